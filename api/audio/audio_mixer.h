@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/refcount.h"
 
@@ -48,6 +49,14 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // The level of the most recently received audio of this source, as
+    // carried by the RTP audio level header extension: -dBov from 0, the
+    // loudest, to 127, silence. Lets the mixer rank the sources without
+    // asking them for audio. absl::nullopt if the level isn't known.
+    virtual absl::optional<int> LatestAudioLevel() const {
+      return absl::nullopt;
+    }
+
     virtual ~Source() {}
   };
 
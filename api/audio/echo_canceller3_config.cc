@@ -21,4 +21,18 @@ EchoCanceller3Config::EchoModel::EchoModel() = default;
 EchoCanceller3Config::EchoModel::EchoModel(
     const EchoCanceller3Config::EchoModel& e) = default;
 
+EchoCanceller3Config EchoCanceller3Config::CreateLowPowerConfig() {
+  EchoCanceller3Config config;
+  config.delay.estimation_interval_blocks = 2;
+  config.filter.main = {8, 0.005f, 0.1f, 0.001f, 20075344.f};
+  config.filter.main_initial = {8, 0.05f, 5.f, 0.001f, 20075344.f};
+  config.filter.shadow = {8, 0.7f, 20075344.f};
+  config.filter.shadow_initial = {8, 0.9f, 20075344.f};
+  config.filter.use_shadow_filter = false;
+  config.ep_strength.reverb_based_on_render = false;
+  config.ep_strength.estimate_reverb_model = false;
+  config.echo_audibility.use_stationary_properties = false;
+  return config;
+}
+
 }  // namespace webrtc
@@ -19,6 +19,13 @@ namespace webrtc {
 struct EchoCanceller3Config {
   EchoCanceller3Config();
   EchoCanceller3Config(const EchoCanceller3Config& e);
+
+  // Returns a configuration for devices with a tight power budget. It uses a
+  // shorter main filter, no shadow filter, less frequent delay estimation and
+  // fixed reverb and stationarity models, which lowers the complexity at the
+  // cost of slower recovery from echo path changes.
+  static EchoCanceller3Config CreateLowPowerConfig();
+
   struct Delay {
     size_t default_delay = 5;
     size_t down_sampling_factor = 4;
@@ -29,6 +36,9 @@ struct EchoCanceller3Config {
     size_t hysteresis_limit_1_blocks = 1;
     size_t hysteresis_limit_2_blocks = 1;
     size_t skew_hysteresis_blocks = 3;
+    // The delay estimator correlates the capture and render signals once per
+    // this many blocks.
+    size_t estimation_interval_blocks = 1;
   } delay;
 
   struct Filter {
@@ -53,6 +63,9 @@ struct EchoCanceller3Config {
     ShadowConfiguration shadow_initial = {12, 0.9f, 20075344.f};
 
     size_t config_change_duration_blocks = 250;
+    // When false, only the main filter is run and the shadow filter outputs
+    // are copies of the main filter outputs.
+    bool use_shadow_filter = true;
   } filter;
 
   struct Erle {
@@ -69,6 +82,9 @@ struct EchoCanceller3Config {
     bool reverb_based_on_render = true;
     bool echo_can_saturate = true;
     bool bounded_erl = false;
+    // When false, the reverb decay stays at default_len instead of being
+    // estimated from the linear filter.
+    bool estimate_reverb_model = true;
   } ep_strength;
 
   struct Mask {
@@ -16,12 +16,52 @@
 
 #include "absl/memory/memory.h"
 #include "common_types.h"  // NOLINT(build/include)
+#include "modules/audio_coding/codecs/opus/audio_coder_opus_common.h"
 #include "modules/audio_coding/codecs/opus/audio_decoder_opus.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
 
 namespace webrtc {
 
+namespace {
+
+// Most channels a 10 ms AudioFrame holds at 48 kHz.
+constexpr int kMaxNumChannels = 8;
+
+}  // namespace
+
+bool AudioDecoderOpus::Config::IsOk() const {
+  if (!IsMultistream())
+    return num_channels == 1 || num_channels == 2;
+  if (num_channels < 1 || num_channels > kMaxNumChannels ||
+      channel_mapping.size() != static_cast<size_t>(num_channels))
+    return false;
+  // libopus limits the coded channels to 255.
+  if (num_streams < 1 || coupled_streams < 0 ||
+      coupled_streams > num_streams || num_streams + coupled_streams > 255)
+    return false;
+  for (unsigned char coded_channel : channel_mapping) {
+    if (coded_channel != 255 && coded_channel >= num_streams + coupled_streams)
+      return false;
+  }
+  return true;
+}
+
 absl::optional<AudioDecoderOpus::Config> AudioDecoderOpus::SdpToConfig(
     const SdpAudioFormat& format) {
+  if (STR_CASE_CMP(format.name.c_str(), kMultistreamOpusName) == 0) {
+    Config config;
+    config.num_channels = rtc::dchecked_cast<int>(format.num_channels);
+    if (format.clockrate_hz != 48000 ||
+        !GetMultistreamParameters(format, &config.num_streams,
+                                  &config.coupled_streams,
+                                  &config.channel_mapping) ||
+        !config.IsOk()) {
+      return absl::nullopt;
+    }
+    return config;
+  }
+
   const auto num_channels = [&]() -> absl::optional<int> {
     auto stereo = format.parameters.find("stereo");
     if (stereo != format.parameters.end()) {
@@ -57,6 +97,12 @@ void AudioDecoderOpus::AppendSupportedDecoders(
 std::unique_ptr<AudioDecoder> AudioDecoderOpus::MakeAudioDecoder(
     Config config,
     absl::optional<AudioCodecPairId> /*codec_pair_id*/) {
+  RTC_DCHECK(config.IsOk());
+  if (config.IsMultistream()) {
+    return absl::make_unique<AudioDecoderOpusImpl>(
+        config.num_channels, config.num_streams, config.coupled_streams,
+        config.channel_mapping);
+  }
   return absl::make_unique<AudioDecoderOpusImpl>(config.num_channels);
 }
 
@@ -27,7 +27,14 @@ namespace webrtc {
 // NOTE: This struct is still under development and may change without notice.
 struct AudioDecoderOpus {
   struct Config {
+    bool IsOk() const;
+    bool IsMultistream() const { return !channel_mapping.empty(); }
+
     int num_channels;
+    // Set for multistream Opus, see AudioEncoderOpusConfig.
+    int num_streams = 0;
+    int coupled_streams = 0;
+    std::vector<unsigned char> channel_mapping;
   };
   static absl::optional<Config> SdpToConfig(const SdpAudioFormat& audio_format);
   static void AppendSupportedDecoders(std::vector<AudioCodecSpec>* specs);
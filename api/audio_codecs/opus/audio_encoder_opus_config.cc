@@ -30,10 +30,13 @@ constexpr int kDefaultLowRateComplexity =
 constexpr int AudioEncoderOpusConfig::kDefaultFrameSizeMs;
 constexpr int AudioEncoderOpusConfig::kMinBitrateBps;
 constexpr int AudioEncoderOpusConfig::kMaxBitrateBps;
+constexpr size_t AudioEncoderOpusConfig::kMaxNumChannels;
 
 AudioEncoderOpusConfig::AudioEncoderOpusConfig()
     : frame_size_ms(kDefaultFrameSizeMs),
       num_channels(1),
+      num_streams(0),
+      coupled_streams(0),
       application(ApplicationMode::kVoip),
       bitrate_bps(32000),
       fec_enabled(false),
@@ -55,8 +58,22 @@ AudioEncoderOpusConfig& AudioEncoderOpusConfig::operator=(
 bool AudioEncoderOpusConfig::IsOk() const {
   if (frame_size_ms <= 0 || frame_size_ms % 10 != 0)
     return false;
-  if (num_channels != 1 && num_channels != 2)
+  if (IsMultistream()) {
+    if (num_channels < 1 || num_channels > kMaxNumChannels ||
+        channel_mapping.size() != num_channels)
+      return false;
+    // libopus limits the coded channels to 255.
+    if (num_streams < 1 || coupled_streams < 0 ||
+        coupled_streams > num_streams || num_streams + coupled_streams > 255)
+      return false;
+    for (unsigned char coded_channel : channel_mapping) {
+      if (coded_channel != 255 &&
+          coded_channel >= num_streams + coupled_streams)
+        return false;
+    }
+  } else if (num_channels != 1 && num_channels != 2) {
     return false;
+  }
   if (!bitrate_bps)
     return false;
   if (*bitrate_bps < kMinBitrateBps || *bitrate_bps > kMaxBitrateBps)
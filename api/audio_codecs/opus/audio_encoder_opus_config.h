@@ -28,15 +28,31 @@ struct AudioEncoderOpusConfig {
   static constexpr int kMinBitrateBps = 6000;
   static constexpr int kMaxBitrateBps = 510000;
 
+  // Most channels that can be coded; this is what a 10 ms AudioFrame holds
+  // at 48 kHz.
+  static constexpr size_t kMaxNumChannels = 8;
+
   AudioEncoderOpusConfig();
   AudioEncoderOpusConfig(const AudioEncoderOpusConfig&);
   ~AudioEncoderOpusConfig();
   AudioEncoderOpusConfig& operator=(const AudioEncoderOpusConfig&);
 
   bool IsOk() const;  // Checks if the values are currently OK.
+  bool IsMultistream() const { return !channel_mapping.empty(); }
 
   int frame_size_ms;
   size_t num_channels;
+
+  // Multistream Opus (RFC 7845, section 5.1.1) codes the channels as
+  // |num_streams| mono and stereo streams in one packet, which is needed for
+  // more than two channels. It is used if |channel_mapping| is set. The first
+  // |coupled_streams| streams are stereo, and their coded channels come
+  // first, two per stream. |channel_mapping| has |num_channels| entries, the
+  // coded channel of each input channel, or 255 for none.
+  int num_streams;
+  int coupled_streams;
+  std::vector<unsigned char> channel_mapping;
+
   enum class ApplicationMode { kVoip, kAudio };
   ApplicationMode application;
 
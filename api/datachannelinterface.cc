@@ -32,4 +32,10 @@ bool DataChannelInterface::negotiated() const {
   return false;
 }
 
+uint64_t DataChannelInterface::buffered_amount_low_threshold() const {
+  return 0;
+}
+
+void DataChannelInterface::SetBufferedAmountLowThreshold(uint64_t threshold) {}
+
 }  // namespace webrtc
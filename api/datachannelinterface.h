@@ -86,6 +86,9 @@ class DataChannelObserver {
   virtual void OnMessage(const DataBuffer& buffer) = 0;
   // The data channel's buffered_amount has changed.
   virtual void OnBufferedAmountChange(uint64_t previous_amount) {}
+  // Sending queued data brought the data channel's buffered_amount down to
+  // its buffered_amount_low_threshold.
+  virtual void OnBufferedAmountLow() {}
 
  protected:
   virtual ~DataChannelObserver() = default;
@@ -155,6 +158,11 @@ class DataChannelInterface : public rtc::RefCountInterface {
   // the SCTP level. See comment above Send below.
   virtual uint64_t buffered_amount() const = 0;
 
+  // See: https://www.w3.org/TR/webrtc/#dom-datachannel-bufferedamountlowthreshold
+  // 0 by default.
+  virtual uint64_t buffered_amount_low_threshold() const;
+  virtual void SetBufferedAmountLowThreshold(uint64_t threshold);
+
   // Begins the graceful data channel closing procedure. See:
   // https://tools.ietf.org/html/draft-ietf-rtcweb-data-channel-13#section-6.7
   virtual void Close() = 0;
@@ -162,11 +170,13 @@ class DataChannelInterface : public rtc::RefCountInterface {
   // Sends |data| to the remote peer. If the data can't be sent at the SCTP
   // level (due to congestion control), it's buffered at the data channel level,
   // up to a maximum of 16MB. If Send is called while this buffer is full, the
-  // data channel will be closed abruptly.
+  // data channel will be closed abruptly. If the data channels of the
+  // PeerConnection have used up their memory budget, Send returns false
+  // without sending or buffering |data|.
   //
-  // So, it's important to use buffered_amount() and OnBufferedAmountChange to
-  // ensure the data channel is used efficiently but without filling this
-  // buffer.
+  // So, it's important to use buffered_amount() and OnBufferedAmountChange, or
+  // the buffered amount low threshold and OnBufferedAmountLow, to ensure the
+  // data channel is used efficiently but without filling this buffer.
   virtual bool Send(const DataBuffer& buffer) = 0;
 
  protected:
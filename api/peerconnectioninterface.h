@@ -91,6 +91,7 @@
 #include "api/setremotedescriptionobserverinterface.h"
 #include "api/stats/rtcstatscollectorcallback.h"
 #include "api/statstypes.h"
+#include "api/transport/bandwidth_estimate_store.h"
 #include "api/transport/bitrate_settings.h"
 #include "api/transport/network_control.h"
 #include "api/turncustomizer.h"
@@ -328,6 +329,13 @@ class PeerConnectionInterface : public rtc::RefCountInterface {
       media_config.video.experiment_cpu_load_estimator = enable;
     }
 
+    bool prewarm_decoders() const {
+      return media_config.video.prewarm_decoders;
+    }
+    void set_prewarm_decoders(bool enable) {
+      media_config.video.prewarm_decoders = enable;
+    }
+
     static const int kUndefined = -1;
     // Default maximum number of packets in the audio jitter buffer.
     static const int kAudioJitterBufferMaxPackets = 50;
@@ -563,6 +571,17 @@ class PeerConnectionInterface : public rtc::RefCountInterface {
     // correctly. This flag will be deprecated soon. Do not rely on it.
     bool active_reset_srtp_params = false;
 
+    // Bounds the memory that the queued outgoing messages of each data
+    // channel, and its queued incoming messages, can take. Unset keeps the
+    // default of 16 MB each.
+    absl::optional<size_t> data_channel_max_queued_bytes;
+
+    // Bounds the memory that the queued messages of all the data channels
+    // take together. Once it is used up, sending a message that may need to be
+    // queued fails instead; OnBufferedAmountLow tells the producer when to
+    // try again. Unset means no bound.
+    absl::optional<size_t> data_channel_memory_budget_bytes;
+
     //
     // Don't forget to update operator== if adding something.
     //
@@ -1158,11 +1177,29 @@ struct PeerConnectionFactoryDependencies final {
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
+  // Optional pool of network threads. When set, each PeerConnection created by
+  // the factory with the default PortAllocator is assigned one of these
+  // threads in turn, and its ICE, DTLS, SRTP and RTP demuxing run there, so
+  // connections don't all serialize on a single network thread. If
+  // |network_thread| is null, the first thread of the pool is used as the
+  // factory's network thread. The threads must be running with a socket server
+  // and outlive the factory.
+  std::vector<rtc::Thread*> network_threads;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine;
   std::unique_ptr<CallFactoryInterface> call_factory;
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory;
   std::unique_ptr<FecControllerFactoryInterface> fec_controller_factory;
   std::unique_ptr<NetworkControllerFactoryInterface> network_controller_factory;
+  // Optional store of the bandwidth estimates of past calls. When set, each
+  // PeerConnection starts bandwidth estimation from the estimate stored for
+  // the network it connects on, unless SetBitrate() set a start bitrate, and
+  // stores its own estimate when closed.
+  std::unique_ptr<BandwidthEstimateStoreInterface> bandwidth_estimate_store;
+  // When positive, the addresses of the STUN and TURN hostnames looked up for
+  // the PeerConnections of the factory that use the default PortAllocator are
+  // shared for this long. The system resolver does not tell the TTL of the
+  // DNS records, so this is how long a stale address may be used.
+  int resolver_cache_ttl_ms = 0;
 };
 
 // PeerConnectionFactoryInterface is the factory interface used for creating
@@ -1511,6 +1548,16 @@ rtc::scoped_refptr<PeerConnectionFactoryInterface>
 CreateModularPeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies);
 
+// Creates a factory for PeerConnections that only use SCTP data channels. It
+// has no media engine and creates no Call, so no audio device, audio
+// processing or codec is ever set up, and audio and video cannot be
+// negotiated. Like CreateModularPeerConnectionFactory, it is implemented in
+// the "peerconnection" build target.
+rtc::scoped_refptr<PeerConnectionFactoryInterface>
+CreateDataChannelOnlyPeerConnectionFactory(rtc::Thread* network_thread,
+                                           rtc::Thread* worker_thread,
+                                           rtc::Thread* signaling_thread);
+
 }  // namespace webrtc
 
 #endif  // API_PEERCONNECTIONINTERFACE_H_
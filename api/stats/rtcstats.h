@@ -72,6 +72,11 @@ class RTCStats {
   bool operator==(const RTCStats& other) const;
   bool operator!=(const RTCStats& other) const;
 
+  // Leaves defined only the members whose values differ from those of
+  // |other|, which must be of the same type, so that this object only holds
+  // what changed since |other|.
+  void UndefineMembersEqualTo(const RTCStats& other);
+
   // Creates a JSON readable string representation of the stats
   // object, listing all of its members (names and values).
   std::string ToJson() const;
@@ -240,6 +245,10 @@ class RTCStatsMemberInterface {
 
   const char* const name_;
   bool is_defined_;
+
+ private:
+  // Undefines the members of its own objects in |UndefineMembersEqualTo|.
+  friend class RTCStats;
 };
 
 // Template implementation of |RTCStatsMemberInterface|. Every possible |T| is
@@ -346,6 +355,8 @@ class RTCNonStandardStatsMember : public RTCStatsMember<T> {
   explicit RTCNonStandardStatsMember(RTCNonStandardStatsMember<T>&& other)
       : RTCStatsMember<T>(std::move(other)) {}
 
+  using RTCStatsMember<T>::operator=;
+
   bool is_standardized() const override { return false; }
 };
 }  // namespace webrtc
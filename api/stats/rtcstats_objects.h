@@ -321,6 +321,23 @@ class RTCPeerConnectionStats final : public RTCStats {
   RTCStatsMember<uint32_t> data_channels_closed;
 };
 
+// Non-standard. The memory that the buffers and queues of a PeerConnection
+// take, to find the sessions that take the most.
+class RTCMemoryUsageStats final : public RTCStats {
+ public:
+  WEBRTC_RTCSTATS_DECL();
+
+  RTCMemoryUsageStats(const std::string& id, int64_t timestamp_us);
+  RTCMemoryUsageStats(std::string&& id, int64_t timestamp_us);
+  RTCMemoryUsageStats(const RTCMemoryUsageStats& other);
+  ~RTCMemoryUsageStats() override;
+
+  // The encoded packets and decoded samples in the audio jitter buffers.
+  RTCNonStandardStatsMember<uint64_t> audio_jitter_buffer_bytes;
+  // The outgoing and incoming messages queued in the data channels.
+  RTCNonStandardStatsMember<uint64_t> data_channel_queued_bytes;
+};
+
 // https://w3c.github.io/webrtc-stats/#streamstats-dict*
 // TODO(hbos): Tracking bug crbug.com/657854
 class RTCRTPStreamStats : public RTCStats {
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "api/stats/rtcstats.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/refcount.h"
 #include "rtc_base/refcountedobject.h"
 #include "rtc_base/scoped_ref_ptr.h"
@@ -90,6 +91,29 @@ class RTCStatsReport : public rtc::RefCountInterface {
   // listing all of its stats objects.
   std::string ToJson() const;
 
+  // Appends a compact binary representation of the report to |buffer|.
+  // Unlike |ToJson| no strings are created for the members, and a buffer that
+  // is reused across reports is only reallocated when it has to grow. Reports
+  // can be written back to back, and read with rtc_tools/stats_reader.
+  //
+  // All integers are little-endian. The report starts with a header:
+  //   uint32 kBinaryMagic, uint32 kBinaryVersion, uint32 size of the report
+  //   in bytes, header included, int64 timestamp_us, uint32 number of groups.
+  // Stats of the same type are stored in a group, column by column:
+  //   string type, uint32 number of objects, uint32 number of members,
+  //   for every member: string name, uint8 |RTCStatsMemberInterface::Type|,
+  //   for every object: string id,
+  //   for every object: int64 timestamp_us,
+  //   for every member: a bitmap of the objects where the member is defined,
+  //   one bit per object with the least significant bit first, followed by
+  //   the values of the objects where it is defined.
+  // Strings are a uint32 length followed by that many bytes. Booleans take
+  // a byte, doubles are stored as their IEEE 754 bits and sequences are a
+  // uint32 length followed by that many elements.
+  void ToBinary(rtc::Buffer* buffer) const;
+  static const uint32_t kBinaryMagic;
+  static const uint32_t kBinaryVersion;
+
   friend class rtc::RefCountedObject<RTCStatsReport>;
 
  private:
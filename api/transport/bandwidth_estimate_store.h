@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_TRANSPORT_BANDWIDTH_ESTIMATE_STORE_H_
+#define API_TRANSPORT_BANDWIDTH_ESTIMATE_STORE_H_
+
+#include <string>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// Keeps the send bandwidth estimates that calls converged to, by the network
+// they were made on, so that the next call on the same network can start its
+// bandwidth estimation, and its encoders, from that estimate instead of from
+// the default start bitrate. Implementations may persist the estimates, and
+// should forget old ones, as networks change over time.
+//
+// |network_id| identifies the network path of the selected ICE candidate
+// pair: the local network adapter type and name, the local address and, for
+// relayed connections, the TURN server.
+//
+// Called on the signaling thread of the PeerConnectionFactory.
+class BandwidthEstimateStoreInterface {
+ public:
+  virtual ~BandwidthEstimateStoreInterface() = default;
+
+  // Called when a PeerConnection connects on |network_id|.
+  virtual absl::optional<int> GetEstimateBps(const std::string& network_id) = 0;
+
+  // Called when a PeerConnection that connected on |network_id| is closed.
+  virtual void SaveEstimateBps(const std::string& network_id,
+                               int estimate_bps) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_TRANSPORT_BANDWIDTH_ESTIMATE_STORE_H_
@@ -32,6 +32,12 @@ PacketResult::~PacketResult() = default;
 TransportPacketsFeedback::TransportPacketsFeedback() = default;
 TransportPacketsFeedback::TransportPacketsFeedback(
     const TransportPacketsFeedback& other) = default;
+TransportPacketsFeedback::TransportPacketsFeedback(
+    TransportPacketsFeedback&& other) = default;
+TransportPacketsFeedback& TransportPacketsFeedback::operator=(
+    const TransportPacketsFeedback& other) = default;
+TransportPacketsFeedback& TransportPacketsFeedback::operator=(
+    TransportPacketsFeedback&& other) = default;
 TransportPacketsFeedback::~TransportPacketsFeedback() = default;
 
 std::vector<PacketResult> TransportPacketsFeedback::ReceivedWithSendInfo()
@@ -123,11 +123,17 @@ struct PacketResult {
 
   absl::optional<SentPacket> sent_packet;
   Timestamp receive_time = Timestamp::Infinity();
+  // Whether the packet arrived with the ECN Congestion Experienced codepoint.
+  // Only known with feedback that reports ECN, false otherwise.
+  bool ecn_ce = false;
 };
 
 struct TransportPacketsFeedback {
   TransportPacketsFeedback();
   TransportPacketsFeedback(const TransportPacketsFeedback& other);
+  TransportPacketsFeedback(TransportPacketsFeedback&& other);
+  TransportPacketsFeedback& operator=(const TransportPacketsFeedback& other);
+  TransportPacketsFeedback& operator=(TransportPacketsFeedback&& other);
   ~TransportPacketsFeedback();
 
   Timestamp feedback_time = Timestamp::Infinity();
@@ -135,6 +141,8 @@ struct TransportPacketsFeedback {
   DataSize prior_in_flight = DataSize::Zero();
   std::vector<PacketResult> packet_feedbacks;
 
+  // Prefer iterating over |packet_feedbacks| directly where the copies made
+  // by these matter.
   std::vector<PacketResult> ReceivedWithSendInfo() const;
   std::vector<PacketResult> LostWithSendInfo() const;
   std::vector<PacketResult> PacketsWithFeedback() const;
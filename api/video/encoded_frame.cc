@@ -13,6 +13,11 @@
 namespace webrtc {
 namespace video_coding {
 
+void EncodedFrame::GetBitstreamFragments(
+    std::vector<rtc::ArrayView<const uint8_t>>* fragments) const {
+  fragments->emplace_back(_buffer, _length);
+}
+
 bool EncodedFrame::delayed_by_retransmission() const {
   return 0;
 }
@@ -11,6 +11,9 @@
 #ifndef API_VIDEO_ENCODED_FRAME_H_
 #define API_VIDEO_ENCODED_FRAME_H_
 
+#include <vector>
+
+#include "api/array_view.h"
 #include "modules/video_coding/encoded_frame.h"
 
 namespace webrtc {
@@ -58,6 +61,18 @@ class EncodedFrame : public webrtc::VCMEncodedFrame {
 
   virtual bool GetBitstream(uint8_t* destination) const = 0;
 
+  // Appends the bitstream of this frame to |fragments|, in decoding order,
+  // without copying it. The views are valid until the frame is destroyed or
+  // MakeBitstreamContiguous() is called. By default the EncodedImage buffer is
+  // returned as a single fragment.
+  virtual void GetBitstreamFragments(
+      std::vector<rtc::ArrayView<const uint8_t>>* fragments) const;
+
+  // Makes the bitstream available in the EncodedImage buffer, for decoders
+  // that need contiguous input. Frames that store the bitstream in fragments
+  // copy it there the first time this is called.
+  virtual void MakeBitstreamContiguous() {}
+
   // The capture timestamp of this frame, using the 90 kHz RTP clock.
   virtual uint32_t Timestamp() const;
   virtual void SetTimestamp(uint32_t rtp_timestamp);
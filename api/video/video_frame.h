@@ -22,6 +22,18 @@ namespace webrtc {
 
 class VideoFrame {
  public:
+  // A region of the frame, in pixels.
+  struct UpdateRect {
+    int offset_x;
+    int offset_y;
+    int width;
+    int height;
+
+    // Makes this the smallest rect that contains both this and |other|.
+    void Union(const UpdateRect& other);
+    bool IsEmpty() const { return width == 0 || height == 0; }
+  };
+
   // Preferred way of building VideoFrame objects.
   class Builder {
    public:
@@ -37,6 +49,7 @@ class VideoFrame {
     Builder& set_ntp_time_ms(int64_t ntp_time_ms);
     Builder& set_rotation(VideoRotation rotation);
     Builder& set_color_space(const ColorSpace& color_space);
+    Builder& set_update_rect(const UpdateRect& update_rect);
 
    private:
     rtc::scoped_refptr<webrtc::VideoFrameBuffer> video_frame_buffer_;
@@ -45,6 +58,7 @@ class VideoFrame {
     int64_t ntp_time_ms_ = 0;
     VideoRotation rotation_ = kVideoRotation_0;
     absl::optional<ColorSpace> color_space_;
+    absl::optional<UpdateRect> update_rect_;
   };
 
   // To be deprecated. Migrate all use to Builder.
@@ -113,6 +127,18 @@ class VideoFrame {
   // Set Color space when available.
   absl::optional<ColorSpace> color_space() const { return color_space_; }
 
+  // The region that changed since the previous frame from the same source,
+  // e.g. from screen capture. Frames without it are assumed to have changed
+  // everywhere. Whoever drops a frame must add its update rect to the next
+  // frame it passes on, and whoever scales or crops a frame must update or
+  // clear it.
+  const absl::optional<UpdateRect>& update_rect() const {
+    return update_rect_;
+  }
+  void set_update_rect(const absl::optional<UpdateRect>& update_rect) {
+    update_rect_ = update_rect;
+  }
+
   // Get render time in milliseconds.
   // TODO(nisse): Deprecated. Migrate all users to timestamp_us().
   int64_t render_time_ms() const;
@@ -133,7 +159,8 @@ class VideoFrame {
              uint32_t timestamp_rtp,
              int64_t ntp_time_ms,
              VideoRotation rotation,
-             const absl::optional<ColorSpace>& color_space);
+             const absl::optional<ColorSpace>& color_space,
+             const absl::optional<UpdateRect>& update_rect);
 
   // An opaque reference counted handle that stores the pixel data.
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> video_frame_buffer_;
@@ -142,6 +169,7 @@ class VideoFrame {
   int64_t timestamp_us_;
   VideoRotation rotation_;
   absl::optional<ColorSpace> color_space_;
+  absl::optional<UpdateRect> update_rect_;
 };
 
 }  // namespace webrtc
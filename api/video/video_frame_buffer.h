@@ -65,6 +65,21 @@ class VideoFrameBuffer : public rtc::RefCountInterface {
   // software encoders.
   virtual rtc::scoped_refptr<I420BufferInterface> ToI420() = 0;
 
+  // Crops the region of |crop_width| x |crop_height| pixels at |offset_x|,
+  // |offset_y| and scales it to |scaled_width| x |scaled_height|, without
+  // leaving the pixel format of the buffer. Returns null if that isn't
+  // supported, in which case the caller has to crop and scale the result of
+  // ToI420(). Native buffers that an encoder can consume directly, e.g.
+  // textures or NV12 buffers of the platform, should implement this, so that
+  // they aren't converted in software just to be cropped or scaled on the way
+  // to the encoder.
+  virtual rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                            int offset_y,
+                                                            int crop_width,
+                                                            int crop_height,
+                                                            int scaled_width,
+                                                            int scaled_height);
+
   // These functions should only be called if type() is of the correct type.
   // Calling with a different type will result in a crash.
   // TODO(magjed): Return raw pointers for GetI420 once deprecated interface is
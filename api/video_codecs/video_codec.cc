@@ -117,6 +117,7 @@ static const char* kPayloadNameH264 = "H264";
 static const char* kPayloadNameI420 = "I420";
 static const char* kPayloadNameGeneric = "Generic";
 static const char* kPayloadNameMultiplex = "Multiplex";
+static const char* kPayloadNameAv1 = "AV1X";
 
 static bool CodecNamesEq(const char* name1, const char* name2) {
   return _stricmp(name1, name2) == 0;
@@ -132,6 +133,8 @@ const char* CodecTypeToPayloadString(VideoCodecType type) {
       return kPayloadNameH264;
     case kVideoCodecI420:
       return kPayloadNameI420;
+    case kVideoCodecAV1:
+      return kPayloadNameAv1;
     // Other codecs default to generic.
     case kVideoCodecMultiplex:
     case kVideoCodecGeneric:
@@ -152,6 +155,8 @@ VideoCodecType PayloadStringToCodecType(const std::string& name) {
     return kVideoCodecI420;
   if (CodecNamesEq(name.c_str(), kPayloadNameMultiplex))
     return kVideoCodecMultiplex;
+  if (CodecNamesEq(name.c_str(), kPayloadNameAv1))
+    return kVideoCodecAV1;
   return kVideoCodecGeneric;
 }
 
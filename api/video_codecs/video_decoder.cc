@@ -37,6 +37,10 @@ bool VideoDecoder::PrefersLateDecoding() const {
   return true;
 }
 
+size_t VideoDecoder::MaxPendingFrames() const {
+  return 1;
+}
+
 const char* VideoDecoder::ImplementationName() const {
   return "unknown";
 }
@@ -69,6 +69,13 @@ class VideoDecoder {
   // frame is consumed.
   virtual bool PrefersLateDecoding() const;
 
+  // Returns how many frames the decoder may hold at once, i.e. how many calls
+  // to Decode() may be made before the first of them produces a decoded
+  // frame. Hardware decoders that queue frames internally should return the
+  // depth of their queue, so that the frames in flight can be matched up with
+  // their output.
+  virtual size_t MaxPendingFrames() const;
+
   virtual const char* ImplementationName() const;
 };
 
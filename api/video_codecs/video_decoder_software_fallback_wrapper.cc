@@ -44,6 +44,7 @@ class VideoDecoderSoftwareFallbackWrapper final : public VideoDecoder {
 
   int32_t Release() override;
   bool PrefersLateDecoding() const override;
+  size_t MaxPendingFrames() const override;
 
   const char* ImplementationName() const override;
 
@@ -201,6 +202,10 @@ bool VideoDecoderSoftwareFallbackWrapper::PrefersLateDecoding() const {
   return active_decoder().PrefersLateDecoding();
 }
 
+size_t VideoDecoderSoftwareFallbackWrapper::MaxPendingFrames() const {
+  return active_decoder().MaxPendingFrames();
+}
+
 const char* VideoDecoderSoftwareFallbackWrapper::ImplementationName() const {
   return decoder_type_ == DecoderType::kFallback
              ? fallback_implementation_name_.c_str()
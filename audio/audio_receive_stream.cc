@@ -102,7 +102,9 @@ AudioReceiveStream::AudioReceiveStream(
     const rtc::scoped_refptr<webrtc::AudioState>& audio_state,
     webrtc::RtcEventLog* event_log,
     std::unique_ptr<voe::ChannelProxy> channel_proxy)
-    : audio_state_(audio_state), channel_proxy_(std::move(channel_proxy)) {
+    : max_sync_delay_ms_(config.max_sync_delay_ms),
+      audio_state_(audio_state),
+      channel_proxy_(std::move(channel_proxy)) {
   RTC_LOG(LS_INFO) << "AudioReceiveStream: " << config.rtp.remote_ssrc;
   RTC_DCHECK(receiver_controller);
   RTC_DCHECK(packet_router);
@@ -196,6 +198,7 @@ webrtc::AudioReceiveStream::Stats AudioReceiveStream::GetStats() const {
   auto ns = channel_proxy_->GetNetworkStatistics();
   stats.jitter_buffer_ms = ns.currentBufferSize;
   stats.jitter_buffer_preferred_ms = ns.preferredBufferSize;
+  stats.jitter_buffer_memory_bytes = ns.bufferMemoryBytes;
   stats.total_samples_received = ns.totalSamplesReceived;
   stats.concealed_samples = ns.concealedSamples;
   stats.concealment_events = ns.concealmentEvents;
@@ -250,6 +253,10 @@ int AudioReceiveStream::PreferredSampleRate() const {
   return channel_proxy_->PreferredSampleRate();
 }
 
+absl::optional<int> AudioReceiveStream::LatestAudioLevel() const {
+  return channel_proxy_->LatestAudioLevel();
+}
+
 int AudioReceiveStream::id() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return config_.rtp.remote_ssrc;
@@ -263,6 +270,7 @@ absl::optional<Syncable::Info> AudioReceiveStream::GetInfo() const {
     return absl::nullopt;
 
   info->current_delay_ms = channel_proxy_->GetDelayEstimate();
+  info->max_sync_delay_ms = max_sync_delay_ms_;
   return info;
 }
 
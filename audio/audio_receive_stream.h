@@ -77,6 +77,7 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
                                        AudioFrame* audio_frame) override;
   int Ssrc() const override;
   int PreferredSampleRate() const override;
+  absl::optional<int> LatestAudioLevel() const override;
 
   // Syncable
   int id() const override;
@@ -100,6 +101,8 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
   rtc::ThreadChecker worker_thread_checker_;
   rtc::ThreadChecker module_process_thread_checker_;
   webrtc::AudioReceiveStream::Config config_;
+  // Copied from |config_| since it's read on the module process thread.
+  const absl::optional<int> max_sync_delay_ms_;
   rtc::scoped_refptr<webrtc::AudioState> audio_state_;
   std::unique_ptr<voe::ChannelProxy> channel_proxy_;
   AudioSendStream* associated_send_stream_ = nullptr;
@@ -10,6 +10,7 @@
 
 #include "audio/audio_send_stream.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -19,8 +20,10 @@
 #include "audio/conversion.h"
 #include "call/rtp_transport_controller_send_interface.h"
 #include "modules/audio_coding/codecs/cng/audio_encoder_cng.h"
+#include "modules/audio_coding/codecs/red/audio_encoder_copy_red.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/function_view.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/audio_format_to_string.h"
@@ -36,6 +39,28 @@ constexpr size_t kPacketLossTrackerMaxWindowSizeMs = 15000;
 constexpr size_t kPacketLossRateMinNumAckedPackets = 50;
 constexpr size_t kRecoverablePacketLossRateMinNumAckedPairs = 40;
 
+// The redundancy of RED can be set by the field trial, e.g.
+// "WebRTC-Audio-Red-For-Opus/Enabled,distance:2,enabling_loss:0.05,
+// disabling_loss:0.02/". Without the loss thresholds, the previous encodings
+// are always sent.
+AudioEncoderCopyRed::Config GetRedConfig() {
+  FieldTrialParameter<int> distance("distance", 1);
+  FieldTrialOptional<double> enabling_loss("enabling_loss");
+  FieldTrialParameter<double> disabling_loss("disabling_loss", 0.0);
+  ParseFieldTrial(
+      {&distance, &enabling_loss, &disabling_loss},
+      webrtc::field_trial::FindFullName("WebRTC-Audio-Red-For-Opus"));
+  AudioEncoderCopyRed::Config config;
+  config.num_redundant_encodings = std::max(distance.Get(), 1);
+  if (enabling_loss.Get()) {
+    config.enabling_packet_loss_fraction =
+        static_cast<float>(*enabling_loss.Get());
+    config.disabling_packet_loss_fraction = static_cast<float>(
+        std::min(disabling_loss.Get(), *enabling_loss.Get()));
+  }
+  return config;
+}
+
 void CallEncoder(const std::unique_ptr<voe::ChannelProxy>& channel_proxy,
                  rtc::FunctionView<void(AudioEncoder*)> lambda) {
   channel_proxy->ModifyEncoder([&](std::unique_ptr<AudioEncoder>* encoder_ptr) {
@@ -280,6 +305,11 @@ void AudioSendStream::ConfigureStream(
     ReconfigureBitrateObserver(stream, new_config);
   }
   stream->config_ = new_config;
+
+  if (stream->sending_) {
+    // Update AudioState's information about the stream.
+    stream->AddToAudioState();
+  }
 }
 
 void AudioSendStream::Start() {
@@ -303,8 +333,7 @@ void AudioSendStream::Start() {
   }
   channel_proxy_->StartSend();
   sending_ = true;
-  audio_state()->AddSendingStream(this, encoder_sample_rate_hz_,
-                                  encoder_num_channels_);
+  AddToAudioState();
 }
 
 void AudioSendStream::Stop() {
@@ -324,6 +353,11 @@ void AudioSendStream::SendAudioData(std::unique_ptr<AudioFrame> audio_frame) {
   channel_proxy_->ProcessAndEncodeAudio(std::move(audio_frame));
 }
 
+void AudioSendStream::SendEncodedAudio(
+    const SharedAudioEncoder::EncodedAudio& encoded_audio) {
+  channel_proxy_->SendEncodedAudio(encoded_audio);
+}
+
 bool AudioSendStream::SendTelephoneEvent(int payload_type,
                                          int payload_frequency,
                                          int event,
@@ -502,12 +536,41 @@ void AudioSendStream::StoreEncoderProperties(int sample_rate_hz,
   RTC_DCHECK(worker_thread_checker_.CalledOnValidThread());
   encoder_sample_rate_hz_ = sample_rate_hz;
   encoder_num_channels_ = num_channels;
-  if (sending_) {
-    // Update AudioState's information about the stream.
-    audio_state()->AddSendingStream(this, sample_rate_hz, num_channels);
+}
+
+void AudioSendStream::AddToAudioState() {
+  RTC_DCHECK(worker_thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(sending_);
+  absl::optional<SharedAudioEncoder::Config> shared_encoder_config =
+      GetSharedEncoderConfig();
+  if (shared_encoder_config) {
+    audio_state()->AddSharedEncoderSendingStream(
+        this, this, *shared_encoder_config, encoder_sample_rate_hz_,
+        encoder_num_channels_);
+  } else {
+    audio_state()->AddSendingStream(this, encoder_sample_rate_hz_,
+                                    encoder_num_channels_);
   }
 }
 
+absl::optional<SharedAudioEncoder::Config>
+AudioSendStream::GetSharedEncoderConfig() const {
+  if (!webrtc::field_trial::IsEnabled("WebRTC-Audio-SharedEncoder"))
+    return absl::nullopt;
+  // Comfort noise and the audio network adaptor make the encoder depend on
+  // the stream, and so does the target bitrate experiment below.
+  if (!config_.send_codec_spec || !config_.encoder_factory ||
+      config_.send_codec_spec->cng_payload_type ||
+      config_.send_codec_spec->red_payload_type ||
+      config_.audio_network_adaptor_config ||
+      webrtc::field_trial::IsEnabled("WebRTC-Audio-SendSideBwe-For-Video")) {
+    return absl::nullopt;
+  }
+  const auto& spec = *config_.send_codec_spec;
+  return SharedAudioEncoder::Config(config_.encoder_factory, spec.payload_type,
+                                    spec.format, spec.target_bitrate_bps);
+}
+
 // Apply current codec settings to a single voe::Channel used for sending.
 bool AudioSendStream::SetupSendCodec(AudioSendStream* stream,
                                      const Config& new_config) {
@@ -563,6 +626,17 @@ bool AudioSendStream::SetupSendCodec(AudioSendStream* stream,
         new_config.send_codec_spec->format.clockrate_hz);
   }
 
+  // Wrap the encoder in an AudioEncoderCopyRed, if RED is negotiated.
+  if (spec.red_payload_type) {
+    AudioEncoderCopyRed::Config red_config = GetRedConfig();
+    red_config.payload_type = *spec.red_payload_type;
+    red_config.speech_encoder = std::move(encoder);
+    encoder.reset(new AudioEncoderCopyRed(std::move(red_config)));
+
+    stream->RegisterRedPayloadType(*spec.red_payload_type,
+                                   new_config.send_codec_spec->format);
+  }
+
   stream->StoreEncoderProperties(encoder->SampleRateHz(),
                                  encoder->NumChannels());
   stream->channel_proxy_->SetEncoder(new_config.send_codec_spec->payload_type,
@@ -587,13 +661,19 @@ bool AudioSendStream::ReconfigureSendCodec(AudioSendStream* stream,
     return true;
   }
 
-  // If we have no encoder, or the format or payload type's changed, create a
-  // new encoder.
+  // If we have no encoder, or the format, payload type or RED has changed,
+  // create a new encoder. The CNG encoder is wrapped in the RED encoder, so it
+  // can't be swapped in place when RED is used either.
   if (!old_config.send_codec_spec ||
       new_config.send_codec_spec->format !=
           old_config.send_codec_spec->format ||
       new_config.send_codec_spec->payload_type !=
-          old_config.send_codec_spec->payload_type) {
+          old_config.send_codec_spec->payload_type ||
+      new_config.send_codec_spec->red_payload_type !=
+          old_config.send_codec_spec->red_payload_type ||
+      (new_config.send_codec_spec->red_payload_type &&
+       new_config.send_codec_spec->cng_payload_type !=
+           old_config.send_codec_spec->cng_payload_type)) {
     return SetupSendCodec(stream, new_config);
   }
 
@@ -765,5 +845,18 @@ void AudioSendStream::RegisterCngPayloadType(int payload_type,
     }
   }
 }
+
+void AudioSendStream::RegisterRedPayloadType(int payload_type,
+                                             const SdpAudioFormat& format) {
+  const CodecInst codec = {
+      payload_type, "red", format.clockrate_hz, 0, format.num_channels, 0};
+  if (rtp_rtcp_module_->RegisterSendPayload(codec) != 0) {
+    rtp_rtcp_module_->DeRegisterSendPayload(codec.pltype);
+    if (rtp_rtcp_module_->RegisterSendPayload(codec) != 0) {
+      RTC_DLOG(LS_ERROR) << "RegisterRedPayloadType() failed to register RED "
+                            "to RTP/RTCP module";
+    }
+  }
+}
 }  // namespace internal
 }  // namespace webrtc
@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "audio/shared_audio_encoder.h"
 #include "audio/time_interval.h"
 #include "audio/transport_feedback_packet_loss_tracker.h"
 #include "call/audio_send_stream.h"
@@ -39,7 +40,8 @@ class AudioState;
 
 class AudioSendStream final : public webrtc::AudioSendStream,
                               public webrtc::BitrateAllocatorObserver,
-                              public webrtc::PacketFeedbackObserver {
+                              public webrtc::PacketFeedbackObserver,
+                              public SharedAudioEncoder::Sink {
  public:
   AudioSendStream(const webrtc::AudioSendStream::Config& config,
                   const rtc::scoped_refptr<webrtc::AudioState>& audio_state,
@@ -93,6 +95,10 @@ class AudioSendStream final : public webrtc::AudioSendStream,
   void OnPacketFeedbackVector(
       const std::vector<PacketFeedback>& packet_feedback_vector) override;
 
+  // Implements SharedAudioEncoder::Sink.
+  void SendEncodedAudio(
+      const SharedAudioEncoder::EncodedAudio& encoded_audio) override;
+
   void SetTransportOverhead(int transport_overhead_per_packet);
 
   RtpState GetRtpState() const;
@@ -105,6 +111,13 @@ class AudioSendStream final : public webrtc::AudioSendStream,
   const internal::AudioState* audio_state() const;
 
   void StoreEncoderProperties(int sample_rate_hz, size_t num_channels);
+  // Registers the stream with AudioState, sharing its encoder with other
+  // streams if possible.
+  void AddToAudioState();
+  // Returns the settings of the shared encoder to use, if the
+  // "WebRTC-Audio-SharedEncoder" field trial is enabled and nothing in the
+  // config requires the stream to have an encoder of its own.
+  absl::optional<SharedAudioEncoder::Config> GetSharedEncoderConfig() const;
 
   // These are all static to make it less likely that (the old) config_ is
   // accessed unintentionally.
@@ -126,6 +139,7 @@ class AudioSendStream final : public webrtc::AudioSendStream,
   void RemoveBitrateObserver();
 
   void RegisterCngPayloadType(int payload_type, int clockrate_hz);
+  void RegisterRedPayloadType(int payload_type, const SdpAudioFormat& format);
 
   rtc::ThreadChecker worker_thread_checker_;
   rtc::ThreadChecker pacer_thread_checker_;
@@ -337,7 +337,7 @@ TEST(AudioSendStreamTest, ConfigToString) {
       "{rtp_history_ms: 0}, c_name: foo_name}, send_transport: null, "
       "min_bitrate_bps: 12000, max_bitrate_bps: 34000, "
       "send_codec_spec: {nack_enabled: true, transport_cc_enabled: false, "
-      "cng_payload_type: 42, payload_type: 103, "
+      "cng_payload_type: 42, red_payload_type: <unset>, payload_type: 103, "
       "format: {name: isac, clockrate_hz: 16000, num_channels: 1, "
       "parameters: {}}}}",
       config.ToString());
@@ -468,6 +468,31 @@ TEST(AudioSendStreamTest, SendCodecCanApplyVad) {
   EXPECT_FALSE(stolen_encoder->ReclaimContainedEncoders().empty());
 }
 
+TEST(AudioSendStreamTest, SendCodecCanApplyRed) {
+  ConfigHelper helper(false, false);
+  helper.config().send_codec_spec =
+      AudioSendStream::Config::SendCodecSpec(9, kG722Format);
+  helper.config().send_codec_spec->red_payload_type = 63;
+  using ::testing::Invoke;
+  std::unique_ptr<AudioEncoder> stolen_encoder;
+  EXPECT_CALL(*helper.channel_proxy(), SetEncoderForMock(9, _))
+      .WillOnce(
+          Invoke([&stolen_encoder](int payload_type,
+                                   std::unique_ptr<AudioEncoder>* encoder) {
+            stolen_encoder = std::move(*encoder);
+            return true;
+          }));
+
+  auto send_stream = helper.CreateAudioSendStream();
+
+  // The encoded audio is sent with the RED payload type.
+  ASSERT_TRUE(stolen_encoder);
+  EXPECT_FALSE(stolen_encoder->ReclaimContainedEncoders().empty());
+  const int16_t audio[160] = {};
+  rtc::Buffer encoded;
+  EXPECT_EQ(63, stolen_encoder->Encode(0, audio, &encoded).payload_type);
+}
+
 TEST(AudioSendStreamTest, DoesNotPassHigherBitrateThanMaxBitrate) {
   ConfigHelper helper(false, true);
   auto send_stream = helper.CreateAudioSendStream();
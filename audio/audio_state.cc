@@ -80,10 +80,53 @@ void AudioState::RemoveReceivingStream(webrtc::AudioReceiveStream* stream) {
 void AudioState::AddSendingStream(webrtc::AudioSendStream* stream,
                                   int sample_rate_hz,
                                   size_t num_channels) {
+  AddSendingStream(stream, sample_rate_hz, num_channels, nullptr, nullptr);
+}
+
+void AudioState::AddSharedEncoderSendingStream(
+    webrtc::AudioSendStream* stream,
+    SharedAudioEncoder::Sink* sink,
+    const SharedAudioEncoder::Config& encoder_config,
+    int sample_rate_hz,
+    size_t num_channels) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(sink);
+  SharedAudioEncoder* shared_encoder = nullptr;
+  for (const auto& encoder : shared_encoders_) {
+    if (encoder->config() == encoder_config) {
+      shared_encoder = encoder.get();
+      break;
+    }
+  }
+  if (!shared_encoder) {
+    std::unique_ptr<SharedAudioEncoder> encoder =
+        SharedAudioEncoder::Create(encoder_config);
+    if (encoder) {
+      shared_encoder = encoder.get();
+      shared_encoders_.push_back(std::move(encoder));
+    }
+  }
+  AddSendingStream(stream, sample_rate_hz, num_channels, shared_encoder,
+                   shared_encoder ? sink : nullptr);
+}
+
+void AudioState::AddSendingStream(webrtc::AudioSendStream* stream,
+                                  int sample_rate_hz,
+                                  size_t num_channels,
+                                  SharedAudioEncoder* shared_encoder,
+                                  SharedAudioEncoder::Sink* sink) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   auto& properties = sending_streams_[stream];
   properties.sample_rate_hz = sample_rate_hz;
   properties.num_channels = num_channels;
+  if (properties.shared_encoder != shared_encoder) {
+    if (properties.shared_encoder)
+      properties.shared_encoder->RemoveSink(properties.sink);
+    if (shared_encoder)
+      shared_encoder->AddSink(sink);
+    properties.shared_encoder = shared_encoder;
+    properties.sink = sink;
+  }
   UpdateAudioTransportWithSendingStreams();
 
   // Make sure recording is initialized; start recording if enabled.
@@ -101,8 +144,13 @@ void AudioState::AddSendingStream(webrtc::AudioSendStream* stream,
 
 void AudioState::RemoveSendingStream(webrtc::AudioSendStream* stream) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
-  auto count = sending_streams_.erase(stream);
-  RTC_DCHECK_EQ(1, count);
+  auto it = sending_streams_.find(stream);
+  RTC_DCHECK(it != sending_streams_.end());
+  if (it == sending_streams_.end())
+    return;
+  if (it->second.shared_encoder)
+    it->second.shared_encoder->RemoveSink(it->second.sink);
+  sending_streams_.erase(it);
   UpdateAudioTransportWithSendingStreams();
   if (sending_streams_.empty()) {
     config_.audio_device_module->StopRecording();
@@ -176,15 +224,32 @@ rtc::RefCountReleaseStatus AudioState::Release() const {
 void AudioState::UpdateAudioTransportWithSendingStreams() {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   std::vector<webrtc::AudioSendStream*> sending_streams;
+  std::vector<SharedAudioEncoder*> shared_encoders;
   int max_sample_rate_hz = 8000;
   size_t max_num_channels = 1;
   for (const auto& kv : sending_streams_) {
-    sending_streams.push_back(kv.first);
+    SharedAudioEncoder* shared_encoder = kv.second.shared_encoder;
+    if (!shared_encoder) {
+      sending_streams.push_back(kv.first);
+    } else if (std::find(shared_encoders.begin(), shared_encoders.end(),
+                         shared_encoder) == shared_encoders.end()) {
+      shared_encoders.push_back(shared_encoder);
+    }
     max_sample_rate_hz = std::max(max_sample_rate_hz, kv.second.sample_rate_hz);
     max_num_channels = std::max(max_num_channels, kv.second.num_channels);
   }
   audio_transport_.UpdateSendingStreams(std::move(sending_streams),
+                                        std::move(shared_encoders),
                                         max_sample_rate_hz, max_num_channels);
+
+  // The audio transport no longer uses encoders without streams, so they can
+  // be destroyed.
+  shared_encoders_.erase(
+      std::remove_if(shared_encoders_.begin(), shared_encoders_.end(),
+                     [](const std::unique_ptr<SharedAudioEncoder>& encoder) {
+                       return !encoder->HasSinks();
+                     }),
+      shared_encoders_.end());
 }
 }  // namespace internal
 
@@ -14,9 +14,11 @@
 #include <map>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "audio/audio_transport_impl.h"
 #include "audio/null_audio_poller.h"
+#include "audio/shared_audio_encoder.h"
 #include "call/audio_state.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/criticalsection.h"
@@ -60,6 +62,16 @@ class AudioState final : public webrtc::AudioState {
   void AddSendingStream(webrtc::AudioSendStream* stream,
                         int sample_rate_hz,
                         size_t num_channels);
+  // Like AddSendingStream(), but the audio of the stream is encoded by a
+  // SharedAudioEncoder common to all streams added with an equal
+  // |encoder_config|, and handed to |sink| instead of to SendAudioData().
+  // Falls back to AddSendingStream() if the encoder can't be created.
+  void AddSharedEncoderSendingStream(
+      webrtc::AudioSendStream* stream,
+      SharedAudioEncoder::Sink* sink,
+      const SharedAudioEncoder::Config& encoder_config,
+      int sample_rate_hz,
+      size_t num_channels);
   void RemoveSendingStream(webrtc::AudioSendStream* stream);
 
  private:
@@ -67,6 +79,11 @@ class AudioState final : public webrtc::AudioState {
   void AddRef() const override;
   rtc::RefCountReleaseStatus Release() const override;
 
+  void AddSendingStream(webrtc::AudioSendStream* stream,
+                        int sample_rate_hz,
+                        size_t num_channels,
+                        SharedAudioEncoder* shared_encoder,
+                        SharedAudioEncoder::Sink* sink);
   void UpdateAudioTransportWithSendingStreams();
 
   rtc::ThreadChecker thread_checker_;
@@ -92,8 +109,13 @@ class AudioState final : public webrtc::AudioState {
   struct StreamProperties {
     int sample_rate_hz = 0;
     size_t num_channels = 0;
+    // Set if the stream's audio is encoded by one of |shared_encoders_|.
+    SharedAudioEncoder* shared_encoder = nullptr;
+    SharedAudioEncoder::Sink* sink = nullptr;
   };
   std::map<webrtc::AudioSendStream*, StreamProperties> sending_streams_;
+  // Only kept while some stream uses them.
+  std::vector<std::unique_ptr<SharedAudioEncoder>> shared_encoders_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(AudioState);
 };
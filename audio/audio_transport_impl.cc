@@ -15,6 +15,7 @@
 #include <utility>
 
 #include "audio/remix_resample.h"
+#include "audio/shared_audio_encoder.h"
 #include "audio/utility/audio_frame_operations.h"
 #include "call/audio_send_stream.h"
 #include "rtc_base/logging.h"
@@ -155,6 +156,15 @@ int32_t AudioTransportImpl::RecordedDataIsAvailable(
     typing_noise_detected_ = typing_detected;
 
     RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
+    for (size_t i = 0; i < shared_encoders_.size(); ++i) {
+      if (sending_streams_.empty() && i + 1 == shared_encoders_.size()) {
+        shared_encoders_[i]->Encode(std::move(audio_frame));
+        break;
+      }
+      std::unique_ptr<AudioFrame> audio_frame_copy(new AudioFrame());
+      audio_frame_copy->CopyFrom(*audio_frame.get());
+      shared_encoders_[i]->Encode(std::move(audio_frame_copy));
+    }
     if (!sending_streams_.empty()) {
       auto it = sending_streams_.begin();
       while (++it != sending_streams_.end()) {
@@ -236,10 +246,12 @@ void AudioTransportImpl::PullRenderData(int bits_per_sample,
 
 void AudioTransportImpl::UpdateSendingStreams(
     std::vector<AudioSendStream*> streams,
+    std::vector<SharedAudioEncoder*> shared_encoders,
     int send_sample_rate_hz,
     size_t send_num_channels) {
   rtc::CritScope lock(&capture_lock_);
   sending_streams_ = std::move(streams);
+  shared_encoders_ = std::move(shared_encoders);
   send_sample_rate_hz_ = send_sample_rate_hz;
   send_num_channels_ = send_num_channels;
 }
@@ -27,6 +27,7 @@
 namespace webrtc {
 
 class AudioSendStream;
+class SharedAudioEncoder;
 
 class AudioTransportImpl : public AudioTransport {
  public:
@@ -61,7 +62,10 @@ class AudioTransportImpl : public AudioTransport {
                       int64_t* elapsed_time_ms,
                       int64_t* ntp_time_ms) override;
 
+  // Captured audio is sent to each of |streams|, and encoded once by each of
+  // |shared_encoders| for the streams that use them.
   void UpdateSendingStreams(std::vector<AudioSendStream*> streams,
+                            std::vector<SharedAudioEncoder*> shared_encoders,
                             int send_sample_rate_hz,
                             size_t send_num_channels);
   void SetStereoChannelSwapping(bool enable);
@@ -75,6 +79,8 @@ class AudioTransportImpl : public AudioTransport {
   // Capture side.
   rtc::CriticalSection capture_lock_;
   std::vector<AudioSendStream*> sending_streams_ RTC_GUARDED_BY(capture_lock_);
+  std::vector<SharedAudioEncoder*> shared_encoders_
+      RTC_GUARDED_BY(capture_lock_);
   int send_sample_rate_hz_ RTC_GUARDED_BY(capture_lock_) = 8000;
   size_t send_num_channels_ RTC_GUARDED_BY(capture_lock_) = 1;
   bool typing_noise_detected_ RTC_GUARDED_BY(capture_lock_) = false;
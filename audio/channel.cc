@@ -59,6 +59,46 @@ constexpr int64_t kMinRetransmissionWindowMs = 30;
 constexpr int kVoiceEngineMinMinPlayoutDelayMs = 0;
 constexpr int kVoiceEngineMaxMinPlayoutDelayMs = 10000;
 
+// Limits of the timestamp offset and length fields of RFC 2198 block headers.
+constexpr uint32_t kRedMaxTimestampOffset = (1 << 14) - 1;
+constexpr size_t kRedMaxBlockLength = (1 << 10) - 1;
+
+// Packs the encodings in |payload| described by |fragmentation|, the newest
+// first, as done by AudioEncoderCopyRed, into an RFC 2198 payload. Previous
+// encodings that don't fit in a block header are left out.
+void PackRedPayload(const uint8_t* payload,
+                    const RTPFragmentationHeader& fragmentation,
+                    rtc::Buffer* red_payload) {
+  red_payload->Clear();
+  std::vector<size_t> blocks;
+  for (size_t i = fragmentation.fragmentationVectorSize - 1; i > 0; --i) {
+    if (fragmentation.fragmentationTimeDiff[i] <= kRedMaxTimestampOffset &&
+        fragmentation.fragmentationLength[i] <= kRedMaxBlockLength) {
+      blocks.push_back(i);
+    }
+  }
+  // The headers of the previous encodings, the oldest first, and the header of
+  // the primary encoding.
+  for (size_t i : blocks) {
+    const uint32_t offset_and_length =
+        (fragmentation.fragmentationTimeDiff[i] << 10) |
+        static_cast<uint32_t>(fragmentation.fragmentationLength[i]);
+    const uint8_t header[4] = {
+        static_cast<uint8_t>(0x80 | fragmentation.fragmentationPlType[i]),
+        static_cast<uint8_t>(offset_and_length >> 16),
+        static_cast<uint8_t>(offset_and_length >> 8),
+        static_cast<uint8_t>(offset_and_length)};
+    red_payload->AppendData(header);
+  }
+  red_payload->AppendData(
+      static_cast<uint8_t>(fragmentation.fragmentationPlType[0] & 0x7f));
+  blocks.push_back(0);
+  for (size_t i : blocks) {
+    red_payload->AppendData(payload + fragmentation.fragmentationOffset[i],
+                            fragmentation.fragmentationLength[i]);
+  }
+}
+
 }  // namespace
 
 const int kTelephoneEventAttenuationdB = 10;
@@ -303,6 +343,15 @@ int32_t Channel::SendData(FrameType frameType,
     _rtpRtcpModule->SetAudioLevel(rms_level_.Average());
   }
 
+  // The RTP/RTCP module sends audio payloads as they are, so the encodings of
+  // AudioEncoderCopyRed are packed here.
+  if (fragmentation && fragmentation->fragmentationVectorSize > 0) {
+    PackRedPayload(payloadData, *fragmentation, &red_payload_);
+    payloadData = red_payload_.data();
+    payloadSize = red_payload_.size();
+    fragmentation = nullptr;
+  }
+
   // Push data from ACM to RTP/RTCP-module to deliver audio frame for
   // packetization.
   // This call will trigger Transport::SendPacket() from the RTP/RTCP module.
@@ -499,11 +548,17 @@ int Channel::PreferredSampleRate() const {
                   audio_coding_->PlayoutFrequency());
 }
 
+absl::optional<int> Channel::LatestAudioLevel() const {
+  rtc::CritScope lock(&audio_level_lock_);
+  return latest_audio_level_;
+}
+
 Channel::Channel(rtc::TaskQueue* encoder_queue,
                  ProcessThread* module_process_thread,
                  AudioDeviceModule* audio_device_module,
                  RtcpRttStats* rtcp_rtt_stats)
-    : Channel(module_process_thread,
+    : Channel(encoder_queue,
+              module_process_thread,
               audio_device_module,
               rtcp_rtt_stats,
               0,
@@ -511,7 +566,6 @@ Channel::Channel(rtc::TaskQueue* encoder_queue,
               rtc::scoped_refptr<AudioDecoderFactory>(),
               absl::nullopt) {
   RTC_DCHECK(encoder_queue);
-  encoder_queue_ = encoder_queue;
 }
 
 Channel::Channel(ProcessThread* module_process_thread,
@@ -521,6 +575,23 @@ Channel::Channel(ProcessThread* module_process_thread,
                  bool jitter_buffer_fast_playout,
                  rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
                  absl::optional<AudioCodecPairId> codec_pair_id)
+    : Channel(nullptr,
+              module_process_thread,
+              audio_device_module,
+              rtcp_rtt_stats,
+              jitter_buffer_max_packets,
+              jitter_buffer_fast_playout,
+              decoder_factory,
+              codec_pair_id) {}
+
+Channel::Channel(rtc::TaskQueue* encoder_queue,
+                 ProcessThread* module_process_thread,
+                 AudioDeviceModule* audio_device_module,
+                 RtcpRttStats* rtcp_rtt_stats,
+                 size_t jitter_buffer_max_packets,
+                 bool jitter_buffer_fast_playout,
+                 rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+                 absl::optional<AudioCodecPairId> codec_pair_id)
     : event_log_proxy_(new RtcEventLogProxy()),
       rtp_payload_registry_(new RTPPayloadRegistry()),
       rtp_receive_statistics_(
@@ -559,6 +630,7 @@ Channel::Channel(ProcessThread* module_process_thread,
           webrtc::field_trial::FindFullName("UseTwccPlrForAna") == "Enabled") {
   RTC_DCHECK(module_process_thread);
   RTC_DCHECK(audio_device_module);
+  encoder_queue_ = encoder_queue;
   AudioCodingModule::Config acm_config;
   acm_config.decoder_factory = decoder_factory;
   acm_config.neteq_config.codec_pair_id = codec_pair_id;
@@ -571,6 +643,7 @@ Channel::Channel(ProcessThread* module_process_thread,
 
   RtpRtcp::Configuration configuration;
   configuration.audio = true;
+  configuration.receiver_only = !encoder_queue;
   configuration.outgoing_transport = this;
   configuration.overhead_observer = this;
   configuration.receive_statistics = rtp_receive_statistics_.get();
@@ -872,6 +945,10 @@ void Channel::OnRtpPacket(const RtpPacketReceived& packet) {
   if (header.payload_type_frequency >= 0) {
     rtp_receive_statistics_->IncomingPacket(header, packet.size(),
                                             IsPacketRetransmitted(header));
+    if (header.extension.hasAudioLevel) {
+      rtc::CritScope lock(&audio_level_lock_);
+      latest_audio_level_ = header.extension.audioLevel;
+    }
 
     ReceivePacket(packet.data(), packet.size(), header);
   }
@@ -1264,6 +1341,37 @@ void Channel::ProcessAndEncodeAudioOnTaskQueue(AudioFrame* audio_input) {
   _timeStamp += static_cast<uint32_t>(audio_input->samples_per_channel_);
 }
 
+void Channel::SendEncodedAudio(
+    const SharedAudioEncoder::EncodedAudio& encoded_audio) {
+  rtc::CritScope cs(&encoder_queue_lock_);
+  if (!encoder_queue_is_active_) {
+    return;
+  }
+  encoder_queue_->PostTask([this, encoded_audio] {
+    RTC_DCHECK_RUN_ON(encoder_queue_);
+    SendEncodedAudioOnTaskQueue(encoded_audio);
+  });
+}
+
+void Channel::SendEncodedAudioOnTaskQueue(
+    const SharedAudioEncoder::EncodedAudio& encoded_audio) {
+  RTC_DCHECK_RUN_ON(encoder_queue_);
+  // The shared encoder can't encode silence for a single stream, so a muted
+  // stream sends nothing, as with DTX.
+  if (InputMute())
+    return;
+
+  if (_includeAudioLevelIndication)
+    _rtpRtcpModule->SetAudioLevel(encoded_audio.audio_level_dbov);
+  if (!_rtpRtcpModule->SendOutgoingData(
+          encoded_audio.frame_type, encoded_audio.payload_type,
+          encoded_audio.rtp_timestamp, -1, encoded_audio.payload.cdata(),
+          encoded_audio.payload.size(), nullptr, nullptr, nullptr)) {
+    RTC_DLOG(LS_ERROR)
+        << "Channel::SendEncodedAudio() failed to send data to RTP/RTCP module";
+  }
+}
+
 void Channel::SetAssociatedSendChannel(Channel* channel) {
   RTC_DCHECK_NE(this, channel);
   rtc::CritScope lock(&assoc_send_channel_lock_);
@@ -22,6 +22,7 @@
 #include "api/call/audio_sink.h"
 #include "api/call/transport.h"
 #include "audio/audio_level.h"
+#include "audio/shared_audio_encoder.h"
 #include "call/syncable.h"
 #include "common_types.h"  // NOLINT(build/include)
 #include "modules/audio_coding/include/audio_coding_module.h"
@@ -30,6 +31,7 @@
 #include "modules/rtp_rtcp/include/rtp_header_parser.h"
 #include "modules/rtp_rtcp/include/rtp_receiver.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/event.h"
 #include "rtc_base/task_queue.h"
@@ -266,6 +268,9 @@ class Channel
 
   int PreferredSampleRate() const;
 
+  // The audio level of the most recently received packet that had one.
+  absl::optional<int> LatestAudioLevel() const;
+
   bool Playing() const { return channel_state_.Get().playing; }
   bool Sending() const { return channel_state_.Get().sending; }
   RtpRtcp* RtpRtcpModulePtr() const { return _rtpRtcpModule.get(); }
@@ -281,6 +286,11 @@ class Channel
   // packet.
   void ProcessAndEncodeAudio(std::unique_ptr<AudioFrame> audio_frame);
 
+  // Sends audio already encoded by a SharedAudioEncoder, instead of encoding
+  // captured audio with this channel's own encoder. Like
+  // ProcessAndEncodeAudio(), the work is posted to the encoder task queue.
+  void SendEncodedAudio(const SharedAudioEncoder::EncodedAudio& encoded_audio);
+
   // Associate to a send channel.
   // Used for obtaining RTT for a receive-only channel.
   void SetAssociatedSendChannel(Channel* channel);
@@ -308,6 +318,17 @@ class Channel
  private:
   class ProcessAndEncodeAudioTask;
 
+  // Receive streams have no |encoder_queue| and only get the RTCP half of
+  // the RTP module, without a packet history or other send-side state.
+  Channel(rtc::TaskQueue* encoder_queue,
+          ProcessThread* module_process_thread,
+          AudioDeviceModule* audio_device_module,
+          RtcpRttStats* rtcp_rtt_stats,
+          size_t jitter_buffer_max_packets,
+          bool jitter_buffer_fast_playout,
+          rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+          absl::optional<AudioCodecPairId> codec_pair_id);
+
   void Init();
   void Terminate();
 
@@ -335,6 +356,8 @@ class Channel
   // Called on the encoder task queue when a new input audio frame is ready
   // for encoding.
   void ProcessAndEncodeAudioOnTaskQueue(AudioFrame* audio_input);
+  void SendEncodedAudioOnTaskQueue(
+      const SharedAudioEncoder::EncodedAudio& encoded_audio);
 
   rtc::CriticalSection _callbackCritSect;
   rtc::CriticalSection volume_settings_critsect_;
@@ -351,12 +374,17 @@ class Channel
   AudioSinkInterface* audio_sink_ = nullptr;
   AudioLevel _outputAudioLevel;
   uint32_t _timeStamp RTC_GUARDED_BY(encoder_queue_);
+  // Payload of the last packet with redundant encodings.
+  rtc::Buffer red_payload_ RTC_GUARDED_BY(encoder_queue_);
 
   RemoteNtpTimeEstimator ntp_estimator_ RTC_GUARDED_BY(ts_stats_lock_);
 
   // Timestamp of the audio pulled from NetEq.
   absl::optional<uint32_t> jitter_buffer_playout_timestamp_;
 
+  rtc::CriticalSection audio_level_lock_;
+  absl::optional<int> latest_audio_level_ RTC_GUARDED_BY(audio_level_lock_);
+
   rtc::CriticalSection video_sync_lock_;
   uint32_t playout_timestamp_rtp_ RTC_GUARDED_BY(video_sync_lock_);
   uint32_t playout_delay_ms_ RTC_GUARDED_BY(video_sync_lock_);
@@ -243,12 +243,22 @@ int ChannelProxy::PreferredSampleRate() const {
   return channel_->PreferredSampleRate();
 }
 
+absl::optional<int> ChannelProxy::LatestAudioLevel() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  return channel_->LatestAudioLevel();
+}
+
 void ChannelProxy::ProcessAndEncodeAudio(
     std::unique_ptr<AudioFrame> audio_frame) {
   RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
   return channel_->ProcessAndEncodeAudio(std::move(audio_frame));
 }
 
+void ChannelProxy::SendEncodedAudio(
+    const SharedAudioEncoder::EncodedAudio& encoded_audio) {
+  channel_->SendEncodedAudio(encoded_audio);
+}
+
 void ChannelProxy::SetTransportOverhead(int transport_overhead_per_packet) {
   RTC_DCHECK(worker_thread_checker_.CalledOnValidThread());
   channel_->SetTransportOverhead(transport_overhead_per_packet);
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/shared_audio_encoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "audio/remix_resample.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/thread_checker.h"
+
+namespace webrtc {
+
+class SharedAudioEncoder::EncodeTask : public rtc::QueuedTask {
+ public:
+  EncodeTask(std::unique_ptr<AudioFrame> audio_frame,
+             SharedAudioEncoder* encoder)
+      : audio_frame_(std::move(audio_frame)), encoder_(encoder) {}
+
+ private:
+  bool Run() override {
+    encoder_->EncodeOnTaskQueue(*audio_frame_);
+    return true;
+  }
+
+  std::unique_ptr<AudioFrame> audio_frame_;
+  SharedAudioEncoder* const encoder_;
+};
+
+SharedAudioEncoder::Config::Config(
+    rtc::scoped_refptr<AudioEncoderFactory> encoder_factory,
+    int payload_type,
+    const SdpAudioFormat& format,
+    absl::optional<int> target_bitrate_bps)
+    : encoder_factory(std::move(encoder_factory)),
+      payload_type(payload_type),
+      format(format),
+      target_bitrate_bps(target_bitrate_bps) {}
+
+SharedAudioEncoder::Config::Config(const Config&) = default;
+SharedAudioEncoder::Config::~Config() = default;
+
+bool SharedAudioEncoder::Config::operator==(const Config& other) const {
+  return encoder_factory == other.encoder_factory &&
+         payload_type == other.payload_type && format == other.format &&
+         target_bitrate_bps == other.target_bitrate_bps;
+}
+
+SharedAudioEncoder::EncodedAudio::EncodedAudio() = default;
+SharedAudioEncoder::EncodedAudio::EncodedAudio(const EncodedAudio&) = default;
+SharedAudioEncoder::EncodedAudio::~EncodedAudio() = default;
+
+std::unique_ptr<SharedAudioEncoder> SharedAudioEncoder::Create(
+    const Config& config) {
+  RTC_DCHECK(config.encoder_factory);
+  std::unique_ptr<AudioEncoder> encoder =
+      config.encoder_factory->MakeAudioEncoder(config.payload_type,
+                                               config.format, absl::nullopt);
+  if (!encoder) {
+    RTC_LOG(LS_WARNING) << "Unable to create shared audio encoder.";
+    return nullptr;
+  }
+  if (config.target_bitrate_bps)
+    encoder->OnReceivedTargetAudioBitrate(*config.target_bitrate_bps);
+  return std::unique_ptr<SharedAudioEncoder>(
+      new SharedAudioEncoder(config, std::move(encoder)));
+}
+
+SharedAudioEncoder::SharedAudioEncoder(const Config& config,
+                                       std::unique_ptr<AudioEncoder> encoder)
+    : config_(config),
+      sample_rate_hz_(encoder->SampleRateHz()),
+      num_channels_(encoder->NumChannels()),
+      encoder_(std::move(encoder)),
+      encoder_queue_("SharedAudioEncoder") {}
+
+SharedAudioEncoder::~SharedAudioEncoder() = default;
+
+void SharedAudioEncoder::AddSink(Sink* sink) {
+  rtc::CritScope lock(&sinks_lock_);
+  RTC_DCHECK(std::find(sinks_.begin(), sinks_.end(), sink) == sinks_.end());
+  sinks_.push_back(sink);
+}
+
+void SharedAudioEncoder::RemoveSink(Sink* sink) {
+  rtc::CritScope lock(&sinks_lock_);
+  auto it = std::find(sinks_.begin(), sinks_.end(), sink);
+  RTC_DCHECK(it != sinks_.end());
+  if (it != sinks_.end())
+    sinks_.erase(it);
+}
+
+bool SharedAudioEncoder::HasSinks() const {
+  rtc::CritScope lock(&sinks_lock_);
+  return !sinks_.empty();
+}
+
+void SharedAudioEncoder::Encode(std::unique_ptr<AudioFrame> audio_frame) {
+  encoder_queue_.PostTask(std::unique_ptr<rtc::QueuedTask>(
+      new EncodeTask(std::move(audio_frame), this)));
+}
+
+void SharedAudioEncoder::EncodeOnTaskQueue(const AudioFrame& audio_frame) {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  resampled_frame_.sample_rate_hz_ = sample_rate_hz_;
+  resampled_frame_.num_channels_ = num_channels_;
+  voe::RemixAndResample(audio_frame, &resampler_, &resampled_frame_);
+
+  const size_t length =
+      resampled_frame_.samples_per_channel_ * resampled_frame_.num_channels_;
+  if (resampled_frame_.muted()) {
+    rms_level_.AnalyzeMuted(length);
+  } else {
+    rms_level_.Analyze(
+        rtc::ArrayView<const int16_t>(resampled_frame_.data(), length));
+  }
+
+  encoded_.Clear();
+  const AudioEncoder::EncodedInfo info = encoder_->Encode(
+      rtp_timestamp_,
+      rtc::ArrayView<const int16_t>(resampled_frame_.data(), length),
+      &encoded_);
+  rtp_timestamp_ += rtc::dchecked_cast<uint32_t>(
+      resampled_frame_.samples_per_channel_ * encoder_->RtpTimestampRateHz() /
+      sample_rate_hz_);
+  if (info.encoded_bytes == 0)
+    return;
+
+  EncodedAudio encoded_audio;
+  encoded_audio.frame_type = info.speech ? kAudioFrameSpeech : kAudioFrameCN;
+  encoded_audio.payload_type = static_cast<uint8_t>(info.payload_type);
+  encoded_audio.rtp_timestamp = info.encoded_timestamp;
+  encoded_audio.audio_level_dbov = rms_level_.Average();
+  // Shared by reference between the sinks rather than copied for each.
+  encoded_audio.payload.SetData(encoded_.data(), encoded_.size());
+
+  rtc::CritScope lock(&sinks_lock_);
+  for (Sink* sink : sinks_)
+    sink->SendEncodedAudio(encoded_audio);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef AUDIO_SHARED_AUDIO_ENCODER_H_
+#define AUDIO_SHARED_AUDIO_ENCODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/audio_codecs/audio_encoder_factory.h"
+#include "api/audio_codecs/audio_format.h"
+#include "common_audio/resampler/include/push_resampler.h"
+#include "common_types.h"  // NOLINT(build/include)
+#include "modules/audio_processing/rms_level.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Encodes the captured audio once for all sending streams that use the same
+// encoder settings, and hands the encoded payloads to each of them, so that
+// only RTP packetization is done per stream. Used when the same microphone
+// is sent to many peers with the "WebRTC-Audio-SharedEncoder" field trial.
+//
+// Since the encoder is shared, per stream adaptation of the encoder, such as
+// target bitrate updates from the bitrate allocator, doesn't apply to it.
+class SharedAudioEncoder {
+ public:
+  // The encoder settings. Streams can share an encoder if their configs are
+  // equal.
+  struct Config {
+    Config(rtc::scoped_refptr<AudioEncoderFactory> encoder_factory,
+           int payload_type,
+           const SdpAudioFormat& format,
+           absl::optional<int> target_bitrate_bps);
+    Config(const Config&);
+    ~Config();
+
+    bool operator==(const Config& other) const;
+
+    rtc::scoped_refptr<AudioEncoderFactory> encoder_factory;
+    int payload_type;
+    SdpAudioFormat format;
+    absl::optional<int> target_bitrate_bps;
+  };
+
+  // An encoded frame, with the RTP timestamp on the encoder's own timeline.
+  // Streams' RTP modules add a random offset to it as usual.
+  struct EncodedAudio {
+    EncodedAudio();
+    EncodedAudio(const EncodedAudio&);
+    ~EncodedAudio();
+
+    FrameType frame_type = kEmptyFrame;
+    uint8_t payload_type = 0;
+    uint32_t rtp_timestamp = 0;
+    // Audio level of the frame, in -dBov, for the audio level extension.
+    int audio_level_dbov = 0;
+    rtc::CopyOnWriteBuffer payload;
+  };
+
+  class Sink {
+   public:
+    // Called on the encoder's task queue for each encoded frame.
+    virtual void SendEncodedAudio(const EncodedAudio& encoded_audio) = 0;
+
+   protected:
+    virtual ~Sink() = default;
+  };
+
+  // Returns null if the encoder factory can't create an encoder for the
+  // config.
+  static std::unique_ptr<SharedAudioEncoder> Create(const Config& config);
+
+  ~SharedAudioEncoder();
+
+  const Config& config() const { return config_; }
+  int sample_rate_hz() const { return sample_rate_hz_; }
+  size_t num_channels() const { return num_channels_; }
+
+  // Once RemoveSink() returns, |sink| isn't called anymore.
+  void AddSink(Sink* sink);
+  void RemoveSink(Sink* sink);
+  bool HasSinks() const;
+
+  // Encodes |audio_frame| on the encoder's task queue, converting it to the
+  // encoder's sample rate and number of channels first.
+  void Encode(std::unique_ptr<AudioFrame> audio_frame);
+
+ private:
+  class EncodeTask;
+
+  SharedAudioEncoder(const Config& config,
+                     std::unique_ptr<AudioEncoder> encoder);
+
+  void EncodeOnTaskQueue(const AudioFrame& audio_frame);
+
+  const Config config_;
+  const int sample_rate_hz_;
+  const size_t num_channels_;
+
+  std::unique_ptr<AudioEncoder> encoder_ RTC_GUARDED_BY(encoder_queue_);
+  PushResampler<int16_t> resampler_ RTC_GUARDED_BY(encoder_queue_);
+  AudioFrame resampled_frame_ RTC_GUARDED_BY(encoder_queue_);
+  RmsLevel rms_level_ RTC_GUARDED_BY(encoder_queue_);
+  rtc::Buffer encoded_ RTC_GUARDED_BY(encoder_queue_);
+  uint32_t rtp_timestamp_ RTC_GUARDED_BY(encoder_queue_) = 0;
+
+  rtc::CriticalSection sinks_lock_;
+  std::vector<Sink*> sinks_ RTC_GUARDED_BY(sinks_lock_);
+
+  // Declared last, so that it's destroyed, and its tasks stopped, before the
+  // members they use.
+  rtc::TaskQueue encoder_queue_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SharedAudioEncoder);
+};
+
+}  // namespace webrtc
+
+#endif  // AUDIO_SHARED_AUDIO_ENCODER_H_
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/shared_audio_encoder.h"
+
+#include <utility>
+#include <vector>
+
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/refcountedobject.h"
+#include "test/gtest.h"
+#include "test/mock_audio_encoder_factory.h"
+
+namespace webrtc {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+
+constexpr int kPayloadType = 111;
+constexpr int kSampleRateHz = 16000;
+constexpr int kCaptureSampleRateHz = 48000;
+constexpr size_t kPayloadSize = 20;
+constexpr int kEventTimeoutMs = 1000;
+
+class FakeEncoder : public AudioEncoder {
+ public:
+  explicit FakeEncoder(int* num_encodes) : num_encodes_(num_encodes) {}
+
+  int SampleRateHz() const override { return kSampleRateHz; }
+  size_t NumChannels() const override { return 1; }
+  size_t Num10MsFramesInNextPacket() const override { return 1; }
+  size_t Max10MsFramesInAPacket() const override { return 1; }
+  int GetTargetBitrate() const override { return 32000; }
+  void Reset() override {}
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    ++*num_encodes_;
+    encoded->AppendData(kPayloadSize, [](rtc::ArrayView<uint8_t> payload) {
+      for (size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<uint8_t>(i);
+      return payload.size();
+    });
+    EncodedInfo info;
+    info.encoded_bytes = kPayloadSize;
+    info.encoded_timestamp = rtp_timestamp;
+    info.payload_type = kPayloadType;
+    info.speech = true;
+    return info;
+  }
+
+ private:
+  int* const num_encodes_;
+};
+
+class FakeSink : public SharedAudioEncoder::Sink {
+ public:
+  void SendEncodedAudio(
+      const SharedAudioEncoder::EncodedAudio& encoded_audio) override {
+    rtc::CritScope lock(&lock_);
+    received_.push_back(encoded_audio);
+    event_.Set();
+  }
+
+  bool WaitForFrame() { return event_.Wait(kEventTimeoutMs); }
+
+  std::vector<SharedAudioEncoder::EncodedAudio> received() {
+    rtc::CritScope lock(&lock_);
+    return received_;
+  }
+
+ private:
+  rtc::Event event_{false, false};
+  rtc::CriticalSection lock_;
+  std::vector<SharedAudioEncoder::EncodedAudio> received_;
+};
+
+class SharedAudioEncoderTest : public ::testing::Test {
+ protected:
+  SharedAudioEncoderTest()
+      : encoder_factory_(new rtc::RefCountedObject<MockAudioEncoderFactory>()) {
+    ON_CALL(*encoder_factory_, MakeAudioEncoderMock(_, _, _, _))
+        .WillByDefault(Invoke([this](int, const SdpAudioFormat&,
+                                     absl::optional<AudioCodecPairId>,
+                                     std::unique_ptr<AudioEncoder>* encoder) {
+          encoder->reset(new FakeEncoder(&num_encodes_));
+        }));
+  }
+
+  SharedAudioEncoder::Config config() const {
+    return SharedAudioEncoder::Config(encoder_factory_, kPayloadType,
+                                      SdpAudioFormat("opus", 48000, 2),
+                                      absl::nullopt);
+  }
+
+  static std::unique_ptr<AudioFrame> CaptureFrame() {
+    std::unique_ptr<AudioFrame> audio_frame(new AudioFrame());
+    audio_frame->UpdateFrame(0, nullptr, kCaptureSampleRateHz / 100,
+                             kCaptureSampleRateHz, AudioFrame::kNormalSpeech,
+                             AudioFrame::kVadActive, 1);
+    return audio_frame;
+  }
+
+  rtc::scoped_refptr<MockAudioEncoderFactory> encoder_factory_;
+  int num_encodes_ = 0;
+};
+
+TEST_F(SharedAudioEncoderTest, ReturnsNullWithoutEncoder) {
+  SharedAudioEncoder::Config empty_config(
+      MockAudioEncoderFactory::CreateEmptyFactory(), kPayloadType,
+      SdpAudioFormat("opus", 48000, 2), absl::nullopt);
+  EXPECT_FALSE(SharedAudioEncoder::Create(empty_config));
+}
+
+TEST_F(SharedAudioEncoderTest, ComparesConfigs) {
+  SharedAudioEncoder::Config other_config = config();
+  EXPECT_TRUE(config() == other_config);
+  other_config.target_bitrate_bps = 24000;
+  EXPECT_FALSE(config() == other_config);
+}
+
+TEST_F(SharedAudioEncoderTest, EncodesOnceForAllSinks) {
+  std::unique_ptr<SharedAudioEncoder> encoder =
+      SharedAudioEncoder::Create(config());
+  ASSERT_TRUE(encoder);
+  EXPECT_EQ(kSampleRateHz, encoder->sample_rate_hz());
+  EXPECT_EQ(1u, encoder->num_channels());
+
+  FakeSink sink1;
+  FakeSink sink2;
+  encoder->AddSink(&sink1);
+  encoder->AddSink(&sink2);
+  EXPECT_TRUE(encoder->HasSinks());
+
+  encoder->Encode(CaptureFrame());
+  ASSERT_TRUE(sink1.WaitForFrame());
+  ASSERT_TRUE(sink2.WaitForFrame());
+  EXPECT_EQ(1, num_encodes_);
+
+  const auto received1 = sink1.received();
+  const auto received2 = sink2.received();
+  ASSERT_EQ(1u, received1.size());
+  ASSERT_EQ(1u, received2.size());
+  EXPECT_EQ(kAudioFrameSpeech, received1[0].frame_type);
+  EXPECT_EQ(kPayloadType, received1[0].payload_type);
+  EXPECT_EQ(kPayloadSize, received1[0].payload.size());
+  // The payload isn't copied for each sink.
+  EXPECT_EQ(received1[0].payload.cdata(), received2[0].payload.cdata());
+
+  encoder->RemoveSink(&sink1);
+  encoder->RemoveSink(&sink2);
+  EXPECT_FALSE(encoder->HasSinks());
+}
+
+TEST_F(SharedAudioEncoderTest, DoesNotCallRemovedSink) {
+  std::unique_ptr<SharedAudioEncoder> encoder =
+      SharedAudioEncoder::Create(config());
+  ASSERT_TRUE(encoder);
+
+  FakeSink sink1;
+  FakeSink sink2;
+  encoder->AddSink(&sink1);
+  encoder->AddSink(&sink2);
+  encoder->RemoveSink(&sink1);
+
+  encoder->Encode(CaptureFrame());
+  ASSERT_TRUE(sink2.WaitForFrame());
+  EXPECT_TRUE(sink1.received().empty());
+  encoder->RemoveSink(&sink2);
+}
+
+}  // namespace
+}  // namespace webrtc
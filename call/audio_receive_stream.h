@@ -44,6 +44,7 @@ class AudioReceiveStream {
     uint32_t jitter_ms = 0;
     uint32_t jitter_buffer_ms = 0;
     uint32_t jitter_buffer_preferred_ms = 0;
+    uint64_t jitter_buffer_memory_bytes = 0;
     uint32_t delay_estimate_ms = 0;
     int32_t audio_level = -1;
     // Stats below correspond to similarly-named fields in the WebRTC stats
@@ -114,6 +115,11 @@ class AudioReceiveStream {
     // stream to one audio stream. Tracked by issue webrtc:4762.
     std::string sync_group;
 
+    // Caps the playout delay A/V synchronization may add to this stream.
+    // Once reached, the remaining offset is left to the video stream, or left
+    // uncorrected. Unset for no cap. Only read at stream creation.
+    absl::optional<int> max_sync_delay_ms;
+
     // Decoder specifications for every payload type that we can receive.
     std::map<int, SdpAudioFormat> decoder_map;
 
@@ -118,6 +118,9 @@ class AudioSendStream {
       bool nack_enabled = false;
       bool transport_cc_enabled = false;
       absl::optional<int> cng_payload_type;
+      // If set, the previous encodings are sent along with each new one in
+      // RED (RFC 2198) packets of this payload type.
+      absl::optional<int> red_payload_type;
       // If unset, use the encoder's default target bitrate.
       absl::optional<int> target_bitrate_bps;
     };
@@ -54,6 +54,7 @@ BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
       last_fraction_loss_(0),
       last_rtt_(0),
+      last_bwe_period_ms_(0),
       num_pause_events_(0),
       clock_(Clock::GetRealTimeClock()),
       last_bwe_log_time_(0),
@@ -105,10 +106,11 @@ void BitrateAllocator::OnNetworkChanged(uint32_t target_bitrate_bps,
     last_bwe_log_time_ = now;
   }
 
-  ObserverAllocation allocation = AllocateBitrates(target_bitrate_bps);
+  AllocateBitrates(target_bitrate_bps, &allocation_);
 
-  for (auto& config : bitrate_observer_configs_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    ObserverConfig& config = bitrate_observer_configs_[i];
+    uint32_t allocated_bitrate = allocation_[i];
     uint32_t protection_bitrate = config.observer->OnBitrateUpdated(
         allocated_bitrate, last_fraction_loss_, last_rtt_, last_bwe_period_ms_);
 
@@ -162,12 +164,12 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
         config.bitrate_priority, config.has_packet_feedback));
   }
 
-  ObserverAllocation allocation;
   if (last_bitrate_bps_ > 0) {
     // Calculate a new allocation and update all observers.
-    allocation = AllocateBitrates(last_bitrate_bps_);
-    for (auto& config : bitrate_observer_configs_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
+    AllocateBitrates(last_bitrate_bps_, &allocation_);
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      ObserverConfig& config = bitrate_observer_configs_[i];
+      uint32_t allocated_bitrate = allocation_[i];
       uint32_t protection_bitrate = config.observer->OnBitrateUpdated(
           allocated_bitrate, last_fraction_loss_, last_rtt_,
           last_bwe_period_ms_);
@@ -177,9 +179,8 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
     }
   } else {
     // Currently, an encoder is not allowed to produce frames.
-    // But we still have to return the initial config bitrate + let the
-    // observer know that it can not produce frames.
-    allocation = AllocateBitrates(last_non_zero_bitrate_bps_);
+    // But we still have to let the observer know that it can not produce
+    // frames.
     observer->OnBitrateUpdated(0, last_fraction_loss_, last_rtt_,
                                last_bwe_period_ms_);
   }
@@ -273,32 +274,27 @@ BitrateAllocator::FindObserverConfig(const BitrateAllocatorObserver* observer) {
   return bitrate_observer_configs_.end();
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
-    uint32_t bitrate) {
+void BitrateAllocator::AllocateBitrates(uint32_t bitrate,
+                                        ObserverAllocation* allocation) {
+  allocation->assign(bitrate_observer_configs_.size(), 0);
   if (bitrate_observer_configs_.empty())
-    return ObserverAllocation();
+    return;
 
   if (bitrate_allocation_strategy_ != nullptr) {
-    std::vector<const rtc::BitrateAllocationStrategy::TrackConfig*>
-        track_configs(bitrate_observer_configs_.size());
-    int i = 0;
-    for (const auto& c : bitrate_observer_configs_) {
-      track_configs[i++] = &c;
-    }
+    track_configs_.clear();
+    for (const auto& c : bitrate_observer_configs_)
+      track_configs_.push_back(&c);
     std::vector<uint32_t> track_allocations =
-        bitrate_allocation_strategy_->AllocateBitrates(bitrate, track_configs);
+        bitrate_allocation_strategy_->AllocateBitrates(bitrate, track_configs_);
     // The strategy should return allocation for all tracks.
     RTC_CHECK(track_allocations.size() == bitrate_observer_configs_.size());
-    ObserverAllocation allocation;
-    auto track_allocations_it = track_allocations.begin();
-    for (const auto& observer_config : bitrate_observer_configs_) {
-      allocation[observer_config.observer] = *track_allocations_it++;
-    }
-    return allocation;
+    allocation->assign(track_allocations.begin(), track_allocations.end());
+    return;
   }
 
+  // Allocates zero bitrate to all observers.
   if (bitrate == 0)
-    return ZeroRateAllocation();
+    return;
 
   uint32_t sum_min_bitrates = 0;
   uint32_t sum_max_bitrates = 0;
@@ -310,50 +306,48 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
   // Not enough for all observers to get an allocation, allocate according to:
   // enforced min bitrate -> allocated bitrate previous round -> restart paused
   // streams.
-  if (!EnoughBitrateForAllObservers(bitrate, sum_min_bitrates))
-    return LowRateAllocation(bitrate);
+  if (!EnoughBitrateForAllObservers(bitrate, sum_min_bitrates)) {
+    LowRateAllocation(bitrate, allocation);
+    return;
+  }
 
   // All observers will get their min bitrate plus a share of the rest. This
   // share is allocated to each observer based on its bitrate_priority.
-  if (bitrate <= sum_max_bitrates)
-    return NormalRateAllocation(bitrate, sum_min_bitrates);
+  if (bitrate <= sum_max_bitrates) {
+    NormalRateAllocation(bitrate, sum_min_bitrates, allocation);
+    return;
+  }
 
   // All observers will get up to transmission_max_bitrate_multiplier_ x max.
-  return MaxRateAllocation(bitrate, sum_max_bitrates);
+  MaxRateAllocation(bitrate, sum_max_bitrates, allocation);
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::ZeroRateAllocation() {
-  ObserverAllocation allocation;
-  for (const auto& observer_config : bitrate_observer_configs_)
-    allocation[observer_config.observer] = 0;
-  return allocation;
-}
-
-BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
-    uint32_t bitrate) {
-  ObserverAllocation allocation;
+void BitrateAllocator::LowRateAllocation(uint32_t bitrate,
+                                         ObserverAllocation* allocation) {
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    int32_t allocated_bitrate = 0;
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    const ObserverConfig& observer_config = bitrate_observer_configs_[i];
+    uint32_t allocated_bitrate = 0;
     if (observer_config.enforce_min_bitrate)
       allocated_bitrate = observer_config.min_bitrate_bps;
 
-    allocation[observer_config.observer] = allocated_bitrate;
+    (*allocation)[i] = allocated_bitrate;
     remaining_bitrate -= allocated_bitrate;
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (observer_config.enforce_min_bitrate ||
           observer_config.LastAllocatedBitrate() == 0)
         continue;
 
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -361,14 +355,15 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (observer_config.LastAllocatedBitrate() != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -376,10 +371,7 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
 
   // Split a possible remainder evenly on all streams with an allocation.
   if (remaining_bitrate > 0)
-    DistributeBitrateEvenly(remaining_bitrate, false, 1, &allocation);
-
-  RTC_DCHECK_EQ(allocation.size(), bitrate_observer_configs_.size());
-  return allocation;
+    DistributeBitrateEvenly(remaining_bitrate, false, 1, allocation);
 }
 
 // Allocates the bitrate based on the bitrate priority of each observer. This
@@ -389,38 +381,28 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
 // bitrate_priority = 2.0, the expected behavior is that observer 2 will be
 // allocated twice the bitrate as observer 1 above the each observer's
 // min_bitrate_bps values, until one of the observers hits its max_bitrate_bps.
-BitrateAllocator::ObserverAllocation BitrateAllocator::NormalRateAllocation(
-    uint32_t bitrate,
-    uint32_t sum_min_bitrates) {
-  ObserverAllocation allocation;
-  ObserverAllocation observers_capacities;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    allocation[observer_config.observer] = observer_config.min_bitrate_bps;
-    observers_capacities[observer_config.observer] =
-        observer_config.max_bitrate_bps - observer_config.min_bitrate_bps;
-  }
+void BitrateAllocator::NormalRateAllocation(uint32_t bitrate,
+                                            uint32_t sum_min_bitrates,
+                                            ObserverAllocation* allocation) {
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i)
+    (*allocation)[i] = bitrate_observer_configs_[i].min_bitrate_bps;
 
   bitrate -= sum_min_bitrates;
   // From the remaining bitrate, allocate a proportional amount to each observer
   // above the min bitrate already allocated.
   if (bitrate > 0)
-    DistributeBitrateRelatively(bitrate, observers_capacities, &allocation);
-
-  return allocation;
+    DistributeBitrateRelatively(bitrate, allocation);
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::MaxRateAllocation(
-    uint32_t bitrate,
-    uint32_t sum_max_bitrates) {
-  ObserverAllocation allocation;
-
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    allocation[observer_config.observer] = observer_config.max_bitrate_bps;
-    bitrate -= observer_config.max_bitrate_bps;
+void BitrateAllocator::MaxRateAllocation(uint32_t bitrate,
+                                         uint32_t sum_max_bitrates,
+                                         ObserverAllocation* allocation) {
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    (*allocation)[i] = bitrate_observer_configs_[i].max_bitrate_bps;
+    bitrate -= bitrate_observer_configs_[i].max_bitrate_bps;
   }
   DistributeBitrateEvenly(bitrate, true, transmission_max_bitrate_multiplier_,
-                          &allocation);
-  return allocation;
+                          allocation);
 }
 
 uint32_t BitrateAllocator::ObserverConfig::LastAllocatedBitrate() const {
@@ -454,31 +436,37 @@ void BitrateAllocator::DistributeBitrateEvenly(uint32_t bitrate,
                                                ObserverAllocation* allocation) {
   RTC_DCHECK_EQ(allocation->size(), bitrate_observer_configs_.size());
 
-  ObserverSortingMap list_max_bitrates;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(std::pair<uint32_t, const ObserverConfig*>(
-          observer_config.max_bitrate_bps, &observer_config));
-    }
+  sorted_observers_.clear();
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    if (include_zero_allocations || (*allocation)[i] != 0)
+      sorted_observers_.push_back(i);
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  // Go through the observers in the order of their max bitrate, and in the
+  // order they were added for equal max bitrates.
+  const ObserverConfigs& configs = bitrate_observer_configs_;
+  std::sort(sorted_observers_.begin(), sorted_observers_.end(),
+            [&configs](size_t a, size_t b) {
+              return configs[a].max_bitrate_bps < configs[b].max_bitrate_bps ||
+                     (configs[a].max_bitrate_bps ==
+                          configs[b].max_bitrate_bps &&
+                      a < b);
+            });
+  size_t num_remaining_observers = sorted_observers_.size();
+  for (size_t index : sorted_observers_) {
     RTC_DCHECK_GT(bitrate, 0);
+    const uint32_t max_bitrate = configs[index].max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(num_remaining_observers--);
+    uint32_t total_allocation = extra_allocation + (*allocation)[index];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_multiplier * max_bitrate) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_multiplier * max_bitrate;
+      total_allocation = max_multiplier * max_bitrate;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[index] = total_allocation;
   }
 }
 
@@ -501,50 +489,25 @@ bool BitrateAllocator::EnoughBitrateForAllObservers(uint32_t bitrate,
 
 void BitrateAllocator::DistributeBitrateRelatively(
     uint32_t remaining_bitrate,
-    const ObserverAllocation& observers_capacities,
     ObserverAllocation* allocation) {
   RTC_DCHECK_EQ(allocation->size(), bitrate_observer_configs_.size());
-  RTC_DCHECK_EQ(observers_capacities.size(), bitrate_observer_configs_.size());
-
-  struct PriorityRateObserverConfig {
-    PriorityRateObserverConfig(BitrateAllocatorObserver* allocation_key,
-                               uint32_t capacity_bps,
-                               double bitrate_priority)
-        : allocation_key(allocation_key),
-          capacity_bps(capacity_bps),
-          bitrate_priority(bitrate_priority) {}
-
-    BitrateAllocatorObserver* allocation_key;
-    // The amount of bitrate bps that can be allocated to this observer.
-    uint32_t capacity_bps;
-    double bitrate_priority;
-
-    // We want to sort by which observers will be allocated their full capacity
-    // first. By dividing each observer's capacity by its bitrate priority we
-    // are "normalizing" the capacity of an observer by the rate it will be
-    // filled. This is because the amount allocated is based upon bitrate
-    // priority. We allocate twice as much bitrate to an observer with twice the
-    // bitrate priority of another.
-    bool operator<(const PriorityRateObserverConfig& other) const {
-      return capacity_bps / bitrate_priority <
-             other.capacity_bps / other.bitrate_priority;
-    }
-  };
 
   double bitrate_priority_sum = 0;
-  std::vector<PriorityRateObserverConfig> priority_rate_observers;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    uint32_t capacity_bps = observers_capacities.at(observer_config.observer);
-    priority_rate_observers.emplace_back(observer_config.observer, capacity_bps,
-                                         observer_config.bitrate_priority);
+  priority_rate_observers_.clear();
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    const ObserverConfig& observer_config = bitrate_observer_configs_[i];
+    uint32_t capacity_bps =
+        observer_config.max_bitrate_bps - observer_config.min_bitrate_bps;
+    priority_rate_observers_.emplace_back(i, capacity_bps,
+                                          observer_config.bitrate_priority);
     bitrate_priority_sum += observer_config.bitrate_priority;
   }
 
   // Iterate in the order observers can be allocated their full capacity.
-  std::sort(priority_rate_observers.begin(), priority_rate_observers.end());
+  std::sort(priority_rate_observers_.begin(), priority_rate_observers_.end());
   size_t i;
-  for (i = 0; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  for (i = 0; i < priority_rate_observers_.size(); ++i) {
+    const auto& priority_rate_observer = priority_rate_observers_[i];
     // We allocate the full capacity to an observer only if its relative
     // portion from the remaining bitrate is sufficient to allocate its full
     // capacity. This means we aren't greedily allocating the full capacity, but
@@ -556,7 +519,7 @@ void BitrateAllocator::DistributeBitrateRelatively(
     bool enough_bitrate = allocation_bps >= priority_rate_observer.capacity_bps;
     if (!enough_bitrate)
       break;
-    allocation->at(priority_rate_observer.allocation_key) +=
+    (*allocation)[priority_rate_observer.index] +=
         priority_rate_observer.capacity_bps;
     remaining_bitrate -= priority_rate_observer.capacity_bps;
     bitrate_priority_sum -= priority_rate_observer.bitrate_priority;
@@ -564,11 +527,11 @@ void BitrateAllocator::DistributeBitrateRelatively(
 
   // From the remaining bitrate, allocate the proportional amounts to the
   // observers that aren't allocated their max capacity.
-  for (; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  for (; i < priority_rate_observers_.size(); ++i) {
+    const auto& priority_rate_observer = priority_rate_observers_[i];
     double fraction_allocated =
         priority_rate_observer.bitrate_priority / bitrate_priority_sum;
-    allocation->at(priority_rate_observer.allocation_key) +=
+    (*allocation)[priority_rate_observer.index] +=
         fraction_allocated * remaining_bitrate;
   }
 }
@@ -13,7 +13,6 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -140,22 +139,18 @@ class BitrateAllocator : public BitrateAllocatorInterface {
         : TrackConfig(min_bitrate_bps,
                       max_bitrate_bps,
                       enforce_min_bitrate,
-                      track_id),
+                      track_id,
+                      bitrate_priority),
           observer(observer),
           pad_up_bitrate_bps(pad_up_bitrate_bps),
           allocated_bitrate_bps(-1),
           media_ratio(1.0),
-          bitrate_priority(bitrate_priority),
           has_packet_feedback(has_packet_feedback) {}
 
     BitrateAllocatorObserver* observer;
     uint32_t pad_up_bitrate_bps;
     int64_t allocated_bitrate_bps;
     double media_ratio;  // Part of the total bitrate used for media [0.0, 1.0].
-    // The amount of bitrate allocated to this observer relative to all other
-    // observers. If an observer has twice the bitrate_priority of other
-    // observers, it should be allocated twice the bitrate above its min.
-    double bitrate_priority;
     bool has_packet_feedback;
 
     uint32_t LastAllocatedBitrate() const;
@@ -172,28 +167,57 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   ObserverConfigs::iterator FindObserverConfig(
       const BitrateAllocatorObserver* observer) RTC_RUN_ON(&sequenced_checker_);
 
-  typedef std::multimap<uint32_t, const ObserverConfig*> ObserverSortingMap;
-  typedef std::map<BitrateAllocatorObserver*, int> ObserverAllocation;
+  // The bitrate of each observer, in the order of |bitrate_observer_configs_|.
+  typedef std::vector<uint32_t> ObserverAllocation;
+
+  struct PriorityRateObserverConfig {
+    PriorityRateObserverConfig(size_t index,
+                               uint32_t capacity_bps,
+                               double bitrate_priority)
+        : index(index),
+          capacity_bps(capacity_bps),
+          bitrate_priority(bitrate_priority) {}
+
+    // The index of the observer in |bitrate_observer_configs_|.
+    size_t index;
+    // The amount of bitrate bps that can be allocated to this observer.
+    uint32_t capacity_bps;
+    double bitrate_priority;
+
+    // We want to sort by which observers will be allocated their full capacity
+    // first. By dividing each observer's capacity by its bitrate priority we
+    // are "normalizing" the capacity of an observer by the rate it will be
+    // filled. This is because the amount allocated is based upon bitrate
+    // priority. We allocate twice as much bitrate to an observer with twice the
+    // bitrate priority of another.
+    bool operator<(const PriorityRateObserverConfig& other) const {
+      return capacity_bps / bitrate_priority <
+             other.capacity_bps / other.bitrate_priority;
+    }
+  };
 
-  ObserverAllocation AllocateBitrates(uint32_t bitrate)
+  // The allocation functions below write to |allocation|, which is reused
+  // between calls to not allocate memory once the number of observers is
+  // stable.
+  void AllocateBitrates(uint32_t bitrate, ObserverAllocation* allocation)
       RTC_RUN_ON(&sequenced_checker_);
 
-  // Allocates zero bitrate to all observers.
-  ObserverAllocation ZeroRateAllocation() RTC_RUN_ON(&sequenced_checker_);
   // Allocates bitrate to observers when there isn't enough to allocate the
   // minimum to all observers.
-  ObserverAllocation LowRateAllocation(uint32_t bitrate)
+  void LowRateAllocation(uint32_t bitrate, ObserverAllocation* allocation)
       RTC_RUN_ON(&sequenced_checker_);
   // Allocates bitrate to all observers when the available bandwidth is enough
   // to allocate the minimum to all observers but not enough to allocate the
   // max bitrate of each observer.
-  ObserverAllocation NormalRateAllocation(uint32_t bitrate,
-                                          uint32_t sum_min_bitrates)
+  void NormalRateAllocation(uint32_t bitrate,
+                            uint32_t sum_min_bitrates,
+                            ObserverAllocation* allocation)
       RTC_RUN_ON(&sequenced_checker_);
   // Allocates bitrate to observers when there is enough available bandwidth
   // for all observers to be allocated their max bitrate.
-  ObserverAllocation MaxRateAllocation(uint32_t bitrate,
-                                       uint32_t sum_max_bitrates)
+  void MaxRateAllocation(uint32_t bitrate,
+                         uint32_t sum_max_bitrates,
+                         ObserverAllocation* allocation)
       RTC_RUN_ON(&sequenced_checker_);
 
   // Splits |bitrate| evenly to observers already in |allocation|.
@@ -210,14 +234,14 @@ class BitrateAllocator : public BitrateAllocatorInterface {
 
   // From the available |bitrate|, each observer will be allocated a
   // proportional amount based upon its bitrate priority. If that amount is
-  // more than the observer's capacity, it will be allocated its capacity, and
-  // the excess bitrate is still allocated proportionally to other observers.
-  // Allocating the proportional amount means an observer with twice the
-  // bitrate_priority of another will be allocated twice the bitrate.
-  void DistributeBitrateRelatively(
-      uint32_t bitrate,
-      const ObserverAllocation& observers_capacities,
-      ObserverAllocation* allocation) RTC_RUN_ON(&sequenced_checker_);
+  // more than the observer's capacity, the difference between its max and min
+  // bitrate, it will be allocated its capacity, and the excess bitrate is
+  // still allocated proportionally to other observers. Allocating the
+  // proportional amount means an observer with twice the bitrate_priority of
+  // another will be allocated twice the bitrate.
+  void DistributeBitrateRelatively(uint32_t bitrate,
+                                   ObserverAllocation* allocation)
+      RTC_RUN_ON(&sequenced_checker_);
 
   // Allow packets to be transmitted in up to 2 times max video bitrate if the
   // bandwidth estimate allows it.
@@ -246,6 +270,14 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   std::unique_ptr<rtc::BitrateAllocationStrategy> bitrate_allocation_strategy_
       RTC_GUARDED_BY(&sequenced_checker_);
   const uint8_t transmission_max_bitrate_multiplier_;
+
+  // Scratch space for the allocation, kept to reuse its memory.
+  ObserverAllocation allocation_ RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<size_t> sorted_observers_ RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<PriorityRateObserverConfig> priority_rate_observers_
+      RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<const rtc::BitrateAllocationStrategy::TrackConfig*>
+      track_configs_ RTC_GUARDED_BY(&sequenced_checker_);
 };
 
 }  // namespace webrtc
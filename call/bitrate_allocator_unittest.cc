@@ -12,6 +12,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "call/bitrate_allocator.h"
 #include "modules/bitrate_controller/include/bitrate_controller.h"
 #include "test/gmock.h"
@@ -594,6 +595,22 @@ TEST_F(BitrateAllocatorTest, PassProbingInterval) {
   allocator_->RemoveObserver(&observer);
 }
 
+TEST_F(BitrateAllocatorTest, PriorityWeightedAllocationStrategy) {
+  TestBitrateObserver observer_low;
+  TestBitrateObserver observer_high;
+  allocator_->SetBitrateAllocationStrategy(
+      absl::make_unique<rtc::PriorityWeightedBitrateAllocationStrategy>());
+  AddObserver(&observer_low, 10000, 1000000, 0, false, "low", 1.0);
+  AddObserver(&observer_high, 10000, 1000000, 0, false, "high", 4.0);
+  allocator_->OnNetworkChanged(120000, 0, 0, kDefaultProbingIntervalMs);
+
+  EXPECT_EQ(10000u + 20000u, observer_low.last_bitrate_bps_);
+  EXPECT_EQ(10000u + 80000u, observer_high.last_bitrate_bps_);
+
+  allocator_->RemoveObserver(&observer_low);
+  allocator_->RemoveObserver(&observer_high);
+}
+
 TEST_F(BitrateAllocatorTest, PriorityRateOneObserverBasic) {
   TestBitrateObserver observer;
   const uint32_t kMinSendBitrateBps = 10;
@@ -13,6 +13,8 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -48,9 +50,12 @@
 #include "modules/video_coding/fec_controller_default.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/sequenced_task_checker.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/synchronization/rw_lock_wrapper.h"
@@ -59,8 +64,11 @@
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/cpu_info.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 #include "video/call_stats.h"
+#include "video/cpu_overuse_coordinator.h"
+#include "video/decode_pool.h"
 #include "video/send_delay_stats.h"
 #include "video/stats_counter.h"
 #include "video/video_receive_stream.h"
@@ -158,6 +166,35 @@ std::unique_ptr<rtclog::StreamConfig> CreateRtcLogStreamConfig(
   return rtclog_config;
 }
 
+// Decoding the video receive streams on a shared pool of threads, rather than
+// on one thread per stream, is enabled with "WebRTC-DecodePool/Enabled-<n>/"
+// for |n| threads, or "WebRTC-DecodePool/Enabled/" for one thread per core.
+std::unique_ptr<DecodePool> MaybeCreateDecodePool(int num_cpu_cores) {
+  std::string group = field_trial::FindFullName("WebRTC-DecodePool");
+  if (group.find("Enabled") != 0)
+    return nullptr;
+  int num_threads = 0;
+  if (sscanf(group.c_str(), "Enabled-%d", &num_threads) != 1 ||
+      num_threads < 1) {
+    num_threads = std::max(num_cpu_cores, 1);
+  }
+  RTC_LOG(LS_INFO) << "Decoding video receive streams on " << num_threads
+                   << " shared threads.";
+  return absl::make_unique<DecodePool>(num_threads);
+}
+
+// Adapting the video send streams for CPU overuse based on the encode usage of
+// all of them, least important streams first, is enabled with
+// "WebRTC-SharedCpuAdaptation/Enabled/".
+std::unique_ptr<CpuOveruseCoordinator> MaybeCreateCpuOveruseCoordinator(
+    int num_cpu_cores) {
+  if (!field_trial::IsEnabled("WebRTC-SharedCpuAdaptation"))
+    return nullptr;
+  RTC_LOG(LS_INFO) << "Adapting video send streams for the CPU usage of all "
+                      "streams.";
+  return absl::make_unique<CpuOveruseCoordinator>(num_cpu_cores);
+}
+
 }  // namespace
 
 namespace internal {
@@ -211,6 +248,9 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverPacket(MediaType media_type,
                                rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) override;
+  DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                  RtpPacketReceived packet,
+                                  int64_t packet_time_us) override;
 
   // Implements RecoveredPacketReceiver.
   void OnRecoveredPacket(const uint8_t* packet, size_t length) override;
@@ -240,14 +280,17 @@ class Call final : public webrtc::Call,
                              const uint8_t* packet,
                              size_t length);
   DeliveryStatus DeliverRtp(MediaType media_type,
-                            rtc::CopyOnWriteBuffer packet,
+                            RtpPacketReceived parsed_packet,
                             int64_t packet_time_us);
   void ConfigureSync(const std::string& sync_group)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
+  // Replaces the snapshot returned by GetReceiveRegistry() with one of the
+  // current receive streams and configs.
+  void PublishReceiveRegistry() RTC_EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
 
   void NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
-                                 MediaType media_type)
-      RTC_SHARED_LOCKS_REQUIRED(receive_crit_);
+                                 MediaType media_type,
+                                 bool use_send_side_bwe);
 
   void UpdateSendHistograms(int64_t first_sent_packet_ms)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&bitrate_crit_);
@@ -258,6 +301,12 @@ class Call final : public webrtc::Call,
   Clock* const clock_;
 
   const int num_cpu_cores_;
+  // Null unless the shared decode pool is enabled. Must outlive the video
+  // receive streams.
+  const std::unique_ptr<DecodePool> decode_pool_;
+  // Null unless the shared CPU adaptation is enabled. Must outlive the video
+  // send streams.
+  const std::unique_ptr<CpuOveruseCoordinator> cpu_overuse_coordinator_;
   const std::unique_ptr<ProcessThread> module_process_thread_;
   const std::unique_ptr<CallStats> call_stats_;
   const std::unique_ptr<BitrateAllocator> bitrate_allocator_;
@@ -314,6 +363,26 @@ class Call final : public webrtc::Call,
   std::map<uint32_t, ReceiveRtpConfig> receive_rtp_config_
       RTC_GUARDED_BY(receive_crit_);
 
+  // Snapshot of the receive streams and configs that packet delivery needs.
+  // A published snapshot is never modified: creating or destroying a receive
+  // stream publishes a new one. Delivery only holds |receive_registry_crit_|
+  // while taking a reference to the current snapshot, so it never waits for
+  // receive streams being reconfigured under |receive_crit_|.
+  //
+  // Receive streams are destroyed on the delivery sequence, so delivery never
+  // uses the streams of a snapshot after they are destroyed.
+  struct ReceiveRegistry {
+    std::unordered_map<uint32_t, ReceiveRtpConfig> rtp_configs;
+    std::vector<AudioReceiveStream*> audio_receive_streams;
+    std::vector<VideoReceiveStream*> video_receive_streams;
+  };
+  using ReceiveRegistryRef =
+      rtc::scoped_refptr<const rtc::RefCountedObject<ReceiveRegistry>>;
+  ReceiveRegistryRef GetReceiveRegistry() const;
+
+  rtc::CriticalSection receive_registry_crit_;
+  ReceiveRegistryRef receive_registry_ RTC_GUARDED_BY(receive_registry_crit_);
+
   std::unique_ptr<RWLockWrapper> send_crit_;
   // Audio and Video send streams are owned by the client that creates them.
   std::map<uint32_t, AudioSendStream*> audio_send_ssrcs_
@@ -385,7 +454,8 @@ std::string Call::Stats::ToString(int64_t time_ms) const {
   ss << "recv_bw_bps: " << recv_bandwidth_bps << ", ";
   ss << "max_pad_bps: " << max_padding_bitrate_bps << ", ";
   ss << "pacer_delay_ms: " << pacer_delay_ms << ", ";
-  ss << "rtt_ms: " << rtt_ms;
+  ss << "rtt_ms: " << rtt_ms << ", ";
+  ss << "cpu_usage_percent: " << cpu_usage_percent;
   ss << '}';
   return ss.str();
 }
@@ -419,6 +489,9 @@ Call::Call(const Call::Config& config,
            std::unique_ptr<RtpTransportControllerSendInterface> transport_send)
     : clock_(Clock::GetRealTimeClock()),
       num_cpu_cores_(CpuInfo::DetectNumberOfCores()),
+      decode_pool_(MaybeCreateDecodePool(num_cpu_cores_)),
+      cpu_overuse_coordinator_(
+          MaybeCreateCpuOveruseCoordinator(num_cpu_cores_)),
       module_process_thread_(ProcessThread::Create("ModuleProcessThread")),
       call_stats_(new CallStats(clock_, module_process_thread_.get())),
       bitrate_allocator_(new BitrateAllocator(this)),
@@ -427,6 +500,7 @@ Call::Call(const Call::Config& config,
       video_network_state_(kNetworkDown),
       aggregate_network_up_(false),
       receive_crit_(RWLockWrapper::CreateRWLock()),
+      receive_registry_(new rtc::RefCountedObject<ReceiveRegistry>()),
       send_crit_(RWLockWrapper::CreateRWLock()),
       event_log_(config.event_log),
       received_bytes_per_second_counter_(clock_, nullptr, true),
@@ -657,6 +731,7 @@ webrtc::AudioReceiveStream* Call::CreateAudioReceiveStream(
     receive_rtp_config_.emplace(config.rtp.remote_ssrc,
                                 ReceiveRtpConfig(config));
     audio_receive_streams_.insert(receive_stream);
+    PublishReceiveRegistry();
 
     ConfigureSync(config.sync_group);
   }
@@ -694,6 +769,7 @@ void Call::DestroyAudioReceiveStream(
       ConfigureSync(sync_group);
     }
     receive_rtp_config_.erase(ssrc);
+    PublishReceiveRegistry();
   }
   UpdateAggregateNetworkState();
   delete audio_receive_stream;
@@ -727,7 +803,8 @@ webrtc::VideoSendStream* Call::CreateVideoSendStream(
       transport_send_ptr_, bitrate_allocator_.get(),
       video_send_delay_stats_.get(), event_log_, std::move(config),
       std::move(encoder_config), suspended_video_send_ssrcs_,
-      suspended_video_payload_states_, std::move(fec_controller));
+      suspended_video_payload_states_, std::move(fec_controller),
+      cpu_overuse_coordinator_.get());
 
   {
     WriteLockScoped write_lock(*send_crit_);
@@ -802,7 +879,8 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
   VideoReceiveStream* receive_stream = new VideoReceiveStream(
       &video_receiver_controller_, num_cpu_cores_,
       transport_send_ptr_->packet_router(), std::move(configuration),
-      module_process_thread_.get(), call_stats_.get());
+      module_process_thread_.get(), call_stats_.get(), decode_pool_.get(),
+      cpu_overuse_coordinator_.get());
 
   const webrtc::VideoReceiveStream::Config& config = receive_stream->config();
   {
@@ -818,6 +896,7 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
     receive_rtp_config_.emplace(config.rtp.remote_ssrc,
                                 ReceiveRtpConfig(config));
     video_receive_streams_.insert(receive_stream);
+    PublishReceiveRegistry();
     ConfigureSync(config.sync_group);
   }
   receive_stream->SignalNetworkState(video_network_state_);
@@ -844,6 +923,7 @@ void Call::DestroyVideoReceiveStream(
       receive_rtp_config_.erase(config.rtp.rtx_ssrc);
     }
     video_receive_streams_.erase(receive_stream_impl);
+    PublishReceiveRegistry();
     ConfigureSync(config.sync_group);
   }
 
@@ -867,12 +947,10 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
     // Unlike the video and audio receive streams,
     // FlexfecReceiveStream implements RtpPacketSinkInterface itself,
     // and hence its constructor passes its |this| pointer to
-    // video_receiver_controller_->CreateStream(). Calling the
-    // constructor while holding |receive_crit_| ensures that we don't
-    // call OnRtpPacket until the constructor is finished and the
-    // object is in a valid state.
-    // TODO(nisse): Fix constructor so that it can be moved outside of
-    // this locked scope.
+    // video_receiver_controller_->CreateStream(). Packets are only
+    // demuxed once their SSRC is in the published receive registry,
+    // which ensures that we don't call OnRtpPacket until the
+    // constructor is finished and the object is in a valid state.
     receive_stream = new FlexfecReceiveStreamImpl(
         &video_receiver_controller_, config, recovered_packet_receiver,
         call_stats_.get(), module_process_thread_.get());
@@ -880,6 +958,7 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
     RTC_DCHECK(receive_rtp_config_.find(config.remote_ssrc) ==
                receive_rtp_config_.end());
     receive_rtp_config_.emplace(config.remote_ssrc, ReceiveRtpConfig(config));
+    PublishReceiveRegistry();
   }
 
   // TODO(brandtr): Store config in RtcEventLog here.
@@ -898,6 +977,7 @@ void Call::DestroyFlexfecReceiveStream(FlexfecReceiveStream* receive_stream) {
     const FlexfecReceiveStream::Config& config = receive_stream->GetConfig();
     uint32_t ssrc = config.remote_ssrc;
     receive_rtp_config_.erase(ssrc);
+    PublishReceiveRegistry();
 
     // Remove all SSRCs pointing to the FlexfecReceiveStreamImpl to be
     // destroyed.
@@ -938,6 +1018,10 @@ Call::Stats Call::GetStats() const {
   }
 
   stats.rtt_ms = call_stats_->LastProcessedRtt();
+  if (cpu_overuse_coordinator_) {
+    stats.cpu_usage_percent =
+        cpu_overuse_coordinator_->TotalUsagePercent().value_or(-1);
+  }
   {
     rtc::CritScope cs(&bitrate_crit_);
     stats.max_padding_bitrate_bps = configured_max_padding_bitrate_bps_;
@@ -1166,6 +1250,30 @@ void Call::ConfigureSync(const std::string& sync_group) {
   }
 }
 
+void Call::PublishReceiveRegistry() {
+  rtc::scoped_refptr<rtc::RefCountedObject<ReceiveRegistry>> registry(
+      new rtc::RefCountedObject<ReceiveRegistry>());
+  registry->rtp_configs.reserve(receive_rtp_config_.size());
+  for (const auto& kv : receive_rtp_config_)
+    registry->rtp_configs.emplace(kv.first, kv.second);
+  registry->audio_receive_streams.assign(audio_receive_streams_.begin(),
+                                         audio_receive_streams_.end());
+  registry->video_receive_streams.assign(video_receive_streams_.begin(),
+                                         video_receive_streams_.end());
+
+  // The previous snapshot is released after the lock, in case it was its last
+  // reference.
+  ReceiveRegistryRef previous_registry;
+  rtc::CritScope lock(&receive_registry_crit_);
+  previous_registry = receive_registry_;
+  receive_registry_ = registry;
+}
+
+Call::ReceiveRegistryRef Call::GetReceiveRegistry() const {
+  rtc::CritScope lock(&receive_registry_crit_);
+  return receive_registry_;
+}
+
 PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
                                                  const uint8_t* packet,
                                                  size_t length) {
@@ -1179,16 +1287,15 @@ PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
     received_rtcp_bytes_per_second_counter_.Add(static_cast<int>(length));
   }
   bool rtcp_delivered = false;
+  const ReceiveRegistryRef receive_registry = GetReceiveRegistry();
   if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
-    ReadLockScoped read_lock(*receive_crit_);
-    for (VideoReceiveStream* stream : video_receive_streams_) {
+    for (VideoReceiveStream* stream : receive_registry->video_receive_streams) {
       if (stream->DeliverRtcp(packet, length))
         rtcp_delivered = true;
     }
   }
   if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
-    ReadLockScoped read_lock(*receive_crit_);
-    for (AudioReceiveStream* stream : audio_receive_streams_) {
+    for (AudioReceiveStream* stream : receive_registry->audio_receive_streams) {
       if (stream->DeliverRtcp(packet, length))
         rtcp_delivered = true;
     }
@@ -1217,14 +1324,10 @@ PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
 }
 
 PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
-                                                rtc::CopyOnWriteBuffer packet,
+                                                RtpPacketReceived parsed_packet,
                                                 int64_t packet_time_us) {
   TRACE_EVENT0("webrtc", "Call::DeliverRtp");
 
-  RtpPacketReceived parsed_packet;
-  if (!parsed_packet.Parse(std::move(packet)))
-    return DELIVERY_PACKET_ERROR;
-
   if (packet_time_us != -1) {
     if (receive_time_calculator_) {
       packet_time_us = receive_time_calculator_->ReconcileReceiveTimes(
@@ -1243,22 +1346,22 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   RTC_DCHECK(media_type == MediaType::AUDIO || media_type == MediaType::VIDEO ||
              is_keep_alive_packet);
 
-  ReadLockScoped read_lock(*receive_crit_);
-  auto it = receive_rtp_config_.find(parsed_packet.Ssrc());
-  if (it == receive_rtp_config_.end()) {
+  const ReceiveRegistryRef receive_registry = GetReceiveRegistry();
+  auto it = receive_registry->rtp_configs.find(parsed_packet.Ssrc());
+  if (it == receive_registry->rtp_configs.end()) {
     RTC_LOG(LS_ERROR) << "receive_rtp_config_ lookup failed for ssrc "
                       << parsed_packet.Ssrc();
     // Destruction of the receive stream, including deregistering from the
-    // RtpDemuxer, is not protected by the |receive_crit_| lock. But
-    // deregistering in the |receive_rtp_config_| map is protected by that lock.
-    // So by not passing the packet on to demuxing in this case, we prevent
-    // incoming packets to be passed on via the demuxer to a receive stream
-    // which is being torned down.
+    // RtpDemuxer, happens after its config is removed from the receive
+    // registry. So by not passing the packet on to demuxing in this case, we
+    // prevent incoming packets to be passed on via the demuxer to a receive
+    // stream which is being torned down.
     return DELIVERY_UNKNOWN_SSRC;
   }
   parsed_packet.IdentifyExtensions(it->second.extensions);
 
-  NotifyBweOfReceivedPacket(parsed_packet, media_type);
+  NotifyBweOfReceivedPacket(parsed_packet, media_type,
+                            it->second.use_send_side_bwe);
 
   // RateCounters expect input parameter as int, save it as int,
   // instead of converting each time it is passed to RateCounter::Add below.
@@ -1302,6 +1405,17 @@ PacketReceiver::DeliveryStatus Call::DeliverPacket(
   if (RtpHeaderParser::IsRtcp(packet.cdata(), packet.size()))
     return DeliverRtcp(media_type, packet.cdata(), packet.size());
 
+  RtpPacketReceived parsed_packet;
+  if (!parsed_packet.Parse(std::move(packet)))
+    return DELIVERY_PACKET_ERROR;
+  return DeliverRtp(media_type, std::move(parsed_packet), packet_time_us);
+}
+
+PacketReceiver::DeliveryStatus Call::DeliverRtpPacket(
+    MediaType media_type,
+    RtpPacketReceived packet,
+    int64_t packet_time_us) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&configuration_sequence_checker_);
   return DeliverRtp(media_type, std::move(packet), packet_time_us);
 }
 
@@ -1312,17 +1426,16 @@ void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
 
   parsed_packet.set_recovered(true);
 
-  ReadLockScoped read_lock(*receive_crit_);
-  auto it = receive_rtp_config_.find(parsed_packet.Ssrc());
-  if (it == receive_rtp_config_.end()) {
+  const ReceiveRegistryRef receive_registry = GetReceiveRegistry();
+  auto it = receive_registry->rtp_configs.find(parsed_packet.Ssrc());
+  if (it == receive_registry->rtp_configs.end()) {
     RTC_LOG(LS_ERROR) << "receive_rtp_config_ lookup failed for ssrc "
                       << parsed_packet.Ssrc();
     // Destruction of the receive stream, including deregistering from the
-    // RtpDemuxer, is not protected by the |receive_crit_| lock. But
-    // deregistering in the |receive_rtp_config_| map is protected by that lock.
-    // So by not passing the packet on to demuxing in this case, we prevent
-    // incoming packets to be passed on via the demuxer to a receive stream
-    // which is being torn down.
+    // RtpDemuxer, happens after its config is removed from the receive
+    // registry. So by not passing the packet on to demuxing in this case, we
+    // prevent incoming packets to be passed on via the demuxer to a receive
+    // stream which is being torn down.
     return;
   }
   parsed_packet.IdentifyExtensions(it->second.extensions);
@@ -1333,11 +1446,8 @@ void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
 }
 
 void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
-                                     MediaType media_type) {
-  auto it = receive_rtp_config_.find(packet.Ssrc());
-  bool use_send_side_bwe =
-      (it != receive_rtp_config_.end()) && it->second.use_send_side_bwe;
-
+                                     MediaType media_type,
+                                     bool use_send_side_bwe) {
   RTPHeader header;
   packet.GetHeader(&header);
 
@@ -47,6 +47,10 @@ class Call {
     int recv_bandwidth_bps = 0;       // Estimated available receive bandwidth.
     int64_t pacer_delay_ms = 0;
     int64_t rtt_ms = -1;
+    // The encode and decode usage of the video streams in percent of all
+    // cores, or -1 if not measured. Only measured with the shared CPU
+    // adaptation of the video send streams.
+    int cpu_usage_percent = -1;
   };
 
   static Call* Create(const Call::Config& config);
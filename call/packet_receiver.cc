@@ -28,4 +28,11 @@ PacketReceiver::DeliveryStatus PacketReceiver::DeliverPacket(
   return DeliverPacket(media_type, packet, packet_time.timestamp);
 }
 
+PacketReceiver::DeliveryStatus PacketReceiver::DeliverRtpPacket(
+    MediaType media_type,
+    RtpPacketReceived packet,
+    int64_t packet_time_us) {
+  return DeliverPacket(media_type, packet.Buffer(), packet_time_us);
+}
+
 }  // namespace webrtc
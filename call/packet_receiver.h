@@ -17,6 +17,7 @@
 
 #include "api/mediatypes.h"
 #include "common_types.h"  // NOLINT(build/include)
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/copyonwritebuffer.h"
 
 namespace webrtc {
@@ -39,6 +40,14 @@ class PacketReceiver {
                                        rtc::CopyOnWriteBuffer packet,
                                        const PacketTime& packet_time);
 
+  // Delivers an RTP packet that the caller has already parsed, e.g. for
+  // demuxing, so that it isn't parsed again. The header extensions are
+  // identified by the receiver. The default implementation delivers the raw
+  // packet through DeliverPacket().
+  virtual DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                          RtpPacketReceived packet,
+                                          int64_t packet_time_us);
+
  protected:
   virtual ~PacketReceiver() {}
 };
@@ -81,7 +81,9 @@ std::string RtpConfig::ToString() const {
     if (i != flexfec.protected_media_ssrcs.size() - 1)
       ss << ", ";
   }
-  ss << "]}";
+  ss << "]";
+  ss << ", two_dimensional_parity: "
+     << (flexfec.two_dimensional_parity ? "true" : "false") << '}';
 
   ss << ", rtx: " << rtx.ToString();
   ss << ", c_name: " << c_name;
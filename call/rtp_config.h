@@ -110,6 +110,10 @@ struct RtpConfig {
     // TODO(brandtr): Update comment above when we support
     // multistream protection.
     std::vector<uint32_t> protected_media_ssrcs;
+
+    // Protect with 2D parity masks, see kFecMaskTwoDimensional, rather than
+    // the masks picked by the FEC controller.
+    bool two_dimensional_parity = false;
   } flexfec;
 
   // Settings for RTP retransmission payload format, see RFC 4588 for
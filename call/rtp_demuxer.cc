@@ -10,6 +10,8 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <algorithm>
+
 #include "call/rtp_packet_sink_interface.h"
 #include "call/rtp_rtcp_demuxer_helper.h"
 #include "call/ssrc_binding_observer.h"
@@ -20,6 +22,98 @@
 
 namespace webrtc {
 
+namespace {
+
+const size_t kMinSsrcSinkCacheSlots = 16;
+
+}  // namespace
+
+RtpDemuxer::SsrcSinkCache::SsrcSinkCache() = default;
+RtpDemuxer::SsrcSinkCache::~SsrcSinkCache() = default;
+
+RtpPacketSinkInterface* RtpDemuxer::SsrcSinkCache::Find(uint32_t ssrc) const {
+  if (size_ == 0) {
+    return nullptr;
+  }
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = HomeSlot(ssrc); slots_[i].sink; i = (i + 1) & mask) {
+    if (slots_[i].ssrc == ssrc) {
+      return slots_[i].sink;
+    }
+  }
+  return nullptr;
+}
+
+void RtpDemuxer::SsrcSinkCache::Insert(uint32_t ssrc,
+                                       RtpPacketSinkInterface* sink) {
+  RTC_DCHECK(sink);
+  // Keep the load factor at or below one half.
+  if (2 * (size_ + 1) > slots_.size()) {
+    Grow();
+  }
+  const size_t mask = slots_.size() - 1;
+  size_t i = HomeSlot(ssrc);
+  while (slots_[i].sink && slots_[i].ssrc != ssrc) {
+    i = (i + 1) & mask;
+  }
+  if (!slots_[i].sink) {
+    ++size_;
+  }
+  slots_[i] = {ssrc, sink};
+}
+
+void RtpDemuxer::SsrcSinkCache::Erase(uint32_t ssrc) {
+  if (size_ == 0) {
+    return;
+  }
+  const size_t mask = slots_.size() - 1;
+  size_t i = HomeSlot(ssrc);
+  while (slots_[i].sink && slots_[i].ssrc != ssrc) {
+    i = (i + 1) & mask;
+  }
+  if (!slots_[i].sink) {
+    return;
+  }
+  // Shift later entries of the probe run back into the hole, unless that
+  // would move them in front of their home slot.
+  for (size_t j = (i + 1) & mask; slots_[j].sink; j = (j + 1) & mask) {
+    const size_t home = HomeSlot(slots_[j].ssrc);
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      slots_[i] = slots_[j];
+      i = j;
+    }
+  }
+  slots_[i].sink = nullptr;
+  --size_;
+}
+
+void RtpDemuxer::SsrcSinkCache::Clear() {
+  if (size_ == 0) {
+    return;
+  }
+  for (Slot& slot : slots_) {
+    slot.sink = nullptr;
+  }
+  size_ = 0;
+}
+
+size_t RtpDemuxer::SsrcSinkCache::HomeSlot(uint32_t ssrc) const {
+  // SSRCs are meant to be random, but don't trust the peer to pick them so.
+  return (ssrc * 0x9E3779B1u) & (slots_.size() - 1);
+}
+
+void RtpDemuxer::SsrcSinkCache::Grow() {
+  std::vector<Slot> old_slots(
+      std::max(kMinSsrcSinkCacheSlots, 2 * slots_.size()), Slot{0, nullptr});
+  old_slots.swap(slots_);
+  size_ = 0;
+  for (const Slot& slot : old_slots) {
+    if (slot.sink) {
+      Insert(slot.ssrc, slot.sink);
+    }
+  }
+}
+
 RtpDemuxerCriteria::RtpDemuxerCriteria() = default;
 RtpDemuxerCriteria::~RtpDemuxerCriteria() = default;
 
@@ -71,6 +165,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  sink_cache_.Clear();
 
   return true;
 }
@@ -148,11 +243,36 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  sink_cache_.Clear();
   return num_removed > 0;
 }
 
+void RtpDemuxer::set_use_mid(bool use_mid) {
+  use_mid_ = use_mid;
+  sink_cache_.Clear();
+}
+
 bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
-  RtpPacketSinkInterface* sink = ResolveSink(packet);
+  const uint32_t ssrc = packet.Ssrc();
+  const bool cacheable = !(use_mid_ && packet.HasExtension<RtpMid>()) &&
+                         !packet.HasExtension<RtpStreamId>() &&
+                         !packet.HasExtension<RepairedRtpStreamId>();
+  RtpPacketSinkInterface* sink = nullptr;
+  if (cacheable) {
+    sink = sink_cache_.Find(ssrc);
+  }
+  if (sink == nullptr) {
+    sink = ResolveSink(packet);
+    // Only cache results that are backed by an SSRC binding; anything else
+    // (e.g. an ambiguous payload type) has to be resolved again next time.
+    const auto it = sink_by_ssrc_.find(ssrc);
+    if (cacheable && sink != nullptr && it != sink_by_ssrc_.end() &&
+        it->second == sink) {
+      sink_cache_.Insert(ssrc, sink);
+    } else if (!cacheable) {
+      sink_cache_.Erase(ssrc);
+    }
+  }
   if (sink != nullptr) {
     sink->OnRtpPacket(packet);
     return true;
@@ -139,9 +139,37 @@ class RtpDemuxer {
 
   // Configure whether to look at the MID header extension when demuxing
   // incoming RTP packets. By default this is enabled.
-  void set_use_mid(bool use_mid) { use_mid_ = use_mid; }
+  void set_use_mid(bool use_mid);
 
  private:
+  // Flat open-addressing map from SSRC to the sink that OnRtpPacket() resolved
+  // for it. Uses linear probing with backward-shift deletion, so lookups touch
+  // a single contiguous run of slots.
+  class SsrcSinkCache {
+   public:
+    SsrcSinkCache();
+    ~SsrcSinkCache();
+
+    // Returns null if |ssrc| is not cached.
+    RtpPacketSinkInterface* Find(uint32_t ssrc) const;
+    void Insert(uint32_t ssrc, RtpPacketSinkInterface* sink);
+    void Erase(uint32_t ssrc);
+    void Clear();
+
+   private:
+    struct Slot {
+      uint32_t ssrc;
+      // Null for empty slots.
+      RtpPacketSinkInterface* sink;
+    };
+
+    size_t HomeSlot(uint32_t ssrc) const;
+    void Grow();
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+  };
+
   // Returns true if adding a sink with the given criteria would cause conflicts
   // with the existing criteria and should be rejected.
   bool CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const;
@@ -202,6 +230,14 @@ class RtpDemuxer {
   // resolved by this object.
   std::vector<SsrcBindingObserver*> ssrc_binding_observers_;
 
+  // Sinks resolved for packets without MID, RSID or RRID header extensions.
+  // Such a packet is routed on its SSRC alone (through the latched
+  // MID/RSID, if any), so once the SSRC is bound to a sink the full
+  // ResolveSink() walk gives the same answer for every following packet.
+  // Cleared whenever sinks are added or removed, and an entry is erased when a
+  // packet carrying header extensions may have changed what was latched.
+  SsrcSinkCache sink_cache_;
+
   bool use_mid_ = true;
 };
 
@@ -1478,6 +1478,61 @@ TEST_F(RtpDemuxerTest, MaliciousPeerCannotCauseMemoryOveruse) {
   }
 }
 
+TEST_F(RtpDemuxerTest, RepeatedPacketsRoutedCorrectlyWithManySsrcSinks) {
+  constexpr size_t kNumSinks = 300;
+  MockRtpPacketSink sinks[kNumSinks];
+  for (size_t i = 0; i < kNumSinks; i++) {
+    // Spaced so that the SSRCs share low bits.
+    ASSERT_TRUE(AddSinkOnlySsrc(rtc::checked_cast<uint32_t>(i << 16),
+                                &sinks[i]));
+  }
+
+  for (int round = 0; round < 3; round++) {
+    for (size_t i = 0; i < kNumSinks; i++) {
+      auto packet = CreatePacketWithSsrc(rtc::checked_cast<uint32_t>(i << 16));
+      EXPECT_CALL(sinks[i], OnRtpPacket(SamePacketAs(*packet))).Times(1);
+      EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+    }
+  }
+
+  for (size_t i = 0; i < kNumSinks; i += 2) {
+    ASSERT_TRUE(RemoveSink(&sinks[i]));
+  }
+  for (size_t i = 0; i < kNumSinks; i++) {
+    auto packet = CreatePacketWithSsrc(rtc::checked_cast<uint32_t>(i << 16));
+    EXPECT_CALL(sinks[i], OnRtpPacket(_)).Times(i % 2 == 0 ? 0 : 1);
+    EXPECT_EQ(i % 2 != 0, demuxer_.OnRtpPacket(*packet));
+  }
+}
+
+TEST_F(RtpDemuxerTest, PacketWithMidRebindsSsrcLatchedByEarlierPackets) {
+  const std::string mid1 = "v1";
+  const std::string mid2 = "v2";
+  constexpr uint32_t ssrc = 10;
+  MockRtpPacketSink sink1;
+  MockRtpPacketSink sink2;
+  AddSinkOnlyMid(mid1, &sink1);
+  AddSinkOnlyMid(mid2, &sink2);
+
+  auto p1 = CreatePacketWithSsrcMid(ssrc, mid1);
+  auto p2 = CreatePacketWithSsrc(ssrc);
+  auto p3 = CreatePacketWithSsrc(ssrc);
+  auto p4 = CreatePacketWithSsrcMid(ssrc, mid2);
+  auto p5 = CreatePacketWithSsrc(ssrc);
+
+  InSequence sequence;
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*p1))).Times(1);
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*p2))).Times(1);
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*p3))).Times(1);
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*p4))).Times(1);
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*p5))).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p1));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p2));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p3));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p4));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p5));
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 TEST_F(RtpDemuxerTest, CriteriaMustBeNonEmpty) {
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/rtp_layer_selector.h"
+
+#include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+
+namespace webrtc {
+
+RtpLayerSelector::PacketInfo RtpLayerSelector::FromVideoHeader(
+    const RTPVideoHeader& header,
+    bool key_frame) {
+  PacketInfo info;
+  info.first_packet_in_frame = header.is_first_packet_in_frame;
+  info.spatial_switch_point = key_frame;
+  info.temporal_switch_point = key_frame;
+  if (header.codec == kVideoCodecVP8) {
+    const RTPVideoHeaderVP8& vp8 = header.vp8();
+    if (vp8.temporalIdx != kNoTemporalIdx) {
+      info.temporal_layer = vp8.temporalIdx;
+      info.temporal_switch_point |= vp8.layerSync;
+    }
+  } else if (header.codec == kVideoCodecVP9) {
+    const RTPVideoHeaderVP9& vp9 =
+        absl::get<RTPVideoHeaderVP9>(header.video_type_header);
+    // Each layer frame of a VP9 picture is a frame here.
+    info.first_packet_in_frame = vp9.beginning_of_frame;
+    info.last_packet_in_frame = vp9.end_of_frame;
+    if (vp9.spatial_idx != kNoSpatialIdx) {
+      info.spatial_layer = vp9.spatial_idx;
+      info.spatial_switch_point |= !vp9.inter_pic_predicted;
+    }
+    if (vp9.temporal_idx != kNoTemporalIdx) {
+      info.temporal_layer = vp9.temporal_idx;
+      info.temporal_switch_point |= vp9.temporal_up_switch;
+    }
+  }
+  return info;
+}
+
+RtpLayerSelector::PacketInfo RtpLayerSelector::FromGenericFrameDescriptor(
+    const RtpGenericFrameDescriptor& descriptor) {
+  PacketInfo info;
+  info.first_packet_in_frame = descriptor.FirstPacketInSubFrame();
+  info.last_packet_in_frame = descriptor.LastPacketInSubFrame();
+  info.has_layers = info.first_packet_in_frame;
+  if (!info.has_layers)
+    return info;
+  const uint8_t spatial_layers = descriptor.SpatialLayersBitmask();
+  while (info.spatial_layer < 7 &&
+         !(spatial_layers & (1 << info.spatial_layer))) {
+    ++info.spatial_layer;
+  }
+  info.temporal_layer = descriptor.TemporalLayer();
+  // The descriptor does not tell which frames the ones after this one depend
+  // on, so only a frame without dependencies is known to be a switch point.
+  const bool independent = descriptor.FrameDependenciesDiffs().empty();
+  info.spatial_switch_point = independent;
+  info.temporal_switch_point = independent;
+  return info;
+}
+
+RtpLayerSelector::RtpLayerSelector() = default;
+
+void RtpLayerSelector::SetLayerBitrates(
+    const VideoBitrateAllocation& layer_bitrates) {
+  layer_bitrates_ = layer_bitrates;
+  has_layer_bitrates_ = true;
+  UpdateTargetLayers();
+}
+
+void RtpLayerSelector::SetBandwidthEstimate(uint32_t bitrate_bps) {
+  bandwidth_estimate_bps_ = bitrate_bps;
+  has_bandwidth_estimate_ = true;
+  UpdateTargetLayers();
+}
+
+void RtpLayerSelector::UpdateTargetLayers() {
+  if (!has_layer_bitrates_ || !has_bandwidth_estimate_)
+    return;
+  // The base layer is forwarded even if it does not fit, the bandwidth
+  // estimator needs it to find out whether the link can take more. Then all
+  // temporal layers of a spatial layer are added before the next spatial
+  // layer, as long as the layers fit.
+  target_spatial_layer_ = 0;
+  target_temporal_layer_ = 0;
+  for (int spatial = 0; spatial < kMaxSpatialLayers; ++spatial) {
+    if (!layer_bitrates_.IsSpatialLayerUsed(spatial))
+      return;
+    for (int temporal = 0; temporal < kMaxTemporalStreams; ++temporal) {
+      if (!layer_bitrates_.HasBitrate(spatial, temporal))
+        break;
+      // Frames of a spatial layer depend on the lower spatial layers of the
+      // same picture, so they are forwarded at the same frame rate.
+      uint64_t bitrate_bps = 0;
+      for (int lower = 0; lower <= spatial; ++lower)
+        bitrate_bps += layer_bitrates_.GetTemporalLayerSum(lower, temporal);
+      if (bitrate_bps > bandwidth_estimate_bps_)
+        return;
+      target_spatial_layer_ = spatial;
+      target_temporal_layer_ = temporal;
+    }
+  }
+}
+
+bool RtpLayerSelector::ShouldForward(const PacketInfo& packet) {
+  if (!packet.has_layers)
+    return forwarding_frame_;
+
+  if (packet.first_packet_in_frame) {
+    // Higher spatial layers depend on the lower ones of the same picture, so
+    // they are only dropped from the start of a picture.
+    if (packet.spatial_layer == 0 &&
+        current_spatial_layer_ > target_spatial_layer_) {
+      current_spatial_layer_ = target_spatial_layer_;
+    }
+    if (packet.spatial_switch_point &&
+        packet.spatial_layer == current_spatial_layer_ + 1 &&
+        packet.spatial_layer <= target_spatial_layer_) {
+      current_spatial_layer_ = packet.spatial_layer;
+    }
+    if (packet.spatial_switch_point && packet.spatial_layer == 0 &&
+        packet.temporal_layer == 0) {
+      // Nothing after a key frame depends on the frames before it.
+      current_temporal_layer_ = target_temporal_layer_;
+    } else if (current_temporal_layer_ > target_temporal_layer_) {
+      current_temporal_layer_ = target_temporal_layer_;
+    } else if (packet.temporal_switch_point &&
+               packet.temporal_layer == current_temporal_layer_ + 1 &&
+               packet.temporal_layer <= target_temporal_layer_) {
+      current_temporal_layer_ = packet.temporal_layer;
+    }
+    frame_spatial_layer_ = packet.spatial_layer;
+    forwarding_frame_ = packet.spatial_layer <= current_spatial_layer_ &&
+                        packet.temporal_layer <= current_temporal_layer_;
+    return forwarding_frame_;
+  }
+  return packet.spatial_layer <= current_spatial_layer_ &&
+         packet.temporal_layer <= current_temporal_layer_;
+}
+
+bool RtpLayerSelector::EndsForwardedPicture(const PacketInfo& packet) const {
+  const int spatial_layer =
+      packet.has_layers ? packet.spatial_layer : frame_spatial_layer_;
+  return packet.last_packet_in_frame &&
+         spatial_layer == current_spatial_layer_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_RTP_LAYER_SELECTOR_H_
+#define CALL_RTP_LAYER_SELECTOR_H_
+
+#include <stdint.h>
+
+#include "api/video/video_bitrate_allocation.h"
+
+namespace webrtc {
+
+class RtpGenericFrameDescriptor;
+struct RTPVideoHeader;
+
+// Decides per packet which spatial and temporal layers of a scalable video
+// stream to forward to one receiver, as many as fit its bandwidth estimate.
+// Layers are switched up only where the receiver can decode the new layer:
+// at key frames, and at the switch points the codecs signal. They are switched
+// down at the start of a frame, or of a picture for spatial layers.
+//
+// The decision takes constant time and does not allocate memory, so that one
+// selector per receiver can run on every forwarded packet.
+class RtpLayerSelector {
+ public:
+  // What the selector needs to know about a packet.
+  struct PacketInfo {
+    // False if the packet does not tell its layers, which is the case for
+    // packets other than the first of a frame with the generic frame
+    // descriptor. They get the same decision as the first packet.
+    bool has_layers = true;
+    int spatial_layer = 0;
+    int temporal_layer = 0;
+    bool first_packet_in_frame = false;
+    bool last_packet_in_frame = false;
+    // The frame does not depend on earlier frames of its spatial layer, e.g.
+    // a key frame.
+    bool spatial_switch_point = false;
+    // The frame does not depend on earlier frames of its temporal layer, e.g.
+    // a VP8 layer sync frame.
+    bool temporal_switch_point = false;
+  };
+
+  // From the header of a VP8 or VP9 packet. Other codecs are treated as a
+  // single layer.
+  static PacketInfo FromVideoHeader(const RTPVideoHeader& header,
+                                    bool key_frame);
+  static PacketInfo FromGenericFrameDescriptor(
+      const RtpGenericFrameDescriptor& descriptor);
+
+  RtpLayerSelector();
+
+  // The bitrate of each layer of the stream, not including the layers below
+  // it. Until this and the estimate are set all layers are forwarded.
+  void SetLayerBitrates(const VideoBitrateAllocation& layer_bitrates);
+  void SetBandwidthEstimate(uint32_t bitrate_bps);
+
+  // Returns whether to forward the packet, updating the forwarded layers if
+  // it is a switch point.
+  bool ShouldForward(const PacketInfo& packet);
+
+  // Whether the forwarded packet for which ShouldForward just returned true
+  // ends the forwarded part of its picture, and should have the marker bit.
+  bool EndsForwardedPicture(const PacketInfo& packet) const;
+
+  // The layers to switch to, and the ones forwarded now, or -1 if none yet.
+  int target_spatial_layer() const { return target_spatial_layer_; }
+  int target_temporal_layer() const { return target_temporal_layer_; }
+  int current_spatial_layer() const { return current_spatial_layer_; }
+  int current_temporal_layer() const { return current_temporal_layer_; }
+
+ private:
+  void UpdateTargetLayers();
+
+  VideoBitrateAllocation layer_bitrates_;
+  bool has_layer_bitrates_ = false;
+  uint32_t bandwidth_estimate_bps_ = 0;
+  bool has_bandwidth_estimate_ = false;
+  int target_spatial_layer_ = kMaxSpatialLayers - 1;
+  int target_temporal_layer_ = kMaxTemporalStreams - 1;
+  int current_spatial_layer_ = -1;
+  int current_temporal_layer_ = -1;
+  // The decision for the frame of the last packet that told its layers.
+  bool forwarding_frame_ = false;
+  int frame_spatial_layer_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_RTP_LAYER_SELECTOR_H_
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/rtp_layer_selector.h"
+
+#include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+RtpLayerSelector::PacketInfo Frame(int spatial_layer,
+                                   int temporal_layer,
+                                   bool switch_point) {
+  RtpLayerSelector::PacketInfo info;
+  info.spatial_layer = spatial_layer;
+  info.temporal_layer = temporal_layer;
+  info.first_packet_in_frame = true;
+  info.last_packet_in_frame = true;
+  info.spatial_switch_point = switch_point;
+  info.temporal_switch_point = switch_point;
+  return info;
+}
+
+RtpLayerSelector::PacketInfo KeyFrame() {
+  return Frame(0, 0, true);
+}
+
+// Three temporal layers of 100, 50 and 50 kbps.
+VideoBitrateAllocation TemporalLayerBitrates() {
+  VideoBitrateAllocation bitrates;
+  bitrates.SetBitrate(0, 0, 100000);
+  bitrates.SetBitrate(0, 1, 50000);
+  bitrates.SetBitrate(0, 2, 50000);
+  return bitrates;
+}
+
+TEST(RtpLayerSelectorTest, ForwardsAllLayersFromKeyFrameWithoutEstimate) {
+  RtpLayerSelector selector;
+  EXPECT_FALSE(selector.ShouldForward(Frame(0, 0, false)));
+  EXPECT_TRUE(selector.ShouldForward(KeyFrame()));
+  EXPECT_TRUE(selector.ShouldForward(Frame(0, 2, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(1, 0, true)));
+}
+
+TEST(RtpLayerSelectorTest, SelectsLayersThatFitEstimate) {
+  RtpLayerSelector selector;
+  selector.SetLayerBitrates(TemporalLayerBitrates());
+  selector.SetBandwidthEstimate(170000);
+  EXPECT_EQ(0, selector.target_spatial_layer());
+  EXPECT_EQ(1, selector.target_temporal_layer());
+
+  // The base layer is forwarded even if it does not fit.
+  selector.SetBandwidthEstimate(10000);
+  EXPECT_EQ(0, selector.target_temporal_layer());
+
+  VideoBitrateAllocation bitrates = TemporalLayerBitrates();
+  bitrates.SetBitrate(1, 0, 300000);
+  bitrates.SetBitrate(1, 1, 150000);
+  selector.SetLayerBitrates(bitrates);
+  // A spatial layer needs its lower layer at the same frame rate.
+  selector.SetBandwidthEstimate(450000);
+  EXPECT_EQ(1, selector.target_spatial_layer());
+  EXPECT_EQ(0, selector.target_temporal_layer());
+  selector.SetBandwidthEstimate(650000);
+  EXPECT_EQ(1, selector.target_spatial_layer());
+  EXPECT_EQ(1, selector.target_temporal_layer());
+}
+
+TEST(RtpLayerSelectorTest, SwitchesTemporalLayerUpAtSwitchPoints) {
+  RtpLayerSelector selector;
+  selector.SetLayerBitrates(TemporalLayerBitrates());
+  selector.SetBandwidthEstimate(100000);
+  EXPECT_TRUE(selector.ShouldForward(KeyFrame()));
+  EXPECT_FALSE(selector.ShouldForward(Frame(0, 1, false)));
+  EXPECT_EQ(0, selector.current_temporal_layer());
+
+  selector.SetBandwidthEstimate(1000000);
+  EXPECT_FALSE(selector.ShouldForward(Frame(0, 2, true)));
+  EXPECT_FALSE(selector.ShouldForward(Frame(0, 1, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(0, 0, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(0, 1, true)));
+  EXPECT_EQ(1, selector.current_temporal_layer());
+  EXPECT_TRUE(selector.ShouldForward(Frame(0, 2, true)));
+  EXPECT_EQ(2, selector.current_temporal_layer());
+}
+
+TEST(RtpLayerSelectorTest, SwitchesTemporalLayerDownAtNextFrame) {
+  RtpLayerSelector selector;
+  selector.SetLayerBitrates(TemporalLayerBitrates());
+  selector.SetBandwidthEstimate(1000000);
+  EXPECT_TRUE(selector.ShouldForward(KeyFrame()));
+  RtpLayerSelector::PacketInfo first_packet = Frame(0, 2, false);
+  first_packet.last_packet_in_frame = false;
+  EXPECT_TRUE(selector.ShouldForward(first_packet));
+
+  selector.SetBandwidthEstimate(100000);
+  // The rest of the frame is still forwarded.
+  RtpLayerSelector::PacketInfo last_packet = Frame(0, 2, false);
+  last_packet.first_packet_in_frame = false;
+  EXPECT_TRUE(selector.ShouldForward(last_packet));
+  EXPECT_FALSE(selector.ShouldForward(Frame(0, 1, false)));
+  EXPECT_EQ(0, selector.current_temporal_layer());
+}
+
+TEST(RtpLayerSelectorTest, SwitchesSpatialLayersAtPictureStart) {
+  VideoBitrateAllocation bitrates;
+  bitrates.SetBitrate(0, 0, 100000);
+  bitrates.SetBitrate(1, 0, 200000);
+  bitrates.SetBitrate(2, 0, 400000);
+  RtpLayerSelector selector;
+  selector.SetLayerBitrates(bitrates);
+  selector.SetBandwidthEstimate(300000);
+  EXPECT_TRUE(selector.ShouldForward(KeyFrame()));
+  EXPECT_TRUE(selector.ShouldForward(Frame(1, 0, true)));
+  EXPECT_FALSE(selector.ShouldForward(Frame(2, 0, true)));
+  EXPECT_EQ(1, selector.current_spatial_layer());
+
+  // Up one layer at a time, where the layer does not depend on earlier
+  // pictures.
+  selector.SetBandwidthEstimate(1000000);
+  EXPECT_TRUE(selector.ShouldForward(Frame(0, 0, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(1, 0, false)));
+  EXPECT_FALSE(selector.ShouldForward(Frame(2, 0, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(0, 0, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(1, 0, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(2, 0, true)));
+  EXPECT_EQ(2, selector.current_spatial_layer());
+
+  // Down at the next picture.
+  selector.SetBandwidthEstimate(100000);
+  EXPECT_TRUE(selector.ShouldForward(Frame(1, 0, false)));
+  EXPECT_TRUE(selector.ShouldForward(Frame(0, 0, false)));
+  EXPECT_FALSE(selector.ShouldForward(Frame(1, 0, false)));
+  EXPECT_EQ(0, selector.current_spatial_layer());
+}
+
+TEST(RtpLayerSelectorTest, EndsPictureAtHighestForwardedSpatialLayer) {
+  VideoBitrateAllocation bitrates;
+  bitrates.SetBitrate(0, 0, 100000);
+  bitrates.SetBitrate(1, 0, 200000);
+  RtpLayerSelector selector;
+  selector.SetLayerBitrates(bitrates);
+  selector.SetBandwidthEstimate(100000);
+  const RtpLayerSelector::PacketInfo base = KeyFrame();
+  EXPECT_TRUE(selector.ShouldForward(base));
+  EXPECT_TRUE(selector.EndsForwardedPicture(base));
+
+  selector.SetBandwidthEstimate(300000);
+  EXPECT_TRUE(selector.ShouldForward(Frame(1, 0, true)));
+  EXPECT_FALSE(selector.EndsForwardedPicture(base));
+}
+
+TEST(RtpLayerSelectorTest, ReadsVp8TemporalLayers) {
+  RTPVideoHeader header;
+  header.codec = kVideoCodecVP8;
+  header.is_first_packet_in_frame = true;
+  header.vp8().InitRTPVideoHeaderVP8();
+  header.vp8().temporalIdx = 2;
+  header.vp8().layerSync = true;
+  RtpLayerSelector::PacketInfo info =
+      RtpLayerSelector::FromVideoHeader(header, false);
+  EXPECT_TRUE(info.has_layers);
+  EXPECT_TRUE(info.first_packet_in_frame);
+  EXPECT_EQ(0, info.spatial_layer);
+  EXPECT_EQ(2, info.temporal_layer);
+  EXPECT_TRUE(info.temporal_switch_point);
+  EXPECT_FALSE(info.spatial_switch_point);
+}
+
+TEST(RtpLayerSelectorTest, ReadsVp9Layers) {
+  RTPVideoHeader header;
+  header.codec = kVideoCodecVP9;
+  RTPVideoHeaderVP9 vp9;
+  vp9.InitRTPVideoHeaderVP9();
+  vp9.beginning_of_frame = true;
+  vp9.end_of_frame = true;
+  vp9.spatial_idx = 1;
+  vp9.temporal_idx = 1;
+  vp9.inter_pic_predicted = false;
+  header.video_type_header = vp9;
+  RtpLayerSelector::PacketInfo info =
+      RtpLayerSelector::FromVideoHeader(header, false);
+  EXPECT_TRUE(info.first_packet_in_frame);
+  EXPECT_TRUE(info.last_packet_in_frame);
+  EXPECT_EQ(1, info.spatial_layer);
+  EXPECT_EQ(1, info.temporal_layer);
+  EXPECT_TRUE(info.spatial_switch_point);
+  EXPECT_FALSE(info.temporal_switch_point);
+}
+
+TEST(RtpLayerSelectorTest, ReadsGenericFrameDescriptor) {
+  RtpGenericFrameDescriptor descriptor;
+  descriptor.SetFirstPacketInSubFrame(true);
+  descriptor.SetSpatialLayersBitmask(0x06);
+  descriptor.SetTemporalLayer(2);
+  descriptor.AddFrameDependencyDiff(1);
+  RtpLayerSelector::PacketInfo info =
+      RtpLayerSelector::FromGenericFrameDescriptor(descriptor);
+  EXPECT_TRUE(info.has_layers);
+  EXPECT_EQ(1, info.spatial_layer);
+  EXPECT_EQ(2, info.temporal_layer);
+  EXPECT_FALSE(info.spatial_switch_point);
+
+  RtpGenericFrameDescriptor last_packet;
+  last_packet.SetLastPacketInSubFrame(true);
+  info = RtpLayerSelector::FromGenericFrameDescriptor(last_packet);
+  EXPECT_FALSE(info.has_layers);
+  EXPECT_TRUE(info.last_packet_in_frame);
+}
+
+TEST(RtpLayerSelectorTest, PacketsWithoutLayersFollowTheirFrame) {
+  RtpLayerSelector selector;
+  selector.SetLayerBitrates(TemporalLayerBitrates());
+  selector.SetBandwidthEstimate(100000);
+  RtpLayerSelector::PacketInfo rest_of_frame;
+  rest_of_frame.has_layers = false;
+  EXPECT_TRUE(selector.ShouldForward(KeyFrame()));
+  EXPECT_TRUE(selector.ShouldForward(rest_of_frame));
+  EXPECT_FALSE(selector.ShouldForward(Frame(0, 1, false)));
+  EXPECT_FALSE(selector.ShouldForward(rest_of_frame));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -77,6 +77,7 @@ void PopulateRtpWithCodecSpecifics(const CodecSpecificInfo& info,
       return;
     }
     case kVideoCodecMultiplex:
+    case kVideoCodecAV1:
     case kVideoCodecGeneric:
       rtp->codec = kVideoCodecGeneric;
       rtp->simulcastIdx = info.codecSpecific.generic.simulcast_idx;
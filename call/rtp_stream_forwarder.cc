@@ -0,0 +1,342 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/rtp_stream_forwarder.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+
+#include "api/call/transport.h"
+#include "modules/include/module_common_types_public.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "modules/rtp_rtcp/source/rtp_format.h"
+#include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
+#include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+
+namespace {
+
+// The RTP clock rate of video.
+constexpr int64_t kVideoPayloadTypeFrequencyKhz = 90;
+
+// Writes |picture_id| and |tl0_pic_idx| into the fields the VP8 payload
+// descriptor at the start of |payload| has, keeping the size of the picture
+// id field. The descriptor was validated by the depacketizer.
+void RewriteVp8PayloadDescriptor(uint16_t picture_id,
+                                 uint8_t tl0_pic_idx,
+                                 rtc::ArrayView<uint8_t> payload) {
+  const bool has_extension = payload[0] & 0x80;
+  if (!has_extension)
+    return;
+  const bool has_picture_id = payload[1] & 0x80;
+  const bool has_tl0_pic_idx = payload[1] & 0x40;
+  size_t offset = 2;
+  if (has_picture_id) {
+    if (payload[offset] & 0x80) {
+      payload[offset] = 0x80 | ((picture_id >> 8) & 0x7F);
+      payload[offset + 1] = picture_id & 0xFF;
+      offset += 2;
+    } else {
+      payload[offset] = picture_id & 0x7F;
+      offset += 1;
+    }
+  }
+  if (has_tl0_pic_idx)
+    payload[offset] = tl0_pic_idx;
+}
+
+}  // namespace
+
+RtpStreamForwarder::Config::Config() = default;
+RtpStreamForwarder::Config::Config(const Config&) = default;
+RtpStreamForwarder::Config::~Config() = default;
+
+RtpStreamForwarder::RtpStreamForwarder(const Config& config,
+                                       const RtpPayloadState* state)
+    : config_(config),
+      depacketizer_(RtpDepacketizer::Create(config.codec_type)) {
+  RTC_DCHECK(config_.transport);
+  RTC_DCHECK(!config_.input_ssrcs.empty());
+  Random random(rtc::TimeMicros());
+  payload_state_.picture_id =
+      state ? state->picture_id : (random.Rand<int16_t>() & 0x7FFF);
+  payload_state_.tl0_pic_idx =
+      state ? state->tl0_pic_idx : (random.Rand<uint8_t>());
+}
+
+RtpStreamForwarder::~RtpStreamForwarder() = default;
+
+void RtpStreamForwarder::SetLayer(size_t layer) {
+  RTC_DCHECK_LT(layer, config_.input_ssrcs.size());
+  {
+    rtc::CritScope lock(&crit_);
+    target_layer_ = layer;
+    if (target_layer_ == current_layer_)
+      return;
+  }
+  if (config_.feedback_observer)
+    config_.feedback_observer->OnKeyFrameRequest(config_.input_ssrcs[layer]);
+}
+
+int RtpStreamForwarder::current_layer() const {
+  rtc::CritScope lock(&crit_);
+  return current_layer_;
+}
+
+RtpPayloadState RtpStreamForwarder::payload_state() const {
+  rtc::CritScope lock(&crit_);
+  return payload_state_;
+}
+
+int RtpStreamForwarder::LayerOfSsrc(uint32_t ssrc) const {
+  auto it = std::find(config_.input_ssrcs.begin(), config_.input_ssrcs.end(),
+                      ssrc);
+  if (it == config_.input_ssrcs.end())
+    return -1;
+  return it - config_.input_ssrcs.begin();
+}
+
+void RtpStreamForwarder::OnRtpPacket(const RtpPacketReceived& packet) {
+  const int layer = LayerOfSsrc(packet.Ssrc());
+  if (layer < 0)
+    return;
+
+  // Padding only packets are probes of the link to the forwarder, and are
+  // dropped like packets of layers the receivers do not get.
+  RtpDepacketizer::ParsedPayload parsed_payload;
+  parsed_payload.frame_type = kVideoFrameDelta;
+  const bool has_payload =
+      packet.payload_size() > 0 &&
+      depacketizer_->Parse(&parsed_payload, packet.payload().data(),
+                           packet.payload_size());
+
+  rtc::CritScope lock(&crit_);
+  if (layer != current_layer_) {
+    if (!has_payload || layer != target_layer_ ||
+        parsed_payload.frame_type != kVideoFrameKey ||
+        !parsed_payload.video_header().is_first_packet_in_frame) {
+      return;
+    }
+    SwitchTo(layer, packet);
+  }
+
+  bool forward = has_payload;
+  bool marker = packet.Marker();
+  if (forward && config_.layer_selector) {
+    RtpGenericFrameDescriptor descriptor;
+    RtpLayerSelector::PacketInfo info =
+        packet.GetExtension<RtpGenericFrameDescriptorExtension>(&descriptor)
+            ? RtpLayerSelector::FromGenericFrameDescriptor(descriptor)
+            : RtpLayerSelector::FromVideoHeader(
+                  parsed_payload.video_header(),
+                  parsed_payload.frame_type == kVideoFrameKey);
+    info.last_packet_in_frame |= packet.Marker();
+    forward = config_.layer_selector->ShouldForward(info);
+    marker = config_.layer_selector->EndsForwardedPicture(info);
+  }
+  uint16_t sequence_number;
+  if (!MapSequenceNumber(packet.SequenceNumber(), forward, &sequence_number))
+    return;
+
+  RtpPacket forwarded(nullptr, packet.size());
+  forwarded.CopyHeaderFrom(packet);
+  uint8_t* payload = forwarded.AllocatePayload(packet.payload_size());
+  if (!payload)
+    return;
+  memcpy(payload, packet.payload().data(), packet.payload_size());
+
+  const uint32_t timestamp = packet.Timestamp() + timestamp_offset_;
+  forwarded.SetSsrc(config_.ssrc);
+  forwarded.SetSequenceNumber(sequence_number);
+  forwarded.SetTimestamp(timestamp);
+  forwarded.SetMarker(marker);
+
+  if (config_.codec_type == kVideoCodecVP8) {
+    // Like RtpPayloadParams, advance the picture id on every new picture and
+    // the tl0 pic idx on every new base layer frame of the input.
+    const RTPVideoHeaderVP8& vp8 = parsed_payload.video_header().vp8();
+    if (vp8.pictureId != kNoPictureId && vp8.pictureId != input_picture_id_) {
+      payload_state_.picture_id =
+          (static_cast<uint16_t>(payload_state_.picture_id) + 1) & 0x7FFF;
+      input_picture_id_ = vp8.pictureId;
+    }
+    if (vp8.tl0PicIdx != kNoTl0PicIdx && vp8.tl0PicIdx != input_tl0_pic_idx_) {
+      ++payload_state_.tl0_pic_idx;
+      input_tl0_pic_idx_ = vp8.tl0PicIdx;
+    }
+    RewriteVp8PayloadDescriptor(
+        payload_state_.picture_id, payload_state_.tl0_pic_idx,
+        rtc::ArrayView<uint8_t>(payload, packet.payload_size()));
+  }
+
+  if (IsNewerSequenceNumber(sequence_number, last_sequence_number_))
+    last_sequence_number_ = sequence_number;
+  if (IsNewerTimestamp(timestamp, last_timestamp_)) {
+    last_timestamp_ = timestamp;
+    last_arrival_time_ms_ = packet.arrival_time_ms();
+  }
+  HistoryEntry& entry = history_[sequence_number % kHistorySize];
+  entry.valid = true;
+  entry.sequence_number = sequence_number;
+  entry.input_ssrc = packet.Ssrc();
+  entry.input_sequence_number = packet.SequenceNumber();
+
+  config_.transport->SendRtp(forwarded.data(), forwarded.size(),
+                             PacketOptions());
+}
+
+bool RtpStreamForwarder::MapSequenceNumber(uint16_t input_sequence_number,
+                                           bool forward,
+                                           uint16_t* sequence_number) {
+  if (has_last_input_sequence_number_ &&
+      !IsNewerSequenceNumber(input_sequence_number,
+                             last_input_sequence_number_)) {
+    // A reordered or retransmitted packet. Packets that were not dropped
+    // keep the sequence number they got, or would have got, when their
+    // successors were forwarded.
+    const InputEntry& entry =
+        input_history_[input_sequence_number % kHistorySize];
+    if (!forward || !entry.valid ||
+        entry.input_sequence_number != input_sequence_number ||
+        entry.dropped) {
+      return false;
+    }
+    *sequence_number = input_sequence_number + entry.offset;
+    return true;
+  }
+
+  if (has_last_input_sequence_number_) {
+    // Packets missing on the input may still arrive, and are forwarded with
+    // the offset from before the packets after them were dropped.
+    const uint16_t missing =
+        input_sequence_number - last_input_sequence_number_ - 1;
+    for (uint16_t i = std::min<uint16_t>(missing, kHistorySize - 1); i > 0;
+         --i) {
+      InputEntry& entry =
+          input_history_[static_cast<uint16_t>(input_sequence_number - i) %
+                         kHistorySize];
+      entry.valid = true;
+      entry.input_sequence_number = input_sequence_number - i;
+      entry.offset = sequence_number_offset_;
+      entry.dropped = false;
+    }
+  }
+  has_last_input_sequence_number_ = true;
+  last_input_sequence_number_ = input_sequence_number;
+
+  InputEntry& entry = input_history_[input_sequence_number % kHistorySize];
+  entry.valid = true;
+  entry.input_sequence_number = input_sequence_number;
+  entry.offset = sequence_number_offset_;
+  entry.dropped = !forward;
+  if (!forward) {
+    // Leave no gap for the receivers to ask retransmissions for.
+    --sequence_number_offset_;
+    return false;
+  }
+  *sequence_number = input_sequence_number + sequence_number_offset_;
+  return true;
+}
+
+void RtpStreamForwarder::SwitchTo(int layer, const RtpPacketReceived& packet) {
+  if (current_layer_ >= 0) {
+    // Continue right after the last forwarded packet, with the timestamp
+    // advanced by the time since then.
+    sequence_number_offset_ =
+        last_sequence_number_ + 1 - packet.SequenceNumber();
+    const int64_t elapsed_ms =
+        std::max<int64_t>(packet.arrival_time_ms() - last_arrival_time_ms_, 0);
+    const uint32_t elapsed = std::max<int64_t>(
+        elapsed_ms * kVideoPayloadTypeFrequencyKhz, 1);
+    timestamp_offset_ = last_timestamp_ + elapsed - packet.Timestamp();
+  } else {
+    last_sequence_number_ = packet.SequenceNumber() - 1;
+    last_timestamp_ = packet.Timestamp();
+  }
+  RTC_LOG(LS_INFO) << "Forwarding layer " << layer << " (ssrc "
+                   << packet.Ssrc() << ") as ssrc " << config_.ssrc;
+  current_layer_ = layer;
+  has_last_input_sequence_number_ = false;
+  input_history_.fill(InputEntry());
+  input_picture_id_ = -1;
+  input_tl0_pic_idx_ = -1;
+}
+
+void RtpStreamForwarder::OnRtcpPacket(rtc::ArrayView<const uint8_t> packet) {
+  bool key_frame_requested = false;
+  rtcp::CommonHeader rtcp_block;
+  for (const uint8_t* next_block = packet.begin(); next_block != packet.end();
+       next_block = rtcp_block.NextPacket()) {
+    if (!rtcp_block.Parse(next_block, packet.end() - next_block))
+      break;
+    if (rtcp_block.type() == rtcp::Rtpfb::kPacketType &&
+        rtcp_block.fmt() == rtcp::Nack::kFeedbackMessageType) {
+      rtcp::Nack nack;
+      if (nack.Parse(rtcp_block) && nack.media_ssrc() == config_.ssrc)
+        HandleNack(nack.packet_ids());
+    } else if (rtcp_block.type() == rtcp::Psfb::kPacketType &&
+               rtcp_block.fmt() == rtcp::Pli::kFeedbackMessageType) {
+      rtcp::Pli pli;
+      if (pli.Parse(rtcp_block) && pli.media_ssrc() == config_.ssrc)
+        key_frame_requested = true;
+    } else if (rtcp_block.type() == rtcp::Psfb::kPacketType &&
+               rtcp_block.fmt() == rtcp::Fir::kFeedbackMessageType) {
+      rtcp::Fir fir;
+      if (!fir.Parse(rtcp_block))
+        continue;
+      for (const rtcp::Fir::Request& request : fir.requests()) {
+        if (request.ssrc == config_.ssrc)
+          key_frame_requested = true;
+      }
+    }
+  }
+  if (!key_frame_requested || !config_.feedback_observer)
+    return;
+
+  int layer;
+  {
+    rtc::CritScope lock(&crit_);
+    // A pending switch waits for a key frame of the target layer anyway.
+    layer = current_layer_ >= 0 ? current_layer_ : target_layer_;
+  }
+  config_.feedback_observer->OnKeyFrameRequest(config_.input_ssrcs[layer]);
+}
+
+void RtpStreamForwarder::HandleNack(
+    const std::vector<uint16_t>& sequence_numbers) {
+  if (!config_.feedback_observer)
+    return;
+  std::map<uint32_t, std::vector<uint16_t>> nacks;
+  {
+    rtc::CritScope lock(&crit_);
+    for (uint16_t sequence_number : sequence_numbers) {
+      const HistoryEntry& entry = history_[sequence_number % kHistorySize];
+      if (!entry.valid || entry.sequence_number != sequence_number)
+        continue;
+      nacks[entry.input_ssrc].push_back(entry.input_sequence_number);
+    }
+  }
+  for (const auto& nack : nacks)
+    config_.feedback_observer->OnNack(nack.first, nack.second);
+}
+
+}  // namespace webrtc
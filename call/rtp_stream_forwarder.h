@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_RTP_STREAM_FORWARDER_H_
+#define CALL_RTP_STREAM_FORWARDER_H_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "call/rtp_config.h"
+#include "call/rtp_layer_selector.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "common_types.h"  // NOLINT(build/include)
+#include "rtc_base/criticalsection.h"
+
+namespace webrtc {
+
+class RtpDepacketizer;
+class Transport;
+
+// Forwards one of a set of received video streams, typically the simulcast
+// layers of a remote sender, as a single stream without decoding it, like a
+// selective forwarding unit does. The SSRC, sequence numbers and timestamps
+// are rewritten so that the receiver sees one continuous stream across layer
+// switches, and so are the VP8 picture id and tl0 pic idx, which continue
+// like RtpPayloadParams would continue them. Switches happen at key frames of
+// the new layer. With a RtpLayerSelector, the forwarded stream is thinned
+// further to the temporal and spatial layers it selects, with the sequence
+// numbers of the dropped packets left out.
+//
+// Register the forwarder as the sink of the input SSRCs, e.g. with
+// RtpDemuxer::AddSink, and give it the RTCP received from the receivers of
+// the forwarded stream. Their NACKs and key frame requests are translated to
+// the input stream they refer to and passed to the FeedbackObserver.
+class RtpStreamForwarder : public RtpPacketSinkInterface {
+ public:
+  class FeedbackObserver {
+   public:
+    // |ssrc| is the input stream the receivers want a key frame of.
+    virtual void OnKeyFrameRequest(uint32_t ssrc) = 0;
+    // |sequence_numbers| are those of the input stream |ssrc|.
+    virtual void OnNack(uint32_t ssrc,
+                        const std::vector<uint16_t>& sequence_numbers) = 0;
+
+   protected:
+    virtual ~FeedbackObserver() = default;
+  };
+
+  struct Config {
+    Config();
+    Config(const Config&);
+    ~Config();
+
+    // The SSRCs of the input streams, one per layer, lowest quality first.
+    std::vector<uint32_t> input_ssrcs;
+    // The SSRC of the forwarded stream.
+    uint32_t ssrc = 0;
+    VideoCodecType codec_type = kVideoCodecGeneric;
+    Transport* transport = nullptr;
+    FeedbackObserver* feedback_observer = nullptr;
+    // If set, only the spatial and temporal layers of the forwarded stream
+    // it selects are forwarded. Not owned, and only used on the thread
+    // packets are received on.
+    RtpLayerSelector* layer_selector = nullptr;
+  };
+
+  // |state| continues the picture id and tl0 pic idx of a previous sender of
+  // the forwarded stream, if not null.
+  RtpStreamForwarder(const Config& config, const RtpPayloadState* state);
+  ~RtpStreamForwarder() override;
+
+  // Forwards |layer|, an index in Config::input_ssrcs, from its next key
+  // frame on. A key frame is requested from it.
+  void SetLayer(size_t layer);
+
+  // Returns the layer currently forwarded, or -1 if none is yet.
+  int current_layer() const;
+
+  // Implements RtpPacketSinkInterface.
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+  // Handles RTCP from the receivers of the forwarded stream.
+  void OnRtcpPacket(rtc::ArrayView<const uint8_t> packet);
+
+  RtpPayloadState payload_state() const;
+
+ private:
+  // Maps a forwarded sequence number back to the input stream.
+  struct HistoryEntry {
+    bool valid = false;
+    uint16_t sequence_number = 0;
+    uint32_t input_ssrc = 0;
+    uint16_t input_sequence_number = 0;
+  };
+  // Maps an input sequence number of the forwarded layer to the offset to
+  // the forwarded sequence number.
+  struct InputEntry {
+    bool valid = false;
+    uint16_t input_sequence_number = 0;
+    uint16_t offset = 0;
+    bool dropped = false;
+  };
+  static constexpr size_t kHistorySize = 1024;
+
+  int LayerOfSsrc(uint32_t ssrc) const;
+  void SwitchTo(int layer, const RtpPacketReceived& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns false if the packet is not forwarded, e.g. because it is dropped
+  // or was dropped before, and else the forwarded |sequence_number|.
+  bool MapSequenceNumber(uint16_t input_sequence_number,
+                         bool forward,
+                         uint16_t* sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void HandleNack(const std::vector<uint16_t>& sequence_numbers);
+
+  const Config config_;
+  const std::unique_ptr<RtpDepacketizer> depacketizer_;
+
+  rtc::CriticalSection crit_;
+  int current_layer_ RTC_GUARDED_BY(crit_) = -1;
+  int target_layer_ RTC_GUARDED_BY(crit_) = 0;
+  uint16_t sequence_number_offset_ RTC_GUARDED_BY(crit_) = 0;
+  uint32_t timestamp_offset_ RTC_GUARDED_BY(crit_) = 0;
+  uint16_t last_sequence_number_ RTC_GUARDED_BY(crit_) = 0;
+  uint32_t last_timestamp_ RTC_GUARDED_BY(crit_) = 0;
+  int64_t last_arrival_time_ms_ RTC_GUARDED_BY(crit_) = 0;
+  RtpPayloadState payload_state_ RTC_GUARDED_BY(crit_);
+  // The picture id and tl0 pic idx last seen on the input, to tell when they
+  // advance.
+  int input_picture_id_ RTC_GUARDED_BY(crit_) = -1;
+  int input_tl0_pic_idx_ RTC_GUARDED_BY(crit_) = -1;
+  std::array<HistoryEntry, kHistorySize> history_ RTC_GUARDED_BY(crit_);
+  bool has_last_input_sequence_number_ RTC_GUARDED_BY(crit_) = false;
+  uint16_t last_input_sequence_number_ RTC_GUARDED_BY(crit_) = 0;
+  std::array<InputEntry, kHistorySize> input_history_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_RTP_STREAM_FORWARDER_H_
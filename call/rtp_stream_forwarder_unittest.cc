@@ -0,0 +1,256 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/rtp_stream_forwarder.h"
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/call/transport.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::_;
+
+constexpr uint32_t kLowSsrc = 1111;
+constexpr uint32_t kHighSsrc = 2222;
+constexpr uint32_t kForwardedSsrc = 3333;
+constexpr uint32_t kReceiverSsrc = 4444;
+
+class MockFeedbackObserver : public RtpStreamForwarder::FeedbackObserver {
+ public:
+  MOCK_METHOD1(OnKeyFrameRequest, void(uint32_t ssrc));
+  MOCK_METHOD2(OnNack,
+               void(uint32_t ssrc,
+                    const std::vector<uint16_t>& sequence_numbers));
+};
+
+class RecordingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    RtpPacketReceived parsed;
+    EXPECT_TRUE(parsed.Parse(packet, length));
+    packets.push_back(parsed);
+    return true;
+  }
+  bool SendRtcp(const uint8_t* packet, size_t length) override { return true; }
+
+  std::vector<RtpPacketReceived> packets;
+};
+
+// A VP8 packet with a 15 bit picture id and a tl0 pic idx, starting a frame.
+RtpPacketReceived CreateVp8Packet(uint32_t ssrc,
+                                  uint16_t sequence_number,
+                                  uint32_t timestamp,
+                                  uint16_t picture_id,
+                                  uint8_t tl0_pic_idx,
+                                  bool key_frame,
+                                  int64_t arrival_time_ms) {
+  RtpPacketReceived packet;
+  packet.SetPayloadType(96);
+  packet.SetSsrc(ssrc);
+  packet.SetSequenceNumber(sequence_number);
+  packet.SetTimestamp(timestamp);
+  packet.set_arrival_time_ms(arrival_time_ms);
+  uint8_t* payload = packet.AllocatePayload(15);
+  memset(payload, 0, 15);
+  payload[0] = 0x90;  // X and S bits, partition 0.
+  payload[1] = 0xC0;  // I and L bits.
+  payload[2] = 0x80 | (picture_id >> 8);
+  payload[3] = picture_id & 0xFF;
+  payload[4] = tl0_pic_idx;
+  payload[5] = key_frame ? 0x00 : 0x01;  // The inverse key frame flag.
+  return packet;
+}
+
+// A VP8 packet of temporal layer |temporal_idx|, a full frame.
+RtpPacketReceived CreateVp8TemporalLayerPacket(uint16_t sequence_number,
+                                               uint32_t timestamp,
+                                               uint8_t tl0_pic_idx,
+                                               int temporal_idx,
+                                               bool key_frame) {
+  RtpPacketReceived packet;
+  packet.SetPayloadType(96);
+  packet.SetSsrc(kLowSsrc);
+  packet.SetSequenceNumber(sequence_number);
+  packet.SetTimestamp(timestamp);
+  packet.SetMarker(true);
+  uint8_t* payload = packet.AllocatePayload(16);
+  memset(payload, 0, 16);
+  payload[0] = 0x90;  // X and S bits, partition 0.
+  payload[1] = 0xE0;  // I, L and T bits.
+  payload[2] = 0x80 | (sequence_number >> 8);
+  payload[3] = sequence_number & 0xFF;
+  payload[4] = tl0_pic_idx;
+  payload[5] = temporal_idx << 6;
+  payload[6] = key_frame ? 0x00 : 0x01;  // The inverse key frame flag.
+  return packet;
+}
+
+uint16_t PictureId(const RtpPacketReceived& packet) {
+  return ((packet.payload()[2] & 0x7F) << 8) | packet.payload()[3];
+}
+
+class RtpStreamForwarderTest : public ::testing::Test {
+ protected:
+  RtpStreamForwarderTest() {
+    RtpStreamForwarder::Config config;
+    config.input_ssrcs = {kLowSsrc, kHighSsrc};
+    config.ssrc = kForwardedSsrc;
+    config.codec_type = kVideoCodecVP8;
+    config.transport = &transport_;
+    config.feedback_observer = &feedback_observer_;
+    RtpPayloadState state;
+    state.picture_id = 100;
+    state.tl0_pic_idx = 10;
+    forwarder_.reset(new RtpStreamForwarder(config, &state));
+  }
+
+  RecordingTransport transport_;
+  ::testing::NiceMock<MockFeedbackObserver> feedback_observer_;
+  std::unique_ptr<RtpStreamForwarder> forwarder_;
+};
+
+TEST_F(RtpStreamForwarderTest, WaitsForKeyFrame) {
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kLowSsrc, 10, 9000, 500, 50, false, 1000));
+  EXPECT_TRUE(transport_.packets.empty());
+  EXPECT_EQ(-1, forwarder_->current_layer());
+
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kLowSsrc, 11, 12000, 501, 51, true, 1033));
+  ASSERT_EQ(1u, transport_.packets.size());
+  EXPECT_EQ(0, forwarder_->current_layer());
+  EXPECT_EQ(kForwardedSsrc, transport_.packets[0].Ssrc());
+  EXPECT_EQ(11, transport_.packets[0].SequenceNumber());
+  EXPECT_EQ(12000u, transport_.packets[0].Timestamp());
+  EXPECT_EQ(101, PictureId(transport_.packets[0]));
+  EXPECT_EQ(11, transport_.packets[0].payload()[4]);
+}
+
+TEST_F(RtpStreamForwarderTest, SwitchesLayersAtKeyFrameAndKeepsContinuity) {
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kLowSsrc, 10, 9000, 500, 50, true, 1000));
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kLowSsrc, 11, 12000, 501, 51, false, 1033));
+
+  EXPECT_CALL(feedback_observer_, OnKeyFrameRequest(kHighSsrc));
+  forwarder_->SetLayer(1);
+  // Delta frames of the new layer, and the old layer until the switch.
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kHighSsrc, 60000, 3000000, 7000, 200, false, 1050));
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kLowSsrc, 12, 15000, 502, 52, false, 1066));
+  ASSERT_EQ(3u, transport_.packets.size());
+  EXPECT_EQ(0, forwarder_->current_layer());
+
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kHighSsrc, 60001, 3003000, 7001, 201, true, 1100));
+  EXPECT_EQ(1, forwarder_->current_layer());
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kLowSsrc, 13, 18000, 503, 53, false, 1100));
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kHighSsrc, 60002, 3006000, 7002, 202, false, 1133));
+
+  ASSERT_EQ(5u, transport_.packets.size());
+  EXPECT_EQ(kForwardedSsrc, transport_.packets[3].Ssrc());
+  EXPECT_EQ(13, transport_.packets[3].SequenceNumber());
+  EXPECT_EQ(14, transport_.packets[4].SequenceNumber());
+  // 34 ms after the last forwarded frame.
+  EXPECT_EQ(15000u + 34 * 90, transport_.packets[3].Timestamp());
+  EXPECT_EQ(15000u + 34 * 90 + 3000, transport_.packets[4].Timestamp());
+  EXPECT_EQ(104, PictureId(transport_.packets[3]));
+  EXPECT_EQ(105, PictureId(transport_.packets[4]));
+  EXPECT_EQ(14, transport_.packets[3].payload()[4]);
+  EXPECT_EQ(15, transport_.packets[4].payload()[4]);
+}
+
+TEST_F(RtpStreamForwarderTest, TranslatesFeedback) {
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kLowSsrc, 10, 9000, 500, 50, true, 1000));
+  forwarder_->SetLayer(1);
+  forwarder_->OnRtpPacket(
+      CreateVp8Packet(kHighSsrc, 60000, 3000000, 7000, 200, true, 1033));
+  ASSERT_EQ(2u, transport_.packets.size());
+
+  rtcp::Nack nack;
+  nack.SetSenderSsrc(kReceiverSsrc);
+  nack.SetMediaSsrc(kForwardedSsrc);
+  nack.SetPacketIds({10, 11, 12});
+  rtc::Buffer raw_nack = nack.Build();
+  EXPECT_CALL(feedback_observer_, OnNack(kLowSsrc, ElementsAre(10)));
+  EXPECT_CALL(feedback_observer_, OnNack(kHighSsrc, ElementsAre(60000)));
+  forwarder_->OnRtcpPacket(raw_nack);
+
+  rtcp::Pli pli;
+  pli.SetSenderSsrc(kReceiverSsrc);
+  pli.SetMediaSsrc(kForwardedSsrc);
+  rtc::Buffer raw_pli = pli.Build();
+  EXPECT_CALL(feedback_observer_, OnKeyFrameRequest(kHighSsrc));
+  forwarder_->OnRtcpPacket(raw_pli);
+
+  // Feedback about other streams is ignored.
+  pli.SetMediaSsrc(kLowSsrc);
+  raw_pli = pli.Build();
+  EXPECT_CALL(feedback_observer_, OnKeyFrameRequest(_)).Times(0);
+  forwarder_->OnRtcpPacket(raw_pli);
+}
+
+TEST(RtpStreamForwarderLayerSelectionTest, LeavesOutDroppedPackets) {
+  RecordingTransport transport;
+  VideoBitrateAllocation layer_bitrates;
+  layer_bitrates.SetBitrate(0, 0, 100000);
+  layer_bitrates.SetBitrate(0, 1, 100000);
+  RtpLayerSelector layer_selector;
+  layer_selector.SetLayerBitrates(layer_bitrates);
+  layer_selector.SetBandwidthEstimate(150000);
+  RtpStreamForwarder::Config config;
+  config.input_ssrcs = {kLowSsrc};
+  config.ssrc = kForwardedSsrc;
+  config.codec_type = kVideoCodecVP8;
+  config.transport = &transport;
+  config.layer_selector = &layer_selector;
+  RtpStreamForwarder forwarder(config, nullptr);
+
+  forwarder.OnRtpPacket(CreateVp8TemporalLayerPacket(10, 0, 1, 0, true));
+  forwarder.OnRtpPacket(CreateVp8TemporalLayerPacket(11, 3000, 1, 1, false));
+  // 13 arrives before 12.
+  forwarder.OnRtpPacket(CreateVp8TemporalLayerPacket(13, 9000, 2, 1, false));
+  forwarder.OnRtpPacket(CreateVp8TemporalLayerPacket(12, 6000, 2, 0, false));
+  // A retransmission of a dropped packet.
+  forwarder.OnRtpPacket(CreateVp8TemporalLayerPacket(11, 3000, 1, 1, false));
+  RtpPacketReceived padding;
+  padding.SetSsrc(kLowSsrc);
+  padding.SetSequenceNumber(14);
+  forwarder.OnRtpPacket(padding);
+  forwarder.OnRtpPacket(CreateVp8TemporalLayerPacket(15, 12000, 3, 0, false));
+
+  ASSERT_EQ(3u, transport.packets.size());
+  EXPECT_EQ(10, transport.packets[0].SequenceNumber());
+  EXPECT_EQ(11, transport.packets[1].SequenceNumber());
+  EXPECT_EQ(6000u, transport.packets[1].Timestamp());
+  EXPECT_EQ(12, transport.packets[2].SequenceNumber());
+  EXPECT_EQ(12000u, transport.packets[2].Timestamp());
+  EXPECT_TRUE(transport.packets[2].Marker());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -61,10 +61,23 @@ RtpTransportControllerSend::RtpTransportControllerSend(
     webrtc::RtcEventLog* event_log,
     NetworkControllerFactoryInterface* controller_factory,
     const BitrateConstraints& bitrate_config)
+    : RtpTransportControllerSend(clock,
+                                 event_log,
+                                 controller_factory,
+                                 bitrate_config,
+                                 nullptr) {}
+
+RtpTransportControllerSend::RtpTransportControllerSend(
+    Clock* clock,
+    webrtc::RtcEventLog* event_log,
+    NetworkControllerFactoryInterface* controller_factory,
+    const BitrateConstraints& bitrate_config,
+    ProcessThread* pacer_thread)
     : clock_(clock),
       pacer_(clock, &packet_router_, event_log),
       bitrate_configurator_(bitrate_config),
       process_thread_(ProcessThread::Create("SendControllerThread")),
+      pacer_thread_(pacer_thread ? pacer_thread : process_thread_.get()),
       observer_(nullptr),
       retransmission_rate_limiter_(clock, kRetransmitWindowSizeMs),
       task_queue_("rtp_send_controller") {
@@ -73,7 +86,7 @@ RtpTransportControllerSend::RtpTransportControllerSend(
       CreateController(clock, &task_queue_, event_log, &pacer_, bitrate_config,
                        TaskQueueExperimentEnabled(), controller_factory);
 
-  process_thread_->RegisterModule(&pacer_, RTC_FROM_HERE);
+  pacer_thread_->RegisterModule(&pacer_, RTC_FROM_HERE);
   process_thread_->RegisterModule(send_side_cc_.get(), RTC_FROM_HERE);
   process_thread_->Start();
 }
@@ -81,7 +94,7 @@ RtpTransportControllerSend::RtpTransportControllerSend(
 RtpTransportControllerSend::~RtpTransportControllerSend() {
   process_thread_->Stop();
   process_thread_->DeRegisterModule(send_side_cc_.get());
-  process_thread_->DeRegisterModule(&pacer_);
+  pacer_thread_->DeRegisterModule(&pacer_);
 }
 
 RtpVideoSenderInterface* RtpTransportControllerSend::CreateRtpVideoSender(
@@ -44,6 +44,16 @@ class RtpTransportControllerSend final
       RtcEventLog* event_log,
       NetworkControllerFactoryInterface* controller_factory,
       const BitrateConstraints& bitrate_config);
+  // If |pacer_thread| is given, the pacer is driven by it rather than by the
+  // thread owned by this object. This lets an SFU drive the pacers of all its
+  // egress transports from one SharedPacerThread. |pacer_thread| must be
+  // running for the lifetime of this object.
+  RtpTransportControllerSend(
+      Clock* clock,
+      RtcEventLog* event_log,
+      NetworkControllerFactoryInterface* controller_factory,
+      const BitrateConstraints& bitrate_config,
+      ProcessThread* pacer_thread);
   ~RtpTransportControllerSend() override;
 
   RtpVideoSenderInterface* CreateRtpVideoSender(
@@ -111,6 +121,7 @@ class RtpTransportControllerSend final
   RtpBitrateConfigurator bitrate_configurator_;
   std::map<std::string, rtc::NetworkRoute> network_routes_;
   const std::unique_ptr<ProcessThread> process_thread_;
+  ProcessThread* const pacer_thread_;
   rtc::CriticalSection observer_crit_;
   TargetTransferRateObserver* observer_ RTC_GUARDED_BY(observer_crit_);
   std::unique_ptr<SendSideCongestionControllerInterface> send_side_cc_;
@@ -104,6 +104,7 @@ absl::optional<size_t> GetSimulcastIdx(const CodecSpecificInfo* info) {
     case kVideoCodecH264:
       return absl::optional<size_t>(info->codecSpecific.H264.simulcast_idx);
     case kVideoCodecMultiplex:
+    case kVideoCodecAV1:
     case kVideoCodecGeneric:
       return absl::optional<size_t>(info->codecSpecific.generic.simulcast_idx);
     default:
@@ -155,10 +156,13 @@ std::unique_ptr<FlexfecSender> MaybeCreateFlexfecSender(
   }
 
   RTC_DCHECK_EQ(1U, rtp.flexfec.protected_media_ssrcs.size());
-  return absl::make_unique<FlexfecSender>(
+  auto flexfec_sender = absl::make_unique<FlexfecSender>(
       rtp.flexfec.payload_type, rtp.flexfec.ssrc,
       rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
       RTPSender::FecExtensionSizes(), rtp_state, Clock::GetRealTimeClock());
+  flexfec_sender->SetUseTwoDimensionalParity(
+      rtp.flexfec.two_dimensional_parity);
+  return flexfec_sender;
 }
 }  // namespace
 
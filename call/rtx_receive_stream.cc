@@ -54,22 +54,17 @@ void RtxReceiveStream::OnRtpPacket(const RtpPacketReceived& rtx_packet) {
                         << " on rtx ssrc " << rtx_packet.Ssrc();
     return;
   }
-  RtpPacketReceived media_packet;
-  media_packet.CopyHeaderFrom(rtx_packet);
+  // Shares the buffer of |rtx_packet| until stripping the RTX header makes
+  // the one copy needed.
+  RtpPacketReceived media_packet(rtx_packet);
+  uint16_t original_sequence_number = (payload[0] << 8) + payload[1];
+  media_packet.RemovePayloadPrefix(kRtxHeaderSize);
 
   media_packet.SetSsrc(media_ssrc_);
-  media_packet.SetSequenceNumber((payload[0] << 8) + payload[1]);
+  media_packet.SetSequenceNumber(original_sequence_number);
   media_packet.SetPayloadType(it->second);
   media_packet.set_recovered(true);
 
-  // Skip the RTX header.
-  rtc::ArrayView<const uint8_t> rtx_payload = payload.subview(kRtxHeaderSize);
-
-  uint8_t* media_payload = media_packet.AllocatePayload(rtx_payload.size());
-  RTC_DCHECK(media_payload != nullptr);
-
-  memcpy(media_payload, rtx_payload.data(), rtx_payload.size());
-
   media_sink_->OnRtpPacket(media_packet);
 }
 
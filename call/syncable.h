@@ -29,6 +29,9 @@ class Syncable {
     uint32_t capture_time_ntp_frac = 0;
     uint32_t capture_time_source_clock = 0;
     int current_delay_ms = 0;
+    // Upper bound on the minimum playout delay stream synchronization may
+    // request for this stream. Unset for no bound.
+    absl::optional<int> max_sync_delay_ms;
   };
 
   virtual ~Syncable();
@@ -86,8 +86,14 @@ std::string VideoReceiveStream::Config::ToString() const {
   ss << ", rtp: " << rtp.ToString();
   ss << ", renderer: " << (renderer ? "(renderer)" : "nullptr");
   ss << ", render_delay_ms: " << render_delay_ms;
+  if (low_latency_playout)
+    ss << ", low_latency_playout: on";
+  if (prewarm_decoder)
+    ss << ", prewarm_decoder: on";
   if (!sync_group.empty())
     ss << ", sync_group: " << sync_group;
+  if (max_sync_delay_ms)
+    ss << ", max_sync_delay_ms: " << *max_sync_delay_ms;
   ss << ", target_delay_ms: " << target_delay_ms;
   ss << '}';
 
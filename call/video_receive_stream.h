@@ -105,6 +105,15 @@ class VideoReceiveStream {
     // Timing frame info: all important timestamps for a full lifetime of a
     // single 'timing frame'.
     absl::optional<webrtc::TimingFrameInfo> timing_frame_info;
+
+    // Start latency of the stream, broken into stages. Each one is the time in
+    // ms from the creation of the stream until the stage was first reached, or
+    // -1 if it hasn't been reached yet.
+    int64_t decoder_ready_ms = -1;
+    int64_t first_packet_received_ms = -1;
+    int64_t first_keyframe_complete_ms = -1;
+    int64_t first_frame_decoded_ms = -1;
+    int64_t first_frame_rendered_ms = -1;
   };
 
   struct Config {
@@ -208,11 +217,30 @@ class VideoReceiveStream {
     // available.
     bool disable_prerenderer_smoothing = false;
 
+    // If set, frames are decoded as soon as they are complete and continuous
+    // and the playout delay follows a fast-adapting jitter estimate, within
+    // the min/max playout delay signaled by the sender. Meant for interactive
+    // use cases such as cloud gaming and remote desktop, typically together
+    // with |disable_prerenderer_smoothing|.
+    bool low_latency_playout = false;
+
+    // If set, the decoder of the first entry of |decoders| is initialized on
+    // the decode thread as soon as the stream is started, instead of when the
+    // first frame is decoded. Shortens the start of the stream with decoders
+    // that are slow to initialize, such as hardware ones.
+    bool prewarm_decoder = false;
+
     // Identifier for an A/V synchronization group. Empty string to disable.
     // TODO(pbos): Synchronize streams in a sync group, not just video streams
     // to one of the audio streams.
     std::string sync_group;
 
+    // Caps the playout delay A/V synchronization may add to this stream.
+    // Together with AudioReceiveStream::Config::max_sync_delay_ms this bounds
+    // the latency synchronization can cost, at the price of a residual A/V
+    // offset once a cap is reached. Unset for no cap.
+    absl::optional<int> max_sync_delay_ms;
+
     // Target delay in milliseconds. A positive value indicates this stream is
     // used for streaming instead of a real-time call.
     int target_delay_ms = 0;
@@ -246,6 +274,13 @@ class VideoReceiveStream {
   virtual void AddSecondarySink(RtpPacketSinkInterface* sink) = 0;
   virtual void RemoveSecondarySink(const RtpPacketSinkInterface* sink) = 0;
 
+  // Lets the renderer report its display refresh so that frames are released
+  // for the vsync closest to their render time instead of mid-refresh.
+  // |vsync_time_ms| is the time of any vsync in the rtc::TimeMillis() clock.
+  // Has no effect when |disable_prerenderer_smoothing| is set, and a
+  // |refresh_interval_ms| of 0 turns the alignment off again.
+  virtual void OnVsync(int64_t vsync_time_ms, int64_t refresh_interval_ms) = 0;
+
  protected:
   virtual ~VideoReceiveStream() {}
 };
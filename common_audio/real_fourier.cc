@@ -10,7 +10,7 @@
 
 #include "common_audio/real_fourier.h"
 
-#include "common_audio/real_fourier_ooura.h"
+#include "common_audio/real_fourier_stockham.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "rtc_base/checks.h"
 
@@ -21,7 +21,7 @@ using std::complex;
 const size_t RealFourier::kFftBufferAlignment = 32;
 
 std::unique_ptr<RealFourier> RealFourier::Create(int fft_order) {
-  return std::unique_ptr<RealFourier>(new RealFourierOoura(fft_order));
+  return std::unique_ptr<RealFourier>(new RealFourierStockham(fft_order));
 }
 
 int RealFourier::FftOrder(size_t length) {
@@ -33,7 +33,10 @@ class RealFourier {
   static const size_t kFftBufferAlignment;
 
   // Construct a wrapper instance for the given input order, which must be
-  // between 1 and kMaxFftOrder, inclusively.
+  // between 1 and kMaxFftOrder, inclusively. The instance is a
+  // RealFourierStockham, which uses the SIMD instructions of the CPU.
+  // Components that need the exact output of the Ooura FFT can create a
+  // RealFourierOoura directly.
   static std::unique_ptr<RealFourier> Create(int fft_order);
   virtual ~RealFourier() {}
 
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "common_audio/real_fourier.h"
+#include "common_audio/real_fourier_ooura.h"
+#include "common_audio/real_fourier_stockham.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+
+namespace {
+
+// Enough transforms of each size to take a few ms.
+const int kNumSamplesPerOrder = 1 << 21;
+
+// Measures how long a forward and an inverse transform of |fft| take.
+void RunTransformTest(const RealFourier& fft, const std::string& name) {
+  const size_t length = RealFourier::FftLength(fft.order());
+  RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+  RealFourier::fft_cplx_scoper cplx =
+      RealFourier::AllocCplxBuffer(RealFourier::ComplexLength(fft.order()));
+  Random random(42);
+  for (size_t i = 0; i < length; ++i)
+    real[i] = random.Rand<float>() - 0.5f;
+
+  const int num_transforms = static_cast<int>(kNumSamplesPerOrder / length);
+  const int64_t start_nanos = rtc::TimeNanos();
+  for (int i = 0; i < num_transforms; ++i) {
+    fft.Forward(real.get(), cplx.get());
+    fft.Inverse(cplx.get(), real.get());
+  }
+  const int64_t total_nanos = rtc::TimeNanos() - start_nanos;
+
+  webrtc::test::PrintResult(
+      "forward_and_inverse_time", "_" + name,
+      std::to_string(length) + "_points",
+      static_cast<double>(total_nanos) / num_transforms /
+          rtc::kNumNanosecsPerMicrosec,
+      "us", false);
+}
+
+}  // namespace
+
+TEST(RealFourierPerformanceTest, Transforms) {
+  // From the 128-point transforms of the band split bands to the 4096-point
+  // transforms of 48 kHz audio.
+  for (int order = 7; order <= 12; ++order) {
+    RunTransformTest(RealFourierOoura(order), "ooura");
+    RunTransformTest(RealFourierStockham(order), "stockham");
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/real_fourier_stockham.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+using std::complex;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Number of twiddle factors of all passes of a complex FFT of |half_length|.
+int NumTwiddles(int num_passes, size_t half_length) {
+  return std::max(1, num_passes * static_cast<int>(half_length / 2));
+}
+
+}  // namespace
+
+RealFourierStockham::RealFourierStockham(int fft_order)
+    : order_(fft_order),
+      length_(FftLength(order_)),
+      complex_length_(ComplexLength(order_)),
+      half_length_(length_ / 2),
+      num_passes_(std::max(order_ - 1, 0)),
+      pass_(Pass_C),
+      twiddles_re_(AllocRealBuffer(NumTwiddles(num_passes_, half_length_))),
+      twiddles_im_(AllocRealBuffer(NumTwiddles(num_passes_, half_length_))),
+      post_twiddles_(new complex<float>[half_length_ + 1]),
+      data_re_(AllocRealBuffer(static_cast<int>(half_length_))),
+      data_im_(AllocRealBuffer(static_cast<int>(half_length_))),
+      work_re_(AllocRealBuffer(static_cast<int>(half_length_))),
+      work_im_(AllocRealBuffer(static_cast<int>(half_length_))) {
+  RTC_CHECK_GE(fft_order, 1);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    pass_ = Pass_AVX2;
+  } else {
+#if defined(__SSE2__)
+    pass_ = Pass_SSE;
+#else
+    pass_ = WebRtc_GetCPUInfo(kSSE2) ? Pass_SSE : Pass_C;
+#endif
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  pass_ = Pass_NEON;
+#endif
+
+  // The pass with stride s combines the DFTs of length s of s-decimated
+  // sequences into DFTs of length 2 * s. Butterfly j of the pass belongs to
+  // the DFT j / s, and its twiddle factor is exp(-2 pi i (j - j % s) / n).
+  const size_t num_butterflies = half_length_ / 2;
+  for (int pass = 0; pass < num_passes_; ++pass) {
+    const size_t stride = size_t{1} << pass;
+    float* w_re = &twiddles_re_[pass * num_butterflies];
+    float* w_im = &twiddles_im_[pass * num_butterflies];
+    for (size_t j = 0; j < num_butterflies; ++j) {
+      const double angle =
+          -2.0 * kPi * static_cast<double>(j - j % stride) / half_length_;
+      w_re[j] = static_cast<float>(std::cos(angle));
+      w_im[j] = static_cast<float>(std::sin(angle));
+    }
+  }
+  for (size_t k = 0; k <= half_length_; ++k) {
+    const double angle = -2.0 * kPi * static_cast<double>(k) / length_;
+    post_twiddles_[k] = complex<float>(static_cast<float>(std::cos(angle)),
+                                       static_cast<float>(std::sin(angle)));
+  }
+}
+
+RealFourierStockham::~RealFourierStockham() = default;
+
+void RealFourierStockham::Pass_C(const float* x_re,
+                                 const float* x_im,
+                                 const float* w_re,
+                                 const float* w_im,
+                                 size_t half_length,
+                                 size_t stride,
+                                 float* y_re,
+                                 float* y_im) {
+  for (size_t j = 0; j < half_length; ++j) {
+    const size_t out = 2 * j - (j & (stride - 1));
+    const float diff_re = x_re[j] - x_re[j + half_length];
+    const float diff_im = x_im[j] - x_im[j + half_length];
+    y_re[out] = x_re[j] + x_re[j + half_length];
+    y_im[out] = x_im[j] + x_im[j + half_length];
+    y_re[out + stride] = diff_re * w_re[j] - diff_im * w_im[j];
+    y_im[out + stride] = diff_re * w_im[j] + diff_im * w_re[j];
+  }
+}
+
+void RealFourierStockham::ComplexFft(float** re, float** im) const {
+  const size_t num_butterflies = half_length_ / 2;
+  float* x_re = *re;
+  float* x_im = *im;
+  float* y_re = work_re_.get();
+  float* y_im = work_im_.get();
+  for (int pass = 0; pass < num_passes_; ++pass) {
+    pass_(x_re, x_im, &twiddles_re_[pass * num_butterflies],
+          &twiddles_im_[pass * num_butterflies], num_butterflies,
+          size_t{1} << pass, y_re, y_im);
+    std::swap(x_re, y_re);
+    std::swap(x_im, y_im);
+  }
+  *re = x_re;
+  *im = x_im;
+}
+
+void RealFourierStockham::Forward(const float* src,
+                                  complex<float>* dest) const {
+  float* z_re = data_re_.get();
+  float* z_im = data_im_.get();
+  for (size_t n = 0; n < half_length_; ++n) {
+    z_re[n] = src[2 * n];
+    z_im[n] = src[2 * n + 1];
+  }
+
+  ComplexFft(&z_re, &z_im);
+
+  // With Z the DFT of the complex sequence, and E and O the DFTs of the even
+  // and odd samples, E[k] = (Z[k] + conj(Z[n - k])) / 2 and
+  // O[k] = (Z[k] - conj(Z[n - k])) / 2i, where n = |half_length_|. Then
+  // X[k] = E[k] + exp(-2 pi i k / |length_|) O[k].
+  dest[0] = complex<float>(z_re[0] + z_im[0], 0.0f);
+  dest[half_length_] = complex<float>(z_re[0] - z_im[0], 0.0f);
+  // Written out, since complex multiplication handles NaNs and infinities
+  // through a slow library call.
+  for (size_t k = 1; k < half_length_; ++k) {
+    const float even_re = 0.5f * (z_re[k] + z_re[half_length_ - k]);
+    const float even_im = 0.5f * (z_im[k] - z_im[half_length_ - k]);
+    const float odd_re = 0.5f * (z_im[k] + z_im[half_length_ - k]);
+    const float odd_im = -0.5f * (z_re[k] - z_re[half_length_ - k]);
+    const float w_re = post_twiddles_[k].real();
+    const float w_im = post_twiddles_[k].imag();
+    dest[k] = complex<float>(even_re + w_re * odd_re - w_im * odd_im,
+                             even_im + w_re * odd_im + w_im * odd_re);
+  }
+}
+
+void RealFourierStockham::Inverse(const complex<float>* src,
+                                  float* dest) const {
+  float* z_re = data_re_.get();
+  float* z_im = data_im_.get();
+
+  // The reverse of Forward(): Z[k] = E[k] + i O[k], with
+  // E[k] = (X[k] + conj(X[n - k])) / 2 and
+  // O[k] = (X[k] - conj(X[n - k])) exp(2 pi i k / |length_|) / 2.
+  for (size_t k = 0; k < half_length_; ++k) {
+    const float x_re = src[k].real();
+    const float x_im = src[k].imag();
+    const float x_conj_re = src[half_length_ - k].real();
+    const float x_conj_im = -src[half_length_ - k].imag();
+    const float even_re = 0.5f * (x_re + x_conj_re);
+    const float even_im = 0.5f * (x_im + x_conj_im);
+    const float diff_re = 0.5f * (x_re - x_conj_re);
+    const float diff_im = 0.5f * (x_im - x_conj_im);
+    // Multiplied by the conjugate twiddle factor.
+    const float w_re = post_twiddles_[k].real();
+    const float w_im = post_twiddles_[k].imag();
+    const float odd_re = diff_re * w_re + diff_im * w_im;
+    const float odd_im = diff_im * w_re - diff_re * w_im;
+    z_re[k] = even_re - odd_im;
+    z_im[k] = even_im + odd_re;
+  }
+
+  ComplexFft(&z_im, &z_re);
+
+  const float scale = 1.0f / half_length_;
+  for (size_t n = 0; n < half_length_; ++n) {
+    dest[2 * n] = z_re[n] * scale;
+    dest[2 * n + 1] = z_im[n] * scale;
+  }
+}
+
+int RealFourierStockham::order() const {
+  return order_;
+}
+
+}  // namespace webrtc
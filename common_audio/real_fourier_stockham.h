@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_REAL_FOURIER_STOCKHAM_H_
+#define COMMON_AUDIO_REAL_FOURIER_STOCKHAM_H_
+
+#include <complex>
+#include <memory>
+
+#include "common_audio/real_fourier.h"
+#include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Real DFT computed as a complex DFT of half the length, with the even samples
+// as real parts and the odd samples as imaginary parts. The complex DFT is a
+// radix-2 Stockham FFT on separate arrays of real and imaginary parts, so each
+// pass is a loop over contiguous butterflies, which the SIMD versions compute
+// 4 (SSE2, NEON) or 8 (AVX2) at a time. The fastest version the CPU supports
+// is selected at construction, like in SincResampler.
+class RealFourierStockham : public RealFourier {
+ public:
+  explicit RealFourierStockham(int fft_order);
+  ~RealFourierStockham() override;
+
+  void Forward(const float* src, std::complex<float>* dest) const override;
+  void Inverse(const std::complex<float>* src, float* dest) const override;
+
+  int order() const override;
+
+ private:
+  FRIEND_TEST_ALL_PREFIXES(RealFourierStockhamTest, Pass);
+
+  // Computes one pass of the complex FFT: the |half_length| butterflies of
+  // elements j and j + |half_length| of |x_re| and |x_im|, with the twiddle
+  // factors |w_re|[j] and |w_im|[j]. The sum of butterfly j is written to
+  // element 2 * j - j % |stride| of |y_re| and |y_im|, and the difference
+  // |stride| elements later. |stride| is a power of two.
+  typedef void (*PassFunction)(const float* x_re,
+                               const float* x_im,
+                               const float* w_re,
+                               const float* w_im,
+                               size_t half_length,
+                               size_t stride,
+                               float* y_re,
+                               float* y_im);
+  static void Pass_C(const float* x_re,
+                     const float* x_im,
+                     const float* w_re,
+                     const float* w_im,
+                     size_t half_length,
+                     size_t stride,
+                     float* y_re,
+                     float* y_im);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  static void Pass_SSE(const float* x_re,
+                       const float* x_im,
+                       const float* w_re,
+                       const float* w_im,
+                       size_t half_length,
+                       size_t stride,
+                       float* y_re,
+                       float* y_im);
+  static void Pass_AVX2(const float* x_re,
+                        const float* x_im,
+                        const float* w_re,
+                        const float* w_im,
+                        size_t half_length,
+                        size_t stride,
+                        float* y_re,
+                        float* y_im);
+#elif defined(WEBRTC_HAS_NEON)
+  static void Pass_NEON(const float* x_re,
+                        const float* x_im,
+                        const float* w_re,
+                        const float* w_im,
+                        size_t half_length,
+                        size_t stride,
+                        float* y_re,
+                        float* y_im);
+#endif
+
+  // Computes the complex FFT of |*re| and |*im|, with the passes alternating
+  // between them and |work_re_| and |work_im_|, and points |*re| and |*im| to
+  // the output. Swapping |re| and |im| gives the unscaled inverse FFT.
+  void ComplexFft(float** re, float** im) const;
+
+  const int order_;
+  const size_t length_;
+  const size_t complex_length_;
+  // Length of the complex FFT.
+  const size_t half_length_;
+  const int num_passes_;
+  PassFunction pass_;
+
+  // Twiddle factors of each pass, |half_length_| / 2 per pass.
+  const fft_real_scoper twiddles_re_;
+  const fft_real_scoper twiddles_im_;
+  // exp(-2 pi i k / |length_|), for combining the even and odd samples.
+  const std::unique_ptr<std::complex<float>[]> post_twiddles_;
+  // Work arrays of |half_length_| floats each.
+  const fft_real_scoper data_re_;
+  const fft_real_scoper data_im_;
+  const fft_real_scoper work_re_;
+  const fft_real_scoper work_im_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_REAL_FOURIER_STOCKHAM_H_
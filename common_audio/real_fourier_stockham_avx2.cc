@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/real_fourier_stockham.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+void RealFourierStockham::Pass_AVX2(const float* x_re,
+                                    const float* x_im,
+                                    const float* w_re,
+                                    const float* w_im,
+                                    size_t half_length,
+                                    size_t stride,
+                                    float* y_re,
+                                    float* y_im) {
+  // Interleaving the outputs of strides below 8 would need lane crossing
+  // shuffles, so those passes are left to the SSE version.
+  if (stride < 8 || half_length % 8 != 0) {
+    Pass_SSE(x_re, x_im, w_re, w_im, half_length, stride, y_re, y_im);
+    return;
+  }
+
+  for (size_t j = 0; j < half_length; j += 8) {
+    const __m256 a_re = _mm256_load_ps(x_re + j);
+    const __m256 a_im = _mm256_load_ps(x_im + j);
+    const __m256 b_re = _mm256_load_ps(x_re + j + half_length);
+    const __m256 b_im = _mm256_load_ps(x_im + j + half_length);
+    const __m256 t_re = _mm256_load_ps(w_re + j);
+    const __m256 t_im = _mm256_load_ps(w_im + j);
+    const __m256 diff_re = _mm256_sub_ps(a_re, b_re);
+    const __m256 diff_im = _mm256_sub_ps(a_im, b_im);
+    const size_t out = 2 * j - (j & (stride - 1));
+    _mm256_store_ps(y_re + out, _mm256_add_ps(a_re, b_re));
+    _mm256_store_ps(y_im + out, _mm256_add_ps(a_im, b_im));
+    _mm256_store_ps(y_re + out + stride,
+                    _mm256_sub_ps(_mm256_mul_ps(diff_re, t_re),
+                                  _mm256_mul_ps(diff_im, t_im)));
+    _mm256_store_ps(y_im + out + stride,
+                    _mm256_add_ps(_mm256_mul_ps(diff_re, t_im),
+                                  _mm256_mul_ps(diff_im, t_re)));
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/real_fourier_stockham.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+void RealFourierStockham::Pass_NEON(const float* x_re,
+                                    const float* x_im,
+                                    const float* w_re,
+                                    const float* w_im,
+                                    size_t half_length,
+                                    size_t stride,
+                                    float* y_re,
+                                    float* y_im) {
+  if (half_length % 4 != 0) {
+    Pass_C(x_re, x_im, w_re, w_im, half_length, stride, y_re, y_im);
+    return;
+  }
+
+  for (size_t j = 0; j < half_length; j += 4) {
+    const float32x4_t a_re = vld1q_f32(x_re + j);
+    const float32x4_t a_im = vld1q_f32(x_im + j);
+    const float32x4_t b_re = vld1q_f32(x_re + j + half_length);
+    const float32x4_t b_im = vld1q_f32(x_im + j + half_length);
+    const float32x4_t t_re = vld1q_f32(w_re + j);
+    const float32x4_t t_im = vld1q_f32(w_im + j);
+    const float32x4_t sum_re = vaddq_f32(a_re, b_re);
+    const float32x4_t sum_im = vaddq_f32(a_im, b_im);
+    const float32x4_t diff_re = vsubq_f32(a_re, b_re);
+    const float32x4_t diff_im = vsubq_f32(a_im, b_im);
+    const float32x4_t out_re =
+        vmlsq_f32(vmulq_f32(diff_re, t_re), diff_im, t_im);
+    const float32x4_t out_im =
+        vmlaq_f32(vmulq_f32(diff_re, t_im), diff_im, t_re);
+
+    if (stride >= 4) {
+      // The 4 butterflies have consecutive outputs.
+      const size_t out = 2 * j - (j & (stride - 1));
+      vst1q_f32(y_re + out, sum_re);
+      vst1q_f32(y_im + out, sum_im);
+      vst1q_f32(y_re + out + stride, out_re);
+      vst1q_f32(y_im + out + stride, out_im);
+    } else if (stride == 2) {
+      // Sums and differences alternate in pairs.
+      vst1q_f32(y_re + 2 * j,
+                vcombine_f32(vget_low_f32(sum_re), vget_low_f32(out_re)));
+      vst1q_f32(y_im + 2 * j,
+                vcombine_f32(vget_low_f32(sum_im), vget_low_f32(out_im)));
+      vst1q_f32(y_re + 2 * j + 4,
+                vcombine_f32(vget_high_f32(sum_re), vget_high_f32(out_re)));
+      vst1q_f32(y_im + 2 * j + 4,
+                vcombine_f32(vget_high_f32(sum_im), vget_high_f32(out_im)));
+    } else {
+      // Sums and differences alternate.
+      const float32x4x2_t re = vzipq_f32(sum_re, out_re);
+      const float32x4x2_t im = vzipq_f32(sum_im, out_im);
+      vst1q_f32(y_re + 2 * j, re.val[0]);
+      vst1q_f32(y_im + 2 * j, im.val[0]);
+      vst1q_f32(y_re + 2 * j + 4, re.val[1]);
+      vst1q_f32(y_im + 2 * j + 4, im.val[1]);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/real_fourier_stockham.h"
+
+#include <xmmintrin.h>
+
+namespace webrtc {
+
+void RealFourierStockham::Pass_SSE(const float* x_re,
+                                   const float* x_im,
+                                   const float* w_re,
+                                   const float* w_im,
+                                   size_t half_length,
+                                   size_t stride,
+                                   float* y_re,
+                                   float* y_im) {
+  if (half_length % 4 != 0) {
+    Pass_C(x_re, x_im, w_re, w_im, half_length, stride, y_re, y_im);
+    return;
+  }
+
+  // The arrays are 32-byte aligned, and |half_length| is a multiple of 4, so
+  // all loads and stores are aligned.
+  for (size_t j = 0; j < half_length; j += 4) {
+    const __m128 a_re = _mm_load_ps(x_re + j);
+    const __m128 a_im = _mm_load_ps(x_im + j);
+    const __m128 b_re = _mm_load_ps(x_re + j + half_length);
+    const __m128 b_im = _mm_load_ps(x_im + j + half_length);
+    const __m128 t_re = _mm_load_ps(w_re + j);
+    const __m128 t_im = _mm_load_ps(w_im + j);
+    const __m128 sum_re = _mm_add_ps(a_re, b_re);
+    const __m128 sum_im = _mm_add_ps(a_im, b_im);
+    const __m128 diff_re = _mm_sub_ps(a_re, b_re);
+    const __m128 diff_im = _mm_sub_ps(a_im, b_im);
+    const __m128 out_re =
+        _mm_sub_ps(_mm_mul_ps(diff_re, t_re), _mm_mul_ps(diff_im, t_im));
+    const __m128 out_im =
+        _mm_add_ps(_mm_mul_ps(diff_re, t_im), _mm_mul_ps(diff_im, t_re));
+
+    if (stride >= 4) {
+      // The 4 butterflies have consecutive outputs.
+      const size_t out = 2 * j - (j & (stride - 1));
+      _mm_store_ps(y_re + out, sum_re);
+      _mm_store_ps(y_im + out, sum_im);
+      _mm_store_ps(y_re + out + stride, out_re);
+      _mm_store_ps(y_im + out + stride, out_im);
+    } else if (stride == 2) {
+      // Sums and differences alternate in pairs.
+      _mm_store_ps(y_re + 2 * j, _mm_movelh_ps(sum_re, out_re));
+      _mm_store_ps(y_im + 2 * j, _mm_movelh_ps(sum_im, out_im));
+      _mm_store_ps(y_re + 2 * j + 4, _mm_movehl_ps(out_re, sum_re));
+      _mm_store_ps(y_im + 2 * j + 4, _mm_movehl_ps(out_im, sum_im));
+    } else {
+      // Sums and differences alternate.
+      _mm_store_ps(y_re + 2 * j, _mm_unpacklo_ps(sum_re, out_re));
+      _mm_store_ps(y_im + 2 * j, _mm_unpacklo_ps(sum_im, out_im));
+      _mm_store_ps(y_re + 2 * j + 4, _mm_unpackhi_ps(sum_re, out_re));
+      _mm_store_ps(y_im + 2 * j + 4, _mm_unpackhi_ps(sum_im, out_im));
+    }
+  }
+}
+
+}  // namespace webrtc
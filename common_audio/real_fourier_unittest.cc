@@ -12,7 +12,12 @@
 
 #include <stdlib.h>
 
+#include <vector>
+
 #include "common_audio/real_fourier_ooura.h"
+#include "common_audio/real_fourier_stockham.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -67,7 +72,7 @@ class RealFourierTest : public ::testing::Test {
   const RealFourier::fft_cplx_scoper cplx_buffer_;
 };
 
-using FftTypes = ::testing::Types<RealFourierOoura>;
+using FftTypes = ::testing::Types<RealFourierOoura, RealFourierStockham>;
 TYPED_TEST_CASE(RealFourierTest, FftTypes);
 
 TYPED_TEST(RealFourierTest, SimpleForwardTransform) {
@@ -99,4 +104,95 @@ TYPED_TEST(RealFourierTest, SimpleBackwardTransform) {
   EXPECT_NEAR(this->real_buffer_[3], 4.0f, 1e-8f);
 }
 
+TEST(RealFourierStockhamTest, MatchesOoura) {
+  Random random(42);
+  for (int order = 1; order <= 12; ++order) {
+    SCOPED_TRACE(order);
+    const size_t length = RealFourier::FftLength(order);
+    const size_t complex_length = RealFourier::ComplexLength(order);
+    RealFourierOoura ooura(order);
+    RealFourierStockham stockham(order);
+    RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_real_scoper real_out =
+        RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_cplx_scoper ooura_cplx =
+        RealFourier::AllocCplxBuffer(complex_length);
+    RealFourier::fft_cplx_scoper stockham_cplx =
+        RealFourier::AllocCplxBuffer(complex_length);
+    for (size_t i = 0; i < length; ++i)
+      real[i] = random.Rand<float>() - 0.5f;
+
+    ooura.Forward(real.get(), ooura_cplx.get());
+    stockham.Forward(real.get(), stockham_cplx.get());
+    for (size_t k = 0; k < complex_length; ++k) {
+      EXPECT_NEAR(ooura_cplx[k].real(), stockham_cplx[k].real(), 1e-4f);
+      EXPECT_NEAR(ooura_cplx[k].imag(), stockham_cplx[k].imag(), 1e-4f);
+    }
+
+    stockham.Inverse(stockham_cplx.get(), real_out.get());
+    for (size_t i = 0; i < length; ++i)
+      EXPECT_NEAR(real[i], real_out[i], 1e-5f);
+  }
+}
+
+// Checks the SIMD passes, including the strides whose outputs are interleaved,
+// against the C version.
+TEST(RealFourierStockhamTest, Pass) {
+  const size_t kHalfLength = 64;
+  Random random(42);
+  RealFourier::fft_real_scoper x_re =
+      RealFourier::AllocRealBuffer(2 * kHalfLength);
+  RealFourier::fft_real_scoper x_im =
+      RealFourier::AllocRealBuffer(2 * kHalfLength);
+  RealFourier::fft_real_scoper w_re = RealFourier::AllocRealBuffer(kHalfLength);
+  RealFourier::fft_real_scoper w_im = RealFourier::AllocRealBuffer(kHalfLength);
+  RealFourier::fft_real_scoper y_re =
+      RealFourier::AllocRealBuffer(2 * kHalfLength);
+  RealFourier::fft_real_scoper y_im =
+      RealFourier::AllocRealBuffer(2 * kHalfLength);
+  std::vector<float> expected_re(2 * kHalfLength);
+  std::vector<float> expected_im(2 * kHalfLength);
+  for (size_t i = 0; i < 2 * kHalfLength; ++i) {
+    x_re[i] = random.Rand<float>() - 0.5f;
+    x_im[i] = random.Rand<float>() - 0.5f;
+  }
+  for (size_t i = 0; i < kHalfLength; ++i) {
+    w_re[i] = random.Rand<float>() - 0.5f;
+    w_im[i] = random.Rand<float>() - 0.5f;
+  }
+
+  for (size_t stride = 1; stride <= kHalfLength; stride *= 2) {
+    SCOPED_TRACE(stride);
+    RealFourierStockham::Pass_C(x_re.get(), x_im.get(), w_re.get(),
+                                w_im.get(), kHalfLength, stride,
+                                expected_re.data(), expected_im.data());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    RealFourierStockham::Pass_SSE(x_re.get(), x_im.get(), w_re.get(),
+                                  w_im.get(), kHalfLength, stride, y_re.get(),
+                                  y_im.get());
+    for (size_t i = 0; i < 2 * kHalfLength; ++i) {
+      EXPECT_FLOAT_EQ(expected_re[i], y_re[i]);
+      EXPECT_FLOAT_EQ(expected_im[i], y_im[i]);
+    }
+    if (WebRtc_GetCPUInfo(kAVX2)) {
+      RealFourierStockham::Pass_AVX2(x_re.get(), x_im.get(), w_re.get(),
+                                     w_im.get(), kHalfLength, stride,
+                                     y_re.get(), y_im.get());
+      for (size_t i = 0; i < 2 * kHalfLength; ++i) {
+        EXPECT_FLOAT_EQ(expected_re[i], y_re[i]);
+        EXPECT_FLOAT_EQ(expected_im[i], y_im[i]);
+      }
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    RealFourierStockham::Pass_NEON(x_re.get(), x_im.get(), w_re.get(),
+                                   w_im.get(), kHalfLength, stride,
+                                   y_re.get(), y_im.get());
+    for (size_t i = 0; i < 2 * kHalfLength; ++i) {
+      EXPECT_FLOAT_EQ(expected_re[i], y_re[i]);
+      EXPECT_FLOAT_EQ(expected_im[i], y_im[i]);
+    }
+#endif
+  }
+}
+
 }  // namespace webrtc
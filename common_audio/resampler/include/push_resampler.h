@@ -12,13 +12,14 @@
 #define COMMON_AUDIO_RESAMPLER_INCLUDE_PUSH_RESAMPLER_H_
 
 #include <memory>
+#include <vector>
 
 namespace webrtc {
 
 class PushSincResampler;
 
-// Wraps PushSincResampler to provide stereo support.
-// TODO(ajm): add support for an arbitrary number of channels.
+// Wraps PushSincResampler to provide support for interleaved audio with any
+// number of channels.
 template <typename T>
 class PushResampler {
  public:
@@ -36,15 +37,23 @@ class PushResampler {
   int Resample(const T* src, size_t src_length, T* dst, size_t dst_capacity);
 
  private:
-  std::unique_ptr<PushSincResampler> sinc_resampler_;
-  std::unique_ptr<PushSincResampler> sinc_resampler_right_;
+  struct ChannelResampler {
+    ChannelResampler();
+    ChannelResampler(ChannelResampler&&);
+    ~ChannelResampler();
+
+    std::unique_ptr<PushSincResampler> resampler;
+    std::vector<T> source;
+    std::vector<T> destination;
+  };
+
   int src_sample_rate_hz_;
   int dst_sample_rate_hz_;
   size_t num_channels_;
-  std::unique_ptr<T[]> src_left_;
-  std::unique_ptr<T[]> src_right_;
-  std::unique_ptr<T[]> dst_left_;
-  std::unique_ptr<T[]> dst_right_;
+  // One resampler per channel. Only multi-channel audio uses the buffers, for
+  // the deinterleaved input and output of each channel.
+  std::vector<ChannelResampler> channel_resamplers_;
+  std::vector<T*> channel_data_array_;
 };
 
 }  // namespace webrtc
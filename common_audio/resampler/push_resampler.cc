@@ -34,7 +34,6 @@ void CheckValidInitParams(int src_sample_rate_hz,
   RTC_DCHECK_GT(src_sample_rate_hz, 0);
   RTC_DCHECK_GT(dst_sample_rate_hz, 0);
   RTC_DCHECK_GT(num_channels, 0);
-  RTC_DCHECK_LE(num_channels, 2);
 #endif
 }
 
@@ -56,6 +55,16 @@ void CheckExpectedBufferSizes(size_t src_length,
 }
 }  // namespace
 
+template <typename T>
+PushResampler<T>::ChannelResampler::ChannelResampler() = default;
+
+template <typename T>
+PushResampler<T>::ChannelResampler::ChannelResampler(ChannelResampler&&) =
+    default;
+
+template <typename T>
+PushResampler<T>::ChannelResampler::~ChannelResampler() = default;
+
 template <typename T>
 PushResampler<T>::PushResampler()
     : src_sample_rate_hz_(0), dst_sample_rate_hz_(0), num_channels_(0) {}
@@ -76,10 +85,8 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
     return 0;
   }
 
-  if (src_sample_rate_hz <= 0 || dst_sample_rate_hz <= 0 || num_channels <= 0 ||
-      num_channels > 2) {
+  if (src_sample_rate_hz <= 0 || dst_sample_rate_hz <= 0 || num_channels <= 0)
     return -1;
-  }
 
   src_sample_rate_hz_ = src_sample_rate_hz;
   dst_sample_rate_hz_ = dst_sample_rate_hz;
@@ -89,16 +96,18 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
       static_cast<size_t>(src_sample_rate_hz / 100);
   const size_t dst_size_10ms_mono =
       static_cast<size_t>(dst_sample_rate_hz / 100);
-  sinc_resampler_.reset(
-      new PushSincResampler(src_size_10ms_mono, dst_size_10ms_mono));
-  if (num_channels_ == 2) {
-    src_left_.reset(new T[src_size_10ms_mono]);
-    src_right_.reset(new T[src_size_10ms_mono]);
-    dst_left_.reset(new T[dst_size_10ms_mono]);
-    dst_right_.reset(new T[dst_size_10ms_mono]);
-    sinc_resampler_right_.reset(
+  channel_resamplers_.clear();
+  for (size_t i = 0; i < num_channels; ++i) {
+    channel_resamplers_.push_back(ChannelResampler());
+    auto& channel_resampler = channel_resamplers_.back();
+    channel_resampler.resampler.reset(
         new PushSincResampler(src_size_10ms_mono, dst_size_10ms_mono));
+    if (num_channels > 1) {
+      channel_resampler.source.resize(src_size_10ms_mono);
+      channel_resampler.destination.resize(dst_size_10ms_mono);
+    }
   }
+  channel_data_array_.resize(num_channels);
 
   return 0;
 }
@@ -117,25 +126,29 @@ int PushResampler<T>::Resample(const T* src,
     memcpy(dst, src, src_length * sizeof(T));
     return static_cast<int>(src_length);
   }
-  if (num_channels_ == 2) {
-    const size_t src_length_mono = src_length / num_channels_;
-    const size_t dst_capacity_mono = dst_capacity / num_channels_;
-    T* deinterleaved[] = {src_left_.get(), src_right_.get()};
-    Deinterleave(src, src_length_mono, num_channels_, deinterleaved);
-
-    size_t dst_length_mono = sinc_resampler_->Resample(
-        src_left_.get(), src_length_mono, dst_left_.get(), dst_capacity_mono);
-    sinc_resampler_right_->Resample(src_right_.get(), src_length_mono,
-                                    dst_right_.get(), dst_capacity_mono);
-
-    deinterleaved[0] = dst_left_.get();
-    deinterleaved[1] = dst_right_.get();
-    Interleave(deinterleaved, dst_length_mono, num_channels_, dst);
-    return static_cast<int>(dst_length_mono * num_channels_);
-  } else {
-    return static_cast<int>(
-        sinc_resampler_->Resample(src, src_length, dst, dst_capacity));
+  if (num_channels_ == 1) {
+    return static_cast<int>(channel_resamplers_[0].resampler->Resample(
+        src, src_length, dst, dst_capacity));
   }
+
+  const size_t src_length_mono = src_length / num_channels_;
+  const size_t dst_capacity_mono = dst_capacity / num_channels_;
+  for (size_t ch = 0; ch < num_channels_; ++ch)
+    channel_data_array_[ch] = channel_resamplers_[ch].source.data();
+  Deinterleave(src, src_length_mono, num_channels_,
+               channel_data_array_.data());
+
+  size_t dst_length_mono = 0;
+  for (auto& channel_resampler : channel_resamplers_) {
+    dst_length_mono = channel_resampler.resampler->Resample(
+        channel_resampler.source.data(), src_length_mono,
+        channel_resampler.destination.data(), dst_capacity_mono);
+  }
+
+  for (size_t ch = 0; ch < num_channels_; ++ch)
+    channel_data_array_[ch] = channel_resamplers_[ch].destination.data();
+  Interleave(channel_data_array_.data(), dst_length_mono, num_channels_, dst);
+  return static_cast<int>(dst_length_mono * num_channels_);
 }
 
 // Explictly generate required instantiations.
@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <vector>
+
 #include "common_audio/resampler/include/push_resampler.h"
 #include "rtc_base/checks.h"  // RTC_DCHECK_IS_ON
 #include "test/gtest.h"
@@ -25,6 +27,7 @@ TEST(PushResamplerTest, VerifiesInputParameters) {
   PushResampler<int16_t> resampler;
   EXPECT_EQ(0, resampler.InitializeIfNeeded(16000, 16000, 1));
   EXPECT_EQ(0, resampler.InitializeIfNeeded(16000, 16000, 2));
+  EXPECT_EQ(0, resampler.InitializeIfNeeded(16000, 16000, 8));
 }
 
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
@@ -44,12 +47,52 @@ TEST(PushResamplerTest, VerifiesBadInputParameters3) {
   PushResampler<int16_t> resampler;
   EXPECT_DEATH(resampler.InitializeIfNeeded(16000, 16000, 0), "num_channels");
 }
-
-TEST(PushResamplerTest, VerifiesBadInputParameters4) {
-  PushResampler<int16_t> resampler;
-  EXPECT_DEATH(resampler.InitializeIfNeeded(16000, 16000, 3), "num_channels");
-}
 #endif
 #endif
 
+// Each channel of interleaved audio is resampled as if it were mono.
+TEST(PushResamplerTest, ResamplesEachChannelIndependently) {
+  constexpr size_t kNumChannels = 6;
+  constexpr int kSrcSampleRateHz = 48000;
+  constexpr int kDstSampleRateHz = 16000;
+  constexpr size_t kSrcFrames = kSrcSampleRateHz / 100;
+  constexpr size_t kDstFrames = kDstSampleRateHz / 100;
+
+  PushResampler<float> resampler;
+  ASSERT_EQ(0, resampler.InitializeIfNeeded(kSrcSampleRateHz, kDstSampleRateHz,
+                                            kNumChannels));
+  std::vector<PushResampler<float>> mono_resamplers(kNumChannels);
+  for (auto& mono_resampler : mono_resamplers) {
+    ASSERT_EQ(0, mono_resampler.InitializeIfNeeded(kSrcSampleRateHz,
+                                                   kDstSampleRateHz, 1));
+  }
+
+  std::vector<float> src(kSrcFrames * kNumChannels);
+  std::vector<float> dst(kDstFrames * kNumChannels);
+  std::vector<float> mono_src(kSrcFrames);
+  std::vector<float> mono_dst(kDstFrames);
+  for (int block = 0; block < 3; ++block) {
+    for (size_t i = 0; i < kSrcFrames; ++i) {
+      for (size_t ch = 0; ch < kNumChannels; ++ch) {
+        src[i * kNumChannels + ch] =
+            static_cast<float>((ch + 1) * ((block * kSrcFrames + i) % 97));
+      }
+    }
+    EXPECT_EQ(static_cast<int>(dst.size()),
+              resampler.Resample(src.data(), src.size(), dst.data(),
+                                 dst.size()));
+
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      for (size_t i = 0; i < kSrcFrames; ++i)
+        mono_src[i] = src[i * kNumChannels + ch];
+      EXPECT_EQ(static_cast<int>(kDstFrames),
+                mono_resamplers[ch].Resample(mono_src.data(), mono_src.size(),
+                                             mono_dst.data(),
+                                             mono_dst.size()));
+      for (size_t i = 0; i < kDstFrames; ++i)
+        EXPECT_EQ(mono_dst[i], dst[i * kNumChannels + ch]);
+    }
+  }
+}
+
 }  // namespace webrtc
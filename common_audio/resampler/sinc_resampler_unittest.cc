@@ -163,6 +163,32 @@ TEST(SincResamplerTest, Convolve) {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Ensure Convolve_AVX2() returns the same value as Convolve_C(), when the CPU
+// supports it.
+TEST(SincResamplerTest, ConvolveAvx2) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+  static const double kEpsilon = 0.00000005;
+
+  for (size_t offset = 0; offset < 2; ++offset) {
+    double result = resampler.Convolve_C(
+        resampler.kernel_storage_.get() + offset,
+        resampler.kernel_storage_.get(), resampler.kernel_storage_.get(),
+        kKernelInterpolationFactor);
+    double result2 = resampler.Convolve_AVX2(
+        resampler.kernel_storage_.get() + offset,
+        resampler.kernel_storage_.get(), resampler.kernel_storage_.get(),
+        kKernelInterpolationFactor);
+    EXPECT_NEAR(result2, result, kEpsilon);
+  }
+}
+#endif
+
 // Benchmark for the various Convolve() methods.  Make sure to build with
 // branding=Chrome so that RTC_DCHECKs are compiled out when benchmarking.
 // Original benchmarks were run with --convolve-iterations=50000000.
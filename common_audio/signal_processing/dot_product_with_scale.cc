@@ -11,11 +11,48 @@
 #include "common_audio/signal_processing/dot_product_with_scale.h"
 
 #include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace {
+
+using DotProductWithScaleFunction = int32_t (*)(const int16_t*,
+                                                const int16_t*,
+                                                size_t,
+                                                int);
+
+DotProductWithScaleFunction SelectDotProductWithScaleFunction() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  return &WebRtcSpl_DotProductWithScaleSSE2;
+#else
+  // x86 CPU detection required.
+  if (WebRtc_GetCPUInfo(kSSE2))
+    return &WebRtcSpl_DotProductWithScaleSSE2;
+  return &WebRtcSpl_DotProductWithScaleC;
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return &WebRtcSpl_DotProductWithScaleNeon;
+#else
+  return &WebRtcSpl_DotProductWithScaleC;
+#endif
+}
+
+}  // namespace
 
 int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
                                       const int16_t* vector2,
                                       size_t length,
                                       int scaling) {
+  static const DotProductWithScaleFunction dot_product_function =
+      SelectDotProductWithScaleFunction();
+  return dot_product_function(vector1, vector2, length, scaling);
+}
+
+int32_t WebRtcSpl_DotProductWithScaleC(const int16_t* vector1,
+                                       const int16_t* vector2,
+                                       size_t length,
+                                       int scaling) {
   int64_t sum = 0;
   size_t i = 0;
 
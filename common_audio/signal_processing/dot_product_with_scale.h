@@ -14,6 +14,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "rtc_base/system/arch.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,6 +36,25 @@ int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
                                       size_t length,
                                       int scaling);
 
+// Implementations of WebRtcSpl_DotProductWithScale(), which selects the fastest
+// one the CPU supports. They all give the same result.
+int32_t WebRtcSpl_DotProductWithScaleC(const int16_t* vector1,
+                                       const int16_t* vector2,
+                                       size_t length,
+                                       int scaling);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int32_t WebRtcSpl_DotProductWithScaleSSE2(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+int32_t WebRtcSpl_DotProductWithScaleNeon(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling);
+#endif
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
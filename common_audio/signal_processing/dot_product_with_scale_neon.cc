@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/dot_product_with_scale.h"
+
+#include <arm_neon.h>
+
+#include "rtc_base/numerics/safe_conversions.h"
+
+int32_t WebRtcSpl_DotProductWithScaleNeon(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling) {
+  const int32x4_t shift = vdupq_n_s32(-scaling);
+  // Like in the C version, every term is shifted and added up in 64 bits.
+  int64x2_t sum = vdupq_n_s64(0);
+  size_t i = 0;
+  for (; i + 7 < length; i += 8) {
+    const int16x8_t a = vld1q_s16(&vector1[i]);
+    const int16x8_t b = vld1q_s16(&vector2[i]);
+    const int32x4_t low =
+        vshlq_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)), shift);
+    const int32x4_t high =
+        vshlq_s32(vmull_s16(vget_high_s16(a), vget_high_s16(b)), shift);
+    sum = vpadalq_s32(sum, low);
+    sum = vpadalq_s32(sum, high);
+  }
+  int64_t total = vgetq_lane_s64(sum, 0) + vgetq_lane_s64(sum, 1);
+  for (; i < length; i++) {
+    total += (vector1[i] * vector2[i]) >> scaling;
+  }
+
+  return rtc::saturated_cast<int32_t>(total);
+}
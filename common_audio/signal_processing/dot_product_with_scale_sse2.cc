@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/dot_product_with_scale.h"
+
+#include <emmintrin.h>
+
+#include "rtc_base/numerics/safe_conversions.h"
+
+int32_t WebRtcSpl_DotProductWithScaleSSE2(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  // Like in the C version, every term is shifted and added up in 64 bits.
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 7 < length; i += 8) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&vector1[i]));
+    const __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&vector2[i]));
+    const __m128i low = _mm_mullo_epi16(a, b);
+    const __m128i high = _mm_mulhi_epi16(a, b);
+    const __m128i terms[2] = {
+        _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift),
+        _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift)};
+    for (const __m128i& term : terms) {
+      const __m128i sign = _mm_srai_epi32(term, 31);
+      sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(term, sign));
+      sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(term, sign));
+    }
+  }
+  int64_t sums[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), sum);
+  int64_t total = sums[0] + sums[1];
+  for (; i < length; i++) {
+    total += (vector1[i] * vector2[i]) >> scaling;
+  }
+
+  return rtc::saturated_cast<int32_t>(total);
+}
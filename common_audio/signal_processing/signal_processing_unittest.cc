@@ -497,10 +497,10 @@ TEST_F(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
+  if (WebRtcSpl_CrossCorrelation == WebRtcSpl_CrossCorrelationNeon) {
     expected = kExpectedNeon;
   }
 #endif
@@ -509,6 +509,58 @@ TEST_F(SplTest, CrossCorrelationTest) {
   }
 }
 
+// Checks the vectorized versions of the kernels used by NetEq against the C
+// versions, on vectors long enough for the vectorized loops to run.
+TEST_F(SplTest, VectorizedKernelsMatchCTest) {
+  const size_t kLength = 203;
+  int16_t vector1[kLength];
+  int16_t vector2[kLength];
+  uint32_t seed = 17;
+  for (size_t i = 0; i < kLength; ++i) {
+    seed = seed * 1103515245 + 12345;
+    vector1[i] = static_cast<int16_t>(seed >> 16);
+    seed = seed * 1103515245 + 12345;
+    vector2[i] = static_cast<int16_t>(seed >> 16);
+  }
+  vector1[0] = vector2[0] = WEBRTC_SPL_WORD16_MIN;
+  vector1[9] = vector2[9] = WEBRTC_SPL_WORD16_MAX;
+
+  for (int scaling = 0; scaling < 16; scaling += 5) {
+    for (size_t length : {kLength, kLength - 3, size_t{8}}) {
+      EXPECT_EQ(
+          WebRtcSpl_DotProductWithScaleC(vector1, vector2, length, scaling),
+          WebRtcSpl_DotProductWithScale(vector1, vector2, length, scaling));
+    }
+  }
+
+  int16_t out[kLength];
+  int16_t expected_out[kLength];
+  for (int right_shifts = 0; right_shifts < 16; right_shifts += 5) {
+    EXPECT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRound(
+                     vector1, 16384, vector2, -5000, right_shifts, out,
+                     kLength));
+    EXPECT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRoundC(
+                     vector1, 16384, vector2, -5000, right_shifts,
+                     expected_out, kLength));
+    for (size_t i = 0; i < kLength; ++i)
+      EXPECT_EQ(expected_out[i], out[i]) << "Sample " << i;
+  }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // The Neon version of WebRtcSpl_CrossCorrelation() is not bit-exact.
+  const size_t kDimSeq = 120;
+  const size_t kDimCrossCorrelation = 40;
+  int32_t correlation[kDimCrossCorrelation];
+  int32_t expected_correlation[kDimCrossCorrelation];
+  WebRtcSpl_CrossCorrelation(correlation, vector1, vector2, kDimSeq,
+                             kDimCrossCorrelation, 6, 2);
+  WebRtcSpl_CrossCorrelationC(expected_correlation, vector1, vector2, kDimSeq,
+                              kDimCrossCorrelation, 6, 2);
+  for (size_t i = 0; i < kDimCrossCorrelation; ++i)
+    EXPECT_EQ(expected_correlation[i], correlation[i]) << "Lag " << i;
+#endif
+}
+
 TEST_F(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
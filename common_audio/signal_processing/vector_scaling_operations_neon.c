@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <arm_neon.h>
+
+/* NEON version of WebRtcSpl_ScaleAndAddVectorsWithRound(). The outputs are
+ * truncated to 16 bits like in the C version, not saturated. */
+int WebRtcSpl_ScaleAndAddVectorsWithRoundNeon(const int16_t* in_vector1,
+                                              int16_t in_vector1_scale,
+                                              const int16_t* in_vector2,
+                                              int16_t in_vector2_scale,
+                                              int right_shifts,
+                                              int16_t* out_vector,
+                                              size_t length) {
+  size_t i = 0;
+  int round_value = (1 << right_shifts) >> 1;
+  int32x4_t round;
+  int32x4_t shift;
+
+  if (in_vector1 == NULL || in_vector2 == NULL || out_vector == NULL ||
+      length == 0 || right_shifts < 0) {
+    return -1;
+  }
+
+  round = vdupq_n_s32(round_value);
+  shift = vdupq_n_s32(-right_shifts);
+  for (i = 0; i + 7 < length; i += 8) {
+    int16x8_t a = vld1q_s16(&in_vector1[i]);
+    int16x8_t b = vld1q_s16(&in_vector2[i]);
+    int32x4_t low = vmlal_n_s16(vmull_n_s16(vget_low_s16(a), in_vector1_scale),
+                                vget_low_s16(b), in_vector2_scale);
+    int32x4_t high =
+        vmlal_n_s16(vmull_n_s16(vget_high_s16(a), in_vector1_scale),
+                    vget_high_s16(b), in_vector2_scale);
+    low = vshlq_s32(vaddq_s32(low, round), shift);
+    high = vshlq_s32(vaddq_s32(high, round), shift);
+    vst1q_s16(&out_vector[i], vcombine_s16(vmovn_s32(low), vmovn_s32(high)));
+  }
+  for (; i < length; i++) {
+    out_vector[i] = (int16_t)((
+        in_vector1[i] * in_vector1_scale + in_vector2[i] * in_vector2_scale +
+        round_value) >> right_shifts);
+  }
+
+  return 0;
+}
@@ -45,6 +45,34 @@ class Vad {
 // Returns a Vad instance that's implemented on top of WebRtcVad.
 std::unique_ptr<Vad> CreateVad(Vad::Aggressiveness aggressiveness);
 
+// Calculates VAD decisions for many streams at once, e.g. for speaker
+// detection or DTX across the streams of a conference on a server. Each
+// stream gets the decisions a Vad of its own would give, but the frames of
+// several streams are processed in parallel.
+class MultiStreamVad {
+ public:
+  virtual ~MultiStreamVad() = default;
+
+  virtual size_t num_streams() const = 0;
+
+  // Calculates a VAD decision for the audio frame of each stream, in
+  // |audio|[stream], and writes it to |activities|[stream]. All frames have
+  // |num_samples| samples, at |sample_rate_hz|; see Vad::VoiceActivity().
+  virtual void VoiceActivity(const int16_t* const* audio,
+                             size_t num_samples,
+                             int sample_rate_hz,
+                             Vad::Activity* activities) = 0;
+
+  // Resets the VAD state of |stream|, e.g. when it's reused for a new source.
+  virtual void Reset(size_t stream) = 0;
+};
+
+// Returns a MultiStreamVad for |num_streams| streams that's implemented on top
+// of WebRtcVad.
+std::unique_ptr<MultiStreamVad> CreateMultiStreamVad(
+    size_t num_streams,
+    Vad::Aggressiveness aggressiveness);
+
 }  // namespace webrtc
 
 #endif  // COMMON_AUDIO_VAD_INCLUDE_VAD_H_
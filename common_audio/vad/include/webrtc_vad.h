@@ -71,6 +71,31 @@ int WebRtcVad_Process(VadInst* handle,
                       const int16_t* audio_frame,
                       size_t frame_length);
 
+// Calculates the VAD decisions of a frame of each of |num_streams| streams at
+// once, e.g. for speaker detection across the streams of a conference. The
+// decision of each stream is the one WebRtcVad_Process() would give, but the
+// streams are filtered several at a time, with SIMD where available.
+//
+// - handles      [i/o] : VAD instance of each stream. Need to be initialized
+//                        by WebRtcVad_Init() before call.
+// - num_streams  [i]   : Number of streams.
+// - fs           [i]   : Sampling frequency (Hz) of all streams: 8000, 16000,
+//                        32000 or 48000.
+// - audio_frames [i]   : Audio frame buffer of each stream.
+// - frame_length [i]   : Length of the audio frame buffers in number of
+//                        samples.
+// - decisions    [o]   : Decision of each stream, 1 - (Active Voice) or
+//                        0 - (Non-active Voice).
+//
+// returns              : 0 - (OK),
+//                       -1 - (Error, in which case no instance is updated)
+int WebRtcVad_ProcessMulti(VadInst* const* handles,
+                           size_t num_streams,
+                           int fs,
+                           const int16_t* const* audio_frames,
+                           size_t frame_length,
+                           int* decisions);
+
 // Checks for valid combinations of |rate| and |frame_length|. We support 10,
 // 20 and 30 ms frames and the rates 8000, 16000 and 32000 Hz.
 //
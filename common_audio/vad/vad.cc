@@ -10,7 +10,9 @@
 
 #include "common_audio/vad/include/vad.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "rtc_base/checks.h"
 
@@ -56,10 +58,68 @@ class VadImpl final : public Vad {
   Aggressiveness aggressiveness_;
 };
 
+class MultiStreamVadImpl final : public MultiStreamVad {
+ public:
+  MultiStreamVadImpl(size_t num_streams, Vad::Aggressiveness aggressiveness)
+      : handles_(num_streams, nullptr),
+        decisions_(num_streams),
+        aggressiveness_(aggressiveness) {
+    for (size_t stream = 0; stream < num_streams; ++stream)
+      Reset(stream);
+  }
+
+  ~MultiStreamVadImpl() override {
+    for (VadInst* handle : handles_)
+      WebRtcVad_Free(handle);
+  }
+
+  size_t num_streams() const override { return handles_.size(); }
+
+  void VoiceActivity(const int16_t* const* audio,
+                     size_t num_samples,
+                     int sample_rate_hz,
+                     Vad::Activity* activities) override {
+    int ret = WebRtcVad_ProcessMulti(handles_.data(), handles_.size(),
+                                     sample_rate_hz, audio, num_samples,
+                                     decisions_.data());
+    if (ret != 0) {
+      RTC_NOTREACHED() << "WebRtcVad_ProcessMulti returned an error.";
+      std::fill(activities, activities + handles_.size(), Vad::kError);
+      return;
+    }
+    for (size_t stream = 0; stream < handles_.size(); ++stream) {
+      activities[stream] =
+          decisions_[stream] == 1 ? Vad::kActive : Vad::kPassive;
+    }
+  }
+
+  void Reset(size_t stream) override {
+    RTC_DCHECK_LT(stream, handles_.size());
+    if (handles_[stream])
+      WebRtcVad_Free(handles_[stream]);
+    handles_[stream] = WebRtcVad_Create();
+    RTC_CHECK(handles_[stream]);
+    RTC_CHECK_EQ(WebRtcVad_Init(handles_[stream]), 0);
+    RTC_CHECK_EQ(WebRtcVad_set_mode(handles_[stream], aggressiveness_), 0);
+  }
+
+ private:
+  std::vector<VadInst*> handles_;
+  std::vector<int> decisions_;
+  const Vad::Aggressiveness aggressiveness_;
+};
+
 }  // namespace
 
 std::unique_ptr<Vad> CreateVad(Vad::Aggressiveness aggressiveness) {
   return std::unique_ptr<Vad>(new VadImpl(aggressiveness));
 }
 
+std::unique_ptr<MultiStreamVad> CreateMultiStreamVad(
+    size_t num_streams,
+    Vad::Aggressiveness aggressiveness) {
+  return std::unique_ptr<MultiStreamVad>(
+      new MultiStreamVadImpl(num_streams, aggressiveness));
+}
+
 }  // namespace webrtc
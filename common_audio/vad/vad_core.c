@@ -601,72 +601,71 @@ int WebRtcVad_set_mode_core(VadInstT* self, int mode) {
   return return_value;
 }
 
+// Downsamples |speech_frame|, sampled at |fs|, to 8 kHz into |speech_nb|.
+// Returns the downsampled frame, which is |speech_frame| itself at 8 kHz.
+static const int16_t* DownsampleTo8khz(VadInstT* inst, int fs,
+                                       const int16_t* speech_frame,
+                                       size_t frame_length,
+                                       int16_t* speech_nb) {
+  int16_t speech_wb[480];  // 30 ms in 16 kHz.
+  size_t i;
+
+  if (fs == 48000) {
+    // |tmp_mem| is a temporary memory used by resample function, length is
+    // frame length in 10 ms (480 samples) + 256 extra.
+    int32_t tmp_mem[480 + 256] = { 0 };
+    for (i = 0; i < frame_length / 480; i++) {
+      WebRtcSpl_Resample48khzTo8khz(speech_frame, &speech_nb[i * 80],
+                                    &inst->state_48_to_8, tmp_mem);
+    }
+  } else if (fs == 32000) {
+    WebRtcVad_Downsampling(speech_frame, speech_wb,
+                           &inst->downsampling_filter_states[2], frame_length);
+    WebRtcVad_Downsampling(speech_wb, speech_nb,
+                           inst->downsampling_filter_states, frame_length / 2);
+  } else if (fs == 16000) {
+    WebRtcVad_Downsampling(speech_frame, speech_nb,
+                           inst->downsampling_filter_states, frame_length);
+  } else {
+    return speech_frame;
+  }
+  return speech_nb;
+}
+
 // Calculate VAD decision by first extracting feature values and then calculate
 // probability for both speech and background noise.
 
 int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
                            size_t frame_length) {
-  int vad;
-  size_t i;
   int16_t speech_nb[240];  // 30 ms in 8 kHz.
-  // |tmp_mem| is a temporary memory used by resample function, length is
-  // frame length in 10 ms (480 samples) + 256 extra.
-  int32_t tmp_mem[480 + 256] = { 0 };
-  const size_t kFrameLen10ms48khz = 480;
-  const size_t kFrameLen10ms8khz = 80;
-  size_t num_10ms_frames = frame_length / kFrameLen10ms48khz;
-
-  for (i = 0; i < num_10ms_frames; i++) {
-    WebRtcSpl_Resample48khzTo8khz(speech_frame,
-                                  &speech_nb[i * kFrameLen10ms8khz],
-                                  &inst->state_48_to_8,
-                                  tmp_mem);
-  }
 
   // Do VAD on an 8 kHz signal
-  vad = WebRtcVad_CalcVad8khz(inst, speech_nb, frame_length / 6);
-
-  return vad;
+  return WebRtcVad_CalcVad8khz(
+      inst, DownsampleTo8khz(inst, 48000, speech_frame, frame_length,
+                             speech_nb),
+      frame_length / 6);
 }
 
 int WebRtcVad_CalcVad32khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
-{
-    size_t len;
-    int vad;
-    int16_t speechWB[480]; // Downsampled speech frame: 960 samples (30ms in SWB)
-    int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
-
-
-    // Downsample signal 32->16->8 before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechWB, &(inst->downsampling_filter_states[2]),
-                           frame_length);
-    len = frame_length / 2;
-
-    WebRtcVad_Downsampling(speechWB, speechNB, inst->downsampling_filter_states, len);
-    len /= 2;
-
-    // Do VAD on an 8 kHz signal
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
+                           size_t frame_length) {
+  int16_t speech_nb[240];  // 30 ms in 8 kHz.
 
-    return vad;
+  // Do VAD on an 8 kHz signal
+  return WebRtcVad_CalcVad8khz(
+      inst, DownsampleTo8khz(inst, 32000, speech_frame, frame_length,
+                             speech_nb),
+      frame_length / 4);
 }
 
 int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
-{
-    size_t len;
-    int vad;
-    int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
-
-    // Wideband: Downsample signal before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechNB, inst->downsampling_filter_states,
-                           frame_length);
-
-    len = frame_length / 2;
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
+                           size_t frame_length) {
+  int16_t speech_nb[240];  // 30 ms in 8 kHz.
 
-    return vad;
+  // Do VAD on an 8 kHz signal
+  return WebRtcVad_CalcVad8khz(
+      inst, DownsampleTo8khz(inst, 16000, speech_frame, frame_length,
+                             speech_nb),
+      frame_length / 2);
 }
 
 int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
@@ -683,3 +682,40 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
 
     return inst->vad;
 }
+
+void WebRtcVad_CalcVadMulti(VadInstT* const* insts, size_t num_streams, int fs,
+                            const int16_t* const* speech_frames,
+                            size_t frame_length, int* vads) {
+  int16_t speech_nb[kVadLanes][240];  // 30 ms in 8 kHz.
+  const int16_t* frames_nb[kVadLanes];
+  int16_t feature_vectors[kVadLanes * kNumChannels];
+  int16_t total_powers[kVadLanes];
+  const size_t length_nb = frame_length / (size_t) (fs / 8000);
+  size_t first;
+  size_t num_lanes;
+  size_t k;
+
+  for (first = 0; first < num_streams; first += kVadLanes) {
+    num_lanes = num_streams - first;
+    if (num_lanes > kVadLanes) {
+      num_lanes = kVadLanes;
+    }
+
+    for (k = 0; k < num_lanes; k++) {
+      frames_nb[k] = DownsampleTo8khz(insts[first + k], fs,
+                                      speech_frames[first + k], frame_length,
+                                      speech_nb[k]);
+    }
+
+    // Get power in the bands of all streams at once.
+    WebRtcVad_CalculateFeaturesMulti(&insts[first], num_lanes, frames_nb,
+                                     length_nb, feature_vectors, total_powers);
+
+    for (k = 0; k < num_lanes; k++) {
+      VadInstT* inst = insts[first + k];
+      inst->vad = GmmProbability(inst, &feature_vectors[k * kNumChannels],
+                                 total_powers[k], length_nb);
+      vads[first + k] = inst->vad;
+    }
+  }
+}
@@ -21,6 +21,7 @@ enum { kNumChannels = 6 };   // Number of frequency bands (named channels).
 enum { kNumGaussians = 2 };  // Number of Gaussians per channel in the GMM.
 enum { kTableSize = kNumChannels * kNumGaussians };
 enum { kMinEnergy = 10 };  // Minimum energy required to trigger audio signal.
+enum { kVadLanes = 8 };  // Number of streams filtered at once.
 
 typedef struct VadInstT_ {
   int vad;
@@ -111,4 +112,31 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst,
                           const int16_t* speech_frame,
                           size_t frame_length);
 
+/****************************************************************************
+ * WebRtcVad_CalcVadMulti(...)
+ *
+ * Calculates the VAD decisions of a frame of each of |num_streams| streams,
+ * like WebRtcVad_CalcVad{48,32,16,8}khz() do for each of them, but with the
+ * features of |kVadLanes| streams calculated at once.
+ *
+ * Input:
+ *      - insts         : Instance of each stream
+ *      - num_streams   : Number of streams
+ *      - fs            : Sampling frequency of all streams
+ *      - speech_frames : Input speech frame of each stream
+ *      - frame_length  : Number of input samples of each stream
+ *
+ * Output:
+ *      - insts         : Updated filter states etc.
+ *      - vads          : VAD decision of each stream
+ *                        0 - No active speech
+ *                        1-6 - Active speech
+ */
+void WebRtcVad_CalcVadMulti(VadInstT* const* insts,
+                            size_t num_streams,
+                            int fs,
+                            const int16_t* const* speech_frames,
+                            size_t frame_length,
+                            int* vads);
+
 #endif  // COMMON_AUDIO_VAD_VAD_CORE_H_
@@ -10,8 +10,11 @@
 
 #include "common_audio/vad/vad_filterbank.h"
 
+#include <string.h>
+
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 // Constants used in LogOfEnergy().
 static const int16_t kLogConst = 24660;  // 160*log10(2) in Q9.
@@ -104,6 +107,36 @@ static void AllPassFilter(const int16_t* data_in, size_t data_length,
   *filter_state = (int16_t) (state32 >> 16);  // Q(-1)
 }
 
+void WebRtcVad_AllPassFilterLanesC(const int16_t* data_in, size_t data_length,
+                                   int16_t filter_coefficient,
+                                   int16_t* filter_state, int16_t* data_out) {
+  size_t i;
+  size_t k;
+  int16_t tmp16 = 0;
+  int32_t tmp32 = 0;
+  int32_t state32[kVadLanes];
+
+  for (k = 0; k < kVadLanes; k++) {
+    state32[k] = ((int32_t) filter_state[k] * (1 << 16));  // Q15
+  }
+
+  for (i = 0; i < data_length; i++) {
+    for (k = 0; k < kVadLanes; k++) {
+      tmp32 = state32[k] + filter_coefficient * data_in[k];
+      tmp16 = (int16_t) (tmp32 >> 16);  // Q(-1)
+      data_out[k] = tmp16;
+      state32[k] = (data_in[k] * (1 << 14)) - filter_coefficient * tmp16;
+      state32[k] *= 2;  // Q15.
+    }
+    data_in += 2 * kVadLanes;
+    data_out += kVadLanes;
+  }
+
+  for (k = 0; k < kVadLanes; k++) {
+    filter_state[k] = (int16_t) (state32[k] >> 16);  // Q(-1)
+  }
+}
+
 // Splits |data_in| into |hp_data_out| and |lp_data_out| corresponding to
 // an upper (high pass) part and a lower (low pass) part respectively.
 //
@@ -138,6 +171,33 @@ static void SplitFilter(const int16_t* data_in, size_t data_length,
   }
 }
 
+// SplitFilter() of |kVadLanes| interleaved signals, see
+// WebRtcVad_AllPassFilterLanesC() for the layout. |upper_state| and
+// |lower_state| hold the state of each lane.
+static void SplitFilterLanes(AllPassFilterLanes all_pass_filter,
+                             const int16_t* data_in, size_t data_length,
+                             int16_t* upper_state, int16_t* lower_state,
+                             int16_t* hp_data_out, int16_t* lp_data_out) {
+  size_t i;
+  size_t half_length = data_length >> 1;  // Downsampling by 2.
+  int16_t tmp_out;
+
+  // All-pass filtering upper branch.
+  all_pass_filter(&data_in[0], half_length, kAllPassCoefsQ15[0], upper_state,
+                  hp_data_out);
+
+  // All-pass filtering lower branch.
+  all_pass_filter(&data_in[kVadLanes], half_length, kAllPassCoefsQ15[1],
+                  lower_state, lp_data_out);
+
+  // Make LP and HP signals.
+  for (i = 0; i < half_length * kVadLanes; i++) {
+    tmp_out = hp_data_out[i];
+    hp_data_out[i] -= lp_data_out[i];
+    lp_data_out[i] += tmp_out;
+  }
+}
+
 // Calculates the energy of |data_in| in dB, and also updates an overall
 // |total_energy| if necessary.
 //
@@ -327,3 +387,135 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
 
   return total_energy;
 }
+
+// Returns the fastest WebRtcVad_AllPassFilterLanes*() the CPU supports.
+static AllPassFilterLanes SelectAllPassFilterLanes(void) {
+#if defined(WEBRTC_HAS_NEON)
+  return WebRtcVad_AllPassFilterLanesNeon;
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  return WebRtcVad_AllPassFilterLanesSSE2;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  return WebRtc_GetCPUInfo(kSSE2) ? WebRtcVad_AllPassFilterLanesSSE2
+                                  : WebRtcVad_AllPassFilterLanesC;
+#else
+  return WebRtcVad_AllPassFilterLanesC;
+#endif
+}
+
+// Calls LogOfEnergy() on each of the |num_lanes| first lanes of the
+// |kVadLanes| interleaved signals in |data_in|, for the feature |channel|.
+static void LogOfEnergyLanes(const int16_t* data_in, size_t data_length,
+                             size_t num_lanes, int channel,
+                             int16_t* total_energies, int16_t* features) {
+  int16_t lane_data[60];
+  size_t i;
+  size_t k;
+
+  for (k = 0; k < num_lanes; k++) {
+    for (i = 0; i < data_length; i++) {
+      lane_data[i] = data_in[i * kVadLanes + k];
+    }
+    LogOfEnergy(lane_data, data_length, kOffsetVector[channel],
+                &total_energies[k], &features[k * kNumChannels + channel]);
+  }
+}
+
+void WebRtcVad_CalculateFeaturesMulti(VadInstT* const* selves,
+                                      size_t num_streams,
+                                      const int16_t* const* data_in,
+                                      size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energies) {
+  const AllPassFilterLanes all_pass_filter = SelectAllPassFilterLanes();
+  // The buffers of WebRtcVad_CalculateFeatures(), for |kVadLanes| streams.
+  int16_t in[240 * kVadLanes];
+  int16_t hp_120[120 * kVadLanes], lp_120[120 * kVadLanes];
+  int16_t hp_60[60 * kVadLanes], lp_60[60 * kVadLanes];
+  int16_t upper_state[5 * kVadLanes], lower_state[5 * kVadLanes];
+  int16_t lane_lp[15], lane_hp[15];
+  const size_t half_data_length = data_length >> 1;
+  size_t length;
+  size_t first;
+  size_t num_lanes;
+  size_t i;
+  size_t k;
+  int band;
+
+  RTC_DCHECK_LE(data_length, 240);
+
+  for (first = 0; first < num_streams; first += kVadLanes) {
+    num_lanes = num_streams - first;
+    if (num_lanes > kVadLanes) {
+      num_lanes = kVadLanes;
+    }
+
+    // Interleave the streams, with silence in the unused lanes.
+    memset(in, 0, sizeof(in));
+    memset(upper_state, 0, sizeof(upper_state));
+    memset(lower_state, 0, sizeof(lower_state));
+    for (k = 0; k < num_lanes; k++) {
+      const VadInstT* self = selves[first + k];
+      for (i = 0; i < data_length; i++) {
+        in[i * kVadLanes + k] = data_in[first + k][i];
+      }
+      for (band = 0; band < 5; band++) {
+        upper_state[band * kVadLanes + k] = self->upper_state[band];
+        lower_state[band * kVadLanes + k] = self->lower_state[band];
+      }
+      total_energies[first + k] = 0;
+    }
+
+    // The same band splits as in WebRtcVad_CalculateFeatures().
+    SplitFilterLanes(all_pass_filter, in, data_length, &upper_state[0],
+                     &lower_state[0], hp_120, lp_120);
+
+    length = half_data_length;
+    SplitFilterLanes(all_pass_filter, hp_120, length, &upper_state[kVadLanes],
+                     &lower_state[kVadLanes], hp_60, lp_60);
+    length >>= 1;
+    LogOfEnergyLanes(hp_60, length, num_lanes, 5, &total_energies[first],
+                     &features[first * kNumChannels]);
+    LogOfEnergyLanes(lp_60, length, num_lanes, 4, &total_energies[first],
+                     &features[first * kNumChannels]);
+
+    length = half_data_length;
+    SplitFilterLanes(all_pass_filter, lp_120, length,
+                     &upper_state[2 * kVadLanes], &lower_state[2 * kVadLanes],
+                     hp_60, lp_60);
+    length >>= 1;
+    LogOfEnergyLanes(hp_60, length, num_lanes, 3, &total_energies[first],
+                     &features[first * kNumChannels]);
+
+    SplitFilterLanes(all_pass_filter, lp_60, length,
+                     &upper_state[3 * kVadLanes], &lower_state[3 * kVadLanes],
+                     hp_120, lp_120);
+    length >>= 1;
+    LogOfEnergyLanes(hp_120, length, num_lanes, 2, &total_energies[first],
+                     &features[first * kNumChannels]);
+
+    SplitFilterLanes(all_pass_filter, lp_120, length,
+                     &upper_state[4 * kVadLanes], &lower_state[4 * kVadLanes],
+                     hp_60, lp_60);
+    length >>= 1;
+    LogOfEnergyLanes(hp_60, length, num_lanes, 1, &total_energies[first],
+                     &features[first * kNumChannels]);
+
+    // The high pass filter runs on |data_length| / 16 samples only, so it
+    // isn't worth interleaving.
+    for (k = 0; k < num_lanes; k++) {
+      VadInstT* self = selves[first + k];
+      for (i = 0; i < length; i++) {
+        lane_lp[i] = lp_60[i * kVadLanes + k];
+      }
+      HighPassFilter(lane_lp, length, self->hp_filter_state, lane_hp);
+      LogOfEnergy(lane_hp, length, kOffsetVector[0],
+                  &total_energies[first + k],
+                  &features[(first + k) * kNumChannels]);
+
+      for (band = 0; band < 5; band++) {
+        self->upper_state[band] = upper_state[band * kVadLanes + k];
+        self->lower_state[band] = lower_state[band * kVadLanes + k];
+      }
+    }
+  }
+}
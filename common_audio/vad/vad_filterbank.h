@@ -42,4 +42,59 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self,
                                     size_t data_length,
                                     int16_t* features);
 
+// Calculates the features of |num_streams| streams at once, like
+// WebRtcVad_CalculateFeatures() does for each of them. The streams are
+// filtered |kVadLanes| at a time, with their samples interleaved so that each
+// stream is a SIMD lane.
+//
+// - selves         [i/o] : State information of the VAD of each stream.
+// - num_streams    [i]   : Number of streams.
+// - data_in        [i]   : Input audio data of each stream.
+// - data_length    [i]   : Audio data size of each stream, in number of
+//                          samples.
+// - features       [o]   : The |kNumChannels| features of each stream, one
+//                          stream after the other, Q4.
+// - total_energies [o]   : Total energy of each stream.
+void WebRtcVad_CalculateFeaturesMulti(VadInstT* const* selves,
+                                      size_t num_streams,
+                                      const int16_t* const* data_in,
+                                      size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energies);
+
+// All pass filters the even samples of |kVadLanes| interleaved signals, i.e.
+// |data_in| holds sample n of lane k at |data_in|[n * |kVadLanes| + k], and
+// |data_out| and |filter_state| are interleaved the same way. Each lane is
+// filtered like the all pass filters of WebRtcVad_CalculateFeatures().
+//
+// - data_in            [i]   : Input audio signal given in Q0.
+// - data_length        [i]   : Number of output samples per lane.
+// - filter_coefficient [i]   : Given in Q15.
+// - filter_state       [i/o] : State of the filter of each lane, in Q(-1).
+// - data_out           [o]   : Output audio signal given in Q(-1).
+typedef void (*AllPassFilterLanes)(const int16_t* data_in,
+                                   size_t data_length,
+                                   int16_t filter_coefficient,
+                                   int16_t* filter_state,
+                                   int16_t* data_out);
+void WebRtcVad_AllPassFilterLanesC(const int16_t* data_in,
+                                   size_t data_length,
+                                   int16_t filter_coefficient,
+                                   int16_t* filter_state,
+                                   int16_t* data_out);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcVad_AllPassFilterLanesSSE2(const int16_t* data_in,
+                                      size_t data_length,
+                                      int16_t filter_coefficient,
+                                      int16_t* filter_state,
+                                      int16_t* data_out);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void WebRtcVad_AllPassFilterLanesNeon(const int16_t* data_in,
+                                      size_t data_length,
+                                      int16_t filter_coefficient,
+                                      int16_t* filter_state,
+                                      int16_t* data_out);
+#endif
+
 #endif  // COMMON_AUDIO_VAD_VAD_FILTERBANK_H_
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/vad/vad_filterbank.h"
+
+#include <arm_neon.h>
+
+// NEON version of WebRtcVad_AllPassFilterLanesC(), with the |kVadLanes| = 8
+// lanes in one register. The products are computed in 32 bits, so the output
+// is bit exact with the C version.
+void WebRtcVad_AllPassFilterLanesNeon(const int16_t* data_in,
+                                      size_t data_length,
+                                      int16_t filter_coefficient,
+                                      int16_t* filter_state,
+                                      int16_t* data_out) {
+  size_t i;
+  const int16x4_t coefficient = vdup_n_s16(filter_coefficient);
+  const int16x8_t state = vld1q_s16(filter_state);
+  // Q15.
+  int32x4_t state_low = vshll_n_s16(vget_low_s16(state), 16);
+  int32x4_t state_high = vshll_n_s16(vget_high_s16(state), 16);
+
+  for (i = 0; i < data_length; i++) {
+    const int16x8_t in = vld1q_s16(data_in);
+    const int16x4_t in_low = vget_low_s16(in);
+    const int16x4_t in_high = vget_high_s16(in);
+    // Q(-1).
+    const int16x4_t out_low =
+        vshrn_n_s32(vmlal_s16(state_low, in_low, coefficient), 16);
+    const int16x4_t out_high =
+        vshrn_n_s32(vmlal_s16(state_high, in_high, coefficient), 16);
+    vst1q_s16(data_out, vcombine_s16(out_low, out_high));
+    // Q14, then Q15.
+    state_low = vshlq_n_s32(
+        vmlsl_s16(vshll_n_s16(in_low, 14), out_low, coefficient), 1);
+    state_high = vshlq_n_s32(
+        vmlsl_s16(vshll_n_s16(in_high, 14), out_high, coefficient), 1);
+    data_in += 2 * kVadLanes;
+    data_out += kVadLanes;
+  }
+
+  vst1q_s16(filter_state, vcombine_s16(vshrn_n_s32(state_low, 16),
+                                       vshrn_n_s32(state_high, 16)));
+}
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/vad/vad_filterbank.h"
+
+#include <emmintrin.h>
+
+// SSE2 version of WebRtcVad_AllPassFilterLanesC(), with the |kVadLanes| = 8
+// lanes in one register. The products are computed in 32 bits with
+// _mm_madd_epi16(), so the output is bit exact with the C version.
+void WebRtcVad_AllPassFilterLanesSSE2(const int16_t* data_in,
+                                      size_t data_length,
+                                      int16_t filter_coefficient,
+                                      int16_t* filter_state,
+                                      int16_t* data_out) {
+  size_t i;
+  const __m128i zero = _mm_setzero_si128();
+  // Pairs (|filter_coefficient|, 0), and (2^14, -|filter_coefficient|).
+  const __m128i in_coefs = _mm_set1_epi32((uint16_t)filter_coefficient);
+  const __m128i state_coefs = _mm_set1_epi32(
+      (int32_t)(((uint32_t)(uint16_t)(-filter_coefficient) << 16) | 16384));
+  const __m128i state = _mm_loadu_si128((const __m128i*)filter_state);
+  // Q15.
+  __m128i state_low = _mm_unpacklo_epi16(zero, state);
+  __m128i state_high = _mm_unpackhi_epi16(zero, state);
+
+  for (i = 0; i < data_length; i++) {
+    const __m128i in = _mm_loadu_si128((const __m128i*)data_in);
+    const __m128i tmp_low = _mm_add_epi32(
+        state_low, _mm_madd_epi16(_mm_unpacklo_epi16(in, zero), in_coefs));
+    const __m128i tmp_high = _mm_add_epi32(
+        state_high, _mm_madd_epi16(_mm_unpackhi_epi16(in, zero), in_coefs));
+    // Q(-1). The shifted values fit in 16 bits, so the pack doesn't saturate.
+    const __m128i out = _mm_packs_epi32(_mm_srai_epi32(tmp_low, 16),
+                                        _mm_srai_epi32(tmp_high, 16));
+    _mm_storeu_si128((__m128i*)data_out, out);
+    // Q14, then Q15.
+    state_low = _mm_slli_epi32(
+        _mm_madd_epi16(_mm_unpacklo_epi16(in, out), state_coefs), 1);
+    state_high = _mm_slli_epi32(
+        _mm_madd_epi16(_mm_unpackhi_epi16(in, out), state_coefs), 1);
+    data_in += 2 * kVadLanes;
+    data_out += kVadLanes;
+  }
+
+  _mm_storeu_si128((__m128i*)filter_state,
+                   _mm_packs_epi32(_mm_srai_epi32(state_low, 16),
+                                   _mm_srai_epi32(state_high, 16)));
+}
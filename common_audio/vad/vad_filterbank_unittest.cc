@@ -10,6 +10,8 @@
 
 #include <stdlib.h>
 
+#include <vector>
+
 #include "common_audio/vad/vad_unittest.h"
 #include "test/gtest.h"
 
@@ -87,5 +89,87 @@ TEST_F(VadTest, vad_filterbank) {
 
   free(self);
 }
+
+TEST_F(VadTest, vad_filterbank_multi) {
+  // More streams than lanes, to also have unused lanes.
+  const size_t kNumStreams = 2 * kVadLanes + 3;
+  std::vector<VadInstT> selves(kNumStreams);
+  std::vector<VadInstT> reference_selves(kNumStreams);
+  std::vector<VadInstT*> self_pointers(kNumStreams);
+  std::vector<std::vector<int16_t>> speech(
+      kNumStreams, std::vector<int16_t>(kMaxFrameLength));
+  std::vector<const int16_t*> speech_pointers(kNumStreams);
+  std::vector<int16_t> features(kNumStreams * kNumChannels);
+  std::vector<int16_t> total_energies(kNumStreams);
+  int16_t reference_features[kNumChannels];
+  uint32_t seed = 1;
+
+  for (size_t k = 0; k < kNumStreams; ++k) {
+    ASSERT_EQ(0, WebRtcVad_InitCore(&selves[k]));
+    ASSERT_EQ(0, WebRtcVad_InitCore(&reference_selves[k]));
+    self_pointers[k] = &selves[k];
+    speech_pointers[k] = speech[k].data();
+  }
+
+  for (size_t j = 0; j < kFrameLengthsSize; ++j) {
+    if (!ValidRatesAndFrameLengths(8000, kFrameLengths[j]))
+      continue;
+    // Full scale noise in some streams, quieter noise or silence in others.
+    for (size_t k = 0; k < kNumStreams; ++k) {
+      for (size_t i = 0; i < kFrameLengths[j]; ++i) {
+        seed = seed * 1664525 + 1013904223;
+        speech[k][i] = static_cast<int16_t>(seed >> 16) >> (k % 16);
+      }
+    }
+
+    WebRtcVad_CalculateFeaturesMulti(self_pointers.data(), kNumStreams,
+                                     speech_pointers.data(), kFrameLengths[j],
+                                     features.data(), total_energies.data());
+    for (size_t k = 0; k < kNumStreams; ++k) {
+      EXPECT_EQ(WebRtcVad_CalculateFeatures(&reference_selves[k],
+                                            speech[k].data(), kFrameLengths[j],
+                                            reference_features),
+                total_energies[k]);
+      for (int c = 0; c < kNumChannels; ++c) {
+        EXPECT_EQ(reference_features[c], features[k * kNumChannels + c]);
+      }
+    }
+  }
+}
+
+TEST_F(VadTest, vad_filterbank_all_pass_lanes) {
+  const size_t kLength = 60;
+  int16_t data_in[2 * kLength * kVadLanes];
+  int16_t reference_out[kLength * kVadLanes];
+  int16_t reference_state[kVadLanes] = {0};
+  int16_t out[kLength * kVadLanes];
+  int16_t state[kVadLanes] = {0};
+  uint32_t seed = 1;
+
+  // Random samples, with runs of the extreme values in some lanes.
+  for (size_t i = 0; i < 2 * kLength * kVadLanes; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    data_in[i] = static_cast<int16_t>(seed >> 16);
+    if (i / kVadLanes % 8 < 4 && i % kVadLanes < 2)
+      data_in[i] = i % kVadLanes == 0 ? 32767 : -32768;
+  }
+  WebRtcVad_AllPassFilterLanesC(data_in, kLength, 20972, reference_state,
+                                reference_out);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  WebRtcVad_AllPassFilterLanesSSE2(data_in, kLength, 20972, state, out);
+#elif defined(WEBRTC_HAS_NEON)
+  WebRtcVad_AllPassFilterLanesNeon(data_in, kLength, 20972, state, out);
+#else
+  WebRtcVad_AllPassFilterLanesC(data_in, kLength, 20972, state, out);
+#endif
+  for (size_t i = 0; i < kLength * kVadLanes; ++i) {
+    EXPECT_EQ(reference_out[i], out[i]);
+  }
+  for (size_t k = 0; k < kVadLanes; ++k) {
+    EXPECT_EQ(reference_state[k], state[k]);
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
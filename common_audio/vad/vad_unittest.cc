@@ -12,6 +12,8 @@
 
 #include <stdlib.h>
 
+#include <vector>
+
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "common_audio/vad/include/webrtc_vad.h"
 #include "rtc_base/arraysize.h"
@@ -142,6 +144,81 @@ TEST_F(VadTest, ValidRatesFrameLengths) {
   }
 }
 
+TEST_F(VadTest, ProcessMulti) {
+  // More streams than are processed at once, with an uneven remainder.
+  const size_t kNumStreams = 19;
+  const int kNumFrames = 20;
+  std::vector<VadInst*> handles(kNumStreams);
+  std::vector<VadInst*> reference_handles(kNumStreams);
+  std::vector<std::vector<int16_t>> frames(
+      kNumStreams, std::vector<int16_t>(kMaxFrameLength));
+  std::vector<const int16_t*> frame_pointers(kNumStreams);
+  std::vector<int> decisions(kNumStreams);
+  uint32_t seed = 1;
+
+  for (size_t i = 0; i < kRatesSize; i++) {
+    for (size_t j = 0; j < kFrameLengthsSize; j++) {
+      if (!ValidRatesAndFrameLengths(kRates[i], kFrameLengths[j]))
+        continue;
+      for (size_t k = 0; k < kNumStreams; k++) {
+        handles[k] = WebRtcVad_Create();
+        reference_handles[k] = WebRtcVad_Create();
+        ASSERT_EQ(0, WebRtcVad_Init(handles[k]));
+        ASSERT_EQ(0, WebRtcVad_Init(reference_handles[k]));
+        const int mode = kModes[k % kModesSize];
+        ASSERT_EQ(0, WebRtcVad_set_mode(handles[k], mode));
+        ASSERT_EQ(0, WebRtcVad_set_mode(reference_handles[k], mode));
+        frame_pointers[k] = frames[k].data();
+      }
+
+      for (int n = 0; n < kNumFrames; n++) {
+        // Noise bursts of different levels, so that the decisions of the
+        // streams differ and change over time.
+        for (size_t k = 0; k < kNumStreams; k++) {
+          const int shift = (n / 4 + static_cast<int>(k)) % 16;
+          for (size_t m = 0; m < kFrameLengths[j]; m++) {
+            seed = seed * 1664525 + 1013904223;
+            frames[k][m] = static_cast<int16_t>(seed >> 16) >> shift;
+          }
+        }
+
+        ASSERT_EQ(0, WebRtcVad_ProcessMulti(handles.data(), kNumStreams,
+                                            kRates[i], frame_pointers.data(),
+                                            kFrameLengths[j],
+                                            decisions.data()));
+        for (size_t k = 0; k < kNumStreams; k++) {
+          EXPECT_EQ(WebRtcVad_Process(reference_handles[k], kRates[i],
+                                      frames[k].data(), kFrameLengths[j]),
+                    decisions[k]);
+        }
+      }
+
+      for (size_t k = 0; k < kNumStreams; k++) {
+        WebRtcVad_Free(handles[k]);
+        WebRtcVad_Free(reference_handles[k]);
+      }
+    }
+  }
+
+  // Invalid arguments.
+  VadInst* handle = WebRtcVad_Create();
+  const int16_t* frame = frames[0].data();
+  int decision = 0;
+  EXPECT_EQ(-1, WebRtcVad_ProcessMulti(&handle, 1, kRates[0], &frame,
+                                       kFrameLengths[0], &decision));
+  ASSERT_EQ(0, WebRtcVad_Init(handle));
+  EXPECT_EQ(-1, WebRtcVad_ProcessMulti(&handle, 1, 9999, &frame,
+                                       kFrameLengths[0], &decision));
+  EXPECT_EQ(-1, WebRtcVad_ProcessMulti(&handle, 1, kRates[0], &frame, 1,
+                                       &decision));
+  const int16_t* null_frame = nullptr;
+  EXPECT_EQ(-1, WebRtcVad_ProcessMulti(&handle, 1, kRates[0], &null_frame,
+                                       kFrameLengths[0], &decision));
+  EXPECT_EQ(0, WebRtcVad_ProcessMulti(&handle, 1, kRates[0], &frame,
+                                      kFrameLengths[0], &decision));
+  WebRtcVad_Free(handle);
+}
+
 // TODO(bjornv): Add a process test, run on file.
 
 }  // namespace test
@@ -89,6 +89,38 @@ int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
   return vad;
 }
 
+int WebRtcVad_ProcessMulti(VadInst* const* handles, size_t num_streams,
+                           int fs, const int16_t* const* audio_frames,
+                           size_t frame_length, int* decisions) {
+  size_t i;
+
+  if (handles == NULL || audio_frames == NULL || decisions == NULL) {
+    return -1;
+  }
+  for (i = 0; i < num_streams; i++) {
+    const VadInstT* self = (const VadInstT*) handles[i];
+    if (self == NULL || self->init_flag != kInitCheck) {
+      return -1;
+    }
+    if (audio_frames[i] == NULL) {
+      return -1;
+    }
+  }
+  if (WebRtcVad_ValidRateAndFrameLength(fs, frame_length) != 0) {
+    return -1;
+  }
+
+  WebRtcVad_CalcVadMulti((VadInstT* const*) handles, num_streams, fs,
+                         audio_frames, frame_length, decisions);
+
+  for (i = 0; i < num_streams; i++) {
+    if (decisions[i] > 0) {
+      decisions[i] = 1;
+    }
+  }
+  return 0;
+}
+
 int WebRtcVad_ValidRateAndFrameLength(int rate, size_t frame_length) {
   int return_value = -1;
   size_t i;
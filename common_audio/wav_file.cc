@@ -14,6 +14,7 @@
 #include <cstdio>
 #include <limits>
 
+#include "absl/memory/memory.h"
 #include "common_audio/include/audio_util.h"
 #include "common_audio/wav_header.h"
 #include "rtc_base/checks.h"
@@ -150,6 +151,26 @@ WavWriter::WavWriter(rtc::PlatformFile file,
   RTC_CHECK_EQ(1, fwrite(blank_header, kWavHeaderSize, 1, file_handle_));
 }
 
+WavWriter::WavWriter(rtc::PlatformFile file,
+                     int sample_rate,
+                     size_t num_channels,
+                     size_t max_pending_bytes)
+    : sample_rate_(sample_rate),
+      num_channels_(num_channels),
+      num_samples_(0),
+      file_handle_(nullptr) {
+  RTC_CHECK_NE(file, rtc::kInvalidPlatformFileValue)
+      << "Invalid file. Could not create wav file.";
+  RTC_CHECK(CheckWavParameters(num_channels_, sample_rate_, kWavFormat,
+                               kBytesPerSample, num_samples_));
+  async_file_ = absl::make_unique<rtc::AsyncFileWriter>(rtc::File(file),
+                                                        max_pending_bytes);
+
+  // Write a blank placeholder header, as above.
+  static const uint8_t blank_header[kWavHeaderSize] = {0};
+  async_file_->WriteAt(blank_header, kWavHeaderSize, 0);
+}
+
 WavWriter::~WavWriter() {
   Close();
 }
@@ -170,6 +191,14 @@ void WavWriter::WriteSamples(const int16_t* samples, size_t num_samples) {
 #ifndef WEBRTC_ARCH_LITTLE_ENDIAN
 #error "Need to convert samples to little-endian when writing to WAV file"
 #endif
+  if (async_file_) {
+    if (async_file_->Write(reinterpret_cast<const uint8_t*>(samples),
+                           num_samples * sizeof(*samples))) {
+      num_samples_ += num_samples;
+      RTC_CHECK(num_samples_ >= num_samples);  // detect size_t overflow
+    }
+    return;
+  }
   const size_t written =
       fwrite(samples, sizeof(*samples), num_samples, file_handle_);
   RTC_CHECK_EQ(num_samples, written);
@@ -188,10 +217,17 @@ void WavWriter::WriteSamples(const float* samples, size_t num_samples) {
 }
 
 void WavWriter::Close() {
-  RTC_CHECK_EQ(0, fseek(file_handle_, 0, SEEK_SET));
   uint8_t header[kWavHeaderSize];
   WriteWavHeader(header, num_channels_, sample_rate_, kWavFormat,
                  kBytesPerSample, num_samples_);
+  if (async_file_) {
+    async_file_->WriteAt(header, kWavHeaderSize, 0);
+    if (!async_file_->Close())
+      RTC_LOG(LS_ERROR) << "Unable to write wav file.";
+    async_file_.reset();
+    return;
+  }
+  RTC_CHECK_EQ(0, fseek(file_handle_, 0, SEEK_SET));
   RTC_CHECK_EQ(1, fwrite(header, kWavHeaderSize, 1, file_handle_));
   RTC_CHECK_EQ(0, fclose(file_handle_));
   file_handle_ = nullptr;
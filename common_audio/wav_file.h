@@ -15,8 +15,10 @@
 
 #include <stdint.h>
 #include <cstddef>
+#include <memory>
 #include <string>
 
+#include "rtc_base/async_file_writer.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/platform_file.h"
 
@@ -42,6 +44,15 @@ class WavWriter final : public WavFile {
   // Open a new WAV file for writing.
   WavWriter(rtc::PlatformFile file, int sample_rate, size_t num_channels);
 
+  // Open a new WAV file for writing on a shared task queue, see
+  // rtc::AsyncFileWriter, so that WriteSamples() never blocks on disk I/O.
+  // Samples that would take the data not yet written above
+  // |max_pending_bytes| are dropped, and aren't counted in num_samples().
+  WavWriter(rtc::PlatformFile file,
+            int sample_rate,
+            size_t num_channels,
+            size_t max_pending_bytes);
+
   // Close the WAV file, after writing its header.
   ~WavWriter() override;
 
@@ -61,6 +72,8 @@ class WavWriter final : public WavFile {
   const size_t num_channels_;
   size_t num_samples_;  // Total number of samples written to file.
   FILE* file_handle_;   // Output file, owned by this class
+  // Used instead of |file_handle_| if set.
+  std::unique_ptr<rtc::AsyncFileWriter> async_file_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(WavWriter);
 };
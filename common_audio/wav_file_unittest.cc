@@ -259,4 +259,34 @@ TEST(WavWriterTest, MAYBE_CPPFileDescriptor) {
   }
 }
 
+
+// Write a WAV file asynchronously and verify the result.
+TEST(WavWriterTest, Async) {
+  const std::string outfile = test::OutputPath() + "wavtest4.wav";
+  static const int kSampleRate = 16000;
+  static const size_t kNumChannels = 1;
+  static const size_t kNumSamples = 2 * kSampleRate;
+  static const size_t kMaxPendingBytes = 1024 * 1024;
+  float samples[kNumSamples];
+  for (size_t i = 0; i < kNumSamples; ++i)
+    samples[i] = static_cast<float>(i % 1000) - 500;
+  {
+    WavWriter w(rtc::CreatePlatformFile(outfile), kSampleRate, kNumChannels,
+                kMaxPendingBytes);
+    w.WriteSamples(samples, kNumSamples);
+    EXPECT_EQ(kNumSamples, w.num_samples());
+  }
+  EXPECT_EQ(sizeof(int16_t) * kNumSamples + kWavHeaderSize,
+            test::GetFileSize(outfile));
+
+  WavReader r(outfile);
+  EXPECT_EQ(kSampleRate, r.sample_rate());
+  EXPECT_EQ(kNumChannels, r.num_channels());
+  EXPECT_EQ(kNumSamples, r.num_samples());
+  float read_samples[kNumSamples];
+  EXPECT_EQ(kNumSamples, r.ReadSamples(kNumSamples, read_samples));
+  for (size_t i = 0; i < kNumSamples; ++i)
+    EXPECT_EQ(samples[i], read_samples[i]);
+}
+
 }  // namespace webrtc
@@ -275,6 +275,8 @@ struct NetworkStatistics {
   int maxWaitingTimeMs;
   // added samples in off mode due to packet loss
   size_t addedSamples;
+  // memory taken by the packets and samples in the jitter buffer (bytes)
+  size_t bufferMemoryBytes;
 };
 
 // Statistics for calls to AudioCodingModule::PlayoutData10Ms().
@@ -347,6 +349,7 @@ enum VideoCodecType {
   kVideoCodecI420,
   kVideoCodecGeneric,
   kVideoCodecMultiplex,
+  kVideoCodecAV1,
 
   // TODO(nisse): Deprecated aliases, for code expecting RtpVideoCodecTypes.
   kRtpVideoNone = kVideoCodecUnknown,
@@ -9,6 +9,7 @@
  */
 #include "common_video/h264/h264_bitstream_parser.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -22,6 +23,10 @@ namespace {
 const int kMaxAbsQpDeltaValue = 51;
 const int kMinQpValue = 0;
 const int kMaxQpValue = 51;
+// Only the slice header is parsed, so there is no need to unescape the slice
+// data that follows it, which is most of the NALU. Slice headers are far
+// shorter than this even with long reference list modifications.
+const size_t kMaxSliceHeaderSize = 1024;
 }  // namespace
 
 namespace webrtc {
@@ -46,7 +51,7 @@ H264BitstreamParser::Result H264BitstreamParser::ParseNonParameterSetNalu(
 
   last_slice_qp_delta_ = absl::nullopt;
   const std::vector<uint8_t> slice_rbsp =
-      H264::ParseRbsp(source, source_length);
+      H264::ParseRbsp(source, std::min(source_length, kMaxSliceHeaderSize));
   if (slice_rbsp.size() < H264::kNaluTypeSize)
     return kInvalidStream;
 
@@ -296,8 +301,12 @@ void H264BitstreamParser::ParseSlice(const uint8_t* slice, size_t length) {
 
 void H264BitstreamParser::ParseBitstream(const uint8_t* bitstream,
                                          size_t length) {
-  std::vector<H264::NaluIndex> nalu_indices =
-      H264::FindNaluIndices(bitstream, length);
+  ParseBitstream(bitstream, H264::FindNaluIndices(bitstream, length));
+}
+
+void H264BitstreamParser::ParseBitstream(
+    const uint8_t* bitstream,
+    const std::vector<H264::NaluIndex>& nalu_indices) {
   for (const H264::NaluIndex& index : nalu_indices)
     ParseSlice(&bitstream[index.payload_start_offset], index.payload_size);
 }
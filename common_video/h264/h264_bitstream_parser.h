@@ -13,7 +13,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "absl/types/optional.h"
+#include "common_video/h264/h264_common.h"
 #include "common_video/h264/pps_parser.h"
 #include "common_video/h264/sps_parser.h"
 
@@ -42,6 +45,10 @@ class H264BitstreamParser {
 
   // Parse an additional chunk of H264 bitstream.
   void ParseBitstream(const uint8_t* bitstream, size_t length);
+  // Same as above, for callers that already located the NALUs with
+  // H264::FindNaluIndices() and don't want the bitstream scanned twice.
+  void ParseBitstream(const uint8_t* bitstream,
+                      const std::vector<H264::NaluIndex>& nalu_indices);
 
   // Get the last extracted QP value from the parsed bitstream.
   bool GetLastSliceQp(int* qp) const;
@@ -10,24 +10,94 @@
 
 #include "common_video/h264/h264_common.h"
 
+#include <string.h>
+
+#include "common_video/h264/h264_common_avx2.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 namespace H264 {
 
 const uint8_t kNaluTypeMask = 0x1F;
 
+namespace {
+
+constexpr size_t kScanBlockSize = 16;
+
+// Returns true if any of the kScanBlockSize bytes at |data| is zero. Every
+// start sequence begins with a zero byte, and those are rare in entropy coded
+// slice data, so most blocks can be skipped without looking at their bytes one
+// by one.
+bool BlockHasZeroByte(const uint8_t* data) {
+#if defined(__SSE2__)
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_setzero_si128())) != 0;
+#elif defined(WEBRTC_HAS_NEON)
+  const uint64x2_t zeros =
+      vreinterpretq_u64_u8(vceqq_u8(vld1q_u8(data), vdupq_n_u8(0)));
+  return (vgetq_lane_u64(zeros, 0) | vgetq_lane_u64(zeros, 1)) != 0;
+#else
+  uint64_t words[2];
+  memcpy(words, data, sizeof(words));
+  const uint64_t kLowBits = 0x0101010101010101ULL;
+  const uint64_t kHighBits = 0x8080808080808080ULL;
+  const uint64_t zero_bytes = ((words[0] - kLowBits) & ~words[0]) |
+                              ((words[1] - kLowBits) & ~words[1]);
+  return (zero_bytes & kHighBits) != 0;
+#endif
+}
+
+// Returns the number of bytes at the start of the |size| bytes at |data| that
+// are in whole blocks of kScanBlockSize bytes without any zero byte.
+size_t SkipZeroFreeBlocks(const uint8_t* data, size_t size) {
+  size_t i = 0;
+  while (size - i >= kScanBlockSize && !BlockHasZeroByte(data + i))
+    i += kScanBlockSize;
+  return i;
+}
+
+using SkipZeroFreeBlocksProc = size_t (*)(const uint8_t*, size_t);
+
+SkipZeroFreeBlocksProc GetSkipZeroFreeBlocksProc() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0)
+    return &SkipZeroFreeBlocks_AVX2;
+#endif
+  return &SkipZeroFreeBlocks;
+}
+
+}  // namespace
+
 std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
                                        size_t buffer_size) {
   // This is sorta like Boyer-Moore, but with only the first optimization step:
   // given a 3-byte sequence we're looking at, if the 3rd byte isn't 1 or 0,
   // skip ahead to the next 3-byte sequence. 0s and 1s are relatively rare, so
-  // this will skip the majority of reads/checks.
+  // this will skip the majority of reads/checks. Before that, whole blocks
+  // without any zero byte are skipped at once, since no start sequence can
+  // begin inside them. Once such a block is found, the run of blocks it
+  // starts is skipped with AVX2 when the CPU has it.
+  // Packets may be parsed on several threads, so the implementation is picked
+  // in a thread safe static initializer.
+  static const SkipZeroFreeBlocksProc skip_zero_free_blocks =
+      GetSkipZeroFreeBlocksProc();
   std::vector<NaluIndex> sequences;
   if (buffer_size < kNaluShortStartSequenceSize)
     return sequences;
 
   const size_t end = buffer_size - kNaluShortStartSequenceSize;
   for (size_t i = 0; i < end;) {
-    if (buffer[i + 2] > 1) {
+    if (buffer_size - i >= kScanBlockSize && !BlockHasZeroByte(&buffer[i])) {
+      i += kScanBlockSize;
+      i += skip_zero_free_blocks(&buffer[i], buffer_size - i);
+    } else if (buffer[i + 2] > 1) {
       i += 3;
     } else if (buffer[i + 2] == 1 && buffer[i + 1] == 0 && buffer[i] == 0) {
       // We found a start sequence, now check if it was a 3 of 4 byte one.
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/h264_common_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+namespace H264 {
+
+namespace {
+
+inline __m256i Load(const uint8_t* data) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+inline bool HasZeroByte(__m256i bytes) {
+  return _mm256_movemask_epi8(
+             _mm256_cmpeq_epi8(bytes, _mm256_setzero_si256())) != 0;
+}
+
+}  // namespace
+
+size_t SkipZeroFreeBlocks_AVX2(const uint8_t* data, size_t size) {
+  size_t i = 0;
+  // Two blocks at a time. The bytewise minimum of the blocks has a zero byte
+  // if either of them has one.
+  for (; size - i >= 64; i += 64) {
+    if (HasZeroByte(_mm256_min_epu8(Load(data + i), Load(data + i + 32))))
+      break;
+  }
+  for (; size - i >= 32; i += 32) {
+    if (HasZeroByte(Load(data + i)))
+      break;
+  }
+  return i;
+}
+
+}  // namespace H264
+}  // namespace webrtc
@@ -0,0 +1,30 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by h264_common.cc. It defines the AVX2
+// routine for skipping bytes that cannot start a NALU start sequence.
+
+#ifndef COMMON_VIDEO_H264_H264_COMMON_AVX2_H_
+#define COMMON_VIDEO_H264_H264_COMMON_AVX2_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+namespace H264 {
+
+// Returns the number of bytes at the start of the |size| bytes at |data| that
+// are in whole blocks of 32 bytes without any zero byte.
+size_t SkipZeroFreeBlocks_AVX2(const uint8_t* data, size_t size);
+
+}  // namespace H264
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_H264_H264_COMMON_AVX2_H_
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/h264_common.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace H264 {
+namespace {
+
+// Fills |buffer| with bytes that never form a start sequence.
+void FillWithoutStartSequences(std::vector<uint8_t>* buffer) {
+  for (size_t i = 0; i < buffer->size(); ++i)
+    (*buffer)[i] = static_cast<uint8_t>(0x10 + i % 0xE0);
+}
+
+TEST(H264CommonTest, FindsNoNalusWithoutStartSequence) {
+  std::vector<uint8_t> buffer(100);
+  FillWithoutStartSequences(&buffer);
+  EXPECT_TRUE(FindNaluIndices(buffer.data(), buffer.size()).empty());
+}
+
+TEST(H264CommonTest, FindsStartSequencesAtEveryOffset) {
+  // Places a 3 byte start sequence at each offset of a buffer that is long
+  // enough to be scanned in blocks, also in the runs of 64 byte blocks of the
+  // AVX2 scan, including near the end where it isn't.
+  const size_t kBufferSize = 256;
+  for (size_t offset = 0; offset + kNaluShortStartSequenceSize < kBufferSize;
+       ++offset) {
+    std::vector<uint8_t> buffer(kBufferSize);
+    FillWithoutStartSequences(&buffer);
+    buffer[offset] = 0;
+    buffer[offset + 1] = 0;
+    buffer[offset + 2] = 1;
+
+    std::vector<NaluIndex> indices =
+        FindNaluIndices(buffer.data(), buffer.size());
+    ASSERT_EQ(1u, indices.size()) << "offset " << offset;
+    EXPECT_EQ(offset, indices[0].start_offset);
+    EXPECT_EQ(offset + 3, indices[0].payload_start_offset);
+    EXPECT_EQ(kBufferSize - offset - 3, indices[0].payload_size);
+  }
+}
+
+TEST(H264CommonTest, FindsLongAndShortStartSequences) {
+  std::vector<uint8_t> buffer(200);
+  FillWithoutStartSequences(&buffer);
+  const uint8_t kLongStartSequence[] = {0, 0, 0, 1};
+  const uint8_t kShortStartSequence[] = {0, 0, 1};
+  memcpy(&buffer[0], kLongStartSequence, sizeof(kLongStartSequence));
+  memcpy(&buffer[37], kShortStartSequence, sizeof(kShortStartSequence));
+  memcpy(&buffer[120], kLongStartSequence, sizeof(kLongStartSequence));
+  // Zero bytes that don't start a sequence must not confuse the scan.
+  buffer[80] = 0;
+  buffer[95] = 0;
+  buffer[96] = 0;
+
+  std::vector<NaluIndex> indices =
+      FindNaluIndices(buffer.data(), buffer.size());
+  ASSERT_EQ(3u, indices.size());
+  EXPECT_EQ(0u, indices[0].start_offset);
+  EXPECT_EQ(4u, indices[0].payload_start_offset);
+  EXPECT_EQ(33u, indices[0].payload_size);
+  EXPECT_EQ(37u, indices[1].start_offset);
+  EXPECT_EQ(40u, indices[1].payload_start_offset);
+  EXPECT_EQ(80u, indices[1].payload_size);
+  EXPECT_EQ(120u, indices[2].start_offset);
+  EXPECT_EQ(124u, indices[2].payload_start_offset);
+  EXPECT_EQ(76u, indices[2].payload_size);
+}
+
+}  // namespace
+}  // namespace H264
+}  // namespace webrtc
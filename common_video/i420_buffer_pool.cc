@@ -10,9 +10,16 @@
 
 #include "common_video/include/i420_buffer_pool.h"
 
+#include <algorithm>
+
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+// Enough for the resolutions quality scaling moves between, without keeping
+// buffers of resolutions that won't come back.
+const size_t kMaxNumberOfResolutions = 3;
+}  // namespace
 
 I420BufferPool::I420BufferPool() : I420BufferPool(false) {}
 I420BufferPool::I420BufferPool(bool zero_initialize)
@@ -25,37 +32,66 @@ I420BufferPool::~I420BufferPool() = default;
 
 void I420BufferPool::Release() {
   buffers_.clear();
+  resolutions_.clear();
 }
 
 rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
                                                             int height) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  // Release buffers with wrong resolution.
-  for (auto it = buffers_.begin(); it != buffers_.end();) {
-    if ((*it)->width() != width || (*it)->height() != height)
-      it = buffers_.erase(it);
-    else
-      ++it;
-  }
+  UseResolution(width, height);
   // Look for a free buffer.
   for (const rtc::scoped_refptr<PooledI420Buffer>& buffer : buffers_) {
     // If the buffer is in use, the ref count will be >= 2, one from the list we
     // are looping over and one from the application. If the ref count is 1,
     // then the list we are looping over holds the only reference and it's safe
     // to reuse.
-    if (buffer->HasOneRef())
+    if (buffer->width() == width && buffer->height() == height &&
+        buffer->HasOneRef()) {
+      ++num_reused_buffers_;
       return buffer;
+    }
   }
 
-  if (buffers_.size() >= max_number_of_buffers_)
-    return nullptr;
+  if (buffers_.size() >= max_number_of_buffers_) {
+    // Make room by dropping a free buffer, which has another resolution.
+    auto it = std::find_if(
+        buffers_.begin(), buffers_.end(),
+        [](const rtc::scoped_refptr<PooledI420Buffer>& buffer) {
+          return buffer->HasOneRef();
+        });
+    if (it == buffers_.end())
+      return nullptr;
+    buffers_.erase(it);
+  }
   // Allocate new buffer.
   rtc::scoped_refptr<PooledI420Buffer> buffer =
       new PooledI420Buffer(width, height);
   if (zero_initialize_)
     buffer->InitializeData();
   buffers_.push_back(buffer);
+  ++num_allocated_buffers_;
   return buffer;
 }
 
+void I420BufferPool::UseResolution(int width, int height) {
+  const std::pair<int, int> resolution(width, height);
+  auto it = std::find(resolutions_.begin(), resolutions_.end(), resolution);
+  if (it == resolutions_.begin() && it != resolutions_.end())
+    return;
+  if (it != resolutions_.end())
+    resolutions_.erase(it);
+  resolutions_.push_front(resolution);
+  if (resolutions_.size() <= kMaxNumberOfResolutions)
+    return;
+
+  // Release buffers of the least recently used resolution.
+  const std::pair<int, int> purged = resolutions_.back();
+  resolutions_.pop_back();
+  buffers_.remove_if(
+      [&purged](const rtc::scoped_refptr<PooledI420Buffer>& buffer) {
+        return buffer->width() == purged.first &&
+               buffer->height() == purged.second;
+      });
+}
+
 }  // namespace webrtc
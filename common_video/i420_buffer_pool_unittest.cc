@@ -70,4 +70,43 @@ TEST(TestI420BufferPool, MaxNumberOfBuffers) {
   EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
 }
 
+TEST(TestI420BufferPool, ReusesBuffersAfterResolutionSwitch) {
+  I420BufferPool pool;
+  rtc::scoped_refptr<I420BufferInterface> buffer = pool.CreateBuffer(16, 16);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(8, 8);
+  buffer = nullptr;
+  // Switching back reuses the buffer of the first resolution.
+  buffer = pool.CreateBuffer(16, 16);
+  EXPECT_EQ(y_ptr, buffer->DataY());
+  EXPECT_EQ(1, pool.num_reused_buffers());
+  EXPECT_EQ(2, pool.num_allocated_buffers());
+}
+
+TEST(TestI420BufferPool, PurgesLeastRecentlyUsedResolution) {
+  I420BufferPool pool;
+  rtc::scoped_refptr<I420BufferInterface> buffer = pool.CreateBuffer(16, 16);
+  buffer = nullptr;
+  // Use 16x16 again after 8x8, so that 8x8 is the oldest resolution.
+  pool.CreateBuffer(8, 8);
+  pool.CreateBuffer(16, 16);
+  pool.CreateBuffer(4, 4);
+  pool.CreateBuffer(2, 2);
+  EXPECT_EQ(1, pool.num_reused_buffers());
+  pool.CreateBuffer(16, 16);
+  EXPECT_EQ(2, pool.num_reused_buffers());
+  pool.CreateBuffer(8, 8);
+  EXPECT_EQ(2, pool.num_reused_buffers());
+}
+
+TEST(TestI420BufferPool, DropsFreeBufferOfOtherResolutionAtMaxNumber) {
+  I420BufferPool pool(false, 1);
+  EXPECT_NE(nullptr, pool.CreateBuffer(16, 16).get());
+  rtc::scoped_refptr<I420BufferInterface> buffer = pool.CreateBuffer(8, 8);
+  ASSERT_NE(nullptr, buffer.get());
+  EXPECT_EQ(8, buffer->width());
+  EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
+}
+
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 
 #include <limits>
 #include <list>
+#include <utility>
 
 #include "api/video/i420_buffer.h"
 #include "rtc_base/race_checker.h"
@@ -23,8 +24,10 @@ namespace webrtc {
 // Simple buffer pool to avoid unnecessary allocations of I420Buffer objects.
 // The pool manages the memory of the I420Buffer returned from CreateBuffer.
 // When the I420Buffer is destructed, the memory is returned to the pool for use
-// by subsequent calls to CreateBuffer. If the resolution passed to CreateBuffer
-// changes, old buffers will be purged from the pool.
+// by subsequent calls to CreateBuffer. The pool keeps the buffers of the last
+// few resolutions passed to CreateBuffer, so that switching back and forth
+// between resolutions, as quality scaling and simulcast do, doesn't allocate
+// new buffers every time. Buffers of older resolutions are purged.
 // Note that CreateBuffer will crash if more than kMaxNumberOfFramesBeforeCrash
 // are created. This is to prevent memory leaks where frames are not returned.
 class I420BufferPool {
@@ -42,13 +45,24 @@ class I420BufferPool {
   // later from another thread.
   void Release();
 
+  // The number of buffers returned by CreateBuffer that were reused from the
+  // pool and that had to be allocated, respectively.
+  int num_reused_buffers() const { return num_reused_buffers_; }
+  int num_allocated_buffers() const { return num_allocated_buffers_; }
+
  private:
   // Explicitly use a RefCountedObject to get access to HasOneRef,
   // needed by the pool to check exclusive access.
   using PooledI420Buffer = rtc::RefCountedObject<I420Buffer>;
 
+  // Moves |width| x |height| first in |resolutions_|, and purges the buffers
+  // of the least recently used resolution if there are too many.
+  void UseResolution(int width, int height);
+
   rtc::RaceChecker race_checker_;
   std::list<rtc::scoped_refptr<PooledI420Buffer>> buffers_;
+  // Most recently used first.
+  std::list<std::pair<int, int>> resolutions_;
   // If true, newly allocated buffers are zero-initialized. Note that recycled
   // buffers are not zero'd before reuse. This is required of buffers used by
   // FFmpeg according to http://crbug.com/390941, which only requires it for the
@@ -57,6 +71,8 @@ class I420BufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   const size_t max_number_of_buffers_;
+  int num_reused_buffers_ = 0;
+  int num_allocated_buffers_ = 0;
 };
 
 }  // namespace webrtc
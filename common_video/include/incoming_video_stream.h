@@ -24,6 +24,11 @@ class IncomingVideoStream : public rtc::VideoSinkInterface<VideoFrame> {
                       rtc::VideoSinkInterface<VideoFrame>* callback);
   ~IncomingVideoStream() override;
 
+  // Aligns the release of frames to the display refresh of the renderer, see
+  // VideoRenderFrames::SetVsync(). Can be called on any thread, and again
+  // whenever the vsync phase or refresh rate changes.
+  void OnVsync(int64_t vsync_time_ms, int64_t refresh_interval_ms);
+
  private:
   void OnFrame(const VideoFrame& video_frame) override;
   void Dequeue();
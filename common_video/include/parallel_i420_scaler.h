@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_PARALLEL_I420_SCALER_H_
+#define COMMON_VIDEO_INCLUDE_PARALLEL_I420_SCALER_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/task_queue.h"
+
+namespace webrtc {
+
+// Crops and scales I420 buffers with the box filter of
+// I420Buffer::CropAndScaleFrom, splitting large frames into stripes of rows
+// that are scaled in parallel on |num_worker_threads| worker queues in
+// addition to the calling thread. With rtc_use_task_queue_pool, the worker
+// queues are sequences on the shared task queue pool rather than threads of
+// their own.
+//
+// Only downscales where every output row comes from a whole number of input
+// rows are split, so that the stripes give the same result as scaling in one
+// go. Other scales, and small frames, are scaled on the calling thread.
+//
+// Downscales by 8 or more in powers of two, as from 4K to the lowest layer of
+// a simulcast ladder, are done as a chain of 2:1 box filters, which libyuv
+// has fast kernels for. The result is the one of the box filter, up to
+// rounding.
+//
+// The scaler may be used on any thread, but not on several at once.
+class ParallelI420Scaler {
+ public:
+  explicit ParallelI420Scaler(int num_worker_threads);
+  ~ParallelI420Scaler();
+
+  // Same as I420Buffer::CropAndScaleFrom(), scaling into |dst|.
+  void CropAndScale(const I420BufferInterface& src,
+                    int offset_x,
+                    int offset_y,
+                    int crop_width,
+                    int crop_height,
+                    I420Buffer* dst);
+  // The center crop to the aspect ratio of |dst|.
+  void CropAndScale(const I420BufferInterface& src, I420Buffer* dst);
+  // Scales all of |src|, with no cropping.
+  void Scale(const I420BufferInterface& src, I420Buffer* dst);
+
+  // Number of frames that were split into stripes so far.
+  int num_parallel_frames() const { return num_parallel_frames_; }
+
+ private:
+  rtc::RaceChecker race_checker_;
+  int num_parallel_frames_ = 0;
+  // Scratch memory of each stripe, kept between frames.
+  std::vector<std::vector<uint8_t>> scratch_;
+  std::vector<std::unique_ptr<rtc::TaskQueue>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ParallelI420Scaler);
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_PARALLEL_I420_SCALER_H_
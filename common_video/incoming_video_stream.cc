@@ -26,7 +26,8 @@ const char kIncomingQueueName[] = "IncomingVideoStream";
 // something like (inside OnFrame):
 // VideoFrame frame(video_frame);
 // incoming_render_queue_.PostTask([this, frame = std::move(frame)](){
-//   if (render_buffers_.AddFrame(std::move(frame)) == 1)
+//   bool was_empty = !render_buffers_.HasPendingFrames();
+//   if (render_buffers_.AddFrame(std::move(frame)) > 0 && was_empty)
 //     Dequeue();
 // });
 class IncomingVideoStream::NewFrameTask : public rtc::QueuedTask {
@@ -37,7 +38,10 @@ class IncomingVideoStream::NewFrameTask : public rtc::QueuedTask {
  private:
   bool Run() override {
     RTC_DCHECK(stream_->incoming_render_queue_.IsCurrent());
-    if (stream_->render_buffers_.AddFrame(std::move(frame_)) == 1)
+    // A new frame may replace a queued one, in which case a Dequeue() is
+    // already scheduled.
+    const bool was_empty = !stream_->render_buffers_.HasPendingFrames();
+    if (stream_->render_buffers_.AddFrame(std::move(frame_)) > 0 && was_empty)
       stream_->Dequeue();
     return true;
   }
@@ -66,6 +70,13 @@ void IncomingVideoStream::OnFrame(const VideoFrame& video_frame) {
       std::unique_ptr<rtc::QueuedTask>(new NewFrameTask(this, video_frame)));
 }
 
+void IncomingVideoStream::OnVsync(int64_t vsync_time_ms,
+                                  int64_t refresh_interval_ms) {
+  incoming_render_queue_.PostTask([this, vsync_time_ms, refresh_interval_ms]() {
+    render_buffers_.SetVsync(vsync_time_ms, refresh_interval_ms);
+  });
+}
+
 void IncomingVideoStream::Dequeue() {
   TRACE_EVENT0("webrtc", "IncomingVideoStream::Dequeue");
   RTC_DCHECK(incoming_render_queue_.IsCurrent());
@@ -0,0 +1,225 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/parallel_i420_scaler.h"
+
+#include <algorithm>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "third_party/libyuv/include/libyuv/scale.h"
+
+namespace webrtc {
+
+namespace {
+
+// Smallest number of source pixels worth handing to a worker.
+const int64_t kMinSourcePixelsPerStripe = 320 * 1024;
+// Smallest power of two downscale done as a chain of 2:1 box filters. libyuv
+// has dedicated kernels for 2:1 and 4:1, but falls back to a generic box
+// filter for larger factors.
+const int kMinHalvingFactor = 8;
+
+// Region of an I420 image. The chroma planes start at half the luma offsets.
+struct Image {
+  const uint8_t* data_y;
+  int stride_y;
+  const uint8_t* data_u;
+  int stride_u;
+  const uint8_t* data_v;
+  int stride_v;
+};
+
+bool IsPowerOfTwo(int value) {
+  return value > 0 && (value & (value - 1)) == 0;
+}
+
+// Halves the |width| x |height| plane |steps| times into |dst|, with the
+// planes in between in |scratch|, which holds at least a quarter plus a
+// sixteenth of the plane.
+void HalvePlane(const uint8_t* src,
+                int src_stride,
+                int width,
+                int height,
+                int steps,
+                uint8_t* dst,
+                int dst_stride,
+                uint8_t* scratch) {
+  uint8_t* const intermediate[2] = {scratch,
+                                    scratch + (width / 2) * (height / 2)};
+  for (int step = 0; step < steps; ++step) {
+    const bool last = step == steps - 1;
+    uint8_t* const to = last ? dst : intermediate[step % 2];
+    const int to_stride = last ? dst_stride : width / 2;
+    libyuv::ScalePlane(src, src_stride, width, height, to, to_stride,
+                       width / 2, height / 2, libyuv::kFilterBox);
+    src = to;
+    src_stride = to_stride;
+    width /= 2;
+    height /= 2;
+  }
+}
+
+// Scales the |num_rows| rows of |dst| from |dst_row| on, which are both even,
+// from the |factor| times as many rows of |src|, which is |src_width| wide.
+// With |halve|, the factor is a power of two applied horizontally as well,
+// and is done as a chain of 2:1 box filters.
+void ScaleStripe(const Image& src,
+                 int src_width,
+                 int factor,
+                 bool halve,
+                 int dst_row,
+                 int num_rows,
+                 std::vector<uint8_t>* scratch,
+                 I420Buffer* dst) {
+  const int src_row = dst_row * factor;
+  const int src_rows = num_rows * factor;
+  const uint8_t* src_y = src.data_y + src.stride_y * src_row;
+  const uint8_t* src_u = src.data_u + src.stride_u * src_row / 2;
+  const uint8_t* src_v = src.data_v + src.stride_v * src_row / 2;
+  uint8_t* dst_y = dst->MutableDataY() + dst->StrideY() * dst_row;
+  uint8_t* dst_u = dst->MutableDataU() + dst->StrideU() * dst_row / 2;
+  uint8_t* dst_v = dst->MutableDataV() + dst->StrideV() * dst_row / 2;
+
+  if (!halve) {
+    const int res = libyuv::I420Scale(
+        src_y, src.stride_y, src_u, src.stride_u, src_v, src.stride_v,
+        src_width, src_rows, dst_y, dst->StrideY(), dst_u, dst->StrideU(),
+        dst_v, dst->StrideV(), dst->width(), num_rows, libyuv::kFilterBox);
+    RTC_DCHECK_EQ(res, 0);
+    return;
+  }
+
+  int steps = 0;
+  while ((1 << steps) < factor)
+    ++steps;
+  const size_t scratch_size = (src_width / 2) * (src_rows / 2) +
+                              (src_width / 4) * (src_rows / 4);
+  if (scratch->size() < scratch_size)
+    scratch->resize(scratch_size);
+  HalvePlane(src_y, src.stride_y, src_width, src_rows, steps, dst_y,
+             dst->StrideY(), scratch->data());
+  HalvePlane(src_u, src.stride_u, src_width / 2, src_rows / 2, steps, dst_u,
+             dst->StrideU(), scratch->data());
+  HalvePlane(src_v, src.stride_v, src_width / 2, src_rows / 2, steps, dst_v,
+             dst->StrideV(), scratch->data());
+}
+
+}  // namespace
+
+ParallelI420Scaler::ParallelI420Scaler(int num_worker_threads) {
+  RTC_DCHECK_GE(num_worker_threads, 0);
+  for (int i = 0; i < num_worker_threads; ++i) {
+    const std::string name = "I420ScalerWorker" + std::to_string(i);
+    workers_.push_back(absl::make_unique<rtc::TaskQueue>(
+        name.c_str(), rtc::TaskQueue::Priority::HIGH));
+  }
+  scratch_.resize(workers_.size() + 1);
+}
+
+ParallelI420Scaler::~ParallelI420Scaler() = default;
+
+void ParallelI420Scaler::CropAndScale(const I420BufferInterface& src,
+                                      int offset_x,
+                                      int offset_y,
+                                      int crop_width,
+                                      int crop_height,
+                                      I420Buffer* dst) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  RTC_CHECK_LE(crop_width, src.width());
+  RTC_CHECK_LE(crop_height, src.height());
+  RTC_CHECK_LE(crop_width + offset_x, src.width());
+  RTC_CHECK_LE(crop_height + offset_y, src.height());
+  RTC_CHECK_GE(offset_x, 0);
+  RTC_CHECK_GE(offset_y, 0);
+
+  // Stripes start at even rows, and take a whole number of source rows for
+  // each of their rows, also in the chroma planes.
+  const int width = dst->width();
+  const int height = dst->height();
+  const int factor = crop_height / height;
+  if (height % 2 != 0 || factor * height != crop_height ||
+      crop_width < width) {
+    dst->CropAndScaleFrom(src, offset_x, offset_y, crop_width, crop_height);
+    return;
+  }
+  const bool halve = factor >= kMinHalvingFactor && IsPowerOfTwo(factor) &&
+                     factor * width == crop_width && width % 2 == 0;
+
+  const size_t num_stripes = static_cast<size_t>(std::max<int64_t>(
+      1, std::min<int64_t>(
+             {static_cast<int64_t>(workers_.size()) + 1, height / 2,
+              static_cast<int64_t>(crop_width) * crop_height /
+                  kMinSourcePixelsPerStripe})));
+  if (num_stripes == 1 && !halve) {
+    dst->CropAndScaleFrom(src, offset_x, offset_y, crop_width, crop_height);
+    return;
+  }
+
+  // Make sure offset is even so that u/v plane becomes aligned.
+  const int uv_offset_x = offset_x / 2;
+  const int uv_offset_y = offset_y / 2;
+  const Image image = {
+      src.DataY() + src.StrideY() * uv_offset_y * 2 + uv_offset_x * 2,
+      src.StrideY(),
+      src.DataU() + src.StrideU() * uv_offset_y + uv_offset_x,
+      src.StrideU(),
+      src.DataV() + src.StrideV() * uv_offset_y + uv_offset_x,
+      src.StrideV()};
+  auto scale_stripe = [this, &image, crop_width, factor, halve, height,
+                       num_stripes, dst](size_t stripe) {
+    const int begin = static_cast<int>(stripe * height / num_stripes) & ~1;
+    const int end =
+        static_cast<int>((stripe + 1) * height / num_stripes) & ~1;
+    ScaleStripe(image, crop_width, factor, halve, begin, end - begin,
+                &scratch_[stripe], dst);
+  };
+  if (num_stripes == 1) {
+    scale_stripe(0);
+    return;
+  }
+
+  // The calling thread scales the first stripe while the workers scale the
+  // others.
+  ++num_parallel_frames_;
+  rtc::Event done(false, false);
+  volatile int pending_stripes = static_cast<int>(num_stripes) - 1;
+  for (size_t stripe = 1; stripe < num_stripes; ++stripe) {
+    workers_[stripe - 1]->PostTask(
+        [&scale_stripe, &done, &pending_stripes, stripe] {
+          scale_stripe(stripe);
+          if (rtc::AtomicOps::Decrement(&pending_stripes) == 0)
+            done.Set();
+        });
+  }
+  scale_stripe(0);
+  done.Wait(rtc::Event::kForever);
+}
+
+void ParallelI420Scaler::CropAndScale(const I420BufferInterface& src,
+                                      I420Buffer* dst) {
+  const int crop_width =
+      std::min(src.width(), dst->width() * src.height() / dst->height());
+  const int crop_height =
+      std::min(src.height(), dst->height() * src.width() / dst->width());
+
+  CropAndScale(src, (src.width() - crop_width) / 2,
+               (src.height() - crop_height) / 2, crop_width, crop_height, dst);
+}
+
+void ParallelI420Scaler::Scale(const I420BufferInterface& src,
+                               I420Buffer* dst) {
+  CropAndScale(src, 0, 0, src.width(), src.height(), dst);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/parallel_i420_scaler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kNumWorkerThreads = 3;
+
+// A smooth image, so that different box filters give close results.
+rtc::scoped_refptr<I420Buffer> CreateGradient(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x)
+      buffer->MutableDataY()[y * buffer->StrideY() + x] = (x + y) / 16;
+  }
+  for (int y = 0; y < (height + 1) / 2; ++y) {
+    for (int x = 0; x < (width + 1) / 2; ++x) {
+      buffer->MutableDataU()[y * buffer->StrideU() + x] = x / 8;
+      buffer->MutableDataV()[y * buffer->StrideV() + x] = y / 8;
+    }
+  }
+  return buffer;
+}
+
+// Largest difference between the samples of the planes of |a| and |b|.
+int MaxDifference(const I420BufferInterface& a, const I420BufferInterface& b) {
+  EXPECT_EQ(a.width(), b.width());
+  EXPECT_EQ(a.height(), b.height());
+  int max_difference = 0;
+  auto compare = [&max_difference](const uint8_t* a_data, int a_stride,
+                                   const uint8_t* b_data, int b_stride,
+                                   int width, int height) {
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        max_difference = std::max(
+            max_difference,
+            abs(a_data[y * a_stride + x] - b_data[y * b_stride + x]));
+      }
+    }
+  };
+  compare(a.DataY(), a.StrideY(), b.DataY(), b.StrideY(), a.width(),
+          a.height());
+  compare(a.DataU(), a.StrideU(), b.DataU(), b.StrideU(), a.ChromaWidth(),
+          a.ChromaHeight());
+  compare(a.DataV(), a.StrideV(), b.DataV(), b.StrideV(), a.ChromaWidth(),
+          a.ChromaHeight());
+  return max_difference;
+}
+
+}  // namespace
+
+TEST(ParallelI420ScalerTest, SplitsWholeRowDownscale) {
+  ParallelI420Scaler scaler(kNumWorkerThreads);
+  rtc::scoped_refptr<I420Buffer> src = CreateGradient(1920, 1080);
+  rtc::scoped_refptr<I420Buffer> expected = I420Buffer::Create(960, 540);
+  expected->ScaleFrom(*src);
+
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(960, 540);
+  scaler.Scale(*src, scaled.get());
+  EXPECT_EQ(1, scaler.num_parallel_frames());
+  EXPECT_EQ(0, MaxDifference(*expected, *scaled));
+}
+
+TEST(ParallelI420ScalerTest, SplitsCroppedDownscale) {
+  ParallelI420Scaler scaler(kNumWorkerThreads);
+  rtc::scoped_refptr<I420Buffer> src = CreateGradient(1920, 1080);
+  // The odd offsets are rounded down, as by I420Buffer.
+  rtc::scoped_refptr<I420Buffer> expected = I420Buffer::Create(640, 500);
+  expected->CropAndScaleFrom(*src, 101, 51, 1280, 1000);
+
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(640, 500);
+  scaler.CropAndScale(*src, 101, 51, 1280, 1000, scaled.get());
+  EXPECT_EQ(1, scaler.num_parallel_frames());
+  EXPECT_EQ(0, MaxDifference(*expected, *scaled));
+}
+
+TEST(ParallelI420ScalerTest, ScalesOtherFactorsOnCallingThread) {
+  ParallelI420Scaler scaler(kNumWorkerThreads);
+  rtc::scoped_refptr<I420Buffer> src = CreateGradient(1920, 1080);
+  rtc::scoped_refptr<I420Buffer> expected = I420Buffer::Create(1280, 720);
+  expected->ScaleFrom(*src);
+
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(1280, 720);
+  scaler.Scale(*src, scaled.get());
+  EXPECT_EQ(0, scaler.num_parallel_frames());
+  EXPECT_EQ(0, MaxDifference(*expected, *scaled));
+}
+
+TEST(ParallelI420ScalerTest, ScalesSmallFramesOnCallingThread) {
+  ParallelI420Scaler scaler(kNumWorkerThreads);
+  rtc::scoped_refptr<I420Buffer> src = CreateGradient(320, 180);
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(160, 90);
+  scaler.Scale(*src, scaled.get());
+  EXPECT_EQ(0, scaler.num_parallel_frames());
+}
+
+TEST(ParallelI420ScalerTest, HalvesPowerOfTwoDownscale) {
+  ParallelI420Scaler scaler(kNumWorkerThreads);
+  rtc::scoped_refptr<I420Buffer> src = CreateGradient(3840, 2160);
+  rtc::scoped_refptr<I420Buffer> expected = I420Buffer::Create(480, 270);
+  expected->ScaleFrom(*src);
+
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(480, 270);
+  scaler.Scale(*src, scaled.get());
+  EXPECT_EQ(1, scaler.num_parallel_frames());
+  EXPECT_LE(MaxDifference(*expected, *scaled), 2);
+}
+
+TEST(ParallelI420ScalerTest, HalvesWithoutWorkers) {
+  ParallelI420Scaler scaler(0);
+  rtc::scoped_refptr<I420Buffer> src = CreateGradient(3840, 2160);
+  rtc::scoped_refptr<I420Buffer> expected = I420Buffer::Create(480, 270);
+  expected->ScaleFrom(*src);
+
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(480, 270);
+  scaler.Scale(*src, scaled.get());
+  EXPECT_EQ(0, scaler.num_parallel_frames());
+  EXPECT_LE(MaxDifference(*expected, *scaled), 2);
+}
+
+// Scales 4K frames to the layers of a simulcast ladder, on the calling thread
+// only, and with worker threads.
+TEST(ParallelI420ScalerTest, DISABLED_Performance) {
+  const int kIterations = 100;
+  rtc::scoped_refptr<I420Buffer> src = CreateGradient(3840, 2160);
+  for (int num_worker_threads : {0, kNumWorkerThreads}) {
+    ParallelI420Scaler scaler(num_worker_threads);
+    for (int divisor : {2, 4, 8}) {
+      rtc::scoped_refptr<I420Buffer> scaled =
+          I420Buffer::Create(src->width() / divisor, src->height() / divisor);
+      int64_t start_us = rtc::TimeMicros();
+      for (int i = 0; i < kIterations; ++i)
+        scaler.Scale(*src, scaled.get());
+      int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      printf("%d workers, %dx%d: %.2f ms per frame\n", num_worker_threads,
+             scaled->width(), scaled->height(),
+             elapsed_us / (1000.0 * kIterations));
+    }
+  }
+}
+
+}  // namespace webrtc
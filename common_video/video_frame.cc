@@ -33,6 +33,7 @@ size_t EncodedImage::GetBufferPaddingBytes(VideoCodecType codec_type) {
     case kVideoCodecI420:
     case kVideoCodecGeneric:
     case kVideoCodecMultiplex:
+    case kVideoCodecAV1:
     case kVideoCodecUnknown:
       return 0;
   }
@@ -313,6 +313,50 @@ TEST(TestVideoFrame, TextureInitialValues) {
   EXPECT_EQ(20, frame.timestamp_us());
 }
 
+TEST(TestVideoFrame, UpdateRect) {
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(I420Buffer::Create(640, 480))
+                         .build();
+  EXPECT_FALSE(frame.update_rect());
+
+  VideoFrame::UpdateRect update_rect = {16, 32, 64, 48};
+  frame = VideoFrame::Builder()
+              .set_video_frame_buffer(I420Buffer::Create(640, 480))
+              .set_update_rect(update_rect)
+              .build();
+  ASSERT_TRUE(frame.update_rect());
+  EXPECT_EQ(16, frame.update_rect()->offset_x);
+  EXPECT_EQ(48, frame.update_rect()->height);
+
+  // Copies keep the update rect.
+  VideoFrame copy = frame;
+  ASSERT_TRUE(copy.update_rect());
+  EXPECT_EQ(64, copy.update_rect()->width);
+  copy.set_update_rect(absl::nullopt);
+  EXPECT_FALSE(copy.update_rect());
+}
+
+TEST(TestVideoFrame, UpdateRectUnion) {
+  VideoFrame::UpdateRect rect = {0, 0, 0, 0};
+  EXPECT_TRUE(rect.IsEmpty());
+  rect.Union({10, 20, 30, 40});
+  EXPECT_EQ(10, rect.offset_x);
+  EXPECT_EQ(20, rect.offset_y);
+  EXPECT_EQ(30, rect.width);
+  EXPECT_EQ(40, rect.height);
+
+  // Unions with empty rects don't grow the rect.
+  rect.Union({0, 0, 0, 0});
+  EXPECT_EQ(10, rect.offset_x);
+  EXPECT_EQ(30, rect.width);
+
+  rect.Union({5, 50, 10, 20});
+  EXPECT_EQ(5, rect.offset_x);
+  EXPECT_EQ(20, rect.offset_y);
+  EXPECT_EQ(35, rect.width);
+  EXPECT_EQ(50, rect.height);
+}
+
 class TestPlanarYuvBuffer
     : public ::testing::TestWithParam<VideoFrameBuffer::Type> {};
 
@@ -10,6 +10,7 @@
 
 #include "common_video/video_render_frames.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "modules/include/module_common_types.h"
@@ -67,6 +68,13 @@ int32_t VideoRenderFrames::AddFrame(VideoFrame&& new_frame) {
   }
 
   last_render_time_ms_ = new_frame.render_time_ms();
+  // A frame that would be shown on the same vsync as the new one would be
+  // replaced before it's visible, so drop it right away.
+  if (refresh_interval_ms_ > 0 && !incoming_frames_.empty() &&
+      ClosestVsyncMs(incoming_frames_.back().render_time_ms()) ==
+          ClosestVsyncMs(new_frame.render_time_ms())) {
+    incoming_frames_.pop_back();
+  }
   incoming_frames_.emplace_back(std::move(new_frame));
 
   if (incoming_frames_.size() > kMaxIncomingFramesBeforeLogged)
@@ -89,8 +97,8 @@ uint32_t VideoRenderFrames::TimeToNextFrameRelease() {
   if (incoming_frames_.empty()) {
     return kEventMaxWaitTimeMs;
   }
-  const int64_t time_to_release = incoming_frames_.front().render_time_ms() -
-                                  render_delay_ms_ - rtc::TimeMillis();
+  const int64_t time_to_release =
+      ReleaseTimeMs(incoming_frames_.front()) - rtc::TimeMillis();
   return time_to_release < 0 ? 0u : static_cast<uint32_t>(time_to_release);
 }
 
@@ -98,4 +106,26 @@ bool VideoRenderFrames::HasPendingFrames() const {
   return !incoming_frames_.empty();
 }
 
+void VideoRenderFrames::SetVsync(int64_t vsync_time_ms,
+                                 int64_t refresh_interval_ms) {
+  vsync_time_ms_ = vsync_time_ms;
+  refresh_interval_ms_ = std::max<int64_t>(refresh_interval_ms, 0);
+}
+
+int64_t VideoRenderFrames::ReleaseTimeMs(const VideoFrame& frame) const {
+  return ClosestVsyncMs(frame.render_time_ms()) - render_delay_ms_;
+}
+
+int64_t VideoRenderFrames::ClosestVsyncMs(int64_t time_ms) const {
+  if (refresh_interval_ms_ == 0)
+    return time_ms;
+  int64_t phase_ms = (time_ms - vsync_time_ms_) % refresh_interval_ms_;
+  if (phase_ms < 0)
+    phase_ms += refresh_interval_ms_;
+  const int64_t previous_vsync_ms = time_ms - phase_ms;
+  return 2 * phase_ms < refresh_interval_ms_
+             ? previous_vsync_ms
+             : previous_vsync_ms + refresh_interval_ms_;
+}
+
 }  // namespace webrtc
@@ -38,7 +38,20 @@ class VideoRenderFrames {
 
   bool HasPendingFrames() const;
 
+  // Aligns frame release to the display refresh. |vsync_time_ms| is the time
+  // of any past or upcoming vsync, in the rtc::TimeMillis() clock, and
+  // |refresh_interval_ms| the display refresh interval. Each frame is then
+  // released for the vsync closest to its render time, and a frame is dropped
+  // as soon as a newer frame is queued for the same vsync. A
+  // |refresh_interval_ms| of 0 disables the alignment.
+  void SetVsync(int64_t vsync_time_ms, int64_t refresh_interval_ms);
+
  private:
+  // Returns the time |frame| should be released to the renderer.
+  int64_t ReleaseTimeMs(const VideoFrame& frame) const;
+  // Returns the vsync closest to |time_ms|, or |time_ms| if no vsync is set.
+  int64_t ClosestVsyncMs(int64_t time_ms) const;
+
   // Sorted list with framed to be rendered, oldest first.
   std::list<VideoFrame> incoming_frames_;
 
@@ -46,6 +59,9 @@ class VideoRenderFrames {
   const uint32_t render_delay_ms_;
 
   int64_t last_render_time_ms_ = 0;
+
+  int64_t vsync_time_ms_ = 0;
+  int64_t refresh_interval_ms_ = 0;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/video_render_frames.h"
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/fakeclock.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+constexpr uint32_t kRenderDelayMs = 10;
+constexpr int64_t kRefreshIntervalMs = 16;
+
+VideoFrame CreateFrame(uint32_t rtp_timestamp, int64_t render_time_ms) {
+  return VideoFrame(I420Buffer::Create(2, 2), rtp_timestamp, render_time_ms,
+                    kVideoRotation_0);
+}
+}  // namespace
+
+class VideoRenderFramesTest : public ::testing::Test {
+ protected:
+  VideoRenderFramesTest() : render_frames_(kRenderDelayMs) {
+    clock_.SetTimeMicros(1000 * rtc::kNumMicrosecsPerMillisec);
+  }
+
+  rtc::ScopedFakeClock clock_;
+  VideoRenderFrames render_frames_;
+};
+
+TEST_F(VideoRenderFramesTest, ReleasesFrameAtRenderTime) {
+  EXPECT_EQ(1, render_frames_.AddFrame(CreateFrame(90, 1035)));
+  EXPECT_EQ(25u, render_frames_.TimeToNextFrameRelease());
+}
+
+TEST_F(VideoRenderFramesTest, ReleasesFrameForClosestVsync) {
+  render_frames_.SetVsync(1000, kRefreshIntervalMs);
+  // The closest vsync of 1035 ms is at 1032 ms.
+  EXPECT_EQ(1, render_frames_.AddFrame(CreateFrame(90, 1035)));
+  EXPECT_EQ(22u, render_frames_.TimeToNextFrameRelease());
+
+  // The closest vsync of 1060 ms is at 1064 ms.
+  render_frames_.SetVsync(1000 + 3 * kRefreshIntervalMs, kRefreshIntervalMs);
+  EXPECT_EQ(2, render_frames_.AddFrame(CreateFrame(180, 1060)));
+  clock_.AdvanceTime(TimeDelta::ms(22));
+  ASSERT_TRUE(render_frames_.FrameToRender());
+  EXPECT_EQ(32u, render_frames_.TimeToNextFrameRelease());
+}
+
+TEST_F(VideoRenderFramesTest, DropsFrameSupersededOnSameVsync) {
+  render_frames_.SetVsync(1000, kRefreshIntervalMs);
+  EXPECT_EQ(1, render_frames_.AddFrame(CreateFrame(90, 1035)));
+  EXPECT_EQ(1, render_frames_.AddFrame(CreateFrame(180, 1037)));
+
+  clock_.AdvanceTime(TimeDelta::ms(22));
+  absl::optional<VideoFrame> frame = render_frames_.FrameToRender();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(180u, frame->timestamp());
+  EXPECT_FALSE(render_frames_.HasPendingFrames());
+}
+
+}  // namespace webrtc
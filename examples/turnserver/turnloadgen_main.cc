@@ -0,0 +1,496 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures the relay throughput of a TurnServer run in this process. Many
+// allocations are made against it over loopback, a channel is bound on each
+// of them to one peer, and ChannelData is then sent through all channels at a
+// fixed rate. The peer timestamps what it receives to report the packet rate,
+// the relay latency percentiles and the server CPU spent per relayed Gbps.
+//
+// The clients speak just enough TURN to get a bound channel, instead of being
+// TurnPorts, so that thousands of them are cheap to run beside the server.
+// Each allocation uses a client and a relay socket, so the limit on open
+// files may have to be raised.
+
+#include <algorithm>
+#include <iostream>  // NOLINT
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/shardedturnserver.h"
+#include "p2p/base/stun.h"
+#include "p2p/base/testturnserver.h"
+#include "p2p/base/turnserver.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/messagehandler.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/timeutils.h"
+
+DEFINE_bool(help, false, "Prints this message");
+DEFINE_int(allocations, 1000, "Number of allocations, one channel each");
+DEFINE_int(rate, 50, "Packets per second sent on each channel");
+DEFINE_int(packet_size, 1000, "Bytes of payload in each packet");
+DEFINE_int(duration, 10, "Seconds to send for once all channels are bound");
+DEFINE_int(setup_rate, 1000, "Allocations started per second");
+DEFINE_int(shards,
+           0,
+           "Number of ShardedTurnServer shards, or 0 for one TurnServer");
+DEFINE_int(port, 3478, "Port the server listens on, on 127.0.0.1");
+
+namespace {
+
+const char kUsername[] = "loadgen";
+const char kRealm[] = "loadgen.webrtc.org";
+const uint16_t kChannelId = 0x4000;
+const size_t kChannelHeaderSize = 4;
+// The payload starts with the send time and the index of the client.
+const size_t kMinPacketSize = sizeof(int64_t) + sizeof(uint32_t);
+const int kTickMs = 10;
+// Sending is paced finer, so that the bursts don't overflow socket buffers.
+const int kSendTickMs = 1;
+const int kRetryMs = 1000;
+// How long packets in flight are still counted after sending stops.
+const int kDrainMs = 200;
+
+// Accepts |kUsername| with itself as the password, like TestTurnServer. Does
+// not keep any state, so the shards can share it.
+class LoadGenAuth : public cricket::TurnAuthInterface {
+ public:
+  bool GetKey(const std::string& username,
+              const std::string& realm,
+              std::string* key) override {
+    return cricket::ComputeStunCredentialHash(username, realm, username, key);
+  }
+};
+
+// A TURN client that allocates, binds one channel to the peer, and then
+// sends ChannelData on it.
+class LoadClient : public sigslot::has_slots<> {
+ public:
+  enum State { STATE_ALLOCATING, STATE_BINDING, STATE_READY, STATE_FAILED };
+
+  LoadClient(uint32_t index,
+             rtc::Thread* thread,
+             const rtc::SocketAddress& server_addr,
+             const rtc::SocketAddress& peer_addr)
+      : index_(index), server_addr_(server_addr), peer_addr_(peer_addr) {
+    socket_.reset(rtc::AsyncUDPSocket::Create(
+        thread->socketserver(), rtc::SocketAddress("127.0.0.1", 0)));
+    if (!socket_) {
+      state_ = STATE_FAILED;
+      return;
+    }
+    socket_->SignalReadPacket.connect(this, &LoadClient::OnReadPacket);
+  }
+
+  State state() const { return state_; }
+
+  void Start() {
+    if (state_ != STATE_FAILED)
+      SendAllocate();
+  }
+
+  // Sends the last request again, if it wasn't answered.
+  void Retry() {
+    if (state_ == STATE_ALLOCATING || state_ == STATE_BINDING)
+      SendBuffer(last_request_);
+  }
+
+  void SendData(size_t packet_size) {
+    rtc::ByteBufferWriter buf;
+    buf.WriteUInt16(kChannelId);
+    buf.WriteUInt16(static_cast<uint16_t>(packet_size));
+    buf.WriteUInt64(static_cast<uint64_t>(rtc::TimeMicros()));
+    buf.WriteUInt32(index_);
+    for (size_t i = kMinPacketSize; i < packet_size; ++i)
+      buf.WriteUInt8(0);
+    // ChannelData over UDP needs no padding.
+    SendBuffer(std::string(buf.Data(), buf.Length()));
+  }
+
+ private:
+  void SendAllocate() {
+    cricket::TurnMessage msg;
+    msg.SetType(cricket::STUN_ALLOCATE_REQUEST);
+    auto transport_attr = cricket::StunAttribute::CreateUInt32(
+        cricket::STUN_ATTR_REQUESTED_TRANSPORT);
+    transport_attr->SetValue(IPPROTO_UDP << 24);
+    msg.AddAttribute(std::move(transport_attr));
+    SendRequest(&msg);
+  }
+
+  void SendChannelBind() {
+    cricket::TurnMessage msg;
+    msg.SetType(cricket::TURN_CHANNEL_BIND_REQUEST);
+    msg.AddAttribute(absl::make_unique<cricket::StunUInt32Attribute>(
+        cricket::STUN_ATTR_CHANNEL_NUMBER, kChannelId << 16));
+    msg.AddAttribute(absl::make_unique<cricket::StunXorAddressAttribute>(
+        cricket::STUN_ATTR_XOR_PEER_ADDRESS, peer_addr_));
+    SendRequest(&msg);
+  }
+
+  void SendRequest(cricket::TurnMessage* msg) {
+    msg->SetTransactionID(
+        rtc::CreateRandomString(cricket::kStunTransactionIdLength));
+    if (!hash_.empty()) {
+      msg->AddAttribute(absl::make_unique<cricket::StunByteStringAttribute>(
+          cricket::STUN_ATTR_USERNAME, kUsername));
+      msg->AddAttribute(absl::make_unique<cricket::StunByteStringAttribute>(
+          cricket::STUN_ATTR_REALM, realm_));
+      msg->AddAttribute(absl::make_unique<cricket::StunByteStringAttribute>(
+          cricket::STUN_ATTR_NONCE, nonce_));
+      msg->AddMessageIntegrity(hash_);
+    }
+    rtc::ByteBufferWriter buf;
+    msg->Write(&buf);
+    last_request_.assign(buf.Data(), buf.Length());
+    SendBuffer(last_request_);
+  }
+
+  void SendBuffer(const std::string& data) {
+    socket_->SendTo(data.data(), data.size(), server_addr_,
+                    rtc::PacketOptions());
+  }
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const rtc::PacketTime& packet_time) {
+    cricket::TurnMessage msg;
+    rtc::ByteBufferReader buf(data, size);
+    if (!msg.Read(&buf))
+      return;
+    switch (msg.type()) {
+      case cricket::STUN_ALLOCATE_ERROR_RESPONSE:
+        OnAllocateError(msg);
+        break;
+      case cricket::STUN_ALLOCATE_RESPONSE:
+        if (state_ == STATE_ALLOCATING) {
+          state_ = STATE_BINDING;
+          SendChannelBind();
+        }
+        break;
+      case cricket::TURN_CHANNEL_BIND_RESPONSE:
+        if (state_ == STATE_BINDING) {
+          state_ = STATE_READY;
+          last_request_.clear();
+        }
+        break;
+      case cricket::TURN_CHANNEL_BIND_ERROR_RESPONSE:
+        RTC_LOG(LS_WARNING) << "Channel bind " << index_ << " failed: "
+                            << msg.GetErrorCodeValue();
+        state_ = STATE_FAILED;
+        break;
+      default:
+        break;
+    }
+  }
+
+  void OnAllocateError(const cricket::TurnMessage& msg) {
+    int code = msg.GetErrorCodeValue();
+    const cricket::StunByteStringAttribute* realm =
+        msg.GetByteString(cricket::STUN_ATTR_REALM);
+    const cricket::StunByteStringAttribute* nonce =
+        msg.GetByteString(cricket::STUN_ATTR_NONCE);
+    // The first request is challenged for credentials, which are then
+    // resent with the fresh nonce if it goes stale.
+    if (state_ != STATE_ALLOCATING ||
+        (code != cricket::STUN_ERROR_UNAUTHORIZED &&
+         code != cricket::STUN_ERROR_STALE_NONCE) ||
+        !nonce || (hash_.empty() && !realm)) {
+      RTC_LOG(LS_WARNING) << "Allocation " << index_ << " failed: " << code;
+      state_ = STATE_FAILED;
+      return;
+    }
+    if (realm)
+      realm_ = realm->GetString();
+    nonce_ = nonce->GetString();
+    cricket::ComputeStunCredentialHash(kUsername, realm_, kUsername, &hash_);
+    SendAllocate();
+  }
+
+  const uint32_t index_;
+  const rtc::SocketAddress server_addr_;
+  const rtc::SocketAddress peer_addr_;
+  std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  State state_ = STATE_ALLOCATING;
+  std::string realm_;
+  std::string nonce_;
+  std::string hash_;
+  std::string last_request_;
+};
+
+// Sets up the clients, drives the load, and collects what the peer receives.
+class LoadGenerator : public rtc::MessageHandler, public sigslot::has_slots<> {
+ public:
+  LoadGenerator(rtc::Thread* thread, const rtc::SocketAddress& server_addr)
+      : thread_(thread), server_addr_(server_addr) {}
+  ~LoadGenerator() override { thread_->Clear(this); }
+
+  bool Start() {
+    peer_.reset(rtc::AsyncUDPSocket::Create(
+        thread_->socketserver(), rtc::SocketAddress("127.0.0.1", 0)));
+    if (!peer_) {
+      std::cerr << "Failed to create the peer socket" << std::endl;
+      return false;
+    }
+    peer_->SignalReadPacket.connect(this, &LoadGenerator::OnPeerReadPacket);
+    setup_start_ms_ = rtc::TimeMillis();
+    last_retry_ms_ = setup_start_ms_;
+    thread_->Post(RTC_FROM_HERE, this, MSG_SETUP);
+    thread_->PostDelayed(RTC_FROM_HERE, kTickMs, this, MSG_CHECK_SETUP);
+    return true;
+  }
+
+  void PrintReport() const;
+
+ private:
+  enum { MSG_SETUP, MSG_CHECK_SETUP, MSG_SEND, MSG_STOP, MSG_QUIT };
+
+  void OnMessage(rtc::Message* msg) override {
+    switch (msg->message_id) {
+      case MSG_SETUP:
+        OnSetup();
+        break;
+      case MSG_CHECK_SETUP:
+        OnCheckSetup();
+        break;
+      case MSG_SEND:
+        OnSend();
+        break;
+      case MSG_STOP:
+        OnStop();
+        break;
+      case MSG_QUIT:
+        thread_->Quit();
+        break;
+    }
+  }
+
+  // Starts the next batch of allocations.
+  void OnSetup() {
+    size_t batch =
+        std::max<size_t>(1, static_cast<size_t>(FLAG_setup_rate) * kTickMs /
+                                1000);
+    for (size_t i = 0; i < batch && clients_.size() <
+                                        static_cast<size_t>(FLAG_allocations);
+         ++i) {
+      clients_.push_back(absl::make_unique<LoadClient>(
+          static_cast<uint32_t>(clients_.size()), thread_, server_addr_,
+          peer_->GetLocalAddress()));
+      clients_.back()->Start();
+    }
+    if (clients_.size() < static_cast<size_t>(FLAG_allocations))
+      thread_->PostDelayed(RTC_FROM_HERE, kTickMs, this, MSG_SETUP);
+  }
+
+  // Resends the requests that weren't answered for a while, until all
+  // clients are bound or failed.
+  void OnCheckSetup() {
+    int64_t now = rtc::TimeMillis();
+    bool retry = now - last_retry_ms_ >= kRetryMs;
+    if (retry)
+      last_retry_ms_ = now;
+    size_t pending = 0;
+    for (const auto& client : clients_) {
+      LoadClient::State state = client->state();
+      if (state == LoadClient::STATE_ALLOCATING ||
+          state == LoadClient::STATE_BINDING) {
+        if (retry)
+          client->Retry();
+        ++pending;
+      }
+    }
+    if (pending > 0 ||
+        clients_.size() < static_cast<size_t>(FLAG_allocations)) {
+      thread_->PostDelayed(RTC_FROM_HERE, kTickMs, this, MSG_CHECK_SETUP);
+      return;
+    }
+    // All clients are bound, or failed.
+    setup_ms_ = rtc::TimeMillis() - setup_start_ms_;
+    for (const auto& client : clients_) {
+      if (client->state() == LoadClient::STATE_READY)
+        ready_.push_back(client.get());
+    }
+    if (ready_.empty()) {
+      std::cerr << "No channel could be bound" << std::endl;
+      thread_->Quit();
+      return;
+    }
+    std::cout << ready_.size() << " channels bound in " << setup_ms_ << " ms"
+              << std::endl;
+    send_start_us_ = rtc::TimeMicros();
+    process_cpu_start_ns_ = rtc::GetProcessCpuTimeNanos();
+    thread_cpu_start_ns_ = rtc::GetThreadCpuTimeNanos();
+    thread_->Post(RTC_FROM_HERE, this, MSG_SEND);
+    thread_->PostDelayed(RTC_FROM_HERE, FLAG_duration * 1000, this, MSG_STOP);
+  }
+
+  // Sends the packets due since the last tick, round robin over the
+  // channels.
+  void OnSend() {
+    if (stopped_)
+      return;
+    int64_t elapsed_us = rtc::TimeMicros() - send_start_us_;
+    int64_t due = elapsed_us * FLAG_rate * static_cast<int64_t>(ready_.size()) /
+                  rtc::kNumMicrosecsPerSec;
+    size_t packet_size =
+        std::max(kMinPacketSize, static_cast<size_t>(FLAG_packet_size));
+    for (; packets_sent_ < due; ++packets_sent_) {
+      ready_[next_client_]->SendData(packet_size);
+      next_client_ = (next_client_ + 1) % ready_.size();
+    }
+    thread_->PostDelayed(RTC_FROM_HERE, kSendTickMs, this, MSG_SEND);
+  }
+
+  void OnStop() {
+    stopped_ = true;
+    send_us_ = rtc::TimeMicros() - send_start_us_;
+    // The clients and the peer run on this thread, so the rest of the CPU
+    // time of the process is the server's.
+    server_cpu_ns_ =
+        (rtc::GetProcessCpuTimeNanos() - process_cpu_start_ns_) -
+        (rtc::GetThreadCpuTimeNanos() - thread_cpu_start_ns_);
+    thread_->PostDelayed(RTC_FROM_HERE, kDrainMs, this, MSG_QUIT);
+  }
+
+  void OnPeerReadPacket(rtc::AsyncPacketSocket* socket,
+                        const char* data,
+                        size_t size,
+                        const rtc::SocketAddress& remote_addr,
+                        const rtc::PacketTime& packet_time) {
+    if (size < kMinPacketSize)
+      return;
+    rtc::ByteBufferReader buf(data, size);
+    uint64_t sent_us;
+    buf.ReadUInt64(&sent_us);
+    latencies_us_.push_back(rtc::TimeMicros() - static_cast<int64_t>(sent_us));
+    bytes_received_ += size + kChannelHeaderSize;
+  }
+
+  rtc::Thread* const thread_;
+  const rtc::SocketAddress server_addr_;
+  std::unique_ptr<rtc::AsyncPacketSocket> peer_;
+  std::vector<std::unique_ptr<LoadClient>> clients_;
+  std::vector<LoadClient*> ready_;
+  size_t next_client_ = 0;
+  bool stopped_ = false;
+  int64_t setup_start_ms_ = 0;
+  int64_t setup_ms_ = 0;
+  int64_t last_retry_ms_ = 0;
+  int64_t send_start_us_ = 0;
+  int64_t send_us_ = 0;
+  int64_t process_cpu_start_ns_ = 0;
+  int64_t thread_cpu_start_ns_ = 0;
+  int64_t server_cpu_ns_ = 0;
+  int64_t packets_sent_ = 0;
+  int64_t bytes_received_ = 0;
+  std::vector<int64_t> latencies_us_;
+};
+
+void LoadGenerator::PrintReport() const {
+  if (send_us_ <= 0)
+    return;
+  std::vector<int64_t> latencies = latencies_us_;
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](int p) -> int64_t {
+    if (latencies.empty())
+      return 0;
+    return latencies[(latencies.size() - 1) * p / 100];
+  };
+  double seconds = static_cast<double>(send_us_) / rtc::kNumMicrosecsPerSec;
+  double received = static_cast<double>(latencies.size());
+  double gbits = bytes_received_ * 8 / 1e9;
+  double server_cores = server_cpu_ns_ / (seconds * rtc::kNumNanosecsPerSec);
+
+  std::cout << "Channels: " << ready_.size() << " of " << clients_.size()
+            << " bound in " << setup_ms_ << " ms" << std::endl;
+  std::cout << "Packets sent: " << packets_sent_
+            << ", relayed: " << latencies.size() << " ("
+            << (packets_sent_ > 0 ? 100 * (1 - received / packets_sent_) : 0)
+            << "% lost)" << std::endl;
+  std::cout << "Relayed packets/s: " << received / seconds << std::endl;
+  std::cout << "Relayed Mbps: " << gbits * 1000 / seconds
+            << " (including the ChannelData header)" << std::endl;
+  std::cout << "Latency us: p50 " << percentile(50) << ", p90 "
+            << percentile(90) << ", p99 " << percentile(99) << ", max "
+            << percentile(100) << std::endl;
+  std::cout << "Server CPU cores: " << server_cores << std::endl;
+  if (gbits > 0) {
+    std::cout << "Server CPU cores per relayed Gbps: "
+              << server_cores / (gbits / seconds) << std::endl;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true);
+  if (FLAG_help || FLAG_allocations < 1 || FLAG_rate < 1 ||
+      FLAG_duration < 1 || FLAG_setup_rate < 1 || FLAG_shards < 0 ||
+      FLAG_packet_size > 0xffff) {
+    rtc::FlagList::Print(nullptr, false);
+    return FLAG_help ? 0 : 1;
+  }
+
+  rtc::Thread* main = rtc::ThreadManager::Instance()->WrapCurrentThread();
+  const rtc::SocketAddress int_addr("127.0.0.1", FLAG_port);
+  const rtc::SocketAddress ext_addr("127.0.0.1", 0);
+  rtc::SocketAddress server_addr = int_addr;
+
+  // The server never runs on the main thread, so that its CPU time can be
+  // told apart from the clients'.
+  LoadGenAuth auth;
+  std::unique_ptr<cricket::ShardedTurnServer> sharded_server;
+  std::unique_ptr<rtc::Thread> server_thread;
+  std::unique_ptr<cricket::TestTurnServer> server;
+  if (FLAG_shards > 0) {
+    sharded_server = absl::make_unique<cricket::ShardedTurnServer>(
+        FLAG_shards);
+    if (!sharded_server->Start(int_addr, cricket::PROTO_UDP, ext_addr,
+                               [&auth](cricket::TurnServer* shard) {
+                                 shard->set_realm(kRealm);
+                                 shard->set_auth_hook(&auth);
+                               })) {
+      std::cerr << "Failed to start " << FLAG_shards << " shards at "
+                << int_addr.ToString() << std::endl;
+      return 1;
+    }
+    server_addr = sharded_server->address();
+  } else {
+    server_thread = rtc::Thread::CreateWithSocketServer();
+    server_thread->Start();
+    server_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+      server = absl::make_unique<cricket::TestTurnServer>(
+          server_thread.get(), int_addr, ext_addr);
+    });
+  }
+  std::cout << "Relaying through " << server_addr.ToString() << std::endl;
+
+  LoadGenerator generator(main, server_addr);
+  if (!generator.Start())
+    return 1;
+  main->Run();
+  generator.PrintReport();
+
+  if (server_thread) {
+    server_thread->Invoke<void>(RTC_FROM_HERE, [&server] { server.reset(); });
+  }
+  return 0;
+}
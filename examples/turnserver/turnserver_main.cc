@@ -11,6 +11,7 @@
 #include <iostream>  // NOLINT
 
 #include "p2p/base/basicpacketsocketfactory.h"
+#include "p2p/base/shardedturnserver.h"
 #include "p2p/base/turnserver.h"
 #include "rtc_base/asyncudpsocket.h"
 #include "rtc_base/optionsfile.h"
@@ -19,6 +20,7 @@
 
 static const char kSoftware[] = "libjingle TurnServer";
 
+// Only reads |file_| after loading it, so the shards can share it.
 class TurnFileAuth : public cricket::TurnAuthInterface {
  public:
   explicit TurnFileAuth(const std::string& path) : file_(path) { file_.Load(); }
@@ -42,8 +44,8 @@ class TurnFileAuth : public cricket::TurnAuthInterface {
 };
 
 int main(int argc, char* argv[]) {
-  if (argc != 5) {
-    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file"
+  if (argc != 5 && argc != 6) {
+    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file [shards]"
               << std::endl;
     return 1;
   }
@@ -60,7 +62,36 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  int num_shards = 0;
+  if (argc == 6 && (!rtc::FromString(argv[5], &num_shards) ||
+                    num_shards < 1)) {
+    std::cerr << "Invalid number of shards: " << argv[5] << std::endl;
+    return 1;
+  }
+
   rtc::Thread* main = rtc::Thread::Current();
+  TurnFileAuth auth(argv[4]);
+  if (num_shards > 0) {
+    // Each shard runs on its own thread, sharing the port with SO_REUSEPORT.
+    cricket::ShardedTurnServer server(num_shards);
+    const std::string realm = argv[3];
+    if (!server.Start(int_addr, cricket::PROTO_UDP,
+                      rtc::SocketAddress(ext_addr, 0),
+                      [&](cricket::TurnServer* shard) {
+                        shard->set_realm(realm);
+                        shard->set_software(kSoftware);
+                        shard->set_auth_hook(&auth);
+                      })) {
+      std::cerr << "Failed to start " << num_shards << " shards at "
+                << int_addr.ToString() << std::endl;
+      return 1;
+    }
+    std::cout << "Listening internally at " << server.address().ToString()
+              << " with " << num_shards << " shards" << std::endl;
+    main->Run();
+    return 0;
+  }
+
   rtc::AsyncUDPSocket* int_socket =
       rtc::AsyncUDPSocket::Create(main->socketserver(), int_addr);
   if (!int_socket) {
@@ -70,7 +101,6 @@ int main(int argc, char* argv[]) {
   }
 
   cricket::TurnServer server(main);
-  TurnFileAuth auth(argv[4]);
   server.set_realm(argv[3]);
   server.set_software(kSoftware);
   server.set_auth_hook(&auth);
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/blob_encoding.h"
+
+#include "logging/rtc_event_log/encoder/varint.h"
+
+namespace webrtc {
+
+std::string EncodeBlobs(const std::vector<std::string>& blobs) {
+  size_t size = 0;
+  for (const std::string& blob : blobs)
+    size += kMaxVarIntLengthBytes + blob.size();
+  std::string output;
+  output.reserve(size);
+  for (const std::string& blob : blobs) {
+    EncodeVarInt(blob.size(), &output);
+    output += blob;
+  }
+  return output;
+}
+
+std::vector<std::string> DecodeBlobs(const std::string& input,
+                                     size_t num_of_blobs) {
+  // Every blob takes at least the byte of its length.
+  if (num_of_blobs > input.size())
+    return {};
+  std::vector<std::string> blobs(num_of_blobs);
+  size_t offset = 0;
+  for (std::string& blob : blobs) {
+    uint64_t length;
+    if (!DecodeVarInt(input, &offset, &length) ||
+        length > input.size() - offset) {
+      return {};
+    }
+    blob = input.substr(offset, length);
+    offset += length;
+  }
+  if (offset != input.size())
+    return {};
+  return blobs;
+}
+
+}  // namespace webrtc
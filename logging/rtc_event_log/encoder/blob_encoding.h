@@ -0,0 +1,31 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_ENCODER_BLOB_ENCODING_H_
+#define LOGGING_RTC_EVENT_LOG_ENCODER_BLOB_ENCODING_H_
+
+#include <string>
+#include <vector>
+
+namespace webrtc {
+
+// Encodes |blobs|, such as raw packets that do not delta encode well, as the
+// varint length of each blob followed by its contents.
+std::string EncodeBlobs(const std::vector<std::string>& blobs);
+
+// Inverse of |EncodeBlobs|. Returns the |num_of_blobs| blobs encoded in
+// |input|, or an empty vector if |input| is not a valid encoding of that many
+// blobs.
+std::vector<std::string> DecodeBlobs(const std::string& input,
+                                     size_t num_of_blobs);
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_ENCODER_BLOB_ENCODING_H_
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/blob_encoding.h"
+
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(BlobEncodingTest, RoundTrip) {
+  const std::vector<std::string> blobs = {"", "a", std::string(300, 'b'),
+                                          std::string("\0\1\2", 3), ""};
+  const std::string encoded = EncodeBlobs(blobs);
+  EXPECT_EQ(blobs, DecodeBlobs(encoded, blobs.size()));
+}
+
+TEST(BlobEncodingTest, MalformedInputIsRejected) {
+  const std::vector<std::string> blobs = {"first", std::string(200, 'x')};
+  const std::string encoded = EncodeBlobs(blobs);
+  for (size_t size = 0; size < encoded.size(); ++size)
+    EXPECT_TRUE(DecodeBlobs(encoded.substr(0, size), blobs.size()).empty());
+  EXPECT_TRUE(DecodeBlobs(encoded + "trailing", blobs.size()).empty());
+  EXPECT_TRUE(DecodeBlobs(encoded, blobs.size() + 1).empty());
+}
+
+}  // namespace
+}  // namespace webrtc
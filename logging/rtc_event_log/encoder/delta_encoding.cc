@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/delta_encoding.h"
+
+#include "logging/rtc_event_log/encoder/varint.h"
+
+namespace webrtc {
+
+// The encoding starts with a header byte. If some of the values are missing,
+// the header is followed by a bitmap of the values that exist, one bit per
+// value, least significant bit first. Then comes one varint per existing
+// value, holding the zigzag encoded difference from the previous existing
+// value, or from the base. A missing base counts as zero.
+namespace {
+
+constexpr uint8_t kHasMissingValues = 0x01;
+
+uint64_t ZigZagEncode(uint64_t delta) {
+  // Small negative deltas map to small odd numbers, and small positive deltas
+  // to small even numbers, so that both get short varints.
+  const uint64_t sign = (delta >> 63) ? ~static_cast<uint64_t>(0) : 0;
+  return (delta << 1) ^ sign;
+}
+
+uint64_t ZigZagDecode(uint64_t value) {
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+}  // namespace
+
+std::string EncodeDeltas(absl::optional<uint64_t> base,
+                         const std::vector<absl::optional<uint64_t>>& values) {
+  bool all_equal_to_base = true;
+  bool has_missing_values = false;
+  for (const auto& value : values) {
+    all_equal_to_base &= (value == base);
+    has_missing_values |= !value.has_value();
+  }
+  if (all_equal_to_base)
+    return std::string();
+
+  std::string output;
+  output.reserve(1 + values.size() * 2);
+  output.push_back(has_missing_values ? kHasMissingValues : 0);
+  if (has_missing_values) {
+    std::string bitmap((values.size() + 7) / 8, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (values[i])
+        bitmap[i / 8] |= 1 << (i % 8);
+    }
+    output += bitmap;
+  }
+
+  uint64_t previous = base.value_or(0);
+  for (const auto& value : values) {
+    if (!value)
+      continue;
+    EncodeVarInt(ZigZagEncode(*value - previous), &output);
+    previous = *value;
+  }
+  return output;
+}
+
+std::vector<absl::optional<uint64_t>> DecodeDeltas(
+    const std::string& input,
+    absl::optional<uint64_t> base,
+    size_t num_of_deltas) {
+  if (input.empty())
+    return std::vector<absl::optional<uint64_t>>(num_of_deltas, base);
+
+  const uint8_t header = static_cast<uint8_t>(input[0]);
+  if (header & ~kHasMissingValues)
+    return {};
+  size_t offset = 1;
+  const char* bitmap = nullptr;
+  if (header & kHasMissingValues) {
+    const size_t bitmap_size = (num_of_deltas + 7) / 8;
+    if (input.size() - offset < bitmap_size)
+      return {};
+    bitmap = input.data() + offset;
+    offset += bitmap_size;
+  } else if (input.size() - offset < num_of_deltas) {
+    // Every value takes at least one byte.
+    return {};
+  }
+
+  std::vector<absl::optional<uint64_t>> values(num_of_deltas);
+  uint64_t previous = base.value_or(0);
+  for (size_t i = 0; i < num_of_deltas; ++i) {
+    if (bitmap && !(bitmap[i / 8] & (1 << (i % 8))))
+      continue;
+    uint64_t delta;
+    if (!DecodeVarInt(input, &offset, &delta))
+      return {};
+    previous += ZigZagDecode(delta);
+    values[i] = previous;
+  }
+  if (offset != input.size())
+    return {};
+  return values;
+}
+
+}  // namespace webrtc
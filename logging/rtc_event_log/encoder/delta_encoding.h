@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_ENCODER_DELTA_ENCODING_H_
+#define LOGGING_RTC_EVENT_LOG_ENCODER_DELTA_ENCODING_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// Encodes |values| as the differences between each value and the one before
+// it, the first one being compared to |base|. Values may be missing, e.g. for
+// header extensions that are not on every packet. The differences are taken
+// modulo 2^64, so signed values can be encoded as their two's complement.
+// Returns an empty string if every value is equal to |base|, which then does
+// not need to be stored.
+std::string EncodeDeltas(absl::optional<uint64_t> base,
+                         const std::vector<absl::optional<uint64_t>>& values);
+
+// Inverse of |EncodeDeltas|. Returns the |num_of_deltas| values encoded in
+// |input|, or an empty vector if |input| is not a valid encoding of that many
+// values.
+std::vector<absl::optional<uint64_t>> DecodeDeltas(
+    const std::string& input,
+    absl::optional<uint64_t> base,
+    size_t num_of_deltas);
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_ENCODER_DELTA_ENCODING_H_
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/delta_encoding.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Values = std::vector<absl::optional<uint64_t>>;
+
+void TestRoundTrip(absl::optional<uint64_t> base, const Values& values) {
+  const std::string encoded = EncodeDeltas(base, values);
+  EXPECT_EQ(values, DecodeDeltas(encoded, base, values.size()));
+}
+
+TEST(DeltaEncodingTest, AllValuesEqualToBaseEncodeToNothing) {
+  const Values values(10, 17u);
+  EXPECT_TRUE(EncodeDeltas(17u, values).empty());
+  TestRoundTrip(17u, values);
+  EXPECT_TRUE(EncodeDeltas(absl::nullopt, Values(3)).empty());
+  TestRoundTrip(absl::nullopt, Values(3));
+}
+
+TEST(DeltaEncodingTest, IncreasingValues) {
+  Values values;
+  for (uint64_t i = 0; i < 100; ++i)
+    values.push_back(1000 + 3 * i);
+  TestRoundTrip(999u, values);
+}
+
+TEST(DeltaEncodingTest, WrapAroundAndSignedValues) {
+  const uint64_t kMax = std::numeric_limits<uint64_t>::max();
+  TestRoundTrip(kMax, Values{0u, kMax, 1u, kMax - 1, 0u});
+  TestRoundTrip(0u, Values{static_cast<uint64_t>(-5), 5u,
+                           static_cast<uint64_t>(-1000000)});
+}
+
+TEST(DeltaEncodingTest, MissingValues) {
+  TestRoundTrip(5u, Values{absl::nullopt, 6u, absl::nullopt, absl::nullopt,
+                           7u, absl::nullopt});
+  TestRoundTrip(absl::nullopt, Values{absl::nullopt, 1u});
+  TestRoundTrip(2u, Values{absl::nullopt, absl::nullopt});
+}
+
+TEST(DeltaEncodingTest, RandomValues) {
+  Random prng(1234);
+  for (int test = 0; test < 100; ++test) {
+    Values values;
+    const size_t size = prng.Rand(1, 50);
+    for (size_t i = 0; i < size; ++i) {
+      if (prng.Rand(0, 3) == 0) {
+        values.push_back(absl::nullopt);
+      } else {
+        values.push_back(static_cast<uint64_t>(prng.Rand<uint32_t>()) << 32 |
+                         prng.Rand<uint32_t>());
+      }
+    }
+    TestRoundTrip(prng.Rand<uint32_t>(), values);
+  }
+}
+
+TEST(DeltaEncodingTest, MalformedInputIsRejected) {
+  Values values;
+  for (uint64_t i = 0; i < 10; ++i)
+    values.push_back(i * i * 1000);
+  const std::string encoded = EncodeDeltas(0u, values);
+  ASSERT_FALSE(encoded.empty());
+  for (size_t size = 1; size < encoded.size(); ++size) {
+    EXPECT_TRUE(
+        DecodeDeltas(encoded.substr(0, size), 0u, values.size()).empty());
+  }
+  EXPECT_TRUE(DecodeDeltas(encoded + '\x01', 0u, values.size()).empty());
+  EXPECT_TRUE(DecodeDeltas(encoded, 0u, values.size() + 1).empty());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,1060 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/rtc_event_log_encoder_new_format.h"
+
+#include <string.h>
+
+#include <map>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "logging/rtc_event_log/encoder/blob_encoding.h"
+#include "logging/rtc_event_log/encoder/delta_encoding.h"
+#include "logging/rtc_event_log/events/rtc_event_alr_state.h"
+#include "logging/rtc_event_log/events/rtc_event_audio_network_adaptation.h"
+#include "logging/rtc_event_log/events/rtc_event_audio_playout.h"
+#include "logging/rtc_event_log/events/rtc_event_audio_receive_stream_config.h"
+#include "logging/rtc_event_log/events/rtc_event_audio_send_stream_config.h"
+#include "logging/rtc_event_log/events/rtc_event_bwe_update_delay_based.h"
+#include "logging/rtc_event_log/events/rtc_event_bwe_update_loss_based.h"
+#include "logging/rtc_event_log/events/rtc_event_ice_candidate_pair.h"
+#include "logging/rtc_event_log/events/rtc_event_ice_candidate_pair_config.h"
+#include "logging/rtc_event_log/events/rtc_event_probe_cluster_created.h"
+#include "logging/rtc_event_log/events/rtc_event_probe_result_failure.h"
+#include "logging/rtc_event_log/events/rtc_event_probe_result_success.h"
+#include "logging/rtc_event_log/events/rtc_event_rtcp_packet_incoming.h"
+#include "logging/rtc_event_log/events/rtc_event_rtcp_packet_outgoing.h"
+#include "logging/rtc_event_log/events/rtc_event_rtp_packet_incoming.h"
+#include "logging/rtc_event_log/events/rtc_event_rtp_packet_outgoing.h"
+#include "logging/rtc_event_log/events/rtc_event_video_receive_stream_config.h"
+#include "logging/rtc_event_log/events/rtc_event_video_send_stream_config.h"
+#include "logging/rtc_event_log/rtc_stream_config.h"
+#include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
+#include "modules/remote_bitrate_estimator/include/bwe_defines.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/app.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/extended_jitter_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/psfb.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "rtc_base/byteorder.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ignore_wundef.h"
+#include "rtc_base/logging.h"
+
+#ifdef ENABLE_RTC_EVENT_LOG
+
+// *.pb.h files are generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/logging/rtc_event_log/rtc_event_log2.pb.h"
+#else
+#include "logging/rtc_event_log/rtc_event_log2.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
+namespace webrtc {
+
+namespace {
+rtclog2::DelayBasedBweUpdates::DetectorState ConvertDetectorState(
+    BandwidthUsage state) {
+  switch (state) {
+    case BandwidthUsage::kBwNormal:
+      return rtclog2::DelayBasedBweUpdates::BWE_NORMAL;
+    case BandwidthUsage::kBwUnderusing:
+      return rtclog2::DelayBasedBweUpdates::BWE_UNDERUSING;
+    case BandwidthUsage::kBwOverusing:
+      return rtclog2::DelayBasedBweUpdates::BWE_OVERUSING;
+    case BandwidthUsage::kLast:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::DelayBasedBweUpdates::BWE_NORMAL;
+}
+
+rtclog2::BweProbeResultFailure::FailureReason ConvertProbeFailureReason(
+    ProbeFailureReason failure_reason) {
+  switch (failure_reason) {
+    case ProbeFailureReason::kInvalidSendReceiveInterval:
+      return rtclog2::BweProbeResultFailure::INVALID_SEND_RECEIVE_INTERVAL;
+    case ProbeFailureReason::kInvalidSendReceiveRatio:
+      return rtclog2::BweProbeResultFailure::INVALID_SEND_RECEIVE_RATIO;
+    case ProbeFailureReason::kTimeout:
+      return rtclog2::BweProbeResultFailure::TIMEOUT;
+    case ProbeFailureReason::kLast:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::BweProbeResultFailure::UNKNOWN;
+}
+
+rtclog2::VideoRecvStreamConfig::RtcpMode ConvertRtcpMode(RtcpMode rtcp_mode) {
+  switch (rtcp_mode) {
+    case RtcpMode::kCompound:
+      return rtclog2::VideoRecvStreamConfig::RTCP_COMPOUND;
+    case RtcpMode::kReducedSize:
+      return rtclog2::VideoRecvStreamConfig::RTCP_REDUCEDSIZE;
+    case RtcpMode::kOff:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::VideoRecvStreamConfig::RTCP_COMPOUND;
+}
+
+rtclog2::IceCandidatePairConfig::IceCandidatePairConfigType
+ConvertIceCandidatePairConfigType(IceCandidatePairConfigType type) {
+  switch (type) {
+    case IceCandidatePairConfigType::kAdded:
+      return rtclog2::IceCandidatePairConfig::ADDED;
+    case IceCandidatePairConfigType::kUpdated:
+      return rtclog2::IceCandidatePairConfig::UPDATED;
+    case IceCandidatePairConfigType::kDestroyed:
+      return rtclog2::IceCandidatePairConfig::DESTROYED;
+    case IceCandidatePairConfigType::kSelected:
+      return rtclog2::IceCandidatePairConfig::SELECTED;
+    case IceCandidatePairConfigType::kNumValues:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::IceCandidatePairConfig::ADDED;
+}
+
+rtclog2::IceCandidatePairConfig::IceCandidateType ConvertIceCandidateType(
+    IceCandidateType type) {
+  switch (type) {
+    case IceCandidateType::kUnknown:
+      return rtclog2::IceCandidatePairConfig::UNKNOWN_CANDIDATE_TYPE;
+    case IceCandidateType::kLocal:
+      return rtclog2::IceCandidatePairConfig::LOCAL;
+    case IceCandidateType::kStun:
+      return rtclog2::IceCandidatePairConfig::STUN;
+    case IceCandidateType::kPrflx:
+      return rtclog2::IceCandidatePairConfig::PRFLX;
+    case IceCandidateType::kRelay:
+      return rtclog2::IceCandidatePairConfig::RELAY;
+    case IceCandidateType::kNumValues:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::IceCandidatePairConfig::UNKNOWN_CANDIDATE_TYPE;
+}
+
+rtclog2::IceCandidatePairConfig::Protocol ConvertIceCandidatePairProtocol(
+    IceCandidatePairProtocol protocol) {
+  switch (protocol) {
+    case IceCandidatePairProtocol::kUnknown:
+      return rtclog2::IceCandidatePairConfig::UNKNOWN_PROTOCOL;
+    case IceCandidatePairProtocol::kUdp:
+      return rtclog2::IceCandidatePairConfig::UDP;
+    case IceCandidatePairProtocol::kTcp:
+      return rtclog2::IceCandidatePairConfig::TCP;
+    case IceCandidatePairProtocol::kSsltcp:
+      return rtclog2::IceCandidatePairConfig::SSLTCP;
+    case IceCandidatePairProtocol::kTls:
+      return rtclog2::IceCandidatePairConfig::TLS;
+    case IceCandidatePairProtocol::kNumValues:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::IceCandidatePairConfig::UNKNOWN_PROTOCOL;
+}
+
+rtclog2::IceCandidatePairConfig::AddressFamily
+ConvertIceCandidatePairAddressFamily(
+    IceCandidatePairAddressFamily address_family) {
+  switch (address_family) {
+    case IceCandidatePairAddressFamily::kUnknown:
+      return rtclog2::IceCandidatePairConfig::UNKNOWN_ADDRESS_FAMILY;
+    case IceCandidatePairAddressFamily::kIpv4:
+      return rtclog2::IceCandidatePairConfig::IPV4;
+    case IceCandidatePairAddressFamily::kIpv6:
+      return rtclog2::IceCandidatePairConfig::IPV6;
+    case IceCandidatePairAddressFamily::kNumValues:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::IceCandidatePairConfig::UNKNOWN_ADDRESS_FAMILY;
+}
+
+rtclog2::IceCandidatePairConfig::NetworkType ConvertIceCandidateNetworkType(
+    IceCandidateNetworkType network_type) {
+  switch (network_type) {
+    case IceCandidateNetworkType::kUnknown:
+      return rtclog2::IceCandidatePairConfig::UNKNOWN_NETWORK_TYPE;
+    case IceCandidateNetworkType::kEthernet:
+      return rtclog2::IceCandidatePairConfig::ETHERNET;
+    case IceCandidateNetworkType::kLoopback:
+      return rtclog2::IceCandidatePairConfig::LOOPBACK;
+    case IceCandidateNetworkType::kWifi:
+      return rtclog2::IceCandidatePairConfig::WIFI;
+    case IceCandidateNetworkType::kVpn:
+      return rtclog2::IceCandidatePairConfig::VPN;
+    case IceCandidateNetworkType::kCellular:
+      return rtclog2::IceCandidatePairConfig::CELLULAR;
+    case IceCandidateNetworkType::kNumValues:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::IceCandidatePairConfig::UNKNOWN_NETWORK_TYPE;
+}
+
+rtclog2::IceCandidatePairEvent::IceCandidatePairEventType
+ConvertIceCandidatePairEventType(IceCandidatePairEventType type) {
+  switch (type) {
+    case IceCandidatePairEventType::kCheckSent:
+      return rtclog2::IceCandidatePairEvent::CHECK_SENT;
+    case IceCandidatePairEventType::kCheckReceived:
+      return rtclog2::IceCandidatePairEvent::CHECK_RECEIVED;
+    case IceCandidatePairEventType::kCheckResponseSent:
+      return rtclog2::IceCandidatePairEvent::CHECK_RESPONSE_SENT;
+    case IceCandidatePairEventType::kCheckResponseReceived:
+      return rtclog2::IceCandidatePairEvent::CHECK_RESPONSE_RECEIVED;
+    case IceCandidatePairEventType::kNumValues:
+      RTC_NOTREACHED();
+  }
+  RTC_NOTREACHED();
+  return rtclog2::IceCandidatePairEvent::CHECK_SENT;
+}
+
+int64_t ToMilliseconds(int64_t timestamp_us) {
+  return timestamp_us / 1000;
+}
+
+// The deltas of floats are taken between their bit patterns.
+uint32_t FloatToBits(float value) {
+  static_assert(sizeof(float) == sizeof(uint32_t), "");
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Delta encodes the value that |get_value| returns for each event of |batch|
+// but the first, starting from the value of the first one, which the caller
+// stores in full. |get_value| returns the value as, or as something that
+// converts to, an absl::optional<uint64_t>.
+template <typename EventType, typename GetValue>
+std::string EncodeDeltasOfBatch(rtc::ArrayView<const EventType*> batch,
+                                GetValue get_value) {
+  RTC_DCHECK(!batch.empty());
+  std::vector<absl::optional<uint64_t>> values;
+  values.reserve(batch.size() - 1);
+  for (size_t i = 1; i < batch.size(); ++i)
+    values.push_back(get_value(*batch[i]));
+  return EncodeDeltas(get_value(*batch[0]), values);
+}
+
+// Sets the number of deltas and the timestamp deltas of |proto_batch|, which
+// all the delta encoded messages have.
+template <typename EventType, typename ProtoType>
+void EncodeTimestampDeltas(rtc::ArrayView<const EventType*> batch,
+                           ProtoType* proto_batch) {
+  proto_batch->set_number_of_deltas(batch.size() - 1);
+  const std::string encoded_deltas =
+      EncodeDeltasOfBatch(batch, [](const EventType& event) {
+        return ToMilliseconds(event.timestamp_us_);
+      });
+  if (!encoded_deltas.empty())
+    proto_batch->set_timestamp_deltas_ms(encoded_deltas);
+}
+
+void EncodeHeaderExtensions(
+    const std::vector<RtpExtension>& extensions,
+    rtclog2::RtpHeaderExtensionConfig* proto_config) {
+  for (const RtpExtension& extension : extensions) {
+    if (extension.uri == RtpExtension::kTimestampOffsetUri) {
+      proto_config->set_transmission_time_offset_id(extension.id);
+    } else if (extension.uri == RtpExtension::kAbsSendTimeUri) {
+      proto_config->set_absolute_send_time_id(extension.id);
+    } else if (extension.uri == RtpExtension::kTransportSequenceNumberUri) {
+      proto_config->set_transport_sequence_number_id(extension.id);
+    } else if (extension.uri == RtpExtension::kAudioLevelUri) {
+      proto_config->set_audio_level_id(extension.id);
+    } else if (extension.uri == RtpExtension::kVideoRotationUri) {
+      proto_config->set_video_rotation_id(extension.id);
+    }
+  }
+}
+
+template <typename ProtoType>
+void EncodeCodecs(const std::vector<rtclog::StreamConfig::Codec>& codecs,
+                  ProtoType* proto_config) {
+  for (const rtclog::StreamConfig::Codec& codec : codecs) {
+    rtclog2::Codec* proto_codec = proto_config->add_codecs();
+    proto_codec->set_payload_name(codec.payload_name);
+    proto_codec->set_payload_type(codec.payload_type);
+    proto_codec->set_rtx_payload_type(codec.rtx_payload_type);
+  }
+}
+
+// Returns the blocks of |packet| that we log. Like the legacy encoder, we
+// drop the source descriptions, application defined messages and the blocks
+// of unknown type.
+std::string FilterRtcpPacket(const rtc::Buffer& packet) {
+  std::string output;
+  output.reserve(packet.size());
+  rtcp::CommonHeader header;
+  const uint8_t* block_begin = packet.data();
+  const uint8_t* packet_end = packet.data() + packet.size();
+  while (block_begin < packet_end) {
+    if (!header.Parse(block_begin, packet_end - block_begin)) {
+      break;  // Incorrect message header.
+    }
+    const uint8_t* next_block = header.NextPacket();
+    switch (header.type()) {
+      case rtcp::Bye::kPacketType:
+      case rtcp::ExtendedJitterReport::kPacketType:
+      case rtcp::ExtendedReports::kPacketType:
+      case rtcp::Psfb::kPacketType:
+      case rtcp::ReceiverReport::kPacketType:
+      case rtcp::Rtpfb::kPacketType:
+      case rtcp::SenderReport::kPacketType:
+        output.append(reinterpret_cast<const char*>(block_begin),
+                      next_block - block_begin);
+        break;
+      case rtcp::App::kPacketType:
+      case rtcp::Sdes::kPacketType:
+      default:
+        break;
+    }
+    block_begin = next_block;
+  }
+  return output;
+}
+
+template <typename EventType, typename ProtoType>
+void EncodeRtcpPacket(rtc::ArrayView<const EventType*> batch,
+                      ProtoType* proto_batch) {
+  const EventType* const base_event = batch[0];
+  proto_batch->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+  proto_batch->set_raw_packet(FilterRtcpPacket(base_event->packet_));
+  if (batch.size() == 1)
+    return;
+
+  EncodeTimestampDeltas(batch, proto_batch);
+  std::vector<std::string> packets;
+  packets.reserve(batch.size() - 1);
+  for (size_t i = 1; i < batch.size(); ++i)
+    packets.push_back(FilterRtcpPacket(batch[i]->packet_));
+  proto_batch->set_raw_packet_blobs(EncodeBlobs(packets));
+}
+
+absl::optional<uint64_t> GetTransmissionTimeOffset(const RtpPacket& header) {
+  int32_t offset;
+  if (!header.GetExtension<TransmissionOffset>(&offset))
+    return absl::nullopt;
+  // Sign extended, so that the small negative offsets give small deltas.
+  return static_cast<uint64_t>(static_cast<int64_t>(offset));
+}
+
+absl::optional<uint64_t> GetAbsoluteSendTime(const RtpPacket& header) {
+  uint32_t send_time;
+  if (!header.GetExtension<AbsoluteSendTime>(&send_time))
+    return absl::nullopt;
+  return send_time;
+}
+
+absl::optional<uint64_t> GetTransportSequenceNumber(const RtpPacket& header) {
+  uint16_t sequence_number;
+  if (!header.GetExtension<TransportSequenceNumber>(&sequence_number))
+    return absl::nullopt;
+  return sequence_number;
+}
+
+absl::optional<uint64_t> GetAudioLevel(const RtpPacket& header) {
+  bool voice_activity;
+  uint8_t audio_level;
+  if (!header.GetExtension<AudioLevel>(&voice_activity, &audio_level))
+    return absl::nullopt;
+  RTC_DCHECK_LE(audio_level, 0x7f);
+  return (voice_activity ? 0x80 : 0) | audio_level;
+}
+
+absl::optional<uint64_t> GetVideoRotation(const RtpPacket& header) {
+  uint8_t rotation;
+  if (!header.GetExtension<VideoOrientation>(&rotation))
+    return absl::nullopt;
+  return rotation;
+}
+
+std::string EncodeCsrcs(const RtpPacket& header) {
+  const std::vector<uint32_t> csrcs = header.Csrcs();
+  std::string output(4 * csrcs.size(), 0);
+  for (size_t i = 0; i < csrcs.size(); ++i)
+    rtc::SetBE32(&output[4 * i], csrcs[i]);
+  return output;
+}
+
+template <typename EventType, typename ProtoType>
+void EncodeRtpPacket(rtc::ArrayView<const EventType*> batch,
+                     ProtoType* proto_batch) {
+  const EventType* const base_event = batch[0];
+  const RtpPacket& base_header = base_event->header_;
+  proto_batch->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+  proto_batch->set_marker(base_header.Marker());
+  proto_batch->set_payload_type(base_header.PayloadType());
+  proto_batch->set_sequence_number(base_header.SequenceNumber());
+  proto_batch->set_rtp_timestamp(base_header.Timestamp());
+  proto_batch->set_ssrc(base_header.Ssrc());
+  for (uint32_t csrc : base_header.Csrcs())
+    proto_batch->add_csrcs(csrc);
+  proto_batch->set_packet_size(base_event->packet_length_);
+  proto_batch->set_header_size(base_header.headers_size());
+  proto_batch->set_padding_size(base_header.padding_size());
+
+  const absl::optional<uint64_t> transmission_time_offset =
+      GetTransmissionTimeOffset(base_header);
+  if (transmission_time_offset) {
+    proto_batch->set_transmission_time_offset(
+        static_cast<int32_t>(*transmission_time_offset));
+  }
+  const absl::optional<uint64_t> absolute_send_time =
+      GetAbsoluteSendTime(base_header);
+  if (absolute_send_time)
+    proto_batch->set_absolute_send_time(*absolute_send_time);
+  const absl::optional<uint64_t> transport_sequence_number =
+      GetTransportSequenceNumber(base_header);
+  if (transport_sequence_number)
+    proto_batch->set_transport_sequence_number(*transport_sequence_number);
+  const absl::optional<uint64_t> audio_level = GetAudioLevel(base_header);
+  if (audio_level)
+    proto_batch->set_audio_level(*audio_level);
+  const absl::optional<uint64_t> video_rotation =
+      GetVideoRotation(base_header);
+  if (video_rotation)
+    proto_batch->set_video_rotation(*video_rotation);
+
+  if (batch.size() == 1)
+    return;
+
+  EncodeTimestampDeltas(batch, proto_batch);
+  std::string encoded_deltas;
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) { return event.header_.Marker(); });
+  if (!encoded_deltas.empty())
+    proto_batch->set_marker_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return event.header_.PayloadType();
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_payload_type_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return event.header_.SequenceNumber();
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_sequence_number_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return event.header_.Timestamp();
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_rtp_timestamp_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) { return event.header_.Ssrc(); });
+  if (!encoded_deltas.empty())
+    proto_batch->set_ssrc_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) { return event.packet_length_; });
+  if (!encoded_deltas.empty())
+    proto_batch->set_packet_size_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return event.header_.headers_size();
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_header_size_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return event.header_.padding_size();
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_padding_size_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return GetTransmissionTimeOffset(event.header_);
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_transmission_time_offset_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return GetAbsoluteSendTime(event.header_);
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_absolute_send_time_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return GetTransportSequenceNumber(event.header_);
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_transport_sequence_number_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return GetAudioLevel(event.header_);
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_audio_level_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return GetVideoRotation(event.header_);
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_video_rotation_deltas(encoded_deltas);
+
+  // Most packets have no CSRCs, in which case the blobs are left out.
+  std::vector<std::string> csrcs;
+  csrcs.reserve(batch.size() - 1);
+  bool has_csrcs = false;
+  for (size_t i = 1; i < batch.size(); ++i) {
+    csrcs.push_back(EncodeCsrcs(batch[i]->header_));
+    has_csrcs |= !csrcs.back().empty();
+  }
+  if (has_csrcs)
+    proto_batch->set_csrcs_blobs(EncodeBlobs(csrcs));
+}
+
+}  // namespace
+
+std::string RtcEventLogEncoderNewFormat::EncodeLogStart(int64_t timestamp_us) {
+  rtclog2::EventStream event_stream;
+  event_stream.set_version(2);
+  rtclog2::BeginLogEvent* proto_event = event_stream.add_begin_log_events();
+  proto_event->set_timestamp_ms(ToMilliseconds(timestamp_us));
+  return event_stream.SerializeAsString();
+}
+
+std::string RtcEventLogEncoderNewFormat::EncodeLogEnd(int64_t timestamp_us) {
+  rtclog2::EventStream event_stream;
+  event_stream.set_version(2);
+  rtclog2::EndLogEvent* proto_event = event_stream.add_end_log_events();
+  proto_event->set_timestamp_ms(ToMilliseconds(timestamp_us));
+  return event_stream.SerializeAsString();
+}
+
+std::string RtcEventLogEncoderNewFormat::EncodeBatch(
+    std::deque<std::unique_ptr<RtcEvent>>::const_iterator begin,
+    std::deque<std::unique_ptr<RtcEvent>>::const_iterator end) {
+  if (begin == end)
+    return std::string();
+
+  std::vector<const RtcEventAlrState*> alr_state_events;
+  std::vector<const RtcEventAudioNetworkAdaptation*>
+      audio_network_adaptation_events;
+  std::vector<const RtcEventAudioPlayout*> audio_playout_events;
+  std::vector<const RtcEventAudioReceiveStreamConfig*>
+      audio_recv_stream_configs;
+  std::vector<const RtcEventAudioSendStreamConfig*> audio_send_stream_configs;
+  std::vector<const RtcEventBweUpdateDelayBased*> bwe_delay_based_updates;
+  std::vector<const RtcEventBweUpdateLossBased*> bwe_loss_based_updates;
+  std::vector<const RtcEventIceCandidatePairConfig*> ice_candidate_configs;
+  std::vector<const RtcEventIceCandidatePair*> ice_candidate_events;
+  std::vector<const RtcEventProbeClusterCreated*> probe_cluster_created_events;
+  std::vector<const RtcEventProbeResultFailure*> probe_result_failure_events;
+  std::vector<const RtcEventProbeResultSuccess*> probe_result_success_events;
+  std::vector<const RtcEventRtcpPacketIncoming*> incoming_rtcp_packets;
+  std::vector<const RtcEventRtcpPacketOutgoing*> outgoing_rtcp_packets;
+  std::map<uint32_t, std::vector<const RtcEventRtpPacketIncoming*>>
+      incoming_rtp_packets;
+  std::map<uint32_t, std::vector<const RtcEventRtpPacketOutgoing*>>
+      outgoing_rtp_packets;
+  std::vector<const RtcEventVideoReceiveStreamConfig*>
+      video_recv_stream_configs;
+  std::vector<const RtcEventVideoSendStreamConfig*> video_send_stream_configs;
+
+  for (auto it = begin; it != end; ++it) {
+    RTC_CHECK(it->get() != nullptr);
+    const RtcEvent* const event = it->get();
+    switch (event->GetType()) {
+      case RtcEvent::Type::AlrStateEvent:
+        alr_state_events.push_back(static_cast<const RtcEventAlrState*>(event));
+        break;
+      case RtcEvent::Type::AudioNetworkAdaptation:
+        audio_network_adaptation_events.push_back(
+            static_cast<const RtcEventAudioNetworkAdaptation*>(event));
+        break;
+      case RtcEvent::Type::AudioPlayout:
+        audio_playout_events.push_back(
+            static_cast<const RtcEventAudioPlayout*>(event));
+        break;
+      case RtcEvent::Type::AudioReceiveStreamConfig:
+        audio_recv_stream_configs.push_back(
+            static_cast<const RtcEventAudioReceiveStreamConfig*>(event));
+        break;
+      case RtcEvent::Type::AudioSendStreamConfig:
+        audio_send_stream_configs.push_back(
+            static_cast<const RtcEventAudioSendStreamConfig*>(event));
+        break;
+      case RtcEvent::Type::BweUpdateDelayBased:
+        bwe_delay_based_updates.push_back(
+            static_cast<const RtcEventBweUpdateDelayBased*>(event));
+        break;
+      case RtcEvent::Type::BweUpdateLossBased:
+        bwe_loss_based_updates.push_back(
+            static_cast<const RtcEventBweUpdateLossBased*>(event));
+        break;
+      case RtcEvent::Type::IceCandidatePairConfig:
+        ice_candidate_configs.push_back(
+            static_cast<const RtcEventIceCandidatePairConfig*>(event));
+        break;
+      case RtcEvent::Type::IceCandidatePairEvent:
+        ice_candidate_events.push_back(
+            static_cast<const RtcEventIceCandidatePair*>(event));
+        break;
+      case RtcEvent::Type::ProbeClusterCreated:
+        probe_cluster_created_events.push_back(
+            static_cast<const RtcEventProbeClusterCreated*>(event));
+        break;
+      case RtcEvent::Type::ProbeResultFailure:
+        probe_result_failure_events.push_back(
+            static_cast<const RtcEventProbeResultFailure*>(event));
+        break;
+      case RtcEvent::Type::ProbeResultSuccess:
+        probe_result_success_events.push_back(
+            static_cast<const RtcEventProbeResultSuccess*>(event));
+        break;
+      case RtcEvent::Type::RtcpPacketIncoming:
+        incoming_rtcp_packets.push_back(
+            static_cast<const RtcEventRtcpPacketIncoming*>(event));
+        break;
+      case RtcEvent::Type::RtcpPacketOutgoing:
+        outgoing_rtcp_packets.push_back(
+            static_cast<const RtcEventRtcpPacketOutgoing*>(event));
+        break;
+      case RtcEvent::Type::RtpPacketIncoming: {
+        auto* rtc_event = static_cast<const RtcEventRtpPacketIncoming*>(event);
+        incoming_rtp_packets[rtc_event->header_.Ssrc()].push_back(rtc_event);
+        break;
+      }
+      case RtcEvent::Type::RtpPacketOutgoing: {
+        auto* rtc_event = static_cast<const RtcEventRtpPacketOutgoing*>(event);
+        outgoing_rtp_packets[rtc_event->header_.Ssrc()].push_back(rtc_event);
+        break;
+      }
+      case RtcEvent::Type::VideoReceiveStreamConfig:
+        video_recv_stream_configs.push_back(
+            static_cast<const RtcEventVideoReceiveStreamConfig*>(event));
+        break;
+      case RtcEvent::Type::VideoSendStreamConfig:
+        video_send_stream_configs.push_back(
+            static_cast<const RtcEventVideoSendStreamConfig*>(event));
+        break;
+    }
+  }
+
+  rtclog2::EventStream event_stream;
+  event_stream.set_version(2);
+  EncodeAlrState(alr_state_events, &event_stream);
+  EncodeAudioNetworkAdaptation(audio_network_adaptation_events, &event_stream);
+  EncodeAudioPlayout(audio_playout_events, &event_stream);
+  EncodeAudioRecvStreamConfig(audio_recv_stream_configs, &event_stream);
+  EncodeAudioSendStreamConfig(audio_send_stream_configs, &event_stream);
+  EncodeBweUpdateDelayBased(bwe_delay_based_updates, &event_stream);
+  EncodeBweUpdateLossBased(bwe_loss_based_updates, &event_stream);
+  EncodeIceCandidatePairConfig(ice_candidate_configs, &event_stream);
+  EncodeIceCandidatePairEvent(ice_candidate_events, &event_stream);
+  EncodeProbeClusterCreated(probe_cluster_created_events, &event_stream);
+  EncodeProbeResultFailure(probe_result_failure_events, &event_stream);
+  EncodeProbeResultSuccess(probe_result_success_events, &event_stream);
+  EncodeRtcpPacketIncoming(incoming_rtcp_packets, &event_stream);
+  EncodeRtcpPacketOutgoing(outgoing_rtcp_packets, &event_stream);
+  for (auto& kv : incoming_rtp_packets)
+    EncodeRtpPacketIncoming(kv.second, &event_stream);
+  for (auto& kv : outgoing_rtp_packets)
+    EncodeRtpPacketOutgoing(kv.second, &event_stream);
+  EncodeVideoRecvStreamConfig(video_recv_stream_configs, &event_stream);
+  EncodeVideoSendStreamConfig(video_send_stream_configs, &event_stream);
+  return event_stream.SerializeAsString();
+}
+
+void RtcEventLogEncoderNewFormat::EncodeAlrState(
+    rtc::ArrayView<const RtcEventAlrState*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventAlrState* base_event : batch) {
+    rtclog2::AlrState* proto_batch = event_stream->add_alr_states();
+    proto_batch->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_batch->set_in_alr(base_event->in_alr_);
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeAudioNetworkAdaptation(
+    rtc::ArrayView<const RtcEventAudioNetworkAdaptation*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+
+  rtclog2::AudioNetworkAdaptations* proto_batch =
+      event_stream->add_audio_network_adaptations();
+  const AudioEncoderRuntimeConfig& base_config = *batch[0]->config_;
+  proto_batch->set_timestamp_ms(ToMilliseconds(batch[0]->timestamp_us_));
+  if (base_config.bitrate_bps)
+    proto_batch->set_bitrate_bps(*base_config.bitrate_bps);
+  if (base_config.frame_length_ms)
+    proto_batch->set_frame_length_ms(*base_config.frame_length_ms);
+  if (base_config.uplink_packet_loss_fraction) {
+    proto_batch->set_uplink_packet_loss_fraction(
+        *base_config.uplink_packet_loss_fraction);
+  }
+  if (base_config.enable_fec)
+    proto_batch->set_enable_fec(*base_config.enable_fec);
+  if (base_config.enable_dtx)
+    proto_batch->set_enable_dtx(*base_config.enable_dtx);
+  if (base_config.num_channels)
+    proto_batch->set_num_channels(*base_config.num_channels);
+
+  if (batch.size() == 1)
+    return;
+
+  using EventType = RtcEventAudioNetworkAdaptation;
+  EncodeTimestampDeltas(batch, proto_batch);
+  std::string encoded_deltas;
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) -> absl::optional<uint64_t> {
+        if (!event.config_->bitrate_bps)
+          return absl::nullopt;
+        return *event.config_->bitrate_bps;
+      });
+  if (!encoded_deltas.empty())
+    proto_batch->set_bitrate_deltas_bps(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) -> absl::optional<uint64_t> {
+        if (!event.config_->frame_length_ms)
+          return absl::nullopt;
+        return *event.config_->frame_length_ms;
+      });
+  if (!encoded_deltas.empty())
+    proto_batch->set_frame_length_deltas_ms(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) -> absl::optional<uint64_t> {
+        if (!event.config_->uplink_packet_loss_fraction)
+          return absl::nullopt;
+        return FloatToBits(*event.config_->uplink_packet_loss_fraction);
+      });
+  if (!encoded_deltas.empty())
+    proto_batch->set_uplink_packet_loss_fraction_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) -> absl::optional<uint64_t> {
+        if (!event.config_->enable_fec)
+          return absl::nullopt;
+        return *event.config_->enable_fec;
+      });
+  if (!encoded_deltas.empty())
+    proto_batch->set_enable_fec_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) -> absl::optional<uint64_t> {
+        if (!event.config_->enable_dtx)
+          return absl::nullopt;
+        return *event.config_->enable_dtx;
+      });
+  if (!encoded_deltas.empty())
+    proto_batch->set_enable_dtx_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) -> absl::optional<uint64_t> {
+        if (!event.config_->num_channels)
+          return absl::nullopt;
+        return *event.config_->num_channels;
+      });
+  if (!encoded_deltas.empty())
+    proto_batch->set_num_channels_deltas(encoded_deltas);
+}
+
+void RtcEventLogEncoderNewFormat::EncodeAudioPlayout(
+    rtc::ArrayView<const RtcEventAudioPlayout*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+
+  rtclog2::AudioPlayoutEvents* proto_batch =
+      event_stream->add_audio_playout_events();
+  proto_batch->set_timestamp_ms(ToMilliseconds(batch[0]->timestamp_us_));
+  proto_batch->set_local_ssrc(batch[0]->ssrc_);
+
+  if (batch.size() == 1)
+    return;
+
+  EncodeTimestampDeltas(batch, proto_batch);
+  const std::string encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const RtcEventAudioPlayout& event) { return event.ssrc_; });
+  if (!encoded_deltas.empty())
+    proto_batch->set_local_ssrc_deltas(encoded_deltas);
+}
+
+void RtcEventLogEncoderNewFormat::EncodeAudioRecvStreamConfig(
+    rtc::ArrayView<const RtcEventAudioReceiveStreamConfig*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventAudioReceiveStreamConfig* base_event : batch) {
+    rtclog2::AudioRecvStreamConfig* proto_config =
+        event_stream->add_audio_recv_stream_configs();
+    const rtclog::StreamConfig& config = *base_event->config_;
+    proto_config->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_config->set_remote_ssrc(config.remote_ssrc);
+    proto_config->set_local_ssrc(config.local_ssrc);
+    if (!config.rsid.empty())
+      proto_config->set_rsid(config.rsid);
+    EncodeHeaderExtensions(config.rtp_extensions,
+                           proto_config->mutable_header_extensions());
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeAudioSendStreamConfig(
+    rtc::ArrayView<const RtcEventAudioSendStreamConfig*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventAudioSendStreamConfig* base_event : batch) {
+    rtclog2::AudioSendStreamConfig* proto_config =
+        event_stream->add_audio_send_stream_configs();
+    const rtclog::StreamConfig& config = *base_event->config_;
+    proto_config->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_config->set_ssrc(config.local_ssrc);
+    if (!config.rsid.empty())
+      proto_config->set_rsid(config.rsid);
+    EncodeHeaderExtensions(config.rtp_extensions,
+                           proto_config->mutable_header_extensions());
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeBweUpdateDelayBased(
+    rtc::ArrayView<const RtcEventBweUpdateDelayBased*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+
+  rtclog2::DelayBasedBweUpdates* proto_batch =
+      event_stream->add_delay_based_bwe_updates();
+  proto_batch->set_timestamp_ms(ToMilliseconds(batch[0]->timestamp_us_));
+  proto_batch->set_bitrate_bps(batch[0]->bitrate_bps_);
+  proto_batch->set_detector_state(
+      ConvertDetectorState(batch[0]->detector_state_));
+
+  if (batch.size() == 1)
+    return;
+
+  using EventType = RtcEventBweUpdateDelayBased;
+  EncodeTimestampDeltas(batch, proto_batch);
+  std::string encoded_deltas;
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) { return event.bitrate_bps_; });
+  if (!encoded_deltas.empty())
+    proto_batch->set_bitrate_deltas_bps(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(batch, [](const EventType& event) {
+    return ConvertDetectorState(event.detector_state_);
+  });
+  if (!encoded_deltas.empty())
+    proto_batch->set_detector_state_deltas(encoded_deltas);
+}
+
+void RtcEventLogEncoderNewFormat::EncodeBweUpdateLossBased(
+    rtc::ArrayView<const RtcEventBweUpdateLossBased*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+
+  rtclog2::LossBasedBweUpdates* proto_batch =
+      event_stream->add_loss_based_bwe_updates();
+  proto_batch->set_timestamp_ms(ToMilliseconds(batch[0]->timestamp_us_));
+  proto_batch->set_bitrate_bps(batch[0]->bitrate_bps_);
+  proto_batch->set_fraction_loss(batch[0]->fraction_loss_);
+  proto_batch->set_total_packets(batch[0]->total_packets_);
+
+  if (batch.size() == 1)
+    return;
+
+  using EventType = RtcEventBweUpdateLossBased;
+  EncodeTimestampDeltas(batch, proto_batch);
+  std::string encoded_deltas;
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) { return event.bitrate_bps_; });
+  if (!encoded_deltas.empty())
+    proto_batch->set_bitrate_deltas_bps(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) { return event.fraction_loss_; });
+  if (!encoded_deltas.empty())
+    proto_batch->set_fraction_loss_deltas(encoded_deltas);
+
+  encoded_deltas = EncodeDeltasOfBatch(
+      batch, [](const EventType& event) { return event.total_packets_; });
+  if (!encoded_deltas.empty())
+    proto_batch->set_total_packets_deltas(encoded_deltas);
+}
+
+void RtcEventLogEncoderNewFormat::EncodeIceCandidatePairConfig(
+    rtc::ArrayView<const RtcEventIceCandidatePairConfig*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventIceCandidatePairConfig* base_event : batch) {
+    rtclog2::IceCandidatePairConfig* proto_event =
+        event_stream->add_ice_candidate_configs();
+    proto_event->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_event->set_config_type(
+        ConvertIceCandidatePairConfigType(base_event->type_));
+    proto_event->set_candidate_pair_id(base_event->candidate_pair_id_);
+    const auto& desc = base_event->candidate_pair_desc_;
+    proto_event->set_local_candidate_type(
+        ConvertIceCandidateType(desc.local_candidate_type));
+    proto_event->set_local_relay_protocol(
+        ConvertIceCandidatePairProtocol(desc.local_relay_protocol));
+    proto_event->set_local_network_type(
+        ConvertIceCandidateNetworkType(desc.local_network_type));
+    proto_event->set_local_address_family(
+        ConvertIceCandidatePairAddressFamily(desc.local_address_family));
+    proto_event->set_remote_candidate_type(
+        ConvertIceCandidateType(desc.remote_candidate_type));
+    proto_event->set_remote_address_family(
+        ConvertIceCandidatePairAddressFamily(desc.remote_address_family));
+    proto_event->set_candidate_pair_protocol(
+        ConvertIceCandidatePairProtocol(desc.candidate_pair_protocol));
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeIceCandidatePairEvent(
+    rtc::ArrayView<const RtcEventIceCandidatePair*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventIceCandidatePair* base_event : batch) {
+    rtclog2::IceCandidatePairEvent* proto_event =
+        event_stream->add_ice_candidate_events();
+    proto_event->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_event->set_event_type(
+        ConvertIceCandidatePairEventType(base_event->type_));
+    proto_event->set_candidate_pair_id(base_event->candidate_pair_id_);
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeProbeClusterCreated(
+    rtc::ArrayView<const RtcEventProbeClusterCreated*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventProbeClusterCreated* base_event : batch) {
+    rtclog2::BweProbeCluster* proto_event = event_stream->add_probe_clusters();
+    proto_event->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_event->set_id(base_event->id_);
+    proto_event->set_bitrate_bps(base_event->bitrate_bps_);
+    proto_event->set_min_packets(base_event->min_probes_);
+    proto_event->set_min_bytes(base_event->min_bytes_);
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeProbeResultFailure(
+    rtc::ArrayView<const RtcEventProbeResultFailure*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventProbeResultFailure* base_event : batch) {
+    rtclog2::BweProbeResultFailure* proto_event =
+        event_stream->add_probe_failure();
+    proto_event->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_event->set_id(base_event->id_);
+    proto_event->set_failure(
+        ConvertProbeFailureReason(base_event->failure_reason_));
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeProbeResultSuccess(
+    rtc::ArrayView<const RtcEventProbeResultSuccess*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventProbeResultSuccess* base_event : batch) {
+    rtclog2::BweProbeResultSuccess* proto_event =
+        event_stream->add_probe_success();
+    proto_event->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_event->set_id(base_event->id_);
+    proto_event->set_bitrate_bps(base_event->bitrate_bps_);
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeRtcpPacketIncoming(
+    rtc::ArrayView<const RtcEventRtcpPacketIncoming*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+  EncodeRtcpPacket(batch, event_stream->add_incoming_rtcp_packets());
+}
+
+void RtcEventLogEncoderNewFormat::EncodeRtcpPacketOutgoing(
+    rtc::ArrayView<const RtcEventRtcpPacketOutgoing*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+  EncodeRtcpPacket(batch, event_stream->add_outgoing_rtcp_packets());
+}
+
+void RtcEventLogEncoderNewFormat::EncodeRtpPacketIncoming(
+    rtc::ArrayView<const RtcEventRtpPacketIncoming*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+  EncodeRtpPacket(batch, event_stream->add_incoming_rtp_packets());
+}
+
+void RtcEventLogEncoderNewFormat::EncodeRtpPacketOutgoing(
+    rtc::ArrayView<const RtcEventRtpPacketOutgoing*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+  EncodeRtpPacket(batch, event_stream->add_outgoing_rtp_packets());
+}
+
+void RtcEventLogEncoderNewFormat::EncodeVideoRecvStreamConfig(
+    rtc::ArrayView<const RtcEventVideoReceiveStreamConfig*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventVideoReceiveStreamConfig* base_event : batch) {
+    rtclog2::VideoRecvStreamConfig* proto_config =
+        event_stream->add_video_recv_stream_configs();
+    const rtclog::StreamConfig& config = *base_event->config_;
+    proto_config->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_config->set_remote_ssrc(config.remote_ssrc);
+    proto_config->set_local_ssrc(config.local_ssrc);
+    if (config.rtx_ssrc != 0)
+      proto_config->set_rtx_ssrc(config.rtx_ssrc);
+    if (!config.rsid.empty())
+      proto_config->set_rsid(config.rsid);
+    EncodeHeaderExtensions(config.rtp_extensions,
+                           proto_config->mutable_header_extensions());
+    EncodeCodecs(config.codecs, proto_config);
+    proto_config->set_remb(config.remb);
+    proto_config->set_rtcp_mode(ConvertRtcpMode(config.rtcp_mode));
+  }
+}
+
+void RtcEventLogEncoderNewFormat::EncodeVideoSendStreamConfig(
+    rtc::ArrayView<const RtcEventVideoSendStreamConfig*> batch,
+    rtclog2::EventStream* event_stream) {
+  for (const RtcEventVideoSendStreamConfig* base_event : batch) {
+    rtclog2::VideoSendStreamConfig* proto_config =
+        event_stream->add_video_send_stream_configs();
+    const rtclog::StreamConfig& config = *base_event->config_;
+    proto_config->set_timestamp_ms(ToMilliseconds(base_event->timestamp_us_));
+    proto_config->set_ssrc(config.local_ssrc);
+    if (config.rtx_ssrc != 0)
+      proto_config->set_rtx_ssrc(config.rtx_ssrc);
+    if (!config.rsid.empty())
+      proto_config->set_rsid(config.rsid);
+    EncodeHeaderExtensions(config.rtp_extensions,
+                           proto_config->mutable_header_extensions());
+    EncodeCodecs(config.codecs, proto_config);
+  }
+}
+
+}  // namespace webrtc
+
+#endif  // ENABLE_RTC_EVENT_LOG
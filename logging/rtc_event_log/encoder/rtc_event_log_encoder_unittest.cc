@@ -11,9 +11,11 @@
 #include <deque>
 #include <limits>
 #include <string>
+#include <tuple>
 
 #include "absl/memory/memory.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder_legacy.h"
+#include "logging/rtc_event_log/encoder/rtc_event_log_encoder_new_format.h"
 #include "logging/rtc_event_log/events/rtc_event_alr_state.h"
 #include "logging/rtc_event_log/events/rtc_event_audio_network_adaptation.h"
 #include "logging/rtc_event_log/events/rtc_event_audio_playout.h"
@@ -35,30 +37,52 @@
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
 #include "modules/remote_bitrate_estimator/include/bwe_defines.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "rtc_base/fakeclock.h"
 #include "rtc_base/random.h"
 #include "test/gtest.h"
 
 namespace webrtc {
 
+namespace {
+std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
+    RtcEventLog::EncodingType encoding_type) {
+  switch (encoding_type) {
+    case RtcEventLog::EncodingType::Legacy:
+      return absl::make_unique<RtcEventLogEncoderLegacy>();
+    case RtcEventLog::EncodingType::NewFormat:
+      return absl::make_unique<RtcEventLogEncoderNewFormat>();
+  }
+  RTC_NOTREACHED();
+  return nullptr;
+}
+}  // namespace
 
-class RtcEventLogEncoderTest : public testing::TestWithParam<int> {
+class RtcEventLogEncoderTest
+    : public testing::TestWithParam<
+          std::tuple<int, RtcEventLog::EncodingType>> {
  protected:
   RtcEventLogEncoderTest()
-      : encoder_(new RtcEventLogEncoderLegacy),
-        seed_(GetParam()),
+      : encoder_(CreateEncoder(std::get<1>(GetParam()))),
+        seed_(std::get<0>(GetParam())),
         prng_(seed_),
-        gen_(seed_ * 880001UL) {}
+        gen_(seed_ * 880001UL) {
+    // The new format only stores the timestamps with millisecond precision.
+    fake_clock_.SetTimeMicros(1000 * prng_.Rand(1, 1000000));
+  }
   ~RtcEventLogEncoderTest() override = default;
 
+  void AdvanceTimeMs(int64_t delta_ms) {
+    fake_clock_.AdvanceTimeMicros(1000 * delta_ms);
+  }
+
   // ANA events have some optional fields, so we want to make sure that we get
   // correct behavior both when all of the values are there, as well as when
   // only some.
   void TestRtcEventAudioNetworkAdaptation(
       std::unique_ptr<AudioEncoderRuntimeConfig> runtime_config);
 
+  rtc::ScopedFakeClock fake_clock_;
   std::deque<std::unique_ptr<RtcEvent>> history_;
-  // TODO(eladalon): Once we have more than one possible encoder, parameterize
-  // encoder selection.
   std::unique_ptr<RtcEventLogEncoder> encoder_;
   ParsedRtcEventLogNew parsed_log_;
   const uint64_t seed_;
@@ -437,8 +461,168 @@ TEST_P(RtcEventLogEncoderTest, RtcEventVideoSendStreamConfig) {
   EXPECT_TRUE(test::VerifyLoggedVideoSendConfig(*event, video_send_configs[0]));
 }
 
-INSTANTIATE_TEST_CASE_P(RandomSeeds,
-                        RtcEventLogEncoderTest,
-                        ::testing::Values(1, 2, 3, 4, 5));
+// The new format delta encodes batches of events of the same type, so make
+// sure that a batch with more than one event of each type survives the round
+// trip, also when the events are interleaved.
+TEST_P(RtcEventLogEncoderTest, RtcEventRtpPacketBatch) {
+  const uint32_t incoming_ssrc = prng_.Rand<uint32_t>();
+  const uint32_t outgoing_ssrc = prng_.Rand<uint32_t>();
+  RtpHeaderExtensionMap extension_map = gen_.NewRtpHeaderExtensionMap();
+  // The legacy format needs the configurations to parse the extensions.
+  history_.push_back(
+      gen_.NewAudioReceiveStreamConfig(incoming_ssrc, extension_map));
+  history_.push_back(
+      gen_.NewAudioSendStreamConfig(outgoing_ssrc, extension_map));
+
+  constexpr size_t kNumPackets = 20;
+  std::vector<std::unique_ptr<RtcEventRtpPacketIncoming>> incoming_events;
+  std::vector<std::unique_ptr<RtcEventRtpPacketOutgoing>> outgoing_events;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    AdvanceTimeMs(prng_.Rand(0, 20));
+    incoming_events.push_back(
+        gen_.NewRtpPacketIncoming(incoming_ssrc, extension_map));
+    history_.push_back(incoming_events.back()->Copy());
+    AdvanceTimeMs(prng_.Rand(0, 20));
+    outgoing_events.push_back(
+        gen_.NewRtpPacketOutgoing(outgoing_ssrc, extension_map));
+    history_.push_back(outgoing_events.back()->Copy());
+  }
+
+  std::string encoded = encoder_->EncodeBatch(history_.begin(), history_.end());
+  ASSERT_TRUE(parsed_log_.ParseString(encoded));
+  const auto& incoming_rtp_packets_by_ssrc =
+      parsed_log_.incoming_rtp_packets_by_ssrc();
+  const auto& outgoing_rtp_packets_by_ssrc =
+      parsed_log_.outgoing_rtp_packets_by_ssrc();
+
+  ASSERT_EQ(incoming_rtp_packets_by_ssrc.size(), 1u);
+  const auto& incoming_stream = incoming_rtp_packets_by_ssrc[0];
+  EXPECT_EQ(incoming_stream.ssrc, incoming_ssrc);
+  ASSERT_EQ(incoming_stream.incoming_packets.size(), kNumPackets);
+  ASSERT_EQ(outgoing_rtp_packets_by_ssrc.size(), 1u);
+  const auto& outgoing_stream = outgoing_rtp_packets_by_ssrc[0];
+  EXPECT_EQ(outgoing_stream.ssrc, outgoing_ssrc);
+  ASSERT_EQ(outgoing_stream.outgoing_packets.size(), kNumPackets);
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(test::VerifyLoggedRtpPacketIncoming(
+        *incoming_events[i], incoming_stream.incoming_packets[i]));
+    EXPECT_TRUE(test::VerifyLoggedRtpPacketOutgoing(
+        *outgoing_events[i], outgoing_stream.outgoing_packets[i]));
+  }
+}
+
+TEST_P(RtcEventLogEncoderTest, RtcEventMixedBatch) {
+  const uint32_t ssrc = prng_.Rand<uint32_t>();
+  constexpr size_t kNumEvents = 10;
+  std::vector<std::unique_ptr<RtcEventAudioPlayout>> playout_events;
+  std::vector<std::unique_ptr<RtcEventBweUpdateDelayBased>> delay_events;
+  std::vector<std::unique_ptr<RtcEventBweUpdateLossBased>> loss_events;
+  std::vector<std::unique_ptr<RtcEventAudioNetworkAdaptation>> ana_events;
+  std::vector<std::unique_ptr<RtcEventRtcpPacketOutgoing>> rtcp_events;
+  for (size_t i = 0; i < kNumEvents; ++i) {
+    AdvanceTimeMs(prng_.Rand(0, 100));
+    playout_events.push_back(gen_.NewAudioPlayout(ssrc));
+    history_.push_back(playout_events.back()->Copy());
+    delay_events.push_back(gen_.NewBweUpdateDelayBased());
+    history_.push_back(delay_events.back()->Copy());
+    AdvanceTimeMs(prng_.Rand(0, 100));
+    loss_events.push_back(gen_.NewBweUpdateLossBased());
+    history_.push_back(loss_events.back()->Copy());
+    ana_events.push_back(gen_.NewAudioNetworkAdaptation());
+    history_.push_back(ana_events.back()->Copy());
+    rtcp_events.push_back(gen_.NewRtcpPacketOutgoing());
+    history_.push_back(rtcp_events.back()->Copy());
+  }
+
+  std::string encoded = encoder_->EncodeBatch(history_.begin(), history_.end());
+  ASSERT_TRUE(parsed_log_.ParseString(encoded));
+  const auto& playout_events_by_ssrc = parsed_log_.audio_playout_events();
+  const auto& delay_updates = parsed_log_.bwe_delay_updates();
+  const auto& loss_updates = parsed_log_.bwe_loss_updates();
+  const auto& ana_updates = parsed_log_.audio_network_adaptation_events();
+  const auto& rtcp_packets = parsed_log_.outgoing_rtcp_packets();
+
+  ASSERT_EQ(playout_events_by_ssrc.size(), 1u);
+  ASSERT_EQ(playout_events_by_ssrc.begin()->first, ssrc);
+  const auto& ssrc_playout_events = playout_events_by_ssrc.begin()->second;
+  ASSERT_EQ(ssrc_playout_events.size(), kNumEvents);
+  ASSERT_EQ(delay_updates.size(), kNumEvents);
+  ASSERT_EQ(loss_updates.size(), kNumEvents);
+  ASSERT_EQ(ana_updates.size(), kNumEvents);
+  ASSERT_EQ(rtcp_packets.size(), kNumEvents);
+  for (size_t i = 0; i < kNumEvents; ++i) {
+    EXPECT_TRUE(test::VerifyLoggedAudioPlayoutEvent(*playout_events[i],
+                                                    ssrc_playout_events[i]));
+    EXPECT_TRUE(
+        test::VerifyLoggedBweDelayBasedUpdate(*delay_events[i],
+                                              delay_updates[i]));
+    EXPECT_TRUE(
+        test::VerifyLoggedBweLossBasedUpdate(*loss_events[i], loss_updates[i]));
+    EXPECT_TRUE(test::VerifyLoggedAudioNetworkAdaptationEvent(*ana_events[i],
+                                                              ana_updates[i]));
+    EXPECT_TRUE(
+        test::VerifyLoggedRtcpPacketOutgoing(*rtcp_events[i], rtcp_packets[i]));
+  }
+}
+
+TEST_P(RtcEventLogEncoderTest, ParserFiltersEventsBySsrcAndType) {
+  const uint32_t ssrc = prng_.Rand<uint32_t>();
+  const uint32_t other_ssrc = ssrc + 1;
+  RtpHeaderExtensionMap extension_map = gen_.NewRtpHeaderExtensionMap();
+  history_.push_back(gen_.NewAudioReceiveStreamConfig(ssrc, extension_map));
+  history_.push_back(
+      gen_.NewAudioReceiveStreamConfig(other_ssrc, extension_map));
+
+  constexpr size_t kNumEvents = 5;
+  std::vector<std::unique_ptr<RtcEventRtpPacketIncoming>> rtp_events;
+  std::vector<std::unique_ptr<RtcEventAudioPlayout>> playout_events;
+  for (size_t i = 0; i < kNumEvents; ++i) {
+    AdvanceTimeMs(prng_.Rand(0, 20));
+    rtp_events.push_back(gen_.NewRtpPacketIncoming(ssrc, extension_map));
+    history_.push_back(rtp_events.back()->Copy());
+    history_.push_back(gen_.NewRtpPacketIncoming(other_ssrc, extension_map));
+    playout_events.push_back(gen_.NewAudioPlayout(ssrc));
+    history_.push_back(playout_events.back()->Copy());
+    history_.push_back(gen_.NewAudioPlayout(other_ssrc));
+    history_.push_back(gen_.NewBweUpdateLossBased());
+  }
+
+  std::string encoded = encoder_->EncodeBatch(history_.begin(), history_.end());
+  parsed_log_.SetEventTypeFilter(
+      {ParsedRtcEventLogNew::EventType::RTP_EVENT,
+       ParsedRtcEventLogNew::EventType::AUDIO_PLAYOUT_EVENT});
+  parsed_log_.SetSsrcFilter({ssrc});
+  parsed_log_.set_store_raw_events(false);
+  ASSERT_TRUE(parsed_log_.ParseString(encoded));
+
+  // The configs are kept regardless of the filters.
+  EXPECT_EQ(parsed_log_.audio_recv_configs().size(), 2u);
+  EXPECT_TRUE(parsed_log_.bwe_loss_updates().empty());
+  EXPECT_EQ(parsed_log_.GetNumberOfEvents(), 0u);
+
+  const auto& rtp_packets_by_ssrc = parsed_log_.incoming_rtp_packets_by_ssrc();
+  ASSERT_EQ(rtp_packets_by_ssrc.size(), 1u);
+  EXPECT_EQ(rtp_packets_by_ssrc[0].ssrc, ssrc);
+  ASSERT_EQ(rtp_packets_by_ssrc[0].incoming_packets.size(), kNumEvents);
+  const auto& playout_events_by_ssrc = parsed_log_.audio_playout_events();
+  ASSERT_EQ(playout_events_by_ssrc.size(), 1u);
+  ASSERT_EQ(playout_events_by_ssrc.begin()->first, ssrc);
+  const auto& ssrc_playout_events = playout_events_by_ssrc.begin()->second;
+  ASSERT_EQ(ssrc_playout_events.size(), kNumEvents);
+  for (size_t i = 0; i < kNumEvents; ++i) {
+    EXPECT_TRUE(test::VerifyLoggedRtpPacketIncoming(
+        *rtp_events[i], rtp_packets_by_ssrc[0].incoming_packets[i]));
+    EXPECT_TRUE(test::VerifyLoggedAudioPlayoutEvent(*playout_events[i],
+                                                    ssrc_playout_events[i]));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    RandomSeeds,
+    RtcEventLogEncoderTest,
+    ::testing::Combine(
+        ::testing::Values(1, 2, 3, 4, 5),
+        ::testing::Values(RtcEventLog::EncodingType::Legacy,
+                          RtcEventLog::EncodingType::NewFormat)));
 
 }  // namespace webrtc
@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/varint.h"
+
+namespace webrtc {
+
+void EncodeVarInt(uint64_t input, std::string* output) {
+  // Every byte holds seven bits of the value, least significant first. The
+  // most significant bit is set on all bytes but the last.
+  while (input >= 0x80) {
+    output->push_back(static_cast<char>((input & 0x7f) | 0x80));
+    input >>= 7;
+  }
+  output->push_back(static_cast<char>(input));
+}
+
+bool DecodeVarInt(const std::string& input, size_t* offset, uint64_t* output) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < kMaxVarIntLengthBytes; ++i) {
+    if (*offset + i >= input.size())
+      return false;
+    const uint8_t byte = static_cast<uint8_t>(input[*offset + i]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if (!(byte & 0x80)) {
+      *offset += i + 1;
+      *output = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace webrtc
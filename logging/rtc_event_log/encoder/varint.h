@@ -0,0 +1,33 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_ENCODER_VARINT_H_
+#define LOGGING_RTC_EVENT_LOG_ENCODER_VARINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace webrtc {
+
+// The maximum length of the varint encoding of a uint64_t.
+constexpr size_t kMaxVarIntLengthBytes = 10;
+
+// Appends the protobuf style varint encoding of |input| to |output|.
+void EncodeVarInt(uint64_t input, std::string* output);
+
+// Reads a varint from |input|, starting at |*offset|. On success, stores the
+// value in |output|, moves |*offset| past the varint and returns true.
+bool DecodeVarInt(const std::string& input, size_t* offset, uint64_t* output);
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_ENCODER_VARINT_H_
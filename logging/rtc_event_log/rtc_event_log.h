@@ -29,10 +29,11 @@ class RtcEventLog {
   enum : size_t { kUnlimitedOutput = 0 };
   enum : int64_t { kImmediateOutput = 0 };
 
-  // TODO(eladalon): Two stages are upcoming.
-  // 1. Extend this to actually support the new encoding.
-  // 2. Get rid of the legacy encoding, allowing us to get rid of this enum.
-  enum class EncodingType { Legacy };
+  // NewFormat groups the events of each output batch by type and delta
+  // encodes them, see rtc_event_log2.proto. It only has millisecond precision.
+  // TODO(eladalon): Get rid of the legacy encoding, allowing us to get rid of
+  // this enum.
+  enum class EncodingType { Legacy, NewFormat };
 
   virtual ~RtcEventLog() {}
 
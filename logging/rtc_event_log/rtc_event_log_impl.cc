@@ -19,9 +19,15 @@
 
 #include "absl/memory/memory.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder_legacy.h"
+#include "logging/rtc_event_log/encoder/rtc_event_log_encoder_new_format.h"
+#include "logging/rtc_event_log/events/rtc_event_rtcp_packet_incoming.h"
+#include "logging/rtc_event_log/events/rtc_event_rtcp_packet_outgoing.h"
+#include "logging/rtc_event_log/events/rtc_event_rtp_packet_incoming.h"
+#include "logging/rtc_event_log/events/rtc_event_rtp_packet_outgoing.h"
 #include "logging/rtc_event_log/output/rtc_event_log_output_file.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -35,10 +41,39 @@ namespace webrtc {
 #ifdef ENABLE_RTC_EVENT_LOG
 
 namespace {
-constexpr size_t kMaxEventsInHistory = 10000;
+// Roughly 10000 RTP packets.
+constexpr size_t kMaxHistorySizeBytes = 2 * 1024 * 1024;
 // The config-history is supposed to be unbounded, but needs to have some bound
 // to prevent an attack via unreasonable memory use.
-constexpr size_t kMaxEventsInConfigHistory = 1000;
+constexpr size_t kMaxConfigHistorySizeBytes = 512 * 1024;
+// What we assume the events that don't carry packets take up, including the
+// allocation overhead. Configs hold a few vectors and strings.
+constexpr size_t kEventSizeBytes = 128;
+constexpr size_t kConfigEventSizeBytes = 512;
+
+// Estimates the memory held by |event|. Only the packets vary in size.
+size_t EstimateSizeBytes(const RtcEvent& event) {
+  switch (event.GetType()) {
+    case RtcEvent::Type::RtpPacketIncoming:
+      return sizeof(RtcEventRtpPacketIncoming) +
+             static_cast<const RtcEventRtpPacketIncoming&>(event)
+                 .header_.size();
+    case RtcEvent::Type::RtpPacketOutgoing:
+      return sizeof(RtcEventRtpPacketOutgoing) +
+             static_cast<const RtcEventRtpPacketOutgoing&>(event)
+                 .header_.size();
+    case RtcEvent::Type::RtcpPacketIncoming:
+      return sizeof(RtcEventRtcpPacketIncoming) +
+             static_cast<const RtcEventRtcpPacketIncoming&>(event)
+                 .packet_.size();
+    case RtcEvent::Type::RtcpPacketOutgoing:
+      return sizeof(RtcEventRtcpPacketOutgoing) +
+             static_cast<const RtcEventRtcpPacketOutgoing&>(event)
+                 .packet_.size();
+    default:
+      return event.IsConfigEvent() ? kConfigEventSizeBytes : kEventSizeBytes;
+  }
+}
 
 // TODO(eladalon): This class exists because C++11 doesn't allow transferring a
 // unique_ptr to a lambda (a copy constructor is required). We should get
@@ -65,6 +100,8 @@ std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
   switch (type) {
     case RtcEventLog::EncodingType::Legacy:
       return absl::make_unique<RtcEventLogEncoderLegacy>();
+    case RtcEventLog::EncodingType::NewFormat:
+      return absl::make_unique<RtcEventLogEncoderNewFormat>();
     default:
       RTC_LOG(LS_ERROR) << "Unknown RtcEventLog encoder type (" << int(type)
                         << ")";
@@ -89,6 +126,8 @@ class RtcEventLogImpl final : public RtcEventLog {
   void Log(std::unique_ptr<RtcEvent> event) override;
 
  private:
+  // Moves the events queued by |Log| into the history.
+  void LogPendingEventsToMemory() RTC_RUN_ON(task_queue_);
   void LogToMemory(std::unique_ptr<RtcEvent> event) RTC_RUN_ON(task_queue_);
   void LogEventsFromMemoryToOutput() RTC_RUN_ON(task_queue_);
 
@@ -107,12 +146,23 @@ class RtcEventLogImpl final : public RtcEventLog {
   // as started/stopped - from the same thread/task-queue.
   rtc::SequencedTaskChecker owner_sequence_checker_;
 
+  // Events are handed over to the |task_queue_| in batches; a task is only
+  // posted when the first event is added to an empty |pending_events_|.
+  rtc::CriticalSection pending_events_lock_;
+  std::vector<std::unique_ptr<RtcEvent>> pending_events_
+      RTC_GUARDED_BY(pending_events_lock_);
+  // Swapped with |pending_events_|, so that both keep their capacity.
+  std::vector<std::unique_ptr<RtcEvent>> events_to_log_
+      RTC_GUARDED_BY(*task_queue_);
+
   // History containing all past configuration events.
   std::deque<std::unique_ptr<RtcEvent>> config_history_
       RTC_GUARDED_BY(*task_queue_);
+  size_t config_history_size_bytes_ RTC_GUARDED_BY(*task_queue_);
 
   // History containing the most recent (non-configuration) events (~10s).
   std::deque<std::unique_ptr<RtcEvent>> history_ RTC_GUARDED_BY(*task_queue_);
+  size_t history_size_bytes_ RTC_GUARDED_BY(*task_queue_);
 
   size_t max_size_bytes_ RTC_GUARDED_BY(*task_queue_);
   size_t written_bytes_ RTC_GUARDED_BY(*task_queue_);
@@ -138,7 +188,9 @@ class RtcEventLogImpl final : public RtcEventLog {
 RtcEventLogImpl::RtcEventLogImpl(
     std::unique_ptr<RtcEventLogEncoder> event_encoder,
     std::unique_ptr<rtc::TaskQueue> task_queue)
-    : max_size_bytes_(std::numeric_limits<decltype(max_size_bytes_)>::max()),
+    : config_history_size_bytes_(0),
+      history_size_bytes_(0),
+      max_size_bytes_(std::numeric_limits<decltype(max_size_bytes_)>::max()),
       written_bytes_(0),
       event_encoder_(std::move(event_encoder)),
       num_config_events_written_(0),
@@ -218,27 +270,37 @@ void RtcEventLogImpl::StopLogging() {
 void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
   RTC_CHECK(event);
 
+  bool post_task;
+  {
+    rtc::CritScope lock(&pending_events_lock_);
+    post_task = pending_events_.empty();
+    pending_events_.push_back(std::move(event));
+  }
+  if (!post_task)
+    return;
+
   // Binding to |this| is safe because |this| outlives the |task_queue_|.
-  auto event_handler = [this](std::unique_ptr<RtcEvent> unencoded_event) {
+  task_queue_->PostTask([this]() {
     RTC_DCHECK_RUN_ON(task_queue_.get());
-    LogToMemory(std::move(unencoded_event));
+    LogPendingEventsToMemory();
     if (event_output_)
       ScheduleOutput();
-  };
+  });
+}
 
-  task_queue_->PostTask(absl::make_unique<ResourceOwningTask<RtcEvent>>(
-      std::move(event), event_handler));
+void RtcEventLogImpl::LogPendingEventsToMemory() {
+  RTC_DCHECK(events_to_log_.empty());
+  {
+    rtc::CritScope lock(&pending_events_lock_);
+    events_to_log_.swap(pending_events_);
+  }
+  for (auto& event : events_to_log_)
+    LogToMemory(std::move(event));
+  events_to_log_.clear();
 }
 
 void RtcEventLogImpl::ScheduleOutput() {
   RTC_DCHECK(event_output_ && event_output_->IsActive());
-  if (history_.size() >= kMaxEventsInHistory) {
-    // We have to emergency drain the buffer. We can't wait for the scheduled
-    // output task because there might be other event incoming before that.
-    LogEventsFromMemoryToOutput();
-    return;
-  }
-
   if (output_period_ms_ == kImmediateOutput) {
     // We are already on the |task_queue_| so there is no reason to post a task
     // if we want to output immediately.
@@ -266,15 +328,30 @@ void RtcEventLogImpl::ScheduleOutput() {
 }
 
 void RtcEventLogImpl::LogToMemory(std::unique_ptr<RtcEvent> event) {
+  const size_t event_size_bytes = EstimateSizeBytes(*event);
+  if (!event->IsConfigEvent() && event_output_ &&
+      history_size_bytes_ + event_size_bytes > kMaxHistorySizeBytes) {
+    // We have to emergency drain the buffer. We can't wait for the scheduled
+    // output task because there might be other event incoming before that.
+    LogEventsFromMemoryToOutput();
+  }
+
   std::deque<std::unique_ptr<RtcEvent>>& container =
       event->IsConfigEvent() ? config_history_ : history_;
-  const size_t container_max_size =
-      event->IsConfigEvent() ? kMaxEventsInConfigHistory : kMaxEventsInHistory;
-
-  if (container.size() >= container_max_size) {
+  size_t& container_size_bytes = event->IsConfigEvent()
+                                     ? config_history_size_bytes_
+                                     : history_size_bytes_;
+  const size_t container_max_size_bytes = event->IsConfigEvent()
+                                              ? kMaxConfigHistorySizeBytes
+                                              : kMaxHistorySizeBytes;
+
+  while (!container.empty() &&
+         container_size_bytes + event_size_bytes > container_max_size_bytes) {
     RTC_DCHECK(!event_output_);  // Shouldn't lose events if we have an output.
+    container_size_bytes -= EstimateSizeBytes(*container.front());
     container.pop_front();
   }
+  container_size_bytes += event_size_bytes;
   container.push_back(std::move(event));
 }
 
@@ -305,6 +382,7 @@ void RtcEventLogImpl::LogEventsFromMemoryToOutput() {
   std::string encoded_history =
       event_encoder_->EncodeBatch(history_.begin(), history_.end());
   history_.clear();
+  history_size_bytes_ = 0;
 
   WriteConfigsAndHistoryToOutput(encoded_configs, encoded_history);
 }
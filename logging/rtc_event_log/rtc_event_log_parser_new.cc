@@ -16,16 +16,22 @@
 #include <algorithm>
 #include <fstream>
 #include <istream>  // no-presubmit-check TODO(webrtc:8982)
+#include <iterator>
 #include <limits>
 #include <map>
 #include <utility>
 
 #include "absl/memory/memory.h"
+#include "absl/types/optional.h"
 #include "api/rtp_headers.h"
 #include "api/rtpparameters.h"
+#include "logging/rtc_event_log/encoder/blob_encoding.h"
+#include "logging/rtc_event_log/encoder/delta_encoding.h"
 #include "logging/rtc_event_log/rtc_event_log.h"
+#include "logging/rtc_event_log/rtc_event_log_reader.h"
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor.h"
 #include "modules/remote_bitrate_estimator/include/bwe_defines.h"
+#include "modules/rtp_rtcp/include/rtp_cvo.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -34,6 +40,15 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/protobuf_utils.h"
 
+// *.pb.h files are generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/logging/rtc_event_log/rtc_event_log2.pb.h"
+#else
+#include "logging/rtc_event_log/rtc_event_log2.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
 namespace webrtc {
 
 namespace {
@@ -235,28 +250,6 @@ webrtc::RtpHeaderExtensionMap GetDefaultHeaderExtensionMap() {
   return default_map;
 }
 
-std::pair<uint64_t, bool> ParseVarInt(
-    std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
-  uint64_t varint = 0;
-  for (size_t bytes_read = 0; bytes_read < 10; ++bytes_read) {
-    // The most significant bit of each byte is 0 if it is the last byte in
-    // the varint and 1 otherwise. Thus, we take the 7 least significant bits
-    // of each byte and shift them 7 bits for each byte read previously to get
-    // the (unsigned) integer.
-    int byte = stream.get();
-    if (stream.eof()) {
-      return std::make_pair(varint, false);
-    }
-    RTC_DCHECK_GE(byte, 0);
-    RTC_DCHECK_LE(byte, 255);
-    varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * bytes_read);
-    if ((byte & 0x80) == 0) {
-      return std::make_pair(varint, true);
-    }
-  }
-  return std::make_pair(varint, false);
-}
-
 void GetHeaderExtensions(std::vector<RtpExtension>* header_extensions,
                          const RepeatedPtrField<rtclog::RtpHeaderExtension>&
                              proto_header_extensions) {
@@ -270,6 +263,576 @@ void GetHeaderExtensions(std::vector<RtpExtension>* header_extensions,
   }
 }
 
+
+// The new format.
+
+BandwidthUsage GetRuntimeDetectorState(
+    rtclog2::DelayBasedBweUpdates::DetectorState detector_state) {
+  switch (detector_state) {
+    case rtclog2::DelayBasedBweUpdates::BWE_NORMAL:
+      return BandwidthUsage::kBwNormal;
+    case rtclog2::DelayBasedBweUpdates::BWE_UNDERUSING:
+      return BandwidthUsage::kBwUnderusing;
+    case rtclog2::DelayBasedBweUpdates::BWE_OVERUSING:
+      return BandwidthUsage::kBwOverusing;
+  }
+  RTC_NOTREACHED();
+  return BandwidthUsage::kBwNormal;
+}
+
+bool GetRuntimeProbeFailureReason(
+    rtclog2::BweProbeResultFailure::FailureReason failure,
+    ProbeFailureReason* failure_reason) {
+  switch (failure) {
+    case rtclog2::BweProbeResultFailure::INVALID_SEND_RECEIVE_INTERVAL:
+      *failure_reason = ProbeFailureReason::kInvalidSendReceiveInterval;
+      return true;
+    case rtclog2::BweProbeResultFailure::INVALID_SEND_RECEIVE_RATIO:
+      *failure_reason = ProbeFailureReason::kInvalidSendReceiveRatio;
+      return true;
+    case rtclog2::BweProbeResultFailure::TIMEOUT:
+      *failure_reason = ProbeFailureReason::kTimeout;
+      return true;
+    case rtclog2::BweProbeResultFailure::UNKNOWN:
+      return false;
+  }
+  RTC_NOTREACHED();
+  return false;
+}
+
+RtcpMode GetRuntimeRtcpMode(
+    rtclog2::VideoRecvStreamConfig::RtcpMode rtcp_mode) {
+  switch (rtcp_mode) {
+    case rtclog2::VideoRecvStreamConfig::RTCP_COMPOUND:
+      return RtcpMode::kCompound;
+    case rtclog2::VideoRecvStreamConfig::RTCP_REDUCEDSIZE:
+      return RtcpMode::kReducedSize;
+  }
+  RTC_NOTREACHED();
+  return RtcpMode::kOff;
+}
+
+IceCandidatePairConfigType GetRuntimeIceCandidatePairConfigType(
+    rtclog2::IceCandidatePairConfig::IceCandidatePairConfigType type) {
+  switch (type) {
+    case rtclog2::IceCandidatePairConfig::ADDED:
+      return IceCandidatePairConfigType::kAdded;
+    case rtclog2::IceCandidatePairConfig::UPDATED:
+      return IceCandidatePairConfigType::kUpdated;
+    case rtclog2::IceCandidatePairConfig::DESTROYED:
+      return IceCandidatePairConfigType::kDestroyed;
+    case rtclog2::IceCandidatePairConfig::SELECTED:
+      return IceCandidatePairConfigType::kSelected;
+  }
+  RTC_NOTREACHED();
+  return IceCandidatePairConfigType::kAdded;
+}
+
+IceCandidateType GetRuntimeIceCandidateType(
+    rtclog2::IceCandidatePairConfig::IceCandidateType type) {
+  switch (type) {
+    case rtclog2::IceCandidatePairConfig::LOCAL:
+      return IceCandidateType::kLocal;
+    case rtclog2::IceCandidatePairConfig::STUN:
+      return IceCandidateType::kStun;
+    case rtclog2::IceCandidatePairConfig::PRFLX:
+      return IceCandidateType::kPrflx;
+    case rtclog2::IceCandidatePairConfig::RELAY:
+      return IceCandidateType::kRelay;
+    case rtclog2::IceCandidatePairConfig::UNKNOWN_CANDIDATE_TYPE:
+      return IceCandidateType::kUnknown;
+  }
+  RTC_NOTREACHED();
+  return IceCandidateType::kUnknown;
+}
+
+IceCandidatePairProtocol GetRuntimeIceCandidatePairProtocol(
+    rtclog2::IceCandidatePairConfig::Protocol protocol) {
+  switch (protocol) {
+    case rtclog2::IceCandidatePairConfig::UDP:
+      return IceCandidatePairProtocol::kUdp;
+    case rtclog2::IceCandidatePairConfig::TCP:
+      return IceCandidatePairProtocol::kTcp;
+    case rtclog2::IceCandidatePairConfig::SSLTCP:
+      return IceCandidatePairProtocol::kSsltcp;
+    case rtclog2::IceCandidatePairConfig::TLS:
+      return IceCandidatePairProtocol::kTls;
+    case rtclog2::IceCandidatePairConfig::UNKNOWN_PROTOCOL:
+      return IceCandidatePairProtocol::kUnknown;
+  }
+  RTC_NOTREACHED();
+  return IceCandidatePairProtocol::kUnknown;
+}
+
+IceCandidatePairAddressFamily GetRuntimeIceCandidatePairAddressFamily(
+    rtclog2::IceCandidatePairConfig::AddressFamily address_family) {
+  switch (address_family) {
+    case rtclog2::IceCandidatePairConfig::IPV4:
+      return IceCandidatePairAddressFamily::kIpv4;
+    case rtclog2::IceCandidatePairConfig::IPV6:
+      return IceCandidatePairAddressFamily::kIpv6;
+    case rtclog2::IceCandidatePairConfig::UNKNOWN_ADDRESS_FAMILY:
+      return IceCandidatePairAddressFamily::kUnknown;
+  }
+  RTC_NOTREACHED();
+  return IceCandidatePairAddressFamily::kUnknown;
+}
+
+IceCandidateNetworkType GetRuntimeIceCandidateNetworkType(
+    rtclog2::IceCandidatePairConfig::NetworkType network_type) {
+  switch (network_type) {
+    case rtclog2::IceCandidatePairConfig::ETHERNET:
+      return IceCandidateNetworkType::kEthernet;
+    case rtclog2::IceCandidatePairConfig::LOOPBACK:
+      return IceCandidateNetworkType::kLoopback;
+    case rtclog2::IceCandidatePairConfig::WIFI:
+      return IceCandidateNetworkType::kWifi;
+    case rtclog2::IceCandidatePairConfig::VPN:
+      return IceCandidateNetworkType::kVpn;
+    case rtclog2::IceCandidatePairConfig::CELLULAR:
+      return IceCandidateNetworkType::kCellular;
+    case rtclog2::IceCandidatePairConfig::UNKNOWN_NETWORK_TYPE:
+      return IceCandidateNetworkType::kUnknown;
+  }
+  RTC_NOTREACHED();
+  return IceCandidateNetworkType::kUnknown;
+}
+
+IceCandidatePairEventType GetRuntimeIceCandidatePairEventType(
+    rtclog2::IceCandidatePairEvent::IceCandidatePairEventType type) {
+  switch (type) {
+    case rtclog2::IceCandidatePairEvent::CHECK_SENT:
+      return IceCandidatePairEventType::kCheckSent;
+    case rtclog2::IceCandidatePairEvent::CHECK_RECEIVED:
+      return IceCandidatePairEventType::kCheckReceived;
+    case rtclog2::IceCandidatePairEvent::CHECK_RESPONSE_SENT:
+      return IceCandidatePairEventType::kCheckResponseSent;
+    case rtclog2::IceCandidatePairEvent::CHECK_RESPONSE_RECEIVED:
+      return IceCandidatePairEventType::kCheckResponseReceived;
+  }
+  RTC_NOTREACHED();
+  return IceCandidatePairEventType::kCheckSent;
+}
+
+int64_t ToMicroseconds(uint64_t timestamp_ms) {
+  return static_cast<int64_t>(timestamp_ms) * 1000;
+}
+
+float FloatFromBits(uint64_t bits) {
+  const uint32_t float_bits = static_cast<uint32_t>(bits);
+  float value;
+  memcpy(&value, &float_bits, sizeof(value));
+  return value;
+}
+
+// Converts a field of the first event of a batch to the type of the values
+// that are delta encoded after it. Signed values are sign extended, like the
+// encoder does.
+template <typename T>
+absl::optional<uint64_t> BaseValue(bool has_value, T value) {
+  if (!has_value)
+    return absl::nullopt;
+  return static_cast<uint64_t>(value);
+}
+
+// The values of one field of all the events of a batch.
+using Column = std::vector<absl::optional<uint64_t>>;
+
+// Returns |base| followed by the |number_of_deltas| values encoded in
+// |deltas|, or an empty column if |deltas| is malformed.
+Column DecodeColumn(absl::optional<uint64_t> base,
+                    const std::string& deltas,
+                    size_t number_of_deltas) {
+  Column values = DecodeDeltas(deltas, base, number_of_deltas);
+  if (values.size() != number_of_deltas)
+    return Column();
+  values.insert(values.begin(), base);
+  return values;
+}
+
+bool HasAllValues(const Column& column, size_t number_of_events) {
+  if (column.size() != number_of_events)
+    return false;
+  for (const absl::optional<uint64_t>& value : column) {
+    if (!value)
+      return false;
+  }
+  return true;
+}
+
+template <typename ProtoType, typename LoggedType>
+bool DecodeRtpPackets(
+    const ProtoType& proto,
+    std::map<uint32_t, std::vector<LoggedType>>* packets_by_ssrc) {
+  if (!proto.has_timestamp_ms() || !proto.has_marker() ||
+      !proto.has_payload_type() || !proto.has_sequence_number() ||
+      !proto.has_rtp_timestamp() || !proto.has_ssrc() ||
+      !proto.has_packet_size() || !proto.has_header_size() ||
+      !proto.has_padding_size()) {
+    return false;
+  }
+  const size_t number_of_deltas = proto.number_of_deltas();
+  const size_t number_of_packets = number_of_deltas + 1;
+
+  const Column timestamp_ms =
+      DecodeColumn(BaseValue(true, proto.timestamp_ms()),
+                   proto.timestamp_deltas_ms(), number_of_deltas);
+  const Column marker = DecodeColumn(BaseValue(true, proto.marker()),
+                                     proto.marker_deltas(), number_of_deltas);
+  const Column payload_type =
+      DecodeColumn(BaseValue(true, proto.payload_type()),
+                   proto.payload_type_deltas(), number_of_deltas);
+  const Column sequence_number =
+      DecodeColumn(BaseValue(true, proto.sequence_number()),
+                   proto.sequence_number_deltas(), number_of_deltas);
+  const Column rtp_timestamp =
+      DecodeColumn(BaseValue(true, proto.rtp_timestamp()),
+                   proto.rtp_timestamp_deltas(), number_of_deltas);
+  const Column ssrc = DecodeColumn(BaseValue(true, proto.ssrc()),
+                                   proto.ssrc_deltas(), number_of_deltas);
+  const Column packet_size =
+      DecodeColumn(BaseValue(true, proto.packet_size()),
+                   proto.packet_size_deltas(), number_of_deltas);
+  const Column header_size =
+      DecodeColumn(BaseValue(true, proto.header_size()),
+                   proto.header_size_deltas(), number_of_deltas);
+  const Column padding_size =
+      DecodeColumn(BaseValue(true, proto.padding_size()),
+                   proto.padding_size_deltas(), number_of_deltas);
+  for (const Column* column :
+       {&timestamp_ms, &marker, &payload_type, &sequence_number,
+        &rtp_timestamp, &ssrc, &packet_size, &header_size, &padding_size}) {
+    if (!HasAllValues(*column, number_of_packets))
+      return false;
+  }
+
+  const Column transmission_time_offset = DecodeColumn(
+      BaseValue(proto.has_transmission_time_offset(),
+                proto.transmission_time_offset()),
+      proto.transmission_time_offset_deltas(), number_of_deltas);
+  const Column absolute_send_time = DecodeColumn(
+      BaseValue(proto.has_absolute_send_time(), proto.absolute_send_time()),
+      proto.absolute_send_time_deltas(), number_of_deltas);
+  const Column transport_sequence_number =
+      DecodeColumn(BaseValue(proto.has_transport_sequence_number(),
+                             proto.transport_sequence_number()),
+                   proto.transport_sequence_number_deltas(), number_of_deltas);
+  const Column audio_level = DecodeColumn(
+      BaseValue(proto.has_audio_level(), proto.audio_level()),
+      proto.audio_level_deltas(), number_of_deltas);
+  const Column video_rotation = DecodeColumn(
+      BaseValue(proto.has_video_rotation(), proto.video_rotation()),
+      proto.video_rotation_deltas(), number_of_deltas);
+  for (const Column* column :
+       {&transmission_time_offset, &absolute_send_time,
+        &transport_sequence_number, &audio_level, &video_rotation}) {
+    if (column->size() != number_of_packets)
+      return false;
+  }
+
+  // The CSRCs of the packets after the first are left out if there are none.
+  std::vector<std::string> csrcs_blobs(number_of_deltas);
+  if (number_of_deltas > 0 && proto.has_csrcs_blobs()) {
+    csrcs_blobs = DecodeBlobs(proto.csrcs_blobs(), number_of_deltas);
+    if (csrcs_blobs.size() != number_of_deltas)
+      return false;
+  }
+
+  for (size_t i = 0; i < number_of_packets; ++i) {
+    RTPHeader header;
+    header.markerBit = *marker[i] != 0;
+    header.payloadType = static_cast<uint8_t>(*payload_type[i]);
+    header.sequenceNumber = static_cast<uint16_t>(*sequence_number[i]);
+    header.timestamp = static_cast<uint32_t>(*rtp_timestamp[i]);
+    header.ssrc = static_cast<uint32_t>(*ssrc[i]);
+    if (i == 0) {
+      if (proto.csrcs_size() > kRtpCsrcSize)
+        return false;
+      header.numCSRCs = proto.csrcs_size();
+      for (int j = 0; j < proto.csrcs_size(); ++j)
+        header.arrOfCSRCs[j] = proto.csrcs(j);
+    } else {
+      const std::string& csrcs = csrcs_blobs[i - 1];
+      if (csrcs.size() % 4 != 0 || csrcs.size() / 4 > kRtpCsrcSize)
+        return false;
+      header.numCSRCs = csrcs.size() / 4;
+      for (size_t j = 0; j < header.numCSRCs; ++j) {
+        header.arrOfCSRCs[j] = ByteReader<uint32_t>::ReadBigEndian(
+            reinterpret_cast<const uint8_t*>(&csrcs[4 * j]));
+      }
+    }
+    header.paddingLength = *padding_size[i];
+    header.headerLength = *header_size[i];
+
+    RTPHeaderExtension& extension = header.extension;
+    if (transmission_time_offset[i]) {
+      extension.hasTransmissionTimeOffset = true;
+      extension.transmissionTimeOffset =
+          static_cast<int32_t>(*transmission_time_offset[i]);
+    }
+    if (absolute_send_time[i]) {
+      extension.hasAbsoluteSendTime = true;
+      extension.absoluteSendTime =
+          static_cast<uint32_t>(*absolute_send_time[i]);
+    }
+    if (transport_sequence_number[i]) {
+      extension.hasTransportSequenceNumber = true;
+      extension.transportSequenceNumber =
+          static_cast<uint16_t>(*transport_sequence_number[i]);
+    }
+    if (audio_level[i]) {
+      // The voice activity flag is stored in the most significant bit.
+      extension.hasAudioLevel = true;
+      extension.voiceActivity = (*audio_level[i] & 0x80) != 0;
+      extension.audioLevel = *audio_level[i] & 0x7f;
+    }
+    if (video_rotation[i]) {
+      extension.hasVideoRotation = true;
+      extension.videoRotation = ConvertCVOByteToVideoRotation(
+          static_cast<uint8_t>(*video_rotation[i]));
+    }
+
+    (*packets_by_ssrc)[header.ssrc].emplace_back(
+        ToMicroseconds(*timestamp_ms[i]), header, header.headerLength,
+        *packet_size[i]);
+  }
+  return true;
+}
+
+// Decodes the timestamps and the raw packets of a batch of RTCP packets.
+template <typename ProtoType>
+bool DecodeRtcpPackets(
+    const ProtoType& proto,
+    std::vector<std::pair<int64_t, std::string>>* packets) {
+  if (!proto.has_timestamp_ms() || !proto.has_raw_packet())
+    return false;
+  const size_t number_of_deltas = proto.number_of_deltas();
+  const Column timestamp_ms =
+      DecodeColumn(BaseValue(true, proto.timestamp_ms()),
+                   proto.timestamp_deltas_ms(), number_of_deltas);
+  std::vector<std::string> raw_packets;
+  if (number_of_deltas > 0) {
+    raw_packets = DecodeBlobs(proto.raw_packet_blobs(), number_of_deltas);
+    if (raw_packets.size() != number_of_deltas)
+      return false;
+  }
+  raw_packets.insert(raw_packets.begin(), proto.raw_packet());
+  if (!HasAllValues(timestamp_ms, raw_packets.size()))
+    return false;
+
+  for (size_t i = 0; i < raw_packets.size(); ++i) {
+    packets->emplace_back(ToMicroseconds(*timestamp_ms[i]),
+                          std::move(raw_packets[i]));
+  }
+  return true;
+}
+
+bool DecodeAudioPlayoutEvents(
+    const rtclog2::AudioPlayoutEvents& proto,
+    std::map<uint32_t, std::vector<LoggedAudioPlayoutEvent>>* events) {
+  if (!proto.has_timestamp_ms() || !proto.has_local_ssrc())
+    return false;
+  const size_t number_of_deltas = proto.number_of_deltas();
+  const Column timestamp_ms =
+      DecodeColumn(BaseValue(true, proto.timestamp_ms()),
+                   proto.timestamp_deltas_ms(), number_of_deltas);
+  const Column local_ssrc =
+      DecodeColumn(BaseValue(true, proto.local_ssrc()),
+                   proto.local_ssrc_deltas(), number_of_deltas);
+  if (!HasAllValues(timestamp_ms, number_of_deltas + 1) ||
+      !HasAllValues(local_ssrc, number_of_deltas + 1)) {
+    return false;
+  }
+
+  for (size_t i = 0; i <= number_of_deltas; ++i) {
+    LoggedAudioPlayoutEvent event;
+    event.timestamp_us = ToMicroseconds(*timestamp_ms[i]);
+    event.ssrc = static_cast<uint32_t>(*local_ssrc[i]);
+    (*events)[event.ssrc].push_back(event);
+  }
+  return true;
+}
+
+bool DecodeLossBasedBweUpdates(const rtclog2::LossBasedBweUpdates& proto,
+                               std::vector<LoggedBweLossBasedUpdate>* events) {
+  if (!proto.has_timestamp_ms() || !proto.has_bitrate_bps() ||
+      !proto.has_fraction_loss() || !proto.has_total_packets()) {
+    return false;
+  }
+  const size_t number_of_deltas = proto.number_of_deltas();
+  const Column timestamp_ms =
+      DecodeColumn(BaseValue(true, proto.timestamp_ms()),
+                   proto.timestamp_deltas_ms(), number_of_deltas);
+  const Column bitrate_bps =
+      DecodeColumn(BaseValue(true, proto.bitrate_bps()),
+                   proto.bitrate_deltas_bps(), number_of_deltas);
+  const Column fraction_loss =
+      DecodeColumn(BaseValue(true, proto.fraction_loss()),
+                   proto.fraction_loss_deltas(), number_of_deltas);
+  const Column total_packets =
+      DecodeColumn(BaseValue(true, proto.total_packets()),
+                   proto.total_packets_deltas(), number_of_deltas);
+  for (const Column* column :
+       {&timestamp_ms, &bitrate_bps, &fraction_loss, &total_packets}) {
+    if (!HasAllValues(*column, number_of_deltas + 1))
+      return false;
+  }
+
+  for (size_t i = 0; i <= number_of_deltas; ++i) {
+    LoggedBweLossBasedUpdate event;
+    event.timestamp_us = ToMicroseconds(*timestamp_ms[i]);
+    event.bitrate_bps = static_cast<int32_t>(*bitrate_bps[i]);
+    event.fraction_lost = static_cast<uint8_t>(*fraction_loss[i]);
+    event.expected_packets = static_cast<int32_t>(*total_packets[i]);
+    events->push_back(event);
+  }
+  return true;
+}
+
+bool DecodeDelayBasedBweUpdates(
+    const rtclog2::DelayBasedBweUpdates& proto,
+    std::vector<LoggedBweDelayBasedUpdate>* events) {
+  if (!proto.has_timestamp_ms() || !proto.has_bitrate_bps() ||
+      !proto.has_detector_state()) {
+    return false;
+  }
+  const size_t number_of_deltas = proto.number_of_deltas();
+  const Column timestamp_ms =
+      DecodeColumn(BaseValue(true, proto.timestamp_ms()),
+                   proto.timestamp_deltas_ms(), number_of_deltas);
+  const Column bitrate_bps =
+      DecodeColumn(BaseValue(true, proto.bitrate_bps()),
+                   proto.bitrate_deltas_bps(), number_of_deltas);
+  const Column detector_state =
+      DecodeColumn(BaseValue(true, proto.detector_state()),
+                   proto.detector_state_deltas(), number_of_deltas);
+  for (const Column* column : {&timestamp_ms, &bitrate_bps, &detector_state}) {
+    if (!HasAllValues(*column, number_of_deltas + 1))
+      return false;
+  }
+
+  for (size_t i = 0; i <= number_of_deltas; ++i) {
+    const int state = static_cast<int>(*detector_state[i]);
+    if (*detector_state[i] > std::numeric_limits<int>::max() ||
+        !rtclog2::DelayBasedBweUpdates::DetectorState_IsValid(state)) {
+      return false;
+    }
+    LoggedBweDelayBasedUpdate event;
+    event.timestamp_us = ToMicroseconds(*timestamp_ms[i]);
+    event.bitrate_bps = static_cast<int32_t>(*bitrate_bps[i]);
+    event.detector_state = GetRuntimeDetectorState(
+        static_cast<rtclog2::DelayBasedBweUpdates::DetectorState>(state));
+    events->push_back(event);
+  }
+  return true;
+}
+
+bool DecodeAudioNetworkAdaptations(
+    const rtclog2::AudioNetworkAdaptations& proto,
+    std::vector<LoggedAudioNetworkAdaptationEvent>* events) {
+  if (!proto.has_timestamp_ms())
+    return false;
+  const size_t number_of_deltas = proto.number_of_deltas();
+  const Column timestamp_ms =
+      DecodeColumn(BaseValue(true, proto.timestamp_ms()),
+                   proto.timestamp_deltas_ms(), number_of_deltas);
+  if (!HasAllValues(timestamp_ms, number_of_deltas + 1))
+    return false;
+  // The float is delta encoded as its bit pattern.
+  uint32_t uplink_packet_loss_fraction_bits = 0;
+  const float uplink_packet_loss_fraction = proto.uplink_packet_loss_fraction();
+  memcpy(&uplink_packet_loss_fraction_bits, &uplink_packet_loss_fraction,
+         sizeof(uplink_packet_loss_fraction_bits));
+
+  const Column bitrate_bps = DecodeColumn(
+      BaseValue(proto.has_bitrate_bps(), proto.bitrate_bps()),
+      proto.bitrate_deltas_bps(), number_of_deltas);
+  const Column frame_length_ms = DecodeColumn(
+      BaseValue(proto.has_frame_length_ms(), proto.frame_length_ms()),
+      proto.frame_length_deltas_ms(), number_of_deltas);
+  const Column uplink_packet_loss_fraction_column =
+      DecodeColumn(BaseValue(proto.has_uplink_packet_loss_fraction(),
+                             uplink_packet_loss_fraction_bits),
+                   proto.uplink_packet_loss_fraction_deltas(),
+                   number_of_deltas);
+  const Column enable_fec =
+      DecodeColumn(BaseValue(proto.has_enable_fec(), proto.enable_fec()),
+                   proto.enable_fec_deltas(), number_of_deltas);
+  const Column enable_dtx =
+      DecodeColumn(BaseValue(proto.has_enable_dtx(), proto.enable_dtx()),
+                   proto.enable_dtx_deltas(), number_of_deltas);
+  const Column num_channels =
+      DecodeColumn(BaseValue(proto.has_num_channels(), proto.num_channels()),
+                   proto.num_channels_deltas(), number_of_deltas);
+  for (const Column* column :
+       {&bitrate_bps, &frame_length_ms, &uplink_packet_loss_fraction_column,
+        &enable_fec, &enable_dtx, &num_channels}) {
+    if (column->size() != number_of_deltas + 1)
+      return false;
+  }
+
+  for (size_t i = 0; i <= number_of_deltas; ++i) {
+    LoggedAudioNetworkAdaptationEvent event;
+    event.timestamp_us = ToMicroseconds(*timestamp_ms[i]);
+    if (bitrate_bps[i])
+      event.config.bitrate_bps = static_cast<int>(*bitrate_bps[i]);
+    if (frame_length_ms[i])
+      event.config.frame_length_ms = static_cast<int>(*frame_length_ms[i]);
+    if (uplink_packet_loss_fraction_column[i]) {
+      event.config.uplink_packet_loss_fraction =
+          FloatFromBits(*uplink_packet_loss_fraction_column[i]);
+    }
+    if (enable_fec[i])
+      event.config.enable_fec = *enable_fec[i] != 0;
+    if (enable_dtx[i])
+      event.config.enable_dtx = *enable_dtx[i] != 0;
+    if (num_channels[i])
+      event.config.num_channels = static_cast<size_t>(*num_channels[i]);
+    events->push_back(event);
+  }
+  return true;
+}
+
+void GetHeaderExtensions(
+    std::vector<RtpExtension>* header_extensions,
+    const rtclog2::RtpHeaderExtensionConfig& proto_header_extensions) {
+  header_extensions->clear();
+  if (proto_header_extensions.has_transmission_time_offset_id()) {
+    header_extensions->emplace_back(
+        RtpExtension::kTimestampOffsetUri,
+        proto_header_extensions.transmission_time_offset_id());
+  }
+  if (proto_header_extensions.has_absolute_send_time_id()) {
+    header_extensions->emplace_back(
+        RtpExtension::kAbsSendTimeUri,
+        proto_header_extensions.absolute_send_time_id());
+  }
+  if (proto_header_extensions.has_transport_sequence_number_id()) {
+    header_extensions->emplace_back(
+        RtpExtension::kTransportSequenceNumberUri,
+        proto_header_extensions.transport_sequence_number_id());
+  }
+  if (proto_header_extensions.has_audio_level_id()) {
+    header_extensions->emplace_back(RtpExtension::kAudioLevelUri,
+                                    proto_header_extensions.audio_level_id());
+  }
+  if (proto_header_extensions.has_video_rotation_id()) {
+    header_extensions->emplace_back(
+        RtpExtension::kVideoRotationUri,
+        proto_header_extensions.video_rotation_id());
+  }
+}
+
+template <typename ProtoType>
+void GetCodecs(std::vector<rtclog::StreamConfig::Codec>* codecs,
+               const ProtoType& proto_config) {
+  codecs->clear();
+  for (const rtclog2::Codec& codec : proto_config.codecs()) {
+    codecs->emplace_back(codec.payload_name(), codec.payload_type(),
+                         codec.rtx_payload_type());
+  }
+}
+
 }  // namespace
 
 ParsedRtcEventLogNew::ParsedRtcEventLogNew(
@@ -397,68 +960,117 @@ bool ParsedRtcEventLogNew::ParseStream(
 
 bool ParsedRtcEventLogNew::ParseStreamInternal(
     std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
-  const size_t kMaxEventSize = (1u << 16) - 1;
-  std::vector<char> tmp_buffer(kMaxEventSize);
-  uint64_t tag;
-  uint64_t message_length;
-  bool success;
-
   RTC_DCHECK(stream.good());
 
-  while (1) {
-    // Check whether we have reached end of file.
-    stream.peek();
-    if (stream.eof()) {
-      break;
-    }
-
-    // Read the next message tag. The tag number is defined as
-    // (fieldnumber << 3) | wire_type. In our case, the field number is
-    // supposed to be 1 and the wire type for an
-    // length-delimited field is 2.
-    const uint64_t kExpectedTag = (1 << 3) | 2;
-    std::tie(tag, success) = ParseVarInt(stream);
-    if (!success) {
-      RTC_LOG(LS_WARNING)
-          << "Missing field tag from beginning of protobuf event.";
-      return false;
-    } else if (tag != kExpectedTag) {
-      RTC_LOG(LS_WARNING)
-          << "Unexpected field tag at beginning of protobuf event.";
-      return false;
-    }
-
-    // Read the length field.
-    std::tie(message_length, success) = ParseVarInt(stream);
-    if (!success) {
-      RTC_LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
-      return false;
-    } else if (message_length > kMaxEventSize) {
-      RTC_LOG(LS_WARNING) << "Protobuf message length is too large.";
+  // The events of the legacy format are stored as the repeated field 1 of
+  // rtclog::EventStream. The tag number is defined as
+  // (fieldnumber << 3) | wire_type, and the wire type for a length-delimited
+  // field is 2.
+  const uint64_t kExpectedTag = (1 << 3) | 2;
+
+  // A log in the new format is a single rtclog2::EventStream, possibly
+  // serialized in several pieces, which never starts with that tag.
+  const int first_byte = stream.peek();
+  if (!stream.eof() && first_byte != kExpectedTag) {
+    std::string data((std::istreambuf_iterator<char>(stream)),
+                     std::istreambuf_iterator<char>());
+    rtclog2::EventStream event_stream;
+    if (!event_stream.ParseFromString(data)) {
+      RTC_LOG(LS_WARNING) << "Failed to parse protobuf message.";
       return false;
     }
-
-    // Read the next protobuf event to a temporary char buffer.
-    stream.read(tmp_buffer.data(), message_length);
-    if (stream.gcount() != static_cast<int>(message_length)) {
-      RTC_LOG(LS_WARNING) << "Failed to read protobuf message from file.";
+    if (!event_stream.has_version() || event_stream.version() != 2) {
+      RTC_LOG(LS_WARNING) << "Unsupported event log version.";
       return false;
     }
-
-    // Parse the protobuf event from the buffer.
-    rtclog::Event event;
-    if (!event.ParseFromArray(tmp_buffer.data(), message_length)) {
-      RTC_LOG(LS_WARNING) << "Failed to parse protobuf message.";
+    FilterNewFormatEvents(&event_stream);
+    if (!StoreParsedNewFormatEvents(event_stream)) {
+      RTC_LOG(LS_WARNING) << "Failed to parse the events of the log.";
       return false;
     }
+    return true;
+  }
 
+  RtcEventLogReader reader(&stream);
+  rtclog::Event event;
+  while (reader.ReadNextEvent(&event)) {
     StoreParsedEvent(event);
-    events_.push_back(event);
+    if (store_raw_events_)
+      events_.push_back(event);
+  }
+  return !reader.failed();
+}
+
+bool ParsedRtcEventLogNew::ShouldStore(EventType type) const {
+  switch (type) {
+    case EventType::VIDEO_RECEIVER_CONFIG_EVENT:
+    case EventType::VIDEO_SENDER_CONFIG_EVENT:
+    case EventType::AUDIO_RECEIVER_CONFIG_EVENT:
+    case EventType::AUDIO_SENDER_CONFIG_EVENT:
+    case EventType::LOG_START:
+    case EventType::LOG_END:
+      return true;
+    default:
+      return event_type_filter_.empty() || event_type_filter_.count(type) > 0;
   }
-  return true;
+}
+
+bool ParsedRtcEventLogNew::ShouldStoreSsrc(uint32_t ssrc) const {
+  return ssrc_filter_.empty() || ssrc_filter_.count(ssrc) > 0;
+}
+
+void ParsedRtcEventLogNew::FilterNewFormatEvents(
+    rtclog2::EventStream* event_stream) const {
+  if (!ShouldStore(EventType::RTP_EVENT)) {
+    event_stream->clear_incoming_rtp_packets();
+    event_stream->clear_outgoing_rtp_packets();
+  }
+  if (!ShouldStore(EventType::RTCP_EVENT)) {
+    event_stream->clear_incoming_rtcp_packets();
+    event_stream->clear_outgoing_rtcp_packets();
+  }
+  if (!ShouldStore(EventType::AUDIO_PLAYOUT_EVENT))
+    event_stream->clear_audio_playout_events();
+  if (!ShouldStore(EventType::LOSS_BASED_BWE_UPDATE))
+    event_stream->clear_loss_based_bwe_updates();
+  if (!ShouldStore(EventType::DELAY_BASED_BWE_UPDATE))
+    event_stream->clear_delay_based_bwe_updates();
+  if (!ShouldStore(EventType::AUDIO_NETWORK_ADAPTATION_EVENT))
+    event_stream->clear_audio_network_adaptations();
+  if (!ShouldStore(EventType::BWE_PROBE_CLUSTER_CREATED_EVENT))
+    event_stream->clear_probe_clusters();
+  if (!ShouldStore(EventType::BWE_PROBE_SUCCESS_EVENT))
+    event_stream->clear_probe_success();
+  if (!ShouldStore(EventType::BWE_PROBE_FAILURE_EVENT))
+    event_stream->clear_probe_failure();
+  if (!ShouldStore(EventType::ALR_STATE_EVENT))
+    event_stream->clear_alr_states();
+  if (!ShouldStore(EventType::ICE_CANDIDATE_PAIR_CONFIG))
+    event_stream->clear_ice_candidate_configs();
+  if (!ShouldStore(EventType::ICE_CANDIDATE_PAIR_EVENT))
+    event_stream->clear_ice_candidate_events();
+
+  // Each of the RTP messages holds the packets of a single SSRC, so the
+  // messages of the other SSRCs can be dropped before they are decoded.
+  auto remove_other_ssrcs = [this](auto* packets) {
+    int kept = 0;
+    for (int i = 0; i < packets->size(); ++i) {
+      if (!packets->Get(i).has_ssrc() ||
+          ShouldStoreSsrc(packets->Get(i).ssrc())) {
+        packets->SwapElements(i, kept++);
+      }
+    }
+    packets->DeleteSubrange(kept, packets->size() - kept);
+  };
+  remove_other_ssrcs(event_stream->mutable_incoming_rtp_packets());
+  remove_other_ssrcs(event_stream->mutable_outgoing_rtp_packets());
 }
 
 void ParsedRtcEventLogNew::StoreParsedEvent(const rtclog::Event& event) {
+  const EventType type = GetEventType(event);
+  if (!ShouldStore(type))
+    return;
+
   if (event.type() != rtclog::Event::VIDEO_RECEIVER_CONFIG_EVENT &&
       event.type() != rtclog::Event::VIDEO_SENDER_CONFIG_EVENT &&
       event.type() != rtclog::Event::AUDIO_RECEIVER_CONFIG_EVENT &&
@@ -471,52 +1083,21 @@ void ParsedRtcEventLogNew::StoreParsedEvent(const rtclog::Event& event) {
     last_timestamp_ = std::max(last_timestamp_, timestamp);
   }
 
-  switch (GetEventType(event)) {
+  switch (type) {
     case ParsedRtcEventLogNew::EventType::VIDEO_RECEIVER_CONFIG_EVENT: {
-      rtclog::StreamConfig config = GetVideoReceiveConfig(event);
-      video_recv_configs_.emplace_back(GetTimestamp(event), config);
-      incoming_rtp_extensions_maps_[config.remote_ssrc] =
-          RtpHeaderExtensionMap(config.rtp_extensions);
-      // TODO(terelius): I don't understand the reason for configuring header
-      // extensions for the local SSRC. I think it should be removed, but for
-      // now I want to preserve the previous functionality.
-      incoming_rtp_extensions_maps_[config.local_ssrc] =
-          RtpHeaderExtensionMap(config.rtp_extensions);
-      incoming_video_ssrcs_.insert(config.remote_ssrc);
-      incoming_video_ssrcs_.insert(config.rtx_ssrc);
-      incoming_rtx_ssrcs_.insert(config.rtx_ssrc);
+      StoreVideoRecvConfig(GetTimestamp(event), GetVideoReceiveConfig(event));
       break;
     }
     case ParsedRtcEventLogNew::EventType::VIDEO_SENDER_CONFIG_EVENT: {
-      std::vector<rtclog::StreamConfig> configs = GetVideoSendConfig(event);
-      video_send_configs_.emplace_back(GetTimestamp(event), configs);
-      for (const auto& config : configs) {
-        outgoing_rtp_extensions_maps_[config.local_ssrc] =
-            RtpHeaderExtensionMap(config.rtp_extensions);
-        outgoing_rtp_extensions_maps_[config.rtx_ssrc] =
-            RtpHeaderExtensionMap(config.rtp_extensions);
-        outgoing_video_ssrcs_.insert(config.local_ssrc);
-        outgoing_video_ssrcs_.insert(config.rtx_ssrc);
-        outgoing_rtx_ssrcs_.insert(config.rtx_ssrc);
-      }
+      StoreVideoSendConfig(GetTimestamp(event), GetVideoSendConfig(event));
       break;
     }
     case ParsedRtcEventLogNew::EventType::AUDIO_RECEIVER_CONFIG_EVENT: {
-      rtclog::StreamConfig config = GetAudioReceiveConfig(event);
-      audio_recv_configs_.emplace_back(GetTimestamp(event), config);
-      incoming_rtp_extensions_maps_[config.remote_ssrc] =
-          RtpHeaderExtensionMap(config.rtp_extensions);
-      incoming_rtp_extensions_maps_[config.local_ssrc] =
-          RtpHeaderExtensionMap(config.rtp_extensions);
-      incoming_audio_ssrcs_.insert(config.remote_ssrc);
+      StoreAudioRecvConfig(GetTimestamp(event), GetAudioReceiveConfig(event));
       break;
     }
     case ParsedRtcEventLogNew::EventType::AUDIO_SENDER_CONFIG_EVENT: {
-      rtclog::StreamConfig config = GetAudioSendConfig(event);
-      audio_send_configs_.emplace_back(GetTimestamp(event), config);
-      outgoing_rtp_extensions_maps_[config.local_ssrc] =
-          RtpHeaderExtensionMap(config.rtp_extensions);
-      outgoing_audio_ssrcs_.insert(config.local_ssrc);
+      StoreAudioSendConfig(GetTimestamp(event), GetAudioSendConfig(event));
       break;
     }
     case ParsedRtcEventLogNew::EventType::RTP_EVENT: {
@@ -539,6 +1120,8 @@ void ParsedRtcEventLogNew::StoreParsedEvent(const rtclog::Event& event) {
         //             Tracking bug: webrtc:6399
         rtp_parser.Parse(&parsed_header, &default_extension_map_);
       }
+      if (!ShouldStoreSsrc(parsed_header.ssrc))
+        break;
       RTC_CHECK(event.has_timestamp_us());
       uint64_t timestamp_us = event.timestamp_us();
       if (direction == kIncomingPacket) {
@@ -557,85 +1140,8 @@ void ParsedRtcEventLogNew::StoreParsedEvent(const rtclog::Event& event) {
       uint8_t packet[IP_PACKET_SIZE];
       size_t total_length;
       GetRtcpPacket(event, &direction, packet, &total_length);
-      uint64_t timestamp_us = GetTimestamp(event);
       RTC_CHECK_LE(total_length, IP_PACKET_SIZE);
-      if (direction == kIncomingPacket) {
-        // Currently incoming RTCP packets are logged twice, both for audio and
-        // video. Only act on one of them. Compare against the previous parsed
-        // incoming RTCP packet.
-        if (total_length == last_incoming_rtcp_packet_length_ &&
-            memcmp(last_incoming_rtcp_packet_, packet, total_length) == 0)
-          break;
-        incoming_rtcp_packets_.push_back(
-            LoggedRtcpPacketIncoming(timestamp_us, packet, total_length));
-        last_incoming_rtcp_packet_length_ = total_length;
-        memcpy(last_incoming_rtcp_packet_, packet, total_length);
-      } else {
-        outgoing_rtcp_packets_.push_back(
-            LoggedRtcpPacketOutgoing(timestamp_us, packet, total_length));
-      }
-      rtcp::CommonHeader header;
-      const uint8_t* packet_end = packet + total_length;
-      for (const uint8_t* block = packet; block < packet_end;
-           block = header.NextPacket()) {
-        RTC_CHECK(header.Parse(block, packet_end - block));
-        if (header.type() == rtcp::TransportFeedback::kPacketType &&
-            header.fmt() == rtcp::TransportFeedback::kFeedbackMessageType) {
-          if (direction == kIncomingPacket) {
-            incoming_transport_feedback_.emplace_back();
-            LoggedRtcpPacketTransportFeedback& parsed_block =
-                incoming_transport_feedback_.back();
-            parsed_block.timestamp_us = GetTimestamp(event);
-            if (!parsed_block.transport_feedback.Parse(header))
-              incoming_transport_feedback_.pop_back();
-          } else {
-            outgoing_transport_feedback_.emplace_back();
-            LoggedRtcpPacketTransportFeedback& parsed_block =
-                outgoing_transport_feedback_.back();
-            parsed_block.timestamp_us = GetTimestamp(event);
-            if (!parsed_block.transport_feedback.Parse(header))
-              outgoing_transport_feedback_.pop_back();
-          }
-        } else if (header.type() == rtcp::SenderReport::kPacketType) {
-          LoggedRtcpPacketSenderReport parsed_block;
-          parsed_block.timestamp_us = GetTimestamp(event);
-          if (parsed_block.sr.Parse(header)) {
-            if (direction == kIncomingPacket)
-              incoming_sr_.push_back(std::move(parsed_block));
-            else
-              outgoing_sr_.push_back(std::move(parsed_block));
-          }
-        } else if (header.type() == rtcp::ReceiverReport::kPacketType) {
-          LoggedRtcpPacketReceiverReport parsed_block;
-          parsed_block.timestamp_us = GetTimestamp(event);
-          if (parsed_block.rr.Parse(header)) {
-            if (direction == kIncomingPacket)
-              incoming_rr_.push_back(std::move(parsed_block));
-            else
-              outgoing_rr_.push_back(std::move(parsed_block));
-          }
-        } else if (header.type() == rtcp::Remb::kPacketType &&
-                   header.fmt() == rtcp::Remb::kFeedbackMessageType) {
-          LoggedRtcpPacketRemb parsed_block;
-          parsed_block.timestamp_us = GetTimestamp(event);
-          if (parsed_block.remb.Parse(header)) {
-            if (direction == kIncomingPacket)
-              incoming_remb_.push_back(std::move(parsed_block));
-            else
-              outgoing_remb_.push_back(std::move(parsed_block));
-          }
-        } else if (header.type() == rtcp::Nack::kPacketType &&
-                   header.fmt() == rtcp::Nack::kFeedbackMessageType) {
-          LoggedRtcpPacketNack parsed_block;
-          parsed_block.timestamp_us = GetTimestamp(event);
-          if (parsed_block.nack.Parse(header)) {
-            if (direction == kIncomingPacket)
-              incoming_nack_.push_back(std::move(parsed_block));
-            else
-              outgoing_nack_.push_back(std::move(parsed_block));
-          }
-        }
-      }
+      StoreRtcpPacket(GetTimestamp(event), direction, packet, total_length);
       break;
     }
     case ParsedRtcEventLogNew::EventType::LOG_START: {
@@ -648,7 +1154,8 @@ void ParsedRtcEventLogNew::StoreParsedEvent(const rtclog::Event& event) {
     }
     case ParsedRtcEventLogNew::EventType::AUDIO_PLAYOUT_EVENT: {
       LoggedAudioPlayoutEvent playout_event = GetAudioPlayout(event);
-      audio_playout_events_[playout_event.ssrc].push_back(playout_event);
+      if (ShouldStoreSsrc(playout_event.ssrc))
+        audio_playout_events_[playout_event.ssrc].push_back(playout_event);
       break;
     }
     case ParsedRtcEventLogNew::EventType::LOSS_BASED_BWE_UPDATE: {
@@ -696,6 +1203,401 @@ void ParsedRtcEventLogNew::StoreParsedEvent(const rtclog::Event& event) {
   }
 }
 
+void ParsedRtcEventLogNew::StoreAudioRecvConfig(
+    int64_t timestamp_us,
+    const rtclog::StreamConfig& config) {
+  audio_recv_configs_.emplace_back(timestamp_us, config);
+  incoming_rtp_extensions_maps_[config.remote_ssrc] =
+      RtpHeaderExtensionMap(config.rtp_extensions);
+  incoming_rtp_extensions_maps_[config.local_ssrc] =
+      RtpHeaderExtensionMap(config.rtp_extensions);
+  incoming_audio_ssrcs_.insert(config.remote_ssrc);
+}
+
+void ParsedRtcEventLogNew::StoreAudioSendConfig(
+    int64_t timestamp_us,
+    const rtclog::StreamConfig& config) {
+  audio_send_configs_.emplace_back(timestamp_us, config);
+  outgoing_rtp_extensions_maps_[config.local_ssrc] =
+      RtpHeaderExtensionMap(config.rtp_extensions);
+  outgoing_audio_ssrcs_.insert(config.local_ssrc);
+}
+
+void ParsedRtcEventLogNew::StoreVideoRecvConfig(
+    int64_t timestamp_us,
+    const rtclog::StreamConfig& config) {
+  video_recv_configs_.emplace_back(timestamp_us, config);
+  incoming_rtp_extensions_maps_[config.remote_ssrc] =
+      RtpHeaderExtensionMap(config.rtp_extensions);
+  // TODO(terelius): I don't understand the reason for configuring header
+  // extensions for the local SSRC. I think it should be removed, but for
+  // now I want to preserve the previous functionality.
+  incoming_rtp_extensions_maps_[config.local_ssrc] =
+      RtpHeaderExtensionMap(config.rtp_extensions);
+  incoming_video_ssrcs_.insert(config.remote_ssrc);
+  incoming_video_ssrcs_.insert(config.rtx_ssrc);
+  incoming_rtx_ssrcs_.insert(config.rtx_ssrc);
+}
+
+void ParsedRtcEventLogNew::StoreVideoSendConfig(
+    int64_t timestamp_us,
+    const std::vector<rtclog::StreamConfig>& configs) {
+  video_send_configs_.emplace_back(timestamp_us, configs);
+  for (const auto& config : configs) {
+    outgoing_rtp_extensions_maps_[config.local_ssrc] =
+        RtpHeaderExtensionMap(config.rtp_extensions);
+    outgoing_rtp_extensions_maps_[config.rtx_ssrc] =
+        RtpHeaderExtensionMap(config.rtp_extensions);
+    outgoing_video_ssrcs_.insert(config.local_ssrc);
+    outgoing_video_ssrcs_.insert(config.rtx_ssrc);
+    outgoing_rtx_ssrcs_.insert(config.rtx_ssrc);
+  }
+}
+
+void ParsedRtcEventLogNew::StoreRtcpPacket(int64_t timestamp_us,
+                                           PacketDirection direction,
+                                           const uint8_t* packet,
+                                           size_t total_length) {
+  RTC_DCHECK_LE(total_length, IP_PACKET_SIZE);
+  if (direction == kIncomingPacket) {
+    // Currently incoming RTCP packets are logged twice, both for audio and
+    // video. Only act on one of them. Compare against the previous parsed
+    // incoming RTCP packet.
+    if (total_length == last_incoming_rtcp_packet_length_ &&
+        memcmp(last_incoming_rtcp_packet_, packet, total_length) == 0)
+      return;
+    incoming_rtcp_packets_.push_back(
+        LoggedRtcpPacketIncoming(timestamp_us, packet, total_length));
+    last_incoming_rtcp_packet_length_ = total_length;
+    memcpy(last_incoming_rtcp_packet_, packet, total_length);
+  } else {
+    outgoing_rtcp_packets_.push_back(
+        LoggedRtcpPacketOutgoing(timestamp_us, packet, total_length));
+  }
+  rtcp::CommonHeader header;
+  const uint8_t* packet_end = packet + total_length;
+  for (const uint8_t* block = packet; block < packet_end;
+       block = header.NextPacket()) {
+    RTC_CHECK(header.Parse(block, packet_end - block));
+    if (header.type() == rtcp::TransportFeedback::kPacketType &&
+        header.fmt() == rtcp::TransportFeedback::kFeedbackMessageType) {
+      if (direction == kIncomingPacket) {
+        incoming_transport_feedback_.emplace_back();
+        LoggedRtcpPacketTransportFeedback& parsed_block =
+            incoming_transport_feedback_.back();
+        parsed_block.timestamp_us = timestamp_us;
+        if (!parsed_block.transport_feedback.Parse(header))
+          incoming_transport_feedback_.pop_back();
+      } else {
+        outgoing_transport_feedback_.emplace_back();
+        LoggedRtcpPacketTransportFeedback& parsed_block =
+            outgoing_transport_feedback_.back();
+        parsed_block.timestamp_us = timestamp_us;
+        if (!parsed_block.transport_feedback.Parse(header))
+          outgoing_transport_feedback_.pop_back();
+      }
+    } else if (header.type() == rtcp::SenderReport::kPacketType) {
+      LoggedRtcpPacketSenderReport parsed_block;
+      parsed_block.timestamp_us = timestamp_us;
+      if (parsed_block.sr.Parse(header)) {
+        if (direction == kIncomingPacket)
+          incoming_sr_.push_back(std::move(parsed_block));
+        else
+          outgoing_sr_.push_back(std::move(parsed_block));
+      }
+    } else if (header.type() == rtcp::ReceiverReport::kPacketType) {
+      LoggedRtcpPacketReceiverReport parsed_block;
+      parsed_block.timestamp_us = timestamp_us;
+      if (parsed_block.rr.Parse(header)) {
+        if (direction == kIncomingPacket)
+          incoming_rr_.push_back(std::move(parsed_block));
+        else
+          outgoing_rr_.push_back(std::move(parsed_block));
+      }
+    } else if (header.type() == rtcp::Remb::kPacketType &&
+               header.fmt() == rtcp::Remb::kFeedbackMessageType) {
+      LoggedRtcpPacketRemb parsed_block;
+      parsed_block.timestamp_us = timestamp_us;
+      if (parsed_block.remb.Parse(header)) {
+        if (direction == kIncomingPacket)
+          incoming_remb_.push_back(std::move(parsed_block));
+        else
+          outgoing_remb_.push_back(std::move(parsed_block));
+      }
+    } else if (header.type() == rtcp::Nack::kPacketType &&
+               header.fmt() == rtcp::Nack::kFeedbackMessageType) {
+      LoggedRtcpPacketNack parsed_block;
+      parsed_block.timestamp_us = timestamp_us;
+      if (parsed_block.nack.Parse(header)) {
+        if (direction == kIncomingPacket)
+          incoming_nack_.push_back(std::move(parsed_block));
+        else
+          outgoing_nack_.push_back(std::move(parsed_block));
+      }
+    }
+  }
+}
+
+bool ParsedRtcEventLogNew::StoreParsedNewFormatEvents(
+    const rtclog2::EventStream& event_stream) {
+  // The configurations come first, although they may have been logged after
+  // some of the packets of a batch.
+  for (const rtclog2::AudioRecvStreamConfig& proto :
+       event_stream.audio_recv_stream_configs()) {
+    if (!proto.has_timestamp_ms() || !proto.has_remote_ssrc() ||
+        !proto.has_local_ssrc()) {
+      return false;
+    }
+    rtclog::StreamConfig config;
+    config.remote_ssrc = proto.remote_ssrc();
+    config.local_ssrc = proto.local_ssrc();
+    config.rsid = proto.rsid();
+    GetHeaderExtensions(&config.rtp_extensions, proto.header_extensions());
+    StoreAudioRecvConfig(ToMicroseconds(proto.timestamp_ms()), config);
+  }
+  for (const rtclog2::AudioSendStreamConfig& proto :
+       event_stream.audio_send_stream_configs()) {
+    if (!proto.has_timestamp_ms() || !proto.has_ssrc())
+      return false;
+    rtclog::StreamConfig config;
+    config.local_ssrc = proto.ssrc();
+    config.rsid = proto.rsid();
+    GetHeaderExtensions(&config.rtp_extensions, proto.header_extensions());
+    StoreAudioSendConfig(ToMicroseconds(proto.timestamp_ms()), config);
+  }
+  for (const rtclog2::VideoRecvStreamConfig& proto :
+       event_stream.video_recv_stream_configs()) {
+    if (!proto.has_timestamp_ms() || !proto.has_remote_ssrc() ||
+        !proto.has_local_ssrc()) {
+      return false;
+    }
+    rtclog::StreamConfig config;
+    config.remote_ssrc = proto.remote_ssrc();
+    config.local_ssrc = proto.local_ssrc();
+    config.rtx_ssrc = proto.rtx_ssrc();
+    config.rsid = proto.rsid();
+    config.remb = proto.remb();
+    if (proto.has_rtcp_mode())
+      config.rtcp_mode = GetRuntimeRtcpMode(proto.rtcp_mode());
+    GetHeaderExtensions(&config.rtp_extensions, proto.header_extensions());
+    GetCodecs(&config.codecs, proto);
+    StoreVideoRecvConfig(ToMicroseconds(proto.timestamp_ms()), config);
+  }
+  for (const rtclog2::VideoSendStreamConfig& proto :
+       event_stream.video_send_stream_configs()) {
+    if (!proto.has_timestamp_ms() || !proto.has_ssrc())
+      return false;
+    rtclog::StreamConfig config;
+    config.local_ssrc = proto.ssrc();
+    config.rtx_ssrc = proto.rtx_ssrc();
+    config.rsid = proto.rsid();
+    GetHeaderExtensions(&config.rtp_extensions, proto.header_extensions());
+    GetCodecs(&config.codecs, proto);
+    StoreVideoSendConfig(ToMicroseconds(proto.timestamp_ms()), {config});
+  }
+
+  for (const rtclog2::BeginLogEvent& proto : event_stream.begin_log_events()) {
+    if (!proto.has_timestamp_ms())
+      return false;
+    start_log_events_.push_back(
+        LoggedStartEvent(ToMicroseconds(proto.timestamp_ms())));
+  }
+  for (const rtclog2::EndLogEvent& proto : event_stream.end_log_events()) {
+    if (!proto.has_timestamp_ms())
+      return false;
+    stop_log_events_.push_back(
+        LoggedStopEvent(ToMicroseconds(proto.timestamp_ms())));
+  }
+
+  for (const rtclog2::IncomingRtpPackets& proto :
+       event_stream.incoming_rtp_packets()) {
+    if (!DecodeRtpPackets(proto, &incoming_rtp_packets_map_))
+      return false;
+  }
+  for (const rtclog2::OutgoingRtpPackets& proto :
+       event_stream.outgoing_rtp_packets()) {
+    if (!DecodeRtpPackets(proto, &outgoing_rtp_packets_map_))
+      return false;
+  }
+
+  std::vector<std::pair<int64_t, std::string>> rtcp_packets;
+  for (const rtclog2::IncomingRtcpPackets& proto :
+       event_stream.incoming_rtcp_packets()) {
+    rtcp_packets.clear();
+    if (!DecodeRtcpPackets(proto, &rtcp_packets))
+      return false;
+    for (const auto& packet : rtcp_packets) {
+      if (packet.second.size() > IP_PACKET_SIZE)
+        return false;
+      StoreRtcpPacket(packet.first, kIncomingPacket,
+                      reinterpret_cast<const uint8_t*>(packet.second.data()),
+                      packet.second.size());
+    }
+  }
+  for (const rtclog2::OutgoingRtcpPackets& proto :
+       event_stream.outgoing_rtcp_packets()) {
+    rtcp_packets.clear();
+    if (!DecodeRtcpPackets(proto, &rtcp_packets))
+      return false;
+    for (const auto& packet : rtcp_packets) {
+      if (packet.second.size() > IP_PACKET_SIZE)
+        return false;
+      StoreRtcpPacket(packet.first, kOutgoingPacket,
+                      reinterpret_cast<const uint8_t*>(packet.second.data()),
+                      packet.second.size());
+    }
+  }
+
+  for (const rtclog2::AudioPlayoutEvents& proto :
+       event_stream.audio_playout_events()) {
+    if (!DecodeAudioPlayoutEvents(proto, &audio_playout_events_))
+      return false;
+  }
+  // The playout events of all SSRCs are batched together.
+  for (auto it = audio_playout_events_.begin();
+       it != audio_playout_events_.end();) {
+    it = ShouldStoreSsrc(it->first) ? std::next(it)
+                                    : audio_playout_events_.erase(it);
+  }
+  for (const rtclog2::LossBasedBweUpdates& proto :
+       event_stream.loss_based_bwe_updates()) {
+    if (!DecodeLossBasedBweUpdates(proto, &bwe_loss_updates_))
+      return false;
+  }
+  for (const rtclog2::DelayBasedBweUpdates& proto :
+       event_stream.delay_based_bwe_updates()) {
+    if (!DecodeDelayBasedBweUpdates(proto, &bwe_delay_updates_))
+      return false;
+  }
+  for (const rtclog2::AudioNetworkAdaptations& proto :
+       event_stream.audio_network_adaptations()) {
+    if (!DecodeAudioNetworkAdaptations(proto,
+                                       &audio_network_adaptation_events_)) {
+      return false;
+    }
+  }
+
+  for (const rtclog2::BweProbeCluster& proto : event_stream.probe_clusters()) {
+    if (!proto.has_timestamp_ms() || !proto.has_id() ||
+        !proto.has_bitrate_bps() || !proto.has_min_packets() ||
+        !proto.has_min_bytes()) {
+      return false;
+    }
+    LoggedBweProbeClusterCreatedEvent event;
+    event.timestamp_us = ToMicroseconds(proto.timestamp_ms());
+    event.id = proto.id();
+    event.bitrate_bps = proto.bitrate_bps();
+    event.min_packets = proto.min_packets();
+    event.min_bytes = proto.min_bytes();
+    bwe_probe_cluster_created_events_.push_back(event);
+  }
+  for (const rtclog2::BweProbeResultSuccess& proto :
+       event_stream.probe_success()) {
+    if (!proto.has_timestamp_ms() || !proto.has_id() ||
+        !proto.has_bitrate_bps()) {
+      return false;
+    }
+    LoggedBweProbeSuccessEvent event;
+    event.timestamp_us = ToMicroseconds(proto.timestamp_ms());
+    event.id = proto.id();
+    event.bitrate_bps = proto.bitrate_bps();
+    bwe_probe_success_events_.push_back(event);
+  }
+  for (const rtclog2::BweProbeResultFailure& proto :
+       event_stream.probe_failure()) {
+    LoggedBweProbeFailureEvent event;
+    if (!proto.has_timestamp_ms() || !proto.has_id() ||
+        !proto.has_failure() ||
+        !GetRuntimeProbeFailureReason(proto.failure(),
+                                      &event.failure_reason)) {
+      return false;
+    }
+    event.timestamp_us = ToMicroseconds(proto.timestamp_ms());
+    event.id = proto.id();
+    bwe_probe_failure_events_.push_back(event);
+  }
+
+  for (const rtclog2::AlrState& proto : event_stream.alr_states()) {
+    if (!proto.has_timestamp_ms() || !proto.has_in_alr())
+      return false;
+    LoggedAlrStateEvent event;
+    event.timestamp_us = ToMicroseconds(proto.timestamp_ms());
+    event.in_alr = proto.in_alr();
+    alr_state_events_.push_back(event);
+  }
+
+  for (const rtclog2::IceCandidatePairConfig& proto :
+       event_stream.ice_candidate_configs()) {
+    if (!proto.has_timestamp_ms() || !proto.has_config_type() ||
+        !proto.has_candidate_pair_id() || !proto.has_local_candidate_type() ||
+        !proto.has_local_relay_protocol() || !proto.has_local_network_type() ||
+        !proto.has_local_address_family() ||
+        !proto.has_remote_candidate_type() ||
+        !proto.has_remote_address_family() ||
+        !proto.has_candidate_pair_protocol()) {
+      return false;
+    }
+    LoggedIceCandidatePairConfig event;
+    event.timestamp_us = ToMicroseconds(proto.timestamp_ms());
+    event.type = GetRuntimeIceCandidatePairConfigType(proto.config_type());
+    event.candidate_pair_id = proto.candidate_pair_id();
+    event.local_candidate_type =
+        GetRuntimeIceCandidateType(proto.local_candidate_type());
+    event.local_relay_protocol =
+        GetRuntimeIceCandidatePairProtocol(proto.local_relay_protocol());
+    event.local_network_type =
+        GetRuntimeIceCandidateNetworkType(proto.local_network_type());
+    event.local_address_family =
+        GetRuntimeIceCandidatePairAddressFamily(proto.local_address_family());
+    event.remote_candidate_type =
+        GetRuntimeIceCandidateType(proto.remote_candidate_type());
+    event.remote_address_family =
+        GetRuntimeIceCandidatePairAddressFamily(proto.remote_address_family());
+    event.candidate_pair_protocol =
+        GetRuntimeIceCandidatePairProtocol(proto.candidate_pair_protocol());
+    ice_candidate_pair_configs_.push_back(event);
+  }
+  for (const rtclog2::IceCandidatePairEvent& proto :
+       event_stream.ice_candidate_events()) {
+    if (!proto.has_timestamp_ms() || !proto.has_event_type() ||
+        !proto.has_candidate_pair_id()) {
+      return false;
+    }
+    LoggedIceCandidatePairEvent event;
+    event.timestamp_us = ToMicroseconds(proto.timestamp_ms());
+    event.type = GetRuntimeIceCandidatePairEventType(proto.event_type());
+    event.candidate_pair_id = proto.candidate_pair_id();
+    ice_candidate_pair_events_.push_back(event);
+  }
+
+  // Like for the legacy format, the configurations and the start and stop
+  // events do not count towards the first and the last timestamp.
+  auto update_timestamps = [this](const auto& events) {
+    for (const auto& event : events) {
+      first_timestamp_ = std::min(first_timestamp_, event.log_time_us());
+      last_timestamp_ = std::max(last_timestamp_, event.log_time_us());
+    }
+  };
+  for (const auto& kv : incoming_rtp_packets_map_)
+    update_timestamps(kv.second);
+  for (const auto& kv : outgoing_rtp_packets_map_)
+    update_timestamps(kv.second);
+  for (const auto& kv : audio_playout_events_)
+    update_timestamps(kv.second);
+  update_timestamps(incoming_rtcp_packets_);
+  update_timestamps(outgoing_rtcp_packets_);
+  update_timestamps(bwe_loss_updates_);
+  update_timestamps(bwe_delay_updates_);
+  update_timestamps(audio_network_adaptation_events_);
+  update_timestamps(bwe_probe_cluster_created_events_);
+  update_timestamps(bwe_probe_success_events_);
+  update_timestamps(bwe_probe_failure_events_);
+  update_timestamps(alr_state_events_);
+  update_timestamps(ice_candidate_pair_configs_);
+  update_timestamps(ice_candidate_pair_events_);
+  return true;
+}
+
 size_t ParsedRtcEventLogNew::GetNumberOfEvents() const {
   return events_.size();
 }
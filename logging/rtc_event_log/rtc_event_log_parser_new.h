@@ -45,6 +45,10 @@ RTC_POP_IGNORING_WUNDEF()
 
 namespace webrtc {
 
+namespace rtclog2 {
+class EventStream;
+}  // namespace rtclog2
+
 enum class BandwidthUsage;
 struct AudioEncoderRuntimeConfig;
 
@@ -544,9 +548,37 @@ class ParsedRtcEventLogNew {
   bool ParseString(const std::string& s);
 
   // Reads an RtcEventLog from an istream and returns true if successful.
+  // The events of a legacy format log are read one at a time, so only the
+  // stored events take up memory.
   bool ParseStream(
       std::istream& stream);  // no-presubmit-check TODO(webrtc:8982)
 
+  // The settings below apply to the following calls to the Parse* methods.
+
+  // Only stores the events of |event_types|, or all events if it is empty.
+  // The stream configs and the log start and end events are always stored,
+  // since the other events can't be interpreted without them. The first and
+  // the last timestamps only cover the stored events.
+  void SetEventTypeFilter(std::set<EventType> event_types) {
+    event_type_filter_ = std::move(event_types);
+  }
+  // Only stores the RTP packets and the audio playout events of |ssrcs|, or
+  // of all SSRCs if it is empty. RTCP packets are not filtered, since a
+  // compound packet can be about several SSRCs.
+  void SetSsrcFilter(std::set<uint32_t> ssrcs) {
+    ssrc_filter_ = std::move(ssrcs);
+  }
+  // Whether to keep a copy of each legacy event for the index based accessors
+  // below. Analyses that only use the typed accessors can turn this off,
+  // which roughly halves the memory it takes to parse a log.
+  void set_store_raw_events(bool store_raw_events) {
+    store_raw_events_ = store_raw_events;
+  }
+
+  // The accessors below read the events of the legacy format by their index.
+  // Logs in the new format only populate the typed accessors further down,
+  // so GetNumberOfEvents() returns 0 for them.
+
   // Returns the number of events in an EventStream.
   size_t GetNumberOfEvents() const;
 
@@ -835,6 +867,30 @@ class ParsedRtcEventLogNew {
 
   void StoreParsedEvent(const rtclog::Event& event);
 
+  bool ShouldStore(EventType type) const;
+  bool ShouldStoreSsrc(uint32_t ssrc) const;
+  // Drops the messages that the filters would discard before they are
+  // decoded.
+  void FilterNewFormatEvents(rtclog2::EventStream* event_stream) const;
+
+  // Stores the events of a log in the new format, returning false if it is
+  // malformed.
+  bool StoreParsedNewFormatEvents(const rtclog2::EventStream& event_stream);
+
+  // Helpers shared by the legacy and the new format.
+  void StoreAudioRecvConfig(int64_t timestamp_us,
+                            const rtclog::StreamConfig& config);
+  void StoreAudioSendConfig(int64_t timestamp_us,
+                            const rtclog::StreamConfig& config);
+  void StoreVideoRecvConfig(int64_t timestamp_us,
+                            const rtclog::StreamConfig& config);
+  void StoreVideoSendConfig(int64_t timestamp_us,
+                            const std::vector<rtclog::StreamConfig>& configs);
+  void StoreRtcpPacket(int64_t timestamp_us,
+                       PacketDirection direction,
+                       const uint8_t* packet,
+                       size_t total_length);
+
   rtclog::StreamConfig GetVideoReceiveConfig(const rtclog::Event& event) const;
   std::vector<rtclog::StreamConfig> GetVideoSendConfig(
       const rtclog::Event& event) const;
@@ -884,6 +940,10 @@ class ParsedRtcEventLogNew {
 
   const UnconfiguredHeaderExtensions parse_unconfigured_header_extensions_;
 
+  std::set<EventType> event_type_filter_;
+  std::set<uint32_t> ssrc_filter_;
+  bool store_raw_events_ = true;
+
   // Make a default extension map for streams without configuration information.
   // TODO(ivoc): Once configuration of audio streams is stored in the event log,
   //             this can be removed. Tracking bug: webrtc:6399
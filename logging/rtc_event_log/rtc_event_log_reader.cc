@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/rtc_event_log_reader.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+// The events are stored as the repeated field 1 of rtclog::EventStream. The
+// tag number is defined as (fieldnumber << 3) | wire_type, and the wire type
+// for a length-delimited field is 2.
+constexpr uint64_t kExpectedTag = (1 << 3) | 2;
+
+// Reads a varint from |stream|, adding the number of bytes it took to
+// |*bytes_read|.
+bool ParseVarInt(std::istream* stream,  // no-presubmit-check TODO(webrtc:8982)
+                 uint64_t* varint,
+                 size_t* bytes_read) {
+  *varint = 0;
+  for (size_t i = 0; i < 10; ++i) {
+    // The most significant bit of each byte is 0 if it is the last byte in
+    // the varint and 1 otherwise. Thus, we take the 7 least significant bits
+    // of each byte and shift them 7 bits for each byte read previously to get
+    // the (unsigned) integer.
+    int byte = stream->get();
+    if (stream->eof())
+      return false;
+    RTC_DCHECK_GE(byte, 0);
+    RTC_DCHECK_LE(byte, 255);
+    ++*bytes_read;
+    *varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+}  // namespace
+
+constexpr size_t RtcEventLogReader::kMaxEventSize;
+
+RtcEventLogReader::RtcEventLogReader(
+    std::istream* stream)  // no-presubmit-check TODO(webrtc:8982)
+    : stream_(stream) {
+  RTC_DCHECK(stream_);
+}
+
+RtcEventLogReader::~RtcEventLogReader() = default;
+
+bool RtcEventLogReader::ReadNextEvent(rtclog::Event* event) {
+  if (failed_)
+    return false;
+
+  // Check whether we have reached end of file.
+  stream_->peek();
+  if (stream_->eof())
+    return false;
+
+  // Read the next message tag and the length field.
+  size_t header_size = 0;
+  uint64_t tag;
+  if (!ParseVarInt(stream_, &tag, &header_size)) {
+    RTC_LOG(LS_WARNING)
+        << "Missing field tag from beginning of protobuf event.";
+    return Fail();
+  } else if (tag != kExpectedTag) {
+    RTC_LOG(LS_WARNING)
+        << "Unexpected field tag at beginning of protobuf event.";
+    return Fail();
+  }
+  uint64_t message_length;
+  if (!ParseVarInt(stream_, &message_length, &header_size)) {
+    RTC_LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
+    return Fail();
+  } else if (message_length > kMaxEventSize) {
+    RTC_LOG(LS_WARNING) << "Protobuf message length is too large.";
+    return Fail();
+  }
+
+  // Read the next protobuf event to the buffer, which is reused between the
+  // events.
+  if (buffer_.size() < message_length)
+    buffer_.resize(kMaxEventSize);
+  stream_->read(buffer_.data(), message_length);
+  if (stream_->gcount() != static_cast<std::streamsize>(message_length)) {
+    RTC_LOG(LS_WARNING) << "Failed to read protobuf message from file.";
+    return Fail();
+  }
+
+  if (!event->ParseFromArray(buffer_.data(), message_length)) {
+    RTC_LOG(LS_WARNING) << "Failed to parse protobuf message.";
+    return Fail();
+  }
+  bytes_read_ += header_size + message_length;
+  return true;
+}
+
+bool RtcEventLogReader::Fail() {
+  failed_ = true;
+  return false;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_READER_H_
+#define LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_READER_H_
+
+#include <istream>  // no-presubmit-check TODO(webrtc:8982)
+#include <vector>
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/ignore_wundef.h"
+
+// Files generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/logging/rtc_event_log/rtc_event_log.pb.h"
+#else
+#include "logging/rtc_event_log/rtc_event_log.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
+namespace webrtc {
+
+// Reads the events of a legacy format log one at a time, so that a log of any
+// size can be processed while only one event is held in memory:
+//
+//   RtcEventLogReader reader(&stream);
+//   rtclog::Event event;
+//   while (reader.ReadNextEvent(&event)) {
+//     ...
+//   }
+//   if (reader.failed()) {
+//     ...
+//   }
+class RtcEventLogReader {
+ public:
+  // The largest event the writer produces.
+  static constexpr size_t kMaxEventSize = (1u << 16) - 1;
+
+  // |stream| must outlive the reader.
+  explicit RtcEventLogReader(
+      std::istream* stream);  // no-presubmit-check TODO(webrtc:8982)
+  ~RtcEventLogReader();
+
+  // Reads the next event into |event|. Returns false at the end of the
+  // stream, or if the stream is malformed, in which case |failed| returns
+  // true and no further events are read.
+  bool ReadNextEvent(rtclog::Event* event);
+
+  bool failed() const { return failed_; }
+
+  // The number of bytes of the stream that the events read so far took,
+  // including the field tag and the length that precede each of them.
+  size_t bytes_read() const { return bytes_read_; }
+
+ private:
+  bool Fail();
+
+  std::istream* const stream_;  // no-presubmit-check TODO(webrtc:8982)
+  std::vector<char> buffer_;
+  size_t bytes_read_ = 0;
+  bool failed_ = false;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtcEventLogReader);
+};
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_READER_H_
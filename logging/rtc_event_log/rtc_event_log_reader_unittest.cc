@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/rtc_event_log_reader.h"
+
+#include <sstream>  // no-presubmit-check TODO(webrtc:8982)
+#include <string>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::string CreateLog(int num_events) {
+  rtclog::EventStream event_stream;
+  for (int i = 0; i < num_events; ++i) {
+    rtclog::Event* event = event_stream.add_stream();
+    event->set_timestamp_us(1000 * i);
+    event->set_type(rtclog::Event::LOSS_BASED_BWE_UPDATE);
+    event->mutable_loss_based_bwe_update()->set_bitrate_bps(300000 + i);
+  }
+  return event_stream.SerializeAsString();
+}
+
+TEST(RtcEventLogReaderTest, ReadsEventsOneAtATime) {
+  const std::string log = CreateLog(3);
+  std::istringstream stream(log);  // no-presubmit-check TODO(webrtc:8982)
+  RtcEventLogReader reader(&stream);
+  rtclog::Event event;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(reader.ReadNextEvent(&event));
+    EXPECT_EQ(1000 * i, event.timestamp_us());
+    EXPECT_EQ(300000 + i, event.loss_based_bwe_update().bitrate_bps());
+  }
+  EXPECT_FALSE(reader.ReadNextEvent(&event));
+  EXPECT_FALSE(reader.failed());
+  EXPECT_EQ(log.size(), reader.bytes_read());
+}
+
+TEST(RtcEventLogReaderTest, EmptyLog) {
+  std::istringstream stream("");  // no-presubmit-check TODO(webrtc:8982)
+  RtcEventLogReader reader(&stream);
+  rtclog::Event event;
+  EXPECT_FALSE(reader.ReadNextEvent(&event));
+  EXPECT_FALSE(reader.failed());
+}
+
+TEST(RtcEventLogReaderTest, FailsOnTruncatedLog) {
+  const std::string log = CreateLog(2);
+  std::istringstream stream(  // no-presubmit-check TODO(webrtc:8982)
+      log.substr(0, log.size() - 1));
+  RtcEventLogReader reader(&stream);
+  rtclog::Event event;
+  EXPECT_TRUE(reader.ReadNextEvent(&event));
+  EXPECT_FALSE(reader.ReadNextEvent(&event));
+  EXPECT_TRUE(reader.failed());
+  // Once it has failed, the reader does not read any further.
+  EXPECT_FALSE(reader.ReadNextEvent(&event));
+}
+
+TEST(RtcEventLogReaderTest, FailsOnUnexpectedFieldTag) {
+  std::string log = CreateLog(1);
+  log[0] = (2 << 3) | 2;
+  std::istringstream stream(log);  // no-presubmit-check TODO(webrtc:8982)
+  RtcEventLogReader reader(&stream);
+  rtclog::Event event;
+  EXPECT_FALSE(reader.ReadNextEvent(&event));
+  EXPECT_TRUE(reader.failed());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -116,4 +116,28 @@ bool AdaptedVideoTrackSource::AdaptFrame(int width,
   return true;
 }
 
+bool AdaptedVideoTrackSource::PeekAdaptFrame(int width,
+                                             int height,
+                                             int64_t time_us,
+                                             int* out_width,
+                                             int* out_height,
+                                             int* crop_width,
+                                             int* crop_height,
+                                             int* crop_x,
+                                             int* crop_y) const {
+  if (!broadcaster_.frame_wanted()) {
+    return false;
+  }
+
+  if (!video_adapter_.PeekFrameResolution(
+          width, height, time_us * rtc::kNumNanosecsPerMicrosec, crop_width,
+          crop_height, out_width, out_height)) {
+    return false;
+  }
+
+  *crop_x = (width - *crop_width) / 2;
+  *crop_y = (height - *crop_height) / 2;
+  return true;
+}
+
 }  // namespace rtc
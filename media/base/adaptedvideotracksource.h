@@ -50,6 +50,20 @@ class AdaptedVideoTrackSource
                   int* crop_x,
                   int* crop_y);
 
+  // Like AdaptFrame, but doesn't count the frame as captured. Lets a
+  // capturer find out before capturing a frame whether it is wanted and at
+  // what size, so it can capture or convert directly to the adapted size. The
+  // captured frame must still be passed through AdaptFrame.
+  bool PeekAdaptFrame(int width,
+                      int height,
+                      int64_t time_us,
+                      int* out_width,
+                      int* out_height,
+                      int* crop_width,
+                      int* crop_height,
+                      int* crop_x,
+                      int* crop_y) const;
+
   // Returns the current value of the apply_rotation flag, derived
   // from the VideoSinkWants of registered sinks. The value is derived
   // from sinks' wants, in AddOrUpdateSink and RemoveSink. Beware that
@@ -10,6 +10,8 @@
 
 #include "media/base/mediachannel.h"
 
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+
 namespace cricket {
 
 VideoOptions::VideoOptions() = default;
@@ -21,6 +23,12 @@ void MediaChannel::SetInterface(NetworkInterface* iface) {
   SetDscp(enable_dscp_ ? PreferredDscp() : rtc::DSCP_DEFAULT);
 }
 
+void MediaChannel::OnRtpPacketReceived(const webrtc::RtpPacketReceived& packet,
+                                       const rtc::PacketTime& packet_time) {
+  rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+  OnPacketReceived(&buffer, packet_time);
+}
+
 rtc::DiffServCodePoint MediaChannel::PreferredDscp() const {
   return rtc::DSCP_DEFAULT;
 }
@@ -49,6 +49,7 @@ class Timing;
 
 namespace webrtc {
 class AudioSinkInterface;
+class RtpPacketReceived;
 class VideoFrame;
 }  // namespace webrtc
 
@@ -187,6 +188,11 @@ class MediaChannel : public sigslot::has_slots<> {
   // Called when a RTP packet is received.
   virtual void OnPacketReceived(rtc::CopyOnWriteBuffer* packet,
                                 const rtc::PacketTime& packet_time) = 0;
+  // Called when a RTP packet that was already parsed for demuxing is
+  // received. The default implementation passes the raw packet to
+  // OnPacketReceived().
+  virtual void OnRtpPacketReceived(const webrtc::RtpPacketReceived& packet,
+                                   const rtc::PacketTime& packet_time);
   // Called when a RTCP packet is received.
   virtual void OnRtcpReceived(rtc::CopyOnWriteBuffer* packet,
                               const rtc::PacketTime& packet_time) = 0;
@@ -403,6 +409,7 @@ struct VoiceReceiverInfo : public MediaReceiverInfo {
   int jitter_ms = 0;
   int jitter_buffer_ms = 0;
   int jitter_buffer_preferred_ms = 0;
+  uint64_t jitter_buffer_memory_bytes = 0;
   int delay_estimate_ms = 0;
   int audio_level = 0;
   // Stats below correspond to similarly-named fields in the WebRTC stats spec.
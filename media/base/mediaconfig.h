@@ -59,6 +59,12 @@ struct MediaConfig {
     // TODO(bugs.webrtc.org/8504): If all goes well, the flag will be removed
     // together with the old method of estimation.
     bool experiment_cpu_load_estimator = false;
+
+    // Initialize the decoders of receive streams when they are created at
+    // negotiation, rather than when their first frame arrives.
+    // WebRtcVideoChannel copies it to
+    // VideoReceiveStream::Config::prewarm_decoder.
+    bool prewarm_decoders = false;
   } video;
 
   bool operator==(const MediaConfig& o) const {
@@ -71,7 +77,8 @@ struct MediaConfig {
            video.periodic_alr_bandwidth_probing ==
                o.video.periodic_alr_bandwidth_probing &&
            video.experiment_cpu_load_estimator ==
-               o.video.experiment_cpu_load_estimator;
+               o.video.experiment_cpu_load_estimator &&
+           video.prewarm_decoders == o.video.prewarm_decoders;
   }
 
   bool operator!=(const MediaConfig& o) const { return !(*this == o); }
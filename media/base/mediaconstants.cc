@@ -33,6 +33,8 @@ const char kFlexfecCodecName[] = "flexfec-03";
 
 // draft-ietf-payload-flexible-fec-scheme-02.txt
 const char kFlexfecFmtpRepairWindow[] = "repair-window";
+const char kFlexfecFmtpTypeOfProtection[] = "ToP";
+const int kFlexfecTypeOfProtection2DParity = 2;
 
 const char kCodecParamAssociatedPayloadType[] = "apt";
 const char kCodecParamAssociatedCodecName[] = "acn";
@@ -104,6 +106,8 @@ const char kComfortNoiseCodecName[] = "CN";
 const char kVp8CodecName[] = "VP8";
 const char kVp9CodecName[] = "VP9";
 const char kH264CodecName[] = "H264";
+// Experimental name until the AV1 RTP payload format is finalized.
+const char kAv1CodecName[] = "AV1X";
 
 // RFC 6184 RTP Payload Format for H.264 video
 const char kH264FmtpProfileLevelId[] = "profile-level-id";
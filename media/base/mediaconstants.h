@@ -33,6 +33,10 @@ extern const char kFlexfecCodecName[];
 extern const char kMultiplexCodecName[];
 
 extern const char kFlexfecFmtpRepairWindow[];
+// Type of protection the FlexFEC receiver asks for. Only 2D parity changes how
+// we send, since the packet masks are always signalled in the FEC header.
+extern const char kFlexfecFmtpTypeOfProtection[];
+extern const int kFlexfecTypeOfProtection2DParity;
 
 // Codec parameters
 extern const char kCodecParamAssociatedPayloadType[];
@@ -128,6 +132,7 @@ extern const char kComfortNoiseCodecName[];
 extern const char kVp8CodecName[];
 extern const char kVp9CodecName[];
 extern const char kH264CodecName[];
+extern const char kAv1CodecName[];
 
 // RFC 6184 RTP Payload Format for H.264 video
 extern const char kH264FmtpProfileLevelId[];
@@ -114,8 +114,9 @@ VideoAdapter::VideoAdapter() : VideoAdapter(1) {}
 
 VideoAdapter::~VideoAdapter() {}
 
-bool VideoAdapter::KeepFrame(int64_t in_timestamp_ns) {
-  rtc::CritScope cs(&critical_section_);
+bool VideoAdapter::KeepFrame(
+    int64_t in_timestamp_ns,
+    absl::optional<int64_t>* next_frame_timestamp_ns) const {
   if (max_framerate_request_ <= 0)
     return false;
 
@@ -132,10 +133,10 @@ bool VideoAdapter::KeepFrame(int64_t in_timestamp_ns) {
     return true;
   }
 
-  if (next_frame_timestamp_ns_) {
+  if (*next_frame_timestamp_ns) {
     // Time until next frame should be outputted.
     const int64_t time_until_next_frame_ns =
-        (*next_frame_timestamp_ns_ - in_timestamp_ns);
+        (**next_frame_timestamp_ns - in_timestamp_ns);
 
     // Continue if timestamp is within expected range.
     if (std::abs(time_until_next_frame_ns) < 2 * frame_interval_ns) {
@@ -143,7 +144,7 @@ bool VideoAdapter::KeepFrame(int64_t in_timestamp_ns) {
       if (time_until_next_frame_ns > 0)
         return false;
       // Time to output new frame.
-      *next_frame_timestamp_ns_ += frame_interval_ns;
+      **next_frame_timestamp_ns += frame_interval_ns;
       return true;
     }
   }
@@ -151,47 +152,28 @@ bool VideoAdapter::KeepFrame(int64_t in_timestamp_ns) {
   // First timestamp received or timestamp is way outside expected range, so
   // reset. Set first timestamp target to just half the interval to prefer
   // keeping frames in case of jitter.
-  next_frame_timestamp_ns_ = in_timestamp_ns + frame_interval_ns / 2;
+  *next_frame_timestamp_ns = in_timestamp_ns + frame_interval_ns / 2;
   return true;
 }
 
-bool VideoAdapter::AdaptFrameResolution(int in_width,
-                                        int in_height,
-                                        int64_t in_timestamp_ns,
-                                        int* cropped_width,
-                                        int* cropped_height,
-                                        int* out_width,
-                                        int* out_height) {
-  rtc::CritScope cs(&critical_section_);
-  ++frames_in_;
-
-  // The max output pixel count is the minimum of the requests from
-  // OnOutputFormatRequest and OnResolutionRequest.
+int VideoAdapter::MaxPixelCount() const {
   int max_pixel_count = resolution_request_max_pixel_count_;
   if (requested_format_) {
     max_pixel_count = std::min(
         max_pixel_count, requested_format_->width * requested_format_->height);
   }
-  int target_pixel_count =
-      std::min(resolution_request_target_pixel_count_, max_pixel_count);
-
-  // Drop the input frame if necessary.
-  if (max_pixel_count <= 0 || !KeepFrame(in_timestamp_ns)) {
-    // Show VAdapt log every 90 frames dropped. (3 seconds)
-    if ((frames_in_ - frames_out_) % 90 == 0) {
-      // TODO(fbarchard): Reduce to LS_VERBOSE when adapter info is not needed
-      // in default calls.
-      RTC_LOG(LS_INFO) << "VAdapt Drop Frame: scaled " << frames_scaled_
-                       << " / out " << frames_out_ << " / in " << frames_in_
-                       << " Changes: " << adaption_changes_
-                       << " Input: " << in_width << "x" << in_height
-                       << " timestamp: " << in_timestamp_ns << " Output: i"
-                       << (requested_format_ ? requested_format_->interval : 0);
-    }
+  return max_pixel_count;
+}
 
-    // Drop frame.
-    return false;
-  }
+bool VideoAdapter::CalculateResolution(int in_width,
+                                       int in_height,
+                                       int* cropped_width,
+                                       int* cropped_height,
+                                       int* out_width,
+                                       int* out_height) const {
+  const int max_pixel_count = MaxPixelCount();
+  const int target_pixel_count =
+      std::min(resolution_request_target_pixel_count_, max_pixel_count);
 
   // Calculate how the input should be cropped.
   if (!requested_format_ || requested_format_->width == 0 ||
@@ -200,13 +182,12 @@ bool VideoAdapter::AdaptFrameResolution(int in_width,
     *cropped_height = in_height;
   } else {
     // Adjust |requested_format_| orientation to match input.
-    if ((in_width > in_height) !=
-        (requested_format_->width > requested_format_->height)) {
-      std::swap(requested_format_->width, requested_format_->height);
-    }
+    int requested_width = requested_format_->width;
+    int requested_height = requested_format_->height;
+    if ((in_width > in_height) != (requested_width > requested_height))
+      std::swap(requested_width, requested_height);
     const float requested_aspect =
-        requested_format_->width /
-        static_cast<float>(requested_format_->height);
+        requested_width / static_cast<float>(requested_height);
     *cropped_width =
         std::min(in_width, static_cast<int>(in_height * requested_aspect));
     *cropped_height =
@@ -231,9 +212,44 @@ bool VideoAdapter::AdaptFrameResolution(int in_width,
   *out_height = *cropped_height / scale.denominator * scale.numerator;
   RTC_DCHECK_EQ(0, *out_width % required_resolution_alignment_);
   RTC_DCHECK_EQ(0, *out_height % required_resolution_alignment_);
+  return scale.numerator != scale.denominator;
+}
+
+bool VideoAdapter::AdaptFrameResolution(int in_width,
+                                        int in_height,
+                                        int64_t in_timestamp_ns,
+                                        int* cropped_width,
+                                        int* cropped_height,
+                                        int* out_width,
+                                        int* out_height) {
+  rtc::CritScope cs(&critical_section_);
+  ++frames_in_;
+
+  // Drop the input frame if necessary.
+  if (MaxPixelCount() <= 0 ||
+      !KeepFrame(in_timestamp_ns, &next_frame_timestamp_ns_)) {
+    // Show VAdapt log every 90 frames dropped. (3 seconds)
+    if ((frames_in_ - frames_out_) % 90 == 0) {
+      // TODO(fbarchard): Reduce to LS_VERBOSE when adapter info is not needed
+      // in default calls.
+      RTC_LOG(LS_INFO) << "VAdapt Drop Frame: scaled " << frames_scaled_
+                       << " / out " << frames_out_ << " / in " << frames_in_
+                       << " Changes: " << adaption_changes_
+                       << " Input: " << in_width << "x" << in_height
+                       << " timestamp: " << in_timestamp_ns << " Output: i"
+                       << (requested_format_ ? requested_format_->interval : 0);
+    }
+
+    // Drop frame.
+    return false;
+  }
+
+  const bool scaled = CalculateResolution(in_width, in_height, cropped_width,
+                                          cropped_height, out_width,
+                                          out_height);
 
   ++frames_out_;
-  if (scale.numerator != scale.denominator)
+  if (scaled)
     ++frames_scaled_;
 
   if (previous_width_ &&
@@ -243,9 +259,8 @@ bool VideoAdapter::AdaptFrameResolution(int in_width,
                      << " / out " << frames_out_ << " / in " << frames_in_
                      << " Changes: " << adaption_changes_
                      << " Input: " << in_width << "x" << in_height
-                     << " Scale: " << scale.numerator << "/"
-                     << scale.denominator << " Output: " << *out_width << "x"
-                     << *out_height << " i"
+                     << " Output: " << *out_width << "x" << *out_height
+                     << " i"
                      << (requested_format_ ? requested_format_->interval : 0);
   }
 
@@ -255,6 +270,24 @@ bool VideoAdapter::AdaptFrameResolution(int in_width,
   return true;
 }
 
+bool VideoAdapter::PeekFrameResolution(int in_width,
+                                       int in_height,
+                                       int64_t in_timestamp_ns,
+                                       int* cropped_width,
+                                       int* cropped_height,
+                                       int* out_width,
+                                       int* out_height) const {
+  rtc::CritScope cs(&critical_section_);
+  absl::optional<int64_t> next_frame_timestamp_ns = next_frame_timestamp_ns_;
+  if (MaxPixelCount() <= 0 ||
+      !KeepFrame(in_timestamp_ns, &next_frame_timestamp_ns)) {
+    return false;
+  }
+  CalculateResolution(in_width, in_height, cropped_width, cropped_height,
+                      out_width, out_height);
+  return true;
+}
+
 void VideoAdapter::OnOutputFormatRequest(
     const absl::optional<VideoFormat>& format) {
   rtc::CritScope cs(&critical_section_);
@@ -42,6 +42,20 @@ class VideoAdapter {
                             int* out_width,
                             int* out_height);
 
+  // Returns what AdaptFrameResolution would for a frame of the given size and
+  // timestamp, without counting the frame or advancing the frame rate
+  // throttling. Lets a capturer skip the capture or conversion of frames that
+  // would be dropped, and produce the others at the adapted resolution. The
+  // frame must still be passed to AdaptFrameResolution afterwards; it gives
+  // the same result as long as the requests don't change in between.
+  bool PeekFrameResolution(int in_width,
+                           int in_height,
+                           int64_t in_timestamp_ns,
+                           int* cropped_width,
+                           int* cropped_height,
+                           int* out_width,
+                           int* out_height) const;
+
   // Requests the output frame size and frame interval from
   // |AdaptFrameResolution| to not be larger than |format|. Also, the input
   // frame size will be cropped to match the requested aspect ratio. The
@@ -64,7 +78,22 @@ class VideoAdapter {
 
  private:
   // Determine if frame should be dropped based on input fps and requested fps.
-  bool KeepFrame(int64_t in_timestamp_ns);
+  // Advances |next_frame_timestamp_ns| if the frame is kept.
+  bool KeepFrame(int64_t in_timestamp_ns,
+                 absl::optional<int64_t>* next_frame_timestamp_ns) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_);
+  // The max output pixel count, the minimum of the requests from
+  // OnOutputFormatRequest and OnResolutionRequest.
+  int MaxPixelCount() const RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_);
+  // Calculates the cropping and output size of a frame that is kept. Returns
+  // true if the frame is scaled.
+  bool CalculateResolution(int in_width,
+                           int in_height,
+                           int* cropped_width,
+                           int* cropped_height,
+                           int* out_width,
+                           int* out_height) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_);
 
   int frames_in_;         // Number of input frames.
   int frames_out_;        // Number of output frames.
@@ -1074,4 +1074,70 @@ TEST_F(VideoAdapterTest, TestAdaptToMax) {
   EXPECT_EQ(640, out_width_);
   EXPECT_EQ(360, out_height_);
 }
+
+// Test that peeking at a frame predicts what the adapter does with it, without
+// affecting the frame rate throttling.
+TEST_F(VideoAdapterTest, PeekFrameResolutionDoesNotDropFrames) {
+  const int64_t capture_interval = VideoFormat::FpsToInterval(kDefaultFps);
+  const VideoFormat request_format(640, 360, capture_interval * 2,
+                                   cricket::FOURCC_ANY);
+  adapter_.OnOutputFormatRequest(request_format);
+  // Gets the same frames without peeking.
+  VideoAdapter reference_adapter;
+  reference_adapter.OnOutputFormatRequest(request_format);
+
+  int num_kept_frames = 0;
+  int peek_cropped_width = 0;
+  int peek_cropped_height = 0;
+  int peek_out_width = 0;
+  int peek_out_height = 0;
+  for (int i = 0; i < 10; ++i) {
+    const int64_t timestamp = i * capture_interval;
+    // Peeking twice gives the same answer.
+    const bool peek_keep = adapter_.PeekFrameResolution(
+        1280, 720, timestamp, &peek_cropped_width, &peek_cropped_height,
+        &peek_out_width, &peek_out_height);
+    EXPECT_EQ(peek_keep,
+              adapter_.PeekFrameResolution(
+                  1280, 720, timestamp, &peek_cropped_width,
+                  &peek_cropped_height, &peek_out_width, &peek_out_height));
+    EXPECT_EQ(reference_adapter.AdaptFrameResolution(
+                  1280, 720, timestamp, &cropped_width_, &cropped_height_,
+                  &out_width_, &out_height_),
+              peek_keep);
+
+    EXPECT_EQ(peek_keep, adapter_.AdaptFrameResolution(
+                             1280, 720, timestamp, &cropped_width_,
+                             &cropped_height_, &out_width_, &out_height_));
+    if (peek_keep) {
+      ++num_kept_frames;
+      EXPECT_EQ(cropped_width_, peek_cropped_width);
+      EXPECT_EQ(cropped_height_, peek_cropped_height);
+      EXPECT_EQ(out_width_, peek_out_width);
+      EXPECT_EQ(out_height_, peek_out_height);
+      EXPECT_EQ(640, out_width_);
+      EXPECT_EQ(360, out_height_);
+    }
+  }
+  // Half the frames are dropped, not all of them.
+  EXPECT_GT(num_kept_frames, 0);
+  EXPECT_LT(num_kept_frames, 10);
+}
+
+// Test that peeking at a frame follows resolution requests.
+TEST_F(VideoAdapterTest, PeekFrameResolutionAfterResolutionRequest) {
+  adapter_.OnResolutionFramerateRequest(absl::nullopt, 640 * 480 - 1,
+                                        std::numeric_limits<int>::max());
+  EXPECT_TRUE(adapter_.PeekFrameResolution(640, 480, 0, &cropped_width_,
+                                           &cropped_height_, &out_width_,
+                                           &out_height_));
+  EXPECT_EQ(480, out_width_);
+  EXPECT_EQ(360, out_height_);
+
+  adapter_.OnResolutionFramerateRequest(absl::nullopt, 0,
+                                        std::numeric_limits<int>::max());
+  EXPECT_FALSE(adapter_.PeekFrameResolution(640, 480, 0, &cropped_width_,
+                                            &cropped_height_, &out_width_,
+                                            &out_height_));
+}
 }  // namespace cricket
@@ -10,15 +10,51 @@
 
 #include "media/base/videobroadcaster.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "api/video/i420_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace rtc {
 
-VideoBroadcaster::VideoBroadcaster() {
+namespace {
+
+// Scales |width| x |height| down in steps of 3/4 and 2/3, like
+// cricket::VideoAdapter, until it has at most |max_pixel_count| pixels. The
+// fixed steps make sinks with slightly different limits end up with the same
+// size, so they can share the scaled frame.
+void ScaleDownToPixelCount(int max_pixel_count, int* width, int* height) {
+  int scaled_width = *width;
+  int scaled_height = *height;
+  int64_t numerator = 1;
+  int64_t denominator = 1;
+  bool three_quarters = true;
+  while (static_cast<int64_t>(scaled_width) * scaled_height > max_pixel_count &&
+         scaled_width > 2 && scaled_height > 2) {
+    if (three_quarters) {
+      numerator *= 3;
+      denominator *= 4;
+    } else {
+      numerator *= 2;
+      denominator *= 3;
+    }
+    three_quarters = !three_quarters;
+    scaled_width = static_cast<int>(*width * numerator / denominator);
+    scaled_height = static_cast<int>(*height * numerator / denominator);
+  }
+  // Even dimensions, so that the chroma planes scale exactly.
+  *width = std::max(2, scaled_width & ~1);
+  *height = std::max(2, scaled_height & ~1);
+}
+
+}  // namespace
+
+VideoBroadcaster::VideoBroadcaster()
+    : scale_per_sink_(webrtc::field_trial::IsEnabled(
+          "WebRTC-VideoBroadcaster-ScalePerSink")) {
   thread_checker_.DetachFromThread();
 }
 VideoBroadcaster::~VideoBroadcaster() = default;
@@ -64,14 +100,25 @@ void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
       RTC_LOG(LS_VERBOSE) << "Discarding frame with unexpected rotation.";
       continue;
     }
+    const bool scale = scale_per_sink_ && frame.width() * frame.height() >
+                                              sink_pair.wants.max_pixel_count;
     if (sink_pair.wants.black_frames) {
+      int width = frame.width();
+      int height = frame.height();
+      if (scale)
+        ScaleDownToPixelCount(sink_pair.wants.max_pixel_count, &width, &height);
       sink_pair.sink->OnFrame(
-          webrtc::VideoFrame(GetBlackFrameBuffer(frame.width(), frame.height()),
+          webrtc::VideoFrame(GetBlackFrameBuffer(width, height),
                              frame.rotation(), frame.timestamp_us()));
     } else {
-      sink_pair.sink->OnFrame(frame);
+      const webrtc::VideoFrame* scaled_frame =
+          scale ? GetScaledFrame(frame, sink_pair.wants.max_pixel_count)
+                : nullptr;
+      sink_pair.sink->OnFrame(scaled_frame ? *scaled_frame : frame);
     }
   }
+  // Let the sinks' references return the buffers to the pool.
+  scaled_frames_.clear();
 }
 
 void VideoBroadcaster::OnDiscardedFrame() {
@@ -85,23 +132,38 @@ void VideoBroadcaster::UpdateWants() {
 
   VideoSinkWants wants;
   wants.rotation_applied = false;
+  if (scale_per_sink_ && !sink_pairs().empty())
+    wants.max_pixel_count = 0;
   for (auto& sink : sink_pairs()) {
     // wants.rotation_applied == ANY(sink.wants.rotation_applied)
     if (sink.wants.rotation_applied) {
       wants.rotation_applied = true;
     }
-    // wants.max_pixel_count == MIN(sink.wants.max_pixel_count)
-    if (sink.wants.max_pixel_count < wants.max_pixel_count) {
-      wants.max_pixel_count = sink.wants.max_pixel_count;
-    }
-    // Select the minimum requested target_pixel_count, if any, of all sinks so
-    // that we don't over utilize the resources for any one.
-    // TODO(sprang): Consider using the median instead, since the limit can be
-    // expressed by max_pixel_count.
-    if (sink.wants.target_pixel_count &&
-        (!wants.target_pixel_count ||
-         (*sink.wants.target_pixel_count < *wants.target_pixel_count))) {
-      wants.target_pixel_count = sink.wants.target_pixel_count;
+    if (scale_per_sink_) {
+      // wants.max_pixel_count == MAX(sink.wants.max_pixel_count), and
+      // OnFrame() scales the frame down for the other sinks.
+      if (sink.wants.max_pixel_count > wants.max_pixel_count) {
+        wants.max_pixel_count = sink.wants.max_pixel_count;
+      }
+      if (sink.wants.target_pixel_count &&
+          (!wants.target_pixel_count ||
+           (*sink.wants.target_pixel_count > *wants.target_pixel_count))) {
+        wants.target_pixel_count = sink.wants.target_pixel_count;
+      }
+    } else {
+      // wants.max_pixel_count == MIN(sink.wants.max_pixel_count)
+      if (sink.wants.max_pixel_count < wants.max_pixel_count) {
+        wants.max_pixel_count = sink.wants.max_pixel_count;
+      }
+      // Select the minimum requested target_pixel_count, if any, of all sinks
+      // so that we don't over utilize the resources for any one.
+      // TODO(sprang): Consider using the median instead, since the limit can
+      // be expressed by max_pixel_count.
+      if (sink.wants.target_pixel_count &&
+          (!wants.target_pixel_count ||
+           (*sink.wants.target_pixel_count < *wants.target_pixel_count))) {
+        wants.target_pixel_count = sink.wants.target_pixel_count;
+      }
     }
     // Select the minimum for the requested max framerates.
     if (sink.wants.max_framerate_fps < wants.max_framerate_fps) {
@@ -129,4 +191,40 @@ VideoBroadcaster::GetBlackFrameBuffer(int width, int height) {
   return black_frame_buffer_;
 }
 
+const webrtc::VideoFrame* VideoBroadcaster::GetScaledFrame(
+    const webrtc::VideoFrame& frame,
+    int max_pixel_count) {
+  int width = frame.width();
+  int height = frame.height();
+  ScaleDownToPixelCount(max_pixel_count, &width, &height);
+  for (const webrtc::VideoFrame& scaled_frame : scaled_frames_) {
+    if (scaled_frame.width() == width && scaled_frame.height() == height)
+      return &scaled_frame;
+  }
+
+  // Native buffers scale themselves if they can; otherwise scale in software
+  // into a pooled buffer.
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
+      frame.video_frame_buffer()->CropAndScale(0, 0, frame.width(),
+                                               frame.height(), width, height);
+  if (!buffer) {
+    rtc::scoped_refptr<webrtc::I420Buffer> scaled_buffer =
+        scaled_buffer_pool_.CreateBuffer(width, height);
+    if (!scaled_buffer)
+      return nullptr;
+    scaled_buffer->ScaleFrom(*frame.video_frame_buffer()->ToI420());
+    buffer = scaled_buffer;
+  }
+  webrtc::VideoFrame::Builder builder;
+  builder.set_video_frame_buffer(buffer)
+      .set_timestamp_us(frame.timestamp_us())
+      .set_timestamp_rtp(frame.timestamp())
+      .set_ntp_time_ms(frame.ntp_time_ms())
+      .set_rotation(frame.rotation());
+  if (frame.color_space())
+    builder.set_color_space(*frame.color_space());
+  scaled_frames_.push_back(builder.build());
+  return &scaled_frames_.back();
+}
+
 }  // namespace rtc
@@ -17,6 +17,7 @@
 
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "media/base/videosourcebase.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/thread_checker.h"
@@ -29,6 +30,13 @@ namespace rtc {
 // Sinks must be added and removed on one and only one thread.
 // Video frames can be broadcasted on any thread. I.e VideoBroadcaster::OnFrame
 // can be called on any thread.
+//
+// With the "WebRTC-VideoBroadcaster-ScalePerSink" field trial, the source is
+// asked for the largest resolution any sink wants instead of the smallest, and
+// sinks that want fewer pixels get the frame scaled down by the broadcaster.
+// Each scaled size is produced once per frame and shared by all sinks that
+// want it, so e.g. several PeerConnections sending the same track at a lower
+// resolution don't each scale it.
 class VideoBroadcaster : public VideoSourceBase,
                          public VideoSinkInterface<webrtc::VideoFrame> {
  public:
@@ -58,12 +66,24 @@ class VideoBroadcaster : public VideoSourceBase,
   const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& GetBlackFrameBuffer(
       int width,
       int height) RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+  // Returns |frame| scaled down to at most |max_pixel_count| pixels, reusing
+  // the buffer scaled for an earlier sink if it has the same size. Returns
+  // null if the frame can't be scaled.
+  const webrtc::VideoFrame* GetScaledFrame(const webrtc::VideoFrame& frame,
+                                           int max_pixel_count)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
 
   ThreadChecker thread_checker_;
   rtc::CriticalSection sinks_and_wants_lock_;
 
+  const bool scale_per_sink_;
   VideoSinkWants current_wants_ RTC_GUARDED_BY(sinks_and_wants_lock_);
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_;
+  // The frames scaled for the frame being broadcast.
+  std::vector<webrtc::VideoFrame> scaled_frames_
+      RTC_GUARDED_BY(sinks_and_wants_lock_);
+  webrtc::I420BufferPool scaled_buffer_pool_
+      RTC_GUARDED_BY(sinks_and_wants_lock_);
 };
 
 }  // namespace rtc
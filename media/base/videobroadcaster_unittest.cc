@@ -15,11 +15,30 @@
 #include "media/base/fakevideorenderer.h"
 #include "media/base/videobroadcaster.h"
 #include "rtc_base/gunit.h"
+#include "test/field_trial.h"
 
 using rtc::VideoBroadcaster;
 using rtc::VideoSinkWants;
 using cricket::FakeVideoRenderer;
 
+namespace {
+
+class FrameRecordingSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+ public:
+  void OnFrame(const webrtc::VideoFrame& frame) override {
+    last_buffer_ = frame.video_frame_buffer();
+  }
+
+  const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& last_buffer() const {
+    return last_buffer_;
+  }
+
+ private:
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> last_buffer_;
+};
+
+}  // namespace
+
 TEST(VideoBroadcasterTest, frame_wanted) {
   VideoBroadcaster broadcaster;
   EXPECT_FALSE(broadcaster.frame_wanted());
@@ -192,3 +211,60 @@ TEST(VideoBroadcasterTest, SinkWantsBlackFrames) {
   EXPECT_TRUE(sink2.black_frame());
   EXPECT_EQ(30, sink2.timestamp_us());
 }
+
+TEST(VideoBroadcasterTest, AppliesMaxOfSinkWantsMaxPixelCountPerSink) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-VideoBroadcaster-ScalePerSink/Enabled/");
+  VideoBroadcaster broadcaster;
+
+  FakeVideoRenderer sink1;
+  VideoSinkWants wants1;
+  wants1.max_pixel_count = 640 * 360;
+  broadcaster.AddOrUpdateSink(&sink1, wants1);
+  EXPECT_EQ(640 * 360, broadcaster.wants().max_pixel_count);
+
+  FakeVideoRenderer sink2;
+  VideoSinkWants wants2;
+  wants2.max_pixel_count = 1280 * 720;
+  broadcaster.AddOrUpdateSink(&sink2, wants2);
+  EXPECT_EQ(1280 * 720, broadcaster.wants().max_pixel_count);
+
+  broadcaster.RemoveSink(&sink2);
+  EXPECT_EQ(640 * 360, broadcaster.wants().max_pixel_count);
+  broadcaster.RemoveSink(&sink1);
+  EXPECT_EQ(std::numeric_limits<int>::max(),
+            broadcaster.wants().max_pixel_count);
+}
+
+TEST(VideoBroadcasterTest, ScalesFrameOnceForSinksWantingSameSize) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-VideoBroadcaster-ScalePerSink/Enabled/");
+  VideoBroadcaster broadcaster;
+
+  FrameRecordingSink full_sink;
+  broadcaster.AddOrUpdateSink(&full_sink, VideoSinkWants());
+  // Slightly different limits that result in the same size.
+  FrameRecordingSink small_sink1;
+  VideoSinkWants wants1;
+  wants1.max_pixel_count = 640 * 360;
+  broadcaster.AddOrUpdateSink(&small_sink1, wants1);
+  FrameRecordingSink small_sink2;
+  VideoSinkWants wants2;
+  wants2.max_pixel_count = 700 * 400;
+  broadcaster.AddOrUpdateSink(&small_sink2, wants2);
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(1280, 720));
+  webrtc::I420Buffer::SetBlack(buffer);
+  broadcaster.OnFrame(webrtc::VideoFrame(buffer, webrtc::kVideoRotation_0, 0));
+
+  EXPECT_EQ(buffer, full_sink.last_buffer());
+  ASSERT_TRUE(small_sink1.last_buffer());
+  EXPECT_EQ(640, small_sink1.last_buffer()->width());
+  EXPECT_EQ(360, small_sink1.last_buffer()->height());
+  EXPECT_EQ(small_sink1.last_buffer(), small_sink2.last_buffer());
+
+  broadcaster.RemoveSink(&full_sink);
+  broadcaster.RemoveSink(&small_sink1);
+  broadcaster.RemoveSink(&small_sink2);
+}
@@ -210,6 +210,8 @@ class FakeVideoReceiveStream final : public webrtc::VideoReceiveStream {
   void AddSecondarySink(webrtc::RtpPacketSinkInterface* sink) override;
   void RemoveSecondarySink(const webrtc::RtpPacketSinkInterface* sink) override;
 
+  void OnVsync(int64_t vsync_time_ms, int64_t refresh_interval_ms) override {}
+
   int GetNumAddedSecondarySinks() const;
   int GetNumRemovedSecondarySinks() const;
 
@@ -12,6 +12,7 @@
 
 #include "api/video_codecs/sdp_video_format.h"
 #include "media/base/mediaconstants.h"
+#include "modules/video_coding/codecs/av1/include/av1.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
@@ -45,6 +46,8 @@ std::vector<SdpVideoFormat> InternalDecoderFactory::GetSupportedFormats()
     formats.push_back(format);
   for (const SdpVideoFormat& h264_format : SupportedH264Codecs())
     formats.push_back(h264_format);
+  for (const SdpVideoFormat& format : SupportedAV1Codecs())
+    formats.push_back(format);
   return formats;
 }
 
@@ -61,6 +64,8 @@ std::unique_ptr<VideoDecoder> InternalDecoderFactory::CreateVideoDecoder(
     return VP9Decoder::Create();
   if (cricket::CodecNamesEq(format.name, cricket::kH264CodecName))
     return H264Decoder::Create();
+  if (cricket::CodecNamesEq(format.name, cricket::kAv1CodecName))
+    return AV1Decoder::Create();
 
   RTC_NOTREACHED();
   return nullptr;
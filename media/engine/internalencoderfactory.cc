@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "api/video_codecs/sdp_video_format.h"
+#include "modules/video_coding/codecs/av1/include/av1.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
@@ -28,6 +29,8 @@ std::vector<SdpVideoFormat> InternalEncoderFactory::GetSupportedFormats()
     supported_codecs.push_back(format);
   for (const webrtc::SdpVideoFormat& format : webrtc::SupportedH264Codecs())
     supported_codecs.push_back(format);
+  for (const webrtc::SdpVideoFormat& format : webrtc::SupportedAV1Codecs())
+    supported_codecs.push_back(format);
   return supported_codecs;
 }
 
@@ -47,6 +50,8 @@ std::unique_ptr<VideoEncoder> InternalEncoderFactory::CreateVideoEncoder(
     return VP9Encoder::Create(cricket::VideoCodec(format));
   if (cricket::CodecNamesEq(format.name, cricket::kH264CodecName))
     return H264Encoder::Create(cricket::VideoCodec(format));
+  if (cricket::CodecNamesEq(format.name, cricket::kAv1CodecName))
+    return AV1Encoder::Create();
   RTC_LOG(LS_ERROR) << "Trying to created encoder of unsupported format "
                     << format.name;
   return nullptr;
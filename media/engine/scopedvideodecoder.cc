@@ -33,6 +33,7 @@ class ScopedVideoDecoder : public webrtc::VideoDecoder {
                  const webrtc::CodecSpecificInfo* codec_specific_info,
                  int64_t render_time_ms) override;
   bool PrefersLateDecoding() const override;
+  size_t MaxPendingFrames() const override;
   const char* ImplementationName() const override;
 
   ~ScopedVideoDecoder() override;
@@ -73,6 +74,10 @@ bool ScopedVideoDecoder::PrefersLateDecoding() const {
   return decoder_->PrefersLateDecoding();
 }
 
+size_t ScopedVideoDecoder::MaxPendingFrames() const {
+  return decoder_->MaxPendingFrames();
+}
+
 const char* ScopedVideoDecoder::ImplementationName() const {
   return decoder_->ImplementationName();
 }
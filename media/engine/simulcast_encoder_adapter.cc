@@ -291,8 +291,77 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  // If scaling isn't required, because the input resolution matches the
+  // destination or the input image is empty (e.g. a keyframe request for
+  // encoders with internal camera sources), the image is passed on directly.
+  // Otherwise, it is scaled to match what the encoder expects. Each stream is
+  // scaled from the smallest frame that has already been scaled and is at
+  // least as large, starting from the highest resolution. Buffers that can
+  // crop and scale themselves, e.g. native buffers of the platform, keep
+  // their type; others are converted to I420 and scaled at full resolution at
+  // most once.
+  // Native frames that can't be scaled as they are are passed on directly,
+  // and the underlying encoder is expected to be able to correctly
+  // sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  const rtc::scoped_refptr<VideoFrameBuffer>& input_buffer =
+      input_image.video_frame_buffer();
+  const bool is_native =
+      input_buffer->type() == VideoFrameBuffer::Type::kNative;
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> scaled_buffers(
+      streaminfos_.size());
+  rtc::scoped_refptr<I420BufferInterface> src_buffer;
+  rtc::scoped_refptr<VideoFrameBuffer> smallest_scaled_buffer;
+  for (size_t stream_idx = streaminfos_.size(); stream_idx-- > 0;) {
+    const int dst_width = streaminfos_[stream_idx].width;
+    const int dst_height = streaminfos_[stream_idx].height;
+    if (!streaminfos_[stream_idx].send_stream ||
+        (dst_width == input_buffer->width() &&
+         dst_height == input_buffer->height())) {
+      continue;
+    }
+
+    rtc::scoped_refptr<VideoFrameBuffer> scale_from = input_buffer;
+    if (smallest_scaled_buffer &&
+        smallest_scaled_buffer->width() >= dst_width &&
+        smallest_scaled_buffer->height() >= dst_height) {
+      scale_from = smallest_scaled_buffer;
+    }
+    rtc::scoped_refptr<VideoFrameBuffer> dst_buffer = scale_from->CropAndScale(
+        0, 0, scale_from->width(), scale_from->height(), dst_width,
+        dst_height);
+    if (!dst_buffer && is_native)
+      continue;
+
+    if (!dst_buffer) {
+      rtc::scoped_refptr<I420BufferInterface> i420_scale_from;
+      if (scale_from != input_buffer) {
+        i420_scale_from = scale_from->ToI420();
+      } else {
+        if (!src_buffer) {
+          src_buffer = input_buffer->ToI420();
+        }
+        i420_scale_from = src_buffer;
+      }
+      rtc::scoped_refptr<I420Buffer> i420_buffer =
+          streaminfos_[stream_idx].buffer_pool->CreateBuffer(dst_width,
+                                                             dst_height);
+      libyuv::I420Scale(
+          i420_scale_from->DataY(), i420_scale_from->StrideY(),
+          i420_scale_from->DataU(), i420_scale_from->StrideU(),
+          i420_scale_from->DataV(), i420_scale_from->StrideV(),
+          i420_scale_from->width(), i420_scale_from->height(),
+          i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+          i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+          i420_buffer->MutableDataV(), i420_buffer->StrideV(), dst_width,
+          dst_height, libyuv::kFilterBilinear);
+      dst_buffer = i420_buffer;
+    }
+    scaled_buffers[stream_idx] = dst_buffer;
+    smallest_scaled_buffer = dst_buffer;
+  }
+
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream) {
@@ -307,47 +376,18 @@ int SimulcastEncoderAdapter::Encode(
       stream_frame_types.push_back(kVideoFrameDelta);
     }
 
-    int dst_width = streaminfos_[stream_idx].width;
-    int dst_height = streaminfos_[stream_idx].height;
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        input_image.video_frame_buffer()->type() ==
-            VideoFrameBuffer::Type::kNative) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(
+    int ret;
+    if (!scaled_buffers[stream_idx]) {
+      ret = streaminfos_[stream_idx].encoder->Encode(
           input_image, codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
     } else {
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height);
-      rtc::scoped_refptr<I420BufferInterface> src_buffer =
-          input_image.video_frame_buffer()->ToI420();
-      libyuv::I420Scale(src_buffer->DataY(), src_buffer->StrideY(),
-                        src_buffer->DataU(), src_buffer->StrideU(),
-                        src_buffer->DataV(), src_buffer->StrideV(), src_width,
-                        src_height, dst_buffer->MutableDataY(),
-                        dst_buffer->StrideY(), dst_buffer->MutableDataU(),
-                        dst_buffer->StrideU(), dst_buffer->MutableDataV(),
-                        dst_buffer->StrideV(), dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          VideoFrame(dst_buffer, input_image.timestamp(),
+      ret = streaminfos_[stream_idx].encoder->Encode(
+          VideoFrame(scaled_buffers[stream_idx], input_image.timestamp(),
                      input_image.render_time_ms(), webrtc::kVideoRotation_0),
           codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+    }
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
   }
 
@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "common_video/include/i420_buffer_pool.h"
 #include "media/engine/webrtcvideoencoderfactory.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/atomicops.h"
@@ -77,13 +78,17 @@ class SimulcastEncoderAdapter : public VideoEncoder {
           width(width),
           height(height),
           key_frame_request(false),
-          send_stream(send_stream) {}
+          send_stream(send_stream),
+          buffer_pool(new I420BufferPool()) {}
     std::unique_ptr<VideoEncoder> encoder;
     std::unique_ptr<EncodedImageCallback> callback;
     uint16_t width;
     uint16_t height;
     bool key_frame_request;
     bool send_stream;
+    // Provides the buffers of the frames scaled to the resolution of the
+    // stream.
+    std::unique_ptr<I420BufferPool> buffer_pool;
   };
 
   // Populate the codec settings for each simulcast stream.
@@ -838,6 +838,115 @@ TEST_F(TestSimulcastEncoderAdapterFake,
   EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
 }
 
+// A native buffer that can be scaled without converting it to I420.
+class FakeScalableNativeBuffer : public FakeNativeBufferNoI420 {
+ public:
+  FakeScalableNativeBuffer(int width, int height, int scaled_from_width)
+      : FakeNativeBufferNoI420(width, height),
+        scaled_from_width_(scaled_from_width) {}
+
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(
+      int offset_x,
+      int offset_y,
+      int crop_width,
+      int crop_height,
+      int scaled_width,
+      int scaled_height) override {
+    return new rtc::RefCountedObject<FakeScalableNativeBuffer>(
+        scaled_width, scaled_height, width());
+  }
+
+  int scaled_from_width() const { return scaled_from_width_; }
+
+ private:
+  const int scaled_from_width_;
+};
+
+TEST_F(TestSimulcastEncoderAdapterFake, ScalesNativeFramesWithoutConversion) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders())
+    encoder->set_supports_native_handle(true);
+
+  rtc::scoped_refptr<VideoFrameBuffer> buffer(
+      new rtc::RefCountedObject<FakeScalableNativeBuffer>(kDefaultWidth,
+                                                          kDefaultHeight, 0));
+  VideoFrame input_frame(buffer, 100, 1000, kVideoRotation_0);
+  std::vector<VideoFrame> frames(3, input_frame);
+  for (size_t stream = 0; stream < 3; ++stream) {
+    EXPECT_CALL(*helper_->factory()->encoders()[stream], Encode(_, _, _))
+        .WillOnce(::testing::DoAll(::testing::SaveArg<0>(&frames[stream]),
+                                   Return(WEBRTC_VIDEO_CODEC_OK)));
+  }
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+
+  EXPECT_EQ(buffer.get(), frames[2].video_frame_buffer().get());
+  for (size_t stream = 0; stream < 2; ++stream) {
+    ASSERT_EQ(VideoFrameBuffer::Type::kNative,
+              frames[stream].video_frame_buffer()->type());
+    EXPECT_EQ(codec_.simulcastStream[stream].width, frames[stream].width());
+    EXPECT_EQ(codec_.simulcastStream[stream].height, frames[stream].height());
+    // Each stream is scaled from the next larger one.
+    EXPECT_EQ(codec_.simulcastStream[stream + 1].width,
+              static_cast<FakeScalableNativeBuffer*>(
+                  frames[stream].video_frame_buffer().get())
+                  ->scaled_from_width());
+  }
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake, ScalesFramesIntoPooledBuffers) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame(input_buffer, 0, 0, webrtc::kVideoRotation_0);
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  std::vector<const uint8_t*> scaled_data(3);
+  for (int i = 0; i < 2; ++i) {
+    std::vector<VideoFrame> frames(3, input_frame);
+    for (size_t stream = 0; stream < 3; ++stream) {
+      EXPECT_CALL(*helper_->factory()->encoders()[stream], Encode(_, _, _))
+          .WillOnce(
+              ::testing::DoAll(::testing::SaveArg<0>(&frames[stream]),
+                               Return(WEBRTC_VIDEO_CODEC_OK)));
+    }
+    EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+
+    for (size_t stream = 0; stream < 3; ++stream) {
+      EXPECT_EQ(codec_.simulcastStream[stream].width, frames[stream].width());
+      EXPECT_EQ(codec_.simulcastStream[stream].height,
+                frames[stream].height());
+    }
+    // The highest resolution stream gets the input frame as is.
+    EXPECT_EQ(input_buffer.get(), frames[2].video_frame_buffer().get());
+    for (size_t stream = 0; stream < 2; ++stream) {
+      const uint8_t* data =
+          frames[stream].video_frame_buffer()->GetI420()->DataY();
+      // The buffers of the scaled frames are reused once released.
+      if (i > 0)
+        EXPECT_EQ(scaled_data[stream], data);
+      scaled_data[stream] = data;
+    }
+  }
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/vaapiencoderfactory.h"
+
+#include <utility>
+
+#include "api/video_codecs/sdp_video_format.h"
+#include "media/base/codec.h"
+#include "media/base/mediaconstants.h"
+#include "modules/video_coding/codecs/h264/include/h264.h"
+
+namespace webrtc {
+
+VaapiEncoderFactory::VaapiEncoderFactory(
+    std::unique_ptr<VideoEncoderFactory> fallback_factory)
+    : fallback_factory_(std::move(fallback_factory)),
+      hardware_supported_(IsH264VaapiEncoderSupported()) {}
+
+VaapiEncoderFactory::~VaapiEncoderFactory() = default;
+
+std::vector<SdpVideoFormat> VaapiEncoderFactory::GetSupportedFormats() const {
+  std::vector<SdpVideoFormat> formats;
+  if (hardware_supported_)
+    formats = SupportedH264Codecs();
+  for (const SdpVideoFormat& format :
+       fallback_factory_->GetSupportedFormats()) {
+    if (!IsHardwareFormat(format))
+      formats.push_back(format);
+  }
+  return formats;
+}
+
+VideoEncoderFactory::CodecInfo VaapiEncoderFactory::QueryVideoEncoder(
+    const SdpVideoFormat& format) const {
+  if (!IsHardwareFormat(format))
+    return fallback_factory_->QueryVideoEncoder(format);
+  CodecInfo info;
+  info.is_hardware_accelerated = true;
+  info.has_internal_source = false;
+  return info;
+}
+
+std::unique_ptr<VideoEncoder> VaapiEncoderFactory::CreateVideoEncoder(
+    const SdpVideoFormat& format) {
+  if (!IsHardwareFormat(format))
+    return fallback_factory_->CreateVideoEncoder(format);
+  return CreateH264VaapiEncoder(cricket::VideoCodec(format));
+}
+
+bool VaapiEncoderFactory::IsHardwareFormat(
+    const SdpVideoFormat& format) const {
+  return hardware_supported_ &&
+         cricket::CodecNamesEq(format.name, cricket::kH264CodecName);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_ENGINE_VAAPIENCODERFACTORY_H_
+#define MEDIA_ENGINE_VAAPIENCODERFACTORY_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/video_codecs/video_encoder_factory.h"
+
+namespace webrtc {
+
+// Offers H.264 encoded with the VAAPI hardware encoder when one is available,
+// and the formats of |fallback_factory| otherwise or for other codecs. The
+// hardware encoder encodes a single stream; SimulcastEncoderAdapter can take
+// this factory to encode simulcast with one hardware encoder per layer.
+class VaapiEncoderFactory : public VideoEncoderFactory {
+ public:
+  explicit VaapiEncoderFactory(
+      std::unique_ptr<VideoEncoderFactory> fallback_factory);
+  ~VaapiEncoderFactory() override;
+
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override;
+  CodecInfo QueryVideoEncoder(const SdpVideoFormat& format) const override;
+  std::unique_ptr<VideoEncoder> CreateVideoEncoder(
+      const SdpVideoFormat& format) override;
+
+ private:
+  bool IsHardwareFormat(const SdpVideoFormat& format) const;
+
+  const std::unique_ptr<VideoEncoderFactory> fallback_factory_;
+  // Probed once at construction, since it opens the device.
+  const bool hardware_supported_;
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_ENGINE_VAAPIENCODERFACTORY_H_
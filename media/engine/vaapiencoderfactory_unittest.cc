@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/vaapiencoderfactory.h"
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_encoder.h"
+#include "media/base/mediaconstants.h"
+#include "media/engine/internalencoderfactory.h"
+#include "modules/video_coding/codecs/h264/include/h264.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(VaapiEncoderFactory, OffersFallbackFormatsWithoutHardware) {
+  if (IsH264VaapiEncoderSupported())
+    return;
+  VaapiEncoderFactory factory(absl::make_unique<InternalEncoderFactory>());
+  EXPECT_EQ(InternalEncoderFactory().GetSupportedFormats(),
+            factory.GetSupportedFormats());
+  EXPECT_FALSE(
+      factory.QueryVideoEncoder(SdpVideoFormat(cricket::kVp8CodecName))
+          .is_hardware_accelerated);
+}
+
+TEST(VaapiEncoderFactory, CreatesFallbackEncoder) {
+  VaapiEncoderFactory factory(absl::make_unique<InternalEncoderFactory>());
+  std::unique_ptr<VideoEncoder> encoder =
+      factory.CreateVideoEncoder(SdpVideoFormat(cricket::kVp8CodecName));
+  EXPECT_TRUE(encoder);
+}
+
+TEST(VaapiEncoderFactory, H264IsHardwareAcceleratedWhenSupported) {
+  if (!IsH264VaapiEncoderSupported())
+    return;
+  VaapiEncoderFactory factory(absl::make_unique<InternalEncoderFactory>());
+  EXPECT_TRUE(
+      factory.QueryVideoEncoder(SdpVideoFormat(cricket::kH264CodecName))
+          .is_hardware_accelerated);
+}
+
+}  // namespace webrtc
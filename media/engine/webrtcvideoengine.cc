@@ -31,9 +31,11 @@
 #include "media/engine/simulcast.h"
 #include "media/engine/webrtcmediaengine.h"
 #include "media/engine/webrtcvoiceengine.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/copyonwritebuffer.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/stringencode.h"
 #include "rtc_base/stringutils.h"
 #include "rtc_base/timeutils.h"
 #include "rtc_base/trace_event.h"
@@ -172,6 +174,13 @@ bool IsFlexfecAdvertisedFieldTrialEnabled() {
   return webrtc::field_trial::IsEnabled("WebRTC-FlexFEC-03-Advertised");
 }
 
+// If this field trial is enabled, the advertised "flexfec-03" codec asks the
+// remote to protect its video with 2D parity FEC, which recovers from burst
+// losses that the default masks can't.
+bool IsFlexfec2DParityFieldTrialEnabled() {
+  return webrtc::field_trial::IsEnabled("WebRTC-FlexFEC-03-2DParity");
+}
+
 void AddDefaultFeedbackParams(VideoCodec* codec) {
   // Don't add any feedback params for RED and ULPFEC.
   if (codec->name == kRedCodecName || codec->name == kUlpfecCodecName)
@@ -209,6 +218,10 @@ std::vector<VideoCodec> AssignPayloadTypesAndDefaultCodecs(
     // we never use the actual value anywhere in our code however.
     // TODO(brandtr): Consider honouring this value in the sender and receiver.
     flexfec_format.parameters = {{kFlexfecFmtpRepairWindow, "10000000"}};
+    if (IsFlexfec2DParityFieldTrialEnabled()) {
+      flexfec_format.parameters[kFlexfecFmtpTypeOfProtection] =
+          rtc::ToString(kFlexfecTypeOfProtection2DParity);
+    }
     input_formats.push_back(flexfec_format);
   }
 
@@ -1244,6 +1257,7 @@ bool WebRtcVideoChannel::AddRecvStream(const StreamParams& sp,
   // TODO(nisse): Rename config variable to avoid negation.
   config.disable_prerenderer_smoothing =
       !video_config_.enable_prerenderer_smoothing;
+  config.prewarm_decoder = video_config_.prewarm_decoders;
   if (!sp.stream_ids().empty()) {
     config.sync_group = sp.stream_ids()[0];
   }
@@ -1441,7 +1455,24 @@ void WebRtcVideoChannel::OnPacketReceived(rtc::CopyOnWriteBuffer* packet,
     case webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC:
       break;
   }
+  OnUnknownSsrcPacket(packet, packet_time);
+}
+
+void WebRtcVideoChannel::OnRtpPacketReceived(
+    const webrtc::RtpPacketReceived& packet,
+    const rtc::PacketTime& packet_time) {
+  if (call_->Receiver()->DeliverRtpPacket(webrtc::MediaType::VIDEO, packet,
+                                          packet_time.timestamp) !=
+      webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC) {
+    return;
+  }
+  rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+  OnUnknownSsrcPacket(&buffer, packet_time);
+}
 
+void WebRtcVideoChannel::OnUnknownSsrcPacket(
+    rtc::CopyOnWriteBuffer* packet,
+    const rtc::PacketTime& packet_time) {
   uint32_t ssrc = 0;
   if (!GetRtpSsrc(packet->cdata(), packet->size(), &ssrc)) {
     return;
@@ -1726,6 +1757,8 @@ void WebRtcVideoChannel::WebRtcVideoSendStream::SetCodec(
   parameters_.config.rtp.ulpfec = codec_settings.ulpfec;
   parameters_.config.rtp.flexfec.payload_type =
       codec_settings.flexfec_payload_type;
+  parameters_.config.rtp.flexfec.two_dimensional_parity =
+      codec_settings.flexfec_two_dimensional_parity;
 
   // Set RTX payload type if RTX is enabled.
   if (!parameters_.config.rtp.rtx.ssrcs.empty()) {
@@ -2577,12 +2610,16 @@ WebRtcVideoChannel::WebRtcVideoReceiveStream::GetVideoReceiverInfo(
 }
 
 WebRtcVideoChannel::VideoCodecSettings::VideoCodecSettings()
-    : flexfec_payload_type(-1), rtx_payload_type(-1) {}
+    : flexfec_payload_type(-1),
+      flexfec_two_dimensional_parity(false),
+      rtx_payload_type(-1) {}
 
 bool WebRtcVideoChannel::VideoCodecSettings::operator==(
     const WebRtcVideoChannel::VideoCodecSettings& other) const {
   return codec == other.codec && ulpfec == other.ulpfec &&
          flexfec_payload_type == other.flexfec_payload_type &&
+         flexfec_two_dimensional_parity ==
+             other.flexfec_two_dimensional_parity &&
          rtx_payload_type == other.rtx_payload_type;
 }
 
@@ -2610,6 +2647,7 @@ WebRtcVideoChannel::MapCodecs(const std::vector<VideoCodec>& codecs) {
 
   webrtc::UlpfecConfig ulpfec_config;
   int flexfec_payload_type = -1;
+  bool flexfec_two_dimensional_parity = false;
 
   for (size_t i = 0; i < codecs.size(); ++i) {
     const VideoCodec& in_codec = codecs[i];
@@ -2642,6 +2680,11 @@ WebRtcVideoChannel::MapCodecs(const std::vector<VideoCodec>& codecs) {
         // FlexFEC payload type, should not have duplicates.
         RTC_DCHECK_EQ(-1, flexfec_payload_type);
         flexfec_payload_type = in_codec.id;
+        int type_of_protection;
+        flexfec_two_dimensional_parity =
+            in_codec.GetParam(kFlexfecFmtpTypeOfProtection,
+                              &type_of_protection) &&
+            type_of_protection == kFlexfecTypeOfProtection2DParity;
         continue;
       }
 
@@ -2692,6 +2735,8 @@ WebRtcVideoChannel::MapCodecs(const std::vector<VideoCodec>& codecs) {
   for (size_t i = 0; i < video_codecs.size(); ++i) {
     video_codecs[i].ulpfec = ulpfec_config;
     video_codecs[i].flexfec_payload_type = flexfec_payload_type;
+    video_codecs[i].flexfec_two_dimensional_parity =
+        flexfec_two_dimensional_parity;
     if (rtx_mapping[video_codecs[i].codec.id] != 0 &&
         rtx_mapping[video_codecs[i].codec.id] !=
             ulpfec_config.red_payload_type) {
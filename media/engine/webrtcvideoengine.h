@@ -151,6 +151,8 @@ class WebRtcVideoChannel : public VideoMediaChannel, public webrtc::Transport {
 
   void OnPacketReceived(rtc::CopyOnWriteBuffer* packet,
                         const rtc::PacketTime& packet_time) override;
+  void OnRtpPacketReceived(const webrtc::RtpPacketReceived& packet,
+                           const rtc::PacketTime& packet_time) override;
   void OnRtcpReceived(rtc::CopyOnWriteBuffer* packet,
                       const rtc::PacketTime& packet_time) override;
   void OnReadyToSend(bool ready) override;
@@ -186,14 +188,16 @@ class WebRtcVideoChannel : public VideoMediaChannel, public webrtc::Transport {
     bool operator==(const VideoCodecSettings& other) const;
     bool operator!=(const VideoCodecSettings& other) const;
 
-    // Checks if all members of |a|, except |flexfec_payload_type|, are equal
-    // to the corresponding members of |b|.
+    // Checks if all members of |a|, except the FlexFEC ones, are equal to the
+    // corresponding members of |b|.
     static bool EqualsDisregardingFlexfec(const VideoCodecSettings& a,
                                           const VideoCodecSettings& b);
 
     VideoCodec codec;
     webrtc::UlpfecConfig ulpfec;
     int flexfec_payload_type;
+    // Set if the remote FlexFEC format asks for 2D parity protection.
+    bool flexfec_two_dimensional_parity;
     int rtx_payload_type;
   };
 
@@ -224,6 +228,10 @@ class WebRtcVideoChannel : public VideoMediaChannel, public webrtc::Transport {
 
   void SetMaxSendBandwidth(int bps);
 
+  // Handles a packet that Call didn't find a receive stream for.
+  void OnUnknownSsrcPacket(rtc::CopyOnWriteBuffer* packet,
+                           const rtc::PacketTime& packet_time);
+
   void ConfigureReceiverRtp(
       webrtc::VideoReceiveStream::Config* config,
       webrtc::FlexfecReceiveStream::Config* flexfec_config,
@@ -3867,6 +3867,27 @@ TEST_F(WebRtcVideoChannelFlexfecSendRecvTest,
       << "SetSendCodec without FlexFEC should disable current FlexFEC.";
 }
 
+TEST_F(WebRtcVideoChannelFlexfecSendRecvTest,
+       SetSendCodecsWithFlexfec2DParityEnablesIt) {
+  cricket::VideoSendParameters parameters;
+  parameters.codecs.push_back(GetEngineCodec("VP8"));
+  parameters.codecs.push_back(GetEngineCodec("flexfec-03"));
+  ASSERT_TRUE(channel_->SetSendParameters(parameters));
+
+  FakeVideoSendStream* stream = AddSendStream(
+      CreatePrimaryWithFecFrStreamParams("cname", kSsrcs1[0], kFlexfecSsrc));
+  webrtc::VideoSendStream::Config config = stream->GetConfig().Copy();
+  EXPECT_FALSE(config.rtp.flexfec.two_dimensional_parity);
+
+  parameters.codecs.back().SetParam(kFlexfecFmtpTypeOfProtection,
+                                    kFlexfecTypeOfProtection2DParity);
+  ASSERT_TRUE(channel_->SetSendParameters(parameters));
+  stream = fake_call_->GetVideoSendStreams()[0];
+  config = stream->GetConfig().Copy();
+  EXPECT_EQ(GetEngineCodec("flexfec-03").id, config.rtp.flexfec.payload_type);
+  EXPECT_TRUE(config.rtp.flexfec.two_dimensional_parity);
+}
+
 TEST_F(WebRtcVideoChannelTest, SetSendCodecsChangesExistingStreams) {
   cricket::VideoSendParameters parameters;
   cricket::VideoCodec codec(100, "VP8");
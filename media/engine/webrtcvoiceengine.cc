@@ -32,6 +32,7 @@
 #include "modules/audio_mixer/audio_mixer_impl.h"
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
 #include "modules/audio_processing/include/audio_processing.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/byteorder.h"
 #include "rtc_base/constructormagic.h"
@@ -678,6 +679,10 @@ AudioCodecs WebRtcVoiceEngine::CollectCodecs(
   // Only generate telephone-event payload types for these clockrates:
   std::map<int, bool, std::greater<int>> generate_dtmf = {
       {8000, false}, {16000, false}, {32000, false}, {48000, false}};
+  // Only generate a RED payload type for Opus, and only if enabled.
+  bool generate_red = false;
+  const bool red_enabled =
+      webrtc::field_trial::IsEnabled("WebRTC-Audio-Red-For-Opus");
 
   auto map_format = [&mapper](const webrtc::SdpAudioFormat& format,
                               AudioCodecs* out) {
@@ -719,10 +724,20 @@ AudioCodecs WebRtcVoiceEngine::CollectCodecs(
         dtmf->second = true;
       }
 
+      if (red_enabled && IsCodec(codec, kOpusCodecName)) {
+        generate_red = true;
+      }
+
       out.push_back(codec);
     }
   }
 
+  // Add RED for Opus after the "proper" audio codecs, so that it's never
+  // preferred as the send codec.
+  if (generate_red) {
+    map_format({kRedCodecName, 48000, 2}, &out);
+  }
+
   // Add CN codecs after "proper" audio codecs.
   for (const auto& cn : generate_cn) {
     if (cn.second) {
@@ -1548,6 +1563,7 @@ bool WebRtcVoiceMediaChannel::SetRecvCodecs(
     }
     auto format = AudioCodecToSdpAudioFormat(codec);
     if (!IsCodec(codec, "cn") && !IsCodec(codec, "telephone-event") &&
+        !IsCodec(codec, kRedCodecName) &&
         !engine()->decoder_factory_->IsSupportedDecoder(format)) {
       RTC_LOG(LS_ERROR) << "Unsupported codec: " << rtc::ToString(format);
       return false;
@@ -1698,6 +1714,17 @@ bool WebRtcVoiceMediaChannel::SetSendCodecs(
     }
   }
 
+  // Find a RED codec matching the send codec, to send the previous encodings
+  // along with each new one.
+  for (const AudioCodec& red_codec : codecs) {
+    if (IsCodec(red_codec, kRedCodecName) &&
+        red_codec.clockrate == send_codec_spec->format.clockrate_hz &&
+        red_codec.channels == send_codec_spec->format.num_channels) {
+      send_codec_spec->red_payload_type = red_codec.id;
+      break;
+    }
+  }
+
   if (send_codec_spec_ != send_codec_spec) {
     send_codec_spec_ = std::move(send_codec_spec);
     // Apply new settings to all streams.
@@ -2014,7 +2041,26 @@ void WebRtcVoiceMediaChannel::OnPacketReceived(
   if (delivery_result != webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC) {
     return;
   }
+  OnUnknownSsrcPacket(packet, packet_time);
+}
 
+void WebRtcVoiceMediaChannel::OnRtpPacketReceived(
+    const webrtc::RtpPacketReceived& packet,
+    const rtc::PacketTime& packet_time) {
+  RTC_DCHECK(worker_thread_checker_.CalledOnValidThread());
+
+  if (call_->Receiver()->DeliverRtpPacket(webrtc::MediaType::AUDIO, packet,
+                                          packet_time.timestamp) !=
+      webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC) {
+    return;
+  }
+  rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+  OnUnknownSsrcPacket(&buffer, packet_time);
+}
+
+void WebRtcVoiceMediaChannel::OnUnknownSsrcPacket(
+    rtc::CopyOnWriteBuffer* packet,
+    const rtc::PacketTime& packet_time) {
   // Create an unsignaled receive stream for this previously not received ssrc.
   // If there already is N unsignaled receive streams, delete the oldest.
   // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=5208
@@ -2062,8 +2108,9 @@ void WebRtcVoiceMediaChannel::OnPacketReceived(
     SetRawAudioSink(ssrc, std::move(proxy_sink));
   }
 
-  delivery_result = call_->Receiver()->DeliverPacket(
-      webrtc::MediaType::AUDIO, *packet, packet_time.timestamp);
+  webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO, *packet,
+                                       packet_time.timestamp);
   RTC_DCHECK_NE(webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC, delivery_result);
 }
 
@@ -2193,6 +2240,7 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
     rinfo.jitter_ms = stats.jitter_ms;
     rinfo.jitter_buffer_ms = stats.jitter_buffer_ms;
     rinfo.jitter_buffer_preferred_ms = stats.jitter_buffer_preferred_ms;
+    rinfo.jitter_buffer_memory_bytes = stats.jitter_buffer_memory_bytes;
     rinfo.delay_estimate_ms = stats.delay_estimate_ms;
     rinfo.audio_level = stats.audio_level;
     rinfo.total_output_energy = stats.total_output_energy;
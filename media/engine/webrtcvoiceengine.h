@@ -180,6 +180,8 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
 
   void OnPacketReceived(rtc::CopyOnWriteBuffer* packet,
                         const rtc::PacketTime& packet_time) override;
+  void OnRtpPacketReceived(const webrtc::RtpPacketReceived& packet,
+                           const rtc::PacketTime& packet_time) override;
   void OnRtcpReceived(rtc::CopyOnWriteBuffer* packet,
                       const rtc::PacketTime& packet_time) override;
   void OnNetworkRouteChanged(const std::string& transport_name,
@@ -226,6 +228,10 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   webrtc::RTCError ValidateRtpParameters(
       const webrtc::RtpParameters& parameters);
   void SetupRecording();
+  // Creates an unsignaled receive stream for a packet that Call didn't find a
+  // receive stream for, and delivers the packet to it.
+  void OnUnknownSsrcPacket(rtc::CopyOnWriteBuffer* packet,
+                           const rtc::PacketTime& packet_time);
   // Check if 'ssrc' is an unsignaled stream, and if so mark it as not being
   // unsignaled anymore (i.e. it is now removed, or signaled), and return true.
   bool MaybeDeregisterUnsignaledRecvStream(uint32_t ssrc);
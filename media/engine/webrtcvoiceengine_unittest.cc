@@ -54,6 +54,7 @@ const cricket::AudioCodec kG722CodecVoE(9, "G722", 16000, 64000, 1);
 const cricket::AudioCodec kG722CodecSdp(9, "G722", 8000, 64000, 1);
 const cricket::AudioCodec kCn8000Codec(13, "CN", 8000, 0, 1);
 const cricket::AudioCodec kCn16000Codec(105, "CN", 16000, 0, 1);
+const cricket::AudioCodec kRedCodec(63, "red", 48000, 0, 2);
 const cricket::AudioCodec kTelephoneEventCodec1(106,
                                                 "telephone-event",
                                                 8000,
@@ -1876,6 +1877,23 @@ TEST_F(WebRtcVoiceEngineTestFake, SetSendCodecsCNOnTop) {
   EXPECT_EQ(98, send_codec_spec.cng_payload_type);
 }
 
+// Test that RED is used with a send codec of the same clockrate and channels.
+TEST_F(WebRtcVoiceEngineTestFake, SetSendCodecsRed) {
+  EXPECT_TRUE(SetupSendStream());
+  cricket::AudioSendParameters parameters;
+  parameters.codecs.push_back(kOpusCodec);
+  parameters.codecs.push_back(kRedCodec);
+  SetSendParameters(parameters);
+  const auto& send_codec_spec = *GetSendStreamConfig(kSsrcX).send_codec_spec;
+  EXPECT_EQ(111, send_codec_spec.payload_type);
+  EXPECT_EQ(63, send_codec_spec.red_payload_type);
+
+  parameters.codecs[0] = kIsacCodec;
+  SetSendParameters(parameters);
+  EXPECT_EQ(absl::nullopt,
+            GetSendStreamConfig(kSsrcX).send_codec_spec->red_payload_type);
+}
+
 // Test that we set VAD and DTMF types correctly as caller.
 TEST_F(WebRtcVoiceEngineTestFake, SetSendCodecsCNandDTMFAsCaller) {
   EXPECT_TRUE(SetupSendStream());
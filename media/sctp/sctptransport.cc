@@ -25,6 +25,8 @@ enum PreservedErrno {
 
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "media/base/codec.h"
 #include "media/base/mediaconstants.h"
@@ -259,12 +261,8 @@ class SctpTransport::UsrSctpWrapper {
 
     VerboseLogPacket(data, length, SCTP_DUMP_OUTBOUND);
     // Note: We have to copy the data; the caller will delete it.
-    rtc::CopyOnWriteBuffer buf(reinterpret_cast<uint8_t*>(data), length);
-    // TODO(deadbeef): Why do we need an AsyncInvoke here? We're already on the
-    // right thread and don't need to unwind the stack.
-    transport->invoker_.AsyncInvoke<void>(
-        RTC_FROM_HERE, transport->network_thread_,
-        rtc::Bind(&SctpTransport::OnPacketFromSctpToNetwork, transport, buf));
+    transport->QueueOutboundPacket(
+        rtc::CopyOnWriteBuffer(reinterpret_cast<uint8_t*>(data), length));
     return 0;
   }
 
@@ -320,14 +318,12 @@ class SctpTransport::UsrSctpWrapper {
       params.timestamp = rcv.rcv_tsn;
       params.type = type;
 
-      // The ownership of the packet transfers to |invoker_|. Using
-      // CopyOnWriteBuffer is the most convenient way to do this.
-      transport->invoker_.AsyncInvoke<void>(
-          RTC_FROM_HERE, transport->network_thread_,
-          rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
-                    transport, transport->partial_message_, params, flags));
-
-      transport->partial_message_.Clear();
+      // Hand the whole message over rather than clearing it and having the
+      // next one reallocate a buffer of the same capacity. The next message
+      // reuses the storage of one that was delivered, if any.
+      rtc::CopyOnWriteBuffer message;
+      swap(message, transport->partial_message_);
+      transport->QueueInboundPacket(std::move(message), params, flags);
     }
     return 1;
   }
@@ -379,6 +375,14 @@ SctpTransport::SctpTransport(rtc::Thread* network_thread,
   ConnectTransportSignals();
 }
 
+void SctpTransport::SetBufferSizes(int send_buffer_size,
+                                   int receive_buffer_size) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  RTC_DCHECK(!sock_);
+  send_buffer_size_ = send_buffer_size;
+  receive_buffer_size_ = receive_buffer_size;
+}
+
 SctpTransport::~SctpTransport() {
   // Close abruptly; no reset procedure.
   CloseSctpSocket();
@@ -648,11 +652,14 @@ bool SctpTransport::OpenSctpSocket() {
   // If kSendBufferSize isn't reflective of reality, we log an error, but we
   // still have to do something reasonable here.  Look up what the buffer's
   // real size is and set our threshold to something reasonable.
-  static const int kSendThreshold = usrsctp_sysctl_get_sctp_sendspace() / 2;
+  const int send_threshold =
+      (send_buffer_size_ > 0 ? send_buffer_size_
+                             : usrsctp_sysctl_get_sctp_sendspace()) /
+      2;
 
   sock_ = usrsctp_socket(
       AF_CONN, SOCK_STREAM, IPPROTO_SCTP, &UsrSctpWrapper::OnSctpInboundPacket,
-      &UsrSctpWrapper::SendThresholdCallback, kSendThreshold, this);
+      &UsrSctpWrapper::SendThresholdCallback, send_threshold, this);
   if (!sock_) {
     RTC_LOG_ERRNO(LS_ERROR) << debug_name_ << "->OpenSctpSocket(): "
                             << "Failed to create SCTP socket.";
@@ -696,6 +703,21 @@ bool SctpTransport::ConfigureSctpSocket() {
     return false;
   }
 
+  if (send_buffer_size_ > 0 &&
+      usrsctp_setsockopt(sock_, SOL_SOCKET, SO_SNDBUF, &send_buffer_size_,
+                         sizeof(send_buffer_size_))) {
+    RTC_LOG_ERRNO(LS_ERROR) << debug_name_ << "->ConfigureSctpSocket(): "
+                            << "Failed to set SO_SNDBUF.";
+    return false;
+  }
+  if (receive_buffer_size_ > 0 &&
+      usrsctp_setsockopt(sock_, SOL_SOCKET, SO_RCVBUF, &receive_buffer_size_,
+                         sizeof(receive_buffer_size_))) {
+    RTC_LOG_ERRNO(LS_ERROR) << debug_name_ << "->ConfigureSctpSocket(): "
+                            << "Failed to set SO_RCVBUF.";
+    return false;
+  }
+
   // Enable stream ID resets.
   struct sctp_assoc_value stream_rst;
   stream_rst.assoc_id = SCTP_ALL_ASSOC;
@@ -892,6 +914,75 @@ sockaddr_conn SctpTransport::GetSctpSockAddr(int port) {
   return sconn;
 }
 
+void SctpTransport::QueueOutboundPacket(rtc::CopyOnWriteBuffer buffer) {
+  rtc::CritScope cs(&queue_crit_);
+  outbound_packets_.push_back(std::move(buffer));
+  if (outbound_packets_.size() == 1) {
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, network_thread_,
+        rtc::Bind(&SctpTransport::SendQueuedOutboundPackets, this));
+  }
+}
+
+void SctpTransport::SendQueuedOutboundPackets() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  {
+    rtc::CritScope cs(&queue_crit_);
+    packets.swap(outbound_packets_);
+  }
+  for (const rtc::CopyOnWriteBuffer& packet : packets) {
+    OnPacketFromSctpToNetwork(packet);
+  }
+}
+
+void SctpTransport::QueueInboundPacket(rtc::CopyOnWriteBuffer buffer,
+                                       const ReceiveDataParams& params,
+                                       int flags) {
+  const size_t capacity = buffer.capacity();
+  {
+    rtc::CritScope cs(&queue_crit_);
+    inbound_packets_.push_back({std::move(buffer), params, flags});
+    if (inbound_packets_.size() == 1) {
+      invoker_.AsyncInvoke<void>(
+          RTC_FROM_HERE, network_thread_,
+          rtc::Bind(&SctpTransport::DeliverQueuedInboundPackets, this));
+    }
+    if (partial_message_.capacity() == 0)
+      swap(partial_message_, recycled_inbound_buffer_);
+  }
+  // Without a recycled buffer, reserve what the last message needed, so that
+  // the next one isn't grown chunk by chunk.
+  partial_message_.EnsureCapacity(capacity);
+}
+
+void SctpTransport::DeliverQueuedInboundPackets() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  std::vector<InboundPacket> packets;
+  {
+    rtc::CritScope cs(&queue_crit_);
+    packets.swap(inbound_packets_);
+  }
+  for (const InboundPacket& packet : packets) {
+    OnInboundPacketFromSctpToTransport(packet.buffer, packet.params,
+                                       packet.flags);
+  }
+  // Keep the largest buffer that the receivers didn't hold on to.
+  rtc::CopyOnWriteBuffer* recycled = nullptr;
+  for (InboundPacket& packet : packets) {
+    if (!packet.buffer.IsShared() &&
+        (!recycled || packet.buffer.capacity() > recycled->capacity())) {
+      recycled = &packet.buffer;
+    }
+  }
+  if (recycled) {
+    recycled->Clear();
+    rtc::CritScope cs(&queue_crit_);
+    if (recycled->capacity() > recycled_inbound_buffer_.capacity())
+      swap(*recycled, recycled_inbound_buffer_);
+  }
+}
+
 void SctpTransport::OnPacketFromSctpToNetwork(
     const rtc::CopyOnWriteBuffer& buffer) {
   RTC_DCHECK_RUN_ON(network_thread_);
@@ -17,11 +17,13 @@
 #include <memory>  // for unique_ptr.
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "rtc_base/asyncinvoker.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
 // For SendDataParams/ReceiveDataParams.
@@ -45,7 +47,7 @@ struct SctpInboundPacket;
 //  2.  usrsctp_sendv(data)
 // [network thread returns; sctp thread then calls the following]
 //  3.  OnSctpOutboundPacket(wrapped_data)
-// [sctp thread returns having async invoked on the network thread]
+// [sctp thread returns having queued the packet for the network thread]
 //  4.  SctpTransport::OnPacketFromSctpToNetwork(wrapped_data)
 //  5.  DtlsTransport::SendPacket(wrapped_data)
 //  6.  ... across network ... a packet is sent back ...
@@ -53,7 +55,7 @@ struct SctpInboundPacket;
 //  8.  usrsctp_conninput(wrapped_data)
 // [network thread returns; sctp thread then calls the following]
 //  9.  OnSctpInboundData(data)
-// [sctp thread returns having async invoked on the network thread]
+// [sctp thread returns having queued the data for the network thread]
 //  10. SctpTransport::OnInboundPacketFromSctpToTransport(inboundpacket)
 //  11. SctpTransport::OnDataFromSctpToTransport(data)
 //  12. SctpTransport::SignalDataReceived(data)
@@ -71,6 +73,11 @@ class SctpTransport : public SctpTransportInternal,
                 rtc::PacketTransportInternal* channel);
   ~SctpTransport() override;
 
+  // Sets the sizes of the SCTP socket send and receive buffers, which bound
+  // how much data can be in flight; 0 keeps the usrsctp default. Must be
+  // called before Start.
+  void SetBufferSizes(int send_buffer_size, int receive_buffer_size);
+
   // SctpTransportInternal overrides (see sctptransportinternal.h for comments).
   void SetDtlsTransport(rtc::PacketTransportInternal* transport) override;
   bool Start(int local_port, int remote_port) override;
@@ -120,9 +127,21 @@ class SctpTransport : public SctpTransportInternal,
   void OnSendThresholdCallback();
   sockaddr_conn GetSctpSockAddr(int port);
 
-  // Called using |invoker_| to send packet on the network.
+  // usrsctp hands packets and messages over from whichever thread it runs
+  // on by queuing them; these are called using |invoker_| to take everything
+  // queued since the last call, so a burst costs a single task.
+  void QueueOutboundPacket(rtc::CopyOnWriteBuffer buffer);
+  void SendQueuedOutboundPackets();
+  // Also gives |partial_message_| a recycled buffer, if there is one, or at
+  // least the capacity of |buffer|.
+  void QueueInboundPacket(rtc::CopyOnWriteBuffer buffer,
+                          const ReceiveDataParams& params,
+                          int flags);
+  void DeliverQueuedInboundPackets();
+
+  // Sends a packet from usrsctp on the network.
   void OnPacketFromSctpToNetwork(const rtc::CopyOnWriteBuffer& buffer);
-  // Called using |invoker_| to decide what to do with the packet.
+  // Decides what to do with a packet from usrsctp.
   // The |flags| parameter is used by SCTP to distinguish notification packets
   // from other types of packets.
   void OnInboundPacketFromSctpToTransport(const rtc::CopyOnWriteBuffer& buffer,
@@ -140,6 +159,20 @@ class SctpTransport : public SctpTransportInternal,
   rtc::Thread* network_thread_;
   // Helps pass inbound/outbound packets asynchronously to the network thread.
   rtc::AsyncInvoker invoker_;
+
+  struct InboundPacket {
+    rtc::CopyOnWriteBuffer buffer;
+    ReceiveDataParams params;
+    int flags;
+  };
+  rtc::CriticalSection queue_crit_;
+  std::vector<rtc::CopyOnWriteBuffer> outbound_packets_
+      RTC_GUARDED_BY(queue_crit_);
+  std::vector<InboundPacket> inbound_packets_ RTC_GUARDED_BY(queue_crit_);
+  // Storage of a delivered message that no one kept, for the next
+  // |partial_message_| to reuse.
+  rtc::CopyOnWriteBuffer recycled_inbound_buffer_ RTC_GUARDED_BY(queue_crit_);
+
   // Underlying DTLS channel.
   rtc::PacketTransportInternal* transport_ = nullptr;
 
@@ -148,6 +181,9 @@ class SctpTransport : public SctpTransportInternal,
   rtc::CopyOnWriteBuffer partial_message_;
   int partial_message_sid_;
 
+  int send_buffer_size_ = 0;
+  int receive_buffer_size_ = 0;
+
   bool was_ever_writable_ = false;
   int local_port_ = kSctpDefaultPort;
   int remote_port_ = kSctpDefaultPort;
@@ -215,14 +251,25 @@ class SctpTransportFactory : public SctpTransportInternalFactory {
   explicit SctpTransportFactory(rtc::Thread* network_thread)
       : network_thread_(network_thread) {}
 
+  // See SctpTransport::SetBufferSizes; applies to the transports created
+  // since.
+  void SetBufferSizes(int send_buffer_size, int receive_buffer_size) {
+    send_buffer_size_ = send_buffer_size;
+    receive_buffer_size_ = receive_buffer_size;
+  }
+
   std::unique_ptr<SctpTransportInternal> CreateSctpTransport(
       rtc::PacketTransportInternal* transport) override {
-    return std::unique_ptr<SctpTransportInternal>(
+    std::unique_ptr<SctpTransport> sctp_transport(
         new SctpTransport(network_thread_, transport));
+    sctp_transport->SetBufferSizes(send_buffer_size_, receive_buffer_size_);
+    return std::move(sctp_transport);
   }
 
  private:
   rtc::Thread* network_thread_;
+  int send_buffer_size_ = 0;
+  int receive_buffer_size_ = 0;
 };
 
 }  // namespace cricket
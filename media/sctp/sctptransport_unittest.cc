@@ -25,6 +25,7 @@
 #include "rtc_base/helpers.h"
 #include "rtc_base/ssladapter.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/timeutils.h"
 
 namespace {
 static const int kDefaultTimeout = 10000;  // 10 seconds.
@@ -97,6 +98,20 @@ class SctpTransportObserver : public sigslot::has_slots<> {
   bool ready_to_send_ = false;
 };
 
+// Counts the bytes of all the data received.
+class SctpByteCounter : public sigslot::has_slots<> {
+ public:
+  void OnDataReceived(const ReceiveDataParams& params,
+                      const rtc::CopyOnWriteBuffer& data) {
+    bytes_ += data.size();
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
 // Helper class used to immediately attempt to reopen a stream as soon as it's
 // been closed.
 class SignalTransportClosedReopener : public sigslot::has_slots<> {
@@ -447,6 +462,38 @@ TEST_F(SctpTransportTest, SendDataBlocked) {
   EXPECT_EQ(SDR_BLOCK, result);
 }
 
+// Measures the throughput between two transports connected over fake DTLS
+// transports, sending as fast as the SCTP send buffer allows.
+TEST_F(SctpTransportTest, DISABLED_SendDataThroughput) {
+  SetupConnectedTransportsWithTwoStreams();
+  EXPECT_EQ_WAIT(1, transport1_ready_to_send_count(), kDefaultTimeout);
+
+  SctpByteCounter counter;
+  transport2()->SignalDataReceived.connect(&counter,
+                                           &SctpByteCounter::OnDataReceived);
+
+  const size_t kMessageSize = 64 * 1024;
+  const size_t kTotalSize = 64 * 1024 * 1024;
+  SendDataParams params;
+  params.sid = 1;
+  rtc::CopyOnWriteBuffer message(kMessageSize);
+  memset(message.data<uint8_t>(), 0, kMessageSize);
+  SendDataResult result;
+  int64_t start_us = rtc::TimeMicros();
+  for (size_t bytes_sent = 0; bytes_sent < kTotalSize;) {
+    if (transport1()->SendData(params, message, &result)) {
+      bytes_sent += kMessageSize;
+      continue;
+    }
+    ASSERT_EQ(SDR_BLOCK, result);
+    rtc::Thread::Current()->ProcessMessages(1);
+  }
+  EXPECT_EQ_WAIT(kTotalSize, counter.bytes(), kDefaultTimeout);
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  printf("%zu bytes in %zu byte messages: %.1f ms, %.1f Mbps\n", kTotalSize,
+         kMessageSize, elapsed_us / 1000.0, kTotalSize * 8.0 / elapsed_us);
+}
+
 // Trying to send data for a nonexistent stream should fail.
 TEST_F(SctpTransportTest, SendDataWithNonexistentStreamFails) {
   SetupConnectedTransportsWithTwoStreams();
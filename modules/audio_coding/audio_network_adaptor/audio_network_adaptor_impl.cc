@@ -51,7 +51,9 @@ AudioNetworkAdaptorImpl::AudioNetworkAdaptorImpl(
       enable_channel_adaptation_(
           webrtc::field_trial::IsEnabled("WebRTC-Audio-ChannelAdaptation")),
       enable_frame_length_adaptation_(webrtc::field_trial::IsEnabled(
-          "WebRTC-Audio-FrameLengthAdaptation")) {
+          "WebRTC-Audio-FrameLengthAdaptation")),
+      enable_complexity_adaptation_(webrtc::field_trial::IsEnabled(
+          "WebRTC-Audio-ComplexityAdaptation")) {
   RTC_DCHECK(controller_manager_);
 }
 
@@ -116,6 +118,15 @@ void AudioNetworkAdaptorImpl::SetOverhead(size_t overhead_bytes_per_packet) {
   UpdateNetworkMetrics(network_metrics);
 }
 
+void AudioNetworkAdaptorImpl::SetEncoderCpuUsage(float encoder_cpu_usage) {
+  last_metrics_.encoder_cpu_usage = encoder_cpu_usage;
+  DumpNetworkMetrics();
+
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.encoder_cpu_usage = encoder_cpu_usage;
+  UpdateNetworkMetrics(network_metrics);
+}
+
 AudioEncoderRuntimeConfig AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
   AudioEncoderRuntimeConfig config;
   for (auto& controller :
@@ -169,6 +180,9 @@ AudioEncoderRuntimeConfig AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
   if (!enable_channel_adaptation_ && config.num_channels) {
     config.num_channels.reset();
   }
+  if (!enable_complexity_adaptation_ && config.max_complexity) {
+    config.max_complexity.reset();
+  }
 
   if (debug_dump_writer_)
     debug_dump_writer_->DumpEncoderRuntimeConfig(config, rtc::TimeMillis());
@@ -52,6 +52,8 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   void SetOverhead(size_t overhead_bytes_per_packet) override;
 
+  void SetEncoderCpuUsage(float encoder_cpu_usage) override;
+
   AudioEncoderRuntimeConfig GetEncoderRuntimeConfig() override;
 
   void StartDebugDump(FILE* file_handle) override;
@@ -84,6 +86,7 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
   const bool enable_fec_adaptation_;
   const bool enable_channel_adaptation_;
   const bool enable_frame_length_adaptation_;
+  const bool enable_complexity_adaptation_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioNetworkAdaptorImpl);
 };
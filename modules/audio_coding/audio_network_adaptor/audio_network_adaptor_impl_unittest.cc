@@ -43,7 +43,8 @@ MATCHER_P(NetworkMetricsIs, metric, "") {
          arg.uplink_packet_loss_fraction ==
              metric.uplink_packet_loss_fraction &&
          arg.uplink_recoverable_packet_loss_fraction ==
-             metric.uplink_recoverable_packet_loss_fraction;
+             metric.uplink_recoverable_packet_loss_fraction &&
+         arg.encoder_cpu_usage == metric.encoder_cpu_usage;
 }
 
 MATCHER_P(IsRtcEventAnaConfigEqualTo, config, "") {
@@ -61,7 +62,8 @@ MATCHER_P(EncoderRuntimeConfigIs, config, "") {
              config.uplink_packet_loss_fraction &&
          arg.enable_fec == config.enable_fec &&
          arg.enable_dtx == config.enable_dtx &&
-         arg.num_channels == config.num_channels;
+         arg.num_channels == config.num_channels &&
+         arg.max_complexity == config.max_complexity;
 }
 
 struct AudioNetworkAdaptorStates {
@@ -177,6 +179,16 @@ TEST(AudioNetworkAdaptorImplTest, UpdateNetworkMetricsIsCalledOnSetOverhead) {
   states.audio_network_adaptor->SetOverhead(kOverhead);
 }
 
+TEST(AudioNetworkAdaptorImplTest,
+     UpdateNetworkMetricsIsCalledOnSetEncoderCpuUsage) {
+  auto states = CreateAudioNetworkAdaptor();
+  constexpr float kEncoderCpuUsage = 0.3f;
+  Controller::NetworkMetrics check;
+  check.encoder_cpu_usage = kEncoderCpuUsage;
+  SetExpectCallToUpdateNetworkMetrics(states.mock_controllers, check);
+  states.audio_network_adaptor->SetEncoderCpuUsage(kEncoderCpuUsage);
+}
+
 TEST(AudioNetworkAdaptorImplTest,
      MakeDecisionIsCalledOnGetEncoderRuntimeConfig) {
   auto states = CreateAudioNetworkAdaptor();
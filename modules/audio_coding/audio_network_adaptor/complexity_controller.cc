@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ComplexityController::Config::Config(int min_complexity,
+                                     int max_complexity,
+                                     float complexity_decreasing_cpu_usage,
+                                     float complexity_increasing_cpu_usage)
+    : min_complexity(min_complexity),
+      max_complexity(max_complexity),
+      complexity_decreasing_cpu_usage(complexity_decreasing_cpu_usage),
+      complexity_increasing_cpu_usage(complexity_increasing_cpu_usage) {}
+
+ComplexityController::ComplexityController(const Config& config)
+    : config_(config), max_complexity_(config_.max_complexity) {
+  RTC_DCHECK_LE(config_.min_complexity, config_.max_complexity);
+  RTC_DCHECK_LT(config_.complexity_increasing_cpu_usage,
+                config_.complexity_decreasing_cpu_usage);
+}
+
+ComplexityController::~ComplexityController() = default;
+
+void ComplexityController::UpdateNetworkMetrics(
+    const NetworkMetrics& network_metrics) {
+  if (!network_metrics.encoder_cpu_usage)
+    return;
+  // Each update is a new measurement, so move by at most one step per update
+  // to see the effect of the previous step first.
+  const float cpu_usage = *network_metrics.encoder_cpu_usage;
+  if (cpu_usage > config_.complexity_decreasing_cpu_usage &&
+      max_complexity_ > config_.min_complexity) {
+    --max_complexity_;
+  } else if (cpu_usage < config_.complexity_increasing_cpu_usage &&
+             max_complexity_ < config_.max_complexity) {
+    ++max_complexity_;
+  }
+}
+
+void ComplexityController::MakeDecision(AudioEncoderRuntimeConfig* config) {
+  // Decision on |max_complexity| should not have been made.
+  RTC_DCHECK(!config->max_complexity);
+  config->max_complexity = max_complexity_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+#define MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+
+#include "modules/audio_coding/audio_network_adaptor/controller.h"
+#include "rtc_base/constructormagic.h"
+
+namespace webrtc {
+
+// Keeps the encoder within a CPU budget by lowering its maximum complexity one
+// step at a time while the measured CPU usage is too high, and raising it
+// again once there is enough headroom.
+class ComplexityController final : public Controller {
+ public:
+  struct Config {
+    Config(int min_complexity,
+           int max_complexity,
+           float complexity_decreasing_cpu_usage,
+           float complexity_increasing_cpu_usage);
+    int min_complexity;
+    int max_complexity;
+    // Encoder CPU usage above which the complexity should decrease.
+    float complexity_decreasing_cpu_usage;
+    // Encoder CPU usage below which the complexity can increase.
+    float complexity_increasing_cpu_usage;
+  };
+
+  explicit ComplexityController(const Config& config);
+
+  ~ComplexityController() override;
+
+  void UpdateNetworkMetrics(const NetworkMetrics& network_metrics) override;
+
+  void MakeDecision(AudioEncoderRuntimeConfig* config) override;
+
+ private:
+  const Config config_;
+  int max_complexity_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(ComplexityController);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
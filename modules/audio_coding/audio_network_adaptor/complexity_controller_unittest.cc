@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kMinComplexity = 3;
+constexpr int kMaxComplexity = 10;
+constexpr float kComplexityDecreasingCpuUsage = 0.2f;
+constexpr float kComplexityIncreasingCpuUsage = 0.1f;
+constexpr float kMediumCpuUsage =
+    (kComplexityDecreasingCpuUsage + kComplexityIncreasingCpuUsage) / 2;
+
+std::unique_ptr<ComplexityController> CreateController() {
+  return std::unique_ptr<ComplexityController>(
+      new ComplexityController(ComplexityController::Config(
+          kMinComplexity, kMaxComplexity, kComplexityDecreasingCpuUsage,
+          kComplexityIncreasingCpuUsage)));
+}
+
+void CheckDecision(ComplexityController* controller,
+                   const absl::optional<float>& encoder_cpu_usage,
+                   int expected_max_complexity) {
+  if (encoder_cpu_usage) {
+    Controller::NetworkMetrics network_metrics;
+    network_metrics.encoder_cpu_usage = encoder_cpu_usage;
+    controller->UpdateNetworkMetrics(network_metrics);
+  }
+  AudioEncoderRuntimeConfig config;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(expected_max_complexity, config.max_complexity);
+}
+
+}  // namespace
+
+TEST(ComplexityControllerTest, OutputMaxComplexityWhenCpuUsageUnknown) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), absl::nullopt, kMaxComplexity);
+}
+
+TEST(ComplexityControllerTest, DecreaseOneStepPerUpdateForHighCpuUsage) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), 0.9f, kMaxComplexity - 1);
+  CheckDecision(controller.get(), 0.9f, kMaxComplexity - 2);
+  // Decisions without new measurements do not change the complexity.
+  CheckDecision(controller.get(), absl::nullopt, kMaxComplexity - 2);
+}
+
+TEST(ComplexityControllerTest, DoNotDecreaseBelowMinComplexity) {
+  auto controller = CreateController();
+  for (int complexity = kMaxComplexity - 1; complexity >= kMinComplexity;
+       --complexity) {
+    CheckDecision(controller.get(), 0.9f, complexity);
+  }
+  CheckDecision(controller.get(), 0.9f, kMinComplexity);
+}
+
+TEST(ComplexityControllerTest, MaintainComplexityForMediumCpuUsage) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), 0.9f, kMaxComplexity - 1);
+  CheckDecision(controller.get(), kMediumCpuUsage, kMaxComplexity - 1);
+  CheckDecision(controller.get(), kComplexityDecreasingCpuUsage,
+                kMaxComplexity - 1);
+  CheckDecision(controller.get(), kComplexityIncreasingCpuUsage,
+                kMaxComplexity - 1);
+}
+
+TEST(ComplexityControllerTest, IncreaseUpToMaxComplexityForLowCpuUsage) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), 0.9f, kMaxComplexity - 1);
+  CheckDecision(controller.get(), 0.9f, kMaxComplexity - 2);
+  CheckDecision(controller.get(), 0.0f, kMaxComplexity - 1);
+  CheckDecision(controller.get(), 0.0f, kMaxComplexity);
+  CheckDecision(controller.get(), 0.0f, kMaxComplexity);
+}
+
+}  // namespace webrtc
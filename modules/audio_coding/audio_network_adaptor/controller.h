@@ -27,6 +27,8 @@ class Controller {
     absl::optional<int> target_audio_bitrate_bps;
     absl::optional<int> rtt_ms;
     absl::optional<size_t> overhead_bytes_per_packet;
+    // Time spent encoding, as a fraction of the duration of the encoded audio.
+    absl::optional<float> encoder_cpu_usage;
   };
 
   virtual ~Controller() = default;
@@ -15,6 +15,7 @@
 
 #include "modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/channel_controller.h"
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/debug_dump_writer.h"
 #include "modules/audio_coding/audio_network_adaptor/dtx_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/fec_controller_plr_based.h"
@@ -201,6 +202,20 @@ std::unique_ptr<BitrateController> CreateBitrateController(
           initial_bitrate_bps, initial_frame_length_ms,
           fl_increase_overhead_offset, fl_decrease_overhead_offset)));
 }
+
+std::unique_ptr<ComplexityController> CreateComplexityController(
+    const audio_network_adaptor::config::ComplexityController& config) {
+  RTC_CHECK(config.has_min_complexity());
+  RTC_CHECK(config.has_max_complexity());
+  RTC_CHECK(config.has_complexity_decreasing_cpu_usage());
+  RTC_CHECK(config.has_complexity_increasing_cpu_usage());
+
+  return std::unique_ptr<ComplexityController>(
+      new ComplexityController(ComplexityController::Config(
+          config.min_complexity(), config.max_complexity(),
+          config.complexity_decreasing_cpu_usage(),
+          config.complexity_increasing_cpu_usage())));
+}
 #endif  // WEBRTC_ENABLE_PROTOBUF
 
 }  // namespace
@@ -281,6 +296,10 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
             controller_config.bitrate_controller(), initial_bitrate_bps,
             initial_frame_length_ms);
         break;
+      case audio_network_adaptor::config::Controller::kComplexityController:
+        controller = CreateComplexityController(
+            controller_config.complexity_controller());
+        break;
       default:
         RTC_NOTREACHED();
     }
@@ -203,6 +203,9 @@ void AddBitrateControllerConfig(
   config->add_controllers()->mutable_bitrate_controller();
 }
 
+constexpr int kMinComplexity = 3;
+constexpr int kMaxComplexity = 10;
+
 void AddChannelControllerConfig(
     audio_network_adaptor::config::ControllerManager* config) {
   auto controller_config =
@@ -218,6 +221,16 @@ void AddDtxControllerConfig(
   controller_config->set_dtx_disabling_bandwidth_bps(65000);
 }
 
+void AddComplexityControllerConfig(
+    audio_network_adaptor::config::ControllerManager* config) {
+  auto controller_config =
+      config->add_controllers()->mutable_complexity_controller();
+  controller_config->set_min_complexity(kMinComplexity);
+  controller_config->set_max_complexity(kMaxComplexity);
+  controller_config->set_complexity_decreasing_cpu_usage(0.2f);
+  controller_config->set_complexity_increasing_cpu_usage(0.1f);
+}
+
 void AddFecControllerConfig(
     audio_network_adaptor::config::ControllerManager* config) {
   auto controller_config_ext = config->add_controllers();
@@ -282,7 +295,8 @@ enum class ControllerType : int8_t {
   CHANNEL,
   DTX,
   FRAME_LENGTH,
-  BIT_RATE
+  BIT_RATE,
+  COMPLEXITY
 };
 
 void CheckControllersOrder(const std::vector<Controller*>& controllers,
@@ -314,6 +328,9 @@ void CheckControllersOrder(const std::vector<Controller*>& controllers,
         break;
       case ControllerType::BIT_RATE:
         EXPECT_EQ(kInitialBitrateBps, encoder_config.bitrate_bps);
+        break;
+      case ControllerType::COMPLEXITY:
+        EXPECT_EQ(kMaxComplexity, encoder_config.max_complexity);
     }
   }
 }
@@ -394,6 +411,7 @@ TEST(ControllerManagerTest, CreateCharPointFreeConfigAndCheckDefaultOrder) {
   AddChannelControllerConfig(&config);
   AddDtxControllerConfig(&config);
   AddBitrateControllerConfig(&config);
+  AddComplexityControllerConfig(&config);
 
   ProtoString config_string;
   config.SerializeToString(&config_string);
@@ -405,7 +423,8 @@ TEST(ControllerManagerTest, CreateCharPointFreeConfigAndCheckDefaultOrder) {
   CheckControllersOrder(
       controllers,
       std::vector<ControllerType>{ControllerType::CHANNEL, ControllerType::DTX,
-                                  ControllerType::BIT_RATE});
+                                  ControllerType::BIT_RATE,
+                                  ControllerType::COMPLEXITY});
 }
 
 TEST(ControllerManagerTest, CreateFromConfigStringAndCheckReordering) {
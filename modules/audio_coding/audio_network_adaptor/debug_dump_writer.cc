@@ -108,6 +108,9 @@ void DebugDumpWriterImpl::DumpNetworkMetrics(
         *metrics.uplink_recoverable_packet_loss_fraction);
   }
 
+  if (metrics.encoder_cpu_usage)
+    dump_metrics->set_encoder_cpu_usage(*metrics.encoder_cpu_usage);
+
   DumpEventToFile(event, dump_file_.get());
 #endif  // WEBRTC_ENABLE_PROTOBUF
 }
@@ -141,6 +144,9 @@ void DebugDumpWriterImpl::DumpEncoderRuntimeConfig(
   if (config.num_channels)
     dump_config->set_num_channels(*config.num_channels);
 
+  if (config.max_complexity)
+    dump_config->set_max_complexity(*config.max_complexity);
+
   DumpEventToFile(event, dump_file_.get());
 #endif  // WEBRTC_ENABLE_PROTOBUF
 }
@@ -38,6 +38,10 @@ class AudioNetworkAdaptor {
 
   virtual void SetOverhead(size_t overhead_bytes_per_packet) = 0;
 
+  // |encoder_cpu_usage| is the time spent encoding divided by the duration of
+  // the audio that was encoded.
+  virtual void SetEncoderCpuUsage(float encoder_cpu_usage) = 0;
+
   virtual AudioEncoderRuntimeConfig GetEncoderRuntimeConfig() = 0;
 
   virtual void StartDebugDump(FILE* file_handle) = 0;
@@ -34,6 +34,10 @@ struct AudioEncoderRuntimeConfig {
   // to encode.
   absl::optional<size_t> num_channels;
 
+  // Upper bound of the encoder complexity, to keep the encoder within a CPU
+  // budget. Encoders may still pick a lower complexity on their own.
+  absl::optional<int> max_complexity;
+
   // This is true if the last frame length change was an increase, and otherwise
   // false.
   // The value of this boolean is used to apply a different offset to the
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/audio_coder_opus_common.h"
+
+#include <utility>
+
+#include "rtc_base/stringencode.h"
+
+namespace webrtc {
+
+absl::optional<std::string> GetFormatParameter(const SdpAudioFormat& format,
+                                               const std::string& param) {
+  auto it = format.parameters.find(param);
+  if (it == format.parameters.end())
+    return absl::nullopt;
+
+  return it->second;
+}
+
+bool GetMultistreamParameters(const SdpAudioFormat& format,
+                              int* num_streams,
+                              int* coupled_streams,
+                              std::vector<unsigned char>* channel_mapping) {
+  const auto streams = GetFormatParameter<int>(format, "num_streams");
+  const auto coupled = GetFormatParameter<int>(format, "coupled_streams");
+  const auto mapping = GetFormatParameter(format, "channel_mapping");
+  if (!streams || !coupled || !mapping)
+    return false;
+
+  std::vector<std::string> fields;
+  rtc::split(*mapping, ',', &fields);
+  std::vector<unsigned char> parsed_mapping;
+  for (const std::string& field : fields) {
+    const auto coded_channel = rtc::StringToNumber<unsigned char>(field);
+    if (!coded_channel)
+      return false;
+    parsed_mapping.push_back(*coded_channel);
+  }
+
+  *num_streams = *streams;
+  *coupled_streams = *coupled;
+  *channel_mapping = std::move(parsed_mapping);
+  return true;
+}
+
+}  // namespace webrtc
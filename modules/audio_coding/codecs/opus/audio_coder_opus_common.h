@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_CODER_OPUS_COMMON_H_
+#define MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_CODER_OPUS_COMMON_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio_codecs/audio_format.h"
+#include "rtc_base/string_to_number.h"
+
+namespace webrtc {
+
+// SDP name of multistream Opus. Its num_channels is the number of channels,
+// and its "num_streams", "coupled_streams" and "channel_mapping" parameters
+// describe the streams, as in AudioEncoderOpusConfig.
+constexpr char kMultistreamOpusName[] = "multiopus";
+
+absl::optional<std::string> GetFormatParameter(const SdpAudioFormat& format,
+                                               const std::string& param);
+
+template <typename T>
+absl::optional<T> GetFormatParameter(const SdpAudioFormat& format,
+                                     const std::string& param) {
+  return rtc::StringToNumber<T>(GetFormatParameter(format, param).value_or(""));
+}
+
+// Reads the stream parameters of a multistream Opus |format|, where
+// "channel_mapping" is a comma separated list. Returns false if one of them
+// is missing or malformed. They are not checked against each other.
+bool GetMultistreamParameters(const SdpAudioFormat& format,
+                              int* num_streams,
+                              int* coupled_streams,
+                              std::vector<unsigned char>* channel_mapping);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_CODER_OPUS_COMMON_H_
@@ -67,12 +67,25 @@ class OpusFrame : public AudioDecoder::EncodedAudioFrame {
 }  // namespace
 
 AudioDecoderOpusImpl::AudioDecoderOpusImpl(size_t num_channels)
-    : channels_(num_channels) {
+    : channels_(num_channels), multistream_(false) {
   RTC_DCHECK(num_channels == 1 || num_channels == 2);
   WebRtcOpus_DecoderCreate(&dec_state_, channels_);
   WebRtcOpus_DecoderInit(dec_state_);
 }
 
+AudioDecoderOpusImpl::AudioDecoderOpusImpl(
+    size_t num_channels,
+    int num_streams,
+    int coupled_streams,
+    const std::vector<unsigned char>& channel_mapping)
+    : channels_(num_channels), multistream_(true) {
+  RTC_DCHECK_EQ(num_channels, channel_mapping.size());
+  RTC_CHECK_EQ(0, WebRtcOpus_MultistreamDecoderCreate(
+                      &dec_state_, channels_, num_streams, coupled_streams,
+                      channel_mapping.data()));
+  WebRtcOpus_DecoderInit(dec_state_);
+}
+
 AudioDecoderOpusImpl::~AudioDecoderOpusImpl() {
   WebRtcOpus_DecoderFree(dec_state_);
 }
@@ -154,6 +167,10 @@ int AudioDecoderOpusImpl::PacketDurationRedundant(const uint8_t* encoded,
 
 bool AudioDecoderOpusImpl::PacketHasFec(const uint8_t* encoded,
                                         size_t encoded_len) const {
+  // WebRtcOpus_PacketHasFec() parses single stream packets only, so the FEC of
+  // multistream packets is not used.
+  if (multistream_)
+    return false;
   int fec;
   fec = WebRtcOpus_PacketHasFec(encoded, encoded_len);
   return (fec == 1);
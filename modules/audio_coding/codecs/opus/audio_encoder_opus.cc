@@ -18,6 +18,7 @@
 #include "common_types.h"  // NOLINT(build/include)
 #include "modules/audio_coding/audio_network_adaptor/audio_network_adaptor_impl.h"
 #include "modules/audio_coding/audio_network_adaptor/controller_manager.h"
+#include "modules/audio_coding/codecs/opus/audio_coder_opus_common.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
@@ -52,6 +53,10 @@ constexpr int kOpusBitrateFbBps = 32000;
 constexpr int kSampleRateHz = 48000;
 constexpr int kDefaultMaxPlaybackRate = 48000;
 
+// Amount of encoded audio over which the encoder CPU usage is averaged before
+// it is reported to the audio network adaptor.
+constexpr int kEncoderCpuUsageUpdateIntervalMs = 1000;
+
 // These two lists must be sorted from low to high
 #if WEBRTC_OPUS_SUPPORT_120MS_PTIME
 constexpr int kANASupportedFrameLengths[] = {20, 60, 120};
@@ -105,21 +110,6 @@ float OptimizePacketLossRate(float new_loss_rate, float old_loss_rate) {
   }
 }
 
-absl::optional<std::string> GetFormatParameter(const SdpAudioFormat& format,
-                                               const std::string& param) {
-  auto it = format.parameters.find(param);
-  if (it == format.parameters.end())
-    return absl::nullopt;
-
-  return it->second;
-}
-
-template <typename T>
-absl::optional<T> GetFormatParameter(const SdpAudioFormat& format,
-                                     const std::string& param) {
-  return rtc::StringToNumber<T>(GetFormatParameter(format, param).value_or(""));
-}
-
 int CalculateDefaultBitrate(int max_playback_rate, size_t num_channels) {
   const int bitrate = [&] {
     if (max_playback_rate <= 8000) {
@@ -244,21 +234,10 @@ std::unique_ptr<AudioEncoder> AudioEncoderOpusImpl::MakeAudioEncoder(
 
 absl::optional<AudioCodecInfo> AudioEncoderOpusImpl::QueryAudioEncoder(
     const SdpAudioFormat& format) {
-  if (STR_CASE_CMP(format.name.c_str(), GetPayloadName()) == 0 &&
-      format.clockrate_hz == 48000 && format.num_channels == 2) {
-    const size_t num_channels = GetChannelCount(format);
-    const int bitrate =
-        CalculateBitrate(GetMaxPlaybackRate(format), num_channels,
-                         GetFormatParameter(format, "maxaveragebitrate"));
-    AudioCodecInfo info(48000, num_channels, bitrate,
-                        AudioEncoderOpusConfig::kMinBitrateBps,
-                        AudioEncoderOpusConfig::kMaxBitrateBps);
-    info.allow_comfort_noise = false;
-    info.supports_network_adaption = true;
-
-    return info;
-  }
-  return absl::nullopt;
+  const absl::optional<AudioEncoderOpusConfig> config = SdpToConfig(format);
+  if (!config)
+    return absl::nullopt;
+  return QueryAudioEncoder(*config);
 }
 
 AudioEncoderOpusConfig AudioEncoderOpusImpl::CreateConfig(
@@ -276,13 +255,27 @@ AudioEncoderOpusConfig AudioEncoderOpusImpl::CreateConfig(
 
 absl::optional<AudioEncoderOpusConfig> AudioEncoderOpusImpl::SdpToConfig(
     const SdpAudioFormat& format) {
-  if (STR_CASE_CMP(format.name.c_str(), "opus") != 0 ||
-      format.clockrate_hz != 48000 || format.num_channels != 2) {
+  const bool multistream =
+      STR_CASE_CMP(format.name.c_str(), kMultistreamOpusName) == 0;
+  if (format.clockrate_hz != 48000)
     return absl::nullopt;
-  }
 
   AudioEncoderOpusConfig config;
-  config.num_channels = GetChannelCount(format);
+  if (multistream) {
+    if (format.num_channels < 1 ||
+        format.num_channels > AudioEncoderOpusConfig::kMaxNumChannels ||
+        !GetMultistreamParameters(format, &config.num_streams,
+                                  &config.coupled_streams,
+                                  &config.channel_mapping)) {
+      return absl::nullopt;
+    }
+    config.num_channels = format.num_channels;
+  } else if (STR_CASE_CMP(format.name.c_str(), GetPayloadName()) == 0 &&
+             format.num_channels == 2) {
+    config.num_channels = GetChannelCount(format);
+  } else {
+    return absl::nullopt;
+  }
   config.frame_size_ms = GetFrameSizeMs(format);
   config.max_playback_rate_hz = GetMaxPlaybackRate(format);
   config.fec_enabled = (GetFormatParameter(format, "useinbandfec") == "1");
@@ -309,6 +302,10 @@ absl::optional<AudioEncoderOpusConfig> AudioEncoderOpusImpl::SdpToConfig(
 
   FindSupportedFrameLengths(min_frame_length_ms, max_frame_length_ms,
                             &config.supported_frame_lengths_ms);
+  if (multistream && !config.IsOk()) {
+    RTC_LOG(LS_WARNING) << "Invalid multistream Opus parameters.";
+    return absl::nullopt;
+  }
   RTC_DCHECK(config.IsOk());
   return config;
 }
@@ -403,6 +400,8 @@ AudioEncoderOpusImpl::AudioEncoderOpusImpl(
       bitrate_changed_(true),
       packet_loss_rate_(0.0),
       inst_(nullptr),
+      accumulated_encode_time_us_(0),
+      accumulated_encoded_ms_(0),
       packet_loss_fraction_smoother_(new PacketLossFractionSmoother()),
       audio_network_adaptor_creator_(audio_network_adaptor_creator),
       bitrate_smoother_(std::move(bitrate_smoother)),
@@ -504,6 +503,12 @@ bool AudioEncoderOpusImpl::EnableAudioNetworkAdaptor(
 
 void AudioEncoderOpusImpl::DisableAudioNetworkAdaptor() {
   audio_network_adaptor_.reset(nullptr);
+  accumulated_encode_time_us_ = 0;
+  accumulated_encoded_ms_ = 0;
+  if (max_complexity_) {
+    max_complexity_ = absl::nullopt;
+    ApplyComplexity();
+  }
 }
 
 void AudioEncoderOpusImpl::OnReceivedUplinkPacketLossFraction(
@@ -612,6 +617,8 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
+  const int64_t encode_start_time_us =
+      audio_network_adaptor_ ? rtc::TimeMicros() : 0;
   EncodedInfo info;
   info.encoded_bytes = encoded->AppendData(
       max_encoded_bytes, [&](rtc::ArrayView<uint8_t> encoded) {
@@ -626,6 +633,11 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
       });
   input_buffer_.clear();
 
+  if (audio_network_adaptor_) {
+    MaybeUpdateEncoderCpuUsage(rtc::TimeMicros() - encode_start_time_us,
+                               config_.frame_size_ms);
+  }
+
   bool dtx_frame = (info.encoded_bytes <= 2);
 
   // Will use new packet size for next encoding.
@@ -684,12 +696,18 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
     RTC_CHECK_EQ(0, WebRtcOpus_EncoderFree(inst_));
   input_buffer_.clear();
   input_buffer_.reserve(Num10msFramesPerPacket() * SamplesPer10msFrame());
-  RTC_CHECK_EQ(0, WebRtcOpus_EncoderCreate(
-                      &inst_, config.num_channels,
-                      config.application ==
-                              AudioEncoderOpusConfig::ApplicationMode::kVoip
-                          ? 0
-                          : 1));
+  const bool voip =
+      config.application == AudioEncoderOpusConfig::ApplicationMode::kVoip;
+  const int application = voip ? 0 : 1;
+  if (config.IsMultistream()) {
+    RTC_CHECK_EQ(0, WebRtcOpus_MultistreamEncoderCreate(
+                        &inst_, config.num_channels, application,
+                        config.num_streams, config.coupled_streams,
+                        config.channel_mapping.data()));
+  } else {
+    RTC_CHECK_EQ(0, WebRtcOpus_EncoderCreate(&inst_, config.num_channels,
+                                             application));
+  }
   RTC_CHECK_EQ(0, WebRtcOpus_SetBitRate(inst_, GetBitrateBps(config)));
   if (config.fec_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableFec(inst_));
@@ -701,7 +719,7 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
   // Use the default complexity if the start bitrate is within the hysteresis
   // window.
   complexity_ = GetNewComplexity(config).value_or(config.complexity);
-  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+  ApplyComplexity();
   bitrate_changed_ = true;
   if (config.dtx_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableDtx(inst_));
@@ -756,7 +774,7 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
   const auto new_complexity = GetNewComplexity(config_);
   if (new_complexity && complexity_ != *new_complexity) {
     complexity_ = *new_complexity;
-    RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+    ApplyComplexity();
   }
   bitrate_changed_ = true;
 }
@@ -774,8 +792,13 @@ void AudioEncoderOpusImpl::ApplyAudioNetworkAdaptor() {
     SetProjectedPacketLossRate(*config.uplink_packet_loss_fraction);
   if (config.enable_dtx)
     SetDtx(*config.enable_dtx);
-  if (config.num_channels)
+  // Multistream encoders always code all their channels.
+  if (config.num_channels && !config_.IsMultistream())
     SetNumChannelsToEncode(*config.num_channels);
+  if (config.max_complexity && max_complexity_ != config.max_complexity) {
+    max_complexity_ = config.max_complexity;
+    ApplyComplexity();
+  }
 }
 
 std::unique_ptr<AudioNetworkAdaptor>
@@ -806,6 +829,26 @@ void AudioEncoderOpusImpl::MaybeUpdateUplinkBandwidth() {
   }
 }
 
+void AudioEncoderOpusImpl::MaybeUpdateEncoderCpuUsage(int64_t encode_time_us,
+                                                      int encoded_ms) {
+  accumulated_encode_time_us_ += encode_time_us;
+  accumulated_encoded_ms_ += encoded_ms;
+  if (accumulated_encoded_ms_ < kEncoderCpuUsageUpdateIntervalMs)
+    return;
+  // Wall clock time also counts the time the encoding thread was preempted,
+  // which errs on the side of a lower complexity on a busy device.
+  audio_network_adaptor_->SetEncoderCpuUsage(
+      static_cast<float>(accumulated_encode_time_us_) /
+      (accumulated_encoded_ms_ * rtc::kNumMicrosecsPerMillisec));
+  accumulated_encode_time_us_ = 0;
+  accumulated_encoded_ms_ = 0;
+  ApplyAudioNetworkAdaptor();
+}
+
+void AudioEncoderOpusImpl::ApplyComplexity() {
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity()));
+}
+
 ANAStats AudioEncoderOpusImpl::GetANAStats() const {
   if (audio_network_adaptor_) {
     return audio_network_adaptor_->GetStats();
@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_ENCODER_OPUS_H_
 #define MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_ENCODER_OPUS_H_
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <string>
@@ -116,6 +117,10 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   bool fec_enabled() const { return config_.fec_enabled; }
   size_t num_channels_to_encode() const { return num_channels_to_encode_; }
   int next_frame_length_ms() const { return next_frame_length_ms_; }
+  int complexity() const {
+    return max_complexity_ ? std::min(complexity_, *max_complexity_)
+                           : complexity_;
+  }
 
  protected:
   EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
@@ -152,6 +157,14 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
 
   void MaybeUpdateUplinkBandwidth();
 
+  // Accumulates the time spent encoding |encoded_ms| of audio and reports the
+  // average CPU usage to the audio network adaptor once in a while.
+  void MaybeUpdateEncoderCpuUsage(int64_t encode_time_us, int encoded_ms);
+
+  // Sets the complexity chosen from the bitrate, limited by the maximum
+  // complexity from the audio network adaptor.
+  void ApplyComplexity();
+
   AudioEncoderOpusConfig config_;
   const int payload_type_;
   const bool send_side_bwe_with_overhead_;
@@ -164,6 +177,9 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   size_t num_channels_to_encode_;
   int next_frame_length_ms_;
   int complexity_;
+  absl::optional<int> max_complexity_;
+  int64_t accumulated_encode_time_us_;
+  int accumulated_encoded_ms_;
   std::unique_ptr<PacketLossFractionSmoother> packet_loss_fraction_smoother_;
   const AudioNetworkAdaptorCreator audio_network_adaptor_creator_;
   std::unique_ptr<AudioNetworkAdaptor> audio_network_adaptor_;
@@ -577,6 +577,32 @@ TEST(AudioEncoderOpusTest, UpdateUplinkBandwidthInAudioNetworkAdaptor) {
   }
 }
 
+TEST(AudioEncoderOpusTest, ReportEncoderCpuUsageToAudioNetworkAdaptor) {
+  auto states = CreateCodec(2);
+  states->encoder->EnableAudioNetworkAdaptor("", nullptr);
+  const int initial_complexity = states->encoder->complexity();
+  std::array<int16_t, 480 * 2> audio;
+  audio.fill(0);
+  rtc::Buffer encoded;
+
+  AudioEncoderRuntimeConfig config;
+  config.max_complexity = initial_complexity - 1;
+  EXPECT_CALL(*states->mock_audio_network_adaptor, GetEncoderRuntimeConfig())
+      .WillOnce(Return(config));
+  // The fake clock does not advance while encoding.
+  EXPECT_CALL(*states->mock_audio_network_adaptor, SetEncoderCpuUsage(0.0f));
+  // One second of audio in 10 ms blocks.
+  for (int i = 0; i < 100; ++i) {
+    states->encoder->Encode(
+        0, rtc::ArrayView<const int16_t>(audio.data(), audio.size()), &encoded);
+  }
+  EXPECT_EQ(initial_complexity - 1, states->encoder->complexity());
+
+  // The maximum complexity is lifted along with the audio network adaptor.
+  states->encoder->DisableAudioNetworkAdaptor();
+  EXPECT_EQ(initial_complexity, states->encoder->complexity());
+}
+
 TEST(AudioEncoderOpusTest, EncodeAtMinBitrate) {
   auto states = CreateCodec(1);
   constexpr int kNumPacketsToEncode = 2;
@@ -728,6 +754,58 @@ TEST(AudioEncoderOpusTest, TestConfigFromInvalidParams) {
             config.supported_frame_lengths_ms);
 }
 
+TEST(AudioEncoderOpusTest, TestMultistreamConfigFromParams) {
+  const SdpAudioFormat format("multiopus", 48000, 6,
+                              {{"num_streams", "4"},
+                               {"coupled_streams", "2"},
+                               {"channel_mapping", "0,4,1,2,3,5"}});
+  const auto config = AudioEncoderOpus::SdpToConfig(format);
+  ASSERT_TRUE(config);
+  EXPECT_TRUE(config->IsMultistream());
+  EXPECT_EQ(6u, config->num_channels);
+  EXPECT_EQ(4, config->num_streams);
+  EXPECT_EQ(2, config->coupled_streams);
+  EXPECT_EQ(std::vector<unsigned char>({0, 4, 1, 2, 3, 5}),
+            config->channel_mapping);
+
+  EXPECT_EQ(6u, AudioEncoderOpus::QueryAudioEncoder(*config).num_channels);
+}
+
+TEST(AudioEncoderOpusTest, TestMultistreamConfigFromInvalidParams) {
+  const SdpAudioFormat::Parameters kValid = {
+      {"num_streams", "4"},
+      {"coupled_streams", "2"},
+      {"channel_mapping", "0,4,1,2,3,5"}};
+  auto create = [&kValid](const std::string& name, const std::string& value) {
+    SdpAudioFormat::Parameters params = kValid;
+    if (value.empty()) {
+      params.erase(name);
+    } else {
+      params[name] = value;
+    }
+    return AudioEncoderOpus::SdpToConfig({"multiopus", 48000, 6, params});
+  };
+
+  EXPECT_FALSE(create("num_streams", ""));
+  EXPECT_FALSE(create("coupled_streams", ""));
+  EXPECT_FALSE(create("channel_mapping", ""));
+  EXPECT_FALSE(create("num_streams", "0"));
+  EXPECT_FALSE(create("coupled_streams", "5"));
+  // Mapping with too few channels, and with a channel outside the streams.
+  EXPECT_FALSE(create("channel_mapping", "0,4,1,2,3"));
+  EXPECT_FALSE(create("channel_mapping", "0,4,1,2,3,6"));
+  EXPECT_FALSE(create("channel_mapping", "0,4,1,2,3,x"));
+  // 255 marks a silent channel.
+  EXPECT_TRUE(create("channel_mapping", "0,4,1,2,3,255"));
+
+  // More channels than an AudioFrame holds at 48 kHz.
+  EXPECT_FALSE(AudioEncoderOpus::SdpToConfig(
+      {"multiopus", 48000, 9,
+       {{"num_streams", "9"},
+        {"coupled_streams", "0"},
+        {"channel_mapping", "0,1,2,3,4,5,6,7,8"}}}));
+}
+
 // Test that bitrate will be overridden by the "maxaveragebitrate" parameter.
 // Also test that the "maxaveragebitrate" can't be set to values outside the
 // range of 6000 and 510000
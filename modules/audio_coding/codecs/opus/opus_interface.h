@@ -47,6 +47,43 @@ int16_t WebRtcOpus_EncoderCreate(OpusEncInst** inst,
                                  size_t channels,
                                  int32_t application);
 
+/****************************************************************************
+ * WebRtcOpus_MultistreamEncoderCreate(...)
+ *
+ * This function creates an Opus encoder that codes |channels| channels as
+ * |streams| mono and stereo streams, which are sent together in one packet.
+ * The other encoder functions can be used with it, except that it can not be
+ * forced to encode in mono or stereo.
+ *
+ * Input:
+ *      - channels           : number of channels in the input.
+ *      - application        : 0 - VOIP applications.
+ *                                 Favor speech intelligibility.
+ *                             1 - Audio applications.
+ *                                 Favor faithfulness to the original input.
+ *      - streams            : number of streams to code.
+ *      - coupled_streams    : number of the streams that are stereo. These
+ *                             are the first streams.
+ *      - channel_mapping    : |channels| entries, the coded channel of each
+ *                             input channel, or 255 for none. The coded
+ *                             channels of stereo streams come first, two per
+ *                             stream.
+ *
+ * Output:
+ *      - inst               : a pointer to Encoder context that is created
+ *                             if success.
+ *
+ * Return value              : 0 - Success
+ *                            -1 - Error
+ */
+int16_t WebRtcOpus_MultistreamEncoderCreate(
+    OpusEncInst** inst,
+    size_t channels,
+    int32_t application,
+    size_t streams,
+    size_t coupled_streams,
+    const unsigned char* channel_mapping);
+
 int16_t WebRtcOpus_EncoderFree(OpusEncInst* inst);
 
 /****************************************************************************
@@ -279,6 +316,25 @@ int16_t WebRtcOpus_SetBandwidth(OpusEncInst* inst, int32_t bandwidth);
 int16_t WebRtcOpus_SetForceChannels(OpusEncInst* inst, size_t num_channels);
 
 int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, size_t channels);
+
+/****************************************************************************
+ * WebRtcOpus_MultistreamDecoderCreate(...)
+ *
+ * This function creates a decoder for packets of an encoder created by
+ * WebRtcOpus_MultistreamEncoderCreate(...), with the same |streams| and
+ * |coupled_streams|. |channel_mapping| has |channels| entries, the coded
+ * channel of each output channel, or 255 for silence.
+ *
+ * Return value              : 0 - Success
+ *                            -1 - Error
+ */
+int16_t WebRtcOpus_MultistreamDecoderCreate(
+    OpusDecInst** inst,
+    size_t channels,
+    size_t streams,
+    size_t coupled_streams,
+    const unsigned char* channel_mapping);
+
 int16_t WebRtcOpus_DecoderFree(OpusDecInst* inst);
 
 /****************************************************************************
@@ -8,8 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
+
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/audio_coding/codecs/opus/opus_inst.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
@@ -34,6 +37,7 @@ const size_t kOpusRateKhz = 48;
 const size_t kOpus20msFrameSamples = kOpusRateKhz * 20;
 // Number of samples-per-channel in a 10 ms frame, sampled at 48 kHz.
 const size_t kOpus10msFrameSamples = kOpusRateKhz * 10;
+const double kPi = 3.14159265358979323846;
 
 class OpusTest : public TestWithParam<::testing::tuple<int, int>> {
  protected:
@@ -370,6 +374,71 @@ TEST(OpusTest, OpusFreeFail) {
   EXPECT_EQ(-1, WebRtcOpus_DecoderFree(NULL));
 }
 
+// 5.1 surround, as four streams of which the first two are stereo.
+TEST(OpusTest, OpusMultistreamEncodeDecode) {
+  const size_t kChannels = 6;
+  const unsigned char kChannelMapping[kChannels] = {0, 4, 1, 2, 3, 5};
+  WebRtcOpusEncInst* opus_encoder;
+  WebRtcOpusDecInst* opus_decoder;
+  ASSERT_EQ(0, WebRtcOpus_MultistreamEncoderCreate(&opus_encoder, kChannels, 1,
+                                                   4, 2, kChannelMapping));
+  ASSERT_EQ(0, WebRtcOpus_MultistreamDecoderCreate(&opus_decoder, kChannels, 4,
+                                                   2, kChannelMapping));
+  EXPECT_EQ(kChannels, WebRtcOpus_DecoderChannels(opus_decoder));
+  EXPECT_EQ(0, WebRtcOpus_SetBitRate(opus_encoder, 192000));
+  EXPECT_EQ(0, WebRtcOpus_EnableFec(opus_encoder));
+  // Multistream encoders can not be forced to mono or stereo.
+  EXPECT_EQ(0, WebRtcOpus_SetForceChannels(opus_encoder, 0));
+  EXPECT_EQ(-1, WebRtcOpus_SetForceChannels(opus_encoder, 1));
+
+  // A tone of a different frequency in each channel.
+  std::vector<int16_t> input(kOpus20msFrameSamples * kChannels);
+  for (size_t i = 0; i < kOpus20msFrameSamples; ++i) {
+    for (size_t c = 0; c < kChannels; ++c) {
+      input[i * kChannels + c] = static_cast<int16_t>(
+          8000 * sin(2 * kPi * 200 * (c + 1) * i / (kOpusRateKhz * 1000)));
+    }
+  }
+  std::vector<uint8_t> bitstream(4 * kMaxBytes);
+  std::vector<int16_t> output(kOpus20msFrameSamples * kChannels);
+  int16_t audio_type;
+  for (int i = 0; i < 5; ++i) {
+    const int encoded_bytes =
+        WebRtcOpus_Encode(opus_encoder, input.data(), kOpus20msFrameSamples,
+                          bitstream.size(), bitstream.data());
+    ASSERT_GT(encoded_bytes, 0);
+    EXPECT_EQ(static_cast<int>(kOpus20msFrameSamples),
+              WebRtcOpus_DurationEst(opus_decoder, bitstream.data(),
+                                     encoded_bytes));
+    EXPECT_EQ(static_cast<int>(kOpus20msFrameSamples),
+              WebRtcOpus_Decode(opus_decoder, bitstream.data(), encoded_bytes,
+                                output.data(), &audio_type));
+  }
+  EXPECT_EQ(static_cast<int>(kOpus20msFrameSamples),
+            WebRtcOpus_DecodePlc(opus_decoder, output.data(), 1));
+
+  EXPECT_EQ(0, WebRtcOpus_EncoderFree(opus_encoder));
+  EXPECT_EQ(0, WebRtcOpus_DecoderFree(opus_decoder));
+}
+
+TEST(OpusTest, OpusMultistreamCreateFail) {
+  const unsigned char kChannelMapping[] = {0, 1, 2, 3};
+  // A coded channel the streams do not have.
+  const unsigned char kBadChannelMapping[] = {0, 1, 2, 4};
+  WebRtcOpusEncInst* opus_encoder;
+  WebRtcOpusDecInst* opus_decoder;
+  EXPECT_EQ(-1, WebRtcOpus_MultistreamEncoderCreate(NULL, 4, 1, 2, 2,
+                                                    kChannelMapping));
+  EXPECT_EQ(-1, WebRtcOpus_MultistreamEncoderCreate(&opus_encoder, 4, 2, 2, 2,
+                                                    kChannelMapping));
+  EXPECT_EQ(-1, WebRtcOpus_MultistreamEncoderCreate(&opus_encoder, 4, 1, 2, 2,
+                                                    kBadChannelMapping));
+  EXPECT_EQ(-1, WebRtcOpus_MultistreamDecoderCreate(NULL, 4, 2, 2,
+                                                    kChannelMapping));
+  EXPECT_EQ(-1, WebRtcOpus_MultistreamDecoderCreate(&opus_decoder, 4, 2, 2,
+                                                    kBadChannelMapping));
+}
+
 // Test normal Create and Free.
 TEST_P(OpusTest, OpusCreateFree) {
   EXPECT_EQ(0,
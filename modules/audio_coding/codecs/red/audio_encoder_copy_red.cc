@@ -24,8 +24,15 @@ AudioEncoderCopyRed::Config::~Config() = default;
 
 AudioEncoderCopyRed::AudioEncoderCopyRed(Config&& config)
     : speech_encoder_(std::move(config.speech_encoder)),
-      red_payload_type_(config.payload_type) {
+      red_payload_type_(config.payload_type),
+      num_redundant_encodings_(config.num_redundant_encodings),
+      enabling_packet_loss_fraction_(config.enabling_packet_loss_fraction),
+      disabling_packet_loss_fraction_(config.disabling_packet_loss_fraction),
+      redundancy_enabled_(!enabling_packet_loss_fraction_) {
   RTC_CHECK(speech_encoder_) << "Speech encoder not provided.";
+  RTC_DCHECK(!enabling_packet_loss_fraction_ ||
+             disabling_packet_loss_fraction_ <=
+                 *enabling_packet_loss_fraction_);
 }
 
 AudioEncoderCopyRed::~AudioEncoderCopyRed() = default;
@@ -70,15 +77,27 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
     // intentional.
     info.redundant.push_back(info);
     RTC_DCHECK_EQ(info.redundant.size(), 1);
-    if (secondary_info_.encoded_bytes > 0) {
-      encoded->AppendData(secondary_encoded_);
-      info.redundant.push_back(secondary_info_);
-      RTC_DCHECK_EQ(info.redundant.size(), 2);
+    if (redundancy_enabled_) {
+      for (const RedundantEncoding& redundant : redundant_encodings_) {
+        encoded->AppendData(redundant.encoded);
+        info.redundant.push_back(redundant.info);
+      }
+    }
+    // Save primary as the newest of the previous encodings, reusing the buffer
+    // of the oldest one if there are enough of them. The previous encodings
+    // are kept while redundancy is disabled, so that they are available at
+    // once when it is enabled.
+    if (num_redundant_encodings_ > 0) {
+      RedundantEncoding newest;
+      if (redundant_encodings_.size() == num_redundant_encodings_) {
+        newest = std::move(redundant_encodings_.back());
+        redundant_encodings_.pop_back();
+      }
+      newest.info = info;
+      newest.encoded.SetData(encoded->data() + primary_offset,
+                             info.encoded_bytes);
+      redundant_encodings_.push_front(std::move(newest));
     }
-    // Save primary to secondary.
-    secondary_encoded_.SetData(encoded->data() + primary_offset,
-                               info.encoded_bytes);
-    secondary_info_ = info;
     RTC_DCHECK_EQ(info.speech, info.redundant[0].speech);
   }
   // Update main EncodedInfo.
@@ -93,8 +112,7 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
 
 void AudioEncoderCopyRed::Reset() {
   speech_encoder_->Reset();
-  secondary_encoded_.Clear();
-  secondary_info_.encoded_bytes = 0;
+  redundant_encodings_.clear();
 }
 
 bool AudioEncoderCopyRed::SetFec(bool enable) {
@@ -122,6 +140,13 @@ void AudioEncoderCopyRed::OnReceivedUplinkPacketLossFraction(
     float uplink_packet_loss_fraction) {
   speech_encoder_->OnReceivedUplinkPacketLossFraction(
       uplink_packet_loss_fraction);
+  if (!enabling_packet_loss_fraction_)
+    return;
+  if (uplink_packet_loss_fraction >= *enabling_packet_loss_fraction_) {
+    redundancy_enabled_ = true;
+  } else if (uplink_packet_loss_fraction < disabling_packet_loss_fraction_) {
+    redundancy_enabled_ = false;
+  }
 }
 
 void AudioEncoderCopyRed::OnReceivedUplinkRecoverablePacketLossFraction(
@@ -11,9 +11,11 @@
 #ifndef MODULES_AUDIO_CODING_CODECS_RED_AUDIO_ENCODER_COPY_RED_H_
 #define MODULES_AUDIO_CODING_CODECS_RED_AUDIO_ENCODER_COPY_RED_H_
 
+#include <deque>
 #include <memory>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/audio_codecs/audio_encoder.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/constructormagic.h"
@@ -22,8 +24,8 @@ namespace webrtc {
 
 // This class implements redundant audio coding. The class object will have an
 // underlying AudioEncoder object that performs the actual encodings. The
-// current class will gather the two latest encodings from the underlying codec
-// into one packet.
+// current class will gather the latest encodings from the underlying codec
+// into one packet, the newest one first.
 class AudioEncoderCopyRed final : public AudioEncoder {
  public:
   struct Config {
@@ -32,6 +34,13 @@ class AudioEncoderCopyRed final : public AudioEncoder {
     ~Config();
     int payload_type;
     std::unique_ptr<AudioEncoder> speech_encoder;
+    // Number of previous encodings sent along with each new one.
+    size_t num_redundant_encodings = 1;
+    // If set, the previous encodings are only sent once the uplink packet loss
+    // fraction reaches |enabling_packet_loss_fraction|, and until it drops
+    // below |disabling_packet_loss_fraction|.
+    absl::optional<float> enabling_packet_loss_fraction;
+    float disabling_packet_loss_fraction = 0.0f;
   };
 
   explicit AudioEncoderCopyRed(Config&& config);
@@ -65,10 +74,19 @@ class AudioEncoderCopyRed final : public AudioEncoder {
                          rtc::Buffer* encoded) override;
 
  private:
+  struct RedundantEncoding {
+    EncodedInfoLeaf info;
+    rtc::Buffer encoded;
+  };
+
   std::unique_ptr<AudioEncoder> speech_encoder_;
   int red_payload_type_;
-  rtc::Buffer secondary_encoded_;
-  EncodedInfoLeaf secondary_info_;
+  const size_t num_redundant_encodings_;
+  const absl::optional<float> enabling_packet_loss_fraction_;
+  const float disabling_packet_loss_fraction_;
+  bool redundancy_enabled_;
+  // The latest encodings, the newest first.
+  std::deque<RedundantEncoding> redundant_encodings_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderCopyRed);
 };
 
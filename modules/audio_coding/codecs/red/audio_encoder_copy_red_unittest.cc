@@ -50,6 +50,13 @@ class AudioEncoderCopyRedTest : public ::testing::Test {
 
   void TearDown() override { red_.reset(); }
 
+  // Replaces |red_| with one using |config| and the same mock encoder.
+  void ReconfigureRed(AudioEncoderCopyRed::Config config) {
+    config.payload_type = red_payload_type_;
+    config.speech_encoder = std::move(red_->ReclaimContainedEncoders()[0]);
+    red_.reset(new AudioEncoderCopyRed(std::move(config)));
+  }
+
   void Encode() {
     ASSERT_TRUE(red_.get() != NULL);
     encoded_.Clear();
@@ -178,6 +185,71 @@ TEST_F(AudioEncoderCopyRedTest, CheckPayloadSizes) {
   }
 }
 
+// Checks that the configured number of previous encodings is sent, the
+// newest first.
+TEST_F(AudioEncoderCopyRedTest, CheckPayloadSizesWithTwoRedundantEncodings) {
+  AudioEncoderCopyRed::Config config;
+  config.num_redundant_encodings = 2;
+  ReconfigureRed(std::move(config));
+
+  static const int kNumPackets = 10;
+  InSequence s;
+  for (int encode_size = 1; encode_size <= kNumPackets; ++encode_size) {
+    EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+        .WillOnce(Invoke(MockAudioEncoder::FakeEncoding(encode_size)));
+  }
+
+  Encode();
+  EXPECT_EQ(1u, encoded_info_.redundant.size());
+  Encode();
+  EXPECT_EQ(2u, encoded_info_.redundant.size());
+  EXPECT_EQ(2u + 1u, encoded_info_.encoded_bytes);
+
+  for (size_t i = 3; i <= kNumPackets; ++i) {
+    Encode();
+    ASSERT_EQ(3u, encoded_info_.redundant.size());
+    EXPECT_EQ(i, encoded_info_.redundant[0].encoded_bytes);
+    EXPECT_EQ(i - 1, encoded_info_.redundant[1].encoded_bytes);
+    EXPECT_EQ(i - 2, encoded_info_.redundant[2].encoded_bytes);
+    EXPECT_EQ(i + i - 1 + i - 2, encoded_info_.encoded_bytes);
+  }
+}
+
+// Checks that the previous encodings are only sent while the packet loss is
+// high enough.
+TEST_F(AudioEncoderCopyRedTest, EnablesRedundancyOnPacketLoss) {
+  AudioEncoderCopyRed::Config config;
+  config.enabling_packet_loss_fraction = 0.05f;
+  config.disabling_packet_loss_fraction = 0.02f;
+  ReconfigureRed(std::move(config));
+
+  EXPECT_CALL(*mock_encoder_, OnReceivedUplinkPacketLossFraction(_)).Times(4);
+  EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+      .WillRepeatedly(Invoke(MockAudioEncoder::FakeEncoding(17)));
+
+  Encode();
+  Encode();
+  EXPECT_EQ(1u, encoded_info_.redundant.size());
+
+  red_->OnReceivedUplinkPacketLossFraction(0.04f);
+  Encode();
+  EXPECT_EQ(1u, encoded_info_.redundant.size());
+
+  red_->OnReceivedUplinkPacketLossFraction(0.05f);
+  Encode();
+  EXPECT_EQ(2u, encoded_info_.redundant.size());
+  EXPECT_EQ(2u * 17u, encoded_info_.encoded_bytes);
+
+  red_->OnReceivedUplinkPacketLossFraction(0.03f);
+  Encode();
+  EXPECT_EQ(2u, encoded_info_.redundant.size());
+
+  red_->OnReceivedUplinkPacketLossFraction(0.01f);
+  Encode();
+  EXPECT_EQ(1u, encoded_info_.redundant.size());
+  EXPECT_EQ(17u, encoded_info_.encoded_bytes);
+}
+
 // Checks that the correct timestamps are returned.
 TEST_F(AudioEncoderCopyRedTest, CheckTimestamps) {
   uint32_t primary_timestamp = timestamp_;
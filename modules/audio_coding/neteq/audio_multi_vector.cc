@@ -75,19 +75,24 @@ void AudioMultiVector::PushBackInterleaved(const int16_t* append_this,
     channels_[0]->PushBack(append_this, length);
     return;
   }
-  size_t length_per_channel = length / num_channels_;
-  int16_t* temp_array = new int16_t[length_per_channel];  // Temporary storage.
+  const size_t length_per_channel = length / num_channels_;
+  // Deinterleave through a small buffer on the stack, one chunk at a time, to
+  // not allocate for every call.
+  static const size_t kChunkLength = 480;  // 10 ms at 48 kHz.
+  int16_t temp_array[kChunkLength];
   for (size_t channel = 0; channel < num_channels_; ++channel) {
-    // Copy elements to |temp_array|.
     // Set |source_ptr| to first element of this channel.
     const int16_t* source_ptr = &append_this[channel];
-    for (size_t i = 0; i < length_per_channel; ++i) {
-      temp_array[i] = *source_ptr;
-      source_ptr += num_channels_;  // Jump to next element of this channel.
+    for (size_t start = 0; start < length_per_channel; start += kChunkLength) {
+      const size_t chunk_length =
+          std::min(kChunkLength, length_per_channel - start);
+      for (size_t i = 0; i < chunk_length; ++i) {
+        temp_array[i] = *source_ptr;
+        source_ptr += num_channels_;  // Jump to next element of this channel.
+      }
+      channels_[channel]->PushBack(temp_array, chunk_length);
     }
-    channels_[channel]->PushBack(temp_array, length_per_channel);
   }
-  delete[] temp_array;
 }
 
 void AudioMultiVector::PushBack(const AudioMultiVector& append_this) {
@@ -28,7 +28,9 @@ namespace webrtc {
 DelayPeakDetector::~DelayPeakDetector() = default;
 
 DelayPeakDetector::DelayPeakDetector(const TickTimer* tick_timer)
-    : peak_found_(false),
+    : peak_heights_(kMaxNumPeaks),
+      peak_periods_(kMaxNumPeaks),
+      peak_found_(false),
       peak_detection_threshold_(0),
       tick_timer_(tick_timer),
       frame_length_change_experiment_(
@@ -39,7 +41,8 @@ DelayPeakDetector::DelayPeakDetector(const TickTimer* tick_timer)
 void DelayPeakDetector::Reset() {
   peak_period_stopwatch_.reset();
   peak_found_ = false;
-  peak_history_.clear();
+  peak_heights_.Reset();
+  peak_periods_.Reset();
 }
 
 // Calculates the threshold in number of packets.
@@ -52,7 +55,8 @@ void DelayPeakDetector::SetPacketAudioLength(int length_ms) {
     }
   }
   if (frame_length_change_experiment_) {
-    peak_history_.clear();
+    peak_heights_.Reset();
+    peak_periods_.Reset();
   }
 }
 
@@ -61,23 +65,17 @@ bool DelayPeakDetector::peak_found() {
 }
 
 int DelayPeakDetector::MaxPeakHeight() const {
-  int max_height = -1;  // Returns -1 for an empty history.
-  std::list<Peak>::const_iterator it;
-  for (it = peak_history_.begin(); it != peak_history_.end(); ++it) {
-    max_height = std::max(max_height, it->peak_height_packets);
-  }
-  return max_height;
+  // Returns -1 for an empty history.
+  return peak_heights_.GetFilteredValue().value_or(-1);
 }
 
 uint64_t DelayPeakDetector::MaxPeakPeriod() const {
-  auto max_period_element = std::max_element(
-      peak_history_.begin(), peak_history_.end(),
-      [](Peak a, Peak b) { return a.period_ms < b.period_ms; });
-  if (max_period_element == peak_history_.end()) {
-    return 0;  // |peak_history_| is empty.
+  const absl::optional<uint64_t> max_period = peak_periods_.GetFilteredValue();
+  if (!max_period) {
+    return 0;  // The history is empty.
   }
-  RTC_DCHECK_GT(max_period_element->period_ms, 0);
-  return max_period_element->period_ms;
+  RTC_DCHECK_GT(*max_period, 0);
+  return *max_period;
 }
 
 bool DelayPeakDetector::Update(int inter_arrival_time, int target_level) {
@@ -90,15 +88,10 @@ bool DelayPeakDetector::Update(int inter_arrival_time, int target_level) {
     } else if (peak_period_stopwatch_->ElapsedMs() > 0) {
       if (peak_period_stopwatch_->ElapsedMs() <= kMaxPeakPeriodMs) {
         // This is not the first peak, and the period is valid.
-        // Store peak data in the vector.
-        Peak peak_data;
-        peak_data.period_ms = peak_period_stopwatch_->ElapsedMs();
-        peak_data.peak_height_packets = inter_arrival_time;
-        peak_history_.push_back(peak_data);
-        while (peak_history_.size() > kMaxNumPeaks) {
-          // Delete the oldest data point.
-          peak_history_.pop_front();
-        }
+        // Store peak data in the history. The oldest data point is dropped
+        // once there are |kMaxNumPeaks| of them.
+        peak_periods_.Insert(peak_period_stopwatch_->ElapsedMs());
+        peak_heights_.Insert(inter_arrival_time);
         peak_period_stopwatch_ = tick_timer_->GetNewStopwatch();
       } else if (peak_period_stopwatch_->ElapsedMs() <= 2 * kMaxPeakPeriodMs) {
         // Invalid peak due to too long period. Reset period counter and start
@@ -116,7 +109,7 @@ bool DelayPeakDetector::Update(int inter_arrival_time, int target_level) {
 }
 
 bool DelayPeakDetector::CheckPeakConditions() {
-  size_t s = peak_history_.size();
+  size_t s = peak_heights_.GetNumberOfSamplesStored();
   if (s >= kMinPeaksToTrigger &&
       peak_period_stopwatch_->ElapsedMs() <= 2 * MaxPeakPeriod()) {
     peak_found_ = true;
@@ -13,11 +13,11 @@
 
 #include <string.h>  // size_t
 
-#include <list>
 #include <memory>
 
 #include "modules/audio_coding/neteq/tick_timer.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/numerics/moving_max_filter.h"
 
 namespace webrtc {
 
@@ -54,14 +54,11 @@ class DelayPeakDetector {
   static const int kPeakHeightMs = 78;
   static const int kMaxPeakPeriodMs = 10000;
 
-  typedef struct {
-    uint64_t period_ms;
-    int peak_height_packets;
-  } Peak;
-
   bool CheckPeakConditions();
 
-  std::list<Peak> peak_history_;
+  // Heights and periods of the latest |kMaxNumPeaks| peaks.
+  MovingMaxFilter<int> peak_heights_;
+  MovingMaxFilter<uint64_t> peak_periods_;
   bool peak_found_;
   int peak_detection_threshold_;
   const TickTimer* tick_timer_;
@@ -58,6 +58,8 @@ struct NetEqNetworkStatistics {
   int median_waiting_time_ms;
   int min_waiting_time_ms;
   int max_waiting_time_ms;
+  // Memory taken by the encoded packets and decoded samples in the buffers.
+  size_t buffer_memory_bytes;
 };
 
 // NetEq statistics that persist over the lifetime of the class.
@@ -92,6 +94,10 @@ class NetEq {
     int max_delay_ms = 2000;
     bool enable_fast_accelerate = false;
     bool enable_muted_state = false;
+    // With muted state enabled, also goes into muted state after a prolonged
+    // comfort noise period, and stays there until speech packets arrive. The
+    // comfort noise is then not generated, but replaced by silence.
+    bool enable_muted_comfort_noise = false;
     absl::optional<AudioCodecPairId> codec_pair_id;
     bool for_test_no_time_stretching = false;  // Use only for testing.
   };
@@ -127,7 +133,8 @@ class NetEq {
   // |vad_activity_| are updated upon success. If an error is returned, some
   // fields may not have been updated, or may contain inconsistent values.
   // If muted state is enabled (through Config::enable_muted_state), |muted|
-  // may be set to true after a prolonged expand period. When this happens, the
+  // may be set to true after a prolonged expand period, or comfort noise
+  // period with Config::enable_muted_comfort_noise. When this happens, the
   // |data_| in |audio_frame| is not written, but should be interpreted as being
   // all zeros.
   // Returns kOK on success, or kFail in case of an error.
@@ -48,6 +48,7 @@ class MockPacketBuffer : public PacketBuffer {
   MOCK_CONST_METHOD0(PeekNextPacket,
       const Packet*());
   MOCK_METHOD0(GetNextPacket, absl::optional<Packet>());
+  MOCK_METHOD1(GetNextPacket, bool(PacketList* packet_list));
   MOCK_METHOD1(DiscardNextPacket, int(StatisticsCalculator* stats));
   MOCK_METHOD3(DiscardOldPackets,
                void(uint32_t timestamp_limit,
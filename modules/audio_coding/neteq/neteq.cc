@@ -32,7 +32,9 @@ std::string NetEq::Config::ToString() const {
      << ", max_packets_in_buffer=" << max_packets_in_buffer
      << ", enable_fast_accelerate="
      << (enable_fast_accelerate ? " true" : "false")
-     << ", enable_muted_state=" << (enable_muted_state ? " true" : "false");
+     << ", enable_muted_state=" << (enable_muted_state ? " true" : "false")
+     << ", enable_muted_comfort_noise="
+     << (enable_muted_comfort_noise ? " true" : "false");
   return ss.str();
 }
 
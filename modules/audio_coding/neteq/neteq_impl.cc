@@ -104,6 +104,7 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       enable_fast_accelerate_(config.enable_fast_accelerate),
       nack_enabled_(false),
       enable_muted_state_(config.enable_muted_state),
+      enable_muted_comfort_noise_(config.enable_muted_comfort_noise),
       expand_uma_logger_("WebRTC.Audio.ExpandRatePercent",
                          10,  // Report once every 10 s.
                          tick_timer_.get()),
@@ -371,6 +372,9 @@ int NetEqImpl::NetworkStatistics(NetEqNetworkStatistics* stats) {
   stats_.PopulateDelayManagerStats(ms_per_packet, *delay_manager_.get(), stats);
   stats_.GetNetworkStatistics(fs_hz_, total_samples_in_buffers,
                               decoder_frame_length_, stats);
+  stats->buffer_memory_bytes =
+      packet_buffer_->GetPayloadBytes() +
+      sync_buffer_->Size() * sync_buffer_->Channels() * sizeof(int16_t);
   return 0;
 }
 
@@ -539,18 +543,18 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
   }
 
   PacketList packet_list;
-  // Insert packet in a packet list.
-  packet_list.push_back([&rtp_header, &payload] {
+  // Insert packet in a packet list, reusing a list node of |packet_buffer_|.
+  packet_buffer_->AppendEmptyPacket(&packet_list);
+  {
     // Convert to Packet.
-    Packet packet;
+    Packet& packet = packet_list.back();
     packet.payload_type = rtp_header.payloadType;
     packet.sequence_number = rtp_header.sequenceNumber;
     packet.timestamp = rtp_header.timestamp;
     packet.payload.SetData(payload.data(), payload.size());
     // Waiting time will be set upon inserting the packet in the buffer.
     RTC_DCHECK(!packet.waiting_time);
-    return packet;
-  }());
+  }
 
   bool update_sample_rate_and_channels =
       first_packet_ || (rtp_header.ssrc != ssrc_);
@@ -688,6 +692,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
       const auto sequence_number = packet.sequence_number;
       const auto payload_type = packet.payload_type;
       const Packet::Priority original_priority = packet.priority;
+      const size_t payload_size = packet.payload.size();
       auto packet_from_result = [&](AudioDecoder::ParseResult& result) {
         Packet new_packet;
         new_packet.sequence_number = sequence_number;
@@ -696,6 +701,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
         new_packet.priority.codec_level = result.priority;
         new_packet.priority.red_level = original_priority.red_level;
         new_packet.frame = std::move(result.frame);
+        new_packet.frame_payload_size = payload_size;
         return new_packet;
       };
 
@@ -703,7 +709,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
           info->GetDecoder()->ParsePayload(std::move(packet.payload),
                                            packet.timestamp);
       if (results.empty()) {
-        packet_list.pop_front();
+        packet_buffer_->RecyclePacket(&packet_list);
       } else {
         bool first = true;
         for (auto& result : results) {
@@ -832,8 +838,10 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame, bool* muted) {
       lifetime_stats.voice_concealed_samples, fs_hz_);
 
   // Check for muted state.
-  if (enable_muted_state_ && expand_->Muted() && packet_buffer_->Empty()) {
-    RTC_DCHECK_EQ(last_mode_, kModeExpand);
+  const bool muted_expand =
+      enable_muted_state_ && expand_->Muted() && packet_buffer_->Empty();
+  if (muted_expand || MuteComfortNoise()) {
+    RTC_DCHECK(!muted_expand || last_mode_ == kModeExpand);
     audio_frame->Reset();
     RTC_DCHECK(audio_frame->muted());  // Reset() should mute the frame.
     playout_timestamp_ += static_cast<uint32_t>(output_size_samples_);
@@ -845,7 +853,8 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame, bool* muted) {
             : timestamp_scaler_->ToExternal(playout_timestamp_) -
                   static_cast<uint32_t>(audio_frame->samples_per_channel_);
     audio_frame->num_channels_ = sync_buffer_->Channels();
-    stats_.ExpandedNoiseSamples(output_size_samples_, false);
+    if (muted_expand)
+      stats_.ExpandedNoiseSamples(output_size_samples_, false);
     *muted = true;
     return 0;
   }
@@ -1030,12 +1039,37 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame, bool* muted) {
         last_mode_ == kModeExpand)) {
     generated_noise_stopwatch_.reset();
   }
+  if (last_mode_ == kModeRfc3389Cng || last_mode_ == kModeCodecInternalCng) {
+    if (!comfort_noise_stopwatch_)
+      comfort_noise_stopwatch_ = tick_timer_->GetNewStopwatch();
+  } else {
+    comfort_noise_stopwatch_.reset();
+  }
 
   if (decode_return_value)
     return decode_return_value;
   return return_value;
 }
 
+bool NetEqImpl::MuteComfortNoise() {
+  if (!enable_muted_state_ || !enable_muted_comfort_noise_ ||
+      !comfort_noise_stopwatch_ ||
+      comfort_noise_stopwatch_->ElapsedMs() < kMutedComfortNoiseDelayMs) {
+    return false;
+  }
+  // The timing is kept by |generated_noise_stopwatch_|, which keeps running
+  // from the last comfort noise packet that was used, so the discarded ones
+  // don't shift it.
+  const Packet* packet = packet_buffer_->PeekNextPacket();
+  while (packet && decoder_database_->IsComfortNoise(packet->payload_type)) {
+    if (packet_buffer_->DiscardNextPacket(&stats_) != PacketBuffer::kOK) {
+      RTC_NOTREACHED();  // Must be ok by design.
+    }
+    packet = packet_buffer_->PeekNextPacket();
+  }
+  return !packet;
+}
+
 int NetEqImpl::GetDecision(Operations* operation,
                            PacketList* packet_list,
                            DtmfEvent* dtmf_event,
@@ -1452,7 +1486,7 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list,
         rtc::ArrayView<int16_t>(&decoded_buffer_[*decoded_length],
                                 decoded_buffer_length_ - *decoded_length));
     last_decoded_timestamps_.push_back(packet_list->front().timestamp);
-    packet_list->pop_front();
+    packet_buffer_->RecyclePacket(packet_list);
     if (opt_result) {
       const auto& result = *opt_result;
       *speech_type = result.speech_type;
@@ -1491,8 +1525,16 @@ void NetEqImpl::DoNormal(const int16_t* decoded_buffer,
                          AudioDecoder::SpeechType speech_type,
                          bool play_dtmf) {
   assert(normal_.get());
-  normal_->Process(decoded_buffer, decoded_length, last_mode_,
-                   algorithm_buffer_.get());
+  if (decoded_length != 0 && last_mode_ != kModeExpand &&
+      last_mode_ != kModeRfc3389Cng &&
+      decoded_length % sync_buffer_->Channels() == 0) {
+    // There is nothing to cross-fade with, so the decoded audio goes straight
+    // to |sync_buffer_| instead of through |algorithm_buffer_|.
+    sync_buffer_->PushBackInterleaved(decoded_buffer, decoded_length);
+  } else {
+    normal_->Process(decoded_buffer, decoded_length, last_mode_,
+                     algorithm_buffer_.get());
+  }
   if (decoded_length != 0) {
     last_mode_ = kModeNormal;
   }
@@ -1888,14 +1930,16 @@ int NetEqImpl::ExtractPackets(size_t required_samples,
   // Packet extraction loop.
   do {
     timestamp_ = next_packet->timestamp;
-    absl::optional<Packet> packet = packet_buffer_->GetNextPacket();
+    // The packet is moved to the end of |packet_list| right away.
+    const bool got_packet = packet_buffer_->GetNextPacket(packet_list);
     // |next_packet| may be invalid after the |packet_buffer_| operation.
     next_packet = nullptr;
-    if (!packet) {
+    if (!got_packet) {
       RTC_LOG(LS_ERROR) << "Should always be able to extract a packet here";
       assert(false);  // Should always be able to extract a packet here.
       return -1;
     }
+    const Packet* packet = &packet_list->back();
     const uint64_t waiting_time_ms = packet->waiting_time->ElapsedMs();
     stats_.StoreWaitingTime(waiting_time_ms);
     RTC_DCHECK(!packet->empty());
@@ -1939,9 +1983,6 @@ int NetEqImpl::ExtractPackets(size_t required_samples,
 
     stats_.JitterBufferDelay(extracted_samples, waiting_time_ms);
 
-    packet_list->push_back(std::move(*packet));  // Store packet in list.
-    packet = absl::nullopt;  // Ensure it's never used after the move.
-
     // Check what packet is available next.
     next_packet = packet_buffer_->PeekNextPacket();
     next_packet_available = false;
@@ -227,6 +227,9 @@ class NetEqImpl : public webrtc::NetEq {
   // Current value is kMaxFrameSize + 60 ms * 48 kHz, which is enough for
   // calculating correlations of current frame against history.
   static const size_t kSyncBufferSize = kMaxFrameSize + 60 * 48;
+  // How long comfort noise is generated before muted state is entered, with
+  // Config::enable_muted_comfort_noise.
+  static const int kMutedComfortNoiseDelayMs = 1000;
 
   // Inserts a new packet into NetEq. This is used by the InsertPacket method
   // above. Returns 0 on success, otherwise an error code.
@@ -241,6 +244,11 @@ class NetEqImpl : public webrtc::NetEq {
   int GetAudioInternal(AudioFrame* audio_frame, bool* muted)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
+  // Returns true if the comfort noise of the next 10 ms should be replaced by
+  // a muted frame. Discards the comfort noise packets that would only update
+  // the parameters of the noise that isn't generated.
+  bool MuteComfortNoise() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
   // Provides a decision to the GetAudioInternal method. The decision what to
   // do is written to |operation|. Packets to decode are written to
   // |packet_list|, and a DTMF event to play is written to |dtmf_event|. When
@@ -416,10 +424,15 @@ class NetEqImpl : public webrtc::NetEq {
   std::unique_ptr<NackTracker> nack_ RTC_GUARDED_BY(crit_sect_);
   bool nack_enabled_ RTC_GUARDED_BY(crit_sect_);
   const bool enable_muted_state_ RTC_GUARDED_BY(crit_sect_);
+  const bool enable_muted_comfort_noise_ RTC_GUARDED_BY(crit_sect_);
   AudioFrame::VADActivity last_vad_activity_ RTC_GUARDED_BY(crit_sect_) =
       AudioFrame::kVadPassive;
   std::unique_ptr<TickTimer::Stopwatch> generated_noise_stopwatch_
       RTC_GUARDED_BY(crit_sect_);
+  // Started when comfort noise starts, unlike |generated_noise_stopwatch_|
+  // which restarts with every comfort noise packet.
+  std::unique_ptr<TickTimer::Stopwatch> comfort_noise_stopwatch_
+      RTC_GUARDED_BY(crit_sect_);
   std::vector<uint32_t> last_decoded_timestamps_ RTC_GUARDED_BY(crit_sect_);
   ExpandUmaLogger expand_uma_logger_ RTC_GUARDED_BY(crit_sect_);
   ExpandUmaLogger speech_expand_uma_logger_ RTC_GUARDED_BY(crit_sect_);
@@ -1451,6 +1451,56 @@ TEST_F(NetEqDecodingTestWithMutedState, RecoverAfterExtendedCngWithoutPackets) {
   GetAudioUntilNormal();
 }
 
+class NetEqDecodingTestWithMutedComfortNoise
+    : public NetEqDecodingTestWithMutedState {
+ public:
+  NetEqDecodingTestWithMutedComfortNoise() {
+    config_.enable_muted_comfort_noise = true;
+  }
+};
+
+// Verifies that NetEq stops generating comfort noise after a while, keeps
+// consuming the comfort noise updates, and resumes with the next speech packet.
+TEST_F(NetEqDecodingTestWithMutedComfortNoise, MutesProlongedComfortNoise) {
+  InsertPacket(0);
+  EXPECT_FALSE(GetAudioReturnMuted());
+
+  // Pull 3 seconds of audio with one CNG packet every 100 ms.
+  int num_muted = 0;
+  for (counter_ = 1; counter_ < 300; ++counter_) {
+    if (counter_ % 10 == 0)
+      InsertCngPacket(kSamples * counter_);
+    if (GetAudioReturnMuted())
+      ++num_muted;
+  }
+  EXPECT_TRUE(out_frame_.muted());
+  EXPECT_EQ(AudioFrame::kCNG, out_frame_.speech_type_);
+  // Muted for about the last 2 seconds.
+  EXPECT_GT(num_muted, 150);
+  int current_num_packets;
+  int max_num_packets;
+  neteq_->PacketBufferStatistics(&current_num_packets, &max_num_packets);
+  EXPECT_EQ(0, current_num_packets);
+
+  InsertPacket(kSamples * counter_);
+  GetAudioUntilNormal();
+  EXPECT_FALSE(out_frame_.muted());
+}
+
+// Verifies that NetEq mutes comfort noise also when the packet stream is
+// suspended, and goes back to normal afterwards.
+TEST_F(NetEqDecodingTestWithMutedComfortNoise, MutesExtendedCngWithoutPackets) {
+  InsertCngPacket(0);
+  GetAudioUntilMuted();
+  EXPECT_EQ(AudioFrame::kCNG, out_frame_.speech_type_);
+  // Roughly after NetEqImpl::kMutedComfortNoiseDelayMs.
+  EXPECT_GE(counter_, 95);
+  EXPECT_LE(counter_, 105);
+
+  InsertPacket(kSamples * counter_);
+  GetAudioUntilNormal();
+}
+
 class NetEqDecodingTestTwoInstances : public NetEqDecodingTest {
  public:
   NetEqDecodingTestTwoInstances() : NetEqDecodingTest() {}
@@ -72,6 +72,8 @@ struct Packet {
   Priority priority;
   std::unique_ptr<TickTimer::Stopwatch> waiting_time;
   std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame;
+  // The size of the encoded payload that |frame| holds, for memory accounting.
+  size_t frame_payload_size = 0;
 
   Packet();
   Packet(Packet&& b);
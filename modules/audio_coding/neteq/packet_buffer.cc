@@ -15,6 +15,7 @@
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>  // find_if()
+#include <iterator>
 
 #include "api/audio_codecs/audio_decoder.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
@@ -24,6 +25,10 @@
 
 namespace webrtc {
 namespace {
+
+// Packets kept for reuse, enough for a steady stream of packets even with some
+// reordering.
+constexpr size_t kMaxSparePackets = 8;
 // Predicate used when inserting packets in the buffer list.
 // Operator() returns true when |packet| goes before |new_packet|.
 class NewTimestampIsLarger {
@@ -68,7 +73,8 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  buffer_.clear();
+  while (!buffer_.empty())
+    RecyclePacket(&buffer_);
 }
 
 bool PacketBuffer::Empty() const {
@@ -76,6 +82,19 @@ bool PacketBuffer::Empty() const {
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
+  PacketList packet_list;
+  AppendEmptyPacket(&packet_list);
+  packet_list.front() = std::move(packet);
+  const int return_val = InsertFirstPacket(&packet_list, stats);
+  if (!packet_list.empty())
+    RecyclePacket(&packet_list);
+  return return_val;
+}
+
+int PacketBuffer::InsertFirstPacket(PacketList* packet_list,
+                                    StatisticsCalculator* stats) {
+  RTC_DCHECK(!packet_list->empty());
+  const Packet& packet = packet_list->front();
   if (packet.empty()) {
     RTC_LOG(LS_WARNING) << "InsertPacket invalid packet";
     return kInvalidPacket;
@@ -86,7 +105,7 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
 
   int return_val = kOK;
 
-  packet.waiting_time = tick_timer_->GetNewStopwatch();
+  packet_list->front().waiting_time = tick_timer_->GetNewStopwatch();
 
   if (buffer_.size() >= max_number_of_packets_) {
     // Buffer is full. Flush it.
@@ -114,10 +133,10 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
   // packet.
   PacketList::iterator it = rit.base();
   if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level, stats);
-    it = buffer_.erase(it);
+    it = Discard(it, stats);
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  // Insert the packet at that position.
+  buffer_.splice(it, *packet_list, packet_list->begin());
 
   return return_val;
 }
@@ -130,7 +149,8 @@ int PacketBuffer::InsertPacketList(
     StatisticsCalculator* stats) {
   RTC_DCHECK(stats);
   bool flushed = false;
-  for (auto& packet : *packet_list) {
+  while (!packet_list->empty()) {
+    const Packet& packet = packet_list->front();
     if (decoder_database.IsComfortNoise(packet.payload_type)) {
       if (*current_cng_rtp_payload_type &&
           **current_cng_rtp_payload_type != packet.payload_type) {
@@ -154,7 +174,7 @@ int PacketBuffer::InsertPacketList(
       }
       *current_rtp_payload_type = packet.payload_type;
     }
-    int return_val = InsertPacket(std::move(packet), stats);
+    int return_val = InsertFirstPacket(packet_list, stats);
     if (return_val == kFlushed) {
       // The buffer flushed, but this is not an error. We can still continue.
       flushed = true;
@@ -163,8 +183,10 @@ int PacketBuffer::InsertPacketList(
       packet_list->clear();
       return return_val;
     }
+    // The packet is left in the list if it wasn't inserted.
+    if (!packet_list->empty() && &packet_list->front() == &packet)
+      RecyclePacket(packet_list);
   }
-  packet_list->clear();
   return flushed ? kFlushed : kOK;
 }
 
@@ -216,29 +238,76 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
   return packet;
 }
 
+bool PacketBuffer::GetNextPacket(PacketList* packet_list) {
+  if (Empty()) {
+    return false;
+  }
+  // Assert that the packet sanity checks in InsertPacket method works.
+  RTC_DCHECK(!buffer_.front().empty());
+  packet_list->splice(packet_list->end(), buffer_, buffer_.begin());
+  return true;
+}
+
+void PacketBuffer::AppendEmptyPacket(PacketList* packet_list) {
+  if (spare_packets_.empty()) {
+    packet_list->emplace_back();
+    return;
+  }
+  packet_list->splice(packet_list->end(), spare_packets_,
+                      spare_packets_.begin());
+}
+
+void PacketBuffer::RecyclePacket(PacketList* packet_list) {
+  RTC_DCHECK(!packet_list->empty());
+  if (spare_packets_.size() >= kMaxSparePackets) {
+    packet_list->pop_front();
+    return;
+  }
+  Packet& packet = packet_list->front();
+  packet.timestamp = 0;
+  packet.sequence_number = 0;
+  packet.payload_type = 0;
+  // Keeps the capacity.
+  packet.payload.Clear();
+  packet.priority = Packet::Priority();
+  packet.waiting_time.reset();
+  packet.frame.reset();
+  spare_packets_.splice(spare_packets_.end(), *packet_list,
+                        packet_list->begin());
+}
+
+PacketList::iterator PacketBuffer::Discard(PacketList::iterator it,
+                                           StatisticsCalculator* stats) {
+  LogPacketDiscarded(it->priority.codec_level, stats);
+  PacketList discarded;
+  PacketList::iterator next = std::next(it);
+  discarded.splice(discarded.end(), buffer_, it);
+  RecyclePacket(&discarded);
+  return next;
+}
+
 int PacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
   if (Empty()) {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
-  RTC_DCHECK(!packet.empty());
-  LogPacketDiscarded(packet.priority.codec_level, stats);
-  buffer_.pop_front();
+  RTC_DCHECK(!buffer_.front().empty());
+  Discard(buffer_.begin(), stats);
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples,
                                      StatisticsCalculator* stats) {
-  buffer_.remove_if([timestamp_limit, horizon_samples, stats](const Packet& p) {
-    if (timestamp_limit == p.timestamp ||
-        !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
-      return false;
+  for (auto it = buffer_.begin(); it != buffer_.end();) {
+    if (timestamp_limit == it->timestamp ||
+        !IsObsoleteTimestamp(it->timestamp, timestamp_limit,
+                             horizon_samples)) {
+      ++it;
+    } else {
+      it = Discard(it, stats);
     }
-    LogPacketDiscarded(p.priority.codec_level, stats);
-    return true;
-  });
+  }
 }
 
 void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
@@ -248,19 +317,27 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
                                                  StatisticsCalculator* stats) {
-  buffer_.remove_if([payload_type, stats](const Packet& p) {
-    if (p.payload_type != payload_type) {
-      return false;
+  for (auto it = buffer_.begin(); it != buffer_.end();) {
+    if (it->payload_type == payload_type) {
+      it = Discard(it, stats);
+    } else {
+      ++it;
     }
-    LogPacketDiscarded(p.priority.codec_level, stats);
-    return true;
-  });
+  }
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
   return buffer_.size();
 }
 
+size_t PacketBuffer::GetPayloadBytes() const {
+  size_t bytes = 0;
+  for (const Packet& packet : buffer_) {
+    bytes += packet.payload.size() + packet.frame_payload_size;
+  }
+  return bytes;
+}
+
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
@@ -91,6 +91,19 @@ class PacketBuffer {
   // Returns an empty optional if the buffer is empty.
   virtual absl::optional<Packet> GetNextPacket();
 
+  // Moves the first packet in the buffer to the end of |packet_list|, without
+  // copying it or allocating. Returns false if the buffer is empty.
+  virtual bool GetNextPacket(PacketList* packet_list);
+
+  // Appends an empty packet to |packet_list|. A packet that was discarded or
+  // recycled is reused if there is one, so that a steady stream of packets
+  // through the buffer doesn't allocate list nodes.
+  void AppendEmptyPacket(PacketList* packet_list);
+
+  // Removes the first packet of |packet_list|, e.g. once it is decoded, and
+  // keeps it for reuse by AppendEmptyPacket().
+  void RecyclePacket(PacketList* packet_list);
+
   // Discards the first packet in the buffer. The packet is deleted.
   // Returns PacketBuffer::kBufferEmpty if the buffer is empty,
   // PacketBuffer::kOK otherwise.
@@ -121,6 +134,9 @@ class PacketBuffer {
   // duplicate and redundant packets.
   virtual size_t NumSamplesInBuffer(size_t last_decoded_length) const;
 
+  // Returns the size of the encoded payload of the packets in the buffer.
+  virtual size_t GetPayloadBytes() const;
+
   // Returns true if the packet buffer contains any DTX or CNG packets.
   virtual bool ContainsDtxOrCngPacket(
       const DecoderDatabase* decoder_database) const;
@@ -142,8 +158,17 @@ class PacketBuffer {
   }
 
  private:
+  // Inserts the first packet of |packet_list| by moving its list node.
+  int InsertFirstPacket(PacketList* packet_list, StatisticsCalculator* stats);
+
+  // Discards the packet at |it| and returns the next one.
+  PacketList::iterator Discard(PacketList::iterator it,
+                               StatisticsCalculator* stats);
+
   size_t max_number_of_packets_;
   PacketList buffer_;
+  // Reset packets, for AppendEmptyPacket().
+  PacketList spare_packets_;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
@@ -11,6 +11,7 @@
 // Unit tests for PacketBuffer class.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
+#include "absl/memory/memory.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "modules/audio_coding/neteq/mock/mock_decoder_database.h"
 #include "modules/audio_coding/neteq/mock/mock_statistics_calculator.h"
@@ -76,6 +77,16 @@ struct PacketsToInsert {
   int extract_order;
 };
 
+// A frame parsed from a payload, standing in for what a decoder returns.
+class FakeFrame : public AudioDecoder::EncodedAudioFrame {
+ public:
+  size_t Duration() const override { return 10; }
+  absl::optional<DecodeResult> Decode(
+      rtc::ArrayView<int16_t> decoded) const override {
+    return absl::nullopt;
+  }
+};
+
 // Start of test definitions.
 
 TEST(PacketBuffer, CreateAndDestroy) {
@@ -128,6 +139,28 @@ TEST(PacketBuffer, FlushBuffer) {
   EXPECT_TRUE(buffer.Empty());
 }
 
+// Test that the payload bytes of the buffered packets are accounted for.
+TEST(PacketBuffer, GetPayloadBytes) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(10, &tick_timer);  // 10 packets.
+  PacketGenerator gen(0, 0, 0, 10);
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  EXPECT_EQ(0u, buffer.GetPayloadBytes());
+
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacket(gen.NextPacket(10), &mock_stats));
+  // A parsed frame keeps the size of the payload it was parsed from.
+  Packet packet = gen.NextPacket(0);
+  packet.frame = absl::make_unique<FakeFrame>();
+  packet.frame_payload_size = 20;
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacket(std::move(packet), &mock_stats));
+  EXPECT_EQ(30u, buffer.GetPayloadBytes());
+
+  buffer.Flush();
+  EXPECT_EQ(0u, buffer.GetPayloadBytes());
+}
+
 // Test to fill the buffer over the limits, and verify that it flushes.
 TEST(PacketBuffer, OverfillBuffer) {
   TickTimer tick_timer;
@@ -197,6 +230,50 @@ TEST(PacketBuffer, InsertPacketList) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Verifies that packets move through the buffer without being copied, and that
+// the list nodes of recycled packets are reused.
+TEST(PacketBuffer, MovesAndReusesPackets) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(10, &tick_timer);  // 10 packets.
+  PacketGenerator gen(0, 0, 0, 10);
+  PacketList list;
+  buffer.AppendEmptyPacket(&list);
+  list.front() = gen.NextPacket(10);
+  const Packet* const packet = &list.front();
+
+  MockDecoderDatabase decoder_database;
+  auto factory = CreateBuiltinAudioDecoderFactory();
+  const DecoderDatabase::DecoderInfo info(NetEqDecoder::kDecoderPCMu,
+                                          absl::nullopt, factory);
+  EXPECT_CALL(decoder_database, GetDecoderInfo(0))
+      .WillRepeatedly(Return(&info));
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  absl::optional<uint8_t> current_pt;
+  absl::optional<uint8_t> current_cng_pt;
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacketList(&list, decoder_database, &current_pt,
+                                    &current_cng_pt, &mock_stats));
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(packet, buffer.PeekNextPacket());
+
+  PacketList extracted;
+  EXPECT_TRUE(buffer.GetNextPacket(&extracted));
+  EXPECT_FALSE(buffer.GetNextPacket(&extracted));
+  ASSERT_EQ(1u, extracted.size());
+  EXPECT_EQ(packet, &extracted.front());
+  EXPECT_TRUE(extracted.front().waiting_time);
+
+  buffer.RecyclePacket(&extracted);
+  EXPECT_TRUE(extracted.empty());
+  buffer.AppendEmptyPacket(&list);
+  ASSERT_EQ(1u, list.size());
+  EXPECT_EQ(packet, &list.front());
+  EXPECT_TRUE(list.front().empty());
+  EXPECT_FALSE(list.front().waiting_time);
+
+  EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
+}
+
 // Test inserting a list of packets. Last packet is of a different payload type.
 // Expecting the buffer to flush.
 // TODO(hlundin): Remove this test when legacy operation is no longer needed.
@@ -34,6 +34,10 @@ class SyncBuffer : public AudioMultiVector {
   // the move of the beginning of "future" data.
   void PushBack(const AudioMultiVector& append_this) override;
 
+  // Like PushBack(), but appends the channel-interleaved |append_this| of
+  // |length| samples, e.g. straight from a decoder.
+  void PushBackInterleaved(const int16_t* append_this, size_t length) override;
+
   // Adds |length| zeros to the beginning of each channel. Removes
   // the same number of samples from the end of the SyncBuffer, to
   // maintain a constant buffer size. The |next_index_| is updated to reflect
@@ -89,6 +93,10 @@ class SyncBuffer : public AudioMultiVector {
   void set_dtmf_index(size_t value);
 
  private:
+  // Removes |length| samples from the beginning after they were added to the
+  // end, and moves the indices accordingly.
+  void PopFrontAfterPushBack(size_t length);
+
   size_t next_index_;
   uint32_t end_timestamp_;  // The timestamp of the last sample in the buffer.
   size_t dtmf_index_;       // Index to the first non-DTMF sample in the buffer.
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <string>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/timeutils.h"
+
+// Define command line flags.
+DEFINE_int(iterations, 100000, "Number of calls to time for each kernel.");
+DEFINE_bool(help, false, "Print this message.");
+
+namespace {
+
+// Sizes of the calls made by Expand, Merge and the time-stretch classes at
+// 48 kHz.
+constexpr size_t kCorrelationLength = 60;
+constexpr size_t kNumCorrelationLags = 54;
+constexpr size_t kDotProductLength = 240;
+constexpr size_t kOverlapLength = 480;
+constexpr size_t kBufferLength =
+    kCorrelationLength + kNumCorrelationLags + kOverlapLength;
+
+int16_t vector1[kBufferLength];
+int16_t vector2[kBufferLength];
+int16_t output[kOverlapLength];
+int32_t correlation[kNumCorrelationLags];
+// Keeps the compiler from optimizing the dot products away.
+volatile int32_t dot_product_sink;
+
+// Expand and the time-stretch classes search for the pitch lag by correlating
+// with the signal stepped backwards.
+void RunCrossCorrelationC() {
+  WebRtcSpl_CrossCorrelationC(correlation, &vector1[kNumCorrelationLags],
+                              &vector2[kNumCorrelationLags], kCorrelationLength,
+                              kNumCorrelationLags, 0, -1);
+}
+
+void RunCrossCorrelation() {
+  WebRtcSpl_CrossCorrelation(correlation, &vector1[kNumCorrelationLags],
+                             &vector2[kNumCorrelationLags], kCorrelationLength,
+                             kNumCorrelationLags, 0, -1);
+}
+
+void RunDotProductWithScaleC() {
+  dot_product_sink =
+      WebRtcSpl_DotProductWithScaleC(vector1, vector2, kDotProductLength, 2);
+}
+
+void RunDotProductWithScale() {
+  dot_product_sink =
+      WebRtcSpl_DotProductWithScale(vector1, vector2, kDotProductLength, 2);
+}
+
+// The overlap-add of Expand and Merge.
+void RunScaleAndAddVectorsWithRoundC() {
+  WebRtcSpl_ScaleAndAddVectorsWithRoundC(vector1, 3, vector2, 1, 2, output,
+                                         kOverlapLength);
+}
+
+void RunScaleAndAddVectorsWithRound() {
+  WebRtcSpl_ScaleAndAddVectorsWithRound(vector1, 3, vector2, 1, 2, output,
+                                        kOverlapLength);
+}
+
+double NanosecondsPerCall(int iterations, void (*function)()) {
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i)
+    function();
+  return static_cast<double>(rtc::TimeNanos() - start_ns) / iterations;
+}
+
+void PrintResult(const char* kernel,
+                 int iterations,
+                 void (*c_function)(),
+                 void (*function)()) {
+  const double c_ns = NanosecondsPerCall(iterations, c_function);
+  const double ns = NanosecondsPerCall(iterations, function);
+  printf("%-28s %10.1f %10.1f %8.2fx\n", kernel, c_ns, ns, c_ns / ns);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage =
+      "Tool for timing the DSP kernels NetEq uses for expansion, merging and\n"
+      "time-stretching, comparing the generic C versions with the ones\n"
+      "selected for this CPU.\n"
+      "Usage: " +
+      program_name +
+      " [options]\n\n"
+      "  --iterations=N         calls per kernel; default is 100000\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) || FLAG_help ||
+      argc != 1) {
+    printf("%s", usage.c_str());
+    if (FLAG_help) {
+      rtc::FlagList::Print(nullptr, false);
+      return 0;
+    }
+    return 1;
+  }
+  RTC_CHECK_GT(FLAG_iterations, 0);
+
+  WebRtcSpl_Init();
+  uint32_t seed = 1;
+  for (size_t i = 0; i < kBufferLength; ++i) {
+    // Keep the samples small enough for unscaled sums not to overflow.
+    vector1[i] = static_cast<int16_t>(WebRtcSpl_RandU(&seed) >> 4);
+    vector2[i] = static_cast<int16_t>(WebRtcSpl_RandU(&seed) >> 4);
+  }
+
+  printf("%-28s %10s %10s %9s\n", "Kernel", "C (ns)", "Used (ns)", "Speedup");
+  PrintResult("CrossCorrelation", FLAG_iterations, &RunCrossCorrelationC,
+              &RunCrossCorrelation);
+  PrintResult("DotProductWithScale", FLAG_iterations, &RunDotProductWithScaleC,
+              &RunDotProductWithScale);
+  PrintResult("ScaleAndAddVectorsWithRound", FLAG_iterations,
+              &RunScaleAndAddVectorsWithRoundC,
+              &RunScaleAndAddVectorsWithRound);
+  return 0;
+}
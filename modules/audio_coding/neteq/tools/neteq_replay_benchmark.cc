@@ -0,0 +1,284 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_replay_benchmark.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "modules/audio_coding/neteq/tools/neteq_packet_source_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+#include "modules/audio_coding/neteq/tools/rtp_file_source.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/platform_thread.h"
+
+#if WEBRTC_ENABLE_PROTOBUF
+#include "modules/audio_coding/neteq/tools/neteq_event_log_input.h"
+#endif
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// The extension IDs used by neteq_rtpplay by default.
+const NetEqPacketSourceInput::RtpHeaderExtensionMap kRtpExtensionMap = {
+    {1, kRtpExtensionAudioLevel},
+    {3, kRtpExtensionAbsoluteSendTime},
+    {5, kRtpExtensionTransportSequenceNumber},
+    {7, kRtpExtensionVideoContentType},
+    {8, kRtpExtensionVideoTiming}};
+
+// Holds all packets and output events of another input in memory.
+class PreloadedNetEqInput : public NetEqInput {
+ public:
+  explicit PreloadedNetEqInput(NetEqInput* input) {
+    // Visit the events in the order NetEqTest would.
+    while (!input->ended()) {
+      const int64_t time_now_ms = *input->NextEventTime();
+      if (input->NextPacketTime() && time_now_ms >= *input->NextPacketTime())
+        packets_.push_back(input->PopPacket());
+      if (input->NextOutputEventTime() &&
+          time_now_ms >= *input->NextOutputEventTime()) {
+        output_event_times_ms_.push_back(time_now_ms);
+        input->AdvanceOutputEvent();
+      }
+    }
+  }
+
+  absl::optional<int64_t> NextPacketTime() const override {
+    if (next_packet_ == packets_.size())
+      return absl::nullopt;
+    return packets_[next_packet_]->time_ms;
+  }
+
+  absl::optional<int64_t> NextOutputEventTime() const override {
+    if (ended())
+      return absl::nullopt;
+    return output_event_times_ms_[next_output_event_];
+  }
+
+  std::unique_ptr<PacketData> PopPacket() override {
+    if (next_packet_ == packets_.size())
+      return nullptr;
+    return std::move(packets_[next_packet_++]);
+  }
+
+  void AdvanceOutputEvent() override { ++next_output_event_; }
+
+  bool ended() const override {
+    return next_output_event_ == output_event_times_ms_.size();
+  }
+
+  absl::optional<RTPHeader> NextHeader() const override {
+    if (next_packet_ == packets_.size())
+      return absl::nullopt;
+    return packets_[next_packet_]->header;
+  }
+
+ private:
+  std::vector<std::unique_ptr<PacketData>> packets_;
+  std::vector<int64_t> output_event_times_ms_;
+  size_t next_packet_ = 0;
+  size_t next_output_event_ = 0;
+};
+
+// Counts the errors instead of aborting, so that one broken capture doesn't
+// stop the benchmark.
+class CountingErrorCallback : public NetEqTestErrorCallback {
+ public:
+  void OnInsertPacketError(const NetEqInput::PacketData& packet) override {
+    ++insert_packet_errors;
+  }
+  void OnGetAudioError() override { ++get_audio_errors; }
+
+  int insert_packet_errors = 0;
+  int get_audio_errors = 0;
+};
+
+struct ReplayQueue {
+  const std::vector<std::string>* file_names;
+  std::vector<NetEqReplayMetrics>* metrics;
+  AllocationCounter allocation_counter;
+  volatile int next_index;
+};
+
+void ReplayFilesFromQueue(void* obj) {
+  ReplayQueue* queue = static_cast<ReplayQueue*>(obj);
+  const int num_files = static_cast<int>(queue->file_names->size());
+  for (int index = rtc::AtomicOps::Increment(&queue->next_index) - 1;
+       index < num_files;
+       index = rtc::AtomicOps::Increment(&queue->next_index) - 1) {
+    (*queue->metrics)[index] = ReplayNetEqFile((*queue->file_names)[index],
+                                               queue->allocation_counter);
+  }
+}
+
+std::string EscapeJson(const std::string& text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+}  // namespace
+
+NetEqReplayMetrics::NetEqReplayMetrics() = default;
+NetEqReplayMetrics::NetEqReplayMetrics(const NetEqReplayMetrics&) = default;
+NetEqReplayMetrics::~NetEqReplayMetrics() = default;
+
+NetEqReplayMetrics ReplayNetEqInput(const std::string& name,
+                                    std::unique_ptr<NetEqInput> input,
+                                    AllocationCounter allocation_counter) {
+  NetEqReplayMetrics metrics;
+  metrics.name = name;
+  const NetEqTest::DecoderMap codecs = NetEqTest::StandardDecoderMap();
+
+  while (absl::optional<RTPHeader> header = input->NextHeader()) {
+    if (codecs.find(header->payloadType) != codecs.end())
+      break;
+    input->PopPacket();
+  }
+  if (!input->NextHeader())
+    return metrics;
+
+  CountingErrorCallback error_callback;
+  NetEqStatsGetter stats_getter(nullptr);
+  NetEqTest::Callbacks callbacks;
+  callbacks.error_callback = &error_callback;
+  callbacks.get_audio_callback = &stats_getter;
+  NetEqTest test(NetEq::Config(), codecs, NetEqTest::ExtDecoderMap(),
+                 absl::make_unique<PreloadedNetEqInput>(input.get()), nullptr,
+                 callbacks);
+  input.reset();
+
+  const int64_t start_allocations =
+      allocation_counter ? allocation_counter() : 0;
+  const int64_t start_cpu_time_ns = rtc::GetThreadCpuTimeNanos();
+  metrics.stream_duration_ms = test.Run();
+  metrics.cpu_time_us =
+      (rtc::GetThreadCpuTimeNanos() - start_cpu_time_ns) / 1000;
+  if (allocation_counter)
+    metrics.allocations = allocation_counter() - start_allocations;
+
+  metrics.ok = true;
+  metrics.insert_packet_errors = error_callback.insert_packet_errors;
+  metrics.get_audio_errors = error_callback.get_audio_errors;
+  metrics.average_stats = stats_getter.AverageStats();
+  metrics.lifetime_stats = test.LifetimeStats();
+  return metrics;
+}
+
+NetEqReplayMetrics ReplayNetEqFile(const std::string& file_name,
+                                   AllocationCounter allocation_counter) {
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file) {
+    NetEqReplayMetrics metrics;
+    metrics.name = file_name;
+    return metrics;
+  }
+  fclose(file);
+
+  std::unique_ptr<NetEqPacketSourceInput> input;
+  if (RtpFileSource::ValidRtpDump(file_name) ||
+      RtpFileSource::ValidPcap(file_name)) {
+    input = absl::make_unique<NetEqRtpDumpInput>(file_name, kRtpExtensionMap);
+  } else {
+#if WEBRTC_ENABLE_PROTOBUF
+    input = absl::make_unique<NetEqEventLogInput>(file_name, kRtpExtensionMap);
+#else
+    NetEqReplayMetrics metrics;
+    metrics.name = file_name;
+    return metrics;
+#endif
+  }
+
+  // Replay only the stream of the first packet NetEq can decode.
+  const NetEqTest::DecoderMap codecs = NetEqTest::StandardDecoderMap();
+  while (absl::optional<RTPHeader> header = input->NextHeader()) {
+    if (codecs.find(header->payloadType) != codecs.end()) {
+      input->SelectSsrc(header->ssrc);
+      break;
+    }
+    input->PopPacket();
+  }
+  return ReplayNetEqInput(file_name, std::move(input), allocation_counter);
+}
+
+std::vector<NetEqReplayMetrics> ReplayNetEqFiles(
+    const std::vector<std::string>& file_names,
+    int num_threads,
+    AllocationCounter allocation_counter) {
+  RTC_DCHECK_GT(num_threads, 0);
+  std::vector<NetEqReplayMetrics> metrics(file_names.size());
+  ReplayQueue queue;
+  queue.file_names = &file_names;
+  queue.metrics = &metrics;
+  queue.allocation_counter = allocation_counter;
+  queue.next_index = 0;
+  num_threads = std::min(num_threads, static_cast<int>(file_names.size()));
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(absl::make_unique<rtc::PlatformThread>(
+        &ReplayFilesFromQueue, &queue, "NetEqReplay"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+  return metrics;
+}
+
+void WriteNetEqReplayMetricsAsJson(
+    FILE* out,
+    const std::vector<NetEqReplayMetrics>& metrics) {
+  for (const NetEqReplayMetrics& m : metrics) {
+    const std::string name = EscapeJson(m.name);
+    if (!m.ok) {
+      fprintf(out, "{\"file\":\"%s\",\"ok\":false}\n", name.c_str());
+      continue;
+    }
+    const double stream_seconds = m.stream_duration_ms / 1000.0;
+    const NetEqStatsGetter::Stats& s = m.average_stats;
+    fprintf(out,
+            "{\"file\":\"%s\",\"ok\":true,\"stream_duration_s\":%.3f,"
+            "\"cpu_time_ms\":%.3f,\"cpu_us_per_stream_second\":%.1f,"
+            "\"allocations\":%lld,\"allocations_per_stream_second\":%.1f,"
+            "\"insert_packet_errors\":%d,\"get_audio_errors\":%d,"
+            "\"current_buffer_size_ms\":%.1f,"
+            "\"preferred_buffer_size_ms\":%.1f,"
+            "\"mean_waiting_time_ms\":%.1f,\"median_waiting_time_ms\":%.1f,"
+            "\"max_waiting_time_ms\":%.1f,\"packet_loss_rate\":%.4f,"
+            "\"expand_rate\":%.4f,\"speech_expand_rate\":%.4f,"
+            "\"accelerate_rate\":%.4f,\"preemptive_rate\":%.4f,"
+            "\"concealment_events\":%llu}\n",
+            name.c_str(), stream_seconds, m.cpu_time_us / 1000.0,
+            stream_seconds > 0 ? m.cpu_time_us / stream_seconds : 0.0,
+            static_cast<long long>(m.allocations),
+            stream_seconds > 0 && m.allocations >= 0
+                ? m.allocations / stream_seconds
+                : 0.0,
+            m.insert_packet_errors, m.get_audio_errors,
+            s.current_buffer_size_ms, s.preferred_buffer_size_ms,
+            s.mean_waiting_time_ms, s.median_waiting_time_ms,
+            s.max_waiting_time_ms, s.packet_loss_rate, s.expand_rate,
+            s.speech_expand_rate, s.accelerate_rate, s.preemptive_rate,
+            static_cast<unsigned long long>(
+                m.lifetime_stats.concealment_events));
+  }
+  fflush(out);
+}
+
+}  // namespace test
+}  // namespace webrtc
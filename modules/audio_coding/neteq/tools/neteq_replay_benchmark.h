@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_REPLAY_BENCHMARK_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_REPLAY_BENCHMARK_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/audio_coding/neteq/include/neteq.h"
+#include "modules/audio_coding/neteq/tools/neteq_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
+
+namespace webrtc {
+namespace test {
+
+struct NetEqReplayMetrics {
+  NetEqReplayMetrics();
+  NetEqReplayMetrics(const NetEqReplayMetrics&);
+  ~NetEqReplayMetrics();
+
+  std::string name;
+  // False if the input couldn't be opened or has no packets NetEq can decode.
+  bool ok = false;
+  // Duration of the produced audio.
+  int64_t stream_duration_ms = 0;
+  // CPU time of the thread spent in NetEq while replaying the stream.
+  int64_t cpu_time_us = 0;
+  // Memory allocations made while replaying the stream, or -1 if they weren't
+  // counted.
+  int64_t allocations = -1;
+  int insert_packet_errors = 0;
+  int get_audio_errors = 0;
+  // Averages of the NetEqNetworkStatistics, queried once per second.
+  NetEqStatsGetter::Stats average_stats;
+  NetEqLifetimeStatistics lifetime_stats;
+};
+
+// Returns the number of memory allocations made on the calling thread so far.
+// NetEq can't count them itself, so a benchmark that wants them replaces the
+// global operator new and provides this.
+using AllocationCounter = int64_t (*)();
+
+// Replays |input| through NetEq, with the decoders of
+// NetEqTest::StandardDecoderMap(), starting at the first packet with a known
+// payload type. The input is read into memory before the replay, so that
+// reading and parsing it isn't measured. |allocation_counter| may be null.
+NetEqReplayMetrics ReplayNetEqInput(const std::string& name,
+                                    std::unique_ptr<NetEqInput> input,
+                                    AllocationCounter allocation_counter);
+
+// Replays the stream of the first decodable packet in an RTP dump, pcap or
+// RtcEventLog file. The extension IDs are those neteq_rtpplay uses by default.
+NetEqReplayMetrics ReplayNetEqFile(const std::string& file_name,
+                                   AllocationCounter allocation_counter);
+
+// Replays the files on |num_threads| threads, one file at a time per thread.
+// The metrics are returned in the order of |file_names|.
+std::vector<NetEqReplayMetrics> ReplayNetEqFiles(
+    const std::vector<std::string>& file_names,
+    int num_threads,
+    AllocationCounter allocation_counter);
+
+// Writes one JSON object per file and line.
+void WriteNetEqReplayMetricsAsJson(
+    FILE* out,
+    const std::vector<NetEqReplayMetrics>& metrics);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_REPLAY_BENCHMARK_H_
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+#include "modules/audio_coding/neteq/tools/neteq_replay_benchmark.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/flags.h"
+
+// Define command line flags.
+DEFINE_int(threads, 1, "Number of files replayed in parallel.");
+DEFINE_string(json, "", "Write the metrics of each file as JSON to this file.");
+DEFINE_bool(help, false, "Print this message.");
+
+namespace {
+
+// Each file is replayed on a single thread, so a per thread count attributes
+// the allocations to the right file.
+thread_local int64_t allocation_count = 0;
+
+int64_t ThreadAllocationCount() {
+  return allocation_count;
+}
+
+void* Allocate(size_t size) {
+  ++allocation_count;
+  return malloc(size == 0 ? 1 : size);
+}
+
+void* AllocateOrAbort(size_t size) {
+  void* p = Allocate(size);
+  if (!p)
+    abort();
+  return p;
+}
+
+}  // namespace
+
+// Every replaceable form of operator new and delete is defined, rather than
+// relying on the standard library forwarding some of them to the others, so
+// every allocation except over-aligned ones is counted.
+void* operator new(size_t size) {
+  return AllocateOrAbort(size);
+}
+
+void* operator new[](size_t size) {
+  return AllocateOrAbort(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  free(p);
+}
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage =
+      "Tool for benchmarking NetEq on a corpus of recorded RTP dumps, pcap\n"
+      "files and RtcEventLogs. Reports the CPU time and allocations per\n"
+      "second of audio, and the delay statistics of each file.\n"
+      "Usage: " +
+      program_name +
+      " [options] file1 [file2 ...]\n\n"
+      "  --threads=N            files replayed in parallel; default is 1\n"
+      "  --json=FILE            write the metrics as JSON to FILE\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) || FLAG_help ||
+      argc < 2) {
+    printf("%s", usage.c_str());
+    if (FLAG_help) {
+      rtc::FlagList::Print(nullptr, false);
+      return 0;
+    }
+    return 1;
+  }
+  RTC_CHECK_GT(FLAG_threads, 0);
+
+  const std::vector<std::string> file_names(argv + 1, argv + argc);
+  const std::vector<webrtc::test::NetEqReplayMetrics> metrics =
+      webrtc::test::ReplayNetEqFiles(file_names, FLAG_threads,
+                                     &ThreadAllocationCount);
+
+  printf("%10s %12s %10s %10s %8s  %s\n", "Stream (s)", "CPU (us/s)",
+         "Allocs/s", "Delay (ms)", "Expand", "File");
+  int64_t total_stream_ms = 0;
+  int64_t total_cpu_time_us = 0;
+  int64_t total_allocations = 0;
+  int failed = 0;
+  for (const webrtc::test::NetEqReplayMetrics& m : metrics) {
+    if (!m.ok || m.stream_duration_ms <= 0) {
+      printf("%10s %12s %10s %10s %8s  %s\n", "-", "-", "-", "-", "-",
+             m.name.c_str());
+      ++failed;
+      continue;
+    }
+    const double stream_seconds = m.stream_duration_ms / 1000.0;
+    printf("%10.1f %12.1f %10.1f %10.1f %8.4f  %s\n", stream_seconds,
+           m.cpu_time_us / stream_seconds, m.allocations / stream_seconds,
+           m.average_stats.current_buffer_size_ms,
+           m.average_stats.expand_rate, m.name.c_str());
+    total_stream_ms += m.stream_duration_ms;
+    total_cpu_time_us += m.cpu_time_us;
+    total_allocations += m.allocations;
+  }
+  if (total_stream_ms > 0) {
+    const double stream_seconds = total_stream_ms / 1000.0;
+    printf("%10.1f %12.1f %10.1f %10s %8s  %s\n", stream_seconds,
+           total_cpu_time_us / stream_seconds,
+           total_allocations / stream_seconds, "", "", "(total)");
+  }
+
+  if (strlen(FLAG_json) > 0) {
+    FILE* json_file = fopen(FLAG_json, "w");
+    RTC_CHECK(json_file) << "Cannot open " << FLAG_json;
+    webrtc::test::WriteNetEqReplayMetricsAsJson(json_file, metrics);
+    fclose(json_file);
+  }
+  if (failed > 0)
+    printf("Could not replay %d file(s).\n", failed);
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_replay_benchmark.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int64_t kInputDurationMs = 3000;
+constexpr int64_t kPacketDurationMs = 10;
+// PCM16b at 8 kHz.
+constexpr size_t kPayloadSizeBytes = 2 * 8 * kPacketDurationMs;
+
+// Sends a packet of constant audio, and gets audio, every 10 ms.
+class ConstantPacketInput : public NetEqInput {
+ public:
+  explicit ConstantPacketInput(uint8_t payload_type) {
+    header_.payloadType = payload_type;
+    header_.ssrc = 0x1234;
+  }
+
+  absl::optional<int64_t> NextPacketTime() const override {
+    if (packet_time_ms_ >= kInputDurationMs)
+      return absl::nullopt;
+    return packet_time_ms_;
+  }
+
+  absl::optional<int64_t> NextOutputEventTime() const override {
+    if (ended())
+      return absl::nullopt;
+    return output_event_time_ms_;
+  }
+
+  std::unique_ptr<PacketData> PopPacket() override {
+    if (!NextPacketTime())
+      return nullptr;
+    std::unique_ptr<PacketData> packet(new PacketData);
+    packet->header = header_;
+    packet->payload.SetSize(kPayloadSizeBytes);
+    std::fill_n(packet->payload.data(), kPayloadSizeBytes, 0x10);
+    packet->time_ms = packet_time_ms_;
+    ++header_.sequenceNumber;
+    header_.timestamp += kPayloadSizeBytes / 2;
+    packet_time_ms_ += kPacketDurationMs;
+    return packet;
+  }
+
+  void AdvanceOutputEvent() override {
+    output_event_time_ms_ += kPacketDurationMs;
+  }
+
+  bool ended() const override {
+    return output_event_time_ms_ >= kInputDurationMs;
+  }
+
+  absl::optional<RTPHeader> NextHeader() const override {
+    if (!NextPacketTime())
+      return absl::nullopt;
+    return header_;
+  }
+
+ private:
+  RTPHeader header_;
+  int64_t packet_time_ms_ = 0;
+  int64_t output_event_time_ms_ = 0;
+};
+
+std::unique_ptr<NetEqInput> CreateInput(uint8_t payload_type) {
+  return std::unique_ptr<NetEqInput>(new ConstantPacketInput(payload_type));
+}
+
+int64_t num_allocation_counter_calls = 0;
+
+// Pretends that 10 allocations are made between two calls.
+int64_t FakeAllocationCounter() {
+  return 10 * num_allocation_counter_calls++;
+}
+
+}  // namespace
+
+TEST(NetEqReplayBenchmark, ReplaysInput) {
+  // The standard decoder map has PCM16b at 8 kHz as payload type 93.
+  const NetEqReplayMetrics metrics =
+      ReplayNetEqInput("pcm16b", CreateInput(93), nullptr);
+  EXPECT_TRUE(metrics.ok);
+  EXPECT_EQ("pcm16b", metrics.name);
+  EXPECT_NEAR(kInputDurationMs, metrics.stream_duration_ms, 20);
+  EXPECT_GE(metrics.cpu_time_us, 0);
+  EXPECT_EQ(-1, metrics.allocations);
+  EXPECT_EQ(0, metrics.insert_packet_errors);
+  EXPECT_EQ(0, metrics.get_audio_errors);
+  EXPECT_EQ(0.0, metrics.average_stats.packet_loss_rate);
+  EXPECT_GT(metrics.lifetime_stats.total_samples_received, 0u);
+}
+
+TEST(NetEqReplayBenchmark, CountsAllocationsDuringTheReplay) {
+  const NetEqReplayMetrics metrics = ReplayNetEqInput(
+      "pcm16b", CreateInput(93), &FakeAllocationCounter);
+  EXPECT_TRUE(metrics.ok);
+  EXPECT_EQ(10, metrics.allocations);
+}
+
+TEST(NetEqReplayBenchmark, FailsWithoutDecodablePackets) {
+  EXPECT_FALSE(ReplayNetEqInput("unknown", CreateInput(127), nullptr).ok);
+  const std::vector<NetEqReplayMetrics> metrics =
+      ReplayNetEqFiles({"no_such_file.rtp", "no_such_file.log"}, 2, nullptr);
+  ASSERT_EQ(2u, metrics.size());
+  EXPECT_EQ("no_such_file.rtp", metrics[0].name);
+  EXPECT_FALSE(metrics[0].ok);
+  EXPECT_EQ("no_such_file.log", metrics[1].name);
+  EXPECT_FALSE(metrics[1].ok);
+}
+
+}  // namespace test
+}  // namespace webrtc
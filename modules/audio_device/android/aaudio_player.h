@@ -23,6 +23,7 @@
 
 namespace webrtc {
 
+class AAudioRecorder;
 class AudioDeviceBuffer;
 class FineAudioBuffer;
 class AudioManager;
@@ -46,7 +47,10 @@ class AudioManager;
 // Also supports automatic buffer-size adjustment based on underrun detections
 // where the internal AAudio buffer can be increased when needed. It will
 // reduce the risk of underruns (~glitches) at the expense of an increased
-// latency.
+// latency. With the "WebRTC-Audio-AAudioExclusiveMode" field trial enabled,
+// the buffer is also decreased again after a period without underruns. The
+// period doubles after each underrun, so a device settles on the smallest
+// buffer size that it can sustain.
 class AAudioPlayer final : public AAudioObserverInterface,
                            public rtc::MessageHandler {
  public:
@@ -65,6 +69,10 @@ class AAudioPlayer final : public AAudioObserverInterface,
 
   void AttachAudioBuffer(AudioDeviceBuffer* audioBuffer);
 
+  // Reads the audio of |recorder| in the data callback of this object, before
+  // the audio is rendered. Must be called before InitPlayout().
+  void AttachDuplexRecorder(AAudioRecorder* recorder);
+
   // Not implemented in AAudio.
   int SpeakerVolumeIsAvailable(bool& available);  // NOLINT
   int SetSpeakerVolume(uint32_t volume) { return -1; }
@@ -92,6 +100,10 @@ class AAudioPlayer final : public AAudioObserverInterface,
   // Closes the existing stream and starts a new stream.
   void HandleStreamDisconnected();
 
+  // Adjusts the buffer size of the output stream given the underruns
+  // detected before a callback of |num_frames| frames.
+  void TuneBufferSize(int32_t num_frames);
+
   // Ensures that methods are called from the same thread as this object is
   // created on.
   rtc::ThreadChecker main_thread_checker_;
@@ -125,6 +137,14 @@ class AAudioPlayer final : public AAudioObserverInterface,
   // Counts number of detected underrun events reported by AAudio.
   int32_t underrun_count_ = 0;
 
+  // Frames played out since the last underrun or buffer size decrease, and the
+  // time without underruns that is needed to decrease the buffer size.
+  int64_t frames_without_underrun_ = 0;
+  int buffer_decrease_interval_ms_ = 0;
+
+  // Recorder whose audio is read in the data callback, if any.
+  AAudioRecorder* duplex_recorder_ = nullptr;
+
   // True only for the first data callback in each audio session.
   bool first_data_callback_ = true;
 
@@ -16,12 +16,16 @@
 
 #include "modules/audio_device/android/aaudio_wrapper.h"
 #include "modules/audio_device/include/audio_device_defines.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/messagehandler.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_checker.h"
 
 namespace webrtc {
 
+class AAudioPlayer;
 class AudioDeviceBuffer;
 class FineAudioBuffer;
 class AudioManager;
@@ -38,6 +42,13 @@ class AudioManager;
 // StopRecording() to be able to call StartRecording() again. This is in line
 // with how the Java- based implementation works.
 //
+// In full-duplex mode, see ConnectFullDuplex(), the input stream is opened
+// without a data callback while playout is active, and the recorded audio is
+// read in the data callback of the AAudioPlayer instead. Capture and render
+// then run in one callback, which avoids the scheduling jitter between two
+// real-time threads and lowers the round-trip latency. Recording is restarted
+// when playout starts or stops, to switch between the two modes.
+//
 // TODO(henrika): add comments about device changes and adaptive buffer
 // management.
 class AAudioRecorder : public AAudioObserverInterface,
@@ -60,6 +71,15 @@ class AAudioRecorder : public AAudioObserverInterface,
 
   double latency_millis() const { return latency_millis_; }
 
+  // Called by the full-duplex AAudioPlayer when its playout starts or stops.
+  void OnPlayoutStarted();
+  void OnPlayoutStopped();
+
+  // Reads the audio recorded since the last call and delivers it to WebRTC.
+  // Called in the data callback of the full-duplex AAudioPlayer, on a
+  // real-time thread owned by AAudio.
+  void ReadDuplexInput();
+
   // TODO(henrika): add support using AAudio APIs when available.
   int EnableBuiltInAEC(bool enable);
   int EnableBuiltInAGC(bool enable);
@@ -85,6 +105,14 @@ class AAudioRecorder : public AAudioObserverInterface,
   // Closes the existing stream and starts a new stream.
   void HandleStreamDisconnected();
 
+  // Restarts recording, if active, when the mode given by |playout_active_|
+  // differs from the mode of the stream.
+  void UpdateDuplexMode();
+
+  // Checks for overflows, updates the latency estimate and delivers
+  // |num_frames| recorded frames in |audio_data| to WebRTC.
+  void DeliverRecordedData(const void* audio_data, int32_t num_frames);
+
   // Ensures that methods are called from the same thread as this object is
   // created on.
   rtc::ThreadChecker thread_checker_;
@@ -121,8 +149,24 @@ class AAudioRecorder : public AAudioObserverInterface,
 
   // True only for the first data callback in each audio session.
   bool first_data_callback_ = true;
+
+  // True while the full-duplex AAudioPlayer plays out.
+  bool playout_active_ = false;
+  // True if the input stream is opened without a data callback.
+  bool duplex_ = false;
+
+  // Set while the full-duplex AAudioPlayer may read from the input stream.
+  rtc::CriticalSection duplex_crit_;
+  bool duplex_active_ RTC_GUARDED_BY(duplex_crit_) = false;
+  // Receives the audio read by ReadDuplexInput().
+  rtc::BufferT<int16_t> duplex_buffer_;
 };
 
+// Lets |output| read the audio of |input| in its data callback, if the
+// "WebRTC-Audio-AAudioFullDuplex" field trial is enabled. |input| must outlive
+// |output|.
+void ConnectFullDuplex(AAudioRecorder* input, AAudioPlayer* output);
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_DEVICE_ANDROID_AAUDIO_RECORDER_H_
@@ -14,6 +14,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/timeutils.h"
+#include "system_wrappers/include/field_trial.h"
 
 #define LOG_ON_ERROR(op)                                                      \
   do {                                                                        \
@@ -36,6 +37,8 @@ namespace webrtc {
 
 namespace {
 
+const char kExclusiveModeFieldTrial[] = "WebRTC-Audio-AAudioExclusiveMode";
+
 const char* DirectionToString(aaudio_direction_t direction) {
   switch (direction) {
     case AAUDIO_DIRECTION_OUTPUT:
@@ -133,7 +136,10 @@ class ScopedStreamBuilder {
 AAudioWrapper::AAudioWrapper(AudioManager* audio_manager,
                              aaudio_direction_t direction,
                              AAudioObserverInterface* observer)
-    : direction_(direction), observer_(observer) {
+    : direction_(direction),
+      observer_(observer),
+      exclusive_mode_requested_(
+          field_trial::IsEnabled(kExclusiveModeFieldTrial)) {
   RTC_LOG(INFO) << "ctor";
   RTC_DCHECK(observer_);
   direction_ == AAUDIO_DIRECTION_OUTPUT
@@ -267,6 +273,40 @@ bool AAudioWrapper::IncreaseOutputBufferSize() {
   return true;
 }
 
+bool AAudioWrapper::DecreaseOutputBufferSize() {
+  RTC_LOG(INFO) << "DecreaseBufferSize";
+  RTC_DCHECK(stream_);
+  RTC_DCHECK(aaudio_thread_checker_.CalledOnValidThread());
+  RTC_DCHECK_EQ(direction(), AAUDIO_DIRECTION_OUTPUT);
+  aaudio_result_t buffer_size = AAudioStream_getBufferSizeInFrames(stream_);
+  if (buffer_size - frames_per_burst() < frames_per_burst()) {
+    return false;
+  }
+  buffer_size -= frames_per_burst();
+  RTC_LOG(INFO) << "Updating buffer size to: " << buffer_size;
+  buffer_size = AAudioStream_setBufferSizeInFrames(stream_, buffer_size);
+  if (buffer_size < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to change buffer size: "
+                      << AAudio_convertResultToText(buffer_size);
+    return false;
+  }
+  RTC_LOG(INFO) << "Buffer size changed to: " << buffer_size;
+  return true;
+}
+
+void AAudioWrapper::EnableDataCallback(bool enable) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(!stream_);
+  use_data_callback_ = enable;
+}
+
+int32_t AAudioWrapper::ReadInput(void* audio_data, int32_t num_frames) {
+  RTC_DCHECK(stream_);
+  RTC_DCHECK(!use_data_callback_);
+  RTC_DCHECK_EQ(direction(), AAUDIO_DIRECTION_INPUT);
+  return AAudioStream_read(stream_, audio_data, num_frames, 0);
+}
+
 void AAudioWrapper::ClearInputStream(void* audio_data, int32_t num_frames) {
   RTC_LOG(INFO) << "ClearInputStream";
   RTC_DCHECK(stream_);
@@ -370,10 +410,13 @@ void AAudioWrapper::SetStreamConfiguration(AAudioStreamBuilder* builder) {
   AAudioStreamBuilder_setChannelCount(builder, audio_parameters().channels());
   // Always use 16-bit PCM audio sample format.
   AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_I16);
-  // TODO(henrika): investigate effect of using AAUDIO_SHARING_MODE_EXCLUSIVE.
-  // Ask for exclusive mode since this will give us the lowest possible latency.
-  // If exclusive mode isn't available, shared mode will be used instead.
-  AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_SHARED);
+  // Exclusive mode gives us the lowest possible latency, but takes the device
+  // from other applications. If exclusive mode isn't available, shared mode
+  // will be used instead.
+  AAudioStreamBuilder_setSharingMode(builder,
+                                     exclusive_mode_requested_
+                                         ? AAUDIO_SHARING_MODE_EXCLUSIVE
+                                         : AAUDIO_SHARING_MODE_SHARED);
   // Use the direction that was given at construction.
   AAudioStreamBuilder_setDirection(builder, direction_);
   // TODO(henrika): investigate performance using different performance modes.
@@ -382,8 +425,11 @@ void AAudioWrapper::SetStreamConfiguration(AAudioStreamBuilder* builder) {
   // Given that WebRTC applications require low latency, our audio stream uses
   // an asynchronous callback function to transfer data to and from the
   // application. AAudio executes the callback in a higher-priority thread that
-  // has better performance.
-  AAudioStreamBuilder_setDataCallback(builder, DataCallback, this);
+  // has better performance. Without the callback, the audio is moved by the
+  // callback of a stream in the other direction instead.
+  if (use_data_callback_) {
+    AAudioStreamBuilder_setDataCallback(builder, DataCallback, this);
+  }
   // Request that AAudio calls this functions if any error occurs on a callback
   // thread.
   AAudioStreamBuilder_setErrorCallback(builder, ErrorCallback, this);
@@ -445,8 +491,12 @@ bool AAudioWrapper::VerifyStreamConfiguration() {
     return false;
   }
   if (AAudioStream_getSharingMode(stream_) != AAUDIO_SHARING_MODE_SHARED) {
-    RTC_LOG(LS_ERROR) << "Stream unable to use requested sharing mode";
-    return false;
+    if (!exclusive_mode_requested_) {
+      RTC_LOG(LS_ERROR) << "Stream unable to use requested sharing mode";
+      return false;
+    }
+  } else if (exclusive_mode_requested_) {
+    RTC_LOG(WARNING) << "Exclusive mode not available, using shared mode";
   }
   if (AAudioStream_getPerformanceMode(stream_) !=
       AAUDIO_PERFORMANCE_MODE_LOW_LATENCY) {
@@ -56,6 +56,11 @@ class AAudioObserverInterface {
 // device instead (device selection takes place in Java). A stream can only
 // move data in one direction. When a stream is opened, Android checks to
 // ensure that the audio device and stream direction agree.
+//
+// With the "WebRTC-Audio-AAudioExclusiveMode" field trial enabled, the stream
+// asks for exclusive access to the device. On devices with an MMAP capable
+// HAL this lets AAudio write directly to the buffer read by the DSP, which
+// gives the lowest latency; other devices fall back to shared mode.
 class AAudioWrapper {
  public:
   AAudioWrapper(AudioManager* audio_manager,
@@ -79,6 +84,20 @@ class AAudioWrapper {
   // reduce the risk of underruns. Can be used while a stream is active.
   bool IncreaseOutputBufferSize();
 
+  // Decreases the internal buffer size for output streams by one burst size,
+  // but not below one burst, to reduce the latency. Can be used while a stream
+  // is active.
+  bool DecreaseOutputBufferSize();
+
+  // Without a data callback, the audio of an input stream must be moved with
+  // ReadInput() instead. Enabled by default. Must be called before Init().
+  void EnableDataCallback(bool enable);
+
+  // Reads up to |num_frames| frames from an input stream opened without a data
+  // callback, without blocking. Returns the number of frames read, or a
+  // negative AAudio error.
+  int32_t ReadInput(void* audio_data, int32_t num_frames);
+
   // Drains the recording stream of any existing data by reading from it until
   // it's empty. Can be used to clear out old data before starting a new audio
   // session.
@@ -101,6 +120,7 @@ class AAudioWrapper {
   int64_t frames_written() const;
   int64_t frames_read() const;
   aaudio_direction_t direction() const { return direction_; }
+  bool exclusive_mode_requested() const { return exclusive_mode_requested_; }
   AAudioStream* stream() const { return stream_; }
   int32_t frames_per_burst() const { return frames_per_burst_; }
 
@@ -118,6 +138,8 @@ class AAudioWrapper {
   AudioParameters audio_parameters_;
   const aaudio_direction_t direction_;
   AAudioObserverInterface* observer_ = nullptr;
+  const bool exclusive_mode_requested_;
+  bool use_data_callback_ = true;
   AAudioStream* stream_ = nullptr;
   int32_t frames_per_burst_ = 0;
 };
@@ -29,6 +29,11 @@ namespace webrtc {
 // and ClearAndroidAudioDeviceObjects) from a different thread but both will
 // RTC_CHECK that the calling thread is attached to a Java VM.
 
+// Lets the output move the audio of the input in its own callback, for the
+// combinations of input and output types that overload this function.
+template <class InputType, class OutputType>
+void ConnectFullDuplex(InputType* input, OutputType* output) {}
+
 template <class InputType, class OutputType>
 class AudioDeviceTemplate : public AudioDeviceGeneric {
  public:
@@ -36,12 +41,13 @@ class AudioDeviceTemplate : public AudioDeviceGeneric {
                       AudioManager* audio_manager)
       : audio_layer_(audio_layer),
         audio_manager_(audio_manager),
-        output_(audio_manager_),
         input_(audio_manager_),
+        output_(audio_manager_),
         initialized_(false) {
     RTC_LOG(INFO) << __FUNCTION__;
     RTC_CHECK(audio_manager);
     audio_manager_->SetActiveAudioLayer(audio_layer);
+    ConnectFullDuplex(&input_, &output_);
   }
 
   virtual ~AudioDeviceTemplate() { RTC_LOG(INFO) << __FUNCTION__; }
@@ -442,10 +448,11 @@ class AudioDeviceTemplate : public AudioDeviceGeneric {
   // is no risk of reading a NULL pointer at any time in this class.
   AudioManager* const audio_manager_;
 
-  OutputType output_;
-
+  // Declared before |output_|, which may use it until destroyed.
   InputType input_;
 
+  OutputType output_;
+
   bool initialized_;
 };
 
@@ -47,6 +47,7 @@ namespace adm_linux_alsa {
   X(snd_pcm_open)                              \
   X(snd_pcm_prepare)                           \
   X(snd_pcm_readi)                             \
+  X(snd_pcm_mmap_readi)                        \
   X(snd_pcm_recover)                           \
   X(snd_pcm_resume)                            \
   X(snd_pcm_reset)                             \
@@ -59,6 +60,7 @@ namespace adm_linux_alsa {
   X(snd_pcm_bytes_to_frames)                   \
   X(snd_pcm_wait)                              \
   X(snd_pcm_writei)                            \
+  X(snd_pcm_mmap_writei)                       \
   X(snd_pcm_info_get_class)                    \
   X(snd_pcm_info_get_subdevices_avail)         \
   X(snd_pcm_info_get_subdevice_name)           \
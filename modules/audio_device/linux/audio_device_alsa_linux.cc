@@ -10,11 +10,15 @@
 
 #include <assert.h>
 
+#include <string>
+
 #include "modules/audio_device/audio_device_config.h"
 #include "modules/audio_device/linux/audio_device_alsa_linux.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/event_wrapper.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/sleep.h"
 webrtc::adm_linux_alsa::AlsaSymbolTable AlsaSymbolTable;
 
@@ -57,6 +61,32 @@ static const unsigned int ALSA_CAPTURE_CH = 2;
 static const unsigned int ALSA_CAPTURE_LATENCY = 40 * 1000;  // in us
 static const unsigned int ALSA_CAPTURE_WAIT_TIMEOUT = 5;     // in ms
 
+// Lowers the device buffering from the defaults above, e.g.
+// "Enabled-20,10" for 20 ms of playout and 10 ms of capture buffering, and
+// uses memory-mapped access when the device supports it. ALSA splits the
+// buffer into four periods, so the wakeup interval shrinks with it.
+static const char kAlsaLowLatencyFieldTrial[] = "WebRTC-Audio-AlsaLowLatency";
+static const int kAlsaMinLatencyMs = 10;
+
+namespace {
+
+void GetLatenciesFromFieldTrialGroup(unsigned int* playout_latency_us,
+                                     unsigned int* recording_latency_us) {
+  std::string group = field_trial::FindFullName(kAlsaLowLatencyFieldTrial);
+  int playout_ms;
+  int recording_ms;
+  if (sscanf(group.c_str(), "Enabled-%d,%d", &playout_ms, &recording_ms) != 2)
+    return;
+  const int max_playout_ms = ALSA_PLAYOUT_LATENCY / 1000;
+  const int max_recording_ms = ALSA_CAPTURE_LATENCY / 1000;
+  *playout_latency_us =
+      1000 * rtc::SafeClamp(playout_ms, kAlsaMinLatencyMs, max_playout_ms);
+  *recording_latency_us =
+      1000 * rtc::SafeClamp(recording_ms, kAlsaMinLatencyMs, max_recording_ms);
+}
+
+}  // namespace
+
 #define FUNC_GET_NUM_OF_DEVICE 0
 #define FUNC_GET_DEVICE_NAME 1
 #define FUNC_GET_DEVICE_NAME_FOR_AN_ENUM 2
@@ -91,8 +121,14 @@ AudioDeviceLinuxALSA::AudioDeviceLinuxALSA()
       _recIsInitialized(false),
       _playIsInitialized(false),
       _recordingDelay(0),
-      _playoutDelay(0) {
+      _playoutDelay(0),
+      _playoutLatencyUs(ALSA_PLAYOUT_LATENCY),
+      _recordingLatencyUs(ALSA_CAPTURE_LATENCY),
+      _useMmap(field_trial::IsEnabled(kAlsaLowLatencyFieldTrial)),
+      _playoutUsesMmap(false),
+      _recordingUsesMmap(false) {
   memset(_oldKeyState, 0, sizeof(_oldKeyState));
+  GetLatenciesFromFieldTrialGroup(&_playoutLatencyUs, &_recordingLatencyUs);
   RTC_LOG(LS_INFO) << __FUNCTION__ << " created";
 }
 
@@ -800,20 +836,8 @@ int32_t AudioDeviceLinuxALSA::InitPlayout() {
   }
 
   _playoutFramesIn10MS = _playoutFreq / 100;
-  if ((errVal = LATE(snd_pcm_set_params)(
-           _handlePlayout,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-           SND_PCM_FORMAT_S16_BE,
-#else
-           SND_PCM_FORMAT_S16_LE,                             // format
-#endif
-           SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-           _playChannels,                  // channels
-           _playoutFreq,                   // rate
-           1,                              // soft_resample
-           ALSA_PLAYOUT_LATENCY  // 40*1000 //latency required overall latency
-                                 // in us
-           )) < 0) {             /* 0.5sec */
+  if ((errVal = SetPcmParams(_handlePlayout, _playChannels, _playoutFreq,
+                             _playoutLatencyUs, &_playoutUsesMmap)) < 0) {
     _playoutFramesIn10MS = 0;
     RTC_LOG(LS_ERROR) << "unable to set playback device: "
                       << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -923,38 +947,17 @@ int32_t AudioDeviceLinuxALSA::InitRecording() {
   }
 
   _recordingFramesIn10MS = _recordingFreq / 100;
-  if ((errVal =
-           LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-                                    SND_PCM_FORMAT_S16_BE,  // format
-#else
-                                    SND_PCM_FORMAT_S16_LE,    // format
-#endif
-                                    SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-                                    _recChannels,                   // channels
-                                    _recordingFreq,                 // rate
-                                    1,                    // soft_resample
-                                    ALSA_CAPTURE_LATENCY  // latency in us
-                                    )) < 0) {
+  if ((errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                             _recordingLatencyUs, &_recordingUsesMmap)) < 0) {
     // Fall back to another mode then.
     if (_recChannels == 1)
       _recChannels = 2;
     else
       _recChannels = 1;
 
-    if ((errVal =
-             LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-                                      SND_PCM_FORMAT_S16_BE,  // format
-#else
-                                      SND_PCM_FORMAT_S16_LE,  // format
-#endif
-                                      SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-                                      _recChannels,         // channels
-                                      _recordingFreq,       // rate
-                                      1,                    // soft_resample
-                                      ALSA_CAPTURE_LATENCY  // latency in us
-                                      )) < 0) {
+    if ((errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                               _recordingLatencyUs, &_recordingUsesMmap)) <
+        0) {
       _recordingFramesIn10MS = 0;
       RTC_LOG(LS_ERROR) << "unable to set record settings: "
                         << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -1460,6 +1463,29 @@ bool AudioDeviceLinuxALSA::RecThreadFunc(void* pThis) {
   return (static_cast<AudioDeviceLinuxALSA*>(pThis)->RecThreadProcess());
 }
 
+int AudioDeviceLinuxALSA::SetPcmParams(snd_pcm_t* handle,
+                                       unsigned int channels,
+                                       unsigned int rate,
+                                       unsigned int latency_us,
+                                       bool* uses_mmap) {
+#if defined(WEBRTC_ARCH_BIG_ENDIAN)
+  const snd_pcm_format_t format = SND_PCM_FORMAT_S16_BE;
+#else
+  const snd_pcm_format_t format = SND_PCM_FORMAT_S16_LE;
+#endif
+  *uses_mmap = false;
+  if (_useMmap &&
+      LATE(snd_pcm_set_params)(handle, format, SND_PCM_ACCESS_MMAP_INTERLEAVED,
+                               channels, rate, 1 /* soft_resample */,
+                               latency_us) == 0) {
+    *uses_mmap = true;
+    return 0;
+  }
+  return LATE(snd_pcm_set_params)(handle, format,
+                                  SND_PCM_ACCESS_RW_INTERLEAVED, channels,
+                                  rate, 1 /* soft_resample */, latency_us);
+}
+
 bool AudioDeviceLinuxALSA::PlayThreadProcess() {
   if (!_playing)
     return false;
@@ -1502,9 +1528,10 @@ bool AudioDeviceLinuxALSA::PlayThreadProcess() {
     avail_frames = _playoutFramesLeft;
 
   int size = LATE(snd_pcm_frames_to_bytes)(_handlePlayout, _playoutFramesLeft);
-  frames = LATE(snd_pcm_writei)(
-      _handlePlayout, &_playoutBuffer[_playoutBufferSizeIn10MS - size],
-      avail_frames);
+  int8_t* data = &_playoutBuffer[_playoutBufferSizeIn10MS - size];
+  frames = _playoutUsesMmap
+               ? LATE(snd_pcm_mmap_writei)(_handlePlayout, data, avail_frames)
+               : LATE(snd_pcm_writei)(_handlePlayout, data, avail_frames);
 
   if (frames < 0) {
     RTC_LOG(LS_VERBOSE) << "playout snd_pcm_writei error: "
@@ -1555,8 +1582,9 @@ bool AudioDeviceLinuxALSA::RecThreadProcess() {
   if (static_cast<uint32_t>(avail_frames) > _recordingFramesLeft)
     avail_frames = _recordingFramesLeft;
 
-  frames = LATE(snd_pcm_readi)(_handleRecord, buffer,
-                               avail_frames);  // frames to be written
+  frames = _recordingUsesMmap
+               ? LATE(snd_pcm_mmap_readi)(_handleRecord, buffer, avail_frames)
+               : LATE(snd_pcm_readi)(_handleRecord, buffer, avail_frames);
   if (frames < 0) {
     RTC_LOG(LS_ERROR) << "capture snd_pcm_readi error: "
                       << LATE(snd_strerror)(frames);
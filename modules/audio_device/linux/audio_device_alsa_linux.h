@@ -140,6 +140,16 @@ class AudioDeviceLinuxALSA : public AudioDeviceGeneric {
   bool RecThreadProcess();
   bool PlayThreadProcess();
 
+  // Configures |handle| for 16-bit interleaved audio with a total buffering
+  // of |latency_us|. Memory-mapped access is tried first when |_useMmap| is
+  // set, since it avoids a copy in the kernel; |*uses_mmap| tells whether it
+  // was granted.
+  int SetPcmParams(snd_pcm_t* handle,
+                   unsigned int channels,
+                   unsigned int rate,
+                   unsigned int latency_us,
+                   bool* uses_mmap);
+
   AudioDeviceBuffer* _ptrAudioBuffer;
 
   rtc::CriticalSection _critSect;
@@ -188,6 +198,13 @@ class AudioDeviceLinuxALSA : public AudioDeviceGeneric {
   snd_pcm_sframes_t _recordingDelay;
   snd_pcm_sframes_t _playoutDelay;
 
+  // Device buffering, set by the "WebRTC-Audio-AlsaLowLatency" field trial.
+  unsigned int _playoutLatencyUs;
+  unsigned int _recordingLatencyUs;
+  bool _useMmap;
+  bool _playoutUsesMmap;
+  bool _recordingUsesMmap;
+
   char _oldKeyState[32];
 #if defined(WEBRTC_USE_X11)
   Display* _XDisplay;
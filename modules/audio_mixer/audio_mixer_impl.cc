@@ -23,6 +23,9 @@
 namespace webrtc {
 namespace {
 
+// The audio level of digital silence, see Source::LatestAudioLevel().
+constexpr int kSilentAudioLevel = 127;
+
 struct SourceFrame {
   SourceFrame(AudioMixerImpl::SourceStatus* source_status,
               AudioFrame* audio_frame,
@@ -92,11 +95,13 @@ AudioMixerImpl::SourceStatusList::const_iterator FindSourceInList(
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-    bool use_limiter)
+    bool use_limiter,
+    bool preselect_by_audio_level)
     : output_rate_calculator_(std::move(output_rate_calculator)),
       output_frequency_(0),
       sample_size_(0),
       audio_source_list_(),
+      preselect_by_audio_level_(preselect_by_audio_level),
       frame_combiner_(use_limiter) {}
 
 AudioMixerImpl::~AudioMixerImpl() {}
@@ -110,9 +115,17 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create() {
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter) {
+  return Create(std::move(output_rate_calculator), use_limiter, false);
+}
+
+rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    bool preselect_by_audio_level) {
   return rtc::scoped_refptr<AudioMixerImpl>(
       new rtc::RefCountedObject<AudioMixerImpl>(
-          std::move(output_rate_calculator), use_limiter));
+          std::move(output_rate_calculator), use_limiter,
+          preselect_by_audio_level));
 }
 
 void AudioMixerImpl::Mix(size_t number_of_channels,
@@ -179,7 +192,7 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   std::vector<SourceFrame> ramp_list;
 
   // Get audio from the audio sources and put it in the SourceFrame vector.
-  for (auto& source_and_status : audio_source_list_) {
+  for (SourceStatus* source_and_status : SelectSourcesToGetAudioFrom()) {
     const auto audio_frame_info =
         source_and_status->audio_source->GetAudioFrameWithInfo(
             OutputFrequency(), &source_and_status->audio_frame);
@@ -189,7 +202,7 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
       continue;
     }
     audio_source_mixing_data_list.emplace_back(
-        source_and_status.get(), &source_and_status->audio_frame,
+        source_and_status, &source_and_status->audio_frame,
         audio_frame_info == Source::AudioFrameInfo::kMuted);
   }
 
@@ -221,6 +234,46 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   return result;
 }
 
+std::vector<AudioMixerImpl::SourceStatus*>
+AudioMixerImpl::SelectSourcesToGetAudioFrom() const {
+  std::vector<SourceStatus*> selected_sources;
+  selected_sources.reserve(audio_source_list_.size());
+  if (!preselect_by_audio_level_ ||
+      audio_source_list_.size() <= kMaximumAmountOfMixedAudioSources) {
+    for (const auto& source_and_status : audio_source_list_)
+      selected_sources.push_back(source_and_status.get());
+    return selected_sources;
+  }
+
+  // Audio levels and indices of the sources that may be skipped. Lower
+  // levels are louder.
+  std::vector<std::pair<int, size_t>> candidates;
+  std::vector<bool> selected(audio_source_list_.size(), false);
+  for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+    const SourceStatus& source_status = *audio_source_list_[i];
+    absl::optional<int> audio_level =
+        source_status.audio_source->LatestAudioLevel();
+    // Sources that were mixed last time need their audio to be ramped out.
+    if (!audio_level || source_status.is_mixed) {
+      selected[i] = true;
+    } else if (*audio_level < kSilentAudioLevel) {
+      candidates.emplace_back(*audio_level, i);
+    }
+  }
+  const size_t num_candidates = std::min<size_t>(
+      candidates.size(), kMaximumAmountOfMixedAudioSources);
+  std::partial_sort(candidates.begin(), candidates.begin() + num_candidates,
+                    candidates.end());
+  for (size_t i = 0; i < num_candidates; ++i)
+    selected[candidates[i].second] = true;
+
+  for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+    if (selected[i])
+      selected_sources.push_back(audio_source_list_[i].get());
+  }
+  return selected_sources;
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
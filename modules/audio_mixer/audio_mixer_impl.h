@@ -50,6 +50,16 @@ class AudioMixerImpl : public AudioMixer {
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter);
 
+  // With |preselect_by_audio_level|, only the sources that are loudest by
+  // Source::LatestAudioLevel(), that don't report a level, or that are
+  // being ramped out are asked for audio. This saves decoding the sources
+  // of large conferences that couldn't be mixed anyway. The jitter buffers
+  // of the other sources are not pulled, and flush when they overflow.
+  static rtc::scoped_refptr<AudioMixerImpl> Create(
+      std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+      bool use_limiter,
+      bool preselect_by_audio_level);
+
   ~AudioMixerImpl() override;
 
   // AudioMixer functions
@@ -67,7 +77,8 @@ class AudioMixerImpl : public AudioMixer {
 
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-                 bool use_limiter);
+                 bool use_limiter,
+                 bool preselect_by_audio_level);
 
  private:
   // Set mixing frequency through OutputFrequencyCalculator.
@@ -80,6 +91,11 @@ class AudioMixerImpl : public AudioMixer {
   // kMaximumAmountOfMixedAudioSources audio sources.
   AudioFrameList GetAudioFromSources() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns the sources of audio_source_list_ to ask for audio, in list
+  // order.
+  std::vector<SourceStatus*> SelectSourcesToGetAudioFrom() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Add/remove the MixerAudioSource to the specified
   // MixerAudioSource list.
   bool AddAudioSourceToList(Source* audio_source,
@@ -101,6 +117,8 @@ class AudioMixerImpl : public AudioMixer {
   // List of all audio sources. Note all lists are disjunct
   SourceStatusList audio_source_list_ RTC_GUARDED_BY(crit_);  // May be mixed.
 
+  const bool preselect_by_audio_level_;
+
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_ RTC_GUARDED_BY(race_checker_);
 
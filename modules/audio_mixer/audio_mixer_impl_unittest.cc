@@ -77,6 +77,7 @@ class MockMixerAudioSource : public testing::NiceMock<AudioMixer::Source> {
 
   MOCK_CONST_METHOD0(PreferredSampleRate, int());
   MOCK_CONST_METHOD0(Ssrc, int());
+  MOCK_CONST_METHOD0(LatestAudioLevel, absl::optional<int>());
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -530,4 +531,59 @@ TEST(AudioMixer, AnyRateIsPossibleWithNoLimiter) {
     }
   }
 }
+
+TEST(AudioMixer, PreselectsLoudestSourcesByAudioLevel) {
+  const auto mixer = AudioMixerImpl::Create(
+      std::unique_ptr<OutputRateCalculator>(new DefaultOutputRateCalculator()),
+      true, true);
+  // Lower audio levels are louder, 127 is silence.
+  const std::vector<absl::optional<int>> audio_levels = {
+      10, 50, 20, 127, 30, absl::nullopt};
+  const std::vector<bool> expect_asked = {true,  false, true,
+                                          false, true,  true};
+  std::vector<MockMixerAudioSource> sources(audio_levels.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    ResetFrame(sources[i].fake_frame());
+    ON_CALL(sources[i], LatestAudioLevel())
+        .WillByDefault(Return(audio_levels[i]));
+    EXPECT_CALL(sources[i], GetAudioFrameWithInfo(_, _))
+        .Times(expect_asked[i] ? 1 : 0);
+    mixer->AddSource(&sources[i]);
+  }
+
+  mixer->Mix(1, &frame_for_mixing);
+
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (!expect_asked[i])
+      EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&sources[i]));
+  }
+}
+
+TEST(AudioMixer, PreselectionAsksMixedSourcesForAudioToRampThemOut) {
+  constexpr size_t kAudioSources =
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources + 1;
+  const auto mixer = AudioMixerImpl::Create(
+      std::unique_ptr<OutputRateCalculator>(new DefaultOutputRateCalculator()),
+      true, true);
+  std::vector<MockMixerAudioSource> sources(kAudioSources);
+  for (size_t i = 0; i < kAudioSources; ++i) {
+    ResetFrame(sources[i].fake_frame());
+    ON_CALL(sources[i], LatestAudioLevel())
+        .WillByDefault(Return(10 * static_cast<int>(i)));
+    mixer->AddSource(&sources[i]);
+  }
+  mixer->Mix(1, &frame_for_mixing);
+  for (size_t i = 0; i + 1 < kAudioSources; ++i)
+    ASSERT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(&sources[i]));
+  ASSERT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(
+      &sources[kAudioSources - 1]));
+
+  // The quiet source gets loudest. All sources are asked, the ones that were
+  // mixed to ramp them out.
+  ON_CALL(sources[kAudioSources - 1], LatestAudioLevel())
+      .WillByDefault(Return(0));
+  for (auto& source : sources)
+    EXPECT_CALL(source, GetAudioFrameWithInfo(_, _)).Times(1);
+  mixer->Mix(1, &frame_for_mixing);
+}
 }  // namespace webrtc
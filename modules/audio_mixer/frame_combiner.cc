@@ -19,6 +19,7 @@
 #include "common_audio/include/audio_util.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
+#include "modules/audio_mixer/sample_accumulator.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/arraysize.h"
@@ -80,13 +81,13 @@ std::array<OneChannelBuffer, kMaximumAmountOfChannels> MixToFloatFrame(
   using OneChannelBuffer = std::array<float, kMaximumChannelSize>;
   std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer{};
 
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    for (size_t j = 0; j < number_of_channels; ++j) {
-      for (size_t k = 0; k < samples_per_channel; ++k) {
-        mixing_buffer[j][k] += frame->data()[number_of_channels * k + j];
-      }
-    }
+  std::array<float*, kMaximumAmountOfChannels> channel_pointers{};
+  for (size_t j = 0; j < number_of_channels; ++j)
+    channel_pointers[j] = &mixing_buffer[j][0];
+
+  for (const AudioFrame* frame : mix_list) {
+    AccumulateInterleaved(frame->data(), samples_per_channel,
+                          number_of_channels, channel_pointers.data());
   }
   return mixing_buffer;
 }
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_mixer/frame_combiner.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+
+namespace {
+
+// 10 s of audio.
+const int kNumFrames = 1000;
+
+// Mixes |num_streams| loud streams of random samples, so that the limiter has
+// to reduce the gain, and measures how long FrameCombiner takes per frame.
+void RunCombinerTest(int sample_rate_hz,
+                     size_t number_of_channels,
+                     size_t num_streams,
+                     bool use_limiter) {
+  const size_t samples_per_channel = sample_rate_hz / 100;
+  Random random(42);
+  std::vector<std::unique_ptr<AudioFrame>> frames;
+  std::vector<AudioFrame*> mix_list;
+  for (size_t i = 0; i < num_streams; ++i) {
+    frames.emplace_back(new AudioFrame());
+    AudioFrame* frame = frames.back().get();
+    frame->UpdateFrame(0, nullptr, samples_per_channel, sample_rate_hz,
+                       AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                       number_of_channels);
+    int16_t* data = frame->mutable_data();
+    for (size_t k = 0; k < samples_per_channel * number_of_channels; ++k)
+      data[k] = random.Rand(-20000, 20000);
+    mix_list.push_back(frame);
+  }
+
+  FrameCombiner combiner(use_limiter);
+  AudioFrame audio_frame_for_mixing;
+  int64_t total_nanos = 0;
+  for (int i = 0; i < kNumFrames; ++i) {
+    const int64_t start_nanos = rtc::TimeNanos();
+    combiner.Combine(mix_list, number_of_channels, sample_rate_hz, num_streams,
+                     &audio_frame_for_mixing);
+    total_nanos += rtc::TimeNanos() - start_nanos;
+  }
+
+  webrtc::test::PrintResult(
+      "combine_time", use_limiter ? "_limiter" : "_no_limiter",
+      std::to_string(sample_rate_hz / 1000) + "kHz_" +
+          std::to_string(number_of_channels) + "ch_" +
+          std::to_string(num_streams) + "_streams",
+      static_cast<double>(total_nanos) / kNumFrames /
+          rtc::kNumNanosecsPerMicrosec,
+      "us", false);
+}
+
+}  // namespace
+
+TEST(FrameCombinerPerformanceTest, MixMono) {
+  for (size_t num_streams : {3, 10})
+    RunCombinerTest(48000, 1, num_streams, true);
+}
+
+TEST(FrameCombinerPerformanceTest, MixStereo) {
+  for (size_t num_streams : {3, 10}) {
+    RunCombinerTest(48000, 2, num_streams, false);
+    RunCombinerTest(48000, 2, num_streams, true);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,319 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/mix_minus_mixer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string>
+#include <utility>
+
+#include "common_audio/include/audio_util.h"
+#include "modules/audio_mixer/audio_frame_manipulator.h"
+#include "modules/audio_mixer/audio_mixer_impl.h"
+#include "modules/audio_mixer/sample_accumulator.h"
+#include "modules/audio_processing/agc2/fixed_gain_controller.h"
+#include "modules/audio_processing/include/audio_frame_view.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Stereo, 48 kHz, 10 ms.
+constexpr size_t kMaximumAmountOfChannels = 2;
+constexpr size_t kMaximumChannelSize =
+    48 * AudioMixerImpl::kFrameDurationInMs;
+
+using OneChannelBuffer = std::array<float, kMaximumChannelSize>;
+using ChannelBuffers = std::array<OneChannelBuffer, kMaximumAmountOfChannels>;
+
+std::array<float*, kMaximumAmountOfChannels> ChannelPointers(
+    ChannelBuffers* buffers) {
+  std::array<float*, kMaximumAmountOfChannels> channel_pointers{};
+  for (size_t i = 0; i < kMaximumAmountOfChannels; ++i)
+    channel_pointers[i] = (*buffers)[i].data();
+  return channel_pointers;
+}
+
+}  // namespace
+
+// Limits and rounds one of the outputs. The limiter has a state, so every
+// output has its own.
+class MixMinusMixer::Output {
+ public:
+  explicit Output(bool use_limiter)
+      : data_dumper_(0), limiter_(&data_dumper_), use_limiter_(use_limiter) {
+    limiter_.SetGain(0.f);
+  }
+
+  // The FloatS16 input of WriteTo().
+  ChannelBuffers* buffers() { return &buffers_; }
+
+  void WriteTo(size_t number_of_channels,
+               int sample_rate_hz,
+               AudioFrame* audio_frame) {
+    const size_t samples_per_channel = static_cast<size_t>(
+        sample_rate_hz * AudioMixerImpl::kFrameDurationInMs / 1000);
+    audio_frame->UpdateFrame(0, nullptr, samples_per_channel, sample_rate_hz,
+                             AudioFrame::kUndefined, AudioFrame::kVadUnknown,
+                             number_of_channels);
+    std::array<float*, kMaximumAmountOfChannels> channel_pointers =
+        ChannelPointers(&buffers_);
+    AudioFrameView<float> view(channel_pointers.data(), number_of_channels,
+                               samples_per_channel);
+    if (use_limiter_) {
+      limiter_.SetSampleRate(sample_rate_hz);
+      limiter_.Process(view);
+    }
+    int16_t* const data = audio_frame->mutable_data();
+    for (size_t i = 0; i < number_of_channels; ++i) {
+      for (size_t j = 0; j < samples_per_channel; ++j)
+        data[number_of_channels * j + i] = FloatS16ToS16(view.channel(i)[j]);
+    }
+  }
+
+ private:
+  ApmDataDumper data_dumper_;
+  FixedGainController limiter_;
+  const bool use_limiter_;
+  ChannelBuffers buffers_;
+};
+
+struct MixMinusMixer::SourceStatus {
+  explicit SourceStatus(AudioMixer::Source* audio_source)
+      : audio_source(audio_source) {}
+
+  AudioMixer::Source* const audio_source;
+  // Whether the source was mixed by the last Mix(), and its gain then.
+  bool is_mixed = false;
+  float gain = 0.0f;
+
+  // Updated by every Mix().
+  AudioMixer::Source::AudioFrameInfo frame_info =
+      AudioMixer::Source::AudioFrameInfo::kError;
+  uint32_t energy = 0;
+  AudioFrame audio_frame;
+
+  // Only used while the source is mixed. Created the first time it is.
+  std::unique_ptr<Output> mix_minus_output;
+  AudioFrame mix_minus;
+};
+
+MixMinusMixer::MixMinusMixer(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    int num_worker_threads)
+    : output_rate_calculator_(std::move(output_rate_calculator)),
+      use_limiter_(use_limiter),
+      full_mix_output_(new Output(use_limiter)) {
+  RTC_DCHECK_GE(num_worker_threads, 0);
+  for (int i = 0; i < num_worker_threads; ++i) {
+    const std::string name = "MixMinusMixer" + std::to_string(i);
+    workers_.emplace_back(
+        new rtc::TaskQueue(name.c_str(), rtc::TaskQueue::Priority::HIGH));
+  }
+}
+
+MixMinusMixer::~MixMinusMixer() = default;
+
+bool MixMinusMixer::AddSource(AudioMixer::Source* audio_source) {
+  RTC_DCHECK(audio_source);
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK(std::none_of(
+      sources_.begin(), sources_.end(),
+      [audio_source](const std::unique_ptr<SourceStatus>& s) {
+        return s->audio_source == audio_source;
+      }))
+      << "Source already added to mixer";
+  sources_.emplace_back(new SourceStatus(audio_source));
+  return true;
+}
+
+void MixMinusMixer::RemoveSource(AudioMixer::Source* audio_source) {
+  RTC_DCHECK(audio_source);
+  rtc::CritScope lock(&crit_);
+  const auto it =
+      std::find_if(sources_.begin(), sources_.end(),
+                   [audio_source](const std::unique_ptr<SourceStatus>& s) {
+                     return s->audio_source == audio_source;
+                   });
+  RTC_DCHECK(it != sources_.end()) << "Source not present in mixer";
+  sources_.erase(it);
+}
+
+void MixMinusMixer::Mix(size_t number_of_channels) {
+  RTC_DCHECK(number_of_channels == 1 || number_of_channels == 2);
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  rtc::CritScope lock(&crit_);
+
+  std::vector<int> preferred_rates;
+  preferred_rates.reserve(sources_.size());
+  for (const auto& source_status : sources_) {
+    preferred_rates.push_back(
+        source_status->audio_source->PreferredSampleRate());
+  }
+  const int sample_rate_hz =
+      output_rate_calculator_->CalculateOutputRate(preferred_rates);
+  const size_t samples_per_channel = static_cast<size_t>(
+      sample_rate_hz * AudioMixerImpl::kFrameDurationInMs / 1000);
+  RTC_DCHECK_LE(samples_per_channel, kMaximumChannelSize);
+
+  std::vector<SourceStatus*> sources;
+  sources.reserve(sources_.size());
+  for (const auto& source_status : sources_)
+    sources.push_back(source_status.get());
+
+  // Get audio from every source once.
+  ParallelFor(sources.size(), [&](size_t i) {
+    SourceStatus* source_status = sources[i];
+    source_status->frame_info =
+        source_status->audio_source->GetAudioFrameWithInfo(
+            sample_rate_hz, &source_status->audio_frame);
+    if (source_status->frame_info !=
+        AudioMixer::Source::AudioFrameInfo::kNormal) {
+      return;
+    }
+    RTC_DCHECK_EQ(samples_per_channel,
+                  source_status->audio_frame.samples_per_channel_);
+    source_status->energy =
+        AudioMixerCalculateEnergy(source_status->audio_frame);
+    RemixFrame(number_of_channels, &source_status->audio_frame);
+  });
+
+  const std::vector<SourceStatus*> mixed_sources = SelectSourcesToMix();
+
+  // The full mix, in FloatS16.
+  ChannelBuffers full_mix{};
+  std::array<float*, kMaximumAmountOfChannels> full_mix_channels =
+      ChannelPointers(&full_mix);
+  for (const SourceStatus* source_status : mixed_sources) {
+    AccumulateInterleaved(source_status->audio_frame.data(),
+                          samples_per_channel, number_of_channels,
+                          full_mix_channels.data());
+  }
+
+  // The first |mixed_sources.size()| outputs are the mix-minus of the mixed
+  // sources, the last one is the full mix.
+  ParallelFor(mixed_sources.size() + 1, [&](size_t i) {
+    if (i == mixed_sources.size()) {
+      *full_mix_output_->buffers() = full_mix;
+      full_mix_output_->WriteTo(number_of_channels, sample_rate_hz,
+                                &full_mix_);
+      return;
+    }
+    SourceStatus* source_status = mixed_sources[i];
+    if (!source_status->mix_minus_output)
+      source_status->mix_minus_output.reset(new Output(use_limiter_));
+    ChannelBuffers* buffers = source_status->mix_minus_output->buffers();
+    for (size_t j = 0; j < number_of_channels; ++j)
+      std::fill_n((*buffers)[j].begin(), samples_per_channel, 0.f);
+    std::array<float*, kMaximumAmountOfChannels> channels =
+        ChannelPointers(buffers);
+    AccumulateInterleaved(source_status->audio_frame.data(),
+                          samples_per_channel, number_of_channels,
+                          channels.data());
+    for (size_t j = 0; j < number_of_channels; ++j) {
+      for (size_t k = 0; k < samples_per_channel; ++k)
+        channels[j][k] = full_mix_channels[j][k] - channels[j][k];
+    }
+    source_status->mix_minus_output->WriteTo(
+        number_of_channels, sample_rate_hz, &source_status->mix_minus);
+  });
+}
+
+const AudioFrame* MixMinusMixer::MixFor(
+    AudioMixer::Source* audio_source) const {
+  rtc::CritScope lock(&crit_);
+  for (const auto& source_status : sources_) {
+    if (source_status->audio_source != audio_source)
+      continue;
+    return source_status->is_mixed ? &source_status->mix_minus : &full_mix_;
+  }
+  return nullptr;
+}
+
+const AudioFrame& MixMinusMixer::full_mix() const {
+  return full_mix_;
+}
+
+void MixMinusMixer::ParallelFor(size_t num_tasks,
+                                rtc::FunctionView<void(size_t)> task) {
+  std::atomic<size_t> next_task(0);
+  auto run_tasks = [&] {
+    for (size_t i = next_task++; i < num_tasks; i = next_task++)
+      task(i);
+  };
+  // The calling thread takes part, so there is no need for more helpers than
+  // tasks minus one.
+  const size_t num_helpers =
+      std::min(workers_.size(), num_tasks > 0 ? num_tasks - 1 : 0);
+  // The helpers may start after all tasks are done, and use the state on this
+  // stack, so wait for all of them and not just for the tasks.
+  std::atomic<size_t> remaining_helpers(num_helpers);
+  rtc::Event helpers_done(false, false);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    workers_[i]->PostTask([&] {
+      run_tasks();
+      if (--remaining_helpers == 0)
+        helpers_done.Set();
+    });
+  }
+  run_tasks();
+  if (num_helpers > 0)
+    helpers_done.Wait(rtc::Event::kForever);
+}
+
+std::vector<MixMinusMixer::SourceStatus*> MixMinusMixer::SelectSourcesToMix() {
+  std::vector<SourceStatus*> candidates;
+  for (const auto& source_status : sources_) {
+    if (source_status->frame_info ==
+        AudioMixer::Source::AudioFrameInfo::kError) {
+      RTC_LOG_F(LS_WARNING) << "failed to GetAudioFrameWithInfo() from source";
+    }
+    if (source_status->frame_info ==
+        AudioMixer::Source::AudioFrameInfo::kNormal) {
+      candidates.push_back(source_status.get());
+    } else {
+      source_status->is_mixed = false;
+      source_status->gain = 0.0f;
+    }
+  }
+
+  // The same order as in AudioMixerImpl, muted sources are already left out.
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const SourceStatus* a, const SourceStatus* b) {
+                     const auto a_activity = a->audio_frame.vad_activity_;
+                     const auto b_activity = b->audio_frame.vad_activity_;
+                     if (a_activity != b_activity)
+                       return a_activity == AudioFrame::kVadActive;
+                     return a->energy > b->energy;
+                   });
+
+  const size_t num_mixed =
+      std::min<size_t>(candidates.size(),
+                       AudioMixerImpl::kMaximumAmountOfMixedAudioSources);
+  for (size_t i = num_mixed; i < candidates.size(); ++i) {
+    candidates[i]->is_mixed = false;
+    candidates[i]->gain = 0.0f;
+  }
+  candidates.resize(num_mixed);
+  for (SourceStatus* source_status : candidates) {
+    Ramp(source_status->gain, 1.0f, &source_status->audio_frame);
+    source_status->is_mixed = true;
+    source_status->gain = 1.0f;
+  }
+  return candidates;
+}
+
+}  // namespace webrtc
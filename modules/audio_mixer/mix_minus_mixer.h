@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_MIXER_MIX_MINUS_MIXER_H_
+#define MODULES_AUDIO_MIXER_MIX_MINUS_MIXER_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "api/audio/audio_mixer.h"
+#include "modules/audio_mixer/output_rate_calculator.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/function_view.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Mixes a conference once and produces the mix-minus of every source, i.e.
+// the mix of the mixed sources except the source itself, which is what an
+// MCU sends back to each participant.
+//
+// Every source is asked for audio once per Mix(), however many outputs there
+// are. The sources that are not mixed all get the full mix, and the mix-minus
+// of a mixed source is the full mix with its contribution subtracted, so the
+// work grows linearly with the number of sources. The sources are selected and
+// ramped in like by AudioMixerImpl.
+class MixMinusMixer {
+ public:
+  // Getting audio from the sources and limiting the outputs is spread over
+  // |num_worker_threads| task queues and the thread calling Mix(). With 0,
+  // all work is done by the thread calling Mix().
+  MixMinusMixer(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+                bool use_limiter,
+                int num_worker_threads);
+  ~MixMinusMixer();
+
+  // Addition and removal can happen on different threads. A source is never
+  // added twice, and never removed if it wasn't added.
+  bool AddSource(AudioMixer::Source* audio_source);
+  void RemoveSource(AudioMixer::Source* audio_source);
+
+  // Gets 10 ms of audio from every source and mixes it with
+  // |number_of_channels| channels. Must be called sequentially.
+  void Mix(size_t number_of_channels);
+
+  // The output of the last Mix() for |audio_source|, or nullptr if it wasn't
+  // a source at that time. Valid until the next call to Mix() or
+  // RemoveSource().
+  const AudioFrame* MixFor(AudioMixer::Source* audio_source) const;
+
+  // The mix of all mixed sources, e.g. for a recording of the conference.
+  const AudioFrame& full_mix() const;
+
+ private:
+  class Output;
+  struct SourceStatus;
+
+  // Runs |task| for each index in [0, num_tasks) on the worker queues and
+  // the calling thread. Returns when all are done.
+  void ParallelFor(size_t num_tasks, rtc::FunctionView<void(size_t)> task);
+  // Returns the sources to mix, and updates their mixed status and gain.
+  std::vector<SourceStatus*> SelectSourcesToMix()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  mutable rtc::CriticalSection crit_;
+  rtc::RaceChecker race_checker_;
+
+  const std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
+  const bool use_limiter_;
+  std::vector<std::unique_ptr<rtc::TaskQueue>> workers_;
+
+  std::vector<std::unique_ptr<SourceStatus>> sources_ RTC_GUARDED_BY(crit_);
+  const std::unique_ptr<Output> full_mix_output_;
+  AudioFrame full_mix_ RTC_GUARDED_BY(race_checker_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MixMinusMixer);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_MIXER_MIX_MINUS_MIXER_H_
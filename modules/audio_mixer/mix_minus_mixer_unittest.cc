@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/mix_minus_mixer.h"
+
+#include <memory>
+#include <vector>
+
+#include "modules/audio_mixer/default_output_rate_calculator.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPerChannel = kSampleRateHz / 100;
+
+// Produces a constant signal and counts how often it is asked for audio.
+class ConstantSource : public AudioMixer::Source {
+ public:
+  explicit ConstantSource(int16_t value) : value_(value) {}
+
+  AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz,
+                                       AudioFrame* audio_frame) override {
+    ++num_calls_;
+    audio_frame->UpdateFrame(0, nullptr, sample_rate_hz / 100, sample_rate_hz,
+                             AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                             1);
+    int16_t* data = audio_frame->mutable_data();
+    for (size_t i = 0; i < audio_frame->samples_per_channel_; ++i)
+      data[i] = value_;
+    return AudioFrameInfo::kNormal;
+  }
+  int Ssrc() const override { return value_; }
+  int PreferredSampleRate() const override { return kSampleRateHz; }
+
+  int num_calls() const { return num_calls_; }
+
+ private:
+  const int16_t value_;
+  int num_calls_ = 0;
+};
+
+std::unique_ptr<MixMinusMixer> CreateMixer(int num_worker_threads) {
+  return std::unique_ptr<MixMinusMixer>(new MixMinusMixer(
+      std::unique_ptr<OutputRateCalculator>(new DefaultOutputRateCalculator()),
+      false, num_worker_threads));
+}
+
+void ExpectConstant(int16_t value, size_t number_of_channels,
+                    const AudioFrame& audio_frame) {
+  ASSERT_EQ(kSamplesPerChannel, audio_frame.samples_per_channel_);
+  ASSERT_EQ(number_of_channels, audio_frame.num_channels_);
+  const int16_t* data = audio_frame.data();
+  for (size_t i = 0; i < kSamplesPerChannel * number_of_channels; ++i)
+    ASSERT_EQ(value, data[i]) << "Sample " << i;
+}
+
+}  // namespace
+
+TEST(MixMinusMixer, GetsAudioFromEverySourceOncePerMix) {
+  std::unique_ptr<MixMinusMixer> mixer = CreateMixer(0);
+  std::vector<std::unique_ptr<ConstantSource>> sources;
+  for (int16_t value = 1; value <= 10; ++value) {
+    sources.emplace_back(new ConstantSource(value));
+    EXPECT_TRUE(mixer->AddSource(sources.back().get()));
+  }
+  mixer->Mix(1);
+  mixer->Mix(1);
+  for (const auto& source : sources)
+    EXPECT_EQ(2, source->num_calls());
+}
+
+TEST(MixMinusMixer, LeavesOutTheOwnAudioOfMixedSources) {
+  std::unique_ptr<MixMinusMixer> mixer = CreateMixer(0);
+  // The quietest source isn't mixed, and gets the full mix.
+  ConstantSource quiet(50), low(100), mid(200), loud(300);
+  for (ConstantSource* source : {&quiet, &low, &mid, &loud})
+    mixer->AddSource(source);
+
+  // Mix twice to be past the ramp in.
+  mixer->Mix(2);
+  mixer->Mix(2);
+  ExpectConstant(600, 2, mixer->full_mix());
+  ExpectConstant(500, 2, *mixer->MixFor(&low));
+  ExpectConstant(400, 2, *mixer->MixFor(&mid));
+  ExpectConstant(300, 2, *mixer->MixFor(&loud));
+  EXPECT_EQ(&mixer->full_mix(), mixer->MixFor(&quiet));
+
+  ConstantSource unknown(1);
+  EXPECT_EQ(nullptr, mixer->MixFor(&unknown));
+  mixer->RemoveSource(&loud);
+  EXPECT_EQ(nullptr, mixer->MixFor(&loud));
+}
+
+TEST(MixMinusMixer, WorkerThreadsProduceTheSameOutput) {
+  std::unique_ptr<MixMinusMixer> serial_mixer = CreateMixer(0);
+  std::unique_ptr<MixMinusMixer> parallel_mixer = CreateMixer(3);
+  std::vector<std::unique_ptr<ConstantSource>> sources;
+  for (int16_t value = 1000; value <= 8000; value += 1000) {
+    sources.emplace_back(new ConstantSource(value));
+    serial_mixer->AddSource(sources.back().get());
+    parallel_mixer->AddSource(sources.back().get());
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    serial_mixer->Mix(1);
+    parallel_mixer->Mix(1);
+    for (const auto& source : sources) {
+      const AudioFrame* serial = serial_mixer->MixFor(source.get());
+      const AudioFrame* parallel = parallel_mixer->MixFor(source.get());
+      ASSERT_TRUE(serial);
+      ASSERT_TRUE(parallel);
+      for (size_t j = 0; j < kSamplesPerChannel; ++j)
+        ASSERT_EQ(serial->data()[j], parallel->data()[j]);
+    }
+  }
+}
+
+}  // namespace webrtc
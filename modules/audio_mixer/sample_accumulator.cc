@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/sample_accumulator.h"
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+namespace {
+
+using AccumulateFunction = void (*)(const int16_t*,
+                                    size_t,
+                                    size_t,
+                                    float* const*);
+
+AccumulateFunction SelectAccumulateFunction() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  return &AccumulateInterleaved_SSE2;
+#else
+  // x86 CPU detection required.
+  if (WebRtc_GetCPUInfo(kSSE2))
+    return &AccumulateInterleaved_SSE2;
+  return &AccumulateInterleaved_C;
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return &AccumulateInterleaved_NEON;
+#else
+  return &AccumulateInterleaved_C;
+#endif
+}
+
+}  // namespace
+
+void AccumulateInterleaved(const int16_t* src,
+                           size_t samples_per_channel,
+                           size_t number_of_channels,
+                           float* const* dst) {
+  static const AccumulateFunction accumulate_function =
+      SelectAccumulateFunction();
+  accumulate_function(src, samples_per_channel, number_of_channels, dst);
+}
+
+void AccumulateInterleaved_C(const int16_t* src,
+                             size_t samples_per_channel,
+                             size_t number_of_channels,
+                             float* const* dst) {
+  for (size_t j = 0; j < number_of_channels; ++j) {
+    float* channel = dst[j];
+    for (size_t k = 0; k < samples_per_channel; ++k)
+      channel[k] += src[number_of_channels * k + j];
+  }
+}
+
+}  // namespace webrtc
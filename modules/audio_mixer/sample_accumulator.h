@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_MIXER_SAMPLE_ACCUMULATOR_H_
+#define MODULES_AUDIO_MIXER_SAMPLE_ACCUMULATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Adds the |samples_per_channel| interleaved samples of each of the
+// |number_of_channels| channels of |src| to the deinterleaved channels
+// |dst[0]| to |dst[number_of_channels - 1]|, using the fastest
+// implementation available on the CPU. Mono and stereo are vectorized.
+void AccumulateInterleaved(const int16_t* src,
+                           size_t samples_per_channel,
+                           size_t number_of_channels,
+                           float* const* dst);
+
+// The implementations behind AccumulateInterleaved(), for tests and
+// benchmarks.
+void AccumulateInterleaved_C(const int16_t* src,
+                             size_t samples_per_channel,
+                             size_t number_of_channels,
+                             float* const* dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void AccumulateInterleaved_SSE2(const int16_t* src,
+                                size_t samples_per_channel,
+                                size_t number_of_channels,
+                                float* const* dst);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void AccumulateInterleaved_NEON(const int16_t* src,
+                                size_t samples_per_channel,
+                                size_t number_of_channels,
+                                float* const* dst);
+#endif
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_MIXER_SAMPLE_ACCUMULATOR_H_
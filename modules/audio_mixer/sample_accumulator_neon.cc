@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/sample_accumulator.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+namespace {
+
+void AddToChannel(int16x4_t samples, float* channel) {
+  vst1q_f32(channel, vaddq_f32(vld1q_f32(channel),
+                               vcvtq_f32_s32(vmovl_s16(samples))));
+}
+
+}  // namespace
+
+void AccumulateInterleaved_NEON(const int16_t* src,
+                                size_t samples_per_channel,
+                                size_t number_of_channels,
+                                float* const* dst) {
+  size_t k = 0;
+  if (number_of_channels == 1) {
+    float* channel = dst[0];
+    for (; k + 8 <= samples_per_channel; k += 8) {
+      int16x8_t s = vld1q_s16(src + k);
+      AddToChannel(vget_low_s16(s), channel + k);
+      AddToChannel(vget_high_s16(s), channel + k + 4);
+    }
+  } else if (number_of_channels == 2) {
+    float* left = dst[0];
+    float* right = dst[1];
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      // Deinterleaves while loading.
+      int16x4x2_t s = vld2_s16(src + 2 * k);
+      AddToChannel(s.val[0], left + k);
+      AddToChannel(s.val[1], right + k);
+    }
+  }
+  // Not calling AccumulateInterleaved_C(), which lives in a target that
+  // depends on this one.
+  for (size_t j = 0; j < number_of_channels; ++j) {
+    float* channel = dst[j];
+    for (size_t i = k; i < samples_per_channel; ++i)
+      channel[i] += src[number_of_channels * i + j];
+  }
+}
+
+}  // namespace webrtc
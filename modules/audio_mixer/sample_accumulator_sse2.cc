@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/sample_accumulator.h"
+
+#include <emmintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+void AddToChannel(__m128i samples, float* channel) {
+  _mm_storeu_ps(channel, _mm_add_ps(_mm_loadu_ps(channel),
+                                    _mm_cvtepi32_ps(samples)));
+}
+
+}  // namespace
+
+void AccumulateInterleaved_SSE2(const int16_t* src,
+                                size_t samples_per_channel,
+                                size_t number_of_channels,
+                                float* const* dst) {
+  size_t k = 0;
+  if (number_of_channels == 1) {
+    float* channel = dst[0];
+    for (; k + 8 <= samples_per_channel; k += 8) {
+      __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k));
+      // Sign extends to 32 bits by placing each sample in the upper half.
+      AddToChannel(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16), channel + k);
+      AddToChannel(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16),
+                   channel + k + 4);
+    }
+  } else if (number_of_channels == 2) {
+    float* left = dst[0];
+    float* right = dst[1];
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      // Each 32 bit lane holds a left sample in its lower and a right sample
+      // in its upper half.
+      __m128i s =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * k));
+      AddToChannel(_mm_srai_epi32(_mm_slli_epi32(s, 16), 16), left + k);
+      AddToChannel(_mm_srai_epi32(s, 16), right + k);
+    }
+  }
+  // Not calling AccumulateInterleaved_C(), which lives in a target that
+  // depends on this one.
+  for (size_t j = 0; j < number_of_channels; ++j) {
+    float* channel = dst[j];
+    for (size_t i = k; i < samples_per_channel; ++i)
+      channel[i] += src[number_of_channels * i + j];
+  }
+}
+
+}  // namespace webrtc
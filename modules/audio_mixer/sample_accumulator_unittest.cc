@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/sample_accumulator.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using AccumulateFunction = void (*)(const int16_t*,
+                                    size_t,
+                                    size_t,
+                                    float* const*);
+
+struct Implementation {
+  const char* name;
+  AccumulateFunction function;
+};
+
+// Stereo, 48 kHz, 10 ms.
+constexpr size_t kMaxSamplesPerChannel = 480;
+constexpr size_t kMaxChannels = 2;
+
+std::vector<Implementation> Implementations() {
+  std::vector<Implementation> implementations = {
+      {"default", &AccumulateInterleaved}, {"C", &AccumulateInterleaved_C}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2))
+    implementations.push_back({"SSE2", &AccumulateInterleaved_SSE2});
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  implementations.push_back({"NEON", &AccumulateInterleaved_NEON});
+#endif
+  return implementations;
+}
+
+void ExpectAccumulateMatchesReference(AccumulateFunction accumulate_function,
+                                      size_t samples_per_channel,
+                                      size_t number_of_channels) {
+  Random random(1 + samples_per_channel * 10 + number_of_channels);
+  std::vector<int16_t> src(kMaxSamplesPerChannel * kMaxChannels);
+  for (int16_t& sample : src)
+    sample = random.Rand<int16_t>();
+  std::vector<std::vector<float>> channels(kMaxChannels);
+  for (std::vector<float>& channel : channels) {
+    for (size_t k = 0; k < kMaxSamplesPerChannel; ++k)
+      channel.push_back(random.Rand(-100000, 100000));
+  }
+  std::vector<std::vector<float>> expected = channels;
+  for (size_t j = 0; j < number_of_channels; ++j) {
+    for (size_t k = 0; k < samples_per_channel; ++k)
+      expected[j][k] += src[number_of_channels * k + j];
+  }
+
+  float* dst[kMaxChannels] = {channels[0].data(), channels[1].data()};
+  accumulate_function(src.data(), samples_per_channel, number_of_channels,
+                      dst);
+  // Also checks that nothing outside of the range was touched.
+  EXPECT_EQ(expected, channels) << samples_per_channel << " samples, "
+                                << number_of_channels << " channels";
+}
+
+}  // namespace
+
+TEST(SampleAccumulatorTest, MatchesSampleWiseSum) {
+  for (const Implementation& implementation : Implementations()) {
+    SCOPED_TRACE(implementation.name);
+    for (size_t number_of_channels = 1; number_of_channels <= kMaxChannels;
+         ++number_of_channels) {
+      for (size_t samples_per_channel = 0; samples_per_channel <= 20;
+           ++samples_per_channel) {
+        ExpectAccumulateMatchesReference(
+            implementation.function, samples_per_channel, number_of_channels);
+      }
+      for (size_t samples_per_channel : {80, 160, 320, 441, 480}) {
+        ExpectAccumulateMatchesReference(
+            implementation.function, samples_per_channel, number_of_channels);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
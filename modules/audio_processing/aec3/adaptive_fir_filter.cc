@@ -162,15 +162,20 @@ void AdaptPartitions_NEON(const RenderBuffer& render_buffer,
       std::min(render_buffer_data.size() - render_buffer.Position(), H.size());
   const int lim2 = H.size();
   constexpr int kNumFourBinBands = kFftLengthBy2 / 4;
-  FftData* H_j = &H[0];
-  const FftData* X = &render_buffer_data[render_buffer.Position()];
-  int limit = lim1;
-  int j = 0;
-  do {
-    for (; j < limit; ++j, ++H_j, ++X) {
-      for (int k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
-        const float32x4_t G_re = vld1q_f32(&G.re[k]);
-        const float32x4_t G_im = vld1q_f32(&G.im[k]);
+  FftData* H_j;
+  const FftData* X;
+  int limit;
+  int j;
+  for (int k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
+    const float32x4_t G_re = vld1q_f32(&G.re[k]);
+    const float32x4_t G_im = vld1q_f32(&G.im[k]);
+
+    H_j = &H[0];
+    X = &render_buffer_data[render_buffer.Position()];
+    limit = lim1;
+    j = 0;
+    do {
+      for (; j < limit; ++j, ++H_j, ++X) {
         const float32x4_t X_re = vld1q_f32(&X->re[k]);
         const float32x4_t X_im = vld1q_f32(&X->im[k]);
         const float32x4_t H_re = vld1q_f32(&H_j->re[k]);
@@ -181,15 +186,14 @@ void AdaptPartitions_NEON(const RenderBuffer& render_buffer,
         const float32x4_t f = vmlsq_f32(c, X_im, G_re);
         const float32x4_t g = vaddq_f32(H_re, e);
         const float32x4_t h = vaddq_f32(H_im, f);
-
         vst1q_f32(&H_j->re[k], g);
         vst1q_f32(&H_j->im[k], h);
       }
-    }
 
-    X = &render_buffer_data[0];
-    limit = lim2;
-  } while (j < lim2);
+      X = &render_buffer_data[0];
+      limit = lim2;
+    } while (j < lim2);
+  }
 
   H_j = &H[0];
   X = &render_buffer_data[render_buffer.Position()];
@@ -294,7 +298,9 @@ void ApplyFilter(const RenderBuffer& render_buffer,
 }
 
 #if defined(WEBRTC_HAS_NEON)
-// Produces the filter output (NEON variant).
+// Produces the filter output (NEON variant). The bands are the outer loop so
+// that the output of each band is accumulated in registers over the
+// partitions, rather than being loaded and stored once per partition.
 void ApplyFilter_NEON(const RenderBuffer& render_buffer,
                       rtc::ArrayView<const FftData> H,
                       FftData* S) {
@@ -308,33 +314,38 @@ void ApplyFilter_NEON(const RenderBuffer& render_buffer,
       std::min(render_buffer_data.size() - render_buffer.Position(), H.size());
   const int lim2 = H.size();
   constexpr int kNumFourBinBands = kFftLengthBy2 / 4;
-  const FftData* H_j = &H[0];
-  const FftData* X = &render_buffer_data[render_buffer.Position()];
+  const FftData* H_j;
+  const FftData* X;
+  int limit;
+  int j;
+  for (int k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
+    float32x4_t S_re = vdupq_n_f32(0.f);
+    float32x4_t S_im = vdupq_n_f32(0.f);
 
-  int j = 0;
-  int limit = lim1;
-  do {
-    for (; j < limit; ++j, ++H_j, ++X) {
-      for (int k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
+    H_j = &H[0];
+    X = &render_buffer_data[render_buffer.Position()];
+    limit = lim1;
+    j = 0;
+    do {
+      for (; j < limit; ++j, ++H_j, ++X) {
         const float32x4_t X_re = vld1q_f32(&X->re[k]);
         const float32x4_t X_im = vld1q_f32(&X->im[k]);
         const float32x4_t H_re = vld1q_f32(&H_j->re[k]);
         const float32x4_t H_im = vld1q_f32(&H_j->im[k]);
-        const float32x4_t S_re = vld1q_f32(&S->re[k]);
-        const float32x4_t S_im = vld1q_f32(&S->im[k]);
         const float32x4_t a = vmulq_f32(X_re, H_re);
         const float32x4_t e = vmlsq_f32(a, X_im, H_im);
         const float32x4_t c = vmulq_f32(X_re, H_im);
         const float32x4_t f = vmlaq_f32(c, X_im, H_re);
-        const float32x4_t g = vaddq_f32(S_re, e);
-        const float32x4_t h = vaddq_f32(S_im, f);
-        vst1q_f32(&S->re[k], g);
-        vst1q_f32(&S->im[k], h);
+        S_re = vaddq_f32(S_re, e);
+        S_im = vaddq_f32(S_im, f);
       }
-    }
-    limit = lim2;
-    X = &render_buffer_data[0];
-  } while (j < lim2);
+      limit = lim2;
+      X = &render_buffer_data[0];
+    } while (j < lim2);
+
+    vst1q_f32(&S->re[k], S_re);
+    vst1q_f32(&S->im[k], S_im);
+  }
 
   H_j = &H[0];
   X = &render_buffer_data[render_buffer.Position()];
@@ -354,7 +365,9 @@ void ApplyFilter_NEON(const RenderBuffer& render_buffer,
 #endif
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-// Produces the filter output (SSE2 variant).
+// Produces the filter output (SSE2 variant). The bands are the outer loop so
+// that the output of each band is accumulated in registers over the
+// partitions, rather than being loaded and stored once per partition.
 void ApplyFilter_SSE2(const RenderBuffer& render_buffer,
                       rtc::ArrayView<const FftData> H,
                       FftData* S) {
@@ -368,35 +381,40 @@ void ApplyFilter_SSE2(const RenderBuffer& render_buffer,
       std::min(render_buffer_data.size() - render_buffer.Position(), H.size());
   const int lim2 = H.size();
   constexpr int kNumFourBinBands = kFftLengthBy2 / 4;
-  const FftData* H_j = &H[0];
-  const FftData* X = &render_buffer_data[render_buffer.Position()];
+  const FftData* H_j;
+  const FftData* X;
+  int limit;
+  int j;
+  for (int k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
+    __m128 S_re = _mm_setzero_ps();
+    __m128 S_im = _mm_setzero_ps();
 
-  int j = 0;
-  int limit = lim1;
-  do {
-    for (; j < limit; ++j, ++H_j, ++X) {
-      for (int k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
+    H_j = &H[0];
+    X = &render_buffer_data[render_buffer.Position()];
+    limit = lim1;
+    j = 0;
+    do {
+      for (; j < limit; ++j, ++H_j, ++X) {
         const __m128 X_re = _mm_loadu_ps(&X->re[k]);
         const __m128 X_im = _mm_loadu_ps(&X->im[k]);
         const __m128 H_re = _mm_loadu_ps(&H_j->re[k]);
         const __m128 H_im = _mm_loadu_ps(&H_j->im[k]);
-        const __m128 S_re = _mm_loadu_ps(&S->re[k]);
-        const __m128 S_im = _mm_loadu_ps(&S->im[k]);
         const __m128 a = _mm_mul_ps(X_re, H_re);
         const __m128 b = _mm_mul_ps(X_im, H_im);
         const __m128 c = _mm_mul_ps(X_re, H_im);
         const __m128 d = _mm_mul_ps(X_im, H_re);
         const __m128 e = _mm_sub_ps(a, b);
         const __m128 f = _mm_add_ps(c, d);
-        const __m128 g = _mm_add_ps(S_re, e);
-        const __m128 h = _mm_add_ps(S_im, f);
-        _mm_storeu_ps(&S->re[k], g);
-        _mm_storeu_ps(&S->im[k], h);
+        S_re = _mm_add_ps(S_re, e);
+        S_im = _mm_add_ps(S_im, f);
       }
-    }
-    limit = lim2;
-    X = &render_buffer_data[0];
-  } while (j < lim2);
+      limit = lim2;
+      X = &render_buffer_data[0];
+    } while (j < lim2);
+
+    _mm_storeu_ps(&S->re[k], S_re);
+    _mm_storeu_ps(&S->im[k], S_im);
+  }
 
   H_j = &H[0];
   X = &render_buffer_data[render_buffer.Position()];
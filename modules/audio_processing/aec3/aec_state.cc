@@ -340,10 +340,13 @@ void AecState::Update(
   const bool stationary_block =
       use_stationary_properties_ && echo_audibility_.IsBlockStationary();
 
-  reverb_model_estimator_.Update(
-      filter_analyzer_.GetAdjustedFilter(), adaptive_filter_frequency_response,
-      erle_estimator_.GetInstLinearQualityEstimate(), filter_delay_blocks_,
-      usable_linear_estimate_, stationary_block);
+  if (config_.ep_strength.estimate_reverb_model) {
+    reverb_model_estimator_.Update(
+        filter_analyzer_.GetAdjustedFilter(),
+        adaptive_filter_frequency_response,
+        erle_estimator_.GetInstLinearQualityEstimate(), filter_delay_blocks_,
+        usable_linear_estimate_, stationary_block);
+  }
 
   erle_estimator_.Dump(data_dumper_);
   reverb_model_estimator_.Dump(data_dumper_.get());
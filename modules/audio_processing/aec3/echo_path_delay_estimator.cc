@@ -37,6 +37,8 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
       sub_block_size_(down_sampling_factor_ != 0
                           ? kBlockSize / down_sampling_factor_
                           : kBlockSize),
+      estimation_interval_blocks_(
+          std::max(config.delay.estimation_interval_blocks, size_t{1})),
       capture_decimator_(down_sampling_factor_),
       matched_filter_(
           data_dumper_,
@@ -63,6 +65,7 @@ void EchoPathDelayEstimator::Reset(bool soft_reset) {
   matched_filter_.Reset();
   old_aggregated_lag_ = absl::nullopt;
   consistent_estimate_counter_ = 0;
+  blocks_since_estimation_ = 0;
 }
 
 absl::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
@@ -79,6 +82,15 @@ absl::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   data_dumper_->DumpWav("aec3_capture_decimator_output",
                         downsampled_capture.size(), downsampled_capture.data(),
                         16000 / down_sampling_factor_, 1);
+
+  // The decimator runs on every block to keep its filter states continuous,
+  // while the matched filters only run once per estimation interval.
+  if (blocks_since_estimation_ > 0) {
+    blocks_since_estimation_ =
+        (blocks_since_estimation_ + 1) % estimation_interval_blocks_;
+    return old_aggregated_lag_;
+  }
+  blocks_since_estimation_ = 1 % estimation_interval_blocks_;
   matched_filter_.Update(render_buffer, downsampled_capture);
 
   absl::optional<DelayEstimate> aggregated_matched_filter_lag =
@@ -108,7 +120,8 @@ absl::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   }
   old_aggregated_lag_ = aggregated_matched_filter_lag;
   constexpr size_t kNumBlocksPerSecondBy2 = kNumBlocksPerSecond / 2;
-  if (consistent_estimate_counter_ > kNumBlocksPerSecondBy2) {
+  if (consistent_estimate_counter_ * estimation_interval_blocks_ >
+      kNumBlocksPerSecondBy2) {
     Reset(true);
   }
 
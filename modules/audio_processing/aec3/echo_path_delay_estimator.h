@@ -52,11 +52,13 @@ class EchoPathDelayEstimator {
   ApmDataDumper* const data_dumper_;
   const size_t down_sampling_factor_;
   const size_t sub_block_size_;
+  const size_t estimation_interval_blocks_;
   Decimator capture_decimator_;
   MatchedFilter matched_filter_;
   MatchedFilterLagAggregator matched_filter_lag_aggregator_;
   absl::optional<DelayEstimate> old_aggregated_lag_;
   size_t consistent_estimate_counter_ = 0;
+  size_t blocks_since_estimation_ = 0;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(EchoPathDelayEstimator);
 };
@@ -108,6 +108,55 @@ TEST(EchoPathDelayEstimator, DelayEstimation) {
   }
 }
 
+// Verifies that the delay estimator finds the delay also when the matched
+// filters only run every few blocks.
+TEST(EchoPathDelayEstimator, DelayEstimationWithReducedRate) {
+  Random random_generator(42U);
+  std::vector<std::vector<float>> render(3, std::vector<float>(kBlockSize));
+  std::vector<float> capture(kBlockSize);
+  ApmDataDumper data_dumper(0);
+  EchoCanceller3Config config;
+  config.delay.estimation_interval_blocks = 2;
+  config.delay.api_call_jitter_blocks = 5;
+  for (size_t delay_samples : {30, 64, 150, 200, 800}) {
+    SCOPED_TRACE(
+        ProduceDebugText(delay_samples, config.delay.down_sampling_factor));
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, 3));
+    DelayBuffer<float> signal_delay_buffer(
+        delay_samples + 2 * config.delay.api_call_jitter_blocks * 64);
+    EchoPathDelayEstimator estimator(&data_dumper, config);
+
+    absl::optional<DelayEstimate> estimated_delay_samples;
+    for (size_t k = 0; k < (1000 + (delay_samples) / kBlockSize); ++k) {
+      RandomizeSampleVector(&random_generator, render[0]);
+      signal_delay_buffer.Delay(render[0], capture);
+      render_delay_buffer->Insert(render);
+
+      if (k == 0) {
+        render_delay_buffer->Reset();
+      }
+
+      render_delay_buffer->PrepareCaptureProcessing();
+
+      auto estimate = estimator.EstimateDelay(
+          render_delay_buffer->GetDownsampledRenderBuffer(), capture);
+
+      if (estimate) {
+        estimated_delay_samples = estimate;
+      }
+    }
+
+    ASSERT_TRUE(estimated_delay_samples);
+    size_t delay_ds = delay_samples / config.delay.down_sampling_factor;
+    size_t estimated_delay_ds =
+        (estimated_delay_samples->delay -
+         (config.delay.api_call_jitter_blocks + 1) * 64) /
+        config.delay.down_sampling_factor;
+    EXPECT_NEAR(delay_ds, estimated_delay_ds, 1);
+  }
+}
+
 // Verifies that the delay estimator does not produce delay estimates for render
 // signals of low level.
 TEST(EchoPathDelayEstimator, NoDelayEstimatesForLowLevelRenderSignals) {
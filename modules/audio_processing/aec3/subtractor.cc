@@ -113,6 +113,7 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
       enable_shadow_filter_boosted_jumpstart_(
           EnableShadowFilterBoostedJumpstart()),
       enable_early_shadow_filter_jumpstart_(EnableEarlyShadowFilterJumpstart()),
+      use_shadow_filter_(config.filter.use_shadow_filter),
       main_filter_(config_.filter.main.length_blocks,
                    config_.filter.main_initial.length_blocks,
                    config.filter.config_change_duration_blocks,
@@ -187,10 +188,15 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
   PredictionError(fft_, S, y, &e_main, &output->s_main,
                   adaptation_during_saturation_, &main_saturation);
 
-  shadow_filter_.Filter(render_buffer, &S);
   bool shadow_saturation = false;
-  PredictionError(fft_, S, y, &e_shadow, &output->s_shadow,
-                  adaptation_during_saturation_, &shadow_saturation);
+  if (use_shadow_filter_) {
+    shadow_filter_.Filter(render_buffer, &S);
+    PredictionError(fft_, S, y, &e_shadow, &output->s_shadow,
+                    adaptation_during_saturation_, &shadow_saturation);
+  } else {
+    e_shadow = e_main;
+    output->s_shadow = output->s_main;
+  }
 
   // Compute the signal powers in the subtractor output.
   output->UpdatePowers(y);
@@ -208,13 +214,16 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
     }
   }
 
-  // Compute the FFts of the main and shadow filter outputs.
+  // Compute the FFts of the main and shadow filter outputs, and their spectra
+  // for future use.
   fft_.ZeroPaddedFft(e_main, Aec3Fft::Window::kHanning, &E_main);
-  fft_.ZeroPaddedFft(e_shadow, Aec3Fft::Window::kHanning, &E_shadow);
-
-  // Compute spectra for future use.
-  E_shadow.Spectrum(optimization_, output->E2_shadow);
   E_main.Spectrum(optimization_, output->E2_main);
+  if (use_shadow_filter_) {
+    fft_.ZeroPaddedFft(e_shadow, Aec3Fft::Window::kHanning, &E_shadow);
+    E_shadow.Spectrum(optimization_, output->E2_shadow);
+  } else {
+    output->E2_shadow = output->E2_main;
+  }
 
   // Compute the render powers.
   std::array<float, kFftLengthBy2Plus1> X2_main;
@@ -223,7 +232,8 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
       main_filter_.SizePartitions() == shadow_filter_.SizePartitions()
           ? X2_main
           : X2_shadow_data;
-  if (main_filter_.SizePartitions() == shadow_filter_.SizePartitions()) {
+  if (!use_shadow_filter_ ||
+      main_filter_.SizePartitions() == shadow_filter_.SizePartitions()) {
     render_buffer.SpectralSum(main_filter_.SizePartitions(), &X2_main);
   } else if (main_filter_.SizePartitions() > shadow_filter_.SizePartitions()) {
     render_buffer.SpectralSums(shadow_filter_.SizePartitions(),
@@ -248,35 +258,38 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
   data_dumper_->DumpRaw("aec3_subtractor_G_main", G.im);
 
   // Update the shadow filter.
-  poor_shadow_filter_counter_ =
-      output->e2_main < output->e2_shadow ? poor_shadow_filter_counter_ + 1 : 0;
-  if (((poor_shadow_filter_counter_ < 5 &&
-        enable_early_shadow_filter_jumpstart_) ||
-       (poor_shadow_filter_counter_ < 10 &&
-        !enable_early_shadow_filter_jumpstart_)) ||
-      !enable_shadow_filter_jumpstart_) {
-    G_shadow_.Compute(X2_shadow, render_signal_analyzer, E_shadow,
-                      shadow_filter_.SizePartitions(),
-                      aec_state.SaturatedCapture() || shadow_saturation, &G);
-    shadow_filter_.Adapt(render_buffer, G);
-  } else {
-    poor_shadow_filter_counter_ = 0;
-    if (enable_shadow_filter_boosted_jumpstart_) {
-      shadow_filter_.SetFilter(main_filter_.GetFilter());
-      G_shadow_.Compute(X2_shadow, render_signal_analyzer, E_main,
+  if (use_shadow_filter_) {
+    poor_shadow_filter_counter_ = output->e2_main < output->e2_shadow
+                                      ? poor_shadow_filter_counter_ + 1
+                                      : 0;
+    if (((poor_shadow_filter_counter_ < 5 &&
+          enable_early_shadow_filter_jumpstart_) ||
+         (poor_shadow_filter_counter_ < 10 &&
+          !enable_early_shadow_filter_jumpstart_)) ||
+        !enable_shadow_filter_jumpstart_) {
+      G_shadow_.Compute(X2_shadow, render_signal_analyzer, E_shadow,
                         shadow_filter_.SizePartitions(),
-                        aec_state.SaturatedCapture() || main_saturation, &G);
+                        aec_state.SaturatedCapture() || shadow_saturation, &G);
       shadow_filter_.Adapt(render_buffer, G);
     } else {
-      G.re.fill(0.f);
-      G.im.fill(0.f);
-      shadow_filter_.Adapt(render_buffer, G);
-      shadow_filter_.SetFilter(main_filter_.GetFilter());
+      poor_shadow_filter_counter_ = 0;
+      if (enable_shadow_filter_boosted_jumpstart_) {
+        shadow_filter_.SetFilter(main_filter_.GetFilter());
+        G_shadow_.Compute(X2_shadow, render_signal_analyzer, E_main,
+                          shadow_filter_.SizePartitions(),
+                          aec_state.SaturatedCapture() || main_saturation, &G);
+        shadow_filter_.Adapt(render_buffer, G);
+      } else {
+        G.re.fill(0.f);
+        G.im.fill(0.f);
+        shadow_filter_.Adapt(render_buffer, G);
+        shadow_filter_.SetFilter(main_filter_.GetFilter());
+      }
     }
-  }
 
-  data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.re);
-  data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.im);
+    data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.re);
+    data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.im);
+  }
   filter_misadjustment_estimator_.Dump(data_dumper_);
   DumpFilters();
 
@@ -285,6 +298,12 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                   [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
   }
 
+  if (!use_shadow_filter_) {
+    // Match the adjustments made to the main filter output.
+    e_shadow = e_main;
+    output->s_shadow = output->s_main;
+  }
+
   data_dumper_->DumpWav("aec3_main_filter_output", kBlockSize, &e_main[0],
                         16000, 1);
   data_dumper_->DumpWav("aec3_shadow_filter_output", kBlockSize, &e_shadow[0],
@@ -110,6 +110,7 @@ class Subtractor {
   const bool enable_shadow_filter_jumpstart_;
   const bool enable_shadow_filter_boosted_jumpstart_;
   const bool enable_early_shadow_filter_jumpstart_;
+  const bool use_shadow_filter_;
 
   AdaptiveFirFilter main_filter_;
   AdaptiveFirFilter shadow_filter_;
@@ -27,12 +27,22 @@ float RunSubtractorTest(int num_blocks_to_process,
                         int delay_samples,
                         int main_filter_length_blocks,
                         int shadow_filter_length_blocks,
+                        bool use_shadow_filter,
                         bool uncorrelated_inputs,
                         const std::vector<int>& blocks_with_echo_path_changes) {
   ApmDataDumper data_dumper(42);
   EchoCanceller3Config config;
   config.filter.main.length_blocks = main_filter_length_blocks;
   config.filter.shadow.length_blocks = shadow_filter_length_blocks;
+  config.filter.use_shadow_filter = use_shadow_filter;
+  if (!use_shadow_filter) {
+    // Without the shadow filter, the main filter needs the faster leakage of
+    // the low-power configuration to converge.
+    const EchoCanceller3Config low_power_config =
+        EchoCanceller3Config::CreateLowPowerConfig();
+    config.filter.main_initial = low_power_config.filter.main_initial;
+    config.filter.main_initial.length_blocks = main_filter_length_blocks;
+  }
 
   Subtractor subtractor(config, &data_dumper, DetectOptimization());
   absl::optional<DelayEstimate> delay_estimate;
@@ -82,6 +92,11 @@ float RunSubtractorTest(int num_blocks_to_process,
     }
     subtractor.Process(*render_delay_buffer->GetRenderBuffer(), y,
                        render_signal_analyzer, aec_state, &output);
+    if (!use_shadow_filter) {
+      EXPECT_TRUE(std::equal(output.e_main.begin(), output.e_main.end(),
+                             output.e_shadow.begin()));
+      EXPECT_EQ(output.e2_main, output.e2_shadow);
+    }
 
     aec_state.HandleEchoPathChange(EchoPathVariability(
         false, EchoPathVariability::DelayAdjustment::kNone, false));
@@ -163,8 +178,8 @@ TEST(Subtractor, Convergence) {
       SCOPED_TRACE(ProduceDebugText(delay_samples, filter_length_blocks));
 
       float echo_to_nearend_power = RunSubtractorTest(
-          400, delay_samples, filter_length_blocks, filter_length_blocks, false,
-          blocks_with_echo_path_changes);
+          400, delay_samples, filter_length_blocks, filter_length_blocks, true,
+          false, blocks_with_echo_path_changes);
 
       // Use different criteria to take overmodelling into account.
       if (filter_length_blocks == 12) {
@@ -176,12 +191,26 @@ TEST(Subtractor, Convergence) {
   }
 }
 
+// Verifies that the subtractor converges with only the main filter, and that
+// the shadow filter outputs then are those of the main filter.
+TEST(Subtractor, ConvergenceWithoutShadowFilter) {
+  std::vector<int> blocks_with_echo_path_changes;
+  for (size_t delay_samples : {0, 64, 150, 200, 301}) {
+    SCOPED_TRACE(ProduceDebugText(delay_samples, 12));
+    float echo_to_nearend_power =
+        RunSubtractorTest(400, delay_samples, 12, 12, false, false,
+                          blocks_with_echo_path_changes);
+    EXPECT_GT(0.1f, echo_to_nearend_power);
+  }
+}
+
 // Verifies that the subtractor is able to handle the case when the main filter
 // is longer than the shadow filter.
 TEST(Subtractor, MainFilterLongerThanShadowFilter) {
   std::vector<int> blocks_with_echo_path_changes;
   float echo_to_nearend_power =
-      RunSubtractorTest(400, 64, 20, 15, false, blocks_with_echo_path_changes);
+      RunSubtractorTest(400, 64, 20, 15, true, false,
+                        blocks_with_echo_path_changes);
   EXPECT_GT(0.5f, echo_to_nearend_power);
 }
 
@@ -190,7 +219,8 @@ TEST(Subtractor, MainFilterLongerThanShadowFilter) {
 TEST(Subtractor, ShadowFilterLongerThanMainFilter) {
   std::vector<int> blocks_with_echo_path_changes;
   float echo_to_nearend_power =
-      RunSubtractorTest(400, 64, 15, 20, false, blocks_with_echo_path_changes);
+      RunSubtractorTest(400, 64, 15, 20, true, false,
+                        blocks_with_echo_path_changes);
   EXPECT_GT(0.5f, echo_to_nearend_power);
 }
 
@@ -203,7 +233,7 @@ TEST(Subtractor, NonConvergenceOnUncorrelatedSignals) {
 
       float echo_to_nearend_power = RunSubtractorTest(
           300, delay_samples, filter_length_blocks, filter_length_blocks, true,
-          blocks_with_echo_path_changes);
+          true, blocks_with_echo_path_changes);
       EXPECT_NEAR(1.f, echo_to_nearend_power, 0.1);
     }
   }
@@ -219,8 +249,8 @@ TEST(Subtractor, EchoPathChangeReset) {
       SCOPED_TRACE(ProduceDebugText(delay_samples, filter_length_blocks));
 
       float echo_to_nearend_power = RunSubtractorTest(
-          100, delay_samples, filter_length_blocks, filter_length_blocks, false,
-          blocks_with_echo_path_changes);
+          100, delay_samples, filter_length_blocks, filter_length_blocks, true,
+          false, blocks_with_echo_path_changes);
       EXPECT_NEAR(1.f, echo_to_nearend_power, 0.0000001f);
     }
   }
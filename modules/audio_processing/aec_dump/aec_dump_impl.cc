@@ -16,6 +16,7 @@
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
+#include "rtc_base/logging.h"
 
 namespace webrtc {
 
@@ -57,21 +58,33 @@ void CopyFromConfigToEvent(const webrtc::InternalAPMConfig& config,
 
 }  // namespace
 
+constexpr int AecDumpImpl::kMaxNumBytesInFlight;
+
 AecDumpImpl::AecDumpImpl(std::unique_ptr<FileWrapper> debug_file,
                          int64_t max_log_size_bytes,
                          rtc::TaskQueue* worker_queue)
     : debug_file_(std::move(debug_file)),
-      num_bytes_left_for_log_(max_log_size_bytes),
+      file_writer_(debug_file_.get(), max_log_size_bytes),
+      num_bytes_in_flight_(0),
+      num_dropped_events_(0),
       worker_queue_(worker_queue),
       capture_stream_info_(CreateWriteToFileTask()) {}
 
 AecDumpImpl::~AecDumpImpl() {
-  // Block until all tasks have finished running.
+  // Block until all tasks have finished running, and write what they left
+  // in the buffer.
   rtc::Event thread_sync_event(false /* manual_reset */, false);
-  worker_queue_->PostTask([&thread_sync_event] { thread_sync_event.Set(); });
+  worker_queue_->PostTask([this, &thread_sync_event] {
+    file_writer_.Flush();
+    thread_sync_event.Set();
+  });
   // Wait until the event has been signaled with .Set(). By then all
   // pending tasks will have finished.
   thread_sync_event.Wait(rtc::Event::kForever);
+  if (num_dropped_events_ > 0) {
+    RTC_LOG(LS_WARNING) << "AecDump dropped " << num_dropped_events_.load()
+                        << " events because writing fell behind.";
+  }
 }
 
 void AecDumpImpl::WriteInitMessage(const ProcessingConfig& api_format,
@@ -98,7 +111,7 @@ void AecDumpImpl::WriteInitMessage(const ProcessingConfig& api_format,
       api_format.reverse_output_stream().num_channels());
   msg->set_timestamp_ms(time_now_ms);
 
-  worker_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(std::move(task)));
+  PostWriteToFileTask(std::move(task));
 }
 
 void AecDumpImpl::AddCaptureStreamInput(
@@ -126,7 +139,7 @@ void AecDumpImpl::AddAudioProcessingState(const AudioProcessingState& state) {
 void AecDumpImpl::WriteCaptureStreamMessage() {
   auto task = capture_stream_info_.GetTask();
   RTC_DCHECK(task);
-  worker_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(std::move(task)));
+  PostWriteToFileTask(std::move(task));
   capture_stream_info_.SetTask(CreateWriteToFileTask());
 }
 
@@ -140,7 +153,7 @@ void AecDumpImpl::WriteRenderStreamMessage(const AudioFrame& frame) {
       sizeof(int16_t) * frame.samples_per_channel_ * frame.num_channels_;
   msg->set_data(frame.data(), data_size);
 
-  worker_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(std::move(task)));
+  PostWriteToFileTask(std::move(task));
 }
 
 void AecDumpImpl::WriteRenderStreamMessage(
@@ -157,7 +170,7 @@ void AecDumpImpl::WriteRenderStreamMessage(
     msg->add_channel(channel_view.begin(), sizeof(float) * channel_view.size());
   }
 
-  worker_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(std::move(task)));
+  PostWriteToFileTask(std::move(task));
 }
 
 void AecDumpImpl::WriteConfig(const InternalAPMConfig& config) {
@@ -166,12 +179,28 @@ void AecDumpImpl::WriteConfig(const InternalAPMConfig& config) {
   auto* event = task->GetEvent();
   event->set_type(audioproc::Event::CONFIG);
   CopyFromConfigToEvent(config, event->mutable_config());
-  worker_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(std::move(task)));
+  PostWriteToFileTask(std::move(task));
 }
 
 std::unique_ptr<WriteToFileTask> AecDumpImpl::CreateWriteToFileTask() {
-  return absl::make_unique<WriteToFileTask>(debug_file_.get(),
-                                            &num_bytes_left_for_log_);
+  return absl::make_unique<WriteToFileTask>(&file_writer_,
+                                            &num_bytes_in_flight_);
+}
+
+void AecDumpImpl::PostWriteToFileTask(std::unique_ptr<WriteToFileTask> task) {
+  const audioproc::Event& event = *task->GetEvent();
+  const int event_byte_size = static_cast<int>(event.ByteSizeLong());
+  // INIT and CONFIG events are never dropped; they're rare, and the rest of
+  // the dump can't be interpreted without them.
+  const bool is_audio = event.type() == audioproc::Event::STREAM ||
+                        event.type() == audioproc::Event::REVERSE_STREAM;
+  if (is_audio &&
+      num_bytes_in_flight_ + event_byte_size > kMaxNumBytesInFlight) {
+    ++num_dropped_events_;
+    return;
+  }
+  num_bytes_in_flight_ += event_byte_size;
+  worker_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(std::move(task)));
 }
 
 std::unique_ptr<AecDump> AecDumpFactory::Create(rtc::PlatformFile file,
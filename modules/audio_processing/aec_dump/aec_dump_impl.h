@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_AEC_DUMP_IMPL_H_
 #define MODULES_AUDIO_PROCESSING_AEC_DUMP_AEC_DUMP_IMPL_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,8 +44,14 @@ namespace webrtc {
 
 // Task-queue based implementation of AecDump. It is thread safe by
 // relying on locks in TaskQueue.
+//
+// Events are serialized and written on the worker queue, in batches. If the
+// worker queue falls behind by more than kMaxNumBytesInFlight, stream and
+// reverse stream events are dropped, instead of holding on to the audio.
 class AecDumpImpl : public AecDump {
  public:
+  static constexpr int kMaxNumBytesInFlight = 4 * 1024 * 1024;
+
   // Does member variables initialization shared across all c-tors.
   AecDumpImpl(std::unique_ptr<FileWrapper> debug_file,
               int64_t max_log_size_bytes,
@@ -69,9 +76,14 @@ class AecDumpImpl : public AecDump {
 
  private:
   std::unique_ptr<WriteToFileTask> CreateWriteToFileTask();
+  void PostWriteToFileTask(std::unique_ptr<WriteToFileTask> task);
 
   std::unique_ptr<FileWrapper> debug_file_;
-  int64_t num_bytes_left_for_log_ = 0;
+  // Used on |worker_queue_| only.
+  AecDumpFileWriter file_writer_;
+  // Size of the events posted to |worker_queue_| and not written yet.
+  std::atomic<int> num_bytes_in_flight_;
+  std::atomic<int> num_dropped_events_;
   rtc::RaceChecker race_checker_;
   rtc::TaskQueue* worker_queue_;
   CaptureStreamInfo capture_stream_info_;
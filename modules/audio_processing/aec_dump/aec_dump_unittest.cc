@@ -8,14 +8,44 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
 
+#include "modules/audio_processing/aec_dump/aec_dump_impl.h"
+#include "rtc_base/event.h"
 #include "rtc_base/task_queue.h"
 #include "test/gtest.h"
 #include "test/testsupport/fileutils.h"
 
+namespace {
+
+// Reads the events of the dump |filename|, each preceded by its size.
+std::vector<webrtc::audioproc::Event> ReadEvents(const std::string& filename) {
+  std::vector<webrtc::audioproc::Event> events;
+  FILE* fid = fopen(filename.c_str(), "rb");
+  EXPECT_TRUE(fid != NULL);
+  int32_t event_byte_size;
+  while (fread(&event_byte_size, sizeof(event_byte_size), 1, fid) == 1) {
+    std::string event_string(event_byte_size, '\0');
+    EXPECT_EQ(1u, fread(&event_string[0], event_byte_size, 1, fid));
+    events.emplace_back();
+    EXPECT_TRUE(events.back().ParseFromString(event_string));
+  }
+  fclose(fid);
+  return events;
+}
+
+void MakeFull(webrtc::AudioFrame* frame) {
+  frame->samples_per_channel_ = webrtc::AudioFrame::kMaxDataSizeSamples;
+  frame->num_channels_ = 1;
+  frame->mutable_data();
+}
+
+}  // namespace
+
 TEST(AecDumper, APICallsDoNotCrash) {
   // Note order of initialization: Task queue has to be initialized
   // before AecDump.
@@ -69,3 +99,67 @@ TEST(AecDumper, WriteToFile) {
   ASSERT_EQ(0, fclose(fid));
   ASSERT_EQ(0, remove(filename.c_str()));
 }
+
+TEST(AecDumper, WritesAllEventsInOrder) {
+  rtc::TaskQueue file_writer_queue("file_writer_queue");
+
+  const std::string filename =
+      webrtc::test::TempFilename(webrtc::test::OutputPath(), "aec_dump");
+
+  // More events than fit in one write batch.
+  constexpr int kNumFrames = 100;
+  {
+    std::unique_ptr<webrtc::AecDump> aec_dump =
+        webrtc::AecDumpFactory::Create(filename, -1, &file_writer_queue);
+    webrtc::ProcessingConfig api_format;
+    aec_dump->WriteInitMessage(api_format, 0);
+    webrtc::AudioFrame frame;
+    MakeFull(&frame);
+    for (int i = 0; i < kNumFrames; ++i)
+      aec_dump->WriteRenderStreamMessage(frame);
+  }
+
+  std::vector<webrtc::audioproc::Event> events = ReadEvents(filename);
+  ASSERT_EQ(static_cast<size_t>(kNumFrames + 1), events.size());
+  EXPECT_EQ(webrtc::audioproc::Event::INIT, events[0].type());
+  for (int i = 1; i <= kNumFrames; ++i) {
+    EXPECT_EQ(webrtc::audioproc::Event::REVERSE_STREAM, events[i].type());
+    EXPECT_EQ(webrtc::AudioFrame::kMaxDataSizeBytes,
+              events[i].reverse_stream().data().size());
+  }
+
+  ASSERT_EQ(0, remove(filename.c_str()));
+}
+
+TEST(AecDumper, DropsAudioWhenWritingFallsBehind) {
+  rtc::TaskQueue file_writer_queue("file_writer_queue");
+
+  const std::string filename =
+      webrtc::test::TempFilename(webrtc::test::OutputPath(), "aec_dump");
+
+  webrtc::AudioFrame frame;
+  MakeFull(&frame);
+  const int kNumFrames = 2 * webrtc::AecDumpImpl::kMaxNumBytesInFlight /
+                         webrtc::AudioFrame::kMaxDataSizeBytes;
+  {
+    std::unique_ptr<webrtc::AecDump> aec_dump =
+        webrtc::AecDumpFactory::Create(filename, -1, &file_writer_queue);
+    // Stall the worker queue while the events are posted.
+    rtc::Event stall_event(false /* manual_reset */, false);
+    file_writer_queue.PostTask(
+        [&stall_event] { stall_event.Wait(rtc::Event::kForever); });
+    for (int i = 0; i < kNumFrames; ++i)
+      aec_dump->WriteRenderStreamMessage(frame);
+    webrtc::InternalAPMConfig apm_config;
+    aec_dump->WriteConfig(apm_config);
+    stall_event.Set();
+  }
+
+  std::vector<webrtc::audioproc::Event> events = ReadEvents(filename);
+  EXPECT_GT(events.size(), 1u);
+  EXPECT_LT(events.size(), static_cast<size_t>(kNumFrames / 2 + 1));
+  // The config is kept, even though the audio before it was dropped.
+  EXPECT_EQ(webrtc::audioproc::Event::CONFIG, events.back().type());
+
+  ASSERT_EQ(0, remove(filename.c_str()));
+}
@@ -10,58 +10,76 @@
 
 #include "modules/audio_processing/aec_dump/write_to_file_task.h"
 
-#include "rtc_base/protobuf_utils.h"
-
 namespace webrtc {
 
-WriteToFileTask::WriteToFileTask(webrtc::FileWrapper* debug_file,
-                                 int64_t* num_bytes_left_for_log)
-    : debug_file_(debug_file),
-      num_bytes_left_for_log_(num_bytes_left_for_log) {}
-
-WriteToFileTask::~WriteToFileTask() = default;
+constexpr size_t AecDumpFileWriter::kWriteBatchSizeBytes;
 
-audioproc::Event* WriteToFileTask::GetEvent() {
-  return &event_;
+AecDumpFileWriter::AecDumpFileWriter(webrtc::FileWrapper* debug_file,
+                                     int64_t max_log_size_bytes)
+    : debug_file_(debug_file), num_bytes_left_for_log_(max_log_size_bytes) {
+  buffer_.reserve(kWriteBatchSizeBytes);
 }
 
-bool WriteToFileTask::IsRoomForNextEvent(size_t event_byte_size) const {
-  int64_t next_message_size = event_byte_size + sizeof(int32_t);
-  return (*num_bytes_left_for_log_ < 0) ||
-         (*num_bytes_left_for_log_ >= next_message_size);
-}
+AecDumpFileWriter::~AecDumpFileWriter() = default;
 
-void WriteToFileTask::UpdateBytesLeft(size_t event_byte_size) {
-  RTC_DCHECK(IsRoomForNextEvent(event_byte_size));
-  if (*num_bytes_left_for_log_ >= 0) {
-    *num_bytes_left_for_log_ -= (sizeof(int32_t) + event_byte_size);
-  }
+bool AecDumpFileWriter::IsRoomForNextEvent(size_t event_byte_size) const {
+  int64_t next_message_size = event_byte_size + sizeof(int32_t);
+  return (num_bytes_left_for_log_ < 0) ||
+         (num_bytes_left_for_log_ >= next_message_size);
 }
 
-bool WriteToFileTask::Run() {
+void AecDumpFileWriter::WriteEvent(const audioproc::Event& event) {
   if (!debug_file_->is_open()) {
-    return true;
+    return;
   }
 
-  ProtoString event_string;
-  event_.SerializeToString(&event_string);
-
-  const size_t event_byte_size = event_.ByteSizeLong();
+  const size_t event_byte_size = event.ByteSizeLong();
 
   if (!IsRoomForNextEvent(event_byte_size)) {
+    Flush();
     debug_file_->CloseFile();
-    return true;
+    return;
   }
 
-  UpdateBytesLeft(event_byte_size);
+  if (num_bytes_left_for_log_ >= 0) {
+    num_bytes_left_for_log_ -= (sizeof(int32_t) + event_byte_size);
+  }
 
-  // Write message preceded by its size.
-  if (!debug_file_->Write(&event_byte_size, sizeof(int32_t))) {
-    RTC_NOTREACHED();
+  // Buffer the message preceded by its size.
+  const int32_t size_prefix = static_cast<int32_t>(event_byte_size);
+  buffer_.append(reinterpret_cast<const char*>(&size_prefix),
+                 sizeof(size_prefix));
+  event.AppendToString(&buffer_);
+
+  if (buffer_.size() >= kWriteBatchSizeBytes) {
+    Flush();
   }
-  if (!debug_file_->Write(event_string.data(), event_string.length())) {
+}
+
+void AecDumpFileWriter::Flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+  if (!debug_file_->Write(buffer_.data(), buffer_.size())) {
     RTC_NOTREACHED();
   }
+  buffer_.clear();
+}
+
+WriteToFileTask::WriteToFileTask(AecDumpFileWriter* writer,
+                                 std::atomic<int>* num_bytes_in_flight)
+    : writer_(writer), num_bytes_in_flight_(num_bytes_in_flight) {}
+
+WriteToFileTask::~WriteToFileTask() = default;
+
+audioproc::Event* WriteToFileTask::GetEvent() {
+  return &event_;
+}
+
+bool WriteToFileTask::Run() {
+  writer_->WriteEvent(event_);
+  // The size was cached when the event was posted.
+  *num_bytes_in_flight_ -= event_.GetCachedSize();
   return true;  // Delete task from queue at once.
 }
 
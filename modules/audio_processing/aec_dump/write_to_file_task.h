@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_WRITE_TO_FILE_TASK_H_
 #define MODULES_AUDIO_PROCESSING_AEC_DUMP_WRITE_TO_FILE_TASK_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -19,6 +20,7 @@
 #include "rtc_base/event.h"
 #include "rtc_base/ignore_wundef.h"
 #include "rtc_base/platform_file.h"
+#include "rtc_base/protobuf_utils.h"
 #include "rtc_base/system/file_wrapper.h"
 #include "rtc_base/task_queue.h"
 
@@ -33,24 +35,47 @@ RTC_POP_IGNORING_WUNDEF()
 
 namespace webrtc {
 
-class WriteToFileTask : public rtc::QueuedTask {
+// Writes the events of an AecDump to its file, each preceded by its size.
+// The events are serialized into a buffer which is written once it holds
+// |kWriteBatchSizeBytes|, instead of writing every event separately. Used on
+// the worker queue only.
+class AecDumpFileWriter {
  public:
-  WriteToFileTask(webrtc::FileWrapper* debug_file,
-                  int64_t* num_bytes_left_for_log);
-  ~WriteToFileTask() override;
+  static constexpr size_t kWriteBatchSizeBytes = 64 * 1024;
 
-  audioproc::Event* GetEvent();
+  // A negative |max_log_size_bytes| means no limit.
+  AecDumpFileWriter(webrtc::FileWrapper* debug_file,
+                    int64_t max_log_size_bytes);
+  ~AecDumpFileWriter();
+
+  void WriteEvent(const audioproc::Event& event);
+  // Writes the buffered events.
+  void Flush();
 
  private:
   bool IsRoomForNextEvent(size_t event_byte_size) const;
 
-  void UpdateBytesLeft(size_t event_byte_size);
+  webrtc::FileWrapper* const debug_file_;
+  int64_t num_bytes_left_for_log_;
+  ProtoString buffer_;
+};
+
+class WriteToFileTask : public rtc::QueuedTask {
+ public:
+  // |num_bytes_in_flight| is decreased by the size of the event when it's
+  // been handed to |writer|.
+  WriteToFileTask(AecDumpFileWriter* writer,
+                  std::atomic<int>* num_bytes_in_flight);
+  ~WriteToFileTask() override;
 
+  audioproc::Event* GetEvent();
+
+ private:
   bool Run() override;
 
-  webrtc::FileWrapper* debug_file_;
+  AecDumpFileWriter* const writer_;
+  std::atomic<int>* const num_bytes_in_flight_;
   audioproc::Event event_;
-  int64_t* num_bytes_left_for_log_;
 };
 
 }  // namespace webrtc
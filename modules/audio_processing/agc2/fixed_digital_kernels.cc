@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/fixed_digital_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+namespace {
+
+using MaxAbsValueFunction = float (*)(const float*, size_t);
+using MultiplyByFactorsFunction = void (*)(const float*, size_t, float*);
+
+struct Kernels {
+  MaxAbsValueFunction max_abs_value;
+  MultiplyByFactorsFunction multiply_by_factors;
+};
+
+Kernels SelectKernels() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // x86 CPU detection required, since AVX2 is not part of the baseline.
+  if (WebRtc_GetCPUInfo(kAVX2))
+    return {&MaxAbsValue_AVX2, &MultiplyByFactors_AVX2};
+#if defined(__SSE2__)
+  return {&MaxAbsValue_SSE2, &MultiplyByFactors_SSE2};
+#else
+  if (WebRtc_GetCPUInfo(kSSE2))
+    return {&MaxAbsValue_SSE2, &MultiplyByFactors_SSE2};
+  return {&MaxAbsValue_C, &MultiplyByFactors_C};
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return {&MaxAbsValue_NEON, &MultiplyByFactors_NEON};
+#else
+  return {&MaxAbsValue_C, &MultiplyByFactors_C};
+#endif
+}
+
+const Kernels& GetKernels() {
+  static const Kernels kernels = SelectKernels();
+  return kernels;
+}
+
+}  // namespace
+
+float MaxAbsValue(const float* x, size_t size) {
+  return GetKernels().max_abs_value(x, size);
+}
+
+void MultiplyByFactors(const float* factors, size_t size, float* x) {
+  GetKernels().multiply_by_factors(factors, size, x);
+}
+
+float MaxAbsValue_C(const float* x, size_t size) {
+  float max_abs_value = 0.f;
+  for (size_t i = 0; i < size; ++i)
+    max_abs_value = std::max(max_abs_value, std::abs(x[i]));
+  return max_abs_value;
+}
+
+void MultiplyByFactors_C(const float* factors, size_t size, float* x) {
+  for (size_t i = 0; i < size; ++i)
+    x[i] *= factors[i];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_FIXED_DIGITAL_KERNELS_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_FIXED_DIGITAL_KERNELS_H_
+
+#include <stddef.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Returns the largest absolute value of the |size| samples of |x|, or 0 if
+// |size| is 0. Uses the fastest implementation available on the CPU.
+float MaxAbsValue(const float* x, size_t size);
+
+// Multiplies each of the |size| samples of |x| by the factor at the same
+// index of |factors|. Uses the fastest implementation available on the CPU.
+void MultiplyByFactors(const float* factors, size_t size, float* x);
+
+// The implementations behind the functions above, for tests and benchmarks.
+float MaxAbsValue_C(const float* x, size_t size);
+void MultiplyByFactors_C(const float* factors, size_t size, float* x);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+float MaxAbsValue_SSE2(const float* x, size_t size);
+void MultiplyByFactors_SSE2(const float* factors, size_t size, float* x);
+float MaxAbsValue_AVX2(const float* x, size_t size);
+void MultiplyByFactors_AVX2(const float* factors, size_t size, float* x);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+float MaxAbsValue_NEON(const float* x, size_t size);
+void MultiplyByFactors_NEON(const float* factors, size_t size, float* x);
+#endif
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_FIXED_DIGITAL_KERNELS_H_
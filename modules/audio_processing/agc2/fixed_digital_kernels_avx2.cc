@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/fixed_digital_kernels.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace webrtc {
+
+float MaxAbsValue_AVX2(const float* x, size_t size) {
+  // Clears the sign bits.
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  __m256 max_abs = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    max_abs =
+        _mm256_max_ps(max_abs, _mm256_and_ps(_mm256_loadu_ps(x + i), abs_mask));
+  }
+  __m128 max_abs_128 = _mm_max_ps(_mm256_castps256_ps128(max_abs),
+                                  _mm256_extractf128_ps(max_abs, 1));
+  max_abs_128 =
+      _mm_max_ps(max_abs_128, _mm_movehl_ps(max_abs_128, max_abs_128));
+  max_abs_128 =
+      _mm_max_ss(max_abs_128, _mm_shuffle_ps(max_abs_128, max_abs_128, 1));
+  float max_abs_value = _mm_cvtss_f32(max_abs_128);
+  for (; i < size; ++i)
+    max_abs_value = std::max(max_abs_value, std::abs(x[i]));
+  return max_abs_value;
+}
+
+void MultiplyByFactors_AVX2(const float* factors, size_t size, float* x) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(x + i, _mm256_mul_ps(_mm256_loadu_ps(x + i),
+                                          _mm256_loadu_ps(factors + i)));
+  }
+  for (; i < size; ++i)
+    x[i] *= factors[i];
+}
+
+}  // namespace webrtc
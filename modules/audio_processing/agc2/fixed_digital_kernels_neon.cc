@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/fixed_digital_kernels.h"
+
+#include <arm_neon.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace webrtc {
+
+float MaxAbsValue_NEON(const float* x, size_t size) {
+  float32x4_t max_abs = vdupq_n_f32(0.f);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4)
+    max_abs = vmaxq_f32(max_abs, vabsq_f32(vld1q_f32(x + i)));
+  float32x2_t max_abs_64 =
+      vpmax_f32(vget_low_f32(max_abs), vget_high_f32(max_abs));
+  max_abs_64 = vpmax_f32(max_abs_64, max_abs_64);
+  float max_abs_value = vget_lane_f32(max_abs_64, 0);
+  // Not calling MaxAbsValue_C(), which lives in a target that depends on this
+  // one.
+  for (; i < size; ++i)
+    max_abs_value = std::max(max_abs_value, std::abs(x[i]));
+  return max_abs_value;
+}
+
+void MultiplyByFactors_NEON(const float* factors, size_t size, float* x) {
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4)
+    vst1q_f32(x + i, vmulq_f32(vld1q_f32(x + i), vld1q_f32(factors + i)));
+  for (; i < size; ++i)
+    x[i] *= factors[i];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/fixed_digital_kernels.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace webrtc {
+
+float MaxAbsValue_SSE2(const float* x, size_t size) {
+  // Clears the sign bits.
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  __m128 max_abs = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4)
+    max_abs = _mm_max_ps(max_abs, _mm_and_ps(_mm_loadu_ps(x + i), abs_mask));
+  max_abs = _mm_max_ps(max_abs, _mm_movehl_ps(max_abs, max_abs));
+  max_abs = _mm_max_ss(max_abs, _mm_shuffle_ps(max_abs, max_abs, 1));
+  float max_abs_value = _mm_cvtss_f32(max_abs);
+  // Not calling MaxAbsValue_C(), which lives in a target that depends on this
+  // one.
+  for (; i < size; ++i)
+    max_abs_value = std::max(max_abs_value, std::abs(x[i]));
+  return max_abs_value;
+}
+
+void MultiplyByFactors_SSE2(const float* factors, size_t size, float* x) {
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    _mm_storeu_ps(x + i,
+                  _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(factors + i)));
+  }
+  for (; i < size; ++i)
+    x[i] *= factors[i];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/fixed_digital_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+struct Implementation {
+  const char* name;
+  float (*max_abs_value)(const float*, size_t);
+  void (*multiply_by_factors)(const float*, size_t, float*);
+};
+
+// 48 kHz, 10 ms.
+constexpr size_t kMaxSize = 480;
+
+std::vector<Implementation> Implementations() {
+  std::vector<Implementation> implementations = {
+      {"default", &MaxAbsValue, &MultiplyByFactors},
+      {"C", &MaxAbsValue_C, &MultiplyByFactors_C}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    implementations.push_back(
+        {"SSE2", &MaxAbsValue_SSE2, &MultiplyByFactors_SSE2});
+  }
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    implementations.push_back(
+        {"AVX2", &MaxAbsValue_AVX2, &MultiplyByFactors_AVX2});
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  implementations.push_back(
+      {"NEON", &MaxAbsValue_NEON, &MultiplyByFactors_NEON});
+#endif
+  return implementations;
+}
+
+std::vector<float> RandomSamples(Random* random, size_t size) {
+  std::vector<float> samples(size);
+  for (float& sample : samples)
+    sample = random->Rand(-32768, 32767) + random->Rand<float>();
+  return samples;
+}
+
+}  // namespace
+
+TEST(FixedDigitalKernelsTest, MaxAbsValueMatchesSampleWiseMax) {
+  Random random(42);
+  for (const Implementation& implementation : Implementations()) {
+    SCOPED_TRACE(implementation.name);
+    EXPECT_EQ(0.f, implementation.max_abs_value(nullptr, 0));
+    for (size_t size = 1; size <= kMaxSize; size += size < 20 ? 1 : 37) {
+      std::vector<float> samples = RandomSamples(&random, size);
+      // Puts the peak at every position, to cover each lane and the tail.
+      for (size_t peak = 0; peak < size; ++peak) {
+        std::vector<float> x = samples;
+        x[peak] = peak % 2 ? -40000.f : 40000.f;
+        EXPECT_EQ(40000.f, implementation.max_abs_value(x.data(), size))
+            << size << " samples, peak at " << peak;
+      }
+      float expected = 0.f;
+      for (float sample : samples)
+        expected = std::max(expected, std::abs(sample));
+      EXPECT_EQ(expected, implementation.max_abs_value(samples.data(), size));
+    }
+  }
+}
+
+TEST(FixedDigitalKernelsTest, MultiplyByFactorsMatchesSampleWiseProduct) {
+  Random random(42);
+  for (const Implementation& implementation : Implementations()) {
+    SCOPED_TRACE(implementation.name);
+    for (size_t size = 0; size <= kMaxSize; size += size < 20 ? 1 : 37) {
+      std::vector<float> factors(size);
+      for (float& factor : factors)
+        factor = random.Rand<float>();
+      std::vector<float> x = RandomSamples(&random, kMaxSize);
+      std::vector<float> expected = x;
+      for (size_t i = 0; i < size; ++i)
+        expected[i] *= factors[i];
+
+      implementation.multiply_by_factors(factors.data(), size, x.data());
+      // Also checks that nothing outside of the range was touched.
+      EXPECT_EQ(expected, x) << size << " samples";
+    }
+  }
+}
+
+}  // namespace webrtc
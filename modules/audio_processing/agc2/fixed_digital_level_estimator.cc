@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cmath>
 
+#include "modules/audio_processing/agc2/fixed_digital_kernels.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 
@@ -46,13 +47,10 @@ std::array<float, kSubFramesInFrame> FixedDigitalLevelEstimator::ComputeLevel(
        ++channel_idx) {
     const auto channel = float_frame.channel(channel_idx);
     for (size_t sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
-      for (size_t sample_in_sub_frame = 0;
-           sample_in_sub_frame < samples_in_sub_frame_; ++sample_in_sub_frame) {
-        envelope[sub_frame] =
-            std::max(envelope[sub_frame],
-                     std::abs(channel[sub_frame * samples_in_sub_frame_ +
-                                      sample_in_sub_frame]));
-      }
+      envelope[sub_frame] = std::max(
+          envelope[sub_frame],
+          MaxAbsValue(&channel[sub_frame * samples_in_sub_frame_],
+                      samples_in_sub_frame_));
     }
   }
 
@@ -15,6 +15,7 @@
 #include <cmath>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/fixed_digital_kernels.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 
@@ -74,10 +75,8 @@ void ScaleSamples(rtc::ArrayView<const float> per_sample_scaling_factors,
   const size_t samples_per_channel = signal.samples_per_channel();
   RTC_DCHECK_EQ(samples_per_channel, per_sample_scaling_factors.size());
   for (size_t i = 0; i < signal.num_channels(); ++i) {
-    auto channel = signal.channel(i);
-    for (size_t j = 0; j < samples_per_channel; ++j) {
-      channel[j] *= per_sample_scaling_factors[j];
-    }
+    MultiplyByFactors(per_sample_scaling_factors.data(), samples_per_channel,
+                      signal.channel(i).data());
   }
 }
 
@@ -10,11 +10,22 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 #include <algorithm>
 #include <array>
 #include <cmath>
 
+#include "modules/audio_processing/agc2/rnn_vad/vector_math_avx2.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
 #include "third_party/rnnoise/src/rnn_vad_weights.h"
 
@@ -48,24 +59,115 @@ using rnnoise::RectifiedLinearUnit;
 using rnnoise::SigmoidApproximated;
 using rnnoise::TansigApproximated;
 
+namespace {
+
+std::vector<float> GetScaledParams(rtc::ArrayView<const int8_t> params) {
+  std::vector<float> scaled_params(params.size());
+  std::transform(params.begin(), params.end(), scaled_params.begin(),
+                 [](int8_t x) { return kWeightsScale * x; });
+  return scaled_params;
+}
+
+// Scales and transposes the first |num_rows| rows of the row-major matrix
+// |weights|, so that the weights of each column, i.e. of each output unit,
+// become contiguous.
+std::vector<float> PreprocessWeights(rtc::ArrayView<const int8_t> weights,
+                                     size_t num_rows,
+                                     size_t num_columns) {
+  RTC_DCHECK_LE(num_rows * num_columns, weights.size())
+      << "Mismatching input-output size and weight coefficients array size.";
+  std::vector<float> preprocessed(num_rows * num_columns);
+  for (size_t r = 0; r < num_rows; ++r) {
+    for (size_t c = 0; c < num_columns; ++c) {
+      preprocessed[c * num_rows + r] =
+          kWeightsScale * weights[r * num_columns + c];
+    }
+  }
+  return preprocessed;
+}
+
+float VectorDotProduct(rtc::ArrayView<const float> x,
+                       rtc::ArrayView<const float> y,
+                       Optimization optimization) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  const size_t size = x.size();
+  size_t i = 0;
+  float result = 0.f;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Optimization::kAvx2:
+      return VectorDotProduct_AVX2(x.data(), y.data(), size);
+    case Optimization::kSse2: {
+      __m128 accumulator = _mm_setzero_ps();
+      for (; i + 4 <= size; i += 4) {
+        accumulator = _mm_add_ps(
+            accumulator, _mm_mul_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&y[i])));
+      }
+      float partial_sums[4];
+      _mm_storeu_ps(partial_sums, accumulator);
+      result = partial_sums[0] + partial_sums[1] + partial_sums[2] +
+               partial_sums[3];
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Optimization::kNeon: {
+      float32x4_t accumulator = vdupq_n_f32(0.f);
+      for (; i + 4 <= size; i += 4) {
+        accumulator =
+            vmlaq_f32(accumulator, vld1q_f32(&x[i]), vld1q_f32(&y[i]));
+      }
+      float partial_sums[4];
+      vst1q_f32(partial_sums, accumulator);
+      result = partial_sums[0] + partial_sums[1] + partial_sums[2] +
+               partial_sums[3];
+    } break;
+#endif
+    default:
+      break;
+  }
+  for (; i < size; ++i) {
+    result += x[i] * y[i];
+  }
+  return result;
+}
+
+}  // namespace
+
+Optimization DetectOptimization() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return Optimization::kAvx2;
+  }
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    return Optimization::kSse2;
+  }
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+  return Optimization::kNeon;
+#endif
+
+  return Optimization::kNone;
+}
+
 FullyConnectedLayer::FullyConnectedLayer(
     const size_t input_size,
     const size_t output_size,
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(bias),
-      weights_(weights),
-      activation_function_(activation_function) {
+      bias_(GetScaledParams(bias)),
+      weights_(PreprocessWeights(weights, input_size, output_size)),
+      activation_function_(activation_function),
+      optimization_(optimization) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayersMaxUnits)
       << "Static over-allocation of fully-connected layers output vectors is "
          "not sufficient.";
   RTC_DCHECK_EQ(output_size_, bias_.size())
       << "Mismatching output size and bias terms array size.";
-  RTC_DCHECK_EQ(input_size_ * output_size_, weights_.size())
-      << "Mismatching input-output size and weight coefficients array size.";
 }
 
 FullyConnectedLayer::~FullyConnectedLayer() = default;
@@ -75,16 +177,13 @@ rtc::ArrayView<const float> FullyConnectedLayer::GetOutput() const {
 }
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
+  rtc::ArrayView<const float> weights(weights_);
   for (size_t o = 0; o < output_size_; ++o) {
-    output_[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| change the performance across different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {
-      output_[o] += input[i] * weights_[i * output_size_ + o];
-    }
-    output_[o] = (*activation_function_)(kWeightsScale * output_[o]);
+    output_[o] = (*activation_function_)(
+        bias_[o] + VectorDotProduct(input,
+                                    weights.subview(o * input_size_,
+                                                    input_size_),
+                                    optimization_));
   }
 }
 
@@ -94,23 +193,21 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(bias),
-      weights_(weights),
-      recurrent_weights_(recurrent_weights),
-      activation_function_(activation_function) {
+      bias_(GetScaledParams(bias)),
+      weights_(PreprocessWeights(weights, input_size, 3 * output_size)),
+      recurrent_weights_(
+          PreprocessWeights(recurrent_weights, output_size, 3 * output_size)),
+      activation_function_(activation_function),
+      optimization_(optimization) {
   RTC_DCHECK_LE(output_size_, kRecurrentLayersMaxUnits)
       << "Static over-allocation of recurrent layers state vectors is not "
       << "sufficient.";
   RTC_DCHECK_EQ(3 * output_size_, bias_.size())
       << "Mismatching output size and bias terms array size.";
-  RTC_DCHECK_EQ(3 * input_size_ * output_size_, weights_.size())
-      << "Mismatching input-output size and weight coefficients array size.";
-  RTC_DCHECK_EQ(3 * input_size_ * output_size_, recurrent_weights_.size())
-      << "Mismatching input-output size and recurrent weight coefficients array"
-      << " size.";
   Reset();
 }
 
@@ -125,56 +222,44 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
-  // Stride and offset used to read parameter arrays.
-  const size_t stride = 3 * output_size_;
-  size_t offset = 0;
+  // The weights of the update gates come first, followed by those of the
+  // reset gates and of the output.
+  rtc::ArrayView<const float> weights(weights_);
+  rtc::ArrayView<const float> recurrent_weights(recurrent_weights_);
+  rtc::ArrayView<const float> state(state_.data(), output_size_);
+  // Returns the weighted sum of |input| and |recurrent_input| for output unit
+  // |o| of the gate whose parameters start at |offset|.
+  auto weighted_sum = [&](size_t offset, size_t o,
+                          rtc::ArrayView<const float> recurrent_input) {
+    return bias_[offset + o] +
+           VectorDotProduct(
+               input, weights.subview((offset + o) * input_size_, input_size_),
+               optimization_) +
+           VectorDotProduct(recurrent_input,
+                            recurrent_weights.subview(
+                                (offset + o) * output_size_, output_size_),
+                            optimization_);
+  };
 
   // Compute update gates.
   std::array<float, kRecurrentLayersMaxUnits> update;
   for (size_t o = 0; o < output_size_; ++o) {
-    update[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| and |recurrent_weights_| change the performance across
-    // different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      update[o] += input[i] * weights_[i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {
-      update[o] += state_[s] * recurrent_weights_[s * stride + o];
-    }  // Add state.
-    update[o] = SigmoidApproximated(kWeightsScale * update[o]);
+    update[o] = SigmoidApproximated(weighted_sum(0, o, state));
   }
 
-  // Compute reset gates.
-  offset += output_size_;
-  std::array<float, kRecurrentLayersMaxUnits> reset;
+  // Compute reset gates and apply them to the state.
+  std::array<float, kRecurrentLayersMaxUnits> reset_state;
   for (size_t o = 0; o < output_size_; ++o) {
-    reset[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      reset[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {  // Add state.
-      reset[o] += state_[s] * recurrent_weights_[offset + s * stride + o];
-    }
-    reset[o] = SigmoidApproximated(kWeightsScale * reset[o]);
+    reset_state[o] =
+        state_[o] * SigmoidApproximated(weighted_sum(output_size_, o, state));
   }
 
   // Compute output.
-  offset += output_size_;
   std::array<float, kRecurrentLayersMaxUnits> output;
   for (size_t o = 0; o < output_size_; ++o) {
-    output[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      output[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_;
-         ++s) {  // Add state through reset gates.
-      output[o] +=
-          state_[s] * recurrent_weights_[offset + s * stride + o] * reset[s];
-    }
-    output[o] = (*activation_function_)(kWeightsScale * output[o]);
+    output[o] = (*activation_function_)(weighted_sum(
+        2 * output_size_, o,
+        rtc::ArrayView<const float>(reset_state.data(), output_size_)));
     // Update output through the update gates.
     output[o] = update[o] * state_[o] + (1.f - update[o]) * output[o];
   }
@@ -189,18 +274,21 @@ RnnBasedVad::RnnBasedVad()
                    kInputLayerOutputSize,
                    kInputDenseBias,
                    kInputDenseWeights,
-                   TansigApproximated),
+                   TansigApproximated,
+                   DetectOptimization()),
       hidden_layer_(kInputLayerOutputSize,
                     kHiddenLayerOutputSize,
                     kHiddenGruBias,
                     kHiddenGruWeights,
                     kHiddenGruRecurrentWeights,
-                    RectifiedLinearUnit),
+                    RectifiedLinearUnit,
+                    DetectOptimization()),
       output_layer_(kHiddenLayerOutputSize,
                     kOutputLayerOutputSize,
                     kOutputDenseBias,
                     kOutputDenseWeights,
-                    SigmoidApproximated) {
+                    SigmoidApproximated,
+                    DetectOptimization()) {
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_layer_.output_size(), hidden_layer_.input_size())
       << "The input and the hidden layers sizes do not match.";
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/vector_math_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+namespace rnn_vad {
+
+float VectorDotProduct_AVX2(const float* x, const float* y, size_t size) {
+  __m256 accumulator = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    accumulator =
+        _mm256_add_ps(accumulator, _mm256_mul_ps(_mm256_loadu_ps(x + i),
+                                                 _mm256_loadu_ps(y + i)));
+  }
+  // Add the upper half of the partial sums to the lower half, and the rest
+  // like the SSE2 version.
+  const __m128 half_sums = _mm_add_ps(_mm256_castps256_ps128(accumulator),
+                                      _mm256_extractf128_ps(accumulator, 1));
+  float partial_sums[4];
+  _mm_storeu_ps(partial_sums, half_sums);
+  float result =
+      partial_sums[0] + partial_sums[1] + partial_sums[2] + partial_sums[3];
+  for (; i < size; ++i)
+    result += x[i] * y[i];
+  return result;
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
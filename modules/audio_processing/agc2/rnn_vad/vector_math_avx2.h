@@ -0,0 +1,28 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by rnn.cc. It defines the AVX2 routine for
+// the weighted sums of the fully-connected and recurrent layers.
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATH_AVX2_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATH_AVX2_H_
+
+#include <stddef.h>
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Returns the dot product of the |size| floats at |x| and |y|.
+float VectorDotProduct_AVX2(const float* x, const float* y, size_t size);
+
+}  // namespace rnn_vad
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATH_AVX2_H_
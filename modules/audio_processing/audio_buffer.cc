@@ -49,6 +49,19 @@ AudioBuffer::AudioBuffer(size_t input_num_frames,
                          size_t process_num_frames,
                          size_t num_process_channels,
                          size_t output_num_frames)
+    : AudioBuffer(input_num_frames,
+                  num_input_channels,
+                  process_num_frames,
+                  num_process_channels,
+                  output_num_frames,
+                  false) {}
+
+AudioBuffer::AudioBuffer(size_t input_num_frames,
+                         size_t num_input_channels,
+                         size_t process_num_frames,
+                         size_t num_process_channels,
+                         size_t output_num_frames,
+                         bool float_split_bands)
     : input_num_frames_(input_num_frames),
       num_input_channels_(num_input_channels),
       proc_num_frames_(process_num_frames),
@@ -95,7 +108,8 @@ AudioBuffer::AudioBuffer(size_t input_num_frames,
     split_data_.reset(
         new IFChannelBuffer(proc_num_frames_, num_proc_channels_, num_bands_));
     splitting_filter_.reset(
-        new SplittingFilter(num_proc_channels_, num_bands_, proc_num_frames_));
+        new SplittingFilter(num_proc_channels_, num_bands_, proc_num_frames_,
+                            float_split_bands));
   }
 }
 
@@ -34,6 +34,14 @@ class AudioBuffer {
               size_t process_num_frames,
               size_t num_process_channels,
               size_t output_num_frames);
+  // Same as above, but if |float_split_bands| is set, the bands are split and
+  // merged on the float representation also when there are two of them.
+  AudioBuffer(size_t input_num_frames,
+              size_t num_input_channels,
+              size_t process_num_frames,
+              size_t num_process_channels,
+              size_t output_num_frames,
+              bool float_split_bands);
   virtual ~AudioBuffer();
 
   size_t num_channels() const;
@@ -505,7 +505,8 @@ int AudioProcessingImpl::InitializeLocked() {
         formats_.api_format.reverse_input_stream().num_channels(),
         formats_.render_processing_format.num_frames(),
         formats_.render_processing_format.num_channels(),
-        render_audiobuffer_num_output_frames));
+        render_audiobuffer_num_output_frames,
+        config_.pipeline.float_processing));
     if (formats_.api_format.reverse_input_stream() !=
         formats_.api_format.reverse_output_stream()) {
       render_.render_converter = AudioConverter::Create(
@@ -526,7 +527,8 @@ int AudioProcessingImpl::InitializeLocked() {
                       formats_.api_format.input_stream().num_channels(),
                       capture_nonlocked_.capture_processing_format.num_frames(),
                       formats_.api_format.output_stream().num_channels(),
-                      formats_.api_format.output_stream().num_frames()));
+                      formats_.api_format.output_stream().num_frames(),
+                      config_.pipeline.float_processing));
 
   public_submodules_->echo_cancellation->Initialize(
       proc_sample_rate_hz(), num_reverse_channels(), num_output_channels(),
@@ -662,12 +664,18 @@ int AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
 }
 
 void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
+  const bool pipeline_config_changed =
+      config_.pipeline.float_processing != config.pipeline.float_processing;
   config_ = config;
 
   // Run in a single-threaded manner when applying the settings.
   rtc::CritScope cs_render(&crit_render_);
   rtc::CritScope cs_capture(&crit_capture_);
 
+  if (pipeline_config_changed) {
+    // The audio buffers need to be recreated.
+    InitializeLocked();
+  }
   InitializeLowCutFilter();
 
   RTC_LOG(LS_INFO) << "Highpass filter activated: "
@@ -781,14 +789,12 @@ AudioProcessingImpl::RuntimeSettingEnqueuer::~RuntimeSettingEnqueuer() =
 
 void AudioProcessingImpl::RuntimeSettingEnqueuer::Enqueue(
     RuntimeSetting setting) {
-  size_t remaining_attempts = 10;
-  while (!runtime_settings_.Insert(&setting) && remaining_attempts-- > 0) {
-    RuntimeSetting setting_to_discard;
-    if (runtime_settings_.Remove(&setting_to_discard))
-      RTC_LOG(LS_ERROR)
-          << "The runtime settings queue is full. Oldest setting discarded.";
-  }
-  if (remaining_attempts == 0)
+  // The queue only supports a single producer, so the settings enqueued from
+  // different threads are serialized here. Discarding the oldest setting when
+  // the queue is full would make this a second consumer, so the new setting is
+  // dropped instead.
+  rtc::CritScope cs(&crit_enqueue_);
+  if (!runtime_settings_.Insert(&setting))
     RTC_LOG(LS_ERROR) << "Cannot enqueue a new runtime setting.";
 }
 
@@ -1313,7 +1319,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (config_.residual_echo_detector.enabled) {
     RTC_DCHECK(private_submodules_->echo_detector);
     private_submodules_->echo_detector->AnalyzeCaptureAudio(
-        rtc::ArrayView<const float>(capture_buffer->channels_f()[0],
+        rtc::ArrayView<const float>(capture_buffer->channels_const_f()[0],
                                     capture_buffer->num_frames()));
   }
 
@@ -1801,7 +1807,8 @@ void AudioProcessingImpl::InitializeIntelligibility() {
 void AudioProcessingImpl::InitializeLowCutFilter() {
   if (config_.high_pass_filter.enabled) {
     private_submodules_->low_cut_filter.reset(
-        new LowCutFilter(num_proc_channels(), proc_sample_rate_hz()));
+        new LowCutFilter(num_proc_channels(), proc_sample_rate_hz(),
+                         config_.pipeline.float_processing));
   } else {
     private_submodules_->low_cut_filter.reset();
   }
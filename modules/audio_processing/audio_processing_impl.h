@@ -151,6 +151,7 @@ class AudioProcessingImpl : public AudioProcessing {
     void Enqueue(RuntimeSetting setting);
 
    private:
+    rtc::CriticalSection crit_enqueue_;
     SwapQueue<RuntimeSetting>& runtime_settings_;
   };
   struct ApmPublicSubmodules;
@@ -16,6 +16,8 @@
 #include <vector>
 
 #include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "api/audio/echo_canceller3_factory.h"
 #include "modules/audio_processing/test/test_utils.h"
 #include "rtc_base/atomicops.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -52,7 +54,9 @@ enum class SettingsType {
   kDefaultApmDesktopAndIntelligibilityEnhancer,
   kAllSubmodulesTurnedOff,
   kDefaultApmDesktopWithoutDelayAgnostic,
-  kDefaultApmDesktopWithoutExtendedFilter
+  kDefaultApmDesktopWithoutExtendedFilter,
+  kDefaultApmMobileWithAec3,
+  kDefaultApmMobileWithLowPowerAec3
 };
 
 // Variables related to the audio data and formats.
@@ -125,6 +129,18 @@ struct SimulationConfig {
       }
     }
 
+    const SettingsType aec3_settings[] = {
+        SettingsType::kDefaultApmMobileWithAec3,
+        SettingsType::kDefaultApmMobileWithLowPowerAec3};
+
+    const int aec3_sample_rates[] = {16000, 48000};
+
+    for (auto sample_rate : aec3_sample_rates) {
+      for (auto settings : aec3_settings) {
+        simulation_configs.push_back(SimulationConfig(sample_rate, settings));
+      }
+    }
+
     return simulation_configs;
   }
 
@@ -149,6 +165,12 @@ struct SimulationConfig {
       case SettingsType::kDefaultApmDesktopWithoutExtendedFilter:
         description = "DefaultApmDesktopWithoutExtendedFilter";
         break;
+      case SettingsType::kDefaultApmMobileWithAec3:
+        description = "DefaultApmMobileWithAec3";
+        break;
+      case SettingsType::kDefaultApmMobileWithLowPowerAec3:
+        description = "DefaultApmMobileWithLowPowerAec3";
+        break;
     }
     return description;
   }
@@ -574,6 +596,24 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
         apm_->SetExtraOptions(config);
         break;
       }
+      case SettingsType::kDefaultApmMobileWithAec3:
+      case SettingsType::kDefaultApmMobileWithLowPowerAec3: {
+        const EchoCanceller3Config aec3_config =
+            simulation_config_.simulation_settings ==
+                    SettingsType::kDefaultApmMobileWithLowPowerAec3
+                ? EchoCanceller3Config::CreateLowPowerConfig()
+                : EchoCanceller3Config();
+        apm_.reset(AudioProcessingBuilder()
+                       .SetEchoControlFactory(
+                           std::unique_ptr<EchoControlFactory>(
+                               new EchoCanceller3Factory(aec3_config)))
+                       .Create());
+        ASSERT_TRUE(!!apm_);
+        set_default_mobile_apm_runtime_settings(apm_.get());
+        // AEC3 replaces the mobile echo canceller.
+        ASSERT_EQ(apm_->kNoError, apm_->echo_control_mobile()->Enable(false));
+        break;
+      }
     }
 
     render_thread_state_.reset(new TimedThreadApiProcessor(
@@ -279,6 +279,15 @@ class AudioProcessing : public rtc::RefCountInterface {
       float fixed_gain_db = 0.f;
     } gain_controller2;
 
+    // Splits and merges the frequency bands, and applies the high-pass filter,
+    // on the float representation of the audio. The audio is then only
+    // converted to int16 for the submodules with fixed-point cores, i.e., AECM,
+    // the legacy AGC and the fixed-point noise suppressor. The output is not
+    // bitexact with the default pipeline.
+    struct Pipeline {
+      bool float_processing = false;
+    } pipeline;
+
     // Explicit copy assignment implementation to avoid issues with memory
     // sanitizer complaints in case of self-assignment.
     // TODO(peah): Add buildflag to ensure that this is only included for memory
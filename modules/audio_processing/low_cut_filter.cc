@@ -27,6 +27,28 @@ class LowCutFilter::BiquadFilter {
                 : kFilterCoefficients) {
     std::memset(x_, 0, sizeof(x_));
     std::memset(y_, 0, sizeof(y_));
+    // The coefficients are in Q12.
+    for (size_t i = 0; i < 5; ++i) {
+      ba_float_[i] = ba_[i] / 4096.f;
+    }
+    std::memset(x_float_, 0, sizeof(x_float_));
+    std::memset(y_float_, 0, sizeof(y_float_));
+  }
+
+  // Float version of the filter below, for data in the S16 range.
+  void Process(float* data, size_t length) {
+    const float* const ba = ba_float_;
+    float* x = x_float_;
+    float* y = y_float_;
+    for (size_t i = 0; i < length; i++) {
+      const float tmp = ba[0] * data[i] + ba[1] * x[0] + ba[2] * x[1] +
+                        ba[3] * y[0] + ba[4] * y[1];
+      x[1] = x[0];
+      x[0] = data[i];
+      y[1] = y[0];
+      y[0] = tmp;
+      data[i] = tmp;
+    }
   }
 
   void Process(int16_t* data, size_t length) {
@@ -77,9 +99,15 @@ class LowCutFilter::BiquadFilter {
   const int16_t* const ba_ = nullptr;
   int16_t x_[2];
   int16_t y_[4];
+  float ba_float_[5];
+  float x_float_[2];
+  float y_float_[2];
 };
 
-LowCutFilter::LowCutFilter(size_t channels, int sample_rate_hz) {
+LowCutFilter::LowCutFilter(size_t channels,
+                           int sample_rate_hz,
+                           bool float_processing)
+    : float_processing_(float_processing) {
   filters_.resize(channels);
   for (size_t i = 0; i < channels; i++) {
     filters_[i].reset(new BiquadFilter(sample_rate_hz));
@@ -93,8 +121,13 @@ void LowCutFilter::Process(AudioBuffer* audio) {
   RTC_DCHECK_GE(160, audio->num_frames_per_band());
   RTC_DCHECK_EQ(filters_.size(), audio->num_channels());
   for (size_t i = 0; i < filters_.size(); i++) {
-    filters_[i]->Process(audio->split_bands(i)[kBand0To8kHz],
-                         audio->num_frames_per_band());
+    if (float_processing_) {
+      filters_[i]->Process(audio->split_bands_f(i)[kBand0To8kHz],
+                           audio->num_frames_per_band());
+    } else {
+      filters_[i]->Process(audio->split_bands(i)[kBand0To8kHz],
+                           audio->num_frames_per_band());
+    }
   }
 }
 
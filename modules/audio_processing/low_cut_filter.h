@@ -20,14 +20,17 @@ namespace webrtc {
 
 class AudioBuffer;
 
+// Filters the lowest band of the audio. The filter is run on the int16
+// representation of the audio, unless |float_processing| is set.
 class LowCutFilter {
  public:
-  LowCutFilter(size_t channels, int sample_rate_hz);
+  LowCutFilter(size_t channels, int sample_rate_hz, bool float_processing);
   ~LowCutFilter();
   void Process(AudioBuffer* audio);
 
  private:
   class BiquadFilter;
+  const bool float_processing_;
   std::vector<std::unique_ptr<BiquadFilter>> filters_;
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(LowCutFilter);
 };
@@ -7,6 +7,7 @@
  *  in the file PATENTS.  All contributing project authors may
  *  be found in the AUTHORS file in the root of the source tree.
  */
+#include <cmath>
 #include <vector>
 
 #include "api/array_view.h"
@@ -43,7 +44,7 @@ void RunBitexactnessTest(int sample_rate,
                          const std::vector<float>& input,
                          const std::vector<float>& reference) {
   const StreamConfig stream_config(sample_rate, num_channels, false);
-  LowCutFilter low_cut_filter(num_channels, sample_rate);
+  LowCutFilter low_cut_filter(num_channels, sample_rate, false);
 
   std::vector<float> output;
   const size_t num_frames_to_process =
@@ -677,4 +678,27 @@ TEST(LowCutFilterBitExactnessTest, Stereo16kHzConverged) {
       16000, 2, CreateVector(rtc::ArrayView<const float>(kReferenceInput)),
       CreateVector(rtc::ArrayView<const float>(kReference)));
 }
+
+TEST(LowCutFilterTest, FloatProcessingMatchesFixedPoint) {
+  const StreamConfig stream_config(16000, 1, false);
+  LowCutFilter fixed_filter(1, 16000, false);
+  LowCutFilter float_filter(1, 16000, true);
+  for (size_t frame_no = 0; frame_no < 20; ++frame_no) {
+    std::vector<float> frame_input(stream_config.num_frames());
+    for (size_t k = 0; k < frame_input.size(); ++k) {
+      // A DC offset and a 300 Hz tone.
+      const size_t n = frame_no * frame_input.size() + k;
+      frame_input[k] = 0.2f + 0.5f * std::sin(2.f * 3.14159265f * n * 300.f /
+                                               16000.f);
+    }
+    const std::vector<float> fixed_output =
+        ProcessOneFrame(frame_input, stream_config, &fixed_filter);
+    const std::vector<float> float_output =
+        ProcessOneFrame(frame_input, stream_config, &float_filter);
+    for (size_t k = 0; k < fixed_output.size(); ++k) {
+      EXPECT_NEAR(fixed_output[k], float_output[k], 4.f / 32768.f);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -15,14 +15,54 @@
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+
+// Maximum number of samples in a band for the two-band filter.
+const size_t kMaxTwoBandsFrameLength = 320;
+
+// The all-pass filter coefficients of WebRtcSpl_AnalysisQMF() and
+// WebRtcSpl_SynthesisQMF(), converted from Q16.
+const float kAllPassFilter1[3] = {6418.f / 65536.f, 36982.f / 65536.f,
+                                  57261.f / 65536.f};
+const float kAllPassFilter2[3] = {21333.f / 65536.f, 49062.f / 65536.f,
+                                  63010.f / 65536.f};
+
+// Filters |data| in place with a cascade of the three first order all-pass
+// filters (a + q^-1) / (1 + a * q^-1). The filter state holds the last input
+// and output of each of them.
+void AllPassQmf(const float* filter_coefficients,
+                size_t length,
+                float* filter_state,
+                float* data) {
+  for (size_t i = 0; i < 3; ++i) {
+    const float a = filter_coefficients[i];
+    float x_old = filter_state[2 * i];
+    float y_old = filter_state[2 * i + 1];
+    for (size_t k = 0; k < length; ++k) {
+      const float x = data[k];
+      y_old = x_old + a * (x - y_old);
+      x_old = x;
+      data[k] = y_old;
+    }
+    filter_state[2 * i] = x_old;
+    filter_state[2 * i + 1] = y_old;
+  }
+}
+
+}  // namespace
 
 SplittingFilter::SplittingFilter(size_t num_channels,
                                  size_t num_bands,
-                                 size_t num_frames)
+                                 size_t num_frames,
+                                 bool float_two_bands)
     : num_bands_(num_bands) {
   RTC_CHECK(num_bands_ == 2 || num_bands_ == 3);
   if (num_bands_ == 2) {
-    two_bands_states_.resize(num_channels);
+    if (float_two_bands) {
+      two_bands_float_states_.resize(num_channels);
+    } else {
+      two_bands_states_.resize(num_channels);
+    }
   } else if (num_bands_ == 3) {
     for (size_t i = 0; i < num_channels; ++i) {
       three_band_filter_banks_.push_back(std::unique_ptr<ThreeBandFilterBank>(
@@ -40,7 +80,11 @@ void SplittingFilter::Analysis(const IFChannelBuffer* data,
   RTC_DCHECK_EQ(data->num_frames(),
                 bands->num_frames_per_band() * bands->num_bands());
   if (bands->num_bands() == 2) {
-    TwoBandsAnalysis(data, bands);
+    if (two_bands_float_states_.empty()) {
+      TwoBandsAnalysis(data, bands);
+    } else {
+      TwoBandsFloatAnalysis(data, bands);
+    }
   } else if (bands->num_bands() == 3) {
     ThreeBandsAnalysis(data, bands);
   }
@@ -53,7 +97,11 @@ void SplittingFilter::Synthesis(const IFChannelBuffer* bands,
   RTC_DCHECK_EQ(data->num_frames(),
                 bands->num_frames_per_band() * bands->num_bands());
   if (bands->num_bands() == 2) {
-    TwoBandsSynthesis(bands, data);
+    if (two_bands_float_states_.empty()) {
+      TwoBandsSynthesis(bands, data);
+    } else {
+      TwoBandsFloatSynthesis(bands, data);
+    }
   } else if (bands->num_bands() == 3) {
     ThreeBandsSynthesis(bands, data);
   }
@@ -83,6 +131,62 @@ void SplittingFilter::TwoBandsSynthesis(const IFChannelBuffer* bands,
   }
 }
 
+// Float version of WebRtcSpl_AnalysisQMF().
+void SplittingFilter::TwoBandsFloatAnalysis(const IFChannelBuffer* data,
+                                            IFChannelBuffer* bands) {
+  RTC_DCHECK_EQ(two_bands_float_states_.size(), data->num_channels());
+  const size_t band_length = bands->num_frames_per_band();
+  RTC_DCHECK_LE(band_length, kMaxTwoBandsFrameLength);
+  float odd[kMaxTwoBandsFrameLength];
+  float even[kMaxTwoBandsFrameLength];
+  for (size_t i = 0; i < two_bands_float_states_.size(); ++i) {
+    const float* in = data->fbuf_const()->channels()[i];
+    for (size_t k = 0; k < band_length; ++k) {
+      even[k] = in[2 * k];
+      odd[k] = in[2 * k + 1];
+    }
+    AllPassQmf(kAllPassFilter1, band_length,
+               two_bands_float_states_[i].analysis_state1, odd);
+    AllPassQmf(kAllPassFilter2, band_length,
+               two_bands_float_states_[i].analysis_state2, even);
+
+    float* low_band = bands->fbuf()->channels(0)[i];
+    float* high_band = bands->fbuf()->channels(1)[i];
+    for (size_t k = 0; k < band_length; ++k) {
+      low_band[k] = 0.5f * (odd[k] + even[k]);
+      high_band[k] = 0.5f * (odd[k] - even[k]);
+    }
+  }
+}
+
+// Float version of WebRtcSpl_SynthesisQMF().
+void SplittingFilter::TwoBandsFloatSynthesis(const IFChannelBuffer* bands,
+                                             IFChannelBuffer* data) {
+  RTC_DCHECK_LE(data->num_channels(), two_bands_float_states_.size());
+  const size_t band_length = bands->num_frames_per_band();
+  RTC_DCHECK_LE(band_length, kMaxTwoBandsFrameLength);
+  float sum[kMaxTwoBandsFrameLength];
+  float difference[kMaxTwoBandsFrameLength];
+  for (size_t i = 0; i < data->num_channels(); ++i) {
+    const float* low_band = bands->fbuf_const()->channels(0)[i];
+    const float* high_band = bands->fbuf_const()->channels(1)[i];
+    for (size_t k = 0; k < band_length; ++k) {
+      sum[k] = low_band[k] + high_band[k];
+      difference[k] = low_band[k] - high_band[k];
+    }
+    AllPassQmf(kAllPassFilter2, band_length,
+               two_bands_float_states_[i].synthesis_state1, sum);
+    AllPassQmf(kAllPassFilter1, band_length,
+               two_bands_float_states_[i].synthesis_state2, difference);
+
+    float* out = data->fbuf()->channels()[i];
+    for (size_t k = 0; k < band_length; ++k) {
+      out[2 * k] = difference[k];
+      out[2 * k + 1] = sum[k];
+    }
+  }
+}
+
 void SplittingFilter::ThreeBandsAnalysis(const IFChannelBuffer* data,
                                          IFChannelBuffer* bands) {
   RTC_DCHECK_EQ(three_band_filter_banks_.size(), data->num_channels());
@@ -36,6 +36,21 @@ struct TwoBandsStates {
   int synthesis_state2[kStateSize];
 };
 
+struct TwoBandsFloatStates {
+  TwoBandsFloatStates() {
+    memset(analysis_state1, 0, sizeof(analysis_state1));
+    memset(analysis_state2, 0, sizeof(analysis_state2));
+    memset(synthesis_state1, 0, sizeof(synthesis_state1));
+    memset(synthesis_state2, 0, sizeof(synthesis_state2));
+  }
+
+  static const int kStateSize = 6;
+  float analysis_state1[kStateSize];
+  float analysis_state2[kStateSize];
+  float synthesis_state1[kStateSize];
+  float synthesis_state2[kStateSize];
+};
+
 // Splitting filter which is able to split into and merge from 2 or 3 frequency
 // bands. The number of channels needs to be provided at construction time.
 //
@@ -43,9 +58,16 @@ struct TwoBandsStates {
 // to merge these bands again. The input and output signals are contained in
 // IFChannelBuffers and for the different bands an array of IFChannelBuffers is
 // used.
+//
+// The two-band filter is run on the int16 representation of the signal, unless
+// |float_two_bands| is set. The three-band filter is always run on the float
+// representation.
 class SplittingFilter {
  public:
-  SplittingFilter(size_t num_channels, size_t num_bands, size_t num_frames);
+  SplittingFilter(size_t num_channels,
+                  size_t num_bands,
+                  size_t num_frames,
+                  bool float_two_bands);
   ~SplittingFilter();
 
   void Analysis(const IFChannelBuffer* data, IFChannelBuffer* bands);
@@ -55,12 +77,17 @@ class SplittingFilter {
   // Two-band analysis and synthesis work for 640 samples or less.
   void TwoBandsAnalysis(const IFChannelBuffer* data, IFChannelBuffer* bands);
   void TwoBandsSynthesis(const IFChannelBuffer* bands, IFChannelBuffer* data);
+  void TwoBandsFloatAnalysis(const IFChannelBuffer* data,
+                             IFChannelBuffer* bands);
+  void TwoBandsFloatSynthesis(const IFChannelBuffer* bands,
+                              IFChannelBuffer* data);
   void ThreeBandsAnalysis(const IFChannelBuffer* data, IFChannelBuffer* bands);
   void ThreeBandsSynthesis(const IFChannelBuffer* bands, IFChannelBuffer* data);
   void InitBuffers();
 
   const size_t num_bands_;
   std::vector<TwoBandsStates> two_bands_states_;
+  std::vector<TwoBandsFloatStates> two_bands_float_states_;
   std::vector<std::unique_ptr<ThreeBandFilterBank>> three_band_filter_banks_;
 };
 
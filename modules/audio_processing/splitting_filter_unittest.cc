@@ -21,10 +21,115 @@ namespace webrtc {
 namespace {
 
 const size_t kSamplesPer16kHzChannel = 160;
+const size_t kSamplesPer32kHzChannel = 320;
 const size_t kSamplesPer48kHzChannel = 480;
 
+// Same as SplitsIntoThreeBandsAndReconstructs below, but for two bands.
+void RunTwoBandsTest(bool float_two_bands) {
+  static const int kChannels = 1;
+  static const int kSampleRateHz = 32000;
+  static const size_t kNumBands = 2;
+  static const int kFrequenciesHz[kNumBands] = {1000, 12000};
+  static const float kAmplitude = 8192.f;
+  static const size_t kChunks = 8;
+  SplittingFilter splitting_filter(kChannels, kNumBands,
+                                   kSamplesPer32kHzChannel, float_two_bands);
+  IFChannelBuffer in_data(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  IFChannelBuffer bands(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  IFChannelBuffer out_data(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  for (size_t i = 0; i < kChunks; ++i) {
+    bool is_present[kNumBands];
+    memset(in_data.fbuf()->channels()[0], 0,
+           kSamplesPer32kHzChannel * sizeof(in_data.fbuf()->channels()[0][0]));
+    for (size_t j = 0; j < kNumBands; ++j) {
+      is_present[j] = i & (static_cast<size_t>(1) << j);
+      float amplitude = is_present[j] ? kAmplitude : 0.f;
+      for (size_t k = 0; k < kSamplesPer32kHzChannel; ++k) {
+        in_data.fbuf()->channels()[0][k] +=
+            amplitude * sin(2.f * M_PI * kFrequenciesHz[j] *
+                            (i * kSamplesPer32kHzChannel + k) / kSampleRateHz);
+      }
+    }
+    splitting_filter.Analysis(&in_data, &bands);
+    for (size_t j = 0; j < kNumBands; ++j) {
+      float energy = 0.f;
+      for (size_t k = 0; k < kSamplesPer16kHzChannel; ++k) {
+        energy += bands.fbuf_const()->channels(j)[0][k] *
+                  bands.fbuf_const()->channels(j)[0][k];
+      }
+      energy /= kSamplesPer16kHzChannel;
+      if (is_present[j]) {
+        EXPECT_GT(energy, kAmplitude * kAmplitude / 4);
+      } else {
+        EXPECT_LT(energy, kAmplitude * kAmplitude / 4);
+      }
+    }
+    splitting_filter.Synthesis(&bands, &out_data);
+    float xcorr = 0.f;
+    for (size_t delay = 0; delay < kSamplesPer32kHzChannel; ++delay) {
+      float tmpcorr = 0.f;
+      for (size_t j = delay; j < kSamplesPer32kHzChannel; ++j) {
+        tmpcorr += in_data.fbuf_const()->channels()[0][j - delay] *
+                   out_data.fbuf_const()->channels()[0][j];
+      }
+      tmpcorr /= kSamplesPer32kHzChannel;
+      if (tmpcorr > xcorr) {
+        xcorr = tmpcorr;
+      }
+    }
+    if (is_present[0] || is_present[1]) {
+      EXPECT_GT(xcorr, kAmplitude * kAmplitude / 4);
+    }
+  }
+}
+
 }  // namespace
 
+TEST(SplittingFilterTest, SplitsIntoTwoBandsAndReconstructs) {
+  RunTwoBandsTest(false);
+}
+
+TEST(SplittingFilterTest, SplitsIntoTwoBandsAndReconstructsInFloat) {
+  RunTwoBandsTest(true);
+}
+
+// Checks that the float two-band filter is the float version of the fixed-point
+// one.
+TEST(SplittingFilterTest, FloatTwoBandsMatchFixedPoint) {
+  static const int kChannels = 1;
+  static const size_t kNumBands = 2;
+  SplittingFilter fixed_filter(kChannels, kNumBands, kSamplesPer32kHzChannel,
+                               false);
+  SplittingFilter float_filter(kChannels, kNumBands, kSamplesPer32kHzChannel,
+                               true);
+  IFChannelBuffer in_data(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  IFChannelBuffer fixed_bands(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  IFChannelBuffer float_bands(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  IFChannelBuffer fixed_out(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  IFChannelBuffer float_out(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  for (size_t i = 0; i < 10; ++i) {
+    for (size_t k = 0; k < kSamplesPer32kHzChannel; ++k) {
+      in_data.fbuf()->channels()[0][k] = static_cast<int16_t>(
+          8000.f * sin(0.05f * (i * kSamplesPer32kHzChannel + k)) +
+          4000.f * sin(2.9f * (i * kSamplesPer32kHzChannel + k)));
+    }
+    fixed_filter.Analysis(&in_data, &fixed_bands);
+    float_filter.Analysis(&in_data, &float_bands);
+    for (size_t j = 0; j < kNumBands; ++j) {
+      for (size_t k = 0; k < kSamplesPer16kHzChannel; ++k) {
+        EXPECT_NEAR(fixed_bands.fbuf_const()->channels(j)[0][k],
+                    float_bands.fbuf_const()->channels(j)[0][k], 2.f);
+      }
+    }
+    fixed_filter.Synthesis(&fixed_bands, &fixed_out);
+    float_filter.Synthesis(&float_bands, &float_out);
+    for (size_t k = 0; k < kSamplesPer32kHzChannel; ++k) {
+      EXPECT_NEAR(fixed_out.fbuf_const()->channels()[0][k],
+                  float_out.fbuf_const()->channels()[0][k], 4.f);
+    }
+  }
+}
+
 // Generates a signal from presence or absence of sine waves of different
 // frequencies.
 // Splits into 3 bands and checks their presence or absence.
@@ -40,7 +145,7 @@ TEST(SplittingFilterTest, SplitsIntoThreeBandsAndReconstructs) {
   static const float kAmplitude = 8192.f;
   static const size_t kChunks = 8;
   SplittingFilter splitting_filter(kChannels, kNumBands,
-                                   kSamplesPer48kHzChannel);
+                                   kSamplesPer48kHzChannel, false);
   IFChannelBuffer in_data(kSamplesPer48kHzChannel, kChannels, kNumBands);
   IFChannelBuffer bands(kSamplesPer48kHzChannel, kChannels, kNumBands);
   IFChannelBuffer out_data(kSamplesPer48kHzChannel, kChannels, kNumBands);
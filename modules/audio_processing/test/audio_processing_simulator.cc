@@ -181,6 +181,8 @@ EchoCanceller3Config ParseAec3Parameters(const std::string& filename) {
               &cfg.delay.hysteresis_limit_2_blocks);
     ReadParam(section, "skew_hysteresis_blocks",
               &cfg.delay.skew_hysteresis_blocks);
+    ReadParam(section, "estimation_interval_blocks",
+              &cfg.delay.estimation_interval_blocks);
   }
 
   if (rtc::GetValueFromJsonObject(root, "filter", &section)) {
@@ -188,6 +190,7 @@ EchoCanceller3Config ParseAec3Parameters(const std::string& filename) {
     ReadParam(section, "shadow", &cfg.filter.shadow);
     ReadParam(section, "main_initial", &cfg.filter.main_initial);
     ReadParam(section, "shadow_initial", &cfg.filter.shadow_initial);
+    ReadParam(section, "use_shadow_filter", &cfg.filter.use_shadow_filter);
   }
 
   if (rtc::GetValueFromJsonObject(root, "erle", &section)) {
@@ -205,6 +208,8 @@ EchoCanceller3Config ParseAec3Parameters(const std::string& filename) {
               &cfg.ep_strength.reverb_based_on_render);
     ReadParam(section, "echo_can_saturate", &cfg.ep_strength.echo_can_saturate);
     ReadParam(section, "bounded_erl", &cfg.ep_strength.bounded_erl);
+    ReadParam(section, "estimate_reverb_model",
+              &cfg.ep_strength.estimate_reverb_model);
   }
 
   if (rtc::GetValueFromJsonObject(root, "gain_mask", &section)) {
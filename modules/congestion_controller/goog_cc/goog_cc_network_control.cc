@@ -84,10 +84,12 @@ static void ClampBitrates(int64_t* bitrate_bps,
     *bitrate_bps = std::max(*min_bitrate_bps, *bitrate_bps);
 }
 
-std::vector<PacketFeedback> ReceivedPacketsFeedbackAsRtp(
-    const TransportPacketsFeedback report) {
-  std::vector<PacketFeedback> packet_feedback_vector;
-  for (auto& fb : report.PacketsWithFeedback()) {
+// Fills |packet_feedback_vector|, reusing its storage.
+void ReceivedPacketsFeedbackAsRtp(
+    const TransportPacketsFeedback& report,
+    std::vector<PacketFeedback>* packet_feedback_vector) {
+  packet_feedback_vector->clear();
+  for (const PacketResult& fb : report.packet_feedbacks) {
     if (fb.receive_time.IsFinite()) {
       PacketFeedback pf(fb.receive_time.ms(), 0);
       pf.creation_time_ms = report.feedback_time.ms();
@@ -98,10 +100,9 @@ std::vector<PacketFeedback> ReceivedPacketsFeedbackAsRtp(
       } else {
         pf.send_time_ms = PacketFeedback::kNoSendTime;
       }
-      packet_feedback_vector.push_back(pf);
+      packet_feedback_vector->push_back(pf);
     }
   }
-  return packet_feedback_vector;
 }
 
 int64_t GetBpsOrDefault(const absl::optional<DataRate>& rate,
@@ -325,7 +326,14 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     TransportPacketsFeedback report) {
   TimeDelta feedback_max_rtt = TimeDelta::MinusInfinity();
   Timestamp max_recv_time = Timestamp::ms(0);
-  for (const auto& packet_feedback : report.ReceivedWithSendInfo()) {
+  int lost_packets = 0;
+  for (const PacketResult& packet_feedback : report.packet_feedbacks) {
+    if (packet_feedback.receive_time.IsInfinite()) {
+      ++lost_packets;
+      continue;
+    }
+    if (!packet_feedback.sent_packet)
+      continue;
     TimeDelta rtt =
         report.feedback_time - packet_feedback.sent_packet->send_time;
     // max() is used to account for feedback being delayed by the
@@ -350,7 +358,11 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     }
 
     TimeDelta feedback_min_rtt = TimeDelta::PlusInfinity();
-    for (const auto& packet_feedback : report.ReceivedWithSendInfo()) {
+    for (const PacketResult& packet_feedback : report.packet_feedbacks) {
+      if (packet_feedback.receive_time.IsInfinite() ||
+          !packet_feedback.sent_packet) {
+        continue;
+      }
       TimeDelta pending_time = packet_feedback.receive_time - max_recv_time;
       TimeDelta rtt = report.feedback_time -
                       packet_feedback.sent_packet->send_time - pending_time;
@@ -362,12 +374,8 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
                                        report.feedback_time.ms());
     }
 
-    expected_packets_since_last_loss_update_ +=
-        report.PacketsWithFeedback().size();
-    for (const auto& packet_feedback : report.PacketsWithFeedback()) {
-      lost_packets_since_last_loss_update_ +=
-          packet_feedback.receive_time.IsFinite() ? 0 : 1;
-    }
+    expected_packets_since_last_loss_update_ += report.packet_feedbacks.size();
+    lost_packets_since_last_loss_update_ += lost_packets;
     if (report.feedback_time > next_loss_update_) {
       next_loss_update_ += kLossUpdateInterval;
       bandwidth_estimation_->UpdatePacketsLost(
@@ -378,8 +386,7 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     }
   }
 
-  std::vector<PacketFeedback> received_feedback_vector =
-      ReceivedPacketsFeedbackAsRtp(report);
+  ReceivedPacketsFeedbackAsRtp(report, &received_feedback_vector_);
 
   absl::optional<int64_t> alr_start_time =
       alr_detector_->GetApplicationLimitedRegionStartTime();
@@ -391,10 +398,10 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
   }
   previously_in_alr = alr_start_time.has_value();
   acknowledged_bitrate_estimator_->IncomingPacketFeedbackVector(
-      received_feedback_vector);
+      received_feedback_vector_);
   DelayBasedBwe::Result result;
   result = delay_based_bwe_->IncomingPacketFeedbackVector(
-      received_feedback_vector, acknowledged_bitrate_estimator_->bitrate_bps(),
+      received_feedback_vector_, acknowledged_bitrate_estimator_->bitrate_bps(),
       report.feedback_time.ms());
   NetworkControlUpdate update;
   if (result.updated) {
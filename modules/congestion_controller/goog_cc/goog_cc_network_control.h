@@ -82,6 +82,9 @@ class GoogCcNetworkController : public NetworkControllerInterface {
 
   std::deque<int64_t> feedback_max_rtts_;
   absl::optional<int64_t> min_feedback_max_rtt_ms_;
+  // The received packets of the feedback being processed, kept to avoid
+  // allocating for every feedback.
+  std::vector<PacketFeedback> received_feedback_vector_;
 
   DataRate last_bandwidth_;
   absl::optional<TargetTransferRate> last_target_rate_;
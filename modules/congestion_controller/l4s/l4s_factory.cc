@@ -0,0 +1,31 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/l4s/l4s_factory.h"
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "modules/congestion_controller/l4s/l4s_network_controller.h"
+
+namespace webrtc {
+
+L4sNetworkControllerFactory::L4sNetworkControllerFactory() {}
+
+std::unique_ptr<NetworkControllerInterface> L4sNetworkControllerFactory::Create(
+    NetworkControllerConfig config) {
+  return absl::make_unique<L4sNetworkController>(config);
+}
+
+TimeDelta L4sNetworkControllerFactory::GetProcessInterval() const {
+  // Everything is driven by feedback.
+  return TimeDelta::PlusInfinity();
+}
+
+}  // namespace webrtc
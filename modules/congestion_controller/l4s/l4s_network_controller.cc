@@ -0,0 +1,293 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/l4s/l4s_network_controller.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
+
+namespace webrtc {
+namespace {
+const char kL4sConfigTrial[] = "WebRTC-L4sCongestionControl";
+
+// The minimum one way delay is taken over this window, long enough to see an
+// empty queue now and then, short enough to follow route and clock changes.
+constexpr TimeDelta kBaseDelayWindow = TimeDelta::Seconds<10>();
+// Used until the first feedback arrives.
+constexpr TimeDelta kDefaultRtt = TimeDelta::Millis<100>();
+// The rate is never reduced below this, so that there is always some feedback
+// to recover from.
+constexpr DataRate kMinRate = DataRate::KilobitsPerSec<30>();
+constexpr DataRate kDefaultStartRate = DataRate::KilobitsPerSec<300>();
+}  // namespace
+
+L4sNetworkController::L4sControllerConfig::L4sControllerConfig(
+    std::string field_trial)
+    : queue_delay_threshold("threshold", TimeDelta::ms(20)),
+      alpha_gain("alpha_gain", 1.0 / 16),
+      increase_per_round("increase", DataSize::bytes(1200)),
+      startup_gain("startup_gain", 1.5),
+      max_acked_rate_factor("max_acked_factor", 2.0),
+      pacing_factor("pacing_factor", 1.5) {
+  ParseFieldTrial(
+      {
+          &alpha_gain,
+          &increase_per_round,
+          &max_acked_rate_factor,
+          &pacing_factor,
+          &queue_delay_threshold,
+          &startup_gain,
+      },
+      field_trial);
+}
+L4sNetworkController::L4sControllerConfig::L4sControllerConfig(
+    const L4sControllerConfig&) = default;
+L4sNetworkController::L4sControllerConfig::~L4sControllerConfig() = default;
+L4sNetworkController::L4sControllerConfig
+L4sNetworkController::L4sControllerConfig::FromTrial() {
+  return L4sControllerConfig(
+      webrtc::field_trial::FindFullName(kL4sConfigTrial));
+}
+
+L4sNetworkController::L4sNetworkController(NetworkControllerConfig config)
+    : config_(L4sControllerConfig::FromTrial()),
+      min_rate_(kMinRate),
+      max_rate_(DataRate::Infinity()),
+      target_rate_(config.starting_bandwidth.IsFinite()
+                       ? config.starting_bandwidth
+                       : kDefaultStartRate),
+      pacing_factor_(config.stream_based_config.pacing_factor.value_or(
+          config_.pacing_factor)) {
+  ApplyConstraints(config.constraints);
+}
+
+L4sNetworkController::~L4sNetworkController() = default;
+
+NetworkControlUpdate L4sNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate L4sNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  // The queues and delays of the old route say nothing about the new one.
+  if (msg.starting_rate)
+    target_rate_ = *msg.starting_rate;
+  ApplyConstraints(msg.constraints);
+  in_startup_ = true;
+  alpha_ = 0;
+  rtt_ = TimeDelta::PlusInfinity();
+  base_delays_.clear();
+  round_end_sequence_number_ = last_sent_sequence_number_;
+  ResetRound();
+  return CreateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate L4sNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  if (first_update_sent_)
+    return NetworkControlUpdate();
+  first_update_sent_ = true;
+  return CreateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate L4sNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate L4sNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate msg) {
+  // Only used until the feedback gives a round trip time.
+  if (rtt_.IsInfinite() && msg.round_trip_time.IsFinite())
+    rtt_ = msg.round_trip_time;
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate L4sNetworkController::OnSentPacket(SentPacket msg) {
+  last_sent_sequence_number_ = msg.sequence_number;
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate L4sNetworkController::OnStreamsConfig(StreamsConfig msg) {
+  if (!msg.pacing_factor || *msg.pacing_factor == pacing_factor_)
+    return NetworkControlUpdate();
+  pacing_factor_ = *msg.pacing_factor;
+  return CreateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate L4sNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints msg) {
+  ApplyConstraints(msg);
+  return CreateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate L4sNetworkController::OnTransportLossReport(
+    TransportLossReport msg) {
+  // Losses are seen in the per packet feedback.
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate L4sNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback msg) {
+  bool round_ended = false;
+  for (const PacketResult& packet : msg.packet_feedbacks) {
+    if (!packet.sent_packet)
+      continue;
+    const SentPacket& sent = *packet.sent_packet;
+    round_bytes_ += sent.size;
+    ++round_packets_;
+    if (packet.receive_time.IsInfinite()) {
+      // Lost packets count as marked, like with L4S AQMs that drop when
+      // overloaded.
+      ++round_lost_packets_;
+      round_marked_bytes_ += sent.size;
+    } else {
+      TimeDelta rtt = msg.feedback_time - sent.send_time;
+      rtt_ = rtt_.IsInfinite() ? rtt : 0.875 * rtt_ + 0.125 * rtt;
+      TimeDelta one_way_delay = packet.receive_time - sent.send_time;
+      TimeDelta base_delay = UpdateBaseDelay(msg.feedback_time, one_way_delay);
+      if (packet.ecn_ce ||
+          one_way_delay - base_delay > config_.queue_delay_threshold) {
+        round_marked_bytes_ += sent.size;
+      }
+      round_received_bytes_ += sent.size;
+      if (!round_first_receive_time_ ||
+          packet.receive_time < *round_first_receive_time_) {
+        round_first_receive_time_ = packet.receive_time;
+      }
+      if (!round_last_receive_time_ ||
+          packet.receive_time > *round_last_receive_time_) {
+        round_last_receive_time_ = packet.receive_time;
+      }
+    }
+    if (sent.sequence_number > round_end_sequence_number_)
+      round_ended = true;
+  }
+  if (!round_ended)
+    return NetworkControlUpdate();
+  EndRound();
+  return CreateUpdate(msg.feedback_time);
+}
+
+void L4sNetworkController::ApplyConstraints(
+    const TargetRateConstraints& constraints) {
+  if (constraints.min_data_rate)
+    min_rate_ = std::max(*constraints.min_data_rate, kMinRate);
+  if (constraints.max_data_rate)
+    max_rate_ = *constraints.max_data_rate;
+  if (max_rate_ < min_rate_)
+    max_rate_ = min_rate_;
+  target_rate_ = std::min(std::max(target_rate_, min_rate_), max_rate_);
+}
+
+void L4sNetworkController::ResetRound() {
+  round_bytes_ = DataSize::Zero();
+  round_marked_bytes_ = DataSize::Zero();
+  round_received_bytes_ = DataSize::Zero();
+  round_packets_ = 0;
+  round_lost_packets_ = 0;
+  round_first_receive_time_.reset();
+  round_last_receive_time_.reset();
+}
+
+void L4sNetworkController::EndRound() {
+  RTC_DCHECK_GT(round_packets_, 0);
+  double marked_fraction = round_bytes_ > DataSize::Zero()
+                               ? round_marked_bytes_ / round_bytes_
+                               : 0;
+  alpha_ = (1 - config_.alpha_gain) * alpha_ +
+           config_.alpha_gain * marked_fraction;
+  loss_rate_ratio_ = static_cast<float>(round_lost_packets_) / round_packets_;
+
+  // The rate at which the packets of the round were received.
+  absl::optional<DataRate> acked_rate;
+  if (round_first_receive_time_ &&
+      *round_last_receive_time_ > *round_first_receive_time_) {
+    acked_rate = round_received_bytes_ /
+                 (*round_last_receive_time_ - *round_first_receive_time_);
+  }
+
+  if (round_marked_bytes_ > DataSize::Zero()) {
+    if (in_startup_) {
+      // |alpha| hasn't had the time to converge, so start it from the marked
+      // fraction of the round that ends startup, like DCTCP starts it high.
+      alpha_ = std::max(alpha_, marked_fraction);
+      in_startup_ = false;
+    }
+    target_rate_ = target_rate_ * (1 - alpha_ / 2);
+    // With a queue at the bottleneck, the packets arrive at its rate. This
+    // handles a sudden drop of the capacity, which a small |alpha| after a
+    // long time without marks would take many rounds to follow.
+    if (acked_rate)
+      target_rate_ = std::min(target_rate_, *acked_rate);
+  } else {
+    DataRate increased_rate = target_rate_;
+    if (in_startup_) {
+      increased_rate = target_rate_ * config_.startup_gain;
+    } else {
+      TimeDelta rtt = rtt_.IsFinite() ? rtt_ : kDefaultRtt;
+      DataRate increase = config_.increase_per_round.Get() / rtt;
+      increased_rate = DataRate::bps(target_rate_.bps() + increase.bps());
+    }
+    // Don't grow further while the sender doesn't use the rate it has, as
+    // there is nothing to learn about the bottleneck from that.
+    if (acked_rate) {
+      increased_rate = std::min(
+          increased_rate,
+          std::max(target_rate_, *acked_rate * config_.max_acked_rate_factor));
+    }
+    target_rate_ = increased_rate;
+  }
+  target_rate_ = std::min(std::max(target_rate_, min_rate_), max_rate_);
+
+  round_end_sequence_number_ = last_sent_sequence_number_;
+  ResetRound();
+}
+
+TimeDelta L4sNetworkController::UpdateBaseDelay(Timestamp at_time,
+                                                TimeDelta one_way_delay) {
+  while (!base_delays_.empty() && base_delays_.back().second >= one_way_delay)
+    base_delays_.pop_back();
+  base_delays_.emplace_back(at_time, one_way_delay);
+  while (at_time - base_delays_.front().first > kBaseDelayWindow)
+    base_delays_.pop_front();
+  return base_delays_.front().second;
+}
+
+NetworkControlUpdate L4sNetworkController::CreateUpdate(
+    Timestamp at_time) const {
+  NetworkControlUpdate update;
+  TargetTransferRate target_rate;
+  target_rate.at_time = at_time;
+  target_rate.target_rate = target_rate_;
+  target_rate.network_estimate.at_time = at_time;
+  target_rate.network_estimate.bandwidth = target_rate_;
+  target_rate.network_estimate.round_trip_time =
+      rtt_.IsFinite() ? rtt_ : kDefaultRtt;
+  target_rate.network_estimate.bwe_period =
+      target_rate.network_estimate.round_trip_time;
+  target_rate.network_estimate.loss_rate_ratio = loss_rate_ratio_;
+  update.target_rate = target_rate;
+
+  PacerConfig pacer_config;
+  pacer_config.at_time = at_time;
+  pacer_config.time_window = TimeDelta::seconds(1);
+  pacer_config.data_window =
+      target_rate_ * pacing_factor_ * pacer_config.time_window;
+  pacer_config.pad_window = DataSize::Zero();
+  update.pacer_config = pacer_config;
+  return update;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Scalable congestion control for L4S (Low Latency, Low Loss, Scalable
+// throughput) networks, in the spirit of DCTCP and TCP Prague.
+
+#ifndef MODULES_CONGESTION_CONTROLLER_L4S_L4S_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_L4S_L4S_NETWORK_CONTROLLER_H_
+
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
+
+namespace webrtc {
+
+// L4sNetworkController reacts to the fraction of packets that were marked
+// congested rather than to loss or to a delay trend. Once per round trip the
+// marked fraction is folded into a moving average |alpha|, and if any packet
+// of the round was marked the target rate is reduced by alpha / 2; otherwise
+// it grows by one segment per round trip. Since the reduction is proportional
+// to the marking, the queue oscillates tightly around the marking threshold of
+// the bottleneck instead of filling it like classic loss based control.
+//
+// A packet counts as marked if it was received with ECN-CE, if it was lost, or
+// if its queueing delay, its one way delay above the minimum of the last
+// seconds, exceeds a threshold. The latter lets the controller keep queues
+// short on paths without ECN marking and with feedback that can't report it.
+class L4sNetworkController : public NetworkControllerInterface {
+ public:
+  struct L4sControllerConfig {
+    // Queueing delay above which a packet is treated as marked. Well above
+    // the threshold of L4S AQMs, as the delay is measured end to end and
+    // jitters by a packet time or more at video rates.
+    FieldTrialParameter<TimeDelta> queue_delay_threshold;
+    // Weight of the marked fraction of the last round in |alpha|.
+    FieldTrialParameter<double> alpha_gain;
+    // Rate increase per round trip without marks, in segments.
+    FieldTrialParameter<DataSize> increase_per_round;
+    // Rate increase factor per round trip until the first mark.
+    FieldTrialParameter<double> startup_gain;
+    // Limits the target rate to this factor of the acknowledged rate, so the
+    // rate doesn't grow without bound while the encoder undershoots.
+    FieldTrialParameter<double> max_acked_rate_factor;
+    FieldTrialParameter<double> pacing_factor;
+
+    explicit L4sControllerConfig(std::string field_trial);
+    L4sControllerConfig(const L4sControllerConfig&);
+    ~L4sControllerConfig();
+    static L4sControllerConfig FromTrial();
+  };
+
+  explicit L4sNetworkController(NetworkControllerConfig config);
+  ~L4sNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+
+  double alpha() const { return alpha_; }
+
+ private:
+  void ApplyConstraints(const TargetRateConstraints& constraints);
+  void ResetRound();
+  void EndRound();
+  TimeDelta UpdateBaseDelay(Timestamp at_time, TimeDelta one_way_delay);
+  NetworkControlUpdate CreateUpdate(Timestamp at_time) const;
+
+  const L4sControllerConfig config_;
+
+  DataRate min_rate_;
+  DataRate max_rate_;
+  DataRate target_rate_;
+  double pacing_factor_;
+  bool first_update_sent_ = false;
+  bool in_startup_ = true;
+  double alpha_ = 0;
+  TimeDelta rtt_ = TimeDelta::PlusInfinity();
+
+  // The one way delays that may become the minimum of the last few seconds,
+  // increasing, with the time they were seen. The minimum is taken as the
+  // delay of an empty queue; it includes the offset of the receiver clock.
+  std::deque<std::pair<Timestamp, TimeDelta>> base_delays_;
+
+  int64_t last_sent_sequence_number_ = 0;
+  // The round ends with feedback for a packet sent after this one.
+  int64_t round_end_sequence_number_ = 0;
+  DataSize round_bytes_ = DataSize::Zero();
+  DataSize round_marked_bytes_ = DataSize::Zero();
+  DataSize round_received_bytes_ = DataSize::Zero();
+  int64_t round_packets_ = 0;
+  int64_t round_lost_packets_ = 0;
+  absl::optional<Timestamp> round_first_receive_time_;
+  absl::optional<Timestamp> round_last_receive_time_;
+  float loss_rate_ratio_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_L4S_L4S_NETWORK_CONTROLLER_H_
@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "api/transport/test/network_control_tester.h"
+#include "modules/congestion_controller/l4s/l4s_factory.h"
+#include "modules/congestion_controller/l4s/l4s_network_controller.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+using testing::AllOf;
+using testing::Field;
+using testing::Ge;
+using testing::Le;
+using testing::Matcher;
+using testing::Property;
+
+namespace webrtc {
+namespace test {
+namespace {
+
+const DataRate kInitialBitrate = DataRate::kbps(300);
+const Timestamp kDefaultStartTime = Timestamp::ms(10000000);
+const TimeDelta kOneWayDelay = TimeDelta::ms(20);
+const DataSize kPacketSize = DataSize::bytes(1000);
+const int kPacketsPerRound = 10;
+
+constexpr double kDataRateMargin = 0.3;
+constexpr double kMinDataRateFactor = 1 - kDataRateMargin;
+constexpr double kMaxDataRateFactor = 1 + kDataRateMargin;
+inline Matcher<TargetTransferRate> TargetRateCloseTo(DataRate rate) {
+  DataRate min_data_rate = rate * kMinDataRateFactor;
+  DataRate max_data_rate = rate * kMaxDataRateFactor;
+  return Field(&TargetTransferRate::target_rate,
+               AllOf(Ge(min_data_rate), Le(max_data_rate)));
+}
+
+NetworkControllerConfig InitialConfig(
+    int starting_bandwidth_kbps = kInitialBitrate.kbps(),
+    int min_data_rate_kbps = 0,
+    int max_data_rate_kbps = 10 * kInitialBitrate.kbps()) {
+  NetworkControllerConfig config;
+  config.constraints.at_time = kDefaultStartTime;
+  config.constraints.min_data_rate = DataRate::kbps(min_data_rate_kbps);
+  config.constraints.max_data_rate = DataRate::kbps(max_data_rate_kbps);
+  config.starting_bandwidth = DataRate::kbps(starting_bandwidth_kbps);
+  return config;
+}
+
+// Sends a round of packets, one every ms, and reports them all in one
+// feedback. Every |marked_every|:th packet of the round, if any, is reported
+// with ECN-CE; the others see |queue_delay| on top of the one way delay.
+class RoundSimulator {
+ public:
+  explicit RoundSimulator(L4sNetworkController* controller)
+      : controller_(controller) {}
+
+  NetworkControlUpdate RunRound(int marked_every,
+                                TimeDelta queue_delay = TimeDelta::Zero()) {
+    TransportPacketsFeedback feedback;
+    for (int i = 0; i < kPacketsPerRound; ++i) {
+      SentPacket sent;
+      sent.send_time = now_;
+      sent.size = kPacketSize;
+      sent.sequence_number = next_sequence_number_++;
+      controller_->OnSentPacket(sent);
+      PacketResult result;
+      result.sent_packet = sent;
+      result.receive_time = now_ + kOneWayDelay + queue_delay;
+      result.ecn_ce = marked_every > 0 && i % marked_every == 0;
+      feedback.packet_feedbacks.push_back(result);
+      now_ += TimeDelta::ms(1);
+    }
+    feedback.feedback_time =
+        feedback.packet_feedbacks.back().receive_time + kOneWayDelay;
+    now_ = feedback.feedback_time;
+    return controller_->OnTransportPacketsFeedback(feedback);
+  }
+
+ private:
+  L4sNetworkController* const controller_;
+  Timestamp now_ = kDefaultStartTime;
+  int64_t next_sequence_number_ = 1;
+};
+
+DataRate TargetRate(const NetworkControlUpdate& update) {
+  EXPECT_TRUE(update.target_rate);
+  return update.target_rate ? update.target_rate->target_rate
+                            : DataRate::Zero();
+}
+
+}  // namespace
+
+TEST(L4sNetworkControllerTest, SendsConfigurationOnFirstProcess) {
+  L4sNetworkController controller(InitialConfig());
+  ProcessInterval process_interval;
+  process_interval.at_time = kDefaultStartTime;
+  NetworkControlUpdate update = controller.OnProcessInterval(process_interval);
+  EXPECT_EQ(kInitialBitrate, TargetRate(update));
+  EXPECT_THAT(*update.pacer_config,
+              Property(&PacerConfig::data_rate, Ge(kInitialBitrate)));
+  EXPECT_FALSE(update.congestion_window);
+}
+
+TEST(L4sNetworkControllerTest, IncreasesRateWithoutMarks) {
+  L4sNetworkController controller(InitialConfig());
+  RoundSimulator simulator(&controller);
+  // The first round ends with the first feedback.
+  DataRate last_rate = TargetRate(simulator.RunRound(0));
+  EXPECT_GT(last_rate, kInitialBitrate);
+  for (int i = 0; i < 3; ++i) {
+    DataRate rate = TargetRate(simulator.RunRound(0));
+    EXPECT_GT(rate, last_rate);
+    last_rate = rate;
+  }
+  EXPECT_EQ(0, controller.alpha());
+}
+
+TEST(L4sNetworkControllerTest, ReducesRateInProportionToCeMarks) {
+  // Leave startup with a marked round, then keep marking the same fraction.
+  const DataRate kStartRate = DataRate::kbps(3000);
+  L4sNetworkController lightly_marked(InitialConfig(kStartRate.kbps()));
+  L4sNetworkController fully_marked(InitialConfig(kStartRate.kbps()));
+  RoundSimulator light_simulator(&lightly_marked);
+  RoundSimulator full_simulator(&fully_marked);
+  DataRate light_rate = kStartRate;
+  DataRate full_rate = kStartRate;
+  for (int i = 0; i < 5; ++i) {
+    DataRate rate = TargetRate(light_simulator.RunRound(kPacketsPerRound));
+    EXPECT_LT(rate, light_rate);
+    light_rate = rate;
+    rate = TargetRate(full_simulator.RunRound(1));
+    EXPECT_LT(rate, full_rate);
+    full_rate = rate;
+  }
+  EXPECT_GT(light_rate, full_rate);
+  EXPECT_LT(lightly_marked.alpha(), fully_marked.alpha());
+  // With every packet marked, each round halves the rate.
+  EXPECT_LT(full_rate, kStartRate * 0.1);
+
+  // The rate recovers once the marks stop.
+  DataRate rate = TargetRate(full_simulator.RunRound(0));
+  EXPECT_GT(rate, full_rate);
+}
+
+TEST(L4sNetworkControllerTest, TreatsQueueingDelayAboveThresholdAsMarks) {
+  L4sNetworkController controller(InitialConfig());
+  RoundSimulator simulator(&controller);
+  DataRate rate = TargetRate(simulator.RunRound(0));
+  // A small queue is tolerated.
+  DataRate new_rate = TargetRate(simulator.RunRound(0, TimeDelta::ms(5)));
+  EXPECT_GT(new_rate, rate);
+  rate = new_rate;
+  new_rate = TargetRate(simulator.RunRound(0, TimeDelta::ms(40)));
+  EXPECT_LT(new_rate, rate);
+  EXPECT_GT(controller.alpha(), 0);
+}
+
+TEST(L4sNetworkControllerTest, StaysWithinConstraints) {
+  L4sNetworkController controller(InitialConfig(300, 200, 400));
+  RoundSimulator simulator(&controller);
+  for (int i = 0; i < 10; ++i)
+    EXPECT_LE(TargetRate(simulator.RunRound(0)), DataRate::kbps(400));
+  for (int i = 0; i < 10; ++i)
+    EXPECT_GE(TargetRate(simulator.RunRound(1)), DataRate::kbps(200));
+}
+
+// Without ECN the queueing delay drives the rate towards the bottleneck rate.
+TEST(L4sNetworkControllerTest, UpdatesTargetSendRate) {
+  L4sNetworkControllerFactory factory;
+  NetworkControllerTester tester(&factory, InitialConfig(60, 0, 600));
+  auto packet_producer = &SimpleTargetRateProducer::ProduceNext;
+
+  tester.RunSimulation(TimeDelta::seconds(10), TimeDelta::ms(10),
+                       DataRate::kbps(300), TimeDelta::ms(100),
+                       packet_producer);
+  EXPECT_THAT(*tester.GetState().target_rate,
+              TargetRateCloseTo(DataRate::kbps(300)));
+
+  tester.RunSimulation(TimeDelta::seconds(30), TimeDelta::ms(10),
+                       DataRate::kbps(500), TimeDelta::ms(100),
+                       packet_producer);
+  EXPECT_THAT(*tester.GetState().target_rate,
+              TargetRateCloseTo(DataRate::kbps(500)));
+
+  tester.RunSimulation(TimeDelta::seconds(30), TimeDelta::ms(10),
+                       DataRate::kbps(100), TimeDelta::ms(200),
+                       packet_producer);
+  EXPECT_THAT(*tester.GetState().target_rate,
+              TargetRateCloseTo(DataRate::kbps(100)));
+}
+
+}  // namespace test
+}  // namespace webrtc
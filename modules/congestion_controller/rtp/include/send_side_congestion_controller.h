@@ -215,6 +215,10 @@ class SendSideCongestionController
   // Protects access to last_packet_feedback_vector_ in feedback adapter.
   // TODO(srte): Remove this checker when feedback adapter runs on task queue.
   rtc::RaceChecker worker_race_;
+  // Scratch space for sorting the feedback in OnTransportFeedback(), kept to
+  // avoid allocating for every feedback.
+  std::vector<PacketFeedback> sorted_feedback_vector_
+      RTC_GUARDED_BY(worker_race_);
 
   rtc::TaskQueue* task_queue_;
 
@@ -91,18 +91,17 @@ PacketResult NetworkPacketFeedbackFromRtpPacketFeedback(
   return feedback;
 }
 
-std::vector<PacketResult> PacketResultsFromRtpFeedbackVector(
-    const std::vector<PacketFeedback>& feedback_vector) {
+void PacketResultsFromRtpFeedbackVector(
+    const std::vector<PacketFeedback>& feedback_vector,
+    std::vector<PacketResult>* packet_feedbacks) {
   RTC_DCHECK(std::is_sorted(feedback_vector.begin(), feedback_vector.end(),
                             PacketFeedbackComparator()));
 
-  std::vector<PacketResult> packet_feedbacks;
-  packet_feedbacks.reserve(feedback_vector.size());
+  packet_feedbacks->reserve(feedback_vector.size());
   for (const PacketFeedback& rtp_feedback : feedback_vector) {
-    auto feedback = NetworkPacketFeedbackFromRtpPacketFeedback(rtp_feedback);
-    packet_feedbacks.push_back(feedback);
+    packet_feedbacks->push_back(
+        NetworkPacketFeedbackFromRtpPacketFeedback(rtp_feedback));
   }
-  return packet_feedbacks;
 }
 
 TargetRateConstraints ConvertConstraints(int min_bitrate_bps,
@@ -689,22 +688,25 @@ void SendSideCongestionController::OnTransportFeedback(
   transport_feedback_adapter_.OnTransportFeedback(feedback);
   MaybeUpdateOutstandingData();
 
-  std::vector<PacketFeedback> feedback_vector =
+  sorted_feedback_vector_ =
       transport_feedback_adapter_.GetTransportFeedbackVector();
-  SortPacketFeedbackVector(&feedback_vector);
+  SortPacketFeedbackVector(&sorted_feedback_vector_);
 
-  if (!feedback_vector.empty()) {
+  if (!sorted_feedback_vector_.empty()) {
     TransportPacketsFeedback msg;
-    msg.packet_feedbacks = PacketResultsFromRtpFeedbackVector(feedback_vector);
+    PacketResultsFromRtpFeedbackVector(sorted_feedback_vector_,
+                                       &msg.packet_feedbacks);
     msg.feedback_time = Timestamp::ms(feedback_time_ms);
     msg.prior_in_flight = prior_in_flight;
     msg.data_in_flight =
         DataSize::bytes(transport_feedback_adapter_.GetOutstandingBytes());
-    task_queue_->PostTask([this, msg]() {
+    // The lambda holds the only other copy of |msg|, so hand it over to the
+    // controller rather than copying it once more.
+    task_queue_->PostTask([this, msg]() mutable {
       RTC_DCHECK_RUN_ON(task_queue_);
       if (controller_)
         control_handler_->PostUpdates(
-            controller_->OnTransportPacketsFeedback(msg));
+            controller_->OnTransportPacketsFeedback(std::move(msg)));
     });
   }
 }
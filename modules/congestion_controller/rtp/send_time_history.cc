@@ -18,6 +18,14 @@
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+const size_t kMinBufferSize = 64;
+// Packets that are lost aren't removed until they're too old, so the stored
+// range may span all packets sent within the age limit. Packets this far
+// behind the newest one are dropped even if they're not that old yet, which
+// bounds the memory used. Feedback for them is unlikely to still arrive.
+const size_t kMaxSpan = 1 << 15;
+}  // namespace
 
 SendTimeHistory::SendTimeHistory(const Clock* clock,
                                  int64_t packet_age_limit_ms)
@@ -28,19 +36,24 @@ SendTimeHistory::~SendTimeHistory() {}
 void SendTimeHistory::AddAndRemoveOld(const PacketFeedback& packet) {
   int64_t now_ms = clock_->TimeInMilliseconds();
   // Remove old.
-  while (!history_.empty() &&
-         now_ms - history_.begin()->second.creation_time_ms >
+  while (span_ > 0 &&
+         now_ms - SlotAt(first_seq_num_)->creation_time_ms >
              packet_age_limit_ms_) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    RemovePacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    RemovePacketBytes(*SlotAt(first_seq_num_));
+    RemovePacket(first_seq_num_);
   }
 
   // Add new.
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(packet.sequence_number);
   PacketFeedback packet_copy = packet;
   packet_copy.long_sequence_number = unwrapped_seq_num;
-  history_.insert(std::make_pair(unwrapped_seq_num, packet_copy));
+  Slot* slot = AllocateSlot(unwrapped_seq_num);
+  // A packet that is dropped for being too far behind, or that is already
+  // stored, isn't counted as in flight, since nothing would remove it again.
+  if (!slot || slot->has_value())
+    return;
+  slot->emplace(packet_copy);
   if (packet.send_time_ms >= 0)
     AddPacketBytes(packet_copy);
 }
@@ -48,13 +61,13 @@ void SendTimeHistory::AddAndRemoveOld(const PacketFeedback& packet) {
 bool SendTimeHistory::OnSentPacket(uint16_t sequence_number,
                                    int64_t send_time_ms) {
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+  if (!packet)
     return false;
-  bool packet_retransmit = it->second.send_time_ms >= 0;
-  it->second.send_time_ms = send_time_ms;
+  bool packet_retransmit = packet->send_time_ms >= 0;
+  packet->send_time_ms = send_time_ms;
   if (!packet_retransmit)
-    AddPacketBytes(it->second);
+    AddPacketBytes(*packet);
   return true;
 }
 
@@ -63,9 +76,9 @@ absl::optional<PacketFeedback> SendTimeHistory::GetPacket(
   int64_t unwrapped_seq_num =
       seq_num_unwrapper_.UnwrapWithoutUpdate(sequence_number);
   absl::optional<PacketFeedback> optional_feedback;
-  auto it = history_.find(unwrapped_seq_num);
-  if (it != history_.end())
-    optional_feedback.emplace(it->second);
+  const PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+  if (packet)
+    optional_feedback.emplace(*packet);
   return optional_feedback;
 }
 
@@ -76,17 +89,17 @@ bool SendTimeHistory::GetFeedback(PacketFeedback* packet_feedback,
       seq_num_unwrapper_.Unwrap(packet_feedback->sequence_number);
   UpdateAckedSeqNum(unwrapped_seq_num);
   RTC_DCHECK_GE(*last_ack_seq_num_, 0);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  const PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+  if (!packet)
     return false;
 
   // Save arrival_time not to overwrite it.
   int64_t arrival_time_ms = packet_feedback->arrival_time_ms;
-  *packet_feedback = it->second;
+  *packet_feedback = *packet;
   packet_feedback->arrival_time_ms = arrival_time_ms;
 
   if (remove)
-    history_.erase(it);
+    RemovePacket(unwrapped_seq_num);
   return true;
 }
 
@@ -129,14 +142,95 @@ void SendTimeHistory::UpdateAckedSeqNum(int64_t acked_seq_num) {
   if (last_ack_seq_num_ && *last_ack_seq_num_ >= acked_seq_num)
     return;
 
-  auto unacked_it = history_.begin();
-  if (last_ack_seq_num_)
-    unacked_it = history_.lower_bound(*last_ack_seq_num_);
-
-  auto newly_acked_end = history_.upper_bound(acked_seq_num);
-  for (; unacked_it != newly_acked_end; ++unacked_it) {
-    RemovePacketBytes(unacked_it->second);
+  if (span_ > 0) {
+    int64_t seq_num = first_seq_num_;
+    if (last_ack_seq_num_)
+      seq_num = std::max(seq_num, *last_ack_seq_num_);
+    int64_t newly_acked_end =
+        std::min<int64_t>(acked_seq_num, first_seq_num_ + span_ - 1);
+    for (; seq_num <= newly_acked_end; ++seq_num) {
+      const Slot& slot = SlotAt(seq_num);
+      if (slot)
+        RemovePacketBytes(*slot);
+    }
   }
   last_ack_seq_num_.emplace(acked_seq_num);
 }
+
+PacketFeedback* SendTimeHistory::FindPacket(int64_t unwrapped_seq_num) {
+  if (unwrapped_seq_num < first_seq_num_ ||
+      unwrapped_seq_num >= first_seq_num_ + static_cast<int64_t>(span_)) {
+    return nullptr;
+  }
+  Slot& slot = SlotAt(unwrapped_seq_num);
+  return slot ? &*slot : nullptr;
+}
+
+const PacketFeedback* SendTimeHistory::FindPacket(
+    int64_t unwrapped_seq_num) const {
+  return const_cast<SendTimeHistory*>(this)->FindPacket(unwrapped_seq_num);
+}
+
+SendTimeHistory::Slot* SendTimeHistory::AllocateSlot(
+    int64_t unwrapped_seq_num) {
+  if (span_ == 0) {
+    if (history_.empty())
+      GrowBuffer(kMinBufferSize);
+    first_seq_num_ = unwrapped_seq_num;
+    span_ = 1;
+    return &SlotAt(unwrapped_seq_num);
+  }
+
+  int64_t end_seq_num = first_seq_num_ + span_;
+  if (unwrapped_seq_num < first_seq_num_) {
+    // Sequence numbers are normally added in order, so make room at the front
+    // only if the packet isn't too far behind.
+    size_t new_span = end_seq_num - unwrapped_seq_num;
+    if (new_span > kMaxSpan)
+      return nullptr;
+    if (new_span > history_.size())
+      GrowBuffer(new_span);
+    first_seq_num_ = unwrapped_seq_num;
+    span_ = new_span;
+  } else if (unwrapped_seq_num >= end_seq_num) {
+    // Drop the packets that are too far behind the new one.
+    while (span_ > 0 &&
+           static_cast<size_t>(unwrapped_seq_num - first_seq_num_) >=
+               kMaxSpan) {
+      RemovePacketBytes(*SlotAt(first_seq_num_));
+      RemovePacket(first_seq_num_);
+    }
+    if (span_ == 0)
+      return AllocateSlot(unwrapped_seq_num);
+    size_t new_span = unwrapped_seq_num - first_seq_num_ + 1;
+    if (new_span > history_.size())
+      GrowBuffer(new_span);
+    span_ = new_span;
+  }
+  return &SlotAt(unwrapped_seq_num);
+}
+
+void SendTimeHistory::GrowBuffer(size_t min_size) {
+  size_t new_size = std::max(history_.size(), kMinBufferSize);
+  while (new_size < min_size)
+    new_size *= 2;
+  std::vector<Slot> new_history(new_size);
+  for (size_t i = 0; i < span_; ++i) {
+    int64_t seq_num = first_seq_num_ + i;
+    new_history[seq_num & (new_size - 1)] = std::move(SlotAt(seq_num));
+  }
+  history_.swap(new_history);
+}
+
+void SendTimeHistory::RemovePacket(int64_t unwrapped_seq_num) {
+  Slot& slot = SlotAt(unwrapped_seq_num);
+  RTC_DCHECK(slot);
+  slot.reset();
+  while (span_ > 0 && !SlotAt(first_seq_num_)) {
+    ++first_seq_num_;
+    --span_;
+  }
+  while (span_ > 0 && !SlotAt(first_seq_num_ + span_ - 1))
+    --span_;
+}
 }  // namespace webrtc
@@ -13,7 +13,9 @@
 
 #include <map>
 #include <utility>
+#include <vector>
 
+#include "absl/types/optional.h"
 #include "modules/include/module_common_types.h"
 #include "rtc_base/constructormagic.h"
 
@@ -21,6 +23,12 @@ namespace webrtc {
 class Clock;
 struct PacketFeedback;
 
+// Keeps the packets sent in the last |packet_age_limit_ms| until their
+// transport feedback arrives. The packets are stored in a circular buffer
+// indexed by their unwrapped transport sequence number, since they are added
+// in sequence number order and mostly acknowledged in order, so that lookups,
+// insertions and removals are O(1) and don't allocate once the buffer has
+// grown to the working size.
 class SendTimeHistory {
  public:
   SendTimeHistory(const Clock* clock, int64_t packet_age_limit_ms);
@@ -47,13 +55,39 @@ class SendTimeHistory {
  private:
   using RemoteAndLocalNetworkId = std::pair<uint16_t, uint16_t>;
 
+  using Slot = absl::optional<PacketFeedback>;
+
+  // Returns the packet with |unwrapped_seq_num|, or null if it isn't stored.
+  PacketFeedback* FindPacket(int64_t unwrapped_seq_num);
+  const PacketFeedback* FindPacket(int64_t unwrapped_seq_num) const;
+  // Returns the slot for |unwrapped_seq_num|, extending the stored range (and
+  // the buffer, if needed), or null if it's too far behind the stored range.
+  Slot* AllocateSlot(int64_t unwrapped_seq_num);
+  // Resizes |history_| to at least |min_size| slots, keeping the packets.
+  void GrowBuffer(size_t min_size);
+  // Removes the packet with |unwrapped_seq_num|, which must be stored, and
+  // shrinks the stored range past empty slots at either end.
+  void RemovePacket(int64_t unwrapped_seq_num);
+  Slot& SlotAt(int64_t unwrapped_seq_num) {
+    return history_[unwrapped_seq_num & (history_.size() - 1)];
+  }
+  const Slot& SlotAt(int64_t unwrapped_seq_num) const {
+    return history_[unwrapped_seq_num & (history_.size() - 1)];
+  }
+
   void AddPacketBytes(const PacketFeedback& packet);
   void RemovePacketBytes(const PacketFeedback& packet);
   void UpdateAckedSeqNum(int64_t acked_seq_num);
   const Clock* const clock_;
   const int64_t packet_age_limit_ms_;
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  // Circular buffer of packets, indexed by unwrapped sequence number modulo
+  // its size, which is a power of two. Slots in the range [first_seq_num_,
+  // first_seq_num_ + span_) without a packet have been acknowledged already.
+  // The first and last slot of the range are never empty.
+  std::vector<Slot> history_;
+  int64_t first_seq_num_ = 0;
+  size_t span_ = 0;
   absl::optional<int64_t> last_ack_seq_num_;
   std::map<RemoteAndLocalNetworkId, size_t> in_flight_bytes_;
 
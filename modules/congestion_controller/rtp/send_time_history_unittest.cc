@@ -252,5 +252,65 @@ TEST_F(SendTimeHistoryTest, InterlievedGetAndRemove) {
   EXPECT_TRUE(history_.GetFeedback(&packet3, true));
   EXPECT_EQ(packets[2], packet3);
 }
+
+TEST_F(SendTimeHistoryTest, LostPacketsDoNotHoldBackLaterPackets) {
+  // Every tenth packet is never acknowledged, as if it was lost.
+  for (int i = 0; i < 20000; ++i) {
+    uint16_t seq_num = static_cast<uint16_t>(i);
+    AddPacketWithSendTime(seq_num, 100, clock_.TimeInMilliseconds(),
+                          PacedPacketInfo());
+    if (i % 10 != 0) {
+      PacketFeedback packet(clock_.TimeInMilliseconds(), seq_num);
+      EXPECT_TRUE(history_.GetFeedback(&packet, true));
+    }
+    if (i % 100 == 0)
+      clock_.AdvanceTimeMilliseconds(10);
+  }
+  // Packets older than the history length are gone, later ones remain.
+  PacketFeedback old_packet(0, 0, 10, 0, PacedPacketInfo());
+  EXPECT_FALSE(history_.GetFeedback(&old_packet, false));
+  PacketFeedback recent_packet(0, 0, 19990, 0, PacedPacketInfo());
+  EXPECT_TRUE(history_.GetFeedback(&recent_packet, false));
+}
+
+TEST_F(SendTimeHistoryTest, DropsPacketsFarBehindNewestPacket) {
+  AddPacketWithSendTime(0, 100, 0, PacedPacketInfo());
+  for (int i = 1; i <= 40000; ++i)
+    AddPacketWithSendTime(static_cast<uint16_t>(i), 100, 0, PacedPacketInfo());
+  EXPECT_FALSE(history_.GetPacket(0));
+  EXPECT_TRUE(history_.GetPacket(static_cast<uint16_t>(40000)));
+  EXPECT_TRUE(history_.GetPacket(static_cast<uint16_t>(40000 - 1000)));
+  // Only the remaining packets are counted as outstanding.
+  EXPECT_LT(history_.GetOutstandingBytes(0, 0), 40000u * 100);
+  EXPECT_GT(history_.GetOutstandingBytes(0, 0), 1000u * 100);
+}
+
+TEST_F(SendTimeHistoryTest, DoesNotCountPacketFarBehindNewestPacket) {
+  for (int i = 0; i <= 40000; ++i)
+    AddPacketWithSendTime(static_cast<uint16_t>(i), 100, 0, PacedPacketInfo());
+  const size_t outstanding_bytes = history_.GetOutstandingBytes(0, 0);
+  // Half the sequence number space behind the newest packet, so it's
+  // unwrapped as an older packet, but too old to be stored.
+  const uint16_t kFarBehindSeqNum = static_cast<uint16_t>(40000 - (1 << 15));
+  PacketFeedback packet(clock_.TimeInMilliseconds(), kFarBehindSeqNum, 100, 0,
+                        0, PacedPacketInfo());
+  packet.send_time_ms = clock_.TimeInMilliseconds();
+  history_.AddAndRemoveOld(packet);
+  EXPECT_FALSE(history_.GetPacket(kFarBehindSeqNum));
+  EXPECT_EQ(outstanding_bytes, history_.GetOutstandingBytes(0, 0));
+}
+
+TEST_F(SendTimeHistoryTest, OutstandingBytesAcrossGrowth) {
+  for (int i = 0; i < 1000; ++i)
+    AddPacketWithSendTime(static_cast<uint16_t>(i), 10, 0, PacedPacketInfo());
+  EXPECT_EQ(1000u * 10, history_.GetOutstandingBytes(0, 0));
+  PacketFeedback packet(0, 0, 499, 0, PacedPacketInfo());
+  EXPECT_TRUE(history_.GetFeedback(&packet, true));
+  EXPECT_EQ(500u * 10, history_.GetOutstandingBytes(0, 0));
+  for (int i = 0; i < 1000; ++i) {
+    PacketFeedback other(0, 0, static_cast<uint16_t>(i), 0, PacedPacketInfo());
+    EXPECT_EQ(i != 499, history_.GetFeedback(&other, false));
+  }
+}
 }  // namespace test
 }  // namespace webrtc
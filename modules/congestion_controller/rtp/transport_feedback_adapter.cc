@@ -96,8 +96,10 @@ void TransportFeedbackAdapter::SetNetworkIds(uint16_t local_id,
   remote_net_id_ = remote_id;
 }
 
-std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
-    const rtcp::TransportFeedback& feedback) {
+void TransportFeedbackAdapter::GetPacketFeedbackVector(
+    const rtcp::TransportFeedback& feedback,
+    std::vector<PacketFeedback>* packet_feedback_vector) {
+  packet_feedback_vector->clear();
   int64_t timestamp_us = feedback.GetBaseTimeUs();
   int64_t now_ms = clock_->TimeInMilliseconds();
   // Add timestamp deltas to a local time base selected on first packet arrival.
@@ -119,12 +121,11 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
   }
   last_timestamp_us_ = timestamp_us;
 
-  std::vector<PacketFeedback> packet_feedback_vector;
   if (feedback.GetPacketStatusCount() == 0) {
     RTC_LOG(LS_INFO) << "Empty transport feedback packet received.";
-    return packet_feedback_vector;
+    return;
   }
-  packet_feedback_vector.reserve(feedback.GetPacketStatusCount());
+  packet_feedback_vector->reserve(feedback.GetPacketStatusCount());
   {
     rtc::CritScope cs(&lock_);
     size_t failed_lookups = 0;
@@ -142,7 +143,7 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
           ++failed_lookups;
         if (packet_feedback.local_net_id == local_net_id_ &&
             packet_feedback.remote_net_id == remote_net_id_) {
-          packet_feedback_vector.push_back(packet_feedback);
+          packet_feedback_vector->push_back(packet_feedback);
         }
       }
 
@@ -154,7 +155,7 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
         ++failed_lookups;
       if (packet_feedback.local_net_id == local_net_id_ &&
           packet_feedback.remote_net_id == remote_net_id_) {
-        packet_feedback_vector.push_back(packet_feedback);
+        packet_feedback_vector->push_back(packet_feedback);
       }
 
       ++seq_num;
@@ -166,12 +167,11 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
                           << ". Send time history too small?";
     }
   }
-  return packet_feedback_vector;
 }
 
 void TransportFeedbackAdapter::OnTransportFeedback(
     const rtcp::TransportFeedback& feedback) {
-  last_packet_feedback_vector_ = GetPacketFeedbackVector(feedback);
+  GetPacketFeedbackVector(feedback, &last_packet_feedback_vector_);
   {
     rtc::CritScope cs(&observers_lock_);
     for (auto* observer : observers_) {
@@ -180,7 +180,7 @@ void TransportFeedbackAdapter::OnTransportFeedback(
   }
 }
 
-std::vector<PacketFeedback>
+const std::vector<PacketFeedback>&
 TransportFeedbackAdapter::GetTransportFeedbackVector() const {
   return last_packet_feedback_vector_;
 }
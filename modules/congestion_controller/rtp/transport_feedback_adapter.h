@@ -47,7 +47,9 @@ class TransportFeedbackAdapter {
   // can get rid of the dependency on BitrateController. Requires changes
   // to the CongestionController interface.
   void OnTransportFeedback(const rtcp::TransportFeedback& feedback);
-  std::vector<PacketFeedback> GetTransportFeedbackVector() const;
+  // The feedback of the last OnTransportFeedback(), in transport sequence
+  // number order. Valid until the next call.
+  const std::vector<PacketFeedback>& GetTransportFeedbackVector() const;
   absl::optional<PacketFeedback> GetPacket(uint16_t sequence_number) const;
 
   void SetTransportOverhead(int transport_overhead_bytes_per_packet);
@@ -57,8 +59,10 @@ class TransportFeedbackAdapter {
   size_t GetOutstandingBytes() const;
 
  private:
-  std::vector<PacketFeedback> GetPacketFeedbackVector(
-      const rtcp::TransportFeedback& feedback);
+  // Fills |packet_feedback_vector|, reusing its storage.
+  void GetPacketFeedbackVector(
+      const rtcp::TransportFeedback& feedback,
+      std::vector<PacketFeedback>* packet_feedback_vector);
 
   rtc::CriticalSection lock_;
   SendTimeHistory send_time_history_ RTC_GUARDED_BY(&lock_);
@@ -0,0 +1,531 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/congestion_controller/test/controller_simulation.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+// Media that the pacer couldn't send within this time is dropped, like an
+// encoder drops frames when the pacer queue grows.
+constexpr TimeDelta kMaxEncoderQueueTime = TimeDelta::Millis<500>();
+// Limits the burst after a period without anything to send.
+constexpr TimeDelta kMaxPacingBudgetTime = TimeDelta::Millis<5>();
+// Gain of the smoothed round trip time reported with RTCP.
+constexpr double kRttSmoothingGain = 0.125;
+
+struct ProbeCluster {
+  int id;
+  DataRate rate = DataRate::Zero();
+  int min_probes;
+  int64_t min_bytes;
+  int sent_probes;
+  int64_t sent_bytes;
+  double budget_bytes;
+};
+
+// Transport feedback as generated by the receiver, translated into
+// TransportPacketsFeedback by the sender once it arrives.
+struct ReceiverFeedback {
+  Timestamp arrival_time = Timestamp::Infinity();
+  // All packets up to and including this one are reported, those not in
+  // |receive_times| as lost.
+  int64_t last_sequence_number = 0;
+  std::map<int64_t, Timestamp> receive_times;
+};
+
+class ControllerSimulation {
+ public:
+  ControllerSimulation(NetworkControllerFactoryInterface* factory,
+                       const ControllerSimulationScenario& scenario);
+
+  ControllerSimulationMetrics Run();
+
+ private:
+  void Update(const NetworkControlUpdate& update);
+  void RunTimeStep(const NetworkTraceStep& step);
+  void HandleArrivedMessages();
+  void SendMedia();
+  void SendProbes();
+  void SendPadding();
+  void SendPacket(DataSize size, const PacedPacketInfo& pacing_info);
+  void ReceivePackets(TimeDelta return_delay);
+  void HandleFeedback(const ReceiverFeedback& feedback);
+
+  const ControllerSimulationScenario& scenario_;
+  const TimeDelta process_interval_;
+  std::unique_ptr<NetworkControllerInterface> controller_;
+  SimulatedNetwork network_;
+  Timestamp now_;
+
+  // Sender.
+  DataRate target_rate_ = DataRate::Zero();
+  DataRate pacing_rate_ = DataRate::Zero();
+  DataRate padding_rate_ = DataRate::Zero();
+  absl::optional<DataSize> congestion_window_;
+  Timestamp next_process_time_;
+  Timestamp next_frame_time_;
+  double encoder_queue_bytes_ = 0;
+  double pacing_budget_bytes_ = 0;
+  double padding_budget_bytes_ = 0;
+  std::deque<ProbeCluster> probe_clusters_;
+  int next_probe_cluster_id_ = 0;
+  int64_t next_sequence_number_ = 1;
+  std::map<int64_t, SentPacket> in_flight_;
+  DataSize in_flight_bytes_ = DataSize::Zero();
+  TimeDelta last_rtt_ = TimeDelta::PlusInfinity();
+  TimeDelta smoothed_rtt_ = TimeDelta::PlusInfinity();
+
+  // Receiver.
+  ReceiverFeedback pending_feedback_;
+  Timestamp next_feedback_time_;
+  Timestamp next_report_time_;
+  Timestamp last_report_time_;
+  int64_t highest_received_sequence_number_ = 0;
+  int64_t last_reported_sequence_number_ = 0;
+  uint64_t packets_received_since_report_ = 0;
+  uint64_t packets_lost_since_report_ = 0;
+
+  // Messages on their way back to the sender.
+  std::deque<ReceiverFeedback> feedback_in_flight_;
+  std::deque<TransportLossReport> reports_in_flight_;
+
+  ControllerSimulationMetrics metrics_;
+  std::vector<int64_t> delays_us_;
+  double target_rate_bit_seconds_ = 0;
+  double capacity_bit_seconds_ = 0;
+};
+
+ControllerSimulation::ControllerSimulation(
+    NetworkControllerFactoryInterface* factory,
+    const ControllerSimulationScenario& scenario)
+    : scenario_(scenario),
+      process_interval_(factory->GetProcessInterval()),
+      network_(SimulatedNetwork::Config(), scenario.random_seed),
+      now_(Timestamp::seconds(100000)),
+      next_process_time_(now_),
+      next_frame_time_(now_),
+      next_feedback_time_(now_ + scenario.feedback_interval),
+      next_report_time_(now_ + scenario.report_interval),
+      last_report_time_(now_) {
+  NetworkControllerConfig config;
+  config.constraints.at_time = now_;
+  config.constraints.min_data_rate = scenario.min_rate;
+  config.constraints.max_data_rate = scenario.max_rate;
+  config.starting_bandwidth = scenario.start_rate;
+  controller_ = factory->Create(config);
+  target_rate_ = scenario.start_rate;
+  pacing_rate_ = scenario.start_rate;
+
+  NetworkAvailability availability;
+  availability.at_time = now_;
+  availability.network_available = true;
+  Update(controller_->OnNetworkAvailability(availability));
+  metrics_.scenario_name = scenario.name;
+}
+
+ControllerSimulationMetrics ControllerSimulation::Run() {
+  Timestamp start_time = now_;
+  for (const NetworkTraceStep& step : scenario_.trace) {
+    network_.SetConfig(step.config);
+    Timestamp step_end_time = now_ + step.duration;
+    while (now_ < step_end_time) {
+      RunTimeStep(step);
+      now_ += scenario_.time_step;
+    }
+  }
+  metrics_.duration = now_ - start_time;
+  if (metrics_.duration <= TimeDelta::Zero())
+    return metrics_;
+
+  double duration_seconds = metrics_.duration.seconds<double>();
+  metrics_.average_target_rate =
+      DataRate::bps(target_rate_bit_seconds_ / duration_seconds);
+  metrics_.average_throughput = metrics_.bytes_received / metrics_.duration;
+  if (capacity_bit_seconds_ > 0) {
+    metrics_.link_utilization =
+        metrics_.bytes_received.bytes() * 8 / capacity_bit_seconds_;
+  }
+  if (metrics_.packets_sent > 0) {
+    metrics_.loss_ratio =
+        static_cast<double>(metrics_.packets_lost) / metrics_.packets_sent;
+  }
+  if (!delays_us_.empty()) {
+    int64_t total_delay_us = 0;
+    for (int64_t delay_us : delays_us_)
+      total_delay_us += delay_us;
+    metrics_.mean_delay = TimeDelta::us(total_delay_us / delays_us_.size());
+    size_t p95_index = delays_us_.size() * 95 / 100;
+    std::nth_element(delays_us_.begin(), delays_us_.begin() + p95_index,
+                     delays_us_.end());
+    metrics_.p95_delay = TimeDelta::us(delays_us_[p95_index]);
+    metrics_.max_delay =
+        TimeDelta::us(*std::max_element(delays_us_.begin(), delays_us_.end()));
+  }
+  return metrics_;
+}
+
+void ControllerSimulation::Update(const NetworkControlUpdate& update) {
+  if (update.congestion_window)
+    congestion_window_ = *update.congestion_window;
+  if (update.pacer_config) {
+    pacing_rate_ = update.pacer_config->data_rate();
+    padding_rate_ = update.pacer_config->pad_rate();
+  }
+  if (update.target_rate)
+    target_rate_ = update.target_rate->target_rate;
+  for (const ProbeClusterConfig& config : update.probe_cluster_configs) {
+    ProbeCluster cluster;
+    cluster.id = next_probe_cluster_id_++;
+    cluster.rate = config.target_data_rate;
+    cluster.min_probes = config.target_probe_count;
+    cluster.min_bytes = (config.target_data_rate * config.target_duration)
+                            .bytes();
+    cluster.sent_probes = 0;
+    cluster.sent_bytes = 0;
+    cluster.budget_bytes = 0;
+    probe_clusters_.push_back(cluster);
+  }
+}
+
+void ControllerSimulation::RunTimeStep(const NetworkTraceStep& step) {
+  TimeDelta return_delay = TimeDelta::ms(step.config.queue_delay_ms);
+  HandleArrivedMessages();
+  if (process_interval_.IsFinite() && now_ >= next_process_time_) {
+    ProcessInterval msg;
+    msg.at_time = now_;
+    Update(controller_->OnProcessInterval(msg));
+    next_process_time_ += process_interval_;
+  }
+
+  if (probe_clusters_.empty()) {
+    SendMedia();
+    SendPadding();
+  } else {
+    SendProbes();
+  }
+  ReceivePackets(return_delay);
+
+  if (now_ >= next_feedback_time_) {
+    if (pending_feedback_.last_sequence_number >
+        last_reported_sequence_number_) {
+      last_reported_sequence_number_ = pending_feedback_.last_sequence_number;
+      pending_feedback_.arrival_time = now_ + return_delay;
+      feedback_in_flight_.push_back(std::move(pending_feedback_));
+      pending_feedback_ = ReceiverFeedback();
+      pending_feedback_.last_sequence_number = last_reported_sequence_number_;
+    }
+    next_feedback_time_ += scenario_.feedback_interval;
+  }
+  if (now_ >= next_report_time_) {
+    TransportLossReport report;
+    report.receive_time = now_ + return_delay;
+    report.start_time = last_report_time_;
+    report.end_time = now_;
+    report.packets_lost_delta = packets_lost_since_report_;
+    report.packets_received_delta = packets_received_since_report_;
+    reports_in_flight_.push_back(report);
+    packets_lost_since_report_ = 0;
+    packets_received_since_report_ = 0;
+    last_report_time_ = now_;
+    next_report_time_ += scenario_.report_interval;
+  }
+
+  target_rate_bit_seconds_ +=
+      target_rate_.bps() * scenario_.time_step.seconds<double>();
+  capacity_bit_seconds_ += step.config.link_capacity_kbps * 1000.0 *
+                           scenario_.time_step.seconds<double>();
+}
+
+void ControllerSimulation::HandleArrivedMessages() {
+  while (!feedback_in_flight_.empty() &&
+         feedback_in_flight_.front().arrival_time <= now_) {
+    HandleFeedback(feedback_in_flight_.front());
+    feedback_in_flight_.pop_front();
+  }
+  while (!reports_in_flight_.empty() &&
+         reports_in_flight_.front().receive_time <= now_) {
+    Update(controller_->OnTransportLossReport(reports_in_flight_.front()));
+    reports_in_flight_.pop_front();
+    if (last_rtt_.IsFinite()) {
+      RoundTripTimeUpdate rtt_update;
+      rtt_update.receive_time = now_;
+      rtt_update.round_trip_time = last_rtt_;
+      Update(controller_->OnRoundTripTimeUpdate(rtt_update));
+      rtt_update.round_trip_time = smoothed_rtt_;
+      rtt_update.smoothed = true;
+      Update(controller_->OnRoundTripTimeUpdate(rtt_update));
+    }
+  }
+}
+
+void ControllerSimulation::SendMedia() {
+  double step_seconds = scenario_.time_step.seconds<double>();
+  if (now_ >= next_frame_time_) {
+    encoder_queue_bytes_ += target_rate_.bps() / 8.0 *
+                            scenario_.frame_interval.seconds<double>();
+    encoder_queue_bytes_ = std::min(
+        encoder_queue_bytes_,
+        target_rate_.bps() / 8.0 * kMaxEncoderQueueTime.seconds<double>());
+    next_frame_time_ += scenario_.frame_interval;
+  }
+  double pacing_bytes_per_step = pacing_rate_.bps() / 8.0 * step_seconds;
+  pacing_budget_bytes_ = std::min(
+      pacing_budget_bytes_ + pacing_bytes_per_step,
+      pacing_rate_.bps() / 8.0 * kMaxPacingBudgetTime.seconds<double>() +
+          pacing_bytes_per_step);
+  const double max_packet_bytes = scenario_.max_packet_size.bytes();
+  while (encoder_queue_bytes_ >= 1 && pacing_budget_bytes_ > 0) {
+    if (congestion_window_ && in_flight_bytes_ >= *congestion_window_)
+      break;
+    double packet_bytes = std::min(encoder_queue_bytes_, max_packet_bytes);
+    SendPacket(DataSize::bytes(static_cast<int64_t>(packet_bytes)),
+               PacedPacketInfo());
+    encoder_queue_bytes_ -= packet_bytes;
+    pacing_budget_bytes_ -= packet_bytes;
+  }
+}
+
+void ControllerSimulation::SendProbes() {
+  ProbeCluster& cluster = probe_clusters_.front();
+  cluster.budget_bytes +=
+      cluster.rate.bps() / 8.0 * scenario_.time_step.seconds<double>();
+  const int64_t max_packet_bytes = scenario_.max_packet_size.bytes();
+  while (cluster.budget_bytes >= max_packet_bytes) {
+    SendPacket(scenario_.max_packet_size,
+               PacedPacketInfo(cluster.id, cluster.min_probes,
+                               static_cast<int>(cluster.min_bytes)));
+    cluster.budget_bytes -= max_packet_bytes;
+    cluster.sent_bytes += max_packet_bytes;
+    ++cluster.sent_probes;
+    if (cluster.sent_probes >= cluster.min_probes &&
+        cluster.sent_bytes >= cluster.min_bytes) {
+      probe_clusters_.pop_front();
+      return;
+    }
+  }
+}
+
+void ControllerSimulation::SendPadding() {
+  padding_budget_bytes_ +=
+      padding_rate_.bps() / 8.0 * scenario_.time_step.seconds<double>();
+  // Padding is only sent when there's no media to send.
+  if (encoder_queue_bytes_ >= 1) {
+    padding_budget_bytes_ = 0;
+    return;
+  }
+  const int64_t max_packet_bytes = scenario_.max_packet_size.bytes();
+  while (padding_budget_bytes_ >= max_packet_bytes) {
+    if (congestion_window_ && in_flight_bytes_ >= *congestion_window_)
+      break;
+    SendPacket(scenario_.max_packet_size, PacedPacketInfo());
+    padding_budget_bytes_ -= max_packet_bytes;
+  }
+}
+
+void ControllerSimulation::SendPacket(DataSize size,
+                                      const PacedPacketInfo& pacing_info) {
+  SentPacket packet;
+  packet.send_time = now_;
+  packet.size = size;
+  packet.pacing_info = pacing_info;
+  packet.sequence_number = next_sequence_number_++;
+  in_flight_bytes_ += size;
+  packet.data_in_flight = in_flight_bytes_;
+  in_flight_.emplace(packet.sequence_number, packet);
+  ++metrics_.packets_sent;
+  metrics_.bytes_sent += size;
+  // A packet that doesn't fit in the queue is simply never received.
+  network_.EnqueuePacket(PacketInFlightInfo(
+      size.bytes(), now_.us(), static_cast<uint64_t>(packet.sequence_number)));
+  Update(controller_->OnSentPacket(packet));
+}
+
+void ControllerSimulation::ReceivePackets(TimeDelta return_delay) {
+  for (const PacketDeliveryInfo& delivery :
+       network_.DequeueDeliverablePackets(now_.us())) {
+    int64_t sequence_number = static_cast<int64_t>(delivery.packet_id);
+    auto it = in_flight_.find(sequence_number);
+    RTC_DCHECK(it != in_flight_.end());
+    Timestamp receive_time = Timestamp::us(delivery.receive_time_us);
+    delays_us_.push_back((receive_time - it->second.send_time).us());
+    metrics_.bytes_received += it->second.size;
+    ++packets_received_since_report_;
+
+    if (sequence_number > highest_received_sequence_number_) {
+      // Gaps before this packet are losses, as the link doesn't reorder.
+      int64_t lost = sequence_number - highest_received_sequence_number_ - 1;
+      packets_lost_since_report_ += lost;
+      metrics_.packets_lost += lost;
+      highest_received_sequence_number_ = sequence_number;
+    }
+    pending_feedback_.receive_times.emplace(sequence_number, receive_time);
+    pending_feedback_.last_sequence_number = highest_received_sequence_number_;
+  }
+}
+
+void ControllerSimulation::HandleFeedback(const ReceiverFeedback& feedback) {
+  TransportPacketsFeedback msg;
+  msg.feedback_time = now_;
+  msg.prior_in_flight = in_flight_bytes_;
+  Timestamp last_send_time = Timestamp::Infinity();
+  while (!in_flight_.empty() &&
+         in_flight_.begin()->first <= feedback.last_sequence_number) {
+    const SentPacket& sent = in_flight_.begin()->second;
+    PacketResult result;
+    result.sent_packet = sent;
+    auto it = feedback.receive_times.find(sent.sequence_number);
+    if (it != feedback.receive_times.end()) {
+      result.receive_time = it->second;
+      last_send_time = sent.send_time;
+    }
+    msg.packet_feedbacks.push_back(result);
+    in_flight_bytes_ -= sent.size;
+    in_flight_.erase(in_flight_.begin());
+  }
+  msg.data_in_flight = in_flight_bytes_;
+  if (last_send_time.IsFinite()) {
+    last_rtt_ = now_ - last_send_time;
+    smoothed_rtt_ = smoothed_rtt_.IsInfinite()
+                        ? last_rtt_
+                        : (1 - kRttSmoothingGain) * smoothed_rtt_ +
+                              kRttSmoothingGain * last_rtt_;
+  }
+  if (!msg.packet_feedbacks.empty())
+    Update(controller_->OnTransportPacketsFeedback(msg));
+}
+
+struct SimulationQueue {
+  NetworkControllerFactoryCreator create_factory;
+  const std::vector<ControllerSimulationScenario>* scenarios;
+  std::vector<ControllerSimulationMetrics>* metrics;
+  volatile int next_index;
+};
+
+void RunSimulationsFromQueue(void* obj) {
+  SimulationQueue* queue = static_cast<SimulationQueue*>(obj);
+  std::unique_ptr<NetworkControllerFactoryInterface> factory =
+      queue->create_factory();
+  const int num_scenarios = static_cast<int>(queue->scenarios->size());
+  for (int index = rtc::AtomicOps::Increment(&queue->next_index) - 1;
+       index < num_scenarios;
+       index = rtc::AtomicOps::Increment(&queue->next_index) - 1) {
+    (*queue->metrics)[index] =
+        RunControllerSimulation(factory.get(), (*queue->scenarios)[index]);
+  }
+}
+}  // namespace
+
+bool ParseNetworkTrace(const std::string& text,
+                       std::vector<NetworkTraceStep>* trace) {
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#')
+      continue;
+    std::istringstream values(line);
+    int64_t duration_ms;
+    NetworkTraceStep step;
+    if (!(values >> duration_ms >> step.config.link_capacity_kbps >>
+          step.config.queue_delay_ms)) {
+      return false;
+    }
+    values >> step.config.loss_percent;
+    values >> step.config.queue_length_packets;
+    values >> step.config.delay_standard_deviation_ms;
+    if ((values.fail() && !values.eof()) || duration_ms < 0 ||
+        step.config.link_capacity_kbps < 0 || step.config.queue_delay_ms < 0) {
+      return false;
+    }
+    step.duration = TimeDelta::ms(duration_ms);
+    trace->push_back(step);
+  }
+  return true;
+}
+
+ControllerSimulationScenario::ControllerSimulationScenario() = default;
+ControllerSimulationScenario::ControllerSimulationScenario(
+    const ControllerSimulationScenario&) = default;
+ControllerSimulationScenario::~ControllerSimulationScenario() = default;
+
+ControllerSimulationMetrics RunControllerSimulation(
+    NetworkControllerFactoryInterface* factory,
+    const ControllerSimulationScenario& scenario) {
+  return ControllerSimulation(factory, scenario).Run();
+}
+
+std::vector<ControllerSimulationMetrics> RunControllerSimulations(
+    NetworkControllerFactoryCreator create_factory,
+    const std::vector<ControllerSimulationScenario>& scenarios,
+    int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  std::vector<ControllerSimulationMetrics> metrics(scenarios.size());
+  SimulationQueue queue;
+  queue.create_factory = std::move(create_factory);
+  queue.scenarios = &scenarios;
+  queue.metrics = &metrics;
+  queue.next_index = 0;
+  num_threads = std::min(num_threads, static_cast<int>(scenarios.size()));
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(absl::make_unique<rtc::PlatformThread>(
+        &RunSimulationsFromQueue, &queue, "ControllerSim"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+  return metrics;
+}
+
+void WriteMetricsAsJson(
+    FILE* out,
+    const std::vector<ControllerSimulationMetrics>& metrics) {
+  for (const ControllerSimulationMetrics& m : metrics) {
+    std::string name;
+    for (char c : m.scenario_name) {
+      if (c == '"' || c == '\\')
+        name += '\\';
+      name += c;
+    }
+    fprintf(out,
+            "{\"scenario\":\"%s\",\"duration_s\":%.3f,"
+            "\"packets_sent\":%lld,\"packets_lost\":%lld,"
+            "\"bytes_sent\":%lld,\"bytes_received\":%lld,"
+            "\"average_target_rate_kbps\":%.1f,"
+            "\"average_throughput_kbps\":%.1f,"
+            "\"link_utilization\":%.4f,\"loss_ratio\":%.4f,"
+            "\"mean_delay_ms\":%.1f,\"p95_delay_ms\":%.1f,"
+            "\"max_delay_ms\":%.1f}\n",
+            name.c_str(), m.duration.seconds<double>(),
+            static_cast<long long>(m.packets_sent),
+            static_cast<long long>(m.packets_lost),
+            static_cast<long long>(m.bytes_sent.bytes()),
+            static_cast<long long>(m.bytes_received.bytes()),
+            m.average_target_rate.bps() / 1000.0,
+            m.average_throughput.bps() / 1000.0, m.link_utilization,
+            m.loss_ratio, m.mean_delay.us() / 1000.0,
+            m.p95_delay.us() / 1000.0, m.max_delay.us() / 1000.0);
+  }
+  fflush(out);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_CONGESTION_CONTROLLER_TEST_CONTROLLER_SIMULATION_H_
+#define MODULES_CONGESTION_CONTROLLER_TEST_CONTROLLER_SIMULATION_H_
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/network_control.h"
+#include "call/simulated_network.h"
+
+namespace webrtc {
+namespace test {
+
+// The link keeps |config| for |duration|, then moves on to the next step. The
+// queue delay of the config is used as the propagation delay of both
+// directions.
+struct NetworkTraceStep {
+  TimeDelta duration = TimeDelta::Zero();
+  SimulatedNetwork::Config config;
+};
+
+// Parses a network trace with one step per line:
+//   <duration_ms> <capacity_kbps> <delay_ms> [<loss_percent> [<queue_packets>
+//   [<delay_deviation_ms>]]]
+// Empty lines and lines starting with '#' are ignored. Returns false if a line
+// can't be parsed.
+bool ParseNetworkTrace(const std::string& text,
+                       std::vector<NetworkTraceStep>* trace);
+
+struct ControllerSimulationScenario {
+  ControllerSimulationScenario();
+  ControllerSimulationScenario(const ControllerSimulationScenario&);
+  ~ControllerSimulationScenario();
+
+  std::string name;
+  std::vector<NetworkTraceStep> trace;
+  DataRate start_rate = DataRate::kbps(300);
+  DataRate min_rate = DataRate::kbps(30);
+  DataRate max_rate = DataRate::kbps(5000);
+  DataSize max_packet_size = DataSize::bytes(1200);
+  // The encoder produces a frame of the target rate this often.
+  TimeDelta frame_interval = TimeDelta::ms(33);
+  // How often the receiver sends transport feedback.
+  TimeDelta feedback_interval = TimeDelta::ms(50);
+  // How often the receiver sends RTCP receiver reports.
+  TimeDelta report_interval = TimeDelta::seconds(1);
+  // The step of the simulated clock.
+  TimeDelta time_step = TimeDelta::ms(1);
+  uint64_t random_seed = 1;
+};
+
+struct ControllerSimulationMetrics {
+  std::string scenario_name;
+  TimeDelta duration = TimeDelta::Zero();
+  int64_t packets_sent = 0;
+  int64_t packets_lost = 0;
+  DataSize bytes_sent = DataSize::Zero();
+  DataSize bytes_received = DataSize::Zero();
+  // Time averages over the whole scenario.
+  DataRate average_target_rate = DataRate::Zero();
+  DataRate average_throughput = DataRate::Zero();
+  // Received data relative to what the link could have carried.
+  double link_utilization = 0;
+  // One way delay of the received packets, including propagation.
+  TimeDelta mean_delay = TimeDelta::Zero();
+  TimeDelta p95_delay = TimeDelta::Zero();
+  TimeDelta max_delay = TimeDelta::Zero();
+  double loss_ratio = 0;
+};
+
+// Runs |scenario| in simulated time against a controller created by
+// |factory|. The sender produces media at the target rate and paces it out at
+// the pacing rate, honoring the congestion window and probe clusters.
+ControllerSimulationMetrics RunControllerSimulation(
+    NetworkControllerFactoryInterface* factory,
+    const ControllerSimulationScenario& scenario);
+
+using NetworkControllerFactoryCreator =
+    std::function<std::unique_ptr<NetworkControllerFactoryInterface>()>;
+
+// Runs the scenarios on |num_threads| threads, each with its own factory from
+// |create_factory|. The factory and the controllers it creates must not share
+// state with those of other threads. The metrics are returned in the order of
+// |scenarios|.
+std::vector<ControllerSimulationMetrics> RunControllerSimulations(
+    NetworkControllerFactoryCreator create_factory,
+    const std::vector<ControllerSimulationScenario>& scenarios,
+    int num_threads);
+
+// Writes one JSON object per scenario and line.
+void WriteMetricsAsJson(
+    FILE* out,
+    const std::vector<ControllerSimulationMetrics>& metrics);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_TEST_CONTROLLER_SIMULATION_H_
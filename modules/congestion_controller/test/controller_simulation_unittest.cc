@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/congestion_controller/test/controller_simulation.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "logging/rtc_event_log/rtc_event_log.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/goog_cc/include/goog_cc_factory.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+class GoogCcTestFactory : public NetworkControllerFactoryInterface {
+ public:
+  GoogCcTestFactory() : factory_(&event_log_) {}
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override {
+    return factory_.Create(config);
+  }
+  TimeDelta GetProcessInterval() const override {
+    return factory_.GetProcessInterval();
+  }
+
+ private:
+  RtcEventLogNullImpl event_log_;
+  GoogCcNetworkControllerFactory factory_;
+};
+
+ControllerSimulationScenario ConstantLinkScenario(int capacity_kbps,
+                                                  int delay_ms,
+                                                  int loss_percent = 0) {
+  ControllerSimulationScenario scenario;
+  scenario.name = "constant_" + std::to_string(capacity_kbps);
+  NetworkTraceStep step;
+  step.duration = TimeDelta::seconds(30);
+  step.config.link_capacity_kbps = capacity_kbps;
+  step.config.queue_delay_ms = delay_ms;
+  step.config.loss_percent = loss_percent;
+  scenario.trace.push_back(step);
+  return scenario;
+}
+}  // namespace
+
+TEST(ControllerSimulationTest, ParsesNetworkTrace) {
+  std::vector<NetworkTraceStep> trace;
+  EXPECT_TRUE(ParseNetworkTrace(
+      "# duration capacity delay loss queue\n"
+      "1000 500 20\n"
+      "\n"
+      "2000 300 50 5 10\n",
+      &trace));
+  ASSERT_EQ(2u, trace.size());
+  EXPECT_EQ(TimeDelta::ms(1000), trace[0].duration);
+  EXPECT_EQ(500, trace[0].config.link_capacity_kbps);
+  EXPECT_EQ(20, trace[0].config.queue_delay_ms);
+  EXPECT_EQ(0, trace[0].config.loss_percent);
+  EXPECT_EQ(TimeDelta::ms(2000), trace[1].duration);
+  EXPECT_EQ(5, trace[1].config.loss_percent);
+  EXPECT_EQ(10u, trace[1].config.queue_length_packets);
+
+  EXPECT_FALSE(ParseNetworkTrace("1000 500\n", &trace));
+  EXPECT_FALSE(ParseNetworkTrace("1000 500 20 x\n", &trace));
+}
+
+TEST(ControllerSimulationTest, GoogCcUsesConstantLink) {
+  GoogCcTestFactory factory;
+  ControllerSimulationMetrics metrics =
+      RunControllerSimulation(&factory, ConstantLinkScenario(1000, 50));
+  EXPECT_EQ(TimeDelta::seconds(30), metrics.duration);
+  EXPECT_GT(metrics.link_utilization, 0.6);
+  EXPECT_LE(metrics.link_utilization, 1.0);
+  EXPECT_EQ(0, metrics.packets_lost);
+  EXPECT_GE(metrics.mean_delay, TimeDelta::ms(50));
+  EXPECT_LT(metrics.p95_delay, TimeDelta::ms(500));
+}
+
+TEST(ControllerSimulationTest, ReportsLoss) {
+  BbrNetworkControllerFactory factory;
+  ControllerSimulationMetrics metrics =
+      RunControllerSimulation(&factory, ConstantLinkScenario(1000, 50, 10));
+  EXPECT_GT(metrics.loss_ratio, 0.05);
+  EXPECT_LT(metrics.loss_ratio, 0.15);
+}
+
+TEST(ControllerSimulationTest, ParallelRunsMatchSequentialRuns) {
+  std::vector<ControllerSimulationScenario> scenarios;
+  for (int capacity_kbps : {300, 800, 1500, 3000})
+    scenarios.push_back(ConstantLinkScenario(capacity_kbps, 25));
+
+  std::vector<ControllerSimulationMetrics> parallel_metrics =
+      RunControllerSimulations(
+          [] { return absl::make_unique<BbrNetworkControllerFactory>(); },
+          scenarios, 3);
+  ASSERT_EQ(scenarios.size(), parallel_metrics.size());
+  for (size_t i = 0; i < scenarios.size(); ++i) {
+    BbrNetworkControllerFactory factory;
+    ControllerSimulationMetrics metrics =
+        RunControllerSimulation(&factory, scenarios[i]);
+    EXPECT_EQ(scenarios[i].name, parallel_metrics[i].scenario_name);
+    EXPECT_EQ(metrics.packets_sent, parallel_metrics[i].packets_sent);
+    EXPECT_EQ(metrics.bytes_received, parallel_metrics[i].bytes_received);
+    EXPECT_EQ(metrics.max_delay, parallel_metrics[i].max_delay);
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Runs network controllers against network traces in simulated time, many
+// scenarios in parallel, and prints the resulting metrics as JSON lines.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "logging/rtc_event_log/rtc_event_log.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/goog_cc/include/goog_cc_factory.h"
+#include "modules/congestion_controller/l4s/l4s_factory.h"
+#include "modules/congestion_controller/test/controller_simulation.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/stringencode.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "test/field_trial.h"
+
+DEFINE_string(controller,
+              "goog_cc",
+              "The controller to simulate: goog_cc, goog_cc_feedback, bbr or "
+              "l4s.");
+DEFINE_string(traces,
+              "",
+              "Comma separated network trace files, one scenario each. Each "
+              "line of a trace is '<duration_ms> <capacity_kbps> <delay_ms> "
+              "[<loss_percent> [<queue_packets> [<delay_deviation_ms>]]]'. "
+              "Without traces a built-in set of scenarios is run.");
+DEFINE_int(threads, 0, "Number of threads, 0 for one per core.");
+DEFINE_int(start_rate_kbps, 300, "Start rate of the controller.");
+DEFINE_int(max_rate_kbps, 5000, "Max rate of the controller.");
+DEFINE_string(output, "", "Output file, stdout if empty.");
+DEFINE_string(
+    force_fieldtrials,
+    "",
+    "Field trials control experimental feature code which can be forced. "
+    "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
+    " will assign the group Enable to field trial WebRTC-FooFeature.");
+DEFINE_bool(help, false, "Prints this message.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// GoogCC logs to the event log unconditionally, so each simulation thread
+// gets a factory with its own null event log.
+template <typename Factory>
+class EventLogOwningFactory : public NetworkControllerFactoryInterface {
+ public:
+  EventLogOwningFactory() : factory_(&event_log_) {}
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override {
+    return factory_.Create(config);
+  }
+  TimeDelta GetProcessInterval() const override {
+    return factory_.GetProcessInterval();
+  }
+
+ private:
+  RtcEventLogNullImpl event_log_;
+  Factory factory_;
+};
+
+NetworkControllerFactoryCreator GetFactoryCreator(
+    const std::string& controller) {
+  if (controller == "goog_cc") {
+    return [] {
+      return absl::make_unique<
+          EventLogOwningFactory<GoogCcNetworkControllerFactory>>();
+    };
+  }
+  if (controller == "goog_cc_feedback") {
+    return [] {
+      return absl::make_unique<
+          EventLogOwningFactory<GoogCcFeedbackNetworkControllerFactory>>();
+    };
+  }
+  if (controller == "bbr")
+    return [] { return absl::make_unique<BbrNetworkControllerFactory>(); };
+  if (controller == "l4s")
+    return [] { return absl::make_unique<L4sNetworkControllerFactory>(); };
+  return nullptr;
+}
+
+NetworkTraceStep Step(int duration_s,
+                      int capacity_kbps,
+                      int delay_ms,
+                      int loss_percent) {
+  NetworkTraceStep step;
+  step.duration = TimeDelta::seconds(duration_s);
+  step.config.link_capacity_kbps = capacity_kbps;
+  step.config.queue_delay_ms = delay_ms;
+  step.config.loss_percent = loss_percent;
+  return step;
+}
+
+std::vector<ControllerSimulationScenario> DefaultScenarios() {
+  std::vector<ControllerSimulationScenario> scenarios;
+  for (int capacity_kbps : {300, 1000, 2500}) {
+    for (int delay_ms : {25, 100}) {
+      for (int loss_percent : {0, 2}) {
+        ControllerSimulationScenario scenario;
+        std::ostringstream name;
+        name << "constant_" << capacity_kbps << "kbps_" << delay_ms << "ms_"
+             << loss_percent << "pct_loss";
+        scenario.name = name.str();
+        scenario.trace.push_back(
+            Step(60, capacity_kbps, delay_ms, loss_percent));
+        scenarios.push_back(scenario);
+      }
+    }
+  }
+  for (int delay_ms : {25, 100}) {
+    ControllerSimulationScenario scenario;
+    scenario.name =
+        "steps_2500_500_2500kbps_" + std::to_string(delay_ms) + "ms";
+    scenario.trace.push_back(Step(20, 2500, delay_ms, 0));
+    scenario.trace.push_back(Step(20, 500, delay_ms, 0));
+    scenario.trace.push_back(Step(20, 2500, delay_ms, 0));
+    scenarios.push_back(scenario);
+  }
+  return scenarios;
+}
+
+bool LoadScenarios(const std::string& trace_files,
+                   std::vector<ControllerSimulationScenario>* scenarios) {
+  std::vector<std::string> files;
+  rtc::split(trace_files, ',', &files);
+  for (const std::string& file : files) {
+    std::ifstream stream(file);
+    if (!stream) {
+      std::cerr << "Can't open " << file << std::endl;
+      return false;
+    }
+    std::stringstream text;
+    text << stream.rdbuf();
+    ControllerSimulationScenario scenario;
+    scenario.name = file;
+    if (!ParseNetworkTrace(text.str(), &scenario.trace)) {
+      std::cerr << "Can't parse " << file << std::endl;
+      return false;
+    }
+    scenarios->push_back(scenario);
+  }
+  return true;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::string usage =
+      "Simulates network controllers against network traces, faster than\n"
+      "real time, and prints throughput, delay and loss metrics as one JSON\n"
+      "object per scenario and line.\n"
+      "Usage: " +
+      std::string(argv[0]) + " [options]\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) || FLAG_help ||
+      argc != 1) {
+    printf("%s", usage.c_str());
+    if (FLAG_help) {
+      rtc::FlagList::Print(nullptr, false);
+      return 0;
+    }
+    return 1;
+  }
+  webrtc::test::ValidateFieldTrialsStringOrDie(FLAG_force_fieldtrials);
+  webrtc::test::ScopedFieldTrials field_trials(FLAG_force_fieldtrials);
+
+  webrtc::test::NetworkControllerFactoryCreator create_factory =
+      webrtc::test::GetFactoryCreator(FLAG_controller);
+  if (!create_factory) {
+    std::cerr << "Unknown controller " << FLAG_controller << std::endl;
+    return 1;
+  }
+  std::vector<webrtc::test::ControllerSimulationScenario> scenarios;
+  if (strlen(FLAG_traces) == 0) {
+    scenarios = webrtc::test::DefaultScenarios();
+  } else if (!webrtc::test::LoadScenarios(FLAG_traces, &scenarios)) {
+    return 1;
+  }
+  for (auto& scenario : scenarios) {
+    scenario.start_rate = webrtc::DataRate::kbps(FLAG_start_rate_kbps);
+    scenario.max_rate = webrtc::DataRate::kbps(FLAG_max_rate_kbps);
+  }
+
+  int num_threads = FLAG_threads > 0
+                        ? FLAG_threads
+                        : webrtc::CpuInfo::DetectNumberOfCores();
+  std::vector<webrtc::test::ControllerSimulationMetrics> metrics =
+      webrtc::test::RunControllerSimulations(create_factory, scenarios,
+                                             num_threads);
+
+  FILE* output = stdout;
+  if (strlen(FLAG_output) > 0) {
+    output = fopen(FLAG_output, "w");
+    if (!output) {
+      std::cerr << "Can't open " << FLAG_output << std::endl;
+      return 1;
+    }
+  }
+  webrtc::test::WriteMetricsAsJson(output, metrics);
+  if (output != stdout)
+    fclose(output);
+  return 0;
+}
@@ -114,6 +114,14 @@ class DesktopCaptureOptions {
   }
 #endif
 
+#if defined(WEBRTC_USE_PIPEWIRE)
+  // Allowing PipeWire makes the screen capturer use the ScreenCast
+  // xdg-desktop-portal in Wayland sessions, which asks the user which screen
+  // to share.
+  bool allow_pipewire() const { return allow_pipewire_; }
+  void set_allow_pipewire(bool allow) { allow_pipewire_ = allow; }
+#endif
+
  private:
 #if defined(USE_X11)
   rtc::scoped_refptr<SharedXDisplay> x_display_;
@@ -137,6 +145,9 @@ class DesktopCaptureOptions {
 #endif
   bool disable_effects_ = true;
   bool detect_updated_region_ = false;
+#if defined(WEBRTC_USE_PIPEWIRE)
+  bool allow_pipewire_ = false;
+#endif
 };
 
 }  // namespace webrtc
@@ -13,17 +13,27 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "modules/desktop_capture/desktop_geometry.h"
 #include "modules/desktop_capture/differ_block.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_info.h"
 
 namespace webrtc {
 
 namespace {
 
+const int kMaxDefaultThreads = 4;
+
+// Smallest area worth comparing on a thread of its own; smaller regions are
+// faster to compare than to hand over to a worker.
+const int kMinPixelsPerThread = 512 * 512;
+
 // Returns true if (0, 0) - (|width|, |height|) vector in |old_buffer| and
 // |new_buffer| are equal. |width| should be less than 32
 // (defined by kBlockSize), otherwise BlockDifference() should be used.
@@ -109,15 +119,11 @@ void CompareRow(const uint8_t* old_buffer,
 }
 
 // Compares |rect| area in |old_frame| and |new_frame|, and outputs dirty
-// regions into |output|.
-void CompareFrames(const DesktopFrame& old_frame,
-                   const DesktopFrame& new_frame,
-                   DesktopRect rect,
-                   DesktopRegion* const output) {
-  RTC_DCHECK(old_frame.size().equals(new_frame.size()));
-  RTC_DCHECK_EQ(old_frame.stride(), new_frame.stride());
-  rect.IntersectWith(DesktopRect::MakeSize(old_frame.size()));
-
+// regions into |output|. |rect| must be within the frames.
+void CompareRect(const DesktopFrame& old_frame,
+                 const DesktopFrame& new_frame,
+                 const DesktopRect& rect,
+                 DesktopRegion* const output) {
   const int y_block_count = (rect.height() - 1) / kBlockSize;
   const int last_y_block_height = rect.height() - y_block_count * kBlockSize;
   // Offset from the start of one block-row to the next.
@@ -145,7 +151,16 @@ void CompareFrames(const DesktopFrame& old_frame,
 
 DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
     std::unique_ptr<DesktopCapturer> base_capturer)
-    : base_capturer_(std::move(base_capturer)) {
+    : DesktopCapturerDifferWrapper(
+          std::move(base_capturer),
+          std::min(static_cast<int>(CpuInfo::DetectNumberOfCores()),
+                   kMaxDefaultThreads)) {}
+
+DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
+    std::unique_ptr<DesktopCapturer> base_capturer,
+    int max_threads)
+    : base_capturer_(std::move(base_capturer)),
+      max_threads_(std::max(max_threads, 1)) {
   RTC_DCHECK(base_capturer_);
 }
 
@@ -185,6 +200,58 @@ bool DesktopCapturerDifferWrapper::IsOccluded(const DesktopVector& pos) {
   return base_capturer_->IsOccluded(pos);
 }
 
+void DesktopCapturerDifferWrapper::CompareFrames(const DesktopFrame& old_frame,
+                                                 const DesktopFrame& new_frame,
+                                                 DesktopRect rect,
+                                                 DesktopRegion* output) {
+  RTC_DCHECK(old_frame.size().equals(new_frame.size()));
+  RTC_DCHECK_EQ(old_frame.stride(), new_frame.stride());
+  rect.IntersectWith(DesktopRect::MakeSize(old_frame.size()));
+  if (rect.is_empty())
+    return;
+
+  // Split |rect| into stripes of whole block-rows, so that every stripe
+  // compares the same blocks as a single pass over |rect| would.
+  const int block_rows = (rect.height() + kBlockSize - 1) / kBlockSize;
+  int num_stripes =
+      std::min({max_threads_, block_rows,
+                rect.width() * rect.height() / kMinPixelsPerThread});
+  if (num_stripes <= 1) {
+    CompareRect(old_frame, new_frame, rect, output);
+    return;
+  }
+  const int stripe_height =
+      (block_rows + num_stripes - 1) / num_stripes * kBlockSize;
+  num_stripes = (rect.height() + stripe_height - 1) / stripe_height;
+  auto stripe_rect = [&rect, stripe_height](int stripe) {
+    const int top = rect.top() + stripe * stripe_height;
+    return DesktopRect::MakeLTRB(rect.left(), top, rect.right(),
+                                 std::min(top + stripe_height, rect.bottom()));
+  };
+
+  while (static_cast<int>(workers_.size()) < max_threads_ - 1) {
+    workers_.push_back(absl::make_unique<rtc::TaskQueue>(
+        "DifferWorker", rtc::TaskQueue::Priority::HIGH));
+  }
+
+  // The last stripe is compared on this thread, the others on the workers.
+  std::vector<DesktopRegion> stripe_regions(num_stripes - 1);
+  std::atomic<int> pending_stripes(num_stripes - 1);
+  rtc::Event done(false, false);
+  for (int i = 0; i < num_stripes - 1; ++i) {
+    workers_[i]->PostTask([&, i] {
+      CompareRect(old_frame, new_frame, stripe_rect(i), &stripe_regions[i]);
+      if (--pending_stripes == 0)
+        done.Set();
+    });
+  }
+  CompareRect(old_frame, new_frame, stripe_rect(num_stripes - 1), output);
+  done.Wait(rtc::Event::kForever);
+
+  for (const DesktopRegion& region : stripe_regions)
+    output->AddRegion(region);
+}
+
 void DesktopCapturerDifferWrapper::OnCaptureResult(
     Result result,
     std::unique_ptr<DesktopFrame> input_frame) {
@@ -12,9 +12,13 @@
 #define MODULES_DESKTOP_CAPTURE_DESKTOP_CAPTURER_DIFFER_WRAPPER_H_
 
 #include <memory>
+#include <vector>
 
 #include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
 #include "modules/desktop_capture/shared_desktop_frame.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -26,6 +30,9 @@ namespace webrtc {
 //
 // This class marks entire frame as updated if the frame size or frame stride
 // has been changed.
+//
+// Large updated regions are split into stripes of block-rows which are
+// compared in parallel on a few worker threads.
 class DesktopCapturerDifferWrapper : public DesktopCapturer,
                                      public DesktopCapturer::Callback {
  public:
@@ -34,6 +41,11 @@ class DesktopCapturerDifferWrapper : public DesktopCapturer,
   explicit DesktopCapturerDifferWrapper(
       std::unique_ptr<DesktopCapturer> base_capturer);
 
+  // Same as above, but compares frames on at most |max_threads| threads,
+  // including the capture thread. By default, one per CPU core, up to 4.
+  DesktopCapturerDifferWrapper(std::unique_ptr<DesktopCapturer> base_capturer,
+                               int max_threads);
+
   ~DesktopCapturerDifferWrapper() override;
 
   // DesktopCapturer interface.
@@ -52,9 +64,19 @@ class DesktopCapturerDifferWrapper : public DesktopCapturer,
   void OnCaptureResult(Result result,
                        std::unique_ptr<DesktopFrame> frame) override;
 
+  // Compares |rect| area in |old_frame| and |new_frame|, and outputs dirty
+  // regions into |output|.
+  void CompareFrames(const DesktopFrame& old_frame,
+                     const DesktopFrame& new_frame,
+                     DesktopRect rect,
+                     DesktopRegion* output);
+
   const std::unique_ptr<DesktopCapturer> base_capturer_;
+  const int max_threads_;
   DesktopCapturer::Callback* callback_;
   std::unique_ptr<SharedDesktopFrame> last_frame_;
+  // Created on the first compare large enough to be split.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> workers_;
 };
 
 }  // namespace webrtc
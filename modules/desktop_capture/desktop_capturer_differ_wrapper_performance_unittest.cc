@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "modules/desktop_capture/desktop_capturer_differ_wrapper.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kNumFrames = 30;
+
+// Captures copies of the same frame, without updated region hints, so that
+// the differ has to compare every pixel, and measures how long the differ
+// takes to pass each frame on.
+class StaticFrameCapturer : public DesktopCapturer {
+ public:
+  explicit StaticFrameCapturer(DesktopSize size) : frame_(size) {
+    uint8_t* data = frame_.data();
+    for (int i = 0; i < frame_.stride() * size.height(); ++i)
+      data[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  void Start(Callback* callback) override { callback_ = callback; }
+
+  void CaptureFrame() override {
+    std::unique_ptr<DesktopFrame> frame(BasicDesktopFrame::CopyOf(frame_));
+    frame->mutable_updated_region()->SetRect(
+        DesktopRect::MakeSize(frame->size()));
+    capture_done_time_nanos_ = rtc::TimeNanos();
+    callback_->OnCaptureResult(Result::SUCCESS, std::move(frame));
+  }
+
+  int64_t capture_done_time_nanos() const { return capture_done_time_nanos_; }
+
+ private:
+  BasicDesktopFrame frame_;
+  Callback* callback_ = nullptr;
+  int64_t capture_done_time_nanos_ = 0;
+};
+
+class DifferTimeCallback : public DesktopCapturer::Callback {
+ public:
+  explicit DifferTimeCallback(const StaticFrameCapturer* capturer)
+      : capturer_(capturer) {}
+
+  void OnCaptureResult(DesktopCapturer::Result result,
+                       std::unique_ptr<DesktopFrame> frame) override {
+    ASSERT_EQ(DesktopCapturer::Result::SUCCESS, result);
+    // The first frame is not compared.
+    if (++num_frames_ > 1)
+      total_nanos_ += rtc::TimeNanos() - capturer_->capture_done_time_nanos();
+  }
+
+  double AverageDifferTimeMs() const {
+    return static_cast<double>(total_nanos_) / (num_frames_ - 1) /
+           rtc::kNumNanosecsPerMillisec;
+  }
+
+ private:
+  const StaticFrameCapturer* const capturer_;
+  int num_frames_ = 0;
+  int64_t total_nanos_ = 0;
+};
+
+void RunDifferTest(const std::string& name, DesktopSize size, int threads) {
+  auto base_capturer = absl::make_unique<StaticFrameCapturer>(size);
+  DifferTimeCallback callback(base_capturer.get());
+  DesktopCapturerDifferWrapper capturer(std::move(base_capturer), threads);
+  capturer.Start(&callback);
+  for (int i = 0; i < kNumFrames + 1; ++i)
+    capturer.CaptureFrame();
+
+  webrtc::test::PrintResult("differ_time", "_" + name,
+                            std::to_string(threads) + "_threads",
+                            callback.AverageDifferTimeMs(), "ms", false);
+}
+
+}  // namespace
+
+TEST(DesktopCapturerDifferWrapperPerformanceTest, StaticFrame1080p) {
+  RunDifferTest("1080p", DesktopSize(1920, 1080), 1);
+  RunDifferTest("1080p", DesktopSize(1920, 1080), 4);
+}
+
+TEST(DesktopCapturerDifferWrapperPerformanceTest, StaticFrame4k) {
+  RunDifferTest("4k", DesktopSize(3840, 2160), 1);
+  RunDifferTest("4k", DesktopSize(3840, 2160), 4);
+}
+
+}  // namespace webrtc
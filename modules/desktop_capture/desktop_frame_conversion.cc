@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_conversion.h"
+
+#include "rtc_base/checks.h"
+#include "third_party/libyuv/include/libyuv/convert_from_argb.h"
+
+namespace webrtc {
+
+// DesktopFrame pixels are BGRA in memory, which libyuv calls ARGB.
+
+rtc::scoped_refptr<I420Buffer> ConvertDesktopFrameToI420(
+    const DesktopFrame& frame,
+    I420BufferPool* pool) {
+  RTC_DCHECK(pool);
+  const int width = frame.size().width();
+  const int height = frame.size().height();
+  rtc::scoped_refptr<I420Buffer> buffer = pool->CreateBuffer(width, height);
+  if (!buffer)
+    return nullptr;
+  if (libyuv::ARGBToI420(frame.data(), frame.stride(), buffer->MutableDataY(),
+                         buffer->StrideY(), buffer->MutableDataU(),
+                         buffer->StrideU(), buffer->MutableDataV(),
+                         buffer->StrideV(), width, height) != 0) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+bool ConvertDesktopFrameToNV12(const DesktopFrame& frame,
+                               uint8_t* dst_y,
+                               int dst_stride_y,
+                               uint8_t* dst_uv,
+                               int dst_stride_uv) {
+  return libyuv::ARGBToNV12(frame.data(), frame.stride(), dst_y, dst_stride_y,
+                            dst_uv, dst_stride_uv, frame.size().width(),
+                            frame.size().height()) == 0;
+}
+
+}  // namespace webrtc
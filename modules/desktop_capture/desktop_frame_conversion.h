@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_CONVERSION_H_
+#define MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_CONVERSION_H_
+
+#include <stdint.h>
+
+#include "api/video/i420_buffer.h"
+#include "common_video/include/i420_buffer_pool.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// Converts the pixels of |frame| to a buffer from |pool|. The pixels are read
+// in place, so a frame wrapped by WrapSharedFrame() is converted straight from
+// shared memory. Returns null if the pool has no free buffer.
+rtc::scoped_refptr<I420Buffer> ConvertDesktopFrameToI420(
+    const DesktopFrame& frame,
+    I420BufferPool* pool);
+
+// Converts the pixels of |frame| to NV12 in the caller's planes, e.g. the input
+// buffer of a hardware encoder. The planes must hold a frame of the size of
+// |frame|. Returns false on failure.
+bool ConvertDesktopFrameToNV12(const DesktopFrame& frame,
+                               uint8_t* dst_y,
+                               int dst_stride_y,
+                               uint8_t* dst_uv,
+                               int dst_stride_uv);
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_CONVERSION_H_
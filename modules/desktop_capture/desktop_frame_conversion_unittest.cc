@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_conversion.h"
+
+#include <string.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "modules/desktop_capture/cropped_desktop_frame.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kWidth = 6;
+const int kHeight = 4;
+
+// Returns a white frame, with black row padding that the conversion must
+// skip.
+std::unique_ptr<DesktopFrame> CreateWhiteFrame() {
+  auto frame = absl::make_unique<BasicDesktopFrame>(
+      DesktopSize(kWidth + 2, kHeight));
+  memset(frame->data(), 0, frame->stride() * kHeight);
+  for (int y = 0; y < kHeight; ++y) {
+    memset(frame->data() + y * frame->stride(), 0xff,
+           kWidth * DesktopFrame::kBytesPerPixel);
+  }
+  return CreateCroppedDesktopFrame(std::move(frame),
+                                   DesktopRect::MakeWH(kWidth, kHeight));
+}
+
+}  // namespace
+
+TEST(DesktopFrameConversionTest, ConvertsToI420) {
+  I420BufferPool pool;
+  rtc::scoped_refptr<I420Buffer> buffer =
+      ConvertDesktopFrameToI420(*CreateWhiteFrame(), &pool);
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(kWidth, buffer->width());
+  EXPECT_EQ(kHeight, buffer->height());
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x)
+      EXPECT_NEAR(235, buffer->DataY()[y * buffer->StrideY() + x], 1);
+  }
+  for (int y = 0; y < kHeight / 2; ++y) {
+    for (int x = 0; x < kWidth / 2; ++x) {
+      EXPECT_NEAR(128, buffer->DataU()[y * buffer->StrideU() + x], 1);
+      EXPECT_NEAR(128, buffer->DataV()[y * buffer->StrideV() + x], 1);
+    }
+  }
+}
+
+TEST(DesktopFrameConversionTest, ConvertsToNV12) {
+  std::vector<uint8_t> y_plane(kWidth * kHeight);
+  std::vector<uint8_t> uv_plane(kWidth * kHeight / 2);
+  ASSERT_TRUE(ConvertDesktopFrameToNV12(*CreateWhiteFrame(), y_plane.data(),
+                                        kWidth, uv_plane.data(), kWidth));
+  for (uint8_t y : y_plane)
+    EXPECT_NEAR(235, y, 1);
+  for (uint8_t uv : uv_plane)
+    EXPECT_NEAR(128, uv, 1);
+}
+
+}  // namespace webrtc
@@ -71,6 +71,17 @@ TEST(BlockDifferenceTestMid, BlockDifference) {
   }
 }
 
+TEST(BlockDifferenceTestPartialHeight, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+  const int stride = kBlockSize * kBytesPerPixel;
+  block2[(kBlockSize - 2) * stride] += 1;
+
+  EXPECT_FALSE(BlockDifference(block1, block2, kBlockSize - 2, stride));
+  EXPECT_TRUE(BlockDifference(block1, block2, kBlockSize - 1, stride));
+}
+
 TEST(BlockDifferenceTestFirst, BlockDifference) {
   uint8_t* block1;
   uint8_t* block2;
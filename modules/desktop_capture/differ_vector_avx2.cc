@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bitwise difference of the 128 bytes at |image1| and |image2|.
+inline __m256i Difference_W32(const uint8_t* image1, const uint8_t* image2) {
+  const __m256i* i1 = reinterpret_cast<const __m256i*>(image1);
+  const __m256i* i2 = reinterpret_cast<const __m256i*>(image2);
+  __m256i acc = _mm256_xor_si256(_mm256_loadu_si256(i1),
+                                 _mm256_loadu_si256(i2));
+  acc = _mm256_or_si256(acc, _mm256_xor_si256(_mm256_loadu_si256(i1 + 1),
+                                              _mm256_loadu_si256(i2 + 1)));
+  acc = _mm256_or_si256(acc, _mm256_xor_si256(_mm256_loadu_si256(i1 + 2),
+                                              _mm256_loadu_si256(i2 + 2)));
+  acc = _mm256_or_si256(acc, _mm256_xor_si256(_mm256_loadu_si256(i1 + 3),
+                                              _mm256_loadu_si256(i2 + 3)));
+  return acc;
+}
+
+}  // namespace
+
+extern bool VectorDifference_AVX2_W32(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  const __m256i diff = Difference_W32(image1, image2);
+  return !_mm256_testz_si256(diff, diff);
+}
+
+extern bool BlockDifference_AVX2_W32(const uint8_t* image1,
+                                     const uint8_t* image2,
+                                     int height,
+                                     int stride) {
+  // Compare two rows at a time, so that the loads of one row overlap with the
+  // test of the other.
+  int i = 0;
+  for (; i + 1 < height; i += 2) {
+    const __m256i diff =
+        _mm256_or_si256(Difference_W32(image1, image2),
+                        Difference_W32(image1 + stride, image2 + stride));
+    if (!_mm256_testz_si256(diff, diff))
+      return true;
+    image1 += 2 * stride;
+    image2 += 2 * stride;
+  }
+  return i < height && VectorDifference_AVX2_W32(image1, image2);
+}
+
+}  // namespace webrtc
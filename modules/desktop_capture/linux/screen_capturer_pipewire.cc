@@ -0,0 +1,661 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/linux/screen_capturer_pipewire.h"
+
+#include <gio/gunixfdlist.h>
+#include <linux/dma-buf.h>
+#include <spa/buffer/meta.h>
+#include <spa/param/props.h>
+#include <spa/pod/builder.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "modules/desktop_capture/desktop_frame.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+const char kDesktopBusName[] = "org.freedesktop.portal.Desktop";
+const char kDesktopObjectPath[] = "/org/freedesktop/portal/desktop";
+const char kDesktopRequestObjectPath[] =
+    "/org/freedesktop/portal/desktop/request";
+const char kSessionInterfaceName[] = "org.freedesktop.portal.Session";
+const char kRequestInterfaceName[] = "org.freedesktop.portal.Request";
+const char kScreenCastInterfaceName[] = "org.freedesktop.portal.ScreenCast";
+
+// Source types of the ScreenCast portal.
+const uint32_t kMonitorSourceType = 1;
+
+// The most damaged regions a buffer reports. The compositor reports the whole
+// frame as damaged when there are more.
+const int kMaxDamageRegions = 16;
+const int kMaxFramerate = 60;
+
+gboolean QuitLoop(gpointer loop) {
+  g_main_loop_quit(static_cast<GMainLoop*>(loop));
+  return G_SOURCE_REMOVE;
+}
+
+// Maps the memory of buffers which PipeWire hasn't mapped, and synchronizes
+// CPU access to DMA-BUF ones, for as long as it's in scope.
+class ScopedBufferData {
+ public:
+  explicit ScopedBufferData(const spa_data& data) : data_(data) {
+    if (data_.data) {
+      pixels_ = static_cast<uint8_t*>(data_.data);
+    } else if (data_.type == SPA_DATA_MemFd ||
+               data_.type == SPA_DATA_DmaBuf) {
+      map_size_ = data_.maxsize + data_.mapoffset;
+      void* map = mmap(nullptr, map_size_, PROT_READ, MAP_SHARED,
+                       static_cast<int>(data_.fd), 0);
+      if (map == MAP_FAILED) {
+        RTC_LOG(LS_ERROR) << "Failed to map PipeWire buffer: " << errno;
+        return;
+      }
+      map_ = static_cast<uint8_t*>(map);
+      pixels_ = map_ + data_.mapoffset;
+    }
+    if (pixels_ && data_.type == SPA_DATA_DmaBuf)
+      SyncDmaBuf(DMA_BUF_SYNC_START);
+  }
+
+  ~ScopedBufferData() {
+    if (pixels_ && data_.type == SPA_DATA_DmaBuf)
+      SyncDmaBuf(DMA_BUF_SYNC_END);
+    if (map_)
+      munmap(map_, map_size_);
+  }
+
+  // Null if the buffer couldn't be mapped.
+  const uint8_t* pixels() const { return pixels_; }
+
+ private:
+  void SyncDmaBuf(uint64_t start_or_end) {
+    struct dma_buf_sync sync = {};
+    sync.flags = start_or_end | DMA_BUF_SYNC_READ;
+    if (ioctl(static_cast<int>(data_.fd), DMA_BUF_IOCTL_SYNC, &sync) != 0)
+      RTC_LOG(LS_WARNING) << "Failed to synchronize DMA-BUF: " << errno;
+  }
+
+  const spa_data& data_;
+  uint8_t* map_ = nullptr;
+  size_t map_size_ = 0;
+  uint8_t* pixels_ = nullptr;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedBufferData);
+};
+
+}  // namespace
+
+// static
+std::unique_ptr<DesktopCapturer>
+ScreenCapturerPipeWire::CreateRawScreenCapturer(
+    const DesktopCaptureOptions& options) {
+  return std::unique_ptr<DesktopCapturer>(new ScreenCapturerPipeWire());
+}
+
+// static
+bool ScreenCapturerPipeWire::IsRunningUnderWayland() {
+  const char* session_type = getenv("XDG_SESSION_TYPE");
+  if (session_type && strcmp(session_type, "wayland") == 0)
+    return true;
+  return getenv("WAYLAND_DISPLAY") != nullptr;
+}
+
+ScreenCapturerPipeWire::ScreenCapturerPipeWire()
+    : portal_context_(g_main_context_new()),
+      portal_loop_(g_main_loop_new(portal_context_, FALSE)),
+      cancellable_(g_cancellable_new()) {}
+
+ScreenCapturerPipeWire::~ScreenCapturerPipeWire() {
+  if (portal_thread_) {
+    // Quits the loop from within it, so that the quit isn't lost if the loop
+    // isn't running yet.
+    g_cancellable_cancel(cancellable_);
+    GSource* quit_source = g_idle_source_new();
+    g_source_set_callback(quit_source, &QuitLoop, portal_loop_, nullptr);
+    g_source_attach(quit_source, portal_context_);
+    g_source_unref(quit_source);
+    portal_thread_->Stop();
+  }
+
+  if (pw_loop_)
+    pw_thread_loop_stop(pw_loop_);
+  if (pw_stream_)
+    pw_stream_destroy(pw_stream_);
+  if (pw_core_)
+    pw_core_disconnect(pw_core_);
+  if (pw_context_)
+    pw_context_destroy(pw_context_);
+  if (pw_loop_)
+    pw_thread_loop_destroy(pw_loop_);
+
+  if (connection_) {
+    if (response_signal_id_)
+      g_dbus_connection_signal_unsubscribe(connection_, response_signal_id_);
+    if (!session_handle_.empty()) {
+      g_dbus_connection_call(connection_, kDesktopBusName,
+                             session_handle_.c_str(), kSessionInterfaceName,
+                             "Close", nullptr, nullptr, G_DBUS_CALL_FLAGS_NONE,
+                             -1, nullptr, nullptr, nullptr);
+      g_dbus_connection_flush_sync(connection_, nullptr, nullptr);
+    }
+    g_object_unref(connection_);
+  }
+  g_object_unref(cancellable_);
+  g_main_loop_unref(portal_loop_);
+  g_main_context_unref(portal_context_);
+}
+
+void ScreenCapturerPipeWire::Start(Callback* callback) {
+  RTC_DCHECK(!callback_);
+  RTC_DCHECK(callback);
+  callback_ = callback;
+
+  portal_thread_.reset(
+      new rtc::PlatformThread(&ScreenCapturerPipeWire::PortalThreadRun, this,
+                              "ScreenCastPortal"));
+  portal_thread_->Start();
+}
+
+void ScreenCapturerPipeWire::CaptureFrame() {
+  DesktopRegion updated_region;
+  {
+    rtc::CritScope lock(&lock_);
+    if (state_ == State::kFailed) {
+      callback_->OnCaptureResult(Result::ERROR_PERMANENT, nullptr);
+      return;
+    }
+    if (!latest_frame_) {
+      callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
+      return;
+    }
+
+    queue_.MoveToNextFrame();
+    RTC_DCHECK(!queue_.current_frame() || !queue_.current_frame()->IsShared());
+    const DesktopSize size = latest_frame_->size();
+    if (!queue_.current_frame() ||
+        !queue_.current_frame()->size().equals(size)) {
+      queue_.ReplaceCurrentFrame(
+          SharedDesktopFrame::Wrap(std::unique_ptr<DesktopFrame>(
+              new BasicDesktopFrame(size))));
+      helper_.InvalidateScreen(size);
+      last_invalid_region_.Clear();
+    }
+    helper_.TakeInvalidRegion(&updated_region);
+
+    // The current frame of the queue misses the updates which went into the
+    // other one, on the previous capture, as well as the new ones.
+    DesktopRegion copy_region(updated_region);
+    copy_region.AddRegion(last_invalid_region_);
+    copy_region.IntersectWith(DesktopRect::MakeSize(size));
+    for (DesktopRegion::Iterator it(copy_region); !it.IsAtEnd();
+         it.Advance()) {
+      queue_.current_frame()->CopyPixelsFrom(
+          *latest_frame_, it.rect().top_left(), it.rect());
+    }
+  }
+  last_invalid_region_ = updated_region;
+
+  std::unique_ptr<DesktopFrame> result = queue_.current_frame()->Share();
+  result->mutable_updated_region()->Swap(&updated_region);
+  callback_->OnCaptureResult(Result::SUCCESS, std::move(result));
+}
+
+bool ScreenCapturerPipeWire::GetSourceList(SourceList* sources) {
+  RTC_DCHECK(sources->size() == 0);
+  // The screen is picked in the portal's dialog rather than by the caller.
+  sources->push_back({0});
+  return true;
+}
+
+bool ScreenCapturerPipeWire::SelectSource(SourceId id) {
+  return id == 0;
+}
+
+// static
+void ScreenCapturerPipeWire::PortalThreadRun(void* obj) {
+  ScreenCapturerPipeWire* capturer = static_cast<ScreenCapturerPipeWire*>(obj);
+  g_main_context_push_thread_default(capturer->portal_context_);
+  capturer->ConnectToPortal();
+  g_main_loop_run(capturer->portal_loop_);
+  g_main_context_pop_thread_default(capturer->portal_context_);
+}
+
+void ScreenCapturerPipeWire::ConnectToPortal() {
+  GError* error = nullptr;
+  connection_ = g_bus_get_sync(G_BUS_TYPE_SESSION, cancellable_, &error);
+  if (!connection_) {
+    RTC_LOG(LS_ERROR) << "Failed to connect to the session bus: "
+                      << error->message;
+    g_error_free(error);
+    Fail("connecting to the portal");
+    return;
+  }
+
+  // Requests are exported by the portal at paths derived from the unique
+  // name of the connection, ":1.42" being "1_42".
+  sender_name_ = g_dbus_connection_get_unique_name(connection_) + 1;
+  for (char& c : sender_name_) {
+    if (c == '.')
+      c = '_';
+  }
+
+  const std::string handle_token = NewHandleToken();
+  const std::string session_token = NewHandleToken();
+  GVariantBuilder options;
+  g_variant_builder_init(&options, G_VARIANT_TYPE_VARDICT);
+  g_variant_builder_add(&options, "{sv}", "handle_token",
+                        g_variant_new_string(handle_token.c_str()));
+  g_variant_builder_add(&options, "{sv}", "session_handle_token",
+                        g_variant_new_string(session_token.c_str()));
+  CallPortal("CreateSession", g_variant_new("(a{sv})", &options), handle_token,
+             &ScreenCapturerPipeWire::OnSessionCreated);
+}
+
+void ScreenCapturerPipeWire::CallPortal(const char* method,
+                                        GVariant* parameters,
+                                        const std::string& handle_token,
+                                        ResponseHandler on_response) {
+  // Subscribes before calling, since the request may respond before the call
+  // returns its path.
+  const std::string request_path =
+      std::string(kDesktopRequestObjectPath) + "/" + sender_name_ + "/" +
+      handle_token;
+  if (response_signal_id_)
+    g_dbus_connection_signal_unsubscribe(connection_, response_signal_id_);
+  pending_response_ = on_response;
+  response_signal_id_ = g_dbus_connection_signal_subscribe(
+      connection_, kDesktopBusName, kRequestInterfaceName, "Response",
+      request_path.c_str(), nullptr, G_DBUS_SIGNAL_FLAGS_NO_MATCH_RULE,
+      &ScreenCapturerPipeWire::OnPortalResponse, this, nullptr);
+
+  g_dbus_connection_call(
+      connection_, kDesktopBusName, kDesktopObjectPath,
+      kScreenCastInterfaceName, method, parameters, G_VARIANT_TYPE("(o)"),
+      G_DBUS_CALL_FLAGS_NONE, -1, cancellable_,
+      &ScreenCapturerPipeWire::OnPortalCallDone, this);
+}
+
+// static
+void ScreenCapturerPipeWire::OnPortalCallDone(GObject* object,
+                                              GAsyncResult* result,
+                                              gpointer user_data) {
+  GError* error = nullptr;
+  GVariant* variant =
+      g_dbus_connection_call_finish(G_DBUS_CONNECTION(object), result, &error);
+  if (!variant) {
+    if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+      RTC_LOG(LS_ERROR) << "ScreenCast portal call failed: " << error->message;
+      static_cast<ScreenCapturerPipeWire*>(user_data)->Fail("calling portal");
+    }
+    g_error_free(error);
+    return;
+  }
+  // The request's path is known already. The result comes with its response.
+  g_variant_unref(variant);
+}
+
+// static
+void ScreenCapturerPipeWire::OnPortalResponse(GDBusConnection* connection,
+                                              const char* sender_name,
+                                              const char* object_path,
+                                              const char* interface_name,
+                                              const char* signal_name,
+                                              GVariant* parameters,
+                                              gpointer user_data) {
+  ScreenCapturerPipeWire* capturer =
+      static_cast<ScreenCapturerPipeWire*>(user_data);
+  uint32_t response = 0;
+  GVariant* results = nullptr;
+  g_variant_get(parameters, "(u@a{sv})", &response, &results);
+
+  ResponseHandler handler = capturer->pending_response_;
+  g_dbus_connection_signal_unsubscribe(connection,
+                                       capturer->response_signal_id_);
+  capturer->response_signal_id_ = 0;
+  capturer->pending_response_ = nullptr;
+  if (handler)
+    (capturer->*handler)(response, results);
+  g_variant_unref(results);
+}
+
+void ScreenCapturerPipeWire::OnSessionCreated(uint32_t response,
+                                              GVariant* results) {
+  const char* session_handle = nullptr;
+  if (response != 0 ||
+      !g_variant_lookup(results, "session_handle", "&s", &session_handle)) {
+    Fail("creating the session");
+    return;
+  }
+  session_handle_ = session_handle;
+
+  const std::string handle_token = NewHandleToken();
+  GVariantBuilder options;
+  g_variant_builder_init(&options, G_VARIANT_TYPE_VARDICT);
+  g_variant_builder_add(&options, "{sv}", "types",
+                        g_variant_new_uint32(kMonitorSourceType));
+  g_variant_builder_add(&options, "{sv}", "multiple",
+                        g_variant_new_boolean(FALSE));
+  g_variant_builder_add(&options, "{sv}", "handle_token",
+                        g_variant_new_string(handle_token.c_str()));
+  CallPortal("SelectSources",
+             g_variant_new("(oa{sv})", session_handle_.c_str(), &options),
+             handle_token, &ScreenCapturerPipeWire::OnSourcesSelected);
+}
+
+void ScreenCapturerPipeWire::OnSourcesSelected(uint32_t response,
+                                               GVariant* results) {
+  if (response != 0) {
+    Fail("selecting the sources");
+    return;
+  }
+
+  const std::string handle_token = NewHandleToken();
+  GVariantBuilder options;
+  g_variant_builder_init(&options, G_VARIANT_TYPE_VARDICT);
+  g_variant_builder_add(&options, "{sv}", "handle_token",
+                        g_variant_new_string(handle_token.c_str()));
+  // There's no parent window to make the portal's dialog modal to.
+  CallPortal("Start",
+             g_variant_new("(osa{sv})", session_handle_.c_str(), "", &options),
+             handle_token, &ScreenCapturerPipeWire::OnStarted);
+}
+
+void ScreenCapturerPipeWire::OnStarted(uint32_t response, GVariant* results) {
+  // Nonzero if the user cancelled the dialog.
+  if (response != 0) {
+    Fail("starting the screen cast");
+    return;
+  }
+  GVariant* streams =
+      g_variant_lookup_value(results, "streams", G_VARIANT_TYPE_ARRAY);
+  if (!streams || g_variant_n_children(streams) == 0) {
+    if (streams)
+      g_variant_unref(streams);
+    Fail("starting the screen cast, without streams");
+    return;
+  }
+  GVariant* properties = nullptr;
+  g_variant_get_child(streams, 0, "(u@a{sv})", &pipewire_node_id_,
+                      &properties);
+  g_variant_unref(properties);
+  g_variant_unref(streams);
+
+  GVariantBuilder options;
+  g_variant_builder_init(&options, G_VARIANT_TYPE_VARDICT);
+  g_dbus_connection_call_with_unix_fd_list(
+      connection_, kDesktopBusName, kDesktopObjectPath,
+      kScreenCastInterfaceName, "OpenPipeWireRemote",
+      g_variant_new("(oa{sv})", session_handle_.c_str(), &options),
+      G_VARIANT_TYPE("(h)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, cancellable_,
+      &ScreenCapturerPipeWire::OnPipeWireRemoteOpened, this);
+}
+
+// static
+void ScreenCapturerPipeWire::OnPipeWireRemoteOpened(GObject* object,
+                                                    GAsyncResult* result,
+                                                    gpointer user_data) {
+  ScreenCapturerPipeWire* capturer =
+      static_cast<ScreenCapturerPipeWire*>(user_data);
+  GError* error = nullptr;
+  GUnixFDList* fd_list = nullptr;
+  GVariant* variant = g_dbus_connection_call_with_unix_fd_list_finish(
+      G_DBUS_CONNECTION(object), &fd_list, result, &error);
+  if (!variant) {
+    if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+      RTC_LOG(LS_ERROR) << "Failed to open PipeWire remote: "
+                        << error->message;
+      capturer->Fail("opening the PipeWire remote");
+    }
+    g_error_free(error);
+    return;
+  }
+
+  int32_t index = 0;
+  g_variant_get(variant, "(h)", &index);
+  g_variant_unref(variant);
+  const int fd = g_unix_fd_list_get(fd_list, index, &error);
+  g_object_unref(fd_list);
+  if (fd < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to get PipeWire remote fd: "
+                      << error->message;
+    g_error_free(error);
+    capturer->Fail("opening the PipeWire remote");
+    return;
+  }
+
+  if (!capturer->InitPipeWire(fd))
+    capturer->Fail("connecting to PipeWire");
+}
+
+std::string ScreenCapturerPipeWire::NewHandleToken() {
+  return "webrtc" + std::to_string(g_random_int_range(0, G_MAXINT)) + "_" +
+         std::to_string(++token_counter_);
+}
+
+void ScreenCapturerPipeWire::Fail(const char* what) {
+  RTC_LOG(LS_ERROR) << "PipeWire screen capture failed " << what << ".";
+  rtc::CritScope lock(&lock_);
+  state_ = State::kFailed;
+}
+
+bool ScreenCapturerPipeWire::InitPipeWire(int fd) {
+  pw_init(nullptr, nullptr);
+
+  pw_loop_ = pw_thread_loop_new("PipeWireCapture", nullptr);
+  pw_context_ =
+      pw_context_new(pw_thread_loop_get_loop(pw_loop_), nullptr, 0);
+  if (!pw_context_) {
+    close(fd);
+    return false;
+  }
+  if (pw_thread_loop_start(pw_loop_) < 0) {
+    close(fd);
+    return false;
+  }
+
+  pw_thread_loop_lock(pw_loop_);
+  // Takes ownership of |fd|.
+  pw_core_ = pw_context_connect_fd(pw_context_, fd, nullptr, 0);
+  if (!pw_core_) {
+    pw_thread_loop_unlock(pw_loop_);
+    return false;
+  }
+
+  pw_stream_ = pw_stream_new(
+      pw_core_, "webrtc-screen-capture",
+      pw_properties_new(PW_KEY_MEDIA_TYPE, "Video", PW_KEY_MEDIA_CATEGORY,
+                        "Capture", PW_KEY_MEDIA_ROLE, "Screen", nullptr));
+  if (!pw_stream_) {
+    pw_thread_loop_unlock(pw_loop_);
+    return false;
+  }
+  stream_events_.version = PW_VERSION_STREAM_EVENTS;
+  stream_events_.state_changed = &ScreenCapturerPipeWire::OnStreamStateChanged;
+  stream_events_.param_changed = &ScreenCapturerPipeWire::OnStreamParamChanged;
+  stream_events_.process = &ScreenCapturerPipeWire::OnStreamProcess;
+  pw_stream_add_listener(pw_stream_, &stream_listener_, &stream_events_, this);
+
+  uint8_t buffer[1024];
+  spa_pod_builder builder = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+  spa_rectangle default_size = SPA_RECTANGLE(1920, 1080);
+  spa_rectangle min_size = SPA_RECTANGLE(1, 1);
+  spa_rectangle max_size = SPA_RECTANGLE(8192, 8192);
+  spa_fraction any_framerate = SPA_FRACTION(0, 1);
+  spa_fraction default_framerate = SPA_FRACTION(kMaxFramerate, 1);
+  spa_fraction min_framerate = SPA_FRACTION(0, 1);
+  spa_fraction max_framerate = SPA_FRACTION(kMaxFramerate, 1);
+  // Only formats with the pixel layout of DesktopFrame, so that frames are
+  // copied without conversion.
+  const spa_pod* params[] = {
+      static_cast<const spa_pod*>(spa_pod_builder_add_object(
+          &builder, SPA_TYPE_OBJECT_Format, SPA_PARAM_EnumFormat,
+          SPA_FORMAT_mediaType, SPA_POD_Id(SPA_MEDIA_TYPE_video),
+          SPA_FORMAT_mediaSubtype, SPA_POD_Id(SPA_MEDIA_SUBTYPE_raw),
+          SPA_FORMAT_VIDEO_format,
+          SPA_POD_CHOICE_ENUM_Id(3, SPA_VIDEO_FORMAT_BGRx,
+                                 SPA_VIDEO_FORMAT_BGRx, SPA_VIDEO_FORMAT_BGRA),
+          SPA_FORMAT_VIDEO_size,
+          SPA_POD_CHOICE_RANGE_Rectangle(&default_size, &min_size, &max_size),
+          SPA_FORMAT_VIDEO_framerate, SPA_POD_Fraction(&any_framerate),
+          SPA_FORMAT_VIDEO_maxFramerate,
+          SPA_POD_CHOICE_RANGE_Fraction(&default_framerate, &min_framerate,
+                                        &max_framerate)))};
+
+  const int result = pw_stream_connect(
+      pw_stream_, PW_DIRECTION_INPUT, pipewire_node_id_,
+      static_cast<pw_stream_flags>(PW_STREAM_FLAG_AUTOCONNECT |
+                                   PW_STREAM_FLAG_MAP_BUFFERS),
+      params, 1);
+  pw_thread_loop_unlock(pw_loop_);
+  return result == 0;
+}
+
+// static
+void ScreenCapturerPipeWire::OnStreamStateChanged(void* data,
+                                                  pw_stream_state old_state,
+                                                  pw_stream_state state,
+                                                  const char* error_message) {
+  ScreenCapturerPipeWire* capturer = static_cast<ScreenCapturerPipeWire*>(data);
+  RTC_LOG(LS_INFO) << "PipeWire stream state changed from "
+                   << pw_stream_state_as_string(old_state) << " to "
+                   << pw_stream_state_as_string(state) << ".";
+  if (state == PW_STREAM_STATE_ERROR) {
+    RTC_LOG(LS_ERROR) << "PipeWire stream error: " << error_message;
+    capturer->Fail("streaming");
+  }
+}
+
+// static
+void ScreenCapturerPipeWire::OnStreamParamChanged(void* data,
+                                                  uint32_t id,
+                                                  const spa_pod* param) {
+  ScreenCapturerPipeWire* capturer = static_cast<ScreenCapturerPipeWire*>(data);
+  if (!param || id != SPA_PARAM_Format)
+    return;
+  if (spa_format_video_raw_parse(param, &capturer->video_format_) < 0) {
+    capturer->Fail("parsing the stream format");
+    return;
+  }
+
+  uint8_t buffer[1024];
+  spa_pod_builder builder = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+  // Memory the compositor renders to can be shared without copying with
+  // DMA-BUF, so that's accepted in addition to mappable memory.
+  const spa_pod* params[] = {
+      static_cast<const spa_pod*>(spa_pod_builder_add_object(
+          &builder, SPA_TYPE_OBJECT_ParamBuffers, SPA_PARAM_Buffers,
+          SPA_PARAM_BUFFERS_dataType,
+          SPA_POD_CHOICE_FLAGS_Int((1 << SPA_DATA_MemPtr) |
+                                   (1 << SPA_DATA_MemFd) |
+                                   (1 << SPA_DATA_DmaBuf)))),
+      static_cast<const spa_pod*>(spa_pod_builder_add_object(
+          &builder, SPA_TYPE_OBJECT_ParamMeta, SPA_PARAM_Meta,
+          SPA_PARAM_META_type, SPA_POD_Id(SPA_META_VideoDamage),
+          SPA_PARAM_META_size,
+          SPA_POD_CHOICE_RANGE_Int(
+              sizeof(spa_meta_region) * kMaxDamageRegions,
+              sizeof(spa_meta_region),
+              sizeof(spa_meta_region) * kMaxDamageRegions)))};
+  pw_stream_update_params(capturer->pw_stream_, params, 2);
+}
+
+// static
+void ScreenCapturerPipeWire::OnStreamProcess(void* data) {
+  ScreenCapturerPipeWire* capturer = static_cast<ScreenCapturerPipeWire*>(data);
+
+  // Only the newest of the queued buffers is copied, with the damage of all
+  // of them.
+  DesktopRegion damage;
+  pw_buffer* newest = nullptr;
+  while (pw_buffer* next = pw_stream_dequeue_buffer(capturer->pw_stream_)) {
+    capturer->AddBufferDamage(next->buffer, &damage);
+    if (newest)
+      pw_stream_queue_buffer(capturer->pw_stream_, newest);
+    newest = next;
+  }
+  if (!newest)
+    return;
+
+  capturer->HandleBuffer(newest->buffer, std::move(damage));
+  pw_stream_queue_buffer(capturer->pw_stream_, newest);
+}
+
+void ScreenCapturerPipeWire::AddBufferDamage(spa_buffer* buffer,
+                                             DesktopRegion* damage) const {
+  const DesktopRect frame_rect = DesktopRect::MakeWH(
+      video_format_.size.width, video_format_.size.height);
+  spa_meta* meta = spa_buffer_find_meta(buffer, SPA_META_VideoDamage);
+  if (!meta) {
+    damage->SetRect(frame_rect);
+    return;
+  }
+  spa_meta_region* region = nullptr;
+  spa_meta_for_each(region, meta) {
+    if (!spa_meta_region_is_valid(region))
+      break;
+    DesktopRect rect = DesktopRect::MakeXYWH(
+        region->region.position.x, region->region.position.y,
+        region->region.size.width, region->region.size.height);
+    rect.IntersectWith(frame_rect);
+    damage->AddRect(rect);
+  }
+}
+
+void ScreenCapturerPipeWire::HandleBuffer(spa_buffer* buffer,
+                                          DesktopRegion damage) {
+  if (buffer->n_datas == 0)
+    return;
+  const spa_data& data = buffer->datas[0];
+  if (!data.chunk || data.chunk->size == 0)
+    return;
+
+  const DesktopSize size(video_format_.size.width, video_format_.size.height);
+  const int stride = data.chunk->stride;
+  if (size.is_empty() ||
+      stride < size.width() * DesktopFrame::kBytesPerPixel ||
+      data.chunk->offset + static_cast<uint64_t>(stride) * size.height() >
+          data.maxsize) {
+    return;
+  }
+
+  ScopedBufferData mapped(data);
+  if (!mapped.pixels())
+    return;
+  const uint8_t* pixels = mapped.pixels() + data.chunk->offset;
+
+  rtc::CritScope lock(&lock_);
+  if (!latest_frame_ || !latest_frame_->size().equals(size)) {
+    latest_frame_.reset(new BasicDesktopFrame(size));
+    damage.SetRect(DesktopRect::MakeSize(size));
+    helper_.InvalidateScreen(size);
+  }
+  for (DesktopRegion::Iterator it(damage); !it.IsAtEnd(); it.Advance()) {
+    const DesktopRect& rect = it.rect();
+    latest_frame_->CopyPixelsFrom(
+        pixels + rect.top() * stride +
+            rect.left() * DesktopFrame::kBytesPerPixel,
+        stride, rect);
+  }
+  helper_.InvalidateRegion(damage);
+  state_ = State::kStreaming;
+}
+
+}  // namespace webrtc
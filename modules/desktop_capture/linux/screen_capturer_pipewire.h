@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_LINUX_SCREEN_CAPTURER_PIPEWIRE_H_
+#define MODULES_DESKTOP_CAPTURE_LINUX_SCREEN_CAPTURER_PIPEWIRE_H_
+
+#include <gio/gio.h>
+#define typeof __typeof__
+#include <pipewire/pipewire.h>
+#include <spa/param/video/format-utils.h>
+
+#include <memory>
+#include <string>
+
+#include "modules/desktop_capture/desktop_capture_options.h"
+#include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "modules/desktop_capture/screen_capture_frame_queue.h"
+#include "modules/desktop_capture/screen_capturer_helper.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Captures the screen through PipeWire, for Wayland sessions, where X11 can't
+// capture the output of other clients. The screen is picked by the user in the
+// dialog of the xdg-desktop-portal ScreenCast interface. That's negotiated on
+// a thread of its own, so CaptureFrame() fails with ERROR_TEMPORARY until the
+// stream runs, and with ERROR_PERMANENT if the portal request fails or is
+// denied.
+//
+// Frames arrive on the PipeWire thread in shared memory or DMA-BUF buffers.
+// Only the regions the compositor reports as damaged are copied out of them,
+// and they're reported as the updated region of the captured frames.
+class ScreenCapturerPipeWire : public DesktopCapturer {
+ public:
+  static std::unique_ptr<DesktopCapturer> CreateRawScreenCapturer(
+      const DesktopCaptureOptions& options);
+  static bool IsRunningUnderWayland();
+
+  ScreenCapturerPipeWire();
+  ~ScreenCapturerPipeWire() override;
+
+  // DesktopCapturer interface.
+  void Start(Callback* delegate) override;
+  void CaptureFrame() override;
+  bool GetSourceList(SourceList* sources) override;
+  bool SelectSource(SourceId id) override;
+
+ private:
+  enum class State { kNegotiating, kStreaming, kFailed };
+
+  using ResponseHandler = void (ScreenCapturerPipeWire::*)(uint32_t response,
+                                                           GVariant* results);
+
+  // Portal negotiation, on |portal_thread_|.
+  static void PortalThreadRun(void* obj);
+  void ConnectToPortal();
+  // Calls |method| of the ScreenCast portal, and |on_response| when the
+  // request it creates responds. |handle_token| must be the one passed in
+  // the options of |parameters|.
+  void CallPortal(const char* method,
+                  GVariant* parameters,
+                  const std::string& handle_token,
+                  ResponseHandler on_response);
+  static void OnPortalCallDone(GObject* object,
+                               GAsyncResult* result,
+                               gpointer user_data);
+  static void OnPortalResponse(GDBusConnection* connection,
+                               const char* sender_name,
+                               const char* object_path,
+                               const char* interface_name,
+                               const char* signal_name,
+                               GVariant* parameters,
+                               gpointer user_data);
+  void OnSessionCreated(uint32_t response, GVariant* results);
+  void OnSourcesSelected(uint32_t response, GVariant* results);
+  void OnStarted(uint32_t response, GVariant* results);
+  static void OnPipeWireRemoteOpened(GObject* object,
+                                     GAsyncResult* result,
+                                     gpointer user_data);
+  std::string NewHandleToken();
+  void Fail(const char* what);
+
+  // PipeWire stream, on the PipeWire thread.
+  bool InitPipeWire(int fd);
+  static void OnStreamStateChanged(void* data,
+                                   pw_stream_state old_state,
+                                   pw_stream_state state,
+                                   const char* error_message);
+  static void OnStreamParamChanged(void* data,
+                                   uint32_t id,
+                                   const spa_pod* param);
+  static void OnStreamProcess(void* data);
+  void AddBufferDamage(spa_buffer* buffer, DesktopRegion* damage) const;
+  void HandleBuffer(spa_buffer* buffer, DesktopRegion damage);
+
+  Callback* callback_ = nullptr;
+
+  // Portal state, used on |portal_thread_| only.
+  GMainContext* portal_context_ = nullptr;
+  GMainLoop* portal_loop_ = nullptr;
+  GCancellable* cancellable_ = nullptr;
+  GDBusConnection* connection_ = nullptr;
+  std::string sender_name_;
+  std::string session_handle_;
+  guint response_signal_id_ = 0;
+  ResponseHandler pending_response_ = nullptr;
+  uint32_t pipewire_node_id_ = 0;
+  int token_counter_ = 0;
+  std::unique_ptr<rtc::PlatformThread> portal_thread_;
+
+  // PipeWire objects. |pw_stream_| and |video_format_| are used on the
+  // PipeWire thread only, after the stream is connected.
+  pw_thread_loop* pw_loop_ = nullptr;
+  pw_context* pw_context_ = nullptr;
+  pw_core* pw_core_ = nullptr;
+  pw_stream* pw_stream_ = nullptr;
+  spa_hook stream_listener_;
+  pw_stream_events stream_events_ = {};
+  spa_video_info_raw video_format_ = {};
+
+  rtc::CriticalSection lock_;
+  State state_ RTC_GUARDED_BY(lock_) = State::kNegotiating;
+  // The newest frame received from PipeWire, and the regions of it that
+  // changed since the last CaptureFrame().
+  std::unique_ptr<DesktopFrame> latest_frame_ RTC_GUARDED_BY(lock_);
+  ScreenCapturerHelper helper_ RTC_GUARDED_BY(lock_);
+
+  // Used on the capture thread only.
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue_;
+  // Updated region of the previous capture, which the current frame of
+  // |queue_| hasn't received yet.
+  DesktopRegion last_invalid_region_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScreenCapturerPipeWire);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_LINUX_SCREEN_CAPTURER_PIPEWIRE_H_
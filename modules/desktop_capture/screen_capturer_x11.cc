@@ -26,6 +26,9 @@
 #include "modules/desktop_capture/screen_capturer_helper.h"
 #include "modules/desktop_capture/shared_desktop_frame.h"
 #include "modules/desktop_capture/x11/x_server_pixel_buffer.h"
+#if defined(WEBRTC_USE_PIPEWIRE)
+#include "modules/desktop_capture/linux/screen_capturer_pipewire.h"
+#endif
 #include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/logging.h"
@@ -411,6 +414,13 @@ void ScreenCapturerLinux::DeinitXlib() {
 // static
 std::unique_ptr<DesktopCapturer> DesktopCapturer::CreateRawScreenCapturer(
     const DesktopCaptureOptions& options) {
+#if defined(WEBRTC_USE_PIPEWIRE)
+  if (options.allow_pipewire() &&
+      ScreenCapturerPipeWire::IsRunningUnderWayland()) {
+    return ScreenCapturerPipeWire::CreateRawScreenCapturer(options);
+  }
+#endif
+
   if (!options.x_display())
     return nullptr;
 
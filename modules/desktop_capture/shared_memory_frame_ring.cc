@@ -0,0 +1,219 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/shared_memory_frame_ring.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// A frame received from another process; notifies the producer when it is
+// destroyed.
+class ReceivedSharedFrame : public DesktopFrame {
+ public:
+  ReceivedSharedFrame(DesktopSize size,
+                      int stride,
+                      uint8_t* data,
+                      std::function<void()> on_release)
+      : DesktopFrame(size, stride, data, nullptr),
+        on_release_(std::move(on_release)) {}
+  ~ReceivedSharedFrame() override {
+    if (on_release_)
+      on_release_();
+  }
+
+ private:
+  const std::function<void()> on_release_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ReceivedSharedFrame);
+};
+
+}  // namespace
+
+// A frame acquired from the ring; frees its slot if it is destroyed without
+// being published.
+class SharedMemoryFrameRing::RingFrame : public DesktopFrame {
+ public:
+  RingFrame(DesktopSize size,
+            SharedMemory* shared_memory,
+            SharedMemoryFrameRing* ring,
+            int slot)
+      : DesktopFrame(size,
+                     size.width() * kBytesPerPixel,
+                     reinterpret_cast<uint8_t*>(shared_memory->data()),
+                     shared_memory),
+        ring_(ring),
+        slot_(slot) {}
+  ~RingFrame() override { ring_->OnFrameDestroyed(slot_); }
+
+ private:
+  SharedMemoryFrameRing* const ring_;
+  const int slot_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RingFrame);
+};
+
+SharedMemoryFrameRing::SharedMemoryFrameRing(
+    std::unique_ptr<SharedMemoryFactory> shared_memory_factory,
+    int num_slots)
+    : shared_memory_factory_(std::move(shared_memory_factory)),
+      slots_(num_slots) {
+  RTC_DCHECK(shared_memory_factory_);
+  RTC_DCHECK_GT(num_slots, 0);
+}
+
+SharedMemoryFrameRing::~SharedMemoryFrameRing() {
+  rtc::CritScope lock(&lock_);
+  for (const Slot& slot : slots_)
+    RTC_DCHECK(slot.state != SlotState::kAcquired);
+}
+
+std::unique_ptr<DesktopFrame> SharedMemoryFrameRing::AcquireFrame(
+    DesktopSize size) {
+  rtc::CritScope lock(&lock_);
+  const int slot = AcquireSlot(size);
+  if (slot < 0)
+    return nullptr;
+  return absl::make_unique<RingFrame>(
+      size, slots_[slot].shared_memory.get(), this, slot);
+}
+
+absl::optional<SharedFrameDescriptor> SharedMemoryFrameRing::Publish(
+    std::unique_ptr<DesktopFrame> frame) {
+  RTC_DCHECK(frame);
+  const int stride = frame->size().width() * DesktopFrame::kBytesPerPixel;
+  int slot = -1;
+  uint8_t* dst = nullptr;
+  {
+    rtc::CritScope lock(&lock_);
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      if (slots_[i].state == SlotState::kAcquired &&
+          frame->shared_memory() == slots_[i].shared_memory.get() &&
+          frame->data() == slots_[i].shared_memory->data()) {
+        // Destroying the frame doesn't free the slot once it's published.
+        return PublishSlot(static_cast<int>(i), *frame, frame->stride());
+      }
+    }
+    slot = AcquireSlot(frame->size());
+    if (slot < 0)
+      return absl::nullopt;
+    dst = reinterpret_cast<uint8_t*>(slots_[slot].shared_memory->data());
+  }
+
+  // The slot is acquired, so it can be written without holding the lock.
+  const uint8_t* src = frame->data();
+  for (int y = 0; y < frame->size().height(); ++y) {
+    memcpy(dst, src, stride);
+    src += frame->stride();
+    dst += stride;
+  }
+
+  rtc::CritScope lock(&lock_);
+  return PublishSlot(slot, *frame, stride);
+}
+
+void SharedMemoryFrameRing::Release(int slot) {
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK_GE(slot, 0);
+  RTC_DCHECK_LT(slot, static_cast<int>(slots_.size()));
+  RTC_DCHECK(slots_[slot].state == SlotState::kPublished);
+  slots_[slot].state = SlotState::kFree;
+}
+
+const SharedMemory* SharedMemoryFrameRing::GetSharedMemory(
+    int shared_memory_id) const {
+  rtc::CritScope lock(&lock_);
+  for (const Slot& slot : slots_) {
+    if (slot.shared_memory && slot.shared_memory->id() == shared_memory_id)
+      return slot.shared_memory.get();
+  }
+  return nullptr;
+}
+
+int SharedMemoryFrameRing::AcquireSlot(DesktopSize size) {
+  const size_t buffer_size =
+      size.width() * size.height() * DesktopFrame::kBytesPerPixel;
+  // Prefer a slot that doesn't need new memory, which the consumer would have
+  // to map.
+  int slot = -1;
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    if (slots_[i].state != SlotState::kFree)
+      continue;
+    if (slots_[i].shared_memory &&
+        slots_[i].shared_memory->size() >= buffer_size) {
+      slot = static_cast<int>(i);
+      break;
+    }
+    if (slot < 0)
+      slot = static_cast<int>(i);
+  }
+  if (slot < 0)
+    return -1;
+
+  Slot& free_slot = slots_[slot];
+  if (!free_slot.shared_memory ||
+      free_slot.shared_memory->size() < buffer_size) {
+    free_slot.shared_memory.reset();
+    free_slot.shared_memory =
+        shared_memory_factory_->CreateSharedMemory(buffer_size);
+    if (!free_slot.shared_memory)
+      return -1;
+    free_slot.new_shared_memory = true;
+  }
+  free_slot.state = SlotState::kAcquired;
+  return slot;
+}
+
+SharedFrameDescriptor SharedMemoryFrameRing::PublishSlot(
+    int slot,
+    const DesktopFrame& frame,
+    int stride) {
+  Slot& published_slot = slots_[slot];
+  RTC_DCHECK(published_slot.state == SlotState::kAcquired);
+  published_slot.state = SlotState::kPublished;
+
+  SharedFrameDescriptor descriptor;
+  descriptor.slot = slot;
+  descriptor.shared_memory_id = published_slot.shared_memory->id();
+  descriptor.new_shared_memory = published_slot.new_shared_memory;
+  descriptor.size = frame.size();
+  descriptor.stride = stride;
+  descriptor.capture_time_ms = frame.capture_time_ms();
+  descriptor.updated_region = frame.updated_region();
+  published_slot.new_shared_memory = false;
+  return descriptor;
+}
+
+void SharedMemoryFrameRing::OnFrameDestroyed(int slot) {
+  rtc::CritScope lock(&lock_);
+  if (slots_[slot].state == SlotState::kAcquired)
+    slots_[slot].state = SlotState::kFree;
+}
+
+std::unique_ptr<DesktopFrame> WrapSharedFrame(
+    const SharedFrameDescriptor& descriptor,
+    uint8_t* data,
+    std::function<void()> on_release) {
+  RTC_DCHECK(data);
+  auto frame = absl::make_unique<ReceivedSharedFrame>(
+      descriptor.size, descriptor.stride, data, std::move(on_release));
+  frame->set_capture_time_ms(descriptor.capture_time_ms);
+  *frame->mutable_updated_region() = descriptor.updated_region;
+  return std::move(frame);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_SHARED_MEMORY_FRAME_RING_H_
+#define MODULES_DESKTOP_CAPTURE_SHARED_MEMORY_FRAME_RING_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "modules/desktop_capture/shared_memory.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Describes a frame published by SharedMemoryFrameRing. The embedder sends it
+// to the consumer process over its own IPC channel. When |new_shared_memory|
+// is true, the handle of the shared memory with |shared_memory_id| must be
+// sent along, so that the consumer can map it; otherwise the consumer has
+// mapped it for an earlier frame already.
+struct SharedFrameDescriptor {
+  int slot = 0;
+  int shared_memory_id = 0;
+  bool new_shared_memory = false;
+  DesktopSize size;
+  int stride = 0;
+  int64_t capture_time_ms = 0;
+  DesktopRegion updated_region;
+};
+
+// A ring of frames in shared memory, to hand captured frames to a consumer in
+// another process without copying them. The consumer maps the memory of the
+// frames once and wraps every received frame with WrapSharedFrame(). When it
+// is done with a frame, the consumer sends the slot back and the producer
+// calls Release(), after which the slot is reused for a later frame.
+//
+// If the consumer holds all slots, new frames are dropped rather than
+// overwriting frames that may still be read.
+//
+// All methods may be called from any thread. The ring must outlive the
+// frames returned by AcquireFrame().
+class SharedMemoryFrameRing {
+ public:
+  static const int kDefaultNumSlots = 3;
+
+  // |shared_memory_factory| must create memory that can be mapped by the
+  // consumer process.
+  SharedMemoryFrameRing(
+      std::unique_ptr<SharedMemoryFactory> shared_memory_factory,
+      int num_slots);
+  ~SharedMemoryFrameRing();
+
+  // Returns a frame in a free slot, for a capturer that writes the pixels of
+  // a frame itself. Publishing the frame then doesn't copy it. Returns
+  // nullptr if there's no free slot or the memory can't be allocated.
+  std::unique_ptr<DesktopFrame> AcquireFrame(DesktopSize size);
+
+  // Publishes |frame| to the consumer. Frames returned by AcquireFrame() are
+  // published in place, others are copied to a free slot. Returns nullopt and
+  // drops the frame if there's no free slot.
+  absl::optional<SharedFrameDescriptor> Publish(
+      std::unique_ptr<DesktopFrame> frame);
+
+  // Called when the consumer is done with the frame in |slot|.
+  void Release(int slot);
+
+  // Returns the shared memory with |shared_memory_id|, to send its handle to
+  // the consumer, or nullptr if no slot uses it anymore.
+  const SharedMemory* GetSharedMemory(int shared_memory_id) const;
+
+ private:
+  class RingFrame;
+
+  enum class SlotState { kFree, kAcquired, kPublished };
+
+  struct Slot {
+    std::unique_ptr<SharedMemory> shared_memory;
+    SlotState state = SlotState::kFree;
+    // Whether the consumer may not have mapped |shared_memory| yet.
+    bool new_shared_memory = false;
+  };
+
+  // Returns the index of a free slot with room for a frame of |size|, and
+  // marks it acquired. Returns -1 on failure.
+  int AcquireSlot(DesktopSize size) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Marks |slot|, holding the pixels of |frame| with |stride|, published.
+  SharedFrameDescriptor PublishSlot(int slot,
+                                    const DesktopFrame& frame,
+                                    int stride)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Frees |slot| if its frame is destroyed without being published.
+  void OnFrameDestroyed(int slot);
+
+  const std::unique_ptr<SharedMemoryFactory> shared_memory_factory_;
+  rtc::CriticalSection lock_;
+  std::vector<Slot> slots_ RTC_GUARDED_BY(lock_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SharedMemoryFrameRing);
+};
+
+// Wraps the pixels of a frame received from a SharedMemoryFrameRing in
+// another process, without copying them. |data| is the consumer's mapping of
+// the shared memory with |descriptor.shared_memory_id|. |on_release| is
+// called when the returned frame is destroyed, to send |descriptor.slot| back
+// to the producer.
+std::unique_ptr<DesktopFrame> WrapSharedFrame(
+    const SharedFrameDescriptor& descriptor,
+    uint8_t* data,
+    std::function<void()> on_release);
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_SHARED_MEMORY_FRAME_RING_H_
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/shared_memory_frame_ring.h"
+
+#include <string.h>
+
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+class HeapSharedMemory : public SharedMemory {
+ public:
+  HeapSharedMemory(size_t size, int id)
+      : SharedMemory(new uint8_t[size], size, kInvalidHandle, id) {}
+  ~HeapSharedMemory() override { delete[] static_cast<uint8_t*>(data_); }
+};
+
+class HeapSharedMemoryFactory : public SharedMemoryFactory {
+ public:
+  std::unique_ptr<SharedMemory> CreateSharedMemory(size_t size) override {
+    return absl::make_unique<HeapSharedMemory>(size, next_id_++);
+  }
+
+ private:
+  int next_id_ = 1;
+};
+
+std::unique_ptr<SharedMemoryFrameRing> CreateRing(int num_slots) {
+  return absl::make_unique<SharedMemoryFrameRing>(
+      absl::make_unique<HeapSharedMemoryFactory>(), num_slots);
+}
+
+// Returns the pixels of the published frame, as the consumer maps them.
+uint8_t* MappedData(const SharedMemoryFrameRing& ring,
+                    const SharedFrameDescriptor& descriptor) {
+  return static_cast<uint8_t*>(
+      ring.GetSharedMemory(descriptor.shared_memory_id)->data());
+}
+
+}  // namespace
+
+TEST(SharedMemoryFrameRingTest, PublishesAcquiredFrameInPlace) {
+  std::unique_ptr<SharedMemoryFrameRing> ring = CreateRing(2);
+  std::unique_ptr<DesktopFrame> frame = ring->AcquireFrame(DesktopSize(4, 2));
+  ASSERT_TRUE(frame);
+  memset(frame->data(), 0x42, frame->stride() * frame->size().height());
+  frame->set_capture_time_ms(7);
+  frame->mutable_updated_region()->SetRect(DesktopRect::MakeWH(2, 2));
+  const uint8_t* data = frame->data();
+
+  absl::optional<SharedFrameDescriptor> descriptor =
+      ring->Publish(std::move(frame));
+  ASSERT_TRUE(descriptor);
+  EXPECT_TRUE(descriptor->new_shared_memory);
+  EXPECT_EQ(data, MappedData(*ring, *descriptor));
+  EXPECT_TRUE(descriptor->size.equals(DesktopSize(4, 2)));
+  EXPECT_EQ(4 * DesktopFrame::kBytesPerPixel, descriptor->stride);
+  EXPECT_EQ(7, descriptor->capture_time_ms);
+  EXPECT_TRUE(descriptor->updated_region.Equals(
+      DesktopRegion(DesktopRect::MakeWH(2, 2))));
+  ring->Release(descriptor->slot);
+}
+
+TEST(SharedMemoryFrameRingTest, CopiesOtherFrames) {
+  std::unique_ptr<SharedMemoryFrameRing> ring = CreateRing(2);
+  auto frame = absl::make_unique<BasicDesktopFrame>(DesktopSize(3, 3));
+  for (int i = 0; i < frame->stride() * 3; ++i)
+    frame->data()[i] = static_cast<uint8_t>(i);
+
+  absl::optional<SharedFrameDescriptor> descriptor =
+      ring->Publish(std::move(frame));
+  ASSERT_TRUE(descriptor);
+  const uint8_t* data = MappedData(*ring, *descriptor);
+  for (int i = 0; i < descriptor->stride * 3; ++i)
+    EXPECT_EQ(static_cast<uint8_t>(i), data[i]);
+  ring->Release(descriptor->slot);
+}
+
+TEST(SharedMemoryFrameRingTest, DropsFramesWhenConsumerHoldsAllSlots) {
+  std::unique_ptr<SharedMemoryFrameRing> ring = CreateRing(2);
+  const DesktopSize size(8, 8);
+  absl::optional<SharedFrameDescriptor> first =
+      ring->Publish(ring->AcquireFrame(size));
+  absl::optional<SharedFrameDescriptor> second =
+      ring->Publish(ring->AcquireFrame(size));
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first->slot, second->slot);
+
+  EXPECT_FALSE(ring->AcquireFrame(size));
+  EXPECT_FALSE(ring->Publish(absl::make_unique<BasicDesktopFrame>(size)));
+
+  // The released slot is reused without new memory.
+  ring->Release(first->slot);
+  absl::optional<SharedFrameDescriptor> third =
+      ring->Publish(ring->AcquireFrame(size));
+  ASSERT_TRUE(third);
+  EXPECT_EQ(first->slot, third->slot);
+  EXPECT_EQ(first->shared_memory_id, third->shared_memory_id);
+  EXPECT_FALSE(third->new_shared_memory);
+  ring->Release(second->slot);
+  ring->Release(third->slot);
+}
+
+TEST(SharedMemoryFrameRingTest, FreesSlotOfDroppedAcquiredFrame) {
+  std::unique_ptr<SharedMemoryFrameRing> ring = CreateRing(1);
+  EXPECT_TRUE(ring->AcquireFrame(DesktopSize(8, 8)));
+  std::unique_ptr<DesktopFrame> frame = ring->AcquireFrame(DesktopSize(8, 8));
+  ASSERT_TRUE(frame);
+  EXPECT_FALSE(ring->AcquireFrame(DesktopSize(8, 8)));
+}
+
+TEST(SharedMemoryFrameRingTest, AllocatesLargerMemoryForLargerFrames) {
+  std::unique_ptr<SharedMemoryFrameRing> ring = CreateRing(1);
+  absl::optional<SharedFrameDescriptor> small =
+      ring->Publish(ring->AcquireFrame(DesktopSize(8, 8)));
+  ASSERT_TRUE(small);
+  ring->Release(small->slot);
+
+  absl::optional<SharedFrameDescriptor> large =
+      ring->Publish(ring->AcquireFrame(DesktopSize(16, 16)));
+  ASSERT_TRUE(large);
+  EXPECT_TRUE(large->new_shared_memory);
+  EXPECT_NE(small->shared_memory_id, large->shared_memory_id);
+  EXPECT_FALSE(ring->GetSharedMemory(small->shared_memory_id));
+  ring->Release(large->slot);
+}
+
+TEST(SharedMemoryFrameRingTest, WrappedFrameReleasesSlot) {
+  std::unique_ptr<SharedMemoryFrameRing> ring = CreateRing(1);
+  absl::optional<SharedFrameDescriptor> descriptor =
+      ring->Publish(ring->AcquireFrame(DesktopSize(8, 8)));
+  ASSERT_TRUE(descriptor);
+
+  uint8_t* data = MappedData(*ring, *descriptor);
+  const int slot = descriptor->slot;
+  std::unique_ptr<DesktopFrame> received = WrapSharedFrame(
+      *descriptor, data, [&ring, slot] { ring->Release(slot); });
+  EXPECT_EQ(data, received->data());
+  EXPECT_TRUE(received->size().equals(DesktopSize(8, 8)));
+  EXPECT_FALSE(ring->AcquireFrame(DesktopSize(8, 8)));
+
+  received.reset();
+  EXPECT_TRUE(ring->AcquireFrame(DesktopSize(8, 8)));
+}
+
+}  // namespace webrtc
@@ -180,10 +180,22 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
   if (error.Error() == S_OK && frame_info.AccumulatedFrames > 0 && resource) {
     DetectUpdatedRegion(frame_info, &context->updated_region);
     SpreadContextChange(context);
-    if (!texture_->CopyFrom(frame_info, resource.Get())) {
+    updated_region.AddRegion(context->updated_region);
+    // The |updated_region| returned by Windows is rotated, but the texture is
+    // not.
+    DesktopRegion texture_region;
+    if (rotation_ != Rotation::CLOCK_WISE_0) {
+      for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
+           it.Advance()) {
+        texture_region.AddRect(
+            RotateRect(it.rect(), desktop_size(), ReverseRotation(rotation_)));
+      }
+    } else {
+      texture_region = updated_region;
+    }
+    if (!texture_->CopyFrom(frame_info, resource.Get(), texture_region)) {
       return false;
     }
-    updated_region.AddRegion(context->updated_region);
     // TODO(zijiehe): Figure out why clearing context->updated_region() here
     // triggers screen flickering?
 
@@ -28,8 +28,11 @@ DxgiTextureStaging::DxgiTextureStaging(const D3dDevice& device)
 
 DxgiTextureStaging::~DxgiTextureStaging() = default;
 
-bool DxgiTextureStaging::InitializeStage(ID3D11Texture2D* texture) {
+bool DxgiTextureStaging::InitializeStage(ID3D11Texture2D* texture,
+                                         bool* created) {
   RTC_DCHECK(texture);
+  RTC_DCHECK(created);
+  *created = false;
   D3D11_TEXTURE2D_DESC desc = {0};
   texture->GetDesc(&desc);
 
@@ -61,6 +64,7 @@ bool DxgiTextureStaging::InitializeStage(ID3D11Texture2D* texture) {
     RTC_DCHECK(!surface_);
   }
 
+  *created = true;
   _com_error error = device_.d3d_device()->CreateTexture2D(
       &desc, nullptr, stage_.GetAddressOf());
   if (error.Error() != S_OK || !stage_) {
@@ -93,18 +97,41 @@ void DxgiTextureStaging::AssertStageAndSurfaceAreSameObject() {
 
 bool DxgiTextureStaging::CopyFromTexture(
     const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-    ID3D11Texture2D* texture) {
+    ID3D11Texture2D* texture,
+    const DesktopRegion& updated_region) {
   RTC_DCHECK_GT(frame_info.AccumulatedFrames, 0);
   RTC_DCHECK(texture);
 
   // AcquireNextFrame returns a CPU inaccessible IDXGIResource, so we need to
   // copy it to a CPU accessible staging ID3D11Texture2D.
-  if (!InitializeStage(texture)) {
+  bool created = false;
+  if (!InitializeStage(texture, &created)) {
     return false;
   }
 
-  device_.context()->CopyResource(static_cast<ID3D11Resource*>(stage_.Get()),
-                                  static_cast<ID3D11Resource*>(texture));
+  if (created) {
+    device_.context()->CopyResource(
+        static_cast<ID3D11Resource*>(stage_.Get()),
+        static_cast<ID3D11Resource*>(texture));
+  } else {
+    // The stage keeps the content of the previous frames, so reading back
+    // the changed regions is enough. For mostly static screens this is a
+    // small part of the frame, which matters at 4K.
+    for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
+         it.Advance()) {
+      const DesktopRect& rect = it.rect();
+      D3D11_BOX box;
+      box.left = rect.left();
+      box.top = rect.top();
+      box.front = 0;
+      box.right = rect.right();
+      box.bottom = rect.bottom();
+      box.back = 1;
+      device_.context()->CopySubresourceRegion(
+          static_cast<ID3D11Resource*>(stage_.Get()), 0, rect.left(),
+          rect.top(), 0, static_cast<ID3D11Resource*>(texture), 0, &box);
+    }
+  }
 
   *rect() = {0};
   _com_error error = surface_->Map(rect(), DXGI_MAP_READ);
@@ -41,15 +41,17 @@ class DxgiTextureStaging : public DxgiTexture {
   // Copies selected regions of a frame represented by frame_info and texture.
   // Returns false if anything wrong.
   bool CopyFromTexture(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                       ID3D11Texture2D* texture) override;
+                       ID3D11Texture2D* texture,
+                       const DesktopRegion& updated_region) override;
 
   bool DoRelease() override;
 
  private:
   // Initializes stage_ from a CPU inaccessible IDXGIResource. Returns false if
   // it failed to execute Windows APIs, or the size of the texture is not
-  // consistent with desktop_rect.
-  bool InitializeStage(ID3D11Texture2D* texture);
+  // consistent with desktop_rect. Sets |created| to whether stage_ was
+  // created rather than reused, i.e. whether it has no content yet.
+  bool InitializeStage(ID3D11Texture2D* texture, bool* created);
 
   // Makes sure stage_ and surface_ are always pointing to a same object.
   // We need an ID3D11Texture2D instance for
@@ -17,9 +17,13 @@ namespace webrtc {
 // random loss model. The type |kFecMaskBursty| is based on a bursty/consecutive
 // loss model. The packet masks are defined in
 // modules/rtp_rtcp/fec_private_tables_random(bursty).h
+// The type |kFecMaskTwoDimensional| is 2D parity, generated at runtime: half
+// of the FEC packets protect interleaved columns of media packets, which
+// recovers bursts, and the other half protect runs of consecutive packets.
 enum FecMaskType {
   kFecMaskRandom,
   kFecMaskBursty,
+  kFecMaskTwoDimensional,
 };
 
 // Struct containing forward error correction settings.
@@ -54,6 +54,16 @@ size_t IntervalBudget::bytes_remaining() const {
   return static_cast<size_t>(std::max(0, bytes_remaining_));
 }
 
+int64_t IntervalBudget::TimeUntilBytesRemainingMs() const {
+  if (bytes_remaining_ > 0)
+    return 0;
+  if (target_rate_kbps_ <= 0)
+    return -1;
+  // Smallest delta for which IncreaseBudget() adds more than the deficit.
+  int64_t bits_needed = (1 - int64_t{bytes_remaining_}) * 8;
+  return (bits_needed + target_rate_kbps_ - 1) / target_rate_kbps_;
+}
+
 int IntervalBudget::budget_level_percent() const {
   if (max_bytes_in_budget_ == 0)
     return 0;
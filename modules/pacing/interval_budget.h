@@ -28,6 +28,9 @@ class IntervalBudget {
   void UseBudget(size_t bytes);
 
   size_t bytes_remaining() const;
+  // Returns how long IncreaseBudget() has to be called for before
+  // bytes_remaining() becomes positive, or -1 if the target rate is zero.
+  int64_t TimeUntilBytesRemainingMs() const;
   int budget_level_percent() const;
   int target_rate_kbps() const;
 
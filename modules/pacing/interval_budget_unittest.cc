@@ -116,4 +116,24 @@ TEST(IntervalBudgetTest, CanNotBuildUpUnderuseWhenConfigured) {
             TimeToBytes(kBitrateKbps, delta_time_ms));
 }
 
+TEST(IntervalBudgetTest, TimeUntilBytesRemaining) {
+  IntervalBudget interval_budget(kBitrateKbps);
+  EXPECT_EQ(1, interval_budget.TimeUntilBytesRemainingMs());
+  interval_budget.IncreaseBudget(1);
+  EXPECT_EQ(0, interval_budget.TimeUntilBytesRemainingMs());
+
+  interval_budget.UseBudget(TimeToBytes(kBitrateKbps, 1) +
+                            TimeToBytes(kBitrateKbps, 40));
+  int64_t time_ms = interval_budget.TimeUntilBytesRemainingMs();
+  EXPECT_EQ(41, time_ms);
+  interval_budget.IncreaseBudget(time_ms - 1);
+  EXPECT_EQ(0u, interval_budget.bytes_remaining());
+  interval_budget.IncreaseBudget(1);
+  EXPECT_GT(interval_budget.bytes_remaining(), 0u);
+
+  interval_budget.set_target_rate_kbps(0);
+  interval_budget.UseBudget(interval_budget.bytes_remaining());
+  EXPECT_EQ(-1, interval_budget.TimeUntilBytesRemainingMs());
+}
+
 }  // namespace webrtc
@@ -22,6 +22,7 @@
 #include "modules/include/module_common_types.h"
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
+#include "modules/pacing/pooled_packet_queue.h"
 #include "modules/pacing/round_robin_packet_queue.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/checks.h"
@@ -35,12 +36,21 @@ namespace {
 const int64_t kMinPacketLimitMs = 5;
 const int64_t kCongestedPacketIntervalMs = 500;
 const int64_t kPausedProcessIntervalMs = kCongestedPacketIntervalMs;
+// With dynamic processing, the longest sleep when there is nothing to send.
+const int64_t kMaxIdleProcessIntervalMs = kCongestedPacketIntervalMs;
 const int64_t kMaxElapsedTimeMs = 2000;
 
 // Upper cap on process interval, in case process has not been called in a long
 // time.
 const int64_t kMaxIntervalTimeMs = 30;
 
+std::unique_ptr<webrtc::PacketQueueInterface> CreatePacketQueue(
+    const webrtc::Clock* clock) {
+  if (webrtc::field_trial::IsEnabled("WebRTC-Pacer-PooledQueue"))
+    return absl::make_unique<webrtc::PooledPacketQueue>(clock);
+  return absl::make_unique<webrtc::RoundRobinPacketQueue>(clock);
+}
+
 }  // namespace
 
 namespace webrtc {
@@ -54,7 +64,7 @@ PacedSender::PacedSender(const Clock* clock,
     : PacedSender(clock,
                   packet_sender,
                   event_log,
-                  absl::make_unique<RoundRobinPacketQueue>(clock)) {}
+                  CreatePacketQueue(clock)) {}
 
 PacedSender::PacedSender(const Clock* clock,
                          PacketSender* packet_sender,
@@ -67,6 +77,8 @@ PacedSender::PacedSender(const Clock* clock,
       send_padding_if_silent_(
           field_trial::IsEnabled("WebRTC-Pacer-PadInSilence")),
       video_blocks_audio_(!field_trial::IsDisabled("WebRTC-Pacer-BlockAudio")),
+      dynamic_process_(
+          field_trial::IsEnabled("WebRTC-Pacer-DynamicProcess")),
       paused_(false),
       media_budget_(absl::make_unique<IntervalBudget>(0)),
       padding_budget_(absl::make_unique<IntervalBudget>(0)),
@@ -105,11 +117,9 @@ void PacedSender::Pause() {
     paused_ = true;
     packets_->SetPauseState(true, clock_->TimeInMilliseconds());
   }
-  rtc::CritScope cs(&process_thread_lock_);
   // Tell the process thread to call our TimeUntilNextProcess() method to get
   // a new (longer) estimate for when to call Process().
-  if (process_thread_)
-    process_thread_->WakeUp(this);
+  WakeUpProcessThread();
 }
 
 void PacedSender::Resume() {
@@ -120,21 +130,33 @@ void PacedSender::Resume() {
     paused_ = false;
     packets_->SetPauseState(false, clock_->TimeInMilliseconds());
   }
-  rtc::CritScope cs(&process_thread_lock_);
   // Tell the process thread to call our TimeUntilNextProcess() method to
   // refresh the estimate for when to call Process().
-  if (process_thread_)
-    process_thread_->WakeUp(this);
+  WakeUpProcessThread();
 }
 
 void PacedSender::SetCongestionWindow(int64_t congestion_window_bytes) {
-  rtc::CritScope cs(&critsect_);
-  congestion_window_bytes_ = congestion_window_bytes;
+  bool wake_up;
+  {
+    rtc::CritScope cs(&critsect_);
+    bool was_congested = Congested();
+    congestion_window_bytes_ = congestion_window_bytes;
+    wake_up = dynamic_process_ && was_congested && !Congested();
+  }
+  if (wake_up)
+    WakeUpProcessThread();
 }
 
 void PacedSender::UpdateOutstandingData(int64_t outstanding_bytes) {
-  rtc::CritScope cs(&critsect_);
-  outstanding_bytes_ = outstanding_bytes;
+  bool wake_up;
+  {
+    rtc::CritScope cs(&critsect_);
+    bool was_congested = Congested();
+    outstanding_bytes_ = outstanding_bytes;
+    wake_up = dynamic_process_ && was_congested && !Congested();
+  }
+  if (wake_up)
+    WakeUpProcessThread();
 }
 
 bool PacedSender::Congested() const {
@@ -176,10 +198,15 @@ void PacedSender::SetSendBitrateLimits(int min_send_bitrate_bps,
 
 void PacedSender::SetPacingRates(uint32_t pacing_rate_bps,
                                  uint32_t padding_rate_bps) {
-  rtc::CritScope cs(&critsect_);
-  RTC_DCHECK(pacing_rate_bps > 0);
-  pacing_bitrate_kbps_ = pacing_rate_bps / 1000;
-  padding_budget_->set_target_rate_kbps(padding_rate_bps / 1000);
+  {
+    rtc::CritScope cs(&critsect_);
+    RTC_DCHECK(pacing_rate_bps > 0);
+    pacing_bitrate_kbps_ = pacing_rate_bps / 1000;
+    padding_budget_->set_target_rate_kbps(padding_rate_bps / 1000);
+  }
+  // The next send time depends on the rates.
+  if (dynamic_process_)
+    WakeUpProcessThread();
 }
 
 void PacedSender::InsertPacket(RtpPacketSender::Priority priority,
@@ -188,19 +215,34 @@ void PacedSender::InsertPacket(RtpPacketSender::Priority priority,
                                int64_t capture_time_ms,
                                size_t bytes,
                                bool retransmission) {
-  rtc::CritScope cs(&critsect_);
-  RTC_DCHECK(pacing_bitrate_kbps_ > 0)
-      << "SetPacingRate must be called before InsertPacket.";
-
-  int64_t now_ms = clock_->TimeInMilliseconds();
-  prober_->OnIncomingPacket(bytes);
-
-  if (capture_time_ms < 0)
-    capture_time_ms = now_ms;
+  bool wake_up = false;
+  {
+    rtc::CritScope cs(&critsect_);
+    RTC_DCHECK(pacing_bitrate_kbps_ > 0)
+        << "SetPacingRate must be called before InsertPacket.";
+
+    int64_t now_ms = clock_->TimeInMilliseconds();
+    bool was_probing = prober_->IsProbing();
+    prober_->OnIncomingPacket(bytes);
+
+    if (capture_time_ms < 0)
+      capture_time_ms = now_ms;
+
+    if (dynamic_process_ && !paused_ && !Congested()) {
+      // The process thread sleeps while the queue is empty. Unpaced audio and
+      // probes don't wait for the media budget either.
+      bool unpaced_audio = priority == kHighPriority && !account_for_audio_ &&
+                           !video_blocks_audio_;
+      wake_up = packets_->Empty() || unpaced_audio ||
+                (!was_probing && prober_->IsProbing());
+    }
 
-  packets_->Push(PacketQueueInterface::Packet(
-      priority, ssrc, sequence_number, capture_time_ms, now_ms, bytes,
-      retransmission, packet_counter_++));
+    packets_->Push(PacketQueueInterface::Packet(
+        priority, ssrc, sequence_number, capture_time_ms, now_ms, bytes,
+        retransmission, packet_counter_++));
+  }
+  if (wake_up)
+    WakeUpProcessThread();
 }
 
 void PacedSender::SetAccountForAudioPackets(bool account_for_audio) {
@@ -256,9 +298,42 @@ int64_t PacedSender::TimeUntilNextProcess() {
     if (ret > 0 || (ret == 0 && !probing_send_failure_))
       return ret;
   }
+  if (dynamic_process_)
+    return TimeUntilNextSendMs(elapsed_time_ms);
   return std::max<int64_t>(kMinPacketLimitMs - elapsed_time_ms, 0);
 }
 
+int64_t PacedSender::TimeUntilNextSendMs(int64_t elapsed_time_ms) const {
+  // Keep bursts at least kMinPacketLimitMs apart, as with fixed polling, so
+  // that high rates don't cause a wakeup per packet.
+  int64_t next_burst_ms =
+      std::max<int64_t>(kMinPacketLimitMs - elapsed_time_ms, 0);
+  int64_t elapsed_since_last_send_ms =
+      (clock_->TimeInMicroseconds() - last_send_time_us_ + 500) / 1000;
+  int64_t keep_alive_ms = std::max<int64_t>(
+      kCongestedPacketIntervalMs - elapsed_since_last_send_ms, 0);
+
+  // Nothing but keep-alive padding can be sent until the congestion window
+  // opens up, which wakes up the process thread.
+  if (Congested())
+    return keep_alive_ms;
+
+  if (packets_->Empty()) {
+    if (packet_counter_ > 0 && padding_budget_->target_rate_kbps() > 0)
+      return next_burst_ms;
+    // InsertPacket() wakes up the process thread.
+    return send_padding_if_silent_ ? keep_alive_ms : kMaxIdleProcessIntervalMs;
+  }
+
+  int64_t budget_ms = media_budget_->TimeUntilBytesRemainingMs();
+  // Either there is budget left and sending failed, or there is no rate.
+  if (budget_ms <= 0)
+    return next_burst_ms;
+  // UpdateBudgetWithElapsedTime() adds at most kMaxIntervalTimeMs at a time.
+  budget_ms = std::min(budget_ms, kMaxIntervalTimeMs) - elapsed_time_ms;
+  return std::max(next_burst_ms, budget_ms);
+}
+
 void PacedSender::Process() {
   int64_t now_us = clock_->TimeInMicroseconds();
   rtc::CritScope cs(&critsect_);
@@ -364,6 +439,12 @@ void PacedSender::ProcessThreadAttached(ProcessThread* process_thread) {
   process_thread_ = process_thread;
 }
 
+void PacedSender::WakeUpProcessThread() {
+  rtc::CritScope cs(&process_thread_lock_);
+  if (process_thread_)
+    process_thread_->WakeUp(this);
+}
+
 bool PacedSender::SendPacket(const PacketQueueInterface::Packet& packet,
                              const PacedPacketInfo& pacing_info) {
   RTC_DCHECK(!paused_);
@@ -158,6 +158,16 @@ class PacedSender : public Pacer {
   void OnBytesSent(size_t bytes_sent) RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   bool Congested() const RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
+  // Used instead of the fixed process interval when |dynamic_process_| is
+  // set. Returns the time until the next packet can be sent given the media
+  // budget and the queue, or until the next keep-alive or padding is due.
+  int64_t TimeUntilNextSendMs(int64_t elapsed_time_ms) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // Asks the process thread to call Process() right away. Must not be called
+  // with |critsect_| held, since the process thread holds its own lock while
+  // calling into this class.
+  void WakeUpProcessThread() RTC_LOCKS_EXCLUDED(critsect_);
+
   const Clock* const clock_;
   PacketSender* const packet_sender_;
   const std::unique_ptr<AlrDetector> alr_detector_ RTC_PT_GUARDED_BY(critsect_);
@@ -165,6 +175,10 @@ class PacedSender : public Pacer {
   const bool drain_large_queues_;
   const bool send_padding_if_silent_;
   const bool video_blocks_audio_;
+  // If set, Process() is only scheduled when something can be sent, and
+  // changes that allow sending earlier wake up the process thread, instead
+  // of polling every kMinPacketLimitMs.
+  const bool dynamic_process_;
   rtc::CriticalSection critsect_;
   bool paused_ RTC_GUARDED_BY(critsect_);
   // This is the media budget, keeping track of how many bits of media
@@ -13,6 +13,7 @@
 #include <string>
 
 #include "modules/pacing/paced_sender.h"
+#include "modules/utility/include/mock/mock_process_thread.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/field_trial.h"
 #include "test/field_trial.h"
@@ -274,6 +275,64 @@ TEST_F(PacedSenderFieldTrialTest, BudgetDoesNotAffectAudioInTrial) {
   ProcessNext(&pacer);
 }
 
+TEST_F(PacedSenderFieldTrialTest, DefaultProcessesAtFixedInterval) {
+  PacedSender pacer(&clock_, &callback_, nullptr);
+  pacer.SetPacingRates(kTargetBitrateBps, 0);
+  pacer.Process();
+  EXPECT_EQ(5, pacer.TimeUntilNextProcess());
+}
+
+TEST_F(PacedSenderFieldTrialTest, DynamicProcessSleepsUntilPacketInserted) {
+  ScopedFieldTrials trial("WebRTC-Pacer-DynamicProcess/Enabled/");
+  MockProcessThread process_thread;
+  PacedSender pacer(&clock_, &callback_, nullptr);
+  pacer.ProcessThreadAttached(&process_thread);
+  EXPECT_CALL(process_thread, WakeUp(&pacer)).Times(1);
+  pacer.SetPacingRates(kTargetBitrateBps, 0);
+  pacer.Process();
+  EXPECT_EQ(500, pacer.TimeUntilNextProcess());
+
+  // Only the first packet into an empty queue wakes up the process thread.
+  EXPECT_CALL(process_thread, WakeUp(&pacer)).Times(1);
+  InsertPacket(&pacer, &video);
+  InsertPacket(&pacer, &video);
+  testing::Mock::VerifyAndClearExpectations(&process_thread);
+  pacer.ProcessThreadAttached(nullptr);
+}
+
+TEST_F(PacedSenderFieldTrialTest, DynamicProcessWaitsForMediaBudget) {
+  ScopedFieldTrials trial("WebRTC-Pacer-DynamicProcess/Enabled/");
+  const int kRateBps = 100000;
+  PacedSender pacer(&clock_, &callback_, nullptr);
+  pacer.SetPacingRates(kRateBps, 0);
+  InsertPacket(&pacer, &video);
+  InsertPacket(&pacer, &video);
+  EXPECT_CALL(callback_, TimeToSendPacket).WillOnce(Return(true));
+  ProcessNext(&pacer);
+  testing::Mock::VerifyAndClearExpectations(&callback_);
+
+  // The second packet is sent as soon as the first one has been paid for,
+  // with far fewer calls to Process() than polling every 5 ms.
+  const int64_t kDebtMs = video.packet_size * 8 * 1000 / kRateBps;
+  const int64_t start_ms = clock_.TimeInMilliseconds();
+  int process_calls = 0;
+  bool sent = false;
+  EXPECT_CALL(callback_, TimeToSendPacket)
+      .WillOnce(testing::InvokeWithoutArgs([&sent] {
+        sent = true;
+        return true;
+      }));
+  while (!sent) {
+    int64_t time_ms = pacer.TimeUntilNextProcess();
+    EXPECT_GT(time_ms, 5);
+    clock_.AdvanceTimeMilliseconds(time_ms);
+    pacer.Process();
+    ++process_calls;
+  }
+  EXPECT_LE(clock_.TimeInMilliseconds() - start_ms, kDebtMs + 5);
+  EXPECT_LE(process_calls, 3);
+}
+
 TEST_F(PacedSenderTest, FirstSentPacketTimeIsSet) {
   uint16_t sequence_number = 1234;
   const uint32_t kSsrc = 12345;
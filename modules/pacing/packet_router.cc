@@ -68,6 +68,14 @@ void PacketRouter::RemoveSendRtpModule(RtpRtcp* rtp_module) {
       std::find(rtp_send_modules_.begin(), rtp_send_modules_.end(), rtp_module);
   RTC_DCHECK(it != rtp_send_modules_.end());
   rtp_send_modules_.erase(it);
+  for (auto cache_it = rtp_module_cache_map_.begin();
+       cache_it != rtp_module_cache_map_.end();) {
+    if (cache_it->second == rtp_module) {
+      cache_it = rtp_module_cache_map_.erase(cache_it);
+    } else {
+      ++cache_it;
+    }
+  }
   if (last_send_module_ == rtp_module) {
     last_send_module_ = nullptr;
   }
@@ -103,23 +111,18 @@ bool PacketRouter::TimeToSendPacket(uint32_t ssrc,
                                     bool retransmission,
                                     const PacedPacketInfo& pacing_info) {
   rtc::CritScope cs(&modules_crit_);
-  for (auto* rtp_module : rtp_send_modules_) {
-    if (!rtp_module->SendingMedia()) {
-      continue;
-    }
-    if (ssrc == rtp_module->SSRC() || ssrc == rtp_module->FlexfecSsrc()) {
-      if ((rtp_module->RtxSendStatus() & kRtxRedundantPayloads) &&
-          rtp_module->HasBweExtensions()) {
-        // This is now the last module to send media, and has the desired
-        // properties needed for payload based padding. Cache it for later use.
-        last_send_module_ = rtp_module;
-      }
-      return rtp_module->TimeToSendPacket(ssrc, sequence_number,
-                                          capture_timestamp, retransmission,
-                                          pacing_info);
-    }
+  RtpRtcp* rtp_module = FindRtpModule(ssrc);
+  if (rtp_module == nullptr || !rtp_module->SendingMedia()) {
+    return true;
   }
-  return true;
+  if ((rtp_module->RtxSendStatus() & kRtxRedundantPayloads) &&
+      rtp_module->HasBweExtensions()) {
+    // This is now the last module to send media, and has the desired
+    // properties needed for payload based padding. Cache it for later use.
+    last_send_module_ = rtp_module;
+  }
+  return rtp_module->TimeToSendPacket(ssrc, sequence_number, capture_timestamp,
+                                      retransmission, pacing_info);
 }
 
 size_t PacketRouter::TimeToSendPadding(size_t bytes_to_send,
@@ -266,6 +269,24 @@ bool PacketRouter::SendTransportFeedback(rtcp::TransportFeedback* packet) {
   return false;
 }
 
+RtpRtcp* PacketRouter::FindRtpModule(uint32_t ssrc) {
+  auto it = rtp_module_cache_map_.find(ssrc);
+  if (it != rtp_module_cache_map_.end()) {
+    if (ssrc == it->second->SSRC() || ssrc == it->second->FlexfecSsrc()) {
+      return it->second;
+    }
+    // The module's SSRC has changed since it was cached.
+    rtp_module_cache_map_.erase(it);
+  }
+  for (RtpRtcp* rtp_module : rtp_send_modules_) {
+    if (ssrc == rtp_module->SSRC() || ssrc == rtp_module->FlexfecSsrc()) {
+      rtp_module_cache_map_[ssrc] = rtp_module;
+      return rtp_module;
+    }
+  }
+  return nullptr;
+}
+
 void PacketRouter::AddRembModuleCandidate(
     RtcpFeedbackSenderInterface* candidate_module,
     bool media_sender) {
@@ -12,6 +12,7 @@
 #define MODULES_PACING_PACKET_ROUTER_H_
 
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 #include "common_types.h"  // NOLINT(build/include)
@@ -90,10 +91,18 @@ class PacketRouter : public PacedSender::PacketSender,
       bool media_sender) RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
   void UnsetActiveRembModule() RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
   void DetermineActiveRembModule() RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
+  // Returns the send module with |ssrc| as its media or FlexFEC SSRC, or null.
+  RtpRtcp* FindRtpModule(uint32_t ssrc)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
 
   rtc::CriticalSection modules_crit_;
   // Rtp and Rtcp modules of the rtp senders.
   std::list<RtpRtcp*> rtp_send_modules_ RTC_GUARDED_BY(modules_crit_);
+  // The modules of |rtp_send_modules_| that packets were last sent on, by
+  // SSRC, so that the pacer's packets don't need a search of the list. Since
+  // modules can change their SSRCs, entries are checked before they're used.
+  std::unordered_map<uint32_t, RtpRtcp*> rtp_module_cache_map_
+      RTC_GUARDED_BY(modules_crit_);
   // The last module used to send media.
   RtpRtcp* last_send_module_ RTC_GUARDED_BY(modules_crit_);
   // Rtcp modules of the rtp receivers.
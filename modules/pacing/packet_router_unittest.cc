@@ -105,13 +105,15 @@ TEST(PacketRouterTest, TimeToSendPacket) {
   packet_router.AddSendRtpModule(&rtp_2, false);
 
   const uint16_t kSsrc1 = 1234;
+  const uint16_t kSsrc2 = 4567;
   uint16_t sequence_number = 17;
   uint64_t timestamp = 7890;
   bool retransmission = false;
+  ON_CALL(rtp_1, SSRC()).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_2, SSRC()).WillByDefault(Return(kSsrc2));
 
   // Send on the first module by letting rtp_1 be sending with correct ssrc.
-  EXPECT_CALL(rtp_1, SendingMedia()).Times(1).WillOnce(Return(true));
-  EXPECT_CALL(rtp_1, SSRC()).Times(1).WillOnce(Return(kSsrc1));
+  ON_CALL(rtp_1, SendingMedia()).WillByDefault(Return(true));
   EXPECT_CALL(rtp_1, TimeToSendPacket(
                          kSsrc1, sequence_number, timestamp, retransmission,
                          Field(&PacedPacketInfo::probe_cluster_id, 1)))
@@ -126,10 +128,8 @@ TEST(PacketRouterTest, TimeToSendPacket) {
   ++sequence_number;
   timestamp += 30;
   retransmission = true;
-  const uint16_t kSsrc2 = 4567;
-  EXPECT_CALL(rtp_1, SendingMedia()).Times(1).WillOnce(Return(false));
-  EXPECT_CALL(rtp_2, SendingMedia()).Times(1).WillOnce(Return(true));
-  EXPECT_CALL(rtp_2, SSRC()).Times(1).WillOnce(Return(kSsrc2));
+  ON_CALL(rtp_1, SendingMedia()).WillByDefault(Return(false));
+  ON_CALL(rtp_2, SendingMedia()).WillByDefault(Return(true));
   EXPECT_CALL(rtp_1, TimeToSendPacket(_, _, _, _, _)).Times(0);
   EXPECT_CALL(rtp_2, TimeToSendPacket(
                          kSsrc2, sequence_number, timestamp, retransmission,
@@ -141,19 +141,16 @@ TEST(PacketRouterTest, TimeToSendPacket) {
       PacedPacketInfo(2, kProbeMinProbes, kProbeMinBytes)));
 
   // No module is sending, hence no packet should be sent.
-  EXPECT_CALL(rtp_1, SendingMedia()).Times(1).WillOnce(Return(false));
+  ON_CALL(rtp_2, SendingMedia()).WillByDefault(Return(false));
   EXPECT_CALL(rtp_1, TimeToSendPacket(_, _, _, _, _)).Times(0);
-  EXPECT_CALL(rtp_2, SendingMedia()).Times(1).WillOnce(Return(false));
   EXPECT_CALL(rtp_2, TimeToSendPacket(_, _, _, _, _)).Times(0);
   EXPECT_TRUE(packet_router.TimeToSendPacket(
       kSsrc1, sequence_number, timestamp, retransmission,
       PacedPacketInfo(1, kProbeMinProbes, kProbeMinBytes)));
 
   // Add a packet with incorrect ssrc and test it's dropped in the router.
-  EXPECT_CALL(rtp_1, SendingMedia()).Times(1).WillOnce(Return(true));
-  EXPECT_CALL(rtp_1, SSRC()).Times(1).WillOnce(Return(kSsrc1));
-  EXPECT_CALL(rtp_2, SendingMedia()).Times(1).WillOnce(Return(true));
-  EXPECT_CALL(rtp_2, SSRC()).Times(1).WillOnce(Return(kSsrc2));
+  ON_CALL(rtp_1, SendingMedia()).WillByDefault(Return(true));
+  ON_CALL(rtp_2, SendingMedia()).WillByDefault(Return(true));
   EXPECT_CALL(rtp_1, TimeToSendPacket(_, _, _, _, _)).Times(0);
   EXPECT_CALL(rtp_2, TimeToSendPacket(_, _, _, _, _)).Times(0);
   EXPECT_TRUE(packet_router.TimeToSendPacket(
@@ -164,8 +161,6 @@ TEST(PacketRouterTest, TimeToSendPacket) {
 
   // rtp_1 has been removed, try sending a packet on that ssrc and make sure
   // it is dropped as expected by not expecting any calls to rtp_1.
-  EXPECT_CALL(rtp_2, SendingMedia()).Times(1).WillOnce(Return(true));
-  EXPECT_CALL(rtp_2, SSRC()).Times(1).WillOnce(Return(kSsrc2));
   EXPECT_CALL(rtp_2, TimeToSendPacket(_, _, _, _, _)).Times(0);
   EXPECT_TRUE(packet_router.TimeToSendPacket(
       kSsrc1, sequence_number, timestamp, retransmission,
@@ -175,6 +170,41 @@ TEST(PacketRouterTest, TimeToSendPacket) {
   packet_router.RemoveSendRtpModule(&rtp_2);
 }
 
+TEST(PacketRouterTest, TimeToSendPacketAfterSsrcChange) {
+  PacketRouter packet_router;
+  NiceMock<MockRtpRtcp> rtp_1;
+  NiceMock<MockRtpRtcp> rtp_2;
+  packet_router.AddSendRtpModule(&rtp_1, false);
+  packet_router.AddSendRtpModule(&rtp_2, false);
+
+  const uint16_t kSsrc1 = 1234;
+  const uint16_t kSsrc2 = 4567;
+  const uint16_t sequence_number = 17;
+  const uint64_t timestamp = 7890;
+  const PacedPacketInfo paced_info(1, kProbeMinProbes, kProbeMinBytes);
+  ON_CALL(rtp_1, SendingMedia()).WillByDefault(Return(true));
+  ON_CALL(rtp_2, SendingMedia()).WillByDefault(Return(true));
+  ON_CALL(rtp_1, SSRC()).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_2, SSRC()).WillByDefault(Return(kSsrc2));
+
+  EXPECT_CALL(rtp_1, TimeToSendPacket(kSsrc1, _, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(packet_router.TimeToSendPacket(kSsrc1, sequence_number,
+                                             timestamp, false, paced_info));
+
+  // The modules swap SSRCs, after packets were sent on rtp_1 with kSsrc1.
+  ON_CALL(rtp_1, SSRC()).WillByDefault(Return(kSsrc2));
+  ON_CALL(rtp_2, SSRC()).WillByDefault(Return(kSsrc1));
+  EXPECT_CALL(rtp_1, TimeToSendPacket(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(rtp_2, TimeToSendPacket(kSsrc1, _, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(packet_router.TimeToSendPacket(kSsrc1, sequence_number,
+                                             timestamp, false, paced_info));
+
+  packet_router.RemoveSendRtpModule(&rtp_1);
+  packet_router.RemoveSendRtpModule(&rtp_2);
+}
+
 TEST(PacketRouterTest, TimeToSendPadding) {
   PacketRouter packet_router;
 
@@ -0,0 +1,286 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pooled_packet_queue.h"
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+constexpr int64_t PooledPacketQueue::kQuantumBytes;
+constexpr int PooledPacketQueue::kNumPriorities;
+constexpr int PooledPacketQueue::kNumClasses;
+
+PooledPacketQueue::Node::Node(const Packet& packet)
+    : packet(packet), enqueue_time_ms(packet.enqueue_time_ms) {}
+
+PooledPacketQueue::Stream::Stream(uint32_t ssrc) : ssrc(ssrc) {}
+
+PooledPacketQueue::PooledPacketQueue(const Clock* clock)
+    : clock_(clock), time_last_updated_(clock_->TimeInMilliseconds()) {}
+
+PooledPacketQueue::~PooledPacketQueue() {
+  while (oldest_) {
+    Node* node = oldest_;
+    oldest_ = node->next_in_queue;
+    delete node;
+  }
+  while (free_nodes_) {
+    Node* node = free_nodes_;
+    free_nodes_ = node->next_in_class;
+    delete node;
+  }
+}
+
+void PooledPacketQueue::Push(const Packet& packet) {
+  RTC_DCHECK_GE(packet.priority, 0);
+  RTC_DCHECK_LT(packet.priority, kNumPriorities);
+  Stream* stream = GetStream(packet.ssrc);
+  Node* node = AllocateNode(packet);
+
+  // See RoundRobinPacketQueue::Push() for how pause time is accounted for.
+  UpdateQueueTime(node->packet.enqueue_time_ms);
+  node->packet.enqueue_time_ms -= pause_time_sum_ms_;
+
+  const int class_index = ClassIndex(node->packet);
+  if (stream->tail[class_index]) {
+    stream->tail[class_index]->next_in_class = node;
+  } else {
+    stream->head[class_index] = node;
+  }
+  stream->tail[class_index] = node;
+
+  node->prev_in_queue = newest_;
+  if (newest_) {
+    newest_->next_in_queue = node;
+  } else {
+    oldest_ = node;
+  }
+  newest_ = node;
+
+  const int priority = TopNode(*stream)->packet.priority;
+  if (stream->scheduled_priority < 0) {
+    stream->deficit = kQuantumBytes * stream->weight;
+    Schedule(stream, priority);
+  } else if (priority < stream->scheduled_priority) {
+    // Note that RtpPacketSender::Priority uses lower ordinal for higher
+    // priority.
+    Unschedule(stream);
+    Schedule(stream, priority);
+  }
+
+  size_packets_ += 1;
+  size_bytes_ += packet.bytes;
+}
+
+const PacketQueueInterface::Packet& PooledPacketQueue::BeginPop() {
+  RTC_CHECK(!pop_node_ && !pop_stream_);
+  for (Stream* stream : rings_) {
+    if (stream) {
+      pop_stream_ = stream;
+      pop_node_ = TopNode(*stream);
+      RTC_CHECK(pop_node_);
+      return pop_node_->packet;
+    }
+  }
+  RTC_CHECK(false) << "BeginPop() called on an empty queue.";
+  return pop_node_->packet;
+}
+
+void PooledPacketQueue::CancelPop(const Packet& packet) {
+  RTC_CHECK(pop_node_ && pop_stream_);
+  // The packet was never unlinked, so it stays first in line.
+  pop_node_ = nullptr;
+  pop_stream_ = nullptr;
+}
+
+void PooledPacketQueue::FinalizePop(const Packet& packet) {
+  if (Empty())
+    return;
+  RTC_CHECK(pop_node_ && pop_stream_);
+  Stream* stream = pop_stream_;
+  Node* node = pop_node_;
+  pop_node_ = nullptr;
+  pop_stream_ = nullptr;
+
+  // Packets pushed since BeginPop() went to the back of their class, so the
+  // popped one is still at the front of its own.
+  const int class_index = ClassIndex(node->packet);
+  RTC_CHECK_EQ(stream->head[class_index], node);
+  stream->head[class_index] = node->next_in_class;
+  if (!stream->head[class_index])
+    stream->tail[class_index] = nullptr;
+
+  if (node->prev_in_queue) {
+    node->prev_in_queue->next_in_queue = node->next_in_queue;
+  } else {
+    oldest_ = node->next_in_queue;
+  }
+  if (node->next_in_queue) {
+    node->next_in_queue->prev_in_queue = node->prev_in_queue;
+  } else {
+    newest_ = node->prev_in_queue;
+  }
+
+  // See RoundRobinPacketQueue::FinalizePop().
+  int64_t time_in_non_paused_state_ms =
+      time_last_updated_ - node->packet.enqueue_time_ms - pause_time_sum_ms_;
+  queue_time_sum_ms_ -= time_in_non_paused_state_ms;
+
+  size_bytes_ -= node->packet.bytes;
+  size_packets_ -= 1;
+  RTC_CHECK(size_packets_ > 0 || queue_time_sum_ms_ == 0);
+  stream->deficit -= node->packet.bytes;
+  ReleaseNode(node);
+
+  Node* top = TopNode(*stream);
+  if (!top) {
+    Unschedule(stream);
+    stream->deficit = 0;
+    return;
+  }
+  const int priority = top->packet.priority;
+  if (priority != stream->scheduled_priority || stream->deficit <= 0) {
+    // Used up its share of this round, or moved to another priority: go to
+    // the back of the line.
+    while (stream->deficit <= 0)
+      stream->deficit += kQuantumBytes * stream->weight;
+    Unschedule(stream);
+    Schedule(stream, priority);
+  }
+}
+
+bool PooledPacketQueue::Empty() const {
+  return size_packets_ == 0;
+}
+
+size_t PooledPacketQueue::SizeInPackets() const {
+  return size_packets_;
+}
+
+uint64_t PooledPacketQueue::SizeInBytes() const {
+  return size_bytes_;
+}
+
+int64_t PooledPacketQueue::OldestEnqueueTimeMs() const {
+  if (Empty())
+    return 0;
+  return oldest_->enqueue_time_ms;
+}
+
+void PooledPacketQueue::UpdateQueueTime(int64_t timestamp_ms) {
+  RTC_CHECK_GE(timestamp_ms, time_last_updated_);
+  if (timestamp_ms == time_last_updated_)
+    return;
+
+  int64_t delta_ms = timestamp_ms - time_last_updated_;
+
+  if (paused_) {
+    pause_time_sum_ms_ += delta_ms;
+  } else {
+    queue_time_sum_ms_ += delta_ms * size_packets_;
+  }
+
+  time_last_updated_ = timestamp_ms;
+}
+
+void PooledPacketQueue::SetPauseState(bool paused, int64_t timestamp_ms) {
+  if (paused_ == paused)
+    return;
+  UpdateQueueTime(timestamp_ms);
+  paused_ = paused;
+}
+
+int64_t PooledPacketQueue::AverageQueueTimeMs() const {
+  if (Empty())
+    return 0;
+  return queue_time_sum_ms_ / size_packets_;
+}
+
+void PooledPacketQueue::SetStreamWeight(uint32_t ssrc, int weight) {
+  RTC_DCHECK_GE(weight, 1);
+  GetStream(ssrc)->weight = weight;
+}
+
+int PooledPacketQueue::ClassIndex(const Packet& packet) {
+  // Same order as Packet::operator<: by priority, then retransmissions first.
+  return 2 * packet.priority + (packet.retransmission ? 0 : 1);
+}
+
+PooledPacketQueue::Node* PooledPacketQueue::TopNode(const Stream& stream) {
+  for (Node* node : stream.head) {
+    if (node)
+      return node;
+  }
+  return nullptr;
+}
+
+PooledPacketQueue::Stream* PooledPacketQueue::GetStream(uint32_t ssrc) {
+  std::unique_ptr<Stream>& stream = streams_[ssrc];
+  if (!stream)
+    stream = absl::make_unique<Stream>(ssrc);
+  return stream.get();
+}
+
+void PooledPacketQueue::Schedule(Stream* stream, int priority) {
+  RTC_DCHECK_LT(stream->scheduled_priority, 0);
+  stream->scheduled_priority = priority;
+  Stream*& front = rings_[priority];
+  if (!front) {
+    stream->prev_in_ring = stream;
+    stream->next_in_ring = stream;
+    front = stream;
+    return;
+  }
+  // Insert at the back, just before the front.
+  stream->next_in_ring = front;
+  stream->prev_in_ring = front->prev_in_ring;
+  front->prev_in_ring->next_in_ring = stream;
+  front->prev_in_ring = stream;
+}
+
+void PooledPacketQueue::Unschedule(Stream* stream) {
+  RTC_DCHECK_GE(stream->scheduled_priority, 0);
+  Stream*& front = rings_[stream->scheduled_priority];
+  if (stream->next_in_ring == stream) {
+    front = nullptr;
+  } else {
+    stream->prev_in_ring->next_in_ring = stream->next_in_ring;
+    stream->next_in_ring->prev_in_ring = stream->prev_in_ring;
+    if (front == stream)
+      front = stream->next_in_ring;
+  }
+  stream->prev_in_ring = nullptr;
+  stream->next_in_ring = nullptr;
+  stream->scheduled_priority = -1;
+}
+
+PooledPacketQueue::Node* PooledPacketQueue::AllocateNode(
+    const Packet& packet) {
+  if (!free_nodes_)
+    return new Node(packet);
+  Node* node = free_nodes_;
+  free_nodes_ = node->next_in_class;
+  node->packet = packet;
+  node->enqueue_time_ms = packet.enqueue_time_ms;
+  node->next_in_class = nullptr;
+  node->prev_in_queue = nullptr;
+  node->next_in_queue = nullptr;
+  return node;
+}
+
+void PooledPacketQueue::ReleaseNode(Node* node) {
+  node->next_in_class = free_nodes_;
+  free_nodes_ = node;
+}
+
+}  // namespace webrtc
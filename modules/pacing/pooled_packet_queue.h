@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_POOLED_PACKET_QUEUE_H_
+#define MODULES_PACING_POOLED_PACKET_QUEUE_H_
+
+#include <memory>
+#include <unordered_map>
+
+#include "modules/pacing/packet_queue_interface.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+
+namespace webrtc {
+
+// Packet queue with the same ordering rules as RoundRobinPacketQueue, but
+// without per-packet allocations and with O(1) Push() and pop.
+//
+// Packets live in pooled nodes that are linked into intrusive lists: one FIFO
+// per stream for each (priority, retransmission) class, and one list across
+// all packets in enqueue order. Streams that have packets are scheduled with
+// deficit round robin, one ring per priority. A stream may send while its
+// deficit is positive, and gets a new quantum of kQuantumBytes times its
+// weight when it is rotated to the back of its ring. With the default weight
+// of one for all streams this shares the bitrate equally between streams of
+// the same priority, like RoundRobinPacketQueue does.
+class PooledPacketQueue : public PacketQueueInterface {
+ public:
+  explicit PooledPacketQueue(const Clock* clock);
+  ~PooledPacketQueue() override;
+
+  using Packet = PacketQueueInterface::Packet;
+
+  static constexpr int64_t kQuantumBytes = 1400;
+
+  void Push(const Packet& packet) override;
+  const Packet& BeginPop() override;
+  void CancelPop(const Packet& packet) override;
+  void FinalizePop(const Packet& packet) override;
+
+  bool Empty() const override;
+  size_t SizeInPackets() const override;
+  uint64_t SizeInBytes() const override;
+
+  int64_t OldestEnqueueTimeMs() const override;
+  int64_t AverageQueueTimeMs() const override;
+  void UpdateQueueTime(int64_t timestamp_ms) override;
+  void SetPauseState(bool paused, int64_t timestamp_ms) override;
+
+  // Weighted fair queueing: a stream with weight N gets N times the share of
+  // a stream with weight one among the streams of the same priority. Weights
+  // must be at least one.
+  void SetStreamWeight(uint32_t ssrc, int weight);
+
+ private:
+  // RtpPacketSender::Priority values are used as indices.
+  static constexpr int kNumPriorities = RtpPacketSender::kLowPriority + 1;
+  // Retransmissions and original packets of each priority.
+  static constexpr int kNumClasses = 2 * kNumPriorities;
+
+  struct Node {
+    explicit Node(const Packet& packet);
+
+    Packet packet;
+    // |packet.enqueue_time_ms| is adjusted for pauses, this is the original.
+    int64_t enqueue_time_ms;
+    // Next packet of the same stream and class.
+    Node* next_in_class = nullptr;
+    // Neighbours in enqueue order, across all streams.
+    Node* prev_in_queue = nullptr;
+    Node* next_in_queue = nullptr;
+  };
+
+  struct Stream {
+    explicit Stream(uint32_t ssrc);
+
+    const uint32_t ssrc;
+    int weight = 1;
+    int64_t deficit = 0;
+    // Heads and tails of the per-class FIFOs; see ClassIndex().
+    Node* head[kNumClasses] = {};
+    Node* tail[kNumClasses] = {};
+    // Priority ring this stream is scheduled in, or -1 if it has no packets.
+    int scheduled_priority = -1;
+    Stream* prev_in_ring = nullptr;
+    Stream* next_in_ring = nullptr;
+  };
+
+  static int ClassIndex(const Packet& packet);
+  // Returns the first packet of |stream| by Packet::operator< order, or null.
+  static Node* TopNode(const Stream& stream);
+
+  Stream* GetStream(uint32_t ssrc);
+  void Schedule(Stream* stream, int priority);
+  void Unschedule(Stream* stream);
+
+  Node* AllocateNode(const Packet& packet);
+  void ReleaseNode(Node* node);
+
+  const Clock* const clock_;
+  int64_t time_last_updated_;
+  Node* pop_node_ = nullptr;
+  Stream* pop_stream_ = nullptr;
+
+  bool paused_ = false;
+  size_t size_packets_ = 0;
+  size_t size_bytes_ = 0;
+  int64_t queue_time_sum_ms_ = 0;
+  int64_t pause_time_sum_ms_ = 0;
+
+  // Circular lists of scheduled streams, indexed by priority. Each entry
+  // points to the stream at the front of the ring.
+  Stream* rings_[kNumPriorities] = {};
+
+  std::unordered_map<uint32_t, std::unique_ptr<Stream>> streams_;
+
+  // All queued packets in enqueue order, used to find the oldest one.
+  Node* oldest_ = nullptr;
+  Node* newest_ = nullptr;
+
+  // Nodes of popped packets, linked through |next_in_class|. Never shrinks,
+  // so once the queue has been through its largest burst it stops allocating.
+  Node* free_nodes_ = nullptr;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_POOLED_PACKET_QUEUE_H_
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pooled_packet_queue.h"
+
+#include <map>
+
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Packet = PacketQueueInterface::Packet;
+
+constexpr size_t kPacketSize = 1200;
+
+class PooledPacketQueueTest : public ::testing::Test {
+ protected:
+  PooledPacketQueueTest() : clock_(123456), queue_(&clock_) {}
+
+  void Push(RtpPacketSender::Priority priority,
+            uint32_t ssrc,
+            uint16_t sequence_number,
+            bool retransmission = false,
+            size_t bytes = kPacketSize) {
+    queue_.Push(Packet(priority, ssrc, sequence_number, 0,
+                       clock_.TimeInMilliseconds(), bytes, retransmission,
+                       enqueue_order_++));
+  }
+
+  Packet Pop() {
+    const Packet& packet = queue_.BeginPop();
+    Packet popped(packet);
+    queue_.FinalizePop(packet);
+    return popped;
+  }
+
+  SimulatedClock clock_;
+  PooledPacketQueue queue_;
+  uint64_t enqueue_order_ = 0;
+};
+
+}  // namespace
+
+TEST_F(PooledPacketQueueTest, OrdersPacketsOfAStream) {
+  Push(RtpPacketSender::kLowPriority, 1, 1);
+  Push(RtpPacketSender::kNormalPriority, 1, 2);
+  Push(RtpPacketSender::kNormalPriority, 1, 3, true);
+  Push(RtpPacketSender::kNormalPriority, 1, 4);
+  Push(RtpPacketSender::kHighPriority, 1, 5);
+  EXPECT_EQ(5u, queue_.SizeInPackets());
+  EXPECT_EQ(5 * kPacketSize, queue_.SizeInBytes());
+
+  EXPECT_EQ(5, Pop().sequence_number);
+  EXPECT_EQ(3, Pop().sequence_number);
+  EXPECT_EQ(2, Pop().sequence_number);
+  EXPECT_EQ(4, Pop().sequence_number);
+  EXPECT_EQ(1, Pop().sequence_number);
+  EXPECT_TRUE(queue_.Empty());
+  EXPECT_EQ(0u, queue_.SizeInBytes());
+}
+
+TEST_F(PooledPacketQueueTest, CancelledPopIsPoppedAgain) {
+  Push(RtpPacketSender::kNormalPriority, 1, 1);
+  Push(RtpPacketSender::kNormalPriority, 2, 2);
+  const Packet& packet = queue_.BeginPop();
+  EXPECT_EQ(1, packet.sequence_number);
+  queue_.CancelPop(packet);
+  EXPECT_EQ(1, Pop().sequence_number);
+  EXPECT_EQ(2, Pop().sequence_number);
+}
+
+TEST_F(PooledPacketQueueTest, HigherPriorityStreamGoesFirst) {
+  // One packet per round for each stream.
+  const size_t kBytes = PooledPacketQueue::kQuantumBytes;
+  Push(RtpPacketSender::kNormalPriority, 1, 1, false, kBytes);
+  Push(RtpPacketSender::kNormalPriority, 1, 2, false, kBytes);
+  Push(RtpPacketSender::kNormalPriority, 2, 3, false, kBytes);
+  Push(RtpPacketSender::kHighPriority, 2, 4, false, kBytes);
+  EXPECT_EQ(4, Pop().sequence_number);
+  EXPECT_EQ(1, Pop().sequence_number);
+  EXPECT_EQ(3, Pop().sequence_number);
+  EXPECT_EQ(2, Pop().sequence_number);
+}
+
+TEST_F(PooledPacketQueueTest, SharesEquallyBetweenStreams) {
+  for (uint16_t i = 0; i < 100; ++i) {
+    Push(RtpPacketSender::kNormalPriority, 1, i);
+    Push(RtpPacketSender::kNormalPriority, 2, i);
+    Push(RtpPacketSender::kNormalPriority, 3, i);
+  }
+  std::map<uint32_t, size_t> bytes_per_ssrc;
+  for (int i = 0; i < 150; ++i) {
+    Packet packet = Pop();
+    bytes_per_ssrc[packet.ssrc] += packet.bytes;
+  }
+  for (const auto& bytes : bytes_per_ssrc) {
+    EXPECT_NEAR(50 * kPacketSize, bytes.second,
+                PooledPacketQueue::kQuantumBytes + kPacketSize);
+  }
+}
+
+TEST_F(PooledPacketQueueTest, WeightedFairQueueing) {
+  queue_.SetStreamWeight(2, 3);
+  for (uint16_t i = 0; i < 200; ++i) {
+    Push(RtpPacketSender::kNormalPriority, 1, i, false, 250);
+    Push(RtpPacketSender::kNormalPriority, 2, i, false, 250);
+  }
+  std::map<uint32_t, size_t> bytes_per_ssrc;
+  for (int i = 0; i < 200; ++i) {
+    Packet packet = Pop();
+    bytes_per_ssrc[packet.ssrc] += packet.bytes;
+  }
+  EXPECT_NEAR(3.0, static_cast<double>(bytes_per_ssrc[2]) / bytes_per_ssrc[1],
+              0.3);
+}
+
+TEST_F(PooledPacketQueueTest, TracksOldestEnqueueTime) {
+  const int64_t first_time_ms = clock_.TimeInMilliseconds();
+  Push(RtpPacketSender::kLowPriority, 1, 1);
+  clock_.AdvanceTimeMilliseconds(10);
+  Push(RtpPacketSender::kHighPriority, 2, 2);
+  EXPECT_EQ(first_time_ms, queue_.OldestEnqueueTimeMs());
+
+  queue_.UpdateQueueTime(clock_.TimeInMilliseconds());
+  EXPECT_EQ(5, queue_.AverageQueueTimeMs());
+
+  // The newer, high priority packet goes first.
+  EXPECT_EQ(2, Pop().sequence_number);
+  EXPECT_EQ(first_time_ms, queue_.OldestEnqueueTimeMs());
+  EXPECT_EQ(1, Pop().sequence_number);
+  EXPECT_EQ(0, queue_.OldestEnqueueTimeMs());
+  EXPECT_EQ(0, queue_.AverageQueueTimeMs());
+}
+
+TEST_F(PooledPacketQueueTest, ReusesNodesAcrossBursts) {
+  for (int burst = 0; burst < 3; ++burst) {
+    for (uint16_t i = 0; i < 50; ++i)
+      Push(RtpPacketSender::kNormalPriority, i % 5, i);
+    EXPECT_EQ(50u, queue_.SizeInPackets());
+    while (!queue_.Empty())
+      Pop();
+  }
+}
+
+}  // namespace webrtc
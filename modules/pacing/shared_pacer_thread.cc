@@ -0,0 +1,249 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacer_thread.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/include/module.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/timeutils.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+// Same as the idle wait of ProcessThreadImpl.
+const int64_t kMaxWaitMs = 1000 * 60;
+// The heap is only compacted when it is larger than this, to avoid doing it
+// over and over for a few modules.
+const size_t kMinCompactSize = 64;
+}  // namespace
+
+SharedPacerThread::SharedPacerThread(const char* thread_name)
+    : thread_name_(thread_name), wake_up_(false, false) {}
+
+SharedPacerThread::~SharedPacerThread() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(!thread_);
+
+  rtc::CritScope lock(&pending_lock_);
+  while (!queue_.empty()) {
+    delete queue_.front();
+    queue_.pop();
+  }
+}
+
+void SharedPacerThread::Start() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(!thread_);
+  if (thread_)
+    return;
+
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(!stop_);
+    running_ = true;
+    for (auto& module : modules_)
+      module.first->ProcessThreadAttached(this);
+  }
+
+  thread_.reset(
+      new rtc::PlatformThread(&SharedPacerThread::Run, this, thread_name_));
+  thread_->Start();
+}
+
+void SharedPacerThread::Stop() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  if (!thread_)
+    return;
+
+  {
+    rtc::CritScope lock(&lock_);
+    stop_ = true;
+  }
+
+  wake_up_.Set();
+  thread_->Stop();
+  thread_.reset();
+
+  rtc::CritScope lock(&lock_);
+  stop_ = false;
+  running_ = false;
+  for (auto& module : modules_)
+    module.first->ProcessThreadAttached(nullptr);
+}
+
+void SharedPacerThread::WakeUp(Module* module) {
+  // Allowed to be called on any thread.
+  {
+    rtc::CritScope lock(&pending_lock_);
+    pending_wake_ups_.push_back(module);
+  }
+  wake_up_.Set();
+}
+
+void SharedPacerThread::PostTask(std::unique_ptr<rtc::QueuedTask> task) {
+  // Allowed to be called on any thread.
+  {
+    rtc::CritScope lock(&pending_lock_);
+    queue_.push(task.release());
+  }
+  wake_up_.Set();
+}
+
+void SharedPacerThread::RegisterModule(Module* module,
+                                       const rtc::Location& from) {
+  // Allowed to be called on any thread.
+  RTC_DCHECK(module) << from.ToString();
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(modules_.find(module) == modules_.end())
+        << "Already registered, now attempting from here: "
+        << from.ToString();
+    modules_[module] = ModuleState{0, from};
+    if (running_)
+      module->ProcessThreadAttached(this);
+    // Like ProcessThreadImpl, ask the module when it wants to be called on the
+    // worker thread rather than calling Process() right away.
+    ScheduleLocked(module, rtc::TimeMillis(), true);
+  }
+  wake_up_.Set();
+}
+
+void SharedPacerThread::DeRegisterModule(Module* module) {
+  // Allowed to be called on any thread. Blocks while the module is being
+  // processed, so the module can be destroyed once this returns.
+  RTC_DCHECK(module);
+  {
+    rtc::CritScope lock(&lock_);
+    modules_.erase(module);
+  }
+  module->ProcessThreadAttached(nullptr);
+}
+
+size_t SharedPacerThread::NumModulesForTesting() const {
+  rtc::CritScope lock(&lock_);
+  return modules_.size();
+}
+
+// static
+bool SharedPacerThread::Run(void* obj) {
+  return static_cast<SharedPacerThread*>(obj)->Process();
+}
+
+bool SharedPacerThread::Process() {
+  TRACE_EVENT1("webrtc", "SharedPacerThread", "name", thread_name_);
+  ApplyPendingWakeUps();
+
+  int64_t next_checkpoint;
+  {
+    rtc::CritScope lock(&lock_);
+    if (stop_)
+      return false;
+
+    // Take out all the callbacks that are due before running any of them, so
+    // that a module that keeps asking to be called right away is called once
+    // per iteration, like with ProcessThreadImpl.
+    int64_t now = rtc::TimeMillis();
+    while (!schedule_.empty() && schedule_.top().time_ms <= now) {
+      due_.push_back(schedule_.top());
+      schedule_.pop();
+    }
+
+    for (const ScheduledCallback& callback : due_) {
+      auto it = modules_.find(callback.module);
+      if (it == modules_.end() || it->second.generation != callback.generation)
+        continue;
+      Module* module = callback.module;
+      if (!callback.query) {
+        TRACE_EVENT2("webrtc", "ModuleProcess", "function",
+                     it->second.location.function_name(), "file",
+                     it->second.location.file_and_line());
+        module->Process();
+      }
+      int64_t new_now = rtc::TimeMillis();
+      int64_t interval = module->TimeUntilNextProcess();
+      // Falling behind, we should call the callback now.
+      ScheduleLocked(module, new_now + std::max<int64_t>(interval, 0), false);
+    }
+    due_.clear();
+    CompactScheduleLocked();
+
+    next_checkpoint = now + kMaxWaitMs;
+    if (!schedule_.empty())
+      next_checkpoint = std::min(next_checkpoint, schedule_.top().time_ms);
+  }
+
+  while (true) {
+    rtc::QueuedTask* task;
+    {
+      rtc::CritScope lock(&pending_lock_);
+      if (queue_.empty())
+        break;
+      task = queue_.front();
+      queue_.pop();
+    }
+    if (task->Run())
+      delete task;
+  }
+
+  int64_t time_to_wait = next_checkpoint - rtc::TimeMillis();
+  if (time_to_wait > 0)
+    wake_up_.Wait(static_cast<int>(time_to_wait));
+
+  return true;
+}
+
+void SharedPacerThread::ScheduleLocked(Module* module,
+                                       int64_t time_ms,
+                                       bool query) {
+  uint64_t generation = next_generation_++;
+  modules_[module].generation = generation;
+  schedule_.push(ScheduledCallback{time_ms, generation, module, query});
+}
+
+void SharedPacerThread::CompactScheduleLocked() {
+  if (schedule_.size() < kMinCompactSize ||
+      schedule_.size() < 2 * modules_.size()) {
+    return;
+  }
+  RTC_DCHECK(due_.empty());
+  while (!schedule_.empty()) {
+    const ScheduledCallback& callback = schedule_.top();
+    auto it = modules_.find(callback.module);
+    if (it != modules_.end() && it->second.generation == callback.generation)
+      due_.push_back(callback);
+    schedule_.pop();
+  }
+  for (const ScheduledCallback& callback : due_)
+    schedule_.push(callback);
+  due_.clear();
+}
+
+void SharedPacerThread::ApplyPendingWakeUps() {
+  {
+    rtc::CritScope lock(&pending_lock_);
+    if (pending_wake_ups_.empty())
+      return;
+    wake_ups_.swap(pending_wake_ups_);
+  }
+  rtc::CritScope lock(&lock_);
+  int64_t now = rtc::TimeMillis();
+  for (Module* module : wake_ups_) {
+    // The module may have been deregistered since it was woken up.
+    if (modules_.find(module) != modules_.end())
+      ScheduleLocked(module, now, false);
+  }
+  wake_ups_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_SHARED_PACER_THREAD_H_
+#define MODULES_PACING_SHARED_PACER_THREAD_H_
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/utility/include/process_thread.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/location.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/thread_checker.h"
+
+namespace webrtc {
+
+// A ProcessThread meant to drive the pacers of many transports, e.g. all
+// egress connections of an SFU, from a single thread.
+//
+// ProcessThreadImpl asks every registered module for its next deadline on
+// each wakeup, which is fine for a handful of modules but grows linearly with
+// the number of connections. This class instead keeps the modules in a
+// min-heap ordered by their next process time, so a wakeup only touches the
+// modules that are due, and the thread sleeps until the earliest deadline.
+//
+// Each PacedSender still sends through its own PacketSender, so the per
+// transport PacketRouter setup is unchanged. Unlike ProcessThreadImpl,
+// modules may be registered and deregistered from any thread, since
+// transports are typically created and destroyed independently of the owner
+// of the thread. Start() and Stop() must be called on the construction thread.
+class SharedPacerThread : public ProcessThread {
+ public:
+  explicit SharedPacerThread(const char* thread_name);
+  ~SharedPacerThread() override;
+
+  void Start() override;
+  void Stop() override;
+
+  void WakeUp(Module* module) override;
+  void PostTask(std::unique_ptr<rtc::QueuedTask> task) override;
+
+  void RegisterModule(Module* module, const rtc::Location& from) override;
+  void DeRegisterModule(Module* module) override;
+
+  size_t NumModulesForTesting() const;
+
+ private:
+  struct ScheduledCallback {
+    int64_t time_ms;
+    // Entries whose generation doesn't match the module's current one have
+    // been superseded by a later WakeUp() or a DeRegisterModule() and are
+    // dropped when they reach the top of the heap.
+    uint64_t generation;
+    Module* module;
+    // If set, TimeUntilNextProcess() is queried at |time_ms| to find the
+    // process time, rather than calling Process() directly.
+    bool query;
+
+    bool operator>(const ScheduledCallback& other) const {
+      return time_ms > other.time_ms;
+    }
+  };
+
+  struct ModuleState {
+    uint64_t generation;
+    rtc::Location location;
+  };
+
+  static bool Run(void* obj);
+  bool Process();
+
+  // Schedules a new callback for |module| at |time_ms|, invalidating earlier
+  // ones.
+  void ScheduleLocked(Module* module, int64_t time_ms, bool query)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Drops superseded callbacks once they make up most of the heap, which
+  // happens if modules are woken up much more often than they are due.
+  void CompactScheduleLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void ApplyPendingWakeUps();
+
+  const char* const thread_name_;
+  rtc::ThreadChecker thread_checker_;
+  rtc::Event wake_up_;
+
+  rtc::CriticalSection lock_;  // Held while running module callbacks.
+  std::unordered_map<Module*, ModuleState> modules_ RTC_GUARDED_BY(lock_);
+  std::priority_queue<ScheduledCallback,
+                      std::vector<ScheduledCallback>,
+                      std::greater<ScheduledCallback>>
+      schedule_ RTC_GUARDED_BY(lock_);
+  uint64_t next_generation_ RTC_GUARDED_BY(lock_) = 1;
+  bool running_ RTC_GUARDED_BY(lock_) = false;
+  bool stop_ RTC_GUARDED_BY(lock_) = false;
+  // Only used on the worker thread; kept to avoid allocating per iteration.
+  std::vector<ScheduledCallback> due_;
+  std::vector<Module*> wake_ups_;
+
+  // WakeUp() and PostTask() are called from the pacers' callers, often while
+  // a module callback is running with |lock_| held on the worker thread, so
+  // they use a separate lock and are applied at the start of each iteration.
+  rtc::CriticalSection pending_lock_;
+  std::vector<Module*> pending_wake_ups_ RTC_GUARDED_BY(pending_lock_);
+  std::queue<rtc::QueuedTask*> queue_ RTC_GUARDED_BY(pending_lock_);
+
+  std::unique_ptr<rtc::PlatformThread> thread_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_SHARED_PACER_THREAD_H_
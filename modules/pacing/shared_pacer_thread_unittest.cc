@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacer_thread.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "modules/include/module.h"
+#include "rtc_base/event.h"
+#include "rtc_base/location.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int kEventWaitTimeout = 500;
+
+// Asks to be processed every |interval_ms| and signals |event| on the
+// |signal_at|:th call to Process().
+class FakeModule : public Module {
+ public:
+  explicit FakeModule(int64_t interval_ms, int signal_at = 1)
+      : interval_ms_(interval_ms),
+        signal_at_(signal_at),
+        last_process_ms_(rtc::TimeMillis()) {}
+
+  int64_t TimeUntilNextProcess() override {
+    return last_process_ms_ + interval_ms_ - rtc::TimeMillis();
+  }
+  void Process() override {
+    last_process_ms_ = rtc::TimeMillis();
+    if (++process_count_ == signal_at_)
+      event_.Set();
+  }
+  void ProcessThreadAttached(ProcessThread* process_thread) override {
+    attached_ = process_thread;
+  }
+
+  int process_count() const { return process_count_; }
+  ProcessThread* attached() const { return attached_; }
+  bool Wait() { return event_.Wait(kEventWaitTimeout); }
+
+ private:
+  const int64_t interval_ms_;
+  const int signal_at_;
+  int64_t last_process_ms_;
+  std::atomic<int> process_count_{0};
+  std::atomic<ProcessThread*> attached_{nullptr};
+  rtc::Event event_{false, false};
+};
+
+class SignalTask : public rtc::QueuedTask {
+ public:
+  explicit SignalTask(rtc::Event* event) : event_(event) {}
+  bool Run() override {
+    event_->Set();
+    return true;
+  }
+
+ private:
+  rtc::Event* const event_;
+};
+
+}  // namespace
+
+TEST(SharedPacerThreadTest, AttachesAndProcessesModules) {
+  SharedPacerThread thread("SharedPacer");
+  FakeModule before_start(5);
+  thread.RegisterModule(&before_start, RTC_FROM_HERE);
+  EXPECT_EQ(nullptr, before_start.attached());
+
+  thread.Start();
+  EXPECT_EQ(&thread, before_start.attached());
+  FakeModule after_start(5);
+  thread.RegisterModule(&after_start, RTC_FROM_HERE);
+  EXPECT_EQ(&thread, after_start.attached());
+
+  EXPECT_TRUE(before_start.Wait());
+  EXPECT_TRUE(after_start.Wait());
+
+  thread.Stop();
+  EXPECT_EQ(nullptr, before_start.attached());
+  EXPECT_EQ(nullptr, after_start.attached());
+  thread.DeRegisterModule(&before_start);
+  thread.DeRegisterModule(&after_start);
+  EXPECT_EQ(0u, thread.NumModulesForTesting());
+}
+
+TEST(SharedPacerThreadTest, ProcessesModulesAtTheirOwnDeadlines) {
+  SharedPacerThread thread("SharedPacer");
+  FakeModule fast(5);
+  FakeModule slow(50, 3);
+  thread.RegisterModule(&fast, RTC_FROM_HERE);
+  thread.RegisterModule(&slow, RTC_FROM_HERE);
+  const int64_t start_ms = rtc::TimeMillis();
+  thread.Start();
+
+  EXPECT_TRUE(slow.Wait());
+  const int64_t elapsed_ms = rtc::TimeMillis() - start_ms;
+  const int fast_count = fast.process_count();
+  thread.Stop();
+
+  EXPECT_GE(elapsed_ms, 150);
+  // The fast module is not processed more often than it asks for, and the
+  // slow one doesn't hold it back.
+  EXPECT_LE(fast_count, elapsed_ms / 5 + 1);
+  EXPECT_GE(fast_count, 3 * 5);
+  thread.DeRegisterModule(&fast);
+  thread.DeRegisterModule(&slow);
+}
+
+TEST(SharedPacerThreadTest, WakeUpProcessesModuleRightAway) {
+  SharedPacerThread thread("SharedPacer");
+  FakeModule module(60 * 1000);
+  thread.RegisterModule(&module, RTC_FROM_HERE);
+  thread.Start();
+
+  // Superseded wake-ups are dropped from the schedule.
+  for (int i = 0; i < 1000; ++i)
+    thread.WakeUp(&module);
+  EXPECT_TRUE(module.Wait());
+  thread.Stop();
+  EXPECT_LE(module.process_count(), 1000);
+  thread.DeRegisterModule(&module);
+}
+
+TEST(SharedPacerThreadTest, DeregisteredModulesAreNotProcessed) {
+  SharedPacerThread thread("SharedPacer");
+  std::vector<std::unique_ptr<FakeModule>> modules;
+  for (int i = 0; i < 100; ++i) {
+    modules.push_back(absl::make_unique<FakeModule>(1));
+    thread.RegisterModule(modules.back().get(), RTC_FROM_HERE);
+  }
+  thread.Start();
+  for (auto& module : modules)
+    EXPECT_TRUE(module->Wait());
+
+  std::vector<int> counts;
+  for (size_t i = 0; i < modules.size(); i += 2) {
+    thread.DeRegisterModule(modules[i].get());
+    EXPECT_EQ(nullptr, modules[i]->attached());
+    counts.push_back(modules[i]->process_count());
+  }
+  EXPECT_EQ(50u, thread.NumModulesForTesting());
+
+  // Wait for another round of the remaining modules.
+  FakeModule marker(1, 10);
+  thread.RegisterModule(&marker, RTC_FROM_HERE);
+  EXPECT_TRUE(marker.Wait());
+  thread.Stop();
+
+  for (size_t i = 0; i < modules.size(); i += 2)
+    EXPECT_EQ(counts[i / 2], modules[i]->process_count());
+  for (size_t i = 1; i < modules.size(); i += 2)
+    thread.DeRegisterModule(modules[i].get());
+  thread.DeRegisterModule(&marker);
+}
+
+TEST(SharedPacerThreadTest, RunsPostedTasks) {
+  SharedPacerThread thread("SharedPacer");
+  rtc::Event event(false, false);
+  thread.Start();
+  thread.PostTask(absl::make_unique<SignalTask>(&event));
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+  thread.Stop();
+}
+
+}  // namespace webrtc
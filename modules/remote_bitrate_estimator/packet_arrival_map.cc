@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+constexpr size_t kMinCapacity = 128;
+}  // namespace
+
+constexpr int64_t PacketArrivalTimeMap::kNotReceived;
+constexpr size_t PacketArrivalTimeMap::kMaxNumberOfPackets;
+
+PacketArrivalTimeMap::PacketArrivalTimeMap()
+    : arrival_times_(kMinCapacity, kNotReceived),
+      begin_sequence_number_(0),
+      end_sequence_number_(0) {}
+
+PacketArrivalTimeMap::~PacketArrivalTimeMap() = default;
+
+int64_t PacketArrivalTimeMap::get(int64_t sequence_number) const {
+  RTC_DCHECK_GE(sequence_number, begin_sequence_number_);
+  RTC_DCHECK_LT(sequence_number, end_sequence_number_);
+  return arrival_times_[Index(sequence_number)];
+}
+
+bool PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
+                                     int64_t arrival_time_ms) {
+  RTC_DCHECK_NE(arrival_time_ms, kNotReceived);
+  if (begin_sequence_number_ == end_sequence_number_) {
+    begin_sequence_number_ = sequence_number;
+    end_sequence_number_ = sequence_number + 1;
+    arrival_times_[Index(sequence_number)] = arrival_time_ms;
+    return true;
+  }
+
+  if (sequence_number >= end_sequence_number_) {
+    const int64_t new_begin = std::max(
+        begin_sequence_number_,
+        sequence_number + 1 - static_cast<int64_t>(kMaxNumberOfPackets));
+    if (new_begin >= end_sequence_number_) {
+      // Nothing of the current contents is kept.
+      begin_sequence_number_ = sequence_number;
+      end_sequence_number_ = sequence_number;
+    } else {
+      begin_sequence_number_ = new_begin;
+    }
+    Reserve(sequence_number + 1 - begin_sequence_number_);
+    for (int64_t seq = end_sequence_number_; seq < sequence_number; ++seq)
+      arrival_times_[Index(seq)] = kNotReceived;
+    arrival_times_[Index(sequence_number)] = arrival_time_ms;
+    end_sequence_number_ = sequence_number + 1;
+    return true;
+  }
+
+  if (sequence_number < begin_sequence_number_) {
+    if (end_sequence_number_ - sequence_number >
+        static_cast<int64_t>(kMaxNumberOfPackets)) {
+      return false;
+    }
+    Reserve(end_sequence_number_ - sequence_number);
+    for (int64_t seq = sequence_number + 1; seq < begin_sequence_number_; ++seq)
+      arrival_times_[Index(seq)] = kNotReceived;
+    arrival_times_[Index(sequence_number)] = arrival_time_ms;
+    begin_sequence_number_ = sequence_number;
+    return true;
+  }
+
+  int64_t& arrival_time = arrival_times_[Index(sequence_number)];
+  if (arrival_time != kNotReceived)
+    return false;
+  arrival_time = arrival_time_ms;
+  return true;
+}
+
+void PacketArrivalTimeMap::RemoveOldPackets(int64_t sequence_number,
+                                            int64_t arrival_time_limit_ms) {
+  while (begin_sequence_number_ < end_sequence_number_ &&
+         begin_sequence_number_ < sequence_number) {
+    const int64_t arrival_time = arrival_times_[Index(begin_sequence_number_)];
+    if (arrival_time != kNotReceived && arrival_time > arrival_time_limit_ms)
+      break;
+    ++begin_sequence_number_;
+  }
+}
+
+void PacketArrivalTimeMap::Reserve(size_t span) {
+  RTC_DCHECK_LE(span, kMaxNumberOfPackets);
+  if (span <= arrival_times_.size())
+    return;
+  size_t capacity = arrival_times_.size();
+  while (capacity < span)
+    capacity *= 2;
+  std::vector<int64_t> arrival_times(capacity, kNotReceived);
+  const size_t mask = capacity - 1;
+  for (int64_t seq = begin_sequence_number_; seq < end_sequence_number_; ++seq)
+    arrival_times[static_cast<size_t>(seq) & mask] = get(seq);
+  arrival_times_.swap(arrival_times);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace webrtc {
+
+// Arrival times of packets, indexed by unwrapped transport sequence number.
+// The packets are stored in a circular buffer covering the sequence numbers
+// [begin_sequence_number(), end_sequence_number()), with packets that haven't
+// been received marked as such. Adding and looking up packets is O(1), and
+// the buffer is only reallocated when the covered range grows past its
+// capacity, which doesn't happen in steady state.
+class PacketArrivalTimeMap {
+ public:
+  static constexpr int64_t kNotReceived = -1;
+  // The largest range of sequence numbers kept. When a packet is added
+  // further ahead than this, the oldest packets are dropped.
+  static constexpr size_t kMaxNumberOfPackets = 1 << 15;
+
+  PacketArrivalTimeMap();
+  ~PacketArrivalTimeMap();
+
+  // First sequence number in the map. Equals end_sequence_number() if the map
+  // is empty.
+  int64_t begin_sequence_number() const { return begin_sequence_number_; }
+  // One past the last received sequence number in the map.
+  int64_t end_sequence_number() const { return end_sequence_number_; }
+
+  // Returns the arrival time of |sequence_number|, or kNotReceived. Must be
+  // called with a sequence number in [begin_sequence_number(),
+  // end_sequence_number()).
+  int64_t get(int64_t sequence_number) const;
+
+  // Records the arrival of |sequence_number|. Returns false if the packet was
+  // already received, or is too old to be kept.
+  bool AddPacket(int64_t sequence_number, int64_t arrival_time_ms);
+
+  // Drops packets from the beginning of the map that are older than
+  // |sequence_number| and arrived at or before |arrival_time_limit_ms|. Stops
+  // at the first received packet that doesn't meet both conditions.
+  void RemoveOldPackets(int64_t sequence_number, int64_t arrival_time_limit_ms);
+
+ private:
+  size_t Index(int64_t sequence_number) const {
+    // Capacity is a power of two, so this works for negative sequence
+    // numbers too.
+    return static_cast<size_t>(sequence_number) & (arrival_times_.size() - 1);
+  }
+  // Makes room for |span| consecutive sequence numbers, keeping the current
+  // contents.
+  void Reserve(size_t span);
+
+  std::vector<int64_t> arrival_times_;
+  int64_t begin_sequence_number_;
+  int64_t end_sequence_number_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
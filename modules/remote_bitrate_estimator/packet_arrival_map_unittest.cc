@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(PacketArrivalMapTest, IsConsistentWhenEmpty) {
+  PacketArrivalTimeMap map;
+  EXPECT_EQ(map.begin_sequence_number(), map.end_sequence_number());
+}
+
+TEST(PacketArrivalMapTest, InsertsFirstItemIntoMap) {
+  PacketArrivalTimeMap map;
+  EXPECT_TRUE(map.AddPacket(42, 10));
+  EXPECT_EQ(42, map.begin_sequence_number());
+  EXPECT_EQ(43, map.end_sequence_number());
+  EXPECT_EQ(10, map.get(42));
+}
+
+TEST(PacketArrivalMapTest, MarksGapsAsNotReceived) {
+  PacketArrivalTimeMap map;
+  EXPECT_TRUE(map.AddPacket(42, 10));
+  EXPECT_TRUE(map.AddPacket(45, 11));
+  EXPECT_EQ(PacketArrivalTimeMap::kNotReceived, map.get(43));
+  EXPECT_EQ(PacketArrivalTimeMap::kNotReceived, map.get(44));
+  EXPECT_EQ(11, map.get(45));
+
+  // Reordered packets fill the gaps, and may extend the map backwards.
+  EXPECT_TRUE(map.AddPacket(44, 12));
+  EXPECT_TRUE(map.AddPacket(40, 13));
+  EXPECT_EQ(40, map.begin_sequence_number());
+  EXPECT_EQ(46, map.end_sequence_number());
+  EXPECT_EQ(13, map.get(40));
+  EXPECT_EQ(PacketArrivalTimeMap::kNotReceived, map.get(41));
+  EXPECT_EQ(12, map.get(44));
+}
+
+TEST(PacketArrivalMapTest, KeepsFirstArrivalOfDuplicates) {
+  PacketArrivalTimeMap map;
+  EXPECT_TRUE(map.AddPacket(42, 10));
+  EXPECT_FALSE(map.AddPacket(42, 20));
+  EXPECT_EQ(10, map.get(42));
+}
+
+TEST(PacketArrivalMapTest, GrowsAndKeepsContents) {
+  PacketArrivalTimeMap map;
+  for (int64_t seq = 1000; seq < 3000; seq += 2)
+    EXPECT_TRUE(map.AddPacket(seq, seq * 10));
+  EXPECT_EQ(1000, map.begin_sequence_number());
+  EXPECT_EQ(2999, map.end_sequence_number());
+  for (int64_t seq = 1000; seq < 2999; ++seq) {
+    EXPECT_EQ(seq % 2 == 0 ? seq * 10 : PacketArrivalTimeMap::kNotReceived,
+              map.get(seq));
+  }
+}
+
+TEST(PacketArrivalMapTest, DropsOldestPacketsWhenFull) {
+  PacketArrivalTimeMap map;
+  const int64_t kMaxPackets = PacketArrivalTimeMap::kMaxNumberOfPackets;
+  EXPECT_TRUE(map.AddPacket(0, 10));
+  EXPECT_TRUE(map.AddPacket(10, 11));
+  EXPECT_TRUE(map.AddPacket(kMaxPackets + 5, 12));
+  EXPECT_EQ(6, map.begin_sequence_number());
+  EXPECT_EQ(11, map.get(10));
+
+  // Too far behind the newest packet to be kept.
+  EXPECT_FALSE(map.AddPacket(5, 13));
+  EXPECT_EQ(6, map.begin_sequence_number());
+}
+
+TEST(PacketArrivalMapTest, RemovesOldPacketsUntilFirstRecentOne) {
+  PacketArrivalTimeMap map;
+  EXPECT_TRUE(map.AddPacket(42, 10));
+  EXPECT_TRUE(map.AddPacket(44, 20));
+  EXPECT_TRUE(map.AddPacket(45, 30));
+  EXPECT_TRUE(map.AddPacket(46, 15));
+
+  map.RemoveOldPackets(46, 20);
+  EXPECT_EQ(45, map.begin_sequence_number());
+  EXPECT_EQ(47, map.end_sequence_number());
+
+  // Never removes packets at or after the given sequence number.
+  map.RemoveOldPackets(46, 100);
+  EXPECT_EQ(46, map.begin_sequence_number());
+  EXPECT_EQ(15, map.get(46));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -70,8 +70,9 @@ bool RemoteBitrateEstimatorAbsSendTime::IsWithinClusterBounds(
   return fabs(static_cast<float>(send_delta_ms) - cluster_mean) < 2.5f;
 }
 
-void RemoteBitrateEstimatorAbsSendTime::AddCluster(std::list<Cluster>* clusters,
-                                                   Cluster* cluster) {
+void RemoteBitrateEstimatorAbsSendTime::AddCluster(
+    std::vector<Cluster>* clusters,
+    Cluster* cluster) {
   cluster->send_mean_ms /= static_cast<float>(cluster->count);
   cluster->recv_mean_ms /= static_cast<float>(cluster->count);
   cluster->mean_size /= cluster->count;
@@ -88,6 +89,7 @@ RemoteBitrateEstimatorAbsSendTime::RemoteBitrateEstimatorAbsSendTime(
       detector_(),
       incoming_bitrate_(kBitrateWindowMs, 8000),
       incoming_bitrate_initialized_(false),
+      probes_(kMaxProbePackets),
       total_probes_received_(0),
       first_packet_time_ms_(-1),
       last_update_ms_(-1),
@@ -98,15 +100,15 @@ RemoteBitrateEstimatorAbsSendTime::RemoteBitrateEstimatorAbsSendTime(
 }
 
 void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
-    std::list<Cluster>* clusters) const {
+    std::vector<Cluster>* clusters) const {
   Cluster current;
   int64_t prev_send_time = -1;
   int64_t prev_recv_time = -1;
-  for (std::list<Probe>::const_iterator it = probes_.begin();
-       it != probes_.end(); ++it) {
+  for (size_t i = 0; i < probes_.size(); ++i) {
+    const Probe& probe = probes_[i];
     if (prev_send_time >= 0) {
-      int send_delta_ms = it->send_time_ms - prev_send_time;
-      int recv_delta_ms = it->recv_time_ms - prev_recv_time;
+      int send_delta_ms = probe.send_time_ms - prev_send_time;
+      int recv_delta_ms = probe.recv_time_ms - prev_recv_time;
       if (send_delta_ms >= 1 && recv_delta_ms >= 1) {
         ++current.num_above_min_delta;
       }
@@ -119,11 +121,11 @@ void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
       }
       current.send_mean_ms += send_delta_ms;
       current.recv_mean_ms += recv_delta_ms;
-      current.mean_size += it->payload_size;
+      current.mean_size += probe.payload_size;
       ++current.count;
     }
-    prev_send_time = it->send_time_ms;
-    prev_recv_time = it->recv_time_ms;
+    prev_send_time = probe.send_time_ms;
+    prev_recv_time = probe.recv_time_ms;
   }
   if (current.count >= kMinClusterSize && current.send_mean_ms > 0.0f &&
       current.recv_mean_ms > 0.0f) {
@@ -131,12 +133,12 @@ void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
   }
 }
 
-std::list<Cluster>::const_iterator
+std::vector<Cluster>::const_iterator
 RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
-    const std::list<Cluster>& clusters) const {
+    const std::vector<Cluster>& clusters) const {
   int highest_probe_bitrate_bps = 0;
-  std::list<Cluster>::const_iterator best_it = clusters.end();
-  for (std::list<Cluster>::const_iterator it = clusters.begin();
+  std::vector<Cluster>::const_iterator best_it = clusters.end();
+  for (std::vector<Cluster>::const_iterator it = clusters.begin();
        it != clusters.end(); ++it) {
     if (it->send_mean_ms == 0 || it->recv_mean_ms == 0)
       continue;
@@ -165,17 +167,18 @@ RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
 
 RemoteBitrateEstimatorAbsSendTime::ProbeResult
 RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
-  std::list<Cluster> clusters;
+  std::vector<Cluster>& clusters = clusters_;
+  clusters.clear();
   ComputeClusters(&clusters);
   if (clusters.empty()) {
     // If we reach the max number of probe packets and still have no clusters,
     // we will remove the oldest one.
     if (probes_.size() >= kMaxProbePackets)
-      probes_.pop_front();
+      probes_.PopFront();
     return ProbeResult::kNoUpdate;
   }
 
-  std::list<Cluster>::const_iterator best_it = FindBestProbe(clusters);
+  std::vector<Cluster>::const_iterator best_it = FindBestProbe(clusters);
   if (best_it != clusters.end()) {
     int probe_bitrate_bps =
         std::min(best_it->GetSendBitrateBps(), best_it->GetRecvBitrateBps());
@@ -196,7 +199,7 @@ RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
   // Not probing and received non-probe packet, or finished with current set
   // of probes.
   if (clusters.size() >= kExpectedNumberOfProbes)
-    probes_.clear();
+    probes_.Clear();
   return ProbeResult::kNoUpdate;
 }
 
@@ -295,7 +298,7 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
                          << " ms, send delta=" << send_delta_ms
                          << " ms, recv delta=" << recv_delta_ms << " ms.";
       }
-      probes_.push_back(Probe(send_time_ms, arrival_time_ms, payload_size));
+      probes_.PushBack(Probe(send_time_ms, arrival_time_ms, payload_size));
       ++total_probes_received_;
       // Make sure that a probe which updated the bitrate immediately has an
       // effect by calling the OnReceiveBitrateChanged callback.
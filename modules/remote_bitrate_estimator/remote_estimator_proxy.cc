@@ -130,16 +130,9 @@ void RemoteEstimatorProxy::OnPacketArrival(uint16_t sequence_number,
     return;
   }
 
-  if (packet_arrival_times_.lower_bound(window_start_seq_) ==
-      packet_arrival_times_.end()) {
+  if (window_start_seq_ >= packet_arrival_times_.end_sequence_number()) {
     // Start new feedback packet, cull old packets.
-    for (auto it = packet_arrival_times_.begin();
-         it != packet_arrival_times_.end() && it->first < seq &&
-         arrival_time - it->second >= kBackWindowMs;) {
-      auto delete_it = it;
-      ++it;
-      packet_arrival_times_.erase(delete_it);
-    }
+    packet_arrival_times_.RemoveOldPackets(seq, arrival_time - kBackWindowMs);
   }
 
   if (window_start_seq_ == -1) {
@@ -149,10 +142,7 @@ void RemoteEstimatorProxy::OnPacketArrival(uint16_t sequence_number,
   }
 
   // We are only interested in the first time a packet is received.
-  if (packet_arrival_times_.find(seq) != packet_arrival_times_.end())
-    return;
-
-  packet_arrival_times_[seq] = arrival_time;
+  packet_arrival_times_.AddPacket(seq, arrival_time);
 }
 
 bool RemoteEstimatorProxy::BuildFeedbackPacket(
@@ -161,28 +151,40 @@ bool RemoteEstimatorProxy::BuildFeedbackPacket(
   // feedback packet. Some older may still be in the map, in case a reordering
   // happens and we need to retransmit them.
   rtc::CritScope cs(&lock_);
-  auto it = packet_arrival_times_.lower_bound(window_start_seq_);
-  if (it == packet_arrival_times_.end()) {
+  // The map may start after window_start_seq_, either because the first
+  // packets of the window were lost or because they were dropped to make room
+  // for newer ones.
+  const int64_t end_seq = packet_arrival_times_.end_sequence_number();
+  int64_t seq = std::max(window_start_seq_,
+                         packet_arrival_times_.begin_sequence_number());
+  while (seq < end_seq &&
+         packet_arrival_times_.get(seq) == PacketArrivalTimeMap::kNotReceived) {
+    ++seq;
+  }
+  if (seq >= end_seq) {
     // Feedback for all packets already sent.
     return false;
   }
 
   // TODO(sprang): Measure receive times in microseconds and remove the
   // conversions below.
-  const int64_t first_sequence = it->first;
+  const int64_t first_sequence = seq;
   feedback_packet->SetMediaSsrc(media_ssrc_);
   // Base sequence is the expected next (window_start_seq_). This is known, but
   // we might not have actually received it, so the base time shall be the time
   // of the first received packet in the feedback.
   feedback_packet->SetBase(static_cast<uint16_t>(window_start_seq_ & 0xFFFF),
-                           it->second * 1000);
+                           packet_arrival_times_.get(seq) * 1000);
   feedback_packet->SetFeedbackSequenceNumber(feedback_sequence_++);
-  for (; it != packet_arrival_times_.end(); ++it) {
-    if (!feedback_packet->AddReceivedPacket(
-            static_cast<uint16_t>(it->first & 0xFFFF), it->second * 1000)) {
+  for (; seq < end_seq; ++seq) {
+    const int64_t arrival_time = packet_arrival_times_.get(seq);
+    if (arrival_time == PacketArrivalTimeMap::kNotReceived)
+      continue;
+    if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(seq & 0xFFFF),
+                                            arrival_time * 1000)) {
       // If we can't even add the first seq to the feedback packet, we won't be
       // able to build it at all.
-      RTC_CHECK_NE(first_sequence, it->first);
+      RTC_CHECK_NE(first_sequence, seq);
 
       // Could not add timestamp, feedback packet might be full. Return and
       // try again with a fresh packet.
@@ -192,7 +194,7 @@ bool RemoteEstimatorProxy::BuildFeedbackPacket(
     // Note: Don't erase items from packet_arrival_times_ after sending, in case
     // they need to be re-sent after a reordering. Removal will be handled
     // by OnPacketArrival once packets are too old.
-    window_start_seq_ = it->first + 1;
+    window_start_seq_ = seq + 1;
   }
 
   return true;
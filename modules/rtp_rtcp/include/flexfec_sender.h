@@ -51,6 +51,11 @@ class FlexfecSender {
   // and what type of generator matrices are used.
   void SetFecParameters(const FecProtectionParams& params);
 
+  // If enabled, FEC is generated with 2D parity masks regardless of the mask
+  // type given to SetFecParameters(). Takes effect on the next call to
+  // SetFecParameters().
+  void SetUseTwoDimensionalParity(bool enabled);
+
   // Adds a media packet to the internal buffer. When enough media packets
   // have been added, the FEC packets are generated and stored internally.
   // These FEC packets are then obtained by calling GetFecPackets().
@@ -84,6 +89,7 @@ class FlexfecSender {
   const std::string mid_;
   // Sequence number of next packet to generate.
   uint16_t seq_num_;
+  bool use_two_dimensional_parity_;
 
   // Implementation.
   UlpfecGenerator ulpfec_generator_;
@@ -78,5 +78,23 @@ TEST(FecTable, TestRandomGenerated) {
   }
 }
 
+TEST(FecTable, TestTwoDimensionalParityGenerated) {
+  // 3 column and 3 row parity packets for 12 media packets.
+  constexpr uint8_t kMask12_6[] = {0x92, 0x40, 0x49, 0x20, 0x24, 0x90,
+                                   0xf0, 0x00, 0x0f, 0x00, 0x00, 0xf0};
+  internal::PacketMaskTable mask_table(kFecMaskTwoDimensional, 12);
+  rtc::ArrayView<const uint8_t> mask = mask_table.LookUp(12, 6);
+  ASSERT_EQ(sizeof(kMask12_6), mask.size());
+  for (size_t i = 0; i < mask.size(); ++i) {
+    EXPECT_EQ(kMask12_6[i], mask[i]) << i;
+  }
+
+  // A single packet protects all media packets.
+  mask = mask_table.LookUp(12, 1);
+  ASSERT_EQ(2u, mask.size());
+  EXPECT_EQ(0xffu, mask[0]);
+  EXPECT_EQ(0xf0u, mask[1]);
+}
+
 }  // namespace fec_private_tables
 }  // namespace webrtc
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using XorFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+struct Implementation {
+  const char* name;
+  XorFunction function;
+};
+
+// Largest payload XORed by ForwardErrorCorrection, plus room for offsets.
+constexpr size_t kMaxLength = 1500;
+constexpr size_t kMaxOffset = 16;
+
+std::vector<Implementation> Implementations() {
+  std::vector<Implementation> implementations = {{"default", &XorBytes},
+                                                 {"C", &XorBytes_C}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2))
+    implementations.push_back({"SSE2", &XorBytes_SSE2});
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  implementations.push_back({"NEON", &XorBytes_NEON});
+#endif
+  return implementations;
+}
+
+std::vector<uint8_t> RandomBytes(Random* random, size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes)
+    byte = random->Rand<uint8_t>();
+  return bytes;
+}
+
+void ExpectXorMatchesReference(XorFunction xor_function,
+                               size_t length,
+                               size_t src_offset,
+                               size_t dst_offset) {
+  Random random(1 + length * 1000 + src_offset * 100 + dst_offset);
+  std::vector<uint8_t> src = RandomBytes(&random, kMaxLength + kMaxOffset);
+  std::vector<uint8_t> dst = RandomBytes(&random, kMaxLength + kMaxOffset);
+  std::vector<uint8_t> expected = dst;
+  for (size_t i = 0; i < length; ++i)
+    expected[dst_offset + i] ^= src[src_offset + i];
+
+  xor_function(&src[src_offset], length, &dst[dst_offset]);
+  // Also checks that nothing outside of the range was touched.
+  EXPECT_EQ(expected, dst) << "length " << length << ", offsets "
+                           << src_offset << " and " << dst_offset;
+}
+
+}  // namespace
+
+TEST(FecXorTest, MatchesByteWiseXor) {
+  for (const Implementation& implementation : Implementations()) {
+    SCOPED_TRACE(implementation.name);
+    for (size_t length = 0; length <= 100; ++length)
+      ExpectXorMatchesReference(implementation.function, length, 0, 0);
+    ExpectXorMatchesReference(implementation.function, kMaxLength, 0, 0);
+  }
+}
+
+TEST(FecXorTest, HandlesUnalignedBuffers) {
+  for (const Implementation& implementation : Implementations()) {
+    SCOPED_TRACE(implementation.name);
+    for (size_t src_offset = 0; src_offset < kMaxOffset; src_offset += 3) {
+      for (size_t dst_offset = 0; dst_offset < kMaxOffset; dst_offset += 5) {
+        ExpectXorMatchesReference(implementation.function, 1187, src_offset,
+                                  dst_offset);
+      }
+    }
+  }
+}
+
+// Compares the implementations on typical payload sizes. FEC encoding XORs
+// each protected media packet into every FEC packet covering it.
+TEST(FecXorTest, DISABLED_Performance) {
+  const int kIterations = 1000000;
+  Random random(4711);
+  std::vector<uint8_t> src = RandomBytes(&random, kMaxLength);
+  std::vector<uint8_t> dst = RandomBytes(&random, kMaxLength);
+  for (size_t length : {200, 1200}) {
+    for (const Implementation& implementation : Implementations()) {
+      int64_t start_us = rtc::TimeMicros();
+      for (int i = 0; i < kIterations; ++i)
+        implementation.function(src.data(), length, dst.data());
+      int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      printf("%s, %zu bytes: %.1f ns per call, %.2f GB/s\n",
+             implementation.name, length, 1000.0 * elapsed_us / kIterations,
+             static_cast<double>(length) * kIterations / (1000.0 * elapsed_us));
+    }
+  }
+  // Keep the result alive.
+  EXPECT_NE(0u, dst.size());
+}
+
+}  // namespace webrtc
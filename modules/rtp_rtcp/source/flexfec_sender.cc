@@ -85,6 +85,7 @@ FlexfecSender::FlexfecSender(
       mid_(mid),
       seq_num_(rtp_state ? rtp_state->sequence_number
                          : random_.Rand(1, kMaxInitRtpSeqNumber)),
+      use_two_dimensional_parity_(false),
       ulpfec_generator_(
           ForwardErrorCorrection::CreateFlexfec(ssrc, protected_media_ssrc)),
       rtp_header_extension_map_(
@@ -101,7 +102,14 @@ FlexfecSender::~FlexfecSender() = default;
 // We are reusing the implementation from UlpfecGenerator for SetFecParameters,
 // AddRtpPacketAndGenerateFec, and FecAvailable.
 void FlexfecSender::SetFecParameters(const FecProtectionParams& params) {
-  ulpfec_generator_.SetFecParameters(params);
+  FecProtectionParams fec_params = params;
+  if (use_two_dimensional_parity_)
+    fec_params.fec_mask_type = kFecMaskTwoDimensional;
+  ulpfec_generator_.SetFecParameters(fec_params);
+}
+
+void FlexfecSender::SetUseTwoDimensionalParity(bool enabled) {
+  use_two_dimensional_parity_ = enabled;
 }
 
 bool FlexfecSender::AddRtpPacketAndGenerateFec(const RtpPacketToSend& packet) {
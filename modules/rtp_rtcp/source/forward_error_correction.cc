@@ -18,6 +18,7 @@
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -47,6 +48,10 @@ int32_t ForwardErrorCorrection::Packet::Release() {
   return ref_count;
 }
 
+bool ForwardErrorCorrection::Packet::HasOneRef() const {
+  return ref_count_ == 1;
+}
+
 // This comparator is used to compare std::unique_ptr's pointing to
 // subclasses of SortablePackets. It needs to be parametric since
 // the std::unique_ptr's are not covariant w.r.t. the types that
@@ -81,7 +86,11 @@ ForwardErrorCorrection::ForwardErrorCorrection(
       fec_header_reader_(std::move(fec_header_reader)),
       fec_header_writer_(std::move(fec_header_writer)),
       generated_fec_packets_(fec_header_writer_->MaxFecPackets()),
-      packet_mask_size_(0) {}
+      max_packet_pool_size_(fec_header_reader_->MaxMediaPackets() +
+                            fec_header_reader_->MaxFecPackets()),
+      packet_mask_size_(0) {
+  packet_pool_.reserve(max_packet_pool_size_);
+}
 
 ForwardErrorCorrection::~ForwardErrorCorrection() = default;
 
@@ -341,9 +350,13 @@ void ForwardErrorCorrection::FinalizeFecHeaders(size_t num_fec_packets,
 
 void ForwardErrorCorrection::ResetState(
     RecoveredPacketList* recovered_packets) {
-  // Free the memory for any existing recovered packets, if the caller hasn't.
-  recovered_packets->clear();
-  received_fec_packets_.clear();
+  // Release any existing recovered packets, if the caller hasn't.
+  auto recovered_it = recovered_packets->begin();
+  while (recovered_it != recovered_packets->end())
+    recovered_it = RecycleRecoveredPacket(recovered_packets, recovered_it);
+  auto fec_it = received_fec_packets_.begin();
+  while (fec_it != received_fec_packets_.end())
+    fec_it = RecycleFecPacket(fec_it);
 }
 
 void ForwardErrorCorrection::InsertMediaPacket(
@@ -360,7 +373,7 @@ void ForwardErrorCorrection::InsertMediaPacket(
     }
   }
 
-  std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
+  RecoveredPacket* recovered_packet = SpareRecoveredPacket();
   // This "recovered packet" was not recovered using parity packets.
   recovered_packet->was_recovered = false;
   // This media packet has already been passed on.
@@ -371,10 +384,11 @@ void ForwardErrorCorrection::InsertMediaPacket(
   recovered_packet->pkt->length = received_packet.pkt->length;
   // TODO(holmer): Consider replacing this with a binary search for the right
   // position, and then just insert the new packet. Would get rid of the sort.
-  RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
+  recovered_packets->splice(recovered_packets->end(),
+                            spare_recovered_packets_,
+                            spare_recovered_packets_.begin());
   recovered_packets->sort(SortablePacket::LessThan());
-  UpdateCoveringFecPackets(*recovered_packet_ptr);
+  UpdateCoveringFecPackets(*recovered_packet);
 }
 
 void ForwardErrorCorrection::UpdateCoveringFecPackets(
@@ -406,13 +420,14 @@ void ForwardErrorCorrection::InsertFecPacket(
     }
   }
 
-  std::unique_ptr<ReceivedFecPacket> fec_packet(new ReceivedFecPacket());
+  ReceivedFecPacket* fec_packet = SpareFecPacket();
   fec_packet->pkt = received_packet.pkt;
   fec_packet->ssrc = received_packet.ssrc;
   fec_packet->seq_num = received_packet.seq_num;
   // Parse ULPFEC/FlexFEC header specific info.
-  bool ret = fec_header_reader_->ReadFecHeader(fec_packet.get());
+  bool ret = fec_header_reader_->ReadFecHeader(fec_packet);
   if (!ret) {
+    ResetSpareFecPacket();
     return;
   }
 
@@ -420,6 +435,7 @@ void ForwardErrorCorrection::InsertFecPacket(
   if (fec_packet->protected_ssrc != protected_media_ssrc_) {
     RTC_LOG(LS_INFO)
         << "Received FEC packet is protecting an unknown media SSRC; dropping.";
+    ResetSpareFecPacket();
     return;
   }
 
@@ -430,14 +446,10 @@ void ForwardErrorCorrection::InsertFecPacket(
         fec_packet->pkt->data[fec_packet->packet_mask_offset + byte_idx];
     for (uint16_t bit_idx = 0; bit_idx < 8; ++bit_idx) {
       if (packet_mask & (1 << (7 - bit_idx))) {
-        std::unique_ptr<ProtectedPacket> protected_packet(
-            new ProtectedPacket());
         // This wraps naturally with the sequence number.
-        protected_packet->ssrc = protected_media_ssrc_;
-        protected_packet->seq_num = static_cast<uint16_t>(
-            fec_packet->seq_num_base + (byte_idx << 3) + bit_idx);
-        protected_packet->pkt = nullptr;
-        fec_packet->protected_packets.push_back(std::move(protected_packet));
+        AddProtectedPacket(fec_packet,
+                           static_cast<uint16_t>(fec_packet->seq_num_base +
+                                                 (byte_idx << 3) + bit_idx));
       }
     }
   }
@@ -445,15 +457,18 @@ void ForwardErrorCorrection::InsertFecPacket(
   if (fec_packet->protected_packets.empty()) {
     // All-zero packet mask; we can discard this FEC packet.
     RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
+    ResetSpareFecPacket();
   } else {
-    AssignRecoveredPackets(recovered_packets, fec_packet.get());
+    AssignRecoveredPackets(recovered_packets, fec_packet);
     // TODO(holmer): Consider replacing this with a binary search for the right
     // position, and then just insert the new packet. Would get rid of the sort.
-    received_fec_packets_.push_back(std::move(fec_packet));
+    received_fec_packets_.splice(received_fec_packets_.end(),
+                                 spare_fec_packets_,
+                                 spare_fec_packets_.begin());
     received_fec_packets_.sort(SortablePacket::LessThan());
     const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
     if (received_fec_packets_.size() > max_fec_packets) {
-      received_fec_packets_.pop_front();
+      RecycleFecPacket(received_fec_packets_.begin());
     }
     RTC_DCHECK_LE(received_fec_packets_.size(), max_fec_packets);
   }
@@ -463,7 +478,6 @@ void ForwardErrorCorrection::AssignRecoveredPackets(
     const RecoveredPacketList& recovered_packets,
     ReceivedFecPacket* fec_packet) {
   ProtectedPacketList* protected_packets = &fec_packet->protected_packets;
-  std::vector<RecoveredPacket*> recovered_protected_packets;
 
   // Find intersection between the (sorted) containers |protected_packets|
   // and |recovered_packets|, i.e. all protected packets that have already
@@ -508,7 +522,7 @@ void ForwardErrorCorrection::InsertPacket(
     while (it != received_fec_packets_.end()) {
       uint16_t seq_num_diff = MinDiff(received_packet.seq_num, (*it)->seq_num);
       if (seq_num_diff > 0x3fff) {
-        it = received_fec_packets_.erase(it);
+        it = RecycleFecPacket(it);
       } else {
         // No need to keep iterating, since |received_fec_packets_| is sorted.
         break;
@@ -536,7 +550,7 @@ bool ForwardErrorCorrection::StartPacketRecovery(
     return false;
   }
   // Initialize recovered packet data.
-  recovered_packet->pkt = new Packet();
+  RTC_DCHECK(recovered_packet->pkt);
   memset(recovered_packet->pkt->data, 0, IP_PACKET_SIZE);
   recovered_packet->returned = false;
   recovered_packet->was_recovered = true;
@@ -611,9 +625,7 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   // XOR the payload.
   RTC_DCHECK_LE(kRtpHeaderSize + payload_length, sizeof(src.data));
   RTC_DCHECK_LE(dst_offset + payload_length, sizeof(dst->data));
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst->data[dst_offset + i] ^= src.data[kRtpHeaderSize + i];
-  }
+  XorBytes(&src.data[kRtpHeaderSize], payload_length, &dst->data[dst_offset]);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -647,25 +659,27 @@ void ForwardErrorCorrection::AttemptRecovery(
     // We can only recover one packet with an FEC packet.
     if (packets_missing == 1) {
       // Recovery possible.
-      std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
-      recovered_packet->pkt = nullptr;
-      if (!RecoverPacket(**fec_packet_it, recovered_packet.get())) {
+      RecoveredPacket* recovered_packet = SpareRecoveredPacket();
+      recovered_packet->pkt = AllocatePacket();
+      if (!RecoverPacket(**fec_packet_it, recovered_packet)) {
         // Can't recover using this packet, drop it.
-        fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+        recovered_packet->pkt = nullptr;
+        fec_packet_it = RecycleFecPacket(fec_packet_it);
         continue;
       }
 
-      auto* recovered_packet_ptr = recovered_packet.get();
       // Add recovered packet to the list of recovered packets and update any
       // FEC packets covering this packet with a pointer to the data.
       // TODO(holmer): Consider replacing this with a binary search for the
       // right position, and then just insert the new packet. Would get rid of
       // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
+      recovered_packets->splice(recovered_packets->end(),
+                                spare_recovered_packets_,
+                                spare_recovered_packets_.begin());
       recovered_packets->sort(SortablePacket::LessThan());
-      UpdateCoveringFecPackets(*recovered_packet_ptr);
+      UpdateCoveringFecPackets(*recovered_packet);
       DiscardOldRecoveredPackets(recovered_packets);
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      fec_packet_it = RecycleFecPacket(fec_packet_it);
 
       // A packet has been recovered. We need to check the FEC list again, as
       // this may allow additional packets to be recovered.
@@ -674,7 +688,7 @@ void ForwardErrorCorrection::AttemptRecovery(
     } else if (packets_missing == 0) {
       // Either all protected packets arrived or have been recovered. We can
       // discard this FEC packet.
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      fec_packet_it = RecycleFecPacket(fec_packet_it);
     } else {
       fec_packet_it++;
     }
@@ -699,11 +713,91 @@ void ForwardErrorCorrection::DiscardOldRecoveredPackets(
     RecoveredPacketList* recovered_packets) {
   const size_t max_media_packets = fec_header_reader_->MaxMediaPackets();
   while (recovered_packets->size() > max_media_packets) {
-    recovered_packets->pop_front();
+    RecycleRecoveredPacket(recovered_packets, recovered_packets->begin());
   }
   RTC_DCHECK_LE(recovered_packets->size(), max_media_packets);
 }
 
+ForwardErrorCorrection::RecoveredPacket*
+ForwardErrorCorrection::SpareRecoveredPacket() {
+  if (spare_recovered_packets_.empty())
+    spare_recovered_packets_.emplace_back(new RecoveredPacket());
+  return spare_recovered_packets_.front().get();
+}
+
+ForwardErrorCorrection::ReceivedFecPacket*
+ForwardErrorCorrection::SpareFecPacket() {
+  if (spare_fec_packets_.empty())
+    spare_fec_packets_.emplace_back(new ReceivedFecPacket());
+  RTC_DCHECK(spare_fec_packets_.front()->protected_packets.empty());
+  return spare_fec_packets_.front().get();
+}
+
+void ForwardErrorCorrection::AddProtectedPacket(ReceivedFecPacket* fec_packet,
+                                                uint16_t seq_num) {
+  ProtectedPacketList* protected_packets = &fec_packet->protected_packets;
+  if (spare_protected_packets_.empty()) {
+    protected_packets->emplace_back(new ProtectedPacket());
+  } else {
+    protected_packets->splice(protected_packets->end(),
+                              spare_protected_packets_,
+                              spare_protected_packets_.begin());
+  }
+  ProtectedPacket* protected_packet = protected_packets->back().get();
+  protected_packet->ssrc = protected_media_ssrc_;
+  protected_packet->seq_num = seq_num;
+  protected_packet->pkt = nullptr;
+}
+
+ForwardErrorCorrection::RecoveredPacketList::iterator
+ForwardErrorCorrection::RecycleRecoveredPacket(
+    RecoveredPacketList* recovered_packets,
+    RecoveredPacketList::iterator it) {
+  (*it)->pkt = nullptr;
+  auto next = std::next(it);
+  spare_recovered_packets_.splice(spare_recovered_packets_.end(),
+                                  *recovered_packets, it);
+  return next;
+}
+
+ForwardErrorCorrection::ReceivedFecPacketList::iterator
+ForwardErrorCorrection::RecycleFecPacket(ReceivedFecPacketList::iterator it) {
+  ReceivedFecPacket* fec_packet = it->get();
+  for (auto& protected_packet : fec_packet->protected_packets)
+    protected_packet->pkt = nullptr;
+  spare_protected_packets_.splice(spare_protected_packets_.end(),
+                                  fec_packet->protected_packets);
+  fec_packet->pkt = nullptr;
+  auto next = std::next(it);
+  spare_fec_packets_.splice(spare_fec_packets_.end(), received_fec_packets_,
+                            it);
+  return next;
+}
+
+void ForwardErrorCorrection::ResetSpareFecPacket() {
+  // The spare packet stays at the front of the spare list.
+  ReceivedFecPacket* fec_packet = spare_fec_packets_.front().get();
+  for (auto& protected_packet : fec_packet->protected_packets)
+    protected_packet->pkt = nullptr;
+  spare_protected_packets_.splice(spare_protected_packets_.end(),
+                                  fec_packet->protected_packets);
+  fec_packet->pkt = nullptr;
+}
+
+rtc::scoped_refptr<ForwardErrorCorrection::Packet>
+ForwardErrorCorrection::AllocatePacket() {
+  for (const auto& packet : packet_pool_) {
+    if (packet->HasOneRef())
+      return packet;
+  }
+  rtc::scoped_refptr<Packet> packet(new Packet());
+  // If the pool is exhausted, e.g. because the caller holds on to recovered
+  // packets, fall back to unpooled buffers.
+  if (packet_pool_.size() < max_packet_pool_size_)
+    packet_pool_.push_back(packet);
+  return packet;
+}
+
 uint16_t ForwardErrorCorrection::ParseSequenceNumber(uint8_t* packet) {
   return (packet[2] << 8) + packet[3];
 }
@@ -52,6 +52,9 @@ class ForwardErrorCorrection {
     // reaches zero.
     virtual int32_t Release();
 
+    // True if the caller holds the only reference.
+    bool HasOneRef() const;
+
     size_t length;                 // Length of packet in bytes.
     uint8_t data[IP_PACKET_SIZE];  // Packet data.
 
@@ -283,6 +286,30 @@ class ForwardErrorCorrection {
   void InsertFecPacket(const RecoveredPacketList& recovered_packets,
                        const ReceivedPacket& received_packet);
 
+  // The decoder recycles the nodes of the lists it manages, and the packet
+  // buffers of recovered packets, so that steady-state decoding does not
+  // touch the heap. Nodes are moved between lists with splice(), which never
+  // allocates, and a node is only deleted together with the decoder.
+
+  // Returns a spare node at the front of |spare_recovered_packets_|, or of
+  // |spare_fec_packets_|, allocating one if there is none. The caller fills it
+  // in and splices it into the destination list, or leaves it there if it
+  // turns out to be unusable.
+  RecoveredPacket* SpareRecoveredPacket();
+  ReceivedFecPacket* SpareFecPacket();
+  void AddProtectedPacket(ReceivedFecPacket* fec_packet, uint16_t seq_num);
+  // Releases the packet references of the node at |it| and moves it to the
+  // spare list. Returns the next node.
+  RecoveredPacketList::iterator RecycleRecoveredPacket(
+      RecoveredPacketList* recovered_packets,
+      RecoveredPacketList::iterator it);
+  ReceivedFecPacketList::iterator RecycleFecPacket(
+      ReceivedFecPacketList::iterator it);
+  void ResetSpareFecPacket();
+  // Returns a packet buffer for a recovered packet. Buffers of recovered
+  // packets that are no longer referenced outside of the pool are reused.
+  rtc::scoped_refptr<Packet> AllocatePacket();
+
   // Assigns pointers to already recovered packets covered by |fec_packet|.
   static void AssignRecoveredPackets(
       const RecoveredPacketList& recovered_packets,
@@ -293,7 +320,7 @@ class ForwardErrorCorrection {
   void AttemptRecovery(RecoveredPacketList* recovered_packets);
 
   // Initializes headers and payload before the XOR operation
-  // that recovers a packet.
+  // that recovers a packet. |recovered_packet->pkt| must be allocated.
   static bool StartPacketRecovery(const ReceivedFecPacket& fec_packet,
                                   RecoveredPacket* recovered_packet);
 
@@ -339,6 +366,15 @@ class ForwardErrorCorrection {
   std::vector<Packet> generated_fec_packets_;
   ReceivedFecPacketList received_fec_packets_;
 
+  // Recycled decoder state, see SpareRecoveredPacket(). The pool holds at
+  // most MaxMediaPackets() + MaxFecPackets() buffers, which covers all
+  // recovered packets that can be referenced by the decoder at once.
+  RecoveredPacketList spare_recovered_packets_;
+  ReceivedFecPacketList spare_fec_packets_;
+  ProtectedPacketList spare_protected_packets_;
+  std::vector<rtc::scoped_refptr<Packet>> packet_pool_;
+  const size_t max_packet_pool_size_;
+
   // Arrays used to avoid dynamically allocating memory when generating
   // the packet masks.
   // (There are never more than |kUlpfecMaxMediaPackets| FEC packets generated.)
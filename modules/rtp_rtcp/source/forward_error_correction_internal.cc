@@ -142,7 +142,8 @@ namespace internal {
 
 PacketMaskTable::PacketMaskTable(FecMaskType fec_mask_type,
                                  int num_media_packets)
-    : table_(PickTable(fec_mask_type, num_media_packets)) {}
+    : fec_mask_type_(fec_mask_type),
+      table_(PickTable(fec_mask_type, num_media_packets)) {}
 
 PacketMaskTable::~PacketMaskTable() = default;
 
@@ -153,6 +154,13 @@ rtc::ArrayView<const uint8_t> PacketMaskTable::LookUp(int num_media_packets,
   RTC_DCHECK_LE(num_media_packets, kUlpfecMaxMediaPackets);
   RTC_DCHECK_LE(num_fec_packets, num_media_packets);
 
+  if (fec_mask_type_ == kFecMaskTwoDimensional) {
+    GenerateTwoDimensionalParityMask(num_media_packets, num_fec_packets,
+                                     fec_packet_mask_);
+    return {&fec_packet_mask_[0],
+            num_fec_packets * PacketMaskSize(num_media_packets)};
+  }
+
   if (num_media_packets <= 12) {
     return LookUpInFecTable(table_, num_media_packets - 1, num_fec_packets - 1);
   }
@@ -213,12 +221,13 @@ rtc::ArrayView<const uint8_t> PacketMaskTable::LookUp(int num_media_packets,
 // If |num_media_packets| is larger than the maximum allowed by |fec_mask_type|
 // for the bursty type, or the random table is explicitly asked for, then the
 // random type is selected. Otherwise the bursty table callback is returned.
+// The 2D parity masks are always generated, so no table is used for them.
 const uint8_t* PacketMaskTable::PickTable(FecMaskType fec_mask_type,
                                           int num_media_packets) {
   RTC_DCHECK_GE(num_media_packets, 0);
   RTC_DCHECK_LE(static_cast<size_t>(num_media_packets), kUlpfecMaxMediaPackets);
 
-  if (fec_mask_type != kFecMaskRandom &&
+  if (fec_mask_type == kFecMaskBursty &&
       num_media_packets <=
           static_cast<int>(fec_private_tables::kPacketMaskBurstyTbl[0])) {
     return &fec_private_tables::kPacketMaskBurstyTbl[0];
@@ -471,6 +480,33 @@ void GeneratePacketMasks(int num_media_packets,
   }  // End of UEP modification
 }  // End of GetPacketMasks
 
+void GenerateTwoDimensionalParityMask(int num_media_packets,
+                                      int num_fec_packets,
+                                      uint8_t* packet_mask) {
+  RTC_DCHECK_GT(num_media_packets, 0);
+  RTC_DCHECK_GT(num_fec_packets, 0);
+  RTC_DCHECK_LE(num_media_packets, kUlpfecMaxMediaPackets);
+  RTC_DCHECK_LE(num_fec_packets, num_media_packets);
+
+  const int num_mask_bytes = PacketMaskSize(num_media_packets);
+  memset(packet_mask, 0, num_fec_packets * num_mask_bytes);
+
+  // With a single FEC packet, this is plain parity over all media packets.
+  const int num_row_fec_packets = num_fec_packets / 2;
+  const int num_columns = num_fec_packets - num_row_fec_packets;
+  for (int i = 0; i < num_media_packets; ++i) {
+    const int byte_index = i / 8;
+    const uint8_t bit = 0x80 >> (i % 8);
+    // Column parity.
+    packet_mask[(i % num_columns) * num_mask_bytes + byte_index] |= bit;
+    // Row parity, splitting the media packets into equally long runs.
+    if (num_row_fec_packets > 0) {
+      const int row = num_columns + i * num_row_fec_packets / num_media_packets;
+      packet_mask[row * num_mask_bytes + byte_index] |= bit;
+    }
+  }
+}
+
 size_t PacketMaskSize(size_t num_sequence_numbers) {
   RTC_DCHECK_LE(num_sequence_numbers, 8 * kUlpfecPacketMaskSizeLBitSet);
   if (num_sequence_numbers > 8 * kUlpfecPacketMaskSizeLBitClear) {
@@ -47,6 +47,7 @@ class PacketMaskTable {
  private:
   static const uint8_t* PickTable(FecMaskType fec_mask_type,
                                   int num_media_packets);
+  const FecMaskType fec_mask_type_;
   const uint8_t* table_;
   uint8_t fec_packet_mask_[kFECPacketMaskMaxSize];
 };
@@ -83,6 +84,24 @@ void GeneratePacketMasks(int num_media_packets,
                          PacketMaskTable* mask_table,
                          uint8_t* packet_mask);
 
+// Generates a 2D parity packet mask. The media packets are laid out row by row
+// in a matrix with ceil(num_fec_packets / 2) columns. The first FEC packets
+// each protect one column, i.e. media packets that are that many sequence
+// numbers apart, so any burst no longer than the number of columns can be
+// recovered. The remaining FEC packets each protect a run of consecutive
+// media packets, which resolves columns that lost more than one packet.
+//
+// \param[in]  num_media_packets The number of media packets to protect.
+//                               [1, kUlpfecMaxMediaPackets].
+// \param[in]  num_fec_packets   The number of FEC packets which will be
+//                               generated. [1, num_media_packets].
+// \param[out] packet_mask       A pointer to hold the packet mask array, of
+//                               size: num_fec_packets * "number of mask
+//                               bytes".
+void GenerateTwoDimensionalParityMask(int num_media_packets,
+                                      int num_fec_packets,
+                                      uint8_t* packet_mask);
+
 // Returns the required packet mask size, given the number of sequence numbers
 // that will be covered.
 size_t PacketMaskSize(size_t num_sequence_numbers);
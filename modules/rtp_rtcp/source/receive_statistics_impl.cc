@@ -25,6 +25,8 @@ namespace webrtc {
 
 const int64_t kStatisticsTimeoutMs = 8000;
 const int64_t kStatisticsProcessIntervalMs = 1000;
+// Kept for every received stream, so use 10 ms buckets rather than 1 ms ones.
+const int64_t kStatisticsBucketMs = 10;
 
 StreamStatistician::~StreamStatistician() {}
 
@@ -36,7 +38,8 @@ StreamStatisticianImpl::StreamStatisticianImpl(
     : ssrc_(ssrc),
       clock_(clock),
       incoming_bitrate_(kStatisticsProcessIntervalMs,
-                        RateStatistics::kBpsScale),
+                        RateStatistics::kBpsScale,
+                        kStatisticsBucketMs),
       max_reordering_threshold_(kDefaultMaxReorderingThreshold),
       jitter_q4_(0),
       last_receive_time_ms_(0),
@@ -335,6 +338,7 @@ ReceiveStatistics* ReceiveStatistics::Create(Clock* clock) {
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(Clock* clock)
     : clock_(clock),
       last_returned_ssrc_(0),
+      last_statistician_(nullptr),
       rtcp_stats_callback_(NULL),
       rtp_stats_callback_(NULL) {}
 
@@ -345,39 +349,45 @@ ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
   }
 }
 
+StreamStatisticianImpl* ReceiveStatisticsImpl::GetOrCreateStatistician(
+    uint32_t ssrc,
+    bool create) {
+  StreamStatisticianImpl* impl =
+      last_statistician_.load(std::memory_order_acquire);
+  if (impl && impl->ssrc() == ssrc)
+    return impl;
+
+  rtc::CritScope cs(&receive_statistics_lock_);
+  auto it = statisticians_.find(ssrc);
+  if (it != statisticians_.end()) {
+    impl = it->second;
+  } else if (create) {
+    impl = new StreamStatisticianImpl(ssrc, clock_, this, this);
+    statisticians_[ssrc] = impl;
+  } else {
+    return nullptr;
+  }
+  last_statistician_.store(impl, std::memory_order_release);
+  return impl;
+}
+
 void ReceiveStatisticsImpl::IncomingPacket(const RTPHeader& header,
                                            size_t packet_length,
                                            bool retransmitted) {
-  StreamStatisticianImpl* impl;
-  {
-    rtc::CritScope cs(&receive_statistics_lock_);
-    auto it = statisticians_.find(header.ssrc);
-    if (it != statisticians_.end()) {
-      impl = it->second;
-    } else {
-      impl = new StreamStatisticianImpl(header.ssrc, clock_, this, this);
-      statisticians_[header.ssrc] = impl;
-    }
-  }
   // StreamStatisticianImpl instance is created once and only destroyed when
   // this whole ReceiveStatisticsImpl is destroyed. StreamStatisticianImpl has
   // it's own locking so don't hold receive_statistics_lock_ (potential
   // deadlock).
-  impl->IncomingPacket(header, packet_length, retransmitted);
+  GetOrCreateStatistician(header.ssrc, true)
+      ->IncomingPacket(header, packet_length, retransmitted);
 }
 
 void ReceiveStatisticsImpl::FecPacketReceived(const RTPHeader& header,
                                               size_t packet_length) {
-  StreamStatisticianImpl* impl;
-  {
-    rtc::CritScope cs(&receive_statistics_lock_);
-    auto it = statisticians_.find(header.ssrc);
-    // Ignore FEC if it is the first packet.
-    if (it == statisticians_.end())
-      return;
-    impl = it->second;
-  }
-  impl->FecPacketReceived(header, packet_length);
+  // Ignore FEC if it is the first packet.
+  StreamStatisticianImpl* impl = GetOrCreateStatistician(header.ssrc, false);
+  if (impl)
+    impl->FecPacketReceived(header, packet_length);
 }
 
 StreamStatistician* ReceiveStatisticsImpl::GetStatistician(
@@ -399,7 +409,7 @@ void ReceiveStatisticsImpl::SetMaxReorderingThreshold(
 
 void ReceiveStatisticsImpl::RegisterRtcpStatisticsCallback(
     RtcpStatisticsCallback* callback) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (callback != NULL)
     assert(rtcp_stats_callback_ == NULL);
   rtcp_stats_callback_ = callback;
@@ -407,20 +417,20 @@ void ReceiveStatisticsImpl::RegisterRtcpStatisticsCallback(
 
 void ReceiveStatisticsImpl::StatisticsUpdated(const RtcpStatistics& statistics,
                                               uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtcp_stats_callback_)
     rtcp_stats_callback_->StatisticsUpdated(statistics, ssrc);
 }
 
 void ReceiveStatisticsImpl::CNameChanged(const char* cname, uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtcp_stats_callback_)
     rtcp_stats_callback_->CNameChanged(cname, ssrc);
 }
 
 void ReceiveStatisticsImpl::RegisterRtpStatisticsCallback(
     StreamDataCountersCallback* callback) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (callback != NULL)
     assert(rtp_stats_callback_ == NULL);
   rtp_stats_callback_ = callback;
@@ -428,7 +438,7 @@ void ReceiveStatisticsImpl::RegisterRtpStatisticsCallback(
 
 void ReceiveStatisticsImpl::DataCountersUpdated(const StreamDataCounters& stats,
                                                 uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtp_stats_callback_) {
     rtp_stats_callback_->DataCountersUpdated(stats, ssrc);
   }
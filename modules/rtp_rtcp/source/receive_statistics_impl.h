@@ -16,6 +16,7 @@
 #include <math.h>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <vector>
 
@@ -33,6 +34,8 @@ class StreamStatisticianImpl : public StreamStatistician {
                          StreamDataCountersCallback* rtp_callback);
   ~StreamStatisticianImpl() override;
 
+  uint32_t ssrc() const { return ssrc_; }
+
   bool GetStatistics(RtcpStatistics* statistics,
                      bool update_fraction_lost) override;
   bool GetActiveStatisticsAndReset(RtcpStatistics* statistics);
@@ -123,13 +126,26 @@ class ReceiveStatisticsImpl : public ReceiveStatistics,
   void DataCountersUpdated(const StreamDataCounters& counters,
                            uint32_t ssrc) override;
 
+  // Returns the statistician of |ssrc|, creating it if |create| is true.
+  StreamStatisticianImpl* GetOrCreateStatistician(uint32_t ssrc, bool create);
+
   Clock* const clock_;
   rtc::CriticalSection receive_statistics_lock_;
   uint32_t last_returned_ssrc_;
-  std::map<uint32_t, StreamStatisticianImpl*> statisticians_;
-
-  RtcpStatisticsCallback* rtcp_stats_callback_;
-  StreamDataCountersCallback* rtp_stats_callback_;
+  std::map<uint32_t, StreamStatisticianImpl*> statisticians_
+      RTC_GUARDED_BY(receive_statistics_lock_);
+  // The statistician of the last received packet. Most packets belong to the
+  // same stream as the one before, and can then be counted without taking
+  // |receive_statistics_lock_|. Statisticians live as long as this object, so
+  // the pointer never dangles.
+  std::atomic<StreamStatisticianImpl*> last_statistician_;
+
+  // The callbacks are called for every packet, so they have a lock of their
+  // own to not contend with the statistician lookup and RTCP reports.
+  rtc::CriticalSection callback_lock_;
+  RtcpStatisticsCallback* rtcp_stats_callback_ RTC_GUARDED_BY(callback_lock_);
+  StreamDataCountersCallback* rtp_stats_callback_
+      RTC_GUARDED_BY(callback_lock_);
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
@@ -76,6 +76,34 @@ bool Nack::Parse(const CommonHeader& packet) {
   return true;
 }
 
+bool Nack::Parse(const CommonHeader& packet,
+                 rtc::FunctionView<void(uint16_t)> on_packet_id) {
+  RTC_DCHECK_EQ(packet.type(), kPacketType);
+  RTC_DCHECK_EQ(packet.fmt(), kFeedbackMessageType);
+
+  if (packet.payload_size_bytes() < kCommonFeedbackLength + kNackItemLength) {
+    RTC_LOG(LS_WARNING) << "Payload length " << packet.payload_size_bytes()
+                        << " is too small for a Nack.";
+    return false;
+  }
+  size_t nack_items =
+      (packet.payload_size_bytes() - kCommonFeedbackLength) / kNackItemLength;
+
+  ParseCommonFeedback(packet.payload());
+  const uint8_t* next_nack = packet.payload() + kCommonFeedbackLength;
+  for (size_t index = 0; index < nack_items; ++index) {
+    uint16_t pid = ByteReader<uint16_t>::ReadBigEndian(next_nack);
+    uint16_t bitmask = ByteReader<uint16_t>::ReadBigEndian(next_nack + 2);
+    on_packet_id(pid);
+    for (++pid; bitmask != 0; bitmask >>= 1, ++pid) {
+      if (bitmask & 1)
+        on_packet_id(pid);
+    }
+    next_nack += kNackItemLength;
+  }
+  return true;
+}
+
 size_t Nack::BlockLength() const {
   return kHeaderLength + kCommonFeedbackLength +
          packed_.size() * kNackItemLength;
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+#include "rtc_base/function_view.h"
 
 namespace webrtc {
 namespace rtcp {
@@ -27,6 +28,10 @@ class Nack : public Rtpfb {
 
   // Parse assumes header is already parsed and validated.
   bool Parse(const CommonHeader& packet);
+  // Like Parse(), but passes the requested packet ids to |on_packet_id| in
+  // order instead of storing them.
+  bool Parse(const CommonHeader& packet,
+             rtc::FunctionView<void(uint16_t)> on_packet_id);
 
   void SetPacketIds(const uint16_t* nack_list, size_t length);
   void SetPacketIds(std::vector<uint16_t> nack_list);
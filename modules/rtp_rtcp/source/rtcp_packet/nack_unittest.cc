@@ -10,6 +10,9 @@
 
 #include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
 
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/rtcp_packet_parser.h"
@@ -100,6 +103,21 @@ TEST(RtcpPacketNackTest, ParseWrap) {
   EXPECT_THAT(parsed.packet_ids(), ElementsAreArray(kWrapList));
 }
 
+TEST(RtcpPacketNackTest, ParseWrapWithCallback) {
+  rtcp::CommonHeader header;
+  ASSERT_TRUE(header.Parse(kWrapPacket, sizeof(kWrapPacket)));
+  std::vector<uint16_t> packet_ids;
+  Nack parsed;
+  EXPECT_TRUE(parsed.Parse(header, [&packet_ids](uint16_t packet_id) {
+    packet_ids.push_back(packet_id);
+  }));
+
+  EXPECT_EQ(kSenderSsrc, parsed.sender_ssrc());
+  EXPECT_EQ(kRemoteSsrc, parsed.media_ssrc());
+  EXPECT_TRUE(parsed.packet_ids().empty());
+  EXPECT_THAT(packet_ids, ElementsAreArray(kWrapList));
+}
+
 TEST(RtcpPacketNackTest, BadOrder) {
   // Does not guarantee optimal packing, but should guarantee correctness.
   const uint16_t kUnorderedList[] = {1, 25, 13, 12, 9, 27, 29};
@@ -168,4 +186,11 @@ TEST(RtcpPacketNackTest, ParseFailsWithTooSmallBuffer) {
   EXPECT_FALSE(test::ParseSinglePacket(kTooSmallPacket, &parsed));
 }
 
+TEST(RtcpPacketNackTest, ParseWithCallbackFailsWithTooSmallBuffer) {
+  rtcp::CommonHeader header;
+  ASSERT_TRUE(header.Parse(kTooSmallPacket, sizeof(kTooSmallPacket)));
+  Nack parsed;
+  EXPECT_FALSE(parsed.Parse(header, [](uint16_t packet_id) { FAIL(); }));
+}
+
 }  // namespace webrtc
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/packet_sender.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rtcp {
+
+PacketSender::PacketSender(RtcpPacket::PacketReadyCallback callback,
+                           size_t max_packet_size)
+    : callback_(callback), max_packet_size_(max_packet_size) {
+  RTC_CHECK_LE(max_packet_size, IP_PACKET_SIZE);
+}
+
+PacketSender::~PacketSender() {
+  RTC_DCHECK_EQ(index_, 0) << "Unsent rtcp packet.";
+}
+
+void PacketSender::AppendPacket(const RtcpPacket& packet) {
+  packet.Create(buffer_, &index_, max_packet_size_, callback_);
+}
+
+void PacketSender::Send() {
+  if (index_ > 0) {
+    callback_(rtc::ArrayView<const uint8_t>(buffer_, index_));
+    index_ = 0;
+  }
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
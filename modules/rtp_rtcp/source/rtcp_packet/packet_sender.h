@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_PACKET_SENDER_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_PACKET_SENDER_H_
+
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet.h"
+#include "rtc_base/constructormagic.h"
+
+namespace webrtc {
+namespace rtcp {
+
+// Serializes rtcp packets one after another into a compound packet in a
+// buffer of its own, without allocating. The compound packet is handed to
+// the callback when the next packet doesn't fit or on Send().
+class PacketSender {
+ public:
+  PacketSender(RtcpPacket::PacketReadyCallback callback,
+               size_t max_packet_size);
+  ~PacketSender();
+
+  // Appends a packet to pending compound packet.
+  // Sends rtcp compound packet if buffer was already full and resets buffer.
+  void AppendPacket(const RtcpPacket& packet);
+
+  // Sends pending rtcp compound packet.
+  void Send();
+
+  // Drops the pending compound packet.
+  void Reset() { index_ = 0; }
+
+  bool IsEmpty() const { return index_ == 0; }
+  size_t max_packet_size() const { return max_packet_size_; }
+
+ private:
+  const RtcpPacket::PacketReadyCallback callback_;
+  const size_t max_packet_size_;
+  size_t index_ = 0;
+  uint8_t buffer_[IP_PACKET_SIZE];
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PacketSender);
+};
+
+}  // namespace rtcp
+}  // namespace webrtc
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_PACKET_SENDER_H_
@@ -38,6 +38,20 @@ ReceiverReport::ReceiverReport() : sender_ssrc_(0) {}
 ReceiverReport::~ReceiverReport() = default;
 
 bool ReceiverReport::Parse(const CommonHeader& packet) {
+  std::vector<ReportBlock> report_blocks;
+  report_blocks.reserve(packet.count());
+  if (!Parse(packet, [&report_blocks](const ReportBlock& block) {
+        report_blocks.push_back(block);
+      })) {
+    return false;
+  }
+  report_blocks_ = std::move(report_blocks);
+  return true;
+}
+
+bool ReceiverReport::Parse(
+    const CommonHeader& packet,
+    rtc::FunctionView<void(const ReportBlock&)> on_report_block) {
   RTC_DCHECK_EQ(packet.type(), kPacketType);
 
   const uint8_t report_blocks_count = packet.count();
@@ -52,9 +66,10 @@ bool ReceiverReport::Parse(const CommonHeader& packet) {
 
   const uint8_t* next_report_block = packet.payload() + kRrBaseLength;
 
-  report_blocks_.resize(report_blocks_count);
-  for (ReportBlock& block : report_blocks_) {
+  for (size_t i = 0; i < report_blocks_count; ++i) {
+    ReportBlock block;
     block.Parse(next_report_block, ReportBlock::kLength);
+    on_report_block(block);
     next_report_block += ReportBlock::kLength;
   }
 
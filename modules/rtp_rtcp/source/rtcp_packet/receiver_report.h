@@ -15,6 +15,7 @@
 
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "rtc_base/function_view.h"
 
 namespace webrtc {
 namespace rtcp {
@@ -30,6 +31,10 @@ class ReceiverReport : public RtcpPacket {
 
   // Parse assumes header is already parsed and validated.
   bool Parse(const CommonHeader& packet);
+  // Like Parse(), but passes the report blocks to |on_report_block| in order
+  // instead of storing them.
+  bool Parse(const CommonHeader& packet,
+             rtc::FunctionView<void(const ReportBlock&)> on_report_block);
 
   void SetSenderSsrc(uint32_t ssrc) { sender_ssrc_ = ssrc; }
   bool AddReportBlock(const ReportBlock& block);
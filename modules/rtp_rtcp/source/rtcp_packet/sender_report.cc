@@ -54,6 +54,20 @@ SenderReport& SenderReport::operator=(SenderReport&&) = default;
 SenderReport::~SenderReport() = default;
 
 bool SenderReport::Parse(const CommonHeader& packet) {
+  std::vector<ReportBlock> report_blocks;
+  report_blocks.reserve(packet.count());
+  if (!Parse(packet, [&report_blocks](const ReportBlock& block) {
+        report_blocks.push_back(block);
+      })) {
+    return false;
+  }
+  report_blocks_ = std::move(report_blocks);
+  return true;
+}
+
+bool SenderReport::Parse(
+    const CommonHeader& packet,
+    rtc::FunctionView<void(const ReportBlock&)> on_report_block) {
   RTC_DCHECK_EQ(packet.type(), kPacketType);
 
   const uint8_t report_block_count = packet.count();
@@ -71,11 +85,12 @@ bool SenderReport::Parse(const CommonHeader& packet) {
   rtp_timestamp_ = ByteReader<uint32_t>::ReadBigEndian(&payload[12]);
   sender_packet_count_ = ByteReader<uint32_t>::ReadBigEndian(&payload[16]);
   sender_octet_count_ = ByteReader<uint32_t>::ReadBigEndian(&payload[20]);
-  report_blocks_.resize(report_block_count);
   const uint8_t* next_block = payload + kSenderBaseLength;
-  for (ReportBlock& block : report_blocks_) {
+  for (size_t i = 0; i < report_block_count; ++i) {
+    ReportBlock block;
     bool block_parsed = block.Parse(next_block, ReportBlock::kLength);
     RTC_DCHECK(block_parsed);
+    on_report_block(block);
     next_block += ReportBlock::kLength;
   }
   // Double check we didn't read beyond provided buffer.
@@ -15,6 +15,7 @@
 
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "rtc_base/function_view.h"
 #include "system_wrappers/include/ntp_time.h"
 
 namespace webrtc {
@@ -35,6 +36,10 @@ class SenderReport : public RtcpPacket {
 
   // Parse assumes header is already parsed and validated.
   bool Parse(const CommonHeader& packet);
+  // Like Parse(), but passes the report blocks to |on_report_block| in order
+  // instead of storing them.
+  bool Parse(const CommonHeader& packet,
+             rtc::FunctionView<void(const ReportBlock&)> on_report_block);
 
   void SetSenderSsrc(uint32_t ssrc) { sender_ssrc_ = ssrc; }
   void SetNtp(NtpTime ntp) { ntp_ = ntp; }
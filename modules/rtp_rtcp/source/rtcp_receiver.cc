@@ -12,6 +12,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <map>
 #include <memory>
@@ -61,6 +63,31 @@ const int64_t kRtcpMinFrameLengthMs = 17;
 // Maximum number of received RRTRs that will be stored.
 const size_t kMaxNumberOfStoredRrtrs = 200;
 
+static_assert(rtcp::SenderReport::kMaxNumberOfReportBlocks ==
+                  rtcp::ReceiverReport::kMaxNumberOfReportBlocks,
+              "");
+// Report blocks of a received SR or RR, stored on the stack while the rest of
+// the report is handled.
+using ReportBlockArray =
+    std::array<ReportBlock, rtcp::SenderReport::kMaxNumberOfReportBlocks>;
+
+// Returns the first of the sorted |report_blocks| that isn't ordered before
+// the block |sender_ssrc| sent about |source_ssrc|.
+template <typename ReportBlocks>
+auto LowerBoundReportBlock(ReportBlocks& report_blocks,
+                           uint32_t source_ssrc,
+                           uint32_t sender_ssrc)
+    -> decltype(report_blocks.begin()) {
+  return std::lower_bound(
+      report_blocks.begin(), report_blocks.end(),
+      std::make_pair(source_ssrc, sender_ssrc),
+      [](const typename ReportBlocks::value_type& info,
+         const std::pair<uint32_t, uint32_t>& key) {
+        return std::make_pair(info.report_block.source_ssrc,
+                              info.report_block.sender_ssrc) < key;
+      });
+}
+
 }  // namespace
 
 struct RTCPReceiver::PacketInformation {
@@ -199,15 +226,14 @@ int32_t RTCPReceiver::RTT(uint32_t remote_ssrc,
                           int64_t* max_rtt_ms) const {
   rtc::CritScope lock(&rtcp_receiver_lock_);
 
-  auto it = received_report_blocks_.find(main_ssrc_);
-  if (it == received_report_blocks_.end())
-    return -1;
-
-  auto it_info = it->second.find(remote_ssrc);
-  if (it_info == it->second.end())
+  auto it =
+      LowerBoundReportBlock(received_report_blocks_, main_ssrc_, remote_ssrc);
+  if (it == received_report_blocks_.end() ||
+      it->report_block.source_ssrc != main_ssrc_ ||
+      it->report_block.sender_ssrc != remote_ssrc)
     return -1;
 
-  const ReportBlockWithRtt* report_block = &it_info->second;
+  const ReportBlockWithRtt* report_block = &*it;
 
   if (report_block->num_rtts == 0)
     return -1;
@@ -298,9 +324,8 @@ int32_t RTCPReceiver::StatisticsReceived(
     std::vector<RTCPReportBlock>* receive_blocks) const {
   RTC_DCHECK(receive_blocks);
   rtc::CritScope lock(&rtcp_receiver_lock_);
-  for (const auto& reports_per_receiver : received_report_blocks_)
-    for (const auto& report : reports_per_receiver.second)
-      receive_blocks->push_back(report.second.report_block);
+  for (const ReportBlockWithRtt& report : received_report_blocks_)
+    receive_blocks->push_back(report.report_block);
   return 0;
 }
 
@@ -409,7 +434,11 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
 void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
   rtcp::SenderReport sender_report;
-  if (!sender_report.Parse(rtcp_block)) {
+  ReportBlockArray report_blocks;
+  size_t num_report_blocks = 0;
+  if (!sender_report.Parse(rtcp_block, [&](const ReportBlock& report_block) {
+        report_blocks[num_report_blocks++] = report_block;
+      })) {
     ++num_skipped_packets_;
     return;
   }
@@ -434,14 +463,18 @@ void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
     packet_information->packet_type_flags |= kRtcpRr;
   }
 
-  for (const rtcp::ReportBlock report_block : sender_report.report_blocks())
-    HandleReportBlock(report_block, packet_information, remote_ssrc);
+  for (size_t i = 0; i < num_report_blocks; ++i)
+    HandleReportBlock(report_blocks[i], packet_information, remote_ssrc);
 }
 
 void RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
                                         PacketInformation* packet_information) {
   rtcp::ReceiverReport receiver_report;
-  if (!receiver_report.Parse(rtcp_block)) {
+  ReportBlockArray report_blocks;
+  size_t num_report_blocks = 0;
+  if (!receiver_report.Parse(rtcp_block, [&](const ReportBlock& report_block) {
+        report_blocks[num_report_blocks++] = report_block;
+      })) {
     ++num_skipped_packets_;
     return;
   }
@@ -454,8 +487,8 @@ void RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
 
   packet_information->packet_type_flags |= kRtcpRr;
 
-  for (const ReportBlock& report_block : receiver_report.report_blocks())
-    HandleReportBlock(report_block, packet_information, remote_ssrc);
+  for (size_t i = 0; i < num_report_blocks; ++i)
+    HandleReportBlock(report_blocks[i], packet_information, remote_ssrc);
 }
 
 void RTCPReceiver::HandleReportBlock(const ReportBlock& report_block,
@@ -476,10 +509,16 @@ void RTCPReceiver::HandleReportBlock(const ReportBlock& report_block,
 
   last_received_rb_ms_ = clock_->TimeInMilliseconds();
 
-  ReportBlockWithRtt* report_block_info =
-      &received_report_blocks_[report_block.source_ssrc()][remote_ssrc];
-  report_block_info->report_block.sender_ssrc = remote_ssrc;
-  report_block_info->report_block.source_ssrc = report_block.source_ssrc();
+  auto it = LowerBoundReportBlock(received_report_blocks_,
+                                  report_block.source_ssrc(), remote_ssrc);
+  if (it == received_report_blocks_.end() ||
+      it->report_block.source_ssrc != report_block.source_ssrc() ||
+      it->report_block.sender_ssrc != remote_ssrc) {
+    it = received_report_blocks_.emplace(it);
+    it->report_block.sender_ssrc = remote_ssrc;
+    it->report_block.source_ssrc = report_block.source_ssrc();
+  }
+  ReportBlockWithRtt* report_block_info = &*it;
   report_block_info->report_block.fraction_lost = report_block.fraction_lost();
   report_block_info->report_block.packets_lost =
       report_block.cumulative_lost_signed();
@@ -649,22 +688,28 @@ void RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 void RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
+  // The requested packets are parsed straight into |packet_information|.
+  std::vector<uint16_t>* nack_sequence_numbers =
+      &packet_information->nack_sequence_numbers;
+  const size_t num_previous_requests = nack_sequence_numbers->size();
   rtcp::Nack nack;
-  if (!nack.Parse(rtcp_block)) {
+  if (!nack.Parse(rtcp_block, [nack_sequence_numbers](uint16_t packet_id) {
+        nack_sequence_numbers->push_back(packet_id);
+      })) {
+    nack_sequence_numbers->resize(num_previous_requests);
     ++num_skipped_packets_;
     return;
   }
 
-  if (receiver_only_ || main_ssrc_ != nack.media_ssrc())  // Not to us.
+  if (receiver_only_ || main_ssrc_ != nack.media_ssrc()) {  // Not to us.
+    nack_sequence_numbers->resize(num_previous_requests);
     return;
+  }
 
-  packet_information->nack_sequence_numbers.insert(
-      packet_information->nack_sequence_numbers.end(),
-      nack.packet_ids().begin(), nack.packet_ids().end());
-  for (uint16_t packet_id : nack.packet_ids())
-    nack_stats_.ReportRequest(packet_id);
+  for (size_t i = num_previous_requests; i < nack_sequence_numbers->size(); ++i)
+    nack_stats_.ReportRequest((*nack_sequence_numbers)[i]);
 
-  if (!nack.packet_ids().empty()) {
+  if (nack_sequence_numbers->size() > num_previous_requests) {
     packet_information->packet_type_flags |= kRtcpNack;
     ++packet_type_counter_.nack_packets;
     packet_type_counter_.nack_requests = nack_stats_.requests();
@@ -680,8 +725,14 @@ void RTCPReceiver::HandleBye(const CommonHeader& rtcp_block) {
   }
 
   // Clear our lists.
-  for (auto& reports_per_receiver : received_report_blocks_)
-    reports_per_receiver.second.erase(bye.sender_ssrc());
+  received_report_blocks_.erase(
+      std::remove_if(received_report_blocks_.begin(),
+                     received_report_blocks_.end(),
+                     [&bye](const ReportBlockWithRtt& report) {
+                       return report.report_block.sender_ssrc ==
+                              bye.sender_ssrc();
+                     }),
+      received_report_blocks_.end());
 
   TmmbrInformation* tmmbr_info = GetTmmbrInformation(bye.sender_ssrc());
   if (tmmbr_info)
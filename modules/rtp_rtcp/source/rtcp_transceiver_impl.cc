@@ -10,6 +10,7 @@
 
 #include "modules/rtp_rtcp/source/rtcp_transceiver_impl.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -23,6 +24,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/packet_sender.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
@@ -42,6 +44,24 @@ struct SenderReportTimes {
   NtpTime remote_sent_time;
 };
 
+// Returns how many report blocks fit into receiver reports of at most
+// |max_size| bytes in total.
+size_t MaxReportBlocks(size_t max_size) {
+  constexpr size_t kReceiverReportHeaderSize = 8;
+  constexpr size_t kMaxBlocksPerReport =
+      rtcp::ReceiverReport::kMaxNumberOfReportBlocks;
+  constexpr size_t kFullReportSize =
+      kReceiverReportHeaderSize +
+      kMaxBlocksPerReport * rtcp::ReportBlock::kLength;
+  size_t max_blocks = max_size / kFullReportSize * kMaxBlocksPerReport;
+  size_t remaining_size = max_size % kFullReportSize;
+  if (remaining_size > kReceiverReportHeaderSize) {
+    max_blocks += (remaining_size - kReceiverReportHeaderSize) /
+                  rtcp::ReportBlock::kLength;
+  }
+  return max_blocks;
+}
+
 }  // namespace
 
 struct RtcpTransceiverImpl::RemoteSenderState {
@@ -50,42 +70,6 @@ struct RtcpTransceiverImpl::RemoteSenderState {
   std::vector<MediaReceiverRtcpObserver*> observers;
 };
 
-// Helper to put several RTCP packets into lower layer datagram composing
-// Compound or Reduced-Size RTCP packet, as defined by RFC 5506 section 2.
-// TODO(danilchap): When in compound mode and packets are so many that several
-// compound RTCP packets need to be generated, ensure each packet is compound.
-class RtcpTransceiverImpl::PacketSender {
- public:
-  PacketSender(rtcp::RtcpPacket::PacketReadyCallback callback,
-               size_t max_packet_size)
-      : callback_(callback), max_packet_size_(max_packet_size) {
-    RTC_CHECK_LE(max_packet_size, IP_PACKET_SIZE);
-  }
-  ~PacketSender() { RTC_DCHECK_EQ(index_, 0) << "Unsent rtcp packet."; }
-
-  // Appends a packet to pending compound packet.
-  // Sends rtcp compound packet if buffer was already full and resets buffer.
-  void AppendPacket(const rtcp::RtcpPacket& packet) {
-    packet.Create(buffer_, &index_, max_packet_size_, callback_);
-  }
-
-  // Sends pending rtcp compound packet.
-  void Send() {
-    if (index_ > 0) {
-      callback_(rtc::ArrayView<const uint8_t>(buffer_, index_));
-      index_ = 0;
-    }
-  }
-
-  bool IsEmpty() const { return index_ == 0; }
-
- private:
-  const rtcp::RtcpPacket::PacketReadyCallback callback_;
-  const size_t max_packet_size_;
-  size_t index_ = 0;
-  uint8_t buffer_[IP_PACKET_SIZE];
-};
-
 RtcpTransceiverImpl::RtcpTransceiverImpl(const RtcpTransceiverConfig& config)
     : config_(config),
       ready_to_send_(config.initial_ready_to_send),
@@ -209,6 +193,14 @@ void RtcpTransceiverImpl::SendFullIntraRequest(
   SendImmediateFeedback(fir);
 }
 
+void RtcpTransceiverImpl::SendCombinedRtcpPacket(
+    rtc::ArrayView<const rtcp::RtcpPacket* const> rtcp_packets) {
+  RTC_DCHECK(!rtcp_packets.empty());
+  if (!ready_to_send_)
+    return;
+  SendImmediateFeedback(rtcp_packets);
+}
+
 void RtcpTransceiverImpl::HandleReceivedPacket(
     const rtcp::CommonHeader& rtcp_packet_header,
     int64_t now_us) {
@@ -354,62 +346,106 @@ void RtcpTransceiverImpl::SchedulePeriodicCompoundPackets(int64_t delay_ms) {
     config_.task_queue->PostTask(std::move(task));
 }
 
-void RtcpTransceiverImpl::CreateCompoundPacket(PacketSender* sender) {
+void RtcpTransceiverImpl::CreateCompoundPacket(size_t reserved_size,
+                                               rtcp::PacketSender* sender) {
   RTC_DCHECK(sender->IsEmpty());
   const uint32_t sender_ssrc = config_.feedback_ssrc;
   int64_t now_us = rtc::TimeMicros();
-  rtcp::ReceiverReport receiver_report;
-  receiver_report.SetSenderSsrc(sender_ssrc);
-  receiver_report.SetReportBlocks(CreateReportBlocks(now_us));
-  sender->AppendPacket(receiver_report);
 
+  // Packets that follow the receiver reports are built first, so that the
+  // report blocks can take the room they leave.
+  rtcp::Sdes sdes;
   if (!config_.cname.empty()) {
-    rtcp::Sdes sdes;
     bool added = sdes.AddCName(config_.feedback_ssrc, config_.cname);
     RTC_DCHECK(added) << "Failed to add cname " << config_.cname
                       << " to rtcp sdes packet.";
-    sender->AppendPacket(sdes);
+    reserved_size += sdes.BlockLength();
   }
   if (remb_) {
     remb_->SetSenderSsrc(sender_ssrc);
-    sender->AppendPacket(*remb_);
+    reserved_size += remb_->BlockLength();
   }
   // TODO(bugs.webrtc.org/8239): Do not send rrtr if this packet starts with
   // SenderReport instead of ReceiverReport
   // when RtcpTransceiver supports rtp senders.
+  rtcp::ExtendedReports xr;
   if (config_.non_sender_rtt_measurement) {
-    rtcp::ExtendedReports xr;
-
     rtcp::Rrtr rrtr;
     rrtr.SetNtp(TimeMicrosToNtp(now_us));
     xr.SetRrtr(rrtr);
 
     xr.SetSenderSsrc(sender_ssrc);
-    sender->AppendPacket(xr);
+    reserved_size += xr.BlockLength();
   }
+
+  // Report blocks that don't fit into one receiver report go into more
+  // receiver reports of the same compound packet.
+  size_t max_report_blocks =
+      reserved_size < sender->max_packet_size()
+          ? MaxReportBlocks(sender->max_packet_size() - reserved_size)
+          : 0;
+  std::vector<rtcp::ReportBlock> report_blocks =
+      CreateReportBlocks(now_us, max_report_blocks);
+  constexpr size_t kMaxBlocksPerReport =
+      rtcp::ReceiverReport::kMaxNumberOfReportBlocks;
+  const size_t num_report_blocks = report_blocks.size();
+  size_t first_block = 0;
+  do {
+    size_t num_blocks =
+        std::min(num_report_blocks - first_block, kMaxBlocksPerReport);
+    rtcp::ReceiverReport receiver_report;
+    receiver_report.SetSenderSsrc(sender_ssrc);
+    if (num_blocks == num_report_blocks) {
+      receiver_report.SetReportBlocks(std::move(report_blocks));
+    } else {
+      auto begin = report_blocks.begin() + first_block;
+      receiver_report.SetReportBlocks(
+          std::vector<rtcp::ReportBlock>(begin, begin + num_blocks));
+    }
+    sender->AppendPacket(receiver_report);
+    first_block += num_blocks;
+  } while (first_block < num_report_blocks);
+
+  if (!config_.cname.empty())
+    sender->AppendPacket(sdes);
+  if (remb_)
+    sender->AppendPacket(*remb_);
+  if (config_.non_sender_rtt_measurement)
+    sender->AppendPacket(xr);
 }
 
 void RtcpTransceiverImpl::SendPeriodicCompoundPacket() {
   auto send_packet = [this](rtc::ArrayView<const uint8_t> packet) {
     config_.outgoing_transport->SendRtcp(packet.data(), packet.size());
   };
-  PacketSender sender(send_packet, config_.max_packet_size);
-  CreateCompoundPacket(&sender);
+  rtcp::PacketSender sender(send_packet, config_.max_packet_size);
+  CreateCompoundPacket(0, &sender);
   sender.Send();
 }
 
 void RtcpTransceiverImpl::SendImmediateFeedback(
     const rtcp::RtcpPacket& rtcp_packet) {
+  const rtcp::RtcpPacket* rtcp_packets[] = {&rtcp_packet};
+  SendImmediateFeedback(rtcp_packets);
+}
+
+void RtcpTransceiverImpl::SendImmediateFeedback(
+    rtc::ArrayView<const rtcp::RtcpPacket* const> rtcp_packets) {
   auto send_packet = [this](rtc::ArrayView<const uint8_t> packet) {
     config_.outgoing_transport->SendRtcp(packet.data(), packet.size());
   };
-  PacketSender sender(send_packet, config_.max_packet_size);
+  rtcp::PacketSender sender(send_packet, config_.max_packet_size);
   // Compound mode requires every sent rtcp packet to be compound, i.e. start
   // with a sender or receiver report.
-  if (config_.rtcp_mode == RtcpMode::kCompound)
-    CreateCompoundPacket(&sender);
+  if (config_.rtcp_mode == RtcpMode::kCompound) {
+    size_t feedback_size = 0;
+    for (const rtcp::RtcpPacket* rtcp_packet : rtcp_packets)
+      feedback_size += rtcp_packet->BlockLength();
+    CreateCompoundPacket(feedback_size, &sender);
+  }
 
-  sender.AppendPacket(rtcp_packet);
+  for (const rtcp::RtcpPacket* rtcp_packet : rtcp_packets)
+    sender.AppendPacket(*rtcp_packet);
   sender.Send();
 
   // If compound packet was sent, delay (reschedule) the periodic one.
@@ -418,14 +454,12 @@ void RtcpTransceiverImpl::SendImmediateFeedback(
 }
 
 std::vector<rtcp::ReportBlock> RtcpTransceiverImpl::CreateReportBlocks(
-    int64_t now_us) {
+    int64_t now_us,
+    size_t max_blocks) {
   if (!config_.receive_statistics)
     return {};
-  // TODO(danilchap): Support sending more than
-  // |ReceiverReport::kMaxNumberOfReportBlocks| per compound rtcp packet.
   std::vector<rtcp::ReportBlock> report_blocks =
-      config_.receive_statistics->RtcpReportBlocks(
-          rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+      config_.receive_statistics->RtcpReportBlocks(max_blocks);
   uint32_t last_sr = 0;
   uint32_t last_delay = 0;
   for (rtcp::ReportBlock& report_block : report_blocks) {
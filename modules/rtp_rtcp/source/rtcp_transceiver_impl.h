@@ -29,6 +29,9 @@
 #include "system_wrappers/include/ntp_time.h"
 
 namespace webrtc {
+namespace rtcp {
+class PacketSender;
+}  // namespace rtcp
 //
 // Manage incoming and outgoing rtcp messages for multiple BUNDLED streams.
 //
@@ -60,8 +63,13 @@ class RtcpTransceiverImpl {
   void SendPictureLossIndication(uint32_t ssrc);
   void SendFullIntraRequest(rtc::ArrayView<const uint32_t> ssrcs);
 
+  // Sends |rtcp_packets|, e.g. feedback for many media ssrcs, in as few
+  // datagrams as max_packet_size allows. In compound mode the first datagram
+  // starts with the receiver reports.
+  void SendCombinedRtcpPacket(
+      rtc::ArrayView<const rtcp::RtcpPacket* const> rtcp_packets);
+
  private:
-  class PacketSender;
   struct RemoteSenderState;
 
   void HandleReceivedPacket(const rtcp::CommonHeader& rtcp_packet_header,
@@ -81,12 +89,17 @@ class RtcpTransceiverImpl {
   void SchedulePeriodicCompoundPackets(int64_t delay_ms);
   // Creates compound RTCP packet, as defined in
   // https://tools.ietf.org/html/rfc5506#section-2
-  void CreateCompoundPacket(PacketSender* sender);
+  // Leaves |reserved_size| bytes of the first datagram to packets that are
+  // appended after it.
+  void CreateCompoundPacket(size_t reserved_size, rtcp::PacketSender* sender);
   // Sends RTCP packets.
   void SendPeriodicCompoundPacket();
   void SendImmediateFeedback(const rtcp::RtcpPacket& rtcp_packet);
+  void SendImmediateFeedback(
+      rtc::ArrayView<const rtcp::RtcpPacket* const> rtcp_packets);
   // Generate Report Blocks to be send in Sender or Receiver Report.
-  std::vector<rtcp::ReportBlock> CreateReportBlocks(int64_t now_us);
+  std::vector<rtcp::ReportBlock> CreateReportBlocks(int64_t now_us,
+                                                    size_t max_blocks);
 
   const RtcpTransceiverConfig config_;
 
@@ -10,6 +10,7 @@
 
 #include "modules/rtp_rtcp/source/rtcp_transceiver_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -19,6 +20,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
 #include "modules/rtp_rtcp/source/time_util.h"
 #include "rtc_base/event.h"
 #include "rtc_base/fakeclock.h"
@@ -48,6 +50,7 @@ using ::webrtc::SaturatedUsToCompactNtp;
 using ::webrtc::TimeMicrosToNtp;
 using ::webrtc::rtcp::Bye;
 using ::webrtc::rtcp::CompoundPacket;
+using ::webrtc::rtcp::Nack;
 using ::webrtc::rtcp::ReportBlock;
 using ::webrtc::rtcp::SenderReport;
 using ::webrtc::test::RtcpPacketParser;
@@ -454,6 +457,58 @@ TEST(RtcpTransceiverImplTest, ReceiverReportUsesReceiveStatistics) {
             kMediaSsrc);
 }
 
+TEST(RtcpTransceiverImplTest, SendsReportBlocksForManySsrcsInOnePacket) {
+  const size_t kNumMediaSsrcs = 40;
+  MockReceiveStatisticsProvider receive_statistics;
+  EXPECT_CALL(receive_statistics, RtcpReportBlocks(_))
+      .WillRepeatedly(Invoke([&](size_t max_blocks) {
+        std::vector<ReportBlock> report_blocks(
+            std::min(max_blocks, kNumMediaSsrcs));
+        for (size_t i = 0; i < report_blocks.size(); ++i)
+          report_blocks[i].SetMediaSsrc(1000 + i);
+        return report_blocks;
+      }));
+
+  RtcpTransceiverConfig config;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  config.schedule_periodic_compound_packets = false;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  EXPECT_EQ(transport.num_packets(), 1);
+  // The report blocks that don't fit into the first receiver report are sent
+  // in the second one.
+  EXPECT_EQ(rtcp_parser.receiver_report()->num_packets(), 2);
+  ASSERT_THAT(rtcp_parser.receiver_report()->report_blocks(), SizeIs(9));
+  EXPECT_EQ(rtcp_parser.receiver_report()->report_blocks()[0].source_ssrc(),
+            1031u);
+}
+
+TEST(RtcpTransceiverImplTest, RequestsReportBlocksThatFitMaxPacketSize) {
+  MockReceiveStatisticsProvider receive_statistics;
+  // 8 bytes of receiver report header and 8 report blocks of 24 bytes each.
+  EXPECT_CALL(receive_statistics, RtcpReportBlocks(8))
+      .WillOnce(Return(std::vector<ReportBlock>(8)));
+
+  RtcpTransceiverConfig config;
+  config.max_packet_size = 8 + 8 * ReportBlock::kLength + 20;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  config.schedule_periodic_compound_packets = false;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  EXPECT_EQ(transport.num_packets(), 1);
+  EXPECT_THAT(rtcp_parser.receiver_report()->report_blocks(), SizeIs(8));
+}
+
 TEST(RtcpTransceiverImplTest, MultipleObserversOnSameSsrc) {
   const uint32_t kRemoteSsrc = 12345;
   StrictMock<MockMediaReceiverRtcpObserver> observer1;
@@ -784,6 +839,34 @@ TEST(RtcpTransceiverImplTest, SendsNack) {
   EXPECT_EQ(rtcp_parser.nack()->packet_ids(), kMissingSequenceNumbers);
 }
 
+TEST(RtcpTransceiverImplTest, SendsCombinedPacketWithFeedbackForManySsrcs) {
+  const uint32_t kSenderSsrc = 1234;
+  RtcpTransceiverConfig config;
+  config.feedback_ssrc = kSenderSsrc;
+  config.schedule_periodic_compound_packets = false;
+  config.rtcp_mode = webrtc::RtcpMode::kCompound;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  Nack nack1;
+  nack1.SetSenderSsrc(kSenderSsrc);
+  nack1.SetMediaSsrc(4321);
+  nack1.SetPacketIds({34, 37});
+  Nack nack2;
+  nack2.SetSenderSsrc(kSenderSsrc);
+  nack2.SetMediaSsrc(5321);
+  nack2.SetPacketIds({12});
+  const webrtc::rtcp::RtcpPacket* packets[] = {&nack1, &nack2};
+  rtcp_transceiver.SendCombinedRtcpPacket(packets);
+
+  EXPECT_EQ(transport.num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.receiver_report()->num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.nack()->num_packets(), 2);
+  EXPECT_EQ(rtcp_parser.nack()->media_ssrc(), 5321u);
+}
+
 TEST(RtcpTransceiverImplTest, RequestKeyFrameWithPictureLossIndication) {
   const uint32_t kSenderSsrc = 1234;
   const uint32_t kRemoteSsrc = 4321;
@@ -340,6 +340,106 @@ TYPED_TEST(RtpFecTest, FecRecoveryWithLoss) {
 }
 
 // Verify that we don't use an old FEC packet for FEC decoding.
+TYPED_TEST(RtpFecTest, FecRecoveryReusesPacketBuffers) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr int kNumMediaPackets = 4;
+  constexpr uint8_t kProtectionFactor = 60;
+
+  // Decodes a frame that lost its last media packet, and returns the buffer
+  // of the recovered packet.
+  auto decode_frame = [this]() {
+    this->media_packets_ =
+        this->media_packet_generator_.ConstructMediaPackets(kNumMediaPackets);
+    this->generated_fec_packets_.clear();
+    EXPECT_EQ(
+        0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                                kNumImportantPackets, kUseUnequalProtection,
+                                kFecMaskBursty, &this->generated_fec_packets_));
+    EXPECT_EQ(1u, this->generated_fec_packets_.size());
+
+    memset(this->media_loss_mask_, 0, sizeof(this->media_loss_mask_));
+    memset(this->fec_loss_mask_, 0, sizeof(this->fec_loss_mask_));
+    this->media_loss_mask_[kNumMediaPackets - 1] = 1;
+    this->NetworkReceivedPackets(this->media_loss_mask_, this->fec_loss_mask_);
+
+    for (const auto& received_packet : this->received_packets_) {
+      this->fec_.DecodeFec(*received_packet, &this->recovered_packets_);
+    }
+    EXPECT_TRUE(this->IsRecoveryComplete());
+    rtc::scoped_refptr<ForwardErrorCorrection::Packet> recovered =
+        this->recovered_packets_.back()->pkt;
+    EXPECT_TRUE(this->recovered_packets_.back()->was_recovered);
+    this->recovered_packets_.clear();
+    return recovered;
+  };
+
+  // A buffer that is still referenced is not handed out again.
+  rtc::scoped_refptr<ForwardErrorCorrection::Packet> first = decode_frame();
+  rtc::scoped_refptr<ForwardErrorCorrection::Packet> second = decode_frame();
+  EXPECT_NE(first.get(), second.get());
+
+  // Once released, buffers are reused for the following frames.
+  ForwardErrorCorrection::Packet* second_ptr = second.get();
+  second = nullptr;
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ(second_ptr, decode_frame().get());
+}
+
+TYPED_TEST(RtpFecTest, FecRecoveryWithBurstLossTwoDimensionalMask) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr int kNumMediaPackets = 12;
+  constexpr uint8_t kProtectionFactor = 128;
+
+  this->media_packets_ =
+      this->media_packet_generator_.ConstructMediaPackets(kNumMediaPackets);
+
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskTwoDimensional,
+                              &this->generated_fec_packets_));
+
+  // Expect 6 FEC packets: 3 column and 3 row parity packets.
+  EXPECT_EQ(6u, this->generated_fec_packets_.size());
+
+  // A burst of 3 media packets and a row parity packet lost. Each column lost
+  // one packet.
+  memset(this->media_loss_mask_, 0, sizeof(this->media_loss_mask_));
+  memset(this->fec_loss_mask_, 0, sizeof(this->fec_loss_mask_));
+  this->media_loss_mask_[5] = 1;
+  this->media_loss_mask_[6] = 1;
+  this->media_loss_mask_[7] = 1;
+  this->fec_loss_mask_[4] = 1;
+  this->NetworkReceivedPackets(this->media_loss_mask_, this->fec_loss_mask_);
+
+  for (const auto& received_packet : this->received_packets_) {
+    this->fec_.DecodeFec(*received_packet, &this->recovered_packets_);
+  }
+
+  EXPECT_TRUE(this->IsRecoveryComplete());
+  this->recovered_packets_.clear();
+
+  // Two losses in the first column and one in the second, all column parity
+  // packets lost: the row parity packets recover them.
+  memset(this->media_loss_mask_, 0, sizeof(this->media_loss_mask_));
+  memset(this->fec_loss_mask_, 0, sizeof(this->fec_loss_mask_));
+  this->media_loss_mask_[0] = 1;
+  this->media_loss_mask_[4] = 1;
+  this->media_loss_mask_[9] = 1;
+  this->fec_loss_mask_[0] = 1;
+  this->fec_loss_mask_[1] = 1;
+  this->fec_loss_mask_[2] = 1;
+  this->NetworkReceivedPackets(this->media_loss_mask_, this->fec_loss_mask_);
+
+  for (const auto& received_packet : this->received_packets_) {
+    this->fec_.DecodeFec(*received_packet, &this->recovered_packets_);
+  }
+
+  EXPECT_TRUE(this->IsRecoveryComplete());
+}
+
 TYPED_TEST(RtpFecTest, NoFecRecoveryWithOldFecPacket) {
   constexpr int kNumImportantPackets = 0;
   constexpr bool kUseUnequalProtection = false;
@@ -10,6 +10,7 @@
 
 #include "modules/rtp_rtcp/source/rtp_packet.h"
 
+#include <algorithm>
 #include <cstring>
 #include <utility>
 
@@ -72,6 +73,7 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
   } else {
     for (size_t i = 0; i < kMaxExtensionHeaders; ++i)
       extension_entries_[i].type = ExtensionManager::kInvalidType;
+    UpdateExtensionIds();
   }
 }
 
@@ -80,6 +82,7 @@ RtpPacket::~RtpPacket() {}
 void RtpPacket::IdentifyExtensions(const ExtensionManager& extensions) {
   for (int i = 0; i < kMaxExtensionHeaders; ++i)
     extension_entries_[i].type = extensions.GetType(i + 1);
+  UpdateExtensionIds();
 }
 
 bool RtpPacket::Parse(const uint8_t* buffer, size_t buffer_size) {
@@ -198,6 +201,7 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   for (size_t i = 0; i < kMaxExtensionHeaders; ++i) {
     extension_entries_[i] = packet.extension_entries_[i];
   }
+  memcpy(extension_ids_, packet.extension_ids_, sizeof(extension_ids_));
   extensions_size_ = packet.extensions_size_;
   buffer_.SetData(packet.data(), packet.headers_size());
   // Reset payload and padding.
@@ -340,6 +344,44 @@ uint8_t* RtpPacket::SetPayloadSize(size_t size_bytes) {
   return WriteAt(payload_offset_);
 }
 
+uint8_t* RtpPacket::PrependToPayload(size_t size_bytes) {
+  const size_t tail_size = payload_size_ + padding_size_;
+  const size_t new_size = size() + size_bytes;
+  if (buffer_.IsShared() || new_size > capacity()) {
+    // Writing to the buffer would copy it anyway, so copy it right away,
+    // leaving the gap.
+    rtc::CopyOnWriteBuffer buffer(new_size, std::max(capacity(), new_size));
+    memcpy(buffer.data(), data(), payload_offset_);
+    memcpy(buffer.data() + payload_offset_ + size_bytes,
+           data() + payload_offset_, tail_size);
+    buffer_ = std::move(buffer);
+  } else {
+    buffer_.SetSize(new_size);
+    uint8_t* payload = WriteAt(payload_offset_);
+    memmove(payload + size_bytes, payload, tail_size);
+  }
+  payload_size_ += size_bytes;
+  return WriteAt(payload_offset_);
+}
+
+bool RtpPacket::RemovePayloadPrefix(size_t size_bytes) {
+  if (size_bytes > payload_size_)
+    return false;
+  const size_t tail_size = payload_size_ - size_bytes + padding_size_;
+  const uint8_t* tail = data() + payload_offset_ + size_bytes;
+  if (buffer_.IsShared()) {
+    rtc::CopyOnWriteBuffer buffer(size() - size_bytes, capacity());
+    memcpy(buffer.data(), data(), payload_offset_);
+    memcpy(buffer.data() + payload_offset_, tail, tail_size);
+    buffer_ = std::move(buffer);
+  } else {
+    memmove(WriteAt(payload_offset_), tail, tail_size);
+    buffer_.SetSize(size() - size_bytes);
+  }
+  payload_size_ -= size_bytes;
+  return true;
+}
+
 bool RtpPacket::SetPadding(uint8_t size_bytes, Random* random) {
   RTC_DCHECK(random);
   if (payload_offset_ + payload_size_ + size_bytes > capacity()) {
@@ -491,30 +533,25 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   return true;
 }
 
-rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
-    ExtensionType type) const {
-  for (const ExtensionInfo& extension : extension_entries_) {
-    if (extension.type == type) {
-      if (extension.length == 0) {
-        // Extension is registered but not set.
-        return nullptr;
-      }
-      return rtc::MakeArrayView(data() + extension.offset, extension.length);
-    }
+void RtpPacket::UpdateExtensionIds() {
+  memset(extension_ids_, 0, sizeof(extension_ids_));
+  // Iterate backwards so that the lowest id wins if a type is registered
+  // more than once, as with a search from the start.
+  for (int i = kMaxExtensionHeaders - 1; i >= 0; --i) {
+    ExtensionType type = extension_entries_[i].type;
+    if (type != ExtensionManager::kInvalidType)
+      extension_ids_[type] = i + 1;
   }
-  return nullptr;
 }
 
 rtc::ArrayView<uint8_t> RtpPacket::AllocateExtension(ExtensionType type,
                                                      size_t length) {
-  for (int i = 0; i < kMaxExtensionHeaders; ++i) {
-    if (extension_entries_[i].type == type) {
-      int extension_id = i + 1;
-      return AllocateRawExtension(extension_id, length);
-    }
+  const int extension_id = extension_ids_[type];
+  if (extension_id == 0) {
+    // Extension not registered.
+    return nullptr;
   }
-  // Extension not registered.
-  return nullptr;
+  return AllocateRawExtension(extension_id, length);
 }
 
 uint8_t* RtpPacket::WriteAt(size_t offset) {
@@ -106,6 +106,14 @@ class RtpPacket {
   uint8_t* SetPayloadSize(size_t size_bytes);
   // Same as SetPayloadSize but doesn't guarantee to keep current payload.
   uint8_t* AllocatePayload(size_t size_bytes);
+  // Inserts |size_bytes| uninitialized bytes before the payload, e.g. for an
+  // RTX header, and returns a pointer to them. The payload and padding move
+  // within the buffer, or, if the buffer is shared, are copied once into a
+  // new one.
+  uint8_t* PrependToPayload(size_t size_bytes);
+  // Removes the first |size_bytes| of the payload, in the same way. Returns
+  // false if the payload is shorter.
+  bool RemovePayloadPrefix(size_t size_bytes);
   bool SetPadding(uint8_t size_bytes, Random* random);
 
  private:
@@ -121,8 +129,13 @@ class RtpPacket {
 
   // Find an extension |type|.
   // Returns view of the raw extension or empty view on failure.
+  // Inlined, so that the typed accessors, which pass a constant |type|, read
+  // the extension location with no search.
   rtc::ArrayView<const uint8_t> FindExtension(ExtensionType type) const;
 
+  // Updates |extension_ids_| from the types in |extension_entries_|.
+  void UpdateExtensionIds();
+
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
   rtc::ArrayView<uint8_t> AllocateRawExtension(int id, size_t length);
@@ -145,10 +158,25 @@ class RtpPacket {
   size_t payload_size_;
 
   ExtensionInfo extension_entries_[kMaxExtensionHeaders];
+  // Id registered for each extension type, or 0 if the type isn't registered.
+  uint8_t extension_ids_[kRtpExtensionNumberOfExtensions];
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
 
+inline rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
+    ExtensionType type) const {
+  const int id = extension_ids_[type];
+  if (id == 0)
+    return nullptr;
+  const ExtensionInfo& extension = extension_entries_[id - 1];
+  if (extension.length == 0) {
+    // Extension is registered but not set.
+    return nullptr;
+  }
+  return rtc::MakeArrayView(data() + extension.offset, extension.length);
+}
+
 template <typename Extension>
 bool RtpPacket::HasExtension() const {
   return !FindExtension(Extension::kId).empty();
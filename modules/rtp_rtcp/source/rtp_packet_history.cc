@@ -11,7 +11,6 @@
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 
 #include <algorithm>
-#include <limits>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -25,6 +24,25 @@ namespace {
 // Min packet size for BestFittingPacket() to honor.
 constexpr size_t kMinPacketRequestBytes = 50;
 
+// Lower bound of the RTT used by GetPacketForProbing(), for when it isn't
+// known yet.
+constexpr int64_t kMinProbingPacketAgeMs = 100;
+
+// Initial size of the packet buffer, which grows as needed.
+constexpr size_t kMinBufferSize = 16;
+
+// Upper bound on the range of sequence numbers held at once. Keeps forward
+// and backward differences to |start_seqno_| unambiguous.
+constexpr size_t kMaxSequenceSpan = 1 << 15;
+
+// Packets are bucketed by exact size up to this one, for padding.
+constexpr size_t kNumPaddingBuckets = IP_PACKET_SIZE + 1;
+constexpr size_t kPaddingMaskWords = (kNumPaddingBuckets + 63) / 64;
+
+int PaddingBucket(size_t packet_size) {
+  return static_cast<int>(std::min(packet_size, kNumPaddingBuckets - 1));
+}
+
 // Utility function to get the absolute difference in size between the provided
 // target size and the size of packet.
 size_t SizeDiff(const std::unique_ptr<RtpPacketToSend>& packet, size_t size) {
@@ -55,7 +73,11 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock)
     : clock_(clock),
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
-      rtt_ms_(-1) {}
+      rtt_ms_(-1),
+      span_(0),
+      num_packets_(0),
+      padding_buckets_(kNumPaddingBuckets, -1),
+      padding_bucket_mask_(kPaddingMaskWords, 0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -69,6 +91,13 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
   Reset();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
+  size_t buffer_size = kMinBufferSize;
+  if (mode_ != StorageMode::kDisabled) {
+    while (buffer_size < number_to_store_) {
+      buffer_size *= 2;
+    }
+  }
+  buffer_.resize(buffer_size);
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
@@ -96,9 +125,13 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
 
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
-  StoredPacket& stored_packet = packet_history_[rtp_seq_no];
-  RTC_DCHECK(stored_packet.packet == nullptr);
+  if (FindPacket(rtp_seq_no)) {
+    RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
+    RemovePacket(rtp_seq_no);
+  }
+  StoredPacket& stored_packet = *AllocatePacket(rtp_seq_no);
   stored_packet.packet = std::move(packet);
+  ++num_packets_;
 
   if (stored_packet.packet->capture_time_ms() <= 0) {
     stored_packet.packet->set_capture_time_ms(now_ms);
@@ -106,10 +139,8 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   stored_packet.send_time_ms = send_time_ms;
   stored_packet.storage_type = type;
   stored_packet.times_retransmitted = 0;
-
-  if (!start_seqno_) {
-    start_seqno_ = rtp_seq_no;
-  }
+  stored_packet.used_for_probing = false;
+  LinkPaddingCandidate(rtp_seq_no, &stored_packet);
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
@@ -121,13 +152,13 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   }
 
   int64_t now_ms = clock_->TimeInMilliseconds();
-  StoredPacketIterator rtp_it = packet_history_.find(sequence_number);
-  if (rtp_it == packet_history_.end()) {
+  StoredPacket* stored_packet = FindPacket(sequence_number);
+  if (!stored_packet) {
     return nullptr;
   }
 
-  StoredPacket& packet = rtp_it->second;
-  if (verify_rtt && !VerifyRtt(rtp_it->second, now_ms)) {
+  StoredPacket& packet = *stored_packet;
+  if (verify_rtt && !VerifyRtt(packet, now_ms)) {
     return nullptr;
   }
 
@@ -141,11 +172,28 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   if (packet.storage_type == StorageType::kDontRetransmit) {
     // Non retransmittable packet, so call must come from paced sender.
     // Remove from history and return actual packet instance.
-    return RemovePacket(rtp_it);
+    return RemovePacket(sequence_number);
   }
   return absl::make_unique<RtpPacketToSend>(*packet.packet);
 }
 
+std::unique_ptr<RtpPacketToSend> RtpPacketHistory::TakeUnsentPacket(
+    uint16_t sequence_number,
+    StorageType* storage_type) {
+  RTC_DCHECK(storage_type);
+  rtc::CritScope cs(&lock_);
+  if (mode_ == StorageMode::kDisabled) {
+    return nullptr;
+  }
+
+  StoredPacket* stored_packet = FindPacket(sequence_number);
+  if (!stored_packet || stored_packet->send_time_ms) {
+    return nullptr;
+  }
+  *storage_type = stored_packet->storage_type;
+  return RemovePacket(sequence_number);
+}
+
 absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
     uint16_t sequence_number,
     bool verify_rtt) const {
@@ -154,16 +202,16 @@ absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
     return absl::nullopt;
   }
 
-  auto rtp_it = packet_history_.find(sequence_number);
-  if (rtp_it == packet_history_.end()) {
+  const StoredPacket* stored_packet = FindPacket(sequence_number);
+  if (!stored_packet) {
     return absl::nullopt;
   }
 
-  if (verify_rtt && !VerifyRtt(rtp_it->second, clock_->TimeInMilliseconds())) {
+  if (verify_rtt && !VerifyRtt(*stored_packet, clock_->TimeInMilliseconds())) {
     return absl::nullopt;
   }
 
-  return StoredPacketToPacketState(rtp_it->second);
+  return StoredPacketToPacketState(*stored_packet);
 }
 
 bool RtpPacketHistory::VerifyRtt(const RtpPacketHistory::StoredPacket& packet,
@@ -186,46 +234,84 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetBestFittingPacket(
     size_t packet_length) const {
   // TODO(sprang): Make this smarter, taking retransmit count etc into account.
   rtc::CritScope cs(&lock_);
-  if (packet_length < kMinPacketRequestBytes || packet_history_.empty()) {
+  if (packet_length < kMinPacketRequestBytes || num_packets_ == 0) {
     return nullptr;
   }
 
-  size_t min_diff = std::numeric_limits<size_t>::max();
-  RtpPacketToSend* best_packet = nullptr;
-  for (auto& it : packet_history_) {
-    size_t diff = SizeDiff(it.second.packet, packet_length);
-    if (!min_diff || diff < min_diff) {
-      min_diff = diff;
-      best_packet = it.second.packet.get();
-      if (diff == 0) {
-        break;
-      }
+  // Only the nearest non-empty bucket on either side can hold the best fit.
+  const StoredPacket* best_packet = nullptr;
+  int below = ClosestBucketAtOrBelow(packet_length);
+  if (below >= 0) {
+    best_packet = BestPacketInBucket(below, packet_length);
+  }
+  int above = ClosestBucketAbove(packet_length);
+  if (above >= 0) {
+    const StoredPacket* candidate = BestPacketInBucket(above, packet_length);
+    if (!best_packet || SizeDiff(candidate->packet, packet_length) <
+                            SizeDiff(best_packet->packet, packet_length)) {
+      best_packet = candidate;
     }
   }
+  RTC_DCHECK(best_packet);
 
-  return absl::make_unique<RtpPacketToSend>(*best_packet);
+  return absl::make_unique<RtpPacketToSend>(*best_packet->packet);
+}
+
+std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketForProbing(
+    size_t packet_size) {
+  rtc::CritScope cs(&lock_);
+  if (packet_size < kMinPacketRequestBytes || num_packets_ == 0) {
+    return nullptr;
+  }
+
+  // Walk back from the newest packet. Packets are sent in sequence number
+  // order, apart from retransmissions, so the walk ends at the first packet
+  // sent too long ago.
+  const int64_t min_send_time_ms = clock_->TimeInMilliseconds() -
+                                   std::max(rtt_ms_, kMinProbingPacketAgeMs);
+  for (size_t i = span_; i > 0; --i) {
+    StoredPacket* stored_packet =
+        FindPacket(static_cast<uint16_t>(*start_seqno_ + i - 1));
+    if (!stored_packet || !stored_packet->send_time_ms) {
+      continue;
+    }
+    if (*stored_packet->send_time_ms < min_send_time_ms) {
+      break;
+    }
+    if (stored_packet->times_retransmitted > 0 ||
+        stored_packet->used_for_probing) {
+      continue;
+    }
+    stored_packet->used_for_probing = true;
+    return absl::make_unique<RtpPacketToSend>(*stored_packet->packet);
+  }
+  return nullptr;
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  buffer_.clear();
+  span_ = 0;
+  num_packets_ = 0;
   start_seqno_.reset();
+  std::fill(padding_buckets_.begin(), padding_buckets_.end(), -1);
+  std::fill(padding_bucket_mask_.begin(), padding_bucket_mask_.end(), 0);
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   int64_t packet_duration_ms =
       std::max(kMinPacketDurationRtt * rtt_ms_, kMinPacketDurationMs);
-  while (!packet_history_.empty()) {
-    auto stored_packet_it = packet_history_.find(*start_seqno_);
-    RTC_DCHECK(stored_packet_it != packet_history_.end());
+  while (num_packets_ > 0) {
+    const StoredPacket* oldest_packet = FindPacket(*start_seqno_);
+    RTC_DCHECK(oldest_packet);
 
-    if (packet_history_.size() >= kMaxCapacity) {
+    if (num_packets_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
-      RemovePacket(stored_packet_it);
+      RemovePacket(*start_seqno_);
       continue;
     }
 
-    const StoredPacket& stored_packet = stored_packet_it->second;
+    const StoredPacket& stored_packet = *oldest_packet;
     if (!stored_packet.send_time_ms) {
       // Don't remove packets that have not been sent.
       return;
@@ -236,14 +322,14 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (num_packets_ >= number_to_store_ ||
         (mode_ == StorageMode::kStoreAndCull &&
          *stored_packet.send_time_ms +
                  (packet_duration_ms * kPacketCullingDelayFactor) <=
              now_ms)) {
       // Too many packets in history, or this packet has timed out. Remove it
       // and continue.
-      RemovePacket(stored_packet_it);
+      RemovePacket(*start_seqno_);
     } else {
       // No more packets can be removed right now.
       return;
@@ -251,30 +337,190 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   }
 }
 
+RtpPacketHistory::StoredPacket* RtpPacketHistory::FindPacket(
+    uint16_t sequence_number) {
+  return const_cast<StoredPacket*>(
+      static_cast<const RtpPacketHistory*>(this)->FindPacket(sequence_number));
+}
+
+const RtpPacketHistory::StoredPacket* RtpPacketHistory::FindPacket(
+    uint16_t sequence_number) const {
+  if (!start_seqno_) {
+    return nullptr;
+  }
+  const uint16_t offset = sequence_number - *start_seqno_;
+  if (offset >= span_) {
+    return nullptr;
+  }
+  const StoredPacket& stored_packet =
+      buffer_[sequence_number & (buffer_.size() - 1)];
+  return stored_packet.packet ? &stored_packet : nullptr;
+}
+
+RtpPacketHistory::StoredPacket* RtpPacketHistory::AllocatePacket(
+    uint16_t sequence_number) {
+  uint16_t start_seqno = sequence_number;
+  size_t span = 1;
+  while (start_seqno_) {
+    const uint16_t forward = sequence_number - *start_seqno_;
+    const uint16_t backward = *start_seqno_ - sequence_number;
+    if (forward < kMaxSequenceSpan) {
+      start_seqno = *start_seqno_;
+      span = std::max<size_t>(span_, forward + 1);
+      break;
+    }
+    if (span_ + backward <= kMaxSequenceSpan) {
+      // Before the oldest packet.
+      span = span_ + backward;
+      break;
+    }
+    // Too far from the stored packets, most likely a sequence number jump.
+    // Drop the oldest packets until it fits.
+    RemovePacket(*start_seqno_);
+  }
+
+  // Grow while |span_| still describes the stored packets.
+  while (span > buffer_.size()) {
+    GrowBuffer();
+  }
+  start_seqno_ = start_seqno;
+  span_ = span;
+  StoredPacket* stored_packet =
+      &buffer_[sequence_number & (buffer_.size() - 1)];
+  RTC_DCHECK(!stored_packet->packet);
+  return stored_packet;
+}
+
+void RtpPacketHistory::GrowBuffer() {
+  std::vector<StoredPacket> buffer(
+      std::max(kMinBufferSize, 2 * buffer_.size()));
+  const size_t old_mask = buffer_.size() - 1;
+  const size_t new_mask = buffer.size() - 1;
+  for (size_t i = 0; i < span_; ++i) {
+    const uint16_t seq_no = *start_seqno_ + i;
+    buffer[seq_no & new_mask] = std::move(buffer_[seq_no & old_mask]);
+  }
+  buffer_.swap(buffer);
+}
+
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    StoredPacketIterator packet_it) {
+    uint16_t sequence_number) {
+  StoredPacket* stored_packet = FindPacket(sequence_number);
+  RTC_DCHECK(stored_packet);
+  UnlinkPaddingCandidate(stored_packet);
   // Move the packet out from the StoredPacket container.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_it->second.packet);
-  // Erase the packet from the map, and capture iterator to the next one.
-  StoredPacketIterator next_it = packet_history_.erase(packet_it);
+      std::move(stored_packet->packet);
+  *stored_packet = StoredPacket();
+  --num_packets_;
 
-  // |next_it| now points to the next element, or to the end. If the end,
-  // check if we can wrap around.
-  if (next_it == packet_history_.end()) {
-    next_it = packet_history_.begin();
+  if (num_packets_ == 0) {
+    span_ = 0;
+    start_seqno_.reset();
+    return rtp_packet;
   }
 
-  // Update |start_seq_no| to the new oldest item.
-  if (next_it != packet_history_.end()) {
-    start_seqno_ = next_it->first;
+  // Skip over gaps so the range always starts and ends with a stored packet.
+  // Each slot is skipped at most once before being reused, so this is O(1)
+  // amortized.
+  const size_t mask = buffer_.size() - 1;
+  if (sequence_number == *start_seqno_) {
+    do {
+      ++*start_seqno_;
+      --span_;
+    } while (!buffer_[*start_seqno_ & mask].packet);
   } else {
-    start_seqno_.reset();
+    while (!buffer_[static_cast<uint16_t>(*start_seqno_ + span_ - 1) & mask]
+                .packet) {
+      --span_;
+    }
   }
 
   return rtp_packet;
 }
 
+void RtpPacketHistory::LinkPaddingCandidate(uint16_t sequence_number,
+                                            StoredPacket* packet) {
+  const int bucket = PaddingBucket(packet->packet->size());
+  int32_t& head = padding_buckets_[bucket];
+  packet->prev_same_size = -1;
+  packet->next_same_size = head;
+  if (head >= 0) {
+    FindPacket(static_cast<uint16_t>(head))->prev_same_size = sequence_number;
+  }
+  head = sequence_number;
+  padding_bucket_mask_[bucket / 64] |= uint64_t{1} << (bucket % 64);
+}
+
+void RtpPacketHistory::UnlinkPaddingCandidate(StoredPacket* packet) {
+  const int bucket = PaddingBucket(packet->packet->size());
+  if (packet->prev_same_size >= 0) {
+    FindPacket(static_cast<uint16_t>(packet->prev_same_size))->next_same_size =
+        packet->next_same_size;
+  } else {
+    padding_buckets_[bucket] = packet->next_same_size;
+  }
+  if (packet->next_same_size >= 0) {
+    FindPacket(static_cast<uint16_t>(packet->next_same_size))->prev_same_size =
+        packet->prev_same_size;
+  }
+  if (padding_buckets_[bucket] < 0) {
+    padding_bucket_mask_[bucket / 64] &= ~(uint64_t{1} << (bucket % 64));
+  }
+}
+
+int RtpPacketHistory::ClosestBucketAtOrBelow(size_t size) const {
+  for (int bucket = PaddingBucket(size); bucket >= 0; --bucket) {
+    const uint64_t word = padding_bucket_mask_[bucket / 64];
+    if (word == 0) {
+      // Skip to the top of the previous word.
+      bucket -= bucket % 64;
+      continue;
+    }
+    if (word & (uint64_t{1} << (bucket % 64))) {
+      return bucket;
+    }
+  }
+  return -1;
+}
+
+int RtpPacketHistory::ClosestBucketAbove(size_t size) const {
+  const int num_buckets = static_cast<int>(kNumPaddingBuckets);
+  for (int bucket = PaddingBucket(size) + 1; bucket < num_buckets; ++bucket) {
+    const uint64_t word = padding_bucket_mask_[bucket / 64];
+    if (word == 0) {
+      // Skip to the bottom of the next word.
+      bucket += 63 - bucket % 64;
+      continue;
+    }
+    if (word & (uint64_t{1} << (bucket % 64))) {
+      return bucket;
+    }
+  }
+  return -1;
+}
+
+const RtpPacketHistory::StoredPacket* RtpPacketHistory::BestPacketInBucket(
+    int bucket,
+    size_t packet_length) const {
+  const StoredPacket* best_packet =
+      FindPacket(static_cast<uint16_t>(padding_buckets_[bucket]));
+  RTC_DCHECK(best_packet);
+  if (bucket < static_cast<int>(kNumPaddingBuckets) - 1) {
+    // All packets in the bucket have the same size.
+    return best_packet;
+  }
+  // The last bucket holds packets of any larger size; these are rare.
+  for (const StoredPacket* packet = best_packet; packet->next_same_size >= 0;) {
+    packet = FindPacket(static_cast<uint16_t>(packet->next_same_size));
+    if (SizeDiff(packet->packet, packet_length) <
+        SizeDiff(best_packet->packet, packet_length)) {
+      best_packet = packet;
+    }
+  }
+  return best_packet;
+}
+
 RtpPacketHistory::PacketState RtpPacketHistory::StoredPacketToPacketState(
     const RtpPacketHistory::StoredPacket& stored_packet) {
   RtpPacketHistory::PacketState state;
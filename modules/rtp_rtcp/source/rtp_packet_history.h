@@ -11,7 +11,6 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <map>
 #include <memory>
 #include <vector>
 
@@ -82,6 +81,16 @@ class RtpPacketHistory {
       uint16_t sequence_number,
       bool verify_rtt);
 
+  // Removes a packet that hasn't been sent yet from the history and returns
+  // it, setting |storage_type| to how it was stored. GetPacketAndSetSendTime()
+  // returns a copy that shares its buffer with the stored packet, so updating
+  // the header for sending copies the whole packet; this instead hands out
+  // the only reference. Packets stored with kAllowRetransmission should be
+  // put back with PutRtpPacket() once sent. Returns nullptr if the packet
+  // isn't found or has already been sent.
+  std::unique_ptr<RtpPacketToSend> TakeUnsentPacket(uint16_t sequence_number,
+                                                    StorageType* storage_type);
+
   // Similar to GetPacketAndSetSendTime(), but only returns a snapshot of the
   // current state for packet, and never updates internal state.
   absl::optional<PacketState> GetPacketState(uint16_t sequence_number,
@@ -92,6 +101,14 @@ class RtpPacketHistory {
   std::unique_ptr<RtpPacketToSend> GetBestFittingPacket(
       size_t packet_size) const;
 
+  // Gets the most recently sent packet that was sent within the last RTT, so
+  // that the sender can't know yet whether it was lost, and hasn't been
+  // retransmitted or returned by this method before. Meant for bandwidth
+  // probes, which then carry media the receiver may be missing instead of
+  // padding. Returns nullptr if there is no such packet, or if |packet_size|
+  // is too small to be worth sending a packet for.
+  std::unique_ptr<RtpPacketToSend> GetPacketForProbing(size_t packet_size);
+
  private:
   struct StoredPacket {
     StoredPacket();
@@ -105,15 +122,21 @@ class RtpPacketHistory {
     // Number of times RE-transmitted, ie excluding the first transmission.
     size_t times_retransmitted = 0;
 
+    // True if returned by GetPacketForProbing().
+    bool used_for_probing = false;
+
     // Storing a packet with |storage_type| = kDontRetransmit indicates this is
     // only used as temporary storage until sent by the pacer sender.
     StorageType storage_type = kDontRetransmit;
 
     // The actual packet.
     std::unique_ptr<RtpPacketToSend> packet;
-  };
 
-  using StoredPacketIterator = std::map<uint16_t, StoredPacket>::iterator;
+    // Sequence numbers of the neighbours in the list of stored packets with
+    // the same padding size bucket, or -1 at either end of that list.
+    int32_t prev_same_size = -1;
+    int32_t next_same_size = -1;
+  };
 
   // Helper method used by GetPacketAndSetSendTime() and GetPacketState() to
   // check if packet has too recently been sent.
@@ -121,9 +144,34 @@ class RtpPacketHistory {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the stored packet with the given sequence number, or null.
+  StoredPacket* FindPacket(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket* FindPacket(uint16_t sequence_number) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns an empty slot for |sequence_number|, extending the stored range
+  // (and the buffer, if needed).
+  StoredPacket* AllocatePacket(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Doubles the size of |buffer_|, keeping the stored packets.
+  void GrowBuffer() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
   // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(StoredPacketIterator packet)
+  std::unique_ptr<RtpPacketToSend> RemovePacket(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Adds the stored packet to, or removes it from, its padding size bucket.
+  void LinkPaddingCandidate(uint16_t sequence_number, StoredPacket* packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void UnlinkPaddingCandidate(StoredPacket* packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the non-empty padding size bucket closest to |size| on the given
+  // side (inclusive below, exclusive above), or -1 if there is none.
+  int ClosestBucketAtOrBelow(size_t size) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  int ClosestBucketAbove(size_t size) const RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the packet in |bucket| with size closest to |packet_length|.
+  const StoredPacket* BestPacketInBucket(int bucket,
+                                         size_t packet_length) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   static PacketState StoredPacketToPacketState(
       const StoredPacket& stored_packet);
@@ -134,13 +182,25 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   int64_t rtt_ms_ RTC_GUARDED_BY(lock_);
 
-  // Map from rtp sequence numbers to stored packet.
-  std::map<uint16_t, StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Circular buffer of stored packets, indexed by rtp sequence number modulo
+  // its size. The size is a power of two, so the mapping is consistent across
+  // sequence number wraparound. Slots in the range [start_seqno_,
+  // start_seqno_ + span_) without a packet are gaps in the sequence.
+  std::vector<StoredPacket> buffer_ RTC_GUARDED_BY(lock_);
+  size_t span_ RTC_GUARDED_BY(lock_);
+  size_t num_packets_ RTC_GUARDED_BY(lock_);
 
   // The earliest packet in the history. This might not be the lowest sequence
   // number, in case there is a wraparound.
   absl::optional<uint16_t> start_seqno_ RTC_GUARDED_BY(lock_);
 
+  // Stored packets bucketed by size, for GetBestFittingPacket(). Each entry is
+  // the sequence number heading a list of packets of that size, or -1. The
+  // last bucket holds all packets of that size or larger.
+  std::vector<int32_t> padding_buckets_ RTC_GUARDED_BY(lock_);
+  // Bit i is set if padding bucket i is non-empty.
+  std::vector<uint64_t> padding_bucket_mask_ RTC_GUARDED_BY(lock_);
+
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
 }  // namespace webrtc
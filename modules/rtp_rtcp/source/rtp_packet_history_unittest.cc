@@ -15,6 +15,7 @@
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/arraysize.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gtest.h"
 
@@ -170,6 +171,38 @@ TEST_F(RtpPacketHistoryTest, DontRetransmit) {
   EXPECT_FALSE(hist_.GetPacketAndSetSendTime(kStartSeqNum, false));
 }
 
+TEST_F(RtpPacketHistoryTest, TakesOnlyUnsentPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), kAllowRetransmission,
+                     absl::nullopt);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 1)),
+                     kAllowRetransmission, fake_clock_.TimeInMilliseconds());
+
+  StorageType storage_type = kDontRetransmit;
+  std::unique_ptr<RtpPacketToSend> packet =
+      hist_.TakeUnsentPacket(kStartSeqNum, &storage_type);
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(kAllowRetransmission, storage_type);
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum, false));
+  // Already sent.
+  EXPECT_FALSE(
+      hist_.TakeUnsentPacket(To16u(kStartSeqNum + 1), &storage_type));
+
+  // The history doesn't hold on to the buffer while the packet is taken, so
+  // writing to it doesn't reallocate.
+  const uint8_t* data = packet->data();
+  packet->SetTimestamp(17);
+  EXPECT_EQ(data, packet->data());
+
+  hist_.PutRtpPacket(std::move(packet), storage_type,
+                     fake_clock_.TimeInMilliseconds());
+  absl::optional<RtpPacketHistory::PacketState> state =
+      hist_.GetPacketState(kStartSeqNum, false);
+  ASSERT_TRUE(state);
+  EXPECT_TRUE(state->send_time_ms);
+  EXPECT_EQ(0u, state->times_retransmitted);
+}
+
 TEST_F(RtpPacketHistoryTest, PacketStateIsCorrect) {
   const uint32_t kSsrc = 92384762;
   hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
@@ -488,4 +521,134 @@ TEST_F(RtpPacketHistoryTest, GetBestFittingPacket) {
   EXPECT_EQ(target_packet_size,
             hist_.GetBestFittingPacket(target_packet_size)->size());
 }
+
+TEST_F(RtpPacketHistoryTest, GetBestFittingPacketPicksClosestSize) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 100);
+  const size_t header_size = CreateRtpPacket(0)->size();
+  const size_t kPayloadSizes[] = {100, 300, 700, 1100, 2000, 3000};
+  for (size_t i = 0; i < 60; ++i) {
+    // Large enough for the biggest payload.
+    std::unique_ptr<RtpPacketToSend> packet(
+        new RtpPacketToSend(nullptr, 4000));
+    packet->SetSequenceNumber(To16u(kStartSeqNum + i));
+    packet->SetPayloadSize(kPayloadSizes[i % arraysize(kPayloadSizes)]);
+    hist_.PutRtpPacket(std::move(packet), kAllowRetransmission,
+                       fake_clock_.TimeInMilliseconds());
+  }
+
+  EXPECT_EQ(header_size + 300,
+            hist_.GetBestFittingPacket(header_size + 350)->size());
+  EXPECT_EQ(header_size + 700,
+            hist_.GetBestFittingPacket(header_size + 550)->size());
+  EXPECT_EQ(header_size + 1100,
+            hist_.GetBestFittingPacket(header_size + 1400)->size());
+  EXPECT_EQ(header_size + 2000,
+            hist_.GetBestFittingPacket(header_size + 1600)->size());
+  EXPECT_EQ(header_size + 3000,
+            hist_.GetBestFittingPacket(header_size + 2900)->size());
+  EXPECT_EQ(header_size + 100, hist_.GetBestFittingPacket(60)->size());
+}
+
+TEST_F(RtpPacketHistoryTest, GetBestFittingPacketSkipsRemovedPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  const size_t header_size = CreateRtpPacket(0)->size();
+  std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
+  packet->SetPayloadSize(500);
+  hist_.PutRtpPacket(std::move(packet), kDontRetransmit, absl::nullopt);
+  packet = CreateRtpPacket(kStartSeqNum + 1);
+  packet->SetPayloadSize(200);
+  hist_.PutRtpPacket(std::move(packet), kAllowRetransmission, absl::nullopt);
+
+  EXPECT_EQ(header_size + 500,
+            hist_.GetBestFittingPacket(header_size + 500)->size());
+  // Sent by the pacer, which removes non-retransmittable packets.
+  EXPECT_TRUE(hist_.GetPacketAndSetSendTime(kStartSeqNum, false));
+  EXPECT_EQ(header_size + 200,
+            hist_.GetBestFittingPacket(header_size + 500)->size());
+}
+
+TEST_F(RtpPacketHistoryTest, GetPacketForProbingReturnsRecentPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  hist_.SetRtt(50);
+  // Sent more than 100 ms, the minimum RTT used, before the probe.
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), kAllowRetransmission,
+                     fake_clock_.TimeInMilliseconds());
+  fake_clock_.AdvanceTimeMilliseconds(150);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum + 1), kAllowRetransmission,
+                     fake_clock_.TimeInMilliseconds());
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 2)),
+                     kAllowRetransmission, fake_clock_.TimeInMilliseconds());
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 3)),
+                     kAllowRetransmission, fake_clock_.TimeInMilliseconds());
+  // Not sent yet.
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 4)),
+                     kAllowRetransmission, absl::nullopt);
+  // Already retransmitted.
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  EXPECT_TRUE(hist_.GetPacketAndSetSendTime(To16u(kStartSeqNum + 2), false));
+
+  EXPECT_FALSE(hist_.GetPacketForProbing(10));
+  std::unique_ptr<RtpPacketToSend> packet = hist_.GetPacketForProbing(1000);
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(To16u(kStartSeqNum + 3), packet->SequenceNumber());
+  packet = hist_.GetPacketForProbing(1000);
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(kStartSeqNum + 1, packet->SequenceNumber());
+  EXPECT_FALSE(hist_.GetPacketForProbing(1000));
+}
+
+TEST_F(RtpPacketHistoryTest, StoresMorePacketsThanRequestedWhileUnsent) {
+  const size_t kMaxNumPackets = 10;
+  hist_.SetStorePacketsStatus(StorageMode::kStore, kMaxNumPackets);
+
+  // Unsent packets are never culled, so the history has to grow beyond the
+  // requested size, across a sequence number wraparound.
+  for (size_t i = 0; i < 10 * kMaxNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       kAllowRetransmission, absl::nullopt);
+  }
+  for (size_t i = 0; i < 10 * kMaxNumPackets; ++i) {
+    absl::optional<RtpPacketHistory::PacketState> state =
+        hist_.GetPacketState(To16u(kStartSeqNum + i), false);
+    ASSERT_TRUE(state);
+    EXPECT_EQ(To16u(kStartSeqNum + i), state->rtp_sequence_number);
+  }
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 1), false));
+  EXPECT_FALSE(
+      hist_.GetPacketState(To16u(kStartSeqNum + 10 * kMaxNumPackets), false));
+}
+
+TEST_F(RtpPacketHistoryTest, HandlesGapsAndOutOfOrderPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 5)),
+                     kAllowRetransmission, absl::nullopt);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 40)),
+                     kAllowRetransmission, absl::nullopt);
+  // Before the oldest stored packet.
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), kAllowRetransmission,
+                     absl::nullopt);
+
+  EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum, false));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 5), false));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 40), false));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 1), false));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 39), false));
+}
+
+TEST_F(RtpPacketHistoryTest, DropsOldPacketsOnSequenceNumberJump) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), kAllowRetransmission,
+                     absl::nullopt);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 1)),
+                     kAllowRetransmission, absl::nullopt);
+  // More than half the sequence number space ahead of the first packet, and
+  // exactly half of it ahead of the second.
+  const uint16_t kJumpedSeqNum = To16u(kStartSeqNum + 0x8001);
+  hist_.PutRtpPacket(CreateRtpPacket(kJumpedSeqNum), kAllowRetransmission,
+                     absl::nullopt);
+
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum, false));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 1), false));
+  EXPECT_TRUE(hist_.GetPacketState(kJumpedSeqNum, false));
+}
 }  // namespace webrtc
@@ -18,6 +18,7 @@
 
 namespace webrtc {
 namespace {
+using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::IsEmpty;
 using ::testing::make_tuple;
@@ -382,6 +383,35 @@ TEST(RtpPacketTest, ParseWithAllFeatures) {
   EXPECT_TRUE(packet.GetExtension<TransmissionOffset>(&time_offset));
 }
 
+TEST(RtpPacketTest, PrependToAndRemoveFromPayload) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register(kRtpExtensionTransmissionTimeOffset,
+                      kTransmissionOffsetExtensionId);
+  RtpPacketReceived packet(&extensions);
+  ASSERT_TRUE(packet.Parse(kPacket, sizeof(kPacket)));
+
+  // Shares the buffer with |packet|, which must not change.
+  RtpPacketReceived copy(packet);
+  uint8_t* prefix = copy.PrependToPayload(2);
+  ASSERT_TRUE(prefix);
+  prefix[0] = 'x';
+  prefix[1] = 'y';
+  EXPECT_THAT(kPacket, ElementsAreArray(packet.data(), packet.size()));
+  EXPECT_THAT(copy.payload(),
+              ElementsAre('x', 'y', 'p', 'a', 'y', 'l', 'o', 'a', 'd'));
+  EXPECT_EQ(kPacketPaddingSize, copy.padding_size());
+  EXPECT_EQ(sizeof(kPacket) + 2, copy.size());
+  int32_t time_offset;
+  EXPECT_TRUE(copy.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(kTimeOffset, time_offset);
+
+  // Now the buffer is no longer shared and is changed in place.
+  EXPECT_FALSE(copy.RemovePayloadPrefix(copy.payload_size() + 1));
+  EXPECT_TRUE(copy.RemovePayloadPrefix(2));
+  EXPECT_THAT(kPacket, ElementsAreArray(copy.data(), copy.size()));
+  EXPECT_THAT(copy.payload(), ElementsAreArray(kPayload));
+}
+
 TEST(RtpPacketTest, ParseWithExtensionDelayed) {
   RtpPacketReceived packet;
   EXPECT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
@@ -403,6 +433,43 @@ TEST(RtpPacketTest, ParseWithExtensionDelayed) {
   EXPECT_EQ(0u, packet.padding_size());
 }
 
+TEST(RtpPacketTest, ParseWithExtensionReidentified) {
+  RtpPacketToSend::ExtensionManager other_extensions;
+  other_extensions.Register(kRtpExtensionTransmissionTimeOffset,
+                            kTransmissionOffsetExtensionId + 1);
+  other_extensions.Register(kRtpExtensionAudioLevel,
+                            kTransmissionOffsetExtensionId);
+  RtpPacketReceived packet(&other_extensions);
+  EXPECT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
+  EXPECT_FALSE(packet.HasExtension<TransmissionOffset>());
+
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register(kRtpExtensionTransmissionTimeOffset,
+                      kTransmissionOffsetExtensionId);
+  packet.IdentifyExtensions(extensions);
+  int32_t time_offset;
+  EXPECT_TRUE(packet.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(kTimeOffset, time_offset);
+  EXPECT_FALSE(packet.HasExtension<AudioLevel>());
+}
+
+TEST(RtpPacketTest, CopyHeaderKeepsExtensions) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register(kRtpExtensionTransmissionTimeOffset,
+                      kTransmissionOffsetExtensionId);
+  RtpPacketToSend packet(&extensions);
+  packet.SetExtension<TransmissionOffset>(kTimeOffset);
+
+  RtpPacketToSend copy(nullptr);
+  copy.CopyHeaderFrom(packet);
+  int32_t time_offset;
+  EXPECT_TRUE(copy.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(kTimeOffset, time_offset);
+  EXPECT_TRUE(copy.SetExtension<TransmissionOffset>(kTimeOffset + 1));
+  EXPECT_TRUE(copy.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(kTimeOffset + 1, time_offset);
+}
+
 TEST(RtpPacketTest, ParseDynamicSizeExtension) {
   // clang-format off
   const uint8_t kPacket1[] = {
@@ -570,7 +570,8 @@ int32_t ModuleRtpRtcpImpl::DataCountersRTP(size_t* bytes_sent,
                                            uint32_t* packets_sent) const {
   StreamDataCounters rtp_stats;
   StreamDataCounters rtx_stats;
-  rtp_sender_->GetDataCounters(&rtp_stats, &rtx_stats);
+  if (rtp_sender_)
+    rtp_sender_->GetDataCounters(&rtp_stats, &rtx_stats);
 
   if (bytes_sent) {
     *bytes_sent = rtp_stats.transmitted.payload_bytes +
@@ -746,11 +747,13 @@ bool ModuleRtpRtcpImpl::TimeToSendFullNackList(int64_t now) const {
 // Store the sent packets, needed to answer to Negative acknowledgment requests.
 void ModuleRtpRtcpImpl::SetStorePacketsStatus(const bool enable,
                                               const uint16_t number_to_store) {
-  rtp_sender_->SetStorePacketsStatus(enable, number_to_store);
+  // A receiver-only module has no packets to store.
+  if (rtp_sender_)
+    rtp_sender_->SetStorePacketsStatus(enable, number_to_store);
 }
 
 bool ModuleRtpRtcpImpl::StorePackets() const {
-  return rtp_sender_->StorePackets();
+  return rtp_sender_ ? rtp_sender_->StorePackets() : false;
 }
 
 void ModuleRtpRtcpImpl::RegisterRtcpStatisticsCallback(
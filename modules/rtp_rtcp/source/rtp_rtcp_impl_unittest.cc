@@ -21,6 +21,7 @@
 #include "rtc_base/rate_limiter.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/mock_transport.h"
 #include "test/rtcp_packet_parser.h"
 
 using ::testing::_;
@@ -390,6 +391,32 @@ TEST_F(RtpRtcpImplTest, RttForReceiverOnly) {
   EXPECT_NEAR(2 * kOneWayNetworkDelayMs, receiver_.impl_->rtt_ms(), 1);
 }
 
+TEST(RtpRtcpImplReceiverOnlyTest, HasNoSendSideState) {
+  SimulatedClock clock(133590000000000);
+  MockTransport transport;
+  RtpRtcp::Configuration config;
+  config.audio = true;
+  config.receiver_only = true;
+  config.clock = &clock;
+  config.outgoing_transport = &transport;
+  ModuleRtpRtcpImpl impl(config);
+  impl.SetRTCPStatus(RtcpMode::kCompound);
+  impl.SetSSRC(kReceiverSsrc);
+  impl.SetRemoteSSRC(kSenderSsrc);
+
+  impl.SetStorePacketsStatus(true, 100);
+  EXPECT_FALSE(impl.StorePackets());
+  size_t bytes_sent = 1;
+  uint32_t packets_sent = 1;
+  EXPECT_EQ(0, impl.DataCountersRTP(&bytes_sent, &packets_sent));
+  EXPECT_EQ(0u, bytes_sent);
+  EXPECT_EQ(0u, packets_sent);
+
+  // Receiver reports are still sent.
+  EXPECT_CALL(transport, SendRtcp(_, _)).WillOnce(Return(true));
+  EXPECT_EQ(0, impl.SendRTCP(kRtcpReport));
+}
+
 TEST_F(RtpRtcpImplTest, NoSrBeforeMedia) {
   // Ignore fake transport delays in this test.
   sender_.transport_.SimulateNetworkDelay(0, &clock_);
@@ -46,6 +46,8 @@ constexpr size_t kRtpHeaderLength = 12;
 constexpr uint16_t kMaxInitRtpSeqNumber = 32767;  // 2^15 -1.
 constexpr uint32_t kTimestampTicksPerMs = 90;
 constexpr int kBitrateStatisticsWindowMs = 1000;
+// Kept for every sender, so use 10 ms buckets rather than 1 ms ones.
+constexpr int kBitrateStatisticsBucketMs = 10;
 
 constexpr size_t kMinFlexfecPacketsToStoreForPacing = 50;
 
@@ -138,8 +140,11 @@ RTPSender::RTPSender(
       // Statistics
       rtp_stats_callback_(nullptr),
       total_bitrate_sent_(kBitrateStatisticsWindowMs,
-                          RateStatistics::kBpsScale),
-      nack_bitrate_sent_(kBitrateStatisticsWindowMs, RateStatistics::kBpsScale),
+                          RateStatistics::kBpsScale,
+                          kBitrateStatisticsBucketMs),
+      nack_bitrate_sent_(kBitrateStatisticsWindowMs,
+                         RateStatistics::kBpsScale,
+                         kBitrateStatisticsBucketMs),
       frame_count_observer_(frame_count_observer),
       send_side_delay_observer_(send_side_delay_observer),
       event_log_(event_log),
@@ -160,7 +165,9 @@ RTPSender::RTPSender(
       overhead_observer_(overhead_observer),
       populate_network2_timestamp_(populate_network2_timestamp),
       send_side_bwe_with_overhead_(
-          webrtc::field_trial::IsEnabled("WebRTC-SendSideBwe-WithOverhead")) {
+          webrtc::field_trial::IsEnabled("WebRTC-SendSideBwe-WithOverhead")),
+      probe_with_recent_packets_(
+          webrtc::field_trial::IsEnabled("WebRTC-ProbeWithRecentPackets")) {
   // This random initialization is not intended to be cryptographic strong.
   timestamp_offset_ = random_.Rand<uint32_t>();
   // Random start, 16 bits. Can't be 0.
@@ -474,7 +481,8 @@ bool RTPSender::SendOutgoingData(FrameType frame_type,
 }
 
 size_t RTPSender::TrySendRedundantPayloads(size_t bytes_to_send,
-                                           const PacedPacketInfo& pacing_info) {
+                                           const PacedPacketInfo& pacing_info,
+                                           bool recent_packets_only) {
   {
     rtc::CritScope lock(&send_critsect_);
     if (!sending_media_)
@@ -486,11 +494,13 @@ size_t RTPSender::TrySendRedundantPayloads(size_t bytes_to_send,
   int bytes_left = static_cast<int>(bytes_to_send);
   while (bytes_left > 0) {
     std::unique_ptr<RtpPacketToSend> packet =
-        packet_history_.GetBestFittingPacket(bytes_left);
+        recent_packets_only
+            ? packet_history_.GetPacketForProbing(bytes_left)
+            : packet_history_.GetBestFittingPacket(bytes_left);
     if (!packet)
       break;
     size_t payload_size = packet->payload_size();
-    if (!PrepareAndSendPacket(std::move(packet), true, false, pacing_info))
+    if (!PrepareAndSendPacket(packet.get(), true, false, pacing_info))
       break;
     bytes_left -= payload_size;
   }
@@ -671,7 +681,7 @@ int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
   }
 
   const bool rtx = (RtxStatus() & kRtxRetransmitted) > 0;
-  if (!PrepareAndSendPacket(std::move(packet), rtx, true, PacedPacketInfo()))
+  if (!PrepareAndSendPacket(packet.get(), rtx, true, PacedPacketInfo()))
     return -1;
 
   return packet_size;
@@ -741,42 +751,57 @@ bool RTPSender::TimeToSendPacket(uint32_t ssrc,
   if (!SendingMedia())
     return true;
 
-  std::unique_ptr<RtpPacketToSend> packet;
-  // No need to verify RTT here, it has already been checked before putting the
-  // packet into the pacer. But _do_ update the send time.
+  RtpPacketHistory* history = nullptr;
   if (ssrc == SSRC()) {
-    packet = packet_history_.GetPacketAndSetSendTime(sequence_number, false);
+    history = &packet_history_;
   } else if (ssrc == FlexfecSsrc()) {
-    packet =
-        flexfec_packet_history_.GetPacketAndSetSendTime(sequence_number, false);
+    history = &flexfec_packet_history_;
+  } else {
+    return true;
   }
 
+  if (!retransmission) {
+    // Take the packet out of the history while it's sent for the first time,
+    // so that updating its header doesn't copy it, and put it back afterwards
+    // if it may be retransmitted.
+    StorageType storage_type;
+    std::unique_ptr<RtpPacketToSend> packet =
+        history->TakeUnsentPacket(sequence_number, &storage_type);
+    if (packet) {
+      const bool sent =
+          PrepareAndSendPacket(packet.get(), false, false, pacing_info);
+      if (storage_type == kAllowRetransmission) {
+        history->PutRtpPacket(std::move(packet), storage_type,
+                              clock_->TimeInMilliseconds());
+      }
+      return sent;
+    }
+  }
+
+  // No need to verify RTT here, it has already been checked before putting the
+  // packet into the pacer. But _do_ update the send time.
+  std::unique_ptr<RtpPacketToSend> packet =
+      history->GetPacketAndSetSendTime(sequence_number, false);
   if (!packet) {
     // Packet cannot be found.
     return true;
   }
 
   return PrepareAndSendPacket(
-      std::move(packet),
-      retransmission && (RtxStatus() & kRtxRetransmitted) > 0, retransmission,
-      pacing_info);
+      packet.get(), retransmission && (RtxStatus() & kRtxRetransmitted) > 0,
+      retransmission, pacing_info);
 }
 
-bool RTPSender::PrepareAndSendPacket(std::unique_ptr<RtpPacketToSend> packet,
+bool RTPSender::PrepareAndSendPacket(RtpPacketToSend* packet,
                                      bool send_over_rtx,
                                      bool is_retransmit,
                                      const PacedPacketInfo& pacing_info) {
   RTC_DCHECK(packet);
   int64_t capture_time_ms = packet->capture_time_ms();
-  RtpPacketToSend* packet_to_send = packet.get();
+  RtpPacketToSend* packet_to_send = packet;
 
-  std::unique_ptr<RtpPacketToSend> packet_rtx;
-  if (send_over_rtx) {
-    packet_rtx = BuildRtxPacket(*packet);
-    if (!packet_rtx)
-      return false;
-    packet_to_send = packet_rtx.get();
-  }
+  if (send_over_rtx && !ConvertToRtxPacket(packet_to_send))
+    return false;
 
   // Bug webrtc:7859. While FEC is invoked from rtp_sender_video, and not after
   // the pacer, these modifications of the header below are happening after the
@@ -876,7 +901,17 @@ size_t RTPSender::TimeToSendPadding(size_t bytes,
                                     const PacedPacketInfo& pacing_info) {
   if (bytes == 0)
     return 0;
-  size_t bytes_sent = TrySendRedundantPayloads(bytes, pacing_info);
+  size_t bytes_sent = 0;
+  // The probe is measured from the transport feedback of whatever is sent
+  // with |pacing_info|, so it may as well protect recent media.
+  if (probe_with_recent_packets_ &&
+      pacing_info.probe_cluster_id != PacedPacketInfo::kNotAProbe) {
+    bytes_sent = TrySendRedundantPayloads(bytes, pacing_info, true);
+  }
+  if (bytes_sent < bytes) {
+    bytes_sent +=
+        TrySendRedundantPayloads(bytes - bytes_sent, pacing_info, false);
+  }
   if (bytes_sent < bytes)
     bytes_sent += SendPadData(bytes - bytes_sent, pacing_info);
   return bytes_sent;
@@ -1211,54 +1246,39 @@ bool RTPSender::SetFecParameters(const FecProtectionParams& delta_params,
   return true;
 }
 
-std::unique_ptr<RtpPacketToSend> RTPSender::BuildRtxPacket(
-    const RtpPacketToSend& packet) {
-  // TODO(danilchap): Create rtx packet with extra capacity for SRTP
-  // when transport interface would be updated to take buffer class.
-  std::unique_ptr<RtpPacketToSend> rtx_packet(new RtpPacketToSend(
-      &rtp_header_extension_map_, packet.size() + kRtxHeaderSize));
-  // Add original RTP header.
-  rtx_packet->CopyHeaderFrom(packet);
+bool RTPSender::ConvertToRtxPacket(RtpPacketToSend* packet) {
+  uint8_t rtx_payload_type;
+  uint16_t rtx_sequence_number;
+  uint32_t rtx_ssrc;
   {
     rtc::CritScope lock(&send_critsect_);
     if (!sending_media_)
-      return nullptr;
+      return false;
 
     RTC_DCHECK(ssrc_rtx_);
 
-    // Replace payload type.
-    auto kv = rtx_payload_type_map_.find(packet.PayloadType());
+    auto kv = rtx_payload_type_map_.find(packet->PayloadType());
     if (kv == rtx_payload_type_map_.end())
-      return nullptr;
-    rtx_packet->SetPayloadType(kv->second);
-
-    // Replace sequence number.
-    rtx_packet->SetSequenceNumber(sequence_number_rtx_++);
-
-    // Replace SSRC.
-    rtx_packet->SetSsrc(*ssrc_rtx_);
-
-    // Possibly include the MID header extension.
-    if (!mid_.empty()) {
-      // This is a no-op if the MID header extension is not registered.
-      rtx_packet->SetExtension<RtpMid>(mid_);
-    }
+      return false;
+    rtx_payload_type = kv->second;
+    rtx_sequence_number = sequence_number_rtx_++;
+    rtx_ssrc = *ssrc_rtx_;
   }
-
-  uint8_t* rtx_payload =
-      rtx_packet->AllocatePayload(packet.payload_size() + kRtxHeaderSize);
-  RTC_DCHECK(rtx_payload);
-  // Add OSN (original sequence number).
-  ByteWriter<uint16_t>::WriteBigEndian(rtx_payload, packet.SequenceNumber());
-
-  // Add original payload data.
-  auto payload = packet.payload();
-  memcpy(rtx_payload + kRtxHeaderSize, payload.data(), payload.size());
-
-  // Add original application data.
-  rtx_packet->set_application_data(packet.application_data());
-
-  return rtx_packet;
+  const uint16_t media_sequence_number = packet->SequenceNumber();
+
+  // Add OSN (original sequence number) first. The packet usually shares its
+  // buffer with the packet history, and this makes the one copy needed, with
+  // room for the OSN, so that the writes below don't copy again.
+  uint8_t* rtx_header = packet->PrependToPayload(kRtxHeaderSize);
+  RTC_DCHECK(rtx_header);
+  ByteWriter<uint16_t>::WriteBigEndian(rtx_header, media_sequence_number);
+
+  packet->SetPayloadType(rtx_payload_type);
+  packet->SetSequenceNumber(rtx_sequence_number);
+  packet->SetSsrc(rtx_ssrc);
+  // The MID header extension, if any, comes with the media packet, which
+  // AllocatePacket() gave it.
+  return true;
 }
 
 void RTPSender::RegisterRtpStatisticsCallback(
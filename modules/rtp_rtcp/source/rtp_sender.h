@@ -222,18 +222,22 @@ class RTPSender {
 
   size_t SendPadData(size_t bytes, const PacedPacketInfo& pacing_info);
 
-  bool PrepareAndSendPacket(std::unique_ptr<RtpPacketToSend> packet,
+  bool PrepareAndSendPacket(RtpPacketToSend* packet,
                             bool send_over_rtx,
                             bool is_retransmit,
                             const PacedPacketInfo& pacing_info);
 
   // Return the number of bytes sent.  Note that both of these functions may
-  // return a larger value that their argument.
+  // return a larger value that their argument. With |recent_packets_only|,
+  // only packets the receiver may still be missing are sent, see
+  // RtpPacketHistory::GetPacketForProbing().
   size_t TrySendRedundantPayloads(size_t bytes,
-                                  const PacedPacketInfo& pacing_info);
+                                  const PacedPacketInfo& pacing_info,
+                                  bool recent_packets_only);
 
-  std::unique_ptr<RtpPacketToSend> BuildRtxPacket(
-      const RtpPacketToSend& packet);
+  // Rewrites the media packet |packet| into an RTX packet, in place. Returns
+  // false if it can't be sent over RTX.
+  bool ConvertToRtxPacket(RtpPacketToSend* packet);
 
   bool SendPacketToNetwork(const RtpPacketToSend& packet,
                            const PacketOptions& options,
@@ -337,6 +341,9 @@ class RTPSender {
   const bool populate_network2_timestamp_;
 
   const bool send_side_bwe_with_overhead_;
+  // Fill bandwidth probes with retransmissions of recent media packets,
+  // before the best fitting packets and padding.
+  const bool probe_with_recent_packets_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RTPSender);
 };
@@ -19,6 +19,7 @@
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_header_parser.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "modules/rtp_rtcp/source/rtp_format_video_generic.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -961,6 +962,56 @@ TEST_P(RtpSenderTest, SendRedundantPayloads) {
   EXPECT_FALSE(options.is_retransmit);
 }
 
+TEST_P(RtpSenderTest, ProbesWithRecentPackets) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-ProbeWithRecentPackets/Enabled/");
+  rtp_sender_.reset(new RTPSender(
+      false, &fake_clock_, &transport_, &mock_paced_sender_, nullptr,
+      &seq_num_allocator_, &feedback_observer_, nullptr, nullptr, nullptr,
+      &mock_rtc_event_log_, nullptr, &retransmission_rate_limiter_, nullptr,
+      false));
+  rtp_sender_->SetSequenceNumber(kSeqNum);
+  rtp_sender_->SetSSRC(kSsrc);
+  rtp_sender_->SetRtxPayloadType(kRtxPayload, kPayload);
+  rtp_sender_->SetRtxStatus(kRtxRetransmitted | kRtxRedundantPayloads);
+  rtp_sender_->SetRtxSsrc(1234);
+  rtp_sender_->SetStorePacketsStatus(true, 10);
+  EXPECT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
+                   kRtpExtensionTransportSequenceNumber,
+                   kTransportSequenceNumberExtensionId));
+  EXPECT_CALL(seq_num_allocator_, AllocateSequenceNumber())
+      .WillRepeatedly(testing::Return(kTransportSequenceNumber));
+
+  // The first packet is sent too long before the probe to be used for it.
+  const size_t kPayloadSizes[] = {500, 900, 700};
+  const int64_t kSendIntervalsMs[] = {200, 10, 10};
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, kSsrc, _, _, _, _)).Times(3);
+  EXPECT_CALL(feedback_observer_, AddPacket(kSsrc, _, _, PacedPacketInfo()))
+      .Times(3);
+  for (size_t i = 0; i < arraysize(kPayloadSizes); ++i) {
+    SendPacket(fake_clock_.TimeInMilliseconds(), kPayloadSizes[i]);
+    rtp_sender_->TimeToSendPacket(kSsrc, kSeqNum + i,
+                                  fake_clock_.TimeInMilliseconds(), false,
+                                  PacedPacketInfo());
+    fake_clock_.AdvanceTimeMilliseconds(kSendIntervalsMs[i]);
+  }
+
+  // The probe retransmits the recent packets newest first, and they are
+  // reported with the probe cluster so that the probe is measured as usual.
+  const PacedPacketInfo kProbeInfo(0, 3, 1000);
+  EXPECT_CALL(feedback_observer_, AddPacket(kSsrc, _, _, kProbeInfo)).Times(2);
+  EXPECT_EQ(kPayloadSizes[2] + kPayloadSizes[1],
+            rtp_sender_->TimeToSendPadding(1000, kProbeInfo));
+  ASSERT_EQ(5, transport_.packets_sent());
+  const RtpPacketReceived& newest = transport_.sent_packets_[3];
+  const RtpPacketReceived& second_newest = transport_.sent_packets_[4];
+  EXPECT_EQ(1234u, newest.Ssrc());
+  EXPECT_EQ(kSeqNum + 2,
+            ByteReader<uint16_t>::ReadBigEndian(newest.payload().data()));
+  EXPECT_EQ(kSeqNum + 1, ByteReader<uint16_t>::ReadBigEndian(
+                             second_newest.payload().data()));
+}
+
 TEST_P(RtpSenderTestWithoutPacer, SendGenericVideo) {
   char payload_name[RTP_PAYLOAD_NAME_SIZE] = "GENERIC";
   const uint8_t payload_type = 127;
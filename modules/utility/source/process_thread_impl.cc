@@ -10,6 +10,8 @@
 
 #include "modules/utility/source/process_thread_impl.h"
 
+#include <vector>
+
 #include "modules/include/module.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/task_queue.h"
@@ -24,6 +26,10 @@ namespace {
 // should be made, but Process() should be called directly.
 const int64_t kCallProcessImmediately = -1;
 
+// Signals that TimeUntilNextProcess hasn't been called yet for a module. Like
+// kCallProcessImmediately, it's scheduled before any actual time.
+const int64_t kNextCallbackUnknown = 0;
+
 int64_t GetNextCallbackTime(Module* module, int64_t time_now) {
   int64_t interval = module->TimeUntilNextProcess();
   if (interval < 0) {
@@ -65,8 +71,8 @@ void ProcessThreadImpl::Start() {
 
   RTC_DCHECK(!stop_);
 
-  for (ModuleCallback& m : modules_)
-    m.module->ProcessThreadAttached(this);
+  for (auto& m : modules_)
+    m.first->ProcessThreadAttached(this);
 
   thread_.reset(
       new rtc::PlatformThread(&ProcessThreadImpl::Run, this, thread_name_));
@@ -89,18 +95,17 @@ void ProcessThreadImpl::Stop() {
   stop_ = false;
 
   thread_.reset();
-  for (ModuleCallback& m : modules_)
-    m.module->ProcessThreadAttached(nullptr);
+  for (auto& m : modules_)
+    m.first->ProcessThreadAttached(nullptr);
 }
 
 void ProcessThreadImpl::WakeUp(Module* module) {
   // Allowed to be called on any thread.
   {
     rtc::CritScope lock(&lock_);
-    for (ModuleCallback& m : modules_) {
-      if (m.module == module)
-        m.next_callback = kCallProcessImmediately;
-    }
+    auto it = modules_.find(module);
+    if (it != modules_.end())
+      Reschedule(&it->second, kCallProcessImmediately);
   }
   wake_up_->Set();
 }
@@ -123,11 +128,11 @@ void ProcessThreadImpl::RegisterModule(Module* module,
   {
     // Catch programmer error.
     rtc::CritScope lock(&lock_);
-    for (const ModuleCallback& mc : modules_) {
-      RTC_DCHECK(mc.module != module)
-          << "Already registered here: " << mc.location.ToString() << "\n"
-          << "Now attempting from here: " << from.ToString();
-    }
+    auto it = modules_.find(module);
+    RTC_DCHECK(it == modules_.end())
+        << "Already registered here: " << it->second.location.ToString()
+        << "\n"
+        << "Now attempting from here: " << from.ToString();
   }
 #endif
 
@@ -139,7 +144,8 @@ void ProcessThreadImpl::RegisterModule(Module* module,
 
   {
     rtc::CritScope lock(&lock_);
-    modules_.push_back(ModuleCallback(module, from));
+    auto it = modules_.emplace(module, ModuleCallback(module, from)).first;
+    schedule_.insert(std::make_pair(it->second.next_callback, &it->second));
   }
 
   // Wake the thread calling ProcessThreadImpl::Process() to update the
@@ -154,14 +160,25 @@ void ProcessThreadImpl::DeRegisterModule(Module* module) {
 
   {
     rtc::CritScope lock(&lock_);
-    modules_.remove_if(
-        [&module](const ModuleCallback& m) { return m.module == module; });
+    auto it = modules_.find(module);
+    if (it != modules_.end()) {
+      schedule_.erase(std::make_pair(it->second.next_callback, &it->second));
+      modules_.erase(it);
+    }
   }
 
   // Notify the module that it's been detached.
   module->ProcessThreadAttached(nullptr);
 }
 
+void ProcessThreadImpl::Reschedule(ModuleCallback* module,
+                                   int64_t next_callback) {
+  // Nothing is erased if the module is being processed, see Process().
+  schedule_.erase(std::make_pair(module->next_callback, module));
+  module->next_callback = next_callback;
+  schedule_.insert(std::make_pair(next_callback, module));
+}
+
 // static
 bool ProcessThreadImpl::Run(void* obj) {
   return static_cast<ProcessThreadImpl*>(obj)->Process();
@@ -176,33 +193,46 @@ bool ProcessThreadImpl::Process() {
     rtc::CritScope lock(&lock_);
     if (stop_)
       return false;
-    for (ModuleCallback& m : modules_) {
+
+    // Take the due modules out of the schedule before processing them, so
+    // that each is processed at most once even if it is due again right
+    // away.
+    std::vector<ModuleCallback*> due_modules;
+    while (!schedule_.empty() && schedule_.begin()->first <= now) {
+      ModuleCallback* m = schedule_.begin()->second;
+      schedule_.erase(schedule_.begin());
       // TODO(tommi): Would be good to measure the time TimeUntilNextProcess
       // takes and dcheck if it takes too long (e.g. >=10ms).  Ideally this
       // operation should not require taking a lock, so querying all modules
       // should run in a matter of nanoseconds.
-      if (m.next_callback == 0)
-        m.next_callback = GetNextCallbackTime(m.module, now);
-
-      if (m.next_callback <= now ||
-          m.next_callback == kCallProcessImmediately) {
-        {
-          TRACE_EVENT2("webrtc", "ModuleProcess", "function",
-                       m.location.function_name(), "file",
-                       m.location.file_and_line());
-          m.module->Process();
+      if (m->next_callback == kNextCallbackUnknown) {
+        int64_t next_callback = GetNextCallbackTime(m->module, now);
+        if (next_callback > now) {
+          Reschedule(m, next_callback);
+          continue;
         }
-        // Use a new 'now' reference to calculate when the next callback
-        // should occur.  We'll continue to use 'now' above for the baseline
-        // of calculating how long we should wait, to reduce variance.
-        int64_t new_now = rtc::TimeMillis();
-        m.next_callback = GetNextCallbackTime(m.module, new_now);
+        m->next_callback = next_callback;
       }
+      due_modules.push_back(m);
+    }
 
-      if (m.next_callback < next_checkpoint)
-        next_checkpoint = m.next_callback;
+    for (ModuleCallback* m : due_modules) {
+      {
+        TRACE_EVENT2("webrtc", "ModuleProcess", "function",
+                     m->location.function_name(), "file",
+                     m->location.file_and_line());
+        m->module->Process();
+      }
+      // Use a new 'now' reference to calculate when the next callback
+      // should occur.  We'll continue to use 'now' above for the baseline
+      // of calculating how long we should wait, to reduce variance.
+      int64_t new_now = rtc::TimeMillis();
+      Reschedule(m, GetNextCallbackTime(m->module, new_now));
     }
 
+    if (!schedule_.empty() && schedule_.begin()->first < next_checkpoint)
+      next_checkpoint = schedule_.begin()->first;
+
     while (!queue_.empty()) {
       rtc::QueuedTask* task = queue_.front();
       queue_.pop();
@@ -11,9 +11,11 @@
 #ifndef MODULES_UTILITY_SOURCE_PROCESS_THREAD_IMPL_H_
 #define MODULES_UTILITY_SOURCE_PROCESS_THREAD_IMPL_H_
 
-#include <list>
+#include <map>
 #include <memory>
 #include <queue>
+#include <set>
+#include <utility>
 
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/criticalsection.h"
@@ -61,7 +63,14 @@ class ProcessThreadImpl : public ProcessThread {
     ModuleCallback& operator=(ModuleCallback&);
   };
 
-  typedef std::list<ModuleCallback> ModuleList;
+  typedef std::map<Module*, ModuleCallback> ModuleMap;
+  // Modules ordered by |next_callback|, so that only the modules that are due
+  // have to be visited.
+  typedef std::set<std::pair<int64_t, ModuleCallback*>> ModuleSchedule;
+
+  // Moves |module| to |next_callback| in |schedule_|.
+  void Reschedule(ModuleCallback* module, int64_t next_callback)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   // Warning: For some reason, if |lock_| comes immediately before |modules_|
   // with the current class layout, we will  start to have mysterious crashes
@@ -69,14 +78,16 @@ class ProcessThreadImpl : public ProcessThread {
   // issues, but I haven't figured out what they are, if there are alignment
   // requirements for mutexes on Mac or if there's something else to it.
   // So be careful with changing the layout.
-  rtc::CriticalSection lock_;  // Used to guard modules_, tasks_ and stop_.
+  // Used to guard modules_, schedule_, tasks_ and stop_.
+  rtc::CriticalSection lock_;
 
   rtc::ThreadChecker thread_checker_;
   const std::unique_ptr<EventWrapper> wake_up_;
   // TODO(pbos): Remove unique_ptr and stop recreating the thread.
   std::unique_ptr<rtc::PlatformThread> thread_;
 
-  ModuleList modules_;
+  ModuleMap modules_;
+  ModuleSchedule schedule_;
   std::queue<rtc::QueuedTask*> queue_;
   bool stop_;
   const char* thread_name_;
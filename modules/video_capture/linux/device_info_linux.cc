@@ -207,15 +207,16 @@ int32_t DeviceInfoLinux::FillCapabilities(int fd) {
   video_fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
   video_fmt.fmt.pix.sizeimage = 0;
 
-  int totalFmts = 4;
+  int totalFmts = 5;
   unsigned int videoFormats[] = {V4L2_PIX_FMT_MJPEG, V4L2_PIX_FMT_YUV420,
-                                 V4L2_PIX_FMT_YUYV, V4L2_PIX_FMT_UYVY};
+                                 V4L2_PIX_FMT_NV12, V4L2_PIX_FMT_YUYV,
+                                 V4L2_PIX_FMT_UYVY};
 
-  int sizes = 13;
+  int sizes = 14;
   unsigned int size[][2] = {{128, 96},   {160, 120},  {176, 144},  {320, 240},
                             {352, 288},  {640, 480},  {704, 576},  {800, 600},
                             {960, 720},  {1280, 720}, {1024, 768}, {1440, 1080},
-                            {1920, 1080}};
+                            {1920, 1080}, {3840, 2160}};
 
   int index = 0;
   for (int fmts = 0; fmts < totalFmts; fmts++) {
@@ -234,6 +235,8 @@ int32_t DeviceInfoLinux::FillCapabilities(int fd) {
             cap.videoType = VideoType::kYUY2;
           } else if (videoFormats[fmts] == V4L2_PIX_FMT_YUV420) {
             cap.videoType = VideoType::kI420;
+          } else if (videoFormats[fmts] == V4L2_PIX_FMT_NV12) {
+            cap.videoType = VideoType::kNV12;
           } else if (videoFormats[fmts] == V4L2_PIX_FMT_MJPEG) {
             cap.videoType = VideoType::kMJPEG;
           } else if (videoFormats[fmts] == V4L2_PIX_FMT_UYVY) {
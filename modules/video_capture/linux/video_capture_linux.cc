@@ -21,8 +21,12 @@
 #include <unistd.h>
 
 #include <new>
+#include <vector>
 
+#include "common_video/include/video_frame_buffer.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "media/base/videocommon.h"
+#include "rtc_base/bind.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/refcount.h"
 #include "rtc_base/refcountedobject.h"
@@ -30,6 +34,84 @@
 
 namespace webrtc {
 namespace videocapturemodule {
+
+// The mmapped buffers of a capture session. Buffers dequeued from the device
+// are either copied and queued again right away, or wrapped by a frame, in
+// which case they're queued again when the last reference to the frame is
+// released. That may happen on any thread, and after the capture has been
+// stopped, so the mappings live as long as any frame uses them.
+class VideoCaptureModuleV4L2::MappedBuffers : public rtc::RefCountInterface {
+ public:
+  explicit MappedBuffers(int device_fd) : device_fd_(device_fd) {}
+
+  ~MappedBuffers() override {
+    for (const Buffer& buffer : buffers_)
+      munmap(buffer.start, buffer.length);
+  }
+
+  void Add(void* start, size_t length) { buffers_.push_back({start, length}); }
+  uint8_t* start(size_t index) const {
+    return static_cast<uint8_t*>(buffers_[index].start);
+  }
+
+  int num_held() const {
+    rtc::CritScope cs(&lock_);
+    return num_held_;
+  }
+
+  // Wraps the I420 frame in buffer |index|, which is queued again when the
+  // returned buffer is released.
+  rtc::scoped_refptr<VideoFrameBuffer> WrapI420(uint32_t index,
+                                                int width,
+                                                int height) {
+    {
+      rtc::CritScope cs(&lock_);
+      ++num_held_;
+    }
+    const int stride_uv = (width + 1) / 2;
+    const uint8_t* data_y = start(index);
+    const uint8_t* data_u = data_y + width * height;
+    const uint8_t* data_v = data_u + stride_uv * ((height + 1) / 2);
+    return new rtc::RefCountedObject<WrappedI420Buffer>(
+        width, height, data_y, width, data_u, stride_uv, data_v, stride_uv,
+        rtc::Bind(&MappedBuffers::Requeue, this, index));
+  }
+
+  // Called before the device is closed. Buffers released afterwards are not
+  // queued again.
+  void StopStreaming() {
+    rtc::CritScope cs(&lock_);
+    streaming_ = false;
+  }
+
+ private:
+  struct Buffer {
+    void* start;
+    size_t length;
+  };
+
+  void Requeue(uint32_t index) {
+    rtc::CritScope cs(&lock_);
+    --num_held_;
+    if (!streaming_)
+      return;
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(struct v4l2_buffer));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    if (ioctl(device_fd_, VIDIOC_QBUF, &buf) == -1) {
+      RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+    }
+  }
+
+  const int device_fd_;
+  std::vector<Buffer> buffers_;
+  rtc::CriticalSection lock_;
+  int num_held_ RTC_GUARDED_BY(lock_) = 0;
+  bool streaming_ RTC_GUARDED_BY(lock_) = true;
+};
+
 rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
     const char* deviceUniqueId) {
   rtc::scoped_refptr<VideoCaptureModuleV4L2> implementation(
@@ -50,8 +132,7 @@ VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
       _currentHeight(-1),
       _currentFrameRate(-1),
       _captureStarted(false),
-      _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      _captureVideoType(VideoType::kI420) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -125,21 +206,24 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
 
   // Supported video formats in preferred order.
   // If the requested resolution is larger than VGA, we prefer MJPEG. Go for
-  // I420 otherwise.
-  const int nFormats = 5;
+  // I420 otherwise, which is delivered without conversion, or NV12, which is
+  // the cheapest to convert.
+  const int nFormats = 6;
   unsigned int fmts[nFormats];
   if (capability.width > 640 || capability.height > 480) {
     fmts[0] = V4L2_PIX_FMT_MJPEG;
     fmts[1] = V4L2_PIX_FMT_YUV420;
-    fmts[2] = V4L2_PIX_FMT_YUYV;
-    fmts[3] = V4L2_PIX_FMT_UYVY;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
+    fmts[2] = V4L2_PIX_FMT_NV12;
+    fmts[3] = V4L2_PIX_FMT_YUYV;
+    fmts[4] = V4L2_PIX_FMT_UYVY;
+    fmts[5] = V4L2_PIX_FMT_JPEG;
   } else {
     fmts[0] = V4L2_PIX_FMT_YUV420;
-    fmts[1] = V4L2_PIX_FMT_YUYV;
-    fmts[2] = V4L2_PIX_FMT_UYVY;
-    fmts[3] = V4L2_PIX_FMT_MJPEG;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
+    fmts[1] = V4L2_PIX_FMT_NV12;
+    fmts[2] = V4L2_PIX_FMT_YUYV;
+    fmts[3] = V4L2_PIX_FMT_UYVY;
+    fmts[4] = V4L2_PIX_FMT_MJPEG;
+    fmts[5] = V4L2_PIX_FMT_JPEG;
   }
 
   // Enumerate image formats.
@@ -182,6 +266,8 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
     _captureVideoType = VideoType::kYUY2;
   else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_YUV420)
     _captureVideoType = VideoType::kI420;
+  else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_NV12)
+    _captureVideoType = VideoType::kNV12;
   else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_UYVY)
     _captureVideoType = VideoType::kUYVY;
   else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_MJPEG ||
@@ -298,7 +384,7 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
   _buffersAllocatedByDevice = rbuffer.count;
 
   // Map the buffers
-  _pool = new Buffer[rbuffer.count];
+  _buffers = new rtc::RefCountedObject<MappedBuffers>(_deviceFd);
 
   for (unsigned int i = 0; i < rbuffer.count; i++) {
     struct v4l2_buffer buffer;
@@ -311,16 +397,15 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
       return false;
     }
 
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
+    void* start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, _deviceFd, buffer.m.offset);
 
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
+    if (MAP_FAILED == start) {
+      _buffers = nullptr;
       return false;
     }
 
-    _pool[i].length = buffer.length;
+    _buffers->Add(start, buffer.length);
 
     if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
       return false;
@@ -330,11 +415,11 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  // The buffers are unmapped once no frame uses them anymore.
+  if (_buffers) {
+    _buffers->StopStreaming();
+    _buffers = nullptr;
+  }
 
   // turn off stream
   enum v4l2_buf_type type;
@@ -396,9 +481,24 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
     frameInfo.height = _currentHeight;
     frameInfo.videoType = _captureVideoType;
 
+    if (_captureVideoType == VideoType::kI420 &&
+        buf.bytesused ==
+            CalcBufferSize(VideoType::kI420, _currentWidth, _currentHeight) &&
+        _buffers->num_held() < kMaxHeldV4L2Buffers) {
+      // Deliver the frame without copying it. The buffer is enqueued again
+      // when the last reference to it is released.
+      rtc::scoped_refptr<VideoFrameBuffer> buffer =
+          _buffers->WrapI420(buf.index, _currentWidth, _currentHeight);
+      if (!IncomingBuffer(buffer, 0)) {
+        // Has to be rotated.
+        IncomingFrame(_buffers->start(buf.index), buf.bytesused, frameInfo);
+      }
+      usleep(0);
+      return true;
+    }
+
     // convert to to I420 if needed
-    IncomingFrame((unsigned char*)_pool[buf.index].start, buf.bytesused,
-                  frameInfo);
+    IncomingFrame(_buffers->start(buf.index), buf.bytesused, frameInfo);
     // enqueue the buffer again
     if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
       RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
@@ -17,6 +17,7 @@
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/scoped_ref_ptr.h"
 
 namespace webrtc {
 namespace videocapturemodule {
@@ -32,6 +33,11 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
 
  private:
   enum { kNoOfV4L2Bufffers = 4 };
+  // I420 frames are delivered without copying while the device has at least
+  // two other buffers to capture into.
+  enum { kMaxHeldV4L2Buffers = kNoOfV4L2Bufffers - 2 };
+
+  class MappedBuffers;
 
   static bool CaptureThread(void*);
   bool CaptureProcess();
@@ -51,11 +57,9 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  // Frames that wrap a buffer without copying keep them mapped, and give the
+  // buffer back to the device when they're released.
+  rtc::scoped_refptr<MappedBuffers> _buffers;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -161,9 +161,13 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   // In Windows, the image starts bottom left, instead of top left.
   // Setting a negative source height, inverts the image (within LibYuv).
 
-  // TODO(nisse): Use a pool?
-  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(
-      target_width, abs(target_height), stride_y, stride_uv, stride_uv);
+  rtc::scoped_refptr<I420Buffer> buffer =
+      buffer_pool_.CreateBuffer(target_width, abs(target_height));
+  if (!buffer) {
+    // All pooled buffers are still in use.
+    buffer = I420Buffer::Create(target_width, abs(target_height), stride_y,
+                                stride_uv, stride_uv);
+  }
 
   libyuv::RotationMode rotation_mode = libyuv::kRotate0;
   if (apply_rotation) {
@@ -205,6 +209,22 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+bool VideoCaptureImpl::IncomingBuffer(
+    const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+    int64_t captureTime) {
+  rtc::CritScope cs(&_apiCs);
+  TRACE_EVENT1("webrtc", "VC::IncomingBuffer", "capture_time", captureTime);
+
+  if (apply_rotation_ && _rotateFrame != kVideoRotation_0)
+    return false;
+
+  VideoFrame captureFrame(buffer, 0, rtc::TimeMillis(), _rotateFrame);
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  DeliverCapturedFrame(captureFrame);
+  return true;
+}
+
 int32_t VideoCaptureImpl::SetCaptureRotation(VideoRotation rotation) {
   rtc::CritScope cs(&_apiCs);
   _rotateFrame = rotation;
@@ -17,6 +17,7 @@
 
 #include "api/video/video_frame.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "modules/video_capture/video_capture.h"
 #include "modules/video_capture/video_capture_config.h"
 #include "rtc_base/criticalsection.h"
@@ -88,6 +89,11 @@ class VideoCaptureImpl : public VideoCaptureModule,
   VideoCaptureImpl();
   virtual ~VideoCaptureImpl();
   int32_t DeliverCapturedFrame(VideoFrame& captureFrame);
+  // Delivers |buffer| as is, without converting or copying it. Returns false,
+  // without delivering anything, if the frame has to be rotated by the capture
+  // module; the caller has to use IncomingFrame() then.
+  bool IncomingBuffer(const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+                      int64_t captureTime);
 
   char* _deviceUniqueId;  // current Device unique name;
   rtc::CriticalSection _apiCs;
@@ -113,6 +119,9 @@ class VideoCaptureImpl : public VideoCaptureModule,
 
   // Indicate whether rotation should be applied before delivered externally.
   bool apply_rotation_;
+
+  // Buffers for the frames converted to I420.
+  I420BufferPool buffer_pool_ RTC_GUARDED_BY(_apiCs);
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -0,0 +1,431 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#include "modules/video_coding/codecs/av1/av1_impl.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "aom/aomcx.h"
+#include "aom/aomdx.h"
+
+#include "absl/memory/memory.h"
+#include "api/video/i420_buffer.h"
+#include "common_types.h"  // NOLINT(build/include)
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "media/base/mediaconstants.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+
+namespace {
+
+// Encoder speed, 0 is the slowest. Use the fastest real time preset, like
+// the cpu speed of -6 and below for VP8.
+const int kCpuUsed = 8;
+const int kMinQp = 2;
+const int kMaxQp = 52;
+// The 90 kHz RTP clock is used as the encoder time base.
+const int kRtpTicksPerSecond = 90000;
+
+}  // namespace
+
+std::vector<SdpVideoFormat> SupportedAV1Codecs() {
+  return {SdpVideoFormat(cricket::kAv1CodecName)};
+}
+
+std::unique_ptr<AV1Encoder> AV1Encoder::Create() {
+  return absl::make_unique<AV1EncoderImpl>();
+}
+
+AV1EncoderImpl::AV1EncoderImpl()
+    : encoded_complete_callback_(nullptr),
+      inited_(false),
+      timestamp_(0),
+      raw_(nullptr) {
+  memset(&codec_, 0, sizeof(codec_));
+  memset(&encoder_, 0, sizeof(encoder_));
+  memset(&config_, 0, sizeof(config_));
+}
+
+AV1EncoderImpl::~AV1EncoderImpl() {
+  Release();
+}
+
+int AV1EncoderImpl::Release() {
+  int ret_val = WEBRTC_VIDEO_CODEC_OK;
+  if (encoded_image_._buffer != nullptr) {
+    delete[] encoded_image_._buffer;
+    encoded_image_._buffer = nullptr;
+    encoded_image_._size = 0;
+  }
+  if (inited_) {
+    if (aom_codec_destroy(&encoder_)) {
+      ret_val = WEBRTC_VIDEO_CODEC_MEMORY;
+    }
+    inited_ = false;
+  }
+  if (raw_ != nullptr) {
+    aom_img_free(raw_);
+    raw_ = nullptr;
+  }
+  return ret_val;
+}
+
+int AV1EncoderImpl::NumberOfThreads(int width,
+                                    int height,
+                                    int number_of_cores) {
+  // Same as for VP9: libaom also spreads the work over tile columns, and
+  // falls back to row based multithreading within them.
+  if (width * height >= 1280 * 720 && number_of_cores > 4) {
+    return 4;
+  } else if (width * height >= 640 * 360 && number_of_cores > 2) {
+    return 2;
+  } else {
+    return 1;
+  }
+}
+
+int AV1EncoderImpl::InitEncode(const VideoCodec* inst,
+                               int number_of_cores,
+                               size_t /*max_payload_size*/) {
+  if (inst == nullptr) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  if (inst->maxFramerate < 1) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  // Allow zero to represent an unspecified maxBitRate.
+  if (inst->maxBitrate > 0 && inst->startBitrate > inst->maxBitrate) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  if (inst->width < 1 || inst->height < 1) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  if (number_of_cores < 1) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  if (inst->numberOfSimulcastStreams > 1) {
+    return WEBRTC_VIDEO_CODEC_ERR_SIMULCAST_PARAMETERS_NOT_SUPPORTED;
+  }
+  int ret_val = Release();
+  if (ret_val < 0) {
+    return ret_val;
+  }
+  codec_ = *inst;
+
+  // Allocate memory for encoded image; the size of an uncompressed frame
+  // is the worst case.
+  encoded_image_._size =
+      CalcBufferSize(VideoType::kI420, codec_.width, codec_.height);
+  encoded_image_._buffer = new uint8_t[encoded_image_._size];
+  encoded_image_._completeFrame = true;
+
+  // The pointers to the planes are set per frame in Encode.
+  raw_ = aom_img_wrap(nullptr, AOM_IMG_FMT_I420, codec_.width, codec_.height,
+                      1, nullptr);
+
+  if (aom_codec_enc_config_default(aom_codec_av1_cx(), &config_,
+                                   AOM_USAGE_REALTIME)) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  config_.g_w = codec_.width;
+  config_.g_h = codec_.height;
+  config_.g_threads =
+      NumberOfThreads(codec_.width, codec_.height, number_of_cores);
+  config_.g_timebase.num = 1;
+  config_.g_timebase.den = kRtpTicksPerSecond;
+  config_.g_lag_in_frames = 0;  // No frame lagging.
+  config_.g_error_resilient = 0;
+  config_.g_pass = AOM_RC_ONE_PASS;
+  config_.rc_target_bitrate = codec_.startBitrate;  // In kbit/s.
+  config_.rc_end_usage = AOM_CBR;
+  config_.rc_dropframe_thresh = 0;
+  config_.rc_min_quantizer = kMinQp;
+  config_.rc_max_quantizer =
+      codec_.qpMax > 0 ? std::min<unsigned int>(codec_.qpMax, 63) : kMaxQp;
+  config_.rc_undershoot_pct = 50;
+  config_.rc_overshoot_pct = 50;
+  config_.rc_buf_initial_sz = 600;
+  config_.rc_buf_optimal_sz = 600;
+  config_.rc_buf_sz = 1000;
+  // Key frames are only sent on request.
+  config_.kf_mode = AOM_KF_DISABLED;
+
+  if (aom_codec_enc_init(&encoder_, aom_codec_av1_cx(), &config_, 0)) {
+    RTC_LOG(LS_ERROR) << "Failed to initialize the AV1 encoder: "
+                      << aom_codec_error(&encoder_);
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  inited_ = true;
+
+  aom_codec_control(&encoder_, AOME_SET_CPUUSED, kCpuUsed);
+  // One tile column per thread, in log2 unit.
+  int tile_columns_log2 = 0;
+  while ((2u << tile_columns_log2) <= config_.g_threads)
+    ++tile_columns_log2;
+  aom_codec_control(&encoder_, AV1E_SET_TILE_COLUMNS, tile_columns_log2);
+  aom_codec_control(&encoder_, AV1E_SET_ROW_MT, 1);
+  aom_codec_control(&encoder_, AV1E_SET_AQ_MODE, 3);
+  if (codec_.mode == VideoCodecMode::kScreensharing) {
+    aom_codec_control(&encoder_, AV1E_SET_TUNE_CONTENT, AOM_CONTENT_SCREEN);
+  }
+
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int AV1EncoderImpl::Encode(const VideoFrame& input_image,
+                           const CodecSpecificInfo* codec_specific_info,
+                           const std::vector<FrameType>* frame_types) {
+  if (!inited_) {
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+  if (encoded_complete_callback_ == nullptr) {
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+
+  aom_enc_frame_flags_t flags = 0;
+  if (frame_types && !frame_types->empty() &&
+      (*frame_types)[0] == kVideoFrameKey) {
+    flags = AOM_EFLAG_FORCE_KF;
+  }
+
+  RTC_DCHECK_EQ(input_image.width(), raw_->d_w);
+  RTC_DCHECK_EQ(input_image.height(), raw_->d_h);
+
+  // Keep reference to buffer until encode completes.
+  rtc::scoped_refptr<I420BufferInterface> i420_buffer =
+      input_image.video_frame_buffer()->ToI420();
+  // Input image is const. libaom's raw image is not defined as const.
+  raw_->planes[AOM_PLANE_Y] = const_cast<uint8_t*>(i420_buffer->DataY());
+  raw_->planes[AOM_PLANE_U] = const_cast<uint8_t*>(i420_buffer->DataU());
+  raw_->planes[AOM_PLANE_V] = const_cast<uint8_t*>(i420_buffer->DataV());
+  raw_->stride[AOM_PLANE_Y] = i420_buffer->StrideY();
+  raw_->stride[AOM_PLANE_U] = i420_buffer->StrideU();
+  raw_->stride[AOM_PLANE_V] = i420_buffer->StrideV();
+
+  const uint32_t duration = kRtpTicksPerSecond / codec_.maxFramerate;
+  if (aom_codec_encode(&encoder_, raw_, timestamp_, duration, flags)) {
+    RTC_LOG(LS_ERROR) << "Encoding error: " << aom_codec_error(&encoder_)
+                      << "\n"
+                      << "Details: " << aom_codec_error_detail(&encoder_);
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  timestamp_ += duration;
+
+  // libaom may output several packets for one frame, e.g. a temporal
+  // delimiter and the frame; together they make up the temporal unit that is
+  // sent as one RTP frame.
+  encoded_image_._length = 0;
+  encoded_image_._frameType = kVideoFrameDelta;
+  aom_codec_iter_t iter = nullptr;
+  while (const aom_codec_cx_pkt_t* pkt =
+             aom_codec_get_cx_data(&encoder_, &iter)) {
+    if (pkt->kind != AOM_CODEC_CX_FRAME_PKT)
+      continue;
+    const size_t required_size = encoded_image_._length + pkt->data.frame.sz;
+    if (required_size > encoded_image_._size) {
+      uint8_t* buffer = new uint8_t[required_size];
+      memcpy(buffer, encoded_image_._buffer, encoded_image_._length);
+      delete[] encoded_image_._buffer;
+      encoded_image_._buffer = buffer;
+      encoded_image_._size = required_size;
+    }
+    memcpy(encoded_image_._buffer + encoded_image_._length,
+           pkt->data.frame.buf, pkt->data.frame.sz);
+    encoded_image_._length += pkt->data.frame.sz;
+    if (pkt->data.frame.flags & AOM_FRAME_IS_KEY)
+      encoded_image_._frameType = kVideoFrameKey;
+  }
+  if (encoded_image_._length == 0) {
+    // The encoder dropped the frame.
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  encoded_image_._timeStamp = input_image.timestamp();
+  encoded_image_.capture_time_ms_ = input_image.render_time_ms();
+  encoded_image_.rotation_ = input_image.rotation();
+  encoded_image_.content_type_ = (codec_.mode == VideoCodecMode::kScreensharing)
+                                     ? VideoContentType::SCREENSHARE
+                                     : VideoContentType::UNSPECIFIED;
+  encoded_image_._encodedWidth = codec_.width;
+  encoded_image_._encodedHeight = codec_.height;
+  encoded_image_.timing_.flags = VideoSendTiming::kInvalid;
+  int qp = -1;
+  aom_codec_control(&encoder_, AOME_GET_LAST_QUANTIZER, &qp);
+  encoded_image_.qp_ = qp;
+
+  CodecSpecificInfo codec_specific;
+  memset(&codec_specific, 0, sizeof(codec_specific));
+  codec_specific.codecType = kVideoCodecAV1;
+  codec_specific.codec_name = ImplementationName();
+  codec_specific.codecSpecific.generic.simulcast_idx = 0;
+  TRACE_COUNTER1("webrtc", "EncodedFrameSize", encoded_image_._length);
+
+  // Without a payload specific packetization, the frame is a single
+  // fragment.
+  RTPFragmentationHeader frag_info;
+  frag_info.VerifyAndAllocateFragmentationHeader(1);
+  frag_info.fragmentationOffset[0] = 0;
+  frag_info.fragmentationLength[0] = encoded_image_._length;
+  frag_info.fragmentationPlType[0] = 0;
+  frag_info.fragmentationTimeDiff[0] = 0;
+  encoded_complete_callback_->OnEncodedImage(encoded_image_, &codec_specific,
+                                             &frag_info);
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int AV1EncoderImpl::RegisterEncodeCompleteCallback(
+    EncodedImageCallback* callback) {
+  encoded_complete_callback_ = callback;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int AV1EncoderImpl::SetChannelParameters(uint32_t packet_loss, int64_t rtt) {
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int AV1EncoderImpl::SetRateAllocation(
+    const VideoBitrateAllocation& bitrate_allocation,
+    uint32_t frame_rate) {
+  if (!inited_) {
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+  if (frame_rate < 1) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  if (codec_.maxBitrate > 0 &&
+      bitrate_allocation.get_sum_kbps() > codec_.maxBitrate) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  config_.rc_target_bitrate = bitrate_allocation.get_sum_kbps();
+  codec_.maxFramerate = frame_rate;
+  if (aom_codec_enc_config_set(&encoder_, &config_)) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+const char* AV1EncoderImpl::ImplementationName() const {
+  return "libaom";
+}
+
+std::unique_ptr<AV1Decoder> AV1Decoder::Create() {
+  return absl::make_unique<AV1DecoderImpl>();
+}
+
+AV1DecoderImpl::AV1DecoderImpl()
+    : decode_complete_callback_(nullptr),
+      inited_(false),
+      key_frame_required_(true) {
+  memset(&decoder_, 0, sizeof(decoder_));
+}
+
+AV1DecoderImpl::~AV1DecoderImpl() {
+  Release();
+}
+
+int AV1DecoderImpl::InitDecode(const VideoCodec* inst, int number_of_cores) {
+  int ret_val = Release();
+  if (ret_val < 0) {
+    return ret_val;
+  }
+  aom_codec_dec_cfg_t config;
+  memset(&config, 0, sizeof(config));
+  config.threads = std::max(1, std::min(number_of_cores, 4));
+  // Let the decoder output 8 bit images for 8 bit streams.
+  config.allow_lowbitdepth = 1;
+  if (aom_codec_dec_init(&decoder_, aom_codec_av1_dx(), &config, 0)) {
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
+  inited_ = true;
+  // Always start with a complete key frame.
+  key_frame_required_ = true;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int AV1DecoderImpl::Decode(const EncodedImage& input_image,
+                           bool missing_frames,
+                           const CodecSpecificInfo* codec_specific_info,
+                           int64_t /*render_time_ms*/) {
+  if (!inited_) {
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+  if (decode_complete_callback_ == nullptr) {
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+  // Always start with a complete key frame.
+  if (key_frame_required_) {
+    if (input_image._frameType != kVideoFrameKey ||
+        !input_image._completeFrame) {
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    key_frame_required_ = false;
+  }
+  if (aom_codec_decode(&decoder_, input_image._buffer, input_image._length,
+                       nullptr)) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+
+  aom_codec_iter_t iter = nullptr;
+  aom_image_t* img = aom_codec_get_frame(&decoder_, &iter);
+  if (img == nullptr) {
+    // Decoder OK and nullptr image => No show frame.
+    return WEBRTC_VIDEO_CODEC_NO_OUTPUT;
+  }
+  if (img->fmt != AOM_IMG_FMT_I420) {
+    RTC_LOG(LS_ERROR) << "Unsupported AV1 image format " << img->fmt;
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  int qp = -1;
+  aom_codec_control(&decoder_, AOMD_GET_LAST_QUANTIZER, &qp);
+
+  // libaom reuses the image once the next frame is decoded, so copy it.
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Copy(
+      img->d_w, img->d_h, img->planes[AOM_PLANE_Y], img->stride[AOM_PLANE_Y],
+      img->planes[AOM_PLANE_U], img->stride[AOM_PLANE_U],
+      img->planes[AOM_PLANE_V], img->stride[AOM_PLANE_V]);
+  VideoFrame decoded_image = VideoFrame::Builder()
+                                 .set_video_frame_buffer(buffer)
+                                 .set_timestamp_ms(0)
+                                 .set_timestamp_rtp(input_image._timeStamp)
+                                 .set_ntp_time_ms(input_image.ntp_time_ms_)
+                                 .set_rotation(webrtc::kVideoRotation_0)
+                                 .build();
+  decode_complete_callback_->Decoded(decoded_image, absl::nullopt, qp);
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int AV1DecoderImpl::RegisterDecodeCompleteCallback(
+    DecodedImageCallback* callback) {
+  decode_complete_callback_ = callback;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int AV1DecoderImpl::Release() {
+  int ret_val = WEBRTC_VIDEO_CODEC_OK;
+  if (inited_) {
+    if (aom_codec_destroy(&decoder_)) {
+      ret_val = WEBRTC_VIDEO_CODEC_MEMORY;
+    }
+    inited_ = false;
+  }
+  return ret_val;
+}
+
+const char* AV1DecoderImpl::ImplementationName() const {
+  return "libaom";
+}
+
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_AV1_AV1_IMPL_H_
+#define MODULES_VIDEO_CODING_CODECS_AV1_AV1_IMPL_H_
+
+#include <memory>
+#include <vector>
+
+#include "aom/aom_decoder.h"
+#include "aom/aom_encoder.h"
+#include "modules/video_coding/codecs/av1/include/av1.h"
+
+namespace webrtc {
+
+// Encodes a single spatial and temporal layer with libaom, tuned for real
+// time. The encoded frames are sent with the generic RTP packetization.
+class AV1EncoderImpl : public AV1Encoder {
+ public:
+  AV1EncoderImpl();
+  ~AV1EncoderImpl() override;
+
+  int InitEncode(const VideoCodec* codec_settings,
+                 int number_of_cores,
+                 size_t max_payload_size) override;
+
+  int Encode(const VideoFrame& input_image,
+             const CodecSpecificInfo* codec_specific_info,
+             const std::vector<FrameType>* frame_types) override;
+
+  int RegisterEncodeCompleteCallback(EncodedImageCallback* callback) override;
+
+  int Release() override;
+
+  int SetChannelParameters(uint32_t packet_loss, int64_t rtt) override;
+
+  int SetRateAllocation(const VideoBitrateAllocation& bitrate_allocation,
+                        uint32_t frame_rate) override;
+
+  const char* ImplementationName() const override;
+
+ private:
+  // Determine number of encoder threads to use.
+  static int NumberOfThreads(int width, int height, int number_of_cores);
+
+  // Delivers the frames libaom has output for the last encoded image.
+  int DeliverEncodedFrames(const VideoFrame& input_image);
+
+  EncodedImageCallback* encoded_complete_callback_;
+  VideoCodec codec_;
+  bool inited_;
+  int64_t timestamp_;
+  aom_codec_ctx_t encoder_;
+  aom_codec_enc_cfg_t config_;
+  aom_image_t* raw_;
+  EncodedImage encoded_image_;
+};
+
+class AV1DecoderImpl : public AV1Decoder {
+ public:
+  AV1DecoderImpl();
+  ~AV1DecoderImpl() override;
+
+  int InitDecode(const VideoCodec* inst, int number_of_cores) override;
+
+  int Decode(const EncodedImage& input_image,
+             bool missing_frames,
+             const CodecSpecificInfo* codec_specific_info,
+             int64_t /*render_time_ms*/) override;
+
+  int RegisterDecodeCompleteCallback(DecodedImageCallback* callback) override;
+
+  int Release() override;
+
+  const char* ImplementationName() const override;
+
+ private:
+  DecodedImageCallback* decode_complete_callback_;
+  bool inited_;
+  aom_codec_ctx_t decoder_;
+  bool key_frame_required_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_AV1_AV1_IMPL_H_
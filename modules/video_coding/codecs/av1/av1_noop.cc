@@ -0,0 +1,37 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#if !defined(RTC_DISABLE_AV1)
+#error
+#endif  // !defined(RTC_DISABLE_AV1)
+
+#include "modules/video_coding/codecs/av1/include/av1.h"
+
+#include "api/video_codecs/sdp_video_format.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+std::vector<SdpVideoFormat> SupportedAV1Codecs() {
+  return std::vector<SdpVideoFormat>();
+}
+
+std::unique_ptr<AV1Encoder> AV1Encoder::Create() {
+  RTC_NOTREACHED();
+  return nullptr;
+}
+
+std::unique_ptr<AV1Decoder> AV1Decoder::Create() {
+  RTC_NOTREACHED();
+  return nullptr;
+}
+
+}  // namespace webrtc
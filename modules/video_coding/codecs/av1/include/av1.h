@@ -0,0 +1,43 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_AV1_INCLUDE_AV1_H_
+#define MODULES_VIDEO_CODING_CODECS_AV1_INCLUDE_AV1_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/video_codecs/sdp_video_format.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+
+namespace webrtc {
+
+// Returns the AV1 formats we can negotiate in SDP. Empty unless WebRTC is
+// built with libaom (rtc_include_libaom).
+std::vector<SdpVideoFormat> SupportedAV1Codecs();
+
+class AV1Encoder : public VideoEncoder {
+ public:
+  static std::unique_ptr<AV1Encoder> Create();
+
+  ~AV1Encoder() override {}
+};
+
+class AV1Decoder : public VideoDecoder {
+ public:
+  static std::unique_ptr<AV1Decoder> Create();
+
+  ~AV1Decoder() override {}
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_AV1_INCLUDE_AV1_H_
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "modules/video_coding/codecs/av1/include/av1.h"
+#include "modules/video_coding/codecs/test/video_codec_unittest.h"
+#include "test/video_codec_settings.h"
+
+namespace webrtc {
+
+namespace {
+const size_t kWidth = 640;
+const size_t kHeight = 360;
+}  // namespace
+
+class TestAv1Impl : public VideoCodecUnitTest {
+ protected:
+  std::unique_ptr<VideoEncoder> CreateEncoder() override {
+    return AV1Encoder::Create();
+  }
+
+  std::unique_ptr<VideoDecoder> CreateDecoder() override {
+    return AV1Decoder::Create();
+  }
+
+  void ModifyCodecSettings(VideoCodec* codec_settings) override {
+    webrtc::test::CodecSettings(kVideoCodecAV1, codec_settings);
+    codec_settings->width = kWidth;
+    codec_settings->height = kHeight;
+  }
+};
+
+TEST_F(TestAv1Impl, EncodeDecode) {
+  VideoFrame* input_frame = NextInputFrame();
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*input_frame, nullptr, nullptr));
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+  EXPECT_EQ(kVideoCodecAV1, codec_specific_info.codecType);
+  // First frame should be a key frame.
+  EXPECT_EQ(kVideoFrameKey, encoded_frame._frameType);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder_->Decode(encoded_frame, false, nullptr, 0));
+  std::unique_ptr<VideoFrame> decoded_frame;
+  absl::optional<uint8_t> decoded_qp;
+  ASSERT_TRUE(WaitForDecodedFrame(&decoded_frame, &decoded_qp));
+  ASSERT_TRUE(decoded_frame);
+  EXPECT_GT(I420PSNR(input_frame, decoded_frame.get()), 36);
+}
+
+TEST_F(TestAv1Impl, EncodesKeyFrameOnRequest) {
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*NextInputFrame(), nullptr, nullptr));
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*NextInputFrame(), nullptr, nullptr));
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+  EXPECT_EQ(kVideoFrameDelta, encoded_frame._frameType);
+
+  const std::vector<FrameType> frame_types = {kVideoFrameKey};
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*NextInputFrame(), nullptr, &frame_types));
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+  EXPECT_EQ(kVideoFrameKey, encoded_frame._frameType);
+}
+
+TEST_F(TestAv1Impl, DecoderRequiresKeyFrameFirst) {
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*NextInputFrame(), nullptr, nullptr));
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*NextInputFrame(), nullptr, nullptr));
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+  ASSERT_EQ(kVideoFrameDelta, encoded_frame._frameType);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_ERROR,
+            decoder_->Decode(encoded_frame, false, nullptr, 0));
+}
+
+}  // namespace webrtc
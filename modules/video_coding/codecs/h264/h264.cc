@@ -19,6 +19,10 @@
 #include "modules/video_coding/codecs/h264/h264_encoder_impl.h"
 #endif
 
+#if defined(WEBRTC_USE_VAAPI)
+#include "modules/video_coding/codecs/h264/h264_vaapi_encoder_impl.h"
+#endif
+
 #include "absl/memory/memory.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -98,6 +102,26 @@ bool H264Encoder::IsSupported() {
   return IsH264CodecSupported();
 }
 
+std::unique_ptr<H264Encoder> CreateH264VaapiEncoder(
+    const cricket::VideoCodec& codec) {
+  RTC_DCHECK(IsH264VaapiEncoderSupported());
+#if defined(WEBRTC_USE_VAAPI)
+  RTC_LOG(LS_INFO) << "Creating H264VaapiEncoderImpl.";
+  return absl::make_unique<H264VaapiEncoderImpl>(codec);
+#else
+  RTC_NOTREACHED();
+  return nullptr;
+#endif
+}
+
+bool IsH264VaapiEncoderSupported() {
+#if defined(WEBRTC_USE_VAAPI)
+  return IsH264CodecSupported() && H264VaapiEncoderImpl::IsDeviceAvailable();
+#else
+  return false;
+#endif
+}
+
 std::unique_ptr<H264Decoder> H264Decoder::Create() {
   RTC_DCHECK(H264Decoder::IsSupported());
 #if defined(WEBRTC_USE_H264)
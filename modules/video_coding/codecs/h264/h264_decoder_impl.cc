@@ -24,6 +24,7 @@ extern "C" {
 #include "api/video/i420_buffer.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/codecs/h264/h264_color_space.h"
+#include "modules/video_coding/utility/codec_thread_budget.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/keep_ref_until_done.h"
@@ -47,6 +48,19 @@ enum H264DecoderImplEvent {
   kH264DecoderEventMax = 16,
 };
 
+// Number of slice threads a decoder would like to use for the given
+// resolution, before taking the process-wide budget into account.
+int NumberOfThreads(int width, int height, int number_of_cores) {
+  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 1280 * 720 && number_of_cores > 4) {
+    return 4;
+  } else if (width * height >= 640 * 360 && number_of_cores > 2) {
+    return 2;
+  }
+  return 1;
+}
+
 }  // namespace
 
 int H264DecoderImpl::AVGetBuffer2(
@@ -141,6 +155,7 @@ void H264DecoderImpl::AVFreeBuffer2(void* opaque, uint8_t* data) {
 
 H264DecoderImpl::H264DecoderImpl() : pool_(true),
                                      decoded_image_callback_(nullptr),
+                                     extra_decoder_threads_(0),
                                      has_reported_init_(false),
                                      has_reported_error_(false) {
 }
@@ -179,9 +194,18 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
   av_context_->extradata = nullptr;
   av_context_->extradata_size = 0;
 
-  // If this is ever increased, look at |av_context_->thread_safe_callbacks| and
-  // make it possible to disable the thread checker in the frame buffer pool.
-  av_context_->thread_count = 1;
+  // Only slice threading is used: frame threading adds a frame of latency per
+  // thread and calls |get_buffer2| from FFmpeg's threads, which the frame
+  // buffer pool does not allow. With slice threading |AVGetBuffer2| is still
+  // only called from the thread calling |Decode|.
+  int wanted_threads = 1;
+  if (codec_settings) {
+    wanted_threads = NumberOfThreads(codec_settings->width,
+                                     codec_settings->height, number_of_cores);
+  }
+  extra_decoder_threads_ =
+      CodecThreadBudget::Global()->Acquire(wanted_threads - 1);
+  av_context_->thread_count = 1 + extra_decoder_threads_;
   av_context_->thread_type = FF_THREAD_SLICE;
 
   // Function used by FFmpeg to get buffers to store decoded frames in.
@@ -214,6 +238,8 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
 int32_t H264DecoderImpl::Release() {
   av_context_.reset();
   av_frame_.reset();
+  CodecThreadBudget::Global()->Release(extra_decoder_threads_);
+  extra_decoder_threads_ = 0;
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -75,6 +75,9 @@ class H264DecoderImpl : public H264Decoder {
   std::unique_ptr<AVFrame, AVFrameDeleter> av_frame_;
 
   DecodedImageCallback* decoded_image_callback_;
+  // Slice threads used by |av_context_| in addition to the decoding thread,
+  // taken from CodecThreadBudget::Global().
+  int extra_decoder_threads_;
 
   bool has_reported_init_;
   bool has_reported_error_;
@@ -18,6 +18,7 @@
 #include "api/video/i420_buffer.h"
 #include "common_video/h264/h264_bitstream_parser.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
+#include "modules/video_coding/utility/encoded_image_buffer_pool.h"
 #include "modules/video_coding/utility/quality_scaler.h"
 
 #include "third_party/openh264/src/codec/api/svc/codec_app_def.h"
@@ -95,7 +96,8 @@ class H264EncoderImpl : public H264Encoder {
   std::vector<rtc::scoped_refptr<I420Buffer>> downscaled_buffers_;
   std::vector<LayerConfig> configurations_;
   std::vector<EncodedImage> encoded_images_;
-  std::vector<std::unique_ptr<uint8_t[]>> encoded_image_buffers_;
+  std::vector<rtc::scoped_refptr<EncodedImageBufferPool::Buffer>>
+      encoded_image_buffers_;
 
   VideoCodec codec_;
   H264PacketizationMode packetization_mode_;
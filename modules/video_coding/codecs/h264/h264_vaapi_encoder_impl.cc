@@ -0,0 +1,411 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#include "modules/video_coding/codecs/h264/h264_vaapi_encoder_impl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+extern "C" {
+#include "third_party/ffmpeg/libavutil/hwcontext.h"
+#include "third_party/ffmpeg/libavutil/opt.h"
+}  // extern "C"
+
+#include "common_video/h264/h264_common.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/video_coding/utility/simulcast_utility.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv/convert_from.h"
+
+namespace webrtc {
+
+namespace {
+
+// The first DRM render node, which is the primary GPU.
+const char kVaapiDevice[] = "/dev/dri/renderD128";
+const char kVaapiEncoderName[] = "h264_vaapi";
+
+// Number of VAAPI surfaces allocated up front for uploading frames.
+const int kHwFramePoolSize = 4;
+
+// Reopening the encoder starts a new GOP, so small rate changes are left to
+// the hardware rate control rather than applied.
+const float kReconfigureBitrateRatio = 0.25f;
+
+// QP scaling thresholds, same as for OpenH264.
+const int kLowH264QpThreshold = 24;
+const int kHighH264QpThreshold = 37;
+
+// RTP timestamps are passed to FFmpeg as pts in this time base.
+const AVRational kRtpTimeBase = {1, kVideoPayloadTypeFrequency};
+
+// Splits the Annex B byte stream in |encoded_image| into one fragment per NAL
+// unit, not including the start codes.
+void RtpFragmentize(const EncodedImage& encoded_image,
+                    RTPFragmentationHeader* frag_header) {
+  std::vector<H264::NaluIndex> nalus =
+      H264::FindNaluIndices(encoded_image._buffer, encoded_image._length);
+  frag_header->VerifyAndAllocateFragmentationHeader(nalus.size());
+  for (size_t i = 0; i < nalus.size(); ++i) {
+    frag_header->fragmentationOffset[i] = nalus[i].payload_start_offset;
+    frag_header->fragmentationLength[i] = nalus[i].payload_size;
+  }
+}
+
+}  // namespace
+
+H264VaapiEncoderImpl::H264VaapiEncoderImpl(const cricket::VideoCodec& codec)
+    : packetization_mode_(H264PacketizationMode::SingleNalUnit),
+      encoded_image_callback_(nullptr),
+      configured_bps_(0),
+      target_bps_(0),
+      sending_(false) {
+  RTC_CHECK(cricket::CodecNamesEq(codec.name, cricket::kH264CodecName));
+  std::string packetization_mode_string;
+  if (codec.GetParam(cricket::kH264FmtpPacketizationMode,
+                     &packetization_mode_string) &&
+      packetization_mode_string == "1") {
+    packetization_mode_ = H264PacketizationMode::NonInterleaved;
+  }
+}
+
+H264VaapiEncoderImpl::~H264VaapiEncoderImpl() {
+  Release();
+}
+
+bool H264VaapiEncoderImpl::IsDeviceAvailable() {
+  if (!avcodec_find_encoder_by_name(kVaapiEncoderName))
+    return false;
+  AVBufferRef* device = nullptr;
+  if (av_hwdevice_ctx_create(&device, AV_HWDEVICE_TYPE_VAAPI, kVaapiDevice,
+                             nullptr, 0) < 0) {
+    return false;
+  }
+  av_buffer_unref(&device);
+  return true;
+}
+
+int32_t H264VaapiEncoderImpl::InitEncode(const VideoCodec* inst,
+                                         int32_t number_of_cores,
+                                         size_t max_payload_size) {
+  if (!inst || inst->codecType != kVideoCodecH264)
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  if (inst->maxFramerate == 0)
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  if (inst->width < 1 || inst->height < 1)
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  if (SimulcastUtility::NumberOfSimulcastStreams(*inst) > 1)
+    return WEBRTC_VIDEO_CODEC_ERR_SIMULCAST_PARAMETERS_NOT_SUPPORTED;
+
+  int32_t release_ret = Release();
+  if (release_ret != WEBRTC_VIDEO_CODEC_OK)
+    return release_ret;
+
+  codec_ = *inst;
+
+  AVBufferRef* device = nullptr;
+  int res = av_hwdevice_ctx_create(&device, AV_HWDEVICE_TYPE_VAAPI,
+                                   kVaapiDevice, nullptr, 0);
+  if (res < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to open VAAPI device " << kVaapiDevice << ": "
+                      << res;
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  hw_device_.reset(device);
+
+  hw_frames_.reset(av_hwframe_ctx_alloc(hw_device_.get()));
+  if (!hw_frames_) {
+    Release();
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
+  AVHWFramesContext* frames_context =
+      reinterpret_cast<AVHWFramesContext*>(hw_frames_->data);
+  frames_context->format = AV_PIX_FMT_VAAPI;
+  frames_context->sw_format = AV_PIX_FMT_NV12;
+  frames_context->width = codec_.width;
+  frames_context->height = codec_.height;
+  frames_context->initial_pool_size = kHwFramePoolSize;
+  res = av_hwframe_ctx_init(hw_frames_.get());
+  if (res < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to allocate VAAPI surfaces: " << res;
+    Release();
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+
+  nv12_frame_.reset(av_frame_alloc());
+  packet_.reset(av_packet_alloc());
+  if (!nv12_frame_ || !packet_) {
+    Release();
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
+  nv12_frame_->format = AV_PIX_FMT_NV12;
+  nv12_frame_->width = codec_.width;
+  nv12_frame_->height = codec_.height;
+  if (av_frame_get_buffer(nv12_frame_.get(), 32) < 0) {
+    Release();
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
+
+  // Initialize encoded image. Default buffer size: size of unencoded data.
+  encoded_image_._size =
+      CalcBufferSize(VideoType::kI420, codec_.width, codec_.height);
+  encoded_image_buffer_.reset(new uint8_t[encoded_image_._size]);
+  encoded_image_._buffer = encoded_image_buffer_.get();
+  encoded_image_._completeFrame = true;
+  encoded_image_._encodedWidth = codec_.width;
+  encoded_image_._encodedHeight = codec_.height;
+  encoded_image_._length = 0;
+
+  // Codec_settings uses kbits/second; encoder uses bits/second.
+  target_bps_ = codec_.startBitrate * 1000;
+  sending_ = target_bps_ > 0;
+  return OpenCodec();
+}
+
+int32_t H264VaapiEncoderImpl::OpenCodec() {
+  if (av_context_) {
+    // Drain the frames still in the hardware pipeline before reopening.
+    avcodec_send_frame(av_context_.get(), nullptr);
+    DeliverPackets();
+    av_context_.reset();
+  }
+  pending_frames_.clear();
+
+  AVCodec* codec = avcodec_find_encoder_by_name(kVaapiEncoderName);
+  if (!codec) {
+    // FFmpeg has been built without VAAPI support.
+    RTC_LOG(LS_ERROR) << "FFmpeg " << kVaapiEncoderName
+                      << " encoder not found.";
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  av_context_.reset(avcodec_alloc_context3(codec));
+  if (!av_context_)
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+
+  av_context_->width = codec_.width;
+  av_context_->height = codec_.height;
+  av_context_->time_base = kRtpTimeBase;
+  av_context_->framerate = {static_cast<int>(codec_.maxFramerate), 1};
+  av_context_->pix_fmt = AV_PIX_FMT_VAAPI;
+  av_context_->hw_frames_ctx = av_buffer_ref(hw_frames_.get());
+  av_context_->profile = FF_PROFILE_H264_CONSTRAINED_BASELINE;
+  // No reordering, so every packet belongs to the last frame sent.
+  av_context_->max_b_frames = 0;
+  av_context_->gop_size = codec_.H264()->keyFrameInterval > 0
+                              ? codec_.H264()->keyFrameInterval
+                              : std::numeric_limits<int>::max();
+  av_context_->bit_rate = target_bps_;
+  av_context_->rc_max_rate = codec_.maxBitrate * 1000;
+  // One second of buffering at the target rate, as for real time encoders.
+  av_context_->rc_buffer_size = target_bps_;
+  configured_bps_ = target_bps_;
+  // Return each frame as soon as it is encoded instead of pipelining several.
+  av_opt_set_int(av_context_->priv_data, "async_depth", 1, 0);
+  if (packetization_mode_ == H264PacketizationMode::SingleNalUnit) {
+    // Every NAL unit must fit in one RTP packet.
+    av_opt_set_int(av_context_->priv_data, "slices",
+                   std::max(1, codec_.height / 64), 0);
+  }
+
+  int res = avcodec_open2(av_context_.get(), codec, nullptr);
+  if (res < 0) {
+    RTC_LOG(LS_ERROR) << "avcodec_open2 error: " << res;
+    av_context_.reset();
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int32_t H264VaapiEncoderImpl::Release() {
+  av_context_.reset();
+  hw_frames_.reset();
+  hw_device_.reset();
+  nv12_frame_.reset();
+  packet_.reset();
+  pending_frames_.clear();
+  encoded_image_buffer_.reset();
+  encoded_image_._buffer = nullptr;
+  encoded_image_._size = 0;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int32_t H264VaapiEncoderImpl::RegisterEncodeCompleteCallback(
+    EncodedImageCallback* callback) {
+  encoded_image_callback_ = callback;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int32_t H264VaapiEncoderImpl::SetRateAllocation(
+    const VideoBitrateAllocation& bitrate,
+    uint32_t new_framerate) {
+  if (!av_context_)
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  if (new_framerate < 1)
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+
+  codec_.maxFramerate = new_framerate;
+  target_bps_ = bitrate.get_sum_bps();
+  // The encoder is paused when the target is zero.
+  sending_ = target_bps_ > 0;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int32_t H264VaapiEncoderImpl::Encode(
+    const VideoFrame& input_frame,
+    const CodecSpecificInfo* codec_specific_info,
+    const std::vector<FrameType>* frame_types) {
+  if (!av_context_)
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  if (!encoded_image_callback_) {
+    RTC_LOG(LS_WARNING)
+        << "InitEncode() has been called, but a callback function "
+        << "has not been set with RegisterEncodeCompleteCallback()";
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+  if (!sending_)
+    return WEBRTC_VIDEO_CODEC_OK;
+  if (frame_types && !frame_types->empty() &&
+      (*frame_types)[0] == kEmptyFrame) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  bool send_key_frame = frame_types && !frame_types->empty() &&
+                        (*frame_types)[0] == kVideoFrameKey;
+  if (target_bps_ != configured_bps_ &&
+      (configured_bps_ == 0 ||
+       std::abs(static_cast<float>(target_bps_) - configured_bps_) >
+           kReconfigureBitrateRatio * configured_bps_)) {
+    // The new encoder starts with a key frame.
+    int32_t ret = OpenCodec();
+    if (ret != WEBRTC_VIDEO_CODEC_OK)
+      return ret;
+    send_key_frame = false;
+  }
+
+  rtc::scoped_refptr<const I420BufferInterface> frame_buffer =
+      input_frame.video_frame_buffer()->ToI420();
+  RTC_DCHECK_EQ(codec_.width, frame_buffer->width());
+  RTC_DCHECK_EQ(codec_.height, frame_buffer->height());
+
+  if (av_frame_make_writable(nv12_frame_.get()) < 0)
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  libyuv::I420ToNV12(frame_buffer->DataY(), frame_buffer->StrideY(),
+                     frame_buffer->DataU(), frame_buffer->StrideU(),
+                     frame_buffer->DataV(), frame_buffer->StrideV(),
+                     nv12_frame_->data[0], nv12_frame_->linesize[0],
+                     nv12_frame_->data[1], nv12_frame_->linesize[1],
+                     frame_buffer->width(), frame_buffer->height());
+
+  std::unique_ptr<AVFrame, AVEncoderFrameDeleter> hw_frame(av_frame_alloc());
+  if (!hw_frame ||
+      av_hwframe_get_buffer(hw_frames_.get(), hw_frame.get(), 0) < 0) {
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
+  int res = av_hwframe_transfer_data(hw_frame.get(), nv12_frame_.get(), 0);
+  if (res < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to upload frame to VAAPI surface: " << res;
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  hw_frame->pts = input_frame.timestamp();
+  hw_frame->pict_type =
+      send_key_frame ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+
+  pending_frames_.push_back({input_frame.timestamp(), input_frame.ntp_time_ms(),
+                             input_frame.render_time_ms(),
+                             input_frame.rotation()});
+  res = avcodec_send_frame(av_context_.get(), hw_frame.get());
+  if (res < 0) {
+    pending_frames_.pop_back();
+    RTC_LOG(LS_ERROR) << "avcodec_send_frame error: " << res;
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  return DeliverPackets();
+}
+
+int32_t H264VaapiEncoderImpl::DeliverPackets() {
+  while (true) {
+    int res = avcodec_receive_packet(av_context_.get(), packet_.get());
+    if (res == AVERROR(EAGAIN) || res == AVERROR_EOF)
+      return WEBRTC_VIDEO_CODEC_OK;
+    if (res < 0) {
+      RTC_LOG(LS_ERROR) << "avcodec_receive_packet error: " << res;
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    RTC_DCHECK(!pending_frames_.empty());
+    if (pending_frames_.empty()) {
+      av_packet_unref(packet_.get());
+      continue;
+    }
+    const PendingFrame frame = pending_frames_.front();
+    pending_frames_.pop_front();
+
+    size_t packet_size = static_cast<size_t>(packet_->size);
+    if (packet_size > encoded_image_._size) {
+      encoded_image_._size = packet_size;
+      encoded_image_buffer_.reset(new uint8_t[encoded_image_._size]);
+      encoded_image_._buffer = encoded_image_buffer_.get();
+    }
+    memcpy(encoded_image_._buffer, packet_->data, packet_size);
+    encoded_image_._length = packet_size;
+    encoded_image_._frameType = (packet_->flags & AV_PKT_FLAG_KEY)
+                                    ? kVideoFrameKey
+                                    : kVideoFrameDelta;
+    av_packet_unref(packet_.get());
+
+    encoded_image_._encodedWidth = codec_.width;
+    encoded_image_._encodedHeight = codec_.height;
+    encoded_image_._timeStamp = frame.timestamp;
+    encoded_image_.ntp_time_ms_ = frame.ntp_time_ms;
+    encoded_image_.capture_time_ms_ = frame.capture_time_ms;
+    encoded_image_.rotation_ = frame.rotation;
+    encoded_image_.content_type_ =
+        (codec_.mode == VideoCodecMode::kScreensharing)
+            ? VideoContentType::SCREENSHARE
+            : VideoContentType::UNSPECIFIED;
+    encoded_image_.timing_.flags = VideoSendTiming::kInvalid;
+
+    RTPFragmentationHeader frag_header;
+    RtpFragmentize(encoded_image_, &frag_header);
+
+    h264_bitstream_parser_.ParseBitstream(encoded_image_._buffer,
+                                          encoded_image_._length);
+    h264_bitstream_parser_.GetLastSliceQp(&encoded_image_.qp_);
+
+    CodecSpecificInfo codec_specific;
+    codec_specific.codecType = kVideoCodecH264;
+    codec_specific.codecSpecific.H264.packetization_mode = packetization_mode_;
+    codec_specific.codecSpecific.H264.simulcast_idx = 0;
+    encoded_image_callback_->OnEncodedImage(encoded_image_, &codec_specific,
+                                            &frag_header);
+  }
+}
+
+const char* H264VaapiEncoderImpl::ImplementationName() const {
+  return "VAAPI";
+}
+
+VideoEncoder::ScalingSettings H264VaapiEncoderImpl::GetScalingSettings()
+    const {
+  return VideoEncoder::ScalingSettings(kLowH264QpThreshold,
+                                       kHighH264QpThreshold);
+}
+
+int32_t H264VaapiEncoderImpl::SetChannelParameters(uint32_t packet_loss,
+                                                   int64_t rtt) {
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+}  // namespace webrtc
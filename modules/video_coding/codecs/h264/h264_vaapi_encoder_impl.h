@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_H264_H264_VAAPI_ENCODER_IMPL_H_
+#define MODULES_VIDEO_CODING_CODECS_H264_H264_VAAPI_ENCODER_IMPL_H_
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+extern "C" {
+#include "third_party/ffmpeg/libavcodec/avcodec.h"
+}  // extern "C"
+
+#include "common_video/h264/h264_bitstream_parser.h"
+#include "modules/video_coding/codecs/h264/include/h264.h"
+
+namespace webrtc {
+
+struct AVBufferRefDeleter {
+  void operator()(AVBufferRef* ptr) const { av_buffer_unref(&ptr); }
+};
+struct AVEncoderContextDeleter {
+  void operator()(AVCodecContext* ptr) const { avcodec_free_context(&ptr); }
+};
+struct AVEncoderFrameDeleter {
+  void operator()(AVFrame* ptr) const { av_frame_free(&ptr); }
+};
+struct AVPacketDeleter {
+  void operator()(AVPacket* ptr) const { av_packet_free(&ptr); }
+};
+
+// H.264 encoder using the VAAPI hardware encoder of Intel and AMD GPUs,
+// through FFmpeg's "h264_vaapi" encoder. Frames are converted to NV12 and
+// uploaded to a VAAPI surface before encoding. Only a single stream is
+// encoded; wrap the encoder factory in a SimulcastEncoderAdapter for
+// simulcast.
+class H264VaapiEncoderImpl : public H264Encoder {
+ public:
+  explicit H264VaapiEncoderImpl(const cricket::VideoCodec& codec);
+  ~H264VaapiEncoderImpl() override;
+
+  // Returns true if a VAAPI device with H.264 encoding support can be opened.
+  static bool IsDeviceAvailable();
+
+  // |max_payload_size| is ignored.
+  int32_t InitEncode(const VideoCodec* codec_settings,
+                     int32_t number_of_cores,
+                     size_t max_payload_size) override;
+  int32_t Release() override;
+
+  int32_t RegisterEncodeCompleteCallback(
+      EncodedImageCallback* callback) override;
+  int32_t SetRateAllocation(const VideoBitrateAllocation& bitrate_allocation,
+                            uint32_t framerate) override;
+
+  int32_t Encode(const VideoFrame& frame,
+                 const CodecSpecificInfo* codec_specific_info,
+                 const std::vector<FrameType>* frame_types) override;
+
+  const char* ImplementationName() const override;
+
+  VideoEncoder::ScalingSettings GetScalingSettings() const override;
+
+  // Unsupported / Do nothing.
+  int32_t SetChannelParameters(uint32_t packet_loss, int64_t rtt) override;
+
+ private:
+  // Metadata of a frame passed to FFmpeg, kept until its packet comes out.
+  struct PendingFrame {
+    uint32_t timestamp;
+    int64_t ntp_time_ms;
+    int64_t capture_time_ms;
+    VideoRotation rotation;
+  };
+
+  // (Re)opens |av_context_| with the current rate settings. The hardware
+  // device and frame pool are kept.
+  int32_t OpenCodec();
+  // Delivers all packets FFmpeg has ready to the encode complete callback.
+  int32_t DeliverPackets();
+
+  std::unique_ptr<AVBufferRef, AVBufferRefDeleter> hw_device_;
+  std::unique_ptr<AVBufferRef, AVBufferRefDeleter> hw_frames_;
+  std::unique_ptr<AVCodecContext, AVEncoderContextDeleter> av_context_;
+  std::unique_ptr<AVFrame, AVEncoderFrameDeleter> nv12_frame_;
+  std::unique_ptr<AVPacket, AVPacketDeleter> packet_;
+  std::deque<PendingFrame> pending_frames_;
+
+  EncodedImage encoded_image_;
+  std::unique_ptr<uint8_t[]> encoded_image_buffer_;
+
+  VideoCodec codec_;
+  H264PacketizationMode packetization_mode_;
+  EncodedImageCallback* encoded_image_callback_;
+  // Bitrate |av_context_| was opened with, and the latest requested one.
+  uint32_t configured_bps_;
+  uint32_t target_bps_;
+  bool sending_;
+
+  H264BitstreamParser h264_bitstream_parser_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_H264_H264_VAAPI_ENCODER_IMPL_H_
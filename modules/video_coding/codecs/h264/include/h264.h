@@ -41,6 +41,14 @@ class H264Encoder : public VideoEncoder {
   ~H264Encoder() override {}
 };
 
+// Creates an H.264 encoder that uses a VAAPI hardware encoder, for Intel and
+// AMD GPUs on Linux. Only available when built with |rtc_use_vaapi| and when
+// a VAAPI device with H.264 encoding support is present, see
+// IsH264VaapiEncoderSupported().
+std::unique_ptr<H264Encoder> CreateH264VaapiEncoder(
+    const cricket::VideoCodec& codec);
+bool IsH264VaapiEncoderSupported();
+
 class H264Decoder : public VideoDecoder {
  public:
   static std::unique_ptr<H264Decoder> Create();
@@ -94,8 +94,11 @@ struct MultiplexImage {
 //    component.
 class MultiplexEncodedImagePacker {
  public:
-  // Note: It is caller responsibility to release the buffer of the result.
-  static EncodedImage PackAndRelease(const MultiplexImage& image);
+  // Packs the components of |image| into one encoded image, whose buffer is
+  // |*buffer|, resized to fit. The buffers of the components aren't
+  // released, and |*buffer| can be reused for every image packed.
+  static EncodedImage Pack(const MultiplexImage& image,
+                           std::vector<uint8_t>* buffer);
 
   // Note: The image components just share the memory with |combined_image|.
   static MultiplexImage Unpack(const EncodedImage& combined_image);
@@ -21,6 +21,7 @@
 #include "modules/video_coding/codecs/multiplex/include/multiplex_encoded_image_packer.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/criticalsection.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -75,8 +76,12 @@ class MultiplexEncoderAdapter : public VideoEncoder {
 
   int key_frame_interval_;
   EncodedImage combined_image_;
+  std::vector<uint8_t> combined_image_buffer_;
 
   rtc::CriticalSection crit_;
+  // Encodes the alpha of a frame while the YUV is encoded on the calling
+  // thread. Null if there's only one core.
+  std::unique_ptr<rtc::TaskQueue> alpha_encoder_queue_;
 };
 
 }  // namespace webrtc
@@ -10,11 +10,13 @@
 
 #include "modules/video_coding/codecs/multiplex/include/multiplex_decoder_adapter.h"
 
+#include "absl/memory/memory.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/include/video_frame.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "rtc_base/event.h"
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/logging.h"
 
@@ -105,6 +107,10 @@ int32_t MultiplexDecoderAdapter::InitDecode(const VideoCodec* codec_settings,
     decoder->RegisterDecodeCompleteCallback(adapter_callbacks_.back().get());
     decoders_.emplace_back(std::move(decoder));
   }
+  if (number_of_cores > 1) {
+    alpha_decoder_queue_ =
+        absl::make_unique<rtc::TaskQueue>("MultiplexAlphaDecoder");
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -117,12 +123,41 @@ int32_t MultiplexDecoderAdapter::Decode(
       MultiplexEncodedImagePacker::Unpack(input_image);
 
   if (image.component_count == 1) {
+    rtc::CritScope cs(&crit_);
     RTC_DCHECK(decoded_data_.find(input_image._timeStamp) ==
                decoded_data_.end());
     decoded_data_.emplace(std::piecewise_construct,
                           std::forward_as_tuple(input_image._timeStamp),
                           std::forward_as_tuple(kAXXStream));
   }
+
+  if (alpha_decoder_queue_ && image.image_components.size() == 2 &&
+      image.image_components[0].component_index !=
+          image.image_components[1].component_index) {
+    // Decode both components at the same time, and wait for both, so that
+    // the decoders are never used by two threads at once.
+    const MultiplexImageComponent& alpha_component =
+        image.image_components[0].component_index == kAXXStream
+            ? image.image_components[0]
+            : image.image_components[1];
+    const MultiplexImageComponent& yuv_component =
+        image.image_components[0].component_index == kAXXStream
+            ? image.image_components[1]
+            : image.image_components[0];
+    rtc::Event alpha_decoded(false /* manual_reset */, false);
+    int32_t alpha_rv = WEBRTC_VIDEO_CODEC_OK;
+    alpha_decoder_queue_->PostTask([&] {
+      alpha_rv = decoders_[kAXXStream]->Decode(
+          alpha_component.encoded_image, missing_frames, nullptr,
+          render_time_ms);
+      alpha_decoded.Set();
+    });
+    const int32_t rv = decoders_[kYUVStream]->Decode(
+        yuv_component.encoded_image, missing_frames, nullptr, render_time_ms);
+    alpha_decoded.Wait(rtc::Event::kForever);
+    return rv != WEBRTC_VIDEO_CODEC_OK ? rv : alpha_rv;
+  }
+
   int32_t rv = 0;
   for (size_t i = 0; i < image.image_components.size(); i++) {
     rv = decoders_[image.image_components[i].component_index]->Decode(
@@ -148,6 +183,7 @@ int32_t MultiplexDecoderAdapter::Release() {
   }
   decoders_.clear();
   adapter_callbacks_.clear();
+  alpha_decoder_queue_.reset();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -155,6 +191,7 @@ void MultiplexDecoderAdapter::Decoded(AlphaCodecStream stream_idx,
                                       VideoFrame* decoded_image,
                                       absl::optional<int32_t> decode_time_ms,
                                       absl::optional<uint8_t> qp) {
+  rtc::CritScope cs(&crit_);
   const auto& other_decoded_data_it =
       decoded_data_.find(decoded_image->timestamp());
   if (other_decoded_data_it != decoded_data_.end()) {
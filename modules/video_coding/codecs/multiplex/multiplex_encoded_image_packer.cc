@@ -109,15 +109,16 @@ MultiplexImageComponentHeader UnpackFrameHeader(uint8_t* buffer) {
   return frame_header;
 }
 
-void PackBitstream(uint8_t* buffer, MultiplexImageComponent image) {
+void PackBitstream(uint8_t* buffer, const MultiplexImageComponent& image) {
   memcpy(buffer, image.encoded_image._buffer, image.encoded_image._length);
 }
 
 MultiplexImage::MultiplexImage(uint16_t picture_index, uint8_t frame_count)
     : image_index(picture_index), component_count(frame_count) {}
 
-EncodedImage MultiplexEncodedImagePacker::PackAndRelease(
-    const MultiplexImage& multiplex_image) {
+EncodedImage MultiplexEncodedImagePacker::Pack(
+    const MultiplexImage& multiplex_image,
+    std::vector<uint8_t>* buffer) {
   MultiplexImageHeader header;
   std::vector<MultiplexImageComponentHeader> frame_headers;
 
@@ -160,8 +161,9 @@ EncodedImage MultiplexEncodedImagePacker::PackAndRelease(
     frame_headers.push_back(frame_header);
   }
 
+  buffer->resize(bitstream_offset);
   combined_image._length = combined_image._size = bitstream_offset;
-  combined_image._buffer = new uint8_t[combined_image._length];
+  combined_image._buffer = buffer->data();
 
   // header
   header_offset = PackHeader(combined_image._buffer, header);
@@ -186,7 +188,9 @@ EncodedImage MultiplexEncodedImagePacker::PackAndRelease(
   for (size_t i = 0; i < images.size(); i++) {
     PackBitstream(combined_image._buffer + frame_headers[i].bitstream_offset,
                   images[i]);
-    delete[] images[i].encoded_image._buffer;
+    const size_t length = images[i].encoded_image._length;
+    memset(combined_image._buffer + frame_headers[i].bitstream_offset + length,
+           0, frame_headers[i].bitstream_length - length);
   }
 
   return combined_image;
@@ -10,12 +10,15 @@
 
 #include "modules/video_coding/codecs/multiplex/include/multiplex_encoder_adapter.h"
 
+#include <algorithm>
 #include <cstring>
 
+#include "absl/memory/memory.h"
 #include "common_video/include/video_frame.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/include/module_common_types.h"
+#include "rtc_base/event.h"
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/logging.h"
 
@@ -103,6 +106,10 @@ int MultiplexEncoderAdapter::InitEncode(const VideoCodec* inst,
     encoder->RegisterEncodeCompleteCallback(adapter_callbacks_.back().get());
     encoders_.emplace_back(std::move(encoder));
   }
+  if (number_of_cores > 1) {
+    alpha_encoder_queue_ =
+        absl::make_unique<rtc::TaskQueue>("MultiplexAlphaEncoder");
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -133,16 +140,14 @@ int MultiplexEncoderAdapter::Encode(
 
   ++picture_index_;
 
-  // Encode YUV
-  int rv = encoders_[kYUVStream]->Encode(input_image, codec_specific_info,
-                                         &adjusted_frame_types);
   // If we do not receive an alpha frame, we send a single frame for this
   // |picture_index_|. The receiver will receive |frame_count| as 1 which
   // soecifies this case.
-  if (rv || !has_alpha)
-    return rv;
+  if (!has_alpha) {
+    return encoders_[kYUVStream]->Encode(input_image, codec_specific_info,
+                                         &adjusted_frame_types);
+  }
 
-  // Encode AXX
   const I420ABufferInterface* yuva_buffer =
       input_image.video_frame_buffer()->GetI420A();
   rtc::scoped_refptr<I420BufferInterface> alpha_buffer =
@@ -153,9 +158,29 @@ int MultiplexEncoderAdapter::Encode(
                      rtc::KeepRefUntilDone(input_image.video_frame_buffer()));
   VideoFrame alpha_image(alpha_buffer, input_image.timestamp(),
                          input_image.render_time_ms(), input_image.rotation());
-  rv = encoders_[kAXXStream]->Encode(alpha_image, codec_specific_info,
-                                     &adjusted_frame_types);
-  return rv;
+
+  if (!alpha_encoder_queue_) {
+    int rv = encoders_[kYUVStream]->Encode(input_image, codec_specific_info,
+                                           &adjusted_frame_types);
+    if (rv)
+      return rv;
+    return encoders_[kAXXStream]->Encode(alpha_image, codec_specific_info,
+                                         &adjusted_frame_types);
+  }
+
+  // Encode YUV and AXX at the same time, and wait for both, so that the
+  // encoders are never used by two threads at once.
+  rtc::Event alpha_encoded(false /* manual_reset */, false);
+  int alpha_rv = WEBRTC_VIDEO_CODEC_OK;
+  alpha_encoder_queue_->PostTask([&] {
+    alpha_rv = encoders_[kAXXStream]->Encode(alpha_image, codec_specific_info,
+                                             &adjusted_frame_types);
+    alpha_encoded.Set();
+  });
+  const int rv = encoders_[kYUVStream]->Encode(input_image, codec_specific_info,
+                                               &adjusted_frame_types);
+  alpha_encoded.Wait(rtc::Event::kForever);
+  return rv ? rv : alpha_rv;
 }
 
 int MultiplexEncoderAdapter::RegisterEncodeCompleteCallback(
@@ -197,6 +222,7 @@ int MultiplexEncoderAdapter::Release() {
   }
   encoders_.clear();
   adapter_callbacks_.clear();
+  alpha_encoder_queue_.reset();
   rtc::CritScope cs(&crit_);
   for (auto& stashed_image : stashed_images_) {
     for (auto& image_component : stashed_image.second.image_components) {
@@ -204,10 +230,8 @@ int MultiplexEncoderAdapter::Release() {
     }
   }
   stashed_images_.clear();
-  if (combined_image_._buffer) {
-    delete[] combined_image_._buffer;
-    combined_image_._buffer = nullptr;
-  }
+  combined_image_._buffer = nullptr;
+  combined_image_buffer_.clear();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -220,15 +244,11 @@ EncodedImageCallback::Result MultiplexEncoderAdapter::OnEncodedImage(
     const EncodedImage& encodedImage,
     const CodecSpecificInfo* codecSpecificInfo,
     const RTPFragmentationHeader* fragmentation) {
-  // Save the image
   MultiplexImageComponent image_component;
   image_component.component_index = stream_idx;
   image_component.codec_type =
       PayloadStringToCodecType(associated_format_.name);
   image_component.encoded_image = encodedImage;
-  image_component.encoded_image._buffer = new uint8_t[encodedImage._length];
-  std::memcpy(image_component.encoded_image._buffer, encodedImage._buffer,
-              encodedImage._length);
 
   rtc::CritScope cs(&crit_);
   const auto& stashed_image_itr = stashed_images_.find(encodedImage._timeStamp);
@@ -237,33 +257,53 @@ EncodedImageCallback::Result MultiplexEncoderAdapter::OnEncodedImage(
   MultiplexImage& stashed_image = stashed_image_itr->second;
   const uint8_t frame_count = stashed_image.component_count;
 
-  stashed_image.image_components.push_back(image_component);
-
-  if (stashed_image.image_components.size() == frame_count) {
-    // Complete case
-    for (auto iter = stashed_images_.begin();
-         iter != stashed_images_.end() && iter != stashed_image_next_itr;
-         iter++) {
-      // No image at all, skip.
-      if (iter->second.image_components.size() == 0)
-        continue;
-
-      // We have to send out those stashed frames, otherwise the delta frame
-      // dependency chain is broken.
-      if (combined_image_._buffer)
-        delete[] combined_image_._buffer;
-      combined_image_ =
-          MultiplexEncodedImagePacker::PackAndRelease(iter->second);
-
-      CodecSpecificInfo codec_info = *codecSpecificInfo;
-      codec_info.codecType = kVideoCodecMultiplex;
-      codec_info.codecSpecific.generic.simulcast_idx = 0;
-      encoded_complete_callback_->OnEncodedImage(combined_image_, &codec_info,
-                                                 fragmentation);
-    }
+  // The components are packed in the order of their index, whichever encoder
+  // finished first.
+  std::vector<MultiplexImageComponent>& components =
+      stashed_image.image_components;
+  auto position = std::upper_bound(
+      components.begin(), components.end(), image_component,
+      [](const MultiplexImageComponent& a, const MultiplexImageComponent& b) {
+        return a.component_index < b.component_index;
+      });
 
-    stashed_images_.erase(stashed_images_.begin(), stashed_image_next_itr);
+  if (components.size() + 1 < frame_count) {
+    // Save a copy of the image until the other components are encoded.
+    image_component.encoded_image._buffer = new uint8_t[encodedImage._length];
+    std::memcpy(image_component.encoded_image._buffer, encodedImage._buffer,
+                encodedImage._length);
+    components.insert(position, image_component);
+    return EncodedImageCallback::Result(EncodedImageCallback::Result::OK);
   }
+
+  // Complete case. The last component is packed straight from the buffer of
+  // its encoder.
+  components.insert(position, image_component);
+  for (auto iter = stashed_images_.begin();
+       iter != stashed_images_.end() && iter != stashed_image_next_itr;
+       iter++) {
+    // No image at all, skip.
+    if (iter->second.image_components.size() == 0)
+      continue;
+
+    // We have to send out those stashed frames, otherwise the delta frame
+    // dependency chain is broken.
+    combined_image_ = MultiplexEncodedImagePacker::Pack(
+        iter->second, &combined_image_buffer_);
+
+    CodecSpecificInfo codec_info = *codecSpecificInfo;
+    codec_info.codecType = kVideoCodecMultiplex;
+    codec_info.codecSpecific.generic.simulcast_idx = 0;
+    encoded_complete_callback_->OnEncodedImage(combined_image_, &codec_info,
+                                               fragmentation);
+
+    for (const auto& component : iter->second.image_components) {
+      if (component.encoded_image._buffer != encodedImage._buffer)
+        delete[] component.encoded_image._buffer;
+    }
+  }
+
+  stashed_images_.erase(stashed_images_.begin(), stashed_image_next_itr);
   return EncodedImageCallback::Result(EncodedImageCallback::Result::OK);
 }
 
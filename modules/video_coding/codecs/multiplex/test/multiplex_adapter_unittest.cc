@@ -24,6 +24,7 @@
 #include "test/video_codec_settings.h"
 
 using testing::_;
+using testing::InvokeWithoutArgs;
 using testing::Return;
 
 namespace webrtc {
@@ -92,14 +93,18 @@ class TestMultiplexAdapter : public VideoCodecUnitTest {
     VideoDecoder* decoder2 = VP9Decoder::Create().release();
     EXPECT_CALL(*decoder_factory_, CreateVideoDecoderProxy(_))
         .WillOnce(Return(decoder1))
-        .WillOnce(Return(decoder2));
+        .WillOnce(Return(decoder2))
+        .WillRepeatedly(InvokeWithoutArgs(
+            [] { return VP9Decoder::Create().release(); }));
 
     EXPECT_CALL(*encoder_factory_, Die());
     VideoEncoder* encoder1 = VP9Encoder::Create().release();
     VideoEncoder* encoder2 = VP9Encoder::Create().release();
     EXPECT_CALL(*encoder_factory_, CreateVideoEncoderProxy(_))
         .WillOnce(Return(encoder1))
-        .WillOnce(Return(encoder2));
+        .WillOnce(Return(encoder2))
+        .WillRepeatedly(InvokeWithoutArgs(
+            [] { return VP9Encoder::Create().release(); }));
 
     VideoCodecUnitTest::SetUp();
   }
@@ -161,6 +166,37 @@ TEST_F(TestMultiplexAdapter, EncodeDecodeI420AFrame) {
   EXPECT_GT(I420PSNR(input_axx_frame.get(), output_axx_frame.get()), 47);
 }
 
+TEST_F(TestMultiplexAdapter, EncodeDecodeI420AFrameOnMultipleCores) {
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Release());
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder_->Release());
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->InitEncode(&codec_settings_, 2 /* number of cores */,
+                                 0 /* max payload size (unused) */));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder_->InitDecode(&codec_settings_, 2 /* number of cores */));
+
+  std::unique_ptr<VideoFrame> yuva_frame = CreateI420AInputFrame();
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*yuva_frame, nullptr, nullptr));
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+
+  const MultiplexImage& unpacked_frame =
+      MultiplexEncodedImagePacker::Unpack(encoded_frame);
+  ASSERT_EQ(2u, unpacked_frame.image_components.size());
+  EXPECT_EQ(0, unpacked_frame.image_components[0].component_index);
+  EXPECT_EQ(1, unpacked_frame.image_components[1].component_index);
+
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder_->Decode(encoded_frame, false, nullptr, 0));
+  std::unique_ptr<VideoFrame> decoded_frame;
+  absl::optional<uint8_t> decoded_qp;
+  ASSERT_TRUE(WaitForDecodedFrame(&decoded_frame, &decoded_qp));
+  ASSERT_TRUE(decoded_frame);
+  EXPECT_GT(I420PSNR(yuva_frame.get(), decoded_frame.get()), 36);
+}
+
 TEST_F(TestMultiplexAdapter, CheckSingleFrameEncodedBitstream) {
   VideoFrame* input_frame = NextInputFrame();
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
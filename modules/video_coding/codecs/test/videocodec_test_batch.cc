@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/test/videocodec_test_batch.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "modules/video_coding/codecs/test/videocodec_test_fixture_impl.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+std::string DefaultTestName(const VideoCodecTestFixture::Config& config) {
+  std::stringstream ss;
+  ss << config.filename << "_" << config.CodecName() << "_"
+     << config.codec_settings.width << "x" << config.codec_settings.height;
+  return ss.str();
+}
+
+}  // namespace
+
+VideoCodecTestBatch::Test::Test() = default;
+VideoCodecTestBatch::Test::Test(const Test&) = default;
+VideoCodecTestBatch::Test::~Test() = default;
+
+VideoCodecTestBatch::Result::Result() = default;
+VideoCodecTestBatch::Result::Result(const Result&) = default;
+VideoCodecTestBatch::Result::~Result() = default;
+
+VideoCodecTestBatch::VideoCodecTestBatch(std::vector<Test> tests,
+                                         const Settings& settings)
+    : VideoCodecTestBatch(std::move(tests),
+                          settings,
+                          [](const VideoCodecTestFixture::Config& config) {
+                            return absl::make_unique<VideoCodecTestFixtureImpl>(
+                                config);
+                          }) {}
+
+VideoCodecTestBatch::VideoCodecTestBatch(std::vector<Test> tests,
+                                         const Settings& settings,
+                                         FixtureFactory fixture_factory)
+    : tests_(std::move(tests)),
+      settings_(settings),
+      fixture_factory_(std::move(fixture_factory)) {
+  RTC_CHECK_GT(settings_.num_shards, 0);
+  RTC_CHECK_LT(settings_.shard_index, settings_.num_shards);
+  for (size_t i = settings_.shard_index; i < tests_.size();
+       i += settings_.num_shards) {
+    shard_tests_.push_back(i);
+  }
+}
+
+VideoCodecTestBatch::~VideoCodecTestBatch() = default;
+
+std::vector<VideoCodecTestBatch::Result> VideoCodecTestBatch::Run() {
+  results_.clear();
+  results_.resize(shard_tests_.size());
+  next_test_ = 0;
+
+  size_t num_threads = settings_.num_threads > 0
+                           ? settings_.num_threads
+                           : CpuInfo::DetectNumberOfCores();
+  num_threads = std::min(num_threads, shard_tests_.size());
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.push_back(absl::make_unique<rtc::PlatformThread>(
+        &VideoCodecTestBatch::RunThread, this, "VidCodecTestBatch"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+
+  return std::move(results_);
+}
+
+std::string VideoCodecTestBatch::Report(const std::vector<Result>& results) {
+  std::stringstream ss;
+  ss << "name target_bitrate_kbps bitrate_kbps input_framerate_fps "
+        "framerate_fps width height enc_speed_fps dec_speed_fps avg_qp "
+        "avg_psnr min_psnr avg_ssim min_ssim num_dropped_frames";
+  for (const Result& result : results) {
+    for (const VideoCodecTestStats::VideoStatistics& stats :
+         result.send_stats) {
+      ss << "\n"
+         << result.name << " " << stats.target_bitrate_kbps << " "
+         << stats.bitrate_kbps << " " << stats.input_framerate_fps << " "
+         << stats.framerate_fps << " " << stats.width << " " << stats.height
+         << " " << stats.enc_speed_fps << " " << stats.dec_speed_fps << " "
+         << stats.avg_qp << " " << stats.avg_psnr << " " << stats.min_psnr
+         << " " << stats.avg_ssim << " " << stats.min_ssim << " "
+         << stats.num_input_frames - stats.num_encoded_frames;
+    }
+  }
+  return ss.str();
+}
+
+void VideoCodecTestBatch::RunThread(void* obj) {
+  static_cast<VideoCodecTestBatch*>(obj)->RunTests();
+}
+
+void VideoCodecTestBatch::RunTests() {
+  while (true) {
+    const size_t index = rtc::AtomicOps::Increment(&next_test_) - 1;
+    if (index >= shard_tests_.size())
+      return;
+    const Test& test = tests_[shard_tests_[index]];
+    RTC_DCHECK(!test.config.measure_cpu);
+
+    std::unique_ptr<VideoCodecTestFixture> fixture =
+        fixture_factory_(test.config);
+    fixture->RunTest(test.rate_profiles, nullptr, nullptr, nullptr);
+
+    // Each thread writes the results of its own tests only.
+    Result& result = results_[index];
+    result.name = test.name.empty() ? DefaultTestName(test.config) : test.name;
+    size_t first_frame_num = 0;
+    for (const RateProfile& rate_profile : test.rate_profiles) {
+      if (first_frame_num >= test.config.num_frames)
+        break;
+      const size_t last_frame_num =
+          std::min(rate_profile.frame_index_rate_update,
+                   test.config.num_frames) -
+          1;
+      result.send_stats.push_back(
+          fixture->GetStats().SliceAndCalcAggregatedVideoStatistic(
+              first_frame_num, last_frame_num));
+      first_frame_num = rate_profile.frame_index_rate_update;
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_BATCH_H_
+#define MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_BATCH_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/test/videocodec_test_fixture.h"
+#include "api/test/videocodec_test_stats.h"
+
+namespace webrtc {
+namespace test {
+
+// Runs a batch of codec tests, e.g. all combinations of codecs, bitrates,
+// resolutions and clips of an encoder settings evaluation, in parallel, and
+// collects their statistics into one report.
+//
+// Each test runs its own fixture, with its own codecs and task queue. Tests
+// should set |use_single_core| in their configs, so that the tests running in
+// parallel don't compete for the cores, and must not set |measure_cpu|, which
+// measures the CPU usage of the whole process.
+class VideoCodecTestBatch {
+ public:
+  struct Test {
+    Test();
+    Test(const Test&);
+    ~Test();
+
+    // Name of the test in the report. If empty, it's derived from |config|.
+    std::string name;
+    VideoCodecTestFixture::Config config;
+    std::vector<RateProfile> rate_profiles;
+  };
+
+  struct Result {
+    Result();
+    Result(const Result&);
+    ~Result();
+
+    std::string name;
+    // Send statistics of each rate profile of the test.
+    std::vector<VideoCodecTestStats::VideoStatistics> send_stats;
+  };
+
+  struct Settings {
+    // Number of tests run at once. If 0, the number of cores.
+    size_t num_threads = 0;
+    // The tests of a batch can be split between processes, e.g. between
+    // machines, by running it in |num_shards| processes. The process with
+    // |shard_index| runs the tests whose index in the batch is |shard_index|
+    // modulo |num_shards|.
+    size_t shard_index = 0;
+    size_t num_shards = 1;
+  };
+
+  using FixtureFactory = std::function<std::unique_ptr<VideoCodecTestFixture>(
+      const VideoCodecTestFixture::Config&)>;
+
+  // Creates the fixtures with CreateVideoCodecTestFixture().
+  VideoCodecTestBatch(std::vector<Test> tests, const Settings& settings);
+  VideoCodecTestBatch(std::vector<Test> tests,
+                      const Settings& settings,
+                      FixtureFactory fixture_factory);
+  ~VideoCodecTestBatch();
+
+  // Runs the tests of this shard, and returns their results in batch order.
+  std::vector<Result> Run();
+
+  // Formats |results| as a table, with one line per rate profile of a test.
+  static std::string Report(const std::vector<Result>& results);
+
+ private:
+  static void RunThread(void* obj);
+  void RunTests();
+
+  const std::vector<Test> tests_;
+  const Settings settings_;
+  const FixtureFactory fixture_factory_;
+
+  // Indices of the tests of this shard, and their results.
+  std::vector<size_t> shard_tests_;
+  std::vector<Result> results_;
+  // Index into |shard_tests_| of the next test to run.
+  volatile int next_test_ = 0;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_BATCH_H_
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/test/videocodec_test_batch.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "modules/video_coding/codecs/test/videocodec_test_stats_impl.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+const size_t kNumFrames = 10;
+const size_t kFrameSizeBytes = 1000;
+
+// Encodes each frame to |kFrameSizeBytes| bytes, at the target bitrate of the
+// test.
+class FakeVideoCodecTestFixture : public VideoCodecTestFixture {
+ public:
+  explicit FakeVideoCodecTestFixture(const Config& config) : config_(config) {}
+
+  void RunTest(const std::vector<RateProfile>& rate_profiles,
+               const std::vector<RateControlThresholds>* rc_thresholds,
+               const std::vector<QualityThresholds>* quality_thresholds,
+               const BitstreamThresholds* bs_thresholds) override {
+    for (size_t i = 0; i < config_.num_frames; ++i) {
+      VideoCodecTestStats::FrameStatistics* frame_stat =
+          stats_.AddFrame(i * 3000, 0);
+      frame_stat->encoding_successful = true;
+      frame_stat->length_bytes = kFrameSizeBytes;
+      frame_stat->target_bitrate_kbps = rate_profiles[0].target_kbps;
+    }
+  }
+
+  VideoCodecTestStats& GetStats() override { return stats_; }
+
+ private:
+  const Config config_;
+  VideoCodecTestStatsImpl stats_;
+};
+
+std::vector<VideoCodecTestBatch::Test> CreateTests(size_t num_tests) {
+  std::vector<VideoCodecTestBatch::Test> tests(num_tests);
+  for (size_t i = 0; i < num_tests; ++i) {
+    tests[i].name = "test" + std::to_string(i);
+    tests[i].config.num_frames = kNumFrames;
+    tests[i].rate_profiles = {{100 * (i + 1), 30, kNumFrames}};
+  }
+  return tests;
+}
+
+VideoCodecTestBatch::FixtureFactory FakeFixtureFactory() {
+  return [](const VideoCodecTestFixture::Config& config) {
+    return absl::make_unique<FakeVideoCodecTestFixture>(config);
+  };
+}
+
+}  // namespace
+
+TEST(VideoCodecTestBatchTest, RunsAllTestsInOrder) {
+  VideoCodecTestBatch::Settings settings;
+  settings.num_threads = 3;
+  VideoCodecTestBatch batch(CreateTests(8), settings, FakeFixtureFactory());
+
+  std::vector<VideoCodecTestBatch::Result> results = batch.Run();
+  ASSERT_EQ(8u, results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ("test" + std::to_string(i), results[i].name);
+    ASSERT_EQ(1u, results[i].send_stats.size());
+    EXPECT_EQ(100 * (i + 1), results[i].send_stats[0].target_bitrate_kbps);
+    EXPECT_EQ(kNumFrames, results[i].send_stats[0].num_encoded_frames);
+  }
+}
+
+TEST(VideoCodecTestBatchTest, RunsTestsOfShard) {
+  VideoCodecTestBatch::Settings settings;
+  settings.shard_index = 1;
+  settings.num_shards = 3;
+  VideoCodecTestBatch batch(CreateTests(8), settings, FakeFixtureFactory());
+
+  std::vector<VideoCodecTestBatch::Result> results = batch.Run();
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ("test1", results[0].name);
+  EXPECT_EQ("test4", results[1].name);
+  EXPECT_EQ("test7", results[2].name);
+}
+
+TEST(VideoCodecTestBatchTest, ReportsEachTest) {
+  VideoCodecTestBatch batch(CreateTests(2), VideoCodecTestBatch::Settings(),
+                            FakeFixtureFactory());
+
+  const std::string report = VideoCodecTestBatch::Report(batch.Run());
+  EXPECT_EQ(0u, report.find("name target_bitrate_kbps"));
+  EXPECT_NE(std::string::npos, report.find("\ntest0 100 "));
+  EXPECT_NE(std::string::npos, report.find("\ntest1 200 "));
+}
+
+}  // namespace test
+}  // namespace webrtc
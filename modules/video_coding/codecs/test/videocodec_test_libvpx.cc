@@ -458,6 +458,30 @@ TEST(VideoCodecTestLibvpx, DISABLED_MultiresVP8RdPerf) {
   PrintRdPerf(rd_stats);
 }
 
+// Compares VP8 decoding throughput at 720p when decoders may use one core and
+// when they may use all cores.
+TEST(VideoCodecTestLibvpx, DISABLED_DecodeSpeedVP8) {
+  printf("%15s %13s\n", "use_single_core", "dec_speed_fps");
+  for (bool use_single_core : {true, false}) {
+    auto config = CreateConfig();
+    config.filename = "FourPeople_1280x720_30";
+    config.filepath = ResourcePath(config.filename, "yuv");
+    config.num_frames = 300;
+    config.use_single_core = use_single_core;
+    config.SetCodecSettings(cricket::kVp8CodecName, 1, 1, 1, false, true,
+                            false, 1280, 720);
+    auto fixture = CreateVideoCodecTestFixture(config);
+
+    std::vector<RateProfile> rate_profiles = {{2000, 30, config.num_frames}};
+    fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+
+    VideoStatistics stats =
+        fixture->GetStats().SliceAndCalcAggregatedVideoStatistic(
+            0, config.num_frames - 1);
+    printf("%15d %13.2f\n", use_single_core, stats.dec_speed_fps);
+  }
+}
+
 TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9RdPerf) {
   auto config = CreateConfig();
   config.filename = "FourPeople_1280x720_30";
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 #include <string>
 
 #include "absl/memory/memory.h"
@@ -31,6 +32,9 @@ constexpr int kVp8ErrorPropagationTh = 30;
 constexpr long kDecodeDeadlineRealtime = 1;  // NOLINT
 
 const char kVp8PostProcArmFieldTrial[] = "WebRTC-VP8-Postproc-Config-Arm";
+// Caps the number of decoding threads, e.g. "Enabled-2". Decoders of a server
+// receiving many streams can be limited to one thread each this way.
+const char kVp8DecoderMaxThreadsFieldTrial[] = "WebRTC-VP8-DecoderMaxThreads";
 
 void GetPostProcParamsFromFieldTrialGroup(
     LibvpxVp8Decoder::DeblockParams* deblock_params) {
@@ -53,6 +57,17 @@ void GetPostProcParamsFromFieldTrialGroup(
   *deblock_params = params;
 }
 
+int GetMaxThreadsFromFieldTrialGroup() {
+  std::string group =
+      webrtc::field_trial::FindFullName(kVp8DecoderMaxThreadsFieldTrial);
+  int max_threads;
+  if (sscanf(group.c_str(), "Enabled-%d", &max_threads) != 1 ||
+      max_threads < 1) {
+    return std::numeric_limits<int>::max();
+  }
+  return max_threads;
+}
+
 }  // namespace
 
 std::unique_ptr<VP8Decoder> VP8Decoder::Create() {
@@ -94,6 +109,9 @@ LibvpxVp8Decoder::LibvpxVp8Decoder()
       last_frame_width_(0),
       last_frame_height_(0),
       key_frame_required_(true),
+      number_of_cores_(1),
+      num_threads_(1),
+      max_threads_(GetMaxThreadsFromFieldTrialGroup()),
       qp_smoother_(use_postproc_arm_ ? new QpSmoother() : nullptr) {
   if (use_postproc_arm_)
     GetPostProcParamsFromFieldTrialGroup(&deblock_);
@@ -109,13 +127,27 @@ int LibvpxVp8Decoder::InitDecode(const VideoCodec* inst, int number_of_cores) {
   if (ret_val < 0) {
     return ret_val;
   }
+  number_of_cores_ = number_of_cores;
+  int width = inst ? inst->width : 0;
+  int height = inst ? inst->height : 0;
+  ret_val = InitDecoder(NumberOfThreads(width, height));
+  if (ret_val != WEBRTC_VIDEO_CODEC_OK)
+    return ret_val;
+
+  propagation_cnt_ = -1;
+
+  // Always start with a complete key frame.
+  key_frame_required_ = true;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int LibvpxVp8Decoder::InitDecoder(int num_threads) {
   if (decoder_ == NULL) {
     decoder_ = new vpx_codec_ctx_t;
     memset(decoder_, 0, sizeof(*decoder_));
   }
   vpx_codec_dec_cfg_t cfg;
-  // Setting number of threads to a constant value (1)
-  cfg.threads = 1;
+  cfg.threads = num_threads;
   cfg.h = cfg.w = 0;  // set after decode
 
 #if defined(WEBRTC_ARCH_ARM) || defined(WEBRTC_ARCH_ARM64) || \
@@ -128,17 +160,27 @@ int LibvpxVp8Decoder::InitDecode(const VideoCodec* inst, int number_of_cores) {
   if (vpx_codec_dec_init(decoder_, vpx_codec_vp8_dx(), &cfg, flags)) {
     delete decoder_;
     decoder_ = nullptr;
+    inited_ = false;
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
 
-  propagation_cnt_ = -1;
+  num_threads_ = num_threads;
   inited_ = true;
-
-  // Always start with a complete key frame.
-  key_frame_required_ = true;
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+int LibvpxVp8Decoder::NumberOfThreads(int width, int height) const {
+  int num_threads = 1;
+  if (width * height >= 1920 * 1080 && number_of_cores_ > 8) {
+    num_threads = 4;
+  } else if (width * height >= 1280 * 720 && number_of_cores_ > 4) {
+    num_threads = 3;
+  } else if (width * height >= 640 * 360 && number_of_cores_ > 2) {
+    num_threads = 2;
+  }
+  return std::min(num_threads, max_threads_);
+}
+
 int LibvpxVp8Decoder::Decode(const EncodedImage& input_image,
                              bool missing_frames,
                              const CodecSpecificInfo* codec_specific_info,
@@ -156,6 +198,22 @@ int LibvpxVp8Decoder::Decode(const EncodedImage& input_image,
     return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
   }
 
+  // The thread count can only change by recreating the decoder, which is
+  // done on key frames since those do not depend on the decoder state.
+  if (input_image._frameType == kVideoFrameKey &&
+      input_image._completeFrame && input_image._encodedWidth > 0 &&
+      input_image._encodedHeight > 0) {
+    int num_threads = NumberOfThreads(input_image._encodedWidth,
+                                      input_image._encodedHeight);
+    if (num_threads != num_threads_) {
+      if (vpx_codec_destroy(decoder_))
+        return WEBRTC_VIDEO_CODEC_MEMORY;
+      int ret_val = InitDecoder(num_threads);
+      if (ret_val != WEBRTC_VIDEO_CODEC_OK)
+        return ret_val;
+    }
+  }
+
 // Post process configurations.
 #if defined(WEBRTC_ARCH_ARM) || defined(WEBRTC_ARCH_ARM64) || \
     defined(WEBRTC_ANDROID)
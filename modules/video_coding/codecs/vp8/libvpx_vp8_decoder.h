@@ -50,6 +50,10 @@ class LibvpxVp8Decoder : public VP8Decoder {
 
  private:
   class QpSmoother;
+  // Creates |decoder_| decoding with |num_threads| threads.
+  int InitDecoder(int num_threads);
+  // Number of decoding threads for frames of the given resolution.
+  int NumberOfThreads(int width, int height) const;
   int ReturnFrame(const vpx_image_t* img,
                   uint32_t timeStamp,
                   int64_t ntp_time_ms,
@@ -65,6 +69,10 @@ class LibvpxVp8Decoder : public VP8Decoder {
   int last_frame_width_;
   int last_frame_height_;
   bool key_frame_required_;
+  int number_of_cores_;
+  int num_threads_;
+  // Upper bound on |num_threads_| set by field trial.
+  const int max_threads_;
   DeblockParams deblock_;
   const std::unique_ptr<QpSmoother> qp_smoother_;
 };
@@ -15,9 +15,11 @@
 #include "absl/memory/memory.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_coding/codecs/vp8/libvpx_vp8_encoder.h"
+#include "modules/video_coding/utility/codec_thread_budget.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "modules/video_coding/utility/simulcast_utility.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/timeutils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
@@ -158,8 +160,10 @@ LibvpxVp8Encoder::LibvpxVp8Encoder()
       qp_max_(56),  // Setting for max quantizer.
       cpu_speed_default_(-6),
       number_of_cores_(0),
+      extra_threads_(0),
       rc_max_intra_target_(0),
-      key_frame_request_(kMaxSimulcastStreams, false) {
+      key_frame_request_(kMaxSimulcastStreams, false),
+      active_map_enabled_(false) {
   temporal_layers_.reserve(kMaxSimulcastStreams);
   temporal_layers_checkers_.reserve(kMaxSimulcastStreams);
   raw_images_.reserve(kMaxSimulcastStreams);
@@ -178,11 +182,8 @@ LibvpxVp8Encoder::~LibvpxVp8Encoder() {
 int LibvpxVp8Encoder::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
-  while (!encoded_images_.empty()) {
-    EncodedImage& image = encoded_images_.back();
-    delete[] image._buffer;
-    encoded_images_.pop_back();
-  }
+  encoded_images_.clear();
+  encoded_image_buffers_.clear();
   while (!encoders_.empty()) {
     vpx_codec_ctx_t& encoder = encoders_.back();
     if (inited_) {
@@ -201,6 +202,10 @@ int LibvpxVp8Encoder::Release() {
   }
   temporal_layers_.clear();
   temporal_layers_checkers_.clear();
+  update_rect_since_last_buffer_.reset();
+  active_map_enabled_ = false;
+  CodecThreadBudget::Global()->Release(extra_threads_);
+  extra_threads_ = 0;
   inited_ = false;
   return ret_val;
 }
@@ -352,6 +357,7 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   }
 
   encoded_images_.resize(number_of_streams);
+  encoded_image_buffers_.resize(number_of_streams);
   encoders_.resize(number_of_streams);
   configurations_.resize(number_of_streams);
   downsampling_factors_.resize(number_of_streams);
@@ -375,13 +381,8 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     downsampling_factors_[number_of_streams - 1].den = 1;
   }
   for (int i = 0; i < number_of_streams; ++i) {
-    // allocate memory for encoded image
-    if (encoded_images_[i]._buffer != NULL) {
-      delete[] encoded_images_[i]._buffer;
-    }
-    encoded_images_[i]._size =
-        CalcBufferSize(VideoType::kI420, codec_.width, codec_.height);
-    encoded_images_[i]._buffer = new uint8_t[encoded_images_[i]._size];
+    // The buffers are taken from the pool as GetEncodedPartitions() needs
+    // them, sized for the frames actually produced.
     encoded_images_[i]._completeFrame = true;
   }
   // populate encoder configuration with default values
@@ -451,10 +452,15 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   configurations_[0].g_w = inst->width;
   configurations_[0].g_h = inst->height;
 
-  // Determine number of threads based on the image size and #cores.
+  // Determine number of threads based on the image size and #cores. Threads
+  // beyond the encoding thread are taken from the budget shared by all codecs
+  // of the process, so that many concurrent encoders do not oversubscribe the
+  // cores.
   // TODO(fbarchard): Consider number of Simulcast layers.
-  configurations_[0].g_threads = NumberOfThreads(
-      configurations_[0].g_w, configurations_[0].g_h, number_of_cores);
+  int wanted_threads = NumberOfThreads(configurations_[0].g_w,
+                                       configurations_[0].g_h, number_of_cores);
+  extra_threads_ = CodecThreadBudget::Global()->Acquire(wanted_threads - 1);
+  configurations_[0].g_threads = 1 + extra_threads_;
 
   // Creating a wrapper to the image - setting image data to NULL.
   // Actual pointer will be set in encode. Setting align to 1, as it
@@ -665,6 +671,13 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   if (encoded_complete_callback_ == NULL)
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
 
+  // Accumulate also the frames dropped below, they are not in the last
+  // buffer either.
+  if (update_rect_since_last_buffer_ && frame.update_rect())
+    update_rect_since_last_buffer_->Union(*frame.update_rect());
+  else
+    update_rect_since_last_buffer_.reset();
+
   rtc::scoped_refptr<I420BufferInterface> input_image =
       frame.video_frame_buffer()->ToI420();
   // Since we are extracting raw pointers from |input_image| to
@@ -746,6 +759,7 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     }
     std::fill(key_frame_request_.begin(), key_frame_request_.end(), false);
   }
+  UpdateActiveMap(send_key_frame, tl_configs[0]);
 
   // Set the encoder frame flags and temporal layer_id for each spatial stream.
   // Note that |temporal_layers_| are defined starting from lowest resolution at
@@ -800,9 +814,55 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Examines frame timestamps only.
     error = GetEncodedPartitions(tl_configs, frame);
   }
+  if (error == WEBRTC_VIDEO_CODEC_OK && encoders_.size() == 1 &&
+      encoded_images_[0]._length > 0 &&
+      (send_key_frame ||
+       (tl_configs[0].last_buffer_flags & TemporalLayers::kUpdate))) {
+    // This frame is now in the last buffer.
+    update_rect_since_last_buffer_ = VideoFrame::UpdateRect{0, 0, 0, 0};
+  }
   return error;
 }
 
+void LibvpxVp8Encoder::UpdateActiveMap(
+    bool send_key_frame,
+    const TemporalLayers::FrameConfig& tl_config) {
+  const bool use_active_map =
+      encoders_.size() == 1 && !send_key_frame &&
+      (tl_config.last_buffer_flags & TemporalLayers::kReference) &&
+      update_rect_since_last_buffer_;
+  if (!use_active_map && !active_map_enabled_)
+    return;
+
+  vpx_active_map_t map;
+  map.rows = (codec_.height + 15) / 16;
+  map.cols = (codec_.width + 15) / 16;
+  map.active_map = nullptr;
+  if (use_active_map) {
+    active_map_.assign(map.rows * map.cols, 0);
+    const VideoFrame::UpdateRect& rect = *update_rect_since_last_buffer_;
+    if (!rect.IsEmpty()) {
+      const int first_row = std::max(rect.offset_y, 0) / 16;
+      const int last_row = std::min<int>(
+          (rect.offset_y + rect.height - 1) / 16, map.rows - 1);
+      const int first_col = std::max(rect.offset_x, 0) / 16;
+      const int last_col = std::min<int>(
+          (rect.offset_x + rect.width - 1) / 16, map.cols - 1);
+      for (int row = first_row; row <= last_row && first_col <= last_col;
+           ++row) {
+        std::fill(active_map_.begin() + row * map.cols + first_col,
+                  active_map_.begin() + row * map.cols + last_col + 1, 1);
+      }
+    }
+    map.active_map = active_map_.data();
+  }
+  if (vpx_codec_control(&encoders_[0], VP8E_SET_ACTIVEMAP, &map)) {
+    RTC_LOG(LS_WARNING) << "Failed to set the VP8 active map.";
+    return;
+  }
+  active_map_enabled_ = use_active_map;
+}
+
 void LibvpxVp8Encoder::PopulateCodecSpecific(
     CodecSpecificInfo* codec_specific,
     const TemporalLayers::FrameConfig& tl_config,
@@ -842,14 +902,9 @@ int LibvpxVp8Encoder::GetEncodedPartitions(
       switch (pkt->kind) {
         case VPX_CODEC_CX_FRAME_PKT: {
           size_t length = encoded_images_[encoder_idx]._length;
-          if (pkt->data.frame.sz + length >
-              encoded_images_[encoder_idx]._size) {
-            uint8_t* buffer = new uint8_t[pkt->data.frame.sz + length];
-            memcpy(buffer, encoded_images_[encoder_idx]._buffer, length);
-            delete[] encoded_images_[encoder_idx]._buffer;
-            encoded_images_[encoder_idx]._buffer = buffer;
-            encoded_images_[encoder_idx]._size = pkt->data.frame.sz + length;
-          }
+          EncodedImageBufferPool::Global()->Reserve(
+              pkt->data.frame.sz + length, &encoded_images_[encoder_idx],
+              &encoded_image_buffers_[encoder_idx]);
           memcpy(&encoded_images_[encoder_idx]._buffer[length],
                  pkt->data.frame.buf, pkt->data.frame.sz);
           frag_info.fragmentationOffset[part_idx] = length;
@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/video/video_frame.h"
 #include "api/video_codecs/video_encoder.h"
 #include "common_types.h"  // NOLINT(build/include)
@@ -21,6 +22,7 @@
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp8/temporal_layers.h"
 #include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/utility/encoded_image_buffer_pool.h"
 
 #include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
@@ -84,6 +86,12 @@ class LibvpxVp8Encoder : public VP8Encoder {
 
   uint32_t MaxIntraTarget(uint32_t optimal_buffer_size);
 
+  // Marks the macroblocks outside of |update_rect_since_last_buffer_| as
+  // inactive, so that they are coded as copies of the last buffer. Only done
+  // for a single stream and for delta frames that reference the last buffer.
+  void UpdateActiveMap(bool send_key_frame,
+                       const TemporalLayers::FrameConfig& tl_config);
+
   const bool use_gf_boost_;
 
   EncodedImageCallback* encoded_complete_callback_;
@@ -93,6 +101,9 @@ class LibvpxVp8Encoder : public VP8Encoder {
   int qp_max_;
   int cpu_speed_default_;
   int number_of_cores_;
+  // Threads of the top stream encoder beyond the encoding thread, taken from
+  // CodecThreadBudget::Global().
+  int extra_threads_;
   uint32_t rc_max_intra_target_;
   std::vector<std::unique_ptr<TemporalLayers>> temporal_layers_;
   std::vector<std::unique_ptr<TemporalLayersChecker>> temporal_layers_checkers_;
@@ -101,9 +112,17 @@ class LibvpxVp8Encoder : public VP8Encoder {
   std::vector<int> cpu_speed_;
   std::vector<vpx_image_t> raw_images_;
   std::vector<EncodedImage> encoded_images_;
+  // The buffers of |encoded_images_|, from EncodedImageBufferPool::Global().
+  std::vector<rtc::scoped_refptr<EncodedImageBufferPool::Buffer>>
+      encoded_image_buffers_;
   std::vector<vpx_codec_ctx_t> encoders_;
   std::vector<vpx_codec_enc_cfg_t> configurations_;
   std::vector<vpx_rational_t> downsampling_factors_;
+  // The region that has changed since the frame in the last buffer was
+  // captured, or unset if unknown.
+  absl::optional<VideoFrame::UpdateRect> update_rect_since_last_buffer_;
+  std::vector<uint8_t> active_map_;
+  bool active_map_enabled_;
 };
 
 }  // namespace webrtc
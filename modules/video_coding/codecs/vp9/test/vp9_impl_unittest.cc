@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <atomic>
+
 #include "api/video/color_space.h"
 #include "api/video/i420_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
@@ -16,6 +18,7 @@
 #include "modules/video_coding/codecs/test/video_codec_unittest.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/svc_config.h"
+#include "rtc_base/timeutils.h"
 #include "test/video_codec_settings.h"
 
 namespace webrtc {
@@ -23,6 +26,23 @@ namespace webrtc {
 namespace {
 const size_t kWidth = 1280;
 const size_t kHeight = 720;
+
+// Advances by a millisecond every time it is read, so that every interval
+// measured with it is positive.
+class TickingClock : public rtc::ClockInterface {
+ public:
+  TickingClock() : previous_(rtc::SetClockForTesting(this)) {}
+  ~TickingClock() override { rtc::SetClockForTesting(previous_); }
+
+  int64_t TimeNanos() const override {
+    return time_nanos_.fetch_add(rtc::kNumNanosecsPerMillisec);
+  }
+
+ private:
+  rtc::ClockInterface* const previous_;
+  mutable std::atomic<int64_t> time_nanos_{rtc::kNumNanosecsPerSec};
+};
+
 }  // namespace
 
 class TestVp9Impl : public VideoCodecUnitTest {
@@ -327,6 +347,40 @@ TEST_F(TestVp9Impl, EndOfPicture) {
   EXPECT_TRUE(codec_specific[0].codecSpecific.VP9.end_of_picture);
 }
 
+TEST_F(TestVp9Impl, ReportsEncodeTimePerLayer) {
+  const size_t num_spatial_layers = 2;
+  ConfigureSvc(num_spatial_layers);
+
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->InitEncode(&codec_settings_, 1 /* number of cores */,
+                                 0 /* max payload size (unused) */));
+
+  VideoBitrateAllocation bitrate_allocation;
+  for (size_t sl_idx = 0; sl_idx < num_spatial_layers; ++sl_idx) {
+    bitrate_allocation.SetBitrate(
+        sl_idx, 0, codec_settings_.spatialLayers[sl_idx].targetBitrate * 1000);
+  }
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->SetRateAllocation(bitrate_allocation,
+                                        codec_settings_.maxFramerate));
+
+  // The clock moves on between the start of the encode and the output of each
+  // layer frame, so every layer frame must report a time of its own.
+  TickingClock clock;
+  SetWaitForEncodedFramesThreshold(num_spatial_layers);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*NextInputFrame(), nullptr, nullptr));
+
+  std::vector<EncodedImage> frames;
+  std::vector<CodecSpecificInfo> codec_specific;
+  ASSERT_TRUE(WaitForEncodedFrames(&frames, &codec_specific));
+  ASSERT_EQ(num_spatial_layers, codec_specific.size());
+  for (size_t sl_idx = 0; sl_idx < num_spatial_layers; ++sl_idx) {
+    EXPECT_EQ(sl_idx, codec_specific[sl_idx].codecSpecific.VP9.spatial_idx);
+    EXPECT_GT(codec_specific[sl_idx].codecSpecific.VP9.encode_time_us, 0);
+  }
+}
+
 TEST_F(TestVp9Impl, InterLayerPred) {
   const size_t num_spatial_layers = 2;
   ConfigureSvc(num_spatial_layers);
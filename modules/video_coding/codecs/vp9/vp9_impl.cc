@@ -145,6 +145,7 @@ VP9EncoderImpl::VP9EncoderImpl(const cricket::VideoCodec& codec)
           ParseSdpForVP9Profile(codec.params).value_or(VP9Profile::kProfile0)),
       inited_(false),
       timestamp_(0),
+      layer_encode_start_us_(0),
       cpu_speed_(3),
       rc_max_intra_target_(0),
       encoder_(nullptr),
@@ -171,10 +172,9 @@ VP9EncoderImpl::~VP9EncoderImpl() {
 int VP9EncoderImpl::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
-  if (encoded_image_._buffer != nullptr) {
-    delete[] encoded_image_._buffer;
-    encoded_image_._buffer = nullptr;
-  }
+  encoded_image_._buffer = nullptr;
+  encoded_image_._size = 0;
+  encoded_image_buffer_ = nullptr;
   if (encoder_ != nullptr) {
     if (inited_) {
       if (vpx_codec_destroy(encoder_)) {
@@ -369,13 +369,8 @@ int VP9EncoderImpl::InitEncode(const VideoCodec* inst,
   // to get reference list in SVC mode.
   RTC_DCHECK(!inst->VP9().flexibleMode || is_svc_);
 
-  // Allocate memory for encoded image
-  if (encoded_image_._buffer != nullptr) {
-    delete[] encoded_image_._buffer;
-  }
-  encoded_image_._size =
-      CalcBufferSize(VideoType::kI420, codec_.width, codec_.height);
-  encoded_image_._buffer = new uint8_t[encoded_image_._size];
+  // The buffer of the encoded image is taken from the pool for each layer
+  // frame, in GetEncodedLayerFrame().
   encoded_image_._completeFrame = true;
   // Populate encoder configuration with default values.
   if (vpx_codec_enc_config_default(vpx_codec_vp9_cx(), config_, 0)) {
@@ -497,7 +492,12 @@ int VP9EncoderImpl::NumberOfThreads(int width,
                                     int number_of_cores) {
   // Keep the number of encoder threads equal to the possible number of column
   // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
-  if (width * height >= 1280 * 720 && number_of_cores > 4) {
+  // With row based multithreading the threads also share the rows of a tile,
+  // so more threads than tiles pay off for high resolutions. With spatial
+  // layers, libvpx caps the tiles of each layer to what its width allows.
+  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 1280 * 720 && number_of_cores > 4) {
     return 4;
   } else if (width * height >= 640 * 360 && number_of_cores > 2) {
     return 2;
@@ -623,7 +623,10 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
-  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
+  int tile_columns_log2 = 0;
+  while ((2u << tile_columns_log2) <= config_->g_threads)
+    ++tile_columns_log2;
+  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, tile_columns_log2);
 
   // Turn on row-based multithreading.
   vpx_codec_control(encoder_, VP9E_SET_ROW_MT, 1);
@@ -743,6 +746,7 @@ int VP9EncoderImpl::Encode(const VideoFrame& input_image,
   RTC_CHECK_GT(codec_.maxFramerate, 0);
   uint32_t duration =
       90000 / target_framerate_fps_.value_or(codec_.maxFramerate);
+  layer_encode_start_us_ = rtc::TimeMicros();
   const vpx_codec_err_t rv = vpx_codec_encode(encoder_, raw_, timestamp_,
                                               duration, flags, VPX_DL_REALTIME);
   if (rv != VPX_CODEC_OK) {
@@ -978,11 +982,9 @@ int VP9EncoderImpl::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
   const bool end_of_picture = false;
   DeliverBufferedFrame(end_of_picture);
 
-  if (pkt->data.frame.sz > encoded_image_._size) {
-    delete[] encoded_image_._buffer;
-    encoded_image_._size = pkt->data.frame.sz;
-    encoded_image_._buffer = new uint8_t[encoded_image_._size];
-  }
+  encoded_image_._length = 0;
+  EncodedImageBufferPool::Global()->Reserve(
+      pkt->data.frame.sz, &encoded_image_, &encoded_image_buffer_);
   memcpy(encoded_image_._buffer, pkt->data.frame.buf, pkt->data.frame.sz);
   encoded_image_._length = pkt->data.frame.sz;
 
@@ -1002,6 +1004,13 @@ int VP9EncoderImpl::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
   memset(&codec_specific_, 0, sizeof(codec_specific_));
   PopulateCodecSpecific(&codec_specific_, *pkt, input_image_->timestamp(),
                         first_frame_in_picture);
+  // libvpx encodes the spatial layers one at a time and outputs each of them
+  // when done, so the time since the previous output is the encode time of
+  // this layer.
+  const int64_t now_us = rtc::TimeMicros();
+  codec_specific_.codecSpecific.VP9.encode_time_us =
+      now_us - layer_encode_start_us_;
+  layer_encode_start_us_ = now_us;
 
   if (is_flexible_mode_) {
     UpdateReferenceBuffers(*pkt, pics_since_key_);
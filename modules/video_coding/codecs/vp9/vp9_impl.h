@@ -20,6 +20,7 @@
 
 #include "media/base/vp9_profile.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
+#include "modules/video_coding/utility/encoded_image_buffer_pool.h"
 #include "rtc_base/rate_statistics.h"
 
 #include "vpx/vp8cx.h"
@@ -93,12 +94,16 @@ class VP9EncoderImpl : public VP9Encoder {
   uint32_t MaxIntraTarget(uint32_t optimal_buffer_size);
 
   EncodedImage encoded_image_;
+  // The buffer of |encoded_image_|, from EncodedImageBufferPool::Global().
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> encoded_image_buffer_;
   CodecSpecificInfo codec_specific_;
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
   const VP9Profile profile_;
   bool inited_;
   int64_t timestamp_;
+  // When the encoder started on the next layer frame of the current picture.
+  int64_t layer_encode_start_us_;
   int cpu_speed_;
   uint32_t rc_max_intra_target_;
   vpx_codec_ctx_t* encoder_;
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/decode_load_controller.h"
+
+#include <algorithm>
+
+#include "modules/include/module_common_types_public.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kVideoPayloadTypeFrequencyKhz = 90;
+// Intervals longer than this are pauses in the stream rather than its frame
+// rate.
+constexpr double kMaxFrameIntervalMs = 1000.0;
+constexpr double kFrameIntervalSmoothing = 0.9;
+
+// A layer is skipped when decoding takes this part of the interval between the
+// decoded frames, before a backlog builds up, and is decoded again when it
+// would take less than the lower part.
+constexpr double kSkipLayerLoad = 0.9;
+constexpr double kDecodeLayerLoad = 0.7;
+
+}  // namespace
+
+DecodeLoadController::DecodeLoadController()
+    : frame_interval_ms_(0.0), max_temporal_index_(0), num_skipped_layers_(0) {}
+
+void DecodeLoadController::OnFrameInserted(uint32_t rtp_timestamp,
+                                           int temporal_index) {
+  if (temporal_index != kNoTemporalIdx)
+    max_temporal_index_ = std::max(max_temporal_index_, temporal_index);
+
+  // Only in-order frames of new pictures give an interval.
+  if (last_rtp_timestamp_ && !IsNewerTimestamp(rtp_timestamp,
+                                               *last_rtp_timestamp_)) {
+    return;
+  }
+  if (last_rtp_timestamp_) {
+    const double interval_ms =
+        static_cast<double>(rtp_timestamp - *last_rtp_timestamp_) /
+        kVideoPayloadTypeFrequencyKhz;
+    if (interval_ms <= kMaxFrameIntervalMs) {
+      frame_interval_ms_ =
+          frame_interval_ms_ == 0.0
+              ? interval_ms
+              : kFrameIntervalSmoothing * frame_interval_ms_ +
+                    (1.0 - kFrameIntervalSmoothing) * interval_ms;
+    }
+  }
+  last_rtp_timestamp_ = rtp_timestamp;
+}
+
+void DecodeLoadController::OnDecodeTime(int decode_time_ms) {
+  num_skipped_layers_ = std::min(num_skipped_layers_, max_temporal_index_);
+  if (frame_interval_ms_ == 0.0)
+    return;
+
+  // Interval between the decoded frames with |num_skipped| layers skipped.
+  auto decoded_interval_ms = [this](int num_skipped) {
+    return frame_interval_ms_ * (1 << num_skipped);
+  };
+  const int num_skipped_layers = num_skipped_layers_;
+  while (num_skipped_layers_ < max_temporal_index_ &&
+         decode_time_ms >
+             kSkipLayerLoad * decoded_interval_ms(num_skipped_layers_)) {
+    ++num_skipped_layers_;
+  }
+  while (num_skipped_layers_ > 0 &&
+         decode_time_ms <
+             kDecodeLayerLoad * decoded_interval_ms(num_skipped_layers_ - 1)) {
+    --num_skipped_layers_;
+  }
+  if (num_skipped_layers_ != num_skipped_layers) {
+    RTC_LOG(LS_INFO) << "Decode time " << decode_time_ms
+                     << " ms for a frame interval of " << frame_interval_ms_
+                     << " ms, skipping " << num_skipped_layers_ << " of "
+                     << max_temporal_index_ + 1 << " temporal layers.";
+  }
+}
+
+bool DecodeLoadController::ShouldSkip(int temporal_index) const {
+  return temporal_index != kNoTemporalIdx && temporal_index > 0 &&
+         temporal_index > max_temporal_index_ - num_skipped_layers_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_DECODE_LOAD_CONTROLLER_H_
+#define MODULES_VIDEO_CODING_DECODE_LOAD_CONTROLLER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// Decides which temporal layers of a received stream to skip when the decoder
+// can't keep up with the frame rate, so that the base layer stays real-time
+// instead of the decoder falling behind until frames are dropped for being
+// late. The load is the decode time of a frame, as estimated by VCMTiming,
+// relative to the interval between the frames of the stream. Each skipped
+// layer is assumed to halve the frame rate, as in the usual dyadic temporal
+// structures. Frames of the base layer are never skipped, and no frame of a
+// lower layer references a higher one, so skipping never stalls decoding.
+class DecodeLoadController {
+ public:
+  DecodeLoadController();
+
+  // Updates the frame interval and the number of temporal layers given a frame
+  // inserted into the frame buffer. |temporal_index| may be kNoTemporalIdx.
+  void OnFrameInserted(uint32_t rtp_timestamp, int temporal_index);
+
+  // Updates the number of skipped layers given the current decode time.
+  void OnDecodeTime(int decode_time_ms);
+
+  // Returns true if a frame of |temporal_index| should be skipped.
+  bool ShouldSkip(int temporal_index) const;
+
+  int num_skipped_layers() const { return num_skipped_layers_; }
+
+ private:
+  absl::optional<uint32_t> last_rtp_timestamp_;
+  // Smoothed interval between the frames of the stream.
+  double frame_interval_ms_;
+  int max_temporal_index_;
+  int num_skipped_layers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_DECODE_LOAD_CONTROLLER_H_
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/decode_load_controller.h"
+
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint32_t kFrameIntervalRtp = 90 * 33;
+
+// Inserts |num_frames| frames of a stream with three dyadic temporal layers.
+void InsertFrames(DecodeLoadController* controller, int num_frames) {
+  const int kTemporalIndices[] = {0, 2, 1, 2};
+  for (int i = 0; i < num_frames; ++i)
+    controller->OnFrameInserted(i * kFrameIntervalRtp, kTemporalIndices[i % 4]);
+}
+
+}  // namespace
+
+TEST(DecodeLoadControllerTest, DoesNotSkipBelowLoadLimit) {
+  DecodeLoadController controller;
+  InsertFrames(&controller, 10);
+  controller.OnDecodeTime(25);
+  EXPECT_EQ(0, controller.num_skipped_layers());
+  EXPECT_FALSE(controller.ShouldSkip(2));
+}
+
+TEST(DecodeLoadControllerTest, SkipsLayersUntilDecodingKeepsUp) {
+  DecodeLoadController controller;
+  InsertFrames(&controller, 10);
+
+  controller.OnDecodeTime(40);
+  EXPECT_EQ(1, controller.num_skipped_layers());
+  EXPECT_FALSE(controller.ShouldSkip(0));
+  EXPECT_FALSE(controller.ShouldSkip(1));
+  EXPECT_TRUE(controller.ShouldSkip(2));
+
+  controller.OnDecodeTime(100);
+  EXPECT_EQ(2, controller.num_skipped_layers());
+  EXPECT_FALSE(controller.ShouldSkip(0));
+  EXPECT_TRUE(controller.ShouldSkip(1));
+}
+
+TEST(DecodeLoadControllerTest, NeverSkipsBaseLayer) {
+  DecodeLoadController controller;
+  InsertFrames(&controller, 10);
+  controller.OnDecodeTime(1000);
+  EXPECT_EQ(2, controller.num_skipped_layers());
+  EXPECT_FALSE(controller.ShouldSkip(0));
+  EXPECT_FALSE(controller.ShouldSkip(kNoTemporalIdx));
+}
+
+TEST(DecodeLoadControllerTest, DecodesLayersAgainWithHysteresis) {
+  DecodeLoadController controller;
+  InsertFrames(&controller, 10);
+  controller.OnDecodeTime(100);
+  EXPECT_EQ(2, controller.num_skipped_layers());
+
+  // Decoding would just fit one more layer, but not with margin.
+  controller.OnDecodeTime(55);
+  EXPECT_EQ(2, controller.num_skipped_layers());
+
+  controller.OnDecodeTime(40);
+  EXPECT_EQ(1, controller.num_skipped_layers());
+
+  controller.OnDecodeTime(10);
+  EXPECT_EQ(0, controller.num_skipped_layers());
+}
+
+TEST(DecodeLoadControllerTest, IgnoresPausesAndReorderedFrames) {
+  DecodeLoadController controller;
+  InsertFrames(&controller, 10);
+  // A pause of several seconds, and a reordered frame.
+  controller.OnFrameInserted(100 * kFrameIntervalRtp, 1);
+  controller.OnFrameInserted(99 * kFrameIntervalRtp, 2);
+  controller.OnDecodeTime(25);
+  EXPECT_EQ(0, controller.num_skipped_layers());
+}
+
+}  // namespace webrtc
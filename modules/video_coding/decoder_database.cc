@@ -11,6 +11,7 @@
 #include "modules/video_coding/decoder_database.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/timeutils.h"
 
 namespace webrtc {
 
@@ -107,20 +108,47 @@ bool VCMDecoderDataBase::DeregisterReceiveCodec(uint8_t payload_type) {
 VCMGenericDecoder* VCMDecoderDataBase::GetDecoder(
     const VCMEncodedFrame& frame,
     VCMDecodedFrameCallback* decoded_frame_callback) {
-  RTC_DCHECK(decoded_frame_callback->UserReceiveCallback());
   uint8_t payload_type = frame.PayloadType();
   if (payload_type == receive_codec_.plType || payload_type == 0) {
     return ptr_decoder_.get();
   }
+  return SwitchDecoder(payload_type, frame.EncodedImage()._encodedWidth,
+                       frame.EncodedImage()._encodedHeight,
+                       decoded_frame_callback);
+}
+
+bool VCMDecoderDataBase::PrewarmDecoder(
+    uint8_t payload_type,
+    VCMDecodedFrameCallback* decoded_frame_callback) {
+  if (payload_type == receive_codec_.plType)
+    return ptr_decoder_ != nullptr;
+  return SwitchDecoder(payload_type, 0, 0, decoded_frame_callback) != nullptr;
+}
+
+bool VCMDecoderDataBase::PrefersLateDecoding() const {
+  return ptr_decoder_ ? ptr_decoder_->PrefersLateDecoding() : true;
+}
+
+VCMGenericDecoder* VCMDecoderDataBase::SwitchDecoder(
+    uint8_t payload_type,
+    int width,
+    int height,
+    VCMDecodedFrameCallback* decoded_frame_callback) {
+  RTC_DCHECK(decoded_frame_callback->UserReceiveCallback());
   // If decoder exists - delete.
   if (ptr_decoder_) {
     ptr_decoder_.reset();
     memset(&receive_codec_, 0, sizeof(VideoCodec));
   }
-  ptr_decoder_ = CreateAndInitDecoder(frame, &receive_codec_);
+  const int64_t init_start_ms = rtc::TimeMillis();
+  ptr_decoder_ =
+      CreateAndInitDecoder(payload_type, width, height, &receive_codec_);
   if (!ptr_decoder_) {
     return nullptr;
   }
+  RTC_LOG(LS_INFO) << "Decoder with payload type '"
+                   << static_cast<int>(payload_type) << "' initialized in "
+                   << rtc::TimeMillis() - init_start_ms << " ms.";
   VCMReceiveCallback* callback = decoded_frame_callback->UserReceiveCallback();
   callback->OnIncomingPayloadType(receive_codec_.plType);
   if (ptr_decoder_->RegisterDecodeCompleteCallback(decoded_frame_callback) <
@@ -132,14 +160,11 @@ VCMGenericDecoder* VCMDecoderDataBase::GetDecoder(
   return ptr_decoder_.get();
 }
 
-bool VCMDecoderDataBase::PrefersLateDecoding() const {
-  return ptr_decoder_ ? ptr_decoder_->PrefersLateDecoding() : true;
-}
-
 std::unique_ptr<VCMGenericDecoder> VCMDecoderDataBase::CreateAndInitDecoder(
-    const VCMEncodedFrame& frame,
+    uint8_t payload_type,
+    int width,
+    int height,
     VideoCodec* new_codec) const {
-  uint8_t payload_type = frame.PayloadType();
   RTC_LOG(LS_INFO) << "Initializing decoder with payload type '"
                    << static_cast<int>(payload_type) << "'.";
   RTC_DCHECK(new_codec);
@@ -166,10 +191,9 @@ std::unique_ptr<VCMGenericDecoder> VCMDecoderDataBase::CreateAndInitDecoder(
   // the first frame being of a different resolution than the database values.
   // This is best effort, since there's no guarantee that width/height have been
   // parsed yet (and may be zero).
-  if (frame.EncodedImage()._encodedWidth > 0 &&
-      frame.EncodedImage()._encodedHeight > 0) {
-    decoder_item->settings->width = frame.EncodedImage()._encodedWidth;
-    decoder_item->settings->height = frame.EncodedImage()._encodedHeight;
+  if (width > 0 && height > 0) {
+    decoder_item->settings->width = width;
+    decoder_item->settings->height = height;
   }
   if (ptr_decoder->InitDecode(decoder_item->settings.get(),
                               decoder_item->number_of_cores) < 0) {
@@ -62,6 +62,12 @@ class VCMDecoderDataBase {
       const VCMEncodedFrame& frame,
       VCMDecodedFrameCallback* decoded_frame_callback);
 
+  // Creates and initializes the decoder of |payload_type| ahead of the first
+  // frame, at the resolution it was registered with, so that the first frame
+  // doesn't wait for it. Returns false if no decoder could be initialized.
+  bool PrewarmDecoder(uint8_t payload_type,
+                      VCMDecodedFrameCallback* decoded_frame_callback);
+
   // Returns true if the currently active decoder prefer to decode frames late.
   // That means that frames must be decoded near the render times stamp.
   bool PrefersLateDecoding() const;
@@ -70,8 +76,19 @@ class VCMDecoderDataBase {
   typedef std::map<uint8_t, VCMDecoderMapItem*> DecoderMap;
   typedef std::map<uint8_t, VCMExtDecoderMapItem*> ExternalDecoderMap;
 
+  // Makes the decoder of |payload_type| the current one, creating it if
+  // needed. |width| and |height| are the resolution of the first frame, if
+  // known.
+  VCMGenericDecoder* SwitchDecoder(
+      uint8_t payload_type,
+      int width,
+      int height,
+      VCMDecodedFrameCallback* decoded_frame_callback);
+
   std::unique_ptr<VCMGenericDecoder> CreateAndInitDecoder(
-      const VCMEncodedFrame& frame,
+      uint8_t payload_type,
+      int width,
+      int height,
       VideoCodec* new_codec) const;
 
   const VCMDecoderMapItem* FindDecoderItem(uint8_t payload_type) const;
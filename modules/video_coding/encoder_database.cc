@@ -160,6 +160,7 @@ bool VCMEncoderDataBase::RequiresEncoderReset(
     // Known codecs without payload-specifics
     case kVideoCodecI420:
     case kVideoCodecMultiplex:
+    case kVideoCodecAV1:
       break;
     // Unknown codec type, reset just to be sure.
     case kVideoCodecUnknown:
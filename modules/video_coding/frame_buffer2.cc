@@ -12,11 +12,12 @@
 
 #include <algorithm>
 #include <cstring>
-#include <queue>
 #include <vector>
 
+#include "modules/video_coding/codecs/interface/common_constants.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/jitter_estimator.h"
+#include "modules/video_coding/layered_jitter_estimator.h"
 #include "modules/video_coding/timing.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -39,13 +40,26 @@ constexpr int kMaxFramesHistory = 50;
 constexpr int kMaxAllowedFrameDelayMs = 5;
 
 constexpr int64_t kLogNonDecodedIntervalMs = 5000;
+
+int TemporalIndex(const EncodedFrame& frame) {
+  const CodecSpecificInfo* codec_specific = frame.CodecSpecific();
+  switch (codec_specific->codecType) {
+    case kVideoCodecVP8:
+      return codec_specific->codecSpecific.VP8.temporalIdx;
+    case kVideoCodecVP9:
+      return codec_specific->codecSpecific.VP9.temporal_idx;
+    default:
+      return kNoTemporalIdx;
+  }
+}
 }  // namespace
 
 FrameBuffer::FrameBuffer(Clock* clock,
                          VCMJitterEstimator* jitter_estimator,
                          VCMTiming* timing,
                          VCMReceiveStatisticsCallback* stats_callback)
-    : clock_(clock),
+    : frames_(FrameMap::allocator_type(&node_pool_)),
+      clock_(clock),
       new_continuous_frame_event_(false, false),
       jitter_estimator_(jitter_estimator),
       timing_(timing),
@@ -58,7 +72,14 @@ FrameBuffer::FrameBuffer(Clock* clock,
       stopped_(false),
       protection_mode_(kProtectionNack),
       stats_callback_(stats_callback),
-      last_log_non_decoded_ms_(-kLogNonDecodedIntervalMs) {}
+      last_log_non_decoded_ms_(-kLogNonDecodedIntervalMs),
+      decode_load_shedding_(
+          !webrtc::field_trial::IsDisabled("WebRTC-DecodeLoadShedding")) {
+  if (webrtc::field_trial::IsEnabled("WebRTC-LayeredJitterEstimator")) {
+    layered_jitter_estimator_.reset(new LayeredJitterEstimator(clock_));
+    layered_jitter_estimator_->SetLowLatencyMode(timing_->low_latency_mode());
+  }
+}
 
 FrameBuffer::~FrameBuffer() {}
 
@@ -80,56 +101,7 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
       if (stopped_)
         return kStopped;
 
-      wait_ms = max_wait_time_ms;
-
-      // Need to hold |crit_| in order to use |frames_|, therefore we
-      // set it here in the loop instead of outside the loop in order to not
-      // acquire the lock unnecesserily.
-      next_frame_it_ = frames_.end();
-
-      // |frame_it| points to the first frame after the
-      // |last_decoded_frame_it_|.
-      auto frame_it = frames_.end();
-      if (last_decoded_frame_it_ == frames_.end()) {
-        frame_it = frames_.begin();
-      } else {
-        frame_it = last_decoded_frame_it_;
-        ++frame_it;
-      }
-
-      // |continuous_end_it| points to the first frame after the
-      // |last_continuous_frame_it_|.
-      auto continuous_end_it = last_continuous_frame_it_;
-      if (continuous_end_it != frames_.end())
-        ++continuous_end_it;
-
-      for (; frame_it != continuous_end_it && frame_it != frames_.end();
-           ++frame_it) {
-        if (!frame_it->second.continuous ||
-            frame_it->second.num_missing_decodable > 0) {
-          continue;
-        }
-
-        EncodedFrame* frame = frame_it->second.frame.get();
-
-        if (keyframe_required && !frame->is_keyframe())
-          continue;
-
-        next_frame_it_ = frame_it;
-        if (frame->RenderTime() == -1)
-          frame->SetRenderTime(timing_->RenderTimeMs(frame->timestamp, now_ms));
-        wait_ms = timing_->MaxWaitingTime(frame->RenderTime(), now_ms);
-
-        // This will cause the frame buffer to prefer high framerate rather
-        // than high resolution in the case of the decoder not decoding fast
-        // enough and the stream has multiple spatial and temporal layers.
-        // For multiple temporal layers it may cause non-base layer frames to be
-        // skipped if they are late.
-        if (wait_ms < -kMaxAllowedFrameDelayMs)
-          continue;
-
-        break;
-      }
+      wait_ms = FindNextFrame(max_wait_time_ms, keyframe_required, now_ms);
     }  // rtc::Critscope lock(&crit_);
 
     wait_ms = std::min<int64_t>(wait_ms, latest_return_time_ms - now_ms);
@@ -140,66 +112,7 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
     rtc::CritScope lock(&crit_);
     now_ms = clock_->TimeInMilliseconds();
     if (next_frame_it_ != frames_.end()) {
-      std::unique_ptr<EncodedFrame> frame =
-          std::move(next_frame_it_->second.frame);
-
-      if (!frame->delayed_by_retransmission()) {
-        int64_t frame_delay;
-
-        if (inter_frame_delay_.CalculateDelay(frame->timestamp, &frame_delay,
-                                              frame->ReceivedTime())) {
-          jitter_estimator_->UpdateEstimate(frame_delay, frame->size());
-        }
-
-        float rtt_mult = protection_mode_ == kProtectionNackFEC ? 0.0 : 1.0;
-        timing_->SetJitterDelay(jitter_estimator_->GetJitterEstimate(rtt_mult));
-        timing_->UpdateCurrentDelay(frame->RenderTime(), now_ms);
-      } else {
-        if (webrtc::field_trial::IsEnabled("WebRTC-AddRttToPlayoutDelay"))
-          jitter_estimator_->FrameNacked();
-      }
-
-      // Gracefully handle bad RTP timestamps and render time issues.
-      if (HasBadRenderTiming(*frame, now_ms)) {
-        jitter_estimator_->Reset();
-        timing_->Reset();
-        frame->SetRenderTime(timing_->RenderTimeMs(frame->timestamp, now_ms));
-      }
-
-      UpdateJitterDelay();
-      UpdateTimingFrameInfo();
-      PropagateDecodability(next_frame_it_->second);
-
-      // Sanity check for RTP timestamp monotonicity.
-      if (last_decoded_frame_it_ != frames_.end()) {
-        const VideoLayerFrameId& last_decoded_frame_key =
-            last_decoded_frame_it_->first;
-        const VideoLayerFrameId& frame_key = next_frame_it_->first;
-
-        const bool frame_is_higher_spatial_layer_of_last_decoded_frame =
-            last_decoded_frame_timestamp_ == frame->timestamp &&
-            last_decoded_frame_key.picture_id == frame_key.picture_id &&
-            last_decoded_frame_key.spatial_layer < frame_key.spatial_layer;
-
-        if (AheadOrAt(last_decoded_frame_timestamp_, frame->timestamp) &&
-            !frame_is_higher_spatial_layer_of_last_decoded_frame) {
-          // TODO(brandtr): Consider clearing the entire buffer when we hit
-          // these conditions.
-          RTC_LOG(LS_WARNING)
-              << "Frame with (timestamp:picture_id:spatial_id) ("
-              << frame->timestamp << ":" << frame->id.picture_id << ":"
-              << static_cast<int>(frame->id.spatial_layer) << ")"
-              << " sent to decoder after frame with"
-              << " (timestamp:picture_id:spatial_id) ("
-              << last_decoded_frame_timestamp_ << ":"
-              << last_decoded_frame_key.picture_id << ":"
-              << static_cast<int>(last_decoded_frame_key.spatial_layer) << ").";
-        }
-      }
-
-      AdvanceLastDecodedFrame(next_frame_it_);
-      last_decoded_frame_timestamp_ = frame->timestamp;
-      *frame_out = std::move(frame);
+      *frame_out = GetNextFrame(now_ms);
       return kFrameFound;
     }
   }
@@ -215,6 +128,162 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
   return kTimeout;
 }
 
+FrameBuffer::ReturnReason FrameBuffer::NextFrameIfDue(
+    int64_t max_wait_time_ms,
+    std::unique_ptr<EncodedFrame>* frame_out,
+    int64_t* wait_ms_out,
+    bool keyframe_required) {
+  TRACE_EVENT0("webrtc", "FrameBuffer::NextFrameIfDue");
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  rtc::CritScope lock(&crit_);
+  if (stopped_)
+    return kStopped;
+
+  int64_t wait_ms = FindNextFrame(max_wait_time_ms, keyframe_required, now_ms);
+  if (next_frame_it_ != frames_.end() && wait_ms <= 0) {
+    *frame_out = GetNextFrame(now_ms);
+    return kFrameFound;
+  }
+  *wait_ms_out = std::max<int64_t>(std::min(wait_ms, max_wait_time_ms), 0);
+  return kTimeout;
+}
+
+int64_t FrameBuffer::FindNextFrame(int64_t max_wait_time_ms,
+                                   bool keyframe_required,
+                                   int64_t now_ms) {
+  int64_t wait_ms = max_wait_time_ms;
+  next_frame_it_ = frames_.end();
+
+  // |frame_it| points to the first frame after the
+  // |last_decoded_frame_it_|.
+  auto frame_it = frames_.end();
+  if (last_decoded_frame_it_ == frames_.end()) {
+    frame_it = frames_.begin();
+  } else {
+    frame_it = last_decoded_frame_it_;
+    ++frame_it;
+  }
+
+  // |continuous_end_it| points to the first frame after the
+  // |last_continuous_frame_it_|.
+  auto continuous_end_it = last_continuous_frame_it_;
+  if (continuous_end_it != frames_.end())
+    ++continuous_end_it;
+
+  for (; frame_it != continuous_end_it && frame_it != frames_.end();
+       ++frame_it) {
+    if (!frame_it->second.continuous ||
+        frame_it->second.num_missing_decodable > 0) {
+      continue;
+    }
+
+    EncodedFrame* frame = frame_it->second.frame.get();
+
+    if (keyframe_required && !frame->is_keyframe())
+      continue;
+
+    // Skip the frames of the temporal layers that the decoder doesn't have
+    // time for, unless frames that depend on them have been received already.
+    if (decode_load_shedding_ && frame_it->second.num_dependent_frames == 0 &&
+        decode_load_controller_.ShouldSkip(TemporalIndex(*frame))) {
+      continue;
+    }
+
+    next_frame_it_ = frame_it;
+    if (frame->RenderTime() == -1)
+      frame->SetRenderTime(timing_->RenderTimeMs(frame->timestamp, now_ms));
+    wait_ms = timing_->MaxWaitingTime(frame->RenderTime(), now_ms);
+
+    // This will cause the frame buffer to prefer high framerate rather
+    // than high resolution in the case of the decoder not decoding fast
+    // enough and the stream has multiple spatial and temporal layers.
+    // For multiple temporal layers it may cause non-base layer frames to be
+    // skipped if they are late.
+    if (wait_ms < -kMaxAllowedFrameDelayMs)
+      continue;
+
+    break;
+  }
+  return wait_ms;
+}
+
+std::unique_ptr<EncodedFrame> FrameBuffer::GetNextFrame(int64_t now_ms) {
+  RTC_DCHECK(next_frame_it_ != frames_.end());
+  std::unique_ptr<EncodedFrame> frame = std::move(next_frame_it_->second.frame);
+
+  if (!frame->delayed_by_retransmission()) {
+    float rtt_mult = protection_mode_ == kProtectionNackFEC ? 0.0 : 1.0;
+    if (layered_jitter_estimator_) {
+      layered_jitter_estimator_->UpdateEstimate(
+          frame->timestamp, frame->ReceivedTime(), frame->size(),
+          frame->is_keyframe(), frame->id.spatial_layer,
+          TemporalIndex(*frame));
+      timing_->SetJitterDelay(
+          layered_jitter_estimator_->GetJitterEstimate(rtt_mult));
+    } else {
+      int64_t frame_delay;
+      if (inter_frame_delay_.CalculateDelay(frame->timestamp, &frame_delay,
+                                            frame->ReceivedTime())) {
+        jitter_estimator_->UpdateEstimate(frame_delay, frame->size());
+      }
+      timing_->SetJitterDelay(jitter_estimator_->GetJitterEstimate(rtt_mult));
+    }
+    timing_->UpdateCurrentDelay(frame->RenderTime(), now_ms);
+  } else {
+    if (webrtc::field_trial::IsEnabled("WebRTC-AddRttToPlayoutDelay")) {
+      if (layered_jitter_estimator_) {
+        layered_jitter_estimator_->FrameNacked();
+      } else {
+        jitter_estimator_->FrameNacked();
+      }
+    }
+  }
+
+  // Gracefully handle bad RTP timestamps and render time issues.
+  if (HasBadRenderTiming(*frame, now_ms)) {
+    jitter_estimator_->Reset();
+    if (layered_jitter_estimator_)
+      layered_jitter_estimator_->Reset();
+    timing_->Reset();
+    frame->SetRenderTime(timing_->RenderTimeMs(frame->timestamp, now_ms));
+  }
+
+  UpdateJitterDelay();
+  UpdateTimingFrameInfo();
+  PropagateDecodability(next_frame_it_->second);
+
+  // Sanity check for RTP timestamp monotonicity.
+  if (last_decoded_frame_it_ != frames_.end()) {
+    const VideoLayerFrameId& last_decoded_frame_key =
+        last_decoded_frame_it_->first;
+    const VideoLayerFrameId& frame_key = next_frame_it_->first;
+
+    const bool frame_is_higher_spatial_layer_of_last_decoded_frame =
+        last_decoded_frame_timestamp_ == frame->timestamp &&
+        last_decoded_frame_key.picture_id == frame_key.picture_id &&
+        last_decoded_frame_key.spatial_layer < frame_key.spatial_layer;
+
+    if (AheadOrAt(last_decoded_frame_timestamp_, frame->timestamp) &&
+        !frame_is_higher_spatial_layer_of_last_decoded_frame) {
+      // TODO(brandtr): Consider clearing the entire buffer when we hit
+      // these conditions.
+      RTC_LOG(LS_WARNING)
+          << "Frame with (timestamp:picture_id:spatial_id) ("
+          << frame->timestamp << ":" << frame->id.picture_id << ":"
+          << static_cast<int>(frame->id.spatial_layer) << ")"
+          << " sent to decoder after frame with"
+          << " (timestamp:picture_id:spatial_id) ("
+          << last_decoded_frame_timestamp_ << ":"
+          << last_decoded_frame_key.picture_id << ":"
+          << static_cast<int>(last_decoded_frame_key.spatial_layer) << ").";
+    }
+  }
+
+  AdvanceLastDecodedFrame(next_frame_it_);
+  last_decoded_frame_timestamp_ = frame->timestamp;
+  return frame;
+}
+
 bool FrameBuffer::HasBadRenderTiming(const EncodedFrame& frame,
                                      int64_t now_ms) {
   // Assume that render timing errors are due to changes in the video stream.
@@ -265,12 +334,17 @@ void FrameBuffer::Stop() {
 void FrameBuffer::UpdateRtt(int64_t rtt_ms) {
   rtc::CritScope lock(&crit_);
   jitter_estimator_->UpdateRtt(rtt_ms);
+  if (layered_jitter_estimator_)
+    layered_jitter_estimator_->UpdateRtt(rtt_ms);
 }
 
 bool FrameBuffer::ValidReferences(const EncodedFrame& frame) const {
   if (frame.id.picture_id < 0)
     return false;
 
+  if (frame.num_references > EncodedFrame::kMaxFrameReferences)
+    return false;
+
   for (size_t i = 0; i < frame.num_references; ++i) {
     if (frame.references[i] < 0 || frame.references[i] >= frame.id.picture_id)
       return false;
@@ -391,6 +465,8 @@ int64_t FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
   if (!UpdateFrameInfoWithIncomingFrame(*frame, info))
     return last_continuous_picture_id;
   UpdatePlayoutDelays(*frame);
+  decode_load_controller_.OnFrameInserted(frame->timestamp,
+                                          TemporalIndex(*frame));
 
   info->second.frame = std::move(frame);
   ++num_frames_buffered_;
@@ -415,13 +491,14 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
   if (last_continuous_frame_it_ == frames_.end())
     last_continuous_frame_it_ = start;
 
-  std::queue<FrameMap::iterator> continuous_frames;
-  continuous_frames.push(start);
+  RTC_DCHECK(continuous_frames_.empty());
+  continuous_frames_.push_back(start);
 
-  // A simple BFS to traverse continuous frames.
-  while (!continuous_frames.empty()) {
-    auto frame = continuous_frames.front();
-    continuous_frames.pop();
+  // A simple DFS to traverse continuous frames. The order doesn't matter
+  // since the latest of them ends up as the last continuous frame.
+  while (!continuous_frames_.empty()) {
+    auto frame = continuous_frames_.back();
+    continuous_frames_.pop_back();
 
     if (last_continuous_frame_it_->first < frame->first)
       last_continuous_frame_it_ = frame;
@@ -437,7 +514,7 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
         --frame_ref->second.num_missing_continuous;
         if (frame_ref->second.num_missing_continuous == 0) {
           frame_ref->second.continuous = true;
-          continuous_frames.push(frame_ref);
+          continuous_frames_.push_back(frame_ref);
         }
       }
     }
@@ -503,7 +580,10 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
     VideoLayerFrameId id;
     bool continuous;
   };
-  std::vector<Dependency> not_yet_fulfilled_dependencies;
+  // One per reference, and one for the lower spatial layer.
+  constexpr size_t kMaxDependencies = EncodedFrame::kMaxFrameReferences + 1;
+  Dependency not_yet_fulfilled_dependencies[kMaxDependencies];
+  size_t num_not_yet_fulfilled_dependencies = 0;
 
   // Find all dependencies that have not yet been fulfilled.
   for (size_t i = 0; i < frame.num_references; ++i) {
@@ -530,7 +610,8 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
     } else {
       bool ref_continuous =
           ref_info != frames_.end() && ref_info->second.continuous;
-      not_yet_fulfilled_dependencies.push_back({ref_key, ref_continuous});
+      not_yet_fulfilled_dependencies[num_not_yet_fulfilled_dependencies++] = {
+          ref_key, ref_continuous};
     }
   }
 
@@ -545,15 +626,16 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
                                last_decoded_frame_it_->first == ref_key;
 
     if (!lower_layer_continuous || !lower_layer_decoded) {
-      not_yet_fulfilled_dependencies.push_back(
-          {ref_key, lower_layer_continuous});
+      not_yet_fulfilled_dependencies[num_not_yet_fulfilled_dependencies++] = {
+          ref_key, lower_layer_continuous};
     }
   }
 
-  info->second.num_missing_continuous = not_yet_fulfilled_dependencies.size();
-  info->second.num_missing_decodable = not_yet_fulfilled_dependencies.size();
+  info->second.num_missing_continuous = num_not_yet_fulfilled_dependencies;
+  info->second.num_missing_decodable = num_not_yet_fulfilled_dependencies;
 
-  for (const Dependency& dep : not_yet_fulfilled_dependencies) {
+  for (size_t i = 0; i < num_not_yet_fulfilled_dependencies; ++i) {
+    const Dependency& dep = not_yet_fulfilled_dependencies[i];
     if (dep.continuous)
       --info->second.num_missing_continuous;
 
@@ -578,7 +660,7 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
 
 void FrameBuffer::UpdateJitterDelay() {
   TRACE_EVENT0("webrtc", "FrameBuffer::UpdateJitterDelay");
-  if (!stats_callback_)
+  if (!stats_callback_ && !decode_load_shedding_)
     return;
 
   int decode_ms;
@@ -591,9 +673,15 @@ void FrameBuffer::UpdateJitterDelay() {
   if (timing_->GetTimings(&decode_ms, &max_decode_ms, &current_delay_ms,
                           &target_delay_ms, &jitter_buffer_ms,
                           &min_playout_delay_ms, &render_delay_ms)) {
-    stats_callback_->OnFrameBufferTimingsUpdated(
-        decode_ms, max_decode_ms, current_delay_ms, target_delay_ms,
-        jitter_buffer_ms, min_playout_delay_ms, render_delay_ms);
+    if (stats_callback_) {
+      stats_callback_->OnFrameBufferTimingsUpdated(
+          decode_ms, max_decode_ms, current_delay_ms, target_delay_ms,
+          jitter_buffer_ms, min_playout_delay_ms, render_delay_ms);
+    }
+    // |max_decode_ms| is the decode time that VCMCodecTimer expects for most
+    // frames.
+    if (decode_load_shedding_)
+      decode_load_controller_.OnDecodeTime(max_decode_ms);
   }
 }
 
@@ -614,6 +702,34 @@ void FrameBuffer::ClearFramesAndHistory() {
   num_frames_buffered_ = 0;
 }
 
+FrameBuffer::NodePool::~NodePool() {
+  while (free_blocks_) {
+    FreeBlock* block = free_blocks_;
+    free_blocks_ = block->next;
+    ::operator delete(block);
+  }
+}
+
+void* FrameBuffer::NodePool::Allocate(size_t size) {
+  if (size != block_size_ || !free_blocks_)
+    return ::operator new(size);
+  FreeBlock* block = free_blocks_;
+  free_blocks_ = block->next;
+  return block;
+}
+
+void FrameBuffer::NodePool::Free(void* block, size_t size) {
+  if (block_size_ == 0 && size >= sizeof(FreeBlock))
+    block_size_ = size;
+  if (size != block_size_) {
+    ::operator delete(block);
+    return;
+  }
+  FreeBlock* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = free_blocks_;
+  free_blocks_ = free_block;
+}
+
 FrameBuffer::FrameInfo::FrameInfo() = default;
 FrameBuffer::FrameInfo::FrameInfo(FrameInfo&&) = default;
 FrameBuffer::FrameInfo::~FrameInfo() = default;
@@ -14,9 +14,12 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <new>
 #include <utility>
+#include <vector>
 
 #include "api/video/encoded_frame.h"
+#include "modules/video_coding/decode_load_controller.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/inter_frame_delay.h"
 #include "rtc_base/constructormagic.h"
@@ -30,6 +33,7 @@ namespace webrtc {
 class Clock;
 class VCMReceiveStatisticsCallback;
 class VCMJitterEstimator;
+class LayeredJitterEstimator;
 class VCMTiming;
 
 namespace video_coding {
@@ -61,6 +65,19 @@ class FrameBuffer {
                          std::unique_ptr<EncodedFrame>* frame_out,
                          bool keyframe_required = false);
 
+  // Like NextFrame(), but returns right away instead of waiting, for callers
+  // that poll many frame buffers from the same thread.
+  //  - If a frame is due for decoding it will return kFrameFound and set
+  //    |frame_out| to the resulting frame.
+  //  - Otherwise it will return kTimeout and set |wait_ms_out| to the time
+  //    until the next frame is due, at most |max_wait_time_ms|. Frames being
+  //    inserted may make a frame due earlier than that.
+  //  - If the FrameBuffer is stopped then it will return kStopped.
+  ReturnReason NextFrameIfDue(int64_t max_wait_time_ms,
+                              std::unique_ptr<EncodedFrame>* frame_out,
+                              int64_t* wait_ms_out,
+                              bool keyframe_required = false);
+
   // Tells the FrameBuffer which protection mode that is in use. Affects
   // the frame timing.
   // TODO(philipel): Remove this when new timing calculations has been
@@ -79,6 +96,60 @@ class FrameBuffer {
   void UpdateRtt(int64_t rtt_ms);
 
  private:
+  // Keeps the memory of freed FrameMap nodes for reuse, so that inserting and
+  // removing frames doesn't allocate once the buffer has reached its working
+  // size. Only blocks of the size of the first freed block are kept, since
+  // those are the nodes; anything else is passed on to the global allocator.
+  class NodePool {
+   public:
+    NodePool() = default;
+    ~NodePool();
+
+    void* Allocate(size_t size);
+    void Free(void* block, size_t size);
+
+   private:
+    struct FreeBlock {
+      FreeBlock* next;
+    };
+
+    size_t block_size_ = 0;
+    FreeBlock* free_blocks_ = nullptr;
+
+    RTC_DISALLOW_COPY_AND_ASSIGN(NodePool);
+  };
+
+  template <typename T>
+  class NodeAllocator {
+   public:
+    using value_type = T;
+
+    explicit NodeAllocator(NodePool* pool) : pool_(pool) {}
+    template <typename U>
+    NodeAllocator(const NodeAllocator<U>& other)  // NOLINT
+        : pool_(other.pool_) {}
+
+    T* allocate(size_t n) {
+      return static_cast<T*>(pool_->Allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) { pool_->Free(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const NodeAllocator<U>& other) const {
+      return pool_ == other.pool_;
+    }
+    template <typename U>
+    bool operator!=(const NodeAllocator<U>& other) const {
+      return pool_ != other.pool_;
+    }
+
+   private:
+    template <typename U>
+    friend class NodeAllocator;
+
+    NodePool* pool_;
+  };
+
   struct FrameInfo {
     FrameInfo();
     FrameInfo(FrameInfo&&);
@@ -112,7 +183,22 @@ class FrameBuffer {
     std::unique_ptr<EncodedFrame> frame;
   };
 
-  using FrameMap = std::map<VideoLayerFrameId, FrameInfo>;
+  using FrameMap =
+      std::map<VideoLayerFrameId,
+               FrameInfo,
+               std::less<VideoLayerFrameId>,
+               NodeAllocator<std::pair<const VideoLayerFrameId, FrameInfo>>>;
+
+  // Sets |next_frame_it_| to the next frame to decode, if any, and returns the
+  // time until it should be decoded, or |max_wait_time_ms| if there is none.
+  int64_t FindNextFrame(int64_t max_wait_time_ms,
+                        bool keyframe_required,
+                        int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Takes the frame at |next_frame_it_| out of the buffer and updates the
+  // timing and decoded state for it.
+  std::unique_ptr<EncodedFrame> GetNextFrame(int64_t now_ms)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Check that the references of |frame| are valid.
   bool ValidReferences(const EncodedFrame& frame) const;
@@ -143,6 +229,8 @@ class FrameBuffer {
                                         FrameMap::iterator info)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Reports the timings of |timing_| to |stats_callback_| and updates the
+  // decode load with them.
   void UpdateJitterDelay() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   void UpdateTimingFrameInfo() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -152,12 +240,21 @@ class FrameBuffer {
   bool HasBadRenderTiming(const EncodedFrame& frame, int64_t now_ms)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Must outlive |frames_|.
+  NodePool node_pool_;
   FrameMap frames_ RTC_GUARDED_BY(crit_);
+  // Frames that became continuous but whose dependent frames haven't been
+  // visited yet. Only used by PropagateContinuity(), kept to not allocate.
+  std::vector<FrameMap::iterator> continuous_frames_ RTC_GUARDED_BY(crit_);
 
   rtc::CriticalSection crit_;
   Clock* const clock_;
   rtc::Event new_continuous_frame_event_;
   VCMJitterEstimator* const jitter_estimator_ RTC_GUARDED_BY(crit_);
+  // Replaces |jitter_estimator_| when the "WebRTC-LayeredJitterEstimator"
+  // field trial is enabled.
+  std::unique_ptr<LayeredJitterEstimator> layered_jitter_estimator_
+      RTC_GUARDED_BY(crit_);
   VCMTiming* const timing_ RTC_GUARDED_BY(crit_);
   VCMInterFrameDelay inter_frame_delay_ RTC_GUARDED_BY(crit_);
   uint32_t last_decoded_frame_timestamp_ RTC_GUARDED_BY(crit_);
@@ -170,6 +267,10 @@ class FrameBuffer {
   VCMVideoProtection protection_mode_ RTC_GUARDED_BY(crit_);
   VCMReceiveStatisticsCallback* const stats_callback_;
   int64_t last_log_non_decoded_ms_ RTC_GUARDED_BY(crit_);
+  // Skips the highest temporal layers while the decoder can't keep up, unless
+  // the "WebRTC-DecodeLoadShedding" field trial is disabled.
+  const bool decode_load_shedding_;
+  DecodeLoadController decode_load_controller_ RTC_GUARDED_BY(crit_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(FrameBuffer);
 };
@@ -64,14 +64,26 @@ class VCMTimingFake : public VCMTiming {
                   int* jitter_buffer_ms,
                   int* min_playout_delay_ms,
                   int* render_delay_ms) const override {
+    *decode_ms = decode_time_ms_;
+    *max_decode_ms = decode_time_ms_;
+    *current_delay_ms = 0;
+    *target_delay_ms = 0;
+    *jitter_buffer_ms = 0;
+    *min_playout_delay_ms = 0;
+    *render_delay_ms = 0;
     return true;
   }
 
+  void set_decode_time_ms(int decode_time_ms) {
+    decode_time_ms_ = decode_time_ms;
+  }
+
  private:
   static constexpr int kDelayMs = 50;
   static constexpr int kDecodeTime = kDelayMs / 2;
   mutable uint32_t last_timestamp_ = 0;
   mutable int64_t last_ms_ = -1;
+  int decode_time_ms_ = 0;
 };
 
 class VCMJitterEstimatorMock : public VCMJitterEstimator {
@@ -99,6 +111,11 @@ class FrameObjectFake : public EncodedFrame {
   // In EncodedImage |_length| is used to descibe its size and |_size| to
   // describe its capacity.
   void SetSize(int size) { _length = size; }
+
+  void SetVp8TemporalIndex(int temporal_index) {
+    _codecSpecificInfo.codecType = kVideoCodecVP8;
+    _codecSpecificInfo.codecSpecific.VP8.temporalIdx = temporal_index;
+  }
 };
 
 class VCMReceiveStatisticsCallbackMock : public VCMReceiveStatisticsCallback {
@@ -174,6 +191,23 @@ class TestFrameBuffer2 : public ::testing::Test {
     return buffer_->InsertFrame(std::move(frame));
   }
 
+  // Inserts a VP8 frame of |temporal_index| that references |ref|, or a key
+  // frame if |ref| is -1.
+  void InsertVp8Frame(uint16_t picture_id,
+                      int64_t ts_ms,
+                      int temporal_index,
+                      int ref) {
+    std::unique_ptr<FrameObjectFake> frame(new FrameObjectFake());
+    frame->id.picture_id = picture_id;
+    frame->timestamp = ts_ms * 90;
+    if (ref != -1) {
+      frame->num_references = 1;
+      frame->references[0] = ref;
+    }
+    frame->SetVp8TemporalIndex(temporal_index);
+    buffer_->InsertFrame(std::move(frame));
+  }
+
   void ExtractFrame(int64_t max_wait_time = 0, bool keyframe_required = false) {
     crit_.Enter();
     if (max_wait_time == 0) {
@@ -332,6 +366,38 @@ TEST_F(TestFrameBuffer2, ExtractFromEmptyBuffer) {
   CheckNoFrame(0);
 }
 
+TEST_F(TestFrameBuffer2, NextFrameIfDueDoesNotWait) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+  std::unique_ptr<EncodedFrame> frame;
+  int64_t wait_ms = -1;
+
+  EXPECT_EQ(FrameBuffer::ReturnReason::kTimeout,
+            buffer_->NextFrameIfDue(100, &frame, &wait_ms));
+  EXPECT_EQ(100, wait_ms);
+
+  // VCMTimingFake renders the first frame 50 ms from now and expects the
+  // decoding to take 25 ms.
+  InsertFrame(pid, 0, ts, false);
+  EXPECT_EQ(FrameBuffer::ReturnReason::kTimeout,
+            buffer_->NextFrameIfDue(100, &frame, &wait_ms));
+  EXPECT_EQ(25, wait_ms);
+  EXPECT_FALSE(frame);
+  EXPECT_EQ(FrameBuffer::ReturnReason::kTimeout,
+            buffer_->NextFrameIfDue(10, &frame, &wait_ms));
+  EXPECT_EQ(10, wait_ms);
+
+  clock_.AdvanceTimeMilliseconds(25);
+  EXPECT_EQ(FrameBuffer::ReturnReason::kFrameFound,
+            buffer_->NextFrameIfDue(100, &frame, &wait_ms));
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(pid, frame->id.picture_id);
+
+  buffer_->Stop();
+  EXPECT_EQ(FrameBuffer::ReturnReason::kStopped,
+            buffer_->NextFrameIfDue(100, &frame, &wait_ms));
+}
+
 TEST_F(TestFrameBuffer2, MissingFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
@@ -363,6 +429,31 @@ TEST_F(TestFrameBuffer2, OneLayerStream) {
   }
 }
 
+TEST_F(TestFrameBuffer2, SpatialLayersContinuousWhenBaseLayerArrives) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  // The upper layers of each picture arrive before its base layer. Enough
+  // pictures are inserted to cycle through the decoded frame history.
+  EXPECT_EQ(-1, InsertFrame(pid, 2, ts, true));
+  EXPECT_EQ(-1, InsertFrame(pid, 1, ts, true));
+  EXPECT_EQ(pid, InsertFrame(pid, 0, ts, false));
+  for (int i = 1; i < 100; ++i) {
+    uint32_t picture_ts = ts + i * kFps10;
+    EXPECT_EQ(pid + i - 1,
+              InsertFrame(pid + i, 2, picture_ts, true, pid + i - 1));
+    EXPECT_EQ(pid + i - 1,
+              InsertFrame(pid + i, 1, picture_ts, true, pid + i - 1));
+    EXPECT_EQ(pid + i, InsertFrame(pid + i, 0, picture_ts, false, pid + i - 1));
+
+    for (int spatial_layer = 0; spatial_layer < 3; ++spatial_layer) {
+      ExtractFrame();
+      CheckFrame(frames_.size() - 1, pid + i - 1, spatial_layer);
+    }
+    clock_.AdvanceTimeMilliseconds(kFps10);
+  }
+}
+
 TEST_F(TestFrameBuffer2, DropTemporalLayerSlowDecoder) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
@@ -602,5 +693,34 @@ TEST_F(TestFrameBuffer2, DontUpdateOnUndecodableFrame) {
   ExtractFrame(0, true);
 }
 
+TEST_F(TestFrameBuffer2, SkipsHighestTemporalLayerWhenDecoderIsOverloaded) {
+  // Two temporal layers at 20 fps, with decoding taking almost all of the
+  // 50 ms between the frames.
+  timing_.set_decode_time_ms(48);
+  InsertVp8Frame(0, 0, 0, -1);
+  InsertVp8Frame(1, 50, 1, 0);
+  InsertVp8Frame(2, 100, 0, 0);
+  ExtractFrame();
+  ExtractFrame();
+  InsertVp8Frame(3, 150, 1, 2);
+  InsertVp8Frame(4, 200, 0, 2);
+  ExtractFrame();
+
+  // The upper layer is decoded again once a decoded frame shows that the
+  // decoder has caught up.
+  timing_.set_decode_time_ms(10);
+  InsertVp8Frame(5, 250, 1, 4);
+  InsertVp8Frame(6, 300, 0, 4);
+  ExtractFrame();
+  InsertVp8Frame(7, 350, 1, 6);
+  ExtractFrame();
+
+  CheckFrame(0, 0, 0);
+  CheckFrame(1, 2, 0);
+  CheckFrame(2, 4, 0);
+  CheckFrame(3, 6, 0);
+  CheckFrame(4, 7, 0);
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
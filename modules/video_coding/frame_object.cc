@@ -10,6 +10,8 @@
 
 #include "modules/video_coding/frame_object.h"
 
+#include <string.h>
+
 #include "common_video/h264/h264_common.h"
 #include "modules/video_coding/packet_buffer.h"
 #include "rtc_base/checks.h"
@@ -49,22 +51,12 @@ RtpFrameObject::RtpFrameObject(PacketBuffer* packet_buffer,
   // as of the first packet's.
   SetPlayoutDelay(first_packet->video_header.playout_delay);
 
-  // Since FFmpeg use an optimized bitstream reader that reads in chunks of
-  // 32/64 bits we have to add at least that much padding to the buffer
-  // to make sure the decoder doesn't read out of bounds.
-  // NOTE! EncodedImage::_size is the size of the buffer (think capacity of
-  //       an std::vector) and EncodedImage::_length is the actual size of
-  //       the bitstream (think size of an std::vector).
-  if (codec_type_ == kVideoCodecH264)
-    _size = frame_size + EncodedImage::kBufferPaddingBytesH264;
-  else
-    _size = frame_size;
-
-  _buffer = new uint8_t[_size];
+  // Take over the packet payloads rather than copying them. The EncodedImage
+  // buffer is only allocated by MakeBitstreamContiguous(), which is what
+  // decoders need, so until then |_size| is 0 and |_buffer| is null.
   _length = frame_size;
-
-  bool bitstream_copied = GetBitstream(_buffer);
-  RTC_DCHECK(bitstream_copied);
+  bool bitstream_taken = packet_buffer_->TakeBitstream(*this, &fragments_);
+  RTC_DCHECK(bitstream_taken);
   _encodedWidth = first_packet->width;
   _encodedHeight = first_packet->height;
 
@@ -137,7 +129,46 @@ VideoCodecType RtpFrameObject::codec_type() const {
 }
 
 bool RtpFrameObject::GetBitstream(uint8_t* destination) const {
-  return packet_buffer_->GetBitstream(*this, destination);
+  if (_buffer) {
+    memcpy(destination, _buffer, _length);
+    return true;
+  }
+  for (const Fragment& fragment : fragments_) {
+    memcpy(destination, fragment.data.get(), fragment.size);
+    destination += fragment.size;
+  }
+  return true;
+}
+
+void RtpFrameObject::GetBitstreamFragments(
+    std::vector<rtc::ArrayView<const uint8_t>>* fragments) const {
+  if (_buffer) {
+    EncodedFrame::GetBitstreamFragments(fragments);
+    return;
+  }
+  for (const Fragment& fragment : fragments_)
+    fragments->emplace_back(fragment.data.get(), fragment.size);
+}
+
+void RtpFrameObject::MakeBitstreamContiguous() {
+  if (_buffer)
+    return;
+
+  // Since FFmpeg use an optimized bitstream reader that reads in chunks of
+  // 32/64 bits we have to add at least that much padding to the buffer
+  // to make sure the decoder doesn't read out of bounds.
+  // NOTE! EncodedImage::_size is the size of the buffer (think capacity of
+  //       an std::vector) and EncodedImage::_length is the actual size of
+  //       the bitstream (think size of an std::vector).
+  if (codec_type_ == kVideoCodecH264)
+    _size = _length + EncodedImage::kBufferPaddingBytesH264;
+  else
+    _size = _length;
+
+  uint8_t* buffer = new uint8_t[_size];
+  GetBitstream(buffer);
+  _buffer = buffer;
+  fragments_.clear();
 }
 
 uint32_t RtpFrameObject::Timestamp() const {
@@ -11,6 +11,9 @@
 #ifndef MODULES_VIDEO_CODING_FRAME_OBJECT_H_
 #define MODULES_VIDEO_CODING_FRAME_OBJECT_H_
 
+#include <memory>
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "api/video/encoded_frame.h"
 #include "common_types.h"  // NOLINT(build/include)
@@ -23,6 +26,12 @@ class PacketBuffer;
 
 class RtpFrameObject : public EncodedFrame {
  public:
+  // The payload of one packet of the frame.
+  struct Fragment {
+    std::unique_ptr<const uint8_t[]> data;
+    size_t size;
+  };
+
   RtpFrameObject(PacketBuffer* packet_buffer,
                  uint16_t first_seq_num,
                  uint16_t last_seq_num,
@@ -37,6 +46,9 @@ class RtpFrameObject : public EncodedFrame {
   enum FrameType frame_type() const;
   VideoCodecType codec_type() const;
   bool GetBitstream(uint8_t* destination) const override;
+  void GetBitstreamFragments(
+      std::vector<rtc::ArrayView<const uint8_t>>* fragments) const override;
+  void MakeBitstreamContiguous() override;
   uint32_t Timestamp() const override;
   int64_t ReceivedTime() const override;
   int64_t RenderTime() const override;
@@ -51,6 +63,9 @@ class RtpFrameObject : public EncodedFrame {
   uint16_t last_seq_num_;
   uint32_t timestamp_;
   int64_t received_time_;
+  // The packet payloads, taken over from the packet buffer when the frame is
+  // created. Empty once they have been copied into the EncodedImage buffer.
+  std::vector<Fragment> fragments_;
 
   // Equal to times nacked of the packet with the highet times nacked
   // belonging to this frame.
@@ -22,11 +22,20 @@
 
 namespace webrtc {
 
+namespace {
+// Returns the number of frames to keep information about for a decoder that
+// may have |max_pending_frames| frames in flight. A full VCMTimestampMap holds
+// one entry less than its capacity.
+size_t FrameMemoryLength(size_t max_pending_frames) {
+  return std::max<size_t>(kDecoderFrameMemoryLength, max_pending_frames + 1);
+}
+}  // namespace
+
 VCMDecodedFrameCallback::VCMDecodedFrameCallback(VCMTiming* timing,
                                                  Clock* clock)
     : _clock(clock),
       _timing(timing),
-      _timestampMap(kDecoderFrameMemoryLength),
+      _timestampMap(new VCMTimestampMap(kDecoderFrameMemoryLength)),
       _lastReceivedPictureID(0) {
   ntp_offset_ =
       _clock->CurrentNtpInMilliseconds() - _clock->TimeInMilliseconds();
@@ -73,7 +82,7 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
   VCMFrameInformation* frameInfo;
   {
     rtc::CritScope cs(&lock_);
-    frameInfo = _timestampMap.Pop(decodedImage.timestamp());
+    frameInfo = _timestampMap->Pop(decodedImage.timestamp());
   }
 
   if (frameInfo == NULL) {
@@ -169,23 +178,34 @@ void VCMDecodedFrameCallback::OnDecoderImplementationName(
 void VCMDecodedFrameCallback::Map(uint32_t timestamp,
                                   VCMFrameInformation* frameInfo) {
   rtc::CritScope cs(&lock_);
-  _timestampMap.Add(timestamp, frameInfo);
+  _timestampMap->Add(timestamp, frameInfo);
 }
 
 int32_t VCMDecodedFrameCallback::Pop(uint32_t timestamp) {
   rtc::CritScope cs(&lock_);
-  if (_timestampMap.Pop(timestamp) == NULL) {
+  if (_timestampMap->Pop(timestamp) == NULL) {
     return VCM_GENERAL_ERROR;
   }
   return VCM_OK;
 }
 
+void VCMDecodedFrameCallback::SetMaxPendingFrames(size_t max_pending_frames) {
+  rtc::CritScope cs(&lock_);
+  _timestampMap.reset(
+      new VCMTimestampMap(FrameMemoryLength(max_pending_frames)));
+}
+
+size_t VCMDecodedFrameCallback::PendingFrames() const {
+  rtc::CritScope cs(&lock_);
+  return _timestampMap->Size();
+}
+
 VCMGenericDecoder::VCMGenericDecoder(std::unique_ptr<VideoDecoder> decoder)
     : VCMGenericDecoder(decoder.release(), false /* isExternal */) {}
 
 VCMGenericDecoder::VCMGenericDecoder(VideoDecoder* decoder, bool isExternal)
     : _callback(NULL),
-      _frameInfos(),
+      _frameInfos(kDecoderFrameMemoryLength),
       _nextFrameInfoIdx(0),
       decoder_(decoder),
       _codecType(kVideoCodecUnknown),
@@ -227,7 +247,8 @@ int32_t VCMGenericDecoder::Decode(const VCMEncodedFrame& frame, int64_t nowMs) {
   }
   _callback->Map(frame.TimeStamp(), &_frameInfos[_nextFrameInfoIdx]);
 
-  _nextFrameInfoIdx = (_nextFrameInfoIdx + 1) % kDecoderFrameMemoryLength;
+  _nextFrameInfoIdx = (_nextFrameInfoIdx + 1) % _frameInfos.size();
+  TRACE_COUNTER1("webrtc", "DecoderPendingFrames", _callback->PendingFrames());
   int32_t ret = decoder_->Decode(frame.EncodedImage(), frame.MissingFrame(),
                                  frame.CodecSpecific(), frame.RenderTimeMs());
 
@@ -248,6 +269,11 @@ int32_t VCMGenericDecoder::Decode(const VCMEncodedFrame& frame, int64_t nowMs) {
 int32_t VCMGenericDecoder::RegisterDecodeCompleteCallback(
     VCMDecodedFrameCallback* callback) {
   _callback = callback;
+  // Frame information must outlive the frames in flight, so keep as many
+  // entries as the timestamp map of the callback can hold.
+  _frameInfos.resize(FrameMemoryLength(decoder_->MaxPendingFrames()));
+  _nextFrameInfoIdx = 0;
+  _callback->SetMaxPendingFrames(decoder_->MaxPendingFrames());
   return decoder_->RegisterDecodeCompleteCallback(callback);
 }
 
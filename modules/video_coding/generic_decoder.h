@@ -12,6 +12,7 @@
 #define MODULES_VIDEO_CODING_GENERIC_DECODER_H_
 
 #include <memory>
+#include <vector>
 
 #include "modules/include/module_common_types.h"
 #include "modules/video_coding/encoded_frame.h"
@@ -57,6 +58,13 @@ class VCMDecodedFrameCallback : public DecodedImageCallback {
   void Map(uint32_t timestamp, VCMFrameInformation* frameInfo);
   int32_t Pop(uint32_t timestamp);
 
+  // Makes room for |max_pending_frames| frames in flight in the decoder.
+  // Frames that are already mapped are forgotten.
+  void SetMaxPendingFrames(size_t max_pending_frames);
+  // Returns the number of frames passed to the decoder that haven't been
+  // decoded yet.
+  size_t PendingFrames() const;
+
  private:
   rtc::ThreadChecker construction_thread_;
   // Protect |_timestampMap|.
@@ -68,8 +76,8 @@ class VCMDecodedFrameCallback : public DecodedImageCallback {
   // from the same thread, and therfore a lock is not required to access it.
   VCMReceiveCallback* _receiveCallback = nullptr;
   VCMTiming* _timing;
-  rtc::CriticalSection lock_;
-  VCMTimestampMap _timestampMap RTC_GUARDED_BY(lock_);
+  mutable rtc::CriticalSection lock_;
+  std::unique_ptr<VCMTimestampMap> _timestampMap RTC_GUARDED_BY(lock_);
   uint64_t _lastReceivedPictureID;
   int64_t ntp_offset_;
 };
@@ -105,7 +113,8 @@ class VCMGenericDecoder {
 
  private:
   VCMDecodedFrameCallback* _callback;
-  VCMFrameInformation _frameInfos[kDecoderFrameMemoryLength];
+  // Sized to hold the frames that may be in flight in the decoder.
+  std::vector<VCMFrameInformation> _frameInfos;
   uint32_t _nextFrameInfoIdx;
   std::unique_ptr<VideoDecoder> decoder_;
   VideoCodecType _codecType;
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <deque>
+#include <memory>
+
+#include "api/video/i420_buffer.h"
+#include "modules/video_coding/encoded_frame.h"
+#include "modules/video_coding/generic_decoder.h"
+#include "modules/video_coding/include/video_coding_defines.h"
+#include "modules/video_coding/timing.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+constexpr size_t kMaxPendingFrames = 16;
+constexpr uint32_t kFrameIntervalRtp = 3000;
+
+class TestEncodedFrame : public VCMEncodedFrame {
+ public:
+  explicit TestEncodedFrame(uint32_t timestamp) { _timeStamp = timestamp; }
+};
+
+// Decoder that holds on to all frames until told to output them, like a
+// hardware decoder with an internal queue.
+class QueueingDecoder : public VideoDecoder {
+ public:
+  int32_t InitDecode(const VideoCodec* codec_settings,
+                     int32_t number_of_cores) override {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t Decode(const EncodedImage& input_image,
+                 bool missing_frames,
+                 const CodecSpecificInfo* codec_specific_info,
+                 int64_t render_time_ms) override {
+    pending_timestamps_.push_back(input_image._timeStamp);
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t RegisterDecodeCompleteCallback(
+      DecodedImageCallback* callback) override {
+    callback_ = callback;
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t Release() override { return WEBRTC_VIDEO_CODEC_OK; }
+  size_t MaxPendingFrames() const override { return kMaxPendingFrames; }
+
+  void OutputFrames() {
+    while (!pending_timestamps_.empty()) {
+      VideoFrame frame(I420Buffer::Create(2, 2), pending_timestamps_.front(),
+                       0, kVideoRotation_0);
+      pending_timestamps_.pop_front();
+      callback_->Decoded(frame, absl::nullopt, absl::nullopt);
+    }
+  }
+
+ private:
+  DecodedImageCallback* callback_ = nullptr;
+  std::deque<uint32_t> pending_timestamps_;
+};
+
+class CountingReceiveCallback : public VCMReceiveCallback {
+ public:
+  int32_t FrameToRender(VideoFrame& videoFrame,
+                        absl::optional<uint8_t> qp,
+                        VideoContentType content_type) override {
+    ++frames_rendered_;
+    return 0;
+  }
+
+  int frames_rendered() const { return frames_rendered_; }
+
+ private:
+  int frames_rendered_ = 0;
+};
+}  // namespace
+
+TEST(GenericDecoderTest, KeepsTrackOfAllFramesInFlight) {
+  SimulatedClock clock(1000);
+  VCMTiming timing(&clock);
+  CountingReceiveCallback receive_callback;
+  VCMDecodedFrameCallback decoded_frame_callback(&timing, &clock);
+  decoded_frame_callback.SetUserReceiveCallback(&receive_callback);
+
+  QueueingDecoder* decoder = new QueueingDecoder();
+  VCMGenericDecoder generic_decoder((std::unique_ptr<VideoDecoder>(decoder)));
+  generic_decoder.RegisterDecodeCompleteCallback(&decoded_frame_callback);
+
+  for (size_t i = 0; i < kMaxPendingFrames; ++i) {
+    TestEncodedFrame frame(i * kFrameIntervalRtp);
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+              generic_decoder.Decode(frame, clock.TimeInMilliseconds()));
+  }
+  EXPECT_EQ(kMaxPendingFrames, decoded_frame_callback.PendingFrames());
+
+  decoder->OutputFrames();
+  EXPECT_EQ(static_cast<int>(kMaxPendingFrames),
+            receive_callback.frames_rendered());
+  EXPECT_EQ(0u, decoded_frame_callback.PendingFrames());
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -61,6 +61,10 @@ struct CodecSpecificInfoVP9 {
   uint8_t p_diff[kMaxVp9RefPics];
 
   bool end_of_picture;
+
+  // Time spent encoding this layer frame, in microseconds. With spatial
+  // layers, counted from when the encoder output the lower layer frame.
+  int64_t encode_time_us;
 };
 
 struct CodecSpecificInfoGeneric {
@@ -26,6 +26,8 @@ namespace webrtc {
 enum { kStartupDelaySamples = 30 };
 enum { kFsAccuStartupSamples = 5 };
 enum { kMaxFramerateEstimate = 200 };
+constexpr int kAlphaCountMax = 400;
+constexpr int kLowLatencyAlphaCountMax = 30;
 
 VCMJitterEstimator::VCMJitterEstimator(const Clock* clock,
                                        int32_t vcmId,
@@ -34,7 +36,7 @@ VCMJitterEstimator::VCMJitterEstimator(const Clock* clock,
       _receiverId(receiverId),
       _phi(0.97),
       _psi(0.9999),
-      _alphaCountMax(400),
+      _alphaCountMax(kAlphaCountMax),
       _thetaLow(0.000001),
       _nackLimit(3),
       _numStdDevDelayOutlier(15),
@@ -70,6 +72,7 @@ VCMJitterEstimator& VCMJitterEstimator::operator=(
     _prevFrameSize = rhs._prevFrameSize;
     _avgNoise = rhs._avgNoise;
     _alphaCount = rhs._alphaCount;
+    _alphaCountMax = rhs._alphaCountMax;
     _filterJitterEstimate = rhs._filterJitterEstimate;
     _startupCount = rhs._startupCount;
     _latestNackTimestamp = rhs._latestNackTimestamp;
@@ -109,6 +112,12 @@ void VCMJitterEstimator::Reset() {
   fps_counter_.Reset();
 }
 
+void VCMJitterEstimator::SetLowLatencyMode(bool enabled) {
+  _alphaCountMax = enabled ? kLowLatencyAlphaCountMax : kAlphaCountMax;
+  if (_alphaCount > _alphaCountMax)
+    _alphaCount = _alphaCountMax;
+}
+
 void VCMJitterEstimator::ResetNackCount() {
   _nackCount = 0;
 }
@@ -191,6 +200,14 @@ void VCMJitterEstimator::UpdateEstimate(int64_t frameDelayMS,
   }
 }
 
+void VCMJitterEstimator::UpdateKeyFrameEstimate(int64_t frameDelayMS,
+                                                uint32_t frameSizeBytes) {
+  if (_prevFrameSize == 0 || frameSizeBytes <= _prevFrameSize) {
+    return;
+  }
+  KalmanEstimateChannel(frameDelayMS, frameSizeBytes - _prevFrameSize);
+}
+
 // Updates the nack/packet ratio
 void VCMJitterEstimator::FrameNacked() {
   // Wait until _nackLimit retransmissions has been received,
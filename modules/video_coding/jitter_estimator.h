@@ -43,6 +43,13 @@ class VCMJitterEstimator {
                       uint32_t frameSizeBytes,
                       bool incompleteFrame = false);
 
+  // Updates only the frame size dependent part of the estimate with a key
+  // frame. The size of a key frame tells how fast the channel is, but since
+  // key frames are rare they neither add to the random jitter nor become the
+  // frame size the delay is budgeted for. The next delta frame is compared
+  // with the delta frame preceding the key frame.
+  void UpdateKeyFrameEstimate(int64_t frameDelayMS, uint32_t frameSizeBytes);
+
   // Returns the current jitter estimate in milliseconds and adds
   // also adds an RTT dependent term in cases of retransmission.
   //  Input:
@@ -62,6 +69,11 @@ class VCMJitterEstimator {
 
   void UpdateMaxFrameSize(uint32_t frameSizeBytes);
 
+  // Limits the memory of the random jitter filter to a few frames so that the
+  // estimate follows changes in network jitter quickly. Used for latency-first
+  // playout where a short rebuffer is preferred over a long delay.
+  void SetLowLatencyMode(bool enabled);
+
   // A constant describing the delay from the jitter buffer
   // to the delay on the receiving side which is not accounted
   // for by the jitter buffer nor the decoding delay estimate.
@@ -126,7 +138,7 @@ class VCMJitterEstimator {
   int32_t _receiverId;
   const double _phi;
   const double _psi;
-  const uint32_t _alphaCountMax;
+  uint32_t _alphaCountMax;
   const double _thetaLow;
   const uint32_t _nackLimit;
   const int32_t _numStdDevDelayOutlier;
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/layered_jitter_estimator.h"
+
+#include <algorithm>
+
+#include "absl/memory/memory.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+// A layer that hasn't received a frame for this long is no longer part of
+// the estimate, and starts over if it comes back.
+constexpr int64_t kLayerTimeoutMs = 3000;
+}  // namespace
+
+LayeredJitterEstimator::Layer::Layer(const Clock* clock, int64_t now_ms)
+    : estimator(clock),
+      inter_frame_delay(now_ms),
+      last_update_ms(now_ms) {}
+
+LayeredJitterEstimator::LayeredJitterEstimator(const Clock* clock)
+    : clock_(clock), low_latency_mode_(false) {}
+
+LayeredJitterEstimator::~LayeredJitterEstimator() = default;
+
+void LayeredJitterEstimator::Reset() {
+  layers_.clear();
+}
+
+void LayeredJitterEstimator::UpdateEstimate(uint32_t rtp_timestamp,
+                                            int64_t received_time_ms,
+                                            size_t frame_size,
+                                            bool is_keyframe,
+                                            int spatial_index,
+                                            int temporal_index) {
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  RemoveInactiveLayers(now_ms);
+
+  if (temporal_index == kNoTemporalIdx)
+    temporal_index = 0;
+  std::unique_ptr<Layer>& layer =
+      layers_[std::make_pair(spatial_index, temporal_index)];
+  if (!layer) {
+    layer = absl::make_unique<Layer>(clock_, now_ms);
+    layer->estimator.SetLowLatencyMode(low_latency_mode_);
+    if (rtt_ms_)
+      layer->estimator.UpdateRtt(*rtt_ms_);
+  }
+  layer->last_update_ms = now_ms;
+
+  int64_t frame_delay_ms;
+  if (is_keyframe) {
+    // Measure the key frame against the last delta frame without advancing
+    // the delta frame history, so that the delta frame after it isn't
+    // measured against the late arrival of the key frame.
+    VCMInterFrameDelay key_frame_delay = layer->inter_frame_delay;
+    if (key_frame_delay.CalculateDelay(rtp_timestamp, &frame_delay_ms,
+                                       received_time_ms)) {
+      layer->estimator.UpdateKeyFrameEstimate(frame_delay_ms, frame_size);
+    }
+    return;
+  }
+  if (layer->inter_frame_delay.CalculateDelay(rtp_timestamp, &frame_delay_ms,
+                                              received_time_ms)) {
+    layer->estimator.UpdateEstimate(frame_delay_ms, frame_size);
+  }
+}
+
+int LayeredJitterEstimator::GetJitterEstimate(double rtt_multiplier) {
+  RemoveInactiveLayers(clock_->TimeInMilliseconds());
+  int jitter_estimate_ms = 0;
+  for (auto& layer : layers_) {
+    jitter_estimate_ms =
+        std::max(jitter_estimate_ms,
+                 layer.second->estimator.GetJitterEstimate(rtt_multiplier));
+  }
+  return jitter_estimate_ms;
+}
+
+void LayeredJitterEstimator::FrameNacked() {
+  for (auto& layer : layers_)
+    layer.second->estimator.FrameNacked();
+}
+
+void LayeredJitterEstimator::UpdateRtt(int64_t rtt_ms) {
+  rtt_ms_ = rtt_ms;
+  for (auto& layer : layers_)
+    layer.second->estimator.UpdateRtt(rtt_ms);
+}
+
+void LayeredJitterEstimator::SetLowLatencyMode(bool enabled) {
+  low_latency_mode_ = enabled;
+  for (auto& layer : layers_)
+    layer.second->estimator.SetLowLatencyMode(enabled);
+}
+
+void LayeredJitterEstimator::RemoveInactiveLayers(int64_t now_ms) {
+  for (auto it = layers_.begin(); it != layers_.end();) {
+    if (now_ms - it->second->last_update_ms > kLayerTimeoutMs) {
+      it = layers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace webrtc
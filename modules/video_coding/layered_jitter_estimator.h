@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_LAYERED_JITTER_ESTIMATOR_H_
+#define MODULES_VIDEO_CODING_LAYERED_JITTER_ESTIMATOR_H_
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "modules/video_coding/inter_frame_delay.h"
+#include "modules/video_coding/jitter_estimator.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Jitter estimator that keeps a separate VCMJitterEstimator per spatial and
+// temporal layer, so that the frame size model of one layer isn't disturbed
+// by the very different frame sizes of another. Inter-frame delays are
+// measured between frames of the same layer, and key frames only update the
+// channel model of their layer (see
+// VCMJitterEstimator::UpdateKeyFrameEstimate()) instead of setting the
+// budgeted frame size. Layers that stop receiving frames, e.g. after an SVC
+// layer switch, are dropped after a while. The resulting estimate is the
+// largest estimate of the active layers and is meant to be passed to
+// VCMTiming::SetJitterDelay() like the one of VCMJitterEstimator.
+class LayeredJitterEstimator {
+ public:
+  explicit LayeredJitterEstimator(const Clock* clock);
+  ~LayeredJitterEstimator();
+
+  void Reset();
+
+  // Updates the estimate of the layer the frame belongs to. |temporal_index|
+  // may be kNoTemporalIdx.
+  void UpdateEstimate(uint32_t rtp_timestamp,
+                      int64_t received_time_ms,
+                      size_t frame_size,
+                      bool is_keyframe,
+                      int spatial_index,
+                      int temporal_index);
+
+  // Returns the jitter estimate in milliseconds, see
+  // VCMJitterEstimator::GetJitterEstimate().
+  int GetJitterEstimate(double rtt_multiplier);
+
+  void FrameNacked();
+  void UpdateRtt(int64_t rtt_ms);
+  void SetLowLatencyMode(bool enabled);
+
+ private:
+  struct Layer {
+    Layer(const Clock* clock, int64_t now_ms);
+
+    VCMJitterEstimator estimator;
+    // Inter-frame delay relative to the last delta frame of the layer.
+    VCMInterFrameDelay inter_frame_delay;
+    int64_t last_update_ms;
+  };
+
+  // Drops the layers that haven't received a frame for a while.
+  void RemoveInactiveLayers(int64_t now_ms);
+
+  const Clock* const clock_;
+  std::map<std::pair<int, int>, std::unique_ptr<Layer>> layers_;
+  absl::optional<int64_t> rtt_ms_;
+  bool low_latency_mode_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_LAYERED_JITTER_ESTIMATOR_H_
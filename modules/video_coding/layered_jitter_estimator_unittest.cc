@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/layered_jitter_estimator.h"
+
+#include <algorithm>
+
+#include "modules/video_coding/inter_frame_delay.h"
+#include "modules/video_coding/jitter_estimator.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+constexpr int kFrameIntervalMs = 33;
+constexpr uint32_t kFrameIntervalRtp = kFrameIntervalMs * 90;
+constexpr size_t kDeltaFrameSize = 1000;
+constexpr size_t kKeyFrameSize = 20000;
+constexpr int kKeyFrameIntervalFrames = 60;
+// Extra time it takes to receive a key frame.
+constexpr int kKeyFrameDelayMs = 40;
+}  // namespace
+
+class LayeredJitterEstimatorTest : public ::testing::Test {
+ protected:
+  LayeredJitterEstimatorTest()
+      : clock_(1000),
+        layered_estimator_(&clock_),
+        estimator_(&clock_),
+        inter_frame_delay_(clock_.TimeInMilliseconds()) {}
+
+  // Feeds the same frame to both estimators and advances the clock to the
+  // next frame.
+  void InsertFrame(uint32_t rtp_timestamp,
+                   int64_t received_time_ms,
+                   size_t frame_size,
+                   bool is_keyframe) {
+    layered_estimator_.UpdateEstimate(rtp_timestamp, received_time_ms,
+                                      frame_size, is_keyframe, 0, 0);
+    int64_t frame_delay_ms;
+    if (inter_frame_delay_.CalculateDelay(rtp_timestamp, &frame_delay_ms,
+                                          received_time_ms)) {
+      estimator_.UpdateEstimate(frame_delay_ms, frame_size);
+    }
+    clock_.AdvanceTimeMilliseconds(kFrameIntervalMs);
+  }
+
+  SimulatedClock clock_;
+  LayeredJitterEstimator layered_estimator_;
+  VCMJitterEstimator estimator_;
+  VCMInterFrameDelay inter_frame_delay_;
+};
+
+TEST_F(LayeredJitterEstimatorTest, KeyFramesAddLessDelay) {
+  uint32_t rtp_timestamp = 0;
+  int64_t last_received_ms = 0;
+  for (int i = 0; i < 20 * kKeyFrameIntervalFrames; ++i) {
+    const bool is_keyframe = i % kKeyFrameIntervalFrames == 0;
+    int64_t received_ms = clock_.TimeInMilliseconds();
+    if (is_keyframe)
+      received_ms += kKeyFrameDelayMs;
+    // Frames sent after a key frame are queued behind it.
+    received_ms = std::max(received_ms, last_received_ms + 1);
+    InsertFrame(rtp_timestamp, received_ms,
+                is_keyframe ? kKeyFrameSize : kDeltaFrameSize, is_keyframe);
+    last_received_ms = received_ms;
+    rtp_timestamp += kFrameIntervalRtp;
+  }
+  EXPECT_LT(layered_estimator_.GetJitterEstimate(1.0),
+            estimator_.GetJitterEstimate(1.0));
+}
+
+TEST_F(LayeredJitterEstimatorTest, InactiveLayerIsDropped) {
+  uint32_t rtp_timestamp = 0;
+  for (int i = 0; i < 300; ++i) {
+    const int64_t now_ms = clock_.TimeInMilliseconds();
+    layered_estimator_.UpdateEstimate(rtp_timestamp, now_ms, kDeltaFrameSize,
+                                      false, 0, 0);
+    // The second spatial layer arrives with a lot of jitter.
+    layered_estimator_.UpdateEstimate(rtp_timestamp,
+                                      now_ms + (i % 2 == 0 ? 0 : 30),
+                                      kDeltaFrameSize, false, 1, 0);
+    clock_.AdvanceTimeMilliseconds(kFrameIntervalMs);
+    rtp_timestamp += kFrameIntervalRtp;
+  }
+  const int estimate_with_both_layers_ms =
+      layered_estimator_.GetJitterEstimate(1.0);
+
+  // Switch to the first spatial layer only.
+  for (int i = 0; i < 150; ++i) {
+    layered_estimator_.UpdateEstimate(rtp_timestamp,
+                                      clock_.TimeInMilliseconds(),
+                                      kDeltaFrameSize, false, 0, 0);
+    clock_.AdvanceTimeMilliseconds(kFrameIntervalMs);
+    rtp_timestamp += kFrameIntervalRtp;
+  }
+  EXPECT_LT(layered_estimator_.GetJitterEstimate(1.0),
+            estimate_with_both_layers_ms);
+}
+
+}  // namespace webrtc
@@ -13,9 +13,12 @@
 
 #include "modules/video_coding/nack_module.h"
 
+#include "absl/types/variant.h"
 #include "modules/utility/include/process_thread.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -28,16 +31,41 @@ const int kProcessFrequency = 50;
 const int kProcessIntervalMs = 1000 / kProcessFrequency;
 const int kMaxReorderedPackets = 128;
 const int kNumReorderingBuckets = 10;
+const char kNackBudgetTrial[] = "WebRTC-NackBudget";
+
+int TemporalIndex(const VCMPacket& packet) {
+  const RTPVideoTypeHeader& header = packet.video_header.video_type_header;
+  if (const auto* vp8 = absl::get_if<RTPVideoHeaderVP8>(&header))
+    return vp8->temporalIdx == kNoTemporalIdx ? 0 : vp8->temporalIdx;
+  if (const auto* vp9 = absl::get_if<RTPVideoHeaderVP9>(&header))
+    return vp9->temporal_idx == kNoTemporalIdx ? 0 : vp9->temporal_idx;
+  return packet.video_header.temporal_index;
+}
 }  // namespace
 
+NackModule::NackBudgetConfig::NackBudgetConfig(std::string field_trial)
+    : rate("rate"), window("window", TimeDelta::ms(100)) {
+  ParseFieldTrial({&rate, &window}, field_trial);
+}
+NackModule::NackBudgetConfig::NackBudgetConfig(const NackBudgetConfig&) =
+    default;
+NackModule::NackBudgetConfig::~NackBudgetConfig() = default;
+
 NackModule::NackInfo::NackInfo()
-    : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
+    : seq_num(0),
+      send_at_seq_num(0),
+      sent_at_time(-1),
+      retries(0),
+      priority(kOtherPacket) {}
 
-NackModule::NackInfo::NackInfo(uint16_t seq_num, uint16_t send_at_seq_num)
+NackModule::NackInfo::NackInfo(uint16_t seq_num,
+                               uint16_t send_at_seq_num,
+                               NackPriority priority)
     : seq_num(seq_num),
       send_at_seq_num(send_at_seq_num),
       sent_at_time(-1),
-      retries(0) {}
+      retries(0),
+      priority(priority) {}
 
 NackModule::NackModule(Clock* clock,
                        NackSender* nack_sender,
@@ -45,10 +73,13 @@ NackModule::NackModule(Clock* clock,
     : clock_(clock),
       nack_sender_(nack_sender),
       keyframe_request_sender_(keyframe_request_sender),
+      budget_config_(field_trial::FindFullName(kNackBudgetTrial)),
       reordering_histogram_(kNumReorderingBuckets, kMaxReorderedPackets),
       initialized_(false),
       rtt_ms_(kDefaultRttMs),
       newest_seq_num_(0),
+      budget_packets_(0),
+      budget_updated_ms_(-1),
       next_process_time_ms_(-1) {
   RTC_DCHECK(clock_);
   RTC_DCHECK(nack_sender_);
@@ -56,6 +87,28 @@ NackModule::NackModule(Clock* clock,
 }
 
 int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
+  return OnReceivedPacket(seq_num, is_keyframe, nullptr);
+}
+
+int NackModule::OnReceivedPacket(const VCMPacket& packet) {
+  PacketFrameInfo frame_info;
+  frame_info.timestamp = packet.timestamp;
+  if (packet.frameType == kVideoFrameKey) {
+    frame_info.priority = kKeyFramePacket;
+  } else if (TemporalIndex(packet) == 0) {
+    frame_info.priority = kBaseLayerPacket;
+  }
+  frame_info.first_packet_in_frame = packet.is_first_packet_in_frame;
+  frame_info.last_packet_in_frame = packet.markerBit;
+  return OnReceivedPacket(
+      packet.seqNum,
+      packet.is_first_packet_in_frame && packet.frameType == kVideoFrameKey,
+      &frame_info);
+}
+
+int NackModule::OnReceivedPacket(uint16_t seq_num,
+                                 bool is_keyframe,
+                                 const PacketFrameInfo* frame_info) {
   rtc::CritScope lock(&crit_);
   // TODO(philipel): When the packet includes information whether it is
   //                 retransmitted or not, use that value instead. For
@@ -67,6 +120,8 @@ int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
     newest_seq_num_ = seq_num;
     if (is_keyframe)
       keyframe_list_.insert(seq_num);
+    if (frame_info)
+      newest_frame_info_ = *frame_info;
     initialized_ = true;
     return 0;
   }
@@ -82,13 +137,30 @@ int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
     int nacks_sent_for_packet = 0;
     if (nack_list_it != nack_list_.end()) {
       nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+      EraseNacks(nack_list_it, std::next(nack_list_it));
     }
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
     return nacks_sent_for_packet;
   }
-  AddPacketsToNack(newest_seq_num_ + 1, seq_num);
+  // The missing packets belong to the frame of the newest packet unless it
+  // was the last of its frame, and to the frame of this packet unless it is
+  // the first of its frame. Only media packets tell.
+  NackPriority priority = kOtherPacket;
+  if (!newest_frame_info_.last_packet_in_frame)
+    priority = newest_frame_info_.priority;
+  if (frame_info) {
+    PacketFrameInfo packet_frame_info = *frame_info;
+    // Some depacketizers only tell a keyframe by its first packet.
+    if (packet_frame_info.timestamp == newest_frame_info_.timestamp) {
+      packet_frame_info.priority =
+          std::min(packet_frame_info.priority, newest_frame_info_.priority);
+    }
+    if (!packet_frame_info.first_packet_in_frame)
+      priority = std::min(priority, packet_frame_info.priority);
+    newest_frame_info_ = packet_frame_info;
+  }
+  AddPacketsToNack(newest_seq_num_ + 1, seq_num, priority);
   newest_seq_num_ = seq_num;
 
   // Keep track of new keyframes.
@@ -108,15 +180,9 @@ int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
   return 0;
 }
 
-int NackModule::OnReceivedPacket(const VCMPacket& packet) {
-  return OnReceivedPacket(
-      packet.seqNum,
-      packet.is_first_packet_in_frame && packet.frameType == kVideoFrameKey);
-}
-
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
+  EraseNacks(nack_list_.begin(), nack_list_.lower_bound(seq_num));
   keyframe_list_.erase(keyframe_list_.begin(),
                        keyframe_list_.lower_bound(seq_num));
 }
@@ -129,6 +195,8 @@ void NackModule::UpdateRtt(int64_t rtt_ms) {
 void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
   nack_list_.clear();
+  waiting_nacks_.clear();
+  sent_nacks_.clear();
   keyframe_list_.clear();
 }
 
@@ -171,7 +239,7 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
       RTC_DCHECK(it != nack_list_.end());
-      nack_list_.erase(nack_list_.begin(), it);
+      EraseNacks(nack_list_.begin(), it);
       return true;
     }
 
@@ -183,10 +251,11 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 }
 
 void NackModule::AddPacketsToNack(uint16_t seq_num_start,
-                                  uint16_t seq_num_end) {
+                                  uint16_t seq_num_end,
+                                  NackPriority priority) {
   // Remove old packets.
   auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  EraseNacks(nack_list_.begin(), it);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
@@ -199,6 +268,8 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
 
     if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
       nack_list_.clear();
+      waiting_nacks_.clear();
+      sent_nacks_.clear();
       RTC_LOG(LS_WARNING) << "NACK list full, clearing NACK"
                              " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -207,50 +278,112 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
   }
 
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5));
+    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5), priority);
     RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
     nack_list_[seq_num] = nack_info;
+    waiting_nacks_.emplace(nack_info.send_at_seq_num, seq_num);
+  }
+}
+
+void NackModule::EraseNacks(NackList::iterator begin, NackList::iterator end) {
+  for (auto it = begin; it != end; ++it) {
+    const NackInfo& nack_info = it->second;
+    if (nack_info.sent_at_time == -1) {
+      waiting_nacks_.erase(
+          std::make_pair(nack_info.send_at_seq_num, nack_info.seq_num));
+    } else {
+      sent_nacks_.erase(
+          std::make_pair(nack_info.sent_at_time, nack_info.seq_num));
+    }
+  }
+  nack_list_.erase(begin, end);
+}
+
+size_t NackModule::UpdateBudget(int64_t now_ms) {
+  absl::optional<double> rate = budget_config_.rate.Get();
+  if (!rate)
+    return std::numeric_limits<size_t>::max();
+  double max_budget =
+      std::max(1.0, *rate * budget_config_.window.Get().ms() / 1000.0);
+  if (budget_updated_ms_ == -1) {
+    budget_packets_ = max_budget;
+  } else {
+    budget_packets_ = std::min(
+        max_budget,
+        budget_packets_ + *rate * (now_ms - budget_updated_ms_) / 1000.0);
   }
+  budget_updated_ms_ = now_ms;
+  return static_cast<size_t>(std::max(0.0, budget_packets_));
 }
 
 std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_seq_num = options != kTimeOnly;
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
-  std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    if (consider_seq_num && it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num)) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                            << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
-      continue;
+  std::vector<uint16_t> due_seq_nums;
+  // Packets that haven't been nacked count as last nacked at time -1.
+  bool waiting_due_by_time = consider_timestamp && -1 + rtt_ms_ <= now_ms;
+  for (const auto& waiting : waiting_nacks_) {
+    if (!waiting_due_by_time &&
+        !(consider_seq_num && AheadOrAt(newest_seq_num_, waiting.first))) {
+      break;
     }
-
-    if (consider_timestamp && it->second.sent_at_time + rtt_ms_ <= now_ms) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                            << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
-      continue;
+    due_seq_nums.push_back(waiting.second);
+  }
+  if (consider_timestamp) {
+    for (const auto& sent : sent_nacks_) {
+      if (sent.first + rtt_ms_ > now_ms)
+        break;
+      due_seq_nums.push_back(sent.second);
+    }
+  }
+  if (due_seq_nums.empty())
+    return due_seq_nums;
+
+  std::sort(due_seq_nums.begin(), due_seq_nums.end(),
+            DescendingSeqNumComp<uint16_t>());
+  size_t budget = UpdateBudget(now_ms);
+  if (due_seq_nums.size() > budget) {
+    // Those left out stay due and are considered again with the next batch.
+    // Within a priority, packets not nacked as often go first.
+    std::stable_sort(due_seq_nums.begin(), due_seq_nums.end(),
+                     [this](uint16_t lhs, uint16_t rhs) {
+                       const NackInfo& lhs_info = nack_list_.find(lhs)->second;
+                       const NackInfo& rhs_info = nack_list_.find(rhs)->second;
+                       return std::make_pair(lhs_info.priority,
+                                             lhs_info.retries) <
+                              std::make_pair(rhs_info.priority,
+                                             rhs_info.retries);
+                     });
+    due_seq_nums.resize(budget);
+    std::sort(due_seq_nums.begin(), due_seq_nums.end(),
+              DescendingSeqNumComp<uint16_t>());
+  }
+  if (budget_config_.rate.Get())
+    budget_packets_ -= due_seq_nums.size();
+
+  for (uint16_t seq_num : due_seq_nums) {
+    auto it = nack_list_.find(seq_num);
+    RTC_DCHECK(it != nack_list_.end());
+    NackInfo& nack_info = it->second;
+    if (nack_info.sent_at_time == -1) {
+      waiting_nacks_.erase(
+          std::make_pair(nack_info.send_at_seq_num, nack_info.seq_num));
+    } else {
+      sent_nacks_.erase(
+          std::make_pair(nack_info.sent_at_time, nack_info.seq_num));
+    }
+    ++nack_info.retries;
+    nack_info.sent_at_time = now_ms;
+    if (nack_info.retries >= kMaxNackRetries) {
+      RTC_LOG(LS_WARNING) << "Sequence number " << nack_info.seq_num
+                          << " removed from NACK list due to max retries.";
+      nack_list_.erase(it);
+    } else {
+      sent_nacks_.emplace(now_ms, seq_num);
     }
-    ++it;
   }
-  return nack_batch;
+  return due_seq_nums;
 }
 
 void NackModule::UpdateReorderingStatistics(uint16_t seq_num) {
@@ -11,8 +11,11 @@
 #ifndef MODULES_VIDEO_CODING_NACK_MODULE_H_
 #define MODULES_VIDEO_CODING_NACK_MODULE_H_
 
+#include <functional>
 #include <map>
 #include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "modules/include/module.h"
@@ -20,12 +23,22 @@
 #include "modules/video_coding/histogram.h"
 #include "modules/video_coding/packet.h"
 #include "rtc_base/criticalsection.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
 
+// Keeps track of missing packets and requests them with NACKs, first when
+// later packets make the loss likely, then once per round trip time.
+//
+// The number of packets nacked can be limited with the "WebRTC-NackBudget"
+// field trial, e.g. "WebRTC-NackBudget/rate:200,window:100ms/" for at most 200
+// packets per second in bursts of at most 100 ms worth. When the budget
+// doesn't allow nacking all packets that are due, packets of keyframes go
+// first, then packets of the base temporal layer.
 class NackModule : public Module {
  public:
   NackModule(Clock* clock,
@@ -47,20 +60,67 @@ class NackModule : public Module {
   // GetNackBatch.
   enum NackFilterOptions { kSeqNumOnly, kTimeOnly, kSeqNumAndTime };
 
+  // In which order packets are nacked when the budget is exhausted.
+  enum NackPriority { kKeyFramePacket, kBaseLayerPacket, kOtherPacket };
+
+  struct NackBudgetConfig {
+    explicit NackBudgetConfig(std::string field_trial);
+    NackBudgetConfig(const NackBudgetConfig&);
+    ~NackBudgetConfig();
+    // Packets per second, unlimited if not set.
+    FieldTrialOptional<double> rate;
+    // The budget saved up while there's nothing to nack is capped at |window|
+    // worth of |rate|.
+    FieldTrialParameter<TimeDelta> window;
+  };
+
+  // Where a media packet is in its frame, used to tell which frames the
+  // packets missing next to it belong to.
+  struct PacketFrameInfo {
+    uint32_t timestamp = 0;
+    NackPriority priority = kOtherPacket;
+    bool first_packet_in_frame = true;
+    bool last_packet_in_frame = true;
+  };
+
   // This class holds the sequence number of the packet that is in the nack list
   // as well as the meta data about when it should be nacked and how many times
   // we have tried to nack this packet.
   struct NackInfo {
     NackInfo();
-    NackInfo(uint16_t seq_num, uint16_t send_at_seq_num);
+    NackInfo(uint16_t seq_num, uint16_t send_at_seq_num, NackPriority priority);
 
     uint16_t seq_num;
     uint16_t send_at_seq_num;
     int64_t sent_at_time;
     int retries;
+    NackPriority priority;
+  };
+  using NackList = std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>>;
+
+  // Orders by the first element, then by sequence number.
+  template <typename T, typename Comp>
+  struct ScheduleComp {
+    bool operator()(const std::pair<T, uint16_t>& lhs,
+                    const std::pair<T, uint16_t>& rhs) const {
+      if (lhs.first != rhs.first)
+        return Comp()(lhs.first, rhs.first);
+      return DescendingSeqNumComp<uint16_t>()(lhs.second, rhs.second);
+    }
   };
-  void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
+
+  int OnReceivedPacket(uint16_t seq_num,
+                       bool is_keyframe,
+                       const PacketFrameInfo* frame_info);
+  void AddPacketsToNack(uint16_t seq_num_start,
+                        uint16_t seq_num_end,
+                        NackPriority priority)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Erases the entries in [begin, end) from |nack_list_| and the schedules.
+  void EraseNacks(NackList::iterator begin, NackList::iterator end)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns how many packets may be nacked now.
+  size_t UpdateBudget(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Removes packets from the nack list until the next keyframe. Returns true
   // if packets were removed.
@@ -82,17 +142,32 @@ class NackModule : public Module {
   NackSender* const nack_sender_;
   KeyFrameRequestSender* const keyframe_request_sender_;
 
+  const NackBudgetConfig budget_config_;
+
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see |initialized_|). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(crit_);
+  NackList nack_list_ RTC_GUARDED_BY(crit_);
+  // The entries of |nack_list_| that haven't been nacked yet, by the sequence
+  // number after which to nack them, and those that have, by the time they
+  // were last nacked. GetNackBatch() only looks at the front of these, the
+  // entries that are due.
+  std::set<std::pair<uint16_t, uint16_t>,
+           ScheduleComp<uint16_t, DescendingSeqNumComp<uint16_t>>>
+      waiting_nacks_ RTC_GUARDED_BY(crit_);
+  std::set<std::pair<int64_t, uint16_t>,
+           ScheduleComp<int64_t, std::less<int64_t>>>
+      sent_nacks_ RTC_GUARDED_BY(crit_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
       RTC_GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(crit_);
   bool initialized_ RTC_GUARDED_BY(crit_);
   int64_t rtt_ms_ RTC_GUARDED_BY(crit_);
   uint16_t newest_seq_num_ RTC_GUARDED_BY(crit_);
+  // Of the newest media packet, if any.
+  PacketFrameInfo newest_frame_info_ RTC_GUARDED_BY(crit_);
+  double budget_packets_ RTC_GUARDED_BY(crit_);
+  int64_t budget_updated_ms_ RTC_GUARDED_BY(crit_);
 
   // Only touched on the process thread.
   int64_t next_process_time_ms_;
@@ -14,6 +14,7 @@
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/nack_module.h"
 #include "system_wrappers/include/clock.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -33,6 +34,22 @@ class TestNackModule : public ::testing::Test,
 
   void RequestKeyFrame() override { ++keyframes_requested_; }
 
+  static VCMPacket Vp8Packet(uint16_t seq_num,
+                             uint32_t timestamp,
+                             FrameType frame_type,
+                             uint8_t temporal_idx,
+                             bool first_packet_in_frame,
+                             bool last_packet_in_frame) {
+    VCMPacket packet;
+    packet.seqNum = seq_num;
+    packet.timestamp = timestamp;
+    packet.frameType = frame_type;
+    packet.is_first_packet_in_frame = first_packet_in_frame;
+    packet.markerBit = last_packet_in_frame;
+    packet.video_header.vp8().temporalIdx = temporal_idx;
+    return packet;
+  }
+
   std::unique_ptr<SimulatedClock> clock_;
   NackModule nack_module_;
   std::vector<uint16_t> sent_nacks_;
@@ -314,4 +331,59 @@ TEST_F(TestNackModule, PacketNackCount) {
   EXPECT_EQ(0, nack_module_.OnReceivedPacket(packet));
 }
 
+TEST_F(TestNackModule, BudgetPrioritizesKeyFramePackets) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-NackBudget/rate:10,window:100ms/");
+  NackModule nack_module(clock_.get(), this, this);
+  nack_module.OnReceivedPacket(
+      Vp8Packet(0, 1000, kVideoFrameDelta, 1, true, false));
+  nack_module.OnReceivedPacket(
+      Vp8Packet(3, 1000, kVideoFrameDelta, 1, false, true));
+  // The budget allows one packet per 100 ms.
+  ASSERT_EQ(1u, sent_nacks_.size());
+  EXPECT_EQ(1, sent_nacks_[0]);
+
+  sent_nacks_.clear();
+  nack_module.OnReceivedPacket(
+      Vp8Packet(4, 2000, kVideoFrameKey, 0, true, false));
+  nack_module.OnReceivedPacket(
+      Vp8Packet(7, 2000, kVideoFrameKey, 0, false, true));
+  EXPECT_EQ(0u, sent_nacks_.size());
+
+  for (int i = 0; i < 2; ++i) {
+    clock_->AdvanceTimeMilliseconds(100);
+    nack_module.Process();
+  }
+  ASSERT_EQ(2u, sent_nacks_.size());
+  EXPECT_EQ(5, sent_nacks_[0]);
+  EXPECT_EQ(6, sent_nacks_[1]);
+}
+
+TEST_F(TestNackModule, BudgetPrioritizesBaseLayerPackets) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-NackBudget/rate:10,window:100ms/");
+  NackModule nack_module(clock_.get(), this, this);
+  nack_module.OnReceivedPacket(
+      Vp8Packet(0, 1000, kVideoFrameDelta, 0, true, true));
+  nack_module.OnReceivedPacket(
+      Vp8Packet(1, 2000, kVideoFrameDelta, 1, true, false));
+  // Spends the budget on packet 2.
+  nack_module.OnReceivedPacket(
+      Vp8Packet(3, 2000, kVideoFrameDelta, 1, false, true));
+  nack_module.OnReceivedPacket(
+      Vp8Packet(4, 3000, kVideoFrameDelta, 1, true, true));
+  nack_module.OnReceivedPacket(
+      Vp8Packet(5, 4000, kVideoFrameDelta, 0, true, false));
+  nack_module.OnReceivedPacket(
+      Vp8Packet(7, 4000, kVideoFrameDelta, 0, false, true));
+  ASSERT_EQ(1u, sent_nacks_.size());
+  EXPECT_EQ(2, sent_nacks_[0]);
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(100);
+  nack_module.Process();
+  ASSERT_EQ(1u, sent_nacks_.size());
+  EXPECT_EQ(6, sent_nacks_[0]);
+}
+
 }  // namespace webrtc
@@ -14,6 +14,7 @@
 #include <limits>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "common_video/h264/h264_common.h"
 #include "modules/video_coding/frame_object.h"
 #include "rtc_base/atomicops.h"
@@ -39,13 +40,12 @@ PacketBuffer::PacketBuffer(Clock* clock,
                            size_t max_buffer_size,
                            OnReceivedFrameCallback* received_frame_callback)
     : clock_(clock),
-      size_(start_buffer_size),
-      max_size_(max_buffer_size),
+      size_(max_buffer_size),
       first_seq_num_(0),
       first_packet_received_(false),
       is_cleared_to_first_seq_num_(false),
-      data_buffer_(start_buffer_size),
-      sequence_buffer_(start_buffer_size),
+      data_buffer_(max_buffer_size),
+      sequence_buffer_(max_buffer_size),
       received_frame_callback_(received_frame_callback),
       unique_frames_seen_(0),
       sps_pps_idr_is_h264_keyframe_(
@@ -54,6 +54,9 @@ PacketBuffer::PacketBuffer(Clock* clock,
   // Buffer size must always be a power of 2.
   RTC_DCHECK((start_buffer_size & (start_buffer_size - 1)) == 0);
   RTC_DCHECK((max_buffer_size & (max_buffer_size - 1)) == 0);
+  free_packets_.reserve(max_buffer_size);
+  for (size_t i = 0; i < start_buffer_size; ++i)
+    free_packets_.push_back(absl::make_unique<VCMPacket>());
 }
 
 PacketBuffer::~PacketBuffer() {
@@ -68,7 +71,7 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
     OnTimestampReceived(packet->timestamp);
 
     uint16_t seq_num = packet->seqNum;
-    size_t index = seq_num % size_;
+    const size_t index = seq_num % size_;
 
     if (!first_packet_received_) {
       first_seq_num_ = seq_num;
@@ -87,23 +90,24 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
 
     if (sequence_buffer_[index].used) {
       // Duplicate packet, just delete the payload.
-      if (data_buffer_[index].seqNum == packet->seqNum) {
+      if (data_buffer_[index]->seqNum == packet->seqNum) {
         delete[] packet->dataPtr;
         packet->dataPtr = nullptr;
         return true;
       }
 
-      // The packet buffer is full, try to expand the buffer.
-      while (ExpandBufferSize() && sequence_buffer_[seq_num % size_].used) {
-      }
-      index = seq_num % size_;
+      // The packet buffer is full.
+      RTC_LOG(LS_WARNING) << "PacketBuffer is full (" << size_
+                          << " packets). Clearing PacketBuffer.";
+      Clear();
+    }
 
-      // Packet buffer is still full.
-      if (sequence_buffer_[index].used) {
-        delete[] packet->dataPtr;
-        packet->dataPtr = nullptr;
-        return false;
-      }
+    RTC_DCHECK(!data_buffer_[index]);
+    if (free_packets_.empty()) {
+      data_buffer_[index] = absl::make_unique<VCMPacket>();
+    } else {
+      data_buffer_[index] = std::move(free_packets_.back());
+      free_packets_.pop_back();
     }
 
     sequence_buffer_[index].frame_begin = packet->is_first_packet_in_frame;
@@ -112,7 +116,7 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
     sequence_buffer_[index].continuous = false;
     sequence_buffer_[index].frame_created = false;
     sequence_buffer_[index].used = true;
-    data_buffer_[index] = *packet;
+    *data_buffer_[index] = *packet;
     packet->dataPtr = nullptr;
 
     UpdateMissingPackets(packet->seqNum);
@@ -150,11 +154,11 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   size_t iterations = std::min(diff, size_);
   for (size_t i = 0; i < iterations; ++i) {
     size_t index = first_seq_num_ % size_;
-    RTC_DCHECK_EQ(data_buffer_[index].seqNum, sequence_buffer_[index].seq_num);
-    if (AheadOf<uint16_t>(seq_num, sequence_buffer_[index].seq_num)) {
-      delete[] data_buffer_[index].dataPtr;
-      data_buffer_[index].dataPtr = nullptr;
-      sequence_buffer_[index].used = false;
+    if (sequence_buffer_[index].used &&
+        AheadOf<uint16_t>(seq_num, sequence_buffer_[index].seq_num)) {
+      RTC_DCHECK_EQ(data_buffer_[index]->seqNum,
+                    sequence_buffer_[index].seq_num);
+      FreeSlot(index);
     }
     ++first_seq_num_;
   }
@@ -173,11 +177,8 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
 
 void PacketBuffer::Clear() {
   rtc::CritScope lock(&crit_);
-  for (size_t i = 0; i < size_; ++i) {
-    delete[] data_buffer_[i].dataPtr;
-    data_buffer_[i].dataPtr = nullptr;
-    sequence_buffer_[i].used = false;
-  }
+  for (size_t i = 0; i < size_; ++i)
+    FreeSlot(i);
 
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
@@ -214,29 +215,13 @@ int PacketBuffer::GetUniqueFramesSeen() const {
   return unique_frames_seen_;
 }
 
-bool PacketBuffer::ExpandBufferSize() {
-  if (size_ == max_size_) {
-    RTC_LOG(LS_WARNING) << "PacketBuffer is already at max size (" << max_size_
-                        << "), failed to increase size. Clearing PacketBuffer.";
-    Clear();
-    return false;
-  }
-
-  size_t new_size = std::min(max_size_, 2 * size_);
-  std::vector<VCMPacket> new_data_buffer(new_size);
-  std::vector<ContinuityInfo> new_sequence_buffer(new_size);
-  for (size_t i = 0; i < size_; ++i) {
-    if (sequence_buffer_[i].used) {
-      size_t index = sequence_buffer_[i].seq_num % new_size;
-      new_sequence_buffer[index] = sequence_buffer_[i];
-      new_data_buffer[index] = data_buffer_[i];
-    }
-  }
-  size_ = new_size;
-  sequence_buffer_ = std::move(new_sequence_buffer);
-  data_buffer_ = std::move(new_data_buffer);
-  RTC_LOG(LS_INFO) << "PacketBuffer size expanded to " << new_size;
-  return true;
+void PacketBuffer::FreeSlot(size_t index) {
+  sequence_buffer_[index].used = false;
+  if (!data_buffer_[index])
+    return;
+  delete[] data_buffer_[index]->dataPtr;
+  data_buffer_[index]->dataPtr = nullptr;
+  free_packets_.push_back(std::move(data_buffer_[index]));
 }
 
 bool PacketBuffer::PotentialNewFrame(uint16_t seq_num) const {
@@ -283,10 +268,10 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
       // the |frame_begin| flag is set.
       int start_index = index;
       size_t tested_packets = 0;
-      int64_t frame_timestamp = data_buffer_[start_index].timestamp;
+      int64_t frame_timestamp = data_buffer_[start_index]->timestamp;
 
       // Identify H.264 keyframes by means of SPS, PPS, and IDR.
-      bool is_h264 = data_buffer_[start_index].codec == kVideoCodecH264;
+      bool is_h264 = data_buffer_[start_index]->codec == kVideoCodecH264;
       bool has_h264_sps = false;
       bool has_h264_pps = false;
       bool has_h264_idr = false;
@@ -294,9 +279,9 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
 
       while (true) {
         ++tested_packets;
-        frame_size += data_buffer_[start_index].sizeBytes;
+        frame_size += data_buffer_[start_index]->sizeBytes;
         max_nack_count =
-            std::max(max_nack_count, data_buffer_[start_index].timesNacked);
+            std::max(max_nack_count, data_buffer_[start_index]->timesNacked);
         sequence_buffer_[start_index].frame_created = true;
 
         if (!is_h264 && sequence_buffer_[start_index].frame_begin)
@@ -304,7 +289,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
 
         if (is_h264 && !is_h264_keyframe) {
           const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
-              &data_buffer_[start_index].video_header.video_type_header);
+              &data_buffer_[start_index]->video_header.video_type_header);
           if (!h264_header || h264_header->nalus_length >= kMaxNalusPerPacket)
             return found_frames;
 
@@ -337,7 +322,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
         if (is_h264 &&
             (!sequence_buffer_[start_index].used ||
-             data_buffer_[start_index].timestamp != frame_timestamp)) {
+             data_buffer_[start_index]->timestamp != frame_timestamp)) {
           break;
         }
 
@@ -362,9 +347,9 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         const size_t first_packet_index = start_seq_num % size_;
         RTC_CHECK_LT(first_packet_index, size_);
         if (is_h264_keyframe) {
-          data_buffer_[first_packet_index].frameType = kVideoFrameKey;
+          data_buffer_[first_packet_index]->frameType = kVideoFrameKey;
         } else {
-          data_buffer_[first_packet_index].frameType = kVideoFrameDelta;
+          data_buffer_[first_packet_index]->frameType = kVideoFrameDelta;
         }
 
         // If this is not a keyframe, make sure there are no gaps in the
@@ -399,25 +384,24 @@ void PacketBuffer::ReturnFrame(RtpFrameObject* frame) {
   size_t end = (frame->last_seq_num() + 1) % size_;
   uint16_t seq_num = frame->first_seq_num();
   while (index != end) {
-    if (sequence_buffer_[index].seq_num == seq_num) {
-      delete[] data_buffer_[index].dataPtr;
-      data_buffer_[index].dataPtr = nullptr;
-      sequence_buffer_[index].used = false;
-    }
+    if (sequence_buffer_[index].seq_num == seq_num)
+      FreeSlot(index);
 
     index = (index + 1) % size_;
     ++seq_num;
   }
 }
 
-bool PacketBuffer::GetBitstream(const RtpFrameObject& frame,
-                                uint8_t* destination) {
+bool PacketBuffer::TakeBitstream(
+    const RtpFrameObject& frame,
+    std::vector<RtpFrameObject::Fragment>* fragments) {
   rtc::CritScope lock(&crit_);
 
   size_t index = frame.first_seq_num() % size_;
   size_t end = (frame.last_seq_num() + 1) % size_;
   uint16_t seq_num = frame.first_seq_num();
-  uint8_t* destination_end = destination + frame.size();
+  fragments->reserve(
+      ForwardDiff<uint16_t>(frame.first_seq_num(), frame.last_seq_num()) + 1);
 
   do {
     if (!sequence_buffer_[index].used ||
@@ -425,18 +409,11 @@ bool PacketBuffer::GetBitstream(const RtpFrameObject& frame,
       return false;
     }
 
-    RTC_DCHECK_EQ(data_buffer_[index].seqNum, sequence_buffer_[index].seq_num);
-    size_t length = data_buffer_[index].sizeBytes;
-    if (destination + length > destination_end) {
-      RTC_LOG(LS_WARNING) << "Frame (" << frame.id.picture_id << ":"
-                          << static_cast<int>(frame.id.spatial_layer) << ")"
-                          << " bitstream buffer is not large enough.";
-      return false;
-    }
-
-    const uint8_t* source = data_buffer_[index].dataPtr;
-    memcpy(destination, source, length);
-    destination += length;
+    VCMPacket* packet = data_buffer_[index].get();
+    RTC_DCHECK_EQ(packet->seqNum, sequence_buffer_[index].seq_num);
+    fragments->push_back(RtpFrameObject::Fragment{
+        std::unique_ptr<const uint8_t[]>(packet->dataPtr), packet->sizeBytes});
+    packet->dataPtr = nullptr;
     index = (index + 1) % size_;
     ++seq_num;
   } while (index != end);
@@ -450,7 +427,7 @@ VCMPacket* PacketBuffer::GetPacket(uint16_t seq_num) {
       seq_num != sequence_buffer_[index].seq_num) {
     return nullptr;
   }
-  return &data_buffer_[index];
+  return data_buffer_[index].get();
 }
 
 int PacketBuffer::AddRef() const {
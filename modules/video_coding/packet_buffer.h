@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "modules/include/module_common_types.h"
+#include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/packet.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
 #include "rtc_base/criticalsection.h"
@@ -68,7 +69,11 @@ class PacketBuffer {
   int Release() const;
 
  protected:
-  // Both |start_buffer_size| and |max_buffer_size| must be a power of 2.
+  // The buffer has |max_buffer_size| slots, which must be a power of 2.
+  // Storage for |start_buffer_size| packets is allocated up front, and more is
+  // allocated when more packets than that are buffered at once. Since packets
+  // are never moved once stored, the buffer doesn't stall to grow while a
+  // large frame is received.
   PacketBuffer(Clock* clock,
                size_t start_buffer_size,
                size_t max_buffer_size,
@@ -101,8 +106,9 @@ class PacketBuffer {
 
   Clock* const clock_;
 
-  // Tries to expand the buffer.
-  bool ExpandBufferSize() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Deletes the payload of the packet in slot |index|, if any, and returns its
+  // storage to |free_packets_|.
+  void FreeSlot(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Test if all previous packets has arrived for the given sequence number.
   bool PotentialNewFrame(uint16_t seq_num) const
@@ -113,9 +119,11 @@ class PacketBuffer {
   std::vector<std::unique_ptr<RtpFrameObject>> FindFrames(uint16_t seq_num)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
-  // Copy the bitstream for |frame| to |destination|.
+  // Move the payloads of the packets of |frame| to |fragments|, without
+  // copying them. The packets stay in the buffer until the frame is returned.
   // Virtual for testing.
-  virtual bool GetBitstream(const RtpFrameObject& frame, uint8_t* destination);
+  virtual bool TakeBitstream(const RtpFrameObject& frame,
+                             std::vector<RtpFrameObject::Fragment>* fragments);
 
   // Get the packet with sequence number |seq_num|.
   // Virtual for testing.
@@ -135,9 +143,8 @@ class PacketBuffer {
 
   rtc::CriticalSection crit_;
 
-  // Buffer size_ and max_size_ must always be a power of two.
-  size_t size_ RTC_GUARDED_BY(crit_);
-  const size_t max_size_;
+  // Number of slots, always a power of two.
+  const size_t size_;
 
   // The fist sequence number currently in the buffer.
   uint16_t first_seq_num_ RTC_GUARDED_BY(crit_);
@@ -148,8 +155,11 @@ class PacketBuffer {
   // If the buffer is cleared to |first_seq_num_|.
   bool is_cleared_to_first_seq_num_ RTC_GUARDED_BY(crit_);
 
-  // Buffer that holds the inserted packets.
-  std::vector<VCMPacket> data_buffer_ RTC_GUARDED_BY(crit_);
+  // Buffer that holds the inserted packets. Only used slots have a packet.
+  std::vector<std::unique_ptr<VCMPacket>> data_buffer_ RTC_GUARDED_BY(crit_);
+  // Storage for packets not currently in |data_buffer_|. Has capacity for
+  // |size_| packets, so returning a packet to it doesn't allocate.
+  std::vector<std::unique_ptr<VCMPacket>> free_packets_ RTC_GUARDED_BY(crit_);
 
   // Buffer that holds the information about which slot that is currently in use
   // and information needed to determine the continuity between packets.
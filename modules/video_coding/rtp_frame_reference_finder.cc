@@ -96,6 +96,7 @@ RtpFrameReferenceFinder::ManageFrameInternal(RtpFrameObject* frame) {
     case kVideoCodecH264:
     case kVideoCodecI420:
     case kVideoCodecMultiplex:
+    case kVideoCodecAV1:
     case kVideoCodecGeneric:
       return ManageFrameGeneric(frame, kNoPictureId);
   }
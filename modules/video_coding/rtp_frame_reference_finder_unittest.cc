@@ -38,8 +38,9 @@ class FakePacketBuffer : public PacketBuffer {
     return true;
   }
 
-  bool GetBitstream(const RtpFrameObject& frame,
-                    uint8_t* destination) override {
+  bool TakeBitstream(
+      const RtpFrameObject& frame,
+      std::vector<RtpFrameObject::Fragment>* fragments) override {
     return true;
   }
 
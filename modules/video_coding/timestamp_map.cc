@@ -57,6 +57,10 @@ VCMFrameInformation* VCMTimestampMap::Pop(uint32_t timestamp) {
   return nullptr;
 }
 
+size_t VCMTimestampMap::Size() const {
+  return (next_add_idx_ + capacity_ - next_pop_idx_) % capacity_;
+}
+
 bool VCMTimestampMap::IsEmpty() const {
   return (next_add_idx_ == next_pop_idx_);
 }
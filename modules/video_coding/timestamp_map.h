@@ -28,6 +28,9 @@ class VCMTimestampMap {
   void Add(uint32_t timestamp, VCMFrameInformation* data);
   VCMFrameInformation* Pop(uint32_t timestamp);
 
+  // Returns the number of entries in the map.
+  size_t Size() const;
+
  private:
   struct TimestampDataTuple {
     uint32_t timestamp;
@@ -23,6 +23,7 @@ VCMTiming::VCMTiming(Clock* clock, VCMTiming* master_timing)
       ts_extrapolator_(),
       codec_timer_(new VCMCodecTimer()),
       render_delay_ms_(kDefaultRenderDelayMs),
+      low_latency_mode_(false),
       min_playout_delay_ms_(0),
       max_playout_delay_ms_(10000),
       jitter_delay_ms_(0),
@@ -61,6 +62,16 @@ void VCMTiming::set_render_delay(int render_delay_ms) {
   render_delay_ms_ = render_delay_ms;
 }
 
+void VCMTiming::set_low_latency_mode(bool enabled) {
+  rtc::CritScope cs(&crit_sect_);
+  low_latency_mode_ = enabled;
+}
+
+bool VCMTiming::low_latency_mode() const {
+  rtc::CritScope cs(&crit_sect_);
+  return low_latency_mode_;
+}
+
 void VCMTiming::set_min_playout_delay(int min_playout_delay_ms) {
   rtc::CritScope cs(&crit_sect_);
   min_playout_delay_ms_ = min_playout_delay_ms;
@@ -96,8 +107,9 @@ void VCMTiming::UpdateCurrentDelay(uint32_t frame_timestamp) {
   rtc::CritScope cs(&crit_sect_);
   int target_delay_ms = TargetDelayInternal();
 
-  if (current_delay_ms_ == 0) {
-    // Not initialized, set current delay to target.
+  if (current_delay_ms_ == 0 || low_latency_mode_) {
+    // Not initialized, or latency-first playout where a short glitch is
+    // preferred over slowly draining a delay that is no longer needed.
     current_delay_ms_ = target_delay_ms;
   } else if (target_delay_ms != current_delay_ms_) {
     int64_t delay_diff_ms =
@@ -203,6 +215,11 @@ int64_t VCMTiming::MaxWaitingTime(int64_t render_time_ms,
   const int64_t max_wait_time_ms =
       render_time_ms - now_ms - RequiredDecodeTimeMs() - render_delay_ms_;
 
+  if (low_latency_mode_ && min_playout_delay_ms_ == 0) {
+    // Decode as soon as the frame is complete and continuous. Late frames
+    // still report a negative waiting time so that they can be dropped.
+    return std::min<int64_t>(max_wait_time_ms, 0);
+  }
   return max_wait_time_ms;
 }
 
@@ -212,8 +229,12 @@ int VCMTiming::TargetVideoDelay() const {
 }
 
 int VCMTiming::TargetDelayInternal() const {
-  return std::max(min_playout_delay_ms_,
-                  jitter_delay_ms_ + RequiredDecodeTimeMs() + render_delay_ms_);
+  const int target_delay_ms =
+      std::max(min_playout_delay_ms_,
+               jitter_delay_ms_ + RequiredDecodeTimeMs() + render_delay_ms_);
+  if (low_latency_mode_)
+    return std::min(target_delay_ms, max_playout_delay_ms_);
+  return target_delay_ms;
 }
 
 bool VCMTiming::GetTimings(int* decode_ms,
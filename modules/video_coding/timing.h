@@ -35,6 +35,14 @@ class VCMTiming {
   // Set the amount of time needed to render an image. Defaults to 10 ms.
   void set_render_delay(int render_delay_ms);
 
+  // Enables latency-first playout. Frames are released for decoding as soon
+  // as they are complete and continuous, unless a non-zero minimum playout
+  // delay asks for them to be held, and the current delay follows the target
+  // delay immediately instead of drifting towards it. The target delay is
+  // capped by the maximum playout delay.
+  void set_low_latency_mode(bool enabled);
+  bool low_latency_mode() const;
+
   // Set the minimum time the video must be delayed on the receiver to
   // get the desired jitter buffer level.
   void SetJitterDelay(int required_delay_ms);
@@ -112,6 +120,7 @@ class VCMTiming {
   TimestampExtrapolator* ts_extrapolator_ RTC_GUARDED_BY(crit_sect_);
   std::unique_ptr<VCMCodecTimer> codec_timer_ RTC_GUARDED_BY(crit_sect_);
   int render_delay_ms_ RTC_GUARDED_BY(crit_sect_);
+  bool low_latency_mode_ RTC_GUARDED_BY(crit_sect_);
   // Best-effort playout delay range for frames from capture to render.
   // The receiver tries to keep the delay between |min_playout_delay_ms_|
   // and |max_playout_delay_ms_| taking the network jitter into account.
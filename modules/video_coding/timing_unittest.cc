@@ -128,4 +128,53 @@ TEST(ReceiverTiming, WrapAround) {
   }
 }
 
+TEST(ReceiverTiming, LowLatencyMode) {
+  SimulatedClock clock(0);
+  VCMTiming timing(&clock);
+  timing.set_low_latency_mode(true);
+  timing.set_render_delay(0);
+  uint32_t timestamp = 0;
+  timing.IncomingTimestamp(timestamp, clock.TimeInMilliseconds());
+  timing.UpdateCurrentDelay(timestamp);
+
+  // The current delay jumps straight to the target in both directions.
+  timing.SetJitterDelay(50);
+  clock.AdvanceTimeMilliseconds(1000 / kFps);
+  timestamp += 90000 / kFps;
+  timing.IncomingTimestamp(timestamp, clock.TimeInMilliseconds());
+  timing.UpdateCurrentDelay(timestamp);
+  int decode_ms, max_decode_ms, current_delay_ms, target_delay_ms;
+  int jitter_buffer_ms, min_playout_delay_ms, render_delay_ms;
+  timing.GetTimings(&decode_ms, &max_decode_ms, &current_delay_ms,
+                    &target_delay_ms, &jitter_buffer_ms, &min_playout_delay_ms,
+                    &render_delay_ms);
+  EXPECT_EQ(50, current_delay_ms);
+  timing.SetJitterDelay(5);
+  clock.AdvanceTimeMilliseconds(1000 / kFps);
+  timestamp += 90000 / kFps;
+  timing.IncomingTimestamp(timestamp, clock.TimeInMilliseconds());
+  timing.UpdateCurrentDelay(timestamp);
+  timing.GetTimings(&decode_ms, &max_decode_ms, &current_delay_ms,
+                    &target_delay_ms, &jitter_buffer_ms, &min_playout_delay_ms,
+                    &render_delay_ms);
+  EXPECT_EQ(5, current_delay_ms);
+
+  // Frames are released for decoding immediately...
+  int64_t render_time_ms =
+      timing.RenderTimeMs(timestamp, clock.TimeInMilliseconds());
+  EXPECT_EQ(0, timing.MaxWaitingTime(render_time_ms,
+                                     clock.TimeInMilliseconds()));
+  // ...unless a minimum playout delay is requested.
+  timing.set_min_playout_delay(30);
+  render_time_ms = timing.RenderTimeMs(timestamp, clock.TimeInMilliseconds());
+  EXPECT_EQ(30, timing.MaxWaitingTime(render_time_ms,
+                                      clock.TimeInMilliseconds()));
+
+  // The maximum playout delay caps the target delay.
+  timing.set_min_playout_delay(0);
+  timing.set_max_playout_delay(20);
+  timing.SetJitterDelay(100);
+  EXPECT_EQ(20, timing.TargetVideoDelay());
+}
+
 }  // namespace webrtc
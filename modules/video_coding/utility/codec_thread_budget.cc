@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/codec_thread_budget.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+CodecThreadBudget* CodecThreadBudget::Global() {
+  static CodecThreadBudget* const budget =
+      new CodecThreadBudget(CpuInfo::DetectNumberOfCores());
+  return budget;
+}
+
+CodecThreadBudget::CodecThreadBudget(int max_threads)
+    : max_threads_(max_threads), used_threads_(0) {
+  RTC_DCHECK_GE(max_threads_, 0);
+}
+
+CodecThreadBudget::~CodecThreadBudget() {
+  RTC_DCHECK_EQ(0, used_threads_);
+}
+
+int CodecThreadBudget::Acquire(int wanted_threads) {
+  rtc::CritScope lock(&crit_);
+  int threads =
+      std::max(0, std::min(wanted_threads, max_threads_ - used_threads_));
+  used_threads_ += threads;
+  return threads;
+}
+
+void CodecThreadBudget::Release(int threads) {
+  rtc::CritScope lock(&crit_);
+  used_threads_ -= threads;
+  RTC_DCHECK_GE(used_threads_, 0);
+}
+
+int CodecThreadBudget::used_threads() const {
+  rtc::CritScope lock(&crit_);
+  return used_threads_;
+}
+
+}  // namespace webrtc
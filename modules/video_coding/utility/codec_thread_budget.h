@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_CODEC_THREAD_BUDGET_H_
+#define MODULES_VIDEO_CODING_UTILITY_CODEC_THREAD_BUDGET_H_
+
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Budget of worker threads for codec libraries that run their own threads,
+// such as libvpx and FFmpeg. A codec always runs on the thread calling it;
+// only the threads it wants in addition to that are taken from the budget.
+// This keeps a process that runs many codecs at once from creating far more
+// threads than it has cores.
+class CodecThreadBudget {
+ public:
+  // The budget shared by all codecs of the process, sized to the number of
+  // cores.
+  static CodecThreadBudget* Global();
+
+  explicit CodecThreadBudget(int max_threads);
+  ~CodecThreadBudget();
+
+  // Takes up to |wanted_threads| threads from the budget and returns the
+  // number taken, which may be zero.
+  int Acquire(int wanted_threads);
+  // Returns threads taken with Acquire().
+  void Release(int threads);
+
+  int used_threads() const;
+
+ private:
+  rtc::CriticalSection crit_;
+  const int max_threads_;
+  int used_threads_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_CODEC_THREAD_BUDGET_H_
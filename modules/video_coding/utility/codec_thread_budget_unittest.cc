@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/codec_thread_budget.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(CodecThreadBudgetTest, GrantsThreadsUntilExhausted) {
+  CodecThreadBudget budget(4);
+  EXPECT_EQ(3, budget.Acquire(3));
+  EXPECT_EQ(1, budget.Acquire(3));
+  EXPECT_EQ(0, budget.Acquire(1));
+  EXPECT_EQ(4, budget.used_threads());
+
+  budget.Release(3);
+  EXPECT_EQ(2, budget.Acquire(2));
+  budget.Release(2);
+  budget.Release(1);
+  EXPECT_EQ(0, budget.used_threads());
+}
+
+TEST(CodecThreadBudgetTest, NonPositiveRequestsGetNothing) {
+  CodecThreadBudget budget(2);
+  EXPECT_EQ(0, budget.Acquire(0));
+  EXPECT_EQ(0, budget.Acquire(-1));
+  EXPECT_EQ(0, budget.used_threads());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoded_image_buffer_pool.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Index of the smallest size class that fits |size| bytes.
+size_t SizeClass(size_t size) {
+  size_t size_class = 0;
+  while ((EncodedImageBufferPool::kMinBufferSize << size_class) < size)
+    ++size_class;
+  return size_class;
+}
+
+}  // namespace
+
+constexpr size_t EncodedImageBufferPool::kMinBufferSize;
+constexpr size_t EncodedImageBufferPool::kMaxUnusedBuffersPerSize;
+
+EncodedImageBufferPool::Buffer::Buffer(size_t size)
+    : size_(size), data_(new uint8_t[size]) {}
+
+EncodedImageBufferPool::Buffer::~Buffer() = default;
+
+EncodedImageBufferPool* EncodedImageBufferPool::Global() {
+  static EncodedImageBufferPool* const pool = new EncodedImageBufferPool();
+  return pool;
+}
+
+EncodedImageBufferPool::EncodedImageBufferPool() = default;
+
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+rtc::scoped_refptr<EncodedImageBufferPool::Buffer>
+EncodedImageBufferPool::Acquire(size_t min_size) {
+  const size_t size_class = SizeClass(min_size);
+  rtc::CritScope lock(&crit_);
+  if (buffers_.size() <= size_class)
+    buffers_.resize(size_class + 1);
+
+  // Buffers that only the pool references are unused. Reuse the first, and
+  // free those beyond the ones kept for reuse.
+  std::list<rtc::scoped_refptr<RefCountedBuffer>>& buffers =
+      buffers_[size_class];
+  rtc::scoped_refptr<RefCountedBuffer> unused_buffer;
+  size_t num_unused_buffers = 0;
+  for (auto it = buffers.begin(); it != buffers.end();) {
+    if (!(*it)->HasOneRef()) {
+      ++it;
+    } else if (!unused_buffer) {
+      unused_buffer = *it++;
+    } else if (++num_unused_buffers > kMaxUnusedBuffersPerSize) {
+      it = buffers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (unused_buffer) {
+    ++num_reused_buffers_;
+    return unused_buffer;
+  }
+
+  ++num_allocated_buffers_;
+  rtc::scoped_refptr<RefCountedBuffer> buffer(
+      new RefCountedBuffer(kMinBufferSize << size_class));
+  buffers.push_back(buffer);
+  return buffer;
+}
+
+void EncodedImageBufferPool::Reserve(size_t min_size,
+                                     EncodedImage* image,
+                                     rtc::scoped_refptr<Buffer>* buffer) {
+  RTC_DCHECK(!*buffer || image->_buffer == (*buffer)->data());
+  RTC_DCHECK_LE(image->_length, min_size);
+  if (*buffer && (*buffer)->size() >= min_size &&
+      SizeClass((*buffer)->size()) <= SizeClass(min_size) + 2) {
+    return;
+  }
+
+  rtc::scoped_refptr<Buffer> new_buffer = Acquire(min_size);
+  if (image->_length > 0)
+    memcpy(new_buffer->data(), image->_buffer, image->_length);
+  image->_buffer = new_buffer->data();
+  image->_size = new_buffer->size();
+  *buffer = std::move(new_buffer);
+}
+
+int EncodedImageBufferPool::num_reused_buffers() const {
+  rtc::CritScope lock(&crit_);
+  return num_reused_buffers_;
+}
+
+int EncodedImageBufferPool::num_allocated_buffers() const {
+  rtc::CritScope lock(&crit_);
+  return num_allocated_buffers_;
+}
+
+}  // namespace webrtc
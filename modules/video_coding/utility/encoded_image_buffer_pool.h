@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_ENCODED_IMAGE_BUFFER_POOL_H_
+#define MODULES_VIDEO_CODING_UTILITY_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "common_video/include/video_frame.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Pool of the output buffers of video encoders. Instead of every encoder
+// keeping a buffer big enough for its largest keyframe, encoders take a
+// buffer of the size each frame needs, and the memory of a keyframe is reused
+// by the next big frame of any encoder using the pool.
+//
+// Buffers come in power-of-two size classes, so that a buffer returned by
+// one encoder fits the frames of others. A buffer is returned to the pool
+// when the last reference to it is released. Thread safe.
+class EncodedImageBufferPool {
+ public:
+  class Buffer : public rtc::RefCountInterface {
+   public:
+    uint8_t* data() { return data_.get(); }
+    size_t size() const { return size_; }
+
+   protected:
+    explicit Buffer(size_t size);
+    ~Buffer() override;
+
+   private:
+    const size_t size_;
+    const std::unique_ptr<uint8_t[]> data_;
+  };
+
+  // Smallest size class.
+  static constexpr size_t kMinBufferSize = 4 * 1024;
+  // Number of unused buffers of each size class kept for reuse.
+  static constexpr size_t kMaxUnusedBuffersPerSize = 4;
+
+  // The pool shared by all the encoders of the process.
+  static EncodedImageBufferPool* Global();
+
+  EncodedImageBufferPool();
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of at least |min_size| bytes.
+  rtc::scoped_refptr<Buffer> Acquire(size_t min_size);
+
+  // Makes |image| use a buffer from the pool that fits at least |min_size|
+  // bytes, held by |*buffer|, which must hold the current buffer of |image|,
+  // if any. The current buffer is kept if it's big enough, but no more than
+  // four times as big as needed. Otherwise, it's replaced, and the
+  // |image->_length| bytes of it are copied to the new buffer.
+  void Reserve(size_t min_size,
+               EncodedImage* image,
+               rtc::scoped_refptr<Buffer>* buffer);
+
+  // The number of buffers returned by Acquire() that were reused from the
+  // pool and that had to be allocated, respectively.
+  int num_reused_buffers() const;
+  int num_allocated_buffers() const;
+
+ private:
+  // Explicitly use a RefCountedObject to get access to HasOneRef, needed by
+  // the pool to check exclusive access.
+  class PooledBuffer : public Buffer {
+   public:
+    explicit PooledBuffer(size_t size) : Buffer(size) {}
+  };
+  using RefCountedBuffer = rtc::RefCountedObject<PooledBuffer>;
+
+  rtc::CriticalSection crit_;
+  // Buffers of size kMinBufferSize << i, at index i.
+  std::vector<std::list<rtc::scoped_refptr<RefCountedBuffer>>> buffers_
+      RTC_GUARDED_BY(crit_);
+  int num_reused_buffers_ RTC_GUARDED_BY(crit_) = 0;
+  int num_allocated_buffers_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_ENCODED_IMAGE_BUFFER_POOL_H_
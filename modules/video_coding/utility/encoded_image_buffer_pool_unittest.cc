@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoded_image_buffer_pool.h"
+
+#include <string.h>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(EncodedImageBufferPoolTest, RoundsUpToSizeClass) {
+  EncodedImageBufferPool pool;
+  EXPECT_EQ(EncodedImageBufferPool::kMinBufferSize, pool.Acquire(1)->size());
+  EXPECT_EQ(EncodedImageBufferPool::kMinBufferSize,
+            pool.Acquire(EncodedImageBufferPool::kMinBufferSize)->size());
+  EXPECT_EQ(4 * EncodedImageBufferPool::kMinBufferSize,
+            pool.Acquire(3 * EncodedImageBufferPool::kMinBufferSize)->size());
+}
+
+TEST(EncodedImageBufferPoolTest, ReusesReleasedBuffers) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer =
+      pool.Acquire(100000);
+  const uint8_t* data = buffer->data();
+  // Not released yet.
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> other_buffer =
+      pool.Acquire(100000);
+  EXPECT_NE(data, other_buffer->data());
+
+  buffer = nullptr;
+  EXPECT_EQ(data, pool.Acquire(90000)->data());
+  EXPECT_EQ(2, pool.num_allocated_buffers());
+  EXPECT_EQ(1, pool.num_reused_buffers());
+}
+
+TEST(EncodedImageBufferPoolTest, ReserveGrowsAndKeepsContent) {
+  EncodedImageBufferPool pool;
+  EncodedImage image;
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer;
+  pool.Reserve(10, &image, &buffer);
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(buffer->data(), image._buffer);
+  EXPECT_EQ(buffer->size(), image._size);
+  memset(image._buffer, 7, 10);
+  image._length = 10;
+
+  const uint8_t* small_data = image._buffer;
+  pool.Reserve(EncodedImageBufferPool::kMinBufferSize + 1, &image, &buffer);
+  EXPECT_NE(small_data, image._buffer);
+  EXPECT_EQ(buffer->data(), image._buffer);
+  EXPECT_EQ(2 * EncodedImageBufferPool::kMinBufferSize, image._size);
+  for (size_t i = 0; i < 10; ++i)
+    EXPECT_EQ(7, image._buffer[i]);
+}
+
+TEST(EncodedImageBufferPoolTest, ReserveShrinksOversizedBuffer) {
+  EncodedImageBufferPool pool;
+  EncodedImage image;
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer;
+  const size_t kKeyFrameSize = 16 * EncodedImageBufferPool::kMinBufferSize;
+  pool.Reserve(kKeyFrameSize, &image, &buffer);
+  EXPECT_EQ(kKeyFrameSize, image._size);
+
+  // Up to four times the size needed is kept.
+  image._length = 0;
+  pool.Reserve(kKeyFrameSize / 4, &image, &buffer);
+  EXPECT_EQ(kKeyFrameSize, image._size);
+  pool.Reserve(kKeyFrameSize / 8, &image, &buffer);
+  EXPECT_EQ(kKeyFrameSize / 8, image._size);
+  EXPECT_EQ(buffer->data(), image._buffer);
+
+  // The keyframe buffer was returned to the pool.
+  EXPECT_EQ(kKeyFrameSize, pool.Acquire(kKeyFrameSize)->size());
+  EXPECT_EQ(1, pool.num_reused_buffers());
+}
+
+}  // namespace webrtc
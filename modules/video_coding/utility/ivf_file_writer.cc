@@ -13,6 +13,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -38,6 +39,12 @@ IvfFileWriter::IvfFileWriter(rtc::File file, size_t byte_limit)
       << "The byte_limit is too low, not even the header will fit.";
 }
 
+IvfFileWriter::IvfFileWriter(std::unique_ptr<rtc::AsyncFileWriter> async_file,
+                             size_t byte_limit)
+    : IvfFileWriter(rtc::File(), byte_limit) {
+  async_file_ = std::move(async_file);
+}
+
 IvfFileWriter::~IvfFileWriter() {
   Close();
 }
@@ -48,8 +55,20 @@ std::unique_ptr<IvfFileWriter> IvfFileWriter::Wrap(rtc::File file,
       new IvfFileWriter(std::move(file), byte_limit));
 }
 
+std::unique_ptr<IvfFileWriter> IvfFileWriter::WrapAsync(
+    rtc::File file,
+    size_t byte_limit,
+    size_t max_pending_bytes) {
+  if (!file.IsOpen())
+    return Wrap(std::move(file), byte_limit);
+  return std::unique_ptr<IvfFileWriter>(new IvfFileWriter(
+      absl::make_unique<rtc::AsyncFileWriter>(std::move(file),
+                                              max_pending_bytes),
+      byte_limit));
+}
+
 bool IvfFileWriter::WriteHeader() {
-  if (!file_.Seek(0)) {
+  if (!async_file_ && !file_.Seek(0)) {
     RTC_LOG(LS_WARNING) << "Unable to rewind ivf output file.";
     return false;
   }
@@ -81,6 +100,12 @@ bool IvfFileWriter::WriteHeader() {
       ivf_header[10] = '6';
       ivf_header[11] = '4';
       break;
+    case kVideoCodecAV1:
+      ivf_header[8] = 'A';
+      ivf_header[9] = 'V';
+      ivf_header[10] = '0';
+      ivf_header[11] = '1';
+      break;
     default:
       RTC_LOG(LS_ERROR) << "Unknown CODEC type: " << codec_type_;
       return false;
@@ -97,7 +122,9 @@ bool IvfFileWriter::WriteHeader() {
                                           static_cast<uint32_t>(num_frames_));
   ByteWriter<uint32_t>::WriteLittleEndian(&ivf_header[28], 0);  // Reserved.
 
-  if (file_.Write(ivf_header, kIvfHeaderSize) < kIvfHeaderSize) {
+  if (async_file_) {
+    async_file_->WriteAt(ivf_header, kIvfHeaderSize, 0);
+  } else if (file_.Write(ivf_header, kIvfHeaderSize) < kIvfHeaderSize) {
     RTC_LOG(LS_ERROR) << "Unable to write IVF header for ivf output file.";
     return false;
   }
@@ -133,7 +160,7 @@ bool IvfFileWriter::InitFromFirstFrame(const EncodedImage& encoded_image,
 
 bool IvfFileWriter::WriteFrame(const EncodedImage& encoded_image,
                                VideoCodecType codec_type) {
-  if (!file_.IsOpen())
+  if (!file_.IsOpen() && !async_file_)
     return false;
 
   if (num_frames_ == 0 && !InitFromFirstFrame(encoded_image, codec_type))
@@ -170,9 +197,17 @@ bool IvfFileWriter::WriteFrame(const EncodedImage& encoded_image,
   ByteWriter<uint32_t>::WriteLittleEndian(
       &frame_header[0], static_cast<uint32_t>(encoded_image._length));
   ByteWriter<uint64_t>::WriteLittleEndian(&frame_header[4], timestamp);
-  if (file_.Write(frame_header, kFrameHeaderSize) < kFrameHeaderSize ||
-      file_.Write(encoded_image._buffer, encoded_image._length) <
-          encoded_image._length) {
+  if (async_file_) {
+    if (!async_file_->Write(
+            {rtc::ArrayView<const uint8_t>(frame_header),
+             rtc::ArrayView<const uint8_t>(encoded_image._buffer,
+                                           encoded_image._length)})) {
+      RTC_LOG(LS_WARNING) << "Dropped frame, file writes are too slow.";
+      return false;
+    }
+  } else if (file_.Write(frame_header, kFrameHeaderSize) < kFrameHeaderSize ||
+             file_.Write(encoded_image._buffer, encoded_image._length) <
+                 encoded_image._length) {
     RTC_LOG(LS_ERROR) << "Unable to write frame to file.";
     return false;
   }
@@ -184,6 +219,13 @@ bool IvfFileWriter::WriteFrame(const EncodedImage& encoded_image,
 }
 
 bool IvfFileWriter::Close() {
+  if (async_file_) {
+    bool ret = num_frames_ == 0 || WriteHeader();
+    ret &= async_file_->Close();
+    async_file_.reset();
+    return ret;
+  }
+
   if (!file_.IsOpen())
     return false;
 
@@ -16,6 +16,7 @@
 
 #include "common_video/include/video_frame.h"
 #include "modules/include/module_common_types.h"
+#include "rtc_base/async_file_writer.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/file.h"
 #include "rtc_base/timeutils.h"
@@ -29,13 +30,22 @@ class IvfFileWriter {
   // |byte_limit| the file will be closed, the write (and all future writes)
   // will fail. A |byte_limit| of 0 is equivalent to no limit.
   static std::unique_ptr<IvfFileWriter> Wrap(rtc::File file, size_t byte_limit);
+  // Same as above, but the file is written on a shared task queue, see
+  // rtc::AsyncFileWriter, so WriteFrame() never blocks on disk I/O. Frames that
+  // would take the data not yet written above |max_pending_bytes| are dropped,
+  // and WriteFrame() fails for them.
+  static std::unique_ptr<IvfFileWriter> WrapAsync(rtc::File file,
+                                                  size_t byte_limit,
+                                                  size_t max_pending_bytes);
   ~IvfFileWriter();
 
   bool WriteFrame(const EncodedImage& encoded_image, VideoCodecType codec_type);
   bool Close();
 
  private:
-  explicit IvfFileWriter(rtc::File file, size_t byte_limit);
+  IvfFileWriter(rtc::File file, size_t byte_limit);
+  IvfFileWriter(std::unique_ptr<rtc::AsyncFileWriter> async_file,
+                size_t byte_limit);
 
   bool WriteHeader();
   bool InitFromFirstFrame(const EncodedImage& encoded_image,
@@ -51,6 +61,8 @@ class IvfFileWriter {
   bool using_capture_timestamps_;
   rtc::TimestampWrapAroundHandler wrap_handler_;
   rtc::File file_;
+  // Used instead of |file_| if set.
+  std::unique_ptr<rtc::AsyncFileWriter> async_file_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(IvfFileWriter);
 };
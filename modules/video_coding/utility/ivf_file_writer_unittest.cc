@@ -156,6 +156,25 @@ TEST_F(IvfFileWriterTest, WritesBasicH264FileMsTimestamp) {
   RunBasicFileStructureTest(kVideoCodecH264, fourcc, true);
 }
 
+TEST_F(IvfFileWriterTest, WritesBasicVP8FileAsync) {
+  const uint8_t fourcc[4] = {'V', 'P', '8', '0'};
+  const int kWidth = 320;
+  const int kHeight = 240;
+  const int kNumFrames = 257;
+  file_writer_ =
+      IvfFileWriter::WrapAsync(rtc::File::Open(file_name_), 0, 1024 * 1024);
+  ASSERT_TRUE(file_writer_.get());
+  ASSERT_TRUE(
+      WriteDummyTestFrames(kVideoCodecVP8, kWidth, kHeight, kNumFrames, false));
+  EXPECT_TRUE(file_writer_->Close());
+
+  rtc::File out_file = rtc::File::Open(file_name_);
+  VerifyIvfHeader(&out_file, fourcc, kWidth, kHeight, kNumFrames, false);
+  VerifyDummyTestFrames(&out_file, kNumFrames);
+
+  out_file.Close();
+}
+
 TEST_F(IvfFileWriterTest, ClosesWhenReachesLimit) {
   const uint8_t fourcc[4] = {'V', 'P', '8', '0'};
   const int kWidth = 320;
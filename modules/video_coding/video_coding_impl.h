@@ -115,6 +115,10 @@ class VideoSender {
   EncodedImageCallback* const post_encode_callback_;
   VCMEncoderDataBase _codecDataBase RTC_GUARDED_BY(encoder_crit_);
   bool frame_dropper_enabled_ RTC_GUARDED_BY(encoder_crit_);
+  // The region changed by the frames dropped since the last encoded frame.
+  // Unset if unknown.
+  absl::optional<VideoFrame::UpdateRect> dropped_update_rect_
+      RTC_GUARDED_BY(encoder_crit_);
 
   // Must be accessed on the construction thread of VideoSender.
   VideoCodec current_codec_;
@@ -152,6 +156,10 @@ class VideoReceiver : public Module {
 
   int32_t Decode(const webrtc::VCMEncodedFrame* frame);
 
+  // Initializes the decoder of |payload_type| before its first frame. Must be
+  // called on the decoder thread.
+  int32_t PrewarmDecoder(uint8_t payload_type);
+
   int32_t IncomingPacket(const uint8_t* incomingPayload,
                          size_t payloadLength,
                          const WebRtcRTPHeader& rtpInfo);
@@ -12,6 +12,7 @@
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "common_video/h264/h264_common.h"
 #include "modules/video_coding/frame_object.h"
@@ -447,6 +448,38 @@ TEST_F(TestPacketBuffer, GetBitstream) {
   EXPECT_EQ(memcmp(result, "many bitstream, such data", sizeof(result)), 0);
 }
 
+TEST_F(TestPacketBuffer, GetBitstreamFragments) {
+  uint8_t* many = new uint8_t[5];
+  uint8_t* such = new uint8_t[5];
+  memcpy(many, "many ", 5);
+  memcpy(such, "such ", 5);
+
+  const uint16_t seq_num = Rand();
+  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kNotLast, 5, many));
+  EXPECT_TRUE(Insert(seq_num + 1, kKeyFrame, kNotFirst, kLast, 5, such));
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  RtpFrameObject* frame = frames_from_callback_[seq_num].get();
+
+  // The fragments are the packet payloads themselves.
+  std::vector<rtc::ArrayView<const uint8_t>> fragments;
+  frame->GetBitstreamFragments(&fragments);
+  ASSERT_EQ(2u, fragments.size());
+  EXPECT_EQ(many, fragments[0].data());
+  EXPECT_EQ(5u, fragments[0].size());
+  EXPECT_EQ(such, fragments[1].data());
+  EXPECT_EQ(5u, fragments[1].size());
+  EXPECT_EQ(nullptr, frame->Buffer());
+
+  frame->MakeBitstreamContiguous();
+  ASSERT_NE(nullptr, frame->Buffer());
+  EXPECT_EQ(10u, frame->Length());
+  EXPECT_EQ(0, memcmp(frame->Buffer(), "many such ", 10));
+  fragments.clear();
+  frame->GetBitstreamFragments(&fragments);
+  ASSERT_EQ(1u, fragments.size());
+  EXPECT_EQ(frame->Buffer(), fragments[0].data());
+}
+
 TEST_F(TestPacketBuffer, GetBitstreamOneFrameOnePacket) {
   uint8_t bitstream_data[] = "All the bitstream data for this frame!";
   uint8_t result[sizeof(bitstream_data)];
@@ -487,6 +520,30 @@ TEST_F(TestPacketBuffer, GetBitstreamOneFrameFullBuffer) {
   EXPECT_EQ(memcmp(result, expected, kStartSize), 0);
 }
 
+TEST_F(TestPacketBuffer, GetBitstreamOfFramesLargerThanStartSize) {
+  const int kFrameSize = kMaxSize / 2;
+  uint8_t expected[kFrameSize];
+  uint8_t result[kFrameSize];
+  uint16_t seq_num = Rand();
+
+  // Packets of returned frames are reused for the later ones.
+  for (int frame = 0; frame < 2 * kMaxSize; ++frame) {
+    const uint16_t first_seq_num = seq_num;
+    for (int i = 0; i < kFrameSize; ++i) {
+      uint8_t* data = new uint8_t[1];
+      data[0] = expected[i] = frame + i;
+      EXPECT_TRUE(Insert(seq_num++, kKeyFrame, i == 0 ? kFirst : kNotFirst,
+                         i == kFrameSize - 1 ? kLast : kNotLast, 1, data));
+    }
+
+    ASSERT_EQ(1UL, frames_from_callback_.size());
+    CheckFrame(first_seq_num);
+    EXPECT_TRUE(frames_from_callback_[first_seq_num]->GetBitstream(result));
+    EXPECT_EQ(memcmp(result, expected, kFrameSize), 0);
+    frames_from_callback_.clear();
+  }
+}
+
 // If |sps_pps_idr_is_keyframe| is true, we require keyframes to contain
 // SPS/PPS/IDR and the keyframes we create as part of the test do contain
 // SPS/PPS/IDR. If |sps_pps_idr_is_keyframe| is false, we only require and
@@ -609,12 +666,13 @@ TEST_P(TestPacketBufferH264Parameterized, GetBitstreamBufferPadding) {
   packet_buffer_->InsertPacket(&packet);
 
   ASSERT_EQ(1UL, frames_from_callback_.size());
+  frames_from_callback_[seq_num]->MakeBitstreamContiguous();
   EXPECT_EQ(frames_from_callback_[seq_num]->EncodedImage()._length,
             sizeof(data_data));
   EXPECT_EQ(frames_from_callback_[seq_num]->EncodedImage()._size,
             sizeof(data_data) + EncodedImage::kBufferPaddingBytesH264);
   EXPECT_TRUE(frames_from_callback_[seq_num]->GetBitstream(result.get()));
-  EXPECT_EQ(memcmp(result.get(), data, sizeof(data_data)), 0);
+  EXPECT_EQ(memcmp(result.get(), data_data, sizeof(data_data)), 0);
 }
 
 TEST_F(TestPacketBuffer, FreeSlotsOnFrameDestruction) {
@@ -656,14 +714,19 @@ TEST_F(TestPacketBuffer, Clear) {
   CheckFrame(seq_num + kStartSize);
 }
 
-TEST_F(TestPacketBuffer, InvalidateFrameByClearing) {
+TEST_F(TestPacketBuffer, FrameKeepsBitstreamAfterClearing) {
   const uint16_t seq_num = Rand();
+  uint8_t* data = new uint8_t[4];
+  memcpy(data, "data", 4);
+  uint8_t result[4];
 
-  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kLast));
+  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kLast, 4, data));
   ASSERT_EQ(1UL, frames_from_callback_.size());
 
+  // The frame owns its bitstream, so it stays valid.
   packet_buffer_->Clear();
-  EXPECT_FALSE(frames_from_callback_.begin()->second->GetBitstream(nullptr));
+  EXPECT_TRUE(frames_from_callback_.begin()->second->GetBitstream(result));
+  EXPECT_EQ(0, memcmp(result, "data", 4));
 }
 
 TEST_F(TestPacketBuffer, FramesAfterClear) {
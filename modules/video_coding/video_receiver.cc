@@ -339,6 +339,14 @@ int32_t VideoReceiver::Decode(const webrtc::VCMEncodedFrame* frame) {
   return Decode(*frame);
 }
 
+int32_t VideoReceiver::PrewarmDecoder(uint8_t payload_type) {
+  RTC_DCHECK_RUN_ON(&decoder_thread_checker_);
+  TRACE_EVENT0("webrtc", "VideoReceiver::PrewarmDecoder");
+  if (!_codecDataBase.PrewarmDecoder(payload_type, &_decodedFrameCallback))
+    return VCM_NO_CODEC_REGISTERED;
+  return VCM_OK;
+}
+
 int32_t VideoReceiver::RequestKeyFrame() {
   RTC_DCHECK_RUN_ON(&module_thread_checker_);
 
@@ -208,6 +208,30 @@ TEST_F(TestVideoReceiver, PaddingOnlyAndVideo) {
   }
 }
 
+TEST_F(TestVideoReceiver, PrewarmedDecoderDecodesFirstFrame) {
+  EXPECT_EQ(VCM_NO_CODEC_REGISTERED,
+            receiver_->PrewarmDecoder(kUnusedPayloadType + 1));
+
+  // The decoder is initialized once, ahead of the frame.
+  EXPECT_CALL(decoder_, InitDecode(_, _)).Times(1);
+  EXPECT_CALL(receive_callback_, OnIncomingPayloadType(kUnusedPayloadType))
+      .Times(1);
+  EXPECT_EQ(VCM_OK, receiver_->PrewarmDecoder(kUnusedPayloadType));
+  EXPECT_EQ(VCM_OK, receiver_->PrewarmDecoder(kUnusedPayloadType));
+
+  const size_t kFrameSize = 1200;
+  const uint8_t payload[kFrameSize] = {0};
+  WebRtcRTPHeader header = {};
+  header.frameType = kVideoFrameKey;
+  header.video_header().is_first_packet_in_frame = true;
+  header.header.markerBit = true;
+  header.header.payloadType = kUnusedPayloadType;
+  header.header.ssrc = 1;
+  header.header.headerLength = 12;
+  header.video_header().codec = kVideoCodecVP8;
+  InsertAndVerifyDecodableFrame(payload, kFrameSize, &header);
+}
+
 TEST_F(TestVideoReceiver, ReceiverDelay) {
   EXPECT_EQ(0, receiver_->SetMinReceiverDelay(0));
   EXPECT_EQ(0, receiver_->SetMinReceiverDelay(5000));
@@ -34,6 +34,7 @@ VideoSender::VideoSender(Clock* clock,
       post_encode_callback_(post_encode_callback),
       _codecDataBase(&_encodedFrameCallback),
       frame_dropper_enabled_(true),
+      dropped_update_rect_(VideoFrame::UpdateRect{0, 0, 0, 0}),
       current_codec_(),
       encoder_params_({VideoBitrateAllocation(), 0, 0, 0}),
       encoder_has_internal_source_(false),
@@ -254,6 +255,15 @@ int32_t VideoSender::AddVideoFrame(const VideoFrame& videoFrame,
   rtc::CritScope lock(&encoder_crit_);
   if (_encoder == nullptr)
     return VCM_UNINITIALIZED;
+  // The encoder must get the changes of the frames dropped here with the next
+  // frame it encodes.
+  absl::optional<VideoFrame::UpdateRect> update_rect = dropped_update_rect_;
+  if (update_rect && videoFrame.update_rect()) {
+    update_rect->Union(*videoFrame.update_rect());
+  } else {
+    update_rect.reset();
+  }
+  dropped_update_rect_ = update_rect;
   SetEncoderParameters(encoder_params, encoder_has_internal_source);
   if (_mediaOpt.DropFrame()) {
     RTC_LOG(LS_VERBOSE) << "Drop Frame "
@@ -296,12 +306,14 @@ int32_t VideoSender::AddVideoFrame(const VideoFrame& videoFrame,
                                  converted_frame.render_time_ms(),
                                  converted_frame.rotation());
   }
+  converted_frame.set_update_rect(update_rect);
   int32_t ret =
       _encoder->Encode(converted_frame, codecSpecificInfo, next_frame_types);
   if (ret < 0) {
     RTC_LOG(LS_ERROR) << "Failed to encode frame. Error code: " << ret;
     return ret;
   }
+  dropped_update_rect_ = VideoFrame::UpdateRect{0, 0, 0, 0};
 
   {
     rtc::CritScope lock(&params_crit_);
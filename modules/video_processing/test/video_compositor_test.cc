@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "api/video/i420_buffer.h"
+#include "modules/video_processing/video_compositor.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/gunit.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 180;
+constexpr int kTimeoutMs = 5000;
+
+class FakeOutput : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  void OnFrame(const VideoFrame& frame) override {
+    rtc::CritScope lock(&crit_);
+    last_frame_ = frame.video_frame_buffer()->ToI420();
+    if (frame.update_rect() && !frame.update_rect()->IsEmpty())
+      last_update_rect_ = *frame.update_rect();
+  }
+
+  // Luma of the last composed frame at |x|, |y|, or -1 if there is none.
+  int LumaAt(int x, int y) const {
+    rtc::CritScope lock(&crit_);
+    if (!last_frame_)
+      return -1;
+    return last_frame_->DataY()[y * last_frame_->StrideY() + x];
+  }
+
+  VideoFrame::UpdateRect last_update_rect() const {
+    rtc::CritScope lock(&crit_);
+    return last_update_rect_;
+  }
+
+ private:
+  rtc::CriticalSection crit_;
+  rtc::scoped_refptr<I420BufferInterface> last_frame_ RTC_GUARDED_BY(crit_);
+  VideoFrame::UpdateRect last_update_rect_ RTC_GUARDED_BY(crit_) = {0, 0, 0,
+                                                                    0};
+};
+
+VideoFrame CreateFrame(int width, int height, uint8_t luma) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  I420Buffer::SetBlack(buffer.get());
+  for (int y = 0; y < height; ++y)
+    memset(buffer->MutableDataY() + y * buffer->StrideY(), luma, width);
+  return VideoFrame(buffer, kVideoRotation_0, 0);
+}
+
+}  // namespace
+
+TEST(VideoCompositorTest, ComposesInputsIntoGrid) {
+  FakeOutput output;
+  VideoCompositor::Config config;
+  config.width = kWidth;
+  config.height = kHeight;
+  config.num_worker_threads = 2;
+  VideoCompositor compositor(config, &output);
+
+  // Four inputs in a 2x2 grid, of different sizes and aspect ratios.
+  const uint8_t kLumas[] = {20, 80, 140, 200};
+  const int kSizes[][2] = {{640, 360}, {160, 120}, {90, 160}, {2, 2}};
+  for (int i = 0; i < 4; ++i)
+    compositor.AddInput()->OnFrame(
+        CreateFrame(kSizes[i][0], kSizes[i][1], kLumas[i]));
+
+  EXPECT_EQ_WAIT(kLumas[3], output.LumaAt(kWidth * 3 / 4, kHeight * 3 / 4),
+                 kTimeoutMs);
+  EXPECT_EQ(kLumas[0], output.LumaAt(0, 0));
+  EXPECT_EQ(kLumas[0], output.LumaAt(kWidth / 2 - 1, kHeight / 2 - 1));
+  EXPECT_EQ(kLumas[1], output.LumaAt(kWidth / 2, 0));
+  EXPECT_EQ(kLumas[2], output.LumaAt(0, kHeight / 2));
+  EXPECT_EQ(kLumas[3], output.LumaAt(kWidth - 1, kHeight - 1));
+}
+
+TEST(VideoCompositorTest, ShowsInputWithoutFrameAsBlack) {
+  FakeOutput output;
+  VideoCompositor::Config config;
+  config.width = kWidth;
+  config.height = kHeight;
+  VideoCompositor compositor(config, &output);
+
+  rtc::VideoSinkInterface<VideoFrame>* first = compositor.AddInput();
+  compositor.AddInput();
+  first->OnFrame(CreateFrame(kWidth, kHeight, 100));
+  EXPECT_EQ_WAIT(100, output.LumaAt(0, 0), kTimeoutMs);
+  EXPECT_EQ(0, output.LumaAt(kWidth - 1, 0));
+
+  // The second input moves into the tile of the first one.
+  compositor.RemoveInput(first);
+  EXPECT_EQ_WAIT(0, output.LumaAt(0, 0), kTimeoutMs);
+}
+
+TEST(VideoCompositorTest, ScalesOnlyChangedTiles) {
+  FakeOutput output;
+  VideoCompositor::Config config;
+  config.width = kWidth;
+  config.height = kHeight;
+  VideoCompositor compositor(config, &output);
+
+  rtc::VideoSinkInterface<VideoFrame>* changing = compositor.AddInput();
+  rtc::VideoSinkInterface<VideoFrame>* still = compositor.AddInput();
+  still->OnFrame(CreateFrame(kWidth, kHeight, 200));
+
+  // Let each pooled buffer be composed with the frame of |still|.
+  int num_scaled_tiles = 0;
+  for (uint8_t luma = 10; luma < 100; luma += 10) {
+    changing->OnFrame(CreateFrame(kWidth, kHeight, luma));
+    EXPECT_EQ_WAIT(luma, output.LumaAt(0, 0), kTimeoutMs);
+    num_scaled_tiles = compositor.num_scaled_tiles();
+  }
+  EXPECT_EQ(200, output.LumaAt(kWidth - 1, 0));
+
+  changing->OnFrame(CreateFrame(kWidth, kHeight, 100));
+  EXPECT_EQ_WAIT(100, output.LumaAt(0, 0), kTimeoutMs);
+  EXPECT_EQ(num_scaled_tiles + 1, compositor.num_scaled_tiles());
+  EXPECT_EQ(200, output.LumaAt(kWidth - 1, 0));
+
+  const VideoFrame::UpdateRect update_rect = output.last_update_rect();
+  EXPECT_EQ(0, update_rect.offset_x);
+  EXPECT_EQ(0, update_rect.offset_y);
+  EXPECT_EQ(kWidth / 2, update_rect.width);
+  EXPECT_EQ(kHeight, update_rect.height);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,282 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_processing/video_compositor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/timeutils.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
+#include "third_party/libyuv/include/libyuv/scale.h"
+
+namespace webrtc {
+
+namespace {
+
+// Crops |src| to the aspect ratio of the |width| x |height| region at |dst_y|,
+// |dst_u| and |dst_v|, and scales it into the region.
+void ScaleIntoRegion(const I420BufferInterface& src,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int width,
+                     int height) {
+  const int crop_width = std::min(src.width(), width * src.height() / height);
+  const int crop_height = std::min(src.height(), height * src.width() / width);
+  // Even offsets, so that the chroma planes are aligned.
+  const int uv_offset_x = (src.width() - crop_width) / 4;
+  const int uv_offset_y = (src.height() - crop_height) / 4;
+  const uint8_t* src_y =
+      src.DataY() + src.StrideY() * uv_offset_y * 2 + uv_offset_x * 2;
+  const uint8_t* src_u =
+      src.DataU() + src.StrideU() * uv_offset_y + uv_offset_x;
+  const uint8_t* src_v =
+      src.DataV() + src.StrideV() * uv_offset_y + uv_offset_x;
+  const int res = libyuv::I420Scale(
+      src_y, src.StrideY(), src_u, src.StrideU(), src_v, src.StrideV(),
+      crop_width, crop_height, dst_y, dst_stride_y, dst_u, dst_stride_u, dst_v,
+      dst_stride_v, width, height, libyuv::kFilterBox);
+  RTC_DCHECK_EQ(res, 0);
+}
+
+// Start of cell |index| when |size| is split into |count| cells, rounded down
+// to even.
+int CellStart(int index, int count, int size) {
+  return (index * size / count) & ~1;
+}
+
+}  // namespace
+
+class VideoCompositor::Input : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  explicit Input(int id) : id_(id), frame_count_(0) {}
+
+  void OnFrame(const VideoFrame& frame) override {
+    rtc::CritScope lock(&crit_);
+    frame_ = frame.video_frame_buffer();
+    ++frame_count_;
+  }
+
+  // Returns the latest frame and what it is.
+  TileContent GetFrame(rtc::scoped_refptr<VideoFrameBuffer>* frame) const {
+    rtc::CritScope lock(&crit_);
+    *frame = frame_;
+    return TileContent{id_, frame_count_};
+  }
+
+ private:
+  const int id_;
+  rtc::CriticalSection crit_;
+  rtc::scoped_refptr<VideoFrameBuffer> frame_ RTC_GUARDED_BY(crit_);
+  int64_t frame_count_ RTC_GUARDED_BY(crit_);
+};
+
+VideoCompositor::VideoCompositor(const Config& config,
+                                 rtc::VideoSinkInterface<VideoFrame>* output)
+    : config_(config),
+      output_(output),
+      next_input_id_(0),
+      num_scaled_tiles_(0),
+      next_compose_ms_(rtc::TimeMillis()),
+      queue_("VideoCompositor", rtc::TaskQueue::Priority::HIGH) {
+  RTC_DCHECK(output_);
+  RTC_DCHECK_GT(config_.width, 0);
+  RTC_DCHECK_GT(config_.height, 0);
+  RTC_DCHECK_GT(config_.max_fps, 0);
+  for (int i = 0; i < config_.num_worker_threads; ++i) {
+    const std::string name = "VideoCompositorWorker" + std::to_string(i);
+    workers_.push_back(absl::make_unique<rtc::TaskQueue>(
+        name.c_str(), rtc::TaskQueue::Priority::HIGH));
+  }
+  queue_.PostTask([this] { ComposeAndReschedule(); });
+}
+
+VideoCompositor::~VideoCompositor() = default;
+
+rtc::VideoSinkInterface<VideoFrame>* VideoCompositor::AddInput() {
+  rtc::CritScope lock(&crit_);
+  inputs_.push_back(absl::make_unique<Input>(next_input_id_++));
+  return inputs_.back().get();
+}
+
+void VideoCompositor::RemoveInput(rtc::VideoSinkInterface<VideoFrame>* input) {
+  rtc::CritScope lock(&crit_);
+  auto it = std::find_if(inputs_.begin(), inputs_.end(),
+                         [input](const std::unique_ptr<Input>& other) {
+                           return other.get() == input;
+                         });
+  RTC_DCHECK(it != inputs_.end());
+  if (it != inputs_.end())
+    inputs_.erase(it);
+}
+
+int VideoCompositor::num_scaled_tiles() const {
+  rtc::CritScope lock(&crit_);
+  return num_scaled_tiles_;
+}
+
+VideoCompositor::Tile VideoCompositor::GetTile(size_t index,
+                                               size_t num_tiles) const {
+  const int columns = static_cast<int>(std::ceil(std::sqrt(num_tiles)));
+  const int rows = (static_cast<int>(num_tiles) + columns - 1) / columns;
+  const int column = static_cast<int>(index) % columns;
+  const int row = static_cast<int>(index) / columns;
+  Tile tile;
+  tile.x = CellStart(column, columns, config_.width);
+  tile.y = CellStart(row, rows, config_.height);
+  tile.width = CellStart(column + 1, columns, config_.width) - tile.x;
+  tile.height = CellStart(row + 1, rows, config_.height) - tile.y;
+  return tile;
+}
+
+void VideoCompositor::ComposeAndReschedule() {
+  RTC_DCHECK(queue_.IsCurrent());
+  Compose();
+
+  // Keep to the frame rate on average, but don't compose a burst of frames
+  // after falling behind.
+  const int64_t now_ms = rtc::TimeMillis();
+  next_compose_ms_ =
+      std::max(now_ms, next_compose_ms_ + 1000 / config_.max_fps);
+  queue_.PostDelayedTask([this] { ComposeAndReschedule(); },
+                         static_cast<uint32_t>(next_compose_ms_ - now_ms));
+}
+
+void VideoCompositor::Compose() {
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> frames;
+  std::vector<TileContent> contents;
+  {
+    rtc::CritScope lock(&crit_);
+    frames.resize(inputs_.size());
+    for (size_t i = 0; i < inputs_.size(); ++i)
+      contents.push_back(inputs_[i]->GetFrame(&frames[i]));
+  }
+
+  VideoFrame::UpdateRect update_rect = {0, 0, 0, 0};
+  if (!last_output_ || contents != last_contents_) {
+    rtc::scoped_refptr<I420Buffer> buffer =
+        buffer_pool_.CreateBuffer(config_.width, config_.height);
+    if (!buffer) {
+      RTC_LOG(LS_WARNING) << "No output buffer available, skipping frame.";
+      return;
+    }
+
+    // A buffer that hasn't been composed with the current layout is cleared,
+    // which is what the tiles of inputs without frames show.
+    std::vector<TileContent>& buffer_contents = buffer_contents_[buffer.get()];
+    if (buffer_contents.size() != contents.size()) {
+      I420Buffer::SetBlack(buffer.get());
+      buffer_contents.clear();
+      for (const TileContent& content : contents)
+        buffer_contents.push_back(TileContent{content.input_id, 0});
+    }
+
+    // The tile of an input without frames is cleared if it held another input.
+    std::vector<TileJob> jobs;
+    for (size_t i = 0; i < contents.size(); ++i) {
+      if (buffer_contents[i] == contents[i])
+        continue;
+      const Tile tile = GetTile(i, contents.size());
+      if (tile.width > 0 && tile.height > 0)
+        jobs.push_back(TileJob{frames[i], tile});
+    }
+    ScaleTiles(jobs, buffer.get());
+    buffer_contents = contents;
+
+    // Tell the encoder which tiles changed since the previous output frame.
+    if (!last_output_ || contents.size() != last_contents_.size()) {
+      update_rect = {0, 0, config_.width, config_.height};
+    } else {
+      for (size_t i = 0; i < contents.size(); ++i) {
+        if (contents[i] == last_contents_[i])
+          continue;
+        const Tile tile = GetTile(i, contents.size());
+        const VideoFrame::UpdateRect tile_rect = {tile.x, tile.y, tile.width,
+                                                  tile.height};
+        if (update_rect.IsEmpty())
+          update_rect = tile_rect;
+        else
+          update_rect.Union(tile_rect);
+      }
+    }
+
+    {
+      rtc::CritScope lock(&crit_);
+      num_scaled_tiles_ += static_cast<int>(jobs.size());
+    }
+    last_output_ = buffer;
+    last_contents_ = contents;
+  }
+
+  output_->OnFrame(VideoFrame::Builder()
+                       .set_video_frame_buffer(last_output_)
+                       .set_timestamp_us(rtc::TimeMicros())
+                       .set_update_rect(update_rect)
+                       .build());
+}
+
+void VideoCompositor::ScaleTiles(const std::vector<TileJob>& jobs,
+                                 I420Buffer* buffer) {
+  const size_t num_shards = std::min(jobs.size(), workers_.size() + 1);
+  auto scale_shard = [&jobs, buffer, num_shards](size_t shard) {
+    for (size_t i = shard; i < jobs.size(); i += num_shards) {
+      const Tile& tile = jobs[i].tile;
+      const rtc::scoped_refptr<I420BufferInterface> source =
+          jobs[i].source ? jobs[i].source->ToI420() : nullptr;
+      if (!source) {
+        libyuv::I420Rect(buffer->MutableDataY(), buffer->StrideY(),
+                         buffer->MutableDataU(), buffer->StrideU(),
+                         buffer->MutableDataV(), buffer->StrideV(), tile.x,
+                         tile.y, tile.width, tile.height, 0, 128, 128);
+        continue;
+      }
+      ScaleIntoRegion(
+          *source,
+          buffer->MutableDataY() + buffer->StrideY() * tile.y + tile.x,
+          buffer->StrideY(),
+          buffer->MutableDataU() + buffer->StrideU() * tile.y / 2 + tile.x / 2,
+          buffer->StrideU(),
+          buffer->MutableDataV() + buffer->StrideV() * tile.y / 2 + tile.x / 2,
+          buffer->StrideV(), tile.width, tile.height);
+    }
+  };
+  if (num_shards <= 1) {
+    if (num_shards == 1)
+      scale_shard(0);
+    return;
+  }
+
+  // The compositor queue scales the first shard while the workers scale the
+  // others.
+  rtc::Event done(false, false);
+  volatile int pending_shards = static_cast<int>(num_shards) - 1;
+  for (size_t shard = 1; shard < num_shards; ++shard) {
+    workers_[shard - 1]->PostTask(
+        [&scale_shard, &done, &pending_shards, shard] {
+          scale_shard(shard);
+          if (rtc::AtomicOps::Decrement(&pending_shards) == 0)
+            done.Set();
+        });
+  }
+  scale_shard(0);
+  done.Wait(rtc::Event::kForever);
+}
+
+}  // namespace webrtc
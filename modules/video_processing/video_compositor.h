@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_PROCESSING_VIDEO_COMPOSITOR_H_
+#define MODULES_VIDEO_PROCESSING_VIDEO_COMPOSITOR_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
+#include "common_video/include/i420_buffer_pool.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Composes the latest frames of any number of inputs into one frame, laid out
+// as a grid of tiles, e.g. for a server that mixes the video of a conference.
+// The composed frames are produced at |Config::max_fps| on a task queue of
+// the compositor.
+//
+// Each input frame is cropped to the aspect ratio of its tile and scaled
+// directly into the tile region of the output buffer, which is taken from a
+// pool. A pooled buffer remembers which frames its tiles hold, so only the
+// tiles whose input has a new frame since the buffer was last composed are
+// scaled again. If no input has a new frame, the previous composed frame is
+// sent again. The tiles are scaled in parallel on |Config::num_worker_threads|
+// worker queues in addition to the compositor queue.
+//
+// Input frames are composed without applying their rotation.
+class VideoCompositor {
+ public:
+  struct Config {
+    int width = 1280;
+    int height = 720;
+    int max_fps = 30;
+    int num_worker_threads = 0;
+  };
+
+  // |output| must outlive the compositor, and is called on its task queue.
+  VideoCompositor(const Config& config,
+                  rtc::VideoSinkInterface<VideoFrame>* output);
+  ~VideoCompositor();
+
+  // Adds an input, shown in the tile after the tiles of the existing inputs.
+  // The returned sink may be called on any thread until it is removed.
+  rtc::VideoSinkInterface<VideoFrame>* AddInput();
+  // The remaining inputs move up to fill the tile of |input|.
+  void RemoveInput(rtc::VideoSinkInterface<VideoFrame>* input);
+
+  // Number of tiles scaled into output buffers so far.
+  int num_scaled_tiles() const;
+
+ private:
+  class Input;
+
+  // Region of the output frame.
+  struct Tile {
+    int x;
+    int y;
+    int width;
+    int height;
+  };
+  // Identifies the input frame a tile was composed from.
+  struct TileContent {
+    int input_id;
+    // Zero if the input had no frame yet.
+    int64_t frame_count;
+
+    bool operator==(const TileContent& other) const {
+      return input_id == other.input_id && frame_count == other.frame_count;
+    }
+    bool operator!=(const TileContent& other) const {
+      return !(*this == other);
+    }
+  };
+  struct TileJob {
+    // Null if the tile is cleared.
+    rtc::scoped_refptr<VideoFrameBuffer> source;
+    Tile tile;
+  };
+
+  // Region of tile |index| out of |num_tiles|.
+  Tile GetTile(size_t index, size_t num_tiles) const;
+
+  void ComposeAndReschedule();
+  void Compose();
+  // Scales the jobs into |buffer|, spread over the worker queues.
+  void ScaleTiles(const std::vector<TileJob>& jobs, I420Buffer* buffer);
+
+  const Config config_;
+  rtc::VideoSinkInterface<VideoFrame>* const output_;
+
+  rtc::CriticalSection crit_;
+  std::vector<std::unique_ptr<Input>> inputs_ RTC_GUARDED_BY(crit_);
+  int next_input_id_ RTC_GUARDED_BY(crit_);
+  int num_scaled_tiles_ RTC_GUARDED_BY(crit_);
+
+  // Only used on |queue_|.
+  I420BufferPool buffer_pool_;
+  // What the tiles of the pooled buffers hold. The buffers are kept by the
+  // pool, which never frees them since the output resolution is fixed.
+  std::map<const I420Buffer*, std::vector<TileContent>> buffer_contents_;
+  rtc::scoped_refptr<I420Buffer> last_output_;
+  std::vector<TileContent> last_contents_;
+  int64_t next_compose_ms_;
+
+  std::vector<std::unique_ptr<rtc::TaskQueue>> workers_;
+  // Destroyed first, so that its tasks may use the members above.
+  rtc::TaskQueue queue_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(VideoCompositor);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_PROCESSING_VIDEO_COMPOSITOR_H_
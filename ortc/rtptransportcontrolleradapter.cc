@@ -864,7 +864,7 @@ void RtpTransportControllerAdapter::OnVideoReceiverDestroyed() {
 void RtpTransportControllerAdapter::CreateVoiceChannel() {
   voice_channel_ = channel_manager_->CreateVoiceChannel(
       call_.get(), media_config_, inner_audio_transport_->GetInternal(),
-      signaling_thread_, "audio", false, rtc::CryptoOptions(),
+      network_thread_, signaling_thread_, "audio", false, rtc::CryptoOptions(),
       cricket::AudioOptions());
   RTC_DCHECK(voice_channel_);
   voice_channel_->Enable(true);
@@ -873,7 +873,7 @@ void RtpTransportControllerAdapter::CreateVoiceChannel() {
 void RtpTransportControllerAdapter::CreateVideoChannel() {
   video_channel_ = channel_manager_->CreateVideoChannel(
       call_.get(), media_config_, inner_video_transport_->GetInternal(),
-      signaling_thread_, "video", false, rtc::CryptoOptions(),
+      network_thread_, signaling_thread_, "video", false, rtc::CryptoOptions(),
       cricket::VideoOptions());
   RTC_DCHECK(video_channel_);
   video_channel_->Enable(true);
@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/asyncresolvercache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/bind.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/nethelpers.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/timeutils.h"
+
+namespace rtc {
+
+// The resolver handed out by the cache. It gets its result from the cache,
+// or from the lookup the cache makes for all the resolvers of a hostname.
+class AsyncResolverCache::CachedResolver : public AsyncResolverInterface {
+ public:
+  explicit CachedResolver(AsyncResolverCache* cache) : cache_(cache) {}
+
+  void Start(const SocketAddress& addr) override {
+    addr_ = addr;
+    cache_->Resolve(this, addr);
+  }
+
+  bool GetResolvedAddress(int family, SocketAddress* addr) const override {
+    if (error_ != 0 || addresses_.empty())
+      return false;
+    *addr = addr_;
+    for (const IPAddress& ip : addresses_) {
+      if (family == ip.family()) {
+        addr->SetResolvedIP(ip);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int GetError() const override { return error_; }
+
+  void Destroy(bool wait) override {
+    cache_->Cancel(this);
+    delete this;
+  }
+
+  void Complete(const std::vector<IPAddress>& addresses, int error) {
+    addresses_ = addresses;
+    error_ = error;
+    SignalDone(this);
+  }
+
+  // Users expect SignalDone after Start() has returned, even when the
+  // result is already known.
+  void CompleteAsync(const std::vector<IPAddress>& addresses) {
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, Thread::Current(),
+        Bind(&CachedResolver::Complete, this, addresses, 0));
+  }
+
+ private:
+  AsyncResolverCache* const cache_;
+  SocketAddress addr_;
+  std::vector<IPAddress> addresses_;
+  int error_ = 0;
+  AsyncInvoker invoker_;
+};
+
+AsyncResolverCache::AsyncResolverCache(int ttl_ms)
+    : AsyncResolverCache(ttl_ms, nullptr) {}
+
+AsyncResolverCache::AsyncResolverCache(int ttl_ms,
+                                       webrtc::AsyncResolverFactory* factory)
+    : ttl_ms_(ttl_ms), factory_(factory) {}
+
+AsyncResolverCache::~AsyncResolverCache() {
+  for (auto& lookup : lookups_) {
+    RTC_DCHECK(lookup.second.waiters.empty());
+    lookup.second.resolver->Destroy(false);
+  }
+}
+
+AsyncResolverInterface* AsyncResolverCache::CreateResolver() {
+  return new CachedResolver(this);
+}
+
+void AsyncResolverCache::Resolve(CachedResolver* waiter,
+                                 const SocketAddress& addr) {
+  if (!addr.IsUnresolvedIP()) {
+    waiter->CompleteAsync(std::vector<IPAddress>(1, addr.ipaddr()));
+    return;
+  }
+  const std::string& hostname = addr.hostname();
+  auto entry_it = entries_.find(hostname);
+  if (entry_it != entries_.end() &&
+      TimeMillis() < entry_it->second.expires_ms) {
+    waiter->CompleteAsync(entry_it->second.addresses);
+    return;
+  }
+
+  Lookup& lookup = lookups_[hostname];
+  lookup.waiters.push_back(waiter);
+  if (!lookup.resolver) {
+    RTC_LOG(LS_INFO) << "Looking up " << hostname << " for the cache";
+    lookup.resolver = factory_ ? factory_->Create() : new AsyncResolver();
+    lookup.resolver->SignalDone.connect(this,
+                                        &AsyncResolverCache::OnResolveDone);
+    lookup.resolver->Start(addr);
+  }
+}
+
+void AsyncResolverCache::Cancel(CachedResolver* waiter) {
+  // A lookup outlives its waiters, so that its result is still cached.
+  for (auto& lookup : lookups_) {
+    std::vector<CachedResolver*>& waiters = lookup.second.waiters;
+    waiters.erase(std::remove(waiters.begin(), waiters.end(), waiter),
+                  waiters.end());
+  }
+}
+
+void AsyncResolverCache::OnResolveDone(AsyncResolverInterface* resolver) {
+  auto it = std::find_if(lookups_.begin(), lookups_.end(),
+                         [resolver](const std::pair<const std::string,
+                                                    Lookup>& lookup) {
+                           return lookup.second.resolver == resolver;
+                         });
+  RTC_DCHECK(it != lookups_.end());
+  AsyncResolverInterface* done = it->second.resolver;
+  std::vector<CachedResolver*> waiters;
+  waiters.swap(it->second.waiters);
+  int error = done->GetError();
+  // The resolvers only tell the first address of each family.
+  std::vector<IPAddress> addresses;
+  for (int family : {AF_INET, AF_INET6}) {
+    SocketAddress resolved;
+    if (error == 0 && done->GetResolvedAddress(family, &resolved))
+      addresses.push_back(resolved.ipaddr());
+  }
+  const int64_t now_ms = TimeMillis();
+  RemoveExpiredEntries(now_ms);
+  if (error == 0) {
+    Entry& entry = entries_[it->first];
+    entry.addresses = addresses;
+    entry.expires_ms = now_ms + ttl_ms_;
+  }
+  lookups_.erase(it);
+
+  // A waiter may destroy itself, or start another lookup, when it is done.
+  for (CachedResolver* waiter : waiters)
+    waiter->Complete(addresses, error);
+  // The resolver cannot be destroyed while it is signaling.
+  invoker_.AsyncInvoke<void>(
+      RTC_FROM_HERE, Thread::Current(),
+      Bind(&AsyncResolverInterface::Destroy, done, false));
+}
+
+void AsyncResolverCache::RemoveExpiredEntries(int64_t now_ms) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (now_ms < it->second.expires_ms)
+      ++it;
+    else
+      it = entries_.erase(it);
+  }
+}
+
+}  // namespace rtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_ASYNCRESOLVERCACHE_H_
+#define P2P_BASE_ASYNCRESOLVERCACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "api/asyncresolverfactory.h"
+#include "rtc_base/asyncinvoker.h"
+#include "rtc_base/asyncresolverinterface.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/ipaddress.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+
+namespace rtc {
+
+// Creates resolvers that share their DNS results for |ttl_ms|, so that the
+// ports of new PeerConnections do not look up the STUN and TURN hostnames
+// again. Concurrent lookups of the same hostname are made only once. The
+// system resolver does not tell the TTL of the DNS records, so |ttl_ms| is
+// how long a stale address may be used. Failed lookups are not cached.
+//
+// The lookups are made with resolvers from |factory|, or with
+// rtc::AsyncResolver if it's null. All resolvers must be used on the thread
+// of the cache, and destroyed before it.
+class AsyncResolverCache : public sigslot::has_slots<> {
+ public:
+  explicit AsyncResolverCache(int ttl_ms);
+  AsyncResolverCache(int ttl_ms, webrtc::AsyncResolverFactory* factory);
+  ~AsyncResolverCache() override;
+
+  AsyncResolverInterface* CreateResolver();
+
+  // The number of hostnames being looked up.
+  size_t num_pending_lookups() const { return lookups_.size(); }
+  // The number of hostnames whose addresses are cached, including expired
+  // ones that haven't been removed yet.
+  size_t num_entries() const { return entries_.size(); }
+
+ private:
+  class CachedResolver;
+  struct Entry {
+    std::vector<IPAddress> addresses;
+    int64_t expires_ms = 0;
+  };
+  struct Lookup {
+    AsyncResolverInterface* resolver = nullptr;
+    std::vector<CachedResolver*> waiters;
+  };
+
+  void Resolve(CachedResolver* waiter, const SocketAddress& addr);
+  void Cancel(CachedResolver* waiter);
+  void OnResolveDone(AsyncResolverInterface* resolver);
+  void RemoveExpiredEntries(int64_t now_ms);
+
+  const int ttl_ms_;
+  webrtc::AsyncResolverFactory* const factory_;
+  std::map<std::string, Entry> entries_;
+  std::map<std::string, Lookup> lookups_;
+  AsyncInvoker invoker_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncResolverCache);
+};
+
+}  // namespace rtc
+
+#endif  // P2P_BASE_ASYNCRESOLVERCACHE_H_
@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/asyncresolvercache.h"
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/fakeclock.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+
+namespace {
+
+const int kTtlMs = 60 * 1000;
+const int kResolveTimeoutMs = 10000;
+const SocketAddress kHostnameAddr("localhost", 5000);
+
+// Resolves every hostname to 1.2.3.4 when Finish() is called.
+class FakeResolver : public AsyncResolverInterface {
+ public:
+  explicit FakeResolver(int* num_alive) : num_alive_(num_alive) {
+    ++*num_alive_;
+  }
+
+  void Start(const SocketAddress& addr) override { addr_ = addr; }
+  bool GetResolvedAddress(int family, SocketAddress* addr) const override {
+    if (family != AF_INET)
+      return false;
+    *addr = addr_;
+    addr->SetResolvedIP(IPAddress(0x01020304));
+    return true;
+  }
+  int GetError() const override { return 0; }
+  void Destroy(bool wait) override {
+    --*num_alive_;
+    delete this;
+  }
+
+  void Finish() { SignalDone(this); }
+
+ private:
+  int* const num_alive_;
+  SocketAddress addr_;
+};
+
+class FakeResolverFactory : public webrtc::AsyncResolverFactory {
+ public:
+  AsyncResolverInterface* Create() override {
+    resolvers_.push_back(new FakeResolver(&num_alive_));
+    return resolvers_.back();
+  }
+
+  // Destroyed resolvers are kept in the list.
+  const std::vector<FakeResolver*>& resolvers() const { return resolvers_; }
+  int num_alive() const { return num_alive_; }
+
+ private:
+  std::vector<FakeResolver*> resolvers_;
+  int num_alive_ = 0;
+};
+
+}  // namespace
+
+class AsyncResolverCacheTest : public testing::Test,
+                               public sigslot::has_slots<> {
+ public:
+  AsyncResolverCacheTest() : cache_(kTtlMs) {}
+
+ protected:
+  AsyncResolverInterface* Start(const SocketAddress& addr) {
+    AsyncResolverInterface* resolver = cache_.CreateResolver();
+    resolver->SignalDone.connect(this, &AsyncResolverCacheTest::OnDone);
+    resolver->Start(addr);
+    return resolver;
+  }
+
+  void OnDone(AsyncResolverInterface* resolver) { ++num_done_; }
+
+  AsyncResolverCache cache_;
+  int num_done_ = 0;
+};
+
+TEST_F(AsyncResolverCacheTest, ResolvesIpLiteralWithoutLookup) {
+  const SocketAddress addr("1.2.3.4", 5000);
+  AsyncResolverInterface* resolver = Start(addr);
+  EXPECT_EQ(0u, cache_.num_pending_lookups());
+  // Done is signaled after Start() returns.
+  EXPECT_EQ(0, num_done_);
+  EXPECT_EQ_WAIT(1, num_done_, kResolveTimeoutMs);
+  SocketAddress resolved;
+  EXPECT_TRUE(resolver->GetResolvedAddress(AF_INET, &resolved));
+  EXPECT_EQ(addr, resolved);
+  resolver->Destroy(false);
+}
+
+TEST_F(AsyncResolverCacheTest, LooksUpHostnameOnce) {
+  AsyncResolverInterface* first = Start(kHostnameAddr);
+  AsyncResolverInterface* second = Start(kHostnameAddr);
+  EXPECT_EQ(1u, cache_.num_pending_lookups());
+  ASSERT_EQ_WAIT(2, num_done_, kResolveTimeoutMs);
+  ASSERT_EQ(0, first->GetError());
+  SocketAddress first_resolved;
+  SocketAddress second_resolved;
+  EXPECT_TRUE(first->GetResolvedAddress(AF_INET, &first_resolved));
+  EXPECT_TRUE(second->GetResolvedAddress(AF_INET, &second_resolved));
+  EXPECT_EQ(first_resolved, second_resolved);
+  EXPECT_EQ(kHostnameAddr.port(), first_resolved.port());
+  first->Destroy(false);
+  second->Destroy(false);
+
+  // The result is now cached.
+  AsyncResolverInterface* third = Start(kHostnameAddr);
+  EXPECT_EQ(0u, cache_.num_pending_lookups());
+  EXPECT_EQ_WAIT(3, num_done_, kResolveTimeoutMs);
+  SocketAddress third_resolved;
+  EXPECT_TRUE(third->GetResolvedAddress(AF_INET, &third_resolved));
+  EXPECT_EQ(first_resolved, third_resolved);
+  third->Destroy(false);
+}
+
+TEST_F(AsyncResolverCacheTest, LookupOutlivesDestroyedResolvers) {
+  Start(kHostnameAddr)->Destroy(false);
+  EXPECT_EQ(1u, cache_.num_pending_lookups());
+  EXPECT_EQ_WAIT(0u, cache_.num_pending_lookups(), kResolveTimeoutMs);
+  EXPECT_EQ(0, num_done_);
+}
+
+class AsyncResolverCacheFactoryTest : public testing::Test,
+                                      public sigslot::has_slots<> {
+ public:
+  AsyncResolverCacheFactoryTest() : cache_(kTtlMs, &factory_) {}
+
+ protected:
+  AsyncResolverInterface* Start(const std::string& hostname) {
+    AsyncResolverInterface* resolver = cache_.CreateResolver();
+    resolver->SignalDone.connect(this, &AsyncResolverCacheFactoryTest::OnDone);
+    resolver->Start(SocketAddress(hostname, 5000));
+    return resolver;
+  }
+
+  void OnDone(AsyncResolverInterface* resolver) { ++num_done_; }
+
+  ScopedFakeClock clock_;
+  FakeResolverFactory factory_;
+  AsyncResolverCache cache_;
+  int num_done_ = 0;
+};
+
+TEST_F(AsyncResolverCacheFactoryTest, LooksUpWithFactoryAndExpiresEntries) {
+  AsyncResolverInterface* first = Start("first.example.com");
+  ASSERT_EQ(1u, factory_.resolvers().size());
+  factory_.resolvers()[0]->Finish();
+  EXPECT_EQ(1, num_done_);
+  SocketAddress resolved;
+  EXPECT_TRUE(first->GetResolvedAddress(AF_INET, &resolved));
+  EXPECT_EQ(IPAddress(0x01020304), resolved.ipaddr());
+  EXPECT_EQ(1u, cache_.num_entries());
+  first->Destroy(false);
+
+  // Once the first hostname has expired, it's removed when another lookup
+  // is done.
+  clock_.AdvanceTime(webrtc::TimeDelta::ms(kTtlMs));
+  AsyncResolverInterface* second = Start("second.example.com");
+  ASSERT_EQ(2u, factory_.resolvers().size());
+  factory_.resolvers()[1]->Finish();
+  EXPECT_EQ(2, num_done_);
+  EXPECT_EQ(1u, cache_.num_entries());
+  second->Destroy(false);
+
+  AsyncResolverInterface* third = Start("second.example.com");
+  Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(3, num_done_);
+  EXPECT_EQ(2u, factory_.resolvers().size());
+  EXPECT_EQ(0, factory_.num_alive());
+  third->Destroy(false);
+}
+
+}  // namespace rtc
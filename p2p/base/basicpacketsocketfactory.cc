@@ -12,6 +12,8 @@
 
 #include <string>
 
+#include "absl/memory/memory.h"
+#include "p2p/base/asyncresolvercache.h"
 #include "p2p/base/asyncstuntcpsocket.h"
 #include "p2p/base/stun.h"
 #include "rtc_base/asynctcpsocket.h"
@@ -23,6 +25,7 @@
 #include "rtc_base/socketadapters.h"
 #include "rtc_base/ssladapter.h"
 #include "rtc_base/thread.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace rtc {
 
@@ -53,7 +56,10 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateUdpSocket(
     delete socket;
     return NULL;
   }
-  return new AsyncUDPSocket(socket);
+  AsyncUDPSocket* udp_socket = new AsyncUDPSocket(socket);
+  if (udp_receive_pool_)
+    udp_socket->SetReceiveBufferPool(udp_receive_pool_, udp_max_packet_size_);
+  return udp_socket;
 }
 
 AsyncPacketSocket* BasicPacketSocketFactory::CreateServerTcpSocket(
@@ -164,6 +170,8 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateClientTcpSocket(
     ssl_adapter->SetAlpnProtocols(tcp_options.tls_alpn_protocols);
     ssl_adapter->SetEllipticCurves(tcp_options.tls_elliptic_curves);
     ssl_adapter->SetCertVerifier(tcp_options.tls_cert_verifier);
+    ssl_adapter->SetKernelTlsOffload(
+        webrtc::field_trial::IsEnabled("WebRTC-KernelTlsOffload"));
 
     socket = ssl_adapter;
 
@@ -199,9 +207,31 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateClientTcpSocket(
 }
 
 AsyncResolverInterface* BasicPacketSocketFactory::CreateAsyncResolver() {
+  if (resolver_cache_)
+    return resolver_cache_->CreateResolver();
+  if (resolver_factory_)
+    return resolver_factory_->Create();
   return new AsyncResolver();
 }
 
+void BasicPacketSocketFactory::EnableUdpReceiveBufferPool(
+    size_t max_packet_size) {
+  if (!udp_receive_pool_)
+    udp_receive_pool_ = CopyOnWriteBufferPool::Create();
+  udp_max_packet_size_ = max_packet_size;
+}
+
+void BasicPacketSocketFactory::EnableAsyncResolverCache(int ttl_ms) {
+  resolver_cache_ =
+      absl::make_unique<AsyncResolverCache>(ttl_ms, resolver_factory_);
+}
+
+void BasicPacketSocketFactory::SetAsyncResolverFactory(
+    webrtc::AsyncResolverFactory* factory) {
+  RTC_DCHECK(!resolver_cache_);
+  resolver_factory_ = factory;
+}
+
 int BasicPacketSocketFactory::BindSocket(AsyncSocket* socket,
                                          const SocketAddress& local_address,
                                          uint16_t min_port,
@@ -11,12 +11,17 @@
 #ifndef P2P_BASE_BASICPACKETSOCKETFACTORY_H_
 #define P2P_BASE_BASICPACKETSOCKETFACTORY_H_
 
+#include <memory>
 #include <string>
 
+#include "api/asyncresolverfactory.h"
 #include "p2p/base/packetsocketfactory.h"
+#include "rtc_base/copyonwritebufferpool.h"
+#include "rtc_base/scoped_ref_ptr.h"
 
 namespace rtc {
 
+class AsyncResolverCache;
 class AsyncSocket;
 class SocketFactory;
 class Thread;
@@ -49,6 +54,26 @@ class BasicPacketSocketFactory : public PacketSocketFactory {
 
   AsyncResolverInterface* CreateAsyncResolver() override;
 
+  // Makes UDP sockets created from now on read every datagram into a buffer
+  // from a pool owned by this factory, which the RTP transport can then keep
+  // without copying; see AsyncUDPSocket::SetReceiveBufferPool(). Datagrams
+  // longer than |max_packet_size| are dropped. All sockets must be read on the
+  // same thread.
+  void EnableUdpReceiveBufferPool(size_t max_packet_size);
+
+  // Makes resolvers created from now on share their results for |ttl_ms|, so
+  // that the STUN and TURN hostnames are looked up once for all of the ports
+  // made with this factory instead of once per port. The lookups are made
+  // with the factory set with SetAsyncResolverFactory(), if any. The
+  // resolvers must be used on the same thread, and destroyed before the
+  // factory.
+  void EnableAsyncResolverCache(int ttl_ms);
+
+  // Makes the resolvers for the ports, or the lookups of the cache, come from
+  // |factory|. Must be called before EnableAsyncResolverCache(). |factory|
+  // must outlive the resolvers.
+  void SetAsyncResolverFactory(webrtc::AsyncResolverFactory* factory);
+
  private:
   int BindSocket(AsyncSocket* socket,
                  const SocketAddress& local_address,
@@ -59,6 +84,10 @@ class BasicPacketSocketFactory : public PacketSocketFactory {
 
   Thread* thread_;
   SocketFactory* socket_factory_;
+  scoped_refptr<CopyOnWriteBufferPool> udp_receive_pool_;
+  size_t udp_max_packet_size_ = 0;
+  std::unique_ptr<AsyncResolverCache> resolver_cache_;
+  webrtc::AsyncResolverFactory* resolver_factory_ = nullptr;
 };
 
 }  // namespace rtc
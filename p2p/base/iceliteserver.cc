@@ -0,0 +1,484 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/iceliteserver.h"
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/p2pconstants.h"
+#include "p2p/base/port.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/crc32.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/messagedigest.h"
+#include "rtc_base/nethelper.h"
+#include "rtc_base/stringencode.h"
+#include "rtc_base/timeutils.h"
+
+namespace cricket {
+
+namespace {
+
+enum { MSG_CHECK_TIMEOUTS };
+
+// How often the receiving and consent state of all transports is checked.
+const int kTimeoutCheckIntervalMs = 500;
+
+}  // namespace
+
+IceLiteTransport::IceLiteTransport(IceLiteServer* server,
+                                   const std::string& transport_name,
+                                   int component)
+    : server_(server),
+      transport_name_(transport_name),
+      component_(component) {}
+
+IceLiteTransport::~IceLiteTransport() {
+  SignalDestroyed(this);
+  server_->RemoveTransport(this);
+}
+
+const std::string& IceLiteTransport::transport_name() const {
+  return transport_name_;
+}
+
+bool IceLiteTransport::writable() const {
+  return writable_;
+}
+
+bool IceLiteTransport::receiving() const {
+  return receiving_;
+}
+
+int IceLiteTransport::SendPacket(const char* data,
+                                 size_t len,
+                                 const rtc::PacketOptions& options,
+                                 int flags) {
+  if (!remote_address_ || !writable_) {
+    error_ = ENOTCONN;
+    return -1;
+  }
+  int sent = server_->SendTo(data, len, *remote_address_, options);
+  if (sent < 0) {
+    error_ = server_->socket_->GetError();
+    return sent;
+  }
+  rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis());
+  SignalSentPacket(this, sent_packet);
+  return sent;
+}
+
+int IceLiteTransport::SetOption(rtc::Socket::Option opt, int value) {
+  socket_options_[opt] = value;
+  return 0;
+}
+
+bool IceLiteTransport::GetOption(rtc::Socket::Option opt, int* value) {
+  auto it = socket_options_.find(opt);
+  if (it == socket_options_.end())
+    return false;
+  *value = it->second;
+  return true;
+}
+
+int IceLiteTransport::GetError() {
+  return error_;
+}
+
+IceTransportState IceLiteTransport::GetState() const {
+  if (writable_)
+    return IceTransportState::STATE_COMPLETED;
+  // Consent to send to the nominated address has expired.
+  if (remote_address_)
+    return IceTransportState::STATE_FAILED;
+  return IceTransportState::STATE_INIT;
+}
+
+int IceLiteTransport::component() const {
+  return component_;
+}
+
+IceRole IceLiteTransport::GetIceRole() const {
+  return ICEROLE_CONTROLLED;
+}
+
+void IceLiteTransport::SetIceRole(IceRole role) {
+  // A lite agent is always controlled by the full agent on the other side.
+  if (role != ICEROLE_CONTROLLED) {
+    RTC_LOG(LS_WARNING) << "Ignoring ICE role " << role
+                        << " for ICE-lite transport " << transport_name_;
+  }
+}
+
+void IceLiteTransport::SetIceTiebreaker(uint64_t tiebreaker) {}
+
+void IceLiteTransport::SetIceParameters(const IceParameters& ice_params) {
+  if (ice_params.pwd != ice_params_.pwd)
+    password_hmac_.reset();
+  ice_params_ = ice_params;
+  server_->SetUfrag(this, ice_params.ufrag);
+}
+
+void IceLiteTransport::SetRemoteIceParameters(
+    const IceParameters& ice_params) {
+  remote_ice_params_ = ice_params;
+}
+
+void IceLiteTransport::SetRemoteIceMode(IceMode mode) {}
+
+void IceLiteTransport::SetIceConfig(const IceConfig& config) {}
+
+void IceLiteTransport::MaybeStartGathering() {
+  if (gathering_state_ != kIceGatheringNew)
+    return;
+  gathering_state_ = kIceGatheringGathering;
+  SignalGatheringState(this);
+  SignalCandidateGathered(this, LocalCandidate());
+  gathering_state_ = kIceGatheringComplete;
+  SignalGatheringState(this);
+}
+
+void IceLiteTransport::AddRemoteCandidate(const Candidate& candidate) {
+  // Remote candidates are learned from the checks of the remote agent.
+}
+
+void IceLiteTransport::RemoveRemoteCandidate(const Candidate& candidate) {}
+
+IceGatheringState IceLiteTransport::gathering_state() const {
+  return gathering_state_;
+}
+
+bool IceLiteTransport::GetStats(ConnectionInfos* candidate_pair_stats_list,
+                                CandidateStatsList* candidate_stats_list) {
+  candidate_pair_stats_list->clear();
+  candidate_stats_list->clear();
+  if (!remote_address_)
+    return true;
+  ConnectionInfo info;
+  info.best_connection = true;
+  info.writable = writable_;
+  info.receiving = receiving_;
+  info.timeout = !writable_;
+  info.nominated = true;
+  info.local_candidate = LocalCandidate();
+  info.remote_candidate.set_component(component_);
+  info.remote_candidate.set_protocol(UDP_PROTOCOL_NAME);
+  info.remote_candidate.set_address(*remote_address_);
+  info.remote_candidate.set_username(remote_ice_params_.ufrag);
+  info.key = this;
+  info.state = writable_ ? IceCandidatePairState::SUCCEEDED
+                         : IceCandidatePairState::FAILED;
+  candidate_pair_stats_list->push_back(std::move(info));
+  return true;
+}
+
+absl::optional<int> IceLiteTransport::GetRttEstimate() {
+  // A lite agent sends no checks, so it cannot measure the RTT.
+  return absl::nullopt;
+}
+
+Candidate IceLiteTransport::LocalCandidate() const {
+  Candidate candidate(component_, UDP_PROTOCOL_NAME, server_->address(), 0,
+                      ice_params_.ufrag, ice_params_.pwd, LOCAL_PORT_TYPE, 0,
+                      "");
+  candidate.set_priority(
+      candidate.GetPriority(ICE_TYPE_PREFERENCE_HOST, 0, 0));
+  candidate.set_foundation(rtc::ToString<uint32_t>(rtc::ComputeCrc32(
+      LOCAL_PORT_TYPE + server_->address().ipaddr().ToString() +
+      UDP_PROTOCOL_NAME)));
+  return candidate;
+}
+
+rtc::OpenSSLHmac* IceLiteTransport::password_hmac() {
+  if (!password_hmac_) {
+    password_hmac_ = absl::make_unique<rtc::OpenSSLHmac>(
+        rtc::DIGEST_SHA_1, ice_params_.pwd.data(), ice_params_.pwd.size());
+  }
+  return password_hmac_.get();
+}
+
+void IceLiteTransport::set_writable(bool writable) {
+  if (writable_ == writable)
+    return;
+  writable_ = writable;
+  if (writable_)
+    SignalReadyToSend(this);
+  SignalWritableState(this);
+  SignalStateChanged(this);
+}
+
+void IceLiteTransport::set_receiving(bool receiving) {
+  if (receiving_ == receiving)
+    return;
+  receiving_ = receiving;
+  SignalReceivingState(this);
+}
+
+IceLiteServer::IceLiteServer(rtc::Thread* thread,
+                             rtc::AsyncPacketSocket* socket)
+    : thread_(thread),
+      socket_(socket),
+      address_(socket->GetLocalAddress()) {
+  RTC_DCHECK(thread_->IsCurrent());
+  socket_->SignalReadPacket.connect(this, &IceLiteServer::OnReadPacket);
+}
+
+IceLiteServer::~IceLiteServer() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(transports_.empty());
+  thread_->Clear(this);
+}
+
+std::unique_ptr<IceLiteTransport> IceLiteServer::CreateTransport(
+    const std::string& transport_name,
+    int component) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  std::unique_ptr<IceLiteTransport> transport(
+      new IceLiteTransport(this, transport_name, component));
+  transports_.insert(transport.get());
+  return transport;
+}
+
+void IceLiteServer::OnMessage(rtc::Message* msg) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK_EQ(MSG_CHECK_TIMEOUTS, msg->message_id);
+  timeout_check_pending_ = false;
+  CheckTimeouts();
+}
+
+void IceLiteServer::RemoveTransport(IceLiteTransport* transport) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  transports_.erase(transport);
+  auto ufrag_it = transports_by_ufrag_.find(transport->ice_params_.ufrag);
+  if (ufrag_it != transports_by_ufrag_.end() &&
+      ufrag_it->second == transport) {
+    transports_by_ufrag_.erase(ufrag_it);
+  }
+  if (transport->remote_address_) {
+    auto addr_it = transports_by_address_.find(*transport->remote_address_);
+    if (addr_it != transports_by_address_.end() &&
+        addr_it->second == transport) {
+      transports_by_address_.erase(addr_it);
+    }
+  }
+}
+
+void IceLiteServer::SetUfrag(IceLiteTransport* transport,
+                             const std::string& ufrag) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  // The old ufrag stays registered until the new one is set, so that an ICE
+  // restart does not drop the checks that are already on their way.
+  auto it = transports_by_ufrag_.begin();
+  while (it != transports_by_ufrag_.end()) {
+    if (it->second == transport && it->first != ufrag)
+      it = transports_by_ufrag_.erase(it);
+    else
+      ++it;
+  }
+  auto result = transports_by_ufrag_.insert(std::make_pair(ufrag, transport));
+  if (!result.second && result.first->second != transport) {
+    RTC_LOG(LS_WARNING) << "ICE ufrag " << ufrag
+                        << " is already used by transport "
+                        << result.first->second->transport_name();
+  }
+}
+
+void IceLiteServer::SetRemoteAddress(IceLiteTransport* transport,
+                                     const rtc::SocketAddress& addr) {
+  if (transport->remote_address_) {
+    if (*transport->remote_address_ == addr)
+      return;
+    auto it = transports_by_address_.find(*transport->remote_address_);
+    if (it != transports_by_address_.end() && it->second == transport)
+      transports_by_address_.erase(it);
+  }
+  RTC_LOG(LS_INFO) << "ICE-lite transport " << transport->transport_name()
+                   << " nominated " << addr.ToSensitiveString();
+  transport->remote_address_ = addr;
+  transports_by_address_[addr] = transport;
+}
+
+int IceLiteServer::SendTo(const void* data,
+                          size_t size,
+                          const rtc::SocketAddress& addr,
+                          const rtc::PacketOptions& options) {
+  return socket_->SendTo(data, size, addr, options);
+}
+
+void IceLiteServer::OnReadPacket(rtc::AsyncPacketSocket* socket,
+                                 const char* data,
+                                 size_t size,
+                                 const rtc::SocketAddress& addr,
+                                 const rtc::PacketTime& packet_time) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK_EQ(socket_.get(), socket);
+  // All checks carry a FINGERPRINT, while DTLS and SRTP packets never
+  // validate as one.
+  if (StunMessage::ValidateFingerprint(data, size)) {
+    HandleStunPacket(data, size, addr);
+    return;
+  }
+  auto it = transports_by_address_.find(addr);
+  if (it == transports_by_address_.end()) {
+    RTC_LOG(LS_VERBOSE) << "Dropping a packet from unknown address "
+                        << addr.ToSensitiveString();
+    return;
+  }
+  IceLiteTransport* transport = it->second;
+  transport->last_received_ms_ = rtc::TimeMillis();
+  transport->set_receiving(true);
+  transport->SignalReadPacket(transport, data, size, packet_time, 0);
+}
+
+void IceLiteServer::HandleStunPacket(const char* data,
+                                     size_t size,
+                                     const rtc::SocketAddress& addr) {
+  IceMessage msg;
+  rtc::ByteBufferReader buf(data, size);
+  if (!msg.Read(&buf) || buf.Length() > 0)
+    return;
+  // A lite agent sends no requests, so it can ignore all responses and
+  // indications.
+  if (msg.type() != STUN_BINDING_REQUEST)
+    return;
+
+  const StunByteStringAttribute* username_attr =
+      msg.GetByteString(STUN_ATTR_USERNAME);
+  if (!username_attr || !msg.GetByteString(STUN_ATTR_MESSAGE_INTEGRITY)) {
+    SendBindingErrorResponse(&msg, addr, STUN_ERROR_BAD_REQUEST,
+                             STUN_ERROR_REASON_BAD_REQUEST);
+    return;
+  }
+  // The USERNAME of a check is "<local ufrag>:<remote ufrag>".
+  const std::string& username = username_attr->GetString();
+  size_t colon = username.find(':');
+  auto it = colon == std::string::npos
+                ? transports_by_ufrag_.end()
+                : transports_by_ufrag_.find(username.substr(0, colon));
+  if (it == transports_by_ufrag_.end()) {
+    RTC_LOG(LS_INFO) << "Received STUN request with unknown username "
+                     << username << " from " << addr.ToSensitiveString();
+    SendBindingErrorResponse(&msg, addr, STUN_ERROR_UNAUTHORIZED,
+                             STUN_ERROR_REASON_UNAUTHORIZED);
+    return;
+  }
+  IceLiteTransport* transport = it->second;
+  if (!msg.ValidateMessageIntegrity(data, size, transport->password_hmac())) {
+    RTC_LOG(LS_INFO) << "Received STUN request with bad M-I from "
+                     << addr.ToSensitiveString();
+    SendBindingErrorResponse(&msg, addr, STUN_ERROR_UNAUTHORIZED,
+                             STUN_ERROR_REASON_UNAUTHORIZED);
+    return;
+  }
+
+  SendBindingResponse(transport, &msg, addr);
+  // The controlling agent nominates the pair to use, which at the same
+  // time renews the consent to send to it.
+  int64_t now = rtc::TimeMillis();
+  if (msg.GetByteString(STUN_ATTR_USE_CANDIDATE))
+    SetRemoteAddress(transport, addr);
+  if (transport->remote_address_ && *transport->remote_address_ == addr) {
+    transport->last_check_ms_ = now;
+    transport->last_received_ms_ = now;
+    transport->set_receiving(true);
+    transport->set_writable(true);
+    ScheduleTimeoutCheck();
+  }
+}
+
+void IceLiteServer::SendBindingResponse(IceLiteTransport* transport,
+                                        const StunMessage* request,
+                                        const rtc::SocketAddress& addr) {
+  StunMessage response;
+  response.SetType(STUN_BINDING_RESPONSE);
+  response.SetTransactionID(request->transaction_id());
+  const StunUInt32Attribute* retransmit_attr =
+      request->GetUInt32(STUN_ATTR_RETRANSMIT_COUNT);
+  if (retransmit_attr) {
+    response.AddAttribute(absl::make_unique<StunUInt32Attribute>(
+        STUN_ATTR_RETRANSMIT_COUNT, retransmit_attr->value()));
+  }
+  response.AddAttribute(absl::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_MAPPED_ADDRESS, addr));
+  response.AddMessageIntegrity(transport->password_hmac());
+  response.AddFingerprint();
+
+  rtc::ByteBufferWriter buf;
+  response.Write(&buf);
+  rtc::PacketOptions options;
+  options.info_signaled_after_sent.packet_type =
+      rtc::PacketType::kIceConnectivityCheckResponse;
+  if (SendTo(buf.Data(), buf.Length(), addr, options) < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to send STUN ping response to "
+                      << addr.ToSensitiveString() << ", err="
+                      << socket_->GetError();
+  }
+}
+
+void IceLiteServer::SendBindingErrorResponse(const StunMessage* request,
+                                             const rtc::SocketAddress& addr,
+                                             int error_code,
+                                             const std::string& reason) {
+  StunMessage response;
+  response.SetType(STUN_BINDING_ERROR_RESPONSE);
+  response.SetTransactionID(request->transaction_id());
+  auto error_attr = StunAttribute::CreateErrorCode();
+  error_attr->SetCode(error_code);
+  error_attr->SetReason(reason);
+  response.AddAttribute(std::move(error_attr));
+  // Per RFC 5389, section 10.1.2, these errors get no MESSAGE-INTEGRITY,
+  // since the shared secret is not known.
+  RTC_DCHECK(error_code == STUN_ERROR_BAD_REQUEST ||
+             error_code == STUN_ERROR_UNAUTHORIZED);
+  response.AddFingerprint();
+
+  rtc::ByteBufferWriter buf;
+  response.Write(&buf);
+  rtc::PacketOptions options;
+  options.info_signaled_after_sent.packet_type =
+      rtc::PacketType::kIceConnectivityCheckResponse;
+  SendTo(buf.Data(), buf.Length(), addr, options);
+}
+
+void IceLiteServer::ScheduleTimeoutCheck() {
+  if (timeout_check_pending_)
+    return;
+  timeout_check_pending_ = true;
+  thread_->PostDelayed(RTC_FROM_HERE, kTimeoutCheckIntervalMs, this,
+                       MSG_CHECK_TIMEOUTS);
+}
+
+void IceLiteServer::CheckTimeouts() {
+  // One pass over all transports replaces the timers a full agent keeps for
+  // each of its connections. It stops once no transport is receiving or
+  // writable, and is restarted by the next check.
+  int64_t now = rtc::TimeMillis();
+  bool any_active = false;
+  for (IceLiteTransport* transport : transports_) {
+    if (transport->receiving_ &&
+        now - transport->last_received_ms_ >= RECEIVING_TIMEOUT) {
+      transport->set_receiving(false);
+    }
+    if (transport->writable_ &&
+        now - transport->last_check_ms_ >= DEAD_CONNECTION_RECEIVE_TIMEOUT) {
+      RTC_LOG(LS_INFO) << "Consent expired for ICE-lite transport "
+                       << transport->transport_name();
+      transport->set_writable(false);
+    }
+    any_active |= transport->receiving_ || transport->writable_;
+  }
+  if (any_active)
+    ScheduleTimeoutCheck();
+}
+
+}  // namespace cricket
@@ -0,0 +1,184 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_ICELITESERVER_H_
+#define P2P_BASE_ICELITESERVER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "absl/types/optional.h"
+#include "p2p/base/icetransportinternal.h"
+#include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/messagehandler.h"
+#include "rtc_base/opensslhmac.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_checker.h"
+
+namespace cricket {
+
+class IceLiteServer;
+class IceMessage;
+class StunMessage;
+
+// An ICE-lite (RFC 5245, section 2.7) transport created by IceLiteServer.
+// It never sends connectivity checks; it only answers the checks of the
+// full agent on the other side, which is always controlling, and sends to
+// the address the remote agent nominated. It has no connections and no
+// timers of its own: the server expires its state.
+class IceLiteTransport : public IceTransportInternal {
+ public:
+  ~IceLiteTransport() override;
+
+  // rtc::PacketTransportInternal implementation.
+  const std::string& transport_name() const override;
+  bool writable() const override;
+  bool receiving() const override;
+  int SendPacket(const char* data,
+                 size_t len,
+                 const rtc::PacketOptions& options,
+                 int flags) override;
+  // Options are recorded but not applied, since the socket is shared by all
+  // the transports of the server.
+  int SetOption(rtc::Socket::Option opt, int value) override;
+  bool GetOption(rtc::Socket::Option opt, int* value) override;
+  int GetError() override;
+
+  // IceTransportInternal implementation.
+  IceTransportState GetState() const override;
+  int component() const override;
+  IceRole GetIceRole() const override;
+  void SetIceRole(IceRole role) override;
+  void SetIceTiebreaker(uint64_t tiebreaker) override;
+  void SetIceParameters(const IceParameters& ice_params) override;
+  void SetRemoteIceParameters(const IceParameters& ice_params) override;
+  void SetRemoteIceMode(IceMode mode) override;
+  void SetIceConfig(const IceConfig& config) override;
+  void MaybeStartGathering() override;
+  void AddRemoteCandidate(const Candidate& candidate) override;
+  void RemoveRemoteCandidate(const Candidate& candidate) override;
+  IceGatheringState gathering_state() const override;
+  bool GetStats(ConnectionInfos* candidate_pair_stats_list,
+                CandidateStatsList* candidate_stats_list) override;
+  absl::optional<int> GetRttEstimate() override;
+
+  // The address nominated by the remote agent, if any.
+  const absl::optional<rtc::SocketAddress>& remote_address() const {
+    return remote_address_;
+  }
+
+ private:
+  friend class IceLiteServer;
+
+  IceLiteTransport(IceLiteServer* server,
+                   const std::string& transport_name,
+                   int component);
+
+  Candidate LocalCandidate() const;
+  rtc::OpenSSLHmac* password_hmac();
+  void set_writable(bool writable);
+  void set_receiving(bool receiving);
+
+  IceLiteServer* const server_;
+  const std::string transport_name_;
+  const int component_;
+  IceParameters ice_params_;
+  IceParameters remote_ice_params_;
+  IceGatheringState gathering_state_ = kIceGatheringNew;
+  absl::optional<rtc::SocketAddress> remote_address_;
+  // Keyed with the local password, which checks are authenticated with.
+  std::unique_ptr<rtc::OpenSSLHmac> password_hmac_;
+  bool writable_ = false;
+  bool receiving_ = false;
+  // Read by the server to expire the state above.
+  int64_t last_received_ms_ = 0;
+  int64_t last_check_ms_ = 0;
+  int error_ = 0;
+  std::map<rtc::Socket::Option, int> socket_options_;
+};
+
+// Answers ICE-lite connectivity checks for many transports on one socket,
+// so that a server can terminate a large number of sessions on a single
+// port. Checks are dispatched to transports by the local ufrag in their
+// USERNAME, and all other packets by their source address. The receiving
+// and consent state of all transports is expired by a single timer.
+class IceLiteServer : public sigslot::has_slots<>,
+                      public rtc::MessageHandler {
+ public:
+  // Takes ownership of |socket|, which must be a bound UDP socket.
+  IceLiteServer(rtc::Thread* thread, rtc::AsyncPacketSocket* socket);
+  ~IceLiteServer() override;
+
+  // Creates a transport answering checks on the shared socket. It must be
+  // destroyed before the server.
+  std::unique_ptr<IceLiteTransport> CreateTransport(
+      const std::string& transport_name,
+      int component);
+
+  const rtc::SocketAddress& address() const { return address_; }
+  size_t num_transports() const { return transports_.size(); }
+
+  // rtc::MessageHandler implementation.
+  void OnMessage(rtc::Message* msg) override;
+
+ private:
+  friend class IceLiteTransport;
+
+  typedef std::unordered_map<std::string, IceLiteTransport*> UfragMap;
+  typedef std::unordered_map<rtc::SocketAddress,
+                             IceLiteTransport*,
+                             rtc::SocketAddressHash>
+      AddressMap;
+
+  void RemoveTransport(IceLiteTransport* transport);
+  void SetUfrag(IceLiteTransport* transport, const std::string& ufrag);
+  void SetRemoteAddress(IceLiteTransport* transport,
+                        const rtc::SocketAddress& addr);
+  int SendTo(const void* data,
+             size_t size,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options);
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& addr,
+                    const rtc::PacketTime& packet_time);
+  void HandleStunPacket(const char* data,
+                        size_t size,
+                        const rtc::SocketAddress& addr);
+  void SendBindingResponse(IceLiteTransport* transport,
+                           const StunMessage* request,
+                           const rtc::SocketAddress& addr);
+  void SendBindingErrorResponse(const StunMessage* request,
+                                const rtc::SocketAddress& addr,
+                                int error_code,
+                                const std::string& reason);
+  void ScheduleTimeoutCheck();
+  void CheckTimeouts();
+
+  rtc::Thread* const thread_;
+  std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  const rtc::SocketAddress address_;
+  std::unordered_set<IceLiteTransport*> transports_;
+  UfragMap transports_by_ufrag_;
+  AddressMap transports_by_address_;
+  bool timeout_check_pending_ = false;
+  rtc::ThreadChecker thread_checker_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_ICELITESERVER_H_
@@ -0,0 +1,251 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/iceliteserver.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/fakeclock.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/testclient.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtualsocketserver.h"
+
+namespace cricket {
+
+namespace {
+
+const rtc::SocketAddress kServerAddr("11.11.11.11", 3478);
+const rtc::SocketAddress kClientAddr("22.22.22.22", 0);
+const char kLocalUfrag[] = "LITE";
+const char kLocalPwd[] = "lite-password-of-24-chars";
+const char kRemoteUfrag[] = "FULL";
+const char kRemotePwd[] = "full-password-of-24-chars";
+const char kTransactionId[] = "0123456789ab";
+
+}  // namespace
+
+class IceLiteServerTest : public testing::Test,
+                          public sigslot::has_slots<> {
+ public:
+  IceLiteServerTest()
+      : ss_(new rtc::VirtualSocketServer()),
+        main_(ss_.get()),
+        server_(rtc::Thread::Current(),
+                rtc::AsyncUDPSocket::Create(ss_.get(), kServerAddr)) {}
+
+ protected:
+  std::unique_ptr<IceLiteTransport> CreateTransport(const std::string& ufrag,
+                                                    const std::string& pwd) {
+    std::unique_ptr<IceLiteTransport> transport =
+        server_.CreateTransport("audio", ICE_CANDIDATE_COMPONENT_RTP);
+    transport->SetIceParameters(IceParameters(ufrag, pwd, false));
+    transport->SetRemoteIceParameters(
+        IceParameters(kRemoteUfrag, kRemotePwd, false));
+    transport->SignalReadPacket.connect(this,
+                                        &IceLiteServerTest::OnReadPacket);
+    transport->SignalCandidateGathered.connect(
+        this, &IceLiteServerTest::OnCandidateGathered);
+    return transport;
+  }
+
+  std::unique_ptr<rtc::TestClient> CreateClient(
+      rtc::FakeClock* fake_clock = nullptr) {
+    return absl::make_unique<rtc::TestClient>(
+        absl::WrapUnique(rtc::AsyncUDPSocket::Create(ss_.get(), kClientAddr)),
+        fake_clock);
+  }
+
+  // Sends a check as the controlling full agent would.
+  void SendCheck(rtc::TestClient* client,
+                 const std::string& ufrag,
+                 const std::string& pwd,
+                 bool use_candidate) {
+    IceMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID(kTransactionId);
+    request.AddAttribute(absl::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, ufrag + ":" + kRemoteUfrag));
+    request.AddAttribute(absl::make_unique<StunUInt64Attribute>(
+        STUN_ATTR_ICE_CONTROLLING, 0));
+    if (use_candidate) {
+      request.AddAttribute(
+          absl::make_unique<StunByteStringAttribute>(STUN_ATTR_USE_CANDIDATE));
+    }
+    request.AddMessageIntegrity(pwd);
+    request.AddFingerprint();
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    client->SendTo(buf.Data(), buf.Length(), kServerAddr);
+  }
+
+  // Returns the type of the response to the last check, or 0 if there was
+  // none.
+  int ReadResponse(rtc::TestClient* client, const std::string& pwd) {
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client->NextPacket(rtc::TestClient::kTimeoutMs);
+    if (!packet)
+      return 0;
+    rtc::ByteBufferReader reader(packet->buf, packet->size);
+    IceMessage response;
+    EXPECT_TRUE(response.Read(&reader));
+    EXPECT_EQ(kTransactionId, response.transaction_id());
+    if (response.type() == STUN_BINDING_RESPONSE) {
+      EXPECT_TRUE(response.ValidateMessageIntegrity(packet->buf, packet->size,
+                                                    pwd));
+      const StunAddressAttribute* mapped_address =
+          response.GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+      EXPECT_TRUE(mapped_address);
+      if (mapped_address)
+        EXPECT_EQ(client->address(), mapped_address->GetAddress());
+    }
+    return response.type();
+  }
+
+  void OnReadPacket(rtc::PacketTransportInternal* transport,
+                    const char* data,
+                    size_t size,
+                    const rtc::PacketTime& packet_time,
+                    int flags) {
+    last_packet_ = std::string(data, size);
+    last_transport_ = transport;
+  }
+
+  void OnCandidateGathered(IceTransportInternal* transport,
+                           const Candidate& candidate) {
+    gathered_.push_back(candidate);
+  }
+
+  std::unique_ptr<rtc::VirtualSocketServer> ss_;
+  rtc::AutoSocketServerThread main_;
+  IceLiteServer server_;
+  std::string last_packet_;
+  rtc::PacketTransportInternal* last_transport_ = nullptr;
+  std::vector<Candidate> gathered_;
+};
+
+TEST_F(IceLiteServerTest, GathersOneHostCandidate) {
+  std::unique_ptr<IceLiteTransport> transport =
+      CreateTransport(kLocalUfrag, kLocalPwd);
+  transport->MaybeStartGathering();
+  EXPECT_EQ(kIceGatheringComplete, transport->gathering_state());
+  ASSERT_EQ(1u, gathered_.size());
+  EXPECT_EQ(kServerAddr, gathered_[0].address());
+  EXPECT_EQ(kLocalUfrag, gathered_[0].username());
+  EXPECT_EQ(ICEROLE_CONTROLLED, transport->GetIceRole());
+}
+
+TEST_F(IceLiteServerTest, AnswersChecksAndBecomesWritable) {
+  std::unique_ptr<IceLiteTransport> transport =
+      CreateTransport(kLocalUfrag, kLocalPwd);
+  std::unique_ptr<rtc::TestClient> client = CreateClient();
+
+  // A check without USE-CANDIDATE is answered, but selects nothing.
+  SendCheck(client.get(), kLocalUfrag, kLocalPwd, false);
+  EXPECT_EQ(STUN_BINDING_RESPONSE, ReadResponse(client.get(), kLocalPwd));
+  EXPECT_FALSE(transport->writable());
+  EXPECT_EQ(-1, transport->SendPacket("x", 1, rtc::PacketOptions(), 0));
+
+  SendCheck(client.get(), kLocalUfrag, kLocalPwd, true);
+  EXPECT_EQ(STUN_BINDING_RESPONSE, ReadResponse(client.get(), kLocalPwd));
+  EXPECT_TRUE(transport->writable());
+  EXPECT_TRUE(transport->receiving());
+  EXPECT_EQ(IceTransportState::STATE_COMPLETED, transport->GetState());
+  ASSERT_TRUE(transport->remote_address());
+  EXPECT_EQ(client->address(), *transport->remote_address());
+
+  // Application data flows both ways on the nominated address.
+  const std::string kData = "not a stun packet";
+  EXPECT_EQ(static_cast<int>(kData.size()),
+            transport->SendPacket(kData.data(), kData.size(),
+                                  rtc::PacketOptions(), 0));
+  EXPECT_TRUE(client->CheckNextPacket(kData.data(), kData.size(), nullptr));
+  client->SendTo(kData.data(), kData.size(), kServerAddr);
+  EXPECT_EQ_WAIT(kData, last_packet_, rtc::TestClient::kTimeoutMs);
+  EXPECT_EQ(transport.get(), last_transport_);
+}
+
+TEST_F(IceLiteServerTest, DemultiplexesTransportsByUfrag) {
+  std::unique_ptr<IceLiteTransport> first =
+      CreateTransport("UFRAG1", kLocalPwd);
+  std::unique_ptr<IceLiteTransport> second =
+      CreateTransport("UFRAG2", kRemotePwd);
+  EXPECT_EQ(2u, server_.num_transports());
+  std::unique_ptr<rtc::TestClient> first_client = CreateClient();
+  std::unique_ptr<rtc::TestClient> second_client = CreateClient();
+
+  SendCheck(second_client.get(), "UFRAG2", kRemotePwd, true);
+  EXPECT_EQ(STUN_BINDING_RESPONSE,
+            ReadResponse(second_client.get(), kRemotePwd));
+  EXPECT_FALSE(first->writable());
+  EXPECT_TRUE(second->writable());
+
+  SendCheck(first_client.get(), "UFRAG1", kLocalPwd, true);
+  EXPECT_EQ(STUN_BINDING_RESPONSE,
+            ReadResponse(first_client.get(), kLocalPwd));
+  EXPECT_TRUE(first->writable());
+
+  const std::string kData = "data";
+  second_client->SendTo(kData.data(), kData.size(), kServerAddr);
+  EXPECT_EQ_WAIT(second.get(), last_transport_, rtc::TestClient::kTimeoutMs);
+
+  second.reset();
+  EXPECT_EQ(1u, server_.num_transports());
+  SendCheck(second_client.get(), "UFRAG2", kRemotePwd, true);
+  EXPECT_EQ(STUN_BINDING_ERROR_RESPONSE,
+            ReadResponse(second_client.get(), kRemotePwd));
+}
+
+TEST_F(IceLiteServerTest, RejectsBadChecks) {
+  std::unique_ptr<IceLiteTransport> transport =
+      CreateTransport(kLocalUfrag, kLocalPwd);
+  std::unique_ptr<rtc::TestClient> client = CreateClient();
+
+  SendCheck(client.get(), "UNKNOWN", kLocalPwd, true);
+  EXPECT_EQ(STUN_BINDING_ERROR_RESPONSE, ReadResponse(client.get(), ""));
+  SendCheck(client.get(), kLocalUfrag, kRemotePwd, true);
+  EXPECT_EQ(STUN_BINDING_ERROR_RESPONSE, ReadResponse(client.get(), ""));
+  EXPECT_FALSE(transport->writable());
+
+  // Packets from addresses that were never nominated are dropped.
+  client->SendTo("data", 4, kServerAddr);
+  ss_->ProcessMessagesUntilIdle();
+  EXPECT_EQ(nullptr, last_transport_);
+}
+
+TEST_F(IceLiteServerTest, ExpiresReceivingAndConsent) {
+  rtc::ScopedFakeClock clock;
+  std::unique_ptr<IceLiteTransport> transport =
+      CreateTransport(kLocalUfrag, kLocalPwd);
+  std::unique_ptr<rtc::TestClient> client = CreateClient(&clock);
+  SendCheck(client.get(), kLocalUfrag, kLocalPwd, true);
+  EXPECT_EQ(STUN_BINDING_RESPONSE, ReadResponse(client.get(), kLocalPwd));
+  ASSERT_TRUE(transport->writable());
+
+  EXPECT_TRUE_SIMULATED_WAIT(!transport->receiving(), RECEIVING_TIMEOUT + 1000,
+                             clock);
+  EXPECT_TRUE(transport->writable());
+  EXPECT_TRUE_SIMULATED_WAIT(!transport->writable(),
+                             DEAD_CONNECTION_RECEIVE_TIMEOUT + 1000, clock);
+  EXPECT_EQ(IceTransportState::STATE_FAILED, transport->GetState());
+
+  // A new check renews the consent.
+  SendCheck(client.get(), kLocalUfrag, kLocalPwd, false);
+  EXPECT_EQ(STUN_BINDING_RESPONSE, ReadResponse(client.get(), kLocalPwd));
+  EXPECT_TRUE(transport->writable());
+}
+
+}  // namespace cricket
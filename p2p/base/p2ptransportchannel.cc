@@ -1538,16 +1538,7 @@ void P2PTransportChannel::SortConnectionsAndUpdateState(
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  std::stable_sort(connections_.begin(), connections_.end(),
-                   [this](const Connection* a, const Connection* b) {
-                     int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
-                     if (cmp != 0) {
-                       return cmp > 0;
-                     }
-                     // Otherwise, sort based on latency estimate.
-                     return a->rtt() < b->rtt();
-                   });
+  SortConnections();
 
   RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                       << " available connections";
@@ -1600,6 +1591,38 @@ void P2PTransportChannel::SortConnectionsAndUpdateState(
   MaybeStartPinging();
 }
 
+void P2PTransportChannel::SortConnections() {
+  auto less = [this](const Connection* a, const Connection* b) {
+    int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
+    if (cmp != 0) {
+      return cmp > 0;
+    }
+    // Otherwise, sort based on latency estimate.
+    return a->rtt() < b->rtt();
+  };
+  // Between two sorts, only the connections whose state changed and the ones
+  // added at the end are out of place, so an insertion sort finishes in close
+  // to linear time. It is stable like std::stable_sort, which takes over if
+  // many connections moved, e.g. after a burst of remote candidates.
+  size_t moves_left = connections_.size();
+  for (size_t i = 1; i < connections_.size(); ++i) {
+    Connection* conn = connections_[i];
+    size_t j = i;
+    for (; j > 0 && less(conn, connections_[j - 1]); --j) {
+      if (moves_left == 0) {
+        break;
+      }
+      connections_[j] = connections_[j - 1];
+      --moves_left;
+    }
+    connections_[j] = conn;
+    if (moves_left == 0) {
+      std::stable_sort(connections_.begin(), connections_.end(), less);
+      return;
+    }
+  }
+}
+
 std::map<rtc::Network*, Connection*>
 P2PTransportChannel::GetBestConnectionByNetwork() const {
   // |connections_| has been sorted, so the first one in the list on a given
@@ -1979,10 +2002,17 @@ Connection* P2PTransportChannel::FindNextPingableConnection() {
     }
   }
 
+  // The remaining rules only consider pingable connections, so find them in
+  // one pass, in the order of |connections_|.
+  std::vector<Connection*> pingable_connections;
+  std::copy_if(connections_.begin(), connections_.end(),
+               std::back_inserter(pingable_connections),
+               [this, now](Connection* conn) { return IsPingable(conn, now); });
+
   // Rule 3: Triggered checks have priority over non-triggered connections.
   // Rule 3.1: Among triggered checks, oldest takes precedence.
   Connection* oldest_triggered_check =
-      FindOldestConnectionNeedingTriggeredCheck(now);
+      FindOldestConnectionNeedingTriggeredCheck(pingable_connections);
   if (oldest_triggered_check) {
     return oldest_triggered_check;
   }
@@ -1992,33 +2022,33 @@ Connection* P2PTransportChannel::FindNextPingableConnection() {
             pinged_connections_.size() + unpinged_connections_.size());
   // If there are unpinged and pingable connections, only ping those.
   // Otherwise, treat everything as unpinged.
-  // TODO(honghaiz): Instead of adding two separate vectors, we can add a state
-  // "pinged" to filter out unpinged connections.
-  if (std::find_if(unpinged_connections_.begin(), unpinged_connections_.end(),
-                   [this, now](Connection* conn) {
-                     return this->IsPingable(conn, now);
-                   }) == unpinged_connections_.end()) {
+  std::vector<Connection*> unpinged_pingable_connections;
+  std::copy_if(pingable_connections.begin(), pingable_connections.end(),
+               std::back_inserter(unpinged_pingable_connections),
+               [this](Connection* conn) {
+                 return unpinged_connections_.count(conn) > 0;
+               });
+  if (unpinged_pingable_connections.empty()) {
     unpinged_connections_.insert(pinged_connections_.begin(),
                                  pinged_connections_.end());
     pinged_connections_.clear();
+    unpinged_pingable_connections.swap(pingable_connections);
   }
 
   // Among un-pinged pingable connections, "more pingable" takes precedence.
-  std::vector<Connection*> pingable_connections;
-  std::copy_if(unpinged_connections_.begin(), unpinged_connections_.end(),
-               std::back_inserter(pingable_connections),
-               [this, now](Connection* conn) { return IsPingable(conn, now); });
-  auto iter =
-      std::max_element(pingable_connections.begin(), pingable_connections.end(),
-                       [this](Connection* conn1, Connection* conn2) {
-                         // Some implementations of max_element compare an
-                         // element with itself.
-                         if (conn1 == conn2) {
-                           return false;
-                         }
-                         return MorePingable(conn1, conn2) == conn2;
-                       });
-  if (iter != pingable_connections.end()) {
+  // Of equally pingable ones, max_element keeps the first, which is the one
+  // that comes first in |connections_|.
+  auto iter = std::max_element(
+      unpinged_pingable_connections.begin(),
+      unpinged_pingable_connections.end(),
+      [this](Connection* conn1, Connection* conn2) {
+        // Some implementations of max_element compare an element with itself.
+        if (conn1 == conn2) {
+          return false;
+        }
+        return MorePingable(conn1, conn2) == conn2;
+      });
+  if (iter != unpinged_pingable_connections.end()) {
     return *iter;
   }
   return nullptr;
@@ -2252,12 +2282,9 @@ void P2PTransportChannel::OnReadyToSend(Connection* connection) {
 // (last_ping_received > last_ping_sent).  But we shouldn't do
 // triggered checks if the connection is already writable.
 Connection* P2PTransportChannel::FindOldestConnectionNeedingTriggeredCheck(
-    int64_t now) {
+    const std::vector<Connection*>& pingable_connections) {
   Connection* oldest_needing_triggered_check = nullptr;
-  for (auto* conn : connections_) {
-    if (!IsPingable(conn, now)) {
-      continue;
-    }
+  for (auto* conn : pingable_connections) {
     bool needs_triggered_check =
         (!conn->writable() &&
          conn->last_ping_received() > conn->last_ping_sent());
@@ -2317,17 +2344,9 @@ Connection* P2PTransportChannel::MorePingable(Connection* conn1,
     }
   }
 
-  Connection* least_recently_pinged_conn = LeastRecentlyPinged(conn1, conn2);
-  if (least_recently_pinged_conn) {
-    return least_recently_pinged_conn;
-  }
-
-  // During the initial state when nothing has been pinged yet, return the first
-  // one in the ordered |connections_|.
-  return *(std::find_if(connections_.begin(), connections_.end(),
-                        [conn1, conn2](Connection* conn) {
-                          return conn == conn1 || conn == conn2;
-                        }));
+  // During the initial state when nothing has been pinged yet, neither is
+  // more pingable.
+  return LeastRecentlyPinged(conn1, conn2);
 }
 
 void P2PTransportChannel::set_writable(bool writable) {
@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_set>
 #include <string>
 #include <vector>
 
@@ -237,6 +238,8 @@ class P2PTransportChannel : public IceTransportInternal {
   bool PresumedWritable(const cricket::Connection* conn) const;
 
   void SortConnectionsAndUpdateState(const std::string& reason_to_sort);
+  // Sorts |connections_| from the best to the worst.
+  void SortConnections();
   void SwitchSelectedConnection(Connection* conn);
   void UpdateState();
   void HandleAllTimedOut();
@@ -324,9 +327,11 @@ class P2PTransportChannel : public IceTransportInternal {
   void PruneConnections();
   bool IsBackupConnection(const Connection* conn) const;
 
-  Connection* FindOldestConnectionNeedingTriggeredCheck(int64_t now);
+  Connection* FindOldestConnectionNeedingTriggeredCheck(
+      const std::vector<Connection*>& pingable_connections);
   // Between |conn1| and |conn2|, this function returns the one which should
-  // be pinged first.
+  // be pinged first, or nullptr if neither should; callers then pick the one
+  // that comes first in |connections_|.
   Connection* MorePingable(Connection* conn1, Connection* conn2);
   // Select the connection which is Relay/Relay. If both of them are,
   // UDP relay protocol takes precedence.
@@ -386,8 +391,8 @@ class P2PTransportChannel : public IceTransportInternal {
   // connections as |connections_|. These 2 sets maintain whether a
   // connection should be pinged next or not.
   std::vector<Connection*> connections_;
-  std::set<Connection*> pinged_connections_;
-  std::set<Connection*> unpinged_connections_;
+  std::unordered_set<Connection*> pinged_connections_;
+  std::unordered_set<Connection*> unpinged_connections_;
 
   Connection* selected_connection_ = nullptr;
 
@@ -3286,6 +3286,33 @@ TEST_F(P2PTransportChannelPingTest, TestTriggeredChecks) {
   EXPECT_EQ(conn1, FindNextPingableConnectionAndPingIt(&ch));
 }
 
+// Every new remote candidate here outranks the previous ones, so sorting
+// has to move each new connection across all the others.
+TEST_F(P2PTransportChannelPingTest, TestManyConnectionsPingedInOrder) {
+  const int kNumCandidates = 20;
+  FakePortAllocator pa(rtc::Thread::Current(), nullptr);
+  P2PTransportChannel ch("many connections", 1, &pa);
+  PrepareChannel(&ch);
+  ch.MaybeStartGathering();
+  std::vector<Connection*> connections;
+  for (int i = 0; i < kNumCandidates; ++i) {
+    std::string ip = "1.1.1." + std::to_string(i + 1);
+    ch.AddRemoteCandidate(
+        CreateUdpCandidate(LOCAL_PORT_TYPE, ip, i + 1, i + 1));
+    connections.push_back(WaitForConnectionTo(&ch, ip, i + 1));
+    ASSERT_TRUE(connections.back() != nullptr);
+  }
+
+  // Unpinged connections are pinged from the highest priority down.
+  for (int i = kNumCandidates - 1; i >= 0; --i) {
+    EXPECT_EQ(connections[i], FindNextPingableConnectionAndPingIt(&ch));
+  }
+
+  // A writable connection is sorted ahead of all the unwritable ones.
+  connections[0]->ReceivedPingResponse(LOW_RTT, "id");
+  EXPECT_EQ_WAIT(connections[0], ch.selected_connection(), kDefaultTimeout);
+}
+
 TEST_F(P2PTransportChannelPingTest, TestAllConnectionsPingedSufficiently) {
   FakePortAllocator pa(rtc::Thread::Current(), nullptr);
   P2PTransportChannel ch("ping sufficiently", 1, &pa);
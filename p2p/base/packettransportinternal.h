@@ -20,6 +20,7 @@
 #include "p2p/base/port.h"
 #include "rtc_base/asyncpacketsocket.h"
 #include "rtc_base/networkroute.h"
+#include "rtc_base/packetsignal.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
@@ -82,15 +83,15 @@ class PacketTransportInternal : public virtual webrtc::PacketTransportInterface,
   sigslot::signal1<PacketTransportInternal*> SignalReceivingState;
 
   // Signalled each time a packet is received on this channel.
-  sigslot::signal5<PacketTransportInternal*,
-                   const char*,
-                   size_t,
-                   const rtc::PacketTime&,
-                   int>
+  rtc::PacketSignal<PacketTransportInternal*,
+                    const char*,
+                    size_t,
+                    const rtc::PacketTime&,
+                    int>
       SignalReadPacket;
 
   // Signalled each time a packet is sent on this channel.
-  sigslot::signal2<PacketTransportInternal*, const rtc::SentPacket&>
+  rtc::PacketSignal<PacketTransportInternal*, const rtc::SentPacket&>
       SignalSentPacket;
 
   // Signalled when the current network route has changed.
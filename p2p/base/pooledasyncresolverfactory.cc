@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/pooledasyncresolverfactory.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ipaddress.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/messagehandler.h"
+#include "rtc_base/nethelpers.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+// The resolver handed out by the factory. The factory completes it from a
+// thread of the pool, and the result is posted to the thread that started it.
+class PooledAsyncResolverFactory::PooledResolver
+    : public rtc::AsyncResolverInterface,
+      public rtc::MessageHandler {
+ public:
+  explicit PooledResolver(PooledAsyncResolverFactory* factory)
+      : factory_(factory) {}
+
+  void Start(const rtc::SocketAddress& addr) override {
+    addr_ = addr;
+    thread_ = rtc::Thread::Current();
+    RTC_DCHECK(thread_);
+    if (!addr.IsUnresolvedIP()) {
+      Complete(std::vector<rtc::IPAddress>(1, addr.ipaddr()), 0);
+      return;
+    }
+    factory_->Resolve(this, addr.hostname());
+  }
+
+  bool GetResolvedAddress(int family,
+                          rtc::SocketAddress* addr) const override {
+    if (error_ != 0 || addresses_.empty())
+      return false;
+    *addr = addr_;
+    for (const rtc::IPAddress& ip : addresses_) {
+      if (family == ip.family()) {
+        addr->SetResolvedIP(ip);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int GetError() const override { return error_; }
+
+  void Destroy(bool wait) override {
+    // No result is posted once the factory has forgotten the resolver, and
+    // the one already posted, if any, is cleared along with the handler.
+    factory_->Cancel(this);
+    delete this;
+  }
+
+  // May be called on any thread. Users expect SignalDone after Start() has
+  // returned, even when the result is already known.
+  void Complete(const std::vector<rtc::IPAddress>& addresses, int error) {
+    thread_->Post(RTC_FROM_HERE, this, 0,
+                  new rtc::TypedMessageData<Result>(Result{addresses, error}));
+  }
+
+ private:
+  struct Result {
+    std::vector<rtc::IPAddress> addresses;
+    int error;
+  };
+
+  void OnMessage(rtc::Message* msg) override {
+    std::unique_ptr<rtc::TypedMessageData<Result>> data(
+        static_cast<rtc::TypedMessageData<Result>*>(msg->pdata));
+    addresses_ = std::move(data->data().addresses);
+    error_ = data->data().error;
+    // May destroy |this|.
+    SignalDone(this);
+  }
+
+  PooledAsyncResolverFactory* const factory_;
+  rtc::Thread* thread_ = nullptr;
+  rtc::SocketAddress addr_;
+  std::vector<rtc::IPAddress> addresses_;
+  int error_ = -1;
+};
+
+PooledAsyncResolverFactory::PooledAsyncResolverFactory(int num_threads)
+    : num_lookups_(0),
+      stopping_(false),
+      wake_up_(false, false) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    const std::string name = "DnsResolver" + std::to_string(i);
+    threads_.push_back(absl::make_unique<rtc::PlatformThread>(
+        &PooledAsyncResolverFactory::RunWorker, this, name.c_str()));
+    threads_.back()->Start();
+  }
+}
+
+PooledAsyncResolverFactory::~PooledAsyncResolverFactory() {
+  {
+    rtc::CritScope lock(&crit_);
+    for (const auto& lookup : lookups_)
+      RTC_DCHECK(lookup.second.waiters.empty());
+    stopping_ = true;
+  }
+  // A thread in the middle of a lookup stops once it is done.
+  wake_up_.Set();
+  for (auto& thread : threads_)
+    thread->Stop();
+}
+
+rtc::AsyncResolverInterface* PooledAsyncResolverFactory::Create() {
+  return new PooledResolver(this);
+}
+
+int PooledAsyncResolverFactory::num_lookups() const {
+  rtc::CritScope lock(&crit_);
+  return num_lookups_;
+}
+
+void PooledAsyncResolverFactory::Resolve(PooledResolver* waiter,
+                                         const std::string& hostname) {
+  rtc::CritScope lock(&crit_);
+  auto inserted = lookups_.emplace(hostname, Lookup());
+  inserted.first->second.waiters.push_back(waiter);
+  if (inserted.second) {
+    queue_.push_back(hostname);
+    wake_up_.Set();
+  }
+}
+
+void PooledAsyncResolverFactory::Cancel(PooledResolver* waiter) {
+  rtc::CritScope lock(&crit_);
+  // A lookup outlives its waiters; the thread looking it up forgets it.
+  for (auto& lookup : lookups_) {
+    std::vector<PooledResolver*>& waiters = lookup.second.waiters;
+    waiters.erase(std::remove(waiters.begin(), waiters.end(), waiter),
+                  waiters.end());
+  }
+}
+
+// static
+void PooledAsyncResolverFactory::RunWorker(void* obj) {
+  static_cast<PooledAsyncResolverFactory*>(obj)->WorkerLoop();
+}
+
+void PooledAsyncResolverFactory::WorkerLoop() {
+  while (true) {
+    std::string hostname;
+    {
+      rtc::CritScope lock(&crit_);
+      if (stopping_) {
+        // Pass the wake up on to the other threads.
+        wake_up_.Set();
+        return;
+      }
+      if (!queue_.empty()) {
+        hostname = std::move(queue_.front());
+        queue_.pop_front();
+        ++num_lookups_;
+        // The event only wakes one thread.
+        if (!queue_.empty())
+          wake_up_.Set();
+      }
+    }
+    if (hostname.empty()) {
+      wake_up_.Wait(rtc::Event::kForever);
+      continue;
+    }
+
+    std::vector<rtc::IPAddress> addresses;
+    const int error = rtc::ResolveHostname(hostname, AF_UNSPEC, &addresses);
+    if (error != 0)
+      RTC_LOG(LS_WARNING) << "Failed to look up " << hostname << ": " << error;
+
+    rtc::CritScope lock(&crit_);
+    auto lookup_it = lookups_.find(hostname);
+    RTC_DCHECK(lookup_it != lookups_.end());
+    for (PooledResolver* waiter : lookup_it->second.waiters)
+      waiter->Complete(addresses, error);
+    lookups_.erase(lookup_it);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_POOLEDASYNCRESOLVERFACTORY_H_
+#define P2P_BASE_POOLEDASYNCRESOLVERFACTORY_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/asyncresolverfactory.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Creates resolvers that look up hostnames on a small pool of threads shared
+// by all of them, instead of on a new thread per lookup like
+// rtc::AsyncResolver. The |num_threads| threads of the pool are started with
+// the factory, and look up as many hostnames at the same time. Concurrent
+// lookups of the same hostname are made only once. Nothing is cached; put an
+// rtc::AsyncResolverCache in front of the factory for that.
+//
+// The factory must be destroyed on the thread it was created on, but may be
+// used from any thread. Each resolver signals its result on the thread that
+// started it, and must be destroyed before the factory.
+class PooledAsyncResolverFactory : public AsyncResolverFactory {
+ public:
+  explicit PooledAsyncResolverFactory(int num_threads);
+  ~PooledAsyncResolverFactory() override;
+
+  rtc::AsyncResolverInterface* Create() override;
+
+  // The number of hostnames looked up by the pool so far.
+  int num_lookups() const;
+
+ private:
+  class PooledResolver;
+  struct Lookup {
+    std::vector<PooledResolver*> waiters;
+  };
+
+  void Resolve(PooledResolver* waiter, const std::string& hostname);
+  void Cancel(PooledResolver* waiter);
+
+  static void RunWorker(void* obj);
+  void WorkerLoop();
+
+  rtc::CriticalSection crit_;
+  std::map<std::string, Lookup> lookups_ RTC_GUARDED_BY(crit_);
+  // Hostnames of |lookups_| that no thread has picked up yet.
+  std::deque<std::string> queue_ RTC_GUARDED_BY(crit_);
+  int num_lookups_ RTC_GUARDED_BY(crit_);
+  bool stopping_ RTC_GUARDED_BY(crit_);
+  // Set when |queue_| has work or the factory is stopping.
+  rtc::Event wake_up_;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PooledAsyncResolverFactory);
+};
+
+}  // namespace webrtc
+
+#endif  // P2P_BASE_POOLEDASYNCRESOLVERFACTORY_H_
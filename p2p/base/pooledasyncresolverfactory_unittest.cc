@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/pooledasyncresolverfactory.h"
+
+#include "rtc_base/gunit.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kNumThreads = 2;
+const int kResolveTimeoutMs = 10000;
+const rtc::SocketAddress kHostnameAddr("localhost", 5000);
+
+}  // namespace
+
+class PooledAsyncResolverFactoryTest : public testing::Test,
+                                       public sigslot::has_slots<> {
+ public:
+  PooledAsyncResolverFactoryTest() : factory_(kNumThreads) {}
+
+ protected:
+  rtc::AsyncResolverInterface* Start(const rtc::SocketAddress& addr) {
+    rtc::AsyncResolverInterface* resolver = factory_.Create();
+    resolver->SignalDone.connect(this,
+                                 &PooledAsyncResolverFactoryTest::OnDone);
+    resolver->Start(addr);
+    return resolver;
+  }
+
+  void OnDone(rtc::AsyncResolverInterface* resolver) { ++num_done_; }
+
+  PooledAsyncResolverFactory factory_;
+  int num_done_ = 0;
+};
+
+TEST_F(PooledAsyncResolverFactoryTest, ResolvesIpLiteralWithoutLookup) {
+  const rtc::SocketAddress addr("1.2.3.4", 5000);
+  rtc::AsyncResolverInterface* resolver = Start(addr);
+  // Done is signaled after Start() returns.
+  EXPECT_EQ(0, num_done_);
+  EXPECT_EQ_WAIT(1, num_done_, kResolveTimeoutMs);
+  EXPECT_EQ(0, factory_.num_lookups());
+  rtc::SocketAddress resolved;
+  EXPECT_TRUE(resolver->GetResolvedAddress(AF_INET, &resolved));
+  EXPECT_EQ(addr, resolved);
+  resolver->Destroy(false);
+}
+
+TEST_F(PooledAsyncResolverFactoryTest, LooksUpConcurrentHostnameOnce) {
+  rtc::AsyncResolverInterface* first = Start(kHostnameAddr);
+  rtc::AsyncResolverInterface* second = Start(kHostnameAddr);
+  ASSERT_EQ_WAIT(2, num_done_, kResolveTimeoutMs);
+  EXPECT_EQ(1, factory_.num_lookups());
+  ASSERT_EQ(0, first->GetError());
+  rtc::SocketAddress first_resolved;
+  rtc::SocketAddress second_resolved;
+  EXPECT_TRUE(first->GetResolvedAddress(AF_INET, &first_resolved));
+  EXPECT_TRUE(second->GetResolvedAddress(AF_INET, &second_resolved));
+  EXPECT_EQ(first_resolved, second_resolved);
+  EXPECT_EQ(kHostnameAddr.port(), first_resolved.port());
+  first->Destroy(false);
+  second->Destroy(false);
+
+  // Nothing is cached.
+  rtc::AsyncResolverInterface* third = Start(kHostnameAddr);
+  EXPECT_EQ_WAIT(3, num_done_, kResolveTimeoutMs);
+  EXPECT_EQ(2, factory_.num_lookups());
+  rtc::SocketAddress third_resolved;
+  EXPECT_TRUE(third->GetResolvedAddress(AF_INET, &third_resolved));
+  EXPECT_EQ(first_resolved, third_resolved);
+  third->Destroy(false);
+}
+
+TEST_F(PooledAsyncResolverFactoryTest, DestroyedResolverIsNotSignaled) {
+  Start(kHostnameAddr)->Destroy(false);
+  // Shares the lookup of the destroyed resolver, unless it's already done.
+  rtc::AsyncResolverInterface* resolver = Start(kHostnameAddr);
+  EXPECT_EQ_WAIT(1, num_done_, kResolveTimeoutMs);
+  resolver->Destroy(false);
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(1, num_done_);
+}
+
+}  // namespace webrtc
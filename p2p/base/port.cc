@@ -368,6 +368,7 @@ void Port::SetIceParameters(int component,
   component_ = component;
   ice_username_fragment_ = username_fragment;
   password_ = password;
+  password_hmac_.reset();
   for (Candidate& c : candidates_) {
     c.set_component(component);
     c.set_username(username_fragment);
@@ -567,7 +568,7 @@ bool Port::GetStunMessage(const char* data,
     }
 
     // If ICE, and the MESSAGE-INTEGRITY is bad, fail with a 401 Unauthorized
-    if (!stun_msg->ValidateMessageIntegrity(data, size, password_)) {
+    if (!stun_msg->ValidateMessageIntegrity(data, size, password_hmac())) {
       RTC_LOG(LS_ERROR) << ToString()
                         << ": Received STUN request with bad M-I from "
                         << addr.ToSensitiveString()
@@ -775,7 +776,7 @@ void Port::SendBindingResponse(StunMessage* request,
 
   response.AddAttribute(absl::make_unique<StunXorAddressAttribute>(
       STUN_ATTR_XOR_MAPPED_ADDRESS, addr));
-  response.AddMessageIntegrity(password_);
+  response.AddMessageIntegrity(password_hmac());
   response.AddFingerprint();
 
   // Send the response message.
@@ -828,7 +829,7 @@ void Port::SendBindingErrorResponse(StunMessage* request,
   // because we don't have enough information to determine the shared secret.
   if (error_code != STUN_ERROR_BAD_REQUEST &&
       error_code != STUN_ERROR_UNAUTHORIZED)
-    response.AddMessageIntegrity(password_);
+    response.AddMessageIntegrity(password_hmac());
   response.AddFingerprint();
 
   // Send the response message.
@@ -872,6 +873,14 @@ void Port::OnNetworkTypeChanged(const rtc::Network* network) {
   UpdateNetworkCost();
 }
 
+rtc::OpenSSLHmac* Port::password_hmac() {
+  if (!password_hmac_) {
+    password_hmac_ = absl::make_unique<rtc::OpenSSLHmac>(
+        rtc::DIGEST_SHA_1, password_.data(), password_.size());
+  }
+  return password_hmac_.get();
+}
+
 std::string Port::ToString() const {
   std::stringstream ss;
   ss << "Port[" << std::hex << this << std::dec << ":" << content_name_ << ":"
@@ -1008,7 +1017,7 @@ class ConnectionRequest : public StunRequest {
         STUN_ATTR_PRIORITY, prflx_priority));
 
     // Adding Message Integrity attribute.
-    request->AddMessageIntegrity(connection_->remote_candidate().password());
+    request->AddMessageIntegrity(connection_->remote_password_hmac());
     // Adding Fingerprint.
     request->AddFingerprint();
   }
@@ -1248,7 +1257,7 @@ void Connection::OnReadPacket(const char* data,
       case STUN_BINDING_RESPONSE:
       case STUN_BINDING_ERROR_RESPONSE:
         if (msg->ValidateMessageIntegrity(data, size,
-                                          remote_candidate().password())) {
+                                          remote_password_hmac())) {
           requests_.CheckResponse(msg.get());
         }
         // Otherwise silently discard the response message.
@@ -1629,6 +1638,16 @@ void Connection::LogCandidatePairEvent(webrtc::IceCandidatePairEventType type) {
   ice_event_log_->LogCandidatePairEvent(type, id());
 }
 
+rtc::OpenSSLHmac* Connection::remote_password_hmac() {
+  const std::string& password = remote_candidate_.password();
+  if (!remote_password_hmac_ || remote_password_hmac_key_ != password) {
+    remote_password_hmac_ = absl::make_unique<rtc::OpenSSLHmac>(
+        rtc::DIGEST_SHA_1, password.data(), password.size());
+    remote_password_hmac_key_ = password;
+  }
+  return remote_password_hmac_.get();
+}
+
 void Connection::OnConnectionRequestResponse(ConnectionRequest* request,
                                              StunMessage* response) {
   // Log at LS_INFO if we receive a ping response on an unwritable
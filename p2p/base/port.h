@@ -34,6 +34,8 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/nethelper.h"
 #include "rtc_base/network.h"
+#include "rtc_base/opensslhmac.h"
+#include "rtc_base/packetsignal.h"
 #include "rtc_base/proxyinfo.h"
 #include "rtc_base/ratetracker.h"
 #include "rtc_base/socketaddress.h"
@@ -450,6 +452,9 @@ class Port : public PortInterface,
 
   void OnNetworkTypeChanged(const rtc::Network* network);
 
+  // Returns the HMAC keyed with |password_|.
+  rtc::OpenSSLHmac* password_hmac();
+
   rtc::Thread* thread_;
   rtc::PacketSocketFactory* factory_;
   std::string type_;
@@ -470,6 +475,8 @@ class Port : public PortInterface,
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  // Keyed with |password_| on first use, to check and sign STUN messages.
+  std::unique_ptr<rtc::OpenSSLHmac> password_hmac_;
   std::vector<Candidate> candidates_;
   AddressMap connections_;
   int timeout_delay_;
@@ -576,7 +583,7 @@ class Connection : public CandidatePairInterface,
   // Error if Send() returns < 0
   virtual int GetError() = 0;
 
-  sigslot::signal4<Connection*, const char*, size_t, const rtc::PacketTime&>
+  rtc::PacketSignal<Connection*, const char*, size_t, const rtc::PacketTime&>
       SignalReadPacket;
 
   sigslot::signal1<Connection*> SignalReadyToSend;
@@ -764,6 +771,10 @@ class Connection : public CandidatePairInterface,
   void LogCandidatePairConfig(webrtc::IceCandidatePairConfigType type);
   void LogCandidatePairEvent(webrtc::IceCandidatePairEventType type);
 
+  // Returns the HMAC keyed with the password of |remote_candidate_|, which is
+  // rekeyed when the password changes.
+  rtc::OpenSSLHmac* remote_password_hmac();
+
   WriteState write_state_;
   bool receiving_;
   bool connected_;
@@ -818,6 +829,9 @@ class Connection : public CandidatePairInterface,
   absl::optional<webrtc::IceCandidatePairDescription> log_description_;
   webrtc::IceEventLog* ice_event_log_ = nullptr;
 
+  std::unique_ptr<rtc::OpenSSLHmac> remote_password_hmac_;
+  std::string remote_password_hmac_key_;
+
   friend class Port;
   friend class ConnectionRequest;
 };
@@ -18,6 +18,7 @@
 #include "api/candidate.h"
 #include "p2p/base/transportdescription.h"
 #include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/packetsignal.h"
 #include "rtc_base/socketaddress.h"
 
 namespace rtc {
@@ -125,12 +126,14 @@ class PortInterface {
   // through their respective connection and instead delivers every packet
   // through this port.
   virtual void EnablePortPackets() = 0;
-  sigslot::
-      signal4<PortInterface*, const char*, size_t, const rtc::SocketAddress&>
-          SignalReadPacket;
+  rtc::PacketSignal<PortInterface*,
+                    const char*,
+                    size_t,
+                    const rtc::SocketAddress&>
+      SignalReadPacket;
 
   // Emitted each time a packet is sent on this port.
-  sigslot::signal1<const rtc::SentPacket&> SignalSentPacket;
+  rtc::PacketSignal<const rtc::SentPacket&> SignalSentPacket;
 
   virtual std::string ToString() const = 0;
 
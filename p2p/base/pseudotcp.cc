@@ -115,6 +115,9 @@ const uint32_t DEF_ACK_DELAY = 100;  // 100 milliseconds
 
 const uint8_t FLAG_CTL = 0x02;
 const uint8_t FLAG_RST = 0x04;
+// Set on ACK packets whose payload is SACK blocks rather than data. Only sent
+// when both sides have specified the SACK option.
+const uint8_t FLAG_SACK = 0x08;
 
 const uint8_t CTL_CONNECT = 0;
 
@@ -123,6 +126,11 @@ const uint8_t TCP_OPT_EOL = 0;        // End of list.
 const uint8_t TCP_OPT_NOOP = 1;       // No-op.
 const uint8_t TCP_OPT_MSS = 2;        // Maximum segment size.
 const uint8_t TCP_OPT_WND_SCALE = 3;  // Window scale factor.
+const uint8_t TCP_OPT_SACK = 4;       // SACK permitted.
+
+// Maximum number of SACK blocks of an ACK packet, and the size of a block.
+const uint32_t MAX_SACK_BLOCKS = 4;
+const uint32_t SACK_BLOCK_SIZE = 8;
 
 const long DEFAULT_TIMEOUT =
     4000;  // If there are no pending clocks, wake up every 4 seconds
@@ -214,7 +222,8 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
       m_rbuf_len(DEFAULT_RCV_BUF_SIZE),
       m_rbuf(m_rbuf_len),
       m_sbuf_len(DEFAULT_SND_BUF_SIZE),
-      m_sbuf(m_sbuf_len) {
+      m_sbuf(m_sbuf_len),
+      m_packet(new uint8_t[MAX_PACKET]) {
   // Sanity check on buffer sizes (needed for OnTcpWriteable notification logic)
   RTC_DCHECK(m_rbuf_len + MIN_PACKET < m_sbuf_len);
 
@@ -247,6 +256,9 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_dup_acks = 0;
   m_recover = 0;
 
+  m_sack_enabled = false;
+  m_sack_high = m_rexmit_nxt = 0;
+
   m_ts_recent = m_ts_lastack = 0;
 
   m_rx_rto = DEF_RTO;
@@ -255,6 +267,7 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_use_nagling = true;
   m_ack_delay = DEF_ACK_DELAY;
   m_support_wnd_scale = true;
+  m_support_sack = true;
 }
 
 PseudoTcp::~PseudoTcp() {}
@@ -309,6 +322,13 @@ void PseudoTcp::NotifyClock(uint32_t now) {
       // nInFlight << "  m_mss: " << m_mss;
       m_cwnd = m_mss;
 
+      // The receiver may have discarded the data it selectively acknowledged,
+      // so forget about it after a timeout.
+      for (SSegment& sseg : m_slist) {
+        sseg.bSacked = false;
+      }
+      m_sack_high = m_snd_una;
+
       // Back off retransmit timer.  Note: the limit is lower when connecting.
       uint32_t rto_limit = (m_state < TCP_ESTABLISHED) ? DEF_RTO : MAX_RTO;
       m_rx_rto = std::min(rto_limit, m_rx_rto * 2);
@@ -517,27 +537,30 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 
   uint32_t now = Now();
 
-  std::unique_ptr<uint8_t[]> buffer(new uint8_t[MAX_PACKET]);
-  long_to_bytes(m_conv, buffer.get());
-  long_to_bytes(seq, buffer.get() + 4);
-  long_to_bytes(m_rcv_nxt, buffer.get() + 8);
+  uint8_t* buffer = m_packet.get();
+  long_to_bytes(m_conv, buffer);
+  long_to_bytes(seq, buffer + 4);
+  long_to_bytes(m_rcv_nxt, buffer + 8);
   buffer[12] = 0;
-  buffer[13] = flags;
-  short_to_bytes(static_cast<uint16_t>(m_rcv_wnd >> m_rwnd_scale),
-                 buffer.get() + 14);
+  short_to_bytes(static_cast<uint16_t>(m_rcv_wnd >> m_rwnd_scale), buffer + 14);
 
   // Timestamp computations
-  long_to_bytes(now, buffer.get() + 16);
-  long_to_bytes(m_ts_recent, buffer.get() + 20);
+  long_to_bytes(now, buffer + 16);
+  long_to_bytes(m_ts_recent, buffer + 20);
   m_ts_lastack = m_rcv_nxt;
 
+  uint32_t sack_len = 0;
   if (len) {
     size_t bytes_read = 0;
     rtc::StreamResult result =
-        m_sbuf.ReadOffset(buffer.get() + HEADER_SIZE, len, offset, &bytes_read);
+        m_sbuf.ReadOffset(buffer + HEADER_SIZE, len, offset, &bytes_read);
     RTC_DCHECK(result == rtc::SR_SUCCESS);
     RTC_DCHECK(static_cast<uint32_t>(bytes_read) == len);
+  } else if (m_sack_enabled && flags == 0 && !m_rlist.empty()) {
+    sack_len = writeSackBlocks(buffer + HEADER_SIZE);
+    flags |= FLAG_SACK;
   }
+  buffer[13] = flags;
 
 #if _DEBUGMSG >= _DBG_VERBOSE
   RTC_LOG(LS_INFO) << "<-- <CONV=" << m_conv
@@ -550,7 +573,7 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 #endif  // _DEBUGMSG
 
   IPseudoTcpNotify::WriteResult wres = m_notify->TcpWritePacket(
-      this, reinterpret_cast<char*>(buffer.get()), len + HEADER_SIZE);
+      this, reinterpret_cast<char*>(buffer), len + sack_len + HEADER_SIZE);
   // Note: When len is 0, this is an ACK packet.  We don't read the return value
   // for those, and thus we won't retry.  So go ahead and treat the packet as a
   // success (basically simulate as if it were dropped), which will prevent our
@@ -585,6 +608,13 @@ bool PseudoTcp::parse(const uint8_t* buffer, uint32_t size) {
   seg.data = reinterpret_cast<const char*>(buffer) + HEADER_SIZE;
   seg.len = size - HEADER_SIZE;
 
+  seg.sack_blocks = seg.data;
+  seg.num_sack_blocks = 0;
+  if (seg.flags & FLAG_SACK) {
+    seg.num_sack_blocks = std::min(seg.len / SACK_BLOCK_SIZE, MAX_SACK_BLOCKS);
+    seg.len = 0;
+  }
+
 #if _DEBUGMSG >= _DBG_VERBOSE
   RTC_LOG(LS_INFO) << "--> <CONV=" << seg.conv
                    << "><FLG=" << static_cast<unsigned>(seg.flags)
@@ -705,6 +735,10 @@ bool PseudoTcp::process(Segment& seg) {
     m_ts_recent = seg.tsval;
   }
 
+  if (seg.num_sack_blocks > 0) {
+    updateSackScoreboard(seg);
+  }
+
   // Check if this is a valuable ack
   if ((seg.ack > m_snd_una) && (seg.ack <= m_snd_nxt)) {
     // Calculate round-trip time
@@ -768,9 +802,18 @@ bool PseudoTcp::process(Segment& seg) {
 #if _DEBUGMSG >= _DBG_NORMAL
         RTC_LOG(LS_INFO) << "recovery retransmit";
 #endif  // _DEBUGMSG
-        if (!transmit(m_slist.begin(), now)) {
-          closedown(ECONNABORTED);
-          return false;
+        // With SACK, the first segment may already have been retransmitted
+        // in this recovery, in which case the next hole is repaired instead.
+        SList::iterator it = m_slist.begin();
+        if (m_sack_enabled && (it->seq < m_rexmit_nxt)) {
+          it = nextSackHole();
+        }
+        if (it != m_slist.end()) {
+          if (!transmit(it, now)) {
+            closedown(ECONNABORTED);
+            return false;
+          }
+          m_rexmit_nxt = std::max(m_rexmit_nxt, it->seq + it->len);
         }
         m_cwnd += m_mss - std::min(nAcked, m_cwnd);
       }
@@ -803,13 +846,29 @@ bool PseudoTcp::process(Segment& seg) {
           return false;
         }
         m_recover = m_snd_nxt;
+        m_rexmit_nxt = m_slist.front().seq + m_slist.front().len;
         uint32_t nInFlight = m_snd_nxt - m_snd_una;
         m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
         // RTC_LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: "
         // << nInFlight << "  m_mss: " << m_mss;
         m_cwnd = m_ssthresh + 3 * m_mss;
       } else if (m_dup_acks > 3) {
-        m_cwnd += m_mss;
+        // Each duplicate ack means a segment has left the network. With SACK
+        // the next lost segment takes its place, otherwise the window is
+        // inflated to send new data.
+        SList::iterator it = m_sack_enabled ? nextSackHole() : m_slist.end();
+        if (it != m_slist.end()) {
+#if _DEBUGMSG >= _DBG_NORMAL
+          RTC_LOG(LS_INFO) << "sack retransmit";
+#endif  // _DEBUGMSG
+          if (!transmit(it, now)) {
+            closedown(ECONNABORTED);
+            return false;
+          }
+          m_rexmit_nxt = it->seq + it->len;
+        } else {
+          m_cwnd += m_mss;
+        }
       }
     } else {
       m_dup_acks = 0;
@@ -1190,6 +1249,10 @@ void PseudoTcp::disableWindowScale() {
   m_support_wnd_scale = false;
 }
 
+void PseudoTcp::disableSack() {
+  m_support_sack = false;
+}
+
 void PseudoTcp::queueConnectMessage() {
   rtc::ByteBufferWriter buf(rtc::ByteBuffer::ORDER_NETWORK);
 
@@ -1199,6 +1262,10 @@ void PseudoTcp::queueConnectMessage() {
     buf.WriteUInt8(1);
     buf.WriteUInt8(m_rwnd_scale);
   }
+  if (m_support_sack) {
+    buf.WriteUInt8(TCP_OPT_SACK);
+    buf.WriteUInt8(0);
+  }
   m_snd_wnd = static_cast<uint32_t>(buf.Length());
   queue(buf.Data(), static_cast<uint32_t>(buf.Length()), true);
 }
@@ -1237,6 +1304,10 @@ void PseudoTcp::parseOptions(const char* data, uint32_t len) {
     options_specified.insert(kind);
   }
 
+  m_sack_enabled =
+      m_support_sack &&
+      (options_specified.find(TCP_OPT_SACK) != options_specified.end());
+
   if (options_specified.find(TCP_OPT_WND_SCALE) == options_specified.end()) {
     RTC_LOG(LS_WARNING) << "Peer doesn't support window scaling";
 
@@ -1268,6 +1339,57 @@ void PseudoTcp::applyWindowScaleOption(uint8_t scale_factor) {
   m_swnd_scale = scale_factor;
 }
 
+uint32_t PseudoTcp::writeSackBlocks(uint8_t* buf) const {
+  // |m_rlist| is sorted by sequence number, and its segments may overlap or
+  // be adjacent, so merge them into blocks.
+  uint32_t num_blocks = 0;
+  RList::const_iterator it = m_rlist.begin();
+  while ((it != m_rlist.end()) && (num_blocks < MAX_SACK_BLOCKS)) {
+    uint32_t begin = it->seq;
+    uint32_t end = it->seq + it->len;
+    for (++it; (it != m_rlist.end()) && (it->seq <= end); ++it) {
+      end = std::max(end, it->seq + it->len);
+    }
+    long_to_bytes(begin, buf + num_blocks * SACK_BLOCK_SIZE);
+    long_to_bytes(end - begin, buf + num_blocks * SACK_BLOCK_SIZE + 4);
+    ++num_blocks;
+  }
+  return num_blocks * SACK_BLOCK_SIZE;
+}
+
+void PseudoTcp::updateSackScoreboard(const Segment& seg) {
+  for (uint32_t i = 0; i < seg.num_sack_blocks; ++i) {
+    const char* block = seg.sack_blocks + i * SACK_BLOCK_SIZE;
+    uint32_t begin = bytes_to_long(block);
+    uint32_t end = begin + bytes_to_long(block + 4);
+    if ((begin < m_snd_una) || (end > m_snd_nxt)) {
+      continue;
+    }
+    for (SSegment& sseg : m_slist) {
+      if (sseg.seq >= end) {
+        break;
+      }
+      if ((sseg.xmit > 0) && (sseg.seq >= begin) &&
+          (sseg.seq + sseg.len <= end)) {
+        sseg.bSacked = true;
+      }
+    }
+    m_sack_high = std::max(m_sack_high, end);
+  }
+}
+
+PseudoTcp::SList::iterator PseudoTcp::nextSackHole() {
+  for (SList::iterator it = m_slist.begin(); it != m_slist.end(); ++it) {
+    if ((it->xmit == 0) || (it->seq + it->len > m_sack_high)) {
+      break;
+    }
+    if (!it->bSacked && (it->seq >= m_rexmit_nxt)) {
+      return it;
+    }
+  }
+  return m_slist.end();
+}
+
 void PseudoTcp::resizeSendBuffer(uint32_t new_size) {
   m_sbuf_len = new_size;
   m_sbuf.SetCapacity(new_size);
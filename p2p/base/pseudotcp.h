@@ -12,6 +12,7 @@
 #define P2P_BASE_PSEUDOTCP_H_
 
 #include <list>
+#include <memory>
 
 #include "rtc_base/stream.h"
 
@@ -121,15 +122,20 @@ class PseudoTcp {
     const char* data;
     uint32_t len;
     uint32_t tsval, tsecr;
+    // SACK blocks of an ACK packet, as pairs of sequence number and length.
+    const char* sack_blocks;
+    uint32_t num_sack_blocks;
   };
 
   struct SSegment {
     SSegment(uint32_t s, uint32_t l, bool c)
-        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c) {}
+        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c), bSacked(false) {}
     uint32_t seq, len;
     // uint32_t tstamp;
     uint8_t xmit;
     bool bCtrl;
+    // Whether the peer has selectively acknowledged this segment.
+    bool bSacked;
   };
   typedef std::list<SSegment> SList;
 
@@ -172,6 +178,10 @@ class PseudoTcp {
   // support for testing backward compatibility.
   void disableWindowScale();
 
+  // This method is only used in tests, to disable SACK support for testing
+  // backward compatibility.
+  void disableSack();
+
  private:
   // Queue the connect message with TCP options.
   void queueConnectMessage();
@@ -185,6 +195,18 @@ class PseudoTcp {
   // Apply window scale option.
   void applyWindowScaleOption(uint8_t scale_factor);
 
+  // Writes the SACK blocks describing the out-of-order data in |m_rlist| to
+  // |buf|, and returns the number of bytes written.
+  uint32_t writeSackBlocks(uint8_t* buf) const;
+
+  // Marks the segments covered by the SACK blocks of |seg| as sacked.
+  void updateSackScoreboard(const Segment& seg);
+
+  // Returns the first segment of the current recovery that has not been
+  // retransmitted yet and lies below the highest sacked sequence number, or
+  // the end of |m_slist| if there is none.
+  SList::iterator nextSackHole();
+
   // Resize the send buffer with |new_size| in bytes.
   void resizeSendBuffer(uint32_t new_size);
 
@@ -215,6 +237,9 @@ class PseudoTcp {
   uint8_t m_swnd_scale;  // Window scale factor.
   rtc::FifoBuffer m_sbuf;
 
+  // Packet being built by packet(), reused to avoid an allocation per packet.
+  std::unique_ptr<uint8_t[]> m_packet;
+
   // Maximum segment size, estimated protocol level, largest segment sent
   uint32_t m_mss, m_msslevel, m_largest, m_mtu_advise;
   // Retransmit timer
@@ -232,6 +257,12 @@ class PseudoTcp {
   uint32_t m_recover;
   uint32_t m_t_ack;
 
+  // Selective acknowledgments, http://www.ietf.org/rfc/rfc2018.txt. The end
+  // of the highest sacked segment, and the end of the last segment
+  // retransmitted in the current recovery.
+  bool m_sack_enabled;
+  uint32_t m_sack_high, m_rexmit_nxt;
+
   // Configuration options
   bool m_use_nagling;
   uint32_t m_ack_delay;
@@ -239,6 +270,10 @@ class PseudoTcp {
   // This is used by unit tests to test backward compatibility of
   // PseudoTcp implementations that don't support window scaling.
   bool m_support_wnd_scale;
+
+  // This is used by unit tests to test backward compatibility of
+  // PseudoTcp implementations that don't support SACK.
+  bool m_support_sack;
 };
 
 }  // namespace cricket
@@ -34,6 +34,8 @@ class PseudoTcpForTest : public cricket::PseudoTcp {
   bool isReceiveBufferFull() const { return PseudoTcp::isReceiveBufferFull(); }
 
   void disableWindowScale() { PseudoTcp::disableWindowScale(); }
+
+  void disableSack() { PseudoTcp::disableSack(); }
 };
 
 class PseudoTcpTestBase : public testing::Test,
@@ -94,6 +96,8 @@ class PseudoTcpTestBase : public testing::Test,
   }
   void DisableRemoteWindowScale() { remote_.disableWindowScale(); }
   void DisableLocalWindowScale() { local_.disableWindowScale(); }
+  void DisableRemoteSack() { remote_.disableSack(); }
+  void DisableLocalSack() { local_.disableSack(); }
 
  protected:
   int Connect() {
@@ -635,6 +639,40 @@ TEST_F(PseudoTcpTest, TestSendWithDelayAndLoss) {
   TestTransfer(100000);  // less data so test runs faster
 }
 
+// Test sending data with a 50 ms RTT and 10% packet loss when the receiver
+// doesn't support SACK, so that losses are repaired one per round trip.
+TEST_F(PseudoTcpTest, TestSendWithDelayAndLossRemoteNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  DisableRemoteSack();
+  TestTransfer(100000);  // less data so test runs faster
+}
+
+// Same as above, with a sender that doesn't support SACK.
+TEST_F(PseudoTcpTest, TestSendWithDelayAndLossLocalNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  DisableLocalSack();
+  TestTransfer(100000);  // less data so test runs faster
+}
+
+// Test sending data with large windows, a 50 ms RTT and 2% packet loss, so
+// that several segments of the same window may be lost.
+TEST_F(PseudoTcpTest, TestSendLargeWindowWithDelayAndLoss) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetRemoteOptRcvBuf(1000000);
+  SetLocalOptRcvBuf(1000000);
+  SetOptSndBuf(1500000);
+  SetDelay(50);
+  SetLoss(2);
+  TestTransfer(300000);  // less data so test runs faster
+}
+
 // Test sending data with 10% packet loss and Nagling disabled.  Transmission
 // should take about the same time as with Nagling enabled.
 TEST_F(PseudoTcpTest, TestSendWithLossAndOptNaglingOff) {
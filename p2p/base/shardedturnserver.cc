@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shardedturnserver.h"
+
+#include "absl/memory/memory.h"
+#include "p2p/base/basicpacketsocketfactory.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace cricket {
+
+namespace {
+
+const int kListenBacklog = 128;
+
+}  // namespace
+
+ShardedTurnServer::ShardedTurnServer(int num_shards)
+    : num_shards_(num_shards) {
+  RTC_DCHECK_GT(num_shards, 0);
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  for (Shard& shard : shards_) {
+    // Start() may have failed before creating the thread.
+    if (!shard.thread)
+      continue;
+    shard.thread->Invoke<void>(RTC_FROM_HERE, [&shard] {
+      shard.server.reset();
+    });
+    shard.thread->Stop();
+  }
+}
+
+bool ShardedTurnServer::Start(const rtc::SocketAddress& int_addr,
+                              ProtocolType proto,
+                              const rtc::SocketAddress& ext_addr,
+                              const ShardCallback& configure) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(shards_.empty());
+  RTC_DCHECK(proto == PROTO_UDP || proto == PROTO_TCP);
+  shards_.resize(num_shards_);
+  address_ = int_addr;
+  for (int i = 0; i < num_shards_; ++i) {
+    Shard* shard = &shards_[i];
+    shard->thread = rtc::Thread::CreateWithSocketServer();
+    shard->thread->SetName("TurnServerShard", shard);
+    shard->thread->Start();
+    // Binds the later shards to the port picked for the first one.
+    rtc::SocketAddress bind_addr = address_;
+    rtc::SocketAddress bound_addr;
+    bool started = shard->thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return StartShard(shard, bind_addr, proto, ext_addr, configure,
+                        &bound_addr);
+    });
+    if (!started) {
+      RTC_LOG(LS_ERROR) << "Failed to start TURN server shard " << i
+                        << " at " << bind_addr.ToString();
+      return false;
+    }
+    address_ = bound_addr;
+  }
+  RTC_LOG(LS_INFO) << "Started " << num_shards_ << " TURN server shards at "
+                   << address_.ToString();
+  return true;
+}
+
+void ShardedTurnServer::InvokeOnShard(int shard,
+                                      const ShardCallback& callback) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK_GE(shard, 0);
+  RTC_DCHECK_LT(shard, static_cast<int>(shards_.size()));
+  TurnServer* server = shards_[shard].server.get();
+  shards_[shard].thread->Invoke<void>(RTC_FROM_HERE,
+                                      [&] { callback(server); });
+}
+
+size_t ShardedTurnServer::NumAllocations() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  size_t num_allocations = 0;
+  for (Shard& shard : shards_) {
+    TurnServer* server = shard.server.get();
+    num_allocations += shard.thread->Invoke<size_t>(
+        RTC_FROM_HERE, [server] { return server->allocations().size(); });
+  }
+  return num_allocations;
+}
+
+bool ShardedTurnServer::StartShard(Shard* shard,
+                                   const rtc::SocketAddress& int_addr,
+                                   ProtocolType proto,
+                                   const rtc::SocketAddress& ext_addr,
+                                   const ShardCallback& configure,
+                                   rtc::SocketAddress* bound_addr) {
+  RTC_DCHECK(shard->thread->IsCurrent());
+  rtc::Thread* thread = shard->thread.get();
+  shard->server = absl::make_unique<TurnServer>(thread);
+  configure(shard->server.get());
+
+  std::unique_ptr<rtc::AsyncSocket> socket(
+      thread->socketserver()->CreateAsyncSocket(
+          int_addr.family(), proto == PROTO_UDP ? SOCK_DGRAM : SOCK_STREAM));
+  if (!socket)
+    return false;
+  if (socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0 ||
+      socket->Bind(int_addr) != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to bind a shared socket at "
+                      << int_addr.ToString() << ", error "
+                      << socket->GetError();
+    return false;
+  }
+  *bound_addr = socket->GetLocalAddress();
+
+  if (proto == PROTO_UDP) {
+    shard->server->AddInternalSocket(
+        new rtc::AsyncUDPSocket(socket.release()), proto);
+  } else {
+    if (socket->Listen(kListenBacklog) != 0)
+      return false;
+    shard->server->AddInternalServerSocket(socket.release(), proto);
+  }
+  shard->server->SetExternalSocketFactory(
+      new rtc::BasicPacketSocketFactory(thread), ext_addr);
+  return true;
+}
+
+}  // namespace cricket
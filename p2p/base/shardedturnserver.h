@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDEDTURNSERVER_H_
+#define P2P_BASE_SHARDEDTURNSERVER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "p2p/base/portinterface.h"
+#include "p2p/base/turnserver.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_checker.h"
+
+namespace cricket {
+
+// Runs a TurnServer per thread, so that a relay uses more than one core.
+// Every shard opens its own internal socket on the same address with
+// SO_REUSEPORT, and the kernel spreads the clients over them by hashing
+// their addresses. A client therefore keeps talking to the shard that
+// created its allocation, and each shard keeps its own allocations, nonce
+// key and caches, without sharing any state with the other shards.
+//
+// The number of shards can't change while the server runs, as the kernel
+// would then move clients to other sockets.
+class ShardedTurnServer {
+ public:
+  // Configures the TurnServer of a shard; called on the thread of the shard.
+  typedef std::function<void(TurnServer*)> ShardCallback;
+
+  explicit ShardedTurnServer(int num_shards);
+  // Stops the shards, and destroys their servers and allocations.
+  ~ShardedTurnServer();
+
+  // Starts the shards, each listening on |int_addr| with |proto| (UDP or
+  // TCP) and relaying from sockets bound to |ext_addr|. |configure| is run
+  // for each shard before it starts listening, and everything it installs,
+  // like the auth hook, must be thread safe if it is shared by the shards.
+  // If the port of |int_addr| is 0, the shards share the port picked for the
+  // first one. Returns false if a socket couldn't be bound, e.g. because
+  // SO_REUSEPORT isn't supported.
+  bool Start(const rtc::SocketAddress& int_addr,
+             ProtocolType proto,
+             const rtc::SocketAddress& ext_addr,
+             const ShardCallback& configure);
+
+  int num_shards() const { return num_shards_; }
+
+  // The address that the shards listen on, once started.
+  const rtc::SocketAddress& address() const {
+    RTC_DCHECK(thread_checker_.CalledOnValidThread());
+    return address_;
+  }
+
+  // Runs |callback| with the server of |shard| on its thread, and waits for
+  // it to return.
+  void InvokeOnShard(int shard, const ShardCallback& callback);
+
+  // Returns the number of allocations on all shards.
+  size_t NumAllocations();
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> thread;
+    // Created, used and destroyed on |thread|.
+    std::unique_ptr<TurnServer> server;
+  };
+
+  // Runs on the thread of |shard|.
+  bool StartShard(Shard* shard,
+                  const rtc::SocketAddress& int_addr,
+                  ProtocolType proto,
+                  const rtc::SocketAddress& ext_addr,
+                  const ShardCallback& configure,
+                  rtc::SocketAddress* bound_addr);
+
+  const int num_shards_;
+  rtc::ThreadChecker thread_checker_;
+  std::vector<Shard> shards_;
+  rtc::SocketAddress address_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ShardedTurnServer);
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDEDTURNSERVER_H_
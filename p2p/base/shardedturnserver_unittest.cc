@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shardedturnserver.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/physicalsocketserver.h"
+#include "rtc_base/testclient.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+namespace {
+
+const int kNumShards = 3;
+const char kRealm[] = "sharded.test";
+const rtc::SocketAddress kLoopbackAddr("127.0.0.1", 0);
+
+}  // namespace
+
+class ShardedTurnServerTest : public testing::Test {
+ public:
+  ShardedTurnServerTest() : main_(&ss_), server_(kNumShards) {}
+
+ protected:
+  rtc::PhysicalSocketServer ss_;
+  rtc::AutoSocketServerThread main_;
+  ShardedTurnServer server_;
+};
+
+TEST_F(ShardedTurnServerTest, ShardsShareOnePort) {
+  int num_configured = 0;
+  ASSERT_TRUE(server_.Start(kLoopbackAddr, PROTO_UDP, kLoopbackAddr,
+                            [&num_configured](TurnServer* server) {
+                              server->set_realm(kRealm);
+                              ++num_configured;
+                            }));
+  EXPECT_EQ(kNumShards, num_configured);
+  EXPECT_NE(0, server_.address().port());
+
+  for (int i = 0; i < server_.num_shards(); ++i) {
+    std::string realm;
+    server_.InvokeOnShard(
+        i, [&realm](TurnServer* server) { realm = server->realm(); });
+    EXPECT_EQ(kRealm, realm);
+  }
+  EXPECT_EQ(0u, server_.NumAllocations());
+}
+
+TEST_F(ShardedTurnServerTest, AnswersClientsOnEveryShard) {
+  ASSERT_TRUE(server_.Start(kLoopbackAddr, PROTO_UDP, kLoopbackAddr,
+                            [](TurnServer* server) {}));
+
+  // With enough clients, the kernel hands some to each shard; every one of
+  // them must be answered.
+  std::vector<std::unique_ptr<rtc::TestClient>> clients;
+  for (int i = 0; i < 4 * kNumShards; ++i) {
+    clients.push_back(absl::make_unique<rtc::TestClient>(
+        absl::WrapUnique(rtc::AsyncUDPSocket::Create(&ss_, kLoopbackAddr))));
+  }
+  for (size_t i = 0; i < clients.size(); ++i) {
+    StunMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID("0123456789a" + std::to_string(i % 10));
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    clients[i]->SendTo(buf.Data(), buf.Length(), server_.address());
+
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        clients[i]->NextPacket(rtc::TestClient::kTimeoutMs);
+    ASSERT_TRUE(packet);
+    rtc::ByteBufferReader reader(packet->buf, packet->size);
+    StunMessage response;
+    ASSERT_TRUE(response.Read(&reader));
+    EXPECT_EQ(STUN_BINDING_RESPONSE, response.type());
+    EXPECT_EQ(request.transaction_id(), response.transaction_id());
+  }
+}
+
+TEST_F(ShardedTurnServerTest, StartsTcpShards) {
+  ASSERT_TRUE(server_.Start(kLoopbackAddr, PROTO_TCP, kLoopbackAddr,
+                            [](TurnServer* server) {}));
+  EXPECT_NE(0, server_.address().port());
+}
+
+}  // namespace cricket
@@ -0,0 +1,330 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharedudpsocketfactory.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "p2p/base/stun.h"
+#include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/byteorder.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+
+namespace {
+
+// Returns the USERNAME of |data| if it is a STUN binding request, or an
+// empty string otherwise.
+std::string GetBindingRequestUsername(const char* data, size_t size) {
+  if (size < cricket::kStunHeaderSize ||
+      GetBE16(data) != cricket::STUN_BINDING_REQUEST) {
+    return std::string();
+  }
+  cricket::IceMessage msg;
+  ByteBufferReader buf(data, size);
+  if (!msg.Read(&buf))
+    return std::string();
+  const cricket::StunByteStringAttribute* username_attr =
+      msg.GetByteString(cricket::STUN_ATTR_USERNAME);
+  return username_attr ? username_attr->GetString() : std::string();
+}
+
+}  // namespace
+
+// The real socket of one IP address, and the demultiplexing state of the
+// sockets sharing it.
+class SharedUdpSocketFactory::SharedSocket : public sigslot::has_slots<> {
+ public:
+  SharedSocket(SharedUdpSocketFactory* factory,
+               const IPAddress& ip,
+               AsyncPacketSocket* socket)
+      : factory_(factory), ip_(ip), socket_(socket) {
+    socket_->SignalReadPacket.connect(this, &SharedSocket::OnReadPacket);
+    socket_->SignalSentPacket.connect(this, &SharedSocket::OnSentPacket);
+    socket_->SignalReadyToSend.connect(this, &SharedSocket::OnReadyToSend);
+  }
+
+  const IPAddress& ip() const { return ip_; }
+  AsyncPacketSocket* socket() { return socket_.get(); }
+
+  void AddSocket(DemuxedSocket* socket) { sockets_.insert(socket); }
+  void RemoveSocket(DemuxedSocket* socket);
+
+  // Directs the packets from |addr| to |socket|.
+  void ClaimAddress(DemuxedSocket* socket, const SocketAddress& addr);
+  // Directs the checks for |ufrag| from unknown addresses to |socket|.
+  void ClaimUfrag(DemuxedSocket* socket, const std::string& ufrag);
+
+  // Nested batches of several sockets are sent as one.
+  void StartSendBatch() {
+    if (batch_depth_++ == 0)
+      socket_->StartSendBatch();
+  }
+  void FlushSendBatch() {
+    RTC_DCHECK_GT(batch_depth_, 0);
+    if (--batch_depth_ == 0)
+      socket_->FlushSendBatch();
+  }
+
+ private:
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& addr,
+                    const PacketTime& packet_time);
+  void OnSentPacket(AsyncPacketSocket* socket, const SentPacket& sent_packet);
+  void OnReadyToSend(AsyncPacketSocket* socket);
+
+  SharedUdpSocketFactory* const factory_;
+  const IPAddress ip_;
+  std::unique_ptr<AsyncPacketSocket> socket_;
+  std::unordered_set<DemuxedSocket*> sockets_;
+  std::unordered_map<SocketAddress, DemuxedSocket*, SocketAddressHash>
+      sockets_by_address_;
+  std::unordered_map<std::string, DemuxedSocket*> sockets_by_ufrag_;
+  int batch_depth_ = 0;
+};
+
+// The socket handed out by the factory. It sends through the shared socket
+// and receives the packets that were demultiplexed to it.
+class SharedUdpSocketFactory::DemuxedSocket : public AsyncPacketSocket {
+ public:
+  explicit DemuxedSocket(SharedSocket* shared) : shared_(shared) {
+    shared_->AddSocket(this);
+  }
+  ~DemuxedSocket() override { Close(); }
+
+  SocketAddress GetLocalAddress() const override {
+    return local_address_;
+  }
+  SocketAddress GetRemoteAddress() const override { return SocketAddress(); }
+
+  int Send(const void* pv, size_t cb, const PacketOptions& options) override {
+    error_ = ENOTCONN;
+    return -1;
+  }
+  int SendTo(const void* pv,
+             size_t cb,
+             const SocketAddress& addr,
+             const PacketOptions& options) override {
+    if (!shared_) {
+      error_ = EBADF;
+      return -1;
+    }
+    shared_->ClaimAddress(this, addr);
+    // The USERNAME of an outgoing check is "<remote ufrag>:<local ufrag>".
+    std::string username =
+        GetBindingRequestUsername(static_cast<const char*>(pv), cb);
+    size_t colon = username.find(':');
+    if (colon != std::string::npos)
+      shared_->ClaimUfrag(this, username.substr(colon + 1));
+    int ret = shared_->socket()->SendTo(pv, cb, addr, options);
+    if (ret < 0)
+      error_ = shared_->socket()->GetError();
+    return ret;
+  }
+
+  void StartSendBatch() override {
+    if (shared_ && !batching_) {
+      batching_ = true;
+      shared_->StartSendBatch();
+    }
+  }
+  void FlushSendBatch() override {
+    if (shared_ && batching_) {
+      batching_ = false;
+      shared_->FlushSendBatch();
+    }
+  }
+
+  int Close() override {
+    if (!shared_)
+      return 0;
+    FlushSendBatch();
+    SharedSocket* shared = shared_;
+    shared_ = nullptr;
+    shared->RemoveSocket(this);
+    return 0;
+  }
+
+  State GetState() const override {
+    return shared_ ? STATE_BOUND : STATE_CLOSED;
+  }
+
+  // Options apply to the real socket, and so to all the sockets sharing it.
+  int GetOption(Socket::Option opt, int* value) override {
+    return shared_ ? shared_->socket()->GetOption(opt, value) : -1;
+  }
+  int SetOption(Socket::Option opt, int value) override {
+    return shared_ ? shared_->socket()->SetOption(opt, value) : -1;
+  }
+
+  int GetError() const override { return error_; }
+  void SetError(int error) override { error_ = error; }
+
+  // The addresses and ufrags claimed by this socket, to release on Close().
+  std::vector<SocketAddress>* claimed_addresses() {
+    return &claimed_addresses_;
+  }
+  std::vector<std::string>* claimed_ufrags() { return &claimed_ufrags_; }
+
+  void set_local_address(const SocketAddress& addr) { local_address_ = addr; }
+
+ private:
+  SharedSocket* shared_;
+  SocketAddress local_address_;
+  std::vector<SocketAddress> claimed_addresses_;
+  std::vector<std::string> claimed_ufrags_;
+  bool batching_ = false;
+  int error_ = 0;
+};
+
+void SharedUdpSocketFactory::SharedSocket::RemoveSocket(
+    DemuxedSocket* socket) {
+  for (const SocketAddress& addr : *socket->claimed_addresses()) {
+    auto it = sockets_by_address_.find(addr);
+    if (it != sockets_by_address_.end() && it->second == socket)
+      sockets_by_address_.erase(it);
+  }
+  for (const std::string& ufrag : *socket->claimed_ufrags()) {
+    auto it = sockets_by_ufrag_.find(ufrag);
+    if (it != sockets_by_ufrag_.end() && it->second == socket)
+      sockets_by_ufrag_.erase(it);
+  }
+  sockets_.erase(socket);
+  if (sockets_.empty())
+    factory_->OnSharedSocketUnused(this);
+}
+
+void SharedUdpSocketFactory::SharedSocket::ClaimAddress(
+    DemuxedSocket* socket,
+    const SocketAddress& addr) {
+  DemuxedSocket*& owner = sockets_by_address_[addr];
+  if (owner == socket)
+    return;
+  if (owner) {
+    RTC_LOG(LS_WARNING) << "Shared UDP socket "
+                        << socket_->GetLocalAddress().ToString() << " moves "
+                        << addr.ToSensitiveString()
+                        << " to another socket";
+  }
+  owner = socket;
+  socket->claimed_addresses()->push_back(addr);
+}
+
+void SharedUdpSocketFactory::SharedSocket::ClaimUfrag(
+    DemuxedSocket* socket,
+    const std::string& ufrag) {
+  DemuxedSocket*& owner = sockets_by_ufrag_[ufrag];
+  if (owner == socket)
+    return;
+  owner = socket;
+  socket->claimed_ufrags()->push_back(ufrag);
+}
+
+void SharedUdpSocketFactory::SharedSocket::OnReadPacket(
+    AsyncPacketSocket* socket,
+    const char* data,
+    size_t size,
+    const SocketAddress& addr,
+    const PacketTime& packet_time) {
+  RTC_DCHECK_EQ(socket_.get(), socket);
+  DemuxedSocket* target = nullptr;
+  auto addr_it = sockets_by_address_.find(addr);
+  if (addr_it != sockets_by_address_.end()) {
+    target = addr_it->second;
+  } else {
+    // On first contact, the USERNAME of an incoming check is
+    // "<local ufrag>:<remote ufrag>".
+    std::string username = GetBindingRequestUsername(data, size);
+    auto ufrag_it = sockets_by_ufrag_.find(username.substr(
+        0, std::min(username.find(':'), username.size())));
+    if (ufrag_it == sockets_by_ufrag_.end()) {
+      RTC_LOG(LS_VERBOSE) << "Shared UDP socket "
+                          << socket_->GetLocalAddress().ToString()
+                          << " dropped a packet from unknown address "
+                          << addr.ToSensitiveString();
+      return;
+    }
+    target = ufrag_it->second;
+    ClaimAddress(target, addr);
+  }
+  target->SignalReadPacket(target, data, size, addr, packet_time);
+}
+
+void SharedUdpSocketFactory::SharedSocket::OnSentPacket(
+    AsyncPacketSocket* socket,
+    const SentPacket& sent_packet) {
+  // Every packet is sent to an address claimed by its sender.
+  auto it = sockets_by_address_.find(sent_packet.info.remote_socket_address);
+  if (it != sockets_by_address_.end())
+    it->second->SignalSentPacket(it->second, sent_packet);
+}
+
+void SharedUdpSocketFactory::SharedSocket::OnReadyToSend(
+    AsyncPacketSocket* socket) {
+  // A handler may close its socket.
+  std::vector<DemuxedSocket*> sockets(sockets_.begin(), sockets_.end());
+  for (DemuxedSocket* demuxed : sockets) {
+    if (sockets_.count(demuxed))
+      demuxed->SignalReadyToSend(demuxed);
+  }
+}
+
+SharedUdpSocketFactory::SharedUdpSocketFactory(Thread* thread, uint16_t port)
+    : BasicPacketSocketFactory(thread), port_(port) {}
+
+SharedUdpSocketFactory::~SharedUdpSocketFactory() {
+  RTC_DCHECK(shared_sockets_.empty());
+}
+
+AsyncPacketSocket* SharedUdpSocketFactory::CreateUdpSocket(
+    const SocketAddress& local_address,
+    uint16_t min_port,
+    uint16_t max_port) {
+  SharedSocket*& shared = shared_sockets_[local_address.ipaddr()];
+  if (!shared) {
+    AsyncPacketSocket* socket = BasicPacketSocketFactory::CreateUdpSocket(
+        SocketAddress(local_address.ipaddr(), port_), port_, port_);
+    if (!socket) {
+      shared_sockets_.erase(local_address.ipaddr());
+      return nullptr;
+    }
+    RTC_LOG(LS_INFO) << "Created shared UDP socket "
+                     << socket->GetLocalAddress().ToString();
+    shared = new SharedSocket(this, local_address.ipaddr(), socket);
+  }
+  DemuxedSocket* socket = new DemuxedSocket(shared);
+  socket->set_local_address(shared->socket()->GetLocalAddress());
+  return socket;
+}
+
+void SharedUdpSocketFactory::OnSharedSocketUnused(SharedSocket* shared) {
+  RTC_DCHECK(shared_sockets_[shared->ip()] == shared);
+  RTC_LOG(LS_INFO) << "Closing unused shared UDP socket "
+                   << shared->socket()->GetLocalAddress().ToString();
+  shared_sockets_.erase(shared->ip());
+  // The last socket may be closed while the shared socket is delivering a
+  // packet, so it is only closed now, which frees the port, and deleted
+  // later.
+  shared->socket()->Close();
+  Thread::Current()->Dispose(shared);
+}
+
+}  // namespace rtc
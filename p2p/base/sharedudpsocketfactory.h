@@ -0,0 +1,58 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHAREDUDPSOCKETFACTORY_H_
+#define P2P_BASE_SHAREDUDPSOCKETFACTORY_H_
+
+#include <map>
+
+#include "p2p/base/basicpacketsocketfactory.h"
+#include "rtc_base/ipaddress.h"
+
+namespace rtc {
+
+// A packet socket factory whose UDP sockets on the same IP address all share
+// one real socket, so that many PeerConnections use a single port and file
+// descriptor. Received packets are demultiplexed by their source address,
+// which a socket claims by sending to it. Checks from addresses nobody has
+// sent to yet go to the socket whose ICE ufrag is the local one in their
+// USERNAME; the ufrags are learned from the checks each socket sends.
+//
+// TCP sockets are created as by BasicPacketSocketFactory. The factory must
+// outlive all of its sockets, which must be used on its thread.
+class SharedUdpSocketFactory : public BasicPacketSocketFactory {
+ public:
+  // The shared sockets are bound to |port|, or to an ephemeral port if it is
+  // 0, regardless of the port range asked for.
+  SharedUdpSocketFactory(Thread* thread, uint16_t port);
+  ~SharedUdpSocketFactory() override;
+
+  AsyncPacketSocket* CreateUdpSocket(const SocketAddress& local_address,
+                                     uint16_t min_port,
+                                     uint16_t max_port) override;
+
+  // The number of real UDP sockets, one per IP address in use.
+  size_t num_shared_sockets() const { return shared_sockets_.size(); }
+
+ private:
+  class SharedSocket;
+  class DemuxedSocket;
+
+  void OnSharedSocketUnused(SharedSocket* shared_socket);
+
+  const uint16_t port_;
+  std::map<IPAddress, SharedSocket*> shared_sockets_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SharedUdpSocketFactory);
+};
+
+}  // namespace rtc
+
+#endif  // P2P_BASE_SHAREDUDPSOCKETFACTORY_H_
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharedudpsocketfactory.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/testclient.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtualsocketserver.h"
+
+namespace rtc {
+
+namespace {
+
+const SocketAddress kLocalAddr("11.11.11.11", 0);
+const SocketAddress kOtherLocalAddr("11.11.11.12", 0);
+const SocketAddress kRemoteAddr("22.22.22.22", 0);
+const uint16_t kSharedPort = 3478;
+
+std::string MakeBindingRequest(const std::string& username) {
+  cricket::IceMessage request;
+  request.SetType(cricket::STUN_BINDING_REQUEST);
+  request.SetTransactionID("0123456789ab");
+  request.AddAttribute(absl::make_unique<cricket::StunByteStringAttribute>(
+      cricket::STUN_ATTR_USERNAME, username));
+  ByteBufferWriter buf;
+  request.Write(&buf);
+  return std::string(buf.Data(), buf.Length());
+}
+
+}  // namespace
+
+class SharedUdpSocketFactoryTest : public testing::Test,
+                                   public sigslot::has_slots<> {
+ public:
+  SharedUdpSocketFactoryTest()
+      : ss_(new VirtualSocketServer()),
+        main_(ss_.get()),
+        factory_(Thread::Current(), kSharedPort) {}
+
+ protected:
+  std::unique_ptr<AsyncPacketSocket> CreateSocket(
+      const SocketAddress& addr = kLocalAddr) {
+    std::unique_ptr<AsyncPacketSocket> socket(
+        factory_.CreateUdpSocket(addr, 0, 0));
+    if (socket) {
+      socket->SignalReadPacket.connect(
+          this, &SharedUdpSocketFactoryTest::OnReadPacket);
+    }
+    return socket;
+  }
+
+  std::unique_ptr<TestClient> CreateClient() {
+    return absl::make_unique<TestClient>(
+        absl::WrapUnique(AsyncUDPSocket::Create(ss_.get(), kRemoteAddr)));
+  }
+
+  void Send(AsyncPacketSocket* socket,
+            const std::string& data,
+            const SocketAddress& addr) {
+    EXPECT_EQ(static_cast<int>(data.size()),
+              socket->SendTo(data.data(), data.size(), addr, PacketOptions()));
+  }
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& addr,
+                    const PacketTime& packet_time) {
+    last_socket_ = socket;
+    last_packet_ = std::string(data, size);
+  }
+
+  std::unique_ptr<VirtualSocketServer> ss_;
+  AutoSocketServerThread main_;
+  SharedUdpSocketFactory factory_;
+  AsyncPacketSocket* last_socket_ = nullptr;
+  std::string last_packet_;
+};
+
+TEST_F(SharedUdpSocketFactoryTest, SocketsShareOnePortPerAddress) {
+  std::unique_ptr<AsyncPacketSocket> first = CreateSocket();
+  std::unique_ptr<AsyncPacketSocket> second = CreateSocket();
+  std::unique_ptr<AsyncPacketSocket> other = CreateSocket(kOtherLocalAddr);
+  ASSERT_TRUE(first && second && other);
+  EXPECT_EQ(SocketAddress(kLocalAddr.ipaddr(), kSharedPort),
+            first->GetLocalAddress());
+  EXPECT_EQ(first->GetLocalAddress(), second->GetLocalAddress());
+  EXPECT_EQ(SocketAddress(kOtherLocalAddr.ipaddr(), kSharedPort),
+            other->GetLocalAddress());
+  EXPECT_EQ(2u, factory_.num_shared_sockets());
+
+  first.reset();
+  EXPECT_EQ(2u, factory_.num_shared_sockets());
+  second.reset();
+  other.reset();
+  EXPECT_EQ(0u, factory_.num_shared_sockets());
+
+  // The port was freed, and can be bound again.
+  EXPECT_TRUE(CreateSocket());
+}
+
+TEST_F(SharedUdpSocketFactoryTest, DemultiplexesByRemoteAddress) {
+  std::unique_ptr<AsyncPacketSocket> first = CreateSocket();
+  std::unique_ptr<AsyncPacketSocket> second = CreateSocket();
+  std::unique_ptr<TestClient> first_client = CreateClient();
+  std::unique_ptr<TestClient> second_client = CreateClient();
+
+  Send(first.get(), "hello", first_client->address());
+  Send(second.get(), "hello", second_client->address());
+  EXPECT_TRUE(first_client->CheckNextPacket("hello", 5, nullptr));
+  EXPECT_TRUE(second_client->CheckNextPacket("hello", 5, nullptr));
+
+  second_client->SendTo("reply", 5, second->GetLocalAddress());
+  EXPECT_EQ_WAIT(second.get(), last_socket_, TestClient::kTimeoutMs);
+  first_client->SendTo("reply", 5, first->GetLocalAddress());
+  EXPECT_EQ_WAIT(first.get(), last_socket_, TestClient::kTimeoutMs);
+  EXPECT_EQ("reply", last_packet_);
+}
+
+TEST_F(SharedUdpSocketFactoryTest, DemultiplexesFirstContactByUfrag) {
+  std::unique_ptr<AsyncPacketSocket> first = CreateSocket();
+  std::unique_ptr<AsyncPacketSocket> second = CreateSocket();
+  std::unique_ptr<TestClient> pinged = CreateClient();
+  std::unique_ptr<TestClient> client = CreateClient();
+
+  // Each socket learns its ufrag from a check it sends elsewhere.
+  Send(first.get(), MakeBindingRequest("remote:FIRST"), pinged->address());
+  Send(second.get(), MakeBindingRequest("remote:SECOND"), pinged->address());
+
+  // An unknown ufrag from an unknown address is dropped.
+  const std::string unknown = MakeBindingRequest("OTHER:remote");
+  client->SendTo(unknown.data(), unknown.size(), first->GetLocalAddress());
+  ss_->ProcessMessagesUntilIdle();
+  EXPECT_EQ(nullptr, last_socket_);
+
+  const std::string check = MakeBindingRequest("FIRST:remote");
+  client->SendTo(check.data(), check.size(), first->GetLocalAddress());
+  EXPECT_EQ_WAIT(first.get(), last_socket_, TestClient::kTimeoutMs);
+  EXPECT_EQ(check, last_packet_);
+
+  // The address now belongs to the first socket.
+  last_socket_ = nullptr;
+  client->SendTo("data", 4, first->GetLocalAddress());
+  EXPECT_EQ_WAIT(first.get(), last_socket_, TestClient::kTimeoutMs);
+
+  // Until the socket is closed.
+  first.reset();
+  last_socket_ = nullptr;
+  client->SendTo("data", 4, second->GetLocalAddress());
+  ss_->ProcessMessagesUntilIdle();
+  EXPECT_EQ(nullptr, last_socket_);
+}
+
+}  // namespace rtc
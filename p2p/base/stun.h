@@ -21,6 +21,10 @@
 #include "rtc_base/bytebuffer.h"
 #include "rtc_base/socketaddress.h"
 
+namespace rtc {
+class OpenSSLHmac;
+}
+
 namespace cricket {
 
 // These are the types of STUN messages defined in RFC 5389.
@@ -173,9 +177,15 @@ class StunMessage {
   static bool ValidateMessageIntegrity(const char* data,
                                        size_t size,
                                        const std::string& password);
+  // Like above, with an HMAC-SHA1 keyed with the password once, for callers
+  // that check many messages with the same password.
+  static bool ValidateMessageIntegrity(const char* data,
+                                       size_t size,
+                                       rtc::OpenSSLHmac* hmac);
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
   bool AddMessageIntegrity(const std::string& password);
   bool AddMessageIntegrity(const char* key, size_t keylen);
+  bool AddMessageIntegrity(rtc::OpenSSLHmac* hmac);
 
   // Verifies that a given buffer is STUN by checking for a correct FINGERPRINT.
   static bool ValidateFingerprint(const char* data, size_t size);
@@ -104,6 +104,32 @@ class StunBindingRequest : public StunRequest {
   int64_t start_time_;
 };
 
+StunMappingCache::StunMappingCache(int ttl_ms) : ttl_ms_(ttl_ms) {}
+
+StunMappingCache::~StunMappingCache() = default;
+
+bool StunMappingCache::Lookup(const rtc::SocketAddress& local_addr,
+                              const rtc::SocketAddress& server_addr,
+                              rtc::SocketAddress* mapped_addr) {
+  auto it = mappings_.find(MappingKey(local_addr, server_addr));
+  if (it == mappings_.end())
+    return false;
+  if (rtc::TimeMillis() >= it->second.expires_ms) {
+    mappings_.erase(it);
+    return false;
+  }
+  *mapped_addr = it->second.mapped_addr;
+  return true;
+}
+
+void StunMappingCache::Insert(const rtc::SocketAddress& local_addr,
+                              const rtc::SocketAddress& server_addr,
+                              const rtc::SocketAddress& mapped_addr) {
+  Mapping& mapping = mappings_[MappingKey(local_addr, server_addr)];
+  mapping.mapped_addr = mapped_addr;
+  mapping.expires_ms = rtc::TimeMillis() + ttl_ms_;
+}
+
 UDPPort::AddressResolver::AddressResolver(rtc::PacketSocketFactory* factory)
     : socket_factory_(factory) {}
 
@@ -419,6 +445,18 @@ void UDPPort::SendStunBindingRequest(const rtc::SocketAddress& stun_addr) {
   } else if (socket_->GetState() == rtc::AsyncPacketSocket::STATE_BOUND) {
     // Check if |server_addr_| is compatible with the port's ip.
     if (IsCompatibleAddress(stun_addr)) {
+      rtc::SocketAddress cached_addr;
+      if (stun_mapping_cache_ &&
+          bind_request_succeeded_servers_.count(stun_addr) == 0 &&
+          stun_mapping_cache_->Lookup(socket_->GetLocalAddress(), stun_addr,
+                                      &cached_addr)) {
+        RTC_LOG(LS_INFO) << ToString() << ": Using the cached mapping "
+                         << cached_addr.ToSensitiveString() << " of "
+                         << stun_addr.ToSensitiveString();
+        bind_request_succeeded_servers_.insert(stun_addr);
+        cached_mappings_[stun_addr] = cached_addr;
+        AddStunCandidate(stun_addr, cached_addr);
+      }
       requests_.Send(
           new StunBindingRequest(this, stun_addr, rtc::TimeMillis()));
     } else {
@@ -456,11 +494,35 @@ void UDPPort::OnStunBindingRequestSucceeded(
   stats_.stun_binding_responses_received++;
   stats_.stun_binding_rtt_ms_total += rtt_ms;
   stats_.stun_binding_rtt_ms_squared_total += rtt_ms * rtt_ms;
+  if (stun_mapping_cache_) {
+    stun_mapping_cache_->Insert(socket_->GetLocalAddress(), stun_server_addr,
+                                stun_reflected_addr);
+  }
+  auto cached_it = cached_mappings_.find(stun_server_addr);
+  if (cached_it != cached_mappings_.end()) {
+    // The first response confirms the candidate taken from the cache, or
+    // replaces a mapping that has changed since.
+    bool changed = cached_it->second != stun_reflected_addr;
+    cached_mappings_.erase(cached_it);
+    if (changed) {
+      RTC_LOG(LS_INFO) << ToString() << ": Cached mapping of "
+                       << stun_server_addr.ToSensitiveString()
+                       << " changed to "
+                       << stun_reflected_addr.ToSensitiveString();
+      AddStunCandidate(stun_server_addr, stun_reflected_addr);
+    }
+    return;
+  }
   if (bind_request_succeeded_servers_.find(stun_server_addr) !=
       bind_request_succeeded_servers_.end()) {
     return;
   }
   bind_request_succeeded_servers_.insert(stun_server_addr);
+  AddStunCandidate(stun_server_addr, stun_reflected_addr);
+}
+
+void UDPPort::AddStunCandidate(const rtc::SocketAddress& stun_server_addr,
+                               const rtc::SocketAddress& stun_reflected_addr) {
   // If socket is shared and |stun_reflected_addr| is equal to local socket
   // address, or if the same address has been added by another STUN server,
   // then discarding the stun address.
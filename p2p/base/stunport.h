@@ -32,6 +32,39 @@ static const int INFINITE_LIFETIME = -1;
 // Lifetime for STUN ports on high-cost networks: 2 minutes
 static const int HIGH_COST_PORT_KEEPALIVE_LIFETIME = 2 * 60 * 1000;
 
+// Remembers the server reflexive addresses that STUN servers returned for
+// local socket addresses, so that a UDPPort on a local address mapped shortly
+// before can signal its STUN candidate without waiting for the binding
+// response. Only ports that reuse a local socket address, as the sockets of
+// a rtc::SharedUdpSocketFactory do, can hit the cache. It can be shared by
+// the allocators of many PeerConnections on the network thread.
+class StunMappingCache {
+ public:
+  explicit StunMappingCache(int ttl_ms);
+  ~StunMappingCache();
+
+  // Returns true and sets |mapped_addr| if there is a fresh mapping of
+  // |local_addr| by |server_addr|.
+  bool Lookup(const rtc::SocketAddress& local_addr,
+              const rtc::SocketAddress& server_addr,
+              rtc::SocketAddress* mapped_addr);
+  void Insert(const rtc::SocketAddress& local_addr,
+              const rtc::SocketAddress& server_addr,
+              const rtc::SocketAddress& mapped_addr);
+
+ private:
+  struct Mapping {
+    rtc::SocketAddress mapped_addr;
+    int64_t expires_ms;
+  };
+  typedef std::pair<rtc::SocketAddress, rtc::SocketAddress> MappingKey;
+
+  const int ttl_ms_;
+  std::map<MappingKey, Mapping> mappings_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(StunMappingCache);
+};
+
 // Communicates using the address on the outside of a NAT.
 class UDPPort : public Port {
  public:
@@ -112,6 +145,14 @@ class UDPPort : public Port {
     return stun_keepalive_delay_;
   }
 
+  // Makes the port signal the mappings found in |cache| as STUN candidates
+  // right away, and record the ones it learns. The binding requests are sent
+  // all the same, and a different mapping is signaled as another candidate.
+  // |cache| is not owned and must outlive the port.
+  void set_stun_mapping_cache(StunMappingCache* cache) {
+    stun_mapping_cache_ = cache;
+  }
+
   // Visible for testing.
   int stun_keepalive_lifetime() const { return stun_keepalive_lifetime_; }
   void set_stun_keepalive_lifetime(int lifetime) {
@@ -217,6 +258,8 @@ class UDPPort : public Port {
       const rtc::SocketAddress& stun_reflected_addr);
   void OnStunBindingOrResolveRequestFailed(
       const rtc::SocketAddress& stun_server_addr);
+  void AddStunCandidate(const rtc::SocketAddress& stun_server_addr,
+                        const rtc::SocketAddress& stun_reflected_addr);
 
   // Sends STUN requests to the server.
   void OnSendPacket(const void* data, size_t size, StunRequest* req);
@@ -239,6 +282,10 @@ class UDPPort : public Port {
   ServerAddresses server_addresses_;
   ServerAddresses bind_request_succeeded_servers_;
   ServerAddresses bind_request_failed_servers_;
+  StunMappingCache* stun_mapping_cache_ = nullptr;
+  // The servers whose candidate was signaled from the cache, and the mapped
+  // address it has, until the first binding response.
+  std::map<rtc::SocketAddress, rtc::SocketAddress> cached_mappings_;
   StunRequestManager requests_;
   rtc::AsyncPacketSocket* socket_;
   int error_;
@@ -252,6 +252,33 @@ TEST_F(StunPortTest, TestSharedSocketPrepareAddress) {
   EXPECT_TRUE(kLocalAddr.EqualIPs(port()->Candidates()[0].address()));
 }
 
+// Test that a cached mapping is signaled before the binding response, and
+// that the response updates the cache.
+TEST_F(StunPortTest, TestSharedSocketPrepareAddressWithCachedMapping) {
+  const rtc::SocketAddress kCachedAddr("1.2.3.4", 5678);
+  cricket::StunMappingCache cache(60 * 1000);
+  CreateSharedUdpPort(kStunAddr1);
+  const rtc::SocketAddress local_addr = port()->GetLocalAddress();
+  cache.Insert(local_addr, kStunAddr1, kCachedAddr);
+  port()->set_stun_mapping_cache(&cache);
+  PrepareAddress();
+  ASSERT_EQ(2U, port()->Candidates().size());
+  EXPECT_EQ(kCachedAddr, port()->Candidates()[1].address());
+  EXPECT_EQ(cricket::STUN_PORT_TYPE, port()->Candidates()[1].type());
+
+  // The port is complete without waiting for the response.
+  EXPECT_TRUE(done());
+  EXPECT_FALSE(error());
+
+  // The server sees the local address, which is not signaled again.
+  rtc::SocketAddress mapped_addr;
+  EXPECT_TRUE_SIMULATED_WAIT(
+      cache.Lookup(local_addr, kStunAddr1, &mapped_addr) &&
+          mapped_addr == local_addr,
+      kTimeoutMs, fake_clock);
+  EXPECT_EQ(2U, port()->Candidates().size());
+}
+
 // Test that we still a get a local candidate with invalid stun server hostname.
 // Also verifing that UDPPort can receive packets when stun address can't be
 // resolved.
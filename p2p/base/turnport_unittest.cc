@@ -140,6 +140,28 @@ class TestConnectionWrapper : public sigslot::has_slots<> {
   Connection* connection_;
 };
 
+// Records the channels offloaded by the TURN server.
+class FakeTurnChannelOffloader : public TurnChannelOffloader {
+ public:
+  explicit FakeTurnChannelOffloader(bool accept) : accept_(accept) {}
+
+  bool AddChannel(const TurnChannelBinding& binding) override {
+    added_.push_back(binding);
+    return accept_;
+  }
+  void RemoveChannel(const TurnChannelBinding& binding) override {
+    removed_.push_back(binding);
+  }
+
+  const std::vector<TurnChannelBinding>& added() const { return added_; }
+  const std::vector<TurnChannelBinding>& removed() const { return removed_; }
+
+ private:
+  const bool accept_;
+  std::vector<TurnChannelBinding> added_;
+  std::vector<TurnChannelBinding> removed_;
+};
+
 // Note: This test uses a fake clock with a simulated network round trip
 // (between local port and TURN server) of kSimulatedRtt.
 class TurnPortTest : public testing::Test,
@@ -1373,6 +1395,44 @@ TEST_F(TurnPortTest, TestTurnSendDataTurnUdpToUdp) {
   EXPECT_EQ(UDP_PROTOCOL_NAME, turn_port_->Candidates()[0].relay_protocol());
 }
 
+// Test that bound channels are offered to the channel offloader, and removed
+// from it with their allocation.
+TEST_F(TurnPortTest, TestChannelsAreOffloaded) {
+  FakeTurnChannelOffloader offloader(true);
+  turn_server_.server()->set_channel_offloader(&offloader);
+  CreateTurnPort(kTurnUsername, kTurnPassword, kTurnUdpProtoAddr);
+  TestTurnSendData(PROTO_UDP);
+
+  ASSERT_EQ(1u, offloader.added().size());
+  const TurnChannelBinding& binding = offloader.added()[0];
+  EXPECT_EQ(PROTO_UDP, binding.proto);
+  EXPECT_EQ(kTurnUdpIntAddr, binding.server_address);
+  EXPECT_EQ(turn_port_->Candidates()[0].address(), binding.relayed_address);
+  EXPECT_EQ(udp_port_->Candidates()[0].address(), binding.peer_address);
+  EXPECT_TRUE(offloader.removed().empty());
+
+  turn_port_.reset();
+  EXPECT_EQ_SIMULATED_WAIT(0U, turn_server_.server()->allocations().size(),
+                           kSimulatedRtt, fake_clock_);
+  ASSERT_EQ(1u, offloader.removed().size());
+  EXPECT_EQ(binding.channel_id, offloader.removed()[0].channel_id);
+  EXPECT_EQ(binding.client_address, offloader.removed()[0].client_address);
+}
+
+// Test that channels refused by the offloader are not removed from it.
+TEST_F(TurnPortTest, TestRefusedChannelsAreNotRemoved) {
+  FakeTurnChannelOffloader offloader(false);
+  turn_server_.server()->set_channel_offloader(&offloader);
+  CreateTurnPort(kTurnUsername, kTurnPassword, kTurnUdpProtoAddr);
+  TestTurnSendData(PROTO_UDP);
+  EXPECT_EQ(1u, offloader.added().size());
+
+  turn_port_.reset();
+  EXPECT_EQ_SIMULATED_WAIT(0U, turn_server_.server()->allocations().size(),
+                           kSimulatedRtt, fake_clock_);
+  EXPECT_TRUE(offloader.removed().empty());
+}
+
 // Do a TURN allocation, establish a TCP connection, and send some data.
 TEST_F(TurnPortTest, TestTurnSendDataTurnTcpToUdp) {
   turn_server_.AddInternalSocket(kTurnTcpIntAddr, PROTO_TCP);
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "absl/memory/memory.h"
+#include "absl/types/optional.h"
 #include "p2p/base/asyncstuntcpsocket.h"
 #include "p2p/base/packetsocketfactory.h"
 #include "p2p/base/stun.h"
@@ -86,6 +87,15 @@ class TurnServerAllocation::Channel : public rtc::MessageHandler {
 
   int id() const { return id_; }
   const rtc::SocketAddress& peer() const { return peer_; }
+  // Set if the channel was accepted by the server's TurnChannelOffloader.
+  // Kept, as the client's socket may be gone when the channel is removed.
+  const absl::optional<TurnChannelBinding>& offloaded_binding() const {
+    return offloaded_binding_;
+  }
+  void set_offloaded_binding(
+      const absl::optional<TurnChannelBinding>& binding) {
+    offloaded_binding_ = binding;
+  }
   void Refresh();
 
   sigslot::signal1<Channel*> SignalDestroyed;
@@ -96,6 +106,7 @@ class TurnServerAllocation::Channel : public rtc::MessageHandler {
   rtc::Thread* thread_;
   int id_;
   rtc::SocketAddress peer_;
+  absl::optional<TurnChannelBinding> offloaded_binding_;
 };
 
 static bool InitResponse(const StunMessage* req, StunMessage* resp) {
@@ -593,6 +604,13 @@ bool TurnServerConnection::operator<(const TurnServerConnection& c) const {
   return std::tie(src_, dst_, proto_) < std::tie(c.src_, c.dst_, c.proto_);
 }
 
+size_t TurnServerConnection::Hash() const {
+  // A server has few local addresses, so most of the entropy is in |src_|.
+  size_t hash = src_.Hash();
+  hash = hash * 31 + dst_.Hash();
+  return hash * 31 + proto_;
+}
+
 std::string TurnServerConnection::ToString() const {
   const char* const kProtos[] = {
       "unknown", "udp", "tcp", "ssltcp"
@@ -617,13 +635,12 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
 }
 
 TurnServerAllocation::~TurnServerAllocation() {
-  for (ChannelList::iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    delete *it;
+  for (const auto& entry : channels_by_id_) {
+    RemoveOffloadedChannel(entry.second);
+    delete entry.second;
   }
-  for (PermissionList::iterator it = perms_.begin();
-       it != perms_.end(); ++it) {
-    delete *it;
+  for (const auto& entry : perms_) {
+    delete entry.second;
   }
   thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
@@ -806,7 +823,13 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
     channel1 = new Channel(thread_, channel_id, peer_attr->GetAddress());
     channel1->SignalDestroyed.connect(this,
         &TurnServerAllocation::OnChannelDestroyed);
-    channels_.push_back(channel1);
+    channels_by_id_[channel_id] = channel1;
+    channels_by_peer_[channel1->peer()] = channel1;
+    if (server_->channel_offloader_) {
+      TurnChannelBinding binding = GetChannelBinding(channel1);
+      if (server_->channel_offloader_->AddChannel(binding))
+        channel1->set_offloaded_binding(binding);
+    }
   } else {
     channel1->Refresh();
   }
@@ -893,7 +916,7 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
     perm = new Permission(thread_, addr);
     perm->SignalDestroyed.connect(
         this, &TurnServerAllocation::OnPermissionDestroyed);
-    perms_.push_back(perm);
+    perms_[addr] = perm;
   } else {
     perm->Refresh();
   }
@@ -901,32 +924,20 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
 
 TurnServerAllocation::Permission* TurnServerAllocation::FindPermission(
     const rtc::IPAddress& addr) const {
-  for (PermissionList::const_iterator it = perms_.begin();
-       it != perms_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  PermissionMap::const_iterator it = perms_.find(addr);
+  return (it != perms_.end()) ? it->second : NULL;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     int channel_id) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->id() == channel_id)
-      return *it;
-  }
-  return NULL;
+  ChannelIdMap::const_iterator it = channels_by_id_.find(channel_id);
+  return (it != channels_by_id_.end()) ? it->second : NULL;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     const rtc::SocketAddress& addr) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  ChannelPeerMap::const_iterator it = channels_by_peer_.find(addr);
+  return (it != channels_by_peer_.end()) ? it->second : NULL;
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -956,17 +967,41 @@ void TurnServerAllocation::OnMessage(rtc::Message* msg) {
   delete this;
 }
 
+TurnChannelBinding TurnServerAllocation::GetChannelBinding(
+    const Channel* channel) {
+  TurnChannelBinding binding;
+  binding.client_address = conn_.src();
+  binding.server_address = conn_.socket()->GetLocalAddress();
+  binding.proto = conn_.proto();
+  binding.relayed_address = external_socket_->GetLocalAddress();
+  binding.peer_address = channel->peer();
+  binding.channel_id = channel->id();
+  return binding;
+}
+
+void TurnServerAllocation::RemoveOffloadedChannel(Channel* channel) {
+  if (!channel->offloaded_binding())
+    return;
+  RTC_DCHECK(server_->channel_offloader_);
+  server_->channel_offloader_->RemoveChannel(*channel->offloaded_binding());
+  channel->set_offloaded_binding(absl::nullopt);
+}
+
 void TurnServerAllocation::OnPermissionDestroyed(Permission* perm) {
-  PermissionList::iterator it = std::find(perms_.begin(), perms_.end(), perm);
-  RTC_DCHECK(it != perms_.end());
+  PermissionMap::iterator it = perms_.find(perm->peer());
+  RTC_DCHECK(it != perms_.end() && it->second == perm);
   perms_.erase(it);
 }
 
 void TurnServerAllocation::OnChannelDestroyed(Channel* channel) {
-  ChannelList::iterator it =
-      std::find(channels_.begin(), channels_.end(), channel);
-  RTC_DCHECK(it != channels_.end());
-  channels_.erase(it);
+  RemoveOffloadedChannel(channel);
+  ChannelIdMap::iterator id_it = channels_by_id_.find(channel->id());
+  RTC_DCHECK(id_it != channels_by_id_.end() && id_it->second == channel);
+  channels_by_id_.erase(id_it);
+  ChannelPeerMap::iterator peer_it = channels_by_peer_.find(channel->peer());
+  RTC_DCHECK(peer_it != channels_by_peer_.end() &&
+             peer_it->second == channel);
+  channels_by_peer_.erase(peer_it);
 }
 
 TurnServerAllocation::Permission::Permission(rtc::Thread* thread,
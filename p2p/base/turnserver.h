@@ -11,11 +11,11 @@
 #ifndef P2P_BASE_TURNSERVER_H_
 #define P2P_BASE_TURNSERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -50,9 +50,11 @@ class TurnServerConnection {
                        ProtocolType proto,
                        rtc::AsyncPacketSocket* socket);
   const rtc::SocketAddress& src() const { return src_; }
+  ProtocolType proto() const { return proto_; }
   rtc::AsyncPacketSocket* socket() { return socket_; }
   bool operator==(const TurnServerConnection& t) const;
   bool operator<(const TurnServerConnection& t) const;
+  size_t Hash() const;
   std::string ToString() const;
 
  private:
@@ -62,6 +64,39 @@ class TurnServerConnection {
   rtc::AsyncPacketSocket* socket_;
 };
 
+struct TurnServerConnectionHash {
+  size_t operator()(const TurnServerConnection& conn) const {
+    return conn.Hash();
+  }
+};
+
+// A channel bound by a client, identified by the 5-tuple of the client's
+// connection to the server and by the relayed and peer addresses.
+struct TurnChannelBinding {
+  rtc::SocketAddress client_address;
+  rtc::SocketAddress server_address;
+  ProtocolType proto = PROTO_UDP;
+  rtc::SocketAddress relayed_address;
+  rtc::SocketAddress peer_address;
+  int channel_id = 0;
+};
+
+// An interface to relay the ChannelData of bound channels outside of the
+// server, e.g. with an XDP program that forwards packets after rewriting the
+// 4-byte ChannelData header. The server remains the control plane: it still
+// handles allocations, refreshes and permissions, expires channels and tells
+// the offloader when they go away. Packets that reach the server anyway are
+// relayed by it as usual. Called on the thread of the server.
+class TurnChannelOffloader {
+ public:
+  // Called when |binding| is created. Returns true if the offloader relays
+  // the packets of the channel from now on.
+  virtual bool AddChannel(const TurnChannelBinding& binding) = 0;
+  // Called when an offloaded channel expires, or its allocation is destroyed.
+  virtual void RemoveChannel(const TurnChannelBinding& binding) = 0;
+  virtual ~TurnChannelOffloader() = default;
+};
+
 // Encapsulates a TURN allocation.
 // The object is created when an allocation request is received, and then
 // handles TURN messages (via HandleTurnMessage) and channel data messages
@@ -95,8 +130,19 @@ class TurnServerAllocation : public rtc::MessageHandler,
  private:
   class Channel;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& addr) const {
+      return rtc::HashIP(addr);
+    }
+  };
+  // Hashed, since they are looked up for every relayed packet.
+  typedef std::unordered_map<rtc::IPAddress, Permission*, IPAddressHash>
+      PermissionMap;
+  typedef std::unordered_map<int, Channel*> ChannelIdMap;
+  typedef std::unordered_map<rtc::SocketAddress,
+                             Channel*,
+                             rtc::SocketAddressHash>
+      ChannelPeerMap;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -123,6 +169,9 @@ class TurnServerAllocation : public rtc::MessageHandler,
   void SendExternal(const void* data, size_t size,
                     const rtc::SocketAddress& peer);
 
+  TurnChannelBinding GetChannelBinding(const Channel* channel);
+  void RemoveOffloadedChannel(Channel* channel);
+
   void OnPermissionDestroyed(Permission* perm);
   void OnChannelDestroyed(Channel* channel);
   void OnMessage(rtc::Message* msg) override;
@@ -136,8 +185,10 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string username_;
   std::string origin_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  PermissionMap perms_;
+  // The same channels, by id and by peer address.
+  ChannelIdMap channels_by_id_;
+  ChannelPeerMap channels_by_peer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -172,7 +223,9 @@ class StunMessageObserver {
 // Not yet wired up: TCP support.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  typedef std::unordered_map<TurnServerConnection,
+                             std::unique_ptr<TurnServerAllocation>,
+                             TurnServerConnectionHash>
       AllocationMap;
 
   explicit TurnServer(rtc::Thread* thread);
@@ -230,6 +283,13 @@ class TurnServer : public sigslot::has_slots<> {
     enable_permission_checks_ = enable;
   }
 
+  // Sets the offloader for bound channels; does not take ownership. Must be
+  // set before the first allocation, and outlive the server.
+  void set_channel_offloader(TurnChannelOffloader* channel_offloader) {
+    RTC_DCHECK(thread_checker_.CalledOnValidThread());
+    channel_offloader_ = channel_offloader;
+  }
+
   // Starts listening for packets from internal clients.
   void AddInternalSocket(rtc::AsyncPacketSocket* socket,
                          ProtocolType proto);
@@ -321,6 +381,7 @@ class TurnServer : public sigslot::has_slots<> {
   bool reject_private_addresses_ = false;
   // Check for permission when receiving an external packet.
   bool enable_permission_checks_ = true;
+  TurnChannelOffloader* channel_offloader_ = nullptr;
 
   InternalSocketMap server_sockets_;
   ServerSocketMap server_listen_sockets_;
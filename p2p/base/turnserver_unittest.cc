@@ -27,6 +27,7 @@ class TurnServerConnectionTest : public testing::Test {
     EXPECT_TRUE(a == b);
     EXPECT_FALSE(a < b);
     EXPECT_FALSE(b < a);
+    EXPECT_EQ(a.Hash(), b.Hash());
   }
 
   void ExpectNotEqual(const TurnServerConnection& a,
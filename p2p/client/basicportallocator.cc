@@ -1505,6 +1505,7 @@ void AllocationSequence::CreateUDPPorts() {
   }
 
   if (port) {
+    port->set_stun_mapping_cache(session_->allocator()->stun_mapping_cache());
     // If shared socket is enabled, STUN candidate will be allocated by the
     // UDPPort.
     if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
@@ -1567,6 +1568,7 @@ void AllocationSequence::CreateStunPorts() {
       session_->allocator()->origin(),
       session_->allocator()->stun_candidate_keepalive_interval());
   if (port) {
+    port->set_stun_mapping_cache(session_->allocator()->stun_mapping_cache());
     session_->AddAllocatedPort(port, this, true);
     // Since StunPort is not created using shared socket, |port| will not be
     // added to the dequeue.
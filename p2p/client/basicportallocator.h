@@ -26,6 +26,8 @@
 
 namespace cricket {
 
+class StunMappingCache;
+
 class BasicPortAllocator : public PortAllocator {
  public:
   // note: The (optional) relay_port_factory is owned by caller
@@ -78,6 +80,18 @@ class BasicPortAllocator : public PortAllocator {
     return relay_port_factory_;
   }
 
+  // Lets the UDP and STUN ports signal STUN candidates from |cache|, which
+  // may be shared with other allocators. It is not owned and must outlive
+  // the ports.
+  void set_stun_mapping_cache(StunMappingCache* cache) {
+    CheckRunOnValidThreadIfInitialized();
+    stun_mapping_cache_ = cache;
+  }
+  StunMappingCache* stun_mapping_cache() {
+    CheckRunOnValidThreadIfInitialized();
+    return stun_mapping_cache_;
+  }
+
  private:
   void Construct();
 
@@ -91,6 +105,7 @@ class BasicPortAllocator : public PortAllocator {
   rtc::PacketSocketFactory* socket_factory_;
   bool allow_tcp_listen_;
   int network_ignore_mask_ = rtc::kDefaultNetworkIgnoreMask;
+  StunMappingCache* stun_mapping_cache_ = nullptr;
 
   // This is the factory being used.
   RelayPortFactoryInterface* relay_port_factory_;
@@ -27,6 +27,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/networkroute.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 // Adding 'nogncheck' to disable the gn include headers check to support modular
 // WebRTC build targets.
 #include "media/engine/webrtcvoiceengine.h"  // nogncheck
@@ -106,6 +107,8 @@ BaseChannel::BaseChannel(rtc::Thread* worker_thread,
       signaling_thread_(signaling_thread),
       content_name_(content_name),
       srtp_required_(srtp_required),
+      batch_incoming_packets_(
+          webrtc::field_trial::IsEnabled("WebRTC-BatchIncomingPackets")),
       crypto_options_(crypto_options),
       media_channel_(std::move(media_channel)) {
   RTC_DCHECK_RUN_ON(worker_thread_);
@@ -265,18 +268,20 @@ bool BaseChannel::SetLocalContent(const MediaContentDescription* content,
                                   SdpType type,
                                   std::string* error_desc) {
   TRACE_EVENT0("webrtc", "BaseChannel::SetLocalContent");
-  return InvokeOnWorker<bool>(
+  has_local_content_ = InvokeOnWorker<bool>(
       RTC_FROM_HERE,
       Bind(&BaseChannel::SetLocalContent_w, this, content, type, error_desc));
+  return has_local_content_;
 }
 
 bool BaseChannel::SetRemoteContent(const MediaContentDescription* content,
                                    SdpType type,
                                    std::string* error_desc) {
   TRACE_EVENT0("webrtc", "BaseChannel::SetRemoteContent");
-  return InvokeOnWorker<bool>(
+  has_remote_content_ = InvokeOnWorker<bool>(
       RTC_FROM_HERE,
       Bind(&BaseChannel::SetRemoteContent_w, this, content, type, error_desc));
+  return has_remote_content_;
 }
 
 bool BaseChannel::IsReadyToReceiveMedia_w() const {
@@ -444,7 +449,18 @@ void BaseChannel::OnRtpPacket(const webrtc::RtpPacketReceived& parsed_packet) {
   }
   rtc::PacketTime packet_time(timestamp, /*not_before=*/0);
 
-  OnPacketReceived(/*rtcp=*/false, parsed_packet.Buffer(), packet_time);
+  if (!CanProcessIncomingPacket(/*rtcp=*/false))
+    return;
+
+  if (batch_incoming_packets_) {
+    QueueIncomingPacket(parsed_packet, /*rtcp=*/false, rtc::CopyOnWriteBuffer(),
+                        packet_time);
+    return;
+  }
+  // Pass the packet on parsed, so that Call doesn't have to parse it again.
+  invoker_.AsyncInvoke<void>(RTC_FROM_HERE, worker_thread_,
+                             Bind(&BaseChannel::ProcessRtpPacket, this,
+                                  parsed_packet, packet_time));
 }
 
 void BaseChannel::UpdateRtpHeaderExtensionMap(
@@ -475,9 +491,7 @@ void BaseChannel::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer* packet,
   OnPacketReceived(/*rtcp=*/true, *packet, packet_time);
 }
 
-void BaseChannel::OnPacketReceived(bool rtcp,
-                                   const rtc::CopyOnWriteBuffer& packet,
-                                   const rtc::PacketTime& packet_time) {
+bool BaseChannel::CanProcessIncomingPacket(bool rtcp) {
   if (!has_received_packet_ && !rtcp) {
     has_received_packet_ = true;
     signaling_thread()->Post(RTC_FROM_HERE, this, MSG_FIRSTPACKETRECEIVED);
@@ -498,9 +512,23 @@ void BaseChannel::OnPacketReceived(bool rtcp,
     RTC_LOG(LS_WARNING)
         << "Can't process incoming " << RtpRtcpStringLiteral(rtcp)
         << " packet when SRTP is inactive and crypto is required";
-    return;
+    return false;
   }
+  return true;
+}
 
+void BaseChannel::OnPacketReceived(bool rtcp,
+                                   const rtc::CopyOnWriteBuffer& packet,
+                                   const rtc::PacketTime& packet_time) {
+  if (!CanProcessIncomingPacket(rtcp))
+    return;
+
+  // RTP packets that weren't parsed go through the same queue as the parsed
+  // ones, so that they can't overtake packets that are still queued.
+  if (batch_incoming_packets_) {
+    QueueIncomingPacket(absl::nullopt, rtcp, packet, packet_time);
+    return;
+  }
   invoker_.AsyncInvoke<void>(
       RTC_FROM_HERE, worker_thread_,
       Bind(&BaseChannel::ProcessPacket, this, rtcp, packet, packet_time));
@@ -521,6 +549,51 @@ void BaseChannel::ProcessPacket(bool rtcp,
   }
 }
 
+void BaseChannel::ProcessRtpPacket(const webrtc::RtpPacketReceived& packet,
+                                   const rtc::PacketTime& packet_time) {
+  RTC_DCHECK(worker_thread_->IsCurrent());
+  media_channel_->OnRtpPacketReceived(packet, packet_time);
+}
+
+void BaseChannel::QueueIncomingPacket(
+    absl::optional<webrtc::RtpPacketReceived> parsed_packet,
+    bool rtcp,
+    const rtc::CopyOnWriteBuffer& packet,
+    const rtc::PacketTime& packet_time) {
+  bool post_task;
+  {
+    rtc::CritScope cs(&incoming_packets_crit_);
+    // A task is already pending if there are queued packets.
+    post_task = incoming_packets_.empty();
+    incoming_packets_.push_back(
+        IncomingPacket{std::move(parsed_packet), rtcp, packet, packet_time});
+  }
+  if (post_task) {
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, worker_thread_,
+        Bind(&BaseChannel::ProcessQueuedPackets, this));
+  }
+}
+
+void BaseChannel::ProcessQueuedPackets() {
+  RTC_DCHECK(worker_thread_->IsCurrent());
+  RTC_DCHECK(processed_packets_.empty());
+  {
+    rtc::CritScope cs(&incoming_packets_crit_);
+    processed_packets_.swap(incoming_packets_);
+  }
+  TRACE_EVENT1("webrtc", "BaseChannel::ProcessQueuedPackets", "packets",
+               processed_packets_.size());
+  for (const IncomingPacket& packet : processed_packets_) {
+    if (packet.parsed_packet) {
+      ProcessRtpPacket(*packet.parsed_packet, packet.packet_time);
+    } else {
+      ProcessPacket(packet.rtcp, packet.packet, packet.packet_time);
+    }
+  }
+  processed_packets_.clear();
+}
+
 void BaseChannel::EnableMedia_w() {
   RTC_DCHECK(worker_thread_ == rtc::Thread::Current());
   if (enabled_)
@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/call/audio_sink.h"
 #include "api/jsep.h"
 #include "api/rtpreceiverinterface.h"
@@ -27,6 +28,7 @@
 #include "media/base/mediachannel.h"
 #include "media/base/mediaengine.h"
 #include "media/base/streamparams.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "p2p/base/dtlstransportinternal.h"
 #include "p2p/base/packettransportinternal.h"
 #include "pc/dtlssrtptransport.h"
@@ -39,6 +41,7 @@
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/network.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 class AudioSinkInterface;
@@ -117,6 +120,10 @@ class BaseChannel : public rtc::MessageHandler,
   bool SetRemoteContent(const MediaContentDescription* content,
                         webrtc::SdpType type,
                         std::string* error_desc);
+  // Whether the last call to SetLocalContent or SetRemoteContent succeeded,
+  // meaning the channel is up to date with the content it was given.
+  bool has_local_content() const { return has_local_content_; }
+  bool has_remote_content() const { return has_remote_content_; }
 
   bool Enable(bool enable);
 
@@ -227,12 +234,26 @@ class BaseChannel : public rtc::MessageHandler,
   void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer* packet,
                             const rtc::PacketTime& packet_time);
 
+  // Signals the first received RTP packet, and returns false if an incoming
+  // packet must be dropped because SRTP isn't active yet.
+  bool CanProcessIncomingPacket(bool rtcp);
   void OnPacketReceived(bool rtcp,
                         const rtc::CopyOnWriteBuffer& packet,
                         const rtc::PacketTime& packet_time);
   void ProcessPacket(bool rtcp,
                      const rtc::CopyOnWriteBuffer& packet,
                      const rtc::PacketTime& packet_time);
+  void ProcessRtpPacket(const webrtc::RtpPacketReceived& packet,
+                        const rtc::PacketTime& packet_time);
+  // Queues a received packet for the worker thread, posting a task to it only
+  // if no earlier packet is still waiting. Either |parsed_packet| is set, or
+  // |packet| holds an unparsed RTP or RTCP packet.
+  void QueueIncomingPacket(
+      absl::optional<webrtc::RtpPacketReceived> parsed_packet,
+      bool rtcp,
+      const rtc::CopyOnWriteBuffer& packet,
+      const rtc::PacketTime& packet_time);
+  void ProcessQueuedPackets();
 
   void EnableMedia_w();
   void DisableMedia_w();
@@ -299,6 +320,8 @@ class BaseChannel : public rtc::MessageHandler,
   rtc::Thread* const network_thread_;
   rtc::Thread* const signaling_thread_;
   rtc::AsyncInvoker invoker_;
+  bool has_local_content_ = false;
+  bool has_remote_content_ = false;
 
   const std::string content_name_;
 
@@ -313,6 +336,10 @@ class BaseChannel : public rtc::MessageHandler,
   bool was_ever_writable_ = false;
   bool has_received_packet_ = false;
   const bool srtp_required_ = true;
+  // If set, received packets are handed to the worker thread in batches,
+  // one task for all packets that arrive while the previous task is pending,
+  // instead of one task per packet.
+  const bool batch_incoming_packets_;
   rtc::CryptoOptions crypto_options_;
 
   // MediaChannel related members that should be accessed from the worker
@@ -322,6 +349,21 @@ class BaseChannel : public rtc::MessageHandler,
   // well, but it can be changed only when signaling thread does a synchronous
   // call to the worker thread, so it should be safe.
   bool enabled_ = false;
+
+  struct IncomingPacket {
+    // Set for RTP packets that were parsed by the RtpTransport.
+    absl::optional<webrtc::RtpPacketReceived> parsed_packet;
+    // Set for all other packets, RTCP and unparsed RTP.
+    bool rtcp;
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketTime packet_time;
+  };
+  rtc::CriticalSection incoming_packets_crit_;
+  std::vector<IncomingPacket> incoming_packets_
+      RTC_GUARDED_BY(incoming_packets_crit_);
+  // Packets being processed on the worker thread. Swapped with
+  // |incoming_packets_| so that neither vector has to reallocate.
+  std::vector<IncomingPacket> processed_packets_;
   std::vector<StreamParams> local_streams_;
   std::vector<StreamParams> remote_streams_;
   webrtc::RtpTransceiverDirection local_content_direction_ =
@@ -26,6 +26,7 @@
 #include "rtc_base/gunit.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/sslstreamadapter.h"
+#include "test/field_trial.h"
 
 using cricket::DtlsTransportInternal;
 using cricket::FakeVoiceMediaChannel;
@@ -1073,6 +1074,29 @@ class ChannelTest : public testing::Test, public sigslot::has_slots<> {
     EXPECT_TRUE(CheckNoRtcp2());
   }
 
+  // Test that packets reach the media channel when they are handed to the
+  // worker thread in batches.
+  void SendRtpAndRtcpBatched() {
+    webrtc::test::ScopedFieldTrials field_trials(
+        "WebRTC-BatchIncomingPackets/Enabled/");
+    CreateChannels(0, 0);
+    EXPECT_TRUE(SendInitiate());
+    EXPECT_TRUE(SendAccept());
+    SendRtp1();
+    SendRtcp1();
+    SendRtp2();
+    SendRtcp2();
+    WaitForThreads();
+    EXPECT_TRUE(CheckRtp1());
+    EXPECT_TRUE(CheckRtp2());
+    EXPECT_TRUE(CheckNoRtp1());
+    EXPECT_TRUE(CheckNoRtp2());
+    EXPECT_TRUE(CheckRtcp1());
+    EXPECT_TRUE(CheckRtcp2());
+    EXPECT_TRUE(CheckNoRtcp1());
+    EXPECT_TRUE(CheckNoRtcp2());
+  }
+
   // Test that the mediachannel retains its sending state after the transport
   // becomes non-writable.
   void SendWithWritabilityLoss() {
@@ -1814,6 +1838,10 @@ TEST_F(VoiceChannelDoubleThreadTest, SendRtpToRtpOnThread) {
   Base::SendRtpToRtpOnThread();
 }
 
+TEST_F(VoiceChannelDoubleThreadTest, SendRtpAndRtcpBatched) {
+  Base::SendRtpAndRtcpBatched();
+}
+
 TEST_F(VoiceChannelDoubleThreadTest, SendWithWritabilityLoss) {
   Base::SendWithWritabilityLoss();
 }
@@ -2080,6 +2108,10 @@ TEST_F(VideoChannelDoubleThreadTest, SendRtpToRtpOnThread) {
   Base::SendRtpToRtpOnThread();
 }
 
+TEST_F(VideoChannelDoubleThreadTest, SendRtpAndRtcpBatched) {
+  Base::SendRtpAndRtcpBatched();
+}
+
 TEST_F(VideoChannelDoubleThreadTest, SendWithWritabilityLoss) {
   Base::SendWithWritabilityLoss();
 }
@@ -66,6 +66,7 @@ void ChannelManager::GetSupportedAudioSendCodecs(
   if (!media_engine_) {
     return;
   }
+  StartMediaEngine();
   *codecs = media_engine_->audio_send_codecs();
 }
 
@@ -74,6 +75,7 @@ void ChannelManager::GetSupportedAudioReceiveCodecs(
   if (!media_engine_) {
     return;
   }
+  StartMediaEngine();
   *codecs = media_engine_->audio_recv_codecs();
 }
 
@@ -82,6 +84,7 @@ void ChannelManager::GetSupportedAudioRtpHeaderExtensions(
   if (!media_engine_) {
     return;
   }
+  StartMediaEngine();
   *ext = media_engine_->GetAudioCapabilities().header_extensions;
 }
 
@@ -90,6 +93,7 @@ void ChannelManager::GetSupportedVideoCodecs(
   if (!media_engine_) {
     return;
   }
+  StartMediaEngine();
   codecs->clear();
 
   std::vector<VideoCodec> video_codecs = media_engine_->video_codecs();
@@ -107,6 +111,7 @@ void ChannelManager::GetSupportedVideoRtpHeaderExtensions(
   if (!media_engine_) {
     return;
   }
+  StartMediaEngine();
   *ext = media_engine_->GetVideoCapabilities().header_extensions;
 }
 
@@ -128,16 +133,27 @@ bool ChannelManager::Init() {
         RTC_FROM_HERE, [&] { network_thread_->SetAllowBlockingCalls(false); });
   }
 
-  if (media_engine_) {
-    initialized_ = worker_thread_->Invoke<bool>(
-        RTC_FROM_HERE, [&] { return media_engine_->Init(); });
-    RTC_DCHECK(initialized_);
-  } else {
-    initialized_ = true;
-  }
+  initialized_ = true;
   return initialized_;
 }
 
+void ChannelManager::StartMediaEngine() const {
+  if (!media_engine_ || media_engine_started_) {
+    return;
+  }
+  // Starting always happens on the worker thread, which serializes racing
+  // callers.
+  worker_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+    if (media_engine_started_) {
+      return;
+    }
+    TRACE_EVENT0("webrtc", "ChannelManager::StartMediaEngine");
+    bool started = media_engine_->Init();
+    RTC_DCHECK(started);
+    media_engine_started_ = true;
+  });
+}
+
 void ChannelManager::Terminate() {
   RTC_DCHECK(initialized_);
   if (!initialized_) {
@@ -156,6 +172,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
     webrtc::Call* call,
     const cricket::MediaConfig& media_config,
     webrtc::RtpTransportInternal* rtp_transport,
+    rtc::Thread* network_thread,
     rtc::Thread* signaling_thread,
     const std::string& content_name,
     bool srtp_required,
@@ -164,8 +181,8 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VoiceChannel*>(RTC_FROM_HERE, [&] {
       return CreateVoiceChannel(call, media_config, rtp_transport,
-                                signaling_thread, content_name, srtp_required,
-                                crypto_options, options);
+                                network_thread, signaling_thread, content_name,
+                                srtp_required, crypto_options, options);
     });
   }
 
@@ -175,6 +192,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   if (!media_engine_) {
     return nullptr;
   }
+  StartMediaEngine();
 
   VoiceMediaChannel* media_channel =
       media_engine_->CreateChannel(call, media_config, options);
@@ -183,7 +201,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   }
 
   auto voice_channel = absl::make_unique<VoiceChannel>(
-      worker_thread_, network_thread_, signaling_thread, media_engine_.get(),
+      worker_thread_, network_thread, signaling_thread, media_engine_.get(),
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
 
@@ -223,6 +241,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
     webrtc::Call* call,
     const cricket::MediaConfig& media_config,
     webrtc::RtpTransportInternal* rtp_transport,
+    rtc::Thread* network_thread,
     rtc::Thread* signaling_thread,
     const std::string& content_name,
     bool srtp_required,
@@ -231,8 +250,8 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VideoChannel*>(RTC_FROM_HERE, [&] {
       return CreateVideoChannel(call, media_config, rtp_transport,
-                                signaling_thread, content_name, srtp_required,
-                                crypto_options, options);
+                                network_thread, signaling_thread, content_name,
+                                srtp_required, crypto_options, options);
     });
   }
 
@@ -242,6 +261,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   if (!media_engine_) {
     return nullptr;
   }
+  StartMediaEngine();
 
   VideoMediaChannel* media_channel =
       media_engine_->CreateVideoChannel(call, media_config, options);
@@ -250,7 +270,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   }
 
   auto video_channel = absl::make_unique<VideoChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
   video_channel->Init_w(rtp_transport);
@@ -288,14 +308,16 @@ void ChannelManager::DestroyVideoChannel(VideoChannel* video_channel) {
 RtpDataChannel* ChannelManager::CreateRtpDataChannel(
     const cricket::MediaConfig& media_config,
     webrtc::RtpTransportInternal* rtp_transport,
+    rtc::Thread* network_thread,
     rtc::Thread* signaling_thread,
     const std::string& content_name,
     bool srtp_required,
     const rtc::CryptoOptions& crypto_options) {
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<RtpDataChannel*>(RTC_FROM_HERE, [&] {
-      return CreateRtpDataChannel(media_config, rtp_transport, signaling_thread,
-                                  content_name, srtp_required, crypto_options);
+      return CreateRtpDataChannel(media_config, rtp_transport, network_thread,
+                                  signaling_thread, content_name, srtp_required,
+                                  crypto_options);
     });
   }
 
@@ -308,7 +330,7 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
   }
 
   auto data_channel = absl::make_unique<RtpDataChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
   data_channel->Init_w(rtp_transport);
@@ -345,12 +367,16 @@ void ChannelManager::DestroyRtpDataChannel(RtpDataChannel* data_channel) {
 
 bool ChannelManager::StartAecDump(rtc::PlatformFile file,
                                   int64_t max_size_bytes) {
+  StartMediaEngine();
   return worker_thread_->Invoke<bool>(RTC_FROM_HERE, [&] {
     return media_engine_->StartAecDump(file, max_size_bytes);
   });
 }
 
 void ChannelManager::StopAecDump() {
+  if (!media_engine_started_) {
+    return;
+  }
   worker_thread_->Invoke<void>(RTC_FROM_HERE,
                                [&] { media_engine_->StopAecDump(); });
 }
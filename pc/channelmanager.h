@@ -11,6 +11,7 @@
 #ifndef PC_CHANNELMANAGER_H_
 #define PC_CHANNELMANAGER_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,10 +40,11 @@ class ChannelManager final {
   ~ChannelManager();
 
   // Accessors for the worker thread, allowing it to be set after construction,
-  // but before Init. set_worker_thread will return false if called after Init.
+  // but before Init. set_worker_thread will return false if called after Init
+  // or once the media engine has started on the old thread.
   rtc::Thread* worker_thread() const { return worker_thread_; }
   bool set_worker_thread(rtc::Thread* thread) {
-    if (initialized_) {
+    if (initialized_ || media_engine_started_) {
       return false;
     }
     worker_thread_ = thread;
@@ -57,10 +59,14 @@ class ChannelManager final {
     return true;
   }
 
-  MediaEngineInterface* media_engine() { return media_engine_.get(); }
+  // Starts the media engine if it has not been started yet.
+  MediaEngineInterface* media_engine() {
+    StartMediaEngine();
+    return media_engine_.get();
+  }
 
   // Retrieves the list of supported audio & video codec types.
-  // Can be called before starting the media engine.
+  // Starts the media engine if it has not been started yet.
   void GetSupportedAudioSendCodecs(std::vector<AudioCodec>* codecs) const;
   void GetSupportedAudioReceiveCodecs(std::vector<AudioCodec>* codecs) const;
   void GetSupportedAudioRtpHeaderExtensions(RtpHeaderExtensions* ext) const;
@@ -68,10 +74,15 @@ class ChannelManager final {
   void GetSupportedVideoRtpHeaderExtensions(RtpHeaderExtensions* ext) const;
   void GetSupportedDataCodecs(std::vector<DataCodec>* codecs) const;
 
-  // Indicates whether the media engine is started.
+  // Indicates whether the ChannelManager is initialized.
   bool initialized() const { return initialized_; }
-  // Starts up the media engine.
+  // Initializes the ChannelManager. The media engine, which sets up the audio
+  // device, the audio processing and the codec lists, is only started when
+  // it is first used, so that PeerConnections that only use data channels
+  // never pay for it.
   bool Init();
+  // Indicates whether the media engine has been started.
+  bool media_engine_started() const { return media_engine_started_; }
   // Shuts down the media engine.
   void Terminate();
 
@@ -79,10 +90,15 @@ class ChannelManager final {
   // ChannelManager retains ownership of the created channels, so clients should
   // call the appropriate Destroy*Channel method when done.
 
+  // |network_thread| is the thread |rtp_transport| runs on; it need not be the
+  // ChannelManager's own network thread when PeerConnections are spread over
+  // several network threads.
+
   // Creates a voice channel, to be associated with the specified session.
   VoiceChannel* CreateVoiceChannel(webrtc::Call* call,
                                    const cricket::MediaConfig& media_config,
                                    webrtc::RtpTransportInternal* rtp_transport,
+                                   rtc::Thread* network_thread,
                                    rtc::Thread* signaling_thread,
                                    const std::string& content_name,
                                    bool srtp_required,
@@ -97,6 +113,7 @@ class ChannelManager final {
   VideoChannel* CreateVideoChannel(webrtc::Call* call,
                                    const cricket::MediaConfig& media_config,
                                    webrtc::RtpTransportInternal* rtp_transport,
+                                   rtc::Thread* network_thread,
                                    rtc::Thread* signaling_thread,
                                    const std::string& content_name,
                                    bool srtp_required,
@@ -108,6 +125,7 @@ class ChannelManager final {
   RtpDataChannel* CreateRtpDataChannel(
       const cricket::MediaConfig& media_config,
       webrtc::RtpTransportInternal* rtp_transport,
+      rtc::Thread* network_thread,
       rtc::Thread* signaling_thread,
       const std::string& content_name,
       bool srtp_required,
@@ -139,9 +157,14 @@ class ChannelManager final {
   void StopAecDump();
 
  private:
+  // Starts the media engine on the worker thread, once.
+  void StartMediaEngine() const;
+
   std::unique_ptr<MediaEngineInterface> media_engine_;  // Nullable.
   std::unique_ptr<DataEngineInterface> data_engine_;    // Non-null.
   bool initialized_ = false;
+  // Only set on the worker thread, but read on any thread.
+  mutable std::atomic<bool> media_engine_started_{false};
   rtc::Thread* main_thread_;
   rtc::Thread* worker_thread_;
   rtc::Thread* network_thread_;
@@ -64,17 +64,18 @@ class ChannelManagerTest : public testing::Test {
   void TestCreateDestroyChannels(webrtc::RtpTransportInternal* rtp_transport) {
     cricket::VoiceChannel* voice_channel = cm_->CreateVoiceChannel(
         &fake_call_, cricket::MediaConfig(), rtp_transport,
-        rtc::Thread::Current(), cricket::CN_AUDIO, kDefaultSrtpRequired,
-        rtc::CryptoOptions(), AudioOptions());
+        cm_->network_thread(), rtc::Thread::Current(), cricket::CN_AUDIO,
+        kDefaultSrtpRequired, rtc::CryptoOptions(), AudioOptions());
     EXPECT_TRUE(voice_channel != nullptr);
     cricket::VideoChannel* video_channel = cm_->CreateVideoChannel(
         &fake_call_, cricket::MediaConfig(), rtp_transport,
-        rtc::Thread::Current(), cricket::CN_VIDEO, kDefaultSrtpRequired,
-        rtc::CryptoOptions(), VideoOptions());
+        cm_->network_thread(), rtc::Thread::Current(), cricket::CN_VIDEO,
+        kDefaultSrtpRequired, rtc::CryptoOptions(), VideoOptions());
     EXPECT_TRUE(video_channel != nullptr);
     cricket::RtpDataChannel* rtp_data_channel = cm_->CreateRtpDataChannel(
-        cricket::MediaConfig(), rtp_transport, rtc::Thread::Current(),
-        cricket::CN_DATA, kDefaultSrtpRequired, rtc::CryptoOptions());
+        cricket::MediaConfig(), rtp_transport, cm_->network_thread(),
+        rtc::Thread::Current(), cricket::CN_DATA, kDefaultSrtpRequired,
+        rtc::CryptoOptions());
     EXPECT_TRUE(rtp_data_channel != nullptr);
     cm_->DestroyVideoChannel(video_channel);
     cm_->DestroyVoiceChannel(voice_channel);
@@ -121,6 +122,30 @@ TEST_F(ChannelManagerTest, StartupShutdownOnThread) {
   EXPECT_FALSE(cm_->initialized());
 }
 
+// Test that the media engine is only started when it is first used.
+TEST_F(ChannelManagerTest, StartsMediaEngineOnFirstUse) {
+  EXPECT_TRUE(cm_->Init());
+  EXPECT_FALSE(cm_->media_engine_started());
+  std::vector<DataCodec> data_codecs;
+  cm_->GetSupportedDataCodecs(&data_codecs);
+  EXPECT_FALSE(cm_->media_engine_started());
+
+  std::vector<AudioCodec> audio_codecs;
+  cm_->GetSupportedAudioSendCodecs(&audio_codecs);
+  EXPECT_TRUE(cm_->media_engine_started());
+  EXPECT_EQ(MAKE_VECTOR(kAudioCodecs), audio_codecs);
+  cm_->Terminate();
+}
+
+TEST_F(ChannelManagerTest, StartsMediaEngineOnThread) {
+  worker_->Start();
+  EXPECT_TRUE(cm_->set_worker_thread(worker_.get()));
+  EXPECT_TRUE(cm_->Init());
+  EXPECT_TRUE(cm_->media_engine());
+  EXPECT_TRUE(cm_->media_engine_started());
+  cm_->Terminate();
+}
+
 TEST_F(ChannelManagerTest, SetVideoRtxEnabled) {
   std::vector<VideoCodec> codecs;
   const VideoCodec rtx_codec(96, "rtx");
@@ -21,9 +21,6 @@
 
 namespace webrtc {
 
-static size_t kMaxQueuedReceivedDataBytes = 16 * 1024 * 1024;
-static size_t kMaxQueuedSendDataBytes = 16 * 1024 * 1024;
-
 enum {
   MSG_CHANNELREADY,
 };
@@ -65,6 +62,16 @@ bool SctpSidAllocator::IsSidAvailable(int sid) const {
   return used_sids_.find(sid) == used_sids_.end();
 }
 
+rtc::scoped_refptr<DataChannelMemoryBudget> DataChannelMemoryBudget::Create(
+    size_t max_bytes) {
+  return new rtc::RefCountedObject<DataChannelMemoryBudget>(max_bytes);
+}
+
+void DataChannelMemoryBudget::Remove(size_t bytes) {
+  RTC_DCHECK_GE(used_bytes_, bytes);
+  used_bytes_ -= bytes;
+}
+
 DataChannel::PacketQueue::PacketQueue() : byte_count_(0) {}
 
 DataChannel::PacketQueue::~PacketQueue() {
@@ -75,7 +82,13 @@ bool DataChannel::PacketQueue::Empty() const {
   return packets_.empty();
 }
 
-DataBuffer* DataChannel::PacketQueue::Front() {
+bool DataChannel::PacketQueue::HasRoomFor(size_t size,
+                                          size_t max_bytes) const {
+  return byte_count_ + size <= max_bytes &&
+         (!memory_budget_ || memory_budget_->HasRoomFor(size));
+}
+
+DataBuffer& DataChannel::PacketQueue::Front() {
   return packets_.front();
 }
 
@@ -84,28 +97,33 @@ void DataChannel::PacketQueue::Pop() {
     return;
   }
 
-  byte_count_ -= packets_.front()->size();
+  size_t size = packets_.front().size();
+  byte_count_ -= size;
+  if (memory_budget_) {
+    memory_budget_->Remove(size);
+  }
   packets_.pop_front();
 }
 
-void DataChannel::PacketQueue::Push(DataBuffer* packet) {
-  byte_count_ += packet->size();
+void DataChannel::PacketQueue::Push(const DataBuffer& packet) {
+  byte_count_ += packet.size();
+  if (memory_budget_) {
+    memory_budget_->Add(packet.size());
+  }
   packets_.push_back(packet);
 }
 
 void DataChannel::PacketQueue::Clear() {
-  while (!packets_.empty()) {
-    delete packets_.front();
-    packets_.pop_front();
+  packets_.clear();
+  if (memory_budget_) {
+    memory_budget_->Remove(byte_count_);
   }
   byte_count_ = 0;
 }
 
 void DataChannel::PacketQueue::Swap(PacketQueue* other) {
-  size_t other_byte_count = other->byte_count_;
-  other->byte_count_ = byte_count_;
-  byte_count_ = other_byte_count;
-
+  std::swap(byte_count_, other->byte_count_);
+  std::swap(memory_budget_, other->memory_budget_);
   other->packets_.swap(packets_);
 }
 
@@ -143,6 +161,9 @@ DataChannel::DataChannel(DataChannelProviderInterface* provider,
       receive_ssrc_(0) {}
 
 bool DataChannel::Init(const InternalDataChannelInit& config) {
+  queued_received_data_.set_memory_budget(config.memory_budget);
+  queued_send_data_.set_memory_budget(config.memory_budget);
+  config_.max_queued_bytes = config.max_queued_bytes;
   if (data_channel_type_ == cricket::DCT_RTP) {
     if (config.reliable || config.id != -1 || config.maxRetransmits != -1 ||
         config.maxRetransmitTime != -1) {
@@ -239,6 +260,14 @@ bool DataChannel::Send(const DataBuffer& buffer) {
     return true;
   }
 
+  // Push back on the producer, rather than close the channel, if the memory
+  // budget shared with the other data channels could not take |buffer| in
+  // case it needs to be queued.
+  if (data_channel_type_ == cricket::DCT_SCTP && config_.memory_budget &&
+      !config_.memory_budget->HasRoomFor(buffer.size())) {
+    return false;
+  }
+
   // If the queue is non-empty, we're waiting for SignalReadyToSend,
   // so just add to the end of the queue and keep waiting.
   if (!queued_send_data_.Empty()) {
@@ -397,15 +426,15 @@ void DataChannel::OnDataReceived(const cricket::ReceiveDataParams& params,
     handshake_state_ = kHandshakeReady;
   }
 
+  // The DataBuffer shares |payload| rather than copying it.
   bool binary = (params.type == cricket::DMT_BINARY);
-  std::unique_ptr<DataBuffer> buffer(new DataBuffer(payload, binary));
   if (state_ == kOpen && observer_) {
     ++messages_received_;
-    bytes_received_ += buffer->size();
-    observer_->OnMessage(*buffer.get());
+    bytes_received_ += payload.size();
+    observer_->OnMessage(DataBuffer(payload, binary));
   } else {
-    if (queued_received_data_.byte_count() + payload.size() >
-        kMaxQueuedReceivedDataBytes) {
+    if (!queued_received_data_.HasRoomFor(payload.size(),
+                                          config_.max_queued_bytes)) {
       RTC_LOG(LS_ERROR) << "Queued received data exceeds the max buffer size.";
 
       queued_received_data_.Clear();
@@ -415,7 +444,7 @@ void DataChannel::OnDataReceived(const cricket::ReceiveDataParams& params,
 
       return;
     }
-    queued_received_data_.Push(buffer.release());
+    queued_received_data_.Push(DataBuffer(payload, binary));
   }
 }
 
@@ -546,11 +575,11 @@ void DataChannel::DeliverQueuedReceivedData() {
   }
 
   while (!queued_received_data_.Empty()) {
-    std::unique_ptr<DataBuffer> buffer(queued_received_data_.Front());
-    ++messages_received_;
-    bytes_received_ += buffer->size();
-    observer_->OnMessage(*buffer);
+    DataBuffer buffer = queued_received_data_.Front();
     queued_received_data_.Pop();
+    ++messages_received_;
+    bytes_received_ += buffer.size();
+    observer_->OnMessage(buffer);
   }
 }
 
@@ -563,17 +592,20 @@ void DataChannel::SendQueuedDataMessages() {
 
   uint64_t start_buffered_amount = buffered_amount();
   while (!queued_send_data_.Empty()) {
-    DataBuffer* buffer = queued_send_data_.Front();
-    if (!SendDataMessage(*buffer, false)) {
+    if (!SendDataMessage(queued_send_data_.Front(), false)) {
       // Leave the message in the queue if sending is aborted.
       break;
     }
     queued_send_data_.Pop();
-    delete buffer;
   }
 
-  if (observer_ && buffered_amount() < start_buffered_amount) {
+  uint64_t end_buffered_amount = buffered_amount();
+  if (observer_ && end_buffered_amount < start_buffered_amount) {
     observer_->OnBufferedAmountChange(start_buffered_amount);
+    if (start_buffered_amount > buffered_amount_low_threshold_ &&
+        end_buffered_amount <= buffered_amount_low_threshold_) {
+      observer_->OnBufferedAmountLow();
+    }
   }
 }
 
@@ -629,11 +661,11 @@ bool DataChannel::SendDataMessage(const DataBuffer& buffer,
 
 bool DataChannel::QueueSendDataMessage(const DataBuffer& buffer) {
   size_t start_buffered_amount = buffered_amount();
-  if (start_buffered_amount >= kMaxQueuedSendDataBytes) {
+  if (start_buffered_amount >= config_.max_queued_bytes) {
     RTC_LOG(LS_ERROR) << "Can't buffer any more data for the data channel.";
     return false;
   }
-  queued_send_data_.Push(new DataBuffer(buffer));
+  queued_send_data_.Push(buffer);
 
   // The buffer can have length zero, in which case there is no change.
   if (observer_ && buffered_amount() > start_buffered_amount) {
@@ -647,14 +679,13 @@ void DataChannel::SendQueuedControlMessages() {
   control_packets.Swap(&queued_control_data_);
 
   while (!control_packets.Empty()) {
-    std::unique_ptr<DataBuffer> buf(control_packets.Front());
-    SendControlMessage(buf->data);
+    SendControlMessage(control_packets.Front().data);
     control_packets.Pop();
   }
 }
 
 void DataChannel::QueueControlMessage(const rtc::CopyOnWriteBuffer& buffer) {
-  queued_control_data_.Push(new DataBuffer(buffer, true));
+  queued_control_data_.Push(DataBuffer(buffer, true));
 }
 
 bool DataChannel::SendControlMessage(const rtc::CopyOnWriteBuffer& buffer) {
@@ -14,11 +14,13 @@
 #include <deque>
 #include <set>
 #include <string>
+#include <utility>
 
 #include "api/datachannelinterface.h"
 #include "api/proxy.h"
 #include "media/base/mediachannel.h"
 #include "pc/channel.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/messagehandler.h"
 #include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -52,6 +54,31 @@ class DataChannelProviderInterface {
   virtual ~DataChannelProviderInterface() {}
 };
 
+// Bounds the memory that the queued messages of a group of data channels, such
+// as all those of a PeerConnection, take together. Used on the signaling
+// thread.
+class DataChannelMemoryBudget : public rtc::RefCountInterface {
+ public:
+  static rtc::scoped_refptr<DataChannelMemoryBudget> Create(size_t max_bytes);
+
+  bool HasRoomFor(size_t bytes) const {
+    return used_bytes_ + bytes <= max_bytes_;
+  }
+  void Add(size_t bytes) { used_bytes_ += bytes; }
+  void Remove(size_t bytes);
+
+  size_t used_bytes() const { return used_bytes_; }
+  size_t max_bytes() const { return max_bytes_; }
+
+ protected:
+  explicit DataChannelMemoryBudget(size_t max_bytes) : max_bytes_(max_bytes) {}
+  ~DataChannelMemoryBudget() override = default;
+
+ private:
+  const size_t max_bytes_;
+  size_t used_bytes_ = 0;
+};
+
 struct InternalDataChannelInit : public DataChannelInit {
   enum OpenHandshakeRole { kOpener, kAcker, kNone };
   // The default role is kOpener because the default |negotiated| is false.
@@ -65,6 +92,11 @@ struct InternalDataChannelInit : public DataChannelInit {
   }
 
   OpenHandshakeRole open_handshake_role;
+  // Bounds the bytes of the queued outgoing messages, and of the queued
+  // incoming ones.
+  size_t max_queued_bytes = 16 * 1024 * 1024;
+  // Charged with the queued messages too, if set.
+  rtc::scoped_refptr<DataChannelMemoryBudget> memory_budget;
 };
 
 // Helper class to allocate unique IDs for SCTP DataChannels
@@ -138,6 +170,12 @@ class DataChannel : public DataChannelInterface,
   virtual bool negotiated() const { return config_.negotiated; }
   virtual int id() const { return config_.id; }
   virtual uint64_t buffered_amount() const;
+  virtual uint64_t buffered_amount_low_threshold() const {
+    return buffered_amount_low_threshold_;
+  }
+  virtual void SetBufferedAmountLowThreshold(uint64_t threshold) {
+    buffered_amount_low_threshold_ = threshold;
+  }
   virtual void Close();
   virtual DataState state() const { return state_; }
   virtual uint32_t messages_sent() const { return messages_sent_; }
@@ -198,6 +236,12 @@ class DataChannel : public DataChannelInterface,
     return data_channel_type_;
   }
 
+  // The bytes of the messages queued in either direction.
+  size_t queued_bytes() const {
+    return queued_control_data_.byte_count() +
+           queued_received_data_.byte_count() + queued_send_data_.byte_count();
+  }
+
   // Emitted when state transitions to kOpen.
   sigslot::signal1<DataChannel*> SignalOpened;
   // Emitted when state transitions to kClosed.
@@ -212,30 +256,42 @@ class DataChannel : public DataChannelInterface,
   virtual ~DataChannel();
 
  private:
-  // A packet queue which tracks the total queued bytes. Queued packets are
-  // owned by this class.
+  // A packet queue which tracks the total queued bytes, and charges them to a
+  // memory budget if it has one. The packets are stored by value, so queuing
+  // one only allocates when the deque needs another block, and the payload
+  // is shared rather than copied.
   class PacketQueue {
    public:
     PacketQueue();
     ~PacketQueue();
 
+    void set_memory_budget(
+        rtc::scoped_refptr<DataChannelMemoryBudget> memory_budget) {
+      RTC_DCHECK(Empty());
+      memory_budget_ = std::move(memory_budget);
+    }
+
     size_t byte_count() const { return byte_count_; }
 
+    // Whether |size| more bytes fit in |max_bytes| and the memory budget.
+    bool HasRoomFor(size_t size, size_t max_bytes) const;
+
     bool Empty() const;
 
-    DataBuffer* Front();
+    DataBuffer& Front();
 
     void Pop();
 
-    void Push(DataBuffer* packet);
+    void Push(const DataBuffer& packet);
 
     void Clear();
 
     void Swap(PacketQueue* other);
 
    private:
-    std::deque<DataBuffer*> packets_;
+    std::deque<DataBuffer> packets_;
     size_t byte_count_;
+    rtc::scoped_refptr<DataChannelMemoryBudget> memory_budget_;
   };
 
   // The OPEN(_ACK) signaling state.
@@ -286,6 +342,7 @@ class DataChannel : public DataChannelInterface,
   bool started_closing_procedure_ = false;
   uint32_t send_ssrc_;
   uint32_t receive_ssrc_;
+  uint64_t buffered_amount_low_threshold_ = 0;
   // Control messages that always have to get sent out before any queued
   // data.
   PacketQueue queued_control_data_;
@@ -312,6 +369,8 @@ PROXY_CONSTMETHOD0(uint64_t, bytes_sent)
 PROXY_CONSTMETHOD0(uint32_t, messages_received)
 PROXY_CONSTMETHOD0(uint64_t, bytes_received)
 PROXY_CONSTMETHOD0(uint64_t, buffered_amount)
+PROXY_CONSTMETHOD0(uint64_t, buffered_amount_low_threshold)
+PROXY_METHOD1(void, SetBufferedAmountLowThreshold, uint64_t)
 PROXY_METHOD0(void, Close)
 PROXY_METHOD1(bool, Send, const DataBuffer&)
 END_PROXY_MAP()
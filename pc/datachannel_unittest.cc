@@ -35,6 +35,8 @@ class FakeDataChannelObserver : public webrtc::DataChannelObserver {
     ++on_buffered_amount_change_count_;
   }
 
+  void OnBufferedAmountLow() { ++on_buffered_amount_low_count_; }
+
   void OnMessage(const webrtc::DataBuffer& buffer) { ++messages_received_; }
 
   size_t messages_received() const { return messages_received_; }
@@ -51,10 +53,15 @@ class FakeDataChannelObserver : public webrtc::DataChannelObserver {
     return on_buffered_amount_change_count_;
   }
 
+  size_t on_buffered_amount_low_count() const {
+    return on_buffered_amount_low_count_;
+  }
+
  private:
   size_t messages_received_;
   size_t on_state_change_count_;
   size_t on_buffered_amount_change_count_;
+  size_t on_buffered_amount_low_count_ = 0;
 };
 
 // TODO(deadbeef): The fact that these tests use a fake provider makes them not
@@ -194,6 +201,56 @@ TEST_F(SctpDataChannelTest, QueuedDataSentWhenUnblocked) {
   EXPECT_EQ(2U, observer_->on_buffered_amount_change_count());
 }
 
+// Tests that OnBufferedAmountLow is called when sending the queued data brings
+// the buffered amount down to the threshold.
+TEST_F(SctpDataChannelTest, BufferedAmountLowWhenUnblocked) {
+  AddObserver();
+  SetChannelReady();
+  webrtc_data_channel_->SetBufferedAmountLowThreshold(4);
+  webrtc::DataBuffer buffer("abcd");
+  provider_->set_send_blocked(true);
+  EXPECT_TRUE(webrtc_data_channel_->Send(buffer));
+  EXPECT_TRUE(webrtc_data_channel_->Send(buffer));
+  EXPECT_EQ(0U, observer_->on_buffered_amount_low_count());
+
+  provider_->set_send_blocked(false);
+  SetChannelReady();
+  EXPECT_EQ(0U, webrtc_data_channel_->buffered_amount());
+  EXPECT_EQ(1U, observer_->on_buffered_amount_low_count());
+}
+
+// Tests that data channels sharing a memory budget fail to send, rather than
+// close, once their queued data has used it up, and can send again once the
+// queued data is sent.
+TEST_F(SctpDataChannelTest, SendFailsWhenMemoryBudgetUsedUp) {
+  webrtc::InternalDataChannelInit init;
+  init.memory_budget = webrtc::DataChannelMemoryBudget::Create(8);
+  provider_->set_transport_available(true);
+  rtc::scoped_refptr<DataChannel> dc1 =
+      DataChannel::Create(provider_.get(), cricket::DCT_SCTP, "test1", init);
+  rtc::scoped_refptr<DataChannel> dc2 =
+      DataChannel::Create(provider_.get(), cricket::DCT_SCTP, "test2", init);
+  dc1->SetSctpSid(1);
+  dc2->SetSctpSid(2);
+  provider_->set_ready_to_send(true);
+  ASSERT_EQ(webrtc::DataChannelInterface::kOpen, dc1->state());
+  ASSERT_EQ(webrtc::DataChannelInterface::kOpen, dc2->state());
+
+  webrtc::DataBuffer buffer("abcd");
+  provider_->set_send_blocked(true);
+  EXPECT_TRUE(dc1->Send(buffer));
+  EXPECT_TRUE(dc2->Send(buffer));
+  EXPECT_EQ(8U, init.memory_budget->used_bytes());
+  EXPECT_FALSE(dc1->Send(buffer));
+  EXPECT_EQ(webrtc::DataChannelInterface::kOpen, dc1->state());
+  EXPECT_EQ(4U, dc1->buffered_amount());
+
+  provider_->set_send_blocked(false);
+  provider_->set_ready_to_send(true);
+  EXPECT_EQ(0U, init.memory_budget->used_bytes());
+  EXPECT_TRUE(dc1->Send(buffer));
+}
+
 // Tests that no crash when the channel is blocked right away while trying to
 // send queued data.
 TEST_F(SctpDataChannelTest, BlockedWhenSendQueuedDataNoCrash) {
@@ -11,10 +11,12 @@
 #include "pc/mediasession.h"
 
 #include <algorithm>  // For std::find_if, std::sort.
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
 #include <set>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 
@@ -1049,34 +1051,73 @@ static void StripCNCodecs(AudioCodecs* audio_codecs) {
   }
 }
 
+// Remembers the values computed for the m= sections of one offer or answer,
+// by the inputs they were computed from. The sections of a large session
+// mostly have the same inputs, and computing their codecs or header
+// extensions again compares each codec or extension with all the others.
+template <class Key, class Value>
+class SectionMemo {
+ public:
+  // Returns the value computed by |compute| for a key equal to |key|, which
+  // may be a tuple of references to the parts of a |Key|. The returned value
+  // is valid until the next call.
+  template <class KeyRef, class Compute>
+  const Value& Get(const KeyRef& key, const Compute& compute) {
+    for (const auto& entry : entries_) {
+      if (entry.first == key)
+        return entry.second;
+    }
+    // Don't spend more time comparing keys than is saved when every section
+    // is different.
+    if (entries_.size() >= kMaxEntries) {
+      uncached_ = compute();
+      return uncached_;
+    }
+    entries_.emplace_back(Key(key), compute());
+    return entries_.back().second;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 8;
+  std::deque<std::pair<Key, Value>> entries_;
+  Value uncached_;
+};
+
+// Returns the codecs of |current_content|, or none if there is no current
+// content or it is being recycled.
+template <class C>
+static const std::vector<C>& GetCurrentCodecs(
+    const ContentInfo* current_content) {
+  static const std::vector<C>* const kNoCodecs = new std::vector<C>();
+  if (!current_content || current_content->rejected)
+    return *kNoCodecs;
+  return static_cast<const MediaContentDescriptionImpl<C>*>(
+             current_content->media_description())
+      ->codecs();
+}
+
 // Create a media content to be answered for the given |sender_options|
 // according to the given session_options.rtcp_mux, session_options.streams,
 // codecs, crypto, and current_streams.  If we don't currently have crypto (in
 // current_cryptos) and it is enabled (in secure_policy), crypto is created
-// (according to crypto_suites). The codecs, rtcp_mux, and crypto are all
-// negotiated with the offer. If the negotiation fails, this method returns
-// false.  The created content is added to the offer.
+// (according to crypto_suites). The rtcp_mux and crypto are negotiated with
+// the offer, and the codecs and header extensions are negotiated by the
+// caller. If the negotiation fails, this method returns false.  The created
+// content is added to the offer.
 template <class C>
 static bool CreateMediaContentAnswer(
     const MediaContentDescriptionImpl<C>* offer,
     const MediaDescriptionOptions& media_description_options,
     const MediaSessionOptions& session_options,
-    const std::vector<C>& local_codecs,
+    const std::vector<C>& negotiated_codecs,
     const SecurePolicy& sdes_policy,
     const CryptoParamsVec* current_cryptos,
-    const RtpHeaderExtensions& local_rtp_extenstions,
-    bool enable_encrypted_rtp_header_extensions,
+    const RtpHeaderExtensions& negotiated_rtp_extensions,
     StreamParamsVec* current_streams,
     bool bundle_enabled,
     MediaContentDescriptionImpl<C>* answer) {
-  std::vector<C> negotiated_codecs;
-  NegotiateCodecs(local_codecs, offer->codecs(), &negotiated_codecs);
   answer->AddCodecs(negotiated_codecs);
   answer->set_protocol(offer->protocol());
-  RtpHeaderExtensions negotiated_rtp_extensions;
-  NegotiateRtpHeaderExtensions(
-      local_rtp_extenstions, offer->rtp_header_extensions(),
-      enable_encrypted_rtp_header_extensions, &negotiated_rtp_extensions);
   answer->set_rtp_header_extensions(negotiated_rtp_extensions);
 
   answer->set_rtcp_mux(session_options.rtcp_mux_enabled && offer->rtcp_mux());
@@ -1261,10 +1302,35 @@ void MediaSessionDescriptionFactory::set_audio_codecs(
   ComputeAudioCodecsIntersectionAndUnion();
 }
 
+struct MediaSessionDescriptionFactory::SectionMemos {
+  // The codecs of offered sections, by the direction and the codecs of the
+  // current section.
+  SectionMemo<std::tuple<RtpTransceiverDirection, AudioCodecs>, AudioCodecs>
+      audio_offer_codecs;
+  SectionMemo<std::tuple<VideoCodecs>, VideoCodecs> video_offer_codecs;
+  // The negotiated codecs of answered sections, by the offered and answered
+  // directions, the codecs of the current section and the offered codecs.
+  SectionMemo<std::tuple<RtpTransceiverDirection,
+                         RtpTransceiverDirection,
+                         AudioCodecs,
+                         AudioCodecs>,
+              AudioCodecs>
+      audio_answer_codecs;
+  SectionMemo<std::tuple<VideoCodecs, VideoCodecs>, VideoCodecs>
+      video_answer_codecs;
+  // The negotiated header extensions of answered sections, by the offered
+  // ones.
+  SectionMemo<std::tuple<RtpHeaderExtensions>, RtpHeaderExtensions>
+      audio_answer_extensions;
+  SectionMemo<std::tuple<RtpHeaderExtensions>, RtpHeaderExtensions>
+      video_answer_extensions;
+};
+
 SessionDescription* MediaSessionDescriptionFactory::CreateOffer(
     const MediaSessionOptions& session_options,
     const SessionDescription* current_description) const {
   std::unique_ptr<SessionDescription> offer(new SessionDescription());
+  SectionMemos memos;
 
   StreamParamsVec current_streams;
   GetCurrentStreamParams(current_description, &current_streams);
@@ -1312,7 +1378,7 @@ SessionDescription* MediaSessionDescriptionFactory::CreateOffer(
         if (!AddAudioContentForOffer(media_description_options, session_options,
                                      current_content, current_description,
                                      audio_rtp_extensions, offer_audio_codecs,
-                                     &current_streams, offer.get())) {
+                                     &memos, &current_streams, offer.get())) {
           return nullptr;
         }
         break;
@@ -1320,7 +1386,7 @@ SessionDescription* MediaSessionDescriptionFactory::CreateOffer(
         if (!AddVideoContentForOffer(media_description_options, session_options,
                                      current_content, current_description,
                                      video_rtp_extensions, offer_video_codecs,
-                                     &current_streams, offer.get())) {
+                                     &memos, &current_streams, offer.get())) {
           return nullptr;
         }
         break;
@@ -1389,6 +1455,7 @@ SessionDescription* MediaSessionDescriptionFactory::CreateAnswer(
   // codecs we support. As indicated by XEP-0167, we retain the same payload ids
   // from the offer in the answer.
   std::unique_ptr<SessionDescription> answer(new SessionDescription());
+  SectionMemos memos;
 
   StreamParamsVec current_streams;
   GetCurrentStreamParams(current_description, &current_streams);
@@ -1443,8 +1510,8 @@ SessionDescription* MediaSessionDescriptionFactory::CreateAnswer(
         if (!AddAudioContentForAnswer(
                 media_description_options, session_options, offer_content,
                 offer, current_content, current_description,
-                bundle_transport.get(), answer_audio_codecs, &current_streams,
-                answer.get())) {
+                bundle_transport.get(), answer_audio_codecs, &memos,
+                &current_streams, answer.get())) {
           return nullptr;
         }
         break;
@@ -1452,8 +1519,8 @@ SessionDescription* MediaSessionDescriptionFactory::CreateAnswer(
         if (!AddVideoContentForAnswer(
                 media_description_options, session_options, offer_content,
                 offer, current_content, current_description,
-                bundle_transport.get(), answer_video_codecs, &current_streams,
-                answer.get())) {
+                bundle_transport.get(), answer_video_codecs, &memos,
+                &current_streams, answer.get())) {
           return nullptr;
         }
         break;
@@ -1835,38 +1902,44 @@ bool MediaSessionDescriptionFactory::AddAudioContentForOffer(
     const SessionDescription* current_description,
     const RtpHeaderExtensions& audio_rtp_extensions,
     const AudioCodecs& audio_codecs,
+    SectionMemos* memos,
     StreamParamsVec* current_streams,
     SessionDescription* desc) const {
-  // Filter audio_codecs (which includes all codecs, with correctly remapped
-  // payload types) based on transceiver direction.
-  const AudioCodecs& supported_audio_codecs =
-      GetAudioCodecsForOffer(media_description_options.direction);
-
-  AudioCodecs filtered_codecs;
-  // Add the codecs from current content if it exists and is not being recycled.
-  if (current_content && !current_content->rejected) {
+  if (current_content && !current_content->rejected)
     RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_AUDIO));
-    const AudioContentDescription* acd =
-        current_content->media_description()->as_audio();
-    for (const AudioCodec& codec : acd->codecs()) {
-      if (FindMatchingCodec<AudioCodec>(acd->codecs(), audio_codecs, codec,
-                                        nullptr)) {
-        filtered_codecs.push_back(codec);
-      }
-    }
-  }
-  // Add other supported audio codecs.
-  AudioCodec found_codec;
-  for (const AudioCodec& codec : supported_audio_codecs) {
-    if (FindMatchingCodec<AudioCodec>(supported_audio_codecs, audio_codecs,
-                                      codec, &found_codec) &&
-        !FindMatchingCodec<AudioCodec>(supported_audio_codecs, filtered_codecs,
-                                       codec, nullptr)) {
-      // Use the |found_codec| from |audio_codecs| because it has the correctly
-      // mapped payload type.
-      filtered_codecs.push_back(found_codec);
-    }
-  }
+  const AudioCodecs& current_codecs =
+      GetCurrentCodecs<AudioCodec>(current_content);
+  const AudioCodecs& filtered_codecs = memos->audio_offer_codecs.Get(
+      std::tie(media_description_options.direction, current_codecs), [&] {
+        // Filter audio_codecs (which includes all codecs, with correctly
+        // remapped payload types) based on transceiver direction.
+        const AudioCodecs& supported_audio_codecs =
+            GetAudioCodecsForOffer(media_description_options.direction);
+
+        AudioCodecs section_codecs;
+        // Add the codecs from current content if it exists and is not being
+        // recycled.
+        for (const AudioCodec& codec : current_codecs) {
+          if (FindMatchingCodec<AudioCodec>(current_codecs, audio_codecs, codec,
+                                            nullptr)) {
+            section_codecs.push_back(codec);
+          }
+        }
+        // Add other supported audio codecs.
+        AudioCodec found_codec;
+        for (const AudioCodec& codec : supported_audio_codecs) {
+          if (FindMatchingCodec<AudioCodec>(supported_audio_codecs,
+                                            audio_codecs, codec,
+                                            &found_codec) &&
+              !FindMatchingCodec<AudioCodec>(supported_audio_codecs,
+                                             section_codecs, codec, nullptr)) {
+            // Use the |found_codec| from |audio_codecs| because it has the
+            // correctly mapped payload type.
+            section_codecs.push_back(found_codec);
+          }
+        }
+        return section_codecs;
+      });
 
   cricket::SecurePolicy sdes_policy =
       IsDtlsActive(current_content, current_description) ? cricket::SEC_DISABLED
@@ -1906,6 +1979,7 @@ bool MediaSessionDescriptionFactory::AddVideoContentForOffer(
     const SessionDescription* current_description,
     const RtpHeaderExtensions& video_rtp_extensions,
     const VideoCodecs& video_codecs,
+    SectionMemos* memos,
     StreamParamsVec* current_streams,
     SessionDescription* desc) const {
   cricket::SecurePolicy sdes_policy =
@@ -1917,31 +1991,35 @@ bool MediaSessionDescriptionFactory::AddVideoContentForOffer(
   GetSupportedVideoSdesCryptoSuiteNames(session_options.crypto_options,
                                         &crypto_suites);
 
-  VideoCodecs filtered_codecs;
-  // Add the codecs from current content if it exists and is not being recycled.
-  if (current_content && !current_content->rejected) {
+  if (current_content && !current_content->rejected)
     RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_VIDEO));
-    const VideoContentDescription* vcd =
-        current_content->media_description()->as_video();
-    for (const VideoCodec& codec : vcd->codecs()) {
-      if (FindMatchingCodec<VideoCodec>(vcd->codecs(), video_codecs, codec,
-                                        nullptr)) {
-        filtered_codecs.push_back(codec);
-      }
-    }
-  }
-  // Add other supported video codecs.
-  VideoCodec found_codec;
-  for (const VideoCodec& codec : video_codecs_) {
-    if (FindMatchingCodec<VideoCodec>(video_codecs_, video_codecs, codec,
-                                      &found_codec) &&
-        !FindMatchingCodec<VideoCodec>(video_codecs_, filtered_codecs, codec,
-                                       nullptr)) {
-      // Use the |found_codec| from |video_codecs| because it has the correctly
-      // mapped payload type.
-      filtered_codecs.push_back(found_codec);
-    }
-  }
+  const VideoCodecs& current_codecs =
+      GetCurrentCodecs<VideoCodec>(current_content);
+  const VideoCodecs& filtered_codecs =
+      memos->video_offer_codecs.Get(std::tie(current_codecs), [&] {
+        VideoCodecs section_codecs;
+        // Add the codecs from current content if it exists and is not being
+        // recycled.
+        for (const VideoCodec& codec : current_codecs) {
+          if (FindMatchingCodec<VideoCodec>(current_codecs, video_codecs, codec,
+                                            nullptr)) {
+            section_codecs.push_back(codec);
+          }
+        }
+        // Add other supported video codecs.
+        VideoCodec found_codec;
+        for (const VideoCodec& codec : video_codecs_) {
+          if (FindMatchingCodec<VideoCodec>(video_codecs_, video_codecs, codec,
+                                            &found_codec) &&
+              !FindMatchingCodec<VideoCodec>(video_codecs_, section_codecs,
+                                             codec, nullptr)) {
+            // Use the |found_codec| from |video_codecs| because it has the
+            // correctly mapped payload type.
+            section_codecs.push_back(found_codec);
+          }
+        }
+        return section_codecs;
+      });
 
   if (!CreateMediaContentOffer(
           media_description_options.sender_options, session_options,
@@ -2055,6 +2133,7 @@ bool MediaSessionDescriptionFactory::AddAudioContentForAnswer(
     const SessionDescription* current_description,
     const TransportInfo* bundle_transport,
     const AudioCodecs& audio_codecs,
+    SectionMemos* memos,
     StreamParamsVec* current_streams,
     SessionDescription* answer) const {
   RTC_CHECK(IsMediaContentOfType(offer_content, MEDIA_TYPE_AUDIO));
@@ -2075,33 +2154,53 @@ bool MediaSessionDescriptionFactory::AddAudioContentForAnswer(
   auto wants_rtd = media_description_options.direction;
   auto offer_rtd = offer_audio_description->direction();
   auto answer_rtd = NegotiateRtpTransceiverDirection(offer_rtd, wants_rtd);
-  AudioCodecs supported_audio_codecs =
-      GetAudioCodecsForAnswer(offer_rtd, answer_rtd);
-
-  AudioCodecs filtered_codecs;
-  // Add the codecs from current content if it exists and is not being recycled.
-  if (current_content && !current_content->rejected) {
+  if (current_content && !current_content->rejected)
     RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_AUDIO));
-    const AudioContentDescription* acd =
-        current_content->media_description()->as_audio();
-    for (const AudioCodec& codec : acd->codecs()) {
-      if (FindMatchingCodec<AudioCodec>(acd->codecs(), audio_codecs, codec,
-                                        nullptr)) {
-        filtered_codecs.push_back(codec);
-      }
-    }
-  }
-  // Add other supported audio codecs.
-  for (const AudioCodec& codec : supported_audio_codecs) {
-    if (FindMatchingCodec<AudioCodec>(supported_audio_codecs, audio_codecs,
-                                      codec, nullptr) &&
-        !FindMatchingCodec<AudioCodec>(supported_audio_codecs, filtered_codecs,
-                                       codec, nullptr)) {
-      // We should use the local codec with local parameters and the codec id
-      // would be correctly mapped in |NegotiateCodecs|.
-      filtered_codecs.push_back(codec);
-    }
-  }
+  const AudioCodecs& current_codecs =
+      GetCurrentCodecs<AudioCodec>(current_content);
+  const AudioCodecs& negotiated_codecs = memos->audio_answer_codecs.Get(
+      std::tie(offer_rtd, answer_rtd, current_codecs,
+               offer_audio_description->codecs()),
+      [&] {
+        const AudioCodecs& supported_audio_codecs =
+            GetAudioCodecsForAnswer(offer_rtd, answer_rtd);
+
+        AudioCodecs filtered_codecs;
+        // Add the codecs from current content if it exists and is not being
+        // recycled.
+        for (const AudioCodec& codec : current_codecs) {
+          if (FindMatchingCodec<AudioCodec>(current_codecs, audio_codecs, codec,
+                                            nullptr)) {
+            filtered_codecs.push_back(codec);
+          }
+        }
+        // Add other supported audio codecs.
+        for (const AudioCodec& codec : supported_audio_codecs) {
+          if (FindMatchingCodec<AudioCodec>(supported_audio_codecs,
+                                            audio_codecs, codec, nullptr) &&
+              !FindMatchingCodec<AudioCodec>(supported_audio_codecs,
+                                             filtered_codecs, codec, nullptr)) {
+            // We should use the local codec with local parameters and the
+            // codec id would be correctly mapped in |NegotiateCodecs|.
+            filtered_codecs.push_back(codec);
+          }
+        }
+
+        AudioCodecs negotiated;
+        NegotiateCodecs(filtered_codecs, offer_audio_description->codecs(),
+                        &negotiated);
+        return negotiated;
+      });
+  const RtpHeaderExtensions& negotiated_rtp_extensions =
+      memos->audio_answer_extensions.Get(
+          std::tie(offer_audio_description->rtp_header_extensions()), [&] {
+            RtpHeaderExtensions negotiated;
+            NegotiateRtpHeaderExtensions(
+                audio_rtp_header_extensions(session_options.is_unified_plan),
+                offer_audio_description->rtp_header_extensions(),
+                enable_encrypted_rtp_header_extensions_, &negotiated);
+            return negotiated;
+          });
 
   bool bundle_enabled = offer_description->HasGroup(GROUP_TYPE_BUNDLE) &&
                         session_options.bundle_enabled;
@@ -2112,10 +2211,9 @@ bool MediaSessionDescriptionFactory::AddAudioContentForAnswer(
       audio_transport->secure() ? cricket::SEC_DISABLED : secure();
   if (!CreateMediaContentAnswer(
           offer_audio_description, media_description_options, session_options,
-          filtered_codecs, sdes_policy, GetCryptos(current_content),
-          audio_rtp_header_extensions(session_options.is_unified_plan),
-          enable_encrypted_rtp_header_extensions_, current_streams,
-          bundle_enabled, audio_answer.get())) {
+          negotiated_codecs, sdes_policy, GetCryptos(current_content),
+          negotiated_rtp_extensions, current_streams, bundle_enabled,
+          audio_answer.get())) {
     return false;  // Fails the session setup.
   }
 
@@ -2149,6 +2247,7 @@ bool MediaSessionDescriptionFactory::AddVideoContentForAnswer(
     const SessionDescription* current_description,
     const TransportInfo* bundle_transport,
     const VideoCodecs& video_codecs,
+    SectionMemos* memos,
     StreamParamsVec* current_streams,
     SessionDescription* answer) const {
   RTC_CHECK(IsMediaContentOfType(offer_content, MEDIA_TYPE_VIDEO));
@@ -2163,30 +2262,48 @@ bool MediaSessionDescriptionFactory::AddVideoContentForAnswer(
     return false;
   }
 
-  VideoCodecs filtered_codecs;
-  // Add the codecs from current content if it exists and is not being recycled.
-  if (current_content && !current_content->rejected) {
+  if (current_content && !current_content->rejected)
     RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_VIDEO));
-    const VideoContentDescription* vcd =
-        current_content->media_description()->as_video();
-    for (const VideoCodec& codec : vcd->codecs()) {
-      if (FindMatchingCodec<VideoCodec>(vcd->codecs(), video_codecs, codec,
-                                        nullptr)) {
-        filtered_codecs.push_back(codec);
-      }
-    }
-  }
-  // Add other supported video codecs.
-  for (const VideoCodec& codec : video_codecs_) {
-    if (FindMatchingCodec<VideoCodec>(video_codecs_, video_codecs, codec,
-                                      nullptr) &&
-        !FindMatchingCodec<VideoCodec>(video_codecs_, filtered_codecs, codec,
-                                       nullptr)) {
-      // We should use the local codec with local parameters and the codec id
-      // would be correctly mapped in |NegotiateCodecs|.
-      filtered_codecs.push_back(codec);
-    }
-  }
+  const VideoCodecs& current_codecs =
+      GetCurrentCodecs<VideoCodec>(current_content);
+  const VideoCodecs& negotiated_codecs = memos->video_answer_codecs.Get(
+      std::tie(current_codecs, offer_video_description->codecs()), [&] {
+        VideoCodecs filtered_codecs;
+        // Add the codecs from current content if it exists and is not being
+        // recycled.
+        for (const VideoCodec& codec : current_codecs) {
+          if (FindMatchingCodec<VideoCodec>(current_codecs, video_codecs, codec,
+                                            nullptr)) {
+            filtered_codecs.push_back(codec);
+          }
+        }
+        // Add other supported video codecs.
+        for (const VideoCodec& codec : video_codecs_) {
+          if (FindMatchingCodec<VideoCodec>(video_codecs_, video_codecs, codec,
+                                            nullptr) &&
+              !FindMatchingCodec<VideoCodec>(video_codecs_, filtered_codecs,
+                                             codec, nullptr)) {
+            // We should use the local codec with local parameters and the
+            // codec id would be correctly mapped in |NegotiateCodecs|.
+            filtered_codecs.push_back(codec);
+          }
+        }
+
+        VideoCodecs negotiated;
+        NegotiateCodecs(filtered_codecs, offer_video_description->codecs(),
+                        &negotiated);
+        return negotiated;
+      });
+  const RtpHeaderExtensions& negotiated_rtp_extensions =
+      memos->video_answer_extensions.Get(
+          std::tie(offer_video_description->rtp_header_extensions()), [&] {
+            RtpHeaderExtensions negotiated;
+            NegotiateRtpHeaderExtensions(
+                video_rtp_header_extensions(session_options.is_unified_plan),
+                offer_video_description->rtp_header_extensions(),
+                enable_encrypted_rtp_header_extensions_, &negotiated);
+            return negotiated;
+          });
 
   bool bundle_enabled = offer_description->HasGroup(GROUP_TYPE_BUNDLE) &&
                         session_options.bundle_enabled;
@@ -2198,10 +2315,9 @@ bool MediaSessionDescriptionFactory::AddVideoContentForAnswer(
       video_transport->secure() ? cricket::SEC_DISABLED : secure();
   if (!CreateMediaContentAnswer(
           offer_video_description, media_description_options, session_options,
-          filtered_codecs, sdes_policy, GetCryptos(current_content),
-          video_rtp_header_extensions(session_options.is_unified_plan),
-          enable_encrypted_rtp_header_extensions_, current_streams,
-          bundle_enabled, video_answer.get())) {
+          negotiated_codecs, sdes_policy, GetCryptos(current_content),
+          negotiated_rtp_extensions, current_streams, bundle_enabled,
+          video_answer.get())) {
     return false;  // Failed the sessin setup.
   }
   bool secure = bundle_transport ? bundle_transport->description.secure()
@@ -2255,11 +2371,14 @@ bool MediaSessionDescriptionFactory::AddDataContentForAnswer(
   RTC_CHECK(IsMediaContentOfType(offer_content, MEDIA_TYPE_DATA));
   const DataContentDescription* offer_data_description =
       offer_content->media_description()->as_data();
+  DataCodecs negotiated_codecs;
+  NegotiateCodecs(data_codecs, offer_data_description->codecs(),
+                  &negotiated_codecs);
   if (!CreateMediaContentAnswer(
           offer_data_description, media_description_options, session_options,
-          data_codecs, sdes_policy, GetCryptos(current_content),
-          RtpHeaderExtensions(), enable_encrypted_rtp_header_extensions_,
-          current_streams, bundle_enabled, data_answer.get())) {
+          negotiated_codecs, sdes_policy, GetCryptos(current_content),
+          RtpHeaderExtensions(), current_streams, bundle_enabled,
+          data_answer.get())) {
     return false;  // Fails the session setup.
   }
 
@@ -165,6 +165,9 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description) const;
 
  private:
+  // What was computed for the m= sections of one offer or answer.
+  struct SectionMemos;
+
   const AudioCodecs& GetAudioCodecsForOffer(
       const webrtc::RtpTransceiverDirection& direction) const;
   const AudioCodecs& GetAudioCodecsForAnswer(
@@ -210,6 +213,7 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description,
       const RtpHeaderExtensions& audio_rtp_extensions,
       const AudioCodecs& audio_codecs,
+      SectionMemos* memos,
       StreamParamsVec* current_streams,
       SessionDescription* desc) const;
 
@@ -220,6 +224,7 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description,
       const RtpHeaderExtensions& video_rtp_extensions,
       const VideoCodecs& video_codecs,
+      SectionMemos* memos,
       StreamParamsVec* current_streams,
       SessionDescription* desc) const;
 
@@ -241,6 +246,7 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description,
       const TransportInfo* bundle_transport,
       const AudioCodecs& audio_codecs,
+      SectionMemos* memos,
       StreamParamsVec* current_streams,
       SessionDescription* answer) const;
 
@@ -253,6 +259,7 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description,
       const TransportInfo* bundle_transport,
       const VideoCodecs& video_codecs,
+      SectionMemos* memos,
       StreamParamsVec* current_streams,
       SessionDescription* answer) const;
 
@@ -1307,6 +1307,74 @@ TEST_F(MediaSessionDescriptionFactoryTest, TestOfferAnswerWithRtpExtensions) {
       GetFirstVideoContentDescription(answer.get())->rtp_header_extensions());
 }
 
+// Sections with the same inputs share what is computed for them, and get the
+// same codecs and RTP header extensions as a section on its own.
+TEST_F(MediaSessionDescriptionFactoryTest,
+       TestOfferAnswerWithManySectionsMatchesSingleSection) {
+  f1_.set_audio_rtp_header_extensions(MAKE_VECTOR(kAudioRtpExtension1));
+  f1_.set_video_rtp_header_extensions(MAKE_VECTOR(kVideoRtpExtension1));
+  f2_.set_audio_rtp_header_extensions(MAKE_VECTOR(kAudioRtpExtension2));
+  f2_.set_video_rtp_header_extensions(MAKE_VECTOR(kVideoRtpExtension2));
+  const RtpTransceiverDirection kDirections[] = {
+      RtpTransceiverDirection::kSendRecv, RtpTransceiverDirection::kRecvOnly};
+
+  std::unique_ptr<SessionDescription> single_offers[2];
+  std::unique_ptr<SessionDescription> single_answers[2];
+  for (int i = 0; i < 2; ++i) {
+    MediaSessionOptions opts;
+    AddAudioVideoSections(kDirections[i], &opts);
+    single_offers[i].reset(f1_.CreateOffer(opts, nullptr));
+    ASSERT_TRUE(single_offers[i]);
+    single_answers[i].reset(
+        f2_.CreateAnswer(single_offers[i].get(), opts, nullptr));
+    ASSERT_TRUE(single_answers[i]);
+  }
+
+  MediaSessionOptions opts;
+  for (int i = 0; i < 20; ++i) {
+    AddMediaSection(MEDIA_TYPE_AUDIO, "audio" + std::to_string(i),
+                    kDirections[i % 2], kActive, &opts);
+    AddMediaSection(MEDIA_TYPE_VIDEO, "video" + std::to_string(i),
+                    kDirections[i % 2], kActive, &opts);
+  }
+  std::unique_ptr<SessionDescription> offer(f1_.CreateOffer(opts, nullptr));
+  ASSERT_TRUE(offer);
+  std::unique_ptr<SessionDescription> answer(
+      f2_.CreateAnswer(offer.get(), opts, nullptr));
+  ASSERT_TRUE(answer);
+  // Also with the codecs of the current sections.
+  std::unique_ptr<SessionDescription> reoffer(
+      f1_.CreateOffer(opts, offer.get()));
+  ASSERT_TRUE(reoffer);
+
+  auto expect_same_as_single = [](const SessionDescription* description,
+                                  const SessionDescription* single,
+                                  size_t index) {
+    const MediaContentDescription* media =
+        description->contents()[index].media_description();
+    const MediaContentDescription* single_media =
+        single->contents()[index % 2].media_description();
+    if (media->type() == MEDIA_TYPE_AUDIO) {
+      EXPECT_EQ(single_media->as_audio()->codecs(),
+                media->as_audio()->codecs());
+    } else {
+      EXPECT_EQ(single_media->as_video()->codecs(),
+                media->as_video()->codecs());
+    }
+    EXPECT_EQ(single_media->rtp_header_extensions(),
+              media->rtp_header_extensions());
+  };
+  ASSERT_EQ(40u, answer->contents().size());
+  for (size_t i = 0; i < 40; ++i) {
+    const SessionDescription* single_offer = single_offers[(i / 2) % 2].get();
+    const SessionDescription* single_answer =
+        single_answers[(i / 2) % 2].get();
+    expect_same_as_single(offer.get(), single_offer, i);
+    expect_same_as_single(reoffer.get(), single_offer, i);
+    expect_same_as_single(answer.get(), single_answer, i);
+  }
+}
+
 TEST_F(MediaSessionDescriptionFactoryTest,
        TestOfferAnswerWithEncryptedRtpExtensionsBoth) {
   MediaSessionOptions opts;
@@ -693,6 +693,8 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
     SdpSemantics sdp_semantics;
     absl::optional<rtc::AdapterType> network_preference;
     bool active_reset_srtp_params;
+    absl::optional<size_t> data_channel_max_queued_bytes;
+    absl::optional<size_t> data_channel_memory_budget_bytes;
   };
   static_assert(sizeof(stuff_being_tested_for_equality) == sizeof(*this),
                 "Did you add something to RTCConfiguration and forget to "
@@ -740,7 +742,10 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
          turn_customizer == o.turn_customizer &&
          sdp_semantics == o.sdp_semantics &&
          network_preference == o.network_preference &&
-         active_reset_srtp_params == o.active_reset_srtp_params;
+         active_reset_srtp_params == o.active_reset_srtp_params &&
+         data_channel_max_queued_bytes == o.data_channel_max_queued_bytes &&
+         data_channel_memory_budget_bytes ==
+             o.data_channel_memory_budget_bytes;
 }
 
 bool PeerConnectionInterface::RTCConfiguration::operator!=(
@@ -818,9 +823,11 @@ bool ConvertConstraintsToOfferAnswerOptions(
 }
 
 PeerConnection::PeerConnection(PeerConnectionFactory* factory,
+                               rtc::Thread* network_thread,
                                std::unique_ptr<RtcEventLog> event_log,
                                std::unique_ptr<Call> call)
     : factory_(factory),
+      network_thread_(network_thread),
       event_log_(std::move(event_log)),
       rtcp_cname_(GenerateRtcpCname()),
       local_streams_(StreamCollection::Create()),
@@ -983,12 +990,17 @@ bool PeerConnection::Initialize(
   transport_controller_->SignalDtlsHandshakeError.connect(
       this, &PeerConnection::OnTransportControllerDtlsHandshakeError);
 
-  sctp_factory_ = factory_->CreateSctpTransportInternalFactory();
+  sctp_factory_ =
+      factory_->CreateSctpTransportInternalFactory(network_thread());
 
   stats_.reset(new StatsCollector(this));
   stats_collector_ = RTCStatsCollector::Create(this);
 
   configuration_ = configuration;
+  if (configuration.data_channel_memory_budget_bytes) {
+    data_channel_memory_budget_ = DataChannelMemoryBudget::Create(
+        *configuration.data_channel_memory_budget_bytes);
+  }
 
   // Obtain a certificate from RTCConfiguration if any were provided (optional).
   rtc::scoped_refptr<rtc::RTCCertificate> certificate;
@@ -2043,6 +2055,11 @@ RTCError PeerConnection::ApplyLocalDescription(
   // The session description to apply now must be accessed by
   // |local_description()|.
   RTC_DCHECK(local_description());
+  // Until its media is pushed down, the new description cannot be used to
+  // skip unchanged media sections of the next one.
+  const SessionDescriptionInterface* pushed_down_local_description =
+      local_media_pushed_down_ ? old_local_description : nullptr;
+  local_media_pushed_down_ = false;
 
   RTCError error = PushdownTransportDescription(cricket::CS_LOCAL, type);
   if (!error.ok()) {
@@ -2108,7 +2125,8 @@ RTCError PeerConnection::ApplyLocalDescription(
   }
 
   error = UpdateSessionState(type, cricket::CS_LOCAL,
-                             local_description()->description());
+                             local_description()->description(),
+                             pushed_down_local_description);
   if (!error.ok()) {
     return error;
   }
@@ -2312,6 +2330,9 @@ RTCError PeerConnection::ApplyRemoteDescription(
   // The session description to apply now must be accessed by
   // |remote_description()|.
   RTC_DCHECK(remote_description());
+  const SessionDescriptionInterface* pushed_down_remote_description =
+      remote_media_pushed_down_ ? old_remote_description : nullptr;
+  remote_media_pushed_down_ = false;
 
   RTCError error = PushdownTransportDescription(cricket::CS_REMOTE, type);
   if (!error.ok()) {
@@ -2343,7 +2364,8 @@ RTCError PeerConnection::ApplyRemoteDescription(
   // NOTE: Candidates allocation will be initiated only when
   // SetLocalDescription is called.
   error = UpdateSessionState(type, cricket::CS_REMOTE,
-                             remote_description()->description());
+                             remote_description()->description(),
+                             pushed_down_remote_description);
   if (!error.ok()) {
     return error;
   }
@@ -3135,7 +3157,11 @@ RTCError PeerConnection::SetBitrate(const BitrateSettings& bitrate) {
     }
   }
 
-  RTC_DCHECK(call_.get());
+  if (!call_) {
+    LOG_AND_RETURN_ERROR(RTCErrorType::UNSUPPORTED_OPERATION,
+                         "SetBitrate needs a media engine");
+  }
+  client_bitrate_settings_ = bitrate;
   call_->GetTransportControllerSend()->SetClientBitratePreferences(bitrate);
 
   return RTCError::OK();
@@ -3149,14 +3175,15 @@ void PeerConnection::SetBitrateAllocationStrategy(
     rtc::BitrateAllocationStrategy* strategy_raw =
         bitrate_allocation_strategy.release();
     auto functor = [this, strategy_raw]() {
-      call_->SetBitrateAllocationStrategy(
+      SetBitrateAllocationStrategy(
           absl::WrapUnique<rtc::BitrateAllocationStrategy>(strategy_raw));
     };
     worker_thread->Invoke<void>(RTC_FROM_HERE, functor);
     return;
   }
-  RTC_DCHECK(call_.get());
-  call_->SetBitrateAllocationStrategy(std::move(bitrate_allocation_strategy));
+  if (call_) {
+    call_->SetBitrateAllocationStrategy(std::move(bitrate_allocation_strategy));
+  }
 }
 
 void PeerConnection::SetAudioPlayout(bool playout) {
@@ -3166,9 +3193,11 @@ void PeerConnection::SetAudioPlayout(bool playout) {
         rtc::Bind(&PeerConnection::SetAudioPlayout, this, playout));
     return;
   }
-  auto audio_state =
-      factory_->channel_manager()->media_engine()->GetAudioState();
-  audio_state->SetPlayout(playout);
+  cricket::MediaEngineInterface* media_engine =
+      factory_->channel_manager()->media_engine();
+  if (media_engine) {
+    media_engine->GetAudioState()->SetPlayout(playout);
+  }
 }
 
 void PeerConnection::SetAudioRecording(bool recording) {
@@ -3178,9 +3207,11 @@ void PeerConnection::SetAudioRecording(bool recording) {
         rtc::Bind(&PeerConnection::SetAudioRecording, this, recording));
     return;
   }
-  auto audio_state =
-      factory_->channel_manager()->media_engine()->GetAudioState();
-  audio_state->SetRecording(recording);
+  cricket::MediaEngineInterface* media_engine =
+      factory_->channel_manager()->media_engine();
+  if (media_engine) {
+    media_engine->GetAudioState()->SetRecording(recording);
+  }
 }
 
 std::unique_ptr<rtc::SSLCertificate>
@@ -3308,11 +3339,20 @@ void PeerConnection::Close() {
       RTC_FROM_HERE, rtc::Bind(&cricket::PortAllocator::DiscardCandidatePool,
                                port_allocator_.get()));
 
-  worker_thread()->Invoke<void>(RTC_FROM_HERE, [this] {
+  const bool save_bandwidth_estimate = bandwidth_estimate_network_id_ &&
+                                       factory_->bandwidth_estimate_store();
+  int bandwidth_estimate_bps = 0;
+  worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    if (save_bandwidth_estimate && call_)
+      bandwidth_estimate_bps = call_->GetStats().send_bandwidth_bps;
     call_.reset();
     // The event log must outlive call (and any other object that uses it).
     event_log_.reset();
   });
+  if (bandwidth_estimate_bps > 0) {
+    factory_->bandwidth_estimate_store()->SaveEstimateBps(
+        *bandwidth_estimate_network_id_, bandwidth_estimate_bps);
+  }
   ReportUsagePattern();
   // The .h file says that observer can be discarded after close() returns.
   // Make sure this is true.
@@ -4476,6 +4516,10 @@ rtc::scoped_refptr<DataChannel> PeerConnection::InternalCreateDataChannel(
   }
   InternalDataChannelInit new_config =
       config ? (*config) : InternalDataChannelInit();
+  if (configuration_.data_channel_max_queued_bytes) {
+    new_config.max_queued_bytes = *configuration_.data_channel_max_queued_bytes;
+  }
+  new_config.memory_budget = data_channel_memory_budget_;
   if (data_channel_type() == cricket::DCT_SCTP) {
     if (new_config.id < 0) {
       rtc::SSLRole role;
@@ -4879,7 +4923,8 @@ void PeerConnection::SetSessionError(SessionError error,
 RTCError PeerConnection::UpdateSessionState(
     SdpType type,
     cricket::ContentSource source,
-    const cricket::SessionDescription* description) {
+    const cricket::SessionDescription* description,
+    const SessionDescriptionInterface* old_description) {
   RTC_DCHECK_RUN_ON(signaling_thread());
 
   // If there's already a pending error then no state transition should happen.
@@ -4908,7 +4953,7 @@ RTCError PeerConnection::UpdateSessionState(
 
   // Update internal objects according to the session description's media
   // descriptions.
-  RTCError error = PushdownMediaDescription(type, source);
+  RTCError error = PushdownMediaDescription(type, source, old_description);
   if (!error.ok()) {
     return error;
   }
@@ -4918,13 +4963,19 @@ RTCError PeerConnection::UpdateSessionState(
 
 RTCError PeerConnection::PushdownMediaDescription(
     SdpType type,
-    cricket::ContentSource source) {
+    cricket::ContentSource source,
+    const SessionDescriptionInterface* old_description) {
   const SessionDescriptionInterface* sdesc =
       (source == cricket::CS_LOCAL ? local_description()
                                    : remote_description());
   RTC_DCHECK(sdesc);
 
   // Push down the new SDP media section for each audio/video transceiver.
+  // Setting the content takes a few thread hops per channel, so when only a
+  // few of many media sections change, skipping the others keeps the cost
+  // of renegotiation with the size of the change.
+  std::vector<std::pair<cricket::BaseChannel*, const MediaContentDescription*>>
+      channels_to_update;
   for (auto transceiver : transceivers_) {
     const ContentInfo* content_info =
         FindMediaSectionForTransceiver(transceiver, sdesc);
@@ -4937,35 +4988,64 @@ RTCError PeerConnection::PushdownMediaDescription(
     if (!content_desc) {
       continue;
     }
-    std::string error;
-    bool success = (source == cricket::CS_LOCAL)
-                       ? channel->SetLocalContent(content_desc, type, &error)
-                       : channel->SetRemoteContent(content_desc, type, &error);
-    if (!success) {
-      LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, std::move(error));
+    // Skip the section if it has not changed, unless the channel does not
+    // have the old content because it was created since or failed to take it.
+    const ContentInfo* old_content_info =
+        old_description
+            ? FindMediaSectionForTransceiver(transceiver, old_description)
+            : nullptr;
+    if (old_content_info && !old_content_info->rejected &&
+        old_content_info->media_description() &&
+        old_content_info->media_description()->Equals(*content_desc) &&
+        (source == cricket::CS_LOCAL ? channel->has_local_content()
+                                     : channel->has_remote_content())) {
+      continue;
     }
+    channels_to_update.emplace_back(channel, content_desc);
   }
+  const size_t num_transceiver_channels = channels_to_update.size();
 
   // If using the RtpDataChannel, push down the new SDP section for it too.
   if (rtp_data_channel_) {
     const ContentInfo* data_content =
         cricket::GetFirstDataContent(sdesc->description());
-    if (data_content && !data_content->rejected) {
-      const MediaContentDescription* data_desc =
-          data_content->media_description();
-      if (data_desc) {
-        std::string error;
-        bool success =
-            (source == cricket::CS_LOCAL)
-                ? rtp_data_channel_->SetLocalContent(data_desc, type, &error)
-                : rtp_data_channel_->SetRemoteContent(data_desc, type, &error);
+    if (data_content && !data_content->rejected &&
+        data_content->media_description()) {
+      channels_to_update.emplace_back(rtp_data_channel_,
+                                      data_content->media_description());
+    }
+  }
+
+  // Set the content of all the channels in a single worker thread task, in
+  // which the channels then run their worker thread parts inline.
+  size_t num_updated = 0;
+  std::string error;
+  if (!channels_to_update.empty()) {
+    worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+      for (const auto& channel_and_desc : channels_to_update) {
+        cricket::BaseChannel* channel = channel_and_desc.first;
+        bool success = (source == cricket::CS_LOCAL)
+                           ? channel->SetLocalContent(channel_and_desc.second,
+                                                      type, &error)
+                           : channel->SetRemoteContent(channel_and_desc.second,
+                                                       type, &error);
         if (!success) {
-          LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER,
-                               std::move(error));
+          return;
         }
+        ++num_updated;
       }
+    });
+  }
+  if (num_updated >= num_transceiver_channels) {
+    if (source == cricket::CS_LOCAL) {
+      local_media_pushed_down_ = true;
+    } else {
+      remote_media_pushed_down_ = true;
     }
   }
+  if (num_updated < channels_to_update.size()) {
+    LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, std::move(error));
+  }
 
   // Need complete offer/answer with an SCTP m= section before starting SCTP,
   // according to https://tools.ietf.org/html/draft-ietf-mmusic-sctp-sdp-19
@@ -5301,6 +5381,7 @@ void PeerConnection::OnTransportControllerConnectionState(
                           "all transports are writable.";
       SetIceConnectionState(PeerConnectionInterface::kIceConnectionConnected);
       NoteUsageEvent(UsageEvent::ICE_STATE_CONNECTED);
+      SeedBandwidthEstimate();
       break;
     case cricket::kIceConnectionCompleted:
       RTC_LOG(LS_INFO) << "Changing to ICE completed state because "
@@ -5310,6 +5391,7 @@ void PeerConnection::OnTransportControllerConnectionState(
         // If jumping directly from "checking" to "connected",
         // signal "connected" first.
         SetIceConnectionState(PeerConnectionInterface::kIceConnectionConnected);
+        SeedBandwidthEstimate();
       }
       SetIceConnectionState(PeerConnectionInterface::kIceConnectionCompleted);
       NoteUsageEvent(UsageEvent::ICE_STATE_CONNECTED);
@@ -5549,7 +5631,7 @@ cricket::VoiceChannel* PeerConnection::CreateVoiceChannel(
   RTC_DCHECK(rtp_transport);
   cricket::VoiceChannel* voice_channel = channel_manager()->CreateVoiceChannel(
       call_.get(), configuration_.media_config, rtp_transport,
-      signaling_thread(), mid, SrtpRequired(),
+      network_thread(), signaling_thread(), mid, SrtpRequired(),
       factory_->options().crypto_options, audio_options_);
   if (!voice_channel) {
     return nullptr;
@@ -5571,7 +5653,7 @@ cricket::VideoChannel* PeerConnection::CreateVideoChannel(
   RTC_DCHECK(rtp_transport);
   cricket::VideoChannel* video_channel = channel_manager()->CreateVideoChannel(
       call_.get(), configuration_.media_config, rtp_transport,
-      signaling_thread(), mid, SrtpRequired(),
+      network_thread(), signaling_thread(), mid, SrtpRequired(),
       factory_->options().crypto_options, video_options_);
   if (!video_channel) {
     return nullptr;
@@ -5607,8 +5689,9 @@ bool PeerConnection::CreateDataChannel(const std::string& mid) {
         transport_controller_->GetRtpTransport(mid);
     RTC_DCHECK(rtp_transport);
     rtp_data_channel_ = channel_manager()->CreateRtpDataChannel(
-        configuration_.media_config, rtp_transport, signaling_thread(), mid,
-        SrtpRequired(), factory_->options().crypto_options);
+        configuration_.media_config, rtp_transport, network_thread(),
+        signaling_thread(), mid, SrtpRequired(),
+        factory_->options().crypto_options);
     if (!rtp_data_channel_) {
       return false;
     }
@@ -6141,6 +6224,73 @@ void PeerConnection::ReportBestConnectionState(
   }
 }
 
+void PeerConnection::SeedBandwidthEstimate() {
+  BandwidthEstimateStoreInterface* store = factory_->bandwidth_estimate_store();
+  // Only the first connection is seeded; reconnections keep the estimate the
+  // call has.
+  if (!store || bandwidth_estimate_network_id_) {
+    return;
+  }
+  bandwidth_estimate_network_id_ = GetSelectedNetworkId();
+  if (!bandwidth_estimate_network_id_) {
+    return;
+  }
+  absl::optional<int> estimate_bps =
+      store->GetEstimateBps(*bandwidth_estimate_network_id_);
+  if (!estimate_bps || *estimate_bps <= 0) {
+    return;
+  }
+  worker_thread()->Invoke<void>(RTC_FROM_HERE, [this, estimate_bps] {
+    // A start bitrate set by the application takes precedence.
+    if (!call_ || client_bitrate_settings_.start_bitrate_bps) {
+      return;
+    }
+    BitrateSettings settings = client_bitrate_settings_;
+    int start_bitrate_bps = *estimate_bps;
+    if (settings.min_bitrate_bps) {
+      start_bitrate_bps =
+          std::max(start_bitrate_bps, *settings.min_bitrate_bps);
+    }
+    if (settings.max_bitrate_bps) {
+      start_bitrate_bps =
+          std::min(start_bitrate_bps, *settings.max_bitrate_bps);
+    }
+    settings.start_bitrate_bps = start_bitrate_bps;
+    RTC_LOG(LS_INFO) << "Starting bandwidth estimation at the stored estimate "
+                     << start_bitrate_bps << " bps.";
+    call_->GetTransportControllerSend()->SetClientBitratePreferences(settings);
+  });
+}
+
+absl::optional<std::string> PeerConnection::GetSelectedNetworkId() {
+  for (auto transceiver : transceivers_) {
+    cricket::BaseChannel* channel = transceiver->internal()->channel();
+    cricket::TransportStats stats;
+    if (!channel ||
+        !transport_controller_->GetStats(channel->transport_name(), &stats)) {
+      continue;
+    }
+    for (const cricket::TransportChannelStats& channel_stats :
+         stats.channel_stats) {
+      for (const cricket::ConnectionInfo& connection_info :
+           channel_stats.connection_infos) {
+        if (!connection_info.best_connection) {
+          continue;
+        }
+        const cricket::Candidate& local = connection_info.local_candidate;
+        // Relay candidates get a new address for each allocation, so the
+        // server identifies them instead.
+        return rtc::ToString(static_cast<int>(local.network_type())) + "/" +
+               local.network_name() + "/" +
+               (local.type() == RELAY_PORT_TYPE
+                    ? local.url()
+                    : local.address().ipaddr().ToString());
+      }
+    }
+  }
+  return absl::nullopt;
+}
+
 void PeerConnection::ReportNegotiatedCiphers(
     const cricket::TransportStats& stats,
     const std::set<cricket::MediaType>& media_types) {
@@ -6208,8 +6358,11 @@ void PeerConnection::ReportNegotiatedCiphers(
 
 void PeerConnection::OnSentPacket_w(const rtc::SentPacket& sent_packet) {
   RTC_DCHECK(worker_thread()->IsCurrent());
-  RTC_DCHECK(call_);
-  call_->OnSentPacket(sent_packet);
+  // There is no Call without a media engine, but RTP data channels still
+  // send packets.
+  if (call_) {
+    call_->OnSentPacket(sent_packet);
+  }
 }
 
 const std::string PeerConnection::GetTransportName(
@@ -71,9 +71,12 @@ class PeerConnection : public PeerConnectionInternal,
     MAX_VALUE = 0x1000,
   };
 
-  explicit PeerConnection(PeerConnectionFactory* factory,
-                          std::unique_ptr<RtcEventLog> event_log,
-                          std::unique_ptr<Call> call);
+  // |network_thread| is the thread this PeerConnection's transports run on.
+  // It is one of the factory's network threads.
+  PeerConnection(PeerConnectionFactory* factory,
+                 rtc::Thread* network_thread,
+                 std::unique_ptr<RtcEventLog> event_log,
+                 std::unique_ptr<Call> call);
 
   bool Initialize(
       const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -205,9 +208,7 @@ class PeerConnection : public PeerConnectionInternal,
   void Close() override;
 
   // PeerConnectionInternal implementation.
-  rtc::Thread* network_thread() const override {
-    return factory_->network_thread();
-  }
+  rtc::Thread* network_thread() const override { return network_thread_; }
   rtc::Thread* worker_thread() const override {
     return factory_->worker_thread();
   }
@@ -750,13 +751,19 @@ class PeerConnection : public PeerConnectionInternal,
   // Updates the error state, signaling if necessary.
   void SetSessionError(SessionError error, const std::string& error_desc);
 
-  RTCError UpdateSessionState(SdpType type,
-                              cricket::ContentSource source,
-                              const cricket::SessionDescription* description);
+  RTCError UpdateSessionState(
+      SdpType type,
+      cricket::ContentSource source,
+      const cricket::SessionDescription* description,
+      const SessionDescriptionInterface* old_description);
   // Push the media parts of the local or remote session description
-  // down to all of the channels.
-  RTCError PushdownMediaDescription(SdpType type,
-                                    cricket::ContentSource source);
+  // down to all of the channels. If |old_description| is the previous
+  // description of the same side, and was pushed down completely, media
+  // sections that have not changed since are skipped.
+  RTCError PushdownMediaDescription(
+      SdpType type,
+      cricket::ContentSource source,
+      const SessionDescriptionInterface* old_description);
   bool PushdownSctpParameters_n(cricket::ContentSource source);
 
   RTCError PushdownTransportDescription(cricket::ContentSource source,
@@ -882,6 +889,15 @@ class PeerConnection : public PeerConnectionInternal,
   // Gather the usage of IPv4/IPv6 as best connection.
   void ReportBestConnectionState(const cricket::TransportStats& stats);
 
+  // Invoked when ICE connects. Starts bandwidth estimation from the estimate
+  // the factory's BandwidthEstimateStoreInterface has for the network of the
+  // selected candidate pair, if any.
+  void SeedBandwidthEstimate();
+
+  // Returns the id of the network of the selected candidate pair, as used as
+  // key in the BandwidthEstimateStoreInterface.
+  absl::optional<std::string> GetSelectedNetworkId();
+
   void ReportNegotiatedCiphers(const cricket::TransportStats& stats,
                                const std::set<cricket::MediaType>& media_types);
 
@@ -928,6 +944,7 @@ class PeerConnection : public PeerConnectionInternal,
   // PeerConnectionFactoryInterface all instances created using the raw pointer
   // will refer to the same reference count.
   rtc::scoped_refptr<PeerConnectionFactory> factory_;
+  rtc::Thread* const network_thread_;
   PeerConnectionObserver* observer_ = nullptr;
 
   // The EventLog needs to outlive |call_| (and any other object that uses it).
@@ -963,6 +980,9 @@ class PeerConnection : public PeerConnectionInternal,
   std::vector<RtpSenderInfo> local_video_sender_infos_;
 
   SctpSidAllocator sid_allocator_;
+  // Shared by all the data channels, if
+  // RTCConfiguration::data_channel_memory_budget_bytes is set.
+  rtc::scoped_refptr<DataChannelMemoryBudget> data_channel_memory_budget_;
   // label -> DataChannel
   std::map<std::string, rtc::scoped_refptr<DataChannel>> rtp_data_channels_;
   std::vector<rtc::scoped_refptr<DataChannel>> sctp_data_channels_;
@@ -971,6 +991,11 @@ class PeerConnection : public PeerConnectionInternal,
   bool remote_peer_supports_msid_ = false;
 
   std::unique_ptr<Call> call_;
+  // The settings last given to SetBitrate(). Accessed on the worker thread.
+  BitrateSettings client_bitrate_settings_;
+  // The network of the selected candidate pair when ICE first connected, for
+  // which the bandwidth estimate is stored when closing.
+  absl::optional<std::string> bandwidth_estimate_network_id_;
   std::unique_ptr<StatsCollector> stats_;  // A pointer is passed to senders_
   rtc::scoped_refptr<RTCStatsCollector> stats_collector_;
 
@@ -980,6 +1005,10 @@ class PeerConnection : public PeerConnectionInternal,
   // MIDs that have been seen either by SetLocalDescription or
   // SetRemoteDescription over the life of the PeerConnection.
   std::set<std::string> seen_mids_;
+  // Whether the media sections of the current local and remote descriptions
+  // have all been pushed down to the channels.
+  bool local_media_pushed_down_ = false;
+  bool remote_media_pushed_down_ = false;
 
   SessionError session_error_ = SessionError::kNone;
   std::string session_error_desc_;
@@ -34,17 +34,20 @@ using ::testing::Values;
 class PeerConnectionFactoryForDataChannelTest
     : public rtc::RefCountedObject<PeerConnectionFactory> {
  public:
-  PeerConnectionFactoryForDataChannelTest()
+  // Without a media engine and a Call factory if |data_channel_only|, like
+  // CreateDataChannelOnlyPeerConnectionFactory.
+  explicit PeerConnectionFactoryForDataChannelTest(bool data_channel_only)
       : rtc::RefCountedObject<PeerConnectionFactory>(
             rtc::Thread::Current(),
             rtc::Thread::Current(),
             rtc::Thread::Current(),
-            absl::make_unique<cricket::FakeMediaEngine>(),
-            CreateCallFactory(),
+            data_channel_only ? nullptr
+                              : absl::make_unique<cricket::FakeMediaEngine>(),
+            data_channel_only ? nullptr : CreateCallFactory(),
             nullptr) {}
 
   std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory() {
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread) {
     auto factory = absl::make_unique<FakeSctpTransportFactory>();
     last_fake_sctp_transport_factory_ = factory.get();
     return factory;
@@ -111,7 +114,7 @@ class PeerConnectionDataChannelBaseTest : public ::testing::Test {
       const RTCConfiguration& config,
       const PeerConnectionFactoryInterface::Options factory_options) {
     rtc::scoped_refptr<PeerConnectionFactoryForDataChannelTest> pc_factory(
-        new PeerConnectionFactoryForDataChannelTest());
+        new PeerConnectionFactoryForDataChannelTest(data_channel_only_));
     pc_factory->SetOptions(factory_options);
     RTC_CHECK(pc_factory->Initialize());
     auto observer = absl::make_unique<MockPeerConnectionObserver>();
@@ -159,6 +162,7 @@ class PeerConnectionDataChannelBaseTest : public ::testing::Test {
   std::unique_ptr<rtc::VirtualSocketServer> vss_;
   rtc::AutoSocketServerThread main_;
   const SdpSemantics sdp_semantics_;
+  bool data_channel_only_ = false;
 };
 
 class PeerConnectionDataChannelTest
@@ -323,6 +327,20 @@ TEST_P(PeerConnectionDataChannelTest, SctpPortPropagatedFromSdpToTransport) {
   EXPECT_EQ(kNewRecvPort, callee_transport->local_port());
 }
 
+TEST_P(PeerConnectionDataChannelTest, DataChannelOnlyFactoryNegotiatesSctp) {
+  data_channel_only_ = true;
+  auto caller = CreatePeerConnectionWithDataChannel();
+  auto callee = CreatePeerConnection();
+  ASSERT_TRUE(caller);
+  ASSERT_TRUE(callee);
+
+  ASSERT_TRUE(caller->ExchangeOfferAnswerWith(callee.get()));
+  EXPECT_TRUE(caller->sctp_transport_factory()->last_fake_sctp_transport());
+  EXPECT_TRUE(callee->sctp_transport_factory()->last_fake_sctp_transport());
+  EXPECT_EQ(RTCErrorType::UNSUPPORTED_OPERATION,
+            caller->pc()->SetBitrate(BitrateSettings()).type());
+}
+
 INSTANTIATE_TEST_CASE_P(PeerConnectionDataChannelTest,
                         PeerConnectionDataChannelTest,
                         Values(SdpSemantics::kPlanB,
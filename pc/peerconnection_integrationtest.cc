@@ -237,7 +237,7 @@ class PeerConnectionWrapper : public webrtc::PeerConnectionObserver,
     webrtc::PeerConnectionDependencies dependencies(nullptr);
     dependencies.cert_generator = std::move(cert_generator);
     if (!client->Init(nullptr, nullptr, nullptr, std::move(dependencies),
-                      network_thread, worker_thread, nullptr)) {
+                      network_thread, worker_thread, nullptr, nullptr)) {
       delete client;
       return nullptr;
     }
@@ -567,7 +567,9 @@ class PeerConnectionWrapper : public webrtc::PeerConnectionObserver,
             webrtc::PeerConnectionDependencies dependencies,
             rtc::Thread* network_thread,
             rtc::Thread* worker_thread,
-            std::unique_ptr<webrtc::FakeRtcEventLogFactory> event_log_factory) {
+            std::unique_ptr<webrtc::FakeRtcEventLogFactory> event_log_factory,
+            std::unique_ptr<webrtc::BandwidthEstimateStoreInterface>
+                bandwidth_estimate_store) {
     // There's an error in this test code if Init ends up being called twice.
     RTC_DCHECK(!peer_connection_);
     RTC_DCHECK(!peer_connection_factory_);
@@ -605,6 +607,8 @@ class PeerConnectionWrapper : public webrtc::PeerConnectionObserver,
       pc_factory_dependencies.event_log_factory =
           webrtc::CreateRtcEventLogFactory();
     }
+    pc_factory_dependencies.bandwidth_estimate_store =
+        std::move(bandwidth_estimate_store);
     peer_connection_factory_ = webrtc::CreateModularPeerConnectionFactory(
         std::move(pc_factory_dependencies));
 
@@ -985,6 +989,34 @@ class MockRtcEventLogOutput : public webrtc::RtcEventLogOutput {
   MOCK_METHOD1(Write, bool(const std::string&));
 };
 
+// Keeps the bandwidth estimates in a map owned by the test, so that they
+// outlive the PeerConnectionFactory.
+class FakeBandwidthEstimateStore
+    : public webrtc::BandwidthEstimateStoreInterface {
+ public:
+  FakeBandwidthEstimateStore(std::map<std::string, int>* estimates,
+                             std::vector<std::string>* looked_up_network_ids)
+      : estimates_(estimates), looked_up_network_ids_(looked_up_network_ids) {}
+
+  absl::optional<int> GetEstimateBps(const std::string& network_id) override {
+    looked_up_network_ids_->push_back(network_id);
+    auto it = estimates_->find(network_id);
+    if (it == estimates_->end()) {
+      return absl::nullopt;
+    }
+    return it->second;
+  }
+
+  void SaveEstimateBps(const std::string& network_id,
+                       int estimate_bps) override {
+    (*estimates_)[network_id] = estimate_bps;
+  }
+
+ private:
+  std::map<std::string, int>* const estimates_;
+  std::vector<std::string>* const looked_up_network_ids_;
+};
+
 // This helper object is used for both specifying how many audio/video frames
 // are expected to be received for a caller/callee. It provides helper functions
 // to specify these expectations. The object initially starts in a state of no
@@ -1158,7 +1190,9 @@ class PeerConnectionIntegrationBaseTest : public testing::Test {
       const PeerConnectionFactory::Options* options,
       const RTCConfiguration* config,
       webrtc::PeerConnectionDependencies dependencies,
-      std::unique_ptr<webrtc::FakeRtcEventLogFactory> event_log_factory) {
+      std::unique_ptr<webrtc::FakeRtcEventLogFactory> event_log_factory,
+      std::unique_ptr<webrtc::BandwidthEstimateStoreInterface>
+          bandwidth_estimate_store = nullptr) {
     RTCConfiguration modified_config;
     if (config) {
       modified_config = *config;
@@ -1173,7 +1207,8 @@ class PeerConnectionIntegrationBaseTest : public testing::Test {
 
     if (!client->Init(constraints, options, &modified_config,
                       std::move(dependencies), network_thread_.get(),
-                      worker_thread_.get(), std::move(event_log_factory))) {
+                      worker_thread_.get(), std::move(event_log_factory),
+                      std::move(bandwidth_estimate_store))) {
       return nullptr;
     }
     return client;
@@ -1282,6 +1317,18 @@ class PeerConnectionIntegrationBaseTest : public testing::Test {
     return caller_ && callee_;
   }
 
+  bool CreatePeerConnectionWrappersWithBandwidthEstimateStore(
+      std::unique_ptr<webrtc::BandwidthEstimateStoreInterface> caller_store) {
+    caller_ = CreatePeerConnectionWrapper(
+        "Caller", nullptr, nullptr, nullptr,
+        webrtc::PeerConnectionDependencies(nullptr), nullptr,
+        std::move(caller_store));
+    callee_ = CreatePeerConnectionWrapper(
+        "Callee", nullptr, nullptr, nullptr,
+        webrtc::PeerConnectionDependencies(nullptr), nullptr);
+    return caller_ && callee_;
+  }
+
   std::unique_ptr<PeerConnectionWrapper>
   CreatePeerConnectionWrapperWithAlternateKey() {
     std::unique_ptr<FakeRTCCertificateGenerator> cert_generator(
@@ -1732,6 +1779,44 @@ TEST_P(PeerConnectionIntegrationTest, EndToEndCallWithSdes) {
                                           webrtc::kEnumCounterKeyProtocolDtls));
 }
 
+// Tests that a PeerConnection stores its bandwidth estimate for the network it
+// connected on when it's closed, and that the next one connecting on that
+// network looks the estimate up.
+TEST_P(PeerConnectionIntegrationTest, StoresBandwidthEstimateOfNetwork) {
+  std::map<std::string, int> estimates;
+  std::vector<std::string> looked_up_network_ids;
+  ASSERT_TRUE(CreatePeerConnectionWrappersWithBandwidthEstimateStore(
+      absl::make_unique<FakeBandwidthEstimateStore>(&estimates,
+                                                    &looked_up_network_ids)));
+  ConnectFakeSignaling();
+  caller()->AddAudioVideoTracks();
+  callee()->AddAudioVideoTracks();
+  caller()->CreateAndSetAndSignalOffer();
+  ASSERT_TRUE_WAIT(SignalingStateStable(), kDefaultTimeout);
+  MediaExpectations media_expectations;
+  media_expectations.ExpectBidirectionalAudioAndVideo();
+  ASSERT_TRUE(ExpectNewFrames(media_expectations));
+  ASSERT_EQ(1u, looked_up_network_ids.size());
+  EXPECT_TRUE(estimates.empty());
+
+  caller()->pc()->Close();
+  ASSERT_EQ(1u, estimates.size());
+  EXPECT_EQ(looked_up_network_ids[0], estimates.begin()->first);
+  EXPECT_LT(0, estimates.begin()->second);
+
+  ASSERT_TRUE(CreatePeerConnectionWrappersWithBandwidthEstimateStore(
+      absl::make_unique<FakeBandwidthEstimateStore>(&estimates,
+                                                    &looked_up_network_ids)));
+  ConnectFakeSignaling();
+  caller()->AddAudioVideoTracks();
+  callee()->AddAudioVideoTracks();
+  caller()->CreateAndSetAndSignalOffer();
+  ASSERT_TRUE_WAIT(SignalingStateStable(), kDefaultTimeout);
+  ASSERT_TRUE(ExpectNewFrames(media_expectations));
+  ASSERT_EQ(2u, looked_up_network_ids.size());
+  EXPECT_EQ(looked_up_network_ids[0], looked_up_network_ids[1]);
+}
+
 // Tests that the GetRemoteAudioSSLCertificate method returns the remote DTLS
 // certificate once the DTLS handshake has finished.
 TEST_P(PeerConnectionIntegrationTest,
@@ -945,6 +945,33 @@ TEST_P(PeerConnectionMediaTest,
   EXPECT_FALSE(caller->SetLocalDescription(caller->CreateOffer()));
 }
 
+// Tests that renegotiating only pushes down the media sections that changed.
+// With the caller's video channel failing to take send codecs, adding an audio
+// track still succeeds, but changing the video section does not.
+TEST_F(PeerConnectionMediaTestUnifiedPlan,
+       RenegotiationSkipsUnchangedMediaSections) {
+  auto caller = CreatePeerConnectionWithAudioVideo();
+  auto callee = CreatePeerConnectionWithAudioVideo();
+
+  ASSERT_TRUE(caller->ExchangeOfferAnswerWith(callee.get()));
+
+  auto video_channel = caller->media_engine()->GetVideoChannel(0);
+  ASSERT_TRUE(video_channel);
+  video_channel->set_fail_set_send_codecs(true);
+
+  caller->AddAudioTrack("a2");
+  ASSERT_TRUE(caller->ExchangeOfferAnswerWith(callee.get()));
+  EXPECT_TRUE(caller->media_engine()->GetVoiceChannel(1));
+
+  auto callee_transceivers = callee->pc()->GetTransceivers();
+  ASSERT_EQ(3u, callee_transceivers.size());
+  callee_transceivers[1]->SetDirection(RtpTransceiverDirection::kRecvOnly);
+  ASSERT_TRUE(
+      callee->SetRemoteDescription(caller->CreateOfferAndSetAsLocal()));
+  EXPECT_FALSE(
+      caller->SetRemoteDescription(callee->CreateAnswerAndSetAsLocal()));
+}
+
 void RenameContent(cricket::SessionDescription* desc,
                    cricket::MediaType media_type,
                    const std::string& new_name) {
@@ -37,7 +37,9 @@
 #include "media/engine/webrtcvideoencoderfactory.h"     // nogncheck
 #include "modules/audio_device/include/audio_device.h"  // nogncheck
 #include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/l4s/l4s_factory.h"
 #include "p2p/base/basicpacketsocketfactory.h"
+#include "p2p/base/pooledasyncresolverfactory.h"
 #include "p2p/client/basicportallocator.h"
 #include "pc/audiotrack.h"
 #include "pc/localaudiosource.h"
@@ -110,6 +112,17 @@ CreateModularPeerConnectionFactory(
                                             pc_factory);
 }
 
+rtc::scoped_refptr<PeerConnectionFactoryInterface>
+CreateDataChannelOnlyPeerConnectionFactory(rtc::Thread* network_thread,
+                                           rtc::Thread* worker_thread,
+                                           rtc::Thread* signaling_thread) {
+  PeerConnectionFactoryDependencies dependencies;
+  dependencies.network_thread = network_thread;
+  dependencies.worker_thread = worker_thread;
+  dependencies.signaling_thread = signaling_thread;
+  return CreateModularPeerConnectionFactory(std::move(dependencies));
+}
+
 PeerConnectionFactory::PeerConnectionFactory(
     rtc::Thread* network_thread,
     rtc::Thread* worker_thread,
@@ -147,7 +160,9 @@ PeerConnectionFactory::PeerConnectionFactory(
       injected_network_controller_factory_(
           std::move(network_controller_factory)),
       bbr_network_controller_factory_(
-          absl::make_unique<BbrNetworkControllerFactory>()) {
+          absl::make_unique<BbrNetworkControllerFactory>()),
+      l4s_network_controller_factory_(
+          absl::make_unique<L4sNetworkControllerFactory>()) {
   if (!network_thread_) {
     owned_network_thread_ = rtc::Thread::CreateWithSocketServer();
     owned_network_thread_->SetName("pc_network_thread", nullptr);
@@ -177,26 +192,59 @@ PeerConnectionFactory::PeerConnectionFactory(
   // RTC_DCHECK(default_adm != NULL);
 }
 
+namespace {
+
+// The STUN and TURN hostnames of all PeerConnections are looked up on this
+// many threads.
+const int kNumResolverThreads = 2;
+
+}  // namespace
+
+struct PeerConnectionFactory::NetworkShard {
+  NetworkShard(rtc::Thread* thread,
+               AsyncResolverFactory* resolver_factory,
+               int resolver_cache_ttl_ms)
+      : thread(thread),
+        network_manager(absl::make_unique<rtc::BasicNetworkManager>()),
+        socket_factory(
+            absl::make_unique<rtc::BasicPacketSocketFactory>(thread)) {
+    socket_factory->SetAsyncResolverFactory(resolver_factory);
+    if (resolver_cache_ttl_ms > 0)
+      socket_factory->EnableAsyncResolverCache(resolver_cache_ttl_ms);
+  }
+
+  rtc::Thread* const thread;
+  // Used only for PeerConnections that aren't given their own allocator.
+  const std::unique_ptr<rtc::BasicNetworkManager> network_manager;
+  const std::unique_ptr<rtc::BasicPacketSocketFactory> socket_factory;
+};
+
 PeerConnectionFactory::PeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies)
     : PeerConnectionFactory(
-          dependencies.network_thread,
+          dependencies.network_thread || dependencies.network_threads.empty()
+              ? dependencies.network_thread
+              : dependencies.network_threads[0],
           dependencies.worker_thread,
           dependencies.signaling_thread,
           std::move(dependencies.media_engine),
           std::move(dependencies.call_factory),
           std::move(dependencies.event_log_factory),
           std::move(dependencies.fec_controller_factory),
-          std::move(dependencies.network_controller_factory)) {}
+          std::move(dependencies.network_controller_factory)) {
+  network_threads_ = std::move(dependencies.network_threads);
+  bandwidth_estimate_store_ = std::move(dependencies.bandwidth_estimate_store);
+  resolver_cache_ttl_ms_ = dependencies.resolver_cache_ttl_ms;
+}
 
 PeerConnectionFactory::~PeerConnectionFactory() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   channel_manager_.reset(nullptr);
 
-  // Make sure |worker_thread_| and |signaling_thread_| outlive
-  // |default_socket_factory_| and |default_network_manager_|.
-  default_socket_factory_ = nullptr;
-  default_network_manager_ = nullptr;
+  // Make sure |worker_thread_| and |signaling_thread_| outlive the default
+  // socket factories and network managers.
+  network_shards_.clear();
+  async_resolver_factory_.reset();
 
   if (wraps_current_thread_)
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
@@ -206,15 +254,15 @@ bool PeerConnectionFactory::Initialize() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   rtc::InitRandom(rtc::Time32());
 
-  default_network_manager_.reset(new rtc::BasicNetworkManager());
-  if (!default_network_manager_) {
-    return false;
+  if (network_threads_.empty()) {
+    network_threads_.push_back(network_thread_);
   }
-
-  default_socket_factory_.reset(
-      new rtc::BasicPacketSocketFactory(network_thread_));
-  if (!default_socket_factory_) {
-    return false;
+  async_resolver_factory_ =
+      absl::make_unique<PooledAsyncResolverFactory>(kNumResolverThreads);
+  for (rtc::Thread* thread : network_threads_) {
+    RTC_DCHECK(thread);
+    network_shards_.push_back(absl::make_unique<NetworkShard>(
+        thread, async_resolver_factory_.get(), resolver_cache_ttl_ms_));
   }
 
   channel_manager_ = absl::make_unique<cricket::ChannelManager>(
@@ -367,22 +415,28 @@ PeerConnectionFactory::CreatePeerConnection(
   RTC_DCHECK(signaling_thread_->IsCurrent());
 
   // Set internal defaults if optional dependencies are not set.
-  if (!dependencies.cert_generator) {
-    dependencies.cert_generator =
-        absl::make_unique<rtc::RTCCertificateGenerator>(signaling_thread_,
-                                                        network_thread_);
-  }
+  rtc::Thread* network_thread = network_thread_;
   if (!dependencies.allocator) {
+    // Only PeerConnections using the default allocator are spread over the
+    // network threads; an injected allocator is assumed to be bound to
+    // |network_thread_|.
+    NetworkShard* shard = NextNetworkShard();
+    network_thread = shard->thread;
     dependencies.allocator.reset(new cricket::BasicPortAllocator(
-        default_network_manager_.get(), default_socket_factory_.get(),
+        shard->network_manager.get(), shard->socket_factory.get(),
         configuration.turn_customizer));
   }
+  if (!dependencies.cert_generator) {
+    dependencies.cert_generator =
+        absl::make_unique<rtc::RTCCertificateGenerator>(signaling_thread_,
+                                                        network_thread);
+  }
 
   // TODO(zstein): Once chromium injects its own AsyncResolverFactory, set
   // |dependencies.async_resolver_factory| to a new
   // |rtc::BasicAsyncResolverFactory| if no factory is provided.
 
-  network_thread_->Invoke<void>(
+  network_thread->Invoke<void>(
       RTC_FROM_HERE,
       rtc::Bind(&cricket::PortAllocator::SetNetworkIgnoreMask,
                 dependencies.allocator.get(), options_.network_ignore_mask));
@@ -397,7 +451,8 @@ PeerConnectionFactory::CreatePeerConnection(
       rtc::Bind(&PeerConnectionFactory::CreateCall_w, this, event_log.get()));
 
   rtc::scoped_refptr<PeerConnection> pc(
-      new rtc::RefCountedObject<PeerConnection>(this, std::move(event_log),
+      new rtc::RefCountedObject<PeerConnection>(this, network_thread,
+                                                std::move(event_log),
                                                 std::move(call)));
   ActionsBeforeInitializeForTesting(pc);
   if (!pc->Initialize(configuration, std::move(dependencies))) {
@@ -431,9 +486,10 @@ rtc::scoped_refptr<AudioTrackInterface> PeerConnectionFactory::CreateAudioTrack(
 }
 
 std::unique_ptr<cricket::SctpTransportInternalFactory>
-PeerConnectionFactory::CreateSctpTransportInternalFactory() {
+PeerConnectionFactory::CreateSctpTransportInternalFactory(
+    rtc::Thread* network_thread) {
 #ifdef HAVE_SCTP
-  return absl::make_unique<cricket::SctpTransportFactory>(network_thread());
+  return absl::make_unique<cricket::SctpTransportFactory>(network_thread);
 #else
   return nullptr;
 #endif
@@ -457,6 +513,14 @@ rtc::Thread* PeerConnectionFactory::network_thread() {
   return network_thread_;
 }
 
+PeerConnectionFactory::NetworkShard*
+PeerConnectionFactory::NextNetworkShard() {
+  RTC_DCHECK(!network_shards_.empty());
+  NetworkShard* shard = network_shards_[next_network_shard_].get();
+  next_network_shard_ = (next_network_shard_ + 1) % network_shards_.size();
+  return shard;
+}
+
 std::unique_ptr<RtcEventLog> PeerConnectionFactory::CreateRtcEventLog_w() {
   RTC_DCHECK_RUN_ON(worker_thread_);
   const auto encoding_type = RtcEventLog::EncodingType::Legacy;
@@ -488,6 +552,10 @@ std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
     RTC_LOG(LS_INFO) << "Using BBR network controller factory";
     call_config.network_controller_factory =
         bbr_network_controller_factory_.get();
+  } else if (CongestionControllerExperiment::L4sControllerEnabled()) {
+    RTC_LOG(LS_INFO) << "Using L4S network controller factory";
+    call_config.network_controller_factory =
+        l4s_network_controller_factory_.get();
   } else if (CongestionControllerExperiment::InjectedControllerEnabled()) {
     RTC_LOG(LS_INFO) << "Using injected network controller factory";
     call_config.network_controller_factory =
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/mediastreaminterface.h"
 #include "api/peerconnectioninterface.h"
@@ -30,6 +31,7 @@ class BasicPacketSocketFactory;
 
 namespace webrtc {
 
+class PooledAsyncResolverFactory;
 class RtcEventLog;
 
 class PeerConnectionFactory : public PeerConnectionFactoryInterface {
@@ -96,13 +98,16 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   void StopAecDump() override;
 
   virtual std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory();
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread);
 
   virtual cricket::ChannelManager* channel_manager();
   virtual rtc::Thread* signaling_thread();
   virtual rtc::Thread* worker_thread();
   virtual rtc::Thread* network_thread();
   const Options& options() const { return options_; }
+  BandwidthEstimateStoreInterface* bandwidth_estimate_store() const {
+    return bandwidth_estimate_store_.get();
+  }
 
  protected:
   PeerConnectionFactory(
@@ -135,8 +140,13 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   virtual ~PeerConnectionFactory();
 
  private:
+  // A network thread together with the default networking objects used by
+  // the PeerConnections assigned to it.
+  struct NetworkShard;
+
   std::unique_ptr<RtcEventLog> CreateRtcEventLog_w();
   std::unique_ptr<Call> CreateCall_w(RtcEventLog* event_log);
+  NetworkShard* NextNetworkShard();
 
   bool wraps_current_thread_;
   rtc::Thread* network_thread_;
@@ -146,8 +156,14 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   std::unique_ptr<rtc::Thread> owned_worker_thread_;
   Options options_;
   std::unique_ptr<cricket::ChannelManager> channel_manager_;
-  std::unique_ptr<rtc::BasicNetworkManager> default_network_manager_;
-  std::unique_ptr<rtc::BasicPacketSocketFactory> default_socket_factory_;
+  // Threads from PeerConnectionFactoryDependencies::network_threads, or just
+  // |network_thread_|.
+  std::vector<rtc::Thread*> network_threads_;
+  // Shared by the default socket factories of all network threads.
+  std::unique_ptr<PooledAsyncResolverFactory> async_resolver_factory_;
+  int resolver_cache_ttl_ms_ = 0;
+  std::vector<std::unique_ptr<NetworkShard>> network_shards_;
+  size_t next_network_shard_ = 0;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine_;
   std::unique_ptr<webrtc::CallFactoryInterface> call_factory_;
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory_;
@@ -156,6 +172,9 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
       injected_network_controller_factory_;
   std::unique_ptr<NetworkControllerFactoryInterface>
       bbr_network_controller_factory_;
+  std::unique_ptr<NetworkControllerFactoryInterface>
+      l4s_network_controller_factory_;
+  std::unique_ptr<BandwidthEstimateStoreInterface> bandwidth_estimate_store_;
 };
 
 }  // namespace webrtc
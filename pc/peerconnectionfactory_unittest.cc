@@ -13,13 +13,18 @@
 #include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/call/callfactoryinterface.h"
 #include "api/mediastreaminterface.h"
+#include "api/peerconnectionproxy.h"
 #include "api/video_codecs/builtin_video_decoder_factory.h"
 #include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "media/base/fakemediaengine.h"
 #include "media/base/fakevideocapturer.h"
 #include "p2p/base/fakeportallocator.h"
+#include "pc/peerconnection.h"
 #include "pc/peerconnectionfactory.h"
 #include "pc/test/fakeaudiocapturemodule.h"
 #include "rtc_base/gunit.h"
@@ -457,3 +462,46 @@ TEST_F(PeerConnectionFactoryTest, LocalRendering) {
   EXPECT_EQ(3, local_renderer.num_rendered_frames());
   EXPECT_FALSE(local_renderer.black_frame());
 }
+
+// Verify that PeerConnections are spread over the pool of network threads
+// given in PeerConnectionFactoryDependencies::network_threads.
+TEST(PeerConnectionFactoryTestInternal, CreatePCUsingNetworkThreadPool) {
+  std::unique_ptr<rtc::Thread> network_thread1 =
+      rtc::Thread::CreateWithSocketServer();
+  std::unique_ptr<rtc::Thread> network_thread2 =
+      rtc::Thread::CreateWithSocketServer();
+  ASSERT_TRUE(network_thread1->Start());
+  ASSERT_TRUE(network_thread2->Start());
+
+  webrtc::PeerConnectionFactoryDependencies dependencies;
+  dependencies.worker_thread = rtc::Thread::Current();
+  dependencies.signaling_thread = rtc::Thread::Current();
+  dependencies.network_threads = {network_thread1.get(),
+                                  network_thread2.get()};
+  dependencies.media_engine = absl::make_unique<cricket::FakeMediaEngine>();
+  dependencies.call_factory = webrtc::CreateCallFactory();
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> factory(
+      webrtc::CreateModularPeerConnectionFactory(std::move(dependencies)));
+  ASSERT_TRUE(factory);
+
+  NullPeerConnectionObserver observer;
+  std::vector<rtc::scoped_refptr<PeerConnectionInterface>> pcs;
+  for (int i = 0; i < 3; ++i) {
+    rtc::scoped_refptr<PeerConnectionInterface> pc(
+        factory->CreatePeerConnection(
+            PeerConnectionInterface::RTCConfiguration(), nullptr,
+            absl::make_unique<FakeRTCCertificateGenerator>(), &observer));
+    ASSERT_TRUE(pc);
+    pcs.push_back(pc);
+  }
+
+  auto network_thread = [](PeerConnectionInterface* pc) {
+    auto* proxy = static_cast<
+        webrtc::PeerConnectionProxyWithInternal<PeerConnectionInterface>*>(pc);
+    return static_cast<webrtc::PeerConnection*>(proxy->internal())
+        ->network_thread();
+  };
+  EXPECT_EQ(network_thread1.get(), network_thread(pcs[0]));
+  EXPECT_EQ(network_thread2.get(), network_thread(pcs[1]));
+  EXPECT_EQ(network_thread1.get(), network_thread(pcs[2]));
+}
@@ -329,6 +329,7 @@ class RTCStatsReportVerifier {
     stats_types.insert(RTCMediaStreamStats::kType);
     stats_types.insert(RTCMediaStreamTrackStats::kType);
     stats_types.insert(RTCPeerConnectionStats::kType);
+    stats_types.insert(RTCMemoryUsageStats::kType);
     stats_types.insert(RTCInboundRTPStreamStats::kType);
     stats_types.insert(RTCOutboundRTPStreamStats::kType);
     stats_types.insert(RTCTransportStats::kType);
@@ -376,6 +377,9 @@ class RTCStatsReportVerifier {
       } else if (stats.type() == RTCPeerConnectionStats::kType) {
         verify_successful &= VerifyRTCPeerConnectionStats(
             stats.cast_to<RTCPeerConnectionStats>());
+      } else if (stats.type() == RTCMemoryUsageStats::kType) {
+        verify_successful &=
+            VerifyRTCMemoryUsageStats(stats.cast_to<RTCMemoryUsageStats>());
       } else if (stats.type() == RTCInboundRTPStreamStats::kType) {
         verify_successful &= VerifyRTCInboundRTPStreamStats(
             stats.cast_to<RTCInboundRTPStreamStats>());
@@ -624,6 +628,15 @@ class RTCStatsReportVerifier {
     return verifier.ExpectAllMembersSuccessfullyTested();
   }
 
+  bool VerifyRTCMemoryUsageStats(const RTCMemoryUsageStats& memory_usage) {
+    RTCStatsVerifier verifier(report_, &memory_usage);
+    verifier.TestMemberIsNonNegative<uint64_t>(
+        memory_usage.audio_jitter_buffer_bytes);
+    verifier.TestMemberIsNonNegative<uint64_t>(
+        memory_usage.data_channel_queued_bytes);
+    return verifier.ExpectAllMembersSuccessfullyTested();
+  }
+
   void VerifyRTCRTPStreamStats(const RTCRTPStreamStats& stream,
                                RTCStatsVerifier* verifier) {
     verifier->TestMemberIsDefined(stream.ssrc);
@@ -761,7 +774,8 @@ TEST_F(RTCStatsIntegrationTest, GetStatsWithSenderSelector) {
       // TODO(hbos): Include RTCRemoteOutboundRtpStreamStats when implemented.
       // TODO(hbos): Include RTCRtpContributingSourceStats when implemented.
       RTCInboundRTPStreamStats::kType, RTCPeerConnectionStats::kType,
-      RTCMediaStreamStats::kType, RTCDataChannelStats::kType,
+      RTCMemoryUsageStats::kType, RTCMediaStreamStats::kType,
+      RTCDataChannelStats::kType,
   };
   RTCStatsReportVerifier(report.get()).VerifyReport(allowed_missing_stats);
   EXPECT_TRUE(report->size());
@@ -778,7 +792,8 @@ TEST_F(RTCStatsIntegrationTest, GetStatsWithReceiverSelector) {
       // TODO(hbos): Include RTCRemoteInboundRtpStreamStats when implemented.
       // TODO(hbos): Include RTCRtpContributingSourceStats when implemented.
       RTCOutboundRTPStreamStats::kType, RTCPeerConnectionStats::kType,
-      RTCMediaStreamStats::kType, RTCDataChannelStats::kType,
+      RTCMemoryUsageStats::kType, RTCMediaStreamStats::kType,
+      RTCDataChannelStats::kType,
   };
   RTCStatsReportVerifier(report.get()).VerifyReport(allowed_missing_stats);
   EXPECT_TRUE(report->size());
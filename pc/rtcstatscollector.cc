@@ -694,6 +694,12 @@ RTCStatsCollector::RequestInfo::RequestInfo(
                   nullptr,
                   std::move(selector)) {}
 
+RTCStatsCollector::RequestInfo RTCStatsCollector::RequestInfo::CreateDelta(
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  return RequestInfo(FilterMode::kDelta, std::move(callback), nullptr,
+                     nullptr);
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     RTCStatsCollector::RequestInfo::FilterMode filter_mode,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
@@ -754,6 +760,11 @@ void RTCStatsCollector::GetStatsReport(
   GetStatsReportInternal(RequestInfo(std::move(selector), std::move(callback)));
 }
 
+void RTCStatsCollector::GetStatsReportDelta(
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  GetStatsReportInternal(RequestInfo::CreateDelta(std::move(callback)));
+}
+
 void RTCStatsCollector::GetStatsReportInternal(
     RTCStatsCollector::RequestInfo request) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
@@ -833,6 +844,7 @@ void RTCStatsCollector::ProducePartialResultsOnSignalingThread(
   ProduceMediaStreamStats_s(timestamp_us, report.get());
   ProduceMediaStreamTrackStats_s(timestamp_us, report.get());
   ProducePeerConnectionStats_s(timestamp_us, report.get());
+  ProduceMemoryUsageStats_s(timestamp_us, report.get());
 
   AddPartialResults(report);
 }
@@ -906,9 +918,15 @@ void RTCStatsCollector::DeliverCachedReport(
   RTC_DCHECK(!requests.empty());
   RTC_DCHECK(cached_report);
 
+  // All delta requests of a batch get the same delta.
+  rtc::scoped_refptr<const RTCStatsReport> delta_report;
   for (const RequestInfo& request : requests) {
     if (request.filter_mode() == RequestInfo::FilterMode::kAll) {
       request.callback()->OnStatsDelivered(cached_report);
+    } else if (request.filter_mode() == RequestInfo::FilterMode::kDelta) {
+      if (!delta_report)
+        delta_report = CreateDeltaReport(cached_report);
+      request.callback()->OnStatsDelivered(delta_report);
     } else {
       bool filter_by_sender_selector;
       rtc::scoped_refptr<RtpSenderInternal> sender_selector;
@@ -929,6 +947,33 @@ void RTCStatsCollector::DeliverCachedReport(
   }
 }
 
+rtc::scoped_refptr<const RTCStatsReport> RTCStatsCollector::CreateDeltaReport(
+    rtc::scoped_refptr<const RTCStatsReport> cached_report) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  rtc::scoped_refptr<const RTCStatsReport> previous_report =
+      std::move(last_delta_report_);
+  last_delta_report_ = cached_report;
+  if (!previous_report)
+    return cached_report;
+  if (previous_report == cached_report) {
+    // The cache was still fresh, nothing changed.
+    return RTCStatsReport::Create(cached_report->timestamp_us());
+  }
+
+  rtc::scoped_refptr<RTCStatsReport> delta_report =
+      RTCStatsReport::Create(cached_report->timestamp_us());
+  for (const RTCStats& stats : *cached_report) {
+    const RTCStats* previous = previous_report->Get(stats.id());
+    if (previous && *previous == stats)
+      continue;
+    std::unique_ptr<RTCStats> delta = stats.copy();
+    if (previous && previous->type() == stats.type())
+      delta->UndefineMembersEqualTo(*previous);
+    delta_report->AddStats(std::move(delta));
+  }
+  return delta_report;
+}
+
 void RTCStatsCollector::ProduceCertificateStats_n(
     int64_t timestamp_us,
     const std::map<std::string, CertificateStatsPair>& transport_cert_stats,
@@ -1160,6 +1205,35 @@ void RTCStatsCollector::ProducePeerConnectionStats_s(
   report->AddStats(std::move(stats));
 }
 
+void RTCStatsCollector::ProduceMemoryUsageStats_s(
+    int64_t timestamp_us, RTCStatsReport* report) const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  uint64_t audio_jitter_buffer_bytes = 0;
+  for (const RtpTransceiverStatsInfo& stats : transceiver_stats_infos_) {
+    const cricket::VoiceMediaInfo* voice_media_info =
+        stats.track_media_info_map->voice_media_info();
+    if (!voice_media_info) {
+      continue;
+    }
+    for (const cricket::VoiceReceiverInfo& voice_receiver_info :
+         voice_media_info->receivers) {
+      audio_jitter_buffer_bytes +=
+          voice_receiver_info.jitter_buffer_memory_bytes;
+    }
+  }
+  uint64_t data_channel_queued_bytes = 0;
+  for (const rtc::scoped_refptr<DataChannel>& data_channel :
+       pc_->sctp_data_channels()) {
+    data_channel_queued_bytes += data_channel->queued_bytes();
+  }
+
+  std::unique_ptr<RTCMemoryUsageStats> stats(
+      new RTCMemoryUsageStats("RTCMemoryUsage", timestamp_us));
+  stats->audio_jitter_buffer_bytes = audio_jitter_buffer_bytes;
+  stats->data_channel_queued_bytes = data_channel_queued_bytes;
+  report->AddStats(std::move(stats));
+}
+
 void RTCStatsCollector::ProduceRTPStreamStats_n(
     int64_t timestamp_us,
     const std::vector<RtpTransceiverStatsInfo>& transceiver_stats_infos,
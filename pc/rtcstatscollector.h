@@ -65,6 +65,14 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // as: no RTP streams are received by selector). The result is empty.
   void GetStatsReport(rtc::scoped_refptr<RtpReceiverInternal> selector,
                       rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Like |GetStatsReport|, but the report only holds the stats objects that
+  // are new or have changed since the previous delta report, and each of them
+  // only has the members that changed defined. The first delta report holds
+  // all stats. Stats that were removed are not reported. Applying the deltas
+  // in order to an empty report yields the latest full report, minus removed
+  // stats, for a fraction of the serialization and callback cost.
+  void GetStatsReportDelta(
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling |GetStatsReport| guarantees fresh stats.
   void ClearCachedStatsReport();
@@ -89,7 +97,12 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
  private:
   class RequestInfo {
    public:
-    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector };
+    enum class FilterMode {
+      kAll,
+      kSenderSelector,
+      kReceiverSelector,
+      kDelta
+    };
 
     // Constructs with FilterMode::kAll.
     explicit RequestInfo(
@@ -102,6 +115,9 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     // applied even if |selector| is null, resulting in an empty report.
     RequestInfo(rtc::scoped_refptr<RtpReceiverInternal> selector,
                 rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+    // Constructs with FilterMode::kDelta.
+    static RequestInfo CreateDelta(
+        rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
 
     FilterMode filter_mode() const { return filter_mode_; }
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback() const {
@@ -154,6 +170,10 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   void DeliverCachedReport(
       rtc::scoped_refptr<const RTCStatsReport> cached_report,
       std::vector<RequestInfo> requests);
+  // The stats of |cached_report| that differ from |last_delta_report_|, which
+  // then becomes |cached_report|.
+  rtc::scoped_refptr<const RTCStatsReport> CreateDeltaReport(
+      rtc::scoped_refptr<const RTCStatsReport> cached_report);
 
   // Produces |RTCCertificateStats|.
   void ProduceCertificateStats_n(
@@ -184,6 +204,9 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // Produces |RTCPeerConnectionStats|.
   void ProducePeerConnectionStats_s(int64_t timestamp_us,
                                     RTCStatsReport* report) const;
+  // Produces |RTCMemoryUsageStats|.
+  void ProduceMemoryUsageStats_s(int64_t timestamp_us,
+                                 RTCStatsReport* report) const;
   // Produces |RTCInboundRTPStreamStats| and |RTCOutboundRTPStreamStats|.
   void ProduceRTPStreamStats_n(
       int64_t timestamp_us,
@@ -244,6 +267,9 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   int64_t cache_timestamp_us_;
   int64_t cache_lifetime_us_;
   rtc::scoped_refptr<const RTCStatsReport> cached_report_;
+  // The full report that the last delta report was computed from. Reports are
+  // immutable, so this shares the cached report instead of copying it.
+  rtc::scoped_refptr<const RTCStatsReport> last_delta_report_;
 
   // Data recorded and maintained by the stats collector during its lifetime.
   // Some stats are produced from this record instead of other components.
@@ -317,6 +317,12 @@ class RTCStatsCollectorWrapper {
     return WaitForReport(callback);
   }
 
+  rtc::scoped_refptr<const RTCStatsReport> GetStatsReportDelta() {
+    rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+    stats_collector_->GetStatsReportDelta(callback);
+    return WaitForReport(callback);
+  }
+
   rtc::scoped_refptr<const RTCStatsReport> GetFreshStatsReport() {
     stats_collector_->ClearCachedStatsReport();
     return GetStatsReport();
@@ -537,6 +543,7 @@ class RTCStatsCollectorTest : public testing::Test {
     std::string receiver_track_id;
     std::string remote_stream_id;
     std::string peer_connection_id;
+    std::string memory_usage_id;
   };
 
   // Sets up the example stats graph (see ASCII art below) used for testing the
@@ -595,6 +602,8 @@ class RTCStatsCollectorTest : public testing::Test {
     graph.remote_stream_id = "RTCMediaStream_RemoteStreamId";
     // peer-connection
     graph.peer_connection_id = "RTCPeerConnection";
+    // memory-usage
+    graph.memory_usage_id = "RTCMemoryUsage";
 
     // Expected stats graph:
     //
@@ -605,10 +614,12 @@ class RTCStatsCollectorTest : public testing::Test {
     //          |        |     |       |
     //          v        v     v       v
     // codec (send)     transport     codec (recv)     peer-connection
+    //
+    // memory-usage
 
     // Verify the stats graph is set up correctly.
     graph.full_report = stats_->GetStatsReport();
-    EXPECT_EQ(graph.full_report->size(), 9u);
+    EXPECT_EQ(graph.full_report->size(), 10u);
     EXPECT_TRUE(graph.full_report->Get(graph.send_codec_id));
     EXPECT_TRUE(graph.full_report->Get(graph.recv_codec_id));
     EXPECT_TRUE(graph.full_report->Get(graph.outbound_rtp_id));
@@ -618,6 +629,7 @@ class RTCStatsCollectorTest : public testing::Test {
     EXPECT_TRUE(graph.full_report->Get(graph.receiver_track_id));
     EXPECT_TRUE(graph.full_report->Get(graph.remote_stream_id));
     EXPECT_TRUE(graph.full_report->Get(graph.peer_connection_id));
+    EXPECT_TRUE(graph.full_report->Get(graph.memory_usage_id));
     const auto& outbound_rtp = graph.full_report->Get(graph.outbound_rtp_id)
                                    ->cast_to<RTCOutboundRTPStreamStats>();
     EXPECT_EQ(*outbound_rtp.codec_id, graph.send_codec_id);
@@ -1319,6 +1331,64 @@ TEST_F(RTCStatsCollectorTest, CollectRTCPeerConnectionStats) {
   }
 }
 
+TEST_F(RTCStatsCollectorTest, CollectRTCMemoryUsageStats) {
+  cricket::VoiceMediaInfo voice_media_info;
+  voice_media_info.receivers.push_back(cricket::VoiceReceiverInfo());
+  voice_media_info.receivers[0].local_stats.push_back(
+      cricket::SsrcReceiverInfo());
+  voice_media_info.receivers[0].local_stats[0].ssrc = 1;
+  voice_media_info.receivers[0].jitter_buffer_memory_bytes = 1000;
+  voice_media_info.receivers.push_back(cricket::VoiceReceiverInfo());
+  voice_media_info.receivers[1].local_stats.push_back(
+      cricket::SsrcReceiverInfo());
+  voice_media_info.receivers[1].local_stats[0].ssrc = 2;
+  voice_media_info.receivers[1].jitter_buffer_memory_bytes = 234;
+
+  auto* voice_media_channel = pc_->AddVoiceChannel("AudioMid", "TransportName");
+  voice_media_channel->SetStats(voice_media_info);
+  pc_->AddSctpDataChannel("DummyChannel", InternalDataChannelInit());
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+
+  RTCMemoryUsageStats expected("RTCMemoryUsage", report->timestamp_us());
+  expected.audio_jitter_buffer_bytes = 1234;
+  expected.data_channel_queued_bytes = 0;
+  ASSERT_TRUE(report->Get("RTCMemoryUsage"));
+  EXPECT_EQ(expected,
+            report->Get("RTCMemoryUsage")->cast_to<RTCMemoryUsageStats>());
+}
+
+TEST_F(RTCStatsCollectorTest, StatsReportDeltasOnlyHoldChanges) {
+  // The first delta is the full report.
+  rtc::scoped_refptr<const RTCStatsReport> full_report =
+      stats_->GetStatsReport();
+  rtc::scoped_refptr<const RTCStatsReport> delta =
+      stats_->GetStatsReportDelta();
+  EXPECT_EQ(full_report.get(), delta.get());
+
+  // Nothing changed since.
+  stats_->stats_collector()->ClearCachedStatsReport();
+  delta = stats_->GetStatsReportDelta();
+  EXPECT_EQ(0u, delta->size());
+  delta = stats_->GetStatsReportDelta();
+  EXPECT_EQ(0u, delta->size());
+
+  rtc::scoped_refptr<DataChannel> dummy_channel = DataChannel::Create(
+      nullptr, cricket::DCT_NONE, "DummyChannel", InternalDataChannelInit());
+  pc_->SignalDataChannelCreated()(dummy_channel.get());
+  dummy_channel->SignalOpened(dummy_channel.get());
+
+  stats_->stats_collector()->ClearCachedStatsReport();
+  delta = stats_->GetStatsReportDelta();
+  EXPECT_EQ(1u, delta->size());
+  ASSERT_TRUE(delta->Get("RTCPeerConnection"));
+  RTCPeerConnectionStats expected("RTCPeerConnection", delta->timestamp_us());
+  expected.data_channels_opened = 1;
+  EXPECT_EQ(
+      expected,
+      delta->Get("RTCPeerConnection")->cast_to<RTCPeerConnectionStats>());
+}
+
 TEST_F(RTCStatsCollectorTest,
        CollectLocalRTCMediaStreamStatsAndRTCMediaStreamTrackStats_Audio) {
   rtc::scoped_refptr<MediaStream> local_stream =
@@ -2024,6 +2094,7 @@ TEST_F(RTCStatsCollectorTest, GetStatsWithSenderSelector) {
   EXPECT_FALSE(sender_report->Get(graph.receiver_track_id));
   EXPECT_FALSE(sender_report->Get(graph.remote_stream_id));
   EXPECT_FALSE(sender_report->Get(graph.peer_connection_id));
+  EXPECT_FALSE(sender_report->Get(graph.memory_usage_id));
 }
 
 TEST_F(RTCStatsCollectorTest, GetStatsWithReceiverSelector) {
@@ -2051,6 +2122,7 @@ TEST_F(RTCStatsCollectorTest, GetStatsWithReceiverSelector) {
   EXPECT_TRUE(receiver_report->Get(graph.receiver_track_id));
   EXPECT_FALSE(receiver_report->Get(graph.remote_stream_id));
   EXPECT_FALSE(receiver_report->Get(graph.peer_connection_id));
+  EXPECT_FALSE(receiver_report->Get(graph.memory_usage_id));
 }
 
 TEST_F(RTCStatsCollectorTest, GetStatsWithNullSenderSelector) {
@@ -97,6 +97,8 @@ std::vector<const std::string*> GetStatsReferencedIds(const RTCStats& stats) {
     // RTCMediaStreamTrackStats does not have any neighbor references.
   } else if (type == RTCPeerConnectionStats::kType) {
     // RTCPeerConnectionStats does not have any neighbor references.
+  } else if (type == RTCMemoryUsageStats::kType) {
+    // RTCMemoryUsageStats does not have any neighbor references.
   } else if (type == RTCInboundRTPStreamStats::kType ||
              type == RTCOutboundRTPStreamStats::kType) {
     const auto& rtp = static_cast<const RTCRTPStreamStats&>(stats);
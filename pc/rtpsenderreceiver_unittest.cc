@@ -76,12 +76,12 @@ class RtpSenderReceiverTest : public testing::Test,
 
     voice_channel_ = channel_manager_.CreateVoiceChannel(
         &fake_call_, cricket::MediaConfig(), rtp_transport_.get(),
-        rtc::Thread::Current(), cricket::CN_AUDIO, srtp_required,
-        rtc::CryptoOptions(), cricket::AudioOptions());
+        network_thread_, rtc::Thread::Current(), cricket::CN_AUDIO,
+        srtp_required, rtc::CryptoOptions(), cricket::AudioOptions());
     video_channel_ = channel_manager_.CreateVideoChannel(
         &fake_call_, cricket::MediaConfig(), rtp_transport_.get(),
-        rtc::Thread::Current(), cricket::CN_VIDEO, srtp_required,
-        rtc::CryptoOptions(), cricket::VideoOptions());
+        network_thread_, rtc::Thread::Current(), cricket::CN_VIDEO,
+        srtp_required, rtc::CryptoOptions(), cricket::VideoOptions());
     voice_channel_->Enable(true);
     video_channel_->Enable(true);
     voice_media_channel_ = media_engine_->GetVoiceChannel(0);
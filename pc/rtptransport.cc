@@ -18,6 +18,7 @@
 #include "p2p/base/packettransportinterface.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/receivedpacketbuffer.h"
 #include "rtc_base/trace_event.h"
 
 namespace webrtc {
@@ -125,6 +126,9 @@ bool RtpTransport::SendPacket(bool rtcp,
   rtc::PacketTransportInternal* transport = rtcp && !rtcp_mux_enabled_
                                                 ? rtcp_packet_transport_
                                                 : rtp_packet_transport_;
+  // Lets a socket that queues the packet hold on to |packet| rather than copy
+  // it.
+  rtc::ScopedSentPacketBuffer published(packet);
   int ret = transport->SendPacket(packet->data<char>(), packet->size(), options,
                                   flags);
   if (ret != static_cast<int>(packet->size())) {
@@ -262,7 +266,14 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  // Nothing reads |data| after us, so we can take over the socket's buffer if
+  // it published one.
+  rtc::CopyOnWriteBuffer packet;
+  if (!rtc::TakeReceivedPacket(data, len, &packet)) {
+    packet = packet_buffer_pool_
+                 ? packet_buffer_pool_->AllocateBuffer(data, len, len)
+                 : rtc::CopyOnWriteBuffer(data, len);
+  }
   // Protect ourselves against crazy data.
   if (!cricket::IsValidRtpRtcpPacketSize(rtcp, packet.size())) {
     RTC_LOG(LS_ERROR) << "Dropping incoming "
@@ -12,10 +12,12 @@
 #define PC_RTPTRANSPORT_H_
 
 #include <string>
+#include <utility>
 
 #include "call/rtp_demuxer.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "pc/rtptransportinternal.h"
+#include "rtc_base/copyonwritebufferpool.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
 namespace rtc {
@@ -82,6 +84,14 @@ class RtpTransport : public RtpTransportInternal {
 
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
+  // Received packets are copied into buffers from |pool| instead of freshly
+  // allocated ones. Must be called on the network thread, before packets
+  // arrive; pass null to go back to regular allocation.
+  void SetPacketBufferPool(
+      rtc::scoped_refptr<rtc::CopyOnWriteBufferPool> pool) {
+    packet_buffer_pool_ = std::move(pool);
+  }
+
  protected:
   // TODO(zstein): Remove this when we remove RtpTransportAdapter.
   RtpTransportAdapter* GetInternal() override;
@@ -148,6 +158,8 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+
+  rtc::scoped_refptr<rtc::CopyOnWriteBufferPool> packet_buffer_pool_;
 };
 
 }  // namespace webrtc
@@ -343,4 +343,32 @@ TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+// Test that received packets are copied into buffers from the packet buffer
+// pool, which get reused once released.
+TEST(RtpTransportTest, ReceivedPacketsUsePacketBufferPool) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  rtc::scoped_refptr<rtc::CopyOnWriteBufferPool> pool =
+      rtc::CopyOnWriteBufferPool::Create();
+  transport.SetPacketBufferPool(pool);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types = {0x11};
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  const rtc::PacketOptions options;
+  const int flags = 0;
+  rtc::Buffer rtp_data(kRtpData, kRtpLen);
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, flags);
+  // The observer keeps the last packet.
+  EXPECT_EQ(0u, pool->idle_buffers());
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, flags);
+  EXPECT_EQ(2, observer.rtp_count());
+  EXPECT_EQ(1u, pool->idle_buffers());
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 }  // namespace webrtc
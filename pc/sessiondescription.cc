@@ -28,6 +28,32 @@ ContentInfo* FindContentInfoByName(ContentInfos* contents,
 
 }  // namespace
 
+bool MediaContentDescription::Equals(
+    const MediaContentDescription& other) const {
+  if (type() != other.type() || rtcp_mux_ != other.rtcp_mux_ ||
+      rtcp_reduced_size_ != other.rtcp_reduced_size_ ||
+      bandwidth_ != other.bandwidth_ || protocol_ != other.protocol_ ||
+      rtp_header_extensions_ != other.rtp_header_extensions_ ||
+      rtp_header_extensions_set_ != other.rtp_header_extensions_set_ ||
+      streams_ != other.streams_ ||
+      conference_mode_ != other.conference_mode_ ||
+      direction_ != other.direction_ ||
+      connection_address_ != other.connection_address_ ||
+      cryptos_.size() != other.cryptos_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < cryptos_.size(); ++i) {
+    const CryptoParams& crypto = cryptos_[i];
+    const CryptoParams& other_crypto = other.cryptos_[i];
+    if (!crypto.Matches(other_crypto) ||
+        crypto.key_params != other_crypto.key_params ||
+        crypto.session_params != other_crypto.session_params) {
+      return false;
+    }
+  }
+  return true;
+}
+
 const ContentInfo* FindContentInfoByName(const ContentInfos& contents,
                                          const std::string& name) {
   for (ContentInfos::const_iterator content = contents.begin();
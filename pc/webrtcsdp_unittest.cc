@@ -24,6 +24,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/stringencode.h"
 #include "rtc_base/stringutils.h"
+#include "rtc_base/timeutils.h"
 
 #ifdef WEBRTC_ANDROID
 #include "pc/test/androidtestinitializer.h"
@@ -3737,3 +3738,123 @@ TEST_F(WebRtcSdpTest, DeserializeEmptySessionName) {
   Replace("s=-\r\n", "s= \r\n", &sdp);
   EXPECT_TRUE(SdpDeserialize(sdp, &jsep_desc));
 }
+
+// Returns an offer with |num_media_sections| m= sections, alternately audio
+// and video, as the serializer writes it.
+static std::string MakeOfferWithManyMediaSections(int num_media_sections) {
+  std::string sdp =
+      "v=0\r\n"
+      "o=- 4611731400430051336 2 IN IP4 127.0.0.1\r\n"
+      "s=-\r\n"
+      "t=0 0\r\n"
+      "a=group:BUNDLE";
+  for (int i = 0; i < num_media_sections; ++i)
+    sdp += " " + rtc::ToString(i);
+  sdp += "\r\na=msid-semantic: WMS stream\r\n";
+  for (int i = 0; i < num_media_sections; ++i) {
+    const std::string mid = rtc::ToString(i);
+    const std::string ssrc = rtc::ToString(1000 + i);
+    sdp += i % 2 ? "m=video 9 UDP/TLS/RTP/SAVPF 96 97\r\n"
+                 : "m=audio 9 UDP/TLS/RTP/SAVPF 111 103 9 0 8 126\r\n";
+    sdp +=
+        "c=IN IP4 0.0.0.0\r\n"
+        "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+        "a=ice-ufrag:ufrag\r\n"
+        "a=ice-pwd:pwd_pwd_pwd_pwd_pwd_pwd\r\n"
+        "a=mid:" +
+        mid +
+        "\r\n"
+        "a=extmap:3 urn:ietf:params:rtp-hdrext:sdes:mid\r\n"
+        "a=sendrecv\r\n"
+        "a=msid:stream track" +
+        mid +
+        "\r\n"
+        "a=rtcp-mux\r\n";
+    if (i % 2) {
+      sdp +=
+          "a=rtpmap:96 VP8/90000\r\n"
+          "a=rtcp-fb:96 goog-remb\r\n"
+          "a=rtcp-fb:96 transport-cc\r\n"
+          "a=rtcp-fb:96 ccm fir\r\n"
+          "a=rtcp-fb:96 nack\r\n"
+          "a=rtcp-fb:96 nack pli\r\n"
+          "a=rtpmap:97 rtx/90000\r\n"
+          "a=fmtp:97 apt=96\r\n";
+    } else {
+      sdp +=
+          "a=rtpmap:111 opus/48000/2\r\n"
+          "a=rtcp-fb:111 transport-cc\r\n"
+          "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+          "a=rtpmap:103 ISAC/16000\r\n"
+          "a=rtpmap:9 G722/8000\r\n"
+          "a=rtpmap:0 PCMU/8000\r\n"
+          "a=rtpmap:8 PCMA/8000\r\n"
+          "a=rtpmap:126 telephone-event/8000\r\n";
+    }
+    sdp += "a=ssrc:" + ssrc + " cname:cname\r\n" + "a=ssrc:" + ssrc +
+           " msid:stream track" + mid + "\r\n" + "a=ssrc:" + ssrc +
+           " mslabel:stream\r\n" + "a=ssrc:" + ssrc + " label:track" + mid +
+           "\r\n";
+  }
+  return sdp;
+}
+
+// Parses an offer with a few m= sections and serializes it again. The result
+// must be what the serializer wrote before the parser was sped up, which is
+// the offer itself.
+TEST_F(WebRtcSdpTest, ParseAndSerializeRoundTrip) {
+  const std::string sdp = MakeOfferWithManyMediaSections(4);
+  JsepSessionDescription jdesc(kDummyType);
+  ASSERT_TRUE(SdpDeserialize(sdp, &jdesc));
+  EXPECT_EQ(sdp, webrtc::SdpSerialize(jdesc));
+}
+
+// Numbers that are only accepted by the lenient fallback of the number
+// parsing are still read as before, and serialized in their canonical form.
+// Numbers that can't be parsed at all still fail.
+TEST_F(WebRtcSdpTest, ParseAndSerializeRoundTripWithMalformedNumbers) {
+  const std::string sdp = MakeOfferWithManyMediaSections(4);
+
+  std::string lenient_sdp = sdp;
+  Replace("a=rtpmap:96 VP8/90000", "a=rtpmap:+96 VP8/90000", &lenient_sdp);
+  Replace("a=rtcp:9 IN", "a=rtcp: 9 IN", &lenient_sdp);
+  Replace("a=ssrc:1000 cname:", "a=ssrc:1000x cname:", &lenient_sdp);
+  JsepSessionDescription jdesc(kDummyType);
+  ASSERT_TRUE(SdpDeserialize(lenient_sdp, &jdesc));
+  EXPECT_EQ(sdp, webrtc::SdpSerialize(jdesc));
+
+  std::string bad_sdp = sdp;
+  Replace("a=rtpmap:96 VP8/90000", "a=rtpmap:x96 VP8/90000", &bad_sdp);
+  ExpectParseFailure(bad_sdp, "a=rtpmap:x96 VP8/90000");
+  bad_sdp = sdp;
+  Replace("a=ssrc:1001 cname:", "a=ssrc:ssrc cname:", &bad_sdp);
+  ExpectParseFailure(bad_sdp, "a=ssrc:ssrc cname:");
+  bad_sdp = sdp;
+  Replace("m=video 9 ", "m=video nine ", &bad_sdp);
+  ExpectParseFailure(bad_sdp, "m=video nine ");
+}
+
+// Times parsing and serializing an offer with many m= sections, like the ones
+// of large conferences. The offer is the serialization of itself, so the two
+// must match.
+TEST_F(WebRtcSdpTest, DISABLED_ParseAndSerializePerformance) {
+  const int kNumMediaSections = 300;
+  const int kNumIterations = 20;
+  const std::string sdp = MakeOfferWithManyMediaSections(kNumMediaSections);
+
+  int64_t parse_us = 0;
+  int64_t serialize_us = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    JsepSessionDescription jdesc(kDummyType);
+    int64_t start_us = rtc::TimeMicros();
+    ASSERT_TRUE(SdpDeserialize(sdp, &jdesc));
+    int64_t parsed_us = rtc::TimeMicros();
+    std::string message = webrtc::SdpSerialize(jdesc);
+    serialize_us += rtc::TimeMicros() - parsed_us;
+    parse_us += parsed_us - start_us;
+    EXPECT_EQ(sdp, message);
+  }
+  RTC_LOG(LS_INFO) << "Offer of " << sdp.size() << " bytes parsed in "
+                   << parse_us / kNumIterations << " us, serialized in "
+                   << serialize_us / kNumIterations << " us.";
+}
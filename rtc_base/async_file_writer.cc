@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/async_file_writer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+
+namespace rtc {
+
+namespace {
+
+TaskQueue* SharedTaskQueue() {
+  // Never destroyed, since writers may be closed during static destruction.
+  static TaskQueue* const task_queue =
+      new TaskQueue("AsyncFileWriter", TaskQueue::Priority::LOW);
+  return task_queue;
+}
+
+}  // namespace
+
+class AsyncFileWriter::WriteTask : public QueuedTask {
+ public:
+  WriteTask(AsyncFileWriter* writer, Buffer data, size_t offset)
+      : writer_(writer), data_(std::move(data)), offset_(offset) {}
+
+ private:
+  bool Run() override {
+    const bool success =
+        writer_->file_.WriteAt(data_.data(), data_.size(), offset_) ==
+        data_.size();
+    writer_->OnWritten(data_.size(), success);
+    return true;
+  }
+
+  AsyncFileWriter* const writer_;
+  const Buffer data_;
+  const size_t offset_;
+};
+
+constexpr size_t AsyncFileWriter::kChunkSize;
+
+AsyncFileWriter::AsyncFileWriter(File file, size_t max_pending_bytes)
+    : AsyncFileWriter(std::move(file), SharedTaskQueue(), max_pending_bytes) {}
+
+AsyncFileWriter::AsyncFileWriter(File file,
+                                 TaskQueue* task_queue,
+                                 size_t max_pending_bytes)
+    : task_queue_(task_queue),
+      max_pending_bytes_(max_pending_bytes),
+      file_(std::move(file)),
+      end_offset_(0),
+      dropped_bytes_(0),
+      closed_(false),
+      pending_bytes_(0),
+      write_failed_(false) {
+  RTC_DCHECK(task_queue_);
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  if (!closed_)
+    Close();
+}
+
+bool AsyncFileWriter::Write(
+    std::initializer_list<ArrayView<const uint8_t>> parts) {
+  RTC_DCHECK(!closed_);
+  size_t length = 0;
+  for (const ArrayView<const uint8_t>& part : parts)
+    length += part.size();
+  {
+    CritScope lock(&crit_);
+    if (write_failed_ || pending_bytes_ + length > max_pending_bytes_) {
+      dropped_bytes_ += length;
+      return false;
+    }
+    pending_bytes_ += length;
+  }
+
+  for (ArrayView<const uint8_t> part : parts) {
+    while (!part.empty()) {
+      // Fill |chunk_| up to the next multiple of |kChunkSize| of the file.
+      const size_t chunk_space = kChunkSize - end_offset_ % kChunkSize;
+      const size_t size = std::min(chunk_space, part.size());
+      chunk_.AppendData(part.data(), size);
+      end_offset_ += size;
+      part = part.subview(size);
+      if (size == chunk_space)
+        PostChunk();
+    }
+  }
+  return true;
+}
+
+bool AsyncFileWriter::Write(const uint8_t* data, size_t length) {
+  return Write({ArrayView<const uint8_t>(data, length)});
+}
+
+void AsyncFileWriter::WriteAt(const uint8_t* data,
+                              size_t length,
+                              size_t offset) {
+  RTC_DCHECK(!closed_);
+  {
+    CritScope lock(&crit_);
+    pending_bytes_ += length;
+  }
+  PostChunk();
+  task_queue_->PostTask(
+      absl::make_unique<WriteTask>(this, Buffer(data, length), offset));
+  end_offset_ = std::max(end_offset_, offset + length);
+}
+
+bool AsyncFileWriter::Close() {
+  RTC_DCHECK(!closed_);
+  closed_ = true;
+  PostChunk();
+
+  Event done(false, false);
+  bool closed = false;
+  task_queue_->PostTask([this, &done, &closed] {
+    closed = file_.Close();
+    done.Set();
+  });
+  done.Wait(Event::kForever);
+
+  CritScope lock(&crit_);
+  RTC_DCHECK_EQ(0, pending_bytes_);
+  return closed && !write_failed_;
+}
+
+void AsyncFileWriter::PostChunk() {
+  if (chunk_.empty())
+    return;
+  const size_t offset = end_offset_ - chunk_.size();
+  task_queue_->PostTask(
+      absl::make_unique<WriteTask>(this, std::move(chunk_), offset));
+  chunk_.Clear();
+}
+
+void AsyncFileWriter::OnWritten(size_t length, bool success) {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  CritScope lock(&crit_);
+  RTC_DCHECK_GE(pending_bytes_, length);
+  pending_bytes_ -= length;
+  if (!success && !write_failed_) {
+    RTC_LOG(LS_ERROR) << "Unable to write " << length << " bytes to file.";
+    write_failed_ = true;
+  }
+}
+
+}  // namespace rtc
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_ASYNC_FILE_WRITER_H_
+#define RTC_BASE_ASYNC_FILE_WRITER_H_
+
+#include <initializer_list>
+
+#include "api/array_view.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/file.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Writes to a file on a task queue, so that the threads producing the data,
+// e.g. the encoder and decoder threads recording a stream, never block on
+// disk I/O. The task queue may be shared by the writers of many files.
+//
+// Appended data is gathered into chunks that end at multiples of |kChunkSize|
+// bytes in the file, and each chunk is written with a single call. Memory use
+// is bounded: data that would take the bytes not yet written to the file above
+// |max_pending_bytes| is dropped, which the call reports.
+//
+// The methods must not be called concurrently.
+class AsyncFileWriter {
+ public:
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  // Writes on a task queue shared by all writers created this way.
+  AsyncFileWriter(File file, size_t max_pending_bytes);
+  // |task_queue| must outlive the writer.
+  AsyncFileWriter(File file, TaskQueue* task_queue, size_t max_pending_bytes);
+  // Closes the file, if Close() hasn't been called.
+  ~AsyncFileWriter();
+
+  // Appends |parts| after the end of the data written so far. Returns false,
+  // and drops all of the parts, if they don't fit in the pending bytes.
+  bool Write(std::initializer_list<ArrayView<const uint8_t>> parts);
+  bool Write(const uint8_t* data, size_t length);
+
+  // Writes |length| bytes at |offset| of the file, after the preceding writes
+  // have been done. Meant for headers that are rewritten when the file is
+  // closed, so it is never dropped.
+  void WriteAt(const uint8_t* data, size_t length, size_t offset);
+
+  // Writes the data not yet written and closes the file, waiting for the
+  // writes to finish. Returns false if any write failed.
+  bool Close();
+
+  // Number of bytes dropped by Write() so far.
+  size_t dropped_bytes() const { return dropped_bytes_; }
+
+ private:
+  class WriteTask;
+
+  // Posts the write of |chunk_|.
+  void PostChunk();
+  // Called on the task queue when a write of |length| bytes is done.
+  void OnWritten(size_t length, bool success);
+
+  TaskQueue* const task_queue_;
+  const size_t max_pending_bytes_;
+  // Only used on |task_queue_|.
+  File file_;
+
+  Buffer chunk_;
+  // Offset of the end of the data appended so far.
+  size_t end_offset_;
+  size_t dropped_bytes_;
+  bool closed_;
+
+  CriticalSection crit_;
+  // Bytes accepted but not yet written to the file.
+  size_t pending_bytes_ RTC_GUARDED_BY(crit_);
+  bool write_failed_ RTC_GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncFileWriter);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_ASYNC_FILE_WRITER_H_
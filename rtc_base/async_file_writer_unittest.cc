@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "rtc_base/async_file_writer.h"
+#include "rtc_base/event.h"
+#include "rtc_base/gunit.h"
+#include "test/testsupport/fileutils.h"
+
+namespace rtc {
+
+class AsyncFileWriterTest : public ::testing::Test {
+ protected:
+  AsyncFileWriterTest() : task_queue_("AsyncFileWriterTest") {}
+
+  void SetUp() override {
+    path_ = webrtc::test::TempFilename(webrtc::test::OutputPath(),
+                                       "async_file_writer");
+    ASSERT_FALSE(path_.empty());
+  }
+  void TearDown() override { File::Remove(path_); }
+
+  std::vector<uint8_t> ReadFile() {
+    std::vector<uint8_t> data(webrtc::test::GetFileSize(path_));
+    File file = File::Open(path_);
+    EXPECT_EQ(data.size(), file.Read(data.data(), data.size()));
+    return data;
+  }
+
+  std::string path_;
+  TaskQueue task_queue_;
+};
+
+TEST_F(AsyncFileWriterTest, WritesAllData) {
+  // Several chunks, written in parts that don't line up with them.
+  std::vector<uint8_t> data(3 * AsyncFileWriter::kChunkSize + 1000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i * 7);
+
+  AsyncFileWriter writer(File::Create(path_), &task_queue_, data.size());
+  const size_t kPartSize = 10000;
+  for (size_t i = 0; i < data.size(); i += kPartSize) {
+    EXPECT_TRUE(writer.Write(&data[i], std::min(kPartSize, data.size() - i)));
+  }
+  EXPECT_TRUE(writer.Close());
+  EXPECT_EQ(0u, writer.dropped_bytes());
+  EXPECT_EQ(data, ReadFile());
+}
+
+TEST_F(AsyncFileWriterTest, RewritesHeader) {
+  const uint8_t kBlankHeader[4] = {0, 0, 0, 0};
+  const uint8_t kHeader[4] = {1, 2, 3, 4};
+  const uint8_t kPayload[2] = {5, 6};
+  const uint8_t kMore[1] = {7};
+
+  AsyncFileWriter writer(File::Create(path_), &task_queue_, 1000);
+  writer.WriteAt(kBlankHeader, sizeof(kBlankHeader), 0);
+  EXPECT_TRUE(writer.Write({ArrayView<const uint8_t>(kPayload),
+                            ArrayView<const uint8_t>(kMore)}));
+  writer.WriteAt(kHeader, sizeof(kHeader), 0);
+  EXPECT_TRUE(writer.Close());
+  EXPECT_EQ(std::vector<uint8_t>({1, 2, 3, 4, 5, 6, 7}), ReadFile());
+}
+
+TEST_F(AsyncFileWriterTest, DropsDataAbovePendingLimit) {
+  // Keep the task queue busy, so that nothing is written.
+  Event queue_blocked(false, false);
+  Event unblock_queue(false, false);
+  task_queue_.PostTask([&queue_blocked, &unblock_queue] {
+    queue_blocked.Set();
+    unblock_queue.Wait(Event::kForever);
+  });
+  ASSERT_TRUE(queue_blocked.Wait(Event::kForever));
+
+  const size_t kMaxPendingBytes = 2 * AsyncFileWriter::kChunkSize;
+  std::vector<uint8_t> data(AsyncFileWriter::kChunkSize, 1);
+  AsyncFileWriter writer(File::Create(path_), &task_queue_, kMaxPendingBytes);
+  EXPECT_TRUE(writer.Write(data.data(), data.size()));
+  EXPECT_TRUE(writer.Write(data.data(), data.size()));
+  // All or nothing of the parts of a write is dropped.
+  EXPECT_FALSE(writer.Write({ArrayView<const uint8_t>(data.data(), 1),
+                             ArrayView<const uint8_t>(data.data(), 1)}));
+  EXPECT_EQ(2u, writer.dropped_bytes());
+
+  unblock_queue.Set();
+  EXPECT_TRUE(writer.Close());
+  EXPECT_EQ(kMaxPendingBytes, webrtc::test::GetFileSize(path_));
+}
+
+}  // namespace rtc
@@ -13,6 +13,8 @@
 
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/dscp.h"
+#include "rtc_base/ecn.h"
+#include "rtc_base/packetsignal.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/timeutils.h"
@@ -64,6 +66,10 @@ struct PacketTime {
   // example, the time of the last select() call.
   // If unknown, this value will be set to zero.
   int64_t not_before;
+
+  // ECN codepoint the packet was received with, if the socket reports it. See
+  // Socket::OPT_RECV_ECN.
+  EcnMarking ecn = ECN_NOT_ECT;
 };
 
 inline PacketTime CreatePacketTime(int64_t not_before) {
@@ -99,6 +105,22 @@ class AsyncPacketSocket : public sigslot::has_slots<> {
                      const SocketAddress& addr,
                      const PacketOptions& options) = 0;
 
+  // Starts queuing packets passed to SendTo() instead of sending each one
+  // immediately; they are written to the network by FlushSendBatch(). This is
+  // meant for senders that produce bursts, such as one pacer tick, and lets
+  // the socket use a single system call per burst. SignalSentPacket fires when
+  // the batch is flushed. Sockets that do not support batching ignore these
+  // calls and keep sending immediately. Queued packets share the sender's
+  // buffer when it is published with ScopedSentPacketBuffer, as RtpTransport
+  // does, and are copied otherwise.
+  //
+  // Nothing on the paced send path calls these yet: the pacer sends from its
+  // own thread, and each packet reaches the network thread as a task of its
+  // own, so a burst isn't visible to the socket. Callers that send bursts on
+  // the network thread can use them directly.
+  virtual void StartSendBatch() {}
+  virtual void FlushSendBatch() {}
+
   // Close the socket.
   virtual int Close() = 0;
 
@@ -115,16 +137,17 @@ class AsyncPacketSocket : public sigslot::has_slots<> {
   virtual void SetError(int error) = 0;
 
   // Emitted each time a packet is read. Used only for UDP and
-  // connected TCP sockets.
-  sigslot::signal5<AsyncPacketSocket*,
-                   const char*,
-                   size_t,
-                   const SocketAddress&,
-                   const PacketTime&>
+  // connected TCP sockets. Like SignalSentPacket, only emitted on the thread
+  // of the socket.
+  PacketSignal<AsyncPacketSocket*,
+               const char*,
+               size_t,
+               const SocketAddress&,
+               const PacketTime&>
       SignalReadPacket;
 
   // Emitted each time a packet is sent.
-  sigslot::signal2<AsyncPacketSocket*, const SentPacket&> SignalSentPacket;
+  PacketSignal<AsyncPacketSocket*, const SentPacket&> SignalSentPacket;
 
   // Emitted when the socket is currently able to send.
   sigslot::signal1<AsyncPacketSocket*> SignalReadyToSend;
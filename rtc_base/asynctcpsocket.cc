@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "rtc_base/arraysize.h"
 #include "rtc_base/byteorder.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -173,6 +174,47 @@ int AsyncTCPSocketBase::FlushOutBuffer() {
   return res;
 }
 
+int AsyncTCPSocketBase::SendBuffers(const OutgoingBuffer* buffers,
+                                    size_t count) {
+  RTC_DCHECK(!listen_);
+  RTC_DCHECK(IsOutBufferEmpty());
+  size_t total_size = 0;
+  for (size_t i = 0; i < count; ++i)
+    total_size += buffers[i].length;
+  RTC_DCHECK_LE(total_size, max_outsize_);
+
+  int res = socket_->SendV(buffers, count);
+  if (res < 0 && socket_->GetError() == EOPNOTSUPP) {
+    // Sockets that can't send vectored data, such as adapters, get the
+    // buffers copied together into |outbuf_| as before.
+    for (size_t i = 0; i < count; ++i)
+      AppendToOutBuffer(buffers[i].data, buffers[i].length);
+    res = FlushOutBuffer();
+    if (res <= 0)
+      ClearOutBuffer();
+    return res;
+  }
+  if (res <= 0) {
+    return res;
+  }
+  if (static_cast<size_t>(res) > total_size) {
+    RTC_NOTREACHED();
+    return -1;
+  }
+  // Buffer the unsent tail, to be flushed on the next write event.
+  size_t skip = res;
+  for (size_t i = 0; i < count; ++i) {
+    if (skip >= buffers[i].length) {
+      skip -= buffers[i].length;
+      continue;
+    }
+    AppendToOutBuffer(static_cast<const uint8_t*>(buffers[i].data) + skip,
+                      buffers[i].length - skip);
+    skip = 0;
+  }
+  return res;
+}
+
 void AsyncTCPSocketBase::AppendToOutBuffer(const void* pv, size_t cb) {
   RTC_DCHECK(outbuf_.size() + cb <= max_outsize_);
   RTC_DCHECK(!listen_);
@@ -289,13 +331,15 @@ int AsyncTCPSocket::Send(const void* pv,
     return static_cast<int>(cb);
 
   PacketLength pkt_len = HostToNetwork16(static_cast<PacketLength>(cb));
-  AppendToOutBuffer(&pkt_len, kPacketLenSize);
-  AppendToOutBuffer(pv, cb);
+  OutgoingBuffer buffers[2];
+  buffers[0].data = &pkt_len;
+  buffers[0].length = kPacketLenSize;
+  buffers[1].data = pv;
+  buffers[1].length = cb;
 
-  int res = FlushOutBuffer();
+  int res = SendBuffers(buffers, arraysize(buffers));
   if (res <= 0) {
     // drop packet if we made no progress
-    ClearOutBuffer();
     return res;
   }
 
@@ -311,21 +355,22 @@ int AsyncTCPSocket::Send(const void* pv,
 void AsyncTCPSocket::ProcessInput(char* data, size_t* len) {
   SocketAddress remote_addr(GetRemoteAddress());
 
-  while (true) {
-    if (*len < kPacketLenSize)
-      return;
-
-    PacketLength pkt_len = rtc::GetBE16(data);
-    if (*len < kPacketLenSize + pkt_len)
-      return;
-
-    SignalReadPacket(this, data + kPacketLenSize, pkt_len, remote_addr,
-                     CreatePacketTime(0));
+  // Signals all complete packets in place, and moves the incomplete one left
+  // at the end to the front only once.
+  size_t processed = 0;
+  while (*len - processed >= kPacketLenSize) {
+    PacketLength pkt_len = rtc::GetBE16(data + processed);
+    if (*len - processed < kPacketLenSize + pkt_len)
+      break;
+
+    SignalReadPacket(this, data + processed + kPacketLenSize, pkt_len,
+                     remote_addr, CreatePacketTime(0));
+    processed += kPacketLenSize + pkt_len;
+  }
 
-    *len -= kPacketLenSize + pkt_len;
-    if (*len > 0) {
-      memmove(data, data + kPacketLenSize + pkt_len, *len);
-    }
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
@@ -59,6 +59,12 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
                                     const SocketAddress& remote_address);
   virtual int SendRaw(const void* pv, size_t cb);
   int FlushOutBuffer();
+  // Sends the concatenation of |buffers| with one call to the socket, while
+  // |outbuf_| is empty, and copies only the part that wasn't sent to
+  // |outbuf_|. Sockets that don't implement SendV() get the buffers copied
+  // into |outbuf_| and sent from there. The result is that of the send; if it
+  // made no progress, nothing is buffered.
+  int SendBuffers(const OutgoingBuffer* buffers, size_t count);
   // Add data to |outbuf_|.
   void AppendToOutBuffer(const void* pv, size_t cb);
 
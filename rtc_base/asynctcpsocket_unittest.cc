@@ -10,9 +10,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "rtc_base/arraysize.h"
 #include "rtc_base/asynctcpsocket.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/virtualsocketserver.h"
 
 namespace rtc {
@@ -21,7 +24,7 @@ class AsyncTCPSocketTest : public testing::Test, public sigslot::has_slots<> {
  public:
   AsyncTCPSocketTest()
       : vss_(new rtc::VirtualSocketServer()),
-        socket_(vss_->CreateAsyncSocket(SOCK_STREAM)),
+        socket_(vss_->CreateAsyncSocket(AF_INET, SOCK_STREAM)),
         tcp_socket_(new AsyncTCPSocket(socket_, true)),
         ready_to_send_(false) {
     tcp_socket_->SignalReadyToSend.connect(this,
@@ -43,4 +46,63 @@ TEST_F(AsyncTCPSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+class AsyncTCPSocketPairTest : public testing::Test,
+                               public sigslot::has_slots<> {
+ public:
+  AsyncTCPSocketPairTest()
+      : vss_(new VirtualSocketServer()), thread_(vss_.get()) {}
+
+  void SetUp() override {
+    AsyncSocket* server = vss_->CreateAsyncSocket(AF_INET, SOCK_STREAM);
+    server->Bind(SocketAddress("127.0.0.1", 0));
+    server_socket_.reset(new AsyncTCPSocket(server, true));
+    server_socket_->SignalNewConnection.connect(
+        this, &AsyncTCPSocketPairTest::OnNewConnection);
+
+    client_socket_.reset(AsyncTCPSocket::Create(
+        vss_->CreateAsyncSocket(AF_INET, SOCK_STREAM),
+        SocketAddress("127.0.0.1", 0), server_socket_->GetLocalAddress()));
+    ASSERT_TRUE(client_socket_);
+    vss_->ProcessMessagesUntilIdle();
+    ASSERT_TRUE(accepted_socket_);
+  }
+
+  void OnNewConnection(AsyncPacketSocket* server,
+                       AsyncPacketSocket* new_socket) {
+    accepted_socket_.reset(new_socket);
+    new_socket->SignalReadPacket.connect(this,
+                                         &AsyncTCPSocketPairTest::OnReadPacket);
+  }
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t len,
+                    const SocketAddress& remote_addr,
+                    const PacketTime& packet_time) {
+    received_.push_back(std::string(data, len));
+  }
+
+ protected:
+  std::unique_ptr<VirtualSocketServer> vss_;
+  AutoSocketServerThread thread_;
+  std::unique_ptr<AsyncTCPSocket> server_socket_;
+  std::unique_ptr<AsyncTCPSocket> client_socket_;
+  std::unique_ptr<AsyncPacketSocket> accepted_socket_;
+  std::vector<std::string> received_;
+};
+
+TEST_F(AsyncTCPSocketPairTest, ReceivesPacketsReadTogether) {
+  const std::string packets[] = {"first", "", "third packet"};
+  for (const std::string& packet : packets) {
+    EXPECT_EQ(static_cast<int>(packet.size()),
+              client_socket_->Send(packet.data(), packet.size(),
+                                   PacketOptions()));
+  }
+  vss_->ProcessMessagesUntilIdle();
+
+  ASSERT_EQ(arraysize(packets), received_.size());
+  for (size_t i = 0; i < arraysize(packets); ++i)
+    EXPECT_EQ(packets[i], received_[i]);
+}
+
 }  // namespace rtc
@@ -9,8 +9,13 @@
  */
 
 #include "rtc_base/asyncudpsocket.h"
+
+#include <algorithm>
+#include <utility>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/receivedpacketbuffer.h"
 
 namespace rtc {
 
@@ -48,6 +53,17 @@ AsyncUDPSocket::~AsyncUDPSocket() {
   delete[] buf_;
 }
 
+AsyncUDPSocket::QueuedPacket::QueuedPacket(const void* data,
+                                           size_t size,
+                                           const SocketAddress& addr,
+                                           const SentPacket& sent_packet)
+    : addr(addr), sent_packet(sent_packet) {
+  if (!ReferenceSentPacket(data, size, &payload))
+    payload.SetData(static_cast<const uint8_t*>(data), size);
+}
+AsyncUDPSocket::QueuedPacket::QueuedPacket(QueuedPacket&&) = default;
+AsyncUDPSocket::QueuedPacket::~QueuedPacket() = default;
+
 SocketAddress AsyncUDPSocket::GetLocalAddress() const {
   return socket_->GetLocalAddress();
 }
@@ -75,12 +91,49 @@ int AsyncUDPSocket::SendTo(const void* pv,
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
   sent_packet.info.remote_socket_address = addr;
+  if (send_batching_) {
+    send_queue_.emplace_back(pv, cb, addr, sent_packet);
+    return static_cast<int>(cb);
+  }
   int ret = socket_->SendTo(pv, cb, addr);
   SignalSentPacket(this, sent_packet);
   return ret;
 }
 
+void AsyncUDPSocket::StartSendBatch() {
+  send_batching_ = true;
+}
+
+void AsyncUDPSocket::FlushSendBatch() {
+  send_batching_ = false;
+  if (send_queue_.empty())
+    return;
+
+  std::vector<OutgoingDatagram> datagrams(send_queue_.size());
+  for (size_t i = 0; i < send_queue_.size(); ++i) {
+    datagrams[i].data = send_queue_[i].payload.cdata();
+    datagrams[i].length = send_queue_[i].payload.size();
+    datagrams[i].destination = send_queue_[i].addr;
+  }
+  int sent = socket_->SendToBatch(datagrams.data(), datagrams.size());
+  if (sent < static_cast<int>(datagrams.size())) {
+    // Like a failed SendTo(), packets that do not fit are dropped; the socket
+    // signals SignalReadyToSend once it is writable again.
+    RTC_LOG(LS_VERBOSE) << "AsyncUDPSocket dropped "
+                        << datagrams.size() - std::max(sent, 0)
+                        << " batched packets, error " << socket_->GetError();
+  }
+  // Move the queue aside first; a SignalSentPacket handler may send again.
+  std::vector<QueuedPacket> flushed;
+  flushed.swap(send_queue_);
+  for (const QueuedPacket& packet : flushed) {
+    SignalSentPacket(this, packet.sent_packet);
+  }
+}
+
 int AsyncUDPSocket::Close() {
+  send_batching_ = false;
+  send_queue_.clear();
   return socket_->Close();
 }
 
@@ -93,7 +146,10 @@ int AsyncUDPSocket::GetOption(Socket::Option opt, int* value) {
 }
 
 int AsyncUDPSocket::SetOption(Socket::Option opt, int value) {
-  return socket_->SetOption(opt, value);
+  int ret = socket_->SetOption(opt, value);
+  if (ret == 0 && opt == Socket::OPT_RECV_ECN)
+    recv_ecn_ = value != 0;
+  return ret;
 }
 
 int AsyncUDPSocket::GetError() const {
@@ -104,12 +160,82 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetReceiveBatchSize(size_t max_datagrams) {
+  batch_.clear();
+  batch_buffers_.clear();
+  if (max_datagrams <= 1)
+    return;
+  batch_.resize(max_datagrams);
+  batch_buffers_.reserve(max_datagrams);
+  for (ReceivedDatagram& datagram : batch_) {
+    batch_buffers_.emplace_back(new char[BUF_SIZE]);
+    datagram.buffer = batch_buffers_.back().get();
+    datagram.capacity = BUF_SIZE;
+  }
+}
+
+void AsyncUDPSocket::SetReceiveBufferPool(
+    scoped_refptr<CopyOnWriteBufferPool> pool,
+    size_t max_packet_size) {
+  receive_pool_ = std::move(pool);
+  max_packet_size_ = max_packet_size;
+}
+
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
+  if (!batch_.empty()) {
+    int count = socket_->RecvFromBatch(batch_.data(), batch_.size());
+    if (count < 0) {
+      SocketAddress local_addr = socket_->GetLocalAddress();
+      RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                       << "] batched receive failed with error "
+                       << socket_->GetError();
+      return;
+    }
+    for (int i = 0; i < count; ++i) {
+      const ReceivedDatagram& datagram = batch_[i];
+      PacketTime packet_time = datagram.timestamp > -1
+                                   ? PacketTime(datagram.timestamp, 0)
+                                   : CreatePacketTime(0);
+      packet_time.ecn = datagram.ecn;
+      SignalReadPacket(this, static_cast<const char*>(datagram.buffer),
+                       datagram.length, datagram.source, packet_time);
+    }
+    return;
+  }
+
+  // With a receive pool, read one byte more than allowed to detect oversized
+  // datagrams, which would otherwise be silently truncated.
+  CopyOnWriteBuffer packet;
+  char* buffer = buf_;
+  size_t capacity = size_;
+  if (receive_pool_) {
+    packet = receive_pool_->AllocateBuffer(max_packet_size_ + 1,
+                                           max_packet_size_ + 1);
+    buffer = packet.data<char>();
+    capacity = packet.size();
+  }
+
   SocketAddress remote_addr;
-  int64_t timestamp;
-  int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
+  int64_t timestamp = -1;
+  EcnMarking ecn = ECN_NOT_ECT;
+  int len;
+  if (recv_ecn_) {
+    // Only RecvFromBatch() reports the ECN codepoint.
+    ReceivedDatagram datagram;
+    datagram.buffer = buffer;
+    datagram.capacity = capacity;
+    len = socket_->RecvFromBatch(&datagram, 1);
+    if (len > 0) {
+      len = static_cast<int>(datagram.length);
+      remote_addr = datagram.source;
+      timestamp = datagram.timestamp;
+      ecn = datagram.ecn;
+    }
+  } else {
+    len = socket_->RecvFrom(buffer, capacity, &remote_addr, &timestamp);
+  }
   if (len < 0) {
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
@@ -121,11 +247,26 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
     return;
   }
 
+  PacketTime packet_time =
+      timestamp > -1 ? PacketTime(timestamp, 0) : CreatePacketTime(0);
+  packet_time.ecn = ecn;
+  if (receive_pool_) {
+    if (static_cast<size_t>(len) > max_packet_size_) {
+      RTC_LOG(LS_WARNING) << "AsyncUDPSocket dropped a datagram longer than "
+                          << max_packet_size_ << " bytes.";
+      return;
+    }
+    packet.SetSize(len);
+    ScopedReceivedPacketBuffer published(&packet);
+    SignalReadPacket(this, buffer, static_cast<size_t>(len), remote_addr,
+                     packet_time);
+    return;
+  }
+
   // TODO: Make sure that we got all of the packet.
   // If we did not, then we should resize our buffer to be large enough.
-  SignalReadPacket(
-      this, buf_, static_cast<size_t>(len), remote_addr,
-      (timestamp > -1 ? PacketTime(timestamp, 0) : CreatePacketTime(0)));
+  SignalReadPacket(this, buf_, static_cast<size_t>(len), remote_addr,
+                   packet_time);
 }
 
 void AsyncUDPSocket::OnWriteEvent(AsyncSocket* socket) {
@@ -12,8 +12,12 @@
 #define RTC_BASE_ASYNCUDPSOCKET_H_
 
 #include <memory>
+#include <vector>
 
 #include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/copyonwritebufferpool.h"
+#include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/socketfactory.h"
 
 namespace rtc {
@@ -43,6 +47,8 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  void StartSendBatch() override;
+  void FlushSendBatch() override;
   int Close() override;
 
   State GetState() const override;
@@ -51,7 +57,38 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Enables reading up to |max_datagrams| datagrams per read event, using
+  // Socket::RecvFromBatch(). Each datagram is still delivered through
+  // SignalReadPacket. Every batch slot owns a full-sized receive buffer, so
+  // this trades memory for fewer system calls on busy sockets. A value of 1
+  // or less restores the default of one datagram per read event.
+  void SetReceiveBatchSize(size_t max_datagrams);
+
+  // Reads every datagram into its own buffer from |pool| and publishes that
+  // buffer with ScopedReceivedPacketBuffer while SignalReadPacket runs, so the
+  // receiver at the end of the chain can keep it instead of copying the
+  // packet. Datagrams longer than |max_packet_size| are dropped. Has no effect
+  // while batched receive is enabled. Pass null to read into the socket's own
+  // buffer again.
+  void SetReceiveBufferPool(scoped_refptr<CopyOnWriteBufferPool> pool,
+                            size_t max_packet_size);
+
  private:
+  struct QueuedPacket {
+    QueuedPacket(const void* data,
+                 size_t size,
+                 const SocketAddress& addr,
+                 const SentPacket& sent_packet);
+    QueuedPacket(QueuedPacket&&);
+    ~QueuedPacket();
+
+    // Shares the sender's buffer when it was published with
+    // ScopedSentPacketBuffer, and holds a copy otherwise.
+    CopyOnWriteBuffer payload;
+    SocketAddress addr;
+    SentPacket sent_packet;
+  };
+
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(AsyncSocket* socket);
   // Called when the underlying socket is ready to send.
@@ -60,6 +97,18 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  // Backing storage and slots used when batched receive is enabled.
+  std::vector<std::unique_ptr<char[]>> batch_buffers_;
+  std::vector<ReceivedDatagram> batch_;
+  // Set by SetReceiveBufferPool().
+  scoped_refptr<CopyOnWriteBufferPool> receive_pool_;
+  size_t max_packet_size_ = 0;
+  // Set by Socket::OPT_RECV_ECN, so that the ECN codepoint of every datagram
+  // is read and passed on in its PacketTime.
+  bool recv_ecn_ = false;
+  // Packets queued between StartSendBatch() and FlushSendBatch().
+  bool send_batching_ = false;
+  std::vector<QueuedPacket> send_queue_;
 };
 
 }  // namespace rtc
@@ -10,6 +10,7 @@
 
 #include "rtc_base/bitrateallocationstrategy.h"
 #include <algorithm>
+#include <numeric>
 #include <utility>
 
 namespace rtc {
@@ -78,6 +79,51 @@ std::vector<uint32_t> BitrateAllocationStrategy::DistributeBitratesEvenly(
   }
 }
 
+std::vector<uint32_t> BitrateAllocationStrategy::DistributeBitratesRelatively(
+    const ArrayView<const TrackConfig*> track_configs,
+    uint32_t available_bitrate) {
+  std::vector<uint32_t> track_allocations =
+      SetAllBitratesToMinimum(track_configs);
+  uint32_t sum_min_bitrates = 0;
+  double priority_sum = 0;
+  for (const auto* track_config : track_configs) {
+    sum_min_bitrates += track_config->min_bitrate_bps;
+    priority_sum += track_config->bitrate_priority;
+  }
+  if (sum_min_bitrates >= available_bitrate)
+    return track_allocations;
+
+  // Go through the tracks in the order they reach their max_bitrate_bps when
+  // given their share, which is the order of their capacity normalized by
+  // their priority. A track that can not take its share leaves the rest to the
+  // following tracks.
+  std::vector<size_t> order(track_configs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&track_configs](size_t a, size_t b) {
+    return (track_configs[a]->max_bitrate_bps -
+            track_configs[a]->min_bitrate_bps) /
+               track_configs[a]->bitrate_priority <
+           (track_configs[b]->max_bitrate_bps -
+            track_configs[b]->min_bitrate_bps) /
+               track_configs[b]->bitrate_priority;
+  });
+  uint32_t remaining_bitrate = available_bitrate - sum_min_bitrates;
+  for (size_t index : order) {
+    const TrackConfig* track_config = track_configs[index];
+    const uint32_t capacity =
+        track_config->max_bitrate_bps - track_config->min_bitrate_bps;
+    const double share =
+        remaining_bitrate * track_config->bitrate_priority / priority_sum;
+    const uint32_t increase = std::min(
+        remaining_bitrate,
+        static_cast<uint32_t>(std::min<double>(share, capacity)));
+    track_allocations[index] += increase;
+    remaining_bitrate -= increase;
+    priority_sum -= track_config->bitrate_priority;
+  }
+  return track_allocations;
+}
+
 AudioPriorityBitrateAllocationStrategy::AudioPriorityBitrateAllocationStrategy(
     std::string audio_track_id,
     uint32_t sufficient_audio_bitrate)
@@ -149,4 +195,11 @@ std::vector<uint32_t> AudioPriorityBitrateAllocationStrategy::AllocateBitrates(
   }
 }
 
+std::vector<uint32_t>
+PriorityWeightedBitrateAllocationStrategy::AllocateBitrates(
+    uint32_t available_bitrate,
+    const ArrayView<const TrackConfig*> track_configs) {
+  return DistributeBitratesRelatively(track_configs, available_bitrate);
+}
+
 }  // namespace rtc
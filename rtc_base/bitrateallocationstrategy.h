@@ -34,11 +34,13 @@ class BitrateAllocationStrategy {
     TrackConfig(uint32_t min_bitrate_bps,
                 uint32_t max_bitrate_bps,
                 bool enforce_min_bitrate,
-                std::string track_id)
+                std::string track_id,
+                double bitrate_priority = 1.0)
         : min_bitrate_bps(min_bitrate_bps),
           max_bitrate_bps(max_bitrate_bps),
           enforce_min_bitrate(enforce_min_bitrate),
-          track_id(track_id) {}
+          track_id(track_id),
+          bitrate_priority(bitrate_priority) {}
     TrackConfig(const TrackConfig& track_config) = default;
     virtual ~TrackConfig() = default;
     TrackConfig() {}
@@ -54,6 +56,10 @@ class BitrateAllocationStrategy {
 
     // MediaStreamTrack ID as defined by application. May be empty.
     std::string track_id;
+
+    // The amount of bitrate this track should get relative to other tracks,
+    // for strategies that take it into account.
+    double bitrate_priority = 1.0;
   };
 
   static std::vector<uint32_t> SetAllBitratesToMinimum(
@@ -61,6 +67,11 @@ class BitrateAllocationStrategy {
   static std::vector<uint32_t> DistributeBitratesEvenly(
       const ArrayView<const TrackConfig*> track_configs,
       uint32_t available_bitrate);
+  // Like DistributeBitratesEvenly, but the bitrate above the sum of
+  // min_bitrate_bps is split in proportion to bitrate_priority.
+  static std::vector<uint32_t> DistributeBitratesRelatively(
+      const ArrayView<const TrackConfig*> track_configs,
+      uint32_t available_bitrate);
 
   // Strategy is expected to allocate all available_bitrate up to the sum of
   // max_bitrate_bps of all tracks. If available_bitrate is less than the sum of
@@ -96,6 +107,19 @@ class AudioPriorityBitrateAllocationStrategy
   std::string audio_track_id_;
   uint32_t sufficient_audio_bitrate_;
 };
+
+// Allocation strategy giving every track its min_bitrate_bps and splitting the
+// rest in proportion to bitrate_priority, up to max_bitrate_bps. A track with
+// twice the priority of another gets twice the bitrate above its minimum until
+// it reaches its maximum. This implementation does not pause tracks even if
+// enforce_min_bitrate is false.
+class PriorityWeightedBitrateAllocationStrategy
+    : public BitrateAllocationStrategy {
+ public:
+  std::vector<uint32_t> AllocateBitrates(
+      uint32_t available_bitrate,
+      const ArrayView<const TrackConfig*> track_configs) override;
+};
 }  // namespace rtc
 
 #endif  // RTC_BASE_BITRATEALLOCATIONSTRATEGY_H_
@@ -241,4 +241,38 @@ TEST(AudioPriorityBitrateAllocationStrategyTest, VideoAllocateBitrate) {
   EXPECT_EQ(max_other_bitrate, allocations[2]);
 }
 
+// Test that the bitrate above the minimum is split in proportion to the
+// priority, with the share a track can not take going to the other tracks.
+TEST(PriorityWeightedBitrateAllocationStrategyTest, WeightedAllocateBitrate) {
+  std::vector<BitrateAllocationStrategy::TrackConfig> track_configs = {
+      BitrateAllocationStrategy::TrackConfig(10000, 1000000, false, "low",
+                                             1.0),
+      BitrateAllocationStrategy::TrackConfig(10000, 1000000, false, "high",
+                                             3.0),
+      BitrateAllocationStrategy::TrackConfig(10000, 20000, false, "capped",
+                                             4.0)};
+  std::vector<const rtc::BitrateAllocationStrategy::TrackConfig*>
+      track_config_ptrs = MakeTrackConfigPtrsVector(track_configs);
+  PriorityWeightedBitrateAllocationStrategy allocation_strategy;
+
+  std::vector<uint32_t> allocations =
+      allocation_strategy.AllocateBitrates(20000, track_config_ptrs);
+  EXPECT_EQ(10000u, allocations[0]);
+  EXPECT_EQ(10000u, allocations[1]);
+  EXPECT_EQ(10000u, allocations[2]);
+
+  // 80000 above the minimum: "capped" takes its 10000 and the other two split
+  // what is left 1:3.
+  allocations = allocation_strategy.AllocateBitrates(110000, track_config_ptrs);
+  EXPECT_EQ(10000u + 17500u, allocations[0]);
+  EXPECT_EQ(10000u + 52500u, allocations[1]);
+  EXPECT_EQ(20000u, allocations[2]);
+
+  allocations =
+      allocation_strategy.AllocateBitrates(3000000, track_config_ptrs);
+  EXPECT_EQ(1000000u, allocations[0]);
+  EXPECT_EQ(1000000u, allocations[1]);
+  EXPECT_EQ(20000u, allocations[2]);
+}
+
 }  // namespace rtc
@@ -111,6 +111,13 @@ class CopyOnWriteBuffer {
     return buffer_ ? buffer_->capacity() : 0;
   }
 
+  // Returns true if other CopyOnWriteBuffers refer to the same data, i.e. if
+  // writing to this buffer makes a copy first.
+  bool IsShared() const {
+    RTC_DCHECK(IsConsistent());
+    return buffer_ && !buffer_->HasOneRef();
+  }
+
   CopyOnWriteBuffer& operator=(const CopyOnWriteBuffer& buf) {
     RTC_DCHECK(IsConsistent());
     RTC_DCHECK(buf.IsConsistent());
@@ -227,6 +234,14 @@ class CopyOnWriteBuffer {
   }
 
  private:
+  friend class CopyOnWriteBufferPool;
+
+  // Wrap a buffer handed out by CopyOnWriteBufferPool.
+  explicit CopyOnWriteBuffer(scoped_refptr<RefCountedObject<Buffer>> buffer)
+      : buffer_(std::move(buffer)) {
+    RTC_DCHECK(IsConsistent());
+  }
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects.
   void CloneDataIfReferenced(size_t new_capacity);
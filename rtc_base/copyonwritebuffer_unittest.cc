@@ -63,6 +63,18 @@ TEST(CopyOnWriteBufferTest, TestMoveConstruct) {
   EXPECT_EQ(buf2.data(), buf1_data);
 }
 
+TEST(CopyOnWriteBufferTest, TestIsShared) {
+  CopyOnWriteBuffer buf1(kTestData, 3, 10);
+  EXPECT_FALSE(buf1.IsShared());
+  CopyOnWriteBuffer buf2(buf1);
+  EXPECT_TRUE(buf1.IsShared());
+  EXPECT_TRUE(buf2.IsShared());
+  buf2.data()[0] = 0xaa;
+  EXPECT_FALSE(buf1.IsShared());
+  EXPECT_FALSE(buf2.IsShared());
+  EXPECT_FALSE(CopyOnWriteBuffer().IsShared());
+}
+
 TEST(CopyOnWriteBufferTest, TestMoveAssign) {
   CopyOnWriteBuffer buf1(kTestData, 3, 10);
   size_t buf1_size = buf1.size();
@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copyonwritebufferpool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/refcountedobject.h"
+
+namespace rtc {
+
+namespace {
+
+const size_t kSmallestSizeClass = 256;
+
+// Returns the smallest size class holding |capacity| bytes, or -1 if
+// |capacity| is too large to be pooled.
+int SizeClassFor(size_t capacity, int num_size_classes) {
+  size_t class_capacity = kSmallestSizeClass;
+  for (int size_class = 0; size_class < num_size_classes; ++size_class) {
+    if (capacity <= class_capacity)
+      return size_class;
+    class_capacity <<= 1;
+  }
+  return -1;
+}
+
+}  // namespace
+
+// A Buffer that hands itself back to its pool rather than being deleted when
+// its last reference is released. |pool_| is only set while the buffer is in
+// use, so idle buffers don't keep the pool alive.
+class CopyOnWriteBufferPool::PooledBuffer : public RefCountedObject<Buffer> {
+ public:
+  PooledBuffer(int size_class, size_t capacity)
+      : RefCountedObject<Buffer>(size_t{0}, capacity),
+        size_class_(size_class) {}
+  ~PooledBuffer() override {}
+
+  RefCountReleaseStatus Release() const override {
+    const auto status = ref_count_.DecRef();
+    if (status == RefCountReleaseStatus::kDroppedLastRef) {
+      // Keep the pool alive until it has stored or deleted this buffer.
+      scoped_refptr<CopyOnWriteBufferPool> pool = std::move(pool_);
+      pool->Recycle(const_cast<PooledBuffer*>(this));
+    }
+    return status;
+  }
+
+  int size_class() const { return size_class_; }
+  void set_pool(CopyOnWriteBufferPool* pool) { pool_ = pool; }
+
+ private:
+  const int size_class_;
+  mutable scoped_refptr<CopyOnWriteBufferPool> pool_;
+};
+
+const int CopyOnWriteBufferPool::kNumSizeClasses;
+const size_t CopyOnWriteBufferPool::kMaxIdleBuffersPerClass;
+
+scoped_refptr<CopyOnWriteBufferPool> CopyOnWriteBufferPool::Create() {
+  return new RefCountedObject<CopyOnWriteBufferPool>();
+}
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool()
+    : allocation_thread_known_(false), remote_idle_count_(0) {
+  // Bound to the thread of the first AllocateBuffer() call.
+  allocation_thread_.DetachFromThread();
+}
+
+CopyOnWriteBufferPool::~CopyOnWriteBufferPool() {
+  for (int size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+    for (PooledBuffer* buffer : idle_[size_class])
+      delete buffer;
+    for (PooledBuffer* buffer : remote_idle_[size_class])
+      delete buffer;
+  }
+}
+
+CopyOnWriteBuffer CopyOnWriteBufferPool::AllocateBuffer(size_t size,
+                                                        size_t capacity) {
+  RTC_DCHECK(allocation_thread_.CalledOnValidThread());
+  if (!allocation_thread_known_.load(std::memory_order_relaxed)) {
+    allocation_thread_ref_ = CurrentThreadRef();
+    allocation_thread_known_.store(true, std::memory_order_release);
+  }
+
+  capacity = std::max(size, capacity);
+  int size_class = SizeClassFor(capacity, kNumSizeClasses);
+  if (capacity == 0 || size_class < 0)
+    return CopyOnWriteBuffer(size, capacity);
+
+  std::vector<PooledBuffer*>& idle = idle_[size_class];
+  if (idle.empty() &&
+      remote_idle_count_.load(std::memory_order_relaxed) > 0) {
+    CritScope cs(&remote_lock_);
+    idle.swap(remote_idle_[size_class]);
+    remote_idle_count_.fetch_sub(idle.size(), std::memory_order_relaxed);
+  }
+
+  PooledBuffer* buffer;
+  if (idle.empty()) {
+    buffer = new PooledBuffer(size_class, kSmallestSizeClass << size_class);
+  } else {
+    buffer = idle.back();
+    idle.pop_back();
+  }
+  buffer->set_pool(this);
+  buffer->SetSize(size);
+  return CopyOnWriteBuffer(scoped_refptr<RefCountedObject<Buffer>>(buffer));
+}
+
+size_t CopyOnWriteBufferPool::idle_buffers() const {
+  RTC_DCHECK(allocation_thread_.CalledOnValidThread());
+  size_t count = remote_idle_count_.load(std::memory_order_relaxed);
+  for (int size_class = 0; size_class < kNumSizeClasses; ++size_class)
+    count += idle_[size_class].size();
+  return count;
+}
+
+void CopyOnWriteBufferPool::Recycle(PooledBuffer* buffer) {
+  buffer->Clear();
+  if (allocation_thread_known_.load(std::memory_order_acquire) &&
+      IsThreadRefEqual(allocation_thread_ref_, CurrentThreadRef())) {
+    std::vector<PooledBuffer*>& idle = idle_[buffer->size_class()];
+    if (idle.size() < kMaxIdleBuffersPerClass) {
+      idle.push_back(buffer);
+      return;
+    }
+  } else {
+    CritScope cs(&remote_lock_);
+    std::vector<PooledBuffer*>& idle = remote_idle_[buffer->size_class()];
+    if (idle.size() < kMaxIdleBuffersPerClass) {
+      idle.push_back(buffer);
+      remote_idle_count_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  delete buffer;
+}
+
+}  // namespace rtc
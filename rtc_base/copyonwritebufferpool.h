@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_COPYONWRITEBUFFERPOOL_H_
+#define RTC_BASE_COPYONWRITEBUFFERPOOL_H_
+
+#include <atomic>
+#include <vector>
+
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/platform_thread_types.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/thread_checker.h"
+
+namespace rtc {
+
+// Recycles the storage of CopyOnWriteBuffers instead of freeing it, for paths
+// such as packet reception that allocate one buffer per packet. Buffers come
+// in power-of-two size classes from 256 bytes to 64 kB; larger requests are
+// allocated normally. A buffer returns to its pool when the last
+// CopyOnWriteBuffer referring to it goes away, on whichever thread that
+// happens, and buffers may outlive the pool.
+//
+// AllocateBuffer() must always be called on the same thread. Buffers released
+// on that thread go straight back to its free lists; buffers released on other
+// threads are collected under a lock and picked up when the free list of their
+// size class runs dry.
+class CopyOnWriteBufferPool : public RefCountInterface {
+ public:
+  static scoped_refptr<CopyOnWriteBufferPool> Create();
+
+  // Returns a buffer of |size| uninitialized bytes, with room for at least
+  // |capacity| bytes.
+  CopyOnWriteBuffer AllocateBuffer(size_t size, size_t capacity);
+
+  // Returns a buffer holding a copy of |size| bytes from |data|, with room for
+  // at least |capacity| bytes.
+  template <typename T,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  CopyOnWriteBuffer AllocateBuffer(const T* data,
+                                   size_t size,
+                                   size_t capacity) {
+    CopyOnWriteBuffer buffer = AllocateBuffer(size, capacity);
+    if (size > 0)
+      std::memcpy(buffer.data(), data, size);
+    return buffer;
+  }
+
+  // Number of buffers currently held for reuse. Must be called on the thread
+  // that calls AllocateBuffer().
+  size_t idle_buffers() const;
+
+ protected:
+  CopyOnWriteBufferPool();
+  ~CopyOnWriteBufferPool() override;
+
+ private:
+  class PooledBuffer;
+
+  static const int kNumSizeClasses = 9;
+  static const size_t kMaxIdleBuffersPerClass = 64;
+
+  void Recycle(PooledBuffer* buffer);
+
+  ThreadChecker allocation_thread_;
+  // Written once by the first AllocateBuffer() call, before
+  // |allocation_thread_known_| is set with release semantics, so Recycle() may
+  // read it on any thread after an acquire load of the flag.
+  PlatformThreadRef allocation_thread_ref_;
+  std::atomic<bool> allocation_thread_known_;
+
+  // Only accessed on the allocation thread.
+  std::vector<PooledBuffer*> idle_[kNumSizeClasses];
+
+  CriticalSection remote_lock_;
+  std::vector<PooledBuffer*> remote_idle_[kNumSizeClasses]
+      RTC_GUARDED_BY(remote_lock_);
+  std::atomic<size_t> remote_idle_count_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_COPYONWRITEBUFFERPOOL_H_
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copyonwritebufferpool.h"
+
+#include "rtc_base/event.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/platform_thread.h"
+
+namespace rtc {
+
+namespace {
+
+const uint8_t kTestData[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7};
+
+}  // namespace
+
+TEST(CopyOnWriteBufferPoolTest, ReusesReleasedBuffers) {
+  scoped_refptr<CopyOnWriteBufferPool> pool = CopyOnWriteBufferPool::Create();
+  const uint8_t* storage;
+  {
+    CopyOnWriteBuffer buffer = pool->AllocateBuffer(kTestData, 8, 1500);
+    EXPECT_EQ(8u, buffer.size());
+    EXPECT_LE(1500u, buffer.capacity());
+    EXPECT_EQ(0, memcmp(kTestData, buffer.cdata(), 8));
+    storage = buffer.cdata();
+    EXPECT_EQ(0u, pool->idle_buffers());
+  }
+  EXPECT_EQ(1u, pool->idle_buffers());
+
+  CopyOnWriteBuffer buffer = pool->AllocateBuffer(100, 1200);
+  EXPECT_EQ(storage, buffer.cdata());
+  EXPECT_EQ(100u, buffer.size());
+  EXPECT_EQ(0u, pool->idle_buffers());
+}
+
+TEST(CopyOnWriteBufferPoolTest, SharedBufferReturnsWithLastReference) {
+  scoped_refptr<CopyOnWriteBufferPool> pool = CopyOnWriteBufferPool::Create();
+  CopyOnWriteBuffer buffer = pool->AllocateBuffer(kTestData, 8, 8);
+  CopyOnWriteBuffer copy = buffer;
+  buffer = CopyOnWriteBuffer();
+  EXPECT_EQ(0u, pool->idle_buffers());
+  copy = CopyOnWriteBuffer();
+  EXPECT_EQ(1u, pool->idle_buffers());
+}
+
+TEST(CopyOnWriteBufferPoolTest, DoesNotPoolLargeBuffers) {
+  scoped_refptr<CopyOnWriteBufferPool> pool = CopyOnWriteBufferPool::Create();
+  {
+    CopyOnWriteBuffer buffer = pool->AllocateBuffer(1 << 20, 1 << 20);
+    EXPECT_EQ(1u << 20, buffer.size());
+  }
+  EXPECT_EQ(0u, pool->idle_buffers());
+}
+
+TEST(CopyOnWriteBufferPoolTest, BufferOutlivesPool) {
+  scoped_refptr<CopyOnWriteBufferPool> pool = CopyOnWriteBufferPool::Create();
+  CopyOnWriteBuffer buffer = pool->AllocateBuffer(kTestData, 8, 8);
+  pool = nullptr;
+  EXPECT_EQ(0, memcmp(kTestData, buffer.cdata(), 8));
+}
+
+namespace {
+
+struct ReleaseOnThread {
+  static void Run(void* param) {
+    static_cast<ReleaseOnThread*>(param)->buffer = CopyOnWriteBuffer();
+  }
+  CopyOnWriteBuffer buffer;
+};
+
+}  // namespace
+
+TEST(CopyOnWriteBufferPoolTest, BufferReleasedOnOtherThreadIsReused) {
+  scoped_refptr<CopyOnWriteBufferPool> pool = CopyOnWriteBufferPool::Create();
+  ReleaseOnThread release;
+  release.buffer = pool->AllocateBuffer(kTestData, 8, 8);
+  const uint8_t* storage = release.buffer.cdata();
+
+  PlatformThread thread(&ReleaseOnThread::Run, &release, "ReleaseOnThread");
+  thread.Start();
+  thread.Stop();
+  EXPECT_EQ(1u, pool->idle_buffers());
+
+  CopyOnWriteBuffer buffer = pool->AllocateBuffer(8, 8);
+  EXPECT_EQ(storage, buffer.cdata());
+}
+
+}  // namespace rtc
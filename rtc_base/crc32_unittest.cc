@@ -33,4 +33,19 @@ TEST(Crc32Test, TestMultipleUpdates) {
   EXPECT_EQ(0x171A3F5FU, c);
 }
 
+TEST(Crc32Test, TestLongInput) {
+  EXPECT_EQ(0xCBF43926U, ComputeCrc32("123456789"));
+
+  std::string input(1000, '\0');
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = static_cast<char>(i * 7);
+  EXPECT_EQ(0x114AD5FFU, ComputeCrc32(input));
+
+  // Updates that split the input at unaligned offsets give the same result.
+  uint32_t c = UpdateCrc32(0, input.data(), 13);
+  c = UpdateCrc32(c, input.data() + 13, 500);
+  c = UpdateCrc32(c, input.data() + 513, input.size() - 513);
+  EXPECT_EQ(0x114AD5FFU, c);
+}
+
 }  // namespace rtc
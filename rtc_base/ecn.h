@@ -0,0 +1,31 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_ECN_H_
+#define RTC_BASE_ECN_H_
+
+namespace rtc {
+// Explicit Congestion Notification codepoints, the two low bits of the IPv4
+// TOS and IPv6 Traffic Class fields.
+// See http://tools.ietf.org/html/rfc3168 for details. L4S senders mark their
+// packets ECT(1), http://tools.ietf.org/html/draft-ietf-tsvwg-ecn-l4s-id.
+enum EcnMarking {
+  ECN_NOT_ECT = 0,  // Not ECN capable.
+  ECN_ECT1 = 1,     // ECN capable, L4S.
+  ECN_ECT0 = 2,     // ECN capable, classic.
+  ECN_CE = 3,       // Congestion experienced.
+};
+
+// Mask of the ECN bits of the TOS/Traffic Class byte.
+const int kEcnMask = 0x3;
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_ECN_H_
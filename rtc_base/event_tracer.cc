@@ -11,6 +11,15 @@
 
 #include <inttypes.h>
 
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -78,6 +87,136 @@ static void EventTracingThreadFunc(void* params);
 
 // Atomic-int fast path for avoiding logging when disabled.
 static volatile int g_event_logging_active = 0;
+// Same for the ring buffer capture.
+static volatile int g_ring_buffer_active = 0;
+
+struct TraceArg {
+  const char* name;
+  unsigned char type;
+  // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
+  union TraceArgValue {
+    bool as_bool;
+    unsigned long long as_uint;
+    long long as_int;
+    double as_double;
+    const void* as_pointer;
+    const char* as_string;
+  } value;
+
+  // Assert that the size of the union is equal to the size of the as_uint
+  // field since we are assigning to arbitrary types using it.
+  static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
+                "Size of TraceArg value union is not equal to the size of "
+                "the uint field of that union.");
+};
+
+struct TraceEvent {
+  const char* name;
+  const unsigned char* category_enabled;
+  char phase;
+  std::vector<TraceArg> args;
+  uint64_t timestamp;
+  int pid;
+  rtc::PlatformThreadId tid;
+};
+
+std::string TraceArgValueAsString(TraceArg arg) {
+  std::string output;
+
+  if (arg.type == TRACE_VALUE_TYPE_STRING ||
+      arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+    // Space for every character to be an espaced character + two for
+    // quatation marks.
+    output.reserve(strlen(arg.value.as_string) * 2 + 2);
+    output += '\"';
+    const char* c = arg.value.as_string;
+    do {
+      if (*c == '"' || *c == '\\') {
+        output += '\\';
+        output += *c;
+      } else {
+        output += *c;
+      }
+    } while (*++c);
+    output += '\"';
+  } else {
+    output.resize(kTraceArgBufferLength);
+    size_t print_length = 0;
+    switch (arg.type) {
+      case TRACE_VALUE_TYPE_BOOL:
+        if (arg.value.as_bool) {
+          strcpy(&output[0], "true");
+          print_length = 4;
+        } else {
+          strcpy(&output[0], "false");
+          print_length = 5;
+        }
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        print_length = sprintfn(&output[0], kTraceArgBufferLength, "%llu",
+                                arg.value.as_uint);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        print_length = sprintfn(&output[0], kTraceArgBufferLength, "%lld",
+                                arg.value.as_int);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        print_length = sprintfn(&output[0], kTraceArgBufferLength, "%f",
+                                arg.value.as_double);
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        print_length = sprintfn(&output[0], kTraceArgBufferLength, "\"%p\"",
+                                arg.value.as_pointer);
+        break;
+    }
+    size_t output_length = print_length < kTraceArgBufferLength
+                               ? print_length
+                               : kTraceArgBufferLength - 1;
+    // This will hopefully be very close to nop. On most implementations, it
+    // just writes null byte and sets the length field of the string.
+    output.resize(output_length);
+  }
+
+  return output;
+}
+
+// Writes |e| to |file| in the TraceEvent format, which is documented here:
+// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview
+void WriteTraceEvent(const TraceEvent& e,
+                     bool is_first_event,
+                     std::string* args_str,
+                     FILE* file) {
+  args_str->clear();
+  if (!e.args.empty()) {
+    *args_str += ", \"args\": {";
+    bool is_first_argument = true;
+    for (const TraceArg& arg : e.args) {
+      if (!is_first_argument)
+        *args_str += ",";
+      is_first_argument = false;
+      *args_str += " \"";
+      *args_str += arg.name;
+      *args_str += "\": ";
+      *args_str += TraceArgValueAsString(arg);
+    }
+    *args_str += " }";
+  }
+  fprintf(file,
+          "%s{ \"name\": \"%s\""
+          ", \"cat\": \"%s\""
+          ", \"ph\": \"%c\""
+          ", \"ts\": %" PRIu64
+          ", \"pid\": %d"
+#if defined(WEBRTC_WIN)
+          ", \"tid\": %lu"
+#else
+          ", \"tid\": %d"
+#endif  // defined(WEBRTC_WIN)
+          "%s"
+          "}\n",
+          is_first_event ? " " : ",", e.name, e.category_enabled, e.phase,
+          e.timestamp, e.pid, e.tid, args_str->c_str());
+}
 
 // TODO(pbos): Log metadata for all threads, etc.
 class EventLogger final {
@@ -121,8 +260,6 @@ class EventLogger final {
         {name, category_enabled, phase, args, timestamp, 1, thread_id});
   }
 
-  // The TraceEvent format is documented here:
-  // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview
   void Log() {
     RTC_DCHECK(output_file_);
     static const int kLoggingIntervalMs = 100;
@@ -138,43 +275,15 @@ class EventLogger final {
       std::string args_str;
       args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
       for (TraceEvent& e : events) {
-        args_str.clear();
-        if (!e.args.empty()) {
-          args_str += ", \"args\": {";
-          bool is_first_argument = true;
-          for (TraceArg& arg : e.args) {
-            if (!is_first_argument)
-              args_str += ",";
-            is_first_argument = false;
-            args_str += " \"";
-            args_str += arg.name;
-            args_str += "\": ";
-            args_str += TraceArgValueAsString(arg);
-
-            // Delete our copy of the string.
-            if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-              delete[] arg.value.as_string;
-              arg.value.as_string = nullptr;
-            }
+        WriteTraceEvent(e, !has_logged_event, &args_str, output_file_);
+        has_logged_event = true;
+        // Delete our copies of the strings.
+        for (TraceArg& arg : e.args) {
+          if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+            delete[] arg.value.as_string;
+            arg.value.as_string = nullptr;
           }
-          args_str += " }";
         }
-        fprintf(output_file_,
-                "%s{ \"name\": \"%s\""
-                ", \"cat\": \"%s\""
-                ", \"ph\": \"%c\""
-                ", \"ts\": %" PRIu64
-                ", \"pid\": %d"
-#if defined(WEBRTC_WIN)
-                ", \"tid\": %lu"
-#else
-                ", \"tid\": %d"
-#endif  // defined(WEBRTC_WIN)
-                "%s"
-                "}\n",
-                has_logged_event ? "," : " ", e.name, e.category_enabled,
-                e.phase, e.timestamp, e.pid, e.tid, args_str.c_str());
-        has_logged_event = true;
       }
       if (shutting_down)
         break;
@@ -223,108 +332,295 @@ class EventLogger final {
   }
 
  private:
-  struct TraceArg {
-    const char* name;
-    unsigned char type;
-    // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
-    union TraceArgValue {
-      bool as_bool;
-      unsigned long long as_uint;
-      long long as_int;
-      double as_double;
-      const void* as_pointer;
-      const char* as_string;
-    } value;
-
-    // Assert that the size of the union is equal to the size of the as_uint
-    // field since we are assigning to arbitrary types using it.
-    static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
-                  "Size of TraceArg value union is not equal to the size of "
-                  "the uint field of that union.");
-  };
+  rtc::CriticalSection crit_;
+  std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(crit_);
+  rtc::PlatformThread logging_thread_;
+  rtc::Event shutdown_event_;
+  rtc::ThreadChecker thread_checker_;
+  FILE* output_file_ = nullptr;
+  bool output_file_owned_ = false;
+};
 
-  struct TraceEvent {
+static void EventTracingThreadFunc(void* params) {
+  static_cast<EventLogger*>(params)->Log();
+}
+
+// Keeps the last events of every thread in a ring buffer of the thread, so
+// that they can be dumped when something has gone wrong. Adding an event takes
+// no lock and does not allocate, it copies the event into the next slot of the
+// buffer of the thread. Arguments are kept in their binary form and are only
+// formatted when dumped.
+//
+// Each slot is a seqlock: the writer makes the sequence number odd while it
+// writes the slot, and a dump skips slots that were written to while it read
+// them. The slot contents are atomics so that the racing reads are defined.
+class RingBufferLogger final {
+ public:
+  // A copied string argument is truncated to this many characters.
+  static constexpr size_t kMaxCopiedStringLength = 15;
+  static constexpr int kMaxArgs = 2;
+  static constexpr const char* kCopiedArgNames[kMaxArgs] = {"arg1", "arg2"};
+
+  static RingBufferLogger* Get() {
+    // Never destroyed, the buffers are referenced from thread local storage
+    // of threads that may outlive any owner.
+    static RingBufferLogger* const logger = new RingBufferLogger();
+    return logger;
+  }
+
+  void Start(size_t events_per_thread) {
+    RTC_CHECK_GT(events_per_thread, 0);
+    {
+      rtc::CritScope lock(&crit_);
+      events_per_thread_ = events_per_thread;
+      // Threads move to new buffers when they see that the generation has
+      // changed, so that events of an earlier capture are not dumped.
+      generation_.fetch_add(1, std::memory_order_release);
+    }
+    RTC_CHECK_EQ(0,
+                 rtc::AtomicOps::CompareAndSwap(&g_ring_buffer_active, 0, 1));
+    TRACE_EVENT_INSTANT0("webrtc", "RingBufferLogger::Start");
+  }
+
+  bool Stop() {
+    return rtc::AtomicOps::CompareAndSwap(&g_ring_buffer_active, 1, 0) == 1;
+  }
+
+  void AddTraceEvent(const char* name,
+                     const unsigned char* category_enabled,
+                     char phase,
+                     int num_args,
+                     const char** arg_names,
+                     const unsigned char* arg_types,
+                     const unsigned long long* arg_values,
+                     unsigned char flags,
+                     uint64_t timestamp) {
+    ThreadBuffer* buffer = CurrentThreadBuffer();
+    Record record;
+    memset(&record, 0, sizeof(record));
+    // With TRACE_EVENT_FLAG_COPY the names are temporary too.
+    const bool copy_names = flags & TRACE_EVENT_FLAG_COPY;
+    if (copy_names) {
+      strncpy(record.copied_name, name, kMaxCopiedStringLength);
+      record.name = nullptr;
+    } else {
+      record.name = name;
+    }
+    record.category_enabled = category_enabled;
+    record.timestamp = timestamp;
+    record.phase = phase;
+    record.num_args = static_cast<unsigned char>(std::min(num_args, kMaxArgs));
+    for (int i = 0; i < record.num_args; ++i) {
+      record.arg_names[i] = copy_names ? kCopiedArgNames[i] : arg_names[i];
+      record.arg_types[i] = arg_types[i];
+      record.arg_values[i] = arg_values[i];
+      // The string is temporary, so a prefix of it is copied into the record.
+      if (arg_types[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+        const char* value = reinterpret_cast<const char*>(
+            static_cast<uintptr_t>(arg_values[i]));
+        strncpy(record.copied_strings[i], value, kMaxCopiedStringLength);
+      }
+    }
+    buffer->Write(record);
+  }
+
+  // Writes the events of all threads, in time order.
+  void Dump(FILE* file) {
+    std::vector<TraceEvent> events;
+    // Keeps the copied strings of the events alive until they are written.
+    std::vector<Record> records;
+    {
+      rtc::CritScope lock(&crit_);
+      const uint64_t generation = generation_.load(std::memory_order_acquire);
+      for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+        if (buffer->generation == generation)
+          buffer->Read(&records, &events);
+      }
+    }
+    // |records| is not resized any more, so the string pointers can be set.
+    for (size_t i = 0; i < events.size(); ++i) {
+      if (!events[i].name)
+        events[i].name = records[i].copied_name;
+      for (size_t j = 0; j < events[i].args.size(); ++j) {
+        if (events[i].args[j].type == TRACE_VALUE_TYPE_COPY_STRING)
+          events[i].args[j].value.as_string = records[i].copied_strings[j];
+      }
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const TraceEvent& a, const TraceEvent& b) {
+                       return a.timestamp < b.timestamp;
+                     });
+    fprintf(file, "{ \"traceEvents\": [\n");
+    std::string args_str;
+    args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
+    for (size_t i = 0; i < events.size(); ++i)
+      WriteTraceEvent(events[i], i == 0, &args_str, file);
+    fprintf(file, "]}\n");
+    fflush(file);
+  }
+
+ private:
+  // The binary form of an event, as it is kept in the buffers.
+  struct Record {
     const char* name;
     const unsigned char* category_enabled;
-    char phase;
-    std::vector<TraceArg> args;
     uint64_t timestamp;
-    int pid;
-    rtc::PlatformThreadId tid;
+    const char* arg_names[kMaxArgs];
+    unsigned long long arg_values[kMaxArgs];
+    unsigned char arg_types[kMaxArgs];
+    char phase;
+    unsigned char num_args;
+    char copied_name[kMaxCopiedStringLength + 1];
+    char copied_strings[kMaxArgs][kMaxCopiedStringLength + 1];
   };
+  static constexpr size_t kRecordWords =
+      (sizeof(Record) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
 
-  static std::string TraceArgValueAsString(TraceArg arg) {
-    std::string output;
-
-    if (arg.type == TRACE_VALUE_TYPE_STRING ||
-        arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-      // Space for every character to be an espaced character + two for
-      // quatation marks.
-      output.reserve(strlen(arg.value.as_string) * 2 + 2);
-      output += '\"';
-      const char* c = arg.value.as_string;
-      do {
-        if (*c == '"' || *c == '\\') {
-          output += '\\';
-          output += *c;
-        } else {
-          output += *c;
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> words[kRecordWords];
+  };
+
+  struct ThreadBuffer {
+    // Written by the owning thread only.
+    void Write(const Record& record) {
+      const uint64_t index = write_index.load(std::memory_order_relaxed);
+      Slot& slot = slots[index % slots.size()];
+      uint64_t words[kRecordWords] = {};
+      memcpy(words, &record, sizeof(record));
+      slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      for (size_t i = 0; i < kRecordWords; ++i)
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+      slot.sequence.store(2 * index + 2, std::memory_order_release);
+      write_index.store(index + 1, std::memory_order_release);
+    }
+
+    // Appends the events in the buffer that are not being overwritten.
+    void Read(std::vector<Record>* records,
+              std::vector<TraceEvent>* events) const {
+      const uint64_t end = write_index.load(std::memory_order_acquire);
+      const uint64_t begin = end > slots.size() ? end - slots.size() : 0;
+      for (uint64_t index = begin; index < end; ++index) {
+        const Slot& slot = slots[index % slots.size()];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2)
+          continue;
+        uint64_t words[kRecordWords];
+        for (size_t i = 0; i < kRecordWords; ++i)
+          words[i] = slot.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+          continue;
+        Record record;
+        memcpy(&record, words, sizeof(record));
+        TraceEvent event = {record.name, record.category_enabled,
+                            record.phase, {}, record.timestamp, 1, thread_id};
+        for (int i = 0; i < record.num_args; ++i) {
+          TraceArg arg;
+          arg.name = record.arg_names[i];
+          arg.type = record.arg_types[i];
+          arg.value.as_uint = record.arg_values[i];
+          event.args.push_back(arg);
         }
-      } while (*++c);
-      output += '\"';
-    } else {
-      output.resize(kTraceArgBufferLength);
-      size_t print_length = 0;
-      switch (arg.type) {
-        case TRACE_VALUE_TYPE_BOOL:
-          if (arg.value.as_bool) {
-            strcpy(&output[0], "true");
-            print_length = 4;
-          } else {
-            strcpy(&output[0], "false");
-            print_length = 5;
-          }
-          break;
-        case TRACE_VALUE_TYPE_UINT:
-          print_length = sprintfn(&output[0], kTraceArgBufferLength, "%llu",
-                                  arg.value.as_uint);
-          break;
-        case TRACE_VALUE_TYPE_INT:
-          print_length = sprintfn(&output[0], kTraceArgBufferLength, "%lld",
-                                  arg.value.as_int);
-          break;
-        case TRACE_VALUE_TYPE_DOUBLE:
-          print_length = sprintfn(&output[0], kTraceArgBufferLength, "%f",
-                                  arg.value.as_double);
-          break;
-        case TRACE_VALUE_TYPE_POINTER:
-          print_length = sprintfn(&output[0], kTraceArgBufferLength, "\"%p\"",
-                                  arg.value.as_pointer);
-          break;
+        records->push_back(record);
+        events->push_back(std::move(event));
       }
-      size_t output_length = print_length < kTraceArgBufferLength
-                                 ? print_length
-                                 : kTraceArgBufferLength - 1;
-      // This will hopefully be very close to nop. On most implementations, it
-      // just writes null byte and sets the length field of the string.
-      output.resize(output_length);
     }
 
-    return output;
+    // These are only changed with |RingBufferLogger::crit_| held while no
+    // thread owns the buffer.
+    std::vector<Slot> slots;
+    uint64_t generation = 0;
+    rtc::PlatformThreadId thread_id = 0;
+    std::atomic<uint64_t> write_index{0};
+    // Set when the owning thread exits or moves to a buffer of a newer
+    // generation, after which the buffer can be handed to another thread.
+    std::atomic<bool> released{false};
+  };
+
+  RingBufferLogger() = default;
+
+  // Returns the buffer of the current thread, for the current generation.
+  ThreadBuffer* CurrentThreadBuffer() {
+    ThreadBuffer* buffer = static_cast<ThreadBuffer*>(GetThreadLocal());
+    if (buffer &&
+        buffer->generation == generation_.load(std::memory_order_acquire)) {
+      return buffer;
+    }
+    if (buffer)
+      buffer->released.store(true, std::memory_order_release);
+    buffer = AcquireBuffer();
+    SetThreadLocal(buffer);
+    return buffer;
+  }
+
+  ThreadBuffer* AcquireBuffer() {
+    rtc::CritScope lock(&crit_);
+    ThreadBuffer* buffer = nullptr;
+    for (const std::unique_ptr<ThreadBuffer>& candidate : buffers_) {
+      if (candidate->released.load(std::memory_order_acquire)) {
+        buffer = candidate.get();
+        break;
+      }
+    }
+    if (!buffer) {
+      buffers_.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+      buffer = buffers_.back().get();
+    }
+    if (buffer->slots.size() != events_per_thread_)
+      buffer->slots = std::vector<Slot>(events_per_thread_);
+    buffer->generation = generation_.load(std::memory_order_relaxed);
+    buffer->thread_id = rtc::CurrentThreadId();
+    buffer->write_index.store(0, std::memory_order_relaxed);
+    buffer->released.store(false, std::memory_order_relaxed);
+    return buffer;
   }
 
+  static void ReleaseBuffer(void* buffer) {
+    static_cast<ThreadBuffer*>(buffer)->released.store(
+        true, std::memory_order_release);
+  }
+
+#if defined(WEBRTC_WIN)
+  static DWORD GetTlsIndex() {
+    // Fiber local storage, unlike thread local storage, tells when a thread
+    // exits.
+    static DWORD index = FlsAlloc(&RingBufferLogger::OnThreadExit);
+    return index;
+  }
+  static void WINAPI OnThreadExit(void* buffer) {
+    if (buffer)
+      ReleaseBuffer(buffer);
+  }
+  static void* GetThreadLocal() { return FlsGetValue(GetTlsIndex()); }
+  static void SetThreadLocal(void* buffer) {
+    FlsSetValue(GetTlsIndex(), buffer);
+  }
+#else
+  static pthread_key_t GetTlsKey() {
+    static pthread_key_t key = [] {
+      pthread_key_t key;
+      RTC_CHECK_EQ(0, pthread_key_create(&key, &ReleaseBuffer));
+      return key;
+    }();
+    return key;
+  }
+  static void* GetThreadLocal() { return pthread_getspecific(GetTlsKey()); }
+  static void SetThreadLocal(void* buffer) {
+    pthread_setspecific(GetTlsKey(), buffer);
+  }
+#endif
+
   rtc::CriticalSection crit_;
-  std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(crit_);
-  rtc::PlatformThread logging_thread_;
-  rtc::Event shutdown_event_;
-  rtc::ThreadChecker thread_checker_;
-  FILE* output_file_ = nullptr;
-  bool output_file_owned_ = false;
+  size_t events_per_thread_ RTC_GUARDED_BY(crit_) = 0;
+  std::atomic<uint64_t> generation_{0};
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_ RTC_GUARDED_BY(crit_);
 };
 
-static void EventTracingThreadFunc(void* params) {
-  static_cast<EventLogger*>(params)->Log();
-}
+constexpr size_t RingBufferLogger::kMaxCopiedStringLength;
+constexpr int RingBufferLogger::kMaxArgs;
+constexpr const char* RingBufferLogger::kCopiedArgNames[];
 
 static EventLogger* volatile g_event_logger = nullptr;
 static const char* const kDisabledTracePrefix = TRACE_DISABLED_BY_DEFAULT("");
@@ -349,6 +645,14 @@ void InternalAddTraceEvent(char phase,
                            const unsigned char* arg_types,
                            const unsigned long long* arg_values,
                            unsigned char flags) {
+  if (rtc::AtomicOps::AcquireLoad(&g_ring_buffer_active) != 0) {
+    RingBufferLogger::Get()->AddTraceEvent(name, category_enabled, phase,
+                                           num_args, arg_names, arg_types,
+                                           arg_values, flags,
+                                           rtc::TimeMicros());
+    return;
+  }
+
   // Fast path for when event tracing is inactive.
   if (rtc::AtomicOps::AcquireLoad(&g_event_logging_active) == 0)
     return;
@@ -368,14 +672,17 @@ void SetupInternalTracer() {
 }
 
 void StartInternalCaptureToFile(FILE* file) {
-  if (g_event_logger) {
+  if (g_event_logger &&
+      rtc::AtomicOps::AcquireLoad(&g_ring_buffer_active) == 0) {
     g_event_logger->Start(file, false);
   }
 }
 
 bool StartInternalCapture(const char* filename) {
-  if (!g_event_logger)
+  if (!g_event_logger ||
+      rtc::AtomicOps::AcquireLoad(&g_ring_buffer_active) != 0) {
     return false;
+  }
 
   FILE* file = fopen(filename, "w");
   if (!file) {
@@ -387,7 +694,24 @@ bool StartInternalCapture(const char* filename) {
   return true;
 }
 
+bool StartInternalRingBufferCapture(size_t events_per_thread) {
+  if (!g_event_logger ||
+      rtc::AtomicOps::AcquireLoad(&g_event_logging_active) != 0) {
+    return false;
+  }
+  RingBufferLogger::Get()->Start(events_per_thread);
+  return true;
+}
+
+bool DumpInternalRingBufferCapture(FILE* file) {
+  if (rtc::AtomicOps::AcquireLoad(&g_ring_buffer_active) == 0)
+    return false;
+  RingBufferLogger::Get()->Dump(file);
+  return true;
+}
+
 void StopInternalCapture() {
+  RingBufferLogger::Get()->Stop();
   if (g_event_logger) {
     g_event_logger->Stop();
   }
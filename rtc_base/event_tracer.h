@@ -73,6 +73,17 @@ namespace tracing {
 void SetupInternalTracer();
 bool StartInternalCapture(const char* filename);
 void StartInternalCaptureToFile(FILE* file);
+// Starts keeping the last |events_per_thread| events of every thread in
+// memory, instead of writing all events to a file. Adding an event only copies
+// it into a buffer of the thread, without locking or allocating, which is
+// cheap enough to leave on so that stalls can be looked into after the fact.
+// Fails if a capture is already running.
+bool StartInternalRingBufferCapture(size_t events_per_thread);
+// Writes the kept events to |file| in the Chrome trace event format, which
+// chrome://tracing and the Perfetto UI load. Recording goes on. Fails if the
+// ring buffer capture is not running.
+bool DumpInternalRingBufferCapture(FILE* file);
+// Stops either kind of capture.
 void StopInternalCapture();
 // Make sure we run this, this will tear down the internal tracing.
 void ShutdownInternalTracer();
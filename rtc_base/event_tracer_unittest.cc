@@ -10,6 +10,11 @@
 
 #include "rtc_base/event_tracer.h"
 
+#include <stdio.h>
+
+#include <string>
+
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/trace_event.h"
 #include "test/gtest.h"
 
@@ -52,6 +57,23 @@ static void AddTraceEventHandler(char phase,
   TestStatistics::Get()->Increment();
 }
 
+std::string DumpRingBuffer() {
+  FILE* file = tmpfile();
+  EXPECT_TRUE(rtc::tracing::DumpInternalRingBufferCapture(file));
+  rewind(file);
+  std::string dump;
+  char buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    dump.append(buffer, read);
+  fclose(file);
+  return dump;
+}
+
+void TraceOnOtherThread(void* /* obj */) {
+  TRACE_EVENT_INSTANT0("webrtc", "OtherThreadEvent");
+}
+
 }  // namespace
 
 namespace webrtc {
@@ -69,4 +91,54 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   TestStatistics::Get()->Reset();
 }
 
+TEST(EventTracerTest, RingBufferKeepsLastEventsOfEachThread) {
+  rtc::tracing::SetupInternalTracer();
+  EXPECT_FALSE(rtc::tracing::DumpInternalRingBufferCapture(stdout));
+  ASSERT_TRUE(rtc::tracing::StartInternalRingBufferCapture(4));
+  EXPECT_FALSE(rtc::tracing::StartInternalCapture("unused"));
+  for (int i = 0; i < 10; ++i)
+    TRACE_EVENT_INSTANT1("webrtc", "Event", "index", i);
+  rtc::PlatformThread thread(&TraceOnOtherThread, nullptr, "OtherThread");
+  thread.Start();
+  thread.Stop();
+
+  const std::string dump = DumpRingBuffer();
+  EXPECT_EQ(0u, dump.find("{ \"traceEvents\": ["));
+  EXPECT_EQ(std::string::npos, dump.find("\"index\": 5 }"));
+  for (int i = 6; i < 10; ++i) {
+    EXPECT_NE(std::string::npos,
+              dump.find("\"index\": " + std::to_string(i) + " }"));
+  }
+  // The buffer of an exited thread is kept until another thread needs one.
+  EXPECT_NE(std::string::npos, dump.find("OtherThreadEvent"));
+
+  // A new capture starts empty.
+  rtc::tracing::StopInternalCapture();
+  ASSERT_TRUE(rtc::tracing::StartInternalRingBufferCapture(4));
+  EXPECT_EQ(std::string::npos, DumpRingBuffer().find("\"Event\""));
+  rtc::tracing::ShutdownInternalTracer();
+}
+
+TEST(EventTracerTest, RingBufferCopiesTemporaryStrings) {
+  rtc::tracing::SetupInternalTracer();
+  ASSERT_TRUE(rtc::tracing::StartInternalRingBufferCapture(16));
+  {
+    std::string value = "copied";
+    TRACE_EVENT_INSTANT1("webrtc", "CopyEvent", "value",
+                         TRACE_STR_COPY(value.c_str()));
+    std::string long_value(100, 'x');
+    TRACE_EVENT_INSTANT1("webrtc", "LongCopyEvent", "value",
+                         TRACE_STR_COPY(long_value.c_str()));
+    std::string name = "CopiedName";
+    TRACE_EVENT_COPY_INSTANT1("webrtc", name.c_str(), "value", 1);
+  }
+  const std::string dump = DumpRingBuffer();
+  EXPECT_NE(std::string::npos, dump.find("\"value\": \"copied\""));
+  // Truncated.
+  EXPECT_NE(std::string::npos,
+            dump.find("\"value\": \"" + std::string(15, 'x') + "\""));
+  EXPECT_NE(std::string::npos, dump.find("\"name\": \"CopiedName\""));
+  rtc::tracing::ShutdownInternalTracer();
+}
+
 }  // namespace webrtc
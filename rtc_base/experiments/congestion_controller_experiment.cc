@@ -25,6 +25,12 @@ bool CongestionControllerExperiment::BbrControllerEnabled() {
   return trial_string.find("Enabled,BBR") == 0;
 }
 
+bool CongestionControllerExperiment::L4sControllerEnabled() {
+  std::string trial_string =
+      webrtc::field_trial::FindFullName(kControllerExperiment);
+  return trial_string.find("Enabled,L4S") == 0;
+}
+
 bool CongestionControllerExperiment::InjectedControllerEnabled() {
   std::string trial_string =
       webrtc::field_trial::FindFullName(kControllerExperiment);
@@ -14,6 +14,7 @@ namespace webrtc {
 class CongestionControllerExperiment {
  public:
   static bool BbrControllerEnabled();
+  static bool L4sControllerEnabled();
   static bool InjectedControllerEnabled();
 };
 
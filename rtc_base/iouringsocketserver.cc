@@ -0,0 +1,585 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/iouringsocketserver.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/timeutils.h"
+
+namespace rtc {
+
+namespace {
+
+// Size of the submission queue. The completion queue is made larger, since
+// every UDP socket keeps several receives outstanding.
+const unsigned kSubmissionQueueEntries = 1024;
+const unsigned kCompletionQueueEntries = 8192;
+
+// Receives kept queued in the kernel per UDP socket.
+const size_t kRecvOperationsPerSocket = 8;
+// Sends that may be in flight per UDP socket before SendTo() reports
+// EWOULDBLOCK.
+const size_t kSendOperationsPerSocket = 64;
+// Receive buffer size. Larger datagrams are truncated by the kernel and
+// dropped.
+const size_t kRecvBufferSize = 4096;
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, 0, nullptr, 0));
+}
+
+}  // namespace
+
+// Minimal wrapper around the raw io_uring rings; liburing is not available
+// in all build environments.
+class IoUring {
+ public:
+  static std::unique_ptr<IoUring> Create() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = kCompletionQueueEntries;
+    int fd = IoUringSetup(kSubmissionQueueEntries, &params);
+    if (fd < 0) {
+      RTC_LOG_E(LS_INFO, EN, errno) << "io_uring_setup";
+      return nullptr;
+    }
+    // IORING_FEAT_NODROP (Linux 5.5) also guarantees IORING_OP_SENDMSG,
+    // IORING_OP_RECVMSG and IORING_OP_ASYNC_CANCEL.
+    if (!(params.features & IORING_FEAT_NODROP) ||
+        !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+      RTC_LOG(LS_INFO) << "io_uring lacks required features: "
+                       << params.features;
+      close(fd);
+      return nullptr;
+    }
+    std::unique_ptr<IoUring> ring(new IoUring(fd));
+    if (!ring->Map(params)) {
+      return nullptr;
+    }
+    return ring;
+  }
+
+  ~IoUring() {
+    if (sqes_)
+      munmap(sqes_, sqes_size_);
+    if (rings_)
+      munmap(rings_, rings_size_);
+    close(fd_);
+  }
+
+  int fd() const { return fd_; }
+
+  // Returns a zeroed submission entry, submitting queued entries first if the
+  // queue is full.
+  io_uring_sqe* GetSqe() {
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sq_tail_ - head >= sq_entries_) {
+      Submit();
+      head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+      if (sq_tail_ - head >= sq_entries_) {
+        RTC_LOG(LS_ERROR) << "io_uring submission queue full";
+        return nullptr;
+      }
+    }
+    unsigned index = sq_tail_ & sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++sq_tail_;
+    return sqe;
+  }
+
+  // Publishes queued entries to the kernel and starts them. Entries the
+  // kernel could not take yet stay queued for the next call.
+  void Submit() {
+    __atomic_store_n(sq_ktail_, sq_tail_, __ATOMIC_RELEASE);
+    unsigned to_submit = sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (to_submit == 0)
+      return;
+    while (IoUringEnter(fd_, to_submit, 0) < 0) {
+      if (errno == EINTR)
+        continue;
+      // EAGAIN and EBUSY mean the kernel is out of resources or completion
+      // space right now.
+      if (errno != EAGAIN && errno != EBUSY)
+        RTC_LOG_E(LS_ERROR, EN, errno) << "io_uring_enter";
+      return;
+    }
+  }
+
+  // Calls |handler| for every available completion, oldest first.
+  template <typename Handler>
+  void ReapCompletions(Handler handler) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+      io_uring_cqe cqe = cqes_[head & cq_mask_];
+      ++head;
+      // Release the slot before running the handler, which may submit more
+      // work.
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      handler(cqe);
+      tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    }
+  }
+
+ private:
+  explicit IoUring(int fd) : fd_(fd) {}
+
+  bool Map(const io_uring_params& params) {
+    rings_size_ =
+        std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                 params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    void* rings = mmap(nullptr, rings_size_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+    if (rings == MAP_FAILED) {
+      RTC_LOG_E(LS_ERROR, EN, errno) << "mmap io_uring rings";
+      return false;
+    }
+    rings_ = static_cast<char*>(rings);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      RTC_LOG_E(LS_ERROR, EN, errno) << "mmap io_uring sqes";
+      return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sq_head_ = reinterpret_cast<unsigned*>(rings_ + params.sq_off.head);
+    sq_ktail_ = reinterpret_cast<unsigned*>(rings_ + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned*>(rings_ + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(rings_ + params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+    sq_tail_ = *sq_ktail_;
+    cq_head_ = reinterpret_cast<unsigned*>(rings_ + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(rings_ + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(rings_ + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(rings_ + params.cq_off.cqes);
+    return true;
+  }
+
+  const int fd_;
+  char* rings_ = nullptr;
+  size_t rings_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_ktail_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  // Tail of locally prepared entries, published to |sq_ktail_| by Submit().
+  unsigned sq_tail_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+};
+
+// One receive or send queued in the ring. Its address is the user_data of the
+// submission, so it must stay alive until the completion is reaped.
+struct IoUringOperation {
+  enum Type { kRecv, kSend };
+
+  IoUringOperation(Type type, IoUringSocketState* state)
+      : type(type), state(state) {
+    memset(&msg, 0, sizeof(msg));
+    memset(&addr, 0, sizeof(addr));
+  }
+
+  const Type type;
+  IoUringSocketState* const state;
+  bool in_flight = false;
+  msghdr msg;
+  iovec iov;
+  sockaddr_storage addr;
+  char control[CMSG_SPACE(sizeof(timespec))];
+  Buffer data;
+  // Result of the completed receive.
+  size_t length = 0;
+};
+
+// Buffers and operations of one UDP socket. Owned by the socket while it is
+// open and by the server afterwards, until no operation is in flight.
+struct IoUringSocketState {
+  explicit IoUringSocketState(IoUringUdpSocket* socket) : socket(socket) {}
+
+  size_t in_flight() const {
+    size_t count = 0;
+    for (const auto& op : recv_ops)
+      count += op->in_flight;
+    for (const auto& op : send_ops)
+      count += op->in_flight;
+    return count;
+  }
+
+  // Null once the socket has been closed.
+  IoUringUdpSocket* socket;
+  std::vector<std::unique_ptr<IoUringOperation>> recv_ops;
+  std::vector<std::unique_ptr<IoUringOperation>> send_ops;
+  std::vector<IoUringOperation*> free_send_ops;
+  std::deque<IoUringOperation*> completed_recvs;
+};
+
+class IoUringUdpSocket : public SocketDispatcher {
+ public:
+  explicit IoUringUdpSocket(IoUringSocketServer* ss)
+      : SocketDispatcher(ss), server_(ss) {}
+  ~IoUringUdpSocket() override { Close(); }
+
+  // Readiness is reported by completions, so epoll only needs to watch for
+  // errors.
+  uint32_t GetRequestedEvents() override { return 0; }
+
+  int Bind(const SocketAddress& bind_addr) override {
+    int result = SocketDispatcher::Bind(bind_addr);
+    if (result == 0)
+      StartReceiving();
+    return result;
+  }
+
+  int Connect(const SocketAddress& addr) override {
+    int result = SocketDispatcher::Connect(addr);
+    if (result == 0)
+      StartReceiving();
+    return result;
+  }
+
+  int Send(const void* pv, size_t cb) override {
+    return QueueSend(pv, cb, nullptr) ? Flush(static_cast<int>(cb)) : -1;
+  }
+
+  int SendTo(const void* pv, size_t cb, const SocketAddress& addr) override {
+    return QueueSend(pv, cb, &addr) ? Flush(static_cast<int>(cb)) : -1;
+  }
+
+  int SendToBatch(const OutgoingDatagram* datagrams, size_t count) override {
+    size_t queued = 0;
+    while (queued < count &&
+           QueueSend(datagrams[queued].data, datagrams[queued].length,
+                     &datagrams[queued].destination)) {
+      ++queued;
+    }
+    if (queued == 0 && count > 0)
+      return SOCKET_ERROR;
+    return Flush(static_cast<int>(queued));
+  }
+
+  int Recv(void* buffer, size_t length, int64_t* timestamp) override {
+    return RecvFrom(buffer, length, nullptr, timestamp);
+  }
+
+  int RecvFrom(void* buffer,
+               size_t length,
+               SocketAddress* out_addr,
+               int64_t* timestamp) override {
+    if (!state_ || state_->completed_recvs.empty()) {
+      SetError(EWOULDBLOCK);
+      return SOCKET_ERROR;
+    }
+    IoUringOperation* op = state_->completed_recvs.front();
+    state_->completed_recvs.pop_front();
+    size_t received = std::min(length, op->length);
+    memcpy(buffer, op->data.data(), received);
+    if (out_addr)
+      SocketAddressFromSockAddrStorage(op->addr, out_addr);
+    if (timestamp)
+      *timestamp = GetTimestamp(op->msg);
+    SubmitRecv(op);
+    if (!server_->processing_completions_)
+      server_->ring()->Submit();
+    return static_cast<int>(received);
+  }
+
+  int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) override {
+    size_t received = 0;
+    for (; received < count; ++received) {
+      ReceivedDatagram& datagram = datagrams[received];
+      int result = RecvFrom(datagram.buffer, datagram.capacity,
+                            &datagram.source, &datagram.timestamp);
+      if (result < 0)
+        break;
+      datagram.length = static_cast<size_t>(result);
+    }
+    if (received == 0 && count > 0)
+      return SOCKET_ERROR;
+    return static_cast<int>(received);
+  }
+
+  int Close() override {
+    if (state_) {
+      for (const auto& op : state_->recv_ops)
+        Cancel(op.get());
+      for (const auto& op : state_->send_ops)
+        Cancel(op.get());
+      server_->ring()->Submit();
+      state_->socket = nullptr;
+      server_->Orphan(std::move(state_));
+    }
+    return SocketDispatcher::Close();
+  }
+
+  void OnCompletion(IoUringOperation* op, int result) {
+    if (op->type == IoUringOperation::kRecv) {
+      if (result >= 0 && !(op->msg.msg_flags & MSG_TRUNC)) {
+        op->length = static_cast<size_t>(result);
+        state_->completed_recvs.push_back(op);
+        SignalReadEvent(this);
+        return;
+      }
+      if (result >= 0) {
+        RTC_LOG(LS_WARNING) << "Dropped UDP datagram larger than "
+                            << kRecvBufferSize << " bytes";
+      } else {
+        // Typically an ICMP error for an earlier send.
+        RTC_LOG(LS_VERBOSE) << "io_uring recvmsg failed: " << -result;
+      }
+      SubmitRecv(op);
+      return;
+    }
+
+    if (result < 0) {
+      SetError(-result);
+      RTC_LOG(LS_VERBOSE) << "io_uring sendmsg failed: " << -result;
+    }
+    state_->free_send_ops.push_back(op);
+    if (write_blocked_) {
+      write_blocked_ = false;
+      SignalWriteEvent(this);
+    }
+  }
+
+ private:
+  void StartReceiving() {
+    if (state_)
+      return;
+    int enable = 1;
+    ::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+    state_.reset(new IoUringSocketState(this));
+    for (size_t i = 0; i < kRecvOperationsPerSocket; ++i) {
+      state_->recv_ops.emplace_back(
+          new IoUringOperation(IoUringOperation::kRecv, state_.get()));
+      IoUringOperation* op = state_->recv_ops.back().get();
+      op->data.SetSize(kRecvBufferSize);
+      SubmitRecv(op);
+    }
+    for (size_t i = 0; i < kSendOperationsPerSocket; ++i) {
+      state_->send_ops.emplace_back(
+          new IoUringOperation(IoUringOperation::kSend, state_.get()));
+      state_->free_send_ops.push_back(state_->send_ops.back().get());
+    }
+    server_->ring()->Submit();
+  }
+
+  void SubmitRecv(IoUringOperation* op) {
+    io_uring_sqe* sqe = server_->ring()->GetSqe();
+    if (!sqe)
+      return;
+    op->iov.iov_base = op->data.data();
+    op->iov.iov_len = op->data.size();
+    memset(&op->msg, 0, sizeof(op->msg));
+    op->msg.msg_name = &op->addr;
+    op->msg.msg_namelen = sizeof(op->addr);
+    op->msg.msg_iov = &op->iov;
+    op->msg.msg_iovlen = 1;
+    op->msg.msg_control = op->control;
+    op->msg.msg_controllen = sizeof(op->control);
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = s_;
+    sqe->addr = reinterpret_cast<uint64_t>(&op->msg);
+    sqe->len = 1;
+    sqe->user_data = reinterpret_cast<uint64_t>(op);
+    op->in_flight = true;
+  }
+
+  // Copies the datagram into a free send operation and queues it. Returns
+  // false, with EWOULDBLOCK set, if all send operations are in flight.
+  bool QueueSend(const void* pv, size_t cb, const SocketAddress* addr) {
+    if (!state_) {
+      // Sending on an unbound socket binds it implicitly.
+      StartReceiving();
+    }
+    if (state_->free_send_ops.empty()) {
+      write_blocked_ = true;
+      SetError(EWOULDBLOCK);
+      return false;
+    }
+    io_uring_sqe* sqe = server_->ring()->GetSqe();
+    if (!sqe) {
+      write_blocked_ = true;
+      SetError(EWOULDBLOCK);
+      return false;
+    }
+    IoUringOperation* op = state_->free_send_ops.back();
+    state_->free_send_ops.pop_back();
+    op->data.SetData(static_cast<const uint8_t*>(pv), cb);
+    op->iov.iov_base = op->data.data();
+    op->iov.iov_len = op->data.size();
+    memset(&op->msg, 0, sizeof(op->msg));
+    if (addr) {
+      op->msg.msg_name = &op->addr;
+      op->msg.msg_namelen =
+          static_cast<socklen_t>(addr->ToSockAddrStorage(&op->addr));
+    }
+    op->msg.msg_iov = &op->iov;
+    op->msg.msg_iovlen = 1;
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = s_;
+    sqe->addr = reinterpret_cast<uint64_t>(&op->msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = reinterpret_cast<uint64_t>(op);
+    op->in_flight = true;
+    return true;
+  }
+
+  int Flush(int result) {
+    server_->ring()->Submit();
+    return result;
+  }
+
+  void Cancel(IoUringOperation* op) {
+    if (!op->in_flight)
+      return;
+    io_uring_sqe* sqe = server_->ring()->GetSqe();
+    if (!sqe)
+      return;
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = reinterpret_cast<uint64_t>(op);
+    // Completions of cancel requests carry no operation.
+    sqe->user_data = 0;
+  }
+
+  static int64_t GetTimestamp(msghdr& msg) {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS) {
+        timespec ts;
+        memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        return kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
+               ts.tv_nsec / kNumNanosecsPerMicrosec;
+      }
+    }
+    return -1;
+  }
+
+  IoUringSocketServer* const server_;
+  std::unique_ptr<IoUringSocketState> state_;
+  bool write_blocked_ = false;
+};
+
+// Watches the ring descriptor, which becomes readable when completions are
+// available.
+class IoUringSocketServer::RingDispatcher : public Dispatcher {
+ public:
+  explicit RingDispatcher(IoUringSocketServer* ss) : ss_(ss) { ss_->Add(this); }
+  ~RingDispatcher() override { ss_->Remove(this); }
+
+  uint32_t GetRequestedEvents() override { return DE_READ; }
+  void OnPreEvent(uint32_t ff) override {}
+  void OnEvent(uint32_t ff, int err) override { ss_->ProcessCompletions(); }
+  int GetDescriptor() override { return ss_->ring()->fd(); }
+  bool IsDescriptorClosed() override { return false; }
+
+ private:
+  IoUringSocketServer* const ss_;
+};
+
+std::unique_ptr<IoUringSocketServer> IoUringSocketServer::Create() {
+  std::unique_ptr<IoUring> ring = IoUring::Create();
+  if (!ring)
+    return nullptr;
+  return std::unique_ptr<IoUringSocketServer>(
+      new IoUringSocketServer(std::move(ring)));
+}
+
+IoUringSocketServer::IoUringSocketServer(std::unique_ptr<IoUring> ring)
+    : ring_(std::move(ring)) {
+  ring_dispatcher_.reset(new RingDispatcher(this));
+}
+
+IoUringSocketServer::~IoUringSocketServer() {
+  ring_dispatcher_.reset();
+  // Closing the ring cancels whatever is still in flight; after that the
+  // orphaned buffers can be released.
+  ring_.reset();
+  orphans_.clear();
+}
+
+AsyncSocket* IoUringSocketServer::CreateAsyncSocket(int family, int type) {
+  if (type != SOCK_DGRAM)
+    return PhysicalSocketServer::CreateAsyncSocket(family, type);
+  IoUringUdpSocket* socket = new IoUringUdpSocket(this);
+  if (!socket->Create(family, type)) {
+    delete socket;
+    return nullptr;
+  }
+  return socket;
+}
+
+bool IoUringSocketServer::Wait(int cms, bool process_io) {
+  // Sends queued outside of Wait() are normally submitted right away; this
+  // catches entries left behind by a full kernel queue.
+  ring_->Submit();
+  return PhysicalSocketServer::Wait(cms, process_io);
+}
+
+void IoUringSocketServer::ProcessCompletions() {
+  processing_completions_ = true;
+  ring_->ReapCompletions([this](const io_uring_cqe& cqe) {
+    IoUringOperation* op = reinterpret_cast<IoUringOperation*>(cqe.user_data);
+    if (!op)
+      return;
+    op->in_flight = false;
+    IoUringSocketState* state = op->state;
+    if (state->socket) {
+      state->socket->OnCompletion(op, cqe.res);
+    }
+  });
+  // Resubmit the receives consumed by the handlers in one go.
+  ring_->Submit();
+  processing_completions_ = false;
+
+  orphans_.erase(
+      std::remove_if(orphans_.begin(), orphans_.end(),
+                     [](const std::unique_ptr<IoUringSocketState>& state) {
+                       return state->in_flight() == 0;
+                     }),
+      orphans_.end());
+}
+
+void IoUringSocketServer::Orphan(std::unique_ptr<IoUringSocketState> state) {
+  if (state->in_flight() > 0)
+    orphans_.push_back(std::move(state));
+}
+
+}  // namespace rtc
@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IOURINGSOCKETSERVER_H_
+#define RTC_BASE_IOURINGSOCKETSERVER_H_
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/physicalsocketserver.h"
+
+namespace rtc {
+
+class IoUring;
+class IoUringUdpSocket;
+struct IoUringSocketState;
+
+// A PhysicalSocketServer whose UDP sockets receive and send through an
+// io_uring submission/completion queue pair instead of one recvfrom() or
+// sendto() system call per datagram. Every UDP socket keeps a set of receive
+// operations queued in the kernel, and sends are queued without waiting for
+// them to complete. TCP sockets, signals and wake-ups keep using epoll; the
+// ring's descriptor is itself watched by epoll so completions are reaped from
+// the regular Wait() loop.
+//
+// Requires Linux 5.5 or later. Create() returns null when the kernel has no
+// suitable io_uring support, so callers can fall back to PhysicalSocketServer:
+//
+//   std::unique_ptr<rtc::SocketServer> ss = rtc::IoUringSocketServer::Create();
+//   if (!ss)
+//     ss.reset(new rtc::PhysicalSocketServer());
+//   auto network_thread = absl::make_unique<rtc::Thread>(std::move(ss));
+class IoUringSocketServer : public PhysicalSocketServer {
+ public:
+  static std::unique_ptr<IoUringSocketServer> Create();
+  ~IoUringSocketServer() override;
+
+  // SocketFactory:
+  AsyncSocket* CreateAsyncSocket(int family, int type) override;
+
+  // SocketServer:
+  bool Wait(int cms, bool process_io) override;
+
+ private:
+  friend class IoUringUdpSocket;
+  class RingDispatcher;
+
+  explicit IoUringSocketServer(std::unique_ptr<IoUring> ring);
+
+  IoUring* ring() { return ring_.get(); }
+  // Reaps all available completions and dispatches them to their sockets.
+  void ProcessCompletions();
+  // Takes over the state of a closed socket until the kernel has returned all
+  // operations still referring to its buffers.
+  void Orphan(std::unique_ptr<IoUringSocketState> state);
+
+  std::unique_ptr<IoUring> ring_;
+  std::unique_ptr<RingDispatcher> ring_dispatcher_;
+  std::vector<std::unique_ptr<IoUringSocketState>> orphans_;
+  bool processing_completions_ = false;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_IOURINGSOCKETSERVER_H_
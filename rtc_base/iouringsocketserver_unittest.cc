@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "rtc_base/arraysize.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/iouringsocketserver.h"
+#include "rtc_base/nethelpers.h"
+#include "rtc_base/socket_unittest.h"
+#include "rtc_base/testutils.h"
+
+namespace rtc {
+
+#define MAYBE_SKIP_IPV4                        \
+  if (!HasIPv4Enabled()) {                     \
+    RTC_LOG(LS_INFO) << "No IPv4... skipping"; \
+    return;                                    \
+  }
+
+#define MAYBE_SKIP_IO_URING                         \
+  if (!server_) {                                   \
+    RTC_LOG(LS_INFO) << "No io_uring... skipping"; \
+    return;                                         \
+  }
+
+class IoUringSocketServerTest : public SocketTest {
+ protected:
+  IoUringSocketServerTest() : server_(IoUringSocketServer::Create()) {
+    if (server_)
+      thread_.reset(new AutoSocketServerThread(server_.get()));
+  }
+
+  std::unique_ptr<IoUringSocketServer> server_;
+  std::unique_ptr<AutoSocketServerThread> thread_;
+};
+
+TEST_F(IoUringSocketServerTest, TestUdpIPv4) {
+  MAYBE_SKIP_IO_URING;
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestUdpReadyToSendIPv4) {
+  MAYBE_SKIP_IO_URING;
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpReadyToSendIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestSocketRecvTimestampIPv4) {
+  MAYBE_SKIP_IO_URING;
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSocketRecvTimestampIPv4();
+}
+
+// TCP sockets are not handled by the ring and must keep working through epoll.
+TEST_F(IoUringSocketServerTest, TestTcpIPv4) {
+  MAYBE_SKIP_IO_URING;
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestTcpIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestBatchIPv4) {
+  MAYBE_SKIP_IO_URING;
+  MAYBE_SKIP_IPV4;
+  SocketAddress any(kIPv4Loopback, 0);
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(receiver);
+  ASSERT_EQ(0, receiver->Bind(any));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(sender);
+  ASSERT_EQ(0, sender->Bind(any));
+
+  const char* kPayloads[] = {"one", "two", "three"};
+  OutgoingDatagram out[arraysize(kPayloads)];
+  for (size_t i = 0; i < arraysize(kPayloads); ++i) {
+    out[i].data = kPayloads[i];
+    out[i].length = strlen(kPayloads[i]);
+    out[i].destination = receiver->GetLocalAddress();
+  }
+  EXPECT_EQ(3, sender->SendToBatch(out, arraysize(out)));
+
+  char buffers[arraysize(kPayloads)][16];
+  ReceivedDatagram in[arraysize(kPayloads)];
+  for (size_t i = 0; i < arraysize(in); ++i) {
+    in[i].buffer = buffers[i];
+    in[i].capacity = sizeof(buffers[i]);
+  }
+  size_t received = 0;
+  int64_t deadline = TimeMillis() + kTimeout;
+  while (received < arraysize(in) && TimeMillis() < deadline) {
+    thread_->ProcessMessages(10);
+    int result = receiver->RecvFromBatch(in + received,
+                                         arraysize(in) - received);
+    if (result > 0)
+      received += result;
+  }
+  ASSERT_EQ(arraysize(kPayloads), received);
+  for (size_t i = 0; i < received; ++i) {
+    EXPECT_EQ(std::string(kPayloads[i]),
+              std::string(buffers[i], in[i].length));
+    EXPECT_EQ(sender->GetLocalAddress(), in[i].source);
+  }
+}
+
+// Closing a socket with receives still queued in the kernel must not leave
+// the kernel writing into freed buffers.
+TEST_F(IoUringSocketServerTest, TestCloseWithPendingOperations) {
+  MAYBE_SKIP_IO_URING;
+  MAYBE_SKIP_IPV4;
+  for (int i = 0; i < 16; ++i) {
+    std::unique_ptr<AsyncSocket> socket(
+        server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+    ASSERT_TRUE(socket);
+    ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  }
+  thread_->ProcessMessages(10);
+  TestUdpIPv4();
+}
+
+}  // namespace rtc
@@ -12,6 +12,7 @@
 
 #include <cstdio>
 #include <string>
+#include <utility>
 
 #include "rtc_base/checks.h"
 
@@ -70,4 +71,76 @@ CallSessionFileRotatingLogSink::CallSessionFileRotatingLogSink(
 
 CallSessionFileRotatingLogSink::~CallSessionFileRotatingLogSink() {}
 
+constexpr size_t AsyncLogSink::kDefaultMaxQueuedMessages;
+
+AsyncLogSink::AsyncLogSink(std::unique_ptr<LogSink> sink,
+                           size_t max_queued_messages)
+    : sink_(std::move(sink)),
+      queue_(max_queued_messages),
+      wake_up_(false, false),
+      writer_thread_(&AsyncLogSink::WriterThread, this, "AsyncLogSink") {
+  RTC_DCHECK(sink_);
+  RTC_DCHECK_GT(max_queued_messages, 0);
+  writer_thread_.Start();
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  stopping_.store(true, std::memory_order_release);
+  wake_up_.Set();
+  writer_thread_.Stop();
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message) {
+  // Assigned rather than copied, to reuse the capacity of the string swapped
+  // out of the queue.
+  pending_.message.assign(message);
+  pending_.severity = LS_NONE;
+  pending_.tag = nullptr;
+  Enqueue();
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message,
+                                LoggingSeverity sev,
+                                const char* tag) {
+  pending_.message.assign(message);
+  pending_.severity = sev;
+  pending_.tag = tag;
+  Enqueue();
+}
+
+void AsyncLogSink::Enqueue() {
+  if (!queue_.Insert(&pending_)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    total_dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+  wake_up_.Set();
+}
+
+// static
+void AsyncLogSink::WriterThread(void* obj) {
+  AsyncLogSink* sink = static_cast<AsyncLogSink*>(obj);
+  while (!sink->stopping_.load(std::memory_order_acquire)) {
+    sink->wake_up_.Wait(Event::kForever);
+    sink->WriteQueued();
+  }
+  sink->WriteQueued();
+}
+
+void AsyncLogSink::WriteQueued() {
+  while (queue_.Remove(&writing_)) {
+    if (writing_.tag) {
+      sink_->OnLogMessage(writing_.message, writing_.severity, writing_.tag);
+    } else {
+      sink_->OnLogMessage(writing_.message);
+    }
+  }
+  // Messages are dropped when the queue is full, i.e. after the ones just
+  // written.
+  const int dropped = dropped_.exchange(0, std::memory_order_relaxed);
+  if (dropped > 0) {
+    sink_->OnLogMessage("AsyncLogSink dropped " + std::to_string(dropped) +
+                        " messages.\n");
+  }
+}
+
 }  // namespace rtc
@@ -11,12 +11,16 @@
 #ifndef RTC_BASE_LOGSINKS_H_
 #define RTC_BASE_LOGSINKS_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/event.h"
 #include "rtc_base/filerotatingstream.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/swap_queue.h"
 
 namespace rtc {
 
@@ -66,6 +70,61 @@ class CallSessionFileRotatingLogSink : public FileRotatingLogSink {
   RTC_DISALLOW_COPY_AND_ASSIGN(CallSessionFileRotatingLogSink);
 };
 
+// Log sink that hands messages to another sink on a thread of its own, so that
+// logging threads don't wait for e.g. a FileRotatingLogSink to write to disk.
+// At most |max_queued_messages| messages wait to be written; messages logged
+// while the queue is full are dropped, and the number dropped is logged to
+// the wrapped sink once there's room again.
+//
+// Messages are passed through a SwapQueue, without locking. LogMessage calls
+// sinks one at a time, which is what SwapQueue requires of producers; other
+// callers of OnLogMessage() must do the same.
+class AsyncLogSink : public LogSink {
+ public:
+  static constexpr size_t kDefaultMaxQueuedMessages = 1000;
+
+  explicit AsyncLogSink(std::unique_ptr<LogSink> sink,
+                        size_t max_queued_messages = kDefaultMaxQueuedMessages);
+  // Writes the messages still queued before returning.
+  ~AsyncLogSink() override;
+
+  void OnLogMessage(const std::string& message) override;
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity sev,
+                    const char* tag) override;
+
+  // Number of messages dropped since the sink was created.
+  int num_dropped_messages() const {
+    return total_dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Entry {
+    std::string message;
+    LoggingSeverity severity = LS_NONE;
+    // Null for messages logged without severity and tag.
+    const char* tag = nullptr;
+  };
+
+  static void WriterThread(void* obj);
+  void Enqueue();
+  void WriteQueued();
+
+  const std::unique_ptr<LogSink> sink_;
+  // Used by the logging threads only.
+  Entry pending_;
+  webrtc::SwapQueue<Entry> queue_;
+  // Used on the writer thread only.
+  Entry writing_;
+  std::atomic<int> dropped_{0};
+  std::atomic<int> total_dropped_{0};
+  std::atomic<bool> stopping_{false};
+  Event wake_up_;
+  PlatformThread writer_thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncLogSink);
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_LOGSINKS_H_
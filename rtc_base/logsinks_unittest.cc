@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/logsinks.h"
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/platform_thread_types.h"
+
+namespace rtc {
+namespace {
+
+const int kEventTimeoutMs = 1000;
+
+// Records the messages it's given, and may block in OnLogMessage() until
+// released.
+class RecordingLogSink : public LogSink {
+ public:
+  struct Record {
+    CriticalSection lock;
+    std::vector<std::string> messages;
+    bool called_on_logging_thread = false;
+  };
+
+  RecordingLogSink(Record* record, Event* release)
+      : record_(record),
+        release_(release),
+        logging_thread_(CurrentThreadRef()) {}
+
+  void OnLogMessage(const std::string& message) override {
+    entered_.Set();
+    if (release_)
+      release_->Wait(Event::kForever);
+    CritScope lock(&record_->lock);
+    record_->messages.push_back(message);
+    if (IsThreadRefEqual(CurrentThreadRef(), logging_thread_))
+      record_->called_on_logging_thread = true;
+  }
+
+  bool WaitForEntered() { return entered_.Wait(kEventTimeoutMs); }
+
+ private:
+  Record* const record_;
+  Event* const release_;
+  const PlatformThreadRef logging_thread_;
+  Event entered_{false, false};
+};
+
+TEST(AsyncLogSinkTest, WritesMessagesInOrderOnAnotherThread) {
+  RecordingLogSink::Record record;
+  {
+    AsyncLogSink sink(std::unique_ptr<LogSink>(
+        new RecordingLogSink(&record, nullptr)));
+    for (int i = 0; i < 100; ++i)
+      sink.OnLogMessage(std::to_string(i));
+    EXPECT_EQ(0, sink.num_dropped_messages());
+  }
+
+  ASSERT_EQ(100u, record.messages.size());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(std::to_string(i), record.messages[i]);
+  EXPECT_FALSE(record.called_on_logging_thread);
+}
+
+TEST(AsyncLogSinkTest, DropsMessagesWhenQueueIsFull) {
+  RecordingLogSink::Record record;
+  Event release(true, false);
+  RecordingLogSink* recording_sink = new RecordingLogSink(&record, &release);
+  {
+    AsyncLogSink sink(std::unique_ptr<LogSink>(recording_sink), 2);
+    // The writer thread blocks on the first message, with the queue empty.
+    sink.OnLogMessage("first");
+    ASSERT_TRUE(recording_sink->WaitForEntered());
+    sink.OnLogMessage("queued 1");
+    sink.OnLogMessage("queued 2");
+    sink.OnLogMessage("dropped 1");
+    sink.OnLogMessage("dropped 2");
+    EXPECT_EQ(2, sink.num_dropped_messages());
+    release.Set();
+  }
+
+  ASSERT_EQ(4u, record.messages.size());
+  EXPECT_EQ("first", record.messages[0]);
+  EXPECT_EQ("queued 1", record.messages[1]);
+  EXPECT_EQ("queued 2", record.messages[2]);
+  EXPECT_EQ("AsyncLogSink dropped 2 messages.\n", record.messages[3]);
+}
+
+}  // namespace
+}  // namespace rtc
@@ -7,21 +7,38 @@
  *  in the file PATENTS.  All contributing project authors may
  *  be found in the AUTHORS file in the root of the source tree.
  */
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#elif defined(WEBRTC_POSIX)
+#include <sched.h>
+#endif
+
 #include <algorithm>
+#include <limits>
 
 #include "rtc_base/atomicops.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/messagequeue.h"
 #include "rtc_base/stringencode.h"
+#include "rtc_base/task_stats.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/trace_event.h"
 
 namespace rtc {
 namespace {
 
-const int kMaxMsgLatency = 150;                // 150 ms
-const int kSlowDispatchLoggingThreshold = 50;  // 50 ms
+const int kMaxMsgLatency = 150;  // 150 ms
+
+// Gives a producer that is halfway through PostedMessageList::Push() a chance
+// to finish linking its node.
+void YieldToProducer() {
+#if defined(WEBRTC_WIN)
+  ::Sleep(0);
+#else
+  sched_yield();
+#endif
+}
 
 class RTC_SCOPED_LOCKABLE MarkProcessingCritScope {
  public:
@@ -171,11 +188,409 @@ void MessageQueueManager::ProcessAllMessageQueuesInternal() {
   }
 }
 
+//------------------------------------------------------------------
+// PostedMessageList
+//
+// The queue itself is Dmitry Vyukov's intrusive MPSC queue: producers swap
+// their node into |head_| and then link the previous head to it, the consumer
+// walks from |tail_| and re-inserts |stub_| whenever it is about to take the
+// last node.
+
+struct PostedMessageList::Node {
+  std::atomic<Node*> next{nullptr};
+  // Next free pool node while this node is on the free stack.
+  std::atomic<uint32_t> next_free{kPoolSize};
+  // Index into |pool_|, or kPoolSize for heap allocated nodes.
+  uint32_t pool_index = kPoolSize;
+  Message msg;
+};
+
+const uint32_t PostedMessageList::kPoolSize;
+
+PostedMessageList::PostedMessageList()
+    : pool_(new Node[kPoolSize]),
+      free_top_(0),
+      head_(nullptr),
+      tail_(nullptr),
+      stub_(new Node()),
+      size_(0) {
+  for (uint32_t i = 0; i < kPoolSize; ++i) {
+    pool_[i].pool_index = i;
+    pool_[i].next_free.store(i + 1, std::memory_order_relaxed);
+  }
+  head_.store(stub_.get(), std::memory_order_relaxed);
+  tail_ = stub_.get();
+}
+
+PostedMessageList::~PostedMessageList() {
+  Message msg;
+  while (Pop(&msg)) {
+  }
+}
+
+PostedMessageList::Node* PostedMessageList::AllocateNode() {
+  uint64_t top = free_top_.load(std::memory_order_acquire);
+  while (true) {
+    uint32_t index = static_cast<uint32_t>(top);
+    if (index == kPoolSize)
+      return new Node();
+    uint32_t next = pool_[index].next_free.load(std::memory_order_relaxed);
+    uint64_t new_top = (((top >> 32) + 1) << 32) | next;
+    if (free_top_.compare_exchange_weak(top, new_top, std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+      return &pool_[index];
+    }
+  }
+}
+
+void PostedMessageList::FreeNode(Node* node) {
+  if (node->pool_index == kPoolSize) {
+    delete node;
+    return;
+  }
+  uint64_t top = free_top_.load(std::memory_order_relaxed);
+  uint64_t new_top;
+  do {
+    node->next_free.store(static_cast<uint32_t>(top),
+                          std::memory_order_relaxed);
+    new_top = (((top >> 32) + 1) << 32) | node->pool_index;
+  } while (!free_top_.compare_exchange_weak(
+      top, new_top, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void PostedMessageList::Push(const Message& msg) {
+  Node* node = AllocateNode();
+  node->msg = msg;
+  node->next.store(nullptr, std::memory_order_relaxed);
+  // Counted before the node becomes visible so size() never underflows.
+  size_.fetch_add(1, std::memory_order_release);
+  Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+}
+
+bool PostedMessageList::Pop(Message* msg) {
+  Node* const stub = stub_.get();
+  while (true) {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == stub) {
+      if (!next) {
+        if (head_.load(std::memory_order_acquire) == stub)
+          return false;
+        // A producer has swapped in its node but not linked it yet.
+        YieldToProducer();
+        continue;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (!next) {
+      if (head_.load(std::memory_order_acquire) != tail) {
+        // Another push is in flight behind |tail|.
+        YieldToProducer();
+        continue;
+      }
+      // |tail| is the last node; put the stub behind it so it can be taken.
+      stub->next.store(nullptr, std::memory_order_relaxed);
+      Node* prev = head_.exchange(stub, std::memory_order_acq_rel);
+      prev->next.store(stub, std::memory_order_release);
+      next = tail->next.load(std::memory_order_acquire);
+      if (!next) {
+        YieldToProducer();
+        continue;
+      }
+    }
+    tail_ = next;
+    *msg = tail->msg;
+    FreeNode(tail);
+    size_.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+}
+
+//------------------------------------------------------------------
+// DelayedMessageWheel
+//
+// Slot i of level L covers the times whose bits [8L, 8L + 8) equal i. A node
+// is put on the lowest level where its trigger time shares all higher bits
+// with |now_|, so on level L > 0 it always lies in a later slot than |now_|.
+// When |now_| reaches the start of such a slot, its nodes are re-placed on
+// lower levels; level 0 slots hold a single millisecond and are expired as a
+// whole.
+
+struct DelayedMessageWheel::Node {
+  Node* prev = nullptr;
+  Node* next = nullptr;
+  int64_t trigger = 0;
+  uint32_t num = 0;
+  Message msg;
+};
+
+const int64_t DelayedMessageWheel::kNever =
+    std::numeric_limits<int64_t>::max();
+
+namespace {
+
+const size_t kWheelChunkSize = 64;
+
+// Whether |a| is triggered before |b|. Identical trigger times are ordered by
+// insertion number; if a queue processes 1 message every millisecond for 50
+// days this wraps, and then only messages with identical times will be
+// misordered, and only briefly.
+template <class Node>
+bool TriggersBefore(const Node* a, const Node* b) {
+  if (a->trigger != b->trigger)
+    return a->trigger < b->trigger;
+  return static_cast<int32_t>(a->num - b->num) < 0;
+}
+
+template <class List, class Node>
+void Unlink(List* list, Node* node) {
+  (node->prev ? node->prev->next : list->head) = node->next;
+  (node->next ? node->next->prev : list->tail) = node->prev;
+  node->prev = node->next = nullptr;
+}
+
+template <class List, class Node>
+void Append(List* list, Node* node) {
+  node->prev = list->tail;
+  node->next = nullptr;
+  (list->tail ? list->tail->next : list->head) = node;
+  list->tail = node;
+}
+
+// Nodes mostly arrive in order, so search from the back.
+template <class List, class Node>
+void InsertSorted(List* list, Node* node) {
+  Node* after = list->tail;
+  while (after && TriggersBefore(node, after))
+    after = after->prev;
+  node->prev = after;
+  node->next = after ? after->next : list->head;
+  (node->next ? node->next->prev : list->tail) = node;
+  (after ? after->next : list->head) = node;
+}
+
+inline int SlotIndex(int64_t time, int level) {
+  return static_cast<int>((static_cast<uint64_t>(time) >> (8 * level)) & 0xff);
+}
+
+inline bool IsSlotStart(int64_t time, int level) {
+  return (static_cast<uint64_t>(time) & ((uint64_t{1} << (8 * level)) - 1)) ==
+         0;
+}
+
+}  // namespace
+
+DelayedMessageWheel::DelayedMessageWheel()
+    : now_(0), next_num_(0), size_(0), free_nodes_(nullptr) {
+  memset(occupied_, 0, sizeof(occupied_));
+}
+
+DelayedMessageWheel::~DelayedMessageWheel() {
+  // Messages are owned by the MessageQueue, which clears them before this.
+  RTC_DCHECK(empty());
+}
+
+DelayedMessageWheel::Node* DelayedMessageWheel::NewNode() {
+  if (!free_nodes_) {
+    chunks_.emplace_back(new Node[kWheelChunkSize]);
+    for (size_t i = 0; i < kWheelChunkSize; ++i)
+      FreeNode(&chunks_.back()[i]);
+  }
+  Node* node = free_nodes_;
+  free_nodes_ = node->next;
+  node->next = nullptr;
+  return node;
+}
+
+void DelayedMessageWheel::FreeNode(Node* node) {
+  node->msg = Message();
+  node->prev = nullptr;
+  node->next = free_nodes_;
+  free_nodes_ = node;
+}
+
+void DelayedMessageWheel::Insert(int64_t now,
+                                 int64_t trigger,
+                                 const Message& msg) {
+  if (empty())
+    now_ = now;
+  Node* node = NewNode();
+  node->trigger = trigger;
+  node->num = next_num_++;
+  node->msg = msg;
+  ++size_;
+  Place(node);
+}
+
+void DelayedMessageWheel::Place(Node* node) {
+  if (node->trigger < now_) {
+    InsertSorted(&expired_, node);
+    return;
+  }
+  uint64_t trigger = static_cast<uint64_t>(node->trigger);
+  uint64_t now = static_cast<uint64_t>(now_);
+  for (int level = 0; level < kLevels; ++level) {
+    int shift = kSlotBits * (level + 1);
+    if ((trigger >> shift) != (now >> shift))
+      continue;
+    int index = SlotIndex(node->trigger, level);
+    // Level 0 slots are expired as a whole, so keep them in FIFO order.
+    if (level == 0) {
+      InsertSorted(&slots_[level][index], node);
+    } else {
+      Append(&slots_[level][index], node);
+    }
+    occupied_[level][index / 64] |= uint64_t{1} << (index % 64);
+    return;
+  }
+  Append(&overflow_, node);
+}
+
+void DelayedMessageWheel::Cascade(int level, int index) {
+  List list = slots_[level][index];
+  slots_[level][index] = List();
+  occupied_[level][index / 64] &= ~(uint64_t{1} << (index % 64));
+  while (Node* node = list.head) {
+    Unlink(&list, node);
+    Place(node);
+  }
+}
+
+int DelayedMessageWheel::FindOccupied(int level, int from) const {
+  for (int word = from / 64; word < kWords; ++word) {
+    uint64_t bits = occupied_[level][word];
+    if (word == from / 64)
+      bits &= ~uint64_t{0} << (from % 64);
+    for (int bit = 0; bits; ++bit, bits >>= 1) {
+      if (bits & 1)
+        return word * 64 + bit;
+    }
+  }
+  return -1;
+}
+
+int64_t DelayedMessageWheel::NextEventTime() const {
+  int64_t next = kNever;
+  for (int level = 0; level < kLevels; ++level) {
+    // A slot on a higher level that |now_| has just reached without
+    // cascading it is still pending.
+    int current = SlotIndex(now_, level);
+    int from = (level == 0 || IsSlotStart(now_, level)) ? current : current + 1;
+    int index = from < kSlots ? FindOccupied(level, from) : -1;
+    if (index < 0)
+      continue;
+    int shift = kSlotBits * level;
+    uint64_t base = static_cast<uint64_t>(now_) >> (shift + kSlotBits)
+                                                << (shift + kSlotBits);
+    next = std::min(next, static_cast<int64_t>(
+                              base + (static_cast<uint64_t>(index) << shift)));
+  }
+  if (overflow_.head) {
+    int64_t boundary = IsSlotStart(now_, kLevels)
+                           ? now_
+                           : static_cast<int64_t>(
+                                 ((static_cast<uint64_t>(now_) >> 32) + 1)
+                                 << 32);
+    next = std::min(next, boundary);
+  }
+  return next;
+}
+
+void DelayedMessageWheel::Advance(int64_t now) {
+  while (now_ <= now) {
+    int64_t next = NextEventTime();
+    if (next > now) {
+      now_ = now + 1;
+      return;
+    }
+    now_ = next;
+    if (IsSlotStart(now_, kLevels)) {
+      List list = overflow_;
+      overflow_ = List();
+      while (Node* node = list.head) {
+        Unlink(&list, node);
+        Place(node);
+      }
+    }
+    for (int level = kLevels - 1; level > 0; --level) {
+      if (IsSlotStart(now_, level))
+        Cascade(level, SlotIndex(now_, level));
+    }
+    // Everything in this slot triggers at |now_|, after all of |expired_|.
+    int index = SlotIndex(now_, 0);
+    List& slot = slots_[0][index];
+    if (slot.head) {
+      slot.head->prev = expired_.tail;
+      (expired_.tail ? expired_.tail->next : expired_.head) = slot.head;
+      expired_.tail = slot.tail;
+      slot = List();
+      occupied_[0][index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+    ++now_;
+  }
+}
+
+bool DelayedMessageWheel::PopDue(int64_t now, Message* msg) {
+  Advance(now);
+  Node* node = expired_.head;
+  if (!node || node->trigger > now)
+    return false;
+  Unlink(&expired_, node);
+  *msg = node->msg;
+  FreeNode(node);
+  --size_;
+  return true;
+}
+
+int64_t DelayedMessageWheel::NextDueTime() const {
+  if (expired_.head)
+    return expired_.head->trigger;
+  return NextEventTime();
+}
+
+void DelayedMessageWheel::ClearList(List* list,
+                                    MessageHandler* phandler,
+                                    uint32_t id,
+                                    MessageList* removed) {
+  for (Node* node = list->head; node;) {
+    Node* next = node->next;
+    if (node->msg.Match(phandler, id)) {
+      if (removed) {
+        removed->push_back(node->msg);
+      } else {
+        delete node->msg.pdata;
+      }
+      Unlink(list, node);
+      FreeNode(node);
+      --size_;
+    }
+    node = next;
+  }
+}
+
+void DelayedMessageWheel::Clear(MessageHandler* phandler,
+                                uint32_t id,
+                                MessageList* removed) {
+  ClearList(&expired_, phandler, id, removed);
+  for (int level = 0; level < kLevels; ++level) {
+    for (int index = FindOccupied(level, 0); index >= 0;
+         index = index + 1 < kSlots ? FindOccupied(level, index + 1) : -1) {
+      List* slot = &slots_[level][index];
+      ClearList(slot, phandler, id, removed);
+      if (!slot->head)
+        occupied_[level][index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+  }
+  ClearList(&overflow_, phandler, id, removed);
+}
+
 //------------------------------------------------------------------
 // MessageQueue
 MessageQueue::MessageQueue(SocketServer* ss, bool init_queue)
     : fPeekKeep_(false),
-      dmsgq_next_num_(0),
       fInitialized_(false),
       fDestroyed_(false),
       stop_(0),
@@ -298,21 +713,22 @@ bool MessageQueue::Get(Message* pmsg, int cmsWait, bool process_io) {
         // triggered and calculate the next trigger time.
         if (first_pass) {
           first_pass = false;
-          while (!dmsgq_.empty()) {
-            if (msCurrent < dmsgq_.top().msTrigger_) {
-              cmsDelayNext = TimeDiff(dmsgq_.top().msTrigger_, msCurrent);
-              break;
-            }
-            msgq_.push_back(dmsgq_.top().msg_);
-            dmsgq_.pop();
+          Message delayed;
+          while (dmsgq_.PopDue(msCurrent, &delayed)) {
+            // Messages posted before the timer fired go first.
+            MovePostedMessages();
+            msgq_.push_back(delayed);
           }
+          int64_t next_due = dmsgq_.NextDueTime();
+          if (next_due != DelayedMessageWheel::kNever)
+            cmsDelayNext = TimeDiff(next_due, msCurrent);
         }
         // Pull a message off the message queue, if available.
-        if (msgq_.empty()) {
-          break;
-        } else {
+        if (!msgq_.empty()) {
           *pmsg = msgq_.front();
           msgq_.pop_front();
+        } else if (!posted_.Pop(pmsg)) {
+          break;
         }
       }  // crit_ is released here.
 
@@ -377,25 +793,28 @@ void MessageQueue::Post(const Location& posted_from,
   if (IsQuitting())
     return;
 
-  // Keep thread safe
-  // Add the message to the end of the queue
+  // Add the message to the end of the lock-free queue
   // Signal for the multiplexer to return
 
-  {
-    CritScope cs(&crit_);
-    Message msg;
-    msg.posted_from = posted_from;
-    msg.phandler = phandler;
-    msg.message_id = id;
-    msg.pdata = pdata;
-    if (time_sensitive) {
-      msg.ts_sensitive = TimeMillis() + kMaxMsgLatency;
-    }
-    msgq_.push_back(msg);
+  Message msg;
+  msg.posted_from = posted_from;
+  msg.phandler = phandler;
+  msg.message_id = id;
+  msg.pdata = pdata;
+  msg.ready_time_us = TimeMicros();
+  if (time_sensitive) {
+    msg.ts_sensitive = TimeMillis() + kMaxMsgLatency;
   }
+  posted_.Push(msg);
   WakeUpSocketServer();
 }
 
+void MessageQueue::MovePostedMessages() {
+  Message msg;
+  while (posted_.Pop(&msg))
+    msgq_.push_back(msg);
+}
+
 void MessageQueue::PostDelayed(const Location& posted_from,
                                int cmsDelay,
                                MessageHandler* phandler,
@@ -435,7 +854,7 @@ void MessageQueue::DoDelayPost(const Location& posted_from,
   }
 
   // Keep thread safe
-  // Add to the priority queue. Gets sorted soonest first.
+  // Add to the timer wheel. Gets sorted soonest first.
   // Signal for the multiplexer to return.
 
   {
@@ -445,13 +864,8 @@ void MessageQueue::DoDelayPost(const Location& posted_from,
     msg.phandler = phandler;
     msg.message_id = id;
     msg.pdata = pdata;
-    DelayedMessage dmsg(cmsDelay, tstamp, dmsgq_next_num_, msg);
-    dmsgq_.push(dmsg);
-    // If this message queue processes 1 message every millisecond for 50 days,
-    // we will wrap this number.  Even then, only messages with identical times
-    // will be misordered, and then only briefly.  This is probably ok.
-    ++dmsgq_next_num_;
-    RTC_DCHECK_NE(0, dmsgq_next_num_);
+    msg.ready_time_us = tstamp * kNumMicrosecsPerMillisec;
+    dmsgq_.Insert(TimeMillis(), tstamp, msg);
   }
   WakeUpSocketServer();
 }
@@ -459,11 +873,11 @@ void MessageQueue::DoDelayPost(const Location& posted_from,
 int MessageQueue::GetDelay() {
   CritScope cs(&crit_);
 
-  if (!msgq_.empty())
+  if (!msgq_.empty() || !posted_.empty())
     return 0;
 
   if (!dmsgq_.empty()) {
-    int delay = TimeUntil(dmsgq_.top().msTrigger_);
+    int delay = static_cast<int>(TimeUntil(dmsgq_.NextDueTime()));
     if (delay < 0)
       delay = 0;
     return delay;
@@ -490,6 +904,7 @@ void MessageQueue::Clear(MessageHandler* phandler,
 
   // Remove from ordered message queue
 
+  MovePostedMessages();
   for (MessageList::iterator it = msgq_.begin(); it != msgq_.end();) {
     if (it->Match(phandler, id)) {
       if (removed) {
@@ -503,38 +918,20 @@ void MessageQueue::Clear(MessageHandler* phandler,
     }
   }
 
-  // Remove from priority queue. Not directly iterable, so use this approach
+  // Remove from the timer wheel
 
-  PriorityQueue::container_type::iterator new_end = dmsgq_.container().begin();
-  for (PriorityQueue::container_type::iterator it = new_end;
-       it != dmsgq_.container().end(); ++it) {
-    if (it->msg_.Match(phandler, id)) {
-      if (removed) {
-        removed->push_back(it->msg_);
-      } else {
-        delete it->msg_.pdata;
-      }
-    } else {
-      *new_end++ = *it;
-    }
-  }
-  dmsgq_.container().erase(new_end, dmsgq_.container().end());
-  dmsgq_.reheap();
+  dmsgq_.Clear(phandler, id, removed);
 }
 
 void MessageQueue::Dispatch(Message* pmsg) {
   TRACE_EVENT2("webrtc", "MessageQueue::Dispatch", "src_file_and_line",
                pmsg->posted_from.file_and_line(), "src_func",
                pmsg->posted_from.function_name());
-  int64_t start_time = TimeMillis();
+  const int64_t start_time_us = TimeMicros();
   pmsg->phandler->OnMessage(pmsg);
-  int64_t end_time = TimeMillis();
-  int64_t diff = TimeDiff(end_time, start_time);
-  if (diff >= kSlowDispatchLoggingThreshold) {
-    RTC_LOG(LS_INFO) << "Message took " << diff
-                     << "ms to dispatch. Posted from: "
-                     << pmsg->posted_from.ToString();
-  }
+  const int64_t end_time_us = TimeMicros();
+  task_stats::RecordTask(pmsg->posted_from, start_time_us - pmsg->ready_time_us,
+                         end_time_us - start_time_us);
 }
 
 }  // namespace rtc
@@ -14,9 +14,9 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <memory>
-#include <queue>
 #include <utility>
 #include <vector>
 
@@ -158,7 +158,11 @@ const uint32_t MQID_DISPOSE = static_cast<uint32_t>(-2);
 
 struct Message {
   Message()
-      : phandler(nullptr), message_id(0), pdata(nullptr), ts_sensitive(0) {}
+      : phandler(nullptr),
+        message_id(0),
+        pdata(nullptr),
+        ts_sensitive(0),
+        ready_time_us(0) {}
   inline bool Match(MessageHandler* handler, uint32_t id) const {
     return (handler == nullptr || handler == phandler) &&
            (id == MQID_ANY || id == message_id);
@@ -168,30 +172,124 @@ struct Message {
   uint32_t message_id;
   MessageData* pdata;
   int64_t ts_sensitive;
+  // The TimeMicros() when the message was posted, or when it was due to run
+  // for a delayed message. The queueing delay reported to rtc::task_stats is
+  // measured from it.
+  int64_t ready_time_us;
 };
 
 typedef std::list<Message> MessageList;
 
-// DelayedMessage goes into a priority queue, sorted by trigger time.  Messages
-// with the same trigger time are processed in num_ (FIFO) order.
+// Lock-free multi-producer, single-consumer FIFO of Messages, used for the
+// immediate-message path of MessageQueue::Post(). Push() may be called from
+// any thread without locking; Pop() must be serialized by the caller
+// (MessageQueue holds |crit_|). Nodes come from a fixed-size pool, so posting
+// only allocates while more than kPoolSize messages are pending.
+class PostedMessageList {
+ public:
+  PostedMessageList();
+  ~PostedMessageList();
+
+  void Push(const Message& msg);
+  bool Pop(Message* msg);
+
+  // Only approximate while Push() is running on other threads.
+  size_t size() const { return size_.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0u; }
+
+ private:
+  struct Node;
+  static const uint32_t kPoolSize = 128;
+
+  Node* AllocateNode();
+  void FreeNode(Node* node);
+
+  std::unique_ptr<Node[]> pool_;
+  // Treiber stack of unused pool nodes. The low 32 bits are the pool index of
+  // the top node (kPoolSize when empty), the high 32 bits a tag bumped on
+  // every update to avoid ABA.
+  std::atomic<uint64_t> free_top_;
+  // Most recently pushed node; producers swap themselves in here.
+  std::atomic<Node*> head_;
+  // Oldest node, owned by the consumer. Starts out as |stub_|.
+  Node* tail_;
+  std::unique_ptr<Node> stub_;
+  std::atomic<size_t> size_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PostedMessageList);
+};
 
-class DelayedMessage {
+// Timer wheel holding the delayed messages of a MessageQueue, ordered by
+// trigger time and, for identical trigger times, in insertion (FIFO) order.
+// Messages due within the next 256 ms sit in per-millisecond slots; later ones
+// sit in three coarser levels of 256 slots each and are cascaded down as their
+// time approaches, so inserting costs O(1) whatever the number of pending
+// messages. Nodes are recycled, so steady-state posting does not allocate.
+// Not thread safe; MessageQueue guards it with |crit_|.
+class DelayedMessageWheel {
  public:
-  DelayedMessage(int64_t delay,
-                 int64_t trigger,
-                 uint32_t num,
-                 const Message& msg)
-      : cmsDelay_(delay), msTrigger_(trigger), num_(num), msg_(msg) {}
-
-  bool operator<(const DelayedMessage& dmsg) const {
-    return (dmsg.msTrigger_ < msTrigger_) ||
-           ((dmsg.msTrigger_ == msTrigger_) && (dmsg.num_ < num_));
-  }
+  static const int64_t kNever;
+
+  DelayedMessageWheel();
+  ~DelayedMessageWheel();
+
+  // Adds |msg| to be triggered at |trigger|. |now| is the current time.
+  void Insert(int64_t now, int64_t trigger, const Message& msg);
+  // Removes the earliest message triggered at or before |now| into |msg|.
+  // Returns false if there is none.
+  bool PopDue(int64_t now, Message* msg);
+  // Earliest time at which PopDue() may return a message, or kNever. This can
+  // be earlier than the actual first trigger time.
+  int64_t NextDueTime() const;
+  // Removes all messages matching |phandler| and |id|, see
+  // MessageQueue::Clear().
+  void Clear(MessageHandler* phandler, uint32_t id, MessageList* removed);
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0u; }
 
-  int64_t cmsDelay_;  // for debugging
-  int64_t msTrigger_;
-  uint32_t num_;
-  Message msg_;
+ private:
+  struct Node;
+  struct List {
+    Node* head = nullptr;
+    Node* tail = nullptr;
+  };
+  static const int kLevels = 4;
+  static const int kSlotBits = 8;
+  static const int kSlots = 1 << kSlotBits;
+  static const int kWords = kSlots / 64;
+
+  Node* NewNode();
+  void FreeNode(Node* node);
+  // Puts |node| into the slot, or list, its trigger time belongs in relative
+  // to |now_|.
+  void Place(Node* node);
+  // Re-places every node of slot |index| on |level|.
+  void Cascade(int level, int index);
+  // Moves the cursor past |now|, collecting due messages into |expired_|.
+  void Advance(int64_t now);
+  // Time of the next slot expiry or cascade, or kNever.
+  int64_t NextEventTime() const;
+  int FindOccupied(int level, int from) const;
+  void ClearList(List* list,
+                 MessageHandler* phandler,
+                 uint32_t id,
+                 MessageList* removed);
+
+  List slots_[kLevels][kSlots];
+  uint64_t occupied_[kLevels][kWords];
+  // Messages triggered before |now_|, sorted by trigger time.
+  List expired_;
+  // Messages too far in the future for the top level.
+  List overflow_;
+  // Everything triggered before |now_| is in |expired_|.
+  int64_t now_;
+  uint32_t next_num_;
+  size_t size_;
+  Node* free_nodes_;
+  std::vector<std::unique_ptr<Node[]>> chunks_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DelayedMessageWheel);
 };
 
 class MessageQueue {
@@ -269,7 +367,8 @@ class MessageQueue {
   bool empty() const { return size() == 0u; }
   size_t size() const {
     CritScope cs(&crit_);  // msgq_.size() is not thread safe.
-    return msgq_.size() + dmsgq_.size() + (fPeekKeep_ ? 1u : 0u);
+    return posted_.size() + msgq_.size() + dmsgq_.size() +
+           (fPeekKeep_ ? 1u : 0u);
   }
 
   // Internally posts a message which causes the doomed object to be deleted
@@ -285,12 +384,6 @@ class MessageQueue {
   sigslot::signal0<> SignalQueueDestroyed;
 
  protected:
-  class PriorityQueue : public std::priority_queue<DelayedMessage> {
-   public:
-    container_type& container() { return c; }
-    void reheap() { make_heap(c.begin(), c.end(), comp); }
-  };
-
   void DoDelayPost(const Location& posted_from,
                    int64_t cmsDelay,
                    int64_t tstamp,
@@ -308,11 +401,17 @@ class MessageQueue {
 
   void WakeUpSocketServer();
 
+  // Appends everything in |posted_| to |msgq_|. Must hold |crit_|.
+  void MovePostedMessages() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   bool fPeekKeep_;
   Message msgPeek_;
+  // Messages from Post(). Filled without |crit_|, drained under it.
+  PostedMessageList posted_;
+  // Older messages that must be delivered before |posted_|: triggered delayed
+  // messages, and posted messages kept back by Clear().
   MessageList msgq_ RTC_GUARDED_BY(crit_);
-  PriorityQueue dmsgq_ RTC_GUARDED_BY(crit_);
-  uint32_t dmsgq_next_num_ RTC_GUARDED_BY(crit_);
+  DelayedMessageWheel dmsgq_ RTC_GUARDED_BY(crit_);
   CriticalSection crit_;
   bool fInitialized_;
   bool fDestroyed_;
@@ -11,15 +11,20 @@
 #include "rtc_base/messagequeue.h"
 
 #include <functional>
+#include <map>
+#include <vector>
 
+#include "rtc_base/arraysize.h"
 #include "rtc_base/atomicops.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/nullsocketserver.h"
+#include "rtc_base/random.h"
 #include "rtc_base/refcount.h"
 #include "rtc_base/refcountedobject.h"
+#include "rtc_base/task_stats.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/timeutils.h"
 
@@ -98,6 +103,83 @@ TEST_F(MessageQueueTest, DisposeNotLocked) {
   EXPECT_FALSE(was_locked);
 }
 
+// Compares the wheel against a sorted map while inserting with delays that
+// land on every level, in the past, and beyond the top level.
+TEST(DelayedMessageWheelTest, PopsInTriggerOrder) {
+  webrtc::Random random(7);
+  DelayedMessageWheel wheel;
+  std::multimap<int64_t, uint32_t> expected;
+  int64_t now = 123456789;
+  uint32_t next_id = 0;
+  for (int step = 0; step < 2000; ++step) {
+    for (uint32_t i = random.Rand(3); i > 0; --i) {
+      int64_t delay;
+      switch (random.Rand(4)) {
+        case 0:
+          delay = random.Rand(-5, 5);
+          break;
+        case 1:
+          delay = random.Rand(300);
+          break;
+        case 2:
+          delay = random.Rand(70000);
+          break;
+        case 3:
+          delay = random.Rand(20000000);
+          break;
+        default:
+          delay = (int64_t{1} << 32) + random.Rand(100000);
+          break;
+      }
+      Message msg;
+      msg.message_id = next_id++;
+      wheel.Insert(now, now + delay, msg);
+      expected.insert(std::make_pair(now + delay, msg.message_id));
+    }
+    now += random.Rand(2) == 0 ? random.Rand(3) : random.Rand(5000000);
+    if (step == 1999)
+      now += int64_t{1} << 34;
+    Message msg;
+    while (wheel.PopDue(now, &msg)) {
+      ASSERT_FALSE(expected.empty());
+      EXPECT_LE(expected.begin()->first, now);
+      EXPECT_EQ(expected.begin()->second, msg.message_id);
+      expected.erase(expected.begin());
+    }
+    if (!expected.empty()) {
+      EXPECT_GT(expected.begin()->first, now);
+      EXPECT_LE(wheel.NextDueTime(), expected.begin()->first);
+    }
+    ASSERT_EQ(expected.size(), wheel.size());
+  }
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(DelayedMessageWheel::kNever, wheel.NextDueTime());
+}
+
+TEST(DelayedMessageWheelTest, ClearRemovesFromAllLevels) {
+  DelayedMessageWheel wheel;
+  const int64_t kDelays[] = {-1, 0, 10, 1000, 100000, 100000000,
+                             int64_t{1} << 33};
+  for (int64_t delay : kDelays) {
+    Message msg;
+    msg.message_id = 1;
+    wheel.Insert(0, delay, msg);
+    msg.message_id = 2;
+    wheel.Insert(0, delay, msg);
+  }
+  MessageList removed;
+  wheel.Clear(nullptr, 1, &removed);
+  EXPECT_EQ(arraysize(kDelays), removed.size());
+  EXPECT_EQ(arraysize(kDelays), wheel.size());
+
+  Message msg;
+  for (int64_t delay : kDelays) {
+    ASSERT_TRUE(wheel.PopDue(delay, &msg));
+    EXPECT_EQ(2u, msg.message_id);
+  }
+  EXPECT_TRUE(wheel.empty());
+}
+
 class DeletedMessageHandler : public MessageHandler {
  public:
   explicit DeletedMessageHandler(bool* deleted) : deleted_(deleted) {}
@@ -120,6 +202,112 @@ TEST_F(MessageQueueTest, DiposeHandlerWithPostedMessagePending) {
   EXPECT_TRUE(deleted);
 }
 
+TEST_F(MessageQueueTest, ClearRemovesPostedMessages) {
+  Post(RTC_FROM_HERE, nullptr, 1);
+  Post(RTC_FROM_HERE, nullptr, 2);
+  Post(RTC_FROM_HERE, nullptr, 1);
+  Post(RTC_FROM_HERE, nullptr, 3);
+  EXPECT_EQ(4u, size());
+  Clear(nullptr, 1);
+  EXPECT_EQ(2u, size());
+
+  Message msg;
+  EXPECT_TRUE(Get(&msg, 0));
+  EXPECT_EQ(2u, msg.message_id);
+  EXPECT_TRUE(Get(&msg, 0));
+  EXPECT_EQ(3u, msg.message_id);
+  EXPECT_FALSE(Get(&msg, 0));
+}
+
+class SleepingMessageHandler : public MessageHandler {
+ public:
+  explicit SleepingMessageHandler(int messages)
+      : messages_(messages), done_(false, false) {}
+  void OnMessage(Message* msg) override {
+    Thread::SleepMs(10);
+    if (--messages_ == 0)
+      done_.Set();
+  }
+  bool Wait() { return done_.Wait(1000); }
+
+ private:
+  int messages_;
+  Event done_;
+};
+
+TEST(MessageQueueTaskStatsTest, DispatchReportsTaskStats) {
+  task_stats::GetAndReset();
+  task_stats::Enable();
+  SleepingMessageHandler handler(2);
+  std::unique_ptr<Thread> thread(Thread::Create());
+  thread->Start();
+  const Location posted_from = RTC_FROM_HERE;
+  thread->Post(posted_from, &handler);
+  thread->PostDelayed(posted_from, 1, &handler);
+  EXPECT_TRUE(handler.Wait());
+  // Waits for the last dispatch to be recorded.
+  thread->Stop();
+  task_stats::Disable();
+
+  const task_stats::LocationStats* found = nullptr;
+  const std::vector<task_stats::LocationStats> all_stats =
+      task_stats::GetAndReset();
+  for (const auto& stats : all_stats) {
+    if (stats.posted_from.file_and_line() == posted_from.file_and_line())
+      found = &stats;
+  }
+  ASSERT_TRUE(found);
+  EXPECT_EQ(2, found->run_time.count);
+  EXPECT_GE(found->run_time.max_us, 10 * kNumMicrosecsPerMillisec);
+  // The delayed message waited behind the first one.
+  EXPECT_GT(found->queue_delay.max_us, 0);
+}
+
+const uint32_t kPostsPerThread = 1000;
+
+class Poster : public Runnable {
+ public:
+  Poster(MessageQueue* queue, uint32_t first_id)
+      : queue_(queue), first_id_(first_id) {}
+  void Run(Thread* thread) override {
+    for (uint32_t i = 0; i < kPostsPerThread; ++i)
+      queue_->Post(RTC_FROM_HERE, nullptr, first_id_ + i);
+  }
+
+ private:
+  MessageQueue* const queue_;
+  const uint32_t first_id_;
+};
+
+// Posts from several threads at once, more than fit in the node pool, must
+// all arrive, in order per posting thread.
+TEST_F(MessageQueueTest, PostsFromManyThreadsKeepPerThreadOrder) {
+  const uint32_t kThreads = 4;
+  std::vector<std::unique_ptr<Poster>> posters;
+  std::vector<std::unique_ptr<Thread>> threads;
+  for (uint32_t t = 0; t < kThreads; ++t) {
+    posters.emplace_back(new Poster(this, t * kPostsPerThread));
+    threads.push_back(Thread::Create());
+    threads.back()->Start(posters.back().get());
+  }
+
+  std::vector<uint32_t> next(kThreads, 0);
+  uint32_t received = 0;
+  int64_t deadline = TimeMillis() + 10000;
+  Message msg;
+  while (received < kThreads * kPostsPerThread && TimeMillis() < deadline) {
+    if (!Get(&msg, 10))
+      continue;
+    uint32_t t = msg.message_id / kPostsPerThread;
+    ASSERT_LT(t, kThreads);
+    EXPECT_EQ(next[t], msg.message_id % kPostsPerThread);
+    next[t] = msg.message_id % kPostsPerThread + 1;
+    ++received;
+  }
+  EXPECT_EQ(kThreads * kPostsPerThread, received);
+  EXPECT_FALSE(Get(&msg, 0));
+}
+
 struct UnwrapMainThreadScope {
   UnwrapMainThreadScope() : rewrap_(Thread::Current() != nullptr) {
     if (rewrap_)
@@ -19,6 +19,8 @@
 #endif
 
 #include <list>
+#include <string>
+#include <vector>
 
 #include "rtc_base/asyncresolverinterface.h"
 #include "rtc_base/signalthread.h"
@@ -52,6 +54,12 @@ class AsyncResolver : public SignalThread, public AsyncResolverInterface {
   int error_;
 };
 
+// Looks up |hostname| on the calling thread, which blocks until it is done.
+// Returns 0 on success, or the error from getaddrinfo().
+int ResolveHostname(const std::string& hostname,
+                    int family,
+                    std::vector<IPAddress>* addresses);
+
 // rtc namespaced wrappers for inet_ntop and inet_pton so we can avoid
 // the windows-native versions of these.
 const char* inet_ntop(int af, const void* src, char* dst, socklen_t size);
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/netlinknetworkmonitor.h"
+
+#include <errno.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace rtc {
+
+// Owns the netlink socket and reads it on the monitor's thread.
+class NetlinkNetworkMonitor::NetlinkDispatcher : public Dispatcher {
+ public:
+  NetlinkDispatcher(NetlinkNetworkMonitor* monitor, int fd)
+      : monitor_(monitor), fd_(fd) {
+    monitor_->socket_server_.Add(this);
+  }
+
+  ~NetlinkDispatcher() override {
+    monitor_->socket_server_.Remove(this);
+    close(fd_);
+  }
+
+  uint32_t GetRequestedEvents() override { return DE_READ; }
+
+  void OnPreEvent(uint32_t ff) override {}
+
+  void OnEvent(uint32_t ff, int err) override {
+    // Reads everything that is queued, so a burst of notifications, as when
+    // an interface goes down with all its addresses, results in a single
+    // update of the networks.
+    bool changed = false;
+    while (true) {
+      const ssize_t length =
+          recv(fd_, buffer_, sizeof(buffer_), MSG_DONTWAIT);
+      if (length < 0) {
+        if (errno == EINTR)
+          continue;
+        if (errno == ENOBUFS) {
+          // The socket buffer overflowed and notifications were lost, so
+          // there may be changes we haven't seen.
+          changed = true;
+          continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+          RTC_LOG_ERR(LS_WARNING) << "Failed to read netlink notifications";
+        break;
+      }
+      if (length == 0)
+        break;
+      changed |= HasNetworkChange(static_cast<size_t>(length));
+    }
+    if (changed)
+      monitor_->OnNetworksChanged();
+  }
+
+  int GetDescriptor() override { return fd_; }
+
+  bool IsDescriptorClosed() override { return false; }
+
+ private:
+  bool HasNetworkChange(size_t length) {
+    int remaining = static_cast<int>(length);
+    for (const nlmsghdr* header = reinterpret_cast<const nlmsghdr*>(buffer_);
+         NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+      switch (header->nlmsg_type) {
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+          return true;
+        default:
+          break;
+      }
+    }
+    return false;
+  }
+
+  NetlinkNetworkMonitor* const monitor_;
+  const int fd_;
+  alignas(nlmsghdr) char buffer_[8192];
+};
+
+NetlinkNetworkMonitor::NetlinkNetworkMonitor() : thread_(&socket_server_) {
+  thread_.SetName("NetlinkNetworkMonitor", this);
+}
+
+NetlinkNetworkMonitor::~NetlinkNetworkMonitor() {
+  Stop();
+}
+
+void NetlinkNetworkMonitor::Start() {
+  if (dispatcher_)
+    return;
+
+  const int fd =
+      socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
+             NETLINK_ROUTE);
+  if (fd < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to create netlink socket";
+    return;
+  }
+  sockaddr_nl address;
+  memset(&address, 0, sizeof(address));
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+  if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to subscribe to netlink notifications";
+    close(fd);
+    return;
+  }
+
+  // The dispatcher is added before the thread starts waiting on the socket
+  // server, so the first wait already includes it.
+  dispatcher_.reset(new NetlinkDispatcher(this, fd));
+  thread_.Start();
+  RTC_LOG(LS_INFO) << "Monitoring network changes with netlink";
+}
+
+void NetlinkNetworkMonitor::Stop() {
+  if (!dispatcher_)
+    return;
+  thread_.Stop();
+  dispatcher_.reset();
+}
+
+AdapterType NetlinkNetworkMonitor::GetAdapterType(
+    const std::string& interface_name) {
+  return ADAPTER_TYPE_UNKNOWN;
+}
+
+}  // namespace rtc
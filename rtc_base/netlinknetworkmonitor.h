@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETLINKNETWORKMONITOR_H_
+#define RTC_BASE_NETLINKNETWORKMONITOR_H_
+
+#include <memory>
+#include <string>
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/networkmonitor.h"
+#include "rtc_base/physicalsocketserver.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+
+// Linux network monitor that listens to the kernel's rtnetlink link and
+// address notifications, so network changes are seen as soon as they happen
+// instead of on the next poll of the interface list. The netlink socket is
+// read on a thread of its own, and changes are signaled on the thread that
+// created the monitor.
+class NetlinkNetworkMonitor : public NetworkMonitorBase {
+ public:
+  NetlinkNetworkMonitor();
+  ~NetlinkNetworkMonitor() override;
+
+  void Start() override;
+  void Stop() override;
+
+  // The adapter type can't be learned from netlink, so it is left to the
+  // name based guess of the network manager.
+  AdapterType GetAdapterType(const std::string& interface_name) override;
+
+  // True if Start() managed to subscribe to the notifications, and Stop()
+  // hasn't been called since.
+  bool IsMonitoring() const { return dispatcher_ != nullptr; }
+
+ private:
+  class NetlinkDispatcher;
+
+  PhysicalSocketServer socket_server_;
+  Thread thread_;
+  std::unique_ptr<NetlinkDispatcher> dispatcher_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NetlinkNetworkMonitor);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETLINKNETWORKMONITOR_H_
@@ -37,6 +37,9 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/networkmonitor.h"
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#include "rtc_base/netlinknetworkmonitor.h"
+#endif
 #include "rtc_base/socket.h"  // includes something that makes windows happy
 #include "rtc_base/stream.h"
 #include "rtc_base/stringencode.h"
@@ -49,7 +52,8 @@ namespace {
 const uint32_t kUpdateNetworksMessage = 1;
 const uint32_t kSignalNetworksMessage = 2;
 
-// Fetch list of networks every two seconds.
+// Fetch list of networks every two seconds, unless the network monitor
+// notifies about changes.
 const int kNetworksUpdateIntervalMs = 2000;
 
 const int kHighestNetworkPreference = 127;
@@ -468,7 +472,8 @@ BasicNetworkManager::BasicNetworkManager()
     : thread_(nullptr),
       sent_first_update_(false),
       start_count_(0),
-      ignore_non_default_routes_(false) {}
+      ignore_non_default_routes_(false),
+      netlink_network_monitor_(nullptr) {}
 
 BasicNetworkManager::~BasicNetworkManager() {}
 
@@ -860,11 +865,15 @@ void BasicNetworkManager::StopUpdating() {
 
 void BasicNetworkManager::StartNetworkMonitor() {
   NetworkMonitorFactory* factory = NetworkMonitorFactory::GetFactory();
-  if (factory == nullptr) {
-    return;
-  }
   if (!network_monitor_) {
-    network_monitor_.reset(factory->CreateNetworkMonitor());
+    if (factory) {
+      network_monitor_.reset(factory->CreateNetworkMonitor());
+    } else {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+      netlink_network_monitor_ = new NetlinkNetworkMonitor();
+      network_monitor_.reset(netlink_network_monitor_);
+#endif
+    }
     if (!network_monitor_) {
       return;
     }
@@ -946,6 +955,8 @@ void BasicNetworkManager::UpdateNetworksOnce() {
 
 void BasicNetworkManager::UpdateNetworksContinually() {
   UpdateNetworksOnce();
+  if (netlink_network_monitor_ && netlink_network_monitor_->IsMonitoring())
+    return;
   thread_->PostDelayed(RTC_FROM_HERE, kNetworksUpdateIntervalMs, this,
                        kUpdateNetworksMessage);
 }
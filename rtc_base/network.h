@@ -34,6 +34,7 @@ extern const char kPublicIPv4Host[];
 extern const char kPublicIPv6Host[];
 
 class IfAddrsConverter;
+class NetlinkNetworkMonitor;
 class Network;
 class NetworkMonitorInterface;
 class Thread;
@@ -266,7 +267,8 @@ class BasicNetworkManager : public NetworkManagerBase,
   // Called when it receives updates from the network monitor.
   void OnNetworksChanged();
 
-  // Updates the networks and reschedules the next update.
+  // Updates the networks and, unless the network monitor reports every
+  // change, reschedules the next update.
   void UpdateNetworksContinually();
   // Only updates the networks; does not reschedule the next update.
   void UpdateNetworksOnce();
@@ -277,6 +279,9 @@ class BasicNetworkManager : public NetworkManagerBase,
   std::vector<std::string> network_ignore_list_;
   bool ignore_non_default_routes_;
   std::unique_ptr<NetworkMonitorInterface> network_monitor_;
+  // Set when |network_monitor_| is the netlink monitor created on Linux in
+  // the absence of a NetworkMonitorFactory.
+  NetlinkNetworkMonitor* netlink_network_monitor_;
 };
 
 // Represents a Unix-type network interface, with a name and single address.
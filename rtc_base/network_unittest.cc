@@ -18,6 +18,9 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/nethelpers.h"
 #include "rtc_base/networkmonitor.h"
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#include "rtc_base/netlinknetworkmonitor.h"
+#endif
 #if defined(WEBRTC_POSIX)
 #include <net/if.h>
 #include <sys/types.h>
@@ -107,6 +110,10 @@ class NetworkTest : public testing::Test, public sigslot::has_slots<> {
     return static_cast<FakeNetworkMonitor*>(
         network_manager.network_monitor_.get());
   }
+  NetlinkNetworkMonitor* GetNetlinkNetworkMonitor(
+      BasicNetworkManager& network_manager) {
+    return network_manager.netlink_network_monitor_;
+  }
   void ClearNetworks(BasicNetworkManager& network_manager) {
     for (const auto& kv : network_manager.networks_map_) {
       delete kv.second;
@@ -1090,6 +1097,28 @@ TEST_F(NetworkTest, TestNetworkMonitoring) {
   NetworkMonitorFactory::ReleaseFactory(factory);
 }
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+TEST_F(NetworkTest, TestNetlinkNetworkMonitoring) {
+  BasicNetworkManager manager;
+  manager.SignalNetworksChanged.connect(static_cast<NetworkTest*>(this),
+                                        &NetworkTest::OnNetworksChanged);
+  // Without a NetworkMonitorFactory, changes are learned from netlink.
+  manager.StartUpdating();
+  NetlinkNetworkMonitor* network_monitor = GetNetlinkNetworkMonitor(manager);
+  ASSERT_TRUE(network_monitor);
+  EXPECT_TRUE(network_monitor->IsMonitoring());
+  EXPECT_TRUE_WAIT(callback_called_, 1000);
+  callback_called_ = false;
+
+  ClearNetworks(manager);
+  network_monitor->OnNetworksChanged();
+  EXPECT_TRUE_WAIT(callback_called_, 1000);
+
+  manager.StopUpdating();
+  EXPECT_FALSE(network_monitor->IsMonitoring());
+}
+#endif
+
 // Fails on Android: https://bugs.chromium.org/p/webrtc/issues/detail?id=4364.
 #if defined(WEBRTC_ANDROID)
 #define MAYBE_DefaultLocalAddress DISABLED_DefaultLocalAddress
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NUMERICS_MOVING_MAX_FILTER_H_
+#define RTC_BASE_NUMERICS_MOVING_MAX_FILTER_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/numerics/sliding_window.h"
+
+namespace webrtc {
+
+// Maximum of the latest |window_size| samples. Unlike rtc::MovingMaxCounter,
+// the window is a number of samples rather than a duration, so its storage is
+// allocated once. Inserting a sample takes amortized constant time, and so
+// does getting the maximum. With |Compare| = std::greater<T> it is a moving
+// minimum instead, see MovingMinFilter.
+template <typename T, typename Compare = std::less<T>>
+class MovingMaxFilter {
+ public:
+  // |window_size| must be positive.
+  explicit MovingMaxFilter(size_t window_size);
+
+  // Inserts a new sample, dropping the oldest one if the window is full.
+  void Insert(const T& value);
+
+  // Removes all samples.
+  void Reset();
+
+  // Maximum over the latest window, or nullopt if there are no samples.
+  absl::optional<T> GetFilteredValue() const;
+
+  // Number of samples in the window.
+  size_t GetNumberOfSamplesStored() const { return num_samples_; }
+
+ private:
+  const size_t window_size_;
+  // Candidates for the maximum, as (sample number, sample) pairs: the newest
+  // sample, and each older sample of the window that is not smaller than all
+  // newer ones. Sample numbers are increasing and samples non-increasing, so
+  // the front is the maximum.
+  SlidingWindow<std::pair<int64_t, T>> candidates_;
+  int64_t next_sample_number_;
+  size_t num_samples_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MovingMaxFilter);
+};
+
+template <typename T>
+using MovingMinFilter = MovingMaxFilter<T, std::greater<T>>;
+
+template <typename T, typename Compare>
+MovingMaxFilter<T, Compare>::MovingMaxFilter(size_t window_size)
+    : window_size_(window_size),
+      candidates_(window_size),
+      next_sample_number_(0),
+      num_samples_(0) {
+  RTC_CHECK_GT(window_size, 0);
+}
+
+template <typename T, typename Compare>
+void MovingMaxFilter<T, Compare>::Insert(const T& value) {
+  const Compare less;
+  while (!candidates_.empty() && less(candidates_.back().second, value))
+    candidates_.PopBack();
+  // Drop the candidate that falls out of the window.
+  if (!candidates_.empty() &&
+      candidates_.front().first + static_cast<int64_t>(window_size_) <=
+          next_sample_number_) {
+    candidates_.PopFront();
+  }
+  candidates_.PushBack(std::make_pair(next_sample_number_, value));
+  ++next_sample_number_;
+  if (num_samples_ < window_size_)
+    ++num_samples_;
+}
+
+template <typename T, typename Compare>
+void MovingMaxFilter<T, Compare>::Reset() {
+  candidates_.Clear();
+  num_samples_ = 0;
+}
+
+template <typename T, typename Compare>
+absl::optional<T> MovingMaxFilter<T, Compare>::GetFilteredValue() const {
+  if (candidates_.empty())
+    return absl::nullopt;
+  return candidates_.front().second;
+}
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_NUMERICS_MOVING_MAX_FILTER_H_
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/numerics/moving_max_filter.h"
+
+#include "rtc_base/arraysize.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(MovingMaxFilterTest, ProcessesNoSamples) {
+  MovingMaxFilter<int> filter(3);
+  EXPECT_FALSE(filter.GetFilteredValue());
+  EXPECT_EQ(0u, filter.GetNumberOfSamplesStored());
+}
+
+TEST(MovingMaxFilterTest, ReturnsMaxOfWindow) {
+  MovingMaxFilter<int> filter(3);
+  const int kSamples[] = {1, 5, 2, 3, 4, 4, 1, 0};
+  const int kExpectedFilteredValues[] = {1, 5, 5, 5, 4, 4, 4, 4};
+  for (size_t i = 0; i < arraysize(kSamples); ++i) {
+    filter.Insert(kSamples[i]);
+    EXPECT_EQ(kExpectedFilteredValues[i], filter.GetFilteredValue());
+  }
+  EXPECT_EQ(3u, filter.GetNumberOfSamplesStored());
+}
+
+TEST(MovingMaxFilterTest, ReturnsMinOfWindow) {
+  MovingMinFilter<int> filter(2);
+  const int kSamples[] = {3, 1, 2, 5, 4};
+  const int kExpectedFilteredValues[] = {3, 1, 1, 2, 4};
+  for (size_t i = 0; i < arraysize(kSamples); ++i) {
+    filter.Insert(kSamples[i]);
+    EXPECT_EQ(kExpectedFilteredValues[i], filter.GetFilteredValue());
+  }
+}
+
+TEST(MovingMaxFilterTest, ResetRemovesSamples) {
+  MovingMaxFilter<int> filter(2);
+  filter.Insert(10);
+  filter.Reset();
+  EXPECT_FALSE(filter.GetFilteredValue());
+  filter.Insert(1);
+  EXPECT_EQ(1, filter.GetFilteredValue());
+  EXPECT_EQ(1u, filter.GetNumberOfSamplesStored());
+}
+
+}  // namespace webrtc
@@ -11,15 +11,14 @@
 #ifndef RTC_BASE_NUMERICS_MOVING_MEDIAN_FILTER_H_
 #define RTC_BASE_NUMERICS_MOVING_MEDIAN_FILTER_H_
 
-#include <list>
-
-#include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
-#include "rtc_base/numerics/percentile_filter.h"
+#include "rtc_base/numerics/moving_percentile_filter.h"
 
 namespace webrtc {
 
 // Class to efficiently get moving median filter from a stream of samples.
+// Inserting a sample takes logarithmic time in the window size, and doesn't
+// allocate once the window has been filled.
 template <typename T>
 class MovingMedianFilter {
  public:
@@ -37,42 +36,28 @@ class MovingMedianFilter {
   T GetFilteredValue() const;
 
  private:
-  PercentileFilter<T> percentile_filter_;
-  std::list<T> samples_;
-  size_t samples_stored_;
-  const size_t window_size_;
+  MovingPercentileFilter<T> percentile_filter_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(MovingMedianFilter);
 };
 
 template <typename T>
 MovingMedianFilter<T>::MovingMedianFilter(size_t window_size)
-    : percentile_filter_(0.5f), samples_stored_(0), window_size_(window_size) {
-  RTC_CHECK_GT(window_size, 0);
-}
+    : percentile_filter_(0.5f, window_size) {}
 
 template <typename T>
 void MovingMedianFilter<T>::Insert(const T& value) {
   percentile_filter_.Insert(value);
-  samples_.emplace_back(value);
-  ++samples_stored_;
-  if (samples_stored_ > window_size_) {
-    percentile_filter_.Erase(samples_.front());
-    samples_.pop_front();
-    --samples_stored_;
-  }
 }
 
 template <typename T>
 T MovingMedianFilter<T>::GetFilteredValue() const {
-  return percentile_filter_.GetPercentileValue();
+  return percentile_filter_.GetFilteredValue();
 }
 
 template <typename T>
 void MovingMedianFilter<T>::Reset() {
   percentile_filter_.Reset();
-  samples_.clear();
-  samples_stored_ = 0;
 }
 
 }  // namespace webrtc
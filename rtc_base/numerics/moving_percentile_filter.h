@@ -0,0 +1,242 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NUMERICS_MOVING_PERCENTILE_FILTER_H_
+#define RTC_BASE_NUMERICS_MOVING_PERCENTILE_FILTER_H_
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/constructormagic.h"
+
+namespace webrtc {
+
+// Percentile of the latest |window_size| samples, with the same definition of
+// the percentile as PercentileFilter. The samples are kept in a ring, and
+// split between a max-heap of the samples up to the percentile and a min-heap
+// of the samples above it. Inserting a sample takes logarithmic time in the
+// window size, getting the percentile constant time, and neither allocates
+// once the window has been filled.
+template <typename T>
+class MovingPercentileFilter {
+ public:
+  // |percentile| should be between 0 and 1, and |window_size| positive.
+  MovingPercentileFilter(float percentile, size_t window_size);
+
+  // Inserts a new sample, dropping the oldest one if the window is full.
+  void Insert(const T& value);
+
+  // Removes all samples.
+  void Reset();
+
+  // Percentile over the latest window, or 0 if there are no samples.
+  T GetFilteredValue() const;
+
+  // Number of samples in the window.
+  size_t GetNumberOfSamplesStored() const { return num_samples_; }
+
+ private:
+  // Slots of |samples_|, as a binary heap with the largest sample on top for
+  // |lower_|, and the smallest one for |upper_|.
+  struct Heap {
+    explicit Heap(bool is_max_heap) : is_max_heap(is_max_heap) {}
+    const bool is_max_heap;
+    std::vector<size_t> slots;
+  };
+
+  // Whether |slot| belongs above |other_slot| in |heap|.
+  bool Above(const Heap& heap, size_t slot, size_t other_slot) const;
+  void Place(Heap* heap, size_t position, size_t slot);
+  void SiftUp(Heap* heap, size_t position);
+  void SiftDown(Heap* heap, size_t position);
+  void Push(Heap* heap, size_t slot);
+  size_t PopTop(Heap* heap);
+  // Restores the heap order after the sample of |slot| has been replaced.
+  void Update(size_t slot);
+  // Moves samples between the heaps, so that |lower_| holds the samples up to
+  // the percentile.
+  void Rebalance();
+
+  const float percentile_;
+  const size_t window_size_;
+  // Ring of samples, growing up to |window_size_|, and for each slot, its
+  // heap and position in it.
+  std::vector<T> samples_;
+  std::vector<bool> in_lower_;
+  std::vector<size_t> heap_positions_;
+  size_t oldest_slot_;
+  size_t num_samples_;
+  Heap lower_;
+  Heap upper_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MovingPercentileFilter);
+};
+
+template <typename T>
+MovingPercentileFilter<T>::MovingPercentileFilter(float percentile,
+                                                  size_t window_size)
+    : percentile_(percentile),
+      window_size_(window_size),
+      oldest_slot_(0),
+      num_samples_(0),
+      lower_(true),
+      upper_(false) {
+  RTC_CHECK_GE(percentile, 0.0f);
+  RTC_CHECK_LE(percentile, 1.0f);
+  RTC_CHECK_GT(window_size, 0);
+  samples_.reserve(window_size);
+  in_lower_.reserve(window_size);
+  heap_positions_.reserve(window_size);
+  lower_.slots.reserve(window_size);
+  upper_.slots.reserve(window_size);
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::Insert(const T& value) {
+  if (num_samples_ == window_size_) {
+    // The new sample takes the place of the oldest one.
+    const size_t slot = oldest_slot_;
+    samples_[slot] = value;
+    oldest_slot_ = (oldest_slot_ + 1) % window_size_;
+    Update(slot);
+    return;
+  }
+
+  // The ring doesn't wrap around until it is full.
+  const size_t slot = num_samples_;
+  if (slot < samples_.size()) {
+    samples_[slot] = value;
+  } else {
+    samples_.push_back(value);
+    in_lower_.push_back(true);
+    heap_positions_.push_back(0);
+  }
+  ++num_samples_;
+  Push(&lower_, slot);
+  Update(slot);
+  Rebalance();
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::Reset() {
+  lower_.slots.clear();
+  upper_.slots.clear();
+  oldest_slot_ = 0;
+  num_samples_ = 0;
+}
+
+template <typename T>
+T MovingPercentileFilter<T>::GetFilteredValue() const {
+  return lower_.slots.empty() ? 0 : samples_[lower_.slots[0]];
+}
+
+template <typename T>
+bool MovingPercentileFilter<T>::Above(const Heap& heap,
+                                      size_t slot,
+                                      size_t other_slot) const {
+  return heap.is_max_heap ? samples_[other_slot] < samples_[slot]
+                          : samples_[slot] < samples_[other_slot];
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::Place(Heap* heap,
+                                      size_t position,
+                                      size_t slot) {
+  heap->slots[position] = slot;
+  heap_positions_[slot] = position;
+  in_lower_[slot] = heap == &lower_;
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::SiftUp(Heap* heap, size_t position) {
+  const size_t slot = heap->slots[position];
+  while (position > 0) {
+    const size_t parent = (position - 1) / 2;
+    if (!Above(*heap, slot, heap->slots[parent]))
+      break;
+    Place(heap, position, heap->slots[parent]);
+    position = parent;
+  }
+  Place(heap, position, slot);
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::SiftDown(Heap* heap, size_t position) {
+  const size_t slot = heap->slots[position];
+  const size_t size = heap->slots.size();
+  while (true) {
+    size_t child = 2 * position + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size &&
+        Above(*heap, heap->slots[child + 1], heap->slots[child])) {
+      ++child;
+    }
+    if (!Above(*heap, heap->slots[child], slot))
+      break;
+    Place(heap, position, heap->slots[child]);
+    position = child;
+  }
+  Place(heap, position, slot);
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::Push(Heap* heap, size_t slot) {
+  heap->slots.push_back(slot);
+  SiftUp(heap, heap->slots.size() - 1);
+}
+
+template <typename T>
+size_t MovingPercentileFilter<T>::PopTop(Heap* heap) {
+  const size_t top = heap->slots[0];
+  const size_t last = heap->slots.back();
+  heap->slots.pop_back();
+  if (!heap->slots.empty()) {
+    Place(heap, 0, last);
+    SiftDown(heap, 0);
+  }
+  return top;
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::Update(size_t slot) {
+  Heap* heap = in_lower_[slot] ? &lower_ : &upper_;
+  SiftUp(heap, heap_positions_[slot]);
+  SiftDown(heap, heap_positions_[slot]);
+  if (lower_.slots.empty() || upper_.slots.empty())
+    return;
+  // Only the replaced sample can be on the wrong side, and then it is on top
+  // of its heap. Swapping the tops puts it, and the sample it passed, right.
+  const size_t lower_top = lower_.slots[0];
+  const size_t upper_top = upper_.slots[0];
+  if (samples_[upper_top] < samples_[lower_top]) {
+    Place(&lower_, 0, upper_top);
+    Place(&upper_, 0, lower_top);
+    SiftDown(&lower_, 0);
+    SiftDown(&upper_, 0);
+  }
+}
+
+template <typename T>
+void MovingPercentileFilter<T>::Rebalance() {
+  const size_t lower_size =
+      static_cast<size_t>(percentile_ * (num_samples_ - 1)) + 1;
+  while (lower_.slots.size() > lower_size)
+    Push(&upper_, PopTop(&lower_));
+  while (lower_.slots.size() < lower_size)
+    Push(&lower_, PopTop(&upper_));
+}
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_NUMERICS_MOVING_PERCENTILE_FILTER_H_
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/numerics/moving_percentile_filter.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+class MovingPercentileFilterTest : public ::testing::TestWithParam<float> {};
+
+INSTANTIATE_TEST_CASE_P(MovingPercentileFilterTests,
+                        MovingPercentileFilterTest,
+                        ::testing::Values(0.0f, 0.1f, 0.5f, 0.9f, 1.0f));
+
+TEST_P(MovingPercentileFilterTest, ProcessesNoSamples) {
+  MovingPercentileFilter<int> filter(GetParam(), 3);
+  EXPECT_EQ(0, filter.GetFilteredValue());
+  EXPECT_EQ(0u, filter.GetNumberOfSamplesStored());
+}
+
+TEST_P(MovingPercentileFilterTest, MatchesSortedWindow) {
+  const float percentile = GetParam();
+  // Make sure the test is deterministic by seeding with a constant.
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(0, 20);
+  for (size_t window_size : {1, 2, 5, 16}) {
+    MovingPercentileFilter<int> filter(percentile, window_size);
+    std::deque<int> window;
+    for (int i = 0; i < 200; ++i) {
+      // Small values, so that there are duplicates.
+      const int value = distribution(generator);
+      filter.Insert(value);
+      window.push_back(value);
+      if (window.size() > window_size)
+        window.pop_front();
+      std::vector<int> sorted(window.begin(), window.end());
+      std::sort(sorted.begin(), sorted.end());
+      const size_t index =
+          static_cast<size_t>(percentile * (sorted.size() - 1));
+      ASSERT_EQ(sorted[index], filter.GetFilteredValue())
+          << "window size " << window_size << ", sample " << i;
+      ASSERT_EQ(window.size(), filter.GetNumberOfSamplesStored());
+    }
+  }
+}
+
+TEST(MovingPercentileFilterTest, RefillsWindowAfterReset) {
+  MovingPercentileFilter<int> filter(1.0f, 3);
+  filter.Insert(10);
+  filter.Insert(30);
+  filter.Insert(20);
+  EXPECT_EQ(30, filter.GetFilteredValue());
+  filter.Reset();
+  EXPECT_EQ(0, filter.GetFilteredValue());
+  filter.Insert(5);
+  EXPECT_EQ(5, filter.GetFilteredValue());
+  filter.Insert(1);
+  filter.Insert(2);
+  filter.Insert(3);
+  // The 5 has left the window.
+  EXPECT_EQ(3, filter.GetFilteredValue());
+}
+
+}  // namespace webrtc
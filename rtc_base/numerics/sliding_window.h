@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NUMERICS_SLIDING_WINDOW_H_
+#define RTC_BASE_NUMERICS_SLIDING_WINDOW_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Holds the latest |capacity| values pushed to it, oldest first, in storage
+// that is allocated up front. Unlike a std::list or std::deque, pushing and
+// popping values never allocates.
+template <typename T>
+class SlidingWindow {
+ public:
+  // |capacity| must be positive.
+  explicit SlidingWindow(size_t capacity);
+
+  // Appends |value|, first removing the oldest value if the window is full.
+  void PushBack(const T& value);
+  // Removes the oldest value. The window must not be empty.
+  void PopFront();
+  // Removes the newest value. The window must not be empty.
+  void PopBack();
+  // Removes all values.
+  void Clear();
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == capacity_; }
+
+  // Index 0 is the oldest value.
+  const T& operator[](size_t index) const {
+    RTC_DCHECK_LT(index, size_);
+    return storage_[Slot(index)];
+  }
+  T& operator[](size_t index) {
+    RTC_DCHECK_LT(index, size_);
+    return storage_[Slot(index)];
+  }
+  const T& front() const { return (*this)[0]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+ private:
+  size_t Slot(size_t index) const {
+    const size_t slot = begin_ + index;
+    return slot < capacity_ ? slot : slot - capacity_;
+  }
+
+  const size_t capacity_;
+  // Grows up to |capacity_| values, so that T needs no default constructor.
+  std::vector<T> storage_;
+  size_t begin_;
+  size_t size_;
+};
+
+template <typename T>
+SlidingWindow<T>::SlidingWindow(size_t capacity)
+    : capacity_(capacity), begin_(0), size_(0) {
+  RTC_CHECK_GT(capacity, 0);
+  storage_.reserve(capacity);
+}
+
+template <typename T>
+void SlidingWindow<T>::PushBack(const T& value) {
+  if (full())
+    PopFront();
+  const size_t slot = Slot(size_);
+  if (slot < storage_.size()) {
+    storage_[slot] = value;
+  } else {
+    // Until the storage is filled, values are never wrapped around.
+    RTC_DCHECK_EQ(slot, storage_.size());
+    storage_.push_back(value);
+  }
+  ++size_;
+}
+
+template <typename T>
+void SlidingWindow<T>::PopFront() {
+  RTC_DCHECK(!empty());
+  begin_ = Slot(1);
+  --size_;
+}
+
+template <typename T>
+void SlidingWindow<T>::PopBack() {
+  RTC_DCHECK(!empty());
+  --size_;
+}
+
+template <typename T>
+void SlidingWindow<T>::Clear() {
+  begin_ = 0;
+  size_ = 0;
+}
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_NUMERICS_SLIDING_WINDOW_H_
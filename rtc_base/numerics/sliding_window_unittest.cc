@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/numerics/sliding_window.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(SlidingWindowTest, DropsOldestValueWhenFull) {
+  SlidingWindow<int> window(3);
+  EXPECT_TRUE(window.empty());
+  for (int i = 1; i <= 5; ++i)
+    window.PushBack(i);
+  EXPECT_TRUE(window.full());
+  ASSERT_EQ(3u, window.size());
+  EXPECT_EQ(3, window[0]);
+  EXPECT_EQ(4, window[1]);
+  EXPECT_EQ(5, window[2]);
+  EXPECT_EQ(3, window.front());
+  EXPECT_EQ(5, window.back());
+}
+
+TEST(SlidingWindowTest, PopsFromBothEnds) {
+  SlidingWindow<int> window(3);
+  window.PushBack(1);
+  window.PushBack(2);
+  window.PopFront();
+  window.PushBack(3);
+  window.PushBack(4);
+  window.PopBack();
+  window.PushBack(5);
+  ASSERT_EQ(3u, window.size());
+  EXPECT_EQ(2, window[0]);
+  EXPECT_EQ(3, window[1]);
+  EXPECT_EQ(5, window[2]);
+}
+
+TEST(SlidingWindowTest, ClearRemovesValues) {
+  SlidingWindow<int> window(2);
+  window.PushBack(1);
+  window.PushBack(2);
+  window.PushBack(3);
+  window.Clear();
+  EXPECT_TRUE(window.empty());
+  window.PushBack(4);
+  ASSERT_EQ(1u, window.size());
+  EXPECT_EQ(4, window.front());
+}
+
+}  // namespace webrtc
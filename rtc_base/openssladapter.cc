@@ -59,10 +59,34 @@ struct CRYPTO_dynlock_value {
 
 #endif  // #ifndef OPENSSL_IS_BORINGSSL
 
+// OpenSSL 3 can have the kernel encrypt the records it sends (kTLS on Linux).
+// It sets that up through controls of the write BIO, which it only defines
+// in internal headers (see bio.h), so they're repeated here.
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER >= 0x30000000L && \
+    !defined(OPENSSL_NO_KTLS) && defined(WEBRTC_LINUX) &&                   \
+    !defined(WEBRTC_ANDROID)
+#define WEBRTC_OPENSSL_KTLS
+static const int kBioCtrlSetKtlsSend = 72;
+static const int kBioCtrlSetKtlsSendCtrlMsg = 74;
+static const int kBioCtrlClearKtlsCtrlMsg = 75;
+#endif
+
 //////////////////////////////////////////////////////////////////////
 // SocketBIO
 //////////////////////////////////////////////////////////////////////
 
+// Data of a socket BIO.
+struct SocketBIOData {
+  explicit SocketBIOData(rtc::AsyncSocket* socket) : socket(socket) {}
+
+  rtc::AsyncSocket* const socket;
+  // Whether the kernel encrypts what's sent on |socket|.
+  bool ktls_send = false;
+  // If non-zero, the type of the record that the next write is, while
+  // |ktls_send| is set. Otherwise writes are application data.
+  uint8_t ktls_record_type = 0;
+};
+
 static int socket_write(BIO* h, const char* buf, int num);
 static int socket_read(BIO* h, char* buf, int size);
 static int socket_puts(BIO* h, const char* str);
@@ -89,10 +113,14 @@ static BIO* BIO_new_socket(rtc::AsyncSocket* socket) {
   if (ret == nullptr) {
     return nullptr;
   }
-  BIO_set_data(ret, socket);
+  BIO_set_data(ret, new SocketBIOData(socket));
   return ret;
 }
 
+static SocketBIOData* BIO_get_socket_data(BIO* b) {
+  return static_cast<SocketBIOData*>(BIO_get_data(b));
+}
+
 static int socket_new(BIO* b) {
   BIO_set_shutdown(b, 0);
   BIO_set_init(b, 1);
@@ -103,13 +131,15 @@ static int socket_new(BIO* b) {
 static int socket_free(BIO* b) {
   if (b == nullptr)
     return 0;
+  delete BIO_get_socket_data(b);
+  BIO_set_data(b, nullptr);
   return 1;
 }
 
 static int socket_read(BIO* b, char* out, int outl) {
   if (!out)
     return -1;
-  rtc::AsyncSocket* socket = static_cast<rtc::AsyncSocket*>(BIO_get_data(b));
+  rtc::AsyncSocket* socket = BIO_get_socket_data(b)->socket;
   BIO_clear_retry_flags(b);
   int result = socket->Recv(out, outl, nullptr);
   if (result > 0) {
@@ -123,9 +153,20 @@ static int socket_read(BIO* b, char* out, int outl) {
 static int socket_write(BIO* b, const char* in, int inl) {
   if (!in)
     return -1;
-  rtc::AsyncSocket* socket = static_cast<rtc::AsyncSocket*>(BIO_get_data(b));
+  SocketBIOData* data = BIO_get_socket_data(b);
+  rtc::AsyncSocket* socket = data->socket;
   BIO_clear_retry_flags(b);
-  int result = socket->Send(in, inl);
+  int result;
+  if (data->ktls_record_type != 0) {
+    // Records other than application data are sent one at a time.
+    result = socket->SendTlsRecord(data->ktls_record_type, in, inl);
+    if (result >= 0) {
+      data->ktls_record_type = 0;
+      result = inl;
+    }
+  } else {
+    result = socket->Send(in, inl);
+  }
   if (result > 0) {
     return result;
   } else if (socket->IsBlocking()) {
@@ -152,6 +193,26 @@ static long socket_ctrl(BIO* b, int cmd, long num, void* ptr) {  // NOLINT
       return 0;
     case BIO_CTRL_FLUSH:
       return 1;
+#if defined(WEBRTC_OPENSSL_KTLS)
+    case kBioCtrlSetKtlsSend: {
+      // |num| is zero for the receive direction, which stays with OpenSSL,
+      // since the kernel would need recvmsg() to pass record types.
+      SocketBIOData* data = BIO_get_socket_data(b);
+      if (num == 0 || !data->socket->EnableKernelTlsTx(ptr))
+        return 0;
+      RTC_LOG(LS_INFO) << "Using kernel TLS to send.";
+      data->ktls_send = true;
+      return 1;
+    }
+    case BIO_CTRL_GET_KTLS_SEND:
+      return BIO_get_socket_data(b)->ktls_send ? 1 : 0;
+    case kBioCtrlSetKtlsSendCtrlMsg:
+      BIO_get_socket_data(b)->ktls_record_type = static_cast<uint8_t>(num);
+      return 0;
+    case kBioCtrlClearKtlsCtrlMsg:
+      BIO_get_socket_data(b)->ktls_record_type = 0;
+      return 0;
+#endif  // WEBRTC_OPENSSL_KTLS
     default:
       return 0;
   }
@@ -259,6 +320,11 @@ void OpenSSLAdapter::SetRole(SSLRole role) {
   role_ = role;
 }
 
+void OpenSSLAdapter::SetKernelTlsOffload(bool enable) {
+  RTC_DCHECK(state_ == SSL_NONE);
+  kernel_tls_offload_ = enable;
+}
+
 AsyncSocket* OpenSSLAdapter::Accept(SocketAddress* paddr) {
   RTC_DCHECK(role_ == SSL_SERVER);
   AsyncSocket* socket = SSLAdapter::Accept(paddr);
@@ -346,6 +412,16 @@ int OpenSSLAdapter::BeginSSL() {
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
                          SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
+  // Lets OpenSSL use kernel TLS for the ciphers and TLS versions the kernel
+  // supports, once the keys are negotiated. Otherwise it encrypts itself.
+  if (kernel_tls_offload_ && ssl_mode_ == SSL_MODE_TLS) {
+#if defined(WEBRTC_OPENSSL_KTLS)
+    SSL_set_options(ssl_, SSL_OP_ENABLE_KTLS);
+#else
+    RTC_LOG(LS_INFO) << "Kernel TLS isn't supported by this build.";
+#endif
+  }
+
   // Enable SNI, if a hostname is supplied.
   if (!ssl_host_name_.empty()) {
     SSL_set_tlsext_host_name(ssl_, ssl_host_name_.c_str());
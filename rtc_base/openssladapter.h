@@ -52,6 +52,7 @@ class OpenSSLAdapter : public SSLAdapter, public MessageHandler {
   void SetCertVerifier(SSLCertificateVerifier* ssl_cert_verifier) override;
   void SetIdentity(SSLIdentity* identity) override;
   void SetRole(SSLRole role) override;
+  void SetKernelTlsOffload(bool enable) override;
   AsyncSocket* Accept(SocketAddress* paddr) override;
   int StartSSL(const char* hostname, bool restartable) override;
   int Send(const void* pv, size_t cb) override;
@@ -146,6 +147,8 @@ class OpenSSLAdapter : public SSLAdapter, public MessageHandler {
   std::vector<std::string> elliptic_curves_;
   // Holds the result of the call to run of the ssl_cert_verify_->Verify()
   bool custom_cert_verifier_status_;
+  // Whether to let the kernel encrypt sent records where it can.
+  bool kernel_tls_offload_ = false;
 };
 
 // The OpenSSLAdapterFactory is responsbile for creating multiple new
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/opensslhmac.h"
+
+#include <openssl/evp.h>
+#include <string.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/openssldigest.h"
+
+namespace rtc {
+
+namespace {
+
+// Large enough for the blocks of all digests in GetDigestEVP().
+const size_t kMaxBlockSize = 128;
+
+}  // namespace
+
+struct OpenSSLHmac::Contexts {
+  Contexts()
+      : inner(EVP_MD_CTX_new()),
+        outer(EVP_MD_CTX_new()),
+        message(EVP_MD_CTX_new()) {
+    RTC_CHECK(inner && outer && message);
+  }
+  ~Contexts() {
+    EVP_MD_CTX_free(inner);
+    EVP_MD_CTX_free(outer);
+    EVP_MD_CTX_free(message);
+  }
+
+  const EVP_MD* md = nullptr;
+  // The states after hashing the inner and the outer padded key.
+  EVP_MD_CTX* const inner;
+  EVP_MD_CTX* const outer;
+  // The inner hash of the current message.
+  EVP_MD_CTX* const message;
+};
+
+OpenSSLHmac::OpenSSLHmac(const std::string& algorithm,
+                         const void* key,
+                         size_t key_len)
+    : contexts_(new Contexts()) {
+  const EVP_MD* md;
+  if (!OpenSSLDigest::GetDigestEVP(algorithm, &md))
+    return;
+  contexts_->md = md;
+
+  const size_t block_len = EVP_MD_block_size(md);
+  RTC_DCHECK_LE(block_len, kMaxBlockSize);
+  // Keys longer than a block are hashed, and shorter ones are zero padded.
+  uint8_t block_key[kMaxBlockSize] = {0};
+  if (key_len > block_len) {
+    unsigned int md_len;
+    EVP_Digest(key, key_len, block_key, &md_len, md, nullptr);
+  } else {
+    memcpy(block_key, key, key_len);
+  }
+  uint8_t pad[kMaxBlockSize];
+  for (size_t i = 0; i < block_len; ++i)
+    pad[i] = 0x36 ^ block_key[i];
+  EVP_DigestInit_ex(contexts_->inner, md, nullptr);
+  EVP_DigestUpdate(contexts_->inner, pad, block_len);
+  for (size_t i = 0; i < block_len; ++i)
+    pad[i] = 0x5c ^ block_key[i];
+  EVP_DigestInit_ex(contexts_->outer, md, nullptr);
+  EVP_DigestUpdate(contexts_->outer, pad, block_len);
+
+  EVP_MD_CTX_copy_ex(contexts_->message, contexts_->inner);
+}
+
+OpenSSLHmac::~OpenSSLHmac() = default;
+
+size_t OpenSSLHmac::Size() const {
+  if (!contexts_->md)
+    return 0;
+  return EVP_MD_size(contexts_->md);
+}
+
+void OpenSSLHmac::Update(const void* buf, size_t len) {
+  if (!contexts_->md)
+    return;
+  EVP_DigestUpdate(contexts_->message, buf, len);
+}
+
+size_t OpenSSLHmac::Finish(void* buf, size_t len) {
+  if (!contexts_->md || len < Size())
+    return 0;
+  uint8_t inner[EVP_MAX_MD_SIZE];
+  unsigned int inner_len;
+  EVP_DigestFinal_ex(contexts_->message, inner, &inner_len);
+  // The outer hash reuses the message context, which restarts from the
+  // inner state afterwards.
+  EVP_MD_CTX_copy_ex(contexts_->message, contexts_->outer);
+  EVP_DigestUpdate(contexts_->message, inner, inner_len);
+  unsigned int md_len;
+  EVP_DigestFinal_ex(contexts_->message, static_cast<unsigned char*>(buf),
+                     &md_len);
+  EVP_MD_CTX_copy_ex(contexts_->message, contexts_->inner);
+  RTC_DCHECK_EQ(md_len, Size());
+  return md_len;
+}
+
+}  // namespace rtc
@@ -0,0 +1,53 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_OPENSSLHMAC_H_
+#define RTC_BASE_OPENSSLHMAC_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "rtc_base/constructormagic.h"
+
+namespace rtc {
+
+// Computes RFC 2104 HMACs of many messages with the same key. Unlike
+// ComputeHmac(), the padded key is hashed into the inner and outer states
+// only once, and every message then starts from copies of these states. This
+// saves the key setup and the buffer allocations of every computation.
+class OpenSSLHmac {
+ public:
+  // Creates an HMAC with |algorithm| (e.g. DIGEST_SHA_1) as the hash
+  // algorithm, keyed with |key_len| bytes of |key|.
+  OpenSSLHmac(const std::string& algorithm, const void* key, size_t key_len);
+  ~OpenSSLHmac();
+
+  // Returns the HMAC size, or 0 if |algorithm| is unknown.
+  size_t Size() const;
+  // Updates the HMAC of the current message with |len| bytes from |buf|.
+  void Update(const void* buf, size_t len);
+  // Outputs the HMAC of the current message to |buf| with length |len|, and
+  // starts the next message. Returns the number of bytes written, or 0 if
+  // |len| is too small.
+  size_t Finish(void* buf, size_t len);
+
+ private:
+  struct Contexts;
+
+  std::unique_ptr<Contexts> contexts_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(OpenSSLHmac);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_OPENSSLHMAC_H_
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/opensslhmac.h"
+
+#include <string>
+
+#include "rtc_base/gunit.h"
+#include "rtc_base/messagedigest.h"
+#include "rtc_base/stringencode.h"
+
+namespace rtc {
+
+namespace {
+
+std::string ComputeHex(OpenSSLHmac* hmac, const std::string& input) {
+  char output[64];
+  hmac->Update(input.data(), input.size());
+  size_t len = hmac->Finish(output, sizeof(output));
+  return hex_encode(output, len);
+}
+
+}  // namespace
+
+// Test vectors from RFC 2202, computed with the same key one after another.
+TEST(OpenSSLHmacTest, TestSha1Hmac) {
+  OpenSSLHmac hmac(DIGEST_SHA_1, "Jefe", 4);
+  EXPECT_EQ(20u, hmac.Size());
+  EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+            ComputeHex(&hmac, "what do ya want for nothing?"));
+  EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+            ComputeHex(&hmac, "what do ya want for nothing?"));
+
+  const std::string key(80, '\xaa');
+  OpenSSLHmac long_key_hmac(DIGEST_SHA_1, key.data(), key.size());
+  EXPECT_EQ(
+      "aa4ae5e15272d00e95705637ce8a3b55ed402112",
+      ComputeHex(&long_key_hmac,
+                 "Test Using Larger Than Block-Size Key - Hash Key First"));
+}
+
+TEST(OpenSSLHmacTest, MatchesComputeHmac) {
+  const std::string key = "a password of some length";
+  OpenSSLHmac hmac(DIGEST_SHA_256, key.data(), key.size());
+  for (int i = 0; i < 10; ++i) {
+    const std::string input(i * 37, static_cast<char>('a' + i));
+    EXPECT_EQ(ComputeHmac(DIGEST_SHA_256, key, input),
+              ComputeHex(&hmac, input));
+  }
+}
+
+TEST(OpenSSLHmacTest, UpdatesInPieces) {
+  OpenSSLHmac hmac(DIGEST_SHA_1, "Jefe", 4);
+  hmac.Update("what do ya", 10);
+  hmac.Update(" want for nothing?", 18);
+  char output[20];
+  ASSERT_EQ(sizeof(output), hmac.Finish(output, sizeof(output)));
+  EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+            hex_encode(output, sizeof(output)));
+}
+
+TEST(OpenSSLHmacTest, TestBadInput) {
+  OpenSSLHmac hmac(DIGEST_SHA_1, "Jefe", 4);
+  char output[19];
+  hmac.Update("abc", 3);
+  EXPECT_EQ(0u, hmac.Finish(output, sizeof(output)));
+
+  OpenSSLHmac bad_hmac("sha-9000", "Jefe", 4);
+  EXPECT_EQ(0u, bad_hmac.Size());
+  char bad_output[64];
+  bad_hmac.Update("abc", 3);
+  EXPECT_EQ(0u, bad_hmac.Finish(bad_output, sizeof(bad_output)));
+}
+
+}  // namespace rtc
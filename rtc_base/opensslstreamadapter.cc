@@ -21,23 +21,30 @@
 #include <openssl/ssl.h>
 #endif
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssladapter.h"
 #include "rtc_base/openssldigest.h"
 #include "rtc_base/opensslidentity.h"
+#include "rtc_base/opensslsessioncache.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/stringencode.h"
 #include "rtc_base/stringutils.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/timeutils.h"
 
 namespace {
 bool g_use_time_callback_for_testing = false;
+bool g_dtls_session_resumption = false;
 }
 
 namespace rtc {
@@ -262,6 +269,64 @@ static long stream_ctrl(BIO* b, int cmd, long num, void* ptr) {
   }
 }
 
+namespace {
+
+// Shares DTLS sessions between all the streams of the process. Servers encrypt
+// their session tickets with the same keys, so that any stream can resume a
+// session issued by another one. Clients keep the last session they had with
+// each pair of certificates, and offer it again to the same peer.
+class DtlsSessionCache {
+ public:
+  // Never destroyed, as streams may use it on any thread until exit.
+  static DtlsSessionCache* Get() {
+    static DtlsSessionCache* const cache = new DtlsSessionCache();
+    return cache;
+  }
+
+  // Makes |ctx| encrypt and decrypt session tickets with the shared keys.
+  void ConfigureContext(SSL_CTX* ctx) {
+    CritScope cs(&crit_);
+    SSL_CTX_set_tlsext_ticket_keys(ctx, ticket_keys_.data(),
+                                   ticket_keys_.size());
+  }
+
+  // Sets the session previously stored with |key| on |ssl|, if any.
+  bool ResumeSession(const std::string& key, SSL* ssl) {
+    CritScope cs(&crit_);
+    SSL_SESSION* session = cache_.LookupSession(key);
+    return session && SSL_set_session(ssl, session) == 1;
+  }
+
+  void AddSession(const std::string& key, SSL_SESSION* session) {
+    CritScope cs(&crit_);
+    SSL_SESSION_up_ref(session);
+    cache_.AddSession(key, session);
+  }
+
+ private:
+  DtlsSessionCache() : cache_(SSL_MODE_DTLS, NewContext()) {
+    // The cache holds a reference to the context now.
+    SSL_CTX* ctx = cache_.GetSSLContext();
+    SSL_CTX_free(ctx);
+    // The size of the keys differs between OpenSSL and BoringSSL.
+    ticket_keys_.resize(SSL_CTX_get_tlsext_ticket_keys(ctx, nullptr, 0));
+    RTC_CHECK_EQ(1, RAND_bytes(ticket_keys_.data(),
+                               static_cast<int>(ticket_keys_.size())));
+  }
+
+  static SSL_CTX* NewContext() {
+    SSL_CTX* ctx = SSL_CTX_new(DTLS_method());
+    RTC_CHECK(ctx);
+    return ctx;
+  }
+
+  CriticalSection crit_;
+  OpenSSLSessionCache cache_ RTC_GUARDED_BY(crit_);
+  std::vector<unsigned char> ticket_keys_;
+};
+
+}  // namespace
+
 /////////////////////////////////////////////////////////////////////////////
 // OpenSSLStreamAdapter
 /////////////////////////////////////////////////////////////////////////////
@@ -275,7 +340,8 @@ OpenSSLStreamAdapter::OpenSSLStreamAdapter(StreamInterface* stream)
       ssl_(nullptr),
       ssl_ctx_(nullptr),
       ssl_mode_(SSL_MODE_TLS),
-      ssl_max_version_(SSL_PROTOCOL_TLS_12) {}
+      ssl_max_version_(SSL_PROTOCOL_TLS_12),
+      session_resumption_(g_dtls_session_resumption) {}
 
 OpenSSLStreamAdapter::~OpenSSLStreamAdapter() {
   Cleanup(0);
@@ -469,6 +535,10 @@ bool OpenSSLStreamAdapter::IsTlsConnected() {
   return state_ == SSL_CONNECTED;
 }
 
+bool OpenSSLStreamAdapter::IsResumedSession() {
+  return ssl_ && SSL_session_reused(ssl_) == 1;
+}
+
 int OpenSSLStreamAdapter::StartSSL() {
   if (state_ != SSL_NONE) {
     // Don't allow StartSSL to be called twice.
@@ -799,6 +869,12 @@ int OpenSSLStreamAdapter::BeginSSL() {
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
                          SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
+  if (session_resumption_enabled() && role_ == SSL_CLIENT) {
+    std::string key = SessionCacheKey();
+    if (!key.empty() && DtlsSessionCache::Get()->ResumeSession(key, ssl_))
+      RTC_LOG(LS_INFO) << "Offering to resume the last session with the peer";
+  }
+
 #if !defined(OPENSSL_IS_BORINGSSL)
   // Specify an ECDH group for ECDHE ciphers, otherwise OpenSSL cannot
   // negotiate them when acting as the server. Use NIST's P-256 which is
@@ -828,6 +904,14 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   switch (ssl_error = SSL_get_error(ssl_, code)) {
     case SSL_ERROR_NONE:
       RTC_LOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_) == 1 && !VerifyResumedPeerCertificate())
+        return -1;
+      if (session_resumption_enabled() && role_ == SSL_CLIENT &&
+          peer_certificate_verified_) {
+        std::string key = SessionCacheKey();
+        if (!key.empty())
+          DtlsSessionCache::Get()->AddSession(key, SSL_get_session(ssl_));
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !client_auth_enabled());
@@ -1054,9 +1138,55 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     }
   }
 
+  if (session_resumption_enabled() && identity_) {
+    DtlsSessionCache::Get()->ConfigureContext(ctx);
+    // Only the sessions issued with our certificate may be resumed.
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    size_t digest_len;
+    if (identity_->certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                               sizeof(digest), &digest_len)) {
+      SSL_CTX_set_session_id_context(
+          ctx, digest,
+          static_cast<unsigned int>(
+              std::min<size_t>(digest_len, SSL_MAX_SID_CTX_LENGTH)));
+    }
+  }
+
   return ctx;
 }
 
+std::string OpenSSLStreamAdapter::SessionCacheKey() const {
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_len;
+  if (!identity_ || !has_peer_certificate_digest() ||
+      !identity_->certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                              sizeof(digest), &digest_len)) {
+    return std::string();
+  }
+  return hex_encode(reinterpret_cast<const char*>(digest), digest_len) + " " +
+         peer_certificate_digest_algorithm_ + ":" +
+         hex_encode(peer_certificate_digest_value_.data<char>(),
+                    peer_certificate_digest_value_.size());
+}
+
+bool OpenSSLStreamAdapter::VerifyResumedPeerCertificate() {
+  if (peer_cert_chain_)
+    return true;
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (!cert)
+    return !client_auth_enabled();
+  peer_cert_chain_.reset(new SSLCertChain(new OpenSSLCertificate(cert)));
+  X509_free(cert);
+  // Otherwise it is verified once the digest is set.
+  if (!has_peer_certificate_digest())
+    return true;
+  if (!VerifyPeerCertificate()) {
+    RTC_LOG(LS_WARNING) << "Resumed session has another peer certificate";
+    return false;
+  }
+  return true;
+}
+
 bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
   if (!has_peer_certificate_digest() || !peer_cert_chain_ ||
       !peer_cert_chain_->GetSize()) {
@@ -1214,4 +1344,8 @@ void OpenSSLStreamAdapter::enable_time_callback_for_testing() {
   g_use_time_callback_for_testing = true;
 }
 
+void OpenSSLStreamAdapter::EnableDtlsSessionResumption(bool enable) {
+  g_dtls_session_resumption = enable;
+}
+
 }  // namespace rtc
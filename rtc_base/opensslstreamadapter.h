@@ -106,6 +106,7 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   bool GetDtlsSrtpCryptoSuite(int* crypto_suite) override;
 
   bool IsTlsConnected() override;
+  bool IsResumedSession() override;
 
   // Capabilities interfaces.
   static bool IsBoringSsl();
@@ -117,6 +118,8 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   // using a fake clock.
   static void enable_time_callback_for_testing();
 
+  static void EnableDtlsSessionResumption(bool enable);
+
  protected:
   void OnEvent(StreamInterface* stream, int events, int err) override;
 
@@ -174,6 +177,16 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
     return client_auth_enabled() && !peer_certificate_verified_;
   }
 
+  bool session_resumption_enabled() const {
+    return session_resumption_ && ssl_mode_ == SSL_MODE_DTLS;
+  }
+  // The key of the sessions with the peer, made of our certificate and the
+  // one the peer must present. Empty if either isn't known.
+  std::string SessionCacheKey() const;
+  // Takes the peer certificate of a resumed session, which the handshake
+  // didn't verify, and verifies it.
+  bool VerifyResumedPeerCertificate();
+
   bool has_peer_certificate_digest() const {
     return !peer_certificate_digest_algorithm_.empty() &&
            !peer_certificate_digest_value_.empty();
@@ -212,6 +225,9 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   // A 50-ms initial timeout ensures rapid setup on fast connections, but may
   // be too aggressive for low bandwidth links.
   int dtls_handshake_timeout_ms_ = 50;
+
+  // Whether DTLS sessions are shared with the other streams of the process.
+  const bool session_resumption_;
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_PACKETSIGNAL_H_
+#define RTC_BASE_PACKETSIGNAL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/thread_checker.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+
+namespace rtc {
+
+// Drop-in replacement for a sigslot::signal that is emitted for every packet.
+// Slots are connected and disconnected as with sigslot, and are disconnected
+// when their sigslot::has_slots is destroyed, but the connections are kept in
+// a vector rather than a std::list, and emitting takes no lock and walks the
+// vector by index. Slots may connect and disconnect while the signal is
+// emitted; a slot disconnected during emission isn't called afterwards.
+//
+// The signal must only be emitted on one thread, which is DCHECKed, and
+// connected and disconnected on that thread or while it isn't emitted.
+template <typename... Args>
+class PacketSignal : public sigslot::_signal_base_interface {
+ public:
+  PacketSignal()
+      : sigslot::_signal_base_interface(&PacketSignal::DoSlotDisconnect,
+                                        &PacketSignal::DoSlotDuplicate) {
+    emit_checker_.DetachFromThread();
+  }
+  ~PacketSignal() { disconnect_all(); }
+
+  template <class DestT>
+  void connect(DestT* dest, void (DestT::*method)(Args...)) {
+    slots_.push_back(Slot{sigslot::_opaque_connection(dest, method), false});
+    dest->signal_connect(static_cast<sigslot::_signal_base_interface*>(this));
+  }
+
+  void disconnect(sigslot::has_slots_interface* dest) {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      if (!slots_[i].removed && slots_[i].connection.getdest() == dest) {
+        Remove(i);
+        dest->signal_disconnect(
+            static_cast<sigslot::_signal_base_interface*>(this));
+        return;
+      }
+    }
+  }
+
+  void disconnect_all() {
+    while (true) {
+      size_t i = 0;
+      while (i < slots_.size() && slots_[i].removed)
+        ++i;
+      if (i == slots_.size())
+        break;
+      sigslot::has_slots_interface* dest = slots_[i].connection.getdest();
+      Remove(i);
+      dest->signal_disconnect(
+          static_cast<sigslot::_signal_base_interface*>(this));
+    }
+  }
+
+  bool is_empty() const {
+    for (const Slot& slot : slots_) {
+      if (!slot.removed)
+        return false;
+    }
+    return true;
+  }
+
+  void emit(Args... args) {
+    RTC_DCHECK(emit_checker_.CalledOnValidThread());
+    ++emit_depth_;
+    // Slots connected while emitting aren't called until the next emit. The
+    // connection is copied, since a slot may connect others and so move the
+    // vector.
+    const size_t num_slots = slots_.size();
+    for (size_t i = 0; i < num_slots; ++i) {
+      if (slots_[i].removed)
+        continue;
+      const sigslot::_opaque_connection connection = slots_[i].connection;
+      connection.emit<Args...>(args...);
+    }
+    if (--emit_depth_ == 0 && has_removed_) {
+      size_t kept = 0;
+      for (size_t i = 0; i < slots_.size(); ++i) {
+        if (!slots_[i].removed)
+          slots_[kept++] = slots_[i];
+      }
+      slots_.erase(slots_.begin() + kept, slots_.end());
+      has_removed_ = false;
+    }
+  }
+
+  void operator()(Args... args) { emit(args...); }
+
+ private:
+  struct Slot {
+    sigslot::_opaque_connection connection;
+    // Set for slots disconnected while emitting, which are erased once the
+    // emission is done.
+    bool removed;
+  };
+
+  PacketSignal(const PacketSignal&) = delete;
+  PacketSignal& operator=(const PacketSignal&) = delete;
+
+  void Remove(size_t index) {
+    if (emit_depth_ == 0) {
+      slots_.erase(slots_.begin() + index);
+    } else {
+      slots_[index].removed = true;
+      has_removed_ = true;
+    }
+  }
+
+  static void DoSlotDisconnect(sigslot::_signal_base_interface* p,
+                               sigslot::has_slots_interface* dest) {
+    PacketSignal* const self = static_cast<PacketSignal*>(p);
+    for (size_t i = self->slots_.size(); i > 0; --i) {
+      const Slot& slot = self->slots_[i - 1];
+      if (!slot.removed && slot.connection.getdest() == dest)
+        self->Remove(i - 1);
+    }
+  }
+
+  static void DoSlotDuplicate(sigslot::_signal_base_interface* p,
+                              const sigslot::has_slots_interface* old_dest,
+                              sigslot::has_slots_interface* new_dest) {
+    PacketSignal* const self = static_cast<PacketSignal*>(p);
+    const size_t num_slots = self->slots_.size();
+    for (size_t i = 0; i < num_slots; ++i) {
+      // Copied, since the vector grows.
+      const Slot slot = self->slots_[i];
+      if (!slot.removed && slot.connection.getdest() == old_dest) {
+        self->slots_.push_back(
+            Slot{slot.connection.duplicate(new_dest), false});
+      }
+    }
+  }
+
+  std::vector<Slot> slots_;
+  int emit_depth_ = 0;
+  bool has_removed_ = false;
+  ThreadChecker emit_checker_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_PACKETSIGNAL_H_
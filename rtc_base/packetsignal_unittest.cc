@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <functional>
+#include <memory>
+
+#include "rtc_base/gunit.h"
+#include "rtc_base/packetsignal.h"
+
+namespace rtc {
+
+namespace {
+
+class Receiver : public sigslot::has_slots<> {
+ public:
+  Receiver() = default;
+  Receiver(const Receiver&) = default;
+
+  void OnPacket(int value) {
+    ++num_packets_;
+    last_value_ = value;
+    if (on_packet_)
+      on_packet_();
+  }
+
+  int num_packets() const { return num_packets_; }
+  int last_value() const { return last_value_; }
+  void set_on_packet(std::function<void()> on_packet) {
+    on_packet_ = on_packet;
+  }
+
+ private:
+  int num_packets_ = 0;
+  int last_value_ = 0;
+  std::function<void()> on_packet_;
+};
+
+}  // namespace
+
+TEST(PacketSignalTest, CallsConnectedSlots) {
+  PacketSignal<int> signal;
+  Receiver first;
+  Receiver second;
+  EXPECT_TRUE(signal.is_empty());
+  signal.connect(&first, &Receiver::OnPacket);
+  signal.connect(&second, &Receiver::OnPacket);
+  EXPECT_FALSE(signal.is_empty());
+
+  signal(17);
+  EXPECT_EQ(1, first.num_packets());
+  EXPECT_EQ(17, first.last_value());
+  EXPECT_EQ(1, second.num_packets());
+
+  signal.disconnect(&first);
+  signal(18);
+  EXPECT_EQ(1, first.num_packets());
+  EXPECT_EQ(2, second.num_packets());
+}
+
+TEST(PacketSignalTest, DisconnectsDestroyedSlots) {
+  PacketSignal<int> signal;
+  {
+    Receiver receiver;
+    signal.connect(&receiver, &Receiver::OnPacket);
+  }
+  EXPECT_TRUE(signal.is_empty());
+  signal(1);
+}
+
+TEST(PacketSignalTest, DisconnectsSlotsWhenDestroyed) {
+  Receiver receiver;
+  {
+    PacketSignal<int> signal;
+    signal.connect(&receiver, &Receiver::OnPacket);
+  }
+  // The receiver doesn't try to disconnect from the destroyed signal.
+}
+
+TEST(PacketSignalTest, ConnectsCopiedSlots) {
+  PacketSignal<int> signal;
+  Receiver receiver;
+  signal.connect(&receiver, &Receiver::OnPacket);
+  Receiver copy(receiver);
+  signal(1);
+  EXPECT_EQ(1, receiver.num_packets());
+  EXPECT_EQ(1, copy.num_packets());
+}
+
+TEST(PacketSignalTest, SkipsSlotDisconnectedWhileEmitting) {
+  PacketSignal<int> signal;
+  Receiver first;
+  std::unique_ptr<Receiver> second(new Receiver());
+  signal.connect(&first, &Receiver::OnPacket);
+  signal.connect(second.get(), &Receiver::OnPacket);
+  first.set_on_packet([&second] { second.reset(); });
+
+  signal(1);
+  EXPECT_EQ(1, first.num_packets());
+  EXPECT_FALSE(signal.is_empty());
+  signal(2);
+  EXPECT_EQ(2, first.num_packets());
+}
+
+TEST(PacketSignalTest, CallsSlotConnectedWhileEmittingNextTime) {
+  PacketSignal<int> signal;
+  Receiver first;
+  Receiver second;
+  signal.connect(&first, &Receiver::OnPacket);
+  first.set_on_packet([&signal, &first, &second] {
+    signal.connect(&second, &Receiver::OnPacket);
+    first.set_on_packet(nullptr);
+  });
+
+  signal(1);
+  EXPECT_EQ(0, second.num_packets());
+  signal(2);
+  EXPECT_EQ(1, second.num_packets());
+}
+
+TEST(PacketSignalTest, SlotMayDisconnectItself) {
+  PacketSignal<int> signal;
+  Receiver receiver;
+  signal.connect(&receiver, &Receiver::OnPacket);
+  receiver.set_on_packet(
+      [&signal, &receiver] { signal.disconnect(&receiver); });
+
+  signal(1);
+  signal(2);
+  EXPECT_EQ(1, receiver.num_packets());
+  EXPECT_TRUE(signal.is_empty());
+}
+
+}  // namespace rtc
@@ -26,8 +26,12 @@
 #endif
 #include <signal.h>
 #include <sys/ioctl.h>
+#if defined(WEBRTC_USE_MMSG)
+#include <netinet/udp.h>
+#endif
 #include <sys/select.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 
@@ -65,6 +69,17 @@
 #define IP_MTU 14  // Until this is integrated from linux/in.h to netinet/in.h
 typedef void* SockOptArg;
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#include <linux/tls.h>
+// Not defined by older C libraries.
+#if !defined(TCP_ULP)
+#define TCP_ULP 31
+#endif
+#if !defined(SOL_TLS)
+#define SOL_TLS 282
+#endif
+#endif  // WEBRTC_LINUX && !WEBRTC_ANDROID
+
 #endif  // WEBRTC_POSIX
 
 #if defined(WEBRTC_POSIX) && !defined(WEBRTC_MAC) && !defined(__native_client__)
@@ -259,6 +274,9 @@ int PhysicalSocket::DoConnect(const SocketAddress& connect_addr) {
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
   int err = ::connect(s_, addr, static_cast<int>(len));
   UpdateLastError();
+  // Readiness seen before connecting (e.g. EPOLLHUP on an unconnected TCP
+  // socket) says nothing about the connection being established.
+  ClearReadiness(DE_CONNECT | DE_WRITE);
   uint8_t events = DE_READ | DE_WRITE;
   if (err == 0) {
     state_ = CS_CONNECTED;
@@ -299,6 +317,8 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
     *value = (*value != IP_PMTUDISC_DONT) ? 1 : 0;
 #endif
   }
+  if (ret != -1 && opt == OPT_ECN)
+    *value &= kEcnMask;
   return ret;
 }
 
@@ -312,7 +332,17 @@ int PhysicalSocket::SetOption(Option opt, int value) {
     value = (value) ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
 #endif
   }
-  return ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
+  if (opt == OPT_ECN) {
+    // Keep the DSCP bits of the TOS byte.
+    int tos = 0;
+    socklen_t optlen = sizeof(tos);
+    ::getsockopt(s_, slevel, sopt, (SockOptArg)&tos, &optlen);
+    value = (tos & ~kEcnMask) | (value & kEcnMask);
+  }
+  int ret = ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
+  if (ret != -1 && opt == OPT_RECV_ECN)
+    recv_ecn_enabled_ = value != 0;
+  return ret;
 }
 
 int PhysicalSocket::Send(const void* pv, size_t cb) {
@@ -333,10 +363,7 @@ int PhysicalSocket::Send(const void* pv, size_t cb) {
   MaybeRemapSendError();
   // We have seen minidumps where this may be false.
   RTC_DCHECK(sent <= static_cast<int>(cb));
-  if ((sent > 0 && sent < static_cast<int>(cb)) ||
-      (sent < 0 && IsBlockingError(GetError()))) {
-    EnableEvents(DE_WRITE);
-  }
+  UpdateWriteReadiness(sent, cb);
   return sent;
 }
 
@@ -358,6 +385,9 @@ int PhysicalSocket::SendTo(const void* buffer,
   MaybeRemapSendError();
   // We have seen minidumps where this may be false.
   RTC_DCHECK(sent <= static_cast<int>(length));
+  if (sent < 0 && IsBlockingError(GetError())) {
+    ClearReadiness(DE_WRITE);
+  }
   if ((sent > 0 && sent < static_cast<int>(length)) ||
       (sent < 0 && IsBlockingError(GetError()))) {
     EnableEvents(DE_WRITE);
@@ -365,6 +395,244 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendV(const OutgoingBuffer* buffers, size_t count) {
+#if defined(WEBRTC_POSIX)
+  // Enough for a framing header, a payload and its padding.
+  iovec iovs[8];
+  if (count <= 1 || count > arraysize(iovs)) {
+    return Socket::SendV(buffers, count);
+  }
+  size_t total_length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = const_cast<void*>(buffers[i].data);
+    iovs[i].iov_len = buffers[i].length;
+    total_length += buffers[i].length;
+  }
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iovs;
+  msg.msg_iovlen = count;
+  int sent = static_cast<int>(::sendmsg(s_, &msg,
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+                                        // Suppress SIGPIPE, as in Send().
+                                        MSG_NOSIGNAL
+#else
+                                        0
+#endif
+                                        ));
+  UpdateLastError();
+  MaybeRemapSendError();
+  UpdateWriteReadiness(sent, total_length);
+  return sent;
+#else
+  return Socket::SendV(buffers, count);
+#endif  // WEBRTC_POSIX
+}
+
+bool PhysicalSocket::EnableKernelTlsTx(const void* crypto_info) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // The kernel wants the exact size of the struct for the cipher.
+  size_t size = 0;
+  switch (static_cast<const tls_crypto_info*>(crypto_info)->cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+      size = sizeof(tls12_crypto_info_aes_gcm_128);
+      break;
+#if defined(TLS_CIPHER_AES_GCM_256)
+    case TLS_CIPHER_AES_GCM_256:
+      size = sizeof(tls12_crypto_info_aes_gcm_256);
+      break;
+#endif
+#if defined(TLS_CIPHER_CHACHA20_POLY1305)
+    case TLS_CIPHER_CHACHA20_POLY1305:
+      size = sizeof(tls12_crypto_info_chacha20_poly1305);
+      break;
+#endif
+    default:
+      return false;
+  }
+  if (setsockopt(s_, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 ||
+      setsockopt(s_, SOL_TLS, TLS_TX, crypto_info, size) != 0) {
+    RTC_LOG(LS_INFO) << "Kernel TLS isn't available, errno=" << errno;
+    return false;
+  }
+  return true;
+#else
+  return Socket::EnableKernelTlsTx(crypto_info);
+#endif
+}
+
+int PhysicalSocket::SendTlsRecord(uint8_t record_type,
+                                  const void* pv,
+                                  size_t cb) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // The record type is passed in a control message.
+  char control[CMSG_SPACE(sizeof(record_type))];
+  memset(control, 0, sizeof(control));
+  iovec iov;
+  iov.iov_base = const_cast<void*>(pv);
+  iov.iov_len = cb;
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(record_type));
+  memcpy(CMSG_DATA(cmsg), &record_type, sizeof(record_type));
+  int sent = static_cast<int>(::sendmsg(s_, &msg, MSG_NOSIGNAL));
+  UpdateLastError();
+  MaybeRemapSendError();
+  UpdateWriteReadiness(sent, cb);
+  return sent;
+#else
+  return Socket::SendTlsRecord(record_type, pv, cb);
+#endif
+}
+
+int PhysicalSocket::SendToBatch(const OutgoingDatagram* datagrams,
+                                size_t count) {
+#if defined(WEBRTC_USE_MMSG)
+  if (!udp_ || count <= 1 || !sendmmsg_supported_) {
+    return Socket::SendToBatch(datagrams, count);
+  }
+  int result;
+  if (SendWithGso(datagrams, count, &result)) {
+    return result;
+  }
+
+  size_t total_sent = 0;
+  while (total_sent < count) {
+    size_t chunk = std::min(count - total_sent, kMaxSendBatchSize);
+    mmsghdr msgs[kMaxSendBatchSize];
+    iovec iovs[kMaxSendBatchSize];
+    sockaddr_storage addrs[kMaxSendBatchSize];
+    memset(msgs, 0, sizeof(msgs[0]) * chunk);
+    for (size_t i = 0; i < chunk; ++i) {
+      const OutgoingDatagram& datagram = datagrams[total_sent + i];
+      iovs[i].iov_base = const_cast<void*>(datagram.data);
+      iovs[i].iov_len = datagram.length;
+      msgs[i].msg_hdr.msg_name = &addrs[i];
+      msgs[i].msg_hdr.msg_namelen = static_cast<socklen_t>(
+          datagram.destination.ToSockAddrStorage(&addrs[i]));
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    // Suppress SIGPIPE, as in SendTo().
+    int sent = ::sendmmsg(s_, msgs, static_cast<unsigned int>(chunk),
+                          MSG_NOSIGNAL);
+    UpdateLastError();
+    if (sent < 0 && GetError() == ENOSYS && total_sent == 0) {
+      sendmmsg_supported_ = false;
+      return Socket::SendToBatch(datagrams, count);
+    }
+    if (sent <= 0)
+      break;
+    total_sent += sent;
+    if (static_cast<size_t>(sent) < chunk) {
+      // sendmmsg() stops at the first datagram that fails; pick up its error.
+      int ret = SendTo(datagrams[total_sent].data,
+                       datagrams[total_sent].length,
+                       datagrams[total_sent].destination);
+      if (ret < 0)
+        break;
+      ++total_sent;
+    }
+  }
+  MaybeRemapSendError();
+  if (total_sent < count && IsBlockingError(GetError())) {
+    ClearReadiness(DE_WRITE);
+    EnableEvents(DE_WRITE);
+  }
+  if (total_sent == 0)
+    return SOCKET_ERROR;
+  return static_cast<int>(total_sent);
+#else
+  return Socket::SendToBatch(datagrams, count);
+#endif  // WEBRTC_USE_MMSG
+}
+
+#if defined(WEBRTC_USE_MMSG)
+bool PhysicalSocket::SendWithGso(const OutgoingDatagram* datagrams,
+                                 size_t count,
+                                 int* result) {
+#if defined(UDP_SEGMENT)
+  // The kernel limits a GSO send to 64 segments and a 64 KB payload. All
+  // segments except the last must have exactly the segment size, and the last
+  // may not be larger.
+  static const size_t kMaxGsoSegments = 64;
+  static const size_t kMaxGsoPayload = 65000;
+  if (!gso_supported_ || count > kMaxGsoSegments)
+    return false;
+  const size_t segment_size = datagrams[0].length;
+  size_t total_size = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const OutgoingDatagram& datagram = datagrams[i];
+    if (datagram.destination != datagrams[0].destination)
+      return false;
+    if (datagram.length > segment_size ||
+        (i + 1 < count && datagram.length != segment_size)) {
+      return false;
+    }
+    total_size += datagram.length;
+  }
+  if (segment_size == 0 || total_size > kMaxGsoPayload)
+    return false;
+
+  sockaddr_storage addr;
+  iovec iovs[kMaxGsoSegments];
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = const_cast<void*>(datagrams[i].data);
+    iovs[i].iov_len = datagrams[i].length;
+  }
+  char control[CMSG_SPACE(sizeof(uint16_t))];
+  memset(control, 0, sizeof(control));
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_name = &addr;
+  msg.msg_namelen =
+      static_cast<socklen_t>(datagrams[0].destination.ToSockAddrStorage(&addr));
+  msg.msg_iov = iovs;
+  msg.msg_iovlen = count;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t gso_size = static_cast<uint16_t>(segment_size);
+  memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+
+  int sent = ::sendmsg(s_, &msg, MSG_NOSIGNAL);
+  UpdateLastError();
+  if (sent < 0) {
+    int error = GetError();
+    if (error == EINVAL || error == EIO || error == ENOPROTOOPT) {
+      // Kernels without UDP GSO (pre 4.18), or devices that cannot offload
+      // checksums, reject the segmented send outright. Stop trying.
+      RTC_LOG(LS_INFO) << "UDP GSO unavailable, error " << error;
+      gso_supported_ = false;
+      return false;
+    }
+    MaybeRemapSendError();
+    if (IsBlockingError(GetError())) {
+      ClearReadiness(DE_WRITE);
+      EnableEvents(DE_WRITE);
+    }
+    *result = SOCKET_ERROR;
+    return true;
+  }
+  *result = static_cast<int>(count);
+  return true;
+#else
+  gso_supported_ = false;
+  return false;
+#endif  // UDP_SEGMENT
+}
+#endif  // WEBRTC_USE_MMSG
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
@@ -385,6 +653,9 @@ int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   UpdateLastError();
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
+  if (received < 0 && IsBlockingError(error)) {
+    ClearReadiness(DE_READ);
+  }
   if (udp_ || success) {
     EnableEvents(DE_READ);
   }
@@ -411,6 +682,9 @@ int PhysicalSocket::RecvFrom(void* buffer,
     SocketAddressFromSockAddrStorage(addr_storage, out_addr);
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
+  if (received < 0 && IsBlockingError(error)) {
+    ClearReadiness(DE_READ);
+  }
   if (udp_ || success) {
     EnableEvents(DE_READ);
   }
@@ -420,6 +694,92 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+#if defined(WEBRTC_USE_MMSG)
+constexpr size_t PhysicalSocket::kMaxRecvBatchSize;
+constexpr size_t PhysicalSocket::kMaxSendBatchSize;
+#endif
+
+int PhysicalSocket::RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+#if defined(WEBRTC_USE_MMSG)
+  if (!udp_ || (count <= 1 && !recv_ecn_enabled_) || !recvmmsg_supported_) {
+    return Socket::RecvFromBatch(datagrams, count);
+  }
+  count = std::min(count, kMaxRecvBatchSize);
+  if (!recv_timestamps_enabled_) {
+    // Kernel receive timestamps are delivered as ancillary data, so they must
+    // be requested explicitly; SIOCGSTAMP only reports the last datagram.
+    int enable = 1;
+    ::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+    recv_timestamps_enabled_ = true;
+  }
+
+  mmsghdr msgs[kMaxRecvBatchSize];
+  iovec iovs[kMaxRecvBatchSize];
+  sockaddr_storage addrs[kMaxRecvBatchSize];
+  char control[kMaxRecvBatchSize]
+              [CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(int))];
+  memset(msgs, 0, sizeof(msgs[0]) * count);
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = datagrams[i].buffer;
+    iovs[i].iov_len = datagrams[i].capacity;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = control[i];
+    msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+  }
+
+  int received =
+      ::recvmmsg(s_, msgs, static_cast<unsigned int>(count), 0, nullptr);
+  UpdateLastError();
+  if (received < 0 && GetError() == ENOSYS) {
+    // Kernels older than 2.6.33 do not implement recvmmsg.
+    recvmmsg_supported_ = false;
+    return Socket::RecvFromBatch(datagrams, count);
+  }
+  for (int i = 0; i < received; ++i) {
+    ReceivedDatagram& datagram = datagrams[i];
+    datagram.length = msgs[i].msg_len;
+    SocketAddressFromSockAddrStorage(addrs[i], &datagram.source);
+    datagram.timestamp = -1;
+    datagram.ecn = ECN_NOT_ECT;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg;
+         cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS) {
+        timespec ts;
+        memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        datagram.timestamp =
+            kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
+            ts.tv_nsec / kNumNanosecsPerMicrosec;
+      } else if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_TOS) {
+        // The TOS byte of IPv4 packets comes as a single byte.
+        uint8_t tos;
+        memcpy(&tos, CMSG_DATA(cmsg), sizeof(tos));
+        datagram.ecn = static_cast<EcnMarking>(tos & kEcnMask);
+      } else if (cmsg->cmsg_level == IPPROTO_IPV6 &&
+                 cmsg->cmsg_type == IPV6_TCLASS) {
+        int tclass;
+        memcpy(&tclass, CMSG_DATA(cmsg), sizeof(tclass));
+        datagram.ecn = static_cast<EcnMarking>(tclass & kEcnMask);
+      }
+    }
+  }
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  if (received < 0 && IsBlockingError(error)) {
+    ClearReadiness(DE_READ);
+  }
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  return received;
+#else
+  return Socket::RecvFromBatch(datagrams, count);
+#endif  // WEBRTC_USE_MMSG
+}
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -443,8 +803,11 @@ AsyncSocket* PhysicalSocket::Accept(SocketAddress* out_addr) {
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
   SOCKET s = DoAccept(s_, addr, &addr_len);
   UpdateLastError();
-  if (s == INVALID_SOCKET)
+  if (s == INVALID_SOCKET) {
+    if (IsBlockingError(GetError()))
+      ClearReadiness(DE_ACCEPT);
     return nullptr;
+  }
   if (out_addr != nullptr)
     SocketAddressFromSockAddrStorage(addr_storage, out_addr);
   return ss_->WrapSocket(s);
@@ -519,6 +882,16 @@ void PhysicalSocket::MaybeRemapSendError() {
 #endif
 }
 
+void PhysicalSocket::UpdateWriteReadiness(int sent, size_t cb) {
+  if (sent < 0 && IsBlockingError(GetError())) {
+    ClearReadiness(DE_WRITE);
+  }
+  if ((sent > 0 && static_cast<size_t>(sent) < cb) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+}
+
 void PhysicalSocket::SetEnabledEvents(uint8_t events) {
   enabled_events_ = events;
 }
@@ -561,6 +934,32 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
     case OPT_DSCP:
       RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
       return -1;
+    case OPT_ECN:
+    case OPT_RECV_ECN: {
+#if defined(WEBRTC_USE_MMSG)
+      bool ipv6 = GetLocalAddress().family() == AF_INET6;
+      *slevel = ipv6 ? IPPROTO_IPV6 : IPPROTO_IP;
+      if (opt == OPT_ECN)
+        *sopt = ipv6 ? IPV6_TCLASS : IP_TOS;
+      else
+        *sopt = ipv6 ? IPV6_RECVTCLASS : IP_RECVTOS;
+      break;
+#else
+      // Received ECN marks are only read from the ancillary data of
+      // recvmmsg().
+      RTC_LOG(LS_WARNING) << "Socket::OPT_ECN not supported.";
+      return -1;
+#endif
+    }
+    case OPT_REUSEPORT:
+#if defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
     default:
@@ -698,6 +1097,8 @@ bool SocketDispatcher::IsDescriptorClosed() {
         return true;
       // The normal blocking error; don't log anything.
       case EWOULDBLOCK:
+        ClearReadiness(DE_READ);
+        return false;
       // Interrupted system call.
       case EINTR:
         return false;
@@ -860,6 +1261,26 @@ void SocketDispatcher::DisableEvents(uint8_t events) {
   MaybeUpdateDispatcher(old_events);
 }
 
+uint32_t SocketDispatcher::GetPendingEpollEvents() {
+  return pending_epoll_events_;
+}
+
+void SocketDispatcher::SetPendingEpollEvents(uint32_t events) {
+  pending_epoll_events_ = events;
+}
+
+void SocketDispatcher::ClearReadiness(uint8_t events) {
+  if (events & (DE_READ | DE_ACCEPT)) {
+    pending_epoll_events_ &= ~(EPOLLIN | EPOLLPRI);
+  }
+  if (events & (DE_WRITE | DE_CONNECT)) {
+    pending_epoll_events_ &= ~EPOLLOUT;
+  }
+  if (events & DE_CONNECT) {
+    pending_epoll_events_ &= ~(EPOLLRDHUP | EPOLLERR | EPOLLHUP);
+  }
+}
+
 #endif  // WEBRTC_USE_EPOLL
 
 int SocketDispatcher::Close() {
@@ -1304,6 +1725,26 @@ void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
 #endif
 }
 
+#if defined(WEBRTC_USE_EPOLL)
+void PhysicalSocketServer::EnableEdgeTriggeredEpoll() {
+  CritScope cs(&crit_);
+  if (edge_triggered_ || epoll_fd_ == INVALID_SOCKET) {
+    return;
+  }
+  edge_triggered_ = true;
+  // Re-register what is already known. EPOLL_CTL_MOD re-evaluates readiness,
+  // so descriptors that are ready now still get their first edge.
+  for (Dispatcher* pdispatcher : dispatchers_) {
+    if (pdispatcher->GetDescriptor() != INVALID_SOCKET)
+      ModifyEpoll(pdispatcher);
+  }
+  for (Dispatcher* pdispatcher : pending_add_dispatchers_) {
+    if (pdispatcher->GetDescriptor() != INVALID_SOCKET)
+      ModifyEpoll(pdispatcher);
+  }
+}
+#endif  // WEBRTC_USE_EPOLL
+
 void PhysicalSocketServer::AddRemovePendingDispatchers() {
   if (!pending_add_dispatchers_.empty()) {
     for (Dispatcher* pdispatcher : pending_add_dispatchers_) {
@@ -1323,6 +1764,13 @@ void PhysicalSocketServer::AddRemovePendingDispatchers() {
 #if defined(WEBRTC_POSIX)
 
 bool PhysicalSocketServer::Wait(int cmsWait, bool process_io) {
+  // Events are handled with a cached time, see ScopedCachedTime. If a handler
+  // runs a message loop which waits here, the cached time must advance for
+  // its timeouts to expire.
+  struct RefreshCachedTimeOnReturn {
+    ~RefreshCachedTimeOnReturn() { ScopedCachedTime::Refresh(); }
+  } refresh_cached_time;
+
 #if defined(WEBRTC_USE_EPOLL)
   // We don't keep a dedicated "epoll" descriptor containing only the non-IO
   // (i.e. signaling) dispatcher, so "poll" will be used instead of the default
@@ -1470,7 +1918,9 @@ bool PhysicalSocketServer::WaitSelect(int cmsWait, bool process_io) {
       // If timeout, return success
       return true;
     } else {
-      // We have signaled descriptors
+      // We have signaled descriptors. They're handled, e.g. packets are
+      // received, with one reading of the clock.
+      ScopedCachedTime cached_time;
       CritScope cr(&crit_);
       processing_dispatchers_ = true;
       for (Dispatcher* pdispatcher : dispatchers_) {
@@ -1527,6 +1977,16 @@ static const size_t kInitialEpollEvents = 128;
 // Maximum number of events to process with one call to "epoll_wait".
 static const size_t kMaxEpollEvents = 8192;
 
+// Events registered for every descriptor in edge-triggered mode.
+static const uint32_t kEdgeTriggeredEpollEvents = EPOLLIN | EPOLLOUT | EPOLLET;
+
+uint32_t PhysicalSocketServer::GetEpollRegistration(Dispatcher* pdispatcher) {
+  if (edge_triggered_) {
+    return kEdgeTriggeredEpollEvents;
+  }
+  return GetEpollEvents(pdispatcher->GetRequestedEvents());
+}
+
 void PhysicalSocketServer::AddEpoll(Dispatcher* pdispatcher) {
   RTC_DCHECK(epoll_fd_ != INVALID_SOCKET);
   int fd = pdispatcher->GetDescriptor();
@@ -1536,7 +1996,7 @@ void PhysicalSocketServer::AddEpoll(Dispatcher* pdispatcher) {
   }
 
   struct epoll_event event = {0};
-  event.events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  event.events = GetEpollRegistration(pdispatcher);
   event.data.ptr = pdispatcher;
   int err = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
   RTC_DCHECK_EQ(err, 0);
@@ -1547,6 +2007,7 @@ void PhysicalSocketServer::AddEpoll(Dispatcher* pdispatcher) {
 
 void PhysicalSocketServer::RemoveEpoll(Dispatcher* pdispatcher) {
   RTC_DCHECK(epoll_fd_ != INVALID_SOCKET);
+  edge_ready_dispatchers_.erase(pdispatcher);
   int fd = pdispatcher->GetDescriptor();
   RTC_DCHECK(fd != INVALID_SOCKET);
   if (fd == INVALID_SOCKET) {
@@ -1574,8 +2035,22 @@ void PhysicalSocketServer::UpdateEpoll(Dispatcher* pdispatcher) {
     return;
   }
 
+  if (edge_triggered_) {
+    // The registration never changes; only check whether the newly requested
+    // events are already known to be ready.
+    if (pdispatcher->GetPendingEpollEvents() &
+        GetEpollEvents(pdispatcher->GetRequestedEvents())) {
+      edge_ready_dispatchers_.insert(pdispatcher);
+    }
+    return;
+  }
+  ModifyEpoll(pdispatcher);
+}
+
+void PhysicalSocketServer::ModifyEpoll(Dispatcher* pdispatcher) {
+  int fd = pdispatcher->GetDescriptor();
   struct epoll_event event = {0};
-  event.events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  event.events = GetEpollRegistration(pdispatcher);
   event.data.ptr = pdispatcher;
   int err = epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event);
   RTC_DCHECK_EQ(err, 0);
@@ -1601,13 +2076,23 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
   fWait_ = true;
 
   while (fWait_) {
+    bool has_pending_events = false;
+    if (edge_triggered_) {
+      ProcessPendingEdgeTriggeredDispatchers();
+      CritScope cr(&crit_);
+      has_pending_events = !edge_ready_dispatchers_.empty();
+    }
+    if (!fWait_) {
+      break;
+    }
+
     // Wait then call handlers as appropriate
     // < 0 means error
     // 0 means timeout
     // > 0 means count of descriptors ready
     int n = epoll_wait(epoll_fd_, &epoll_events_[0],
                        static_cast<int>(epoll_events_.size()),
-                       static_cast<int>(tvWait));
+                       has_pending_events ? 0 : static_cast<int>(tvWait));
     if (n < 0) {
       if (errno != EINTR) {
         RTC_LOG_E(LS_ERROR, EN, errno) << "epoll";
@@ -1618,10 +2103,15 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
       // PosixSignalDeliveryDispatcher will be in the signaled state in the next
       // iteration.
     } else if (n == 0) {
-      // If timeout, return success
-      return true;
+      // If timeout, return success. With pending edge-triggered events the
+      // poll did not block, so keep going until the real deadline.
+      if (!has_pending_events) {
+        return true;
+      }
     } else {
-      // We have signaled descriptors
+      // We have signaled descriptors. They're handled, e.g. packets are
+      // received, with one reading of the clock.
+      ScopedCachedTime cached_time;
       CritScope cr(&crit_);
       for (int i = 0; i < n; ++i) {
         const epoll_event& event = epoll_events_[i];
@@ -1631,6 +2121,11 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
           continue;
         }
 
+        if (edge_triggered_) {
+          ProcessEdgeTriggeredEvents(pdispatcher, event.events);
+          continue;
+        }
+
         bool readable = (event.events & (EPOLLIN | EPOLLPRI));
         bool writable = (event.events & EPOLLOUT);
         bool check_error = (event.events & (EPOLLRDHUP | EPOLLERR | EPOLLHUP));
@@ -1643,7 +2138,7 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
         epoll_events_.size() < kMaxEpollEvents) {
       // We used the complete space to receive events, increase size for future
       // iterations.
-      epoll_events_.resize(std::max(epoll_events_.size() * 2, kMaxEpollEvents));
+      epoll_events_.resize(std::min(epoll_events_.size() * 2, kMaxEpollEvents));
     }
 
     if (cmsWait != kForever) {
@@ -1658,6 +2153,50 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
   return true;
 }
 
+void PhysicalSocketServer::ProcessEdgeTriggeredEvents(Dispatcher* pdispatcher,
+                                                      uint32_t new_events) {
+  uint32_t events = pdispatcher->GetPendingEpollEvents() | new_events;
+  pdispatcher->SetPendingEpollEvents(events);
+  uint32_t requested = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  bool readable = (events & (EPOLLIN | EPOLLPRI)) && (requested & EPOLLIN);
+  bool writable = (events & EPOLLOUT) && (requested & EPOLLOUT);
+  // Errors are only checked when the kernel reports them, not every time
+  // pending readiness is dispatched again.
+  bool check_error = (new_events & (EPOLLRDHUP | EPOLLERR | EPOLLHUP));
+  if (readable || writable || check_error) {
+    ProcessEvents(pdispatcher, readable, writable, check_error);
+  }
+
+  // The handlers may have removed the dispatcher.
+  if (dispatchers_.find(pdispatcher) == dispatchers_.end()) {
+    return;
+  }
+  if (pdispatcher->GetPendingEpollEvents() &
+      GetEpollEvents(pdispatcher->GetRequestedEvents())) {
+    edge_ready_dispatchers_.insert(pdispatcher);
+  } else {
+    edge_ready_dispatchers_.erase(pdispatcher);
+  }
+}
+
+void PhysicalSocketServer::ProcessPendingEdgeTriggeredDispatchers() {
+  CritScope cr(&crit_);
+  if (edge_ready_dispatchers_.empty()) {
+    return;
+  }
+  ScopedCachedTime cached_time;
+  // Handlers may add or remove dispatchers, so work on a snapshot.
+  std::vector<Dispatcher*> ready(edge_ready_dispatchers_.begin(),
+                                 edge_ready_dispatchers_.end());
+  for (Dispatcher* pdispatcher : ready) {
+    if (dispatchers_.find(pdispatcher) == dispatchers_.end()) {
+      edge_ready_dispatchers_.erase(pdispatcher);
+      continue;
+    }
+    ProcessEdgeTriggeredEvents(pdispatcher, 0);
+  }
+}
+
 bool PhysicalSocketServer::WaitPoll(int cmsWait, Dispatcher* dispatcher) {
   RTC_DCHECK(dispatcher);
   int64_t tvWait = -1;
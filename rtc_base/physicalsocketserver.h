@@ -16,6 +16,12 @@
 #define WEBRTC_USE_EPOLL 1
 #endif
 
+#if defined(WEBRTC_POSIX) && defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+// recvmmsg()/sendmmsg() let UDP sockets move several datagrams per system
+// call.
+#define WEBRTC_USE_MMSG 1
+#endif
+
 #include <memory>
 #include <set>
 #include <vector>
@@ -58,6 +64,15 @@ class Dispatcher {
   virtual int GetDescriptor() = 0;
   virtual bool IsDescriptorClosed() = 0;
 #endif
+#if defined(WEBRTC_USE_EPOLL)
+  // Used when the PhysicalSocketServer runs epoll in edge-triggered mode.
+  // Dispatchers that may leave their descriptor partially consumed after an
+  // event store the epoll readiness that is still outstanding, so the server
+  // can dispatch it again without waiting for a new edge. Dispatchers that
+  // always drain their descriptor keep the defaults.
+  virtual uint32_t GetPendingEpollEvents() { return 0; }
+  virtual void SetPendingEpollEvents(uint32_t events) {}
+#endif
 };
 
 // A socket server that provides the real sockets of the underlying OS.
@@ -81,6 +96,15 @@ class PhysicalSocketServer : public SocketServer {
   void Remove(Dispatcher* dispatcher);
   void Update(Dispatcher* dispatcher);
 
+#if defined(WEBRTC_USE_EPOLL)
+  // Switches epoll to edge-triggered mode. Every descriptor is then registered
+  // once for both read and write readiness, and changes to the events a
+  // dispatcher requests no longer cost an epoll_ctl() call; readiness that a
+  // dispatcher has not consumed yet is remembered and dispatched again from
+  // Wait(). This cuts system calls on servers with many busy sockets.
+  void EnableEdgeTriggeredEpoll();
+#endif
+
 #if defined(WEBRTC_POSIX)
   // Sets the function to be executed in response to the specified POSIX signal.
   // The function is executed from inside Wait() using the "self-pipe trick"--
@@ -113,11 +137,20 @@ class PhysicalSocketServer : public SocketServer {
   void AddEpoll(Dispatcher* dispatcher);
   void RemoveEpoll(Dispatcher* dispatcher);
   void UpdateEpoll(Dispatcher* dispatcher);
+  void ModifyEpoll(Dispatcher* dispatcher);
   bool WaitEpoll(int cms);
   bool WaitPoll(int cms, Dispatcher* dispatcher);
+  uint32_t GetEpollRegistration(Dispatcher* dispatcher);
+  // Edge-triggered mode: merges |new_events| into the dispatcher's pending
+  // readiness and dispatches whatever it currently requests.
+  void ProcessEdgeTriggeredEvents(Dispatcher* dispatcher, uint32_t new_events);
+  void ProcessPendingEdgeTriggeredDispatchers();
 
   int epoll_fd_ = INVALID_SOCKET;
   std::vector<struct epoll_event> epoll_events_;
+  bool edge_triggered_ = false;
+  // Dispatchers with pending readiness for events they currently request.
+  DispatcherSet edge_ready_dispatchers_;
 #endif  // WEBRTC_USE_EPOLL
   DispatcherSet dispatchers_;
   DispatcherSet pending_add_dispatchers_;
@@ -157,12 +190,22 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  // Uses sendmmsg() on Linux, or a single UDP_SEGMENT (GSO) send when all
+  // datagrams share a destination and segment size.
+  int SendToBatch(const OutgoingDatagram* datagrams, size_t count) override;
+  // Uses sendmsg() with one iovec per buffer on POSIX.
+  int SendV(const OutgoingBuffer* buffers, size_t count) override;
+  // Uses kTLS on Linux.
+  bool EnableKernelTlsTx(const void* crypto_info) override;
+  int SendTlsRecord(uint8_t record_type, const void* pv, size_t cb) override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+  // Uses recvmmsg() on Linux to read several datagrams per system call.
+  int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) override;
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
@@ -192,13 +235,20 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
   void UpdateLastError();
   void MaybeRemapSendError();
+  // Waits for the socket to become writable again after a send of |cb| bytes
+  // that returned |sent| blocked or was partial.
+  void UpdateWriteReadiness(int sent, size_t cb);
+
+  // Called when an operation found |events| not to be ready (e.g. it failed
+  // with EWOULDBLOCK), so any cached readiness for them is stale.
+  virtual void ClearReadiness(uint8_t events) {}
 
   uint8_t enabled_events() const { return enabled_events_; }
   virtual void SetEnabledEvents(uint8_t events);
   virtual void EnableEvents(uint8_t events);
   virtual void DisableEvents(uint8_t events);
 
-  static int TranslateOption(Option opt, int* slevel, int* sopt);
+  int TranslateOption(Option opt, int* slevel, int* sopt);
 
   PhysicalSocketServer* ss_;
   SOCKET s_;
@@ -214,6 +264,27 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
  private:
   uint8_t enabled_events_ = 0;
+#if defined(WEBRTC_USE_MMSG)
+  // Attempts to send |datagrams| as one UDP_SEGMENT super-packet. Returns
+  // false if the batch is not eligible or the kernel rejects GSO, in which
+  // case nothing was sent.
+  bool SendWithGso(const OutgoingDatagram* datagrams,
+                   size_t count,
+                   int* result);
+
+  // Upper bound on datagrams read by a single RecvFromBatch() call.
+  static constexpr size_t kMaxRecvBatchSize = 64;
+  // Upper bound on datagrams passed to a single sendmmsg() call.
+  static constexpr size_t kMaxSendBatchSize = 64;
+
+  bool recvmmsg_supported_ = true;
+  bool sendmmsg_supported_ = true;
+  bool gso_supported_ = true;
+  bool recv_timestamps_enabled_ = false;
+#endif
+  // Set by OPT_RECV_ECN, which needs the ancillary data of recvmmsg() even for
+  // single datagrams.
+  bool recv_ecn_enabled_ = false;
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
@@ -243,10 +314,15 @@ class SocketDispatcher : public Dispatcher, public PhysicalSocket {
   int Close() override;
 
 #if defined(WEBRTC_USE_EPOLL)
+  uint32_t GetPendingEpollEvents() override;
+  void SetPendingEpollEvents(uint32_t events) override;
+
  protected:
   void StartBatchedEventUpdates();
   void FinishBatchedEventUpdates();
 
+  void ClearReadiness(uint8_t events) override;
+
   void SetEnabledEvents(uint8_t events) override;
   void EnableEvents(uint8_t events) override;
   void DisableEvents(uint8_t events) override;
@@ -263,6 +339,7 @@ class SocketDispatcher : public Dispatcher, public PhysicalSocket {
   void MaybeUpdateDispatcher(uint8_t old_events);
 
   int saved_enabled_events_ = -1;
+  uint32_t pending_epoll_events_ = 0;
 #endif
 };
 
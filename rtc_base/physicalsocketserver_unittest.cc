@@ -12,6 +12,7 @@
 #include <stdarg.h>
 #include <memory>
 
+#include "rtc_base/arraysize.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/networkmonitor.h"
@@ -457,6 +458,171 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+// Verify that several queued datagrams are returned by one RecvFromBatch()
+// call, each with its own source address and receive timestamp.
+TEST_F(PhysicalSocketTest, TestRecvFromBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const char kPayload[] = "batch";
+  const int kNumDatagrams = 3;
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    ASSERT_EQ(static_cast<int>(sizeof(kPayload)),
+              sender->SendTo(kPayload, sizeof(kPayload),
+                             receiver->GetLocalAddress()));
+  }
+
+  char buffers[4][64];
+  ReceivedDatagram datagrams[4];
+  for (size_t i = 0; i < arraysize(datagrams); ++i) {
+    datagrams[i].buffer = buffers[i];
+    datagrams[i].capacity = sizeof(buffers[i]);
+  }
+  int received = 0;
+  while (received < kNumDatagrams) {
+    int ret = receiver->RecvFromBatch(datagrams + received,
+                                      arraysize(datagrams) - received);
+    if (ret < 0) {
+      ASSERT_TRUE(receiver->IsBlocking());
+      Thread::SleepMs(1);
+      continue;
+    }
+    received += ret;
+  }
+  EXPECT_EQ(kNumDatagrams, received);
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    EXPECT_EQ(sizeof(kPayload), datagrams[i].length);
+    EXPECT_EQ(0, memcmp(kPayload, datagrams[i].buffer, sizeof(kPayload)));
+    EXPECT_EQ(sender->GetLocalAddress(), datagrams[i].source);
+#if !defined(WEBRTC_MAC)
+    EXPECT_GT(datagrams[i].timestamp, -1);
+#endif
+  }
+}
+
+#if defined(WEBRTC_USE_MMSG)
+// Verify that the ECN codepoint set with OPT_ECN is reported to a receiver
+// that asked for it with OPT_RECV_ECN, also when reading a single datagram.
+TEST_F(PhysicalSocketTest, TestEcnIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, receiver->SetOption(Socket::OPT_RECV_ECN, 1));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_ECN, ECN_ECT1));
+  int ecn = -1;
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_ECN, &ecn));
+  EXPECT_EQ(ECN_ECT1, ecn);
+
+  const char kPayload[] = "ecn";
+  ASSERT_EQ(static_cast<int>(sizeof(kPayload)),
+            sender->SendTo(kPayload, sizeof(kPayload),
+                           receiver->GetLocalAddress()));
+  char buffer[64];
+  ReceivedDatagram datagram;
+  datagram.buffer = buffer;
+  datagram.capacity = sizeof(buffer);
+  int ret;
+  while ((ret = receiver->RecvFromBatch(&datagram, 1)) < 0) {
+    ASSERT_TRUE(receiver->IsBlocking());
+    Thread::SleepMs(1);
+  }
+  EXPECT_EQ(1, ret);
+  EXPECT_EQ(sizeof(kPayload), datagram.length);
+  EXPECT_EQ(ECN_ECT1, datagram.ecn);
+}
+#endif
+
+// Verify that SendToBatch() delivers every datagram intact, both for batches
+// eligible for UDP GSO (equal sizes, one destination) and for mixed sizes.
+TEST_F(PhysicalSocketTest, TestSendToBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const std::string kPayloads[] = {"aaaa", "bbbb", "cc", "dddddd", "e"};
+  OutgoingDatagram outgoing[arraysize(kPayloads)];
+  for (size_t i = 0; i < arraysize(kPayloads); ++i) {
+    outgoing[i].data = kPayloads[i].data();
+    outgoing[i].length = kPayloads[i].size();
+    outgoing[i].destination = receiver->GetLocalAddress();
+  }
+  // The first three datagrams form a GSO-eligible batch.
+  ASSERT_EQ(3, sender->SendToBatch(outgoing, 3));
+  ASSERT_EQ(2, sender->SendToBatch(outgoing + 3, 2));
+
+  for (const std::string& expected : kPayloads) {
+    char buffer[64];
+    SocketAddress source;
+    int received = -1;
+    while ((received = receiver->RecvFrom(buffer, sizeof(buffer), &source,
+                                          nullptr)) < 0) {
+      ASSERT_TRUE(receiver->IsBlocking());
+      Thread::SleepMs(1);
+    }
+    EXPECT_EQ(expected, std::string(buffer, received));
+    EXPECT_EQ(sender->GetLocalAddress(), source);
+  }
+}
+
+// Verify that SendV() sends the buffers in order as one stream of bytes.
+TEST_F(PhysicalSocketTest, TestSendVIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> listener(
+      server_->CreateAsyncSocket(AF_INET, SOCK_STREAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_STREAM));
+  ASSERT_EQ(0, listener->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, listener->Listen(1));
+  sender->Connect(listener->GetLocalAddress());
+  std::unique_ptr<AsyncSocket> receiver;
+  while (!receiver) {
+    receiver.reset(listener->Accept(nullptr));
+    Thread::SleepMs(1);
+  }
+  while (sender->GetState() != Socket::CS_CONNECTED) {
+    ASSERT_NE(Socket::CS_CLOSED, sender->GetState());
+    server_->Wait(1, true);
+  }
+
+  const std::string kPieces[] = {"\x00\x05", "hello", "", " world"};
+  OutgoingBuffer buffers[arraysize(kPieces)];
+  std::string expected;
+  for (size_t i = 0; i < arraysize(kPieces); ++i) {
+    buffers[i].data = kPieces[i].data();
+    buffers[i].length = kPieces[i].size();
+    expected += kPieces[i];
+  }
+  ASSERT_EQ(static_cast<int>(expected.size()),
+            sender->SendV(buffers, arraysize(buffers)));
+
+  std::string received;
+  while (received.size() < expected.size()) {
+    char buffer[64];
+    int len = receiver->Recv(buffer, sizeof(buffer), nullptr);
+    if (len < 0) {
+      ASSERT_TRUE(receiver->IsBlocking());
+      Thread::SleepMs(1);
+      continue;
+    }
+    ASSERT_GT(len, 0);
+    received.append(buffer, len);
+  }
+  EXPECT_EQ(expected, received);
+}
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
@@ -497,6 +663,50 @@ TEST_F(PhysicalSocketTest,
   server_->set_network_binder(nullptr);
 }
 
+#if defined(WEBRTC_USE_EPOLL)
+// Runs a subset of the socket tests with epoll in edge-triggered mode, where
+// readiness not consumed by a handler must be re-dispatched by the server.
+class PhysicalSocketEdgeTriggeredTest : public PhysicalSocketTest {
+ protected:
+  PhysicalSocketEdgeTriggeredTest() { server_->EnableEdgeTriggeredEpoll(); }
+};
+
+TEST_F(PhysicalSocketEdgeTriggeredTest, TestConnectIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectIPv4();
+}
+
+TEST_F(PhysicalSocketEdgeTriggeredTest, TestConnectFailIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectFailIPv4();
+}
+
+TEST_F(PhysicalSocketEdgeTriggeredTest, TestServerCloseIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestServerCloseIPv4();
+}
+
+TEST_F(PhysicalSocketEdgeTriggeredTest, TestSocketServerWaitIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSocketServerWaitIPv4();
+}
+
+TEST_F(PhysicalSocketEdgeTriggeredTest, TestTcpIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestTcpIPv4();
+}
+
+TEST_F(PhysicalSocketEdgeTriggeredTest, TestUdpIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpIPv4();
+}
+
+TEST_F(PhysicalSocketEdgeTriggeredTest, TestWritableAfterPartialWriteIPv4) {
+  MAYBE_SKIP_IPV4;
+  WritableAfterPartialWrite(kIPv4Loopback);
+}
+#endif  // WEBRTC_USE_EPOLL
+
 class PosixSignalDeliveryTest : public testing::Test {
  public:
   static void RecordSignal(int signum) {
@@ -16,15 +16,35 @@
 
 namespace webrtc {
 
+namespace {
+
+// Number of buckets of |bucket_size_ms| that a window of |window_size_ms|
+// can overlap.
+int64_t NumBuckets(int64_t window_size_ms, int64_t bucket_size_ms) {
+  return (window_size_ms + bucket_size_ms - 2) / bucket_size_ms + 1;
+}
+
+}  // namespace
+
 RateStatistics::RateStatistics(int64_t window_size_ms, float scale)
-    : buckets_(new Bucket[window_size_ms]()),
+    : RateStatistics(window_size_ms, scale, 1) {}
+
+RateStatistics::RateStatistics(int64_t window_size_ms,
+                               float scale,
+                               int64_t bucket_size_ms)
+    : buckets_(new Bucket[NumBuckets(window_size_ms, bucket_size_ms)]()),
       accumulated_count_(0),
       num_samples_(0),
       oldest_time_(-window_size_ms),
       oldest_index_(0),
+      oldest_bucket_(0),
       scale_(scale),
       max_window_size_ms_(window_size_ms),
-      current_window_size_ms_(max_window_size_ms_) {}
+      current_window_size_ms_(max_window_size_ms_),
+      bucket_size_ms_(bucket_size_ms),
+      num_buckets_(NumBuckets(window_size_ms, bucket_size_ms)) {
+  RTC_DCHECK_GT(bucket_size_ms, 0);
+}
 
 RateStatistics::~RateStatistics() {}
 
@@ -33,8 +53,9 @@ void RateStatistics::Reset() {
   num_samples_ = 0;
   oldest_time_ = -max_window_size_ms_;
   oldest_index_ = 0;
+  oldest_bucket_ = 0;
   current_window_size_ms_ = max_window_size_ms_;
-  for (int64_t i = 0; i < max_window_size_ms_; i++)
+  for (int64_t i = 0; i < num_buckets_; i++)
     buckets_[i] = Bucket();
 }
 
@@ -47,14 +68,17 @@ void RateStatistics::Update(size_t count, int64_t now_ms) {
   EraseOld(now_ms);
 
   // First ever sample, reset window to start now.
-  if (!IsInitialized())
+  if (!IsInitialized()) {
     oldest_time_ = now_ms;
+    oldest_bucket_ = BucketNumber(now_ms);
+  }
 
-  uint32_t now_offset = static_cast<uint32_t>(now_ms - oldest_time_);
-  RTC_DCHECK_LT(now_offset, max_window_size_ms_);
+  uint32_t now_offset =
+      static_cast<uint32_t>(BucketNumber(now_ms) - oldest_bucket_);
+  RTC_DCHECK_LT(now_offset, num_buckets_);
   uint32_t index = oldest_index_ + now_offset;
-  if (index >= max_window_size_ms_)
-    index -= max_window_size_ms_;
+  if (index >= num_buckets_)
+    index -= num_buckets_;
   buckets_[index].sum += count;
   ++buckets_[index].samples;
   accumulated_count_ += count;
@@ -89,18 +113,21 @@ void RateStatistics::EraseOld(int64_t now_ms) {
   if (new_oldest_time <= oldest_time_)
     return;
 
-  // Loop over buckets and remove too old data points.
-  while (num_samples_ > 0 && oldest_time_ < new_oldest_time) {
+  // Loop over buckets and remove too old data points. The bucket that
+  // |new_oldest_time| falls in is kept.
+  const int64_t new_oldest_bucket = BucketNumber(new_oldest_time);
+  while (num_samples_ > 0 && oldest_bucket_ < new_oldest_bucket) {
     const Bucket& oldest_bucket = buckets_[oldest_index_];
     RTC_DCHECK_GE(accumulated_count_, oldest_bucket.sum);
     RTC_DCHECK_GE(num_samples_, oldest_bucket.samples);
     accumulated_count_ -= oldest_bucket.sum;
     num_samples_ -= oldest_bucket.samples;
     buckets_[oldest_index_] = Bucket();
-    if (++oldest_index_ >= max_window_size_ms_)
+    if (++oldest_index_ >= num_buckets_)
       oldest_index_ = 0;
-    ++oldest_time_;
+    ++oldest_bucket_;
   }
+  oldest_bucket_ = std::max(oldest_bucket_, new_oldest_bucket);
   oldest_time_ = new_oldest_time;
 }
 
@@ -117,4 +144,11 @@ bool RateStatistics::IsInitialized() const {
   return oldest_time_ != -max_window_size_ms_;
 }
 
+int64_t RateStatistics::BucketNumber(int64_t time_ms) const {
+  // Rounds towards minus infinity, as the window may start before time 0.
+  if (time_ms >= 0)
+    return time_ms / bucket_size_ms_;
+  return -((bucket_size_ms_ - 1 - time_ms) / bucket_size_ms_);
+}
+
 }  // namespace webrtc
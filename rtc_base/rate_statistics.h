@@ -27,6 +27,16 @@ class RateStatistics {
   // scale = coefficient to convert counts/ms to desired unit
   //         ex: kBpsScale (8000) for bits/s if count represents bytes.
   RateStatistics(int64_t max_window_size_ms, float scale);
+  // bucket_size_ms = Resolution of the window, in ms. Counts are kept in one
+  //                  bucket per bucket_size_ms ms, so memory usage is
+  //                  proportional to max_window_size_ms / bucket_size_ms.
+  //                  When the window has moved, the oldest bucket may still
+  //                  hold up to bucket_size_ms - 1 ms of data older than the
+  //                  window. Suitable for statistics kept for each of many
+  //                  streams, where a 1 ms resolution isn't needed.
+  RateStatistics(int64_t max_window_size_ms,
+                 float scale,
+                 int64_t bucket_size_ms);
   ~RateStatistics();
 
   // Reset instance to original state.
@@ -50,9 +60,11 @@ class RateStatistics {
  private:
   void EraseOld(int64_t now_ms);
   bool IsInitialized() const;
+  // Returns the number of the bucket that |time_ms| falls in.
+  int64_t BucketNumber(int64_t time_ms) const;
 
   // Counters are kept in buckets (circular buffer), with one bucket
-  // per millisecond.
+  // per |bucket_size_ms_| milliseconds.
   struct Bucket {
     size_t sum;      // Sum of all samples in this bucket.
     size_t samples;  // Number of samples in this bucket.
@@ -68,8 +80,10 @@ class RateStatistics {
   // Oldest time recorded in buckets.
   int64_t oldest_time_;
 
-  // Bucket index of oldest counter recorded in buckets.
+  // Bucket index of oldest counter recorded in buckets, and the number of the
+  // bucket it holds.
   uint32_t oldest_index_;
+  int64_t oldest_bucket_;
 
   // To convert counts/ms to desired units
   const float scale_;
@@ -77,6 +91,9 @@ class RateStatistics {
   // The window sizes, in ms, over which the rate is calculated.
   const int64_t max_window_size_ms_;
   int64_t current_window_size_ms_;
+
+  const int64_t bucket_size_ms_;
+  const int64_t num_buckets_;
 };
 }  // namespace webrtc
 
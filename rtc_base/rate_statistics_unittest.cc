@@ -277,4 +277,38 @@ TEST_F(RateStatisticsTest, HandlesQuietPeriods) {
   EXPECT_TRUE(static_cast<bool>(bitrate));
   EXPECT_EQ(0u, *bitrate);
 }
+
+TEST(RateStatisticsCoarseTest, MatchesFineBucketsUntilWindowMoves) {
+  RateStatistics fine(kWindowMs, 8000);
+  RateStatistics coarse(kWindowMs, 8000, 10);
+  int64_t now_ms = 7;
+  for (int i = 0; i < kWindowMs - 10; i += 3) {
+    fine.Update(100 + i, now_ms + i);
+    coarse.Update(100 + i, now_ms + i);
+    EXPECT_EQ(fine.Rate(now_ms + i), coarse.Rate(now_ms + i));
+  }
+}
+
+TEST(RateStatisticsCoarseTest, KeepsRateWithinOneBucket) {
+  const int64_t kBucketMs = 10;
+  RateStatistics coarse(kWindowMs, 8000, kBucketMs);
+  const uint32_t kPacketSize = 1500u;
+  int64_t now_ms = 0;
+  for (int i = 0; i < 10 * kWindowMs; ++i) {
+    if (i % 4 == 0)
+      coarse.Update(kPacketSize, now_ms);
+    if (i > 2 * kWindowMs) {
+      // 1500 bytes every 4 ms is 3 Mbps. The oldest bucket may hold up to
+      // |kBucketMs| - 1 ms of data from before the window.
+      absl::optional<uint32_t> rate = coarse.Rate(now_ms);
+      ASSERT_TRUE(rate);
+      EXPECT_GE(*rate, 3000000u - 3000000u * 4 / kWindowMs);
+      EXPECT_LE(*rate, 3000000u + 3000000u * (kBucketMs + 4) / kWindowMs);
+    }
+    ++now_ms;
+  }
+  // Nothing is left once the whole window has passed.
+  now_ms += kWindowMs;
+  EXPECT_FALSE(coarse.Rate(now_ms));
+}
 }  // namespace
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/receivedpacketbuffer.h"
+
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+
+namespace {
+
+#if defined(WEBRTC_WIN)
+typedef DWORD TlsKey;
+
+TlsKey CreateTlsKey() {
+  return TlsAlloc();
+}
+
+void* GetTlsValue(TlsKey key) {
+  return TlsGetValue(key);
+}
+
+void SetTlsValue(TlsKey key, void* value) {
+  TlsSetValue(key, value);
+}
+#else
+typedef pthread_key_t TlsKey;
+
+TlsKey CreateTlsKey() {
+  pthread_key_t key;
+  RTC_CHECK_EQ(0, pthread_key_create(&key, nullptr));
+  return key;
+}
+
+void* GetTlsValue(TlsKey key) {
+  return pthread_getspecific(key);
+}
+
+void SetTlsValue(TlsKey key, void* value) {
+  pthread_setspecific(key, value);
+}
+#endif
+
+TlsKey ReceivedScopeTls() {
+  static TlsKey key = CreateTlsKey();
+  return key;
+}
+
+TlsKey SentScopeTls() {
+  static TlsKey key = CreateTlsKey();
+  return key;
+}
+
+ScopedReceivedPacketBuffer* CurrentScope() {
+  return static_cast<ScopedReceivedPacketBuffer*>(
+      GetTlsValue(ReceivedScopeTls()));
+}
+
+void SetCurrentScope(ScopedReceivedPacketBuffer* scope) {
+  SetTlsValue(ReceivedScopeTls(), scope);
+}
+
+ScopedSentPacketBuffer* CurrentSentScope() {
+  return static_cast<ScopedSentPacketBuffer*>(GetTlsValue(SentScopeTls()));
+}
+
+void SetCurrentSentScope(ScopedSentPacketBuffer* scope) {
+  SetTlsValue(SentScopeTls(), scope);
+}
+
+}  // namespace
+
+ScopedReceivedPacketBuffer::ScopedReceivedPacketBuffer(
+    CopyOnWriteBuffer* buffer)
+    : previous_(CurrentScope()), buffer_(buffer) {
+  RTC_DCHECK(buffer_);
+  SetCurrentScope(this);
+}
+
+ScopedReceivedPacketBuffer::~ScopedReceivedPacketBuffer() {
+  RTC_DCHECK_EQ(this, CurrentScope());
+  SetCurrentScope(previous_);
+}
+
+bool TakeReceivedPacket(const char* data,
+                        size_t len,
+                        CopyOnWriteBuffer* packet) {
+  ScopedReceivedPacketBuffer* scope = CurrentScope();
+  if (!scope || !scope->buffer_)
+    return false;
+  const CopyOnWriteBuffer& buffer = *scope->buffer_;
+  if (len == 0 || buffer.cdata<char>() != data || buffer.size() != len)
+    return false;
+  *packet = std::move(*scope->buffer_);
+  // Only one consumer can own the bytes.
+  scope->buffer_ = nullptr;
+  return true;
+}
+
+ScopedSentPacketBuffer::ScopedSentPacketBuffer(
+    const CopyOnWriteBuffer* buffer)
+    : previous_(CurrentSentScope()), buffer_(buffer) {
+  RTC_DCHECK(buffer_);
+  SetCurrentSentScope(this);
+}
+
+ScopedSentPacketBuffer::~ScopedSentPacketBuffer() {
+  RTC_DCHECK_EQ(this, CurrentSentScope());
+  SetCurrentSentScope(previous_);
+}
+
+bool ReferenceSentPacket(const void* data,
+                         size_t len,
+                         CopyOnWriteBuffer* packet) {
+  ScopedSentPacketBuffer* scope = CurrentSentScope();
+  if (!scope)
+    return false;
+  const CopyOnWriteBuffer& buffer = *scope->buffer_;
+  if (len == 0 || buffer.cdata() != data || buffer.size() != len)
+    return false;
+  *packet = buffer;
+  return true;
+}
+
+}  // namespace rtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_RECEIVEDPACKETBUFFER_H_
+#define RTC_BASE_RECEIVEDPACKETBUFFER_H_
+
+#include <stddef.h>
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/copyonwritebuffer.h"
+
+namespace rtc {
+
+// Received packets travel from the socket up to RtpTransport through a chain
+// of SignalReadPacket(const char* data, size_t len, ...) signals. A socket that
+// reads into a CopyOnWriteBuffer can publish that buffer on the current thread
+// for as long as it is emitting the signal, and the consumer at the end of the
+// chain can take it over with TakeReceivedPacket() instead of copying |data|:
+//
+//   CopyOnWriteBuffer packet = ...;  // Filled by the socket.
+//   ScopedReceivedPacketBuffer published(&packet);
+//   SignalReadPacket(this, packet.data<char>(), packet.size(), ...);
+//
+// Scopes nest, in which case the innermost one is published.
+class ScopedReceivedPacketBuffer {
+ public:
+  explicit ScopedReceivedPacketBuffer(CopyOnWriteBuffer* buffer);
+  ~ScopedReceivedPacketBuffer();
+
+ private:
+  friend bool TakeReceivedPacket(const char* data,
+                                 size_t len,
+                                 CopyOnWriteBuffer* packet);
+
+  ScopedReceivedPacketBuffer* const previous_;
+  CopyOnWriteBuffer* buffer_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedReceivedPacketBuffer);
+};
+
+// If the buffer published on this thread holds exactly the |len| bytes at
+// |data|, moves it into |packet| and returns true. Packets that were
+// unwrapped on the way, e.g. from TURN framing, don't match and return false,
+// so the caller has to copy them.
+//
+// The caller becomes the owner of the bytes at |data|, so it must be the last
+// reader of them: earlier receivers in the chain must not touch |data| after
+// their signal returns.
+bool TakeReceivedPacket(const char* data,
+                        size_t len,
+                        CopyOnWriteBuffer* packet);
+
+// The send side: packets go down from RtpTransport to the socket through
+// SendPacket(const char* data, size_t len, ...) calls. RtpTransport publishes
+// the CopyOnWriteBuffer the packet is in while the call runs, so that a socket
+// that queues packets, such as AsyncUDPSocket between StartSendBatch() and
+// FlushSendBatch(), can hold a reference to it with ReferenceSentPacket()
+// instead of copying |data|. Scopes nest, in which case the innermost one is
+// published.
+class ScopedSentPacketBuffer {
+ public:
+  explicit ScopedSentPacketBuffer(const CopyOnWriteBuffer* buffer);
+  ~ScopedSentPacketBuffer();
+
+ private:
+  friend bool ReferenceSentPacket(const void* data,
+                                  size_t len,
+                                  CopyOnWriteBuffer* packet);
+
+  ScopedSentPacketBuffer* const previous_;
+  const CopyOnWriteBuffer* const buffer_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedSentPacketBuffer);
+};
+
+// If the buffer published on this thread holds exactly the |len| bytes at
+// |data|, makes |packet| share it and returns true. Packets that were wrapped
+// on the way, e.g. in TURN framing, don't match and return false, so the
+// caller has to copy them. The publisher keeps its buffer; if it modifies it
+// later, it gets a copy of its own, as with any shared CopyOnWriteBuffer.
+bool ReferenceSentPacket(const void* data,
+                         size_t len,
+                         CopyOnWriteBuffer* packet);
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_RECEIVEDPACKETBUFFER_H_
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/receivedpacketbuffer.h"
+
+#include <memory>
+#include <string>
+
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/physicalsocketserver.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+
+TEST(ReceivedPacketBufferTest, TakesPublishedBufferOnce) {
+  CopyOnWriteBuffer buffer(std::string("packet"));
+  const char* data = buffer.cdata<char>();
+  ScopedReceivedPacketBuffer published(&buffer);
+
+  CopyOnWriteBuffer packet;
+  EXPECT_TRUE(TakeReceivedPacket(data, 6, &packet));
+  EXPECT_EQ(data, packet.cdata<char>());
+  EXPECT_EQ(0u, buffer.size());
+  EXPECT_FALSE(TakeReceivedPacket(data, 6, &packet));
+}
+
+TEST(ReceivedPacketBufferTest, DoesNotTakeOtherBytes) {
+  CopyOnWriteBuffer packet;
+  CopyOnWriteBuffer buffer(std::string("packet"));
+  const char* data = buffer.cdata<char>();
+  EXPECT_FALSE(TakeReceivedPacket(data, 6, &packet));
+
+  ScopedReceivedPacketBuffer published(&buffer);
+  EXPECT_FALSE(TakeReceivedPacket(data + 1, 5, &packet));
+  EXPECT_FALSE(TakeReceivedPacket(data, 5, &packet));
+  EXPECT_EQ(6u, buffer.size());
+}
+
+TEST(ReceivedPacketBufferTest, InnermostScopeIsPublished) {
+  CopyOnWriteBuffer outer(std::string("outer"));
+  CopyOnWriteBuffer inner(std::string("inner"));
+  CopyOnWriteBuffer packet;
+  ScopedReceivedPacketBuffer published_outer(&outer);
+  {
+    ScopedReceivedPacketBuffer published_inner(&inner);
+    EXPECT_FALSE(TakeReceivedPacket(outer.cdata<char>(), 5, &packet));
+  }
+  EXPECT_TRUE(TakeReceivedPacket(outer.cdata<char>(), 5, &packet));
+  EXPECT_EQ(CopyOnWriteBuffer(std::string("outer")), packet);
+}
+
+TEST(SentPacketBufferTest, ReferencesPublishedBuffer) {
+  CopyOnWriteBuffer buffer(std::string("packet"));
+  const char* data = buffer.cdata<char>();
+  CopyOnWriteBuffer packet;
+  EXPECT_FALSE(ReferenceSentPacket(data, 6, &packet));
+
+  ScopedSentPacketBuffer published(&buffer);
+  EXPECT_FALSE(ReferenceSentPacket(data, 5, &packet));
+  EXPECT_TRUE(ReferenceSentPacket(data, 6, &packet));
+  EXPECT_EQ(data, packet.cdata<char>());
+  // The publisher keeps its buffer, and gets a copy of its own on writes.
+  EXPECT_EQ(data, buffer.cdata<char>());
+  buffer.data()[0] = 'P';
+  EXPECT_EQ(CopyOnWriteBuffer(std::string("packet")), packet);
+}
+
+class ReceiveBufferPoolTest : public testing::Test,
+                              public sigslot::has_slots<> {
+ public:
+  ReceiveBufferPoolTest() : thread_(&ss_) {}
+
+  void Listen(AsyncPacketSocket* socket) {
+    socket->SignalReadPacket.connect(this,
+                                     &ReceiveBufferPoolTest::OnReadPacket);
+  }
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t len,
+                    const SocketAddress& remote_addr,
+                    const PacketTime& packet_time) {
+    ++packets_;
+    taken_ = TakeReceivedPacket(data, len, &packet_);
+    if (!taken_)
+      packet_.SetData(data, len);
+  }
+
+ protected:
+  PhysicalSocketServer ss_;
+  AutoSocketServerThread thread_;
+  int packets_ = 0;
+  bool taken_ = false;
+  CopyOnWriteBuffer packet_;
+};
+
+TEST_F(ReceiveBufferPoolTest, AsyncUDPSocketPublishesPooledBuffer) {
+  SocketAddress loopback("127.0.0.1", 0);
+  std::unique_ptr<AsyncUDPSocket> receiver(AsyncUDPSocket::Create(&ss_,
+                                                                  loopback));
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(&ss_,
+                                                                loopback));
+  ASSERT_TRUE(receiver && sender);
+  scoped_refptr<CopyOnWriteBufferPool> pool = CopyOnWriteBufferPool::Create();
+  receiver->SetReceiveBufferPool(pool, 8);
+  Listen(receiver.get());
+
+  PacketOptions options;
+  ASSERT_EQ(6, sender->SendTo("packet", 6, receiver->GetLocalAddress(),
+                              options));
+  EXPECT_TRUE_WAIT(packets_ == 1, 1000);
+  EXPECT_TRUE(taken_);
+  EXPECT_EQ(CopyOnWriteBuffer(std::string("packet")), packet_);
+
+  // Too long for the configured maximum.
+  ASSERT_EQ(9, sender->SendTo("oversized", 9, receiver->GetLocalAddress(),
+                              options));
+  ASSERT_EQ(6, sender->SendTo("second", 6, receiver->GetLocalAddress(),
+                              options));
+  EXPECT_TRUE_WAIT(packets_ == 2, 1000);
+  EXPECT_EQ(CopyOnWriteBuffer(std::string("second")), packet_);
+}
+
+TEST_F(ReceiveBufferPoolTest, AsyncUDPSocketQueuesPublishedBuffer) {
+  SocketAddress loopback("127.0.0.1", 0);
+  std::unique_ptr<AsyncUDPSocket> receiver(AsyncUDPSocket::Create(&ss_,
+                                                                  loopback));
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(&ss_,
+                                                                loopback));
+  ASSERT_TRUE(receiver && sender);
+  Listen(receiver.get());
+
+  CopyOnWriteBuffer buffer(std::string("packet"));
+  PacketOptions options;
+  sender->StartSendBatch();
+  {
+    ScopedSentPacketBuffer published(&buffer);
+    ASSERT_EQ(6, sender->SendTo(buffer.cdata(), buffer.size(),
+                                receiver->GetLocalAddress(), options));
+  }
+  // The queued packet shares |buffer|, so writing to it detaches it.
+  const uint8_t* queued = buffer.cdata();
+  buffer.data()[0] = 'P';
+  EXPECT_NE(queued, buffer.cdata());
+  sender->FlushSendBatch();
+  EXPECT_TRUE_WAIT(packets_ == 1, 1000);
+  EXPECT_EQ(CopyOnWriteBuffer(std::string("packet")), packet_);
+}
+
+}  // namespace rtc
@@ -24,4 +24,44 @@ SentPacket::SentPacket(int64_t packet_id,
                        const rtc::PacketInfo& info)
     : packet_id(packet_id), send_time_ms(send_time_ms), info(info) {}
 
+int Socket::SendToBatch(const OutgoingDatagram* datagrams, size_t count) {
+  size_t sent = 0;
+  for (; sent < count; ++sent) {
+    const OutgoingDatagram& datagram = datagrams[sent];
+    if (SendTo(datagram.data, datagram.length, datagram.destination) < 0)
+      break;
+  }
+  if (sent == 0 && count > 0)
+    return SOCKET_ERROR;
+  return static_cast<int>(sent);
+}
+
+int Socket::SendV(const OutgoingBuffer* buffers, size_t count) {
+  if (count == 1)
+    return Send(buffers[0].data, buffers[0].length);
+  SetError(EOPNOTSUPP);
+  return SOCKET_ERROR;
+}
+
+bool Socket::EnableKernelTlsTx(const void* crypto_info) {
+  return false;
+}
+
+int Socket::SendTlsRecord(uint8_t record_type, const void* pv, size_t cb) {
+  SetError(EOPNOTSUPP);
+  return SOCKET_ERROR;
+}
+
+int Socket::RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+  if (count == 0)
+    return 0;
+  ReceivedDatagram& datagram = datagrams[0];
+  int received = RecvFrom(datagram.buffer, datagram.capacity, &datagram.source,
+                          &datagram.timestamp);
+  if (received < 0)
+    return received;
+  datagram.length = static_cast<size_t>(received);
+  return 1;
+}
+
 }  // namespace rtc
@@ -27,6 +27,7 @@
 
 #include "absl/types/optional.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/ecn.h"
 #include "rtc_base/socketaddress.h"
 
 // Rather than converting errors into a private namespace,
@@ -167,6 +168,34 @@ struct SentPacket {
   rtc::PacketInfo info;
 };
 
+// Describes one datagram slot for Socket::RecvFromBatch(). The caller fills in
+// |buffer| and |capacity|; the socket fills in the remaining fields for every
+// slot it reports as received.
+struct ReceivedDatagram {
+  void* buffer = nullptr;
+  size_t capacity = 0;
+  // Number of bytes written to |buffer|.
+  size_t length = 0;
+  SocketAddress source;
+  // Receive time in microseconds, or -1 if not available.
+  int64_t timestamp = -1;
+  // ECN codepoint of the IP header. Only reported with OPT_RECV_ECN set.
+  EcnMarking ecn = ECN_NOT_ECT;
+};
+
+// Describes one datagram passed to Socket::SendToBatch().
+struct OutgoingDatagram {
+  const void* data = nullptr;
+  size_t length = 0;
+  SocketAddress destination;
+};
+
+// Describes one piece of the data passed to Socket::SendV().
+struct OutgoingBuffer {
+  const void* data = nullptr;
+  size_t length = 0;
+};
+
 // General interface for the socket implementations of various networks.  The
 // methods match those of normal UNIX sockets very closely.
 class Socket {
@@ -185,12 +214,37 @@ class Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends |count| datagrams in order. Returns the number of datagrams handed
+  // to the network, which may be less than |count| if the socket would block,
+  // or SOCKET_ERROR if none could be sent. The default implementation calls
+  // SendTo() for each datagram.
+  virtual int SendToBatch(const OutgoingDatagram* datagrams, size_t count);
+  // Sends the concatenation of |count| buffers, as Send() would send it, in
+  // one system call where possible (e.g. writev). Returns the number of bytes
+  // sent or SOCKET_ERROR. The default implementation only sends a single
+  // buffer, and otherwise fails with EOPNOTSUPP, leaving the caller to copy
+  // the buffers together into storage it can reuse.
+  virtual int SendV(const OutgoingBuffer* buffers, size_t count);
+  // Hands the encryption of sent data over to the kernel's TLS layer, kTLS on
+  // Linux, once a TLS handshake on the connection is done. |crypto_info| is
+  // what setsockopt(SOL_TLS, TLS_TX) takes: a struct starting with a
+  // tls_crypto_info, which gives the TLS version and cipher. After it returns
+  // true, Send() sends application data records, and SendTlsRecord() other
+  // records. The default implementation returns false, for unsupported.
+  virtual bool EnableKernelTlsTx(const void* crypto_info);
+  // Sends |pv| as one record of |record_type|, after EnableKernelTlsTx().
+  virtual int SendTlsRecord(uint8_t record_type, const void* pv, size_t cb);
   // |timestamp| is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   virtual int RecvFrom(void* pv,
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Receives up to |count| datagrams in one call. Returns the number of
+  // datagrams received, or SOCKET_ERROR if none could be read. The default
+  // implementation reads a single datagram with RecvFrom(); implementations
+  // with a cheaper bulk receive (e.g. recvmmsg) should override it.
+  virtual int RecvFromBatch(ReceivedDatagram* datagrams, size_t count);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -208,6 +262,11 @@ class Socket {
     OPT_NODELAY,               // whether Nagle algorithm is enabled
     OPT_IPV6_V6ONLY,           // Whether the socket is IPv6 only.
     OPT_DSCP,                  // DSCP code
+    OPT_ECN,                   // ECN codepoint of sent packets (EcnMarking)
+    OPT_RECV_ECN,              // whether RecvFromBatch() reports the ECN of
+                               // received packets
+    OPT_REUSEPORT,             // whether other sockets may bind the same
+                               // address, to share its packets
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
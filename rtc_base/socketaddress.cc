@@ -9,6 +9,9 @@
  */
 
 #include "rtc_base/socketaddress.h"
+
+#include <utility>
+
 #include "rtc_base/numerics/safe_conversions.h"
 
 #if defined(WEBRTC_POSIX)
@@ -61,8 +64,14 @@ SocketAddress::SocketAddress(const SocketAddress& addr) {
   this->operator=(addr);
 }
 
+SocketAddress::SocketAddress(SocketAddress&& addr) {
+  this->operator=(std::move(addr));
+}
+
+SocketAddress::~SocketAddress() = default;
+
 void SocketAddress::Clear() {
-  hostname_.clear();
+  hostname_.reset();
   literal_ = false;
   ip_ = IPAddress();
   port_ = 0;
@@ -70,7 +79,7 @@ void SocketAddress::Clear() {
 }
 
 bool SocketAddress::IsNil() const {
-  return hostname_.empty() && IPIsUnspec(ip_) && 0 == port_;
+  return !hostname_ && IPIsUnspec(ip_) && 0 == port_;
 }
 
 bool SocketAddress::IsComplete() const {
@@ -78,7 +87,22 @@ bool SocketAddress::IsComplete() const {
 }
 
 SocketAddress& SocketAddress::operator=(const SocketAddress& addr) {
-  hostname_ = addr.hostname_;
+  if (!addr.hostname_) {
+    hostname_.reset();
+  } else if (hostname_) {
+    *hostname_ = *addr.hostname_;
+  } else {
+    hostname_.reset(new std::string(*addr.hostname_));
+  }
+  ip_ = addr.ip_;
+  port_ = addr.port_;
+  literal_ = addr.literal_;
+  scope_id_ = addr.scope_id_;
+  return *this;
+}
+
+SocketAddress& SocketAddress::operator=(SocketAddress&& addr) {
+  hostname_ = std::move(addr.hostname_);
   ip_ = addr.ip_;
   port_ = addr.port_;
   literal_ = addr.literal_;
@@ -87,21 +111,24 @@ SocketAddress& SocketAddress::operator=(const SocketAddress& addr) {
 }
 
 void SocketAddress::SetIP(uint32_t ip_as_host_order_integer) {
-  hostname_.clear();
+  hostname_.reset();
   literal_ = false;
   ip_ = IPAddress(ip_as_host_order_integer);
   scope_id_ = 0;
 }
 
 void SocketAddress::SetIP(const IPAddress& ip) {
-  hostname_.clear();
+  hostname_.reset();
   literal_ = false;
   ip_ = ip;
   scope_id_ = 0;
 }
 
 void SocketAddress::SetIP(const std::string& hostname) {
-  hostname_ = hostname;
+  if (hostname.empty())
+    hostname_.reset();
+  else
+    hostname_.reset(new std::string(hostname));
   literal_ = IPFromString(hostname, &ip_);
   if (!literal_) {
     ip_ = IPAddress();
@@ -123,6 +150,11 @@ void SocketAddress::SetPort(int port) {
   port_ = rtc::dchecked_cast<uint16_t>(port);
 }
 
+const std::string& SocketAddress::hostname() const {
+  static const std::string* const kEmptyHostname = new std::string();
+  return hostname_ ? *hostname_ : *kEmptyHostname;
+}
+
 uint32_t SocketAddress::ip() const {
   return ip_.v4AddressAsHostOrderInteger();
 }
@@ -138,8 +170,8 @@ uint16_t SocketAddress::port() const {
 std::string SocketAddress::HostAsURIString() const {
   // If the hostname was a literal IP string, it may need to have square
   // brackets added (for SocketAddress::ToString()).
-  if (!literal_ && !hostname_.empty())
-    return hostname_;
+  if (!literal_ && hostname_)
+    return *hostname_;
   if (ip_.family() == AF_INET6) {
     return "[" + ip_.ToString() + "]";
   } else {
@@ -150,8 +182,8 @@ std::string SocketAddress::HostAsURIString() const {
 std::string SocketAddress::HostAsSensitiveURIString() const {
   // If the hostname was a literal IP string, it may need to have square
   // brackets added (for SocketAddress::ToString()).
-  if (!literal_ && !hostname_.empty())
-    return hostname_;
+  if (!literal_ && hostname_)
+    return *hostname_;
   if (ip_.family() == AF_INET6) {
     return "[" + ip_.ToSensitiveString() + "]";
   } else {
@@ -205,7 +237,7 @@ bool SocketAddress::IsAnyIP() const {
 
 bool SocketAddress::IsLoopbackIP() const {
   return IPIsLoopback(ip_) ||
-         (IPIsAny(ip_) && 0 == strcmp(hostname_.c_str(), "localhost"));
+         (IPIsAny(ip_) && hostname() == "localhost");
 }
 
 bool SocketAddress::IsPrivateIP() const {
@@ -213,7 +245,7 @@ bool SocketAddress::IsPrivateIP() const {
 }
 
 bool SocketAddress::IsUnresolvedIP() const {
-  return IPIsUnspec(ip_) && !literal_ && !hostname_.empty();
+  return IPIsUnspec(ip_) && !literal_ && hostname_;
 }
 
 bool SocketAddress::operator==(const SocketAddress& addr) const {
@@ -226,15 +258,15 @@ bool SocketAddress::operator<(const SocketAddress& addr) const {
 
   // We only check hostnames if both IPs are ANY or unspecified.  This matches
   // EqualIPs().
-  if ((IPIsAny(ip_) || IPIsUnspec(ip_)) && hostname_ != addr.hostname_)
-    return hostname_ < addr.hostname_;
+  if ((IPIsAny(ip_) || IPIsUnspec(ip_)) && hostname() != addr.hostname())
+    return hostname() < addr.hostname();
 
   return port_ < addr.port_;
 }
 
 bool SocketAddress::EqualIPs(const SocketAddress& addr) const {
-  return (ip_ == addr.ip_) &&
-         ((!IPIsAny(ip_) && !IPIsUnspec(ip_)) || (hostname_ == addr.hostname_));
+  return (ip_ == addr.ip_) && ((!IPIsAny(ip_) && !IPIsUnspec(ip_)) ||
+                               (hostname() == addr.hostname()));
 }
 
 bool SocketAddress::EqualPorts(const SocketAddress& addr) const {
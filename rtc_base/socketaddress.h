@@ -12,6 +12,7 @@
 #define RTC_BASE_SOCKETADDRESS_H_
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #ifdef UNIT_TEST
 #include <ostream>  // no-presubmit-check TODO(webrtc:8982)
@@ -48,6 +49,9 @@ class SocketAddress {
 
   // Creates a copy of the given address.
   SocketAddress(const SocketAddress& addr);
+  SocketAddress(SocketAddress&& addr);
+
+  ~SocketAddress();
 
   // Resets to the nil address.
   void Clear();
@@ -60,6 +64,7 @@ class SocketAddress {
 
   // Replaces our address with the given one.
   SocketAddress& operator=(const SocketAddress& addr);
+  SocketAddress& operator=(SocketAddress&& addr);
 
   // Changes the IP of this address to the given one, and clears the hostname
   // IP is given as an integer in host byte order. V4 only, to be deprecated..
@@ -86,7 +91,7 @@ class SocketAddress {
   void SetPort(int port);
 
   // Returns the hostname.
-  const std::string& hostname() const { return hostname_; }
+  const std::string& hostname() const;
 
   // Returns the IP address as a host byte order integer.
   // Returns 0 for non-v4 addresses.
@@ -168,7 +173,8 @@ class SocketAddress {
   // Determines whether this address has the same port as the one given.
   bool EqualPorts(const SocketAddress& addr) const;
 
-  // Hashes this address into a small number.
+  // Hashes this address into a small number. Consistent with operator==, so
+  // usable as the hash of unordered containers; see SocketAddressHash.
   size_t Hash() const;
 
   // Write this address to a sockaddr_in.
@@ -188,13 +194,21 @@ class SocketAddress {
   size_t ToSockAddrStorage(sockaddr_storage* saddr) const;
 
  private:
-  std::string hostname_;
+  // Only allocated when there is a hostname, which is never the case for the
+  // addresses of sockets and received packets. Those are copied and compared
+  // without touching the heap.
+  std::unique_ptr<std::string> hostname_;
   IPAddress ip_;
   uint16_t port_;
   int scope_id_;
   bool literal_;  // Indicates that 'hostname_' contains a literal IP string.
 };
 
+// Hash function for unordered containers keyed on SocketAddress.
+struct SocketAddressHash {
+  size_t operator()(const SocketAddress& addr) const { return addr.Hash(); }
+};
+
 bool SocketAddressFromSockAddrStorage(const sockaddr_storage& saddr,
                                       SocketAddress* out);
 SocketAddress EmptySocketAddressWithFamily(int family);
@@ -108,6 +108,21 @@ TEST(SocketAddressTest, TestAssign) {
   EXPECT_EQ("1.2.3.4:5678", addr.ToString());
 }
 
+TEST(SocketAddressTest, TestAssignReplacesHostname) {
+  SocketAddress addr("a.b.com", 5678);
+  addr = SocketAddress(IPAddress(0x01020304), 9999);
+  EXPECT_EQ("", addr.hostname());
+  EXPECT_EQ("1.2.3.4:9999", addr.ToString());
+
+  addr = SocketAddress("a.b.com", 5678);
+  EXPECT_TRUE(addr.IsUnresolvedIP());
+  EXPECT_EQ("a.b.com", addr.hostname());
+  SocketAddress copy(addr);
+  addr.SetIP("c.d.com");
+  EXPECT_EQ("a.b.com", copy.hostname());
+  EXPECT_EQ("a.b.com:5678", copy.ToString());
+}
+
 TEST(SocketAddressTest, TestSetIPPort) {
   SocketAddress addr(IPAddress(0x88888888), 9999);
   addr.SetIP(IPAddress(0x01020304));
@@ -36,6 +36,11 @@ class SocketAddressPair {
   SocketAddress dest_;
 };
 
+// Hash function for unordered containers keyed on SocketAddressPair.
+struct SocketAddressPairHash {
+  size_t operator()(const SocketAddressPair& pair) const { return pair.Hash(); }
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_SOCKETADDRESSPAIR_H_
@@ -72,6 +72,12 @@ class SSLAdapter : public AsyncSocketAdapter {
   // Choose whether the socket acts as a server socket or client socket.
   virtual void SetRole(SSLRole role) = 0;
 
+  // Lets the kernel encrypt the records sent after the handshake, if the
+  // platform, SSL library and negotiated cipher support it (kTLS on Linux),
+  // which saves copying and encrypting them in user space. Only applies to
+  // sockets created by a PhysicalSocketServer.
+  virtual void SetKernelTlsOffload(bool enable) = 0;
+
   // StartSSL returns 0 if successful.
   // If StartSSL is called while the socket is closed or connecting, the SSL
   // negotiation will begin as soon as the socket connects.
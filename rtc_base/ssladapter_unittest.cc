@@ -91,6 +91,10 @@ class SSLAdapterTestDummyClient : public sigslot::has_slots<> {
     ssl_adapter_->SetEllipticCurves(curves);
   }
 
+  void SetKernelTlsOffload(bool enable) {
+    ssl_adapter_->SetKernelTlsOffload(enable);
+  }
+
   rtc::SocketAddress GetAddress() const {
     return ssl_adapter_->GetLocalAddress();
   }
@@ -321,6 +325,10 @@ class SSLAdapterTestBase : public testing::Test, public sigslot::has_slots<> {
     client_->SetEllipticCurves(curves);
   }
 
+  void SetKernelTlsOffload(bool enable) {
+    client_->SetKernelTlsOffload(enable);
+  }
+
   void SetMockCertVerifier(bool return_value) {
     auto mock_verifier = absl::make_unique<MockCertVerifier>();
     EXPECT_CALL(*mock_verifier, Verify(_)).WillRepeatedly(Return(return_value));
@@ -541,6 +549,14 @@ TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSEllipticCurves) {
   TestTransfer("Hello, world!");
 }
 
+// Test transfer with kernel TLS enabled, which virtual sockets don't support,
+// so that OpenSSL keeps encrypting.
+TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSTransferWithKernelTlsOffload) {
+  SetKernelTlsOffload(true);
+  TestHandshake(true);
+  TestTransfer("Hello, world!");
+}
+
 // Basic tests: DTLS
 
 // Test that handshake works, using RSA
@@ -148,6 +148,10 @@ bool SSLStreamAdapter::GetDtlsSrtpCryptoSuite(int* crypto_suite) {
   return false;
 }
 
+bool SSLStreamAdapter::IsResumedSession() {
+  return false;
+}
+
 bool SSLStreamAdapter::IsBoringSsl() {
   return OpenSSLStreamAdapter::IsBoringSsl();
 }
@@ -165,6 +169,10 @@ void SSLStreamAdapter::enable_time_callback_for_testing() {
   OpenSSLStreamAdapter::enable_time_callback_for_testing();
 }
 
+void SSLStreamAdapter::EnableDtlsSessionResumption(bool enable) {
+  OpenSSLStreamAdapter::EnableDtlsSessionResumption(enable);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }  // namespace rtc
@@ -248,6 +248,10 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // SS_OPENING but IsTlsConnected should return true.
   virtual bool IsTlsConnected() = 0;
 
+  // Returns true if the connection resumed an earlier session instead of
+  // making a full handshake.
+  virtual bool IsResumedSession();
+
   // Capabilities testing.
   // Used to have "DTLS supported", "DTLS-SRTP supported" etc. methods, but now
   // that's assumed.
@@ -267,6 +271,14 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // using a fake clock.
   static void enable_time_callback_for_testing();
 
+  // Makes the DTLS streams created from now on resume their sessions with
+  // peers they connected to before, skipping the key exchange and certificate
+  // signatures of a full handshake. A server resumes the sessions issued by
+  // any stream of the process with the same certificate, and a client offers
+  // the last session it had with the same pair of certificates. The peer
+  // certificate of a resumed session is still checked against the digest.
+  static void EnableDtlsSessionResumption(bool enable);
+
   sigslot::signal1<SSLHandshakeError> SignalSSLHandshakeError;
 
  private:
@@ -369,6 +369,30 @@ class SSLStreamAdapterTestBase : public testing::Test,
     server_ssl_->SetIdentity(server_identity_);
   }
 
+  // Recreates the streams and adapters, keeping the identities, as for a
+  // second call between the same peers. |new_server_identity| gives the
+  // server another certificate.
+  void ReconnectStreams(bool new_server_identity) {
+    rtc::SSLIdentity* client_identity = client_identity_->GetReference();
+    rtc::SSLIdentity* server_identity =
+        new_server_identity
+            ? rtc::SSLIdentity::Generate("server", server_key_type_)
+            : server_identity_->GetReference();
+    CreateStreams();
+
+    client_ssl_.reset(rtc::SSLStreamAdapter::Create(client_stream_));
+    server_ssl_.reset(rtc::SSLStreamAdapter::Create(server_stream_));
+
+    client_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+
+    client_identity_ = client_identity;
+    server_identity_ = server_identity;
+    client_ssl_->SetIdentity(client_identity_);
+    server_ssl_->SetIdentity(server_identity_);
+    identities_set_ = false;
+  }
+
   virtual void OnEvent(rtc::StreamInterface* stream, int sig, int err) {
     RTC_LOG(LS_VERBOSE) << "SSLStreamAdapterTestBase::OnEvent sig=" << sig;
 
@@ -1330,6 +1354,32 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSExporter) {
   ASSERT_TRUE(!memcmp(client_out, server_out, sizeof(client_out)));
 }
 
+// Test that a second connection between the same certificates resumes the
+// session of the first, and that it still works as a full one.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSessionResumption) {
+  rtc::SSLStreamAdapter::EnableDtlsSessionResumption(true);
+  ReconnectStreams(false);
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+
+  ReconnectStreams(false);
+  TestHandshake();
+  EXPECT_TRUE(client_ssl_->IsResumedSession());
+  EXPECT_TRUE(server_ssl_->IsResumedSession());
+  std::unique_ptr<rtc::SSLCertChain> server_chain =
+      client_ssl_->GetPeerSSLCertChain();
+  ASSERT_TRUE(server_chain);
+  EXPECT_EQ(server_identity_->certificate().ToPEMString(),
+            server_chain->Get(0).ToPEMString());
+  TestTransfer(100);
+
+  // A server with another certificate needs a full handshake.
+  ReconnectStreams(true);
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+  rtc::SSLStreamAdapter::EnableDtlsSessionResumption(false);
+}
+
 // Test not yet valid certificates are not rejected.
 TEST_P(SSLStreamAdapterTestDTLS, TestCertNotYetValid) {
   long one_day = 60 * 60 * 24;
@@ -12,12 +12,12 @@
 #define RTC_BASE_SWAP_QUEUE_H_
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 #include <vector>
 
 #include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
-#include "rtc_base/criticalsection.h"
 #include "rtc_base/system/unused.h"
 
 namespace webrtc {
@@ -44,8 +44,10 @@ class SwapQueueItemVerifier {
 // This class is a fixed-size queue. A producer calls Insert() to insert
 // an element of type T at the back of the queue, and a consumer calls
 // Remove() to remove an element from the front of the queue. It's safe
-// for the producer(s) and the consumer(s) to access the queue
-// concurrently, from different threads.
+// for a single producer thread and a single consumer thread to access the
+// queue concurrently, from different threads, and neither ever blocks the
+// other. Several producers (or several consumers) must serialize their calls
+// among themselves, e.g., by holding a common lock.
 //
 // To avoid the construction, copying, and destruction of Ts that a naive
 // queue implementation would require, for each "full" T passed from
@@ -106,11 +108,16 @@ class SwapQueue {
   }
 
   // Resets the queue to have zero content wile maintaining the queue size.
+  // Must only be called by the consumer.
   void Clear() {
-    rtc::CritScope cs(&crit_queue_);
-    next_write_index_ = 0;
-    next_read_index_ = 0;
-    num_elements_ = 0;
+    // Drop all elements by advancing the read index past them. The write index
+    // is owned by the producer and is left untouched.
+    const size_t num_elements = num_elements_.load(std::memory_order_acquire);
+    next_read_index_ += num_elements;
+    if (next_read_index_ >= queue_.size()) {
+      next_read_index_ -= queue_.size();
+    }
+    num_elements_.fetch_sub(num_elements, std::memory_order_release);
   }
 
   // Inserts a "full" T at the back of the queue by swapping *input with an
@@ -122,11 +129,11 @@ class SwapQueue {
   bool Insert(T* input) RTC_WARN_UNUSED_RESULT {
     RTC_DCHECK(input);
 
-    rtc::CritScope cs(&crit_queue_);
-
     RTC_DCHECK(queue_item_verifier_(*input));
 
-    if (num_elements_ == queue_.size()) {
+    // The acquire load makes the consumer's swap of the slot complete before
+    // it is written here.
+    if (num_elements_.load(std::memory_order_acquire) == queue_.size()) {
       return false;
     }
 
@@ -138,10 +145,13 @@ class SwapQueue {
       next_write_index_ = 0;
     }
 
-    ++num_elements_;
+    // The release publishes the inserted item to the consumer.
+    const size_t old_num_elements =
+        num_elements_.fetch_add(1, std::memory_order_release);
 
     RTC_DCHECK_LT(next_write_index_, queue_.size());
-    RTC_DCHECK_LE(num_elements_, queue_.size());
+    RTC_DCHECK_LT(old_num_elements, queue_.size());
+    RTC_UNUSED(old_num_elements);
 
     return true;
   }
@@ -155,11 +165,10 @@ class SwapQueue {
   bool Remove(T* output) RTC_WARN_UNUSED_RESULT {
     RTC_DCHECK(output);
 
-    rtc::CritScope cs(&crit_queue_);
-
     RTC_DCHECK(queue_item_verifier_(*output));
 
-    if (num_elements_ == 0) {
+    // The acquire load makes the producer's swap of the slot visible here.
+    if (num_elements_.load(std::memory_order_acquire) == 0) {
       return false;
     }
 
@@ -171,10 +180,13 @@ class SwapQueue {
       next_read_index_ = 0;
     }
 
-    --num_elements_;
+    // The release hands the "empty" T back to the producer.
+    const size_t old_num_elements =
+        num_elements_.fetch_sub(1, std::memory_order_release);
 
     RTC_DCHECK_LT(next_read_index_, queue_.size());
-    RTC_DCHECK_LE(num_elements_, queue_.size());
+    RTC_DCHECK_LE(old_num_elements, queue_.size());
+    RTC_UNUSED(old_num_elements);
 
     return true;
   }
@@ -182,27 +194,30 @@ class SwapQueue {
  private:
   // Verify that the queue slots complies with the ItemVerifier test.
   bool VerifyQueueSlots() {
-    rtc::CritScope cs(&crit_queue_);
     for (const auto& v : queue_) {
       RTC_DCHECK(queue_item_verifier_(v));
     }
     return true;
   }
 
-  rtc::CriticalSection crit_queue_;
-
   // TODO(peah): Change this to use std::function() once we can use C++11 std
   // lib.
-  QueueItemVerifier queue_item_verifier_ RTC_GUARDED_BY(crit_queue_);
+  QueueItemVerifier queue_item_verifier_;
+
+  // Only accessed by the producer.
+  size_t next_write_index_ = 0;
+
+  // Only accessed by the consumer.
+  size_t next_read_index_ = 0;
 
-  // (next_read_index_ + num_elements_) % queue_.size() =
-  //  next_write_index_
-  size_t next_write_index_ RTC_GUARDED_BY(crit_queue_) = 0;
-  size_t next_read_index_ RTC_GUARDED_BY(crit_queue_) = 0;
-  size_t num_elements_ RTC_GUARDED_BY(crit_queue_) = 0;
+  // Accessed by both the producer and the consumer and used for synchronizing
+  // the access to the slots of |queue_|. A slot belongs to the producer until
+  // the increment of num_elements_ that follows its insertion, and to the
+  // consumer until the decrement that follows its removal.
+  std::atomic<size_t> num_elements_{0};
 
   // queue_.size() is constant.
-  std::vector<T> queue_ RTC_GUARDED_BY(crit_queue_);
+  std::vector<T> queue_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(SwapQueue);
 };
@@ -10,8 +10,11 @@
 
 #include "rtc_base/swap_queue.h"
 
+#include <algorithm>
 #include <vector>
 
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/sleep.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -21,6 +24,9 @@ namespace {
 // Test parameter for the basic sample based SwapQueue Tests.
 const size_t kChunkSize = 3;
 
+// Number of chunks passed between the threads of the concurrency test.
+const int kNumConcurrentChunks = 100;
+
 // Queue item verification function for the vector test.
 bool LengthVerifierFunction(const std::vector<int>& v) {
   return v.size() == kChunkSize;
@@ -39,6 +45,20 @@ class LengthVerifierFunctor {
   size_t length_;
 };
 
+// Inserts chunks filled with increasing numbers, waiting while the queue is
+// full.
+void InsertIncreasingChunks(void* obj) {
+  SwapQueue<std::vector<int>>* queue =
+      static_cast<SwapQueue<std::vector<int>>*>(obj);
+  std::vector<int> chunk(kChunkSize);
+  for (int k = 0; k < kNumConcurrentChunks; ++k) {
+    std::fill(chunk.begin(), chunk.end(), k);
+    while (!queue->Insert(&chunk)) {
+      SleepMs(0);
+    }
+  }
+}
+
 }  // anonymous namespace
 
 TEST(SwapQueueTest, BasicOperation) {
@@ -222,4 +242,24 @@ TEST(SwapQueueTest, OneSlotQueue) {
   EXPECT_FALSE(queue.Remove(&i));
 }
 
+TEST(SwapQueueTest, ConcurrentProducerAndConsumer) {
+  SwapQueue<std::vector<int>> queue(4, std::vector<int>(kChunkSize));
+  rtc::PlatformThread producer(&InsertIncreasingChunks, &queue,
+                               "SwapQueueProducer");
+  producer.Start();
+
+  std::vector<int> chunk(kChunkSize);
+  for (int k = 0; k < kNumConcurrentChunks; ++k) {
+    while (!queue.Remove(&chunk)) {
+      SleepMs(0);
+    }
+    ASSERT_EQ(kChunkSize, chunk.size());
+    for (int value : chunk) {
+      ASSERT_EQ(k, value);
+    }
+  }
+  producer.Stop();
+  EXPECT_FALSE(queue.Remove(&chunk));
+}
+
 }  // namespace webrtc
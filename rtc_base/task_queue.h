@@ -17,8 +17,11 @@
 
 #include "absl/memory/memory.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/location.h"
 #include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/task_stats.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/timeutils.h"
 
 namespace rtc {
 
@@ -74,6 +77,36 @@ class ClosureTaskWithCleanup : public ClosureTask<Closure> {
       typename std::remove_reference<Cleanup>::type>::type cleanup_;
 };
 
+// Wraps a task to report how long it waited in the queue and how long it ran
+// to rtc::task_stats, under the location that posted it.
+class LocatedTask : public QueuedTask {
+ public:
+  LocatedTask(const Location& posted_from,
+              std::unique_ptr<QueuedTask> task,
+              uint32_t delay_ms)
+      : posted_from_(posted_from),
+        task_(std::move(task)),
+        ready_time_us_(TimeMicros() + delay_ms * kNumMicrosecsPerMillisec) {}
+
+ private:
+  bool Run() override {
+    const int64_t start_time_us = TimeMicros();
+    // If Run() returns false, the task has taken ownership of itself, for
+    // instance by posting itself again.
+    QueuedTask* task = task_.release();
+    const bool delete_task = task->Run();
+    task_stats::RecordTask(posted_from_, start_time_us - ready_time_us_,
+                           TimeMicros() - start_time_us);
+    if (delete_task)
+      delete task;
+    return true;
+  }
+
+  const Location posted_from_;
+  std::unique_ptr<QueuedTask> task_;
+  const int64_t ready_time_us_;
+};
+
 // Convenience function to construct closures that can be passed directly
 // to methods that support std::unique_ptr<QueuedTask> but not template
 // based parameters.
@@ -169,8 +202,6 @@ class RTC_LOCKABLE TaskQueue {
   // Used for DCHECKing the current queue.
   bool IsCurrent() const;
 
-  // TODO(tommi): For better debuggability, implement RTC_FROM_HERE.
-
   // Ownership of the task is passed to PostTask.
   void PostTask(std::unique_ptr<QueuedTask> task);
   void PostTaskAndReply(std::unique_ptr<QueuedTask> task,
@@ -206,6 +237,41 @@ class RTC_LOCKABLE TaskQueue {
     PostDelayedTask(NewClosure(std::forward<Closure>(closure)), milliseconds);
   }
 
+  // Same as PostTask() and PostDelayedTask() above, except that the time the
+  // task waits in the queue and the time it runs are reported to
+  // rtc::task_stats under |posted_from|, and that the task is logged if it
+  // runs for long. Pass RTC_FROM_HERE as |posted_from|.
+  void PostTask(const Location& posted_from, std::unique_ptr<QueuedTask> task) {
+    PostTask(absl::make_unique<LocatedTask>(posted_from, std::move(task), 0));
+  }
+
+  void PostDelayedTask(const Location& posted_from,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) {
+    PostDelayedTask(absl::make_unique<LocatedTask>(posted_from, std::move(task),
+                                                   milliseconds),
+                    milliseconds);
+  }
+
+  template <class Closure,
+            typename std::enable_if<!std::is_convertible<
+                Closure,
+                std::unique_ptr<QueuedTask>>::value>::type* = nullptr>
+  void PostTask(const Location& posted_from, Closure&& closure) {
+    PostTask(posted_from, NewClosure(std::forward<Closure>(closure)));
+  }
+
+  template <class Closure,
+            typename std::enable_if<!std::is_convertible<
+                Closure,
+                std::unique_ptr<QueuedTask>>::value>::type* = nullptr>
+  void PostDelayedTask(const Location& posted_from,
+                       Closure&& closure,
+                       uint32_t milliseconds) {
+    PostDelayedTask(posted_from, NewClosure(std::forward<Closure>(closure)),
+                    milliseconds);
+  }
+
   template <class Closure1, class Closure2>
   void PostTaskAndReply(Closure1&& task,
                         Closure2&& reply,
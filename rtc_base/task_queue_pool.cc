@@ -0,0 +1,582 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// TaskQueue implementation that does not own a thread. Every TaskQueue is a
+// logical sequence scheduled on a process wide pool of worker threads, one
+// pool per TaskQueue::Priority. A queue with pending tasks is placed on the
+// run list of one worker; a worker that runs out of queues steals from the
+// others. At most one worker runs a given queue at any time and a queue's
+// tasks run in posting order, so the guarantees of a thread per queue are
+// kept while thousands of mostly idle queues share a few threads.
+
+#include "rtc_base/task_queue.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/task_queue_posix.h"
+#include "rtc_base/timeutils.h"
+
+namespace rtc {
+using internal::GetQueuePtrTls;
+
+namespace {
+
+using Priority = TaskQueue::Priority;
+
+// Number of tasks a worker runs from one queue before giving other queues a
+// turn.
+const int kMaxTasksPerSlice = 16;
+
+ThreadPriority TaskQueuePriorityToThreadPriority(Priority priority) {
+  switch (priority) {
+    case Priority::HIGH:
+      return kRealtimePriority;
+    case Priority::LOW:
+      return kLowPriority;
+    case Priority::NORMAL:
+      return kNormalPriority;
+    default:
+      RTC_NOTREACHED();
+      break;
+  }
+  return kNormalPriority;
+}
+
+const char* TaskQueuePriorityToThreadName(Priority priority) {
+  switch (priority) {
+    case Priority::HIGH:
+      return "TaskQueuePoolHigh";
+    case Priority::LOW:
+      return "TaskQueuePoolLow";
+    case Priority::NORMAL:
+      return "TaskQueuePool";
+    default:
+      RTC_NOTREACHED();
+      break;
+  }
+  return "TaskQueuePool";
+}
+
+size_t NumberOfWorkers() {
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);  // NOLINT
+  return cores > 1 ? static_cast<size_t>(cores) : 2;
+}
+
+class TaskQueuePool;
+
+// What the pool sees of a TaskQueue.
+class SequencedQueue : public RefCountInterface {
+ public:
+  virtual void PostTask(std::unique_ptr<QueuedTask> task) = 0;
+  // Runs up to kMaxTasksPerSlice tasks and reschedules the queue if more are
+  // pending.
+  virtual void RunTasks() = 0;
+
+ protected:
+  ~SequencedQueue() override {}
+};
+
+}  // namespace
+
+class TaskQueue::Impl : public SequencedQueue {
+ public:
+  Impl(TaskQueue* queue, Priority priority);
+  ~Impl() override;
+
+  static TaskQueue::Impl* Current();
+  static TaskQueue* CurrentQueue();
+
+  // Used for DCHECKing the current queue.
+  bool IsCurrent() const;
+
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+  void PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                        std::unique_ptr<QueuedTask> reply,
+                        TaskQueue::Impl* reply_queue);
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task, uint32_t milliseconds);
+
+  // Drops all pending tasks and waits for a running task to finish. Tasks
+  // posted afterwards are deleted without running.
+  void Stop();
+
+  // Called by a pool worker.
+  void RunTasks() override;
+
+ private:
+  class PostAndReplyTask;
+
+  TaskQueue* const queue_;
+  TaskQueuePool* const pool_;
+  // Signaled when a worker leaves RunTasks() of a stopped queue.
+  Event slice_done_;
+  rtc::CriticalSection lock_;
+  std::deque<std::unique_ptr<QueuedTask>> pending_ RTC_GUARDED_BY(lock_);
+  // True while the queue is on a run list or being run by a worker.
+  bool scheduled_ RTC_GUARDED_BY(lock_) = false;
+  bool running_ RTC_GUARDED_BY(lock_) = false;
+  bool stopped_ RTC_GUARDED_BY(lock_) = false;
+};
+
+namespace {
+
+class TaskQueuePool {
+ public:
+  // Pools are created on first use and never destroyed.
+  static TaskQueuePool* Get(Priority priority);
+
+  // Puts a queue that has tasks to run on a worker's run list.
+  void Schedule(scoped_refptr<SequencedQueue> queue);
+  // Posts |task| to |queue| once |milliseconds| have passed.
+  void PostDelayedTask(scoped_refptr<SequencedQueue> queue,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds);
+  // Deletes the delayed tasks of a stopped queue.
+  void CancelDelayedTasks(SequencedQueue* queue);
+
+ private:
+  struct Worker {
+    Worker(TaskQueuePool* pool, size_t index, Priority priority)
+        : pool(pool),
+          index(index),
+          wakeup(false, false),
+          thread(&TaskQueuePool::WorkerMain,
+                 this,
+                 TaskQueuePriorityToThreadName(priority),
+                 TaskQueuePriorityToThreadPriority(priority)) {}
+
+    TaskQueuePool* const pool;
+    const size_t index;
+    Event wakeup;
+    rtc::CriticalSection lock;
+    std::deque<scoped_refptr<SequencedQueue>> run_list RTC_GUARDED_BY(lock);
+    PlatformThread thread;
+  };
+
+  struct DelayedTask {
+    scoped_refptr<SequencedQueue> queue;
+    std::unique_ptr<QueuedTask> task;
+  };
+
+  explicit TaskQueuePool(Priority priority);
+
+  static void WorkerMain(void* context);
+  static pthread_key_t GetWorkerTls();
+
+  void Run(Worker* worker);
+  scoped_refptr<SequencedQueue> FindWork(Worker* worker);
+  void PostDueTasks();
+  // Returns how long an idle worker may sleep before a delayed task is due.
+  int TimeUntilNextDelayedTask();
+  void WakeUpIdleWorker(bool for_timer);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> next_worker_{0};
+  // Number of queues on run lists. Together with |num_idle_| this makes sure
+  // a worker never goes to sleep while a queue is waiting to be run.
+  std::atomic<int> num_runnable_{0};
+  std::atomic<int> num_idle_{0};
+  // Due time of the earliest delayed task, read without |lock_| by busy
+  // workers.
+  std::atomic<int64_t> next_due_ms_{std::numeric_limits<int64_t>::max()};
+
+  rtc::CriticalSection lock_;
+  std::vector<Worker*> idle_workers_ RTC_GUARDED_BY(lock_);
+  // The idle worker that wakes up for the next delayed task.
+  Worker* timer_worker_ RTC_GUARDED_BY(lock_) = nullptr;
+  std::multimap<int64_t, DelayedTask> delayed_tasks_ RTC_GUARDED_BY(lock_);
+};
+
+// static
+TaskQueuePool* TaskQueuePool::Get(Priority priority) {
+  static TaskQueuePool* const normal = new TaskQueuePool(Priority::NORMAL);
+  if (priority == Priority::NORMAL)
+    return normal;
+  static TaskQueuePool* const high = new TaskQueuePool(Priority::HIGH);
+  if (priority == Priority::HIGH)
+    return high;
+  static TaskQueuePool* const low = new TaskQueuePool(Priority::LOW);
+  return low;
+}
+
+TaskQueuePool::TaskQueuePool(Priority priority) {
+  size_t count = NumberOfWorkers();
+  for (size_t i = 0; i < count; ++i)
+    workers_.emplace_back(new Worker(this, i, priority));
+  for (auto& worker : workers_)
+    worker->thread.Start();
+}
+
+// static
+pthread_key_t TaskQueuePool::GetWorkerTls() {
+  static pthread_key_t key = [] {
+    pthread_key_t key;
+    RTC_CHECK_EQ(0, pthread_key_create(&key, nullptr));
+    return key;
+  }();
+  return key;
+}
+
+// static
+void TaskQueuePool::WorkerMain(void* context) {
+  Worker* worker = static_cast<Worker*>(context);
+  pthread_setspecific(GetWorkerTls(), worker);
+  worker->pool->Run(worker);
+}
+
+void TaskQueuePool::Run(Worker* worker) {
+  while (true) {
+    if (TimeMillis() >= next_due_ms_.load())
+      PostDueTasks();
+
+    scoped_refptr<SequencedQueue> queue = FindWork(worker);
+    if (queue) {
+      queue->RunTasks();
+      continue;
+    }
+
+    int timeout_ms;
+    {
+      CritScope lock(&lock_);
+      idle_workers_.push_back(worker);
+      ++num_idle_;
+      if (num_runnable_.load() > 0) {
+        // Lost a race with Schedule(); there is work after all.
+        idle_workers_.pop_back();
+        --num_idle_;
+        continue;
+      }
+      // Only one idle worker sleeps with a timeout for the next delayed task,
+      // so that the others aren't all woken up by every timer.
+      if (!timer_worker_)
+        timer_worker_ = worker;
+      timeout_ms = timer_worker_ == worker ? TimeUntilNextDelayedTask()
+                                           : Event::kForever;
+    }
+    worker->wakeup.Wait(timeout_ms);
+    {
+      CritScope lock(&lock_);
+      auto it = std::find(idle_workers_.begin(), idle_workers_.end(), worker);
+      if (it != idle_workers_.end()) {
+        idle_workers_.erase(it);
+        --num_idle_;
+      }
+      if (timer_worker_ == worker)
+        timer_worker_ = nullptr;
+    }
+  }
+}
+
+scoped_refptr<SequencedQueue> TaskQueuePool::FindWork(Worker* worker) {
+  scoped_refptr<SequencedQueue> queue;
+  {
+    CritScope lock(&worker->lock);
+    if (!worker->run_list.empty()) {
+      queue = std::move(worker->run_list.front());
+      worker->run_list.pop_front();
+    }
+  }
+  // Steal from the back of the other workers' run lists; the owner keeps the
+  // front, which it is likely to have in cache.
+  for (size_t i = 1; !queue && i < workers_.size(); ++i) {
+    Worker* victim = workers_[(worker->index + i) % workers_.size()].get();
+    CritScope lock(&victim->lock);
+    if (!victim->run_list.empty()) {
+      queue = std::move(victim->run_list.back());
+      victim->run_list.pop_back();
+    }
+  }
+  if (queue)
+    --num_runnable_;
+  return queue;
+}
+
+void TaskQueuePool::Schedule(scoped_refptr<SequencedQueue> queue) {
+  // Queues scheduled from a worker stay on that worker unless stolen.
+  Worker* worker = static_cast<Worker*>(pthread_getspecific(GetWorkerTls()));
+  if (!worker || worker->pool != this)
+    worker = workers_[next_worker_++ % workers_.size()].get();
+  {
+    CritScope lock(&worker->lock);
+    worker->run_list.push_back(std::move(queue));
+  }
+  ++num_runnable_;
+  if (num_idle_.load() > 0)
+    WakeUpIdleWorker(false);
+}
+
+void TaskQueuePool::WakeUpIdleWorker(bool for_timer) {
+  CritScope lock(&lock_);
+  if (idle_workers_.empty())
+    return;
+  // Work goes to a worker other than the one watching the timers, if there
+  // is one; a new earliest timer goes to the timer worker.
+  auto it = std::find(idle_workers_.begin(), idle_workers_.end(),
+                      timer_worker_);
+  if (it == idle_workers_.end() || (!for_timer && idle_workers_.size() > 1)) {
+    it = idle_workers_.end() - 1;
+    if (*it == timer_worker_)
+      --it;
+  }
+  (*it)->wakeup.Set();
+  idle_workers_.erase(it);
+  --num_idle_;
+}
+
+void TaskQueuePool::PostDelayedTask(scoped_refptr<SequencedQueue> queue,
+                                    std::unique_ptr<QueuedTask> task,
+                                    uint32_t milliseconds) {
+  int64_t due_ms = TimeMillis() + milliseconds;
+  bool earliest;
+  {
+    CritScope lock(&lock_);
+    delayed_tasks_.emplace(due_ms,
+                           DelayedTask{std::move(queue), std::move(task)});
+    earliest = due_ms < next_due_ms_.load();
+    if (earliest)
+      next_due_ms_ = due_ms;
+  }
+  // The sleeping timer worker has to recompute its timeout.
+  if (earliest)
+    WakeUpIdleWorker(true);
+}
+
+void TaskQueuePool::PostDueTasks() {
+  std::vector<DelayedTask> due;
+  {
+    CritScope lock(&lock_);
+    int64_t now = TimeMillis();
+    auto end = delayed_tasks_.upper_bound(now);
+    for (auto it = delayed_tasks_.begin(); it != end; ++it)
+      due.push_back(std::move(it->second));
+    delayed_tasks_.erase(delayed_tasks_.begin(), end);
+    next_due_ms_ = delayed_tasks_.empty()
+                       ? std::numeric_limits<int64_t>::max()
+                       : delayed_tasks_.begin()->first;
+  }
+  for (DelayedTask& delayed : due)
+    delayed.queue->PostTask(std::move(delayed.task));
+}
+
+int TaskQueuePool::TimeUntilNextDelayedTask() {
+  int64_t due_ms = next_due_ms_.load();
+  if (due_ms == std::numeric_limits<int64_t>::max())
+    return Event::kForever;
+  return static_cast<int>(std::max<int64_t>(0, due_ms - TimeMillis()));
+}
+
+void TaskQueuePool::CancelDelayedTasks(SequencedQueue* queue) {
+  std::vector<DelayedTask> cancelled;
+  {
+    CritScope lock(&lock_);
+    for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+      if (it->second.queue.get() == queue) {
+        cancelled.push_back(std::move(it->second));
+        it = delayed_tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    next_due_ms_ = delayed_tasks_.empty()
+                       ? std::numeric_limits<int64_t>::max()
+                       : delayed_tasks_.begin()->first;
+  }
+  // |cancelled| deletes the tasks outside of |lock_|.
+}
+
+}  // namespace
+
+// Runs |task_| and then posts |reply_| to the reply queue. The reply queue is
+// kept alive by the reference, so no handshake is needed when it has been
+// stopped in the meantime; PostTask() then just deletes the reply.
+class TaskQueue::Impl::PostAndReplyTask : public QueuedTask {
+ public:
+  PostAndReplyTask(std::unique_ptr<QueuedTask> task,
+                   std::unique_ptr<QueuedTask> reply,
+                   TaskQueue::Impl* reply_queue)
+      : task_(std::move(task)),
+        reply_(std::move(reply)),
+        reply_queue_(reply_queue) {}
+
+ private:
+  bool Run() override {
+    if (!task_->Run())
+      task_.release();
+    reply_queue_->PostTask(std::move(reply_));
+    return true;
+  }
+
+  std::unique_ptr<QueuedTask> task_;
+  std::unique_ptr<QueuedTask> reply_;
+  const scoped_refptr<TaskQueue::Impl> reply_queue_;
+};
+
+TaskQueue::Impl::Impl(TaskQueue* queue, Priority priority)
+    : queue_(queue),
+      pool_(TaskQueuePool::Get(priority)),
+      slice_done_(false, false) {}
+
+TaskQueue::Impl::~Impl() {}
+
+// static
+TaskQueue::Impl* TaskQueue::Impl::Current() {
+  return static_cast<TaskQueue::Impl*>(pthread_getspecific(GetQueuePtrTls()));
+}
+
+// static
+TaskQueue* TaskQueue::Impl::CurrentQueue() {
+  TaskQueue::Impl* current = Current();
+  return current ? current->queue_ : nullptr;
+}
+
+bool TaskQueue::Impl::IsCurrent() const {
+  return Current() == this;
+}
+
+void TaskQueue::Impl::PostTask(std::unique_ptr<QueuedTask> task) {
+  RTC_DCHECK(task.get());
+  {
+    CritScope lock(&lock_);
+    if (stopped_)
+      return;
+    pending_.push_back(std::move(task));
+    if (scheduled_)
+      return;
+    scheduled_ = true;
+  }
+  pool_->Schedule(this);
+}
+
+void TaskQueue::Impl::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  RTC_DCHECK(task.get());
+  pool_->PostDelayedTask(this, std::move(task), milliseconds);
+}
+
+void TaskQueue::Impl::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                       std::unique_ptr<QueuedTask> reply,
+                                       TaskQueue::Impl* reply_queue) {
+  PostTask(std::unique_ptr<QueuedTask>(
+      new PostAndReplyTask(std::move(task), std::move(reply), reply_queue)));
+}
+
+void TaskQueue::Impl::Stop() {
+  RTC_DCHECK(!IsCurrent());
+  bool wait;
+  {
+    CritScope lock(&lock_);
+    stopped_ = true;
+    wait = running_;
+  }
+  // The worker notices |stopped_| before starting its next task.
+  if (wait)
+    slice_done_.Wait(Event::kForever);
+
+  std::deque<std::unique_ptr<QueuedTask>> dropped;
+  {
+    CritScope lock(&lock_);
+    dropped.swap(pending_);
+  }
+  dropped.clear();
+  pool_->CancelDelayedTasks(this);
+}
+
+void TaskQueue::Impl::RunTasks() {
+  TaskQueue::Impl* previous = Current();
+  pthread_setspecific(GetQueuePtrTls(), this);
+  {
+    CritScope lock(&lock_);
+    RTC_DCHECK(scheduled_);
+    running_ = true;
+  }
+  bool reschedule = false;
+  for (int i = 0; i < kMaxTasksPerSlice; ++i) {
+    std::unique_ptr<QueuedTask> task;
+    {
+      CritScope lock(&lock_);
+      if (stopped_ || pending_.empty())
+        break;
+      task = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    if (!task->Run())
+      task.release();
+  }
+  {
+    CritScope lock(&lock_);
+    running_ = false;
+    if (stopped_) {
+      slice_done_.Set();
+    } else if (!pending_.empty()) {
+      reschedule = true;
+    }
+    scheduled_ = reschedule;
+  }
+  pthread_setspecific(GetQueuePtrTls(), previous);
+  if (reschedule)
+    pool_->Schedule(this);
+}
+
+TaskQueue::TaskQueue(const char* queue_name, Priority priority)
+    : impl_(new RefCountedObject<TaskQueue::Impl>(this, priority)) {
+  RTC_DCHECK(queue_name);
+}
+
+TaskQueue::~TaskQueue() {
+  impl_->Stop();
+}
+
+// static
+TaskQueue* TaskQueue::Current() {
+  return TaskQueue::Impl::CurrentQueue();
+}
+
+// Used for DCHECKing the current queue.
+bool TaskQueue::IsCurrent() const {
+  return impl_->IsCurrent();
+}
+
+void TaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  return TaskQueue::impl_->PostTask(std::move(task));
+}
+
+void TaskQueue::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                 std::unique_ptr<QueuedTask> reply,
+                                 TaskQueue* reply_queue) {
+  return TaskQueue::impl_->PostTaskAndReply(std::move(task), std::move(reply),
+                                            reply_queue->impl_.get());
+}
+
+void TaskQueue::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                 std::unique_ptr<QueuedTask> reply) {
+  return TaskQueue::impl_->PostTaskAndReply(std::move(task), std::move(reply),
+                                            impl_.get());
+}
+
+void TaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                uint32_t milliseconds) {
+  return TaskQueue::impl_->PostDelayedTask(std::move(task), milliseconds);
+}
+
+}  // namespace rtc
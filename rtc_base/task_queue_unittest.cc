@@ -18,10 +18,12 @@
 #include <memory>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/task_stats.h"
 #include "rtc_base/timeutils.h"
 
 using rtc::test::TaskQueueForTest;
@@ -104,6 +106,52 @@ TEST(TaskQueueTest, PostLambda) {
   EXPECT_TRUE(ran);
 }
 
+TEST(TaskQueueTest, PostWithLocationReportsTaskStats) {
+  static const char kQueueName[] = "PostWithLocationReportsTaskStats";
+  Event event(false, false);
+  TaskQueue queue(kQueueName);
+  task_stats::GetAndReset();
+  task_stats::Enable();
+
+  // Posts itself once more, keeping its ownership.
+  class RepostingTask : public QueuedTask {
+   public:
+    RepostingTask(const Location& posted_from, Event* event)
+        : posted_from_(posted_from), event_(event) {}
+
+   private:
+    bool Run() override {
+      if (++runs_ == 2) {
+        event_->Set();
+        return true;
+      }
+      TaskQueue::Current()->PostDelayedTask(
+          posted_from_, std::unique_ptr<QueuedTask>(this), 1);
+      return false;
+    }
+
+    const Location posted_from_;
+    Event* const event_;
+    int runs_ = 0;
+  };
+
+  const Location posted_from = RTC_FROM_HERE;
+  queue.PostTask(posted_from,
+                 absl::make_unique<RepostingTask>(posted_from, &event));
+  EXPECT_TRUE(event.Wait(1000));
+  Event ran(false, false);
+  queue.PostTask(posted_from, [&ran] { ran.Set(); });
+  EXPECT_TRUE(ran.Wait(1000));
+
+  task_stats::Disable();
+  int64_t runs = 0;
+  for (const auto& stats : task_stats::GetAndReset()) {
+    if (stats.posted_from.file_and_line() == posted_from.file_and_line())
+      runs = stats.run_time.count;
+  }
+  EXPECT_EQ(3, runs);
+}
+
 TEST(TaskQueueTest, PostDelayedZero) {
   static const char kQueueName[] = "PostDelayedZero";
   Event event(false, false);
@@ -123,6 +171,39 @@ TEST(TaskQueueTest, PostFromQueue) {
   EXPECT_TRUE(event.Wait(1000));
 }
 
+// Posts interleaved tasks to many queues and checks that every queue runs its
+// own tasks one at a time and in order.
+TEST(TaskQueueTest, PostToManyQueuesKeepsOrder) {
+  static const int kQueueCount = 64;
+  static const int kTasksPerQueue = 100;
+  std::vector<std::unique_ptr<TaskQueue>> queues;
+  std::vector<std::vector<int>> results(kQueueCount);
+  std::vector<std::unique_ptr<Event>> done;
+  for (int i = 0; i < kQueueCount; ++i) {
+    queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue("ManyQueues")));
+    done.push_back(std::unique_ptr<Event>(new Event(false, false)));
+  }
+  for (int task = 0; task < kTasksPerQueue; ++task) {
+    for (int i = 0; i < kQueueCount; ++i) {
+      TaskQueue* queue = queues[i].get();
+      std::vector<int>* result = &results[i];
+      Event* event = task == kTasksPerQueue - 1 ? done[i].get() : nullptr;
+      queue->PostTask([queue, result, task, event]() {
+        EXPECT_TRUE(queue->IsCurrent());
+        result->push_back(task);
+        if (event)
+          event->Set();
+      });
+    }
+  }
+  for (int i = 0; i < kQueueCount; ++i) {
+    ASSERT_TRUE(done[i]->Wait(1000));
+    ASSERT_EQ(static_cast<size_t>(kTasksPerQueue), results[i].size());
+    for (int task = 0; task < kTasksPerQueue; ++task)
+      EXPECT_EQ(task, results[i][task]);
+  }
+}
+
 TEST(TaskQueueTest, PostDelayed) {
   static const char kQueueName[] = "PostDelayed";
   Event event(false, false);
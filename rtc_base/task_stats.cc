@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/timeutils.h"
+
+namespace rtc {
+namespace task_stats {
+namespace {
+
+constexpr int64_t kDefaultSlowTaskThresholdMs = 50;
+
+std::atomic<bool> g_enabled(false);
+std::atomic<int64_t> g_slow_task_threshold_us(kDefaultSlowTaskThresholdMs *
+                                              kNumMicrosecsPerMillisec);
+
+int GetBucket(int64_t value_us) {
+  int bucket = 0;
+  while (value_us > 0 && bucket < Histogram::kNumBuckets - 1) {
+    value_us >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+class Registry {
+ public:
+  static Registry* Get() {
+    // Leaked, so that tasks that run during shutdown can still be recorded.
+    static Registry* const registry = new Registry();
+    return registry;
+  }
+
+  void Record(const Location& posted_from,
+              int64_t queue_delay_us,
+              int64_t run_time_us) {
+    CritScope lock(&crit_);
+    // RTC_FROM_HERE makes the same string literal for every task posted from
+    // the same line, so the pointer identifies the location.
+    LocationStats& stats = stats_[posted_from.file_and_line()];
+    stats.posted_from = posted_from;
+    stats.queue_delay.Add(queue_delay_us);
+    stats.run_time.Add(run_time_us);
+  }
+
+  std::vector<LocationStats> GetAndReset() {
+    std::vector<LocationStats> result;
+    {
+      CritScope lock(&crit_);
+      result.reserve(stats_.size());
+      for (const auto& entry : stats_)
+        result.push_back(entry.second);
+      stats_.clear();
+    }
+    std::sort(result.begin(), result.end(),
+              [](const LocationStats& a, const LocationStats& b) {
+                return a.run_time.sum_us > b.run_time.sum_us;
+              });
+    return result;
+  }
+
+ private:
+  CriticalSection crit_;
+  std::map<const char*, LocationStats> stats_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace
+
+constexpr int Histogram::kNumBuckets;
+
+void Histogram::Add(int64_t value_us) {
+  value_us = std::max<int64_t>(value_us, 0);
+  ++count;
+  sum_us += value_us;
+  max_us = std::max(max_us, value_us);
+  ++buckets[GetBucket(value_us)];
+}
+
+int64_t Histogram::GetPercentileUs(double fraction) const {
+  RTC_DCHECK_GE(fraction, 0.0);
+  RTC_DCHECK_LE(fraction, 1.0);
+  if (count == 0)
+    return 0;
+  const int64_t rank =
+      std::max<int64_t>(1, static_cast<int64_t>(fraction * count + 0.5));
+  int64_t seen = 0;
+  for (int i = 0; i < kNumBuckets - 1; ++i) {
+    seen += buckets[i];
+    if (seen >= rank)
+      return std::min(i == 0 ? 0 : (int64_t{1} << i) - 1, max_us);
+  }
+  return max_us;
+}
+
+void Enable() {
+  g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Disable() {
+  g_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool IsEnabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void SetSlowTaskThresholdMs(int64_t threshold_ms) {
+  g_slow_task_threshold_us.store(threshold_ms * kNumMicrosecsPerMillisec,
+                                 std::memory_order_relaxed);
+}
+
+void RecordTask(const Location& posted_from,
+                int64_t queue_delay_us,
+                int64_t run_time_us) {
+  const int64_t threshold_us =
+      g_slow_task_threshold_us.load(std::memory_order_relaxed);
+  if (run_time_us >= threshold_us) {
+    RTC_LOG(LS_WARNING) << "Task took "
+                        << run_time_us / kNumMicrosecsPerMillisec
+                        << "ms to run, after waiting "
+                        << std::max<int64_t>(queue_delay_us, 0) /
+                               kNumMicrosecsPerMillisec
+                        << "ms in the queue. Posted from: "
+                        << posted_from.ToString();
+  }
+  if (IsEnabled())
+    Registry::Get()->Record(posted_from, queue_delay_us, run_time_us);
+}
+
+std::vector<LocationStats> GetAndReset() {
+  return Registry::Get()->GetAndReset();
+}
+
+}  // namespace task_stats
+}  // namespace rtc
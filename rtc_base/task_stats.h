@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_STATS_H_
+#define RTC_BASE_TASK_STATS_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/location.h"
+
+// Process-wide statistics of the tasks run by rtc::Thread and rtc::TaskQueue:
+// how long each task waited in its queue before it started to run, and how
+// long it ran, aggregated per location that posted it.
+//
+// Aggregation is off by default, and costs a lock and a map lookup per task
+// while it is on. Regardless of it, tasks that run for longer than the slow
+// task threshold are logged together with the location that posted them.
+//
+// Example:
+//
+//   rtc::task_stats::Enable();
+//   ...
+//   for (const auto& stats : rtc::task_stats::GetAndReset()) {
+//     RTC_LOG(LS_INFO) << stats.posted_from.ToString() << " ran "
+//                      << stats.run_time.count << " times, 99% within "
+//                      << stats.run_time.GetPercentileUs(0.99) << " us";
+//   }
+namespace rtc {
+namespace task_stats {
+
+// Histogram of durations in microseconds. Bucket 0 counts durations of 0 us
+// and bucket i > 0 counts durations in [2^(i-1), 2^i) us, except that the
+// last bucket also counts everything longer.
+struct Histogram {
+  static constexpr int kNumBuckets = 32;
+
+  void Add(int64_t value_us);
+  // Returns an upper bound of the |fraction| percentile, where |fraction| is
+  // between 0 and 1, or 0 if the histogram is empty.
+  int64_t GetPercentileUs(double fraction) const;
+
+  int64_t count = 0;
+  int64_t sum_us = 0;
+  int64_t max_us = 0;
+  int64_t buckets[kNumBuckets] = {};
+};
+
+struct LocationStats {
+  Location posted_from;
+  // Time from when the task was due to run until it started to run.
+  Histogram queue_delay;
+  Histogram run_time;
+};
+
+// Starts and stops aggregating the tasks that run.
+void Enable();
+void Disable();
+bool IsEnabled();
+
+// Tasks that run for at least |threshold_ms| are logged. Defaults to 50 ms.
+void SetSlowTaskThresholdMs(int64_t threshold_ms);
+
+// Called by the task queues after a task posted from |posted_from| has run.
+void RecordTask(const Location& posted_from,
+                int64_t queue_delay_us,
+                int64_t run_time_us);
+
+// Returns what has been aggregated since the last call, with the locations
+// whose tasks ran for the longest in total first.
+std::vector<LocationStats> GetAndReset();
+
+}  // namespace task_stats
+}  // namespace rtc
+
+#endif  // RTC_BASE_TASK_STATS_H_
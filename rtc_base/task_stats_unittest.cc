@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_stats.h"
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace task_stats {
+namespace {
+
+class TaskStatsTest : public ::testing::Test {
+ protected:
+  TaskStatsTest() {
+    GetAndReset();
+    Enable();
+  }
+  ~TaskStatsTest() override {
+    Disable();
+    GetAndReset();
+  }
+};
+
+}  // namespace
+
+TEST(TaskStatsHistogramTest, AddsToPowerOfTwoBuckets) {
+  Histogram histogram;
+  histogram.Add(0);
+  histogram.Add(1);
+  histogram.Add(3);
+  histogram.Add(4);
+  histogram.Add(7);
+  histogram.Add(-5);
+  EXPECT_EQ(6, histogram.count);
+  EXPECT_EQ(15, histogram.sum_us);
+  EXPECT_EQ(7, histogram.max_us);
+  EXPECT_EQ(2, histogram.buckets[0]);
+  EXPECT_EQ(1, histogram.buckets[1]);
+  EXPECT_EQ(1, histogram.buckets[2]);
+  EXPECT_EQ(2, histogram.buckets[3]);
+}
+
+TEST(TaskStatsHistogramTest, LastBucketCountsLongDurations) {
+  Histogram histogram;
+  histogram.Add(int64_t{1} << 40);
+  EXPECT_EQ(1, histogram.buckets[Histogram::kNumBuckets - 1]);
+  EXPECT_EQ(int64_t{1} << 40, histogram.GetPercentileUs(0.5));
+}
+
+TEST(TaskStatsHistogramTest, GetsPercentiles) {
+  Histogram histogram;
+  EXPECT_EQ(0, histogram.GetPercentileUs(0.5));
+  for (int i = 0; i < 90; ++i)
+    histogram.Add(100);
+  for (int i = 0; i < 10; ++i)
+    histogram.Add(5000);
+  // 100 us is in [64, 128) and 5000 us in [4096, 8192).
+  EXPECT_EQ(127, histogram.GetPercentileUs(0.0));
+  EXPECT_EQ(127, histogram.GetPercentileUs(0.5));
+  EXPECT_EQ(127, histogram.GetPercentileUs(0.9));
+  EXPECT_EQ(5000, histogram.GetPercentileUs(0.95));
+  EXPECT_EQ(5000, histogram.GetPercentileUs(1.0));
+}
+
+TEST_F(TaskStatsTest, AggregatesPerLocation) {
+  const Location first = RTC_FROM_HERE;
+  const Location second = RTC_FROM_HERE;
+  RecordTask(first, 10, 100);
+  RecordTask(second, 20, 2000);
+  RecordTask(first, 30, 300);
+
+  std::vector<LocationStats> stats = GetAndReset();
+  ASSERT_EQ(2u, stats.size());
+  // Sorted by total run time.
+  EXPECT_EQ(second.file_and_line(), stats[0].posted_from.file_and_line());
+  EXPECT_EQ(1, stats[0].run_time.count);
+  EXPECT_EQ(2000, stats[0].run_time.sum_us);
+  EXPECT_EQ(first.file_and_line(), stats[1].posted_from.file_and_line());
+  EXPECT_EQ(2, stats[1].run_time.count);
+  EXPECT_EQ(400, stats[1].run_time.sum_us);
+  EXPECT_EQ(40, stats[1].queue_delay.sum_us);
+  EXPECT_EQ(30, stats[1].queue_delay.max_us);
+
+  EXPECT_TRUE(GetAndReset().empty());
+}
+
+TEST_F(TaskStatsTest, DoesNotAggregateWhenDisabled) {
+  Disable();
+  RecordTask(RTC_FROM_HERE, 0, 100);
+  EXPECT_TRUE(GetAndReset().empty());
+  Enable();
+  RecordTask(RTC_FROM_HERE, 0, 100);
+  EXPECT_EQ(1u, GetAndReset().size());
+}
+
+}  // namespace task_stats
+}  // namespace rtc
@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #if defined(WEBRTC_POSIX)
+#include <pthread.h>
 #include <sys/time.h>
 #if defined(WEBRTC_MAC)
 #include <mach/mach_time.h>
@@ -45,6 +46,69 @@ ClockInterface* GetClockForTesting() {
   return g_clock;
 }
 
+namespace {
+
+#if defined(WEBRTC_POSIX)
+pthread_key_t GetCachedTimeTls() {
+  static const pthread_key_t key = [] {
+    pthread_key_t key;
+    RTC_CHECK_EQ(0, pthread_key_create(&key, nullptr));
+    return key;
+  }();
+  return key;
+}
+
+ScopedCachedTime* GetCachedTime() {
+  return static_cast<ScopedCachedTime*>(
+      pthread_getspecific(GetCachedTimeTls()));
+}
+
+void SetCachedTime(ScopedCachedTime* cached_time) {
+  pthread_setspecific(GetCachedTimeTls(), cached_time);
+}
+#elif defined(WEBRTC_WIN)
+DWORD GetCachedTimeTls() {
+  static const DWORD key = [] {
+    DWORD key = ::TlsAlloc();
+    RTC_CHECK_NE(TLS_OUT_OF_INDEXES, key);
+    return key;
+  }();
+  return key;
+}
+
+ScopedCachedTime* GetCachedTime() {
+  return static_cast<ScopedCachedTime*>(::TlsGetValue(GetCachedTimeTls()));
+}
+
+void SetCachedTime(ScopedCachedTime* cached_time) {
+  ::TlsSetValue(GetCachedTimeTls(), cached_time);
+}
+#endif
+
+}  // namespace
+
+ScopedCachedTime::ScopedCachedTime()
+    : time_nanos_(SystemTimeNanos()), previous_(GetCachedTime()) {
+  SetCachedTime(this);
+}
+
+ScopedCachedTime::~ScopedCachedTime() {
+  RTC_DCHECK_EQ(this, GetCachedTime());
+  SetCachedTime(previous_);
+}
+
+// static
+const ScopedCachedTime* ScopedCachedTime::Current() {
+  return GetCachedTime();
+}
+
+// static
+void ScopedCachedTime::Refresh() {
+  ScopedCachedTime* cached_time = GetCachedTime();
+  if (cached_time)
+    cached_time->time_nanos_ = SystemTimeNanos();
+}
+
 int64_t SystemTimeNanos() {
   int64_t ticks;
 #if defined(WEBRTC_MAC)
@@ -104,6 +168,10 @@ int64_t TimeNanos() {
   if (g_clock) {
     return g_clock->TimeNanos();
   }
+  const ScopedCachedTime* cached_time = GetCachedTime();
+  if (cached_time) {
+    return cached_time->time_nanos();
+  }
   return SystemTimeNanos();
 }
 
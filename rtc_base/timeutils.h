@@ -18,6 +18,7 @@
 #include <string>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/constructormagic.h"
 
 namespace rtc {
 
@@ -80,6 +81,34 @@ int64_t TimeMicros();
 // Returns the current time in nanoseconds.
 int64_t TimeNanos();
 
+// While in scope, TimeNanos() and the functions and clocks based on it return
+// the time of construction on the current thread, rather than reading the
+// system clock for each call. Event loops use this to handle a batch of
+// events, e.g. received packets, with one reading of the clock. Durations
+// measured within the scope are zero. A clock set with SetClockForTesting()
+// takes precedence.
+class ScopedCachedTime {
+ public:
+  ScopedCachedTime();
+  ~ScopedCachedTime();
+
+  // Returns the scope of the current thread, or null if there is none.
+  static const ScopedCachedTime* Current();
+
+  // Reads the clock again for the scope of the current thread, if any. Loops
+  // that wait within a scope, e.g. a message loop run from an event handler,
+  // call this after waiting, so that their timeouts expire.
+  static void Refresh();
+
+  int64_t time_nanos() const { return time_nanos_; }
+
+ private:
+  int64_t time_nanos_;
+  ScopedCachedTime* const previous_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedCachedTime);
+};
+
 // Returns a future timestamp, 'elapsed' milliseconds from now.
 int64_t TimeAfter(int64_t elapsed);
 
@@ -14,6 +14,7 @@
 #include "rtc_base/gunit.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/thread.h"
+#include "system_wrappers/include/clock.h"
 
 namespace rtc {
 
@@ -205,6 +206,45 @@ TEST_F(TmToSeconds, TestTmToSeconds) {
   TestTmToSeconds(100000);
 }
 
+TEST(ScopedCachedTimeTest, TimeFunctionsUseCachedTime) {
+  {
+    ScopedCachedTime cached_time;
+    const int64_t time_nanos = TimeNanos();
+    Thread::SleepMs(2);
+    EXPECT_EQ(time_nanos, TimeNanos());
+    EXPECT_EQ(time_nanos / kNumNanosecsPerMicrosec, TimeMicros());
+    EXPECT_EQ(time_nanos / kNumNanosecsPerMillisec, TimeMillis());
+    EXPECT_EQ(time_nanos / kNumNanosecsPerMillisec,
+              webrtc::Clock::GetRealTimeClock()->TimeInMilliseconds());
+
+    ScopedCachedTime::Refresh();
+    EXPECT_LT(time_nanos, TimeNanos());
+  }
+  EXPECT_FALSE(ScopedCachedTime::Current());
+}
+
+TEST(ScopedCachedTimeTest, RestoresOuterScope) {
+  ScopedCachedTime outer;
+  Thread::SleepMs(2);
+  {
+    ScopedCachedTime inner;
+    EXPECT_EQ(&inner, ScopedCachedTime::Current());
+    EXPECT_LT(outer.time_nanos(), TimeNanos());
+  }
+  EXPECT_EQ(&outer, ScopedCachedTime::Current());
+  EXPECT_EQ(outer.time_nanos(), TimeNanos());
+}
+
+TEST(ScopedCachedTimeTest, IsPerThread) {
+  ScopedCachedTime cached_time;
+  Thread::SleepMs(2);
+  std::unique_ptr<Thread> thread(Thread::Create());
+  thread->Start();
+  const int64_t other_thread_time_nanos =
+      thread->Invoke<int64_t>(RTC_FROM_HERE, [] { return TimeNanos(); });
+  EXPECT_LT(cached_time.time_nanos(), other_thread_time_nanos);
+}
+
 // Test that all the time functions exposed by TimeUtils get time from the
 // fake clock when it's set.
 TEST(FakeClock, TimeFunctionsUseFakeClock) {
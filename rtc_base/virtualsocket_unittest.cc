@@ -14,7 +14,9 @@
 #include <netinet/in.h>
 #endif
 
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "rtc_base/arraysize.h"
@@ -36,6 +38,44 @@ using webrtc::testing::SSE_READ;
 using webrtc::testing::SSE_WRITE;
 using webrtc::testing::StreamSink;
 
+// Delivers the packets sent through it after a fixed delay, losing every
+// other one.
+class LossyNetworkLink : public webrtc::NetworkSimulationInterface {
+ public:
+  explicit LossyNetworkLink(int64_t delay_us) : delay_us_(delay_us) {}
+
+  bool EnqueuePacket(webrtc::PacketInFlightInfo packet_info) override {
+    packets_.push_back(packet_info);
+    return true;
+  }
+
+  std::vector<webrtc::PacketDeliveryInfo> DequeueDeliverablePackets(
+      int64_t receive_time_us) override {
+    std::vector<webrtc::PacketDeliveryInfo> deliverable;
+    while (!packets_.empty() &&
+           packets_.front().send_time_us + delay_us_ <= receive_time_us) {
+      const webrtc::PacketInFlightInfo& packet = packets_.front();
+      deliverable.emplace_back(
+          packet, (num_dequeued_++ % 2)
+                      ? webrtc::PacketDeliveryInfo::kNotReceived
+                      : packet.send_time_us + delay_us_);
+      packets_.pop_front();
+    }
+    return deliverable;
+  }
+
+  absl::optional<int64_t> NextDeliveryTimeUs() const override {
+    if (packets_.empty())
+      return absl::nullopt;
+    return packets_.front().send_time_us + delay_us_;
+  }
+
+ private:
+  const int64_t delay_us_;
+  std::deque<webrtc::PacketInFlightInfo> packets_;
+  int num_dequeued_ = 0;
+};
+
 // Sends at a constant rate but with random packet sizes.
 struct Sender : public MessageHandler {
   Sender(Thread* th, AsyncSocket* s, uint32_t rt)
@@ -1089,6 +1129,40 @@ TEST_F(VirtualSocketServerTest, SetSendingBlockedWithTcpSocket) {
   EXPECT_TRUE(sink.Check(socket2.get(), SSE_READ));
 }
 
+TEST_F(VirtualSocketServerTest, SendsDatagramsThroughNetworkLink) {
+  const SocketAddress kAddress1("1.1.1.1", 0);
+  const SocketAddress kAddress2("2.2.2.2", 0);
+  constexpr int kDelayMs = 100;
+  ss_.SetNetworkLinkOnAddress(
+      kAddress2.ipaddr(),
+      absl::make_unique<LossyNetworkLink>(kDelayMs * kNumMicrosecsPerMillisec));
+
+  AsyncSocket* socket1 = ss_.CreateAsyncSocket(AF_INET, SOCK_DGRAM);
+  AsyncSocket* socket2 = ss_.CreateAsyncSocket(AF_INET, SOCK_DGRAM);
+  socket1->Bind(kAddress1);
+  socket2->Bind(kAddress2);
+  auto client1 = absl::make_unique<TestClient>(
+      absl::make_unique<AsyncUDPSocket>(socket1), &fake_clock_);
+  auto client2 = absl::make_unique<TestClient>(
+      absl::make_unique<AsyncUDPSocket>(socket2), &fake_clock_);
+
+  const int64_t send_time_ms = TimeMillis();
+  for (const char* data : {"a", "b", "c", "d"})
+    EXPECT_EQ(1, client1->SendTo(data, 1, socket2->GetLocalAddress()));
+  ss_.ProcessMessagesUntilIdle();
+  EXPECT_EQ(send_time_ms + kDelayMs, TimeMillis());
+
+  SocketAddress addr;
+  EXPECT_TRUE(client2->CheckNextPacket("a", 1, &addr));
+  EXPECT_EQ(socket1->GetLocalAddress(), addr);
+  EXPECT_TRUE(client2->CheckNextPacket("c", 1, &addr));
+  EXPECT_TRUE(client2->CheckNoPacket());
+
+  // Packets in the other direction don't go through the link.
+  EXPECT_EQ(1, client2->SendTo("e", 1, socket1->GetLocalAddress()));
+  EXPECT_TRUE(client1->CheckNextPacket("e", 1, &addr));
+}
+
 TEST_F(VirtualSocketServerTest, CreatesStandardDistribution) {
   const uint32_t kTestMean[] = {10, 100, 333, 1000};
   const double kTestDev[] = {0.25, 0.1, 0.01};
@@ -16,14 +16,18 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/fakeclock.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/physicalsocketserver.h"
 #include "rtc_base/socketaddresspair.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/timeutils.h"
 
 namespace rtc {
@@ -51,6 +55,10 @@ const uint32_t TCP_MSS = 1400;        // Maximum segment size
 // Note: The current algorithm doesn't work for sample sizes smaller than this.
 const int NUM_SAMPLES = 1000;
 
+// How often a network link is processed while the packets it holds have no
+// delivery time yet, such as when they're queued for link capacity.
+const int kNetworkLinkProcessIntervalMs = 5;
+
 enum {
   MSG_ID_PACKET,
   MSG_ID_ADDRESS_BOUND,
@@ -521,6 +529,81 @@ void VirtualSocket::OnSocketServerReadyToSend() {
   }
 }
 
+// Holds the packets sent through a NetworkSimulationInterface until it
+// delivers them, and then posts them to their recipients.
+class VirtualSocketServer::NetworkLink : public MessageHandler {
+ public:
+  NetworkLink(VirtualSocketServer* server,
+              std::unique_ptr<webrtc::NetworkSimulationInterface> link)
+      : server_(server), link_(std::move(link)) {}
+
+  // Takes ownership of |packet|.
+  void SendPacket(Packet* packet, const SocketAddress& recipient_addr) {
+    CritScope cs(&crit_);
+    const uint64_t packet_id = next_packet_id_++;
+    if (!link_->EnqueuePacket(webrtc::PacketInFlightInfo(
+            packet->size() + UDP_HEADER_SIZE, TimeMicros(), packet_id))) {
+      RTC_LOG(LS_VERBOSE) << "Dropping packet: network link queue full";
+      delete packet;
+      return;
+    }
+    PendingPacket& pending = pending_packets_[packet_id];
+    pending.packet.reset(packet);
+    pending.recipient_addr = recipient_addr;
+    if (!process_scheduled_ && server_->msg_queue_) {
+      process_scheduled_ = true;
+      server_->msg_queue_->Post(RTC_FROM_HERE, this);
+    }
+  }
+
+ private:
+  struct PendingPacket {
+    std::unique_ptr<Packet> packet;
+    SocketAddress recipient_addr;
+  };
+
+  void OnMessage(Message* msg) override {
+    CritScope cs(&crit_);
+    process_scheduled_ = false;
+    const int64_t now_us = TimeMicros();
+    for (const webrtc::PacketDeliveryInfo& delivery :
+         link_->DequeueDeliverablePackets(now_us)) {
+      auto it = pending_packets_.find(delivery.packet_id);
+      RTC_DCHECK(it != pending_packets_.end());
+      if (it == pending_packets_.end())
+        continue;
+      std::unique_ptr<Packet> packet = std::move(it->second.packet);
+      const SocketAddress recipient_addr = it->second.recipient_addr;
+      pending_packets_.erase(it);
+      if (delivery.receive_time_us == webrtc::PacketDeliveryInfo::kNotReceived)
+        continue;
+      // The recipient may have closed since the packet was sent.
+      VirtualSocket* recipient = server_->LookupBinding(recipient_addr);
+      if (recipient) {
+        server_->msg_queue_->Post(RTC_FROM_HERE, recipient, MSG_ID_PACKET,
+                                  packet.release());
+      }
+    }
+    if (pending_packets_.empty())
+      return;
+    absl::optional<int64_t> next_delivery_us = link_->NextDeliveryTimeUs();
+    int64_t next_process_ms =
+        next_delivery_us
+            ? (*next_delivery_us + kNumMicrosecsPerMillisec - 1) /
+                  kNumMicrosecsPerMillisec
+            : now_us / kNumMicrosecsPerMillisec + kNetworkLinkProcessIntervalMs;
+    process_scheduled_ = true;
+    server_->msg_queue_->PostAt(RTC_FROM_HERE, next_process_ms, this);
+  }
+
+  VirtualSocketServer* const server_;
+  const std::unique_ptr<webrtc::NetworkSimulationInterface> link_;
+  CriticalSection crit_;
+  uint64_t next_packet_id_ RTC_GUARDED_BY(crit_) = 0;
+  std::map<uint64_t, PendingPacket> pending_packets_ RTC_GUARDED_BY(crit_);
+  bool process_scheduled_ RTC_GUARDED_BY(crit_) = false;
+};
+
 VirtualSocketServer::VirtualSocketServer() : VirtualSocketServer(nullptr) {}
 
 VirtualSocketServer::VirtualSocketServer(FakeClock* fake_clock)
@@ -625,6 +708,18 @@ void VirtualSocketServer::WakeUp() {
   wakeup_.Set();
 }
 
+void VirtualSocketServer::SetNetworkLinkOnAddress(
+    const IPAddress& address,
+    std::unique_ptr<webrtc::NetworkSimulationInterface> link) {
+  const IPAddress normalized = address.Normalized();
+  if (link) {
+    links_by_ip_[normalized] =
+        absl::make_unique<NetworkLink>(this, std::move(link));
+  } else {
+    links_by_ip_.erase(normalized);
+  }
+}
+
 void VirtualSocketServer::SetAlternativeLocalAddress(
     const rtc::IPAddress& address,
     const rtc::IPAddress& alternative) {
@@ -854,6 +949,13 @@ int VirtualSocketServer::SendUdp(VirtualSocket* socket,
     return -1;
   }
 
+  auto link = links_by_ip_.find(remote_addr.ipaddr().Normalized());
+  if (link != links_by_ip_.end()) {
+    link->second->SendPacket(
+        new Packet(data, data_size, GetSourceAddress(socket)), remote_addr);
+    return static_cast<int>(data_size);
+  }
+
   {
     CritScope cs(&socket->crit_);
 
@@ -956,17 +1058,8 @@ void VirtualSocketServer::AddPacketToNetwork(VirtualSocket* sender,
   // Find the delay for crossing the many virtual hops of the network.
   uint32_t transit_delay = GetTransitDelay(sender);
 
-  // When the incoming packet is from a binding of the any address, translate it
-  // to the default route here such that the recipient will see the default
-  // route.
-  SocketAddress sender_addr = sender->local_addr_;
-  IPAddress default_ip = GetDefaultRoute(sender_addr.ipaddr().family());
-  if (sender_addr.IsAnyIP() && !IPIsUnspec(default_ip)) {
-    sender_addr.SetIP(default_ip);
-  }
-
   // Post the packet as a message to be delivered (on our own thread)
-  Packet* p = new Packet(data, data_size, sender_addr);
+  Packet* p = new Packet(data, data_size, GetSourceAddress(sender));
 
   int64_t ts = TimeAfter(send_delay + transit_delay);
   if (ordered) {
@@ -979,6 +1072,17 @@ void VirtualSocketServer::AddPacketToNetwork(VirtualSocket* sender,
   msg_queue_->PostAt(RTC_FROM_HERE, ts, recipient, MSG_ID_PACKET, p);
 }
 
+SocketAddress VirtualSocketServer::GetSourceAddress(VirtualSocket* socket) {
+  // When the packet is from a binding of the any address, translate it to the
+  // default route here such that the recipient will see the default route.
+  SocketAddress source_addr = socket->local_addr_;
+  IPAddress default_ip = GetDefaultRoute(source_addr.ipaddr().family());
+  if (source_addr.IsAnyIP() && !IPIsUnspec(default_ip)) {
+    source_addr.SetIP(default_ip);
+  }
+  return source_addr;
+}
+
 void VirtualSocketServer::PurgeNetworkPackets(VirtualSocket* socket,
                                               int64_t cur_time) {
   while (!socket->network_.empty() &&
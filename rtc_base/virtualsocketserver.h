@@ -13,12 +13,16 @@
 
 #include <deque>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
+#include "api/test/simulated_network.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/event.h"
 #include "rtc_base/fakeclock.h"
 #include "rtc_base/messagequeue.h"
+#include "rtc_base/socketaddress.h"
 #include "rtc_base/socketserver.h"
 
 namespace rtc {
@@ -26,6 +30,7 @@ namespace rtc {
 class Packet;
 class VirtualSocket;
 class SocketAddressPair;
+struct SocketAddressPairHash;
 
 // Simulates a network in the same manner as a loopback interface.  The
 // interface can create as many addresses as you want.  All of the sockets
@@ -115,6 +120,17 @@ class VirtualSocketServer : public SocketServer, public sigslot::has_slots<> {
     delay_by_ip_[address.ipaddr()] = delay_ms;
   }
 
+  // Sends the datagrams addressed to |address| through |link|, which then
+  // decides when each of them arrives, or if it's lost, in place of the
+  // bandwidth, capacity and delay settings above. This gives each simulated
+  // host a link of its own, which can be a webrtc::SimulatedNetwork as used
+  // by the call tests. The link is timed by rtc::TimeMicros(), so with a fake
+  // clock, ProcessMessagesUntilIdle() runs through it without sleeping.
+  // Passing null removes the link. TCP traffic doesn't go through links.
+  void SetNetworkLinkOnAddress(
+      const IPAddress& address,
+      std::unique_ptr<webrtc::NetworkSimulationInterface> link);
+
   // Used by TurnPortTest and TcpPortTest (for example), to mimic a case where
   // a proxy returns the local host address instead of the original one the
   // port was bound against. Please see WebRTC issue 3927 for more detail.
@@ -219,6 +235,10 @@ class VirtualSocketServer : public SocketServer, public sigslot::has_slots<> {
   // appropriate distribution.
   uint32_t GetTransitDelay(Socket* socket);
 
+  // Returns the address the recipients of packets from |socket| see them
+  // coming from.
+  SocketAddress GetSourceAddress(VirtualSocket* socket);
+
   // Basic operations on functions.  Those that return a function also take
   // ownership of the function given (and hence, may modify or delete it).
   static Function* Accumulate(Function* f);
@@ -255,11 +275,18 @@ class VirtualSocketServer : public SocketServer, public sigslot::has_slots<> {
  private:
   friend class VirtualSocket;
 
+  class NetworkLink;
+
   // Sending was previously blocked, but now isn't.
   sigslot::signal0<> SignalReadyToSend;
 
-  typedef std::map<SocketAddress, VirtualSocket*> AddressMap;
-  typedef std::map<SocketAddressPair, VirtualSocket*> ConnectionMap;
+  // Hashed, since tests simulating many hosts look these up for each packet.
+  typedef std::unordered_map<SocketAddress, VirtualSocket*, SocketAddressHash>
+      AddressMap;
+  typedef std::unordered_map<SocketAddressPair,
+                             VirtualSocket*,
+                             SocketAddressPairHash>
+      ConnectionMap;
 
   // May be null if the test doesn't use a fake clock, or it does but doesn't
   // use ProcessMessagesUntilIdle.
@@ -291,6 +318,7 @@ class VirtualSocketServer : public SocketServer, public sigslot::has_slots<> {
 
   std::map<rtc::IPAddress, int> delay_by_ip_;
   std::map<rtc::IPAddress, rtc::IPAddress> alternative_address_mapping_;
+  std::map<rtc::IPAddress, std::unique_ptr<NetworkLink>> links_by_ip_;
   std::unique_ptr<Function> delay_dist_;
 
   CriticalSection delay_crit_;
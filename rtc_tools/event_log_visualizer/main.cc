@@ -8,13 +8,24 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include "absl/memory/memory.h"
 #include "logging/rtc_event_log/rtc_event_log_parser_new.h"
 #include "rtc_base/flags.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_tools/event_log_visualizer/analyzer.h"
 #include "rtc_tools/event_log_visualizer/plot_base.h"
 #include "rtc_tools/event_log_visualizer/plot_python.h"
+#include "rtc_tools/event_log_visualizer/plot_summary.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "system_wrappers/include/field_trial_default.h"
 #include "test/field_trial.h"
 #include "test/testsupport/fileutils.h"
@@ -161,165 +172,104 @@ DEFINE_bool(normalize_time,
             true,
             "Normalize the log timestamps so that the call starts at time 0.");
 
-void SetAllPlotFlags(bool setting);
-
-int main(int argc, char* argv[]) {
-  std::string program_name = argv[0];
-  std::string usage =
-      "A tool for visualizing WebRTC event logs.\n"
-      "Example usage:\n" +
-      program_name + " <logfile> | python\n" + "Run " + program_name +
-      " --help for a list of command line options\n";
-
-  // Parse command line flags without removing them. We're only interested in
-  // the |plot_profile| flag.
-  rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, false);
-  if (strcmp(FLAG_plot_profile, "all") == 0) {
-    SetAllPlotFlags(true);
-  } else if (strcmp(FLAG_plot_profile, "none") == 0) {
-    SetAllPlotFlags(false);
-  } else if (strcmp(FLAG_plot_profile, "sendside_bwe") == 0) {
-    SetAllPlotFlags(false);
-    FLAG_plot_outgoing_packet_sizes = true;
-    FLAG_plot_outgoing_bitrate = true;
-    FLAG_plot_outgoing_stream_bitrate = true;
-    FLAG_plot_simulated_sendside_bwe = true;
-    FLAG_plot_network_delay_feedback = true;
-    FLAG_plot_fraction_loss_feedback = true;
-  } else if (strcmp(FLAG_plot_profile, "receiveside_bwe") == 0) {
-    SetAllPlotFlags(false);
-    FLAG_plot_incoming_packet_sizes = true;
-    FLAG_plot_incoming_delay_delta = true;
-    FLAG_plot_incoming_delay = true;
-    FLAG_plot_incoming_loss_rate = true;
-    FLAG_plot_incoming_bitrate = true;
-    FLAG_plot_incoming_stream_bitrate = true;
-    FLAG_plot_simulated_receiveside_bwe = true;
-  } else if (strcmp(FLAG_plot_profile, "default") == 0) {
-    // Do nothing.
-  } else {
-    rtc::Flag* plot_profile_flag = rtc::FlagList::Lookup("plot_profile");
-    RTC_CHECK(plot_profile_flag);
-    plot_profile_flag->Print(false);
-  }
-  // Parse the remaining flags. They are applied relative to the chosen profile.
-  rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true);
-
-  if (argc != 2 || FLAG_help) {
-    // Print usage information.
-    std::cout << usage;
-    if (FLAG_help)
-      rtc::FlagList::Print(nullptr, false);
-    return 0;
-  }
-
-  webrtc::test::SetExecutablePath(argv[0]);
-  webrtc::test::ValidateFieldTrialsStringOrDie(FLAG_force_fieldtrials);
-  // InitFieldTrialsFromString stores the char*, so the char array must outlive
-  // the application.
-  webrtc::field_trial::InitFieldTrialsFromString(FLAG_force_fieldtrials);
-
-  std::string filename = argv[1];
-
-  webrtc::ParsedRtcEventLogNew::UnconfiguredHeaderExtensions header_extensions =
-      webrtc::ParsedRtcEventLogNew::UnconfiguredHeaderExtensions::kDontParse;
-  if (FLAG_parse_unconfigured_header_extensions) {
-    header_extensions = webrtc::ParsedRtcEventLogNew::
-        UnconfiguredHeaderExtensions::kAttemptWebrtcDefaultConfig;
-  }
-  webrtc::ParsedRtcEventLogNew parsed_log(header_extensions);
+DEFINE_string(summary,
+              "",
+              "Instead of plotting, print the number of points and the min, "
+              "mean, max and last value of each plotted series, as \"csv\" "
+              "or \"json\" (one object per log and line). Several logs, or "
+              "directories of logs, can then be given and are processed in "
+              "parallel.");
+DEFINE_int(threads,
+           0,
+           "The number of logs to process in parallel with --summary. "
+           "Defaults to the number of cores.");
 
-  if (!parsed_log.ParseFile(filename)) {
-    std::cerr << "Could not parse the entire log file." << std::endl;
-    std::cerr << "Proceeding to analyze the first "
-              << parsed_log.GetNumberOfEvents() << " events in the file."
-              << std::endl;
-  }
+void SetAllPlotFlags(bool setting);
 
-  webrtc::EventLogAnalyzer analyzer(parsed_log, FLAG_normalize_time);
-  std::unique_ptr<webrtc::PlotCollection> collection(
-      new webrtc::PythonPlotCollection());
+namespace {
 
+void CreatePlots(webrtc::EventLogAnalyzer* analyzer,
+                 webrtc::PlotCollection* collection) {
   if (FLAG_plot_incoming_packet_sizes) {
-    analyzer.CreatePacketGraph(webrtc::kIncomingPacket,
-                               collection->AppendNewPlot());
+    analyzer->CreatePacketGraph(webrtc::kIncomingPacket,
+                                collection->AppendNewPlot());
   }
   if (FLAG_plot_outgoing_packet_sizes) {
-    analyzer.CreatePacketGraph(webrtc::kOutgoingPacket,
-                               collection->AppendNewPlot());
+    analyzer->CreatePacketGraph(webrtc::kOutgoingPacket,
+                                collection->AppendNewPlot());
   }
   if (FLAG_plot_incoming_packet_count) {
-    analyzer.CreateAccumulatedPacketsGraph(webrtc::kIncomingPacket,
-                                           collection->AppendNewPlot());
+    analyzer->CreateAccumulatedPacketsGraph(webrtc::kIncomingPacket,
+                                            collection->AppendNewPlot());
   }
   if (FLAG_plot_outgoing_packet_count) {
-    analyzer.CreateAccumulatedPacketsGraph(webrtc::kOutgoingPacket,
-                                           collection->AppendNewPlot());
+    analyzer->CreateAccumulatedPacketsGraph(webrtc::kOutgoingPacket,
+                                            collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_playout) {
-    analyzer.CreatePlayoutGraph(collection->AppendNewPlot());
+    analyzer->CreatePlayoutGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_level) {
-    analyzer.CreateAudioLevelGraph(webrtc::kIncomingPacket,
-                                   collection->AppendNewPlot());
-    analyzer.CreateAudioLevelGraph(webrtc::kOutgoingPacket,
-                                   collection->AppendNewPlot());
+    analyzer->CreateAudioLevelGraph(webrtc::kIncomingPacket,
+                                    collection->AppendNewPlot());
+    analyzer->CreateAudioLevelGraph(webrtc::kOutgoingPacket,
+                                    collection->AppendNewPlot());
   }
   if (FLAG_plot_incoming_sequence_number_delta) {
-    analyzer.CreateSequenceNumberGraph(collection->AppendNewPlot());
+    analyzer->CreateSequenceNumberGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_incoming_delay_delta) {
-    analyzer.CreateIncomingDelayDeltaGraph(collection->AppendNewPlot());
+    analyzer->CreateIncomingDelayDeltaGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_incoming_delay) {
-    analyzer.CreateIncomingDelayGraph(collection->AppendNewPlot());
+    analyzer->CreateIncomingDelayGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_incoming_loss_rate) {
-    analyzer.CreateIncomingPacketLossGraph(collection->AppendNewPlot());
+    analyzer->CreateIncomingPacketLossGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_incoming_bitrate) {
-    analyzer.CreateTotalIncomingBitrateGraph(collection->AppendNewPlot());
+    analyzer->CreateTotalIncomingBitrateGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_outgoing_bitrate) {
-    analyzer.CreateTotalOutgoingBitrateGraph(collection->AppendNewPlot(),
-                                             FLAG_show_detector_state,
-                                             FLAG_show_alr_state);
+    analyzer->CreateTotalOutgoingBitrateGraph(collection->AppendNewPlot(),
+                                              FLAG_show_detector_state,
+                                              FLAG_show_alr_state);
   }
   if (FLAG_plot_incoming_stream_bitrate) {
-    analyzer.CreateStreamBitrateGraph(webrtc::kIncomingPacket,
-                                      collection->AppendNewPlot());
+    analyzer->CreateStreamBitrateGraph(webrtc::kIncomingPacket,
+                                       collection->AppendNewPlot());
   }
   if (FLAG_plot_outgoing_stream_bitrate) {
-    analyzer.CreateStreamBitrateGraph(webrtc::kOutgoingPacket,
-                                      collection->AppendNewPlot());
+    analyzer->CreateStreamBitrateGraph(webrtc::kOutgoingPacket,
+                                       collection->AppendNewPlot());
   }
   if (FLAG_plot_simulated_receiveside_bwe) {
-    analyzer.CreateReceiveSideBweSimulationGraph(collection->AppendNewPlot());
+    analyzer->CreateReceiveSideBweSimulationGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_simulated_sendside_bwe) {
-    analyzer.CreateSendSideBweSimulationGraph(collection->AppendNewPlot());
+    analyzer->CreateSendSideBweSimulationGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_network_delay_feedback) {
-    analyzer.CreateNetworkDelayFeedbackGraph(collection->AppendNewPlot());
+    analyzer->CreateNetworkDelayFeedbackGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_fraction_loss_feedback) {
-    analyzer.CreateFractionLossGraph(collection->AppendNewPlot());
+    analyzer->CreateFractionLossGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_timestamps) {
-    analyzer.CreateTimestampGraph(webrtc::kIncomingPacket,
-                                  collection->AppendNewPlot());
-    analyzer.CreateTimestampGraph(webrtc::kOutgoingPacket,
-                                  collection->AppendNewPlot());
+    analyzer->CreateTimestampGraph(webrtc::kIncomingPacket,
+                                   collection->AppendNewPlot());
+    analyzer->CreateTimestampGraph(webrtc::kOutgoingPacket,
+                                   collection->AppendNewPlot());
   }
   if (FLAG_plot_rtcp_details) {
     auto GetFractionLost = [](const webrtc::rtcp::ReportBlock& block) -> float {
       return static_cast<double>(block.fraction_lost()) / 256 * 100;
     };
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, GetFractionLost,
         "Fraction lost (incoming RTCP)", "Loss rate (percent)",
         collection->AppendNewPlot());
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, GetFractionLost,
         "Fraction lost (outgoing RTCP)", "Loss rate (percent)",
         collection->AppendNewPlot());
@@ -328,11 +278,11 @@ int main(int argc, char* argv[]) {
         [](const webrtc::rtcp::ReportBlock& block) -> float {
       return block.cumulative_lost_signed();
     };
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, GetCumulativeLost,
         "Cumulative lost packets (incoming RTCP)", "Packets",
         collection->AppendNewPlot());
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, GetCumulativeLost,
         "Cumulative lost packets (outgoing RTCP)", "Packets",
         collection->AppendNewPlot());
@@ -341,11 +291,11 @@ int main(int argc, char* argv[]) {
         [](const webrtc::rtcp::ReportBlock& block) -> float {
       return block.extended_high_seq_num();
     };
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, GetHighestSeqNumber,
         "Highest sequence number (incoming RTCP)", "Seqence number",
         collection->AppendNewPlot());
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, GetHighestSeqNumber,
         "Highest sequence number (outgoing RTCP)", "Seqence number",
         collection->AppendNewPlot());
@@ -354,36 +304,36 @@ int main(int argc, char* argv[]) {
         [](const webrtc::rtcp::ReportBlock& block) -> float {
       return static_cast<double>(block.delay_since_last_sr()) / 65536;
     };
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, DelaySinceLastSr,
         "Delay since last received sender report (incoming RTCP)", "Time (s)",
         collection->AppendNewPlot());
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, DelaySinceLastSr,
         "Delay since last received sender report (outgoing RTCP)", "Time (s)",
         collection->AppendNewPlot());
   }
 
   if (FLAG_plot_pacer_delay) {
-    analyzer.CreatePacerDelayGraph(collection->AppendNewPlot());
+    analyzer->CreatePacerDelayGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_encoder_bitrate_bps) {
-    analyzer.CreateAudioEncoderTargetBitrateGraph(collection->AppendNewPlot());
+    analyzer->CreateAudioEncoderTargetBitrateGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_encoder_frame_length_ms) {
-    analyzer.CreateAudioEncoderFrameLengthGraph(collection->AppendNewPlot());
+    analyzer->CreateAudioEncoderFrameLengthGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_encoder_packet_loss) {
-    analyzer.CreateAudioEncoderPacketLossGraph(collection->AppendNewPlot());
+    analyzer->CreateAudioEncoderPacketLossGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_encoder_fec) {
-    analyzer.CreateAudioEncoderEnableFecGraph(collection->AppendNewPlot());
+    analyzer->CreateAudioEncoderEnableFecGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_encoder_dtx) {
-    analyzer.CreateAudioEncoderEnableDtxGraph(collection->AppendNewPlot());
+    analyzer->CreateAudioEncoderEnableDtxGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_audio_encoder_num_channels) {
-    analyzer.CreateAudioEncoderNumChannelsGraph(collection->AppendNewPlot());
+    analyzer->CreateAudioEncoderNumChannelsGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_neteq_stats) {
     std::string wav_path;
@@ -393,38 +343,38 @@ int main(int argc, char* argv[]) {
       wav_path = webrtc::test::ResourcePath(
           "audio_processing/conversational_speech/EN_script2_F_sp2_B1", "wav");
     }
-    auto neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
+    auto neteq_stats = analyzer->SimulateNetEq(wav_path, 48000);
     for (webrtc::EventLogAnalyzer::NetEqStatsGetterMap::const_iterator it =
              neteq_stats.cbegin();
          it != neteq_stats.cend(); ++it) {
-      analyzer.CreateAudioJitterBufferGraph(it->first, it->second.get(),
-                                            collection->AppendNewPlot());
+      analyzer->CreateAudioJitterBufferGraph(it->first, it->second.get(),
+                                             collection->AppendNewPlot());
     }
-    analyzer.CreateNetEqNetworkStatsGraph(
+    analyzer->CreateNetEqNetworkStatsGraph(
         neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.expand_rate / 16384.f;
         },
         "Expand rate", collection->AppendNewPlot());
-    analyzer.CreateNetEqNetworkStatsGraph(
+    analyzer->CreateNetEqNetworkStatsGraph(
         neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.speech_expand_rate / 16384.f;
         },
         "Speech expand rate", collection->AppendNewPlot());
-    analyzer.CreateNetEqNetworkStatsGraph(
+    analyzer->CreateNetEqNetworkStatsGraph(
         neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.accelerate_rate / 16384.f;
         },
         "Accelerate rate", collection->AppendNewPlot());
-    analyzer.CreateNetEqNetworkStatsGraph(
+    analyzer->CreateNetEqNetworkStatsGraph(
         neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.packet_loss_rate / 16384.f;
         },
         "Packet loss rate", collection->AppendNewPlot());
-    analyzer.CreateNetEqLifetimeStatsGraph(
+    analyzer->CreateNetEqLifetimeStatsGraph(
         neteq_stats,
         [](const webrtc::NetEqLifetimeStatistics& stats) {
           return static_cast<float>(stats.concealment_events);
@@ -433,12 +383,185 @@ int main(int argc, char* argv[]) {
   }
 
   if (FLAG_plot_ice_candidate_pair_config) {
-    analyzer.CreateIceCandidatePairConfigGraph(collection->AppendNewPlot());
+    analyzer->CreateIceCandidatePairConfigGraph(collection->AppendNewPlot());
   }
   if (FLAG_plot_ice_connectivity_check) {
-    analyzer.CreateIceConnectivityCheckGraph(collection->AppendNewPlot());
+    analyzer->CreateIceConnectivityCheckGraph(collection->AppendNewPlot());
+  }
+
+}
+
+struct SummaryJob {
+  webrtc::SummaryPlot::Format format;
+  webrtc::ParsedRtcEventLogNew::UnconfiguredHeaderExtensions header_extensions;
+  std::vector<std::string> filenames;
+  std::vector<std::string> summaries;
+  std::atomic<size_t> next_index{0};
+};
+
+std::string SummarizeLog(const SummaryJob& job, const std::string& filename) {
+  webrtc::ParsedRtcEventLogNew parsed_log(job.header_extensions);
+  parsed_log.set_store_raw_events(false);
+  if (!parsed_log.ParseFile(filename)) {
+    std::cerr << "Could not parse the entire log file " << filename
+              << ", summarizing the events before the error." << std::endl;
+  }
+  webrtc::EventLogAnalyzer analyzer(parsed_log, FLAG_normalize_time);
+  webrtc::SummaryPlotCollection collection(job.format, filename);
+  CreatePlots(&analyzer, &collection);
+  return collection.ExportSummary();
+}
+
+// The logs are handed out one at a time, since they can differ a lot in size.
+void RunSummaryWorker(void* obj) {
+  SummaryJob* job = static_cast<SummaryJob*>(obj);
+  for (size_t i = job->next_index++; i < job->filenames.size();
+       i = job->next_index++) {
+    job->summaries[i] = SummarizeLog(*job, job->filenames[i]);
+  }
+}
+
+int PrintSummaries(
+    int argc,
+    char* argv[],
+    webrtc::ParsedRtcEventLogNew::UnconfiguredHeaderExtensions
+        header_extensions) {
+  SummaryJob job;
+  job.header_extensions = header_extensions;
+  if (strcmp(FLAG_summary, "csv") == 0) {
+    job.format = webrtc::SummaryPlot::Format::kCsv;
+  } else if (strcmp(FLAG_summary, "json") == 0) {
+    job.format = webrtc::SummaryPlot::Format::kJson;
+  } else {
+    std::cerr << "Unknown summary format " << FLAG_summary << std::endl;
+    return 1;
   }
 
+  for (int i = 1; i < argc; ++i) {
+    if (!webrtc::test::DirExists(argv[i])) {
+      job.filenames.push_back(argv[i]);
+      continue;
+    }
+    auto entries = webrtc::test::ReadDirectory(argv[i]);
+    if (!entries) {
+      std::cerr << "Could not read the directory " << argv[i] << std::endl;
+      return 1;
+    }
+    std::sort(entries->begin(), entries->end());
+    for (const std::string& entry : *entries) {
+      if (!webrtc::test::DirExists(entry))
+        job.filenames.push_back(entry);
+    }
+  }
+  job.summaries.resize(job.filenames.size());
+
+  size_t num_threads = FLAG_threads > 0
+                           ? FLAG_threads
+                           : webrtc::CpuInfo::DetectNumberOfCores();
+  num_threads = std::max<size_t>(
+      1, std::min<size_t>(num_threads, job.filenames.size()));
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers;
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.push_back(absl::make_unique<rtc::PlatformThread>(
+        &RunSummaryWorker, &job, "summary_worker"));
+    workers.back()->Start();
+  }
+  for (auto& worker : workers)
+    worker->Stop();
+
+  if (job.format == webrtc::SummaryPlot::Format::kCsv)
+    std::cout << webrtc::SummaryPlotCollection::kCsvHeader;
+  for (const std::string& summary : job.summaries)
+    std::cout << summary;
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage =
+      "A tool for visualizing WebRTC event logs.\n"
+      "Example usage:\n" +
+      program_name + " <logfile> | python\n" + program_name +
+      " --summary=csv <logfile or directory>... > summary.csv\n" + "Run " +
+      program_name + " --help for a list of command line options\n";
+
+  // Parse command line flags without removing them. We're only interested in
+  // the |plot_profile| flag.
+  rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, false);
+  if (strcmp(FLAG_plot_profile, "all") == 0) {
+    SetAllPlotFlags(true);
+  } else if (strcmp(FLAG_plot_profile, "none") == 0) {
+    SetAllPlotFlags(false);
+  } else if (strcmp(FLAG_plot_profile, "sendside_bwe") == 0) {
+    SetAllPlotFlags(false);
+    FLAG_plot_outgoing_packet_sizes = true;
+    FLAG_plot_outgoing_bitrate = true;
+    FLAG_plot_outgoing_stream_bitrate = true;
+    FLAG_plot_simulated_sendside_bwe = true;
+    FLAG_plot_network_delay_feedback = true;
+    FLAG_plot_fraction_loss_feedback = true;
+  } else if (strcmp(FLAG_plot_profile, "receiveside_bwe") == 0) {
+    SetAllPlotFlags(false);
+    FLAG_plot_incoming_packet_sizes = true;
+    FLAG_plot_incoming_delay_delta = true;
+    FLAG_plot_incoming_delay = true;
+    FLAG_plot_incoming_loss_rate = true;
+    FLAG_plot_incoming_bitrate = true;
+    FLAG_plot_incoming_stream_bitrate = true;
+    FLAG_plot_simulated_receiveside_bwe = true;
+  } else if (strcmp(FLAG_plot_profile, "default") == 0) {
+    // Do nothing.
+  } else {
+    rtc::Flag* plot_profile_flag = rtc::FlagList::Lookup("plot_profile");
+    RTC_CHECK(plot_profile_flag);
+    plot_profile_flag->Print(false);
+  }
+  // Parse the remaining flags. They are applied relative to the chosen profile.
+  rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true);
+
+  const bool summary = FLAG_summary[0] != '\0';
+  if ((summary ? argc < 2 : argc != 2) || FLAG_help) {
+    // Print usage information.
+    std::cout << usage;
+    if (FLAG_help)
+      rtc::FlagList::Print(nullptr, false);
+    return 0;
+  }
+
+  webrtc::test::SetExecutablePath(argv[0]);
+  webrtc::test::ValidateFieldTrialsStringOrDie(FLAG_force_fieldtrials);
+  // InitFieldTrialsFromString stores the char*, so the char array must outlive
+  // the application.
+  webrtc::field_trial::InitFieldTrialsFromString(FLAG_force_fieldtrials);
+
+  webrtc::ParsedRtcEventLogNew::UnconfiguredHeaderExtensions header_extensions =
+      webrtc::ParsedRtcEventLogNew::UnconfiguredHeaderExtensions::kDontParse;
+  if (FLAG_parse_unconfigured_header_extensions) {
+    header_extensions = webrtc::ParsedRtcEventLogNew::
+        UnconfiguredHeaderExtensions::kAttemptWebrtcDefaultConfig;
+  }
+  if (summary)
+    return PrintSummaries(argc, argv, header_extensions);
+
+  std::string filename = argv[1];
+  webrtc::ParsedRtcEventLogNew parsed_log(header_extensions);
+  // The analyzer only uses the typed accessors.
+  parsed_log.set_store_raw_events(false);
+
+  if (!parsed_log.ParseFile(filename)) {
+    std::cerr << "Could not parse the entire log file." << std::endl;
+    std::cerr << "Proceeding to analyze the events before the error."
+              << std::endl;
+  }
+
+  webrtc::EventLogAnalyzer analyzer(parsed_log, FLAG_normalize_time);
+  std::unique_ptr<webrtc::PlotCollection> collection(
+      new webrtc::PythonPlotCollection());
+
+  CreatePlots(&analyzer, collection.get());
+
   collection->Draw();
 
   if (FLAG_print_triage_alerts) {
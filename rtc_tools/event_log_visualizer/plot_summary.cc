@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/event_log_visualizer/plot_summary.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace webrtc {
+
+namespace {
+
+std::string CsvField(const std::string& value) {
+  if (value.find_first_of(",\"\n") == std::string::npos)
+    return value;
+  std::string escaped = "\"";
+  for (char c : value) {
+    if (c == '"')
+      escaped += '"';
+    escaped += c;
+  }
+  return escaped + "\"";
+}
+
+std::string JsonString(const std::string& value) {
+  std::string escaped = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      escaped += buffer;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped + "\"";
+}
+
+// Formats |value| like printf's %G, which is valid JSON as long as the value
+// is finite.
+std::string Number(double value, SummaryPlot::Format format) {
+  if (!std::isfinite(value) && format == SummaryPlot::Format::kJson)
+    return "null";
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%G", value);
+  return buffer;
+}
+
+struct SeriesSummary {
+  size_t points = 0;
+  double min = 0;
+  double mean = 0;
+  double max = 0;
+  double last = 0;
+};
+
+SeriesSummary Summarize(const TimeSeries& series) {
+  SeriesSummary summary;
+  if (series.points.empty())
+    return summary;
+  summary.points = series.points.size();
+  summary.min = summary.max = series.points[0].y;
+  double sum = 0;
+  for (const TimeSeriesPoint& point : series.points) {
+    summary.min = std::min<double>(summary.min, point.y);
+    summary.max = std::max<double>(summary.max, point.y);
+    sum += point.y;
+  }
+  summary.mean = sum / series.points.size();
+  summary.last = series.points.back().y;
+  return summary;
+}
+
+}  // namespace
+
+SummaryPlot::SummaryPlot() {}
+
+SummaryPlot::~SummaryPlot() {}
+
+void SummaryPlot::Draw() {}
+
+void SummaryPlot::ExportSummary(Format format,
+                                const std::string& log_name,
+                                std::string* output) const {
+  if (format == Format::kJson) {
+    *output += "{\"title\":" + JsonString(title_) + ",\"series\":[";
+  }
+  for (size_t i = 0; i < series_list_.size(); ++i) {
+    const SeriesSummary summary = Summarize(series_list_[i]);
+    const std::string points = std::to_string(summary.points);
+    const std::string min = Number(summary.min, format);
+    const std::string mean = Number(summary.mean, format);
+    const std::string max = Number(summary.max, format);
+    const std::string last = Number(summary.last, format);
+    if (format == Format::kCsv) {
+      *output += CsvField(log_name) + "," + CsvField(title_) + "," +
+                 CsvField(series_list_[i].label) + "," + points + "," + min +
+                 "," + mean + "," + max + "," + last + "\n";
+    } else {
+      *output += std::string(i ? "," : "") +
+                 "{\"label\":" + JsonString(series_list_[i].label) +
+                 ",\"points\":" + points + ",\"min\":" + min +
+                 ",\"mean\":" + mean + ",\"max\":" + max +
+                 ",\"last\":" + last + "}";
+    }
+  }
+  if (format == Format::kJson)
+    *output += "]}";
+}
+
+const char SummaryPlotCollection::kCsvHeader[] =
+    "log,plot,series,points,min,mean,max,last\n";
+
+SummaryPlotCollection::SummaryPlotCollection(SummaryPlot::Format format,
+                                             std::string log_name)
+    : format_(format), log_name_(std::move(log_name)) {}
+
+SummaryPlotCollection::~SummaryPlotCollection() {}
+
+void SummaryPlotCollection::Draw() {}
+
+Plot* SummaryPlotCollection::AppendNewPlot() {
+  Plot* plot = new SummaryPlot();
+  plots_.push_back(std::unique_ptr<Plot>(plot));
+  return plot;
+}
+
+std::string SummaryPlotCollection::ExportSummary() const {
+  std::string output;
+  if (format_ == SummaryPlot::Format::kJson)
+    output += "{\"log\":" + JsonString(log_name_) + ",\"plots\":[";
+  for (size_t i = 0; i < plots_.size(); ++i) {
+    if (format_ == SummaryPlot::Format::kJson && i > 0)
+      output += ",";
+    // Only SummaryPlots are inserted by AppendNewPlot.
+    static_cast<const SummaryPlot*>(plots_[i].get())
+        ->ExportSummary(format_, log_name_, &output);
+  }
+  if (format_ == SummaryPlot::Format::kJson)
+    output += "]}\n";
+  return output;
+}
+
+}  // namespace webrtc
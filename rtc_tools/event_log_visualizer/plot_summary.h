@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef RTC_TOOLS_EVENT_LOG_VISUALIZER_PLOT_SUMMARY_H_
+#define RTC_TOOLS_EVENT_LOG_VISUALIZER_PLOT_SUMMARY_H_
+
+#include <string>
+
+#include "rtc_tools/event_log_visualizer/plot_base.h"
+
+namespace webrtc {
+
+// Summarizes each time series of a plot by the number of points and the
+// minimum, mean, maximum and last y-value, instead of drawing it. Meant for
+// processing many logs without looking at the plots.
+class SummaryPlot final : public Plot {
+ public:
+  enum class Format {
+    // One line per time series: log,plot,series,points,min,mean,max,last.
+    kCsv,
+    // One JSON object per log, on a single line.
+    kJson
+  };
+
+  SummaryPlot();
+  ~SummaryPlot() override;
+  void Draw() override;
+  void ExportSummary(Format format,
+                     const std::string& log_name,
+                     std::string* output) const;
+};
+
+class SummaryPlotCollection final : public PlotCollection {
+ public:
+  SummaryPlotCollection(SummaryPlot::Format format, std::string log_name);
+  ~SummaryPlotCollection() override;
+  void Draw() override;
+  Plot* AppendNewPlot() override;
+  // Returns the summary of all the plots.
+  std::string ExportSummary() const;
+
+  // The header line of the CSV format.
+  static const char kCsvHeader[];
+
+ private:
+  const SummaryPlot::Format format_;
+  const std::string log_name_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_EVENT_LOG_VISUALIZER_PLOT_SUMMARY_H_
@@ -14,10 +14,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "test/testsupport/perf_test.h"
 
 #define STATS_LINE_LENGTH 32
@@ -28,6 +32,55 @@
 namespace webrtc {
 namespace test {
 
+namespace {
+struct FrameMatchJob {
+  const char* reference_file_name;
+  const char* test_file_name;
+  bool y4m_mode;
+  int width;
+  int height;
+  const std::vector<FrameMatch>* matches;
+  std::vector<AnalysisResult> results;
+  // Not std::vector<bool>, which can't be written from several threads.
+  std::unique_ptr<bool[]> frames_read;
+  std::atomic<size_t> next_index{0};
+};
+
+// The matches are handed out one at a time, so that slow reads don't hold up
+// the other threads.
+void RunFrameMatchWorker(void* obj) {
+  FrameMatchJob* job = static_cast<FrameMatchJob*>(obj);
+  const int size = GetI420FrameSize(job->width, job->height);
+  std::unique_ptr<uint8_t[]> test_frame(new uint8_t[size]);
+  std::unique_ptr<uint8_t[]> reference_frame(new uint8_t[size]);
+  for (size_t i = job->next_index++; i < job->matches->size();
+       i = job->next_index++) {
+    const FrameMatch& match = (*job->matches)[i];
+    bool read_result = ExtractFrameFromYuvFile(
+        job->test_file_name, job->width, job->height, match.test_frame,
+        test_frame.get());
+    read_result &=
+        job->y4m_mode
+            ? ExtractFrameFromY4mFile(job->reference_file_name, job->width,
+                                      job->height, match.reference_frame,
+                                      reference_frame.get())
+            : ExtractFrameFromYuvFile(job->reference_file_name, job->width,
+                                      job->height, match.reference_frame,
+                                      reference_frame.get());
+    if (!read_result)
+      continue;
+
+    job->results[i] = AnalysisResult(
+        match.frame_number,
+        CalculateMetrics(kPSNR, reference_frame.get(), test_frame.get(),
+                         job->width, job->height),
+        CalculateMetrics(kSSIM, reference_frame.get(), test_frame.get(),
+                         job->width, job->height));
+    job->frames_read[i] = true;
+  }
+}
+}  // namespace
+
 ResultsContainer::ResultsContainer() {}
 ResultsContainer::~ResultsContainer() {}
 
@@ -112,9 +165,13 @@ bool ExtractFrameFromYuvFile(const char* i420_file_name,
   fseek(input_file, offset, SEEK_SET);
 
   size_t bytes_read = fread(result_frame, 1, frame_size, input_file);
-  if (bytes_read != static_cast<size_t>(frame_size) && ferror(input_file)) {
-    fprintf(stdout, "Error while reading frame no %d from file %s\n",
-            frame_number, i420_file_name);
+  if (bytes_read != static_cast<size_t>(frame_size)) {
+    // A short read without an error means the frame is past the end of the
+    // file.
+    if (ferror(input_file)) {
+      fprintf(stdout, "Error while reading frame no %d from file %s\n",
+              frame_number, i420_file_name);
+    }
     errors = true;
   }
   fclose(input_file);
@@ -178,6 +235,45 @@ bool ExtractFrameFromY4mFile(const char* y4m_file_name,
   return true;
 }
 
+void AnalyzeFrameMatches(const char* reference_file_name,
+                         const char* test_file_name,
+                         int width,
+                         int height,
+                         const std::vector<FrameMatch>& matches,
+                         size_t num_threads,
+                         std::vector<AnalysisResult>* results) {
+  if (matches.empty())
+    return;
+
+  FrameMatchJob job;
+  job.reference_file_name = reference_file_name;
+  job.test_file_name = test_file_name;
+  job.y4m_mode =
+      std::string(reference_file_name).find("y4m") != std::string::npos;
+  job.width = width;
+  job.height = height;
+  job.matches = &matches;
+  job.results.resize(matches.size());
+  job.frames_read.reset(new bool[matches.size()]());
+
+  if (num_threads == 0)
+    num_threads = CpuInfo::DetectNumberOfCores();
+  num_threads = std::max<size_t>(1, std::min(num_threads, matches.size()));
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers;
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back(new rtc::PlatformThread(&RunFrameMatchWorker, &job,
+                                                 "frame_match_worker"));
+    workers.back()->Start();
+  }
+  for (auto& worker : workers)
+    worker->Stop();
+
+  for (size_t i = 0; i < matches.size(); ++i) {
+    if (job.frames_read[i])
+      results->push_back(job.results[i]);
+  }
+}
+
 double CalculateMetrics(VideoAnalysisMetricsType video_metrics_type,
                         const uint8_t* ref_frame,
                         const uint8_t* test_frame,
@@ -230,22 +326,12 @@ void RunAnalysis(const char* reference_file_name,
                  int width,
                  int height,
                  ResultsContainer* results) {
-  // Check if the reference_file_name ends with "y4m".
-  bool y4m_mode = false;
-  if (std::string(reference_file_name).find("y4m") != std::string::npos) {
-    y4m_mode = true;
-  }
-
-  int size = GetI420FrameSize(width, height);
   FILE* stats_file_ref = fopen(stats_file_reference_name, "r");
   FILE* stats_file_test = fopen(stats_file_test_name, "r");
 
   // String buffer for the lines in the stats file.
   char line[STATS_LINE_LENGTH];
 
-  // Allocate buffers for test and reference frames.
-  uint8_t* test_frame = new uint8_t[size];
-  uint8_t* reference_frame = new uint8_t[size];
   int previous_frame_number = -1;
 
   // Maps barcode id to the frame id for the reference video.
@@ -261,6 +347,7 @@ void RunAnalysis(const char* reference_file_name,
         std::make_pair(decoded_frame_number, extracted_ref_frame));
   }
 
+  std::vector<FrameMatch> matches;
   while (GetNextStatsLine(stats_file_test, line)) {
     int extracted_test_frame = ExtractFrameSequenceNumber(line);
     int decoded_frame_number = ExtractDecodedFrameNumber(line);
@@ -282,38 +369,18 @@ void RunAnalysis(const char* reference_file_name,
     assert(extracted_test_frame != -1);
     assert(decoded_frame_number != -1);
 
-    ExtractFrameFromYuvFile(test_file_name, width, height, extracted_test_frame,
-                            test_frame);
-    if (y4m_mode) {
-      ExtractFrameFromY4mFile(reference_file_name, width, height,
-                              extracted_ref_frame, reference_frame);
-    } else {
-      ExtractFrameFromYuvFile(reference_file_name, width, height,
-                              extracted_ref_frame, reference_frame);
-    }
-
-    // Calculate the PSNR and SSIM.
-    double result_psnr =
-        CalculateMetrics(kPSNR, reference_frame, test_frame, width, height);
-    double result_ssim =
-        CalculateMetrics(kSSIM, reference_frame, test_frame, width, height);
-
     previous_frame_number = decoded_frame_number;
-
-    // Fill in the result struct.
-    AnalysisResult result;
-    result.frame_number = decoded_frame_number;
-    result.psnr_value = result_psnr;
-    result.ssim_value = result_ssim;
-
-    results->frames.push_back(result);
+    matches.push_back(
+        {extracted_ref_frame, extracted_test_frame, decoded_frame_number});
   }
 
   // Cleanup.
   fclose(stats_file_ref);
   fclose(stats_file_test);
-  delete[] test_frame;
-  delete[] reference_frame;
+
+  // Calculate the PSNR and SSIM.
+  AnalyzeFrameMatches(reference_file_name, test_file_name, width, height,
+                      matches, 0 /* num_threads */, &results->frames);
 }
 
 std::vector<std::pair<int, int> > CalculateFrameClusters(
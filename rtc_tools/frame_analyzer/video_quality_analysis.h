@@ -46,6 +46,15 @@ struct ResultsContainer {
 
 enum VideoAnalysisMetricsType { kPSNR, kSSIM };
 
+// A frame of the test video and the frame of the reference video it should be
+// compared with.
+struct FrameMatch {
+  int reference_frame;
+  int test_frame;
+  // Frame number reported in the AnalysisResult.
+  int frame_number;
+};
+
 // A function to run the PSNR and SSIM analysis on the test file. The test file
 // comprises the frames that were captured during the quality measurement test.
 // There may be missing or duplicate frames. Also the frames start at a random
@@ -69,6 +78,18 @@ void RunAnalysis(const char* reference_file_name,
                  int height,
                  ResultsContainer* results);
 
+// Computes PSNR and SSIM of each match on |num_threads| threads, or one thread
+// per core if |num_threads| is 0, and appends the results to |results| in the
+// order of |matches|. Matches whose frames can't be read are left out. The
+// reference file is read as Y4M if its name contains "y4m".
+void AnalyzeFrameMatches(const char* reference_file_name,
+                         const char* test_file_name,
+                         int width,
+                         int height,
+                         const std::vector<FrameMatch>& matches,
+                         size_t num_threads,
+                         std::vector<AnalysisResult>* results);
+
 // Compute PSNR or SSIM for an I420 frame (all planes). When we are calculating
 // PSNR values, the max return value (in the case where the test and reference
 // frames are exactly the same) will be 48. In the case of SSIM the max return
@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
 #include "test/gtest.h"
@@ -66,6 +67,40 @@ TEST_F(VideoQualityAnalysisTest, MatchExtractedY4mFrame) {
   delete[] expected_frame;
 }
 
+TEST_F(VideoQualityAnalysisTest, AnalyzeFrameMatchesKeepsOrder) {
+  const int kWidth = 16;
+  const int kHeight = 16;
+  const int kNumFrames = 3;
+  const int size = GetI420FrameSize(kWidth, kHeight);
+  std::string video_filename = TempFilename(OutputPath(), "frames.yuv");
+  FILE* video_file = fopen(video_filename.c_str(), "wb");
+  ASSERT_TRUE(video_file != NULL);
+  std::vector<uint8_t> frame(size);
+  for (int i = 0; i < kNumFrames; ++i) {
+    for (int j = 0; j < size; ++j)
+      frame[j] = static_cast<uint8_t>(i * 50 + j);
+    fwrite(frame.data(), 1, size, video_file);
+  }
+  fclose(video_file);
+
+  // The last match is past the end of the file.
+  std::vector<FrameMatch> matches = {
+      {0, 0, 10}, {2, 2, 12}, {1, 1, 11}, {5, 5, 15}};
+  std::vector<AnalysisResult> results;
+  AnalyzeFrameMatches(video_filename.c_str(), video_filename.c_str(), kWidth,
+                      kHeight, matches, 2, &results);
+  remove(video_filename.c_str());
+
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ(10, results[0].frame_number);
+  EXPECT_EQ(12, results[1].frame_number);
+  EXPECT_EQ(11, results[2].frame_number);
+  for (const AnalysisResult& result : results) {
+    EXPECT_EQ(48.0, result.psnr_value);
+    EXPECT_DOUBLE_EQ(1.0, result.ssim_value);
+  }
+}
+
 TEST_F(VideoQualityAnalysisTest, PrintAnalysisResultsEmpty) {
   ResultsContainer result;
   PrintAnalysisResults(logfile_, "Empty", &result);
@@ -0,0 +1,241 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/pc_load_tester/load_test_call.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "api/jsep.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
+#include "p2p/base/fakeportallocator.h"
+#include "pc/test/fakertccertificategenerator.h"
+#include "pc/test/mockpeerconnectionobservers.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// One side of the call. Sends its descriptions and candidates straight to the
+// other side, and measures the video it renders.
+class LoadTestCall::Peer : public PeerConnectionObserver,
+                           public CreateSessionDescriptionObserver,
+                           public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  Peer(const std::string& name, Clock* clock) : name_(name), clock_(clock) {}
+
+  bool Create(PeerConnectionFactoryInterface* factory,
+              rtc::Thread* network_thread) {
+    PeerConnectionInterface::RTCConfiguration config;
+    PeerConnectionDependencies dependencies(this);
+    dependencies.allocator =
+        absl::make_unique<cricket::FakePortAllocator>(network_thread, nullptr);
+    dependencies.cert_generator =
+        absl::make_unique<FakeRTCCertificateGenerator>();
+    peer_connection_ =
+        factory->CreatePeerConnection(config, std::move(dependencies));
+    return peer_connection_ != nullptr;
+  }
+
+  bool AddTracks(PeerConnectionFactoryInterface* factory,
+                 VideoTrackSourceInterface* video_source) {
+    rtc::scoped_refptr<AudioTrackInterface> audio_track =
+        factory->CreateAudioTrack(
+            name_ + "_audio",
+            factory->CreateAudioSource(cricket::AudioOptions()));
+    rtc::scoped_refptr<VideoTrackInterface> video_track =
+        factory->CreateVideoTrack(name_ + "_video", video_source);
+    return peer_connection_->AddTrack(audio_track, {name_}).ok() &&
+           peer_connection_->AddTrack(video_track, {name_}).ok();
+  }
+
+  void Close() {
+    if (remote_video_track_) {
+      remote_video_track_->RemoveSink(this);
+      remote_video_track_ = nullptr;
+    }
+    if (peer_connection_) {
+      peer_connection_->Close();
+      peer_connection_ = nullptr;
+    }
+    remote_ = nullptr;
+  }
+
+  void set_remote(Peer* remote) { remote_ = remote; }
+  PeerConnectionInterface* peer_connection() { return peer_connection_; }
+
+  void CreateOffer() {
+    peer_connection_->CreateOffer(
+        this, PeerConnectionInterface::RTCOfferAnswerOptions());
+  }
+
+  void ReceiveDescription(SdpType type, const std::string& sdp) {
+    SdpParseError error;
+    std::unique_ptr<SessionDescriptionInterface> description =
+        CreateSessionDescription(type, sdp, &error);
+    if (!description) {
+      RTC_LOG(LS_ERROR) << name_ << ": Failed to parse description: "
+                        << error.description;
+      return;
+    }
+    peer_connection_->SetRemoteDescription(
+        new rtc::RefCountedObject<MockSetSessionDescriptionObserver>(),
+        description.release());
+    if (type == SdpType::kOffer) {
+      peer_connection_->CreateAnswer(
+          this, PeerConnectionInterface::RTCOfferAnswerOptions());
+    }
+  }
+
+  absl::optional<int64_t> first_frame_time_ms() const {
+    rtc::CritScope lock(&lock_);
+    return first_frame_time_ms_;
+  }
+
+  void GetLatencies(std::map<int64_t, int64_t>* latency_histogram_ms) const {
+    rtc::CritScope lock(&lock_);
+    for (const auto& bin : latency_histogram_ms_)
+      (*latency_histogram_ms)[bin.first] += bin.second;
+  }
+
+  // Implements PeerConnectionObserver.
+  void OnSignalingChange(
+      PeerConnectionInterface::SignalingState new_state) override {}
+  void OnDataChannel(
+      rtc::scoped_refptr<DataChannelInterface> data_channel) override {}
+  void OnRenegotiationNeeded() override {}
+  void OnIceConnectionChange(
+      PeerConnectionInterface::IceConnectionState new_state) override {}
+  void OnIceGatheringChange(
+      PeerConnectionInterface::IceGatheringState new_state) override {}
+  void OnAddTrack(
+      rtc::scoped_refptr<RtpReceiverInterface> receiver,
+      const std::vector<rtc::scoped_refptr<MediaStreamInterface>>& streams)
+      override {
+    if (receiver->track()->kind() != MediaStreamTrackInterface::kVideoKind)
+      return;
+    remote_video_track_ =
+        static_cast<VideoTrackInterface*>(receiver->track().get());
+    remote_video_track_->AddOrUpdateSink(this, rtc::VideoSinkWants());
+  }
+  void OnIceCandidate(const IceCandidateInterface* candidate) override {
+    if (remote_ && !remote_->peer_connection()->AddIceCandidate(candidate))
+      RTC_LOG(LS_WARNING) << name_ << ": Failed to add candidate.";
+  }
+
+  // Implements CreateSessionDescriptionObserver.
+  void OnSuccess(SessionDescriptionInterface* desc) override {
+    std::string sdp;
+    desc->ToString(&sdp);
+    const SdpType type = desc->GetType();
+    peer_connection_->SetLocalDescription(
+        new rtc::RefCountedObject<MockSetSessionDescriptionObserver>(), desc);
+    if (remote_)
+      remote_->ReceiveDescription(type, sdp);
+  }
+  void OnFailure(RTCError error) override {
+    RTC_LOG(LS_ERROR) << name_ << ": Failed to create description: "
+                      << error.message();
+  }
+
+  // Implements rtc::VideoSinkInterface. Called on a decoder thread.
+  void OnFrame(const VideoFrame& frame) override {
+    rtc::CritScope lock(&lock_);
+    if (!first_frame_time_ms_)
+      first_frame_time_ms_ = rtc::TimeMillis();
+    // The capture time is estimated from the sender reports, so it is only
+    // known once the first one has arrived. Both sides use the same clock.
+    if (frame.ntp_time_ms() > 0) {
+      ++latency_histogram_ms_[clock_->CurrentNtpInMilliseconds() -
+                              frame.ntp_time_ms()];
+    }
+  }
+
+ private:
+  const std::string name_;
+  Clock* const clock_;
+  rtc::scoped_refptr<PeerConnectionInterface> peer_connection_;
+  rtc::scoped_refptr<VideoTrackInterface> remote_video_track_;
+  Peer* remote_ = nullptr;
+
+  rtc::CriticalSection lock_;
+  absl::optional<int64_t> first_frame_time_ms_ RTC_GUARDED_BY(lock_);
+  std::map<int64_t, int64_t> latency_histogram_ms_ RTC_GUARDED_BY(lock_);
+};
+
+constexpr int LoadTestCall::kNumStreams;
+
+LoadTestCall::LoadTestCall(
+    const std::string& name,
+    PeerConnectionFactoryInterface* factory,
+    rtc::Thread* network_thread,
+    rtc::scoped_refptr<VideoTrackSourceInterface> video_source,
+    Clock* clock)
+    : name_(name),
+      factory_(factory),
+      network_thread_(network_thread),
+      video_source_(std::move(video_source)),
+      clock_(clock) {}
+
+LoadTestCall::~LoadTestCall() {
+  Stop();
+}
+
+bool LoadTestCall::Start() {
+  RTC_DCHECK(!caller_);
+  start_time_ms_ = rtc::TimeMillis();
+  caller_ = new rtc::RefCountedObject<Peer>(name_ + "_caller", clock_);
+  callee_ = new rtc::RefCountedObject<Peer>(name_ + "_callee", clock_);
+  if (!caller_->Create(factory_, network_thread_) ||
+      !callee_->Create(factory_, network_thread_) ||
+      !caller_->AddTracks(factory_, video_source_) ||
+      !callee_->AddTracks(factory_, video_source_)) {
+    RTC_LOG(LS_ERROR) << name_ << ": Failed to create call.";
+    return false;
+  }
+  caller_->set_remote(callee_);
+  callee_->set_remote(caller_);
+  caller_->CreateOffer();
+  return true;
+}
+
+void LoadTestCall::Stop() {
+  if (caller_)
+    caller_->Close();
+  if (callee_)
+    callee_->Close();
+}
+
+absl::optional<int64_t> LoadTestCall::setup_time_ms() const {
+  if (!caller_ || !callee_)
+    return absl::nullopt;
+  const absl::optional<int64_t> caller_time_ms = caller_->first_frame_time_ms();
+  const absl::optional<int64_t> callee_time_ms = callee_->first_frame_time_ms();
+  if (!caller_time_ms || !callee_time_ms)
+    return absl::nullopt;
+  return std::max(*caller_time_ms, *callee_time_ms) - start_time_ms_;
+}
+
+void LoadTestCall::GetLatencies(
+    std::map<int64_t, int64_t>* latency_histogram_ms) const {
+  if (caller_)
+    caller_->GetLatencies(latency_histogram_ms);
+  if (callee_)
+    callee_->GetLatencies(latency_histogram_ms);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_PC_LOAD_TESTER_LOAD_TEST_CALL_H_
+#define RTC_TOOLS_PC_LOAD_TESTER_LOAD_TEST_CALL_H_
+
+#include <map>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "api/peerconnectioninterface.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+class Clock;
+
+// A call between two PeerConnections of the same process, which signal to
+// each other directly and connect over the loopback interface. Both sides send
+// audio from the factory's audio device and video from a shared source.
+//
+// All methods must be called on the signaling thread of |factory|.
+class LoadTestCall {
+ public:
+  LoadTestCall(const std::string& name,
+               PeerConnectionFactoryInterface* factory,
+               rtc::Thread* network_thread,
+               rtc::scoped_refptr<VideoTrackSourceInterface> video_source,
+               Clock* clock);
+  ~LoadTestCall();
+
+  // Creates both PeerConnections and starts the offer/answer exchange.
+  bool Start();
+  // Closes both PeerConnections. Results can still be read after it.
+  void Stop();
+
+  // Time from Start() until video was rendered on both sides, or nullopt if
+  // that has not happened yet.
+  absl::optional<int64_t> setup_time_ms() const;
+  // Adds the capture to render delay of every frame rendered on either side.
+  void GetLatencies(std::map<int64_t, int64_t>* latency_histogram_ms) const;
+
+  // Audio and video streams sent by the call.
+  static constexpr int kNumStreams = 4;
+
+ private:
+  class Peer;
+
+  const std::string name_;
+  PeerConnectionFactoryInterface* const factory_;
+  rtc::Thread* const network_thread_;
+  const rtc::scoped_refptr<VideoTrackSourceInterface> video_source_;
+  Clock* const clock_;
+  int64_t start_time_ms_ = -1;
+  rtc::scoped_refptr<Peer> caller_;
+  rtc::scoped_refptr<Peer> callee_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_PC_LOAD_TESTER_LOAD_TEST_CALL_H_
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/pc_load_tester/load_test_result.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/string_to_number.h"
+#include "rtc_base/stringencode.h"
+
+namespace webrtc {
+namespace {
+
+const double kReportedPercentiles[] = {0.5, 0.9, 0.99};
+
+// Returns the 0-based rank of the |fraction| percentile of |count| samples,
+// using the nearest rank method.
+int64_t PercentileRank(int64_t count, double fraction) {
+  RTC_DCHECK_GT(count, 0);
+  RTC_DCHECK_GE(fraction, 0.0);
+  RTC_DCHECK_LE(fraction, 1.0);
+  const int64_t rank = static_cast<int64_t>(std::ceil(fraction * count)) - 1;
+  return std::min(std::max<int64_t>(rank, 0), count - 1);
+}
+
+bool ParseNumber(const std::string& value, int64_t* number) {
+  absl::optional<int64_t> parsed = rtc::StringToNumber<int64_t>(value);
+  if (!parsed)
+    return false;
+  *number = *parsed;
+  return true;
+}
+
+// |Samples| is a vector of samples or a histogram.
+template <typename Samples>
+void FormatPercentiles(const char* name,
+                       const Samples& samples,
+                       std::ostringstream* oss) {
+  if (!GetPercentile(samples, 0.0)) {
+    *oss << name << ": no samples\n";
+    return;
+  }
+  *oss << name << ":";
+  for (double fraction : kReportedPercentiles) {
+    *oss << " p" << static_cast<int>(fraction * 100) << "="
+         << *GetPercentile(samples, fraction) << "ms";
+  }
+  *oss << " max=" << *GetPercentile(samples, 1.0) << "ms\n";
+}
+
+}  // namespace
+
+LoadTestResult::LoadTestResult() = default;
+LoadTestResult::LoadTestResult(const LoadTestResult&) = default;
+LoadTestResult::~LoadTestResult() = default;
+LoadTestResult& LoadTestResult::operator=(const LoadTestResult&) = default;
+
+void LoadTestResult::Merge(const LoadTestResult& other) {
+  call_setup_times_ms.insert(call_setup_times_ms.end(),
+                             other.call_setup_times_ms.begin(),
+                             other.call_setup_times_ms.end());
+  failed_calls += other.failed_calls;
+  for (const auto& bin : other.latency_histogram_ms)
+    latency_histogram_ms[bin.first] += bin.second;
+  num_streams += other.num_streams;
+  cpu_time_ns += other.cpu_time_ns;
+  // The processes measure at the same time.
+  measurement_time_ms =
+      std::max(measurement_time_ms, other.measurement_time_ms);
+}
+
+std::string SerializeLoadTestResult(const LoadTestResult& result) {
+  std::ostringstream oss;
+  oss << "setup=";
+  for (size_t i = 0; i < result.call_setup_times_ms.size(); ++i)
+    oss << (i ? "," : "") << result.call_setup_times_ms[i];
+  oss << " failed=" << result.failed_calls << " latency=";
+  bool first = true;
+  for (const auto& bin : result.latency_histogram_ms) {
+    oss << (first ? "" : ",") << bin.first << ":" << bin.second;
+    first = false;
+  }
+  oss << " streams=" << result.num_streams << " cpu=" << result.cpu_time_ns
+      << " time=" << result.measurement_time_ms;
+  return oss.str();
+}
+
+bool ParseLoadTestResult(const std::string& line, LoadTestResult* result) {
+  LoadTestResult parsed;
+  std::vector<std::string> fields;
+  rtc::tokenize(line, ' ', &fields);
+  for (const std::string& field : fields) {
+    const size_t equals = field.find('=');
+    if (equals == std::string::npos)
+      return false;
+    const std::string key = field.substr(0, equals);
+    const std::string value = field.substr(equals + 1);
+    std::vector<std::string> items;
+    if (!value.empty())
+      rtc::split(value, ',', &items);
+    int64_t number = 0;
+    if (key == "setup") {
+      for (const std::string& item : items) {
+        if (!ParseNumber(item, &number))
+          return false;
+        parsed.call_setup_times_ms.push_back(number);
+      }
+    } else if (key == "latency") {
+      for (const std::string& item : items) {
+        std::string latency;
+        std::string count;
+        int64_t latency_ms = 0;
+        int64_t num_samples = 0;
+        if (!rtc::tokenize_first(item, ':', &latency, &count) ||
+            !ParseNumber(latency, &latency_ms) ||
+            !ParseNumber(count, &num_samples)) {
+          return false;
+        }
+        parsed.latency_histogram_ms[latency_ms] += num_samples;
+      }
+    } else if (ParseNumber(value, &number)) {
+      if (key == "failed") {
+        parsed.failed_calls = static_cast<int>(number);
+      } else if (key == "streams") {
+        parsed.num_streams = static_cast<int>(number);
+      } else if (key == "cpu") {
+        parsed.cpu_time_ns = number;
+      } else if (key == "time") {
+        parsed.measurement_time_ms = number;
+      } else {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  *result = parsed;
+  return true;
+}
+
+absl::optional<int64_t> GetPercentile(const std::vector<int64_t>& samples,
+                                      double fraction) {
+  if (samples.empty())
+    return absl::nullopt;
+  std::vector<int64_t> sorted = samples;
+  const int64_t rank = PercentileRank(sorted.size(), fraction);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+  return sorted[rank];
+}
+
+absl::optional<int64_t> GetPercentile(
+    const std::map<int64_t, int64_t>& histogram,
+    double fraction) {
+  int64_t count = 0;
+  for (const auto& bin : histogram)
+    count += bin.second;
+  if (count == 0)
+    return absl::nullopt;
+  const int64_t rank = PercentileRank(count, fraction);
+  int64_t below = 0;
+  for (const auto& bin : histogram) {
+    below += bin.second;
+    if (below > rank)
+      return bin.first;
+  }
+  RTC_NOTREACHED();
+  return absl::nullopt;
+}
+
+std::string FormatLoadTestReport(const LoadTestResult& result) {
+  std::ostringstream oss;
+  oss << "Calls: " << result.call_setup_times_ms.size() << " set up, "
+      << result.failed_calls << " failed\n";
+
+  FormatPercentiles("Call setup time", result.call_setup_times_ms, &oss);
+  FormatPercentiles("End-to-end video latency", result.latency_histogram_ms,
+                    &oss);
+
+  if (result.num_streams > 0 && result.measurement_time_ms > 0) {
+    // Percent of one core.
+    const double cpu_percent = 100.0 * result.cpu_time_ns /
+                               (result.measurement_time_ms * 1000000.0);
+    oss << "CPU: " << cpu_percent << "% of a core for " << result.num_streams
+        << " streams, " << cpu_percent / result.num_streams
+        << "% per stream\n";
+  }
+  return oss.str();
+}
+
+}  // namespace webrtc
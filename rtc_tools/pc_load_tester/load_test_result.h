@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_PC_LOAD_TESTER_LOAD_TEST_RESULT_H_
+#define RTC_TOOLS_PC_LOAD_TESTER_LOAD_TEST_RESULT_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// What one load test process measured. Results of several processes are
+// merged into one before they are reported.
+struct LoadTestResult {
+  LoadTestResult();
+  LoadTestResult(const LoadTestResult&);
+  ~LoadTestResult();
+  LoadTestResult& operator=(const LoadTestResult&);
+
+  // Adds the samples and counters of |other| to this result.
+  void Merge(const LoadTestResult& other);
+
+  // Time from creating the offer until the first video frame was rendered on
+  // both sides, one sample per call.
+  std::vector<int64_t> call_setup_times_ms;
+  int failed_calls = 0;
+  // End-to-end video latency, from capture to render, as a histogram with
+  // 1 ms bins.
+  std::map<int64_t, int64_t> latency_histogram_ms;
+  // Sent audio and video streams that were running while the CPU time was
+  // measured.
+  int num_streams = 0;
+  int64_t cpu_time_ns = 0;
+  int64_t measurement_time_ms = 0;
+};
+
+// Writes |result| as a single line of text, so that worker processes can
+// pass it to the process that reports it.
+std::string SerializeLoadTestResult(const LoadTestResult& result);
+bool ParseLoadTestResult(const std::string& line, LoadTestResult* result);
+
+// Returns the value below which |fraction| of the samples are, where
+// |fraction| is between 0 and 1, or nullopt if there are no samples.
+absl::optional<int64_t> GetPercentile(const std::vector<int64_t>& samples,
+                                      double fraction);
+absl::optional<int64_t> GetPercentile(
+    const std::map<int64_t, int64_t>& histogram,
+    double fraction);
+
+// Returns a human readable report of |result|.
+std::string FormatLoadTestReport(const LoadTestResult& result);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_PC_LOAD_TESTER_LOAD_TEST_RESULT_H_
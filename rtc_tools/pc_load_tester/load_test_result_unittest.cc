@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/pc_load_tester/load_test_result.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(LoadTestResultTest, SerializesAndParses) {
+  LoadTestResult result;
+  result.call_setup_times_ms = {120, 80, 300};
+  result.failed_calls = 2;
+  result.latency_histogram_ms = {{40, 10}, {55, 3}};
+  result.num_streams = 12;
+  result.cpu_time_ns = 123456789;
+  result.measurement_time_ms = 30000;
+
+  LoadTestResult parsed;
+  ASSERT_TRUE(ParseLoadTestResult(SerializeLoadTestResult(result), &parsed));
+  EXPECT_EQ(result.call_setup_times_ms, parsed.call_setup_times_ms);
+  EXPECT_EQ(result.failed_calls, parsed.failed_calls);
+  EXPECT_EQ(result.latency_histogram_ms, parsed.latency_histogram_ms);
+  EXPECT_EQ(result.num_streams, parsed.num_streams);
+  EXPECT_EQ(result.cpu_time_ns, parsed.cpu_time_ns);
+  EXPECT_EQ(result.measurement_time_ms, parsed.measurement_time_ms);
+}
+
+TEST(LoadTestResultTest, SerializesAndParsesEmptyResult) {
+  LoadTestResult parsed;
+  parsed.failed_calls = 5;
+  ASSERT_TRUE(
+      ParseLoadTestResult(SerializeLoadTestResult(LoadTestResult()), &parsed));
+  EXPECT_TRUE(parsed.call_setup_times_ms.empty());
+  EXPECT_TRUE(parsed.latency_histogram_ms.empty());
+  EXPECT_EQ(0, parsed.failed_calls);
+}
+
+TEST(LoadTestResultTest, RejectsMalformedLine) {
+  LoadTestResult parsed;
+  EXPECT_FALSE(ParseLoadTestResult("setup=1,x", &parsed));
+  EXPECT_FALSE(ParseLoadTestResult("latency=5", &parsed));
+  EXPECT_FALSE(ParseLoadTestResult("unknown=5", &parsed));
+  EXPECT_FALSE(ParseLoadTestResult("failed", &parsed));
+}
+
+TEST(LoadTestResultTest, MergesResults) {
+  LoadTestResult result;
+  result.call_setup_times_ms = {100};
+  result.latency_histogram_ms = {{40, 1}};
+  result.num_streams = 4;
+  result.cpu_time_ns = 1000;
+  result.measurement_time_ms = 900;
+  LoadTestResult other;
+  other.call_setup_times_ms = {200};
+  other.failed_calls = 1;
+  other.latency_histogram_ms = {{40, 2}, {50, 1}};
+  other.num_streams = 4;
+  other.cpu_time_ns = 3000;
+  other.measurement_time_ms = 1000;
+
+  result.Merge(other);
+  EXPECT_EQ(std::vector<int64_t>({100, 200}), result.call_setup_times_ms);
+  EXPECT_EQ(1, result.failed_calls);
+  EXPECT_EQ((std::map<int64_t, int64_t>{{40, 3}, {50, 1}}),
+            result.latency_histogram_ms);
+  EXPECT_EQ(8, result.num_streams);
+  EXPECT_EQ(4000, result.cpu_time_ns);
+  EXPECT_EQ(1000, result.measurement_time_ms);
+}
+
+TEST(LoadTestResultTest, GetsPercentiles) {
+  EXPECT_FALSE(GetPercentile(std::vector<int64_t>(), 0.5));
+  EXPECT_FALSE(GetPercentile(std::map<int64_t, int64_t>(), 0.5));
+
+  const std::vector<int64_t> samples = {5, 1, 4, 2, 3, 10, 9, 8, 7, 6};
+  EXPECT_EQ(1, GetPercentile(samples, 0.0));
+  EXPECT_EQ(5, GetPercentile(samples, 0.5));
+  EXPECT_EQ(9, GetPercentile(samples, 0.9));
+  EXPECT_EQ(10, GetPercentile(samples, 0.99));
+  EXPECT_EQ(10, GetPercentile(samples, 1.0));
+
+  const std::map<int64_t, int64_t> histogram = {{10, 5}, {20, 4}, {30, 1}};
+  EXPECT_EQ(10, GetPercentile(histogram, 0.0));
+  EXPECT_EQ(10, GetPercentile(histogram, 0.5));
+  EXPECT_EQ(20, GetPercentile(histogram, 0.6));
+  EXPECT_EQ(20, GetPercentile(histogram, 0.9));
+  EXPECT_EQ(30, GetPercentile(histogram, 0.99));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,310 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#if defined(WEBRTC_POSIX)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/peerconnectioninterface.h"
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "pc/test/fakeaudiocapturemodule.h"
+#include "pc/test/framegeneratorcapturervideotracksource.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ssladapter.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/timeutils.h"
+#include "rtc_tools/pc_load_tester/load_test_call.h"
+#include "rtc_tools/pc_load_tester/load_test_result.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/sleep.h"
+
+DEFINE_int(calls, 10, "Number of calls to run, in all processes together.");
+DEFINE_int(processes,
+           1,
+           "Number of processes to run the calls in. Only supported on POSIX.");
+DEFINE_int(threads,
+           1,
+           "Number of thread groups per process. Each group has its own "
+           "PeerConnectionFactory with network, worker and signaling threads.");
+DEFINE_int(duration, 30, "Seconds to measure for once the calls are set up.");
+DEFINE_int(setup_timeout, 30, "Seconds to wait for the calls to be set up.");
+DEFINE_int(width, 320, "Width of the sent video.");
+DEFINE_int(height, 180, "Height of the sent video.");
+DEFINE_int(fps, 15, "Frame rate of the sent video.");
+DEFINE_bool(help, false, "Prints this message.");
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kPollIntervalMs = 100;
+
+// A PeerConnectionFactory and its threads, and the calls that run on them.
+class CallGroup {
+ public:
+  explicit CallGroup(int index)
+      : index_(index),
+        network_thread_(rtc::Thread::CreateWithSocketServer()),
+        worker_thread_(rtc::Thread::Create()),
+        signaling_thread_(rtc::Thread::Create()) {
+    network_thread_->SetName("network_thread", nullptr);
+    worker_thread_->SetName("worker_thread", nullptr);
+    signaling_thread_->SetName("signaling_thread", nullptr);
+    RTC_CHECK(network_thread_->Start());
+    RTC_CHECK(worker_thread_->Start());
+    RTC_CHECK(signaling_thread_->Start());
+  }
+
+  ~CallGroup() {
+    signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this] {
+      calls_.clear();
+      if (video_source_)
+        video_source_->Stop();
+      video_source_ = nullptr;
+      factory_ = nullptr;
+    });
+  }
+
+  // Returns the number of calls that started.
+  int StartCalls(int num_calls) {
+    return signaling_thread_->Invoke<int>(RTC_FROM_HERE, [this, num_calls] {
+      if (!CreateFactory())
+        return 0;
+      int started = 0;
+      for (int i = 0; i < num_calls; ++i) {
+        auto call = absl::make_unique<LoadTestCall>(
+            "call_" + std::to_string(index_) + "_" + std::to_string(i),
+            factory_, network_thread_.get(), video_source_,
+            Clock::GetRealTimeClock());
+        if (call->Start())
+          ++started;
+        calls_.push_back(std::move(call));
+      }
+      return started;
+    });
+  }
+
+  // Returns the number of calls that have been set up.
+  int NumCallsSetUp() {
+    return signaling_thread_->Invoke<int>(RTC_FROM_HERE, [this] {
+      int set_up = 0;
+      for (const auto& call : calls_)
+        set_up += call->setup_time_ms() ? 1 : 0;
+      return set_up;
+    });
+  }
+
+  void StopCalls(LoadTestResult* result) {
+    signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this, result] {
+      for (const auto& call : calls_) {
+        call->Stop();
+        const absl::optional<int64_t> setup_time_ms = call->setup_time_ms();
+        if (setup_time_ms)
+          result->call_setup_times_ms.push_back(*setup_time_ms);
+        call->GetLatencies(&result->latency_histogram_ms);
+      }
+    });
+  }
+
+ private:
+  bool CreateFactory() {
+    RTC_DCHECK(signaling_thread_->IsCurrent());
+    // One audio device per factory, like an application would have. It mixes
+    // the received audio of all calls and feeds them all the same capture.
+    rtc::scoped_refptr<FakeAudioCaptureModule> audio_device =
+        FakeAudioCaptureModule::Create();
+    if (!audio_device)
+      return false;
+    factory_ = CreatePeerConnectionFactory(
+        network_thread_.get(), worker_thread_.get(), signaling_thread_.get(),
+        audio_device, CreateBuiltinAudioEncoderFactory(),
+        CreateBuiltinAudioDecoderFactory(), CreateBuiltinVideoEncoderFactory(),
+        CreateBuiltinVideoDecoderFactory(), nullptr /* audio_mixer */,
+        nullptr /* audio_processing */);
+    if (!factory_)
+      return false;
+    // The calls share one capturer, so that the cost measured is the cost of
+    // encoding and sending rather than of generating frames.
+    FrameGeneratorCapturerVideoTrackSource::Config config;
+    config.width = FLAG_width;
+    config.height = FLAG_height;
+    config.frames_per_second = FLAG_fps;
+    video_source_ =
+        new rtc::RefCountedObject<FrameGeneratorCapturerVideoTrackSource>(
+            config, Clock::GetRealTimeClock());
+    video_source_->Start();
+    return true;
+  }
+
+  const int index_;
+  const std::unique_ptr<rtc::Thread> network_thread_;
+  const std::unique_ptr<rtc::Thread> worker_thread_;
+  const std::unique_ptr<rtc::Thread> signaling_thread_;
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> factory_;
+  rtc::scoped_refptr<FrameGeneratorCapturerVideoTrackSource> video_source_;
+  std::vector<std::unique_ptr<LoadTestCall>> calls_;
+};
+
+// Runs |num_calls| calls in this process.
+LoadTestResult RunLoadTest(int num_calls) {
+  LoadTestResult result;
+  std::vector<std::unique_ptr<CallGroup>> groups;
+  int num_started = 0;
+  for (int i = 0; i < FLAG_threads; ++i) {
+    // Spread the calls evenly over the groups.
+    const int group_calls = num_calls * (i + 1) / FLAG_threads -
+                            num_calls * i / FLAG_threads;
+    groups.push_back(absl::make_unique<CallGroup>(i));
+    num_started += groups.back()->StartCalls(group_calls);
+  }
+
+  const int64_t setup_deadline_ms =
+      rtc::TimeMillis() + FLAG_setup_timeout * rtc::kNumMillisecsPerSec;
+  int num_set_up = 0;
+  while (rtc::TimeMillis() < setup_deadline_ms) {
+    num_set_up = 0;
+    for (const auto& group : groups)
+      num_set_up += group->NumCallsSetUp();
+    if (num_set_up == num_started)
+      break;
+    SleepMs(kPollIntervalMs);
+  }
+
+  const int64_t start_cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+  const int64_t start_time_ms = rtc::TimeMillis();
+  SleepMs(FLAG_duration * rtc::kNumMillisecsPerSec);
+  result.cpu_time_ns = rtc::GetProcessCpuTimeNanos() - start_cpu_time_ns;
+  result.measurement_time_ms = rtc::TimeMillis() - start_time_ms;
+  result.num_streams = num_set_up * LoadTestCall::kNumStreams;
+
+  for (const auto& group : groups)
+    group->StopCalls(&result);
+  // Including the calls that could not be created.
+  result.failed_calls =
+      num_calls - static_cast<int>(result.call_setup_times_ms.size());
+  return result;
+}
+
+#if defined(WEBRTC_POSIX)
+// Runs the calls in |num_processes| child processes, and merges what they
+// measured. The children are forked before any threads are started.
+bool RunLoadTestInProcesses(int num_processes, LoadTestResult* result) {
+  std::vector<pid_t> children;
+  std::vector<int> pipes;
+  for (int i = 0; i < num_processes; ++i) {
+    int fds[2];
+    RTC_CHECK_EQ(0, pipe(fds));
+    const pid_t pid = fork();
+    RTC_CHECK_GE(pid, 0);
+    if (pid == 0) {
+      close(fds[0]);
+      const int num_calls = FLAG_calls * (i + 1) / num_processes -
+                            FLAG_calls * i / num_processes;
+      rtc::InitializeSSL();
+      const std::string line =
+          SerializeLoadTestResult(RunLoadTest(num_calls)) + "\n";
+      size_t written = 0;
+      while (written < line.size()) {
+        const ssize_t n =
+            write(fds[1], line.data() + written, line.size() - written);
+        if (n <= 0)
+          _exit(1);
+        written += n;
+      }
+      close(fds[1]);
+      _exit(0);
+    }
+    close(fds[1]);
+    children.push_back(pid);
+    pipes.push_back(fds[0]);
+  }
+
+  bool success = true;
+  for (size_t i = 0; i < children.size(); ++i) {
+    std::string line;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(pipes[i], buffer, sizeof(buffer))) > 0)
+      line.append(buffer, n);
+    close(pipes[i]);
+    int status = 0;
+    waitpid(children[i], &status, 0);
+    LoadTestResult child_result;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 ||
+        !ParseLoadTestResult(line.substr(0, line.find('\n')),
+                             &child_result)) {
+      std::cerr << "Process " << i << " failed." << std::endl;
+      success = false;
+      continue;
+    }
+    result->Merge(child_result);
+  }
+  return success;
+}
+#endif  // defined(WEBRTC_POSIX)
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage =
+      "Measures how many PeerConnection calls this machine sustains, by\n"
+      "running calls between PeerConnections of the same processes over the\n"
+      "loopback interface, with synthetic audio and video.\n"
+      "Example usage:\n" +
+      program_name + " --calls=500 --processes=4 --threads=2\n" + "Run " +
+      program_name + " --help for a list of command line options\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) != 0 ||
+      FLAG_help || argc != 1) {
+    std::cout << usage;
+    if (FLAG_help)
+      rtc::FlagList::Print(nullptr, false);
+    return FLAG_help ? 0 : 1;
+  }
+  if (FLAG_calls < 1 || FLAG_processes < 1 || FLAG_threads < 1 ||
+      FLAG_duration < 0 || FLAG_fps < 1) {
+    std::cerr << "--calls, --processes, --threads and --fps must be positive."
+              << std::endl;
+    return 1;
+  }
+  // Thousands of calls log too much to be useful.
+  rtc::LogMessage::LogToDebug(rtc::LS_ERROR);
+
+  webrtc::LoadTestResult result;
+  bool success = true;
+  if (FLAG_processes == 1) {
+    rtc::InitializeSSL();
+    result = webrtc::RunLoadTest(FLAG_calls);
+    rtc::CleanupSSL();
+  } else {
+#if defined(WEBRTC_POSIX)
+    success = webrtc::RunLoadTestInProcesses(FLAG_processes, &result);
+#else
+    std::cerr << "--processes is only supported on POSIX." << std::endl;
+    return 1;
+#endif
+  }
+
+  std::cout << webrtc::FormatLoadTestReport(result);
+  return success && result.failed_calls == 0 ? 0 : 1;
+}
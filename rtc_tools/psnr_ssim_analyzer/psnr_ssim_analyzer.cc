@@ -18,53 +18,53 @@
 
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
 #include "rtc_tools/simple_command_line_parser.h"
+#include "system_wrappers/include/cpu_info.h"
 
 #define MAX_NUM_FRAMES_PER_FILE INT_MAX
+// Number of frames analyzed at a time per thread. The number of frames in the
+// files isn't known up front, so the frames are analyzed in batches until a
+// batch runs past the end of one of the files.
+#define FRAMES_PER_THREAD_AND_BATCH 16
 
 void CompareFiles(const char* reference_file_name,
                   const char* test_file_name,
                   const char* results_file_name,
                   int width,
-                  int height) {
-  // Check if the reference_file_name ends with "y4m".
-  bool y4m_mode = false;
-  if (std::string(reference_file_name).find("y4m") != std::string::npos) {
-    y4m_mode = true;
-  }
-
+                  int height,
+                  size_t num_threads) {
   FILE* results_file = fopen(results_file_name, "w");
 
-  int size = webrtc::test::GetI420FrameSize(width, height);
-
-  // Allocate buffers for test and reference frames.
-  uint8_t* test_frame = new uint8_t[size];
-  uint8_t* ref_frame = new uint8_t[size];
-
-  bool read_result = true;
-  for (int frame_counter = 0; frame_counter < MAX_NUM_FRAMES_PER_FILE;
-       ++frame_counter) {
-    read_result &=
-        (y4m_mode)
-            ? webrtc::test::ExtractFrameFromY4mFile(
-                  reference_file_name, width, height, frame_counter, ref_frame)
-            : webrtc::test::ExtractFrameFromYuvFile(
-                  reference_file_name, width, height, frame_counter, ref_frame);
-    read_result &= webrtc::test::ExtractFrameFromYuvFile(
-        test_file_name, width, height, frame_counter, test_frame);
-
-    if (!read_result)
+  if (num_threads == 0)
+    num_threads = webrtc::CpuInfo::DetectNumberOfCores();
+  const int batch_size =
+      static_cast<int>(num_threads) * FRAMES_PER_THREAD_AND_BATCH;
+
+  std::vector<webrtc::test::FrameMatch> matches;
+  std::vector<webrtc::test::AnalysisResult> results;
+  for (int frame_counter = 0;
+       frame_counter <= MAX_NUM_FRAMES_PER_FILE - batch_size;
+       frame_counter += batch_size) {
+    const int batch_end = frame_counter + batch_size;
+    matches.clear();
+    for (int frame = frame_counter; frame < batch_end; ++frame)
+      matches.push_back({frame, frame, frame});
+    results.clear();
+    webrtc::test::AnalyzeFrameMatches(reference_file_name, test_file_name,
+                                      width, height, matches, num_threads,
+                                      &results);
+
+    // Stop at the first frame that couldn't be read.
+    int expected_frame = frame_counter;
+    for (const webrtc::test::AnalysisResult& result : results) {
+      if (result.frame_number != expected_frame)
+        break;
+      fprintf(results_file, "Frame: %d, PSNR: %f, SSIM: %f\n",
+              result.frame_number, result.psnr_value, result.ssim_value);
+      ++expected_frame;
+    }
+    if (expected_frame != batch_end)
       break;
-
-    // Calculate the PSNR and SSIM.
-    double result_psnr = webrtc::test::CalculateMetrics(
-        webrtc::test::kPSNR, ref_frame, test_frame, width, height);
-    double result_ssim = webrtc::test::CalculateMetrics(
-        webrtc::test::kSSIM, ref_frame, test_frame, width, height);
-    fprintf(results_file, "Frame: %d, PSNR: %f, SSIM: %f\n", frame_counter,
-            result_psnr, result_ssim);
   }
-  delete[] test_frame;
-  delete[] ref_frame;
 
   fclose(results_file);
 }
@@ -83,7 +83,7 @@ void CompareFiles(const char* reference_file_name,
  * Usage:
  * psnr_ssim_analyzer --reference_file=<name_of_file> --test_file=<name_of_file>
  * --results_file=<name_of_file> --width=<width_of_frames>
- * --height=<height_of_frames>
+ * --height=<height_of_frames> [--num_threads=<number_of_threads>]
  */
 int main(int argc, char* argv[]) {
   std::string program_name = argv[0];
@@ -104,7 +104,9 @@ int main(int argc, char* argv[]) {
       "  - test_file(string): The test YUV file to run the analysis for."
       " Default: test_file.yuv\n"
       "  - results_file(string): The full name of the file where the results "
-      "will be written. Default: results.txt\n";
+      "will be written. Default: results.txt\n"
+      "  - num_threads(int): The number of threads computing the metrics, or "
+      "0 for one per core. Default: 0\n";
 
   webrtc::test::CommandLineParser parser;
 
@@ -118,6 +120,7 @@ int main(int argc, char* argv[]) {
   parser.SetFlag("reference_file", "ref.yuv");
   parser.SetFlag("test_file", "test.yuv");
   parser.SetFlag("results_file", "results.txt");
+  parser.SetFlag("num_threads", "0");
   parser.SetFlag("help", "false");
 
   parser.ProcessFlags();
@@ -129,14 +132,20 @@ int main(int argc, char* argv[]) {
 
   int width = strtol((parser.GetFlag("width")).c_str(), NULL, 10);
   int height = strtol((parser.GetFlag("height")).c_str(), NULL, 10);
+  int num_threads = strtol((parser.GetFlag("num_threads")).c_str(), NULL, 10);
 
   if (width <= 0 || height <= 0) {
     fprintf(stderr, "Error: width or height cannot be <= 0!\n");
     return -1;
   }
+  if (num_threads < 0) {
+    fprintf(stderr, "Error: num_threads cannot be < 0!\n");
+    return -1;
+  }
 
   CompareFiles(parser.GetFlag("reference_file").c_str(),
                parser.GetFlag("test_file").c_str(),
-               parser.GetFlag("results_file").c_str(), width, height);
+               parser.GetFlag("results_file").c_str(), width, height,
+               num_threads);
   return 0;
 }
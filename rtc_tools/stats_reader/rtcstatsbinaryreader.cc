@@ -0,0 +1,342 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/stats_reader/rtcstatsbinaryreader.h"
+
+#include <string.h>
+
+#include <sstream>
+#include <utility>
+
+#include "api/stats/rtcstatsreport.h"
+#include "rtc_base/byteorder.h"
+#include "rtc_base/stringencode.h"
+
+namespace webrtc {
+
+namespace {
+
+// Reads from |data| without going past its end.
+class Cursor {
+ public:
+  Cursor(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  const uint8_t* position() const { return data_ + offset_; }
+  size_t offset() const { return offset_; }
+  size_t remaining() const { return size_ - offset_; }
+
+  bool Skip(size_t size) {
+    if (size > remaining())
+      return false;
+    offset_ += size;
+    return true;
+  }
+  bool ReadUint8(uint8_t* value) {
+    if (!Skip(1))
+      return false;
+    *value = position()[-1];
+    return true;
+  }
+  bool ReadUint32(uint32_t* value) {
+    if (!Skip(4))
+      return false;
+    *value = rtc::GetLE32(position() - 4);
+    return true;
+  }
+  bool ReadUint64(uint64_t* value) {
+    if (!Skip(8))
+      return false;
+    *value = rtc::GetLE64(position() - 8);
+    return true;
+  }
+  bool ReadString(std::string* value) {
+    uint32_t length;
+    if (!ReadUint32(&length) || !Skip(length))
+      return false;
+    value->assign(reinterpret_cast<const char*>(position()) - length, length);
+    return true;
+  }
+  bool SkipString() {
+    uint32_t length;
+    return ReadUint32(&length) && Skip(length);
+  }
+
+ private:
+  const uint8_t* const data_;
+  const size_t size_;
+  size_t offset_ = 0;
+};
+
+// The size of the sequence elements of |type|, or 0 for strings.
+size_t ElementSize(RTCStatsMemberInterface::Type type) {
+  switch (type) {
+    case RTCStatsMemberInterface::kBool:
+    case RTCStatsMemberInterface::kSequenceBool:
+      return 1;
+    case RTCStatsMemberInterface::kInt32:
+    case RTCStatsMemberInterface::kUint32:
+    case RTCStatsMemberInterface::kSequenceInt32:
+    case RTCStatsMemberInterface::kSequenceUint32:
+      return 4;
+    case RTCStatsMemberInterface::kInt64:
+    case RTCStatsMemberInterface::kUint64:
+    case RTCStatsMemberInterface::kDouble:
+    case RTCStatsMemberInterface::kSequenceInt64:
+    case RTCStatsMemberInterface::kSequenceUint64:
+    case RTCStatsMemberInterface::kSequenceDouble:
+      return 8;
+    case RTCStatsMemberInterface::kString:
+    case RTCStatsMemberInterface::kSequenceString:
+      return 0;
+  }
+  return 0;
+}
+
+bool IsSequence(RTCStatsMemberInterface::Type type) {
+  return type >= RTCStatsMemberInterface::kSequenceBool;
+}
+
+bool SkipValue(RTCStatsMemberInterface::Type type, Cursor* cursor) {
+  if (type == RTCStatsMemberInterface::kString)
+    return cursor->SkipString();
+  if (!IsSequence(type))
+    return cursor->Skip(ElementSize(type));
+  uint32_t length;
+  if (!cursor->ReadUint32(&length))
+    return false;
+  if (type != RTCStatsMemberInterface::kSequenceString) {
+    const size_t element_size = ElementSize(type);
+    return length <= cursor->remaining() / element_size &&
+           cursor->Skip(length * element_size);
+  }
+  for (uint32_t i = 0; i < length; ++i) {
+    if (!cursor->SkipString())
+      return false;
+  }
+  return true;
+}
+
+double ToDouble(const uint8_t* data) {
+  uint64_t bits = rtc::GetLE64(data);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+std::string ReadString(const uint8_t* data) {
+  return std::string(reinterpret_cast<const char*>(data) + 4,
+                     rtc::GetLE32(data));
+}
+
+// Formats the scalar of |type|, or its sequence element, at |data|.
+std::string ScalarToString(RTCStatsMemberInterface::Type type,
+                           const uint8_t* data) {
+  switch (type) {
+    case RTCStatsMemberInterface::kBool:
+    case RTCStatsMemberInterface::kSequenceBool:
+      return rtc::ToString(data[0] != 0);
+    case RTCStatsMemberInterface::kInt32:
+    case RTCStatsMemberInterface::kSequenceInt32:
+      return rtc::ToString(static_cast<int32_t>(rtc::GetLE32(data)));
+    case RTCStatsMemberInterface::kUint32:
+    case RTCStatsMemberInterface::kSequenceUint32:
+      return rtc::ToString(rtc::GetLE32(data));
+    case RTCStatsMemberInterface::kInt64:
+    case RTCStatsMemberInterface::kSequenceInt64:
+      return rtc::ToString(static_cast<int64_t>(rtc::GetLE64(data)));
+    case RTCStatsMemberInterface::kUint64:
+    case RTCStatsMemberInterface::kSequenceUint64:
+      return rtc::ToString(rtc::GetLE64(data));
+    case RTCStatsMemberInterface::kDouble:
+    case RTCStatsMemberInterface::kSequenceDouble:
+      return rtc::ToString(ToDouble(data));
+    case RTCStatsMemberInterface::kString:
+      return ReadString(data);
+    case RTCStatsMemberInterface::kSequenceString:
+      return "\"" + ReadString(data) + "\"";
+  }
+  return std::string();
+}
+
+}  // namespace
+
+bool RTCStatsBinaryReader::Column::GetBool(size_t index, bool* value) const {
+  if (!values[index] || type != RTCStatsMemberInterface::kBool)
+    return false;
+  *value = values[index][0] != 0;
+  return true;
+}
+
+bool RTCStatsBinaryReader::Column::GetInt64(size_t index,
+                                            int64_t* value) const {
+  if (!values[index])
+    return false;
+  switch (type) {
+    case RTCStatsMemberInterface::kInt32:
+      *value = static_cast<int32_t>(rtc::GetLE32(values[index]));
+      return true;
+    case RTCStatsMemberInterface::kUint32:
+      *value = rtc::GetLE32(values[index]);
+      return true;
+    case RTCStatsMemberInterface::kInt64:
+      *value = static_cast<int64_t>(rtc::GetLE64(values[index]));
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool RTCStatsBinaryReader::Column::GetUint64(size_t index,
+                                             uint64_t* value) const {
+  if (!values[index])
+    return false;
+  switch (type) {
+    case RTCStatsMemberInterface::kUint32:
+      *value = rtc::GetLE32(values[index]);
+      return true;
+    case RTCStatsMemberInterface::kUint64:
+      *value = rtc::GetLE64(values[index]);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool RTCStatsBinaryReader::Column::GetDouble(size_t index,
+                                             double* value) const {
+  if (!values[index])
+    return false;
+  int64_t int_value;
+  uint64_t uint_value;
+  if (type == RTCStatsMemberInterface::kDouble) {
+    *value = ToDouble(values[index]);
+  } else if (type == RTCStatsMemberInterface::kUint64 &&
+             GetUint64(index, &uint_value)) {
+    *value = static_cast<double>(uint_value);
+  } else if (GetInt64(index, &int_value)) {
+    *value = static_cast<double>(int_value);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool RTCStatsBinaryReader::Column::GetString(size_t index,
+                                             std::string* value) const {
+  if (!values[index] || type != RTCStatsMemberInterface::kString)
+    return false;
+  *value = ReadString(values[index]);
+  return true;
+}
+
+std::string RTCStatsBinaryReader::Column::ValueToString(size_t index) const {
+  const uint8_t* data = values[index];
+  if (!data)
+    return "undefined";
+  if (!IsSequence(type))
+    return ScalarToString(type, data);
+
+  // The elements were validated by |Parse|.
+  const uint32_t length = rtc::GetLE32(data);
+  const uint8_t* element = data + 4;
+  std::ostringstream oss;
+  oss << "[";
+  for (uint32_t i = 0; i < length; ++i) {
+    oss << (i ? "," : "") << ScalarToString(type, element);
+    if (type == RTCStatsMemberInterface::kSequenceString)
+      element += 4 + rtc::GetLE32(element);
+    else
+      element += ElementSize(type);
+  }
+  oss << "]";
+  return oss.str();
+}
+
+RTCStatsBinaryReader::RTCStatsBinaryReader() {}
+
+RTCStatsBinaryReader::~RTCStatsBinaryReader() {}
+
+size_t RTCStatsBinaryReader::Parse(const uint8_t* data, size_t size) {
+  timestamp_us_ = 0;
+  groups_.clear();
+
+  Cursor header(data, size);
+  uint32_t magic, version, report_size, num_groups;
+  uint64_t timestamp_us;
+  if (!header.ReadUint32(&magic) || magic != RTCStatsReport::kBinaryMagic ||
+      !header.ReadUint32(&version) ||
+      version != RTCStatsReport::kBinaryVersion ||
+      !header.ReadUint32(&report_size) || report_size > size ||
+      !header.ReadUint64(&timestamp_us) || !header.ReadUint32(&num_groups) ||
+      report_size < header.offset()) {
+    return 0;
+  }
+
+  // The report must not read past its own size. Every group, and every
+  // member and object in it, takes a few bytes at least, which bounds the
+  // allocations below by the size of the report.
+  Cursor cursor(data, report_size);
+  cursor.Skip(header.offset());
+  if (num_groups > cursor.remaining() / 12)
+    return 0;
+  std::vector<Group> groups(num_groups);
+  for (Group& group : groups) {
+    uint32_t num_objects, num_members;
+    if (!cursor.ReadString(&group.type) || !cursor.ReadUint32(&num_objects) ||
+        !cursor.ReadUint32(&num_members)) {
+      return 0;
+    }
+    if (num_objects > cursor.remaining() / 12 ||
+        num_members > cursor.remaining() / 5)
+      return 0;
+    group.columns.resize(num_members);
+    for (Column& column : group.columns) {
+      uint8_t type;
+      if (!cursor.ReadString(&column.name) || !cursor.ReadUint8(&type) ||
+          type > RTCStatsMemberInterface::kSequenceString) {
+        return 0;
+      }
+      column.type = static_cast<RTCStatsMemberInterface::Type>(type);
+      column.values.resize(num_objects);
+    }
+    group.ids.resize(num_objects);
+    for (std::string& id : group.ids) {
+      if (!cursor.ReadString(&id))
+        return 0;
+    }
+    group.timestamps_us.resize(num_objects);
+    for (int64_t& object_timestamp_us : group.timestamps_us) {
+      uint64_t value;
+      if (!cursor.ReadUint64(&value))
+        return 0;
+      object_timestamp_us = static_cast<int64_t>(value);
+    }
+    for (Column& column : group.columns) {
+      const uint8_t* bitmap = cursor.position();
+      if (!cursor.Skip((num_objects + 7) / 8))
+        return 0;
+      for (uint32_t i = 0; i < num_objects; ++i) {
+        if (!(bitmap[i / 8] & (1 << (i % 8))))
+          continue;
+        column.values[i] = cursor.position();
+        if (!SkipValue(column.type, &cursor))
+          return 0;
+      }
+    }
+  }
+  if (cursor.offset() != report_size)
+    return 0;
+
+  timestamp_us_ = static_cast<int64_t>(timestamp_us);
+  groups_ = std::move(groups);
+  return report_size;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_STATS_READER_RTCSTATSBINARYREADER_H_
+#define RTC_TOOLS_STATS_READER_RTCSTATSBINARYREADER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "api/stats/rtcstats.h"
+
+namespace webrtc {
+
+// Reads the reports written by |RTCStatsReport::ToBinary|. Values are not
+// copied out of the data but decoded on access, so the data can be a memory
+// mapped file of reports written back to back:
+//
+//   RTCStatsBinaryReader reader;
+//   while (size_t report_size = reader.Parse(data, size)) {
+//     ... reader.groups() ...
+//     data += report_size;
+//     size -= report_size;
+//   }
+class RTCStatsBinaryReader {
+ public:
+  // The values of one member of all the objects of a group.
+  struct Column {
+    // The accessors return false if the member is undefined for the object at
+    // |index|, or if it is of a type the accessor does not accept.
+    bool GetBool(size_t index, bool* value) const;
+    // Accepts kInt32, kUint32 and kInt64 members.
+    bool GetInt64(size_t index, int64_t* value) const;
+    // Accepts kUint32 and kUint64 members.
+    bool GetUint64(size_t index, uint64_t* value) const;
+    // Accepts all the numeric members, like JSON does.
+    bool GetDouble(size_t index, double* value) const;
+    bool GetString(size_t index, std::string* value) const;
+    // Formats the value like |RTCStatsMemberInterface::ValueToString|, or
+    // returns "undefined".
+    std::string ValueToString(size_t index) const;
+
+    std::string name;
+    RTCStatsMemberInterface::Type type;
+    // For every object of the group, where its encoded value is, or null if
+    // the member is undefined for it.
+    std::vector<const uint8_t*> values;
+  };
+
+  // The objects of one stats type.
+  struct Group {
+    std::string type;
+    std::vector<std::string> ids;
+    std::vector<int64_t> timestamps_us;
+    std::vector<Column> columns;
+  };
+
+  RTCStatsBinaryReader();
+  ~RTCStatsBinaryReader();
+
+  // Parses the report at the start of |data|, replacing the previous one.
+  // Returns the size of the report, or 0 if |data| does not start with a
+  // valid report. The columns point into |data|, which must outlive them.
+  size_t Parse(const uint8_t* data, size_t size);
+
+  int64_t timestamp_us() const { return timestamp_us_; }
+  const std::vector<Group>& groups() const { return groups_; }
+
+ private:
+  int64_t timestamp_us_ = 0;
+  std::vector<Group> groups_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_STATS_READER_RTCSTATSBINARYREADER_H_
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/stats_reader/rtcstatsbinaryreader.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "api/stats/rtcstats_objects.h"
+#include "api/stats/rtcstatsreport.h"
+#include "rtc_base/buffer.h"
+#include "stats/test/rtcteststats.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+rtc::scoped_refptr<RTCStatsReport> CreateReport() {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  std::unique_ptr<RTCTestStats> all_values =
+      absl::make_unique<RTCTestStats>("allValues", 1001);
+  all_values->m_bool = true;
+  all_values->m_int32 = -32;
+  all_values->m_uint32 = 32;
+  all_values->m_int64 = -64;
+  all_values->m_uint64 = 64;
+  all_values->m_double = 0.5;
+  all_values->m_string = "string";
+  all_values->m_sequence_bool = std::vector<bool>{true, false};
+  all_values->m_sequence_int32 = std::vector<int32_t>{-1, 2};
+  all_values->m_sequence_uint32 = std::vector<uint32_t>{1, 2};
+  all_values->m_sequence_int64 = std::vector<int64_t>{-1, 2};
+  all_values->m_sequence_uint64 = std::vector<uint64_t>{1, 2};
+  all_values->m_sequence_double = std::vector<double>{1.5, -2.5};
+  all_values->m_sequence_string = std::vector<std::string>{"a", ""};
+  report->AddStats(std::move(all_values));
+  std::unique_ptr<RTCTestStats> some_values =
+      absl::make_unique<RTCTestStats>("someValues", 1002);
+  some_values->m_uint32 = 7;
+  report->AddStats(std::move(some_values));
+  std::unique_ptr<RTCPeerConnectionStats> pc_stats =
+      absl::make_unique<RTCPeerConnectionStats>("RTCPeerConnection", 1003);
+  pc_stats->data_channels_opened = 1;
+  report->AddStats(std::move(pc_stats));
+  return report;
+}
+
+}  // namespace
+
+TEST(RTCStatsBinaryReaderTest, ReadsWhatWasWritten) {
+  rtc::scoped_refptr<RTCStatsReport> report = CreateReport();
+  rtc::Buffer buffer;
+  report->ToBinary(&buffer);
+
+  RTCStatsBinaryReader reader;
+  ASSERT_EQ(buffer.size(), reader.Parse(buffer.data(), buffer.size()));
+  EXPECT_EQ(1000, reader.timestamp_us());
+  ASSERT_EQ(2u, reader.groups().size());
+  size_t num_objects = 0;
+  for (const RTCStatsBinaryReader::Group& group : reader.groups()) {
+    for (size_t i = 0; i < group.ids.size(); ++i, ++num_objects) {
+      const RTCStats* stats = report->Get(group.ids[i]);
+      ASSERT_TRUE(stats);
+      EXPECT_EQ(stats->type(), group.type);
+      EXPECT_EQ(stats->timestamp_us(), group.timestamps_us[i]);
+      std::vector<const RTCStatsMemberInterface*> members = stats->Members();
+      ASSERT_EQ(members.size(), group.columns.size());
+      for (size_t j = 0; j < members.size(); ++j) {
+        const RTCStatsBinaryReader::Column& column = group.columns[j];
+        EXPECT_EQ(members[j]->name(), column.name);
+        EXPECT_EQ(members[j]->type(), column.type);
+        EXPECT_EQ(members[j]->is_defined()
+                      ? members[j]->ValueToString()
+                      : std::string("undefined"),
+                  column.ValueToString(i));
+      }
+    }
+  }
+  EXPECT_EQ(report->size(), num_objects);
+}
+
+TEST(RTCStatsBinaryReaderTest, TypedAccessors) {
+  rtc::Buffer buffer;
+  CreateReport()->ToBinary(&buffer);
+  RTCStatsBinaryReader reader;
+  ASSERT_TRUE(reader.Parse(buffer.data(), buffer.size()));
+
+  // Groups are ordered on type, objects on id.
+  const RTCStatsBinaryReader::Group& group = reader.groups()[1];
+  ASSERT_EQ(RTCTestStats::kType, group.type);
+  ASSERT_EQ("allValues", group.ids[0]);
+  bool bool_value;
+  int64_t int_value;
+  uint64_t uint_value;
+  double double_value;
+  std::string string_value;
+  EXPECT_TRUE(group.columns[0].GetBool(0, &bool_value));
+  EXPECT_TRUE(bool_value);
+  EXPECT_TRUE(group.columns[1].GetInt64(0, &int_value));
+  EXPECT_EQ(-32, int_value);
+  EXPECT_FALSE(group.columns[1].GetUint64(0, &uint_value));
+  EXPECT_TRUE(group.columns[2].GetUint64(1, &uint_value));
+  EXPECT_EQ(7u, uint_value);
+  EXPECT_TRUE(group.columns[2].GetInt64(0, &int_value));
+  EXPECT_EQ(32, int_value);
+  EXPECT_FALSE(group.columns[0].GetBool(1, &bool_value));
+  EXPECT_TRUE(group.columns[4].GetDouble(0, &double_value));
+  EXPECT_EQ(64.0, double_value);
+  EXPECT_TRUE(group.columns[5].GetDouble(0, &double_value));
+  EXPECT_EQ(0.5, double_value);
+  EXPECT_TRUE(group.columns[6].GetString(0, &string_value));
+  EXPECT_EQ("string", string_value);
+  EXPECT_FALSE(group.columns[6].GetString(1, &string_value));
+  EXPECT_FALSE(group.columns[6].GetDouble(0, &double_value));
+}
+
+TEST(RTCStatsBinaryReaderTest, ReadsReportsBackToBack) {
+  rtc::Buffer buffer;
+  CreateReport()->ToBinary(&buffer);
+  const size_t first_size = buffer.size();
+  RTCStatsReport::Create(2000)->ToBinary(&buffer);
+
+  RTCStatsBinaryReader reader;
+  ASSERT_EQ(first_size, reader.Parse(buffer.data(), buffer.size()));
+  EXPECT_EQ(1000, reader.timestamp_us());
+  const size_t second_size = buffer.size() - first_size;
+  EXPECT_EQ(second_size,
+            reader.Parse(buffer.data() + first_size, second_size));
+  EXPECT_EQ(2000, reader.timestamp_us());
+  EXPECT_TRUE(reader.groups().empty());
+}
+
+TEST(RTCStatsBinaryReaderTest, RejectsTruncatedAndCorruptReports) {
+  rtc::Buffer buffer;
+  CreateReport()->ToBinary(&buffer);
+  RTCStatsBinaryReader reader;
+  for (size_t size = 0; size < buffer.size(); ++size)
+    EXPECT_EQ(0u, reader.Parse(buffer.data(), size));
+
+  // A string claiming to be longer than the report.
+  rtc::Buffer corrupt(buffer.data(), buffer.size());
+  corrupt[24] = 0xff;
+  EXPECT_EQ(0u, reader.Parse(corrupt.data(), corrupt.size()));
+  EXPECT_TRUE(reader.groups().empty());
+}
+
+}  // namespace webrtc
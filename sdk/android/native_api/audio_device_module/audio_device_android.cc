@@ -60,12 +60,15 @@ rtc::scoped_refptr<AudioDeviceModule> CreateAAudioAudioDeviceModule(
   GetDefaultAudioParameters(env, application_context, &input_parameters,
                             &output_parameters);
   // Create ADM from AAudioRecorder and AAudioPlayer.
+  auto audio_input = absl::make_unique<jni::AAudioRecorder>(input_parameters);
+  auto audio_output = absl::make_unique<jni::AAudioPlayer>(output_parameters);
+  // The ADM destroys the output before the input.
+  jni::ConnectFullDuplex(audio_input.get(), audio_output.get());
   return CreateAudioDeviceModuleFromInputAndOutput(
       AudioDeviceModule::kAndroidAAudioAudio, false /* use_stereo_input */,
       false /* use_stereo_output */,
-      jni::kLowLatencyModeDelayEstimateInMilliseconds,
-      absl::make_unique<jni::AAudioRecorder>(input_parameters),
-      absl::make_unique<jni::AAudioPlayer>(output_parameters));
+      jni::kLowLatencyModeDelayEstimateInMilliseconds, std::move(audio_input),
+      std::move(audio_output));
 }
 #endif
 
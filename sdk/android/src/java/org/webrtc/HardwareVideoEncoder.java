@@ -105,6 +105,11 @@ class HardwareVideoEncoder implements VideoEncoder {
   // --- Only accessed on the output thread.
   // Contents of the last observed config frame output by the MediaCodec. Used by H.264.
   @Nullable private ByteBuffer configBuffer = null;
+  // Reused for every output buffer to avoid allocating per frame. Encoded images only need to be
+  // valid for the duration of the callback, just like the MediaCodec output buffers.
+  private final MediaCodec.BufferInfo outputBufferInfo = new MediaCodec.BufferInfo();
+  @Nullable private ByteBuffer keyFrameBuffer = null;
+  private final CodecSpecificInfo codecSpecificInfo = new CodecSpecificInfo();
   private int adjustedBitrate;
 
   // Whether the encoder is running.  Volatile so that the output thread can watch this value and
@@ -487,7 +492,7 @@ class HardwareVideoEncoder implements VideoEncoder {
   protected void deliverEncodedImage() {
     outputThreadChecker.checkIsOnValidThread();
     try {
-      MediaCodec.BufferInfo info = new MediaCodec.BufferInfo();
+      MediaCodec.BufferInfo info = outputBufferInfo;
       int index = codec.dequeueOutputBuffer(info, DEQUEUE_OUTPUT_BUFFER_TIMEOUT_US);
       if (index < 0) {
         return;
@@ -518,11 +523,16 @@ class HardwareVideoEncoder implements VideoEncoder {
               "Prepending config frame of size " + configBuffer.capacity()
                   + " to output buffer with offset " + info.offset + ", size " + info.size);
           // For H.264 key frame prepend SPS and PPS NALs at the start.
-          frameBuffer = ByteBuffer.allocateDirect(info.size + configBuffer.capacity());
+          final int keyFrameSize = info.size + configBuffer.capacity();
+          if (keyFrameBuffer == null || keyFrameBuffer.capacity() < keyFrameSize) {
+            keyFrameBuffer = ByteBuffer.allocateDirect(keyFrameSize);
+          }
+          keyFrameBuffer.clear();
           configBuffer.rewind();
-          frameBuffer.put(configBuffer);
-          frameBuffer.put(codecOutputBuffer);
-          frameBuffer.rewind();
+          keyFrameBuffer.put(configBuffer);
+          keyFrameBuffer.put(codecOutputBuffer);
+          keyFrameBuffer.flip();
+          frameBuffer = keyFrameBuffer.slice();
         } else {
           frameBuffer = codecOutputBuffer.slice();
         }
@@ -534,7 +544,7 @@ class HardwareVideoEncoder implements VideoEncoder {
         EncodedImage.Builder builder = outputBuilders.poll();
         builder.setBuffer(frameBuffer).setFrameType(frameType);
         // TODO(mellem):  Set codec-specific info.
-        callback.onEncodedFrame(builder.createEncodedImage(), new CodecSpecificInfo());
+        callback.onEncodedFrame(builder.createEncodedImage(), codecSpecificInfo);
       }
       codec.releaseOutputBuffer(index, false);
     } catch (IllegalStateException e) {
@@ -558,6 +568,7 @@ class HardwareVideoEncoder implements VideoEncoder {
       shutdownException = e;
     }
     configBuffer = null;
+    keyFrameBuffer = null;
     Logging.d(TAG, "Release on output thread done");
   }
 
@@ -10,6 +10,7 @@
 
 package org.webrtc;
 
+import android.graphics.Matrix;
 import javax.annotation.Nullable;
 
 /**
@@ -41,6 +42,27 @@ class NativeCapturerObserver implements CapturerObserver {
         frame.getRotation(), frame.getTimestampNs(), frame.getBuffer());
   }
 
+  /**
+   * Returns |buffer| rotated clockwise by |rotation| degrees, if it is a texture buffer. The
+   * rotation only updates the transform matrix and is applied on the GPU when the texture is
+   * sampled, e.g. when drawn into a MediaCodec input surface. Returns null for other buffers.
+   */
+  @Nullable
+  @CalledByNative
+  static VideoFrame.Buffer rotateTextureBuffer(VideoFrame.Buffer buffer, int rotation) {
+    if (!(buffer instanceof TextureBufferImpl)) {
+      return null;
+    }
+    final Matrix rotationMatrix = new Matrix();
+    rotationMatrix.preTranslate(0.5f, 0.5f);
+    rotationMatrix.preRotate(rotation);
+    rotationMatrix.preTranslate(-0.5f, -0.5f);
+    final boolean swapSides = rotation % 180 != 0;
+    return ((TextureBufferImpl) buffer)
+        .applyTransformMatrix(rotationMatrix, swapSides ? buffer.getHeight() : buffer.getWidth(),
+            swapSides ? buffer.getWidth() : buffer.getHeight());
+  }
+
   private static native void nativeCapturerStarted(long source, boolean success);
   private static native void nativeCapturerStopped(long source);
   private static native void nativeOnFrameCaptured(
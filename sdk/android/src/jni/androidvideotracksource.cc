@@ -14,6 +14,7 @@
 
 #include "api/videosourceproxy.h"
 #include "rtc_base/logging.h"
+#include "sdk/android/src/jni/nativecapturerobserver.h"
 
 namespace webrtc {
 namespace jni {
@@ -90,14 +91,24 @@ void AndroidVideoTrackSource::OnFrameCaptured(
     return;
   }
 
-  rtc::scoped_refptr<VideoFrameBuffer> buffer =
+  rtc::scoped_refptr<AndroidVideoBuffer> android_buffer =
       AndroidVideoBuffer::Create(jni, j_video_frame_buffer)
           ->CropAndScale(jni, crop_x, crop_y, crop_width, crop_height,
                          adapted_width, adapted_height);
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = android_buffer;
 
-  // AdaptedVideoTrackSource handles applying rotation for I420 frames.
   if (apply_rotation() && rotation != kVideoRotation_0) {
-    buffer = buffer->ToI420();
+    // Texture frames are rotated on the GPU, keeping them textures all the
+    // way to a surface mode hardware encoder. AdaptedVideoTrackSource handles
+    // applying rotation for I420 frames.
+    ScopedJavaLocalRef<jobject> j_rotated_buffer = RotateJavaTextureBuffer(
+        jni, android_buffer->video_frame_buffer(), rotation);
+    if (!j_rotated_buffer.is_null()) {
+      buffer = AndroidVideoBuffer::Adopt(jni, j_rotated_buffer);
+      rotation = kVideoRotation_0;
+    } else {
+      buffer = buffer->ToI420();
+    }
   }
 
   OnFrame(VideoFrame(buffer, rotation, translated_camera_time_us));
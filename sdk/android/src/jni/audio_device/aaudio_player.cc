@@ -10,16 +10,29 @@
 
 #include "sdk/android/src/jni/audio_device/aaudio_player.h"
 
+#include <algorithm>
+
 #include "absl/memory/memory.h"
 #include "api/array_view.h"
 #include "modules/audio_device/fine_audio_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/timeutils.h"
+#include "sdk/android/src/jni/audio_device/aaudio_recorder.h"
 
 namespace webrtc {
 
 namespace jni {
 
+namespace {
+
+// Bounds of the time without underruns before the output buffer is decreased
+// by one burst.
+const int kMinBufferDecreaseIntervalMs = 5000;
+const int kMaxBufferDecreaseIntervalMs = 80000;
+
+}  // namespace
+
 enum AudioDeviceMessageType : uint32_t {
   kMessageOutputStreamDisconnected,
 };
@@ -87,8 +100,13 @@ int AAudioPlayer::StartPlayout() {
     return -1;
   }
   underrun_count_ = aaudio_.xrun_count();
+  frames_without_underrun_ = 0;
+  buffer_decrease_interval_ms_ = kMinBufferDecreaseIntervalMs;
   first_data_callback_ = true;
   playing_ = true;
+  if (duplex_recorder_) {
+    duplex_recorder_->OnPlayoutStarted();
+  }
   return 0;
 }
 
@@ -105,6 +123,9 @@ int AAudioPlayer::StopPlayout() {
   thread_checker_aaudio_.DetachFromThread();
   initialized_ = false;
   playing_ = false;
+  if (duplex_recorder_) {
+    duplex_recorder_->OnPlayoutStopped();
+  }
   return 0;
 }
 
@@ -127,6 +148,13 @@ void AAudioPlayer::AttachAudioBuffer(AudioDeviceBuffer* audioBuffer) {
   fine_audio_buffer_ = absl::make_unique<FineAudioBuffer>(audio_device_buffer_);
 }
 
+void AAudioPlayer::AttachDuplexRecorder(AAudioRecorder* recorder) {
+  RTC_DLOG(INFO) << "AttachDuplexRecorder";
+  RTC_DCHECK_RUN_ON(&main_thread_checker_);
+  RTC_DCHECK(!initialized_);
+  duplex_recorder_ = recorder;
+}
+
 bool AAudioPlayer::SpeakerVolumeIsAvailable() {
   return false;
 }
@@ -177,15 +205,12 @@ aaudio_data_callback_result_t AAudioPlayer::OnDataCallback(void* audio_data,
     first_data_callback_ = false;
   }
 
-  // Check if the underrun count has increased. If it has, increase the buffer
-  // size by adding the size of a burst. It will reduce the risk of underruns
-  // at the expense of an increased latency.
-  // TODO(henrika): enable possibility to disable and/or tune the algorithm.
-  const int32_t underrun_count = aaudio_.xrun_count();
-  if (underrun_count > underrun_count_) {
-    RTC_LOG(LS_ERROR) << "Underrun detected: " << underrun_count;
-    underrun_count_ = underrun_count;
-    aaudio_.IncreaseOutputBufferSize();
+  TuneBufferSize(num_frames);
+
+  // Deliver the audio recorded since the last callback before rendering, so
+  // that capture and render are driven by the same real-time thread.
+  if (duplex_recorder_) {
+    duplex_recorder_->ReadDuplexInput();
   }
 
   // Estimate latency between writing an audio frame to the output stream and
@@ -218,6 +243,34 @@ aaudio_data_callback_result_t AAudioPlayer::OnDataCallback(void* audio_data,
   return AAUDIO_CALLBACK_RESULT_CONTINUE;
 }
 
+void AAudioPlayer::TuneBufferSize(int32_t num_frames) {
+  RTC_DCHECK_RUN_ON(&thread_checker_aaudio_);
+  // Check if the underrun count has increased. If it has, increase the buffer
+  // size by adding the size of a burst. It will reduce the risk of underruns
+  // at the expense of an increased latency.
+  const int32_t underrun_count = aaudio_.xrun_count();
+  if (underrun_count > underrun_count_) {
+    RTC_LOG(LS_ERROR) << "Underrun detected: " << underrun_count;
+    underrun_count_ = underrun_count;
+    aaudio_.IncreaseOutputBufferSize();
+    frames_without_underrun_ = 0;
+    buffer_decrease_interval_ms_ = std::min(2 * buffer_decrease_interval_ms_,
+                                            kMaxBufferDecreaseIntervalMs);
+    return;
+  }
+  if (!aaudio_.exclusive_mode_requested()) {
+    return;
+  }
+  // Try one burst less once the buffer has been large enough for a while.
+  frames_without_underrun_ += num_frames;
+  if (frames_without_underrun_ * rtc::kNumMillisecsPerSec >=
+      static_cast<int64_t>(buffer_decrease_interval_ms_) *
+          aaudio_.sample_rate()) {
+    aaudio_.DecreaseOutputBufferSize();
+    frames_without_underrun_ = 0;
+  }
+}
+
 void AAudioPlayer::OnMessage(rtc::Message* msg) {
   RTC_DCHECK_RUN_ON(&main_thread_checker_);
   switch (msg->message_id) {
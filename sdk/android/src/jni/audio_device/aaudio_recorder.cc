@@ -16,17 +16,31 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/timeutils.h"
-
+#include "sdk/android/src/jni/audio_device/aaudio_player.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/sleep.h"
 
 namespace webrtc {
 
 namespace jni {
 
+namespace {
+
+const char kFullDuplexFieldTrial[] = "WebRTC-Audio-AAudioFullDuplex";
+
+}  // namespace
+
 enum AudioDeviceMessageType : uint32_t {
   kMessageInputStreamDisconnected,
 };
 
+void ConnectFullDuplex(AAudioRecorder* input, AAudioPlayer* output) {
+  if (field_trial::IsEnabled(kFullDuplexFieldTrial)) {
+    RTC_LOG(INFO) << "Full-duplex AAudio callback is enabled";
+    output->AttachDuplexRecorder(input);
+  }
+}
+
 AAudioRecorder::AAudioRecorder(const AudioParameters& audio_parameters)
     : main_thread_(rtc::Thread::Current()),
       aaudio_(audio_parameters, AAUDIO_DIRECTION_INPUT, this) {
@@ -62,9 +76,15 @@ int AAudioRecorder::InitRecording() {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   RTC_DCHECK(!initialized_);
   RTC_DCHECK(!recording_);
+  duplex_ = playout_active_;
+  aaudio_.EnableDataCallback(!duplex_);
   if (!aaudio_.Init()) {
     return -1;
   }
+  if (duplex_) {
+    duplex_buffer_.SetSize(aaudio_.buffer_capacity_in_frames() *
+                           aaudio_.samples_per_frame());
+  }
   initialized_ = true;
   return 0;
 }
@@ -87,6 +107,10 @@ int AAudioRecorder::StartRecording() {
   overflow_count_ = aaudio_.xrun_count();
   first_data_callback_ = true;
   recording_ = true;
+  if (duplex_) {
+    rtc::CritScope lock(&duplex_crit_);
+    duplex_active_ = true;
+  }
   return 0;
 }
 
@@ -96,6 +120,11 @@ int AAudioRecorder::StopRecording() {
   if (!initialized_ || !recording_) {
     return 0;
   }
+  {
+    // Waits for an ongoing ReadDuplexInput() before the stream is closed.
+    rtc::CritScope lock(&duplex_crit_);
+    duplex_active_ = false;
+  }
   if (!aaudio_.Stop()) {
     return -1;
   }
@@ -131,6 +160,42 @@ bool AAudioRecorder::IsNoiseSuppressorSupported() const {
   return false;
 }
 
+void AAudioRecorder::OnPlayoutStarted() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  playout_active_ = true;
+  UpdateDuplexMode();
+}
+
+void AAudioRecorder::OnPlayoutStopped() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  playout_active_ = false;
+  UpdateDuplexMode();
+}
+
+void AAudioRecorder::ReadDuplexInput() {
+  rtc::CritScope lock(&duplex_crit_);
+  if (!duplex_active_) {
+    return;
+  }
+  const int32_t capacity_in_frames =
+      static_cast<int32_t>(duplex_buffer_.size()) / aaudio_.samples_per_frame();
+  if (first_data_callback_) {
+    RTC_LOG(INFO) << "--- First full-duplex input read: "
+                  << "device id=" << aaudio_.device_id();
+    aaudio_.ClearInputStream(duplex_buffer_.data(), capacity_in_frames);
+    first_data_callback_ = false;
+  }
+  // Read all available frames, since the bursts of the input and output
+  // streams need not be of the same size.
+  int32_t frames_read = 0;
+  do {
+    frames_read = aaudio_.ReadInput(duplex_buffer_.data(), capacity_in_frames);
+    if (frames_read > 0) {
+      DeliverRecordedData(duplex_buffer_.data(), frames_read);
+    }
+  } while (frames_read == capacity_in_frames);
+}
+
 int AAudioRecorder::EnableBuiltInAEC(bool enable) {
   RTC_LOG(INFO) << "EnableBuiltInAEC: " << enable;
   RTC_LOG(LS_ERROR) << "Not implemented";
@@ -176,6 +241,12 @@ aaudio_data_callback_result_t AAudioRecorder::OnDataCallback(
     aaudio_.ClearInputStream(audio_data, num_frames);
     first_data_callback_ = false;
   }
+  DeliverRecordedData(audio_data, num_frames);
+  return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+void AAudioRecorder::DeliverRecordedData(const void* audio_data,
+                                         int32_t num_frames) {
   // Check if the overflow counter has increased and if so log a warning.
   // TODO(henrika): possible add UMA stat or capacity extension.
   const int32_t overflow_count = aaudio_.xrun_count();
@@ -197,8 +268,6 @@ aaudio_data_callback_result_t AAudioRecorder::OnDataCallback(
       rtc::MakeArrayView(static_cast<const int16_t*>(audio_data),
                          aaudio_.samples_per_frame() * num_frames),
       static_cast<int>(latency_millis_ + 0.5));
-
-  return AAUDIO_CALLBACK_RESULT_CONTINUE;
 }
 
 void AAudioRecorder::OnMessage(rtc::Message* msg) {
@@ -230,6 +299,17 @@ void AAudioRecorder::HandleStreamDisconnected() {
   StartRecording();
 }
 
+void AAudioRecorder::UpdateDuplexMode() {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  if (!recording_ || duplex_ == playout_active_) {
+    return;
+  }
+  RTC_LOG(INFO) << "Restarting recording, full duplex: " << playout_active_;
+  StopRecording();
+  InitRecording();
+  StartRecording();
+}
+
 }  // namespace jni
 
 }  // namespace webrtc
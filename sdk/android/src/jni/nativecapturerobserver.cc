@@ -34,6 +34,14 @@ ScopedJavaLocalRef<jobject> CreateJavaNativeCapturerObserver(
       env, NativeToJavaPointer(native_source.release()));
 }
 
+ScopedJavaLocalRef<jobject> RotateJavaTextureBuffer(
+    JNIEnv* env,
+    const JavaRef<jobject>& j_video_frame_buffer,
+    VideoRotation rotation) {
+  return Java_NativeCapturerObserver_rotateTextureBuffer(
+      env, j_video_frame_buffer, static_cast<jint>(rotation));
+}
+
 static void JNI_NativeCapturerObserver_OnFrameCaptured(
     JNIEnv* jni,
     const JavaParamRef<jclass>&,
@@ -23,6 +23,14 @@ ScopedJavaLocalRef<jobject> CreateJavaNativeCapturerObserver(
     JNIEnv* env,
     rtc::scoped_refptr<AndroidVideoTrackSource> native_source);
 
+// Rotates a Java texture VideoFrame.Buffer on the GPU, see
+// NativeCapturerObserver.rotateTextureBuffer(). Returns a null reference if
+// the buffer isn't a texture.
+ScopedJavaLocalRef<jobject> RotateJavaTextureBuffer(
+    JNIEnv* env,
+    const JavaRef<jobject>& j_video_frame_buffer,
+    VideoRotation rotation);
+
 }  // namespace jni
 }  // namespace webrtc
 
@@ -28,6 +28,9 @@ namespace jni {
 namespace {
 // RTP timestamps are 90 kHz.
 const int64_t kNumRtpTicksPerMillisec = 90000 / rtc::kNumMillisecsPerSec;
+// MediaCodec decoders hold on to a number of input buffers before the first
+// output buffer is released.
+const size_t kMaxPendingFrames = 16;
 
 template <typename Dst, typename Src>
 inline absl::optional<Dst> cast_optional(const absl::optional<Src>& value) {
@@ -148,6 +151,10 @@ bool VideoDecoderWrapper::PrefersLateDecoding() const {
   return Java_VideoDecoder_getPrefersLateDecoding(jni, decoder_);
 }
 
+size_t VideoDecoderWrapper::MaxPendingFrames() const {
+  return kMaxPendingFrames;
+}
+
 const char* VideoDecoderWrapper::ImplementationName() const {
   return implementation_name_.c_str();
 }
@@ -51,6 +51,8 @@ class VideoDecoderWrapper : public VideoDecoder {
   // frame is consumed.
   bool PrefersLateDecoding() const override;
 
+  size_t MaxPendingFrames() const override;
+
   const char* ImplementationName() const override;
 
   // Wraps the frame to a AndroidVideoBuffer and passes it to the callback.
@@ -116,11 +116,20 @@ int32_t VideoEncoderWrapper::Encode(
 
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
 
-  // Construct encode info.
-  ScopedJavaLocalRef<jobjectArray> j_frame_types =
-      NativeToJavaFrameTypeArray(jni, *frame_types);
-  ScopedJavaLocalRef<jobject> encode_info =
-      Java_EncodeInfo_Constructor(jni, j_frame_types);
+  // EncodeInfo is immutable and there are only a few combinations of frame
+  // types, so keep one per combination instead of allocating it per frame.
+  auto encode_info_it = encode_infos_.find(*frame_types);
+  if (encode_info_it == encode_infos_.end()) {
+    ScopedJavaLocalRef<jobjectArray> j_frame_types =
+        NativeToJavaFrameTypeArray(jni, *frame_types);
+    encode_info_it =
+        encode_infos_
+            .emplace(*frame_types,
+                     ScopedJavaGlobalRef<jobject>(
+                         Java_EncodeInfo_Constructor(jni, j_frame_types)))
+            .first;
+  }
+  const JavaRef<jobject>& encode_info = encode_info_it->second;
 
   FrameExtraInfo info;
   info.capture_time_ns = frame.timestamp_us() * rtc::kNumNanosecsPerMicrosec;
@@ -327,11 +336,10 @@ RTPFragmentationHeader VideoEncoderWrapper::ParseFragmentationHeader(
     const std::vector<uint8_t>& buffer) {
   RTPFragmentationHeader header;
   if (codec_settings_.codecType == kVideoCodecH264) {
-    h264_bitstream_parser_.ParseBitstream(buffer.data(), buffer.size());
-
     // For H.264 search for start codes.
     const std::vector<H264::NaluIndex> nalu_idxs =
         H264::FindNaluIndices(buffer.data(), buffer.size());
+    h264_bitstream_parser_.ParseBitstream(buffer.data(), nalu_idxs);
     if (nalu_idxs.empty()) {
       RTC_LOG(LS_ERROR) << "Start code is not found!";
       RTC_LOG(LS_ERROR) << "Data:" << buffer[0] << " " << buffer[1] << " "
@@ -13,6 +13,7 @@
 
 #include <jni.h>
 #include <deque>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -99,6 +100,8 @@ class VideoEncoderWrapper : public VideoEncoder {
 
   rtc::TaskQueue* encoder_queue_;
   std::deque<FrameExtraInfo> frame_extra_infos_;
+  // Java EncodeInfo objects, reused across frames with the same frame types.
+  std::map<std::vector<FrameType>, ScopedJavaGlobalRef<jobject>> encode_infos_;
   EncodedImageCallback* callback_;
   bool initialized_;
   int num_resets_;
@@ -61,6 +61,13 @@ class AndroidVideoBuffer : public VideoFrameBuffer {
   int height() const override;
 
   rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  // Crops and scales the Java buffer, e.g. on the GPU for texture buffers.
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int crop_x,
+                                                    int crop_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scale_width,
+                                                    int scale_height) override;
 
   const int width_;
   const int height_;
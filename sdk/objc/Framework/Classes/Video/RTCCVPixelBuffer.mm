@@ -10,6 +10,9 @@
 
 #import "WebRTC/RTCVideoFrameBuffer.h"
 
+#import <CoreImage/CoreImage.h>
+#import <Metal/Metal.h>
+
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -123,6 +126,14 @@
   const OSType srcPixelFormat = CVPixelBufferGetPixelFormatType(_pixelBuffer);
   const OSType dstPixelFormat = CVPixelBufferGetPixelFormatType(outputPixelBuffer);
 
+  // Scaling on the GPU avoids locking both buffers and touching every pixel on the CPU, which
+  // adds up when several simulcast layers are scaled from the same captured frame.
+  if ([self requiresScalingToWidth:CVPixelBufferGetWidth(outputPixelBuffer)
+                            height:CVPixelBufferGetHeight(outputPixelBuffer)] &&
+      [self cropAndScaleOnGPUTo:outputPixelBuffer]) {
+    return YES;
+  }
+
   switch (srcPixelFormat) {
     case kCVPixelFormatType_420YpCbCr8BiPlanarFullRange:
     case kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange: {
@@ -262,6 +273,55 @@
 
 #pragma mark - Private
 
++ (nullable CIContext*)sharedScalingContext {
+  static CIContext* context = nil;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    // Color management is disabled since source and destination share the same color space.
+    NSDictionary* options = @{kCIContextWorkingColorSpace : [NSNull null]};
+    id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+    if (device) {
+      context = [CIContext contextWithMTLDevice:device options:options];
+    }
+  });
+  return context;
+}
+
+- (BOOL)cropAndScaleOnGPUTo:(CVPixelBufferRef)outputPixelBuffer {
+  const OSType srcPixelFormat = CVPixelBufferGetPixelFormatType(_pixelBuffer);
+  const OSType dstPixelFormat = CVPixelBufferGetPixelFormatType(outputPixelBuffer);
+  // Core Image can't render to 32ARGB, and the output must be IOSurface backed to be rendered to
+  // without a copy.
+  if (srcPixelFormat == kCVPixelFormatType_32ARGB || dstPixelFormat == kCVPixelFormatType_32ARGB ||
+      !CVPixelBufferGetIOSurface(outputPixelBuffer)) {
+    return NO;
+  }
+  CIContext* context = [[self class] sharedScalingContext];
+  if (!context) {
+    return NO;
+  }
+
+  const size_t dstWidth = CVPixelBufferGetWidth(outputPixelBuffer);
+  const size_t dstHeight = CVPixelBufferGetHeight(outputPixelBuffer);
+  // Core Image has its origin in the bottom left corner.
+  const CGRect cropRect =
+      CGRectMake(_cropX, _bufferHeight - _cropY - _cropHeight, _cropWidth, _cropHeight);
+  CIImage* image = [[CIImage imageWithCVPixelBuffer:_pixelBuffer] imageByCroppingToRect:cropRect];
+  CGAffineTransform transform =
+      CGAffineTransformMakeTranslation(-cropRect.origin.x, -cropRect.origin.y);
+  transform = CGAffineTransformConcat(
+      transform,
+      CGAffineTransformMakeScale(static_cast<CGFloat>(dstWidth) / _cropWidth,
+                                 static_cast<CGFloat>(dstHeight) / _cropHeight));
+  image = [image imageByApplyingTransform:transform];
+
+  [context render:image
+      toCVPixelBuffer:outputPixelBuffer
+               bounds:CGRectMake(0, 0, dstWidth, dstHeight)
+           colorSpace:nil];
+  return YES;
+}
+
 - (void)cropAndScaleNV12To:(CVPixelBufferRef)outputPixelBuffer withTempBuffer:(uint8_t*)tmpBuffer {
   // Prepare output pointers.
   CVReturn cvRet = CVPixelBufferLockBaseAddress(outputPixelBuffer, 0);
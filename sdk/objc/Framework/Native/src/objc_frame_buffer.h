@@ -31,6 +31,15 @@ class ObjCFrameBuffer : public VideoFrameBuffer {
 
   rtc::scoped_refptr<I420BufferInterface> ToI420() override;
 
+  // Supported for RTCCVPixelBuffer, by adjusting the crop and the size the
+  // pixel buffer is scaled to when it is used.
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+
   id<RTCVideoFrameBuffer> wrapped_frame_buffer() const;
 
  private:
@@ -72,6 +72,30 @@ rtc::scoped_refptr<I420BufferInterface> ObjCFrameBuffer::ToI420() {
   return buffer;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> ObjCFrameBuffer::CropAndScale(int offset_x,
+                                                                   int offset_y,
+                                                                   int crop_width,
+                                                                   int crop_height,
+                                                                   int scaled_width,
+                                                                   int scaled_height) {
+  if (![frame_buffer_ isKindOfClass:[RTCCVPixelBuffer class]]) {
+    return nullptr;
+  }
+  // The crop of the pixel buffer is in pixel buffer coordinates, while the
+  // crop asked for is in the coordinates of the already scaled buffer.
+  RTCCVPixelBuffer *pixel_buffer = (RTCCVPixelBuffer *)frame_buffer_;
+  const int scale_x = pixel_buffer.cropWidth;
+  const int scale_y = pixel_buffer.cropHeight;
+  return new rtc::RefCountedObject<ObjCFrameBuffer>([[RTCCVPixelBuffer alloc]
+      initWithPixelBuffer:pixel_buffer.pixelBuffer
+             adaptedWidth:scaled_width
+            adaptedHeight:scaled_height
+                cropWidth:crop_width * scale_x / width_
+               cropHeight:crop_height * scale_y / height_
+                    cropX:pixel_buffer.cropX + offset_x * scale_x / width_
+                    cropY:pixel_buffer.cropY + offset_y * scale_y / height_]);
+}
+
 id<RTCVideoFrameBuffer> ObjCFrameBuffer::wrapped_frame_buffer() const {
   return frame_buffer_;
 }
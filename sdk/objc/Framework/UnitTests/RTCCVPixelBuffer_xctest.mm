@@ -145,6 +145,44 @@
                                  outputSize:CGSizeMake(361, 640)];
 }
 
+- (void)testCropAndScaleToIOSurface_NV12 {
+  CVPixelBufferRef pixelBufferRef = NULL;
+  CVPixelBufferCreate(
+      NULL, 720, 1280, kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange, NULL, &pixelBufferRef);
+  rtc::scoped_refptr<webrtc::I420Buffer> i420Buffer = CreateI420Gradient(720, 1280);
+  CopyI420BufferToCVPixelBuffer(i420Buffer, pixelBufferRef);
+  RTCCVPixelBuffer *buffer = [[RTCCVPixelBuffer alloc] initWithPixelBuffer:pixelBufferRef];
+
+  // IOSurface backed output buffers are scaled on the GPU.
+  NSDictionary *attributes = @{(NSString *)kCVPixelBufferIOSurfacePropertiesKey : @{}};
+  CVPixelBufferRef outputPixelBufferRef = NULL;
+  CVPixelBufferCreate(NULL,
+                      360,
+                      640,
+                      kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange,
+                      (__bridge CFDictionaryRef)attributes,
+                      &outputPixelBufferRef);
+  std::vector<uint8_t> frameScaleBuffer(
+      [buffer bufferSizeForCroppingAndScalingToWidth:360 height:640]);
+  XCTAssertTrue([buffer cropAndScaleTo:outputPixelBufferRef
+                        withTempBuffer:frameScaleBuffer.data()]);
+
+  RTCCVPixelBuffer *scaledBuffer =
+      [[RTCCVPixelBuffer alloc] initWithPixelBuffer:outputPixelBufferRef];
+  XCTAssertEqual(scaledBuffer.width, 360);
+  XCTAssertEqual(scaledBuffer.height, 640);
+
+  // The GPU filter differs from libyuv, so the result only has to be close.
+  RTCI420Buffer *originalBufferI420 = [buffer toI420];
+  RTCI420Buffer *scaledBufferI420 = [scaledBuffer toI420];
+  double psnr =
+      I420PSNR(*[originalBufferI420 nativeI420Buffer], *[scaledBufferI420 nativeI420Buffer]);
+  XCTAssertGreaterThan(psnr, 30.0);
+
+  CVBufferRelease(outputPixelBufferRef);
+  CVBufferRelease(pixelBufferRef);
+}
+
 - (void)testCropAndScale_32BGRA {
   [self cropAndScaleTestWithRGBPixelFormat:kCVPixelFormatType_32BGRA];
 }
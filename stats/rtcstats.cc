@@ -95,6 +95,19 @@ bool RTCStats::operator!=(const RTCStats& other) const {
   return !(*this == other);
 }
 
+void RTCStats::UndefineMembersEqualTo(const RTCStats& other) {
+  RTC_DCHECK_EQ(type(), other.type());
+  std::vector<const RTCStatsMemberInterface*> members = Members();
+  std::vector<const RTCStatsMemberInterface*> other_members = other.Members();
+  RTC_DCHECK_EQ(members.size(), other_members.size());
+  for (size_t i = 0; i < members.size(); ++i) {
+    if (*members[i] == *other_members[i]) {
+      // The members are those of this object, which isn't const.
+      const_cast<RTCStatsMemberInterface*>(members[i])->is_defined_ = false;
+    }
+  }
+}
+
 std::string RTCStats::ToJson() const {
   std::ostringstream oss;
   oss << "{\"type\":\"" << type() << "\","
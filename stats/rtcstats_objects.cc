@@ -467,6 +467,29 @@ RTCPeerConnectionStats::RTCPeerConnectionStats(
 
 RTCPeerConnectionStats::~RTCPeerConnectionStats() {}
 
+// clang-format off
+WEBRTC_RTCSTATS_IMPL(RTCMemoryUsageStats, RTCStats, "memory-usage",
+    &audio_jitter_buffer_bytes,
+    &data_channel_queued_bytes);
+// clang-format on
+
+RTCMemoryUsageStats::RTCMemoryUsageStats(const std::string& id,
+                                         int64_t timestamp_us)
+    : RTCMemoryUsageStats(std::string(id), timestamp_us) {}
+
+RTCMemoryUsageStats::RTCMemoryUsageStats(std::string&& id,
+                                         int64_t timestamp_us)
+    : RTCStats(std::move(id), timestamp_us),
+      audio_jitter_buffer_bytes("audioJitterBufferBytes"),
+      data_channel_queued_bytes("dataChannelQueuedBytes") {}
+
+RTCMemoryUsageStats::RTCMemoryUsageStats(const RTCMemoryUsageStats& other)
+    : RTCStats(other.id(), other.timestamp_us()),
+      audio_jitter_buffer_bytes(other.audio_jitter_buffer_bytes),
+      data_channel_queued_bytes(other.data_channel_queued_bytes) {}
+
+RTCMemoryUsageStats::~RTCMemoryUsageStats() {}
+
 // clang-format off
 WEBRTC_RTCSTATS_IMPL(RTCRTPStreamStats, RTCStats, "rtp",
     &ssrc,
@@ -198,6 +198,28 @@ TEST(RTCStatsTest, EqualityOperator) {
   EXPECT_NE(stats_with_undefined_member, stats_with_defined_member);
 }
 
+TEST(RTCStatsTest, UndefineMembersEqualTo) {
+  RTCTestStats previous("testId", 123);
+  previous.m_int32 = 123;
+  previous.m_string = "123";
+  previous.m_sequence_int32 = std::vector<int32_t>(1, 123);
+
+  RTCTestStats stats = previous;
+  stats.m_string = "321";
+  stats.m_sequence_int32->push_back(321);
+  stats.m_double = 321.0;
+  stats.UndefineMembersEqualTo(previous);
+  EXPECT_FALSE(stats.m_int32.is_defined());
+  EXPECT_EQ("321", *stats.m_string);
+  EXPECT_EQ(2u, stats.m_sequence_int32->size());
+  EXPECT_EQ(321.0, *stats.m_double);
+  EXPECT_FALSE(stats.m_bool.is_defined());
+
+  RTCTestStats unchanged = previous;
+  unchanged.UndefineMembersEqualTo(previous);
+  EXPECT_EQ(RTCTestStats("testId", 123), unchanged);
+}
+
 TEST(RTCStatsTest, RTCStatsGrandChild) {
   RTCGrandChildStats stats("grandchild", 0.0);
   stats.child_int = 1;
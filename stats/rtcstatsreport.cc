@@ -10,10 +10,171 @@
 
 #include "api/stats/rtcstatsreport.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
+#include "rtc_base/byteorder.h"
+#include "rtc_base/checks.h"
+
 namespace webrtc {
 
+namespace {
+
+void AppendUint8(uint8_t value, rtc::Buffer* buffer) {
+  buffer->AppendData(&value, 1);
+}
+
+void AppendUint32(uint32_t value, rtc::Buffer* buffer) {
+  uint8_t bytes[4];
+  rtc::SetLE32(bytes, value);
+  buffer->AppendData(bytes, sizeof(bytes));
+}
+
+void AppendUint64(uint64_t value, rtc::Buffer* buffer) {
+  uint8_t bytes[8];
+  rtc::SetLE64(bytes, value);
+  buffer->AppendData(bytes, sizeof(bytes));
+}
+
+void AppendDouble(double value, rtc::Buffer* buffer) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(value), "");
+  memcpy(&bits, &value, sizeof(bits));
+  AppendUint64(bits, buffer);
+}
+
+void AppendString(const char* value, size_t length, rtc::Buffer* buffer) {
+  AppendUint32(static_cast<uint32_t>(length), buffer);
+  buffer->AppendData(value, length);
+}
+
+void AppendString(const std::string& value, rtc::Buffer* buffer) {
+  AppendString(value.data(), value.size(), buffer);
+}
+
+template <typename T>
+const T& ValueOf(const RTCStatsMemberInterface& member) {
+  return *member.cast_to<RTCStatsMember<T>>();
+}
+
+template <typename T, typename AppendFn>
+void AppendSequence(const RTCStatsMemberInterface& member,
+                    AppendFn append,
+                    rtc::Buffer* buffer) {
+  const std::vector<T>& values = ValueOf<std::vector<T>>(member);
+  AppendUint32(static_cast<uint32_t>(values.size()), buffer);
+  for (const T& value : values)
+    append(value, buffer);
+}
+
+void AppendMemberValue(const RTCStatsMemberInterface& member,
+                       rtc::Buffer* buffer) {
+  RTC_DCHECK(member.is_defined());
+  switch (member.type()) {
+    case RTCStatsMemberInterface::kBool:
+      AppendUint8(ValueOf<bool>(member) ? 1 : 0, buffer);
+      break;
+    case RTCStatsMemberInterface::kInt32:
+      AppendUint32(ValueOf<int32_t>(member), buffer);
+      break;
+    case RTCStatsMemberInterface::kUint32:
+      AppendUint32(ValueOf<uint32_t>(member), buffer);
+      break;
+    case RTCStatsMemberInterface::kInt64:
+      AppendUint64(ValueOf<int64_t>(member), buffer);
+      break;
+    case RTCStatsMemberInterface::kUint64:
+      AppendUint64(ValueOf<uint64_t>(member), buffer);
+      break;
+    case RTCStatsMemberInterface::kDouble:
+      AppendDouble(ValueOf<double>(member), buffer);
+      break;
+    case RTCStatsMemberInterface::kString:
+      AppendString(ValueOf<std::string>(member), buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceBool: {
+      // std::vector<bool> has no references to its elements.
+      const std::vector<bool>& values = ValueOf<std::vector<bool>>(member);
+      AppendUint32(static_cast<uint32_t>(values.size()), buffer);
+      for (bool value : values)
+        AppendUint8(value ? 1 : 0, buffer);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceInt32:
+      AppendSequence<int32_t>(member, AppendUint32, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceUint32:
+      AppendSequence<uint32_t>(member, AppendUint32, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceInt64:
+      AppendSequence<int64_t>(member, AppendUint64, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceUint64:
+      AppendSequence<uint64_t>(member, AppendUint64, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceDouble:
+      AppendSequence<double>(member, AppendDouble, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceString:
+      AppendSequence<std::string>(
+          member,
+          [](const std::string& value, rtc::Buffer* buffer) {
+            AppendString(value, buffer);
+          },
+          buffer);
+      break;
+  }
+}
+
+// Appends the objects in [|begin|, |end|), which are all of the same type.
+void AppendGroup(std::vector<const RTCStats*>::const_iterator begin,
+                 std::vector<const RTCStats*>::const_iterator end,
+                 rtc::Buffer* buffer) {
+  const RTCStats& first = **begin;
+  const size_t num_objects = end - begin;
+  const std::vector<const RTCStatsMemberInterface*> schema = first.Members();
+  AppendString(first.type(), strlen(first.type()), buffer);
+  AppendUint32(static_cast<uint32_t>(num_objects), buffer);
+  AppendUint32(static_cast<uint32_t>(schema.size()), buffer);
+  for (const RTCStatsMemberInterface* member : schema) {
+    AppendString(member->name(), strlen(member->name()), buffer);
+    AppendUint8(static_cast<uint8_t>(member->type()), buffer);
+  }
+  for (auto it = begin; it != end; ++it)
+    AppendString((*it)->id(), buffer);
+  for (auto it = begin; it != end; ++it)
+    AppendUint64((*it)->timestamp_us(), buffer);
+
+  std::vector<std::vector<const RTCStatsMemberInterface*>> members;
+  members.reserve(num_objects);
+  for (auto it = begin; it != end; ++it) {
+    members.push_back((*it)->Members());
+    RTC_DCHECK_EQ(schema.size(), members.back().size());
+  }
+  for (size_t i = 0; i < schema.size(); ++i) {
+    // The bitmap is filled in once the column's objects have been visited.
+    const size_t bitmap_offset = buffer->size();
+    buffer->AppendData(
+        (num_objects + 7) / 8,
+        [](rtc::ArrayView<uint8_t> bitmap) {
+          std::fill(bitmap.begin(), bitmap.end(), 0);
+          return bitmap.size();
+        });
+    for (size_t j = 0; j < num_objects; ++j) {
+      if (!members[j][i]->is_defined())
+        continue;
+      buffer->data()[bitmap_offset + j / 8] |= 1 << (j % 8);
+      AppendMemberValue(*members[j][i], buffer);
+    }
+  }
+}
+
+}  // namespace
+
+const uint32_t RTCStatsReport::kBinaryMagic = 0x53435452;  // "RTCS".
+const uint32_t RTCStatsReport::kBinaryVersion = 1;
+
 RTCStatsReport::ConstIterator::ConstIterator(
     const rtc::scoped_refptr<const RTCStatsReport>& report,
     StatsMap::const_iterator it)
@@ -127,4 +288,37 @@ std::string RTCStatsReport::ToJson() const {
   return oss.str();
 }
 
+void RTCStatsReport::ToBinary(rtc::Buffer* buffer) const {
+  const size_t start = buffer->size();
+  // Objects of a type are next to each other, in the order of their ids.
+  std::vector<const RTCStats*> stats;
+  stats.reserve(stats_.size());
+  for (const auto& it : stats_)
+    stats.push_back(it.second.get());
+  std::stable_sort(stats.begin(), stats.end(),
+                   [](const RTCStats* a, const RTCStats* b) {
+                     return strcmp(a->type(), b->type()) < 0;
+                   });
+
+  AppendUint32(kBinaryMagic, buffer);
+  AppendUint32(kBinaryVersion, buffer);
+  const size_t size_offset = buffer->size();
+  AppendUint32(0, buffer);
+  AppendUint64(timestamp_us_, buffer);
+  const size_t num_groups_offset = buffer->size();
+  AppendUint32(0, buffer);
+
+  uint32_t num_groups = 0;
+  for (auto begin = stats.cbegin(); begin != stats.cend(); ++num_groups) {
+    auto end = std::find_if(begin, stats.cend(), [begin](const RTCStats* s) {
+      return strcmp(s->type(), (*begin)->type()) != 0;
+    });
+    AppendGroup(begin, end, buffer);
+    begin = end;
+  }
+  rtc::SetLE32(buffer->data() + size_offset,
+               static_cast<uint32_t>(buffer->size() - start));
+  rtc::SetLE32(buffer->data() + num_groups_offset, num_groups);
+}
+
 }  // namespace webrtc
@@ -11,6 +11,14 @@
 #include "system_wrappers/include/field_trial.h"
 
 #include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
 
 // Simple field trial implementation, which allows client to
 // specify desired flags in InitFieldTrialsFromString.
@@ -19,42 +27,91 @@ namespace field_trial {
 
 static const char* trials_init_string = NULL;
 
-std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
-    return std::string();
-
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
-    return std::string();
-
-  static const char kPersistentStringSeparator = '/';
-  size_t next_item = 0;
-  while (next_item < trials_string.length()) {
-    // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
-      break;
-    size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
-        field_value_end == field_name_end + 1)
-      break;
-    std::string field_name(trials_string, next_item,
-                           field_name_end - next_item);
-    std::string field_value(trials_string, field_name_end + 1,
-                            field_value_end - field_name_end - 1);
-    next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return field_value;
+namespace {
+
+// Field trials are looked up when many objects are created, e.g. for each
+// stream, so the string is parsed once, when it's set, rather than on each
+// lookup. Lookups hold a reference, so that trials replaced while a lookup is
+// in progress on another thread are deleted once it's done.
+class ParsedFieldTrials : public rtc::RefCountInterface {
+ public:
+  explicit ParsedFieldTrials(const char* trials_string)
+      : trials_string_(trials_string) {
+    const std::string& trials = trials_string_;
+    static const char kPersistentStringSeparator = '/';
+    size_t next_item = 0;
+    while (next_item < trials.length()) {
+      // Find next name/value pair in field trial configuration string.
+      size_t field_name_end =
+          trials.find(kPersistentStringSeparator, next_item);
+      if (field_name_end == trials.npos || field_name_end == next_item)
+        break;
+      size_t field_value_end =
+          trials.find(kPersistentStringSeparator, field_name_end + 1);
+      if (field_value_end == trials.npos ||
+          field_value_end == field_name_end + 1)
+        break;
+      std::string field_name(trials, next_item, field_name_end - next_item);
+      std::string field_value(trials, field_name_end + 1,
+                              field_value_end - field_name_end - 1);
+      next_item = field_value_end + 1;
+
+      // The first value of a field trial given more than once is used.
+      trials_.emplace(std::move(field_name), std::move(field_value));
+    }
   }
-  return std::string();
+
+  std::string Find(const std::string& name) const {
+    const auto it = trials_.find(name);
+    return it == trials_.end() ? std::string() : it->second;
+  }
+
+  const std::string& trials_string() const { return trials_string_; }
+
+ private:
+  const std::string trials_string_;
+  std::unordered_map<std::string, std::string> trials_;
+};
+
+rtc::GlobalLockPod parsed_trials_lock;
+// Holds a reference to the current trials, if any.
+const ParsedFieldTrials* parsed_trials RTC_GUARDED_BY(parsed_trials_lock) =
+    nullptr;
+
+rtc::scoped_refptr<const ParsedFieldTrials> GetParsedTrials() {
+  rtc::GlobalLockScope lock(&parsed_trials_lock);
+  return rtc::scoped_refptr<const ParsedFieldTrials>(parsed_trials);
+}
+
+}  // namespace
+
+std::string FindFullName(const std::string& name) {
+  rtc::scoped_refptr<const ParsedFieldTrials> trials = GetParsedTrials();
+  return trials ? trials->Find(name) : std::string();
 }
 
 // Optionally initialize field trial from a string.
 void InitFieldTrialsFromString(const char* trials_string) {
   trials_init_string = trials_string;
+  // Fuzzers and tests set the same string over and over again.
+  rtc::scoped_refptr<const ParsedFieldTrials> current = GetParsedTrials();
+  if (current && trials_string && current->trials_string() == trials_string)
+    return;
+
+  const ParsedFieldTrials* trials = nullptr;
+  if (trials_string) {
+    trials = new rtc::RefCountedObject<ParsedFieldTrials>(trials_string);
+    trials->AddRef();
+  }
+  const ParsedFieldTrials* old_trials;
+  {
+    rtc::GlobalLockScope lock(&parsed_trials_lock);
+    old_trials = parsed_trials;
+    parsed_trials = trials;
+  }
+  // Deleted here unless a lookup on another thread still holds it.
+  if (old_trials)
+    old_trials->Release();
 }
 
 const char* GetFieldTrialString() {
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "system_wrappers/include/field_trial_default.h"
+
+#include <atomic>
+#include <string>
+
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace field_trial {
+namespace {
+
+class FieldTrialDefaultTest : public ::testing::Test {
+ protected:
+  FieldTrialDefaultTest() : previous_trials_(GetFieldTrialString()) {}
+  ~FieldTrialDefaultTest() override {
+    InitFieldTrialsFromString(previous_trials_);
+  }
+
+ private:
+  const char* const previous_trials_;
+};
+
+TEST_F(FieldTrialDefaultTest, FindsTrials) {
+  InitFieldTrialsFromString("Trial1/Enabled/Trial2/Disabled-10/");
+  EXPECT_EQ("Enabled", FindFullName("Trial1"));
+  EXPECT_EQ("Disabled-10", FindFullName("Trial2"));
+  EXPECT_EQ("", FindFullName("Trial3"));
+  EXPECT_TRUE(IsEnabled("Trial1"));
+  EXPECT_TRUE(IsDisabled("Trial2"));
+}
+
+TEST_F(FieldTrialDefaultTest, UsesFirstValueOfRepeatedTrial) {
+  InitFieldTrialsFromString("Trial/First/Trial/Second/");
+  EXPECT_EQ("First", FindFullName("Trial"));
+}
+
+TEST_F(FieldTrialDefaultTest, StopsAtMalformedTrial) {
+  InitFieldTrialsFromString("Trial1/Enabled/Trial2//Trial3/Enabled/");
+  EXPECT_EQ("Enabled", FindFullName("Trial1"));
+  EXPECT_EQ("", FindFullName("Trial2"));
+  EXPECT_EQ("", FindFullName("Trial3"));
+}
+
+TEST_F(FieldTrialDefaultTest, UsesLatestTrialsString) {
+  InitFieldTrialsFromString("Trial/Enabled/");
+  EXPECT_EQ("Enabled", FindFullName("Trial"));
+  InitFieldTrialsFromString("Trial/Disabled/");
+  EXPECT_EQ("Disabled", FindFullName("Trial"));
+  InitFieldTrialsFromString(nullptr);
+  EXPECT_EQ("", FindFullName("Trial"));
+  EXPECT_EQ(nullptr, GetFieldTrialString());
+}
+
+TEST_F(FieldTrialDefaultTest, ReusesTrialsOfSameString) {
+  std::string trials = "Trial/Enabled/";
+  for (int i = 0; i < 100; ++i) {
+    // A copy, as from a fuzzer building the string for each input.
+    const std::string copy = trials;
+    InitFieldTrialsFromString(copy.c_str());
+    EXPECT_EQ("Enabled", FindFullName("Trial"));
+    EXPECT_EQ(copy.c_str(), GetFieldTrialString());
+  }
+  InitFieldTrialsFromString(trials.c_str());
+}
+
+TEST_F(FieldTrialDefaultTest, ReplacesTrialsManyTimes) {
+  for (int i = 0; i < 100; ++i) {
+    const std::string trials = "Trial/Group" + std::to_string(i) + "/";
+    InitFieldTrialsFromString(trials.c_str());
+    EXPECT_EQ("Group" + std::to_string(i), FindFullName("Trial"));
+  }
+  InitFieldTrialsFromString(nullptr);
+}
+
+void LookUpTrialUntilStopped(void* obj) {
+  std::atomic<bool>* stop = static_cast<std::atomic<bool>*>(obj);
+  while (!stop->load()) {
+    const std::string group = FindFullName("Trial");
+    EXPECT_EQ(0u, group.find("Group"));
+  }
+}
+
+TEST_F(FieldTrialDefaultTest, ReplacesTrialsWhileLookedUpOnOtherThread) {
+  InitFieldTrialsFromString("Trial/Group/");
+  std::atomic<bool> stop(false);
+  rtc::PlatformThread thread(&LookUpTrialUntilStopped, &stop, "LookUpTrial");
+  thread.Start();
+  for (int i = 0; i < 1000; ++i) {
+    const std::string trials = "Trial/Group" + std::to_string(i) + "/";
+    InitFieldTrialsFromString(trials.c_str());
+  }
+  stop.store(true);
+  thread.Stop();
+  InitFieldTrialsFromString(nullptr);
+}
+
+}  // namespace
+}  // namespace field_trial
+}  // namespace webrtc
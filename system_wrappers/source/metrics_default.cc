@@ -10,9 +10,12 @@
 #include "system_wrappers/include/metrics_default.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 
-#include "rtc_base/criticalsection.h"
-#include "rtc_base/thread_annotations.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/constructormagic.h"
 #include "system_wrappers/include/metrics.h"
 
 // Default implementation of histogram methods for WebRTC clients that do not
@@ -28,145 +31,240 @@ namespace {
 // linearly/exponentially spaced buckets) if samples are logged more frequently.
 const int kMaxSampleMapSize = 300;
 
+// Size of the sample table of a histogram. A power of two, with room for
+// kMaxSampleMapSize values without long probe sequences.
+const size_t kSampleTableSize = 512;
+
+// Size of the histogram table. Histograms are never removed, so this bounds
+// the number of distinct histogram names; further ones aren't recorded.
+const size_t kHistogramTableSize = 8192;
+
+// Samples are added from media threads, so histograms are updated without
+// locks. Each slot of the sample table packs a sample value in its upper 32
+// bits and its number of events in the lower 32, and is updated with
+// compare-and-swap. A slot with no events is free. Slots are freed when the
+// samples are taken, which may leave a value in two slots of a probe
+// sequence; those are summed when read.
 class RtcHistogram {
  public:
   RtcHistogram(const std::string& name, int min, int max, int bucket_count)
       : min_(min), max_(max), info_(name, min, max, bucket_count) {
     RTC_DCHECK_GT(bucket_count, 0);
+    for (std::atomic<uint64_t>& slot : slots_)
+      slot.store(0, std::memory_order_relaxed);
   }
 
   void Add(int sample) {
     sample = std::min(sample, max_);
     sample = std::max(sample, min_ - 1);  // Underflow bucket.
 
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.size() == kMaxSampleMapSize &&
-        info_.samples.find(sample) == info_.samples.end()) {
-      return;
+    const uint32_t key = static_cast<uint32_t>(sample);
+    size_t index = (key * 0x9E3779B1u) % kSampleTableSize;
+    for (size_t probe = 0; probe < kSampleTableSize; ++probe) {
+      std::atomic<uint64_t>& slot = slots_[index];
+      uint64_t value = slot.load(std::memory_order_relaxed);
+      while (true) {
+        if (value == 0) {
+          // Reserves room for a new value before claiming the slot.
+          if (num_values_.fetch_add(1, std::memory_order_relaxed) >=
+              kMaxSampleMapSize) {
+            num_values_.fetch_sub(1, std::memory_order_relaxed);
+            return;
+          }
+          if (slot.compare_exchange_weak(value, Pack(key, 1),
+                                         std::memory_order_relaxed)) {
+            return;
+          }
+          num_values_.fetch_sub(1, std::memory_order_relaxed);
+          continue;
+        }
+        if (Key(value) != key)
+          break;
+        if (slot.compare_exchange_weak(value, value + 1,
+                                       std::memory_order_relaxed)) {
+          return;
+        }
+      }
+      index = (index + 1) % kSampleTableSize;
     }
-    ++info_.samples[sample];
   }
 
   // Returns a copy (or nullptr if there are no samples) and clears samples.
   std::unique_ptr<SampleInfo> GetAndReset() {
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.empty())
-      return nullptr;
-
-    SampleInfo* copy =
-        new SampleInfo(info_.name, info_.min, info_.max, info_.bucket_count);
-
-    std::swap(info_.samples, copy->samples);
-
-    return std::unique_ptr<SampleInfo>(copy);
+    std::unique_ptr<SampleInfo> copy;
+    for (std::atomic<uint64_t>& slot : slots_) {
+      const uint64_t value = slot.exchange(0, std::memory_order_relaxed);
+      if (value == 0)
+        continue;
+      num_values_.fetch_sub(1, std::memory_order_relaxed);
+      if (!copy) {
+        copy.reset(new SampleInfo(info_.name, info_.min, info_.max,
+                                  info_.bucket_count));
+      }
+      copy->samples[static_cast<int>(Key(value))] += Count(value);
+    }
+    return copy;
   }
 
   const std::string& name() const { return info_.name; }
 
   // Functions only for testing.
-  void Reset() {
-    rtc::CritScope cs(&crit_);
-    info_.samples.clear();
-  }
+  void Reset() { GetAndReset(); }
 
   int NumEvents(int sample) const {
-    rtc::CritScope cs(&crit_);
-    const auto it = info_.samples.find(sample);
-    return (it == info_.samples.end()) ? 0 : it->second;
+    int num_events = 0;
+    for (const std::atomic<uint64_t>& slot : slots_) {
+      const uint64_t value = slot.load(std::memory_order_relaxed);
+      if (value != 0 && static_cast<int>(Key(value)) == sample)
+        num_events += Count(value);
+    }
+    return num_events;
   }
 
   int NumSamples() const {
     int num_samples = 0;
-    rtc::CritScope cs(&crit_);
-    for (const auto& sample : info_.samples) {
-      num_samples += sample.second;
-    }
+    for (const std::atomic<uint64_t>& slot : slots_)
+      num_samples += Count(slot.load(std::memory_order_relaxed));
     return num_samples;
   }
 
   int MinSample() const {
-    rtc::CritScope cs(&crit_);
-    return (info_.samples.empty()) ? -1 : info_.samples.begin()->first;
+    bool found = false;
+    int min_sample = 0;
+    for (const std::atomic<uint64_t>& slot : slots_) {
+      const uint64_t value = slot.load(std::memory_order_relaxed);
+      if (value == 0)
+        continue;
+      const int sample = static_cast<int>(Key(value));
+      if (!found || sample < min_sample)
+        min_sample = sample;
+      found = true;
+    }
+    return found ? min_sample : -1;
   }
 
  private:
-  rtc::CriticalSection crit_;
+  static uint64_t Pack(uint32_t key, uint32_t count) {
+    return (static_cast<uint64_t>(key) << 32) | count;
+  }
+  static uint32_t Key(uint64_t value) {
+    return static_cast<uint32_t>(value >> 32);
+  }
+  static int Count(uint64_t value) {
+    return static_cast<int>(static_cast<uint32_t>(value));
+  }
+
   const int min_;
   const int max_;
-  SampleInfo info_ RTC_GUARDED_BY(crit_);
+  // Only the name and limits are used; samples live in |slots_|.
+  const SampleInfo info_;
+  std::atomic<uint64_t> slots_[kSampleTableSize];
+  std::atomic<int> num_values_{0};
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtcHistogram);
 };
 
+// Histograms are registered in an open addressing table of pointers, which are
+// set once with compare-and-swap, so looking up the histograms of the macros
+// with dynamic names takes no lock.
 class RtcHistogramMap {
  public:
-  RtcHistogramMap() {}
+  RtcHistogramMap() {
+    for (std::atomic<RtcHistogram*>& slot : slots_)
+      slot.store(nullptr, std::memory_order_relaxed);
+  }
   ~RtcHistogramMap() {}
 
   Histogram* GetCountsHistogram(const std::string& name,
                                 int min,
                                 int max,
                                 int bucket_count) {
-    rtc::CritScope cs(&crit_);
-    const auto& it = map_.find(name);
-    if (it != map_.end())
-      return reinterpret_cast<Histogram*>(it->second.get());
-
-    RtcHistogram* hist = new RtcHistogram(name, min, max, bucket_count);
-    map_[name].reset(hist);
-    return reinterpret_cast<Histogram*>(hist);
+    return reinterpret_cast<Histogram*>(
+        GetOrCreate(name, min, max, bucket_count));
   }
 
   Histogram* GetEnumerationHistogram(const std::string& name, int boundary) {
-    rtc::CritScope cs(&crit_);
-    const auto& it = map_.find(name);
-    if (it != map_.end())
-      return reinterpret_cast<Histogram*>(it->second.get());
-
-    RtcHistogram* hist = new RtcHistogram(name, 1, boundary, boundary + 1);
-    map_[name].reset(hist);
-    return reinterpret_cast<Histogram*>(hist);
+    return reinterpret_cast<Histogram*>(
+        GetOrCreate(name, 1, boundary, boundary + 1));
   }
 
   void GetAndReset(
       std::map<std::string, std::unique_ptr<SampleInfo>>* histograms) {
-    rtc::CritScope cs(&crit_);
-    for (const auto& kv : map_) {
-      std::unique_ptr<SampleInfo> info = kv.second->GetAndReset();
+    for (std::atomic<RtcHistogram*>& slot : slots_) {
+      RtcHistogram* hist = slot.load(std::memory_order_acquire);
+      if (!hist)
+        continue;
+      std::unique_ptr<SampleInfo> info = hist->GetAndReset();
       if (info)
-        histograms->insert(std::make_pair(kv.first, std::move(info)));
+        histograms->insert(std::make_pair(hist->name(), std::move(info)));
     }
   }
 
   // Functions only for testing.
   void Reset() {
-    rtc::CritScope cs(&crit_);
-    for (const auto& kv : map_)
-      kv.second->Reset();
+    for (std::atomic<RtcHistogram*>& slot : slots_) {
+      RtcHistogram* hist = slot.load(std::memory_order_acquire);
+      if (hist)
+        hist->Reset();
+    }
   }
 
   int NumEvents(const std::string& name, int sample) const {
-    rtc::CritScope cs(&crit_);
-    const auto& it = map_.find(name);
-    return (it == map_.end()) ? 0 : it->second->NumEvents(sample);
+    const RtcHistogram* hist = Find(name);
+    return hist ? hist->NumEvents(sample) : 0;
   }
 
   int NumSamples(const std::string& name) const {
-    rtc::CritScope cs(&crit_);
-    const auto& it = map_.find(name);
-    return (it == map_.end()) ? 0 : it->second->NumSamples();
+    const RtcHistogram* hist = Find(name);
+    return hist ? hist->NumSamples() : 0;
   }
 
   int MinSample(const std::string& name) const {
-    rtc::CritScope cs(&crit_);
-    const auto& it = map_.find(name);
-    return (it == map_.end()) ? -1 : it->second->MinSample();
+    const RtcHistogram* hist = Find(name);
+    return hist ? hist->MinSample() : -1;
   }
 
  private:
-  rtc::CriticalSection crit_;
-  std::map<std::string, std::unique_ptr<RtcHistogram>> map_
-      RTC_GUARDED_BY(crit_);
+  const RtcHistogram* Find(const std::string& name) const {
+    size_t index = std::hash<std::string>()(name) % kHistogramTableSize;
+    for (size_t probe = 0; probe < kHistogramTableSize; ++probe) {
+      const RtcHistogram* hist = slots_[index].load(std::memory_order_acquire);
+      if (!hist)
+        return nullptr;
+      if (hist->name() == name)
+        return hist;
+      index = (index + 1) % kHistogramTableSize;
+    }
+    return nullptr;
+  }
+
+  RtcHistogram* GetOrCreate(const std::string& name,
+                            int min,
+                            int max,
+                            int bucket_count) {
+    std::unique_ptr<RtcHistogram> new_hist;
+    size_t index = std::hash<std::string>()(name) % kHistogramTableSize;
+    for (size_t probe = 0; probe < kHistogramTableSize; ++probe) {
+      std::atomic<RtcHistogram*>& slot = slots_[index];
+      RtcHistogram* hist = slot.load(std::memory_order_acquire);
+      if (!hist) {
+        if (!new_hist)
+          new_hist.reset(new RtcHistogram(name, min, max, bucket_count));
+        if (slot.compare_exchange_strong(hist, new_hist.get(),
+                                         std::memory_order_acq_rel)) {
+          return new_hist.release();
+        }
+        // Another thread registered a histogram in the slot; |hist| is it.
+      }
+      if (hist->name() == name)
+        return hist;
+      index = (index + 1) % kHistogramTableSize;
+    }
+    RTC_NOTREACHED() << "Too many histograms.";
+    return nullptr;
+  }
+
+  std::atomic<RtcHistogram*> slots_[kHistogramTableSize];
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtcHistogramMap);
 };
@@ -9,6 +9,11 @@
  */
 
 #include "system_wrappers/include/metrics_default.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
 #include "system_wrappers/include/metrics.h"
 #include "test/gtest.h"
 
@@ -47,6 +52,16 @@ int NumEvents(const std::string& name,
 
   return it_sample->second;
 }
+
+const int kNumThreads = 4;
+const int kNumAddsPerThread = 10000;
+
+void AddSamples(void* /*obj*/) {
+  for (int i = 0; i < kNumAddsPerThread; ++i) {
+    RTC_HISTOGRAM_COUNTS_100("Concurrent", i % 10);
+    RTC_HISTOGRAM_COUNTS_SPARSE_100("Concurrent" + std::to_string(i % 3), 1);
+  }
+}
 }  // namespace
 
 class MetricsDefaultTest : public ::testing::Test {
@@ -158,4 +173,39 @@ TEST_F(MetricsDefaultTest, TestMinMaxBucket) {
   EXPECT_EQ(1u, histograms.begin()->second->samples.size());
 }
 
+TEST_F(MetricsDefaultTest, KeepsLimitedNumberOfSampleValues) {
+  const std::string kName = "DistinctValues";
+  for (int i = 0; i < 1000; ++i)
+    RTC_HISTOGRAM_COUNTS_10000(kName, i);
+  RTC_HISTOGRAM_COUNTS_10000(kName, 0);
+  EXPECT_EQ(301, metrics::NumSamples(kName));
+  EXPECT_EQ(2, metrics::NumEvents(kName, 0));
+  EXPECT_EQ(0, metrics::NumEvents(kName, 999));
+
+  // Taking the samples makes room for new values.
+  std::map<std::string, std::unique_ptr<metrics::SampleInfo>> histograms;
+  metrics::GetAndReset(&histograms);
+  EXPECT_EQ(300u, histograms[kName]->samples.size());
+  RTC_HISTOGRAM_COUNTS_10000(kName, 999);
+  EXPECT_EQ(1, metrics::NumEvents(kName, 999));
+}
+
+TEST_F(MetricsDefaultTest, AddsSamplesFromManyThreads) {
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back(
+        new rtc::PlatformThread(&AddSamples, nullptr, "AddSamples"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+
+  EXPECT_EQ(kNumThreads * kNumAddsPerThread,
+            metrics::NumSamples("Concurrent"));
+  EXPECT_EQ(kNumThreads * kNumAddsPerThread / 10,
+            metrics::NumEvents("Concurrent", 3));
+  EXPECT_EQ(kNumThreads * 3334, metrics::NumSamples("Concurrent0"));
+  EXPECT_EQ(kNumThreads * 3333, metrics::NumSamples("Concurrent1"));
+}
+
 }  // namespace webrtc
@@ -19,6 +19,7 @@
 #include "call/rtp_transport_controller_send.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
 #include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/l4s/l4s_factory.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/experiments/congestion_controller_experiment.h"
@@ -40,6 +41,7 @@ CallTest::CallTest()
       audio_send_config_(nullptr),
       audio_send_stream_(nullptr),
       bbr_network_controller_factory_(new BbrNetworkControllerFactory()),
+      l4s_network_controller_factory_(new L4sNetworkControllerFactory()),
       fake_encoder_factory_([this]() {
         auto encoder = absl::make_unique<test::FakeEncoder>(clock_);
         encoder->SetMaxBitrate(fake_encoder_max_bitrate_);
@@ -196,6 +198,9 @@ void CallTest::CreateSenderCall(const Call::Config& config) {
     if (CongestionControllerExperiment::BbrControllerEnabled()) {
       RTC_LOG(LS_INFO) << "Using BBR network controller factory";
       injected_factory = bbr_network_controller_factory_.get();
+    } else if (CongestionControllerExperiment::L4sControllerEnabled()) {
+      RTC_LOG(LS_INFO) << "Using L4S network controller factory";
+      injected_factory = l4s_network_controller_factory_.get();
     } else {
       RTC_LOG(LS_INFO) << "Using default network controller factory";
     }
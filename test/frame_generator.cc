@@ -13,13 +13,23 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <map>
 #include <memory>
+#include <utility>
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "api/video/i010_buffer.h"
 #include "api/video/i420_buffer.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
@@ -234,6 +244,119 @@ class YuvFileGenerator : public FrameGenerator {
   std::unique_ptr<VideoFrame> temp_frame_;
 };
 
+#if defined(WEBRTC_POSIX)
+// A yuv file mapped read-only into memory. All the generators of the process
+// playing the same file share its mapping, which is unmapped when the last
+// generator and the last frame wrapping it are gone.
+class MappedYuvFile {
+ public:
+  static std::shared_ptr<const MappedYuvFile> Open(
+      const std::string& filename) {
+    rtc::GlobalLockScope lock(&g_mapped_files_lock);
+    static auto* const mapped_files =
+        new std::map<std::string, std::weak_ptr<const MappedYuvFile>>();
+    std::shared_ptr<const MappedYuvFile> file =
+        (*mapped_files)[filename].lock();
+    if (file)
+      return file;
+
+    const int fd = open(filename.c_str(), O_RDONLY);
+    RTC_CHECK_GE(fd, 0) << "Failed to open " << filename;
+    struct stat file_stat;
+    RTC_CHECK_EQ(0, fstat(fd, &file_stat));
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    RTC_CHECK_GT(size, 0) << filename << " is empty";
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    RTC_CHECK(data != MAP_FAILED) << "Failed to map " << filename;
+
+    file.reset(new MappedYuvFile(static_cast<const uint8_t*>(data), size));
+    (*mapped_files)[filename] = file;
+    return file;
+  }
+
+  ~MappedYuvFile() { munmap(const_cast<uint8_t*>(data_), size_); }
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  MappedYuvFile(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  static rtc::GlobalLockPod g_mapped_files_lock;
+
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
+rtc::GlobalLockPod MappedYuvFile::g_mapped_files_lock;
+
+// Plays yuv files like YuvFileGenerator, but from their shared mappings, and
+// without copying: the frames wrap the mapped memory directly, and keep the
+// mapping alive until they're released.
+class MappedYuvFileGenerator : public FrameGenerator {
+ public:
+  MappedYuvFileGenerator(
+      std::vector<std::shared_ptr<const MappedYuvFile>> files,
+      size_t width,
+      size_t height,
+      int frame_repeat_count)
+      : files_(std::move(files)),
+        width_(static_cast<int>(width)),
+        height_(static_cast<int>(height)),
+        chroma_width_((width_ + 1) / 2),
+        chroma_height_((height_ + 1) / 2),
+        frame_size_(CalcBufferSize(VideoType::kI420, width_, height_)),
+        frame_display_count_(frame_repeat_count) {
+    RTC_DCHECK_GT(width, 0);
+    RTC_DCHECK_GT(height, 0);
+    RTC_DCHECK_GT(frame_repeat_count, 0);
+    for (const auto& file : files_)
+      RTC_CHECK_GE(file->size(), frame_size_);
+  }
+
+  VideoFrame* NextFrame() override {
+    if (current_display_count_ == 0)
+      WrapNextFrame();
+    if (++current_display_count_ >= frame_display_count_)
+      current_display_count_ = 0;
+
+    temp_frame_.reset(new VideoFrame(
+        last_buffer_, webrtc::kVideoRotation_0, 0 /* timestamp_us */));
+    return temp_frame_.get();
+  }
+
+ private:
+  void WrapNextFrame() {
+    if (next_frame_offset_ + frame_size_ > files_[file_index_]->size()) {
+      // No more frames in this file, move to the start of the next file.
+      file_index_ = (file_index_ + 1) % files_.size();
+      next_frame_offset_ = 0;
+    }
+    std::shared_ptr<const MappedYuvFile> file = files_[file_index_];
+    const uint8_t* y = file->data() + next_frame_offset_;
+    const uint8_t* u = y + width_ * height_;
+    const uint8_t* v = u + chroma_width_ * chroma_height_;
+    next_frame_offset_ += frame_size_;
+    last_buffer_ = WrapI420Buffer(width_, height_, y, width_, u, chroma_width_,
+                                  v, chroma_width_, [file] {});
+  }
+
+  const std::vector<std::shared_ptr<const MappedYuvFile>> files_;
+  const int width_;
+  const int height_;
+  const int chroma_width_;
+  const int chroma_height_;
+  const size_t frame_size_;
+  const int frame_display_count_;
+  int current_display_count_ = 0;
+  size_t file_index_ = 0;
+  size_t next_frame_offset_ = 0;
+  rtc::scoped_refptr<VideoFrameBuffer> last_buffer_;
+  std::unique_ptr<VideoFrame> temp_frame_;
+};
+#endif  // defined(WEBRTC_POSIX)
+
 // SlideGenerator works similarly to YuvFileGenerator but it fills the frames
 // with randomly sized and colored squares instead of reading their content
 // from files.
@@ -480,6 +603,25 @@ std::unique_ptr<FrameGenerator> FrameGenerator::CreateFromYuvFile(
       new YuvFileGenerator(files, width, height, frame_repeat_count));
 }
 
+std::unique_ptr<FrameGenerator> FrameGenerator::CreateFromMappedYuvFile(
+    std::vector<std::string> filenames,
+    size_t width,
+    size_t height,
+    int frame_repeat_count) {
+#if defined(WEBRTC_POSIX)
+  RTC_DCHECK(!filenames.empty());
+  std::vector<std::shared_ptr<const MappedYuvFile>> files;
+  for (const std::string& filename : filenames)
+    files.push_back(MappedYuvFile::Open(filename));
+
+  return std::unique_ptr<FrameGenerator>(new MappedYuvFileGenerator(
+      std::move(files), width, height, frame_repeat_count));
+#else
+  return CreateFromYuvFile(std::move(filenames), width, height,
+                           frame_repeat_count);
+#endif
+}
+
 std::unique_ptr<FrameGenerator>
 FrameGenerator::CreateScrollingInputFromYuvFiles(
     Clock* clock,
@@ -78,6 +78,18 @@ class FrameGenerator {
       size_t height,
       int frame_repeat_count);
 
+  // Like CreateFromYuvFile(), but memory-maps the files instead of reading
+  // them, and outputs frames that point into the mapping instead of copies.
+  // Generators of the same file share its mapping, so many senders can play
+  // large clips without each of them reading and holding the clips. The
+  // frames are read-only. Falls back to CreateFromYuvFile() where mapping
+  // isn't supported.
+  static std::unique_ptr<FrameGenerator> CreateFromMappedYuvFile(
+      std::vector<std::string> files,
+      size_t width,
+      size_t height,
+      int frame_repeat_count);
+
   // Creates a frame generator which takes a set of yuv files (wrapping a
   // frame generator created by CreateFromYuvFile() above), but outputs frames
   // that have been cropped to specified resolution: source_width/source_height
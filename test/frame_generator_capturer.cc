@@ -118,6 +118,23 @@ FrameGeneratorCapturer* FrameGeneratorCapturer::CreateFromYuvFile(
   return capturer.release();
 }
 
+FrameGeneratorCapturer* FrameGeneratorCapturer::CreateFromMappedYuvFile(
+    const std::string& file_name,
+    size_t width,
+    size_t height,
+    int target_fps,
+    Clock* clock) {
+  std::unique_ptr<FrameGeneratorCapturer> capturer(new FrameGeneratorCapturer(
+      clock,
+      FrameGenerator::CreateFromMappedYuvFile(
+          std::vector<std::string>(1, file_name), width, height, 1),
+      target_fps));
+  if (!capturer->Init())
+    return nullptr;
+
+  return capturer.release();
+}
+
 FrameGeneratorCapturer* FrameGeneratorCapturer::CreateSlideGenerator(
     int width,
     int height,
@@ -54,6 +54,16 @@ class FrameGeneratorCapturer : public VideoCapturer {
                                                    int target_fps,
                                                    Clock* clock);
 
+  // Like CreateFromYuvFile(), but plays the file from a memory mapping shared
+  // by all the capturers of the process, see
+  // FrameGenerator::CreateFromMappedYuvFile().
+  static FrameGeneratorCapturer* CreateFromMappedYuvFile(
+      const std::string& file_name,
+      size_t width,
+      size_t height,
+      int target_fps,
+      Clock* clock);
+
   static FrameGeneratorCapturer* CreateSlideGenerator(int width,
                                                       int height,
                                                       int frame_repeat_count,
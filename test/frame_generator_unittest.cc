@@ -165,6 +165,34 @@ TEST_F(FrameGeneratorTest, MultipleFrameFilesWithRepeat) {
   CheckFrameAndMutate(generator->NextFrame(), 0, 0, 0);
 }
 
+TEST_F(FrameGeneratorTest, MappedMultipleFrameFilesWithRepeat) {
+  const int kRepeatCount = 3;
+  std::vector<std::string> files;
+  files.push_back(two_frame_filename_);
+  files.push_back(one_frame_filename_);
+  std::unique_ptr<FrameGenerator> generator(
+      FrameGenerator::CreateFromMappedYuvFile(files, kFrameWidth, kFrameHeight,
+                                              kRepeatCount));
+  for (int i = 0; i < kRepeatCount; ++i)
+    CheckFrameAndMutate(generator->NextFrame(), 0, 0, 0);
+  for (int i = 0; i < kRepeatCount; ++i)
+    CheckFrameAndMutate(generator->NextFrame(), 127, 127, 127);
+  for (int i = 0; i < kRepeatCount; ++i)
+    CheckFrameAndMutate(generator->NextFrame(), 255, 255, 255);
+  CheckFrameAndMutate(generator->NextFrame(), 0, 0, 0);
+}
+
+TEST_F(FrameGeneratorTest, MappedFramesOutliveGenerator) {
+  std::unique_ptr<FrameGenerator> generator(
+      FrameGenerator::CreateFromMappedYuvFile(
+          std::vector<std::string>(1, two_frame_filename_), kFrameWidth,
+          kFrameHeight, 1));
+  generator->NextFrame();
+  VideoFrame frame = *generator->NextFrame();
+  generator.reset();
+  CheckFrameAndMutate(&frame, 127, 127, 127);
+}
+
 TEST_F(FrameGeneratorTest, SlideGenerator) {
   const int kGenCount = 9;
   const int kRepeatCount = 3;
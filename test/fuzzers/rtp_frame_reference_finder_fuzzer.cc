@@ -86,8 +86,9 @@ class FuzzyPacketBuffer : public video_coding::PacketBuffer {
     return packet;
   }
 
-  bool GetBitstream(const video_coding::RtpFrameObject& frame,
-                    uint8_t* destination) override {
+  bool TakeBitstream(const video_coding::RtpFrameObject& frame,
+                     std::vector<video_coding::RtpFrameObject::Fragment>*
+                         fragments) override {
     return true;
   }
 
@@ -0,0 +1,259 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/simulated_time_controller.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+#include "absl/memory/memory.h"
+#include "modules/include/module.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+constexpr int64_t kNever = std::numeric_limits<int64_t>::max();
+}  // namespace
+
+// Like ProcessThreadImpl, but runs its modules and tasks when the controller
+// advances the time instead of on a thread of its own.
+class SimulatedTimeController::SimulatedProcessThread : public ProcessThread {
+ public:
+  explicit SimulatedProcessThread(SimulatedTimeController* controller)
+      : controller_(controller) {}
+
+  ~SimulatedProcessThread() override {
+    {
+      rtc::CritScope lock(&lock_);
+      RTC_DCHECK(!running_);
+    }
+    controller_->RemoveProcessThread(this);
+  }
+
+  void Start() override {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(!running_);
+    running_ = true;
+    for (ModuleState& state : modules_) {
+      state.module->ProcessThreadAttached(this);
+      state.next_run_time_us = -1;
+    }
+  }
+
+  void Stop() override {
+    rtc::CritScope lock(&lock_);
+    if (!running_)
+      return;
+    running_ = false;
+    for (ModuleState& state : modules_)
+      state.module->ProcessThreadAttached(nullptr);
+    while (!queue_.empty())
+      queue_.pop();
+  }
+
+  void WakeUp(Module* module) override {
+    rtc::CritScope lock(&lock_);
+    for (ModuleState& state : modules_) {
+      if (state.module == module)
+        state.next_run_time_us = -1;
+    }
+  }
+
+  void PostTask(std::unique_ptr<rtc::QueuedTask> task) override {
+    rtc::CritScope lock(&lock_);
+    queue_.push(std::move(task));
+  }
+
+  void RegisterModule(Module* module, const rtc::Location& from) override {
+    rtc::CritScope lock(&lock_);
+    ModuleState state;
+    state.module = module;
+    modules_.push_back(state);
+    if (running_)
+      module->ProcessThreadAttached(this);
+  }
+
+  void DeRegisterModule(Module* module) override {
+    rtc::CritScope lock(&lock_);
+    auto it = std::find_if(
+        modules_.begin(), modules_.end(),
+        [module](const ModuleState& state) { return state.module == module; });
+    if (it == modules_.end())
+      return;
+    modules_.erase(it);
+    if (running_)
+      module->ProcessThreadAttached(nullptr);
+  }
+
+  int64_t NextRunTimeUs(int64_t now_us) {
+    rtc::CritScope lock(&lock_);
+    if (!running_)
+      return kNever;
+    if (!queue_.empty())
+      return now_us;
+    int64_t next_run_time_us = kNever;
+    for (ModuleState& state : modules_) {
+      if (state.next_run_time_us < 0)
+        state.next_run_time_us = NextProcessTimeUs(state.module, now_us);
+      next_run_time_us = std::min(next_run_time_us, state.next_run_time_us);
+    }
+    return next_run_time_us;
+  }
+
+  void Process(int64_t now_us) {
+    std::queue<std::unique_ptr<rtc::QueuedTask>> tasks;
+    {
+      rtc::CritScope lock(&lock_);
+      if (!running_)
+        return;
+      for (ModuleState& state : modules_) {
+        if (state.next_run_time_us < 0)
+          state.next_run_time_us = NextProcessTimeUs(state.module, now_us);
+        if (state.next_run_time_us > now_us)
+          continue;
+        state.module->Process();
+        state.next_run_time_us = NextProcessTimeUs(state.module, now_us);
+      }
+      std::swap(tasks, queue_);
+    }
+    while (!tasks.empty()) {
+      std::unique_ptr<rtc::QueuedTask> task = std::move(tasks.front());
+      tasks.pop();
+      if (!task->Run())
+        task.release();
+    }
+  }
+
+ private:
+  struct ModuleState {
+    Module* module = nullptr;
+    // When to call Process, or -1 to ask the module.
+    int64_t next_run_time_us = -1;
+  };
+
+  static int64_t NextProcessTimeUs(Module* module, int64_t now_us) {
+    return now_us + std::max<int64_t>(module->TimeUntilNextProcess(), 0) *
+                        rtc::kNumMicrosecsPerMillisec;
+  }
+
+  SimulatedTimeController* const controller_;
+  rtc::CriticalSection lock_;
+  bool running_ RTC_GUARDED_BY(lock_) = false;
+  std::vector<ModuleState> modules_ RTC_GUARDED_BY(lock_);
+  std::queue<std::unique_ptr<rtc::QueuedTask>> queue_ RTC_GUARDED_BY(lock_);
+};
+
+SimulatedTimeController::SimulatedTimeController(int64_t start_time_ms) {
+  fake_clock_.SetTimeMicros(start_time_ms * rtc::kNumMicrosecsPerMillisec);
+}
+
+SimulatedTimeController::~SimulatedTimeController() {
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(process_threads_.empty());
+}
+
+Clock* SimulatedTimeController::GetClock() const {
+  return Clock::GetRealTimeClock();
+}
+
+int64_t SimulatedTimeController::TimeMs() const {
+  return rtc::TimeMillis();
+}
+
+std::unique_ptr<ProcessThread> SimulatedTimeController::CreateProcessThread(
+    const char* name) {
+  auto process_thread = absl::make_unique<SimulatedProcessThread>(this);
+  rtc::CritScope lock(&lock_);
+  process_threads_.push_back(process_thread.get());
+  return std::move(process_thread);
+}
+
+void SimulatedTimeController::PostDelayedTask(Task task, int64_t delay_ms) {
+  const int64_t run_time_us =
+      rtc::TimeMicros() +
+      std::max<int64_t>(delay_ms, 0) * rtc::kNumMicrosecsPerMillisec;
+  rtc::CritScope lock(&lock_);
+  tasks_.emplace(std::make_pair(run_time_us, next_task_number_++),
+                 std::move(task));
+}
+
+void SimulatedTimeController::AdvanceTimeMs(int64_t duration_ms) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK_GE(duration_ms, 0);
+  const int64_t end_us =
+      rtc::TimeMicros() + duration_ms * rtc::kNumMicrosecsPerMillisec;
+  while (true) {
+    int64_t now_us = rtc::TimeMicros();
+    const int64_t next_run_time_us = NextRunTimeUs(now_us);
+    if (next_run_time_us > end_us)
+      break;
+    if (next_run_time_us > now_us) {
+      fake_clock_.SetTimeMicros(next_run_time_us);
+      now_us = next_run_time_us;
+    }
+    RunDueTasks(now_us);
+    std::vector<SimulatedProcessThread*> process_threads;
+    {
+      rtc::CritScope lock(&lock_);
+      process_threads = process_threads_;
+    }
+    for (SimulatedProcessThread* process_thread : process_threads)
+      process_thread->Process(now_us);
+  }
+  if (end_us > rtc::TimeMicros())
+    fake_clock_.SetTimeMicros(end_us);
+}
+
+int64_t SimulatedTimeController::NextRunTimeUs(int64_t now_us) {
+  std::vector<SimulatedProcessThread*> process_threads;
+  int64_t next_run_time_us = kNever;
+  {
+    rtc::CritScope lock(&lock_);
+    if (!tasks_.empty())
+      next_run_time_us = tasks_.begin()->first.first;
+    process_threads = process_threads_;
+  }
+  for (SimulatedProcessThread* process_thread : process_threads) {
+    next_run_time_us =
+        std::min(next_run_time_us, process_thread->NextRunTimeUs(now_us));
+  }
+  return next_run_time_us;
+}
+
+void SimulatedTimeController::RunDueTasks(int64_t now_us) {
+  while (true) {
+    Task task;
+    {
+      rtc::CritScope lock(&lock_);
+      if (tasks_.empty() || tasks_.begin()->first.first > now_us)
+        return;
+      task = std::move(tasks_.begin()->second);
+      tasks_.erase(tasks_.begin());
+    }
+    task();
+  }
+}
+
+void SimulatedTimeController::RemoveProcessThread(
+    SimulatedProcessThread* process_thread) {
+  rtc::CritScope lock(&lock_);
+  process_threads_.erase(std::remove(process_threads_.begin(),
+                                     process_threads_.end(), process_thread),
+                         process_threads_.end());
+}
+
+}  // namespace test
+}  // namespace webrtc
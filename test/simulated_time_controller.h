@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef TEST_SIMULATED_TIME_CONTROLLER_H_
+#define TEST_SIMULATED_TIME_CONTROLLER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "modules/utility/include/process_thread.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/fakeclock.h"
+#include "rtc_base/thread_checker.h"
+
+namespace webrtc {
+
+class Clock;
+
+namespace test {
+
+// Runs tasks and process threads on simulated time, so that tests of
+// components driven by them run as fast as the CPU allows and behave the same
+// on every run. While the controller exists the rtc clock is faked, so
+// Clock::GetRealTimeClock() and rtc::TimeMillis() return the simulated time.
+//
+// Nothing runs on its own. AdvanceTimeMs() runs everything that gets due, in
+// the order it gets due, on the calling thread, moving the clock to the time
+// each task or module is due at. Components may post tasks and wake up
+// process threads from other threads, but those are only run when the time is
+// advanced.
+class SimulatedTimeController {
+ public:
+  using Task = std::function<void()>;
+
+  explicit SimulatedTimeController(int64_t start_time_ms);
+  ~SimulatedTimeController();
+
+  // Reads the simulated time.
+  Clock* GetClock() const;
+  int64_t TimeMs() const;
+
+  // Returns a ProcessThread whose modules and tasks run on the simulated
+  // time, once it is started. It must be destroyed before the controller.
+  std::unique_ptr<ProcessThread> CreateProcessThread(const char* name);
+
+  // Runs |task| once the time has advanced by |delay_ms|. Tasks due at the
+  // same time run in posting order.
+  void PostTask(Task task) { PostDelayedTask(std::move(task), 0); }
+  void PostDelayedTask(Task task, int64_t delay_ms);
+
+  // Runs everything due in the next |duration_ms|, and leaves the clock at
+  // the end of it.
+  void AdvanceTimeMs(int64_t duration_ms);
+
+ private:
+  class SimulatedProcessThread;
+
+  // Returns the first time anything is due at, which is |now_us| if anything
+  // is due already.
+  int64_t NextRunTimeUs(int64_t now_us);
+  void RunDueTasks(int64_t now_us);
+  void RemoveProcessThread(SimulatedProcessThread* process_thread);
+
+  rtc::ThreadChecker thread_checker_;
+  rtc::ScopedFakeClock fake_clock_;
+
+  rtc::CriticalSection lock_;
+  // Keyed by the time the task is due and the order it was posted in.
+  std::map<std::pair<int64_t, uint64_t>, Task> tasks_ RTC_GUARDED_BY(lock_);
+  uint64_t next_task_number_ RTC_GUARDED_BY(lock_) = 0;
+  std::vector<SimulatedProcessThread*> process_threads_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_SIMULATED_TIME_CONTROLLER_H_
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/simulated_time_controller.h"
+
+#include <memory>
+#include <vector>
+
+#include "call/fake_network_pipe.h"
+#include "modules/include/module.h"
+#include "rtc_base/location.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+class PeriodicModule : public Module {
+ public:
+  explicit PeriodicModule(int64_t interval_ms) : interval_ms_(interval_ms) {}
+
+  int64_t TimeUntilNextProcess() override {
+    return last_process_time_ms_ + interval_ms_ - rtc::TimeMillis();
+  }
+  void Process() override {
+    last_process_time_ms_ = rtc::TimeMillis();
+    process_times_ms.push_back(last_process_time_ms_);
+  }
+
+  std::vector<int64_t> process_times_ms;
+
+ private:
+  const int64_t interval_ms_;
+  int64_t last_process_time_ms_ = rtc::TimeMillis();
+};
+
+class ArrivalTimeRecorder : public PacketReceiver {
+ public:
+  explicit ArrivalTimeRecorder(Clock* clock) : clock_(clock) {}
+
+  DeliveryStatus DeliverPacket(MediaType media_type,
+                               rtc::CopyOnWriteBuffer packet,
+                               int64_t packet_time_us) override {
+    arrival_times_ms.push_back(clock_->TimeInMilliseconds());
+    return DELIVERY_OK;
+  }
+  using PacketReceiver::DeliverPacket;
+
+  std::vector<int64_t> arrival_times_ms;
+
+ private:
+  Clock* const clock_;
+};
+
+}  // namespace
+
+TEST(SimulatedTimeControllerTest, RunsTasksAtTheirTimeInOrder) {
+  SimulatedTimeController time_controller(1000);
+  EXPECT_EQ(1000, time_controller.GetClock()->TimeInMilliseconds());
+  std::vector<int64_t> run_times_ms;
+  time_controller.PostDelayedTask(
+      [&] { run_times_ms.push_back(time_controller.TimeMs()); }, 20);
+  time_controller.PostDelayedTask(
+      [&] {
+        run_times_ms.push_back(time_controller.TimeMs());
+        time_controller.PostDelayedTask(
+            [&] { run_times_ms.push_back(time_controller.TimeMs()); }, 15);
+      },
+      10);
+
+  time_controller.AdvanceTimeMs(19);
+  EXPECT_EQ(std::vector<int64_t>({1010}), run_times_ms);
+  EXPECT_EQ(1019, rtc::TimeMillis());
+  time_controller.AdvanceTimeMs(10);
+  EXPECT_EQ(std::vector<int64_t>({1010, 1020, 1025}), run_times_ms);
+  EXPECT_EQ(1029, time_controller.TimeMs());
+}
+
+TEST(SimulatedTimeControllerTest, RunsProcessThreadOnSimulatedTime) {
+  SimulatedTimeController time_controller(0);
+  std::unique_ptr<ProcessThread> process_thread =
+      time_controller.CreateProcessThread("ProcessThread");
+  PeriodicModule module(10);
+  process_thread->RegisterModule(&module, RTC_FROM_HERE);
+  bool task_run = false;
+  process_thread->PostTask(rtc::NewClosure([&task_run] { task_run = true; }));
+
+  // Nothing runs before the thread is started.
+  time_controller.AdvanceTimeMs(100);
+  EXPECT_TRUE(module.process_times_ms.empty());
+  EXPECT_FALSE(task_run);
+
+  process_thread->Start();
+  // An hour of simulated time, which takes no time at all.
+  const int64_t start_time_ms = rtc::SystemTimeMillis();
+  time_controller.AdvanceTimeMs(3600 * 1000);
+  EXPECT_LT(rtc::SystemTimeMillis() - start_time_ms, 60 * 1000);
+  EXPECT_TRUE(task_run);
+  // The module was due before the thread started.
+  ASSERT_EQ(360001u, module.process_times_ms.size());
+  EXPECT_EQ(100, module.process_times_ms.front());
+  EXPECT_EQ(3600 * 1000 + 100, module.process_times_ms.back());
+
+  process_thread->Stop();
+  process_thread->DeRegisterModule(&module);
+}
+
+TEST(SimulatedTimeControllerTest, DeliversThroughFakeNetworkPipe) {
+  SimulatedTimeController time_controller(0);
+  std::unique_ptr<ProcessThread> process_thread =
+      time_controller.CreateProcessThread("NetworkProcessThread");
+  ArrivalTimeRecorder receiver(time_controller.GetClock());
+  FakeNetworkPipe::Config config;
+  config.queue_delay_ms = 50;
+  FakeNetworkPipe pipe(time_controller.GetClock(), config);
+  pipe.SetReceiver(&receiver);
+  process_thread->RegisterModule(&pipe, RTC_FROM_HERE);
+  process_thread->Start();
+
+  const uint8_t kPacket[] = {1, 2, 3};
+  for (int i = 0; i < 10; ++i) {
+    time_controller.PostDelayedTask(
+        [&] {
+          pipe.DeliverPacket(MediaType::VIDEO,
+                             rtc::CopyOnWriteBuffer(kPacket, sizeof(kPacket)),
+                             rtc::TimeMicros());
+          process_thread->WakeUp(&pipe);
+        },
+        i * 100);
+  }
+  time_controller.AdvanceTimeMs(1000);
+
+  ASSERT_EQ(10u, receiver.arrival_times_ms.size());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(i * 100 + 50, receiver.arrival_times_ms[i]);
+
+  process_thread->Stop();
+  process_thread->DeRegisterModule(&pipe);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -11,6 +11,7 @@
 #ifndef TEST_TESTSUPPORT_FRAME_READER_H_
 #define TEST_TESTSUPPORT_FRAME_READER_H_
 
+#include <stdint.h>
 #include <stdio.h>
 
 #include <string>
@@ -66,6 +67,11 @@ class YuvFrameReaderImpl : public FrameReader {
   const int height_;
   int number_of_frames_;
   FILE* input_file_;
+  // The input file mapped into memory, where supported. Frames are then
+  // copied out of the mapping instead of being read from |input_file_|.
+  const uint8_t* mapped_file_;
+  size_t mapped_file_size_;
+  size_t mapped_file_offset_;
 };
 
 }  // namespace test
@@ -10,6 +10,10 @@
 
 #include "test/testsupport/frame_reader.h"
 
+#if defined(WEBRTC_POSIX)
+#include <sys/mman.h>
+#endif
+
 #include "api/video/i420_buffer.h"
 #include "test/frame_utils.h"
 #include "test/testsupport/fileutils.h"
@@ -25,7 +29,10 @@ YuvFrameReaderImpl::YuvFrameReaderImpl(std::string input_filename,
       width_(width),
       height_(height),
       number_of_frames_(-1),
-      input_file_(nullptr) {}
+      input_file_(nullptr),
+      mapped_file_(nullptr),
+      mapped_file_size_(0),
+      mapped_file_offset_(0) {}
 
 YuvFrameReaderImpl::~YuvFrameReaderImpl() {
   Close();
@@ -54,6 +61,19 @@ bool YuvFrameReaderImpl::Init() {
   }
   number_of_frames_ =
       static_cast<int>(source_file_size / frame_length_in_bytes_);
+#if defined(WEBRTC_POSIX)
+  // Long clips are read many times over when codec settings are evaluated, so
+  // they're mapped rather than read a frame at a time. If mapping fails, the
+  // frames are read from the file.
+  void* mapped_file = mmap(nullptr, source_file_size, PROT_READ, MAP_PRIVATE,
+                           fileno(input_file_), 0);
+  if (mapped_file != MAP_FAILED) {
+    madvise(mapped_file, source_file_size, MADV_SEQUENTIAL);
+    mapped_file_ = static_cast<const uint8_t*>(mapped_file);
+    mapped_file_size_ = source_file_size;
+    mapped_file_offset_ = 0;
+  }
+#endif
   return true;
 }
 
@@ -63,6 +83,18 @@ rtc::scoped_refptr<I420Buffer> YuvFrameReaderImpl::ReadFrame() {
             "YuvFrameReaderImpl is not initialized (input file is NULL)\n");
     return nullptr;
   }
+  if (mapped_file_ != nullptr) {
+    if (mapped_file_size_ - mapped_file_offset_ < frame_length_in_bytes_)
+      return nullptr;
+    const int chroma_width = (width_ + 1) / 2;
+    const int chroma_height = (height_ + 1) / 2;
+    const uint8_t* data_y = mapped_file_ + mapped_file_offset_;
+    const uint8_t* data_u = data_y + width_ * height_;
+    const uint8_t* data_v = data_u + chroma_width * chroma_height;
+    mapped_file_offset_ += frame_length_in_bytes_;
+    return I420Buffer::Copy(width_, height_, data_y, width_, data_u,
+                            chroma_width, data_v, chroma_width);
+  }
   rtc::scoped_refptr<I420Buffer> buffer(
       ReadI420Buffer(width_, height_, input_file_));
   if (!buffer && ferror(input_file_)) {
@@ -73,6 +105,12 @@ rtc::scoped_refptr<I420Buffer> YuvFrameReaderImpl::ReadFrame() {
 }
 
 void YuvFrameReaderImpl::Close() {
+#if defined(WEBRTC_POSIX)
+  if (mapped_file_ != nullptr) {
+    munmap(const_cast<uint8_t*>(mapped_file_), mapped_file_size_);
+    mapped_file_ = nullptr;
+  }
+#endif
   if (input_file_ != nullptr) {
     fclose(input_file_);
     input_file_ = nullptr;
@@ -69,6 +69,9 @@ static void CodecSettings(VideoCodecType codec_type, VideoCodec* settings) {
           3 * kTestWidth * kTestHeight * 8 * kTestFrameRate / 1000 / 2;
       settings->maxBitrate = settings->startBitrate;
       return;
+    case kVideoCodecAV1:
+      settings->codecType = kVideoCodecAV1;
+      return;
     case kVideoCodecMultiplex:
     case kVideoCodecGeneric:
     case kVideoCodecUnknown:
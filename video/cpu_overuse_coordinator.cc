@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/cpu_overuse_coordinator.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+CpuOveruseCoordinator::CpuOveruseCoordinator(int num_cpu_cores)
+    : num_cpu_cores_(std::max(num_cpu_cores, 1)) {}
+
+CpuOveruseCoordinator::~CpuOveruseCoordinator() {
+  RTC_DCHECK(streams_.empty());
+  RTC_DCHECK(load_usage_percent_.empty());
+}
+
+void CpuOveruseCoordinator::AddStream(StreamId stream, double priority) {
+  RTC_DCHECK_GT(priority, 0.0);
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(streams_.find(stream) == streams_.end());
+  streams_[stream].priority = priority;
+}
+
+void CpuOveruseCoordinator::RemoveStream(StreamId stream) {
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(streams_.find(stream) != streams_.end());
+  streams_.erase(stream);
+}
+
+int CpuOveruseCoordinator::UpdateUsage(StreamId stream, int usage_percent) {
+  rtc::CritScope lock(&lock_);
+  auto it = streams_.find(stream);
+  RTC_DCHECK(it != streams_.end());
+  it->second.usage_percent = usage_percent;
+  return *TotalUsagePercentLocked();
+}
+
+void CpuOveruseCoordinator::UpdateLoad(StreamId load,
+                                       absl::optional<int> usage_percent) {
+  rtc::CritScope lock(&lock_);
+  if (usage_percent)
+    load_usage_percent_[load] = *usage_percent;
+  else
+    load_usage_percent_.erase(load);
+}
+
+absl::optional<int> CpuOveruseCoordinator::TotalUsagePercent() const {
+  rtc::CritScope lock(&lock_);
+  return TotalUsagePercentLocked();
+}
+
+absl::optional<int> CpuOveruseCoordinator::TotalUsagePercentLocked() const {
+  bool measured = false;
+  int total_usage_percent = 0;
+  for (const auto& entry : streams_) {
+    if (!entry.second.usage_percent)
+      continue;
+    measured = true;
+    total_usage_percent += *entry.second.usage_percent;
+  }
+  for (const auto& entry : load_usage_percent_) {
+    measured = true;
+    total_usage_percent += entry.second;
+  }
+  if (!measured)
+    return absl::nullopt;
+  return total_usage_percent / num_cpu_cores_;
+}
+
+bool CpuOveruseCoordinator::IsNextToAdaptDown(StreamId stream) const {
+  rtc::CritScope lock(&lock_);
+  StreamId next = nullptr;
+  double lowest_priority = 0.0;
+  int highest_usage_percent = 0;
+  for (const auto& entry : streams_) {
+    const StreamState& state = entry.second;
+    if (!state.usage_percent)
+      continue;
+    double priority = state.priority * (state.num_adaptations + 1);
+    // Of equally important streams, the one using the most CPU adapts.
+    if (!next || priority < lowest_priority ||
+        (priority == lowest_priority &&
+         *state.usage_percent > highest_usage_percent)) {
+      next = entry.first;
+      lowest_priority = priority;
+      highest_usage_percent = *state.usage_percent;
+    }
+  }
+  return next && next == stream;
+}
+
+bool CpuOveruseCoordinator::IsNextToAdaptUp(StreamId stream) const {
+  rtc::CritScope lock(&lock_);
+  StreamId next = nullptr;
+  double highest_priority = 0.0;
+  for (const auto& entry : streams_) {
+    const StreamState& state = entry.second;
+    if (state.num_adaptations == 0)
+      continue;
+    // The priority the stream had when it last adapted down.
+    double priority = state.priority * state.num_adaptations;
+    if (!next || priority > highest_priority) {
+      next = entry.first;
+      highest_priority = priority;
+    }
+  }
+  return next && next == stream;
+}
+
+void CpuOveruseCoordinator::OnAdaptedDown(StreamId stream) {
+  rtc::CritScope lock(&lock_);
+  auto it = streams_.find(stream);
+  RTC_DCHECK(it != streams_.end());
+  ++it->second.num_adaptations;
+}
+
+void CpuOveruseCoordinator::OnAdaptedUp(StreamId stream) {
+  rtc::CritScope lock(&lock_);
+  auto it = streams_.find(stream);
+  RTC_DCHECK(it != streams_.end());
+  if (it->second.num_adaptations > 0)
+    --it->second.num_adaptations;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_CPU_OVERUSE_COORDINATOR_H_
+#define VIDEO_CPU_OVERUSE_COORDINATOR_H_
+
+#include <map>
+
+#include "absl/types/optional.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares the CPU between the encoders of many video send streams. Every
+// OveruseFrameDetector only sees the encode time of its own stream, relative
+// to the frame interval, so with one stream per encoder thread each of them
+// may stay below its overuse threshold while together they use more CPU than
+// there is. Then, once the machine can't keep up, all streams overuse at the
+// same time and all of them adapt down.
+//
+// The detectors of the streams report their encode usage here, and overuse
+// is checked against the usage of all streams, spread over the CPU cores.
+// Only one stream adapts down per overuse: the one with the lowest priority
+// times the number of times it has adapted down plus one. So the least
+// important streams adapt first, and a stream with twice the priority of
+// another adapts half as often. Adapting back up is done in reverse order.
+//
+// Work that takes CPU but doesn't adapt for it here, like decoding the video
+// receive streams, reports its usage as a load. Loads count toward the usage
+// of all streams, so the send streams make room for them.
+//
+// All methods may be called from any thread.
+class CpuOveruseCoordinator {
+ public:
+  // Identifies a stream; the address of the stream's detector.
+  using StreamId = const void*;
+
+  explicit CpuOveruseCoordinator(int num_cpu_cores);
+  ~CpuOveruseCoordinator();
+
+  // |priority| is relative to the other streams and must be positive, like
+  // the bitrate priority of a stream.
+  void AddStream(StreamId stream, double priority);
+  void RemoveStream(StreamId stream);
+
+  // Stores the latest encode usage of |stream|, in percent of one core, and
+  // returns the usage of all streams and loads in percent of all cores.
+  int UpdateUsage(StreamId stream, int usage_percent);
+
+  // Stores the latest usage of |load|, in percent of one core. An unset
+  // |usage_percent| removes the load.
+  void UpdateLoad(StreamId load, absl::optional<int> usage_percent);
+
+  // The usage of all streams and loads in percent of all cores, unset if none
+  // has been measured.
+  absl::optional<int> TotalUsagePercent() const;
+
+  // Returns true if |stream| is the one to adapt down for the next overuse.
+  // Streams without a measured usage don't adapt.
+  bool IsNextToAdaptDown(StreamId stream) const;
+  // Returns true if |stream| has adapted down for CPU and is the one to adapt
+  // up for the next underuse.
+  bool IsNextToAdaptUp(StreamId stream) const;
+
+  void OnAdaptedDown(StreamId stream);
+  void OnAdaptedUp(StreamId stream);
+
+ private:
+  struct StreamState {
+    double priority = 1.0;
+    absl::optional<int> usage_percent;
+    int num_adaptations = 0;
+  };
+
+  absl::optional<int> TotalUsagePercentLocked() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const int num_cpu_cores_;
+  rtc::CriticalSection lock_;
+  std::map<StreamId, StreamState> streams_ RTC_GUARDED_BY(lock_);
+  std::map<StreamId, int> load_usage_percent_ RTC_GUARDED_BY(lock_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(CpuOveruseCoordinator);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_CPU_OVERUSE_COORDINATOR_H_
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/cpu_overuse_coordinator.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int kLowPriorityStream = 1;
+const int kHighPriorityStream = 2;
+const CpuOveruseCoordinator::StreamId kLow = &kLowPriorityStream;
+const CpuOveruseCoordinator::StreamId kHigh = &kHighPriorityStream;
+
+}  // namespace
+
+TEST(CpuOveruseCoordinatorTest, SpreadsUsageOverCores) {
+  CpuOveruseCoordinator coordinator(2);
+  coordinator.AddStream(kLow, 1.0);
+  coordinator.AddStream(kHigh, 2.0);
+  EXPECT_EQ(30, coordinator.UpdateUsage(kLow, 60));
+  EXPECT_EQ(70, coordinator.UpdateUsage(kHigh, 80));
+  EXPECT_EQ(60, coordinator.UpdateUsage(kLow, 40));
+  coordinator.RemoveStream(kLow);
+  EXPECT_EQ(40, coordinator.UpdateUsage(kHigh, 80));
+  coordinator.RemoveStream(kHigh);
+}
+
+TEST(CpuOveruseCoordinatorTest, CountsLoadsTowardUsage) {
+  CpuOveruseCoordinator coordinator(2);
+  EXPECT_FALSE(coordinator.TotalUsagePercent());
+  coordinator.AddStream(kLow, 1.0);
+  int decode_load;
+  coordinator.UpdateLoad(&decode_load, 100);
+  EXPECT_EQ(50, coordinator.TotalUsagePercent());
+  EXPECT_EQ(80, coordinator.UpdateUsage(kLow, 60));
+  // Loads don't adapt.
+  EXPECT_TRUE(coordinator.IsNextToAdaptDown(kLow));
+  coordinator.UpdateLoad(&decode_load, absl::nullopt);
+  EXPECT_EQ(30, coordinator.TotalUsagePercent());
+  coordinator.RemoveStream(kLow);
+}
+
+TEST(CpuOveruseCoordinatorTest, StreamsWithoutUsageDontAdapt) {
+  CpuOveruseCoordinator coordinator(1);
+  coordinator.AddStream(kLow, 1.0);
+  coordinator.AddStream(kHigh, 2.0);
+  coordinator.UpdateUsage(kHigh, 50);
+  EXPECT_FALSE(coordinator.IsNextToAdaptDown(kLow));
+  EXPECT_TRUE(coordinator.IsNextToAdaptDown(kHigh));
+  coordinator.RemoveStream(kLow);
+  coordinator.RemoveStream(kHigh);
+}
+
+TEST(CpuOveruseCoordinatorTest, AdaptsLeastImportantStreamFirst) {
+  CpuOveruseCoordinator coordinator(1);
+  coordinator.AddStream(kLow, 1.0);
+  coordinator.AddStream(kHigh, 2.5);
+  coordinator.UpdateUsage(kLow, 50);
+  coordinator.UpdateUsage(kHigh, 50);
+
+  // The low priority stream adapts until its priority times the number of
+  // adaptations is above the priority of the other stream.
+  EXPECT_TRUE(coordinator.IsNextToAdaptDown(kLow));
+  EXPECT_FALSE(coordinator.IsNextToAdaptDown(kHigh));
+  coordinator.OnAdaptedDown(kLow);
+  EXPECT_TRUE(coordinator.IsNextToAdaptDown(kLow));
+  coordinator.OnAdaptedDown(kLow);
+  EXPECT_TRUE(coordinator.IsNextToAdaptDown(kHigh));
+  coordinator.OnAdaptedDown(kHigh);
+  EXPECT_TRUE(coordinator.IsNextToAdaptDown(kLow));
+
+  // Adapting up restores the high priority stream first.
+  EXPECT_TRUE(coordinator.IsNextToAdaptUp(kHigh));
+  EXPECT_FALSE(coordinator.IsNextToAdaptUp(kLow));
+  coordinator.OnAdaptedUp(kHigh);
+  EXPECT_TRUE(coordinator.IsNextToAdaptUp(kLow));
+  coordinator.OnAdaptedUp(kLow);
+  EXPECT_TRUE(coordinator.IsNextToAdaptUp(kLow));
+  coordinator.OnAdaptedUp(kLow);
+  EXPECT_FALSE(coordinator.IsNextToAdaptUp(kLow));
+  EXPECT_FALSE(coordinator.IsNextToAdaptUp(kHigh));
+
+  coordinator.RemoveStream(kLow);
+  coordinator.RemoveStream(kHigh);
+}
+
+TEST(CpuOveruseCoordinatorTest, AdaptsStreamUsingMostCpuOfEqualPriority) {
+  CpuOveruseCoordinator coordinator(1);
+  coordinator.AddStream(kLow, 1.0);
+  coordinator.AddStream(kHigh, 1.0);
+  coordinator.UpdateUsage(kLow, 20);
+  coordinator.UpdateUsage(kHigh, 70);
+  EXPECT_TRUE(coordinator.IsNextToAdaptDown(kHigh));
+  EXPECT_FALSE(coordinator.IsNextToAdaptDown(kLow));
+  coordinator.RemoveStream(kLow);
+  coordinator.RemoveStream(kHigh);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,222 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_pool.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/timeutils.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+// Streams are expected to ask to be called well before this; it only bounds
+// the sleep of a thread without streams.
+const int64_t kMaxWaitMs = 1000 * 60;
+}  // namespace
+
+class DecodePool::DecodeThread {
+ public:
+  explicit DecodeThread(const std::string& name)
+      : wake_up_(false, false),
+        stream_done_(false, false),
+        thread_(&DecodeThread::Run,
+                this,
+                name.c_str(),
+                rtc::kHighestPriority) {
+    thread_.Start();
+  }
+
+  ~DecodeThread() {
+    {
+      rtc::CritScope lock(&lock_);
+      RTC_DCHECK(next_run_ms_.empty());
+      stop_ = true;
+    }
+    wake_up_.Set();
+    thread_.Stop();
+  }
+
+  void AddStream(Stream* stream) {
+    {
+      rtc::CritScope lock(&lock_);
+      int64_t now_ms = rtc::TimeMillis();
+      RTC_DCHECK(next_run_ms_.find(stream) == next_run_ms_.end());
+      next_run_ms_[stream] = now_ms;
+      schedule_.emplace(now_ms, stream);
+    }
+    wake_up_.Set();
+  }
+
+  void RemoveStream(Stream* stream) {
+    bool running;
+    {
+      rtc::CritScope lock(&lock_);
+      auto it = next_run_ms_.find(stream);
+      RTC_DCHECK(it != next_run_ms_.end());
+      running = running_ == stream;
+      // A running stream is not in |schedule_|, and won't be put back once
+      // it's gone from |next_run_ms_|.
+      if (!running)
+        schedule_.erase(std::make_pair(it->second, stream));
+      next_run_ms_.erase(it);
+    }
+    if (running)
+      stream_done_.Wait(rtc::Event::kForever);
+  }
+
+  void WakeUp(Stream* stream) {
+    {
+      rtc::CritScope lock(&lock_);
+      if (running_ == stream) {
+        wake_up_running_ = true;
+        return;
+      }
+      auto it = next_run_ms_.find(stream);
+      if (it == next_run_ms_.end())
+        return;
+      int64_t now_ms = rtc::TimeMillis();
+      if (it->second <= now_ms)
+        return;
+      schedule_.erase(std::make_pair(it->second, stream));
+      it->second = now_ms;
+      schedule_.emplace(now_ms, stream);
+    }
+    wake_up_.Set();
+  }
+
+ private:
+  static void Run(void* obj) {
+    while (static_cast<DecodeThread*>(obj)->Process()) {
+    }
+  }
+
+  bool Process() {
+    Stream* stream = nullptr;
+    int64_t wait_ms = kMaxWaitMs;
+    {
+      rtc::CritScope lock(&lock_);
+      if (stop_)
+        return false;
+      int64_t now_ms = rtc::TimeMillis();
+      if (!schedule_.empty() && schedule_.begin()->first <= now_ms) {
+        stream = schedule_.begin()->second;
+        schedule_.erase(schedule_.begin());
+        running_ = stream;
+        wake_up_running_ = false;
+      } else if (!schedule_.empty()) {
+        wait_ms = schedule_.begin()->first - now_ms;
+      }
+    }
+
+    if (!stream) {
+      wake_up_.Wait(static_cast<int>(wait_ms));
+      return true;
+    }
+
+    // Decoding is done without holding |lock_|, so that frames arriving for
+    // the streams of this thread can wake them up meanwhile.
+    int64_t delay_ms;
+    {
+      TRACE_EVENT0("webrtc", "DecodePool::DecodeNextFrame");
+      delay_ms = stream->DecodeNextFrame();
+    }
+
+    rtc::CritScope lock(&lock_);
+    running_ = nullptr;
+    auto it = next_run_ms_.find(stream);
+    if (it == next_run_ms_.end()) {
+      // Removed while running.
+      stream_done_.Set();
+      return true;
+    }
+    int64_t now_ms = rtc::TimeMillis();
+    it->second =
+        wake_up_running_ ? now_ms : now_ms + std::max<int64_t>(delay_ms, 0);
+    schedule_.emplace(it->second, stream);
+    return true;
+  }
+
+  // Signaled when a stream is added or woken up.
+  rtc::Event wake_up_;
+  // Signaled when a stream that was removed while running returns.
+  rtc::Event stream_done_;
+
+  rtc::CriticalSection lock_;
+  // The streams that are not currently running, ordered by when they're due.
+  std::set<std::pair<int64_t, Stream*>> schedule_ RTC_GUARDED_BY(lock_);
+  // The time each stream is scheduled at, to find it in |schedule_|.
+  std::unordered_map<Stream*, int64_t> next_run_ms_ RTC_GUARDED_BY(lock_);
+  Stream* running_ RTC_GUARDED_BY(lock_) = nullptr;
+  bool wake_up_running_ RTC_GUARDED_BY(lock_) = false;
+  bool stop_ RTC_GUARDED_BY(lock_) = false;
+
+  rtc::PlatformThread thread_;
+};
+
+DecodePool::DecodePool(size_t num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.push_back(absl::make_unique<DecodeThread>(
+        "DecodePool" + std::to_string(i)));
+  }
+  num_streams_.resize(num_threads, 0);
+}
+
+DecodePool::~DecodePool() {
+  RTC_DCHECK(stream_threads_.empty());
+}
+
+void DecodePool::AddStream(Stream* stream) {
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(stream_threads_.find(stream) == stream_threads_.end());
+  size_t index = std::min_element(num_streams_.begin(), num_streams_.end()) -
+                 num_streams_.begin();
+  ++num_streams_[index];
+  stream_threads_[stream] = index;
+  threads_[index]->AddStream(stream);
+}
+
+void DecodePool::RemoveStream(Stream* stream) {
+  DecodeThread* thread;
+  {
+    rtc::CritScope lock(&lock_);
+    auto it = stream_threads_.find(stream);
+    RTC_DCHECK(it != stream_threads_.end());
+    --num_streams_[it->second];
+    thread = threads_[it->second].get();
+    stream_threads_.erase(it);
+  }
+  // Not holding |lock_| while waiting for the stream to return, so that the
+  // other threads aren't held up.
+  thread->RemoveStream(stream);
+}
+
+void DecodePool::WakeUp(Stream* stream) {
+  // Holding |lock_| so that |stream| can't be removed while it's woken up.
+  rtc::CritScope lock(&lock_);
+  auto it = stream_threads_.find(stream);
+  if (it != stream_threads_.end())
+    threads_[it->second]->WakeUp(stream);
+}
+
+size_t DecodePool::NumStreamsForTesting() const {
+  rtc::CritScope lock(&lock_);
+  return stream_threads_.size();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_POOL_H_
+#define VIDEO_DECODE_POOL_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// A fixed set of threads that decode the frames of many video receive
+// streams, instead of every stream running its own decode thread. Meant for
+// endpoints receiving hundreds of streams, e.g. an SFU that transcodes or
+// records, where one OS thread per stream costs more in memory and context
+// switches than the decoding itself.
+//
+// Each stream is pinned to the thread with the fewest streams when it is
+// added, so a stream is always decoded on the same thread and the decoder and
+// the thread checkers of the stream don't see a change of thread. The threads
+// keep their streams ordered by when they next want to run and sleep until the
+// earliest one is due or a stream is woken up.
+//
+// All methods may be called from any thread except the pool threads.
+class DecodePool {
+ public:
+  class Stream {
+   public:
+    // Called on the stream's pool thread when it is due. Decodes at most one
+    // frame and returns the time in ms until the stream wants to be called
+    // again, unless it is woken up before that.
+    virtual int64_t DecodeNextFrame() = 0;
+
+   protected:
+    virtual ~Stream() = default;
+  };
+
+  explicit DecodePool(size_t num_threads);
+  ~DecodePool();
+
+  // |stream| is called for the first time right away.
+  void AddStream(Stream* stream);
+  // Blocks while |stream| is being called, so the stream may be destroyed
+  // once this returns.
+  void RemoveStream(Stream* stream);
+  // Calls |stream| as soon as possible. If it is currently being called, it is
+  // called again right after. Ignored for streams that aren't added.
+  void WakeUp(Stream* stream);
+
+  size_t NumStreamsForTesting() const;
+
+ private:
+  class DecodeThread;
+
+  std::vector<std::unique_ptr<DecodeThread>> threads_;
+
+  rtc::CriticalSection lock_;
+  // The index of the thread of each stream in |threads_|.
+  std::unordered_map<Stream*, size_t> stream_threads_ RTC_GUARDED_BY(lock_);
+  std::vector<size_t> num_streams_ RTC_GUARDED_BY(lock_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DecodePool);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_POOL_H_
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int kEventWaitTimeout = 500;
+
+// Asks to be called every |interval_ms| and signals |event_| on each call from
+// the |signal_at|:th on.
+class FakeStream : public DecodePool::Stream {
+ public:
+  explicit FakeStream(int64_t interval_ms, int signal_at = 1)
+      : interval_ms_(interval_ms), signal_at_(signal_at) {}
+
+  int64_t DecodeNextFrame() override {
+    rtc::PlatformThreadRef current = rtc::CurrentThreadRef();
+    if (call_count_ == 0)
+      thread_ = current;
+    else if (!rtc::IsThreadRefEqual(thread_, current))
+      changed_thread_ = true;
+    rtc::Event* block = block_;
+    if (block) {
+      blocked_.Set();
+      block->Wait(rtc::Event::kForever);
+    }
+    if (++call_count_ >= signal_at_)
+      event_.Set();
+    return interval_ms_;
+  }
+
+  int call_count() const { return call_count_; }
+  bool changed_thread() const { return changed_thread_; }
+  bool Wait() { return event_.Wait(kEventWaitTimeout); }
+  bool WaitBlocked() { return blocked_.Wait(kEventWaitTimeout); }
+  // Makes the next calls block until |block| is signaled.
+  void set_block(rtc::Event* block) { block_ = block; }
+
+ private:
+  const int64_t interval_ms_;
+  const int signal_at_;
+  std::atomic<int> call_count_{0};
+  std::atomic<bool> changed_thread_{false};
+  std::atomic<rtc::Event*> block_{nullptr};
+  rtc::PlatformThreadRef thread_;
+  rtc::Event event_{false, false};
+  rtc::Event blocked_{false, false};
+};
+
+struct RemoveArgs {
+  DecodePool* pool;
+  DecodePool::Stream* stream;
+  rtc::Event removed{false, false};
+};
+
+void RemoveStream(void* obj) {
+  RemoveArgs* args = static_cast<RemoveArgs*>(obj);
+  args->pool->RemoveStream(args->stream);
+  args->removed.Set();
+}
+
+}  // namespace
+
+TEST(DecodePoolTest, CallsStreamsAtTheirOwnDeadlines) {
+  DecodePool pool(1);
+  FakeStream fast(5);
+  FakeStream slow(50, 3);
+  const int64_t start_ms = rtc::TimeMillis();
+  pool.AddStream(&fast);
+  pool.AddStream(&slow);
+
+  EXPECT_TRUE(slow.Wait());
+  const int64_t elapsed_ms = rtc::TimeMillis() - start_ms;
+  const int fast_count = fast.call_count();
+  pool.RemoveStream(&fast);
+  pool.RemoveStream(&slow);
+
+  EXPECT_GE(elapsed_ms, 100);
+  // The fast stream is not called more often than it asks for, and the slow
+  // one doesn't hold it back.
+  EXPECT_LE(fast_count, elapsed_ms / 5 + 1);
+  EXPECT_GE(fast_count, 2 * 5);
+}
+
+TEST(DecodePoolTest, WakeUpCallsStreamRightAway) {
+  DecodePool pool(2);
+  FakeStream stream(60 * 1000);
+  pool.AddStream(&stream);
+  ASSERT_TRUE(stream.Wait());
+  pool.WakeUp(&stream);
+  EXPECT_TRUE(stream.Wait());
+  pool.RemoveStream(&stream);
+  EXPECT_EQ(2, stream.call_count());
+}
+
+TEST(DecodePoolTest, WakeUpWhileRunningCallsStreamAgain) {
+  DecodePool pool(1);
+  rtc::Event block(false, false);
+  FakeStream stream(60 * 1000, 2);
+  stream.set_block(&block);
+  pool.AddStream(&stream);
+  ASSERT_TRUE(stream.WaitBlocked());
+  pool.WakeUp(&stream);
+  stream.set_block(nullptr);
+  block.Set();
+  EXPECT_TRUE(stream.Wait());
+  pool.RemoveStream(&stream);
+}
+
+TEST(DecodePoolTest, RemoveStreamWaitsForRunningStream) {
+  DecodePool pool(1);
+  rtc::Event block(false, false);
+  FakeStream stream(1);
+  stream.set_block(&block);
+  pool.AddStream(&stream);
+  ASSERT_TRUE(stream.WaitBlocked());
+
+  RemoveArgs args;
+  args.pool = &pool;
+  args.stream = &stream;
+  rtc::PlatformThread remover(&RemoveStream, &args, "Remover");
+  remover.Start();
+  EXPECT_FALSE(args.removed.Wait(20));
+  EXPECT_EQ(0u, pool.NumStreamsForTesting());
+
+  block.Set();
+  EXPECT_TRUE(args.removed.Wait(kEventWaitTimeout));
+  remover.Stop();
+  EXPECT_EQ(1, stream.call_count());
+}
+
+TEST(DecodePoolTest, SpreadsStreamsOverThreadsAndKeepsThemThere) {
+  DecodePool pool(4);
+  std::vector<std::unique_ptr<FakeStream>> streams;
+  for (int i = 0; i < 100; ++i) {
+    streams.push_back(absl::make_unique<FakeStream>(1, 20));
+    pool.AddStream(streams.back().get());
+  }
+  EXPECT_EQ(100u, pool.NumStreamsForTesting());
+  for (auto& stream : streams)
+    EXPECT_TRUE(stream->Wait());
+
+  std::vector<int> counts;
+  for (size_t i = 0; i < streams.size(); i += 2) {
+    pool.RemoveStream(streams[i].get());
+    counts.push_back(streams[i]->call_count());
+  }
+  EXPECT_EQ(50u, pool.NumStreamsForTesting());
+
+  // Streams added after removing others go to the emptiest threads.
+  FakeStream marker(1, 20);
+  pool.AddStream(&marker);
+  EXPECT_TRUE(marker.Wait());
+
+  for (size_t i = 0; i < streams.size(); i += 2)
+    EXPECT_EQ(counts[i / 2], streams[i]->call_count());
+  for (size_t i = 1; i < streams.size(); i += 2)
+    pool.RemoveStream(streams[i].get());
+  pool.RemoveStream(&marker);
+
+  for (auto& stream : streams)
+    EXPECT_FALSE(stream->changed_thread());
+  EXPECT_FALSE(marker.changed_thread());
+}
+
+}  // namespace webrtc
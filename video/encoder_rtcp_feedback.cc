@@ -10,6 +10,8 @@
 
 #include "video/encoder_rtcp_feedback.h"
 
+#include <algorithm>
+
 #include "api/video/video_stream_encoder_interface.h"
 #include "rtc_base/checks.h"
 
@@ -23,7 +25,7 @@ EncoderRtcpFeedback::EncoderRtcpFeedback(Clock* clock,
     : clock_(clock),
       ssrcs_(ssrcs),
       video_stream_encoder_(encoder),
-      time_last_intra_request_ms_(ssrcs.size(), -1) {
+      time_last_key_frame_ms_(ssrcs.size(), -1) {
   RTC_DCHECK(!ssrcs.empty());
 }
 
@@ -53,15 +55,25 @@ void EncoderRtcpFeedback::OnReceivedIntraFrameRequest(uint32_t ssrc) {
     // it easier to test there.
     int64_t now_ms = clock_->TimeInMilliseconds();
     rtc::CritScope lock(&crit_);
-    if (time_last_intra_request_ms_[index] + kMinKeyFrameRequestIntervalMs >
-        now_ms) {
+    if (time_last_key_frame_ms_[index] >= 0 &&
+        time_last_key_frame_ms_[index] + kMinKeyFrameRequestIntervalMs >
+            now_ms) {
       return;
     }
-    time_last_intra_request_ms_[index] = now_ms;
+    time_last_key_frame_ms_[index] = now_ms;
   }
 
   // Always produce key frame for all streams.
   video_stream_encoder_->SendKeyFrame();
 }
 
+void EncoderRtcpFeedback::OnKeyFrameEncoded(size_t stream_index) {
+  if (stream_index >= ssrcs_.size())
+    return;
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  rtc::CritScope lock(&crit_);
+  time_last_key_frame_ms_[stream_index] =
+      std::max(time_last_key_frame_ms_[stream_index], now_ms);
+}
+
 }  // namespace webrtc
@@ -20,6 +20,10 @@ namespace webrtc {
 
 class VideoStreamEncoderInterface;
 
+// Forwards key frame requests received over RTCP to the encoder. A request
+// for a stream is dropped if a key frame has been requested or encoded for
+// that same stream within the last 300 ms, so that a key frame that is
+// already on its way isn't requested again.
 class EncoderRtcpFeedback : public RtcpIntraFrameObserver {
  public:
   EncoderRtcpFeedback(Clock* clock,
@@ -27,6 +31,11 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver {
                       VideoStreamEncoderInterface* encoder);
   void OnReceivedIntraFrameRequest(uint32_t ssrc) override;
 
+  // Called when the encoder has produced a key frame, requested or not, for
+  // the simulcast stream |stream_index|, which sends on the SSRC at that
+  // index.
+  void OnKeyFrameEncoded(size_t stream_index);
+
  private:
   bool HasSsrc(uint32_t ssrc);
   size_t GetStreamIndex(uint32_t ssrc);
@@ -36,7 +45,7 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver {
   VideoStreamEncoderInterface* const video_stream_encoder_;
 
   rtc::CriticalSection crit_;
-  std::vector<int64_t> time_last_intra_request_ms_ RTC_GUARDED_BY(crit_);
+  std::vector<int64_t> time_last_key_frame_ms_ RTC_GUARDED_BY(crit_);
 };
 
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "video/encoder_rtcp_feedback.h"
 
 #include <memory>
+#include <vector>
 
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -57,4 +58,37 @@ TEST_F(VieKeyRequestTest, TooManyOnReceivedIntraFrameRequest) {
   encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
 }
 
+TEST_F(VieKeyRequestTest, RequestSoonAfterEncodedKeyFrameIsDropped) {
+  encoder_rtcp_feedback_.OnKeyFrameEncoded(0);
+  simulated_clock_.AdvanceTimeMilliseconds(100);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
+
+  EXPECT_CALL(encoder_, SendKeyFrame()).Times(1);
+  simulated_clock_.AdvanceTimeMilliseconds(200);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
+}
+
+TEST(VieKeyRequestSimulcastTest, RequestsAreThrottledPerStream) {
+  const std::vector<uint32_t> kSsrcs = {1234, 5678, 9012};
+  SimulatedClock simulated_clock(123456789);
+  testing::StrictMock<MockVideoStreamEncoder> encoder;
+  EncoderRtcpFeedback encoder_rtcp_feedback(&simulated_clock, kSsrcs, &encoder);
+
+  EXPECT_CALL(encoder, SendKeyFrame()).Times(2);
+  encoder_rtcp_feedback.OnReceivedIntraFrameRequest(kSsrcs[0]);
+  encoder_rtcp_feedback.OnReceivedIntraFrameRequest(kSsrcs[0]);
+  encoder_rtcp_feedback.OnReceivedIntraFrameRequest(kSsrcs[1]);
+
+  // A key frame encoded for the last stream only drops requests for that
+  // stream.
+  encoder_rtcp_feedback.OnKeyFrameEncoded(2);
+  simulated_clock.AdvanceTimeMilliseconds(10);
+  encoder_rtcp_feedback.OnReceivedIntraFrameRequest(kSsrcs[2]);
+  encoder_rtcp_feedback.OnReceivedIntraFrameRequest(kSsrcs[1]);
+
+  EXPECT_CALL(encoder, SendKeyFrame()).Times(1);
+  simulated_clock.AdvanceTimeMilliseconds(300);
+  encoder_rtcp_feedback.OnReceivedIntraFrameRequest(kSsrcs[2]);
+}
+
 }  // namespace webrtc
@@ -26,6 +26,7 @@
 #include "rtc_base/numerics/exp_filter.h"
 #include "rtc_base/timeutils.h"
 #include "system_wrappers/include/field_trial.h"
+#include "video/cpu_overuse_coordinator.h"
 
 #if defined(WEBRTC_MAC) && !defined(WEBRTC_IOS)
 #include <mach/mach.h>
@@ -520,8 +521,15 @@ class OveruseFrameDetector::CheckOveruseTask : public rtc::QueuedTask {
 
 OveruseFrameDetector::OveruseFrameDetector(
     CpuOveruseMetricsObserver* metrics_observer)
+    : OveruseFrameDetector(metrics_observer, nullptr, 1.0) {}
+
+OveruseFrameDetector::OveruseFrameDetector(
+    CpuOveruseMetricsObserver* metrics_observer,
+    CpuOveruseCoordinator* coordinator,
+    double priority)
     : check_overuse_task_(nullptr),
       metrics_observer_(metrics_observer),
+      coordinator_(coordinator),
       num_process_times_(0),
       // TODO(nisse): Use absl::optional
       last_capture_time_us_(-1),
@@ -534,10 +542,14 @@ OveruseFrameDetector::OveruseFrameDetector(
       in_quick_rampup_(false),
       current_rampup_delay_ms_(kStandardRampUpDelayMs) {
   task_checker_.Detach();
+  if (coordinator_)
+    coordinator_->AddStream(this, priority);
 }
 
 OveruseFrameDetector::~OveruseFrameDetector() {
   RTC_DCHECK(!check_overuse_task_) << "StopCheckForOverUse must be called.";
+  if (coordinator_)
+    coordinator_->RemoveStream(this);
 }
 
 void OveruseFrameDetector::StartCheckForOveruse(
@@ -640,7 +652,19 @@ void OveruseFrameDetector::CheckForOveruse(
 
   int64_t now_ms = rtc::TimeMillis();
 
-  if (IsOverusing(*encode_usage_percent_)) {
+  int usage_percent = *encode_usage_percent_;
+  if (coordinator_) {
+    usage_percent = std::max(
+        usage_percent, coordinator_->UpdateUsage(this, usage_percent));
+  }
+
+  if (IsOverusing(usage_percent)) {
+    // Streams that overuse by themselves can't wait for others to adapt.
+    if (coordinator_ &&
+        *encode_usage_percent_ < options_.high_encode_usage_threshold_percent &&
+        !coordinator_->IsNextToAdaptDown(this)) {
+      return;
+    }
     // If the last thing we did was going up, and now have to back down, we need
     // to check if this peak was short. If so we should back off to avoid going
     // back and forth between this load, the system doesn't seem to handle it.
@@ -663,11 +687,17 @@ void OveruseFrameDetector::CheckForOveruse(
     checks_above_threshold_ = 0;
     ++num_overuse_detections_;
 
+    if (coordinator_)
+      coordinator_->OnAdaptedDown(this);
     observer->AdaptDown(kScaleReasonCpu);
-  } else if (IsUnderusing(*encode_usage_percent_, now_ms)) {
+  } else if (IsUnderusing(usage_percent, now_ms)) {
+    if (coordinator_ && !coordinator_->IsNextToAdaptUp(this))
+      return;
     last_rampup_time_ms_ = now_ms;
     in_quick_rampup_ = true;
 
+    if (coordinator_)
+      coordinator_->OnAdaptedUp(this);
     observer->AdaptUp(kScaleReasonCpu);
   }
 
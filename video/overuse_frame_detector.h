@@ -25,6 +25,7 @@
 
 namespace webrtc {
 
+class CpuOveruseCoordinator;
 class VideoFrame;
 
 struct CpuOveruseOptions {
@@ -53,6 +54,14 @@ struct CpuOveruseOptions {
 class OveruseFrameDetector {
  public:
   explicit OveruseFrameDetector(CpuOveruseMetricsObserver* metrics_observer);
+  // With a |coordinator|, overuse is detected from the encode usage of all
+  // streams of the coordinator and this stream only adapts when it is the
+  // least important one. It still adapts down by itself if its own usage is
+  // above the high threshold. |priority| is the priority of the stream
+  // relative to the others; see CpuOveruseCoordinator.
+  OveruseFrameDetector(CpuOveruseMetricsObserver* metrics_observer,
+                       CpuOveruseCoordinator* coordinator,
+                       double priority);
   virtual ~OveruseFrameDetector();
 
   // Start to periodically check for overuse.
@@ -128,6 +137,8 @@ class OveruseFrameDetector {
 
   // Stats metrics.
   CpuOveruseMetricsObserver* const metrics_observer_;
+  // May be null; outlives this object.
+  CpuOveruseCoordinator* const coordinator_;
   absl::optional<int> encode_usage_percent_ RTC_GUARDED_BY(task_checker_);
 
   int64_t num_process_times_ RTC_GUARDED_BY(task_checker_);
@@ -9,6 +9,7 @@
  */
 
 #include <memory>
+#include <utility>
 
 #include "api/video/i420_buffer.h"
 #include "common_video/include/video_frame.h"
@@ -18,6 +19,7 @@
 #include "rtc_base/random.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "video/cpu_overuse_coordinator.h"
 #include "video/overuse_frame_detector.h"
 
 namespace webrtc {
@@ -59,6 +61,10 @@ class OveruseFrameDetectorUnderTest : public OveruseFrameDetector {
   explicit OveruseFrameDetectorUnderTest(
       CpuOveruseMetricsObserver* metrics_observer)
       : OveruseFrameDetector(metrics_observer) {}
+  OveruseFrameDetectorUnderTest(CpuOveruseMetricsObserver* metrics_observer,
+                                CpuOveruseCoordinator* coordinator,
+                                double priority)
+      : OveruseFrameDetector(metrics_observer, coordinator, priority) {}
   ~OveruseFrameDetectorUnderTest() {}
 
   using OveruseFrameDetector::CheckForOveruse;
@@ -219,6 +225,36 @@ TEST_F(OveruseFrameDetectorTest, DoubleOveruseAndRecover) {
   TriggerUnderuse();
 }
 
+TEST_F(OveruseFrameDetectorTest, AdaptsLeastImportantStreamForSharedOveruse) {
+  // Each stream uses 60% of the single core, together more than there is.
+  const int kDelayUs = 20 * rtc::kNumMicrosecsPerMillisec;
+  CpuOveruseCoordinator coordinator(1);
+  std::unique_ptr<OveruseFrameDetectorUnderTest> low_priority_detector =
+      absl::make_unique<OveruseFrameDetectorUnderTest>(this, &coordinator, 1.0);
+  std::unique_ptr<OveruseFrameDetectorUnderTest> high_priority_detector =
+      absl::make_unique<OveruseFrameDetectorUnderTest>(this, &coordinator, 3.0);
+  low_priority_detector->SetOptions(options_);
+  high_priority_detector->SetOptions(options_);
+  MockCpuOveruseObserver high_priority_observer;
+  EXPECT_CALL(mock_observer_, AdaptDown(reason_)).Times(1);
+  EXPECT_CALL(high_priority_observer, AdaptDown(reason_)).Times(0);
+
+  // A stream reports its usage when it checks for overuse, so the first
+  // check of the first stream only sees its own usage.
+  for (int i = 0; i <= options_.high_threshold_consecutive_count; ++i) {
+    std::swap(overuse_detector_, low_priority_detector);
+    InsertAndSendFramesWithInterval(1000, kFrameIntervalUs, kWidth, kHeight,
+                                    kDelayUs);
+    overuse_detector_->CheckForOveruse(observer_);
+    std::swap(overuse_detector_, low_priority_detector);
+    std::swap(overuse_detector_, high_priority_detector);
+    InsertAndSendFramesWithInterval(1000, kFrameIntervalUs, kWidth, kHeight,
+                                    kDelayUs);
+    overuse_detector_->CheckForOveruse(&high_priority_observer);
+    std::swap(overuse_detector_, high_priority_detector);
+  }
+}
+
 TEST_F(OveruseFrameDetectorTest, TriggerUnderuseWithMinProcessCount) {
   const int kProcessIntervalUs = 5 * rtc::kNumMicrosecsPerSec;
   options_.min_process_count = 1;
@@ -102,9 +102,6 @@ ReceiveStatisticsProxy::ReceiveStatisticsProxy(
       num_certain_states_(0),
       // 1000ms window, scale 1000 for ms to s.
       decode_fps_estimator_(1000, 1000),
-      renders_fps_estimator_(1000, 1000),
-      render_fps_tracker_(100, 10u),
-      render_pixel_tracker_(100, 10u),
       total_byte_tracker_(100, 10u),  // bucket_interval_ms, bucket_count
       video_quality_observer_(
           new VideoQualityObserver(VideoContentType::UNSPECIFIED)),
@@ -114,9 +111,17 @@ ReceiveStatisticsProxy::ReceiveStatisticsProxy(
       avg_rtt_ms_(0),
       last_content_type_(VideoContentType::UNSPECIFIED),
       last_codec_type_(kVideoCodecVP8),
+      timing_frame_info_counter_(kMovingMaxWindowMs),
+      renders_fps_estimator_(1000, 1000),
+      render_fps_tracker_(100, 10u),
+      render_pixel_tracker_(100, 10u),
+      frames_rendered_(0),
+      render_width_(0),
+      render_height_(0),
+      first_frame_rendered_ms_(-1),
       num_delayed_frames_rendered_(0),
       sum_missed_render_deadline_ms_(0),
-      timing_frame_info_counter_(kMovingMaxWindowMs) {
+      render_content_type_(VideoContentType::UNSPECIFIED) {
   decode_thread_.DetachFromThread();
   network_thread_.DetachFromThread();
   stats_.ssrc = config_.rtp.remote_ssrc;
@@ -141,6 +146,11 @@ ReceiveStatisticsProxy::~ReceiveStatisticsProxy() {
 
 void ReceiveStatisticsProxy::UpdateHistograms() {
   RTC_DCHECK_RUN_ON(&decode_thread_);
+  rtc::CritScope render_lock(&render_crit_);
+  for (const auto& it : render_content_specific_stats_)
+    content_specific_stats_[it.first].Add(it.second);
+  render_content_specific_stats_.clear();
+
   char log_stream_buf[8 * 1024];
   rtc::SimpleStringBuilder log_stream(log_stream_buf);
   int stream_duration_sec = (clock_->TimeInMilliseconds() - start_ms_) / 1000;
@@ -184,7 +194,7 @@ void ReceiveStatisticsProxy::UpdateHistograms() {
           static_cast<int>((stats_.frames_decoded * 1000.0f / elapsed_ms) +
                            0.5f));
 
-      const uint32_t frames_rendered = stats_.frames_rendered;
+      const uint32_t frames_rendered = frames_rendered_;
       if (frames_rendered > 0) {
         RTC_HISTOGRAM_PERCENTAGE("WebRTC.Video.DelayedFramesToRenderer",
                                  static_cast<int>(num_delayed_frames_rendered_ *
@@ -494,8 +504,11 @@ void ReceiveStatisticsProxy::QualitySample() {
   if (last_sample_time_ + kMinSampleLengthMs > now)
     return;
 
-  double fps =
-      render_fps_tracker_.ComputeRateForInterval(now - last_sample_time_);
+  double fps;
+  {
+    rtc::CritScope render_lock(&render_crit_);
+    fps = render_fps_tracker_.ComputeRateForInterval(now - last_sample_time_);
+  }
   absl::optional<int> qp = qp_sample_.Avg(1);
 
   bool prev_fps_bad = !fps_threshold_.IsHigh().value_or(true);
@@ -576,7 +589,14 @@ VideoReceiveStream::Stats ReceiveStatisticsProxy::GetStats() const {
   // us from ever correctly displaying frame rate of 0.
   int64_t now_ms = clock_->TimeInMilliseconds();
   UpdateFramerate(now_ms);
-  stats_.render_frame_rate = renders_fps_estimator_.Rate(now_ms).value_or(0);
+  {
+    rtc::CritScope render_lock(&render_crit_);
+    stats_.render_frame_rate = renders_fps_estimator_.Rate(now_ms).value_or(0);
+    stats_.frames_rendered = frames_rendered_;
+    stats_.width = render_width_;
+    stats_.height = render_height_;
+    stats_.first_frame_rendered_ms = first_frame_rendered_ms_;
+  }
   stats_.decode_frame_rate = decode_fps_estimator_.Rate(now_ms).value_or(0);
   stats_.total_bitrate_bps =
       static_cast<int>(total_byte_tracker_.ComputeRate() * 8);
@@ -590,6 +610,11 @@ VideoReceiveStream::Stats ReceiveStatisticsProxy::GetStats() const {
 void ReceiveStatisticsProxy::OnIncomingPayloadType(int payload_type) {
   rtc::CritScope lock(&crit_);
   stats_.current_payload_type = payload_type;
+  if (stats_.decoder_ready_ms == -1) {
+    stats_.decoder_ready_ms = clock_->TimeInMilliseconds() - start_ms_;
+    RTC_LOG(LS_INFO) << "Video start: decoder ready after "
+                     << stats_.decoder_ready_ms << " ms.";
+  }
 }
 
 void ReceiveStatisticsProxy::OnDecoderImplementationName(
@@ -697,6 +722,12 @@ void ReceiveStatisticsProxy::DataCountersUpdated(
   }
   if (total_bytes > last_total_bytes)
     total_byte_tracker_.AddSamples(total_bytes - last_total_bytes);
+  if (stats_.first_packet_received_ms == -1 &&
+      counters.first_packet_time_ms != -1) {
+    stats_.first_packet_received_ms = counters.first_packet_time_ms - start_ms_;
+    RTC_LOG(LS_INFO) << "Video start: first packet received after "
+                     << stats_.first_packet_received_ms << " ms.";
+  }
 }
 
 void ReceiveStatisticsProxy::OnDecodedFrame(absl::optional<uint8_t> qp,
@@ -736,6 +767,10 @@ void ReceiveStatisticsProxy::OnDecodedFrame(absl::optional<uint8_t> qp,
         << "QP sum was already set and no QP was given for a frame.";
     stats_.qp_sum = absl::nullopt;
   }
+  if (content_type != last_content_type_) {
+    rtc::CritScope render_lock(&render_crit_);
+    render_content_type_ = content_type;
+  }
   last_content_type_ = content_type;
   decode_fps_estimator_.Update(1, now);
   if (last_decoded_frame_time_ms_) {
@@ -747,8 +782,12 @@ void ReceiveStatisticsProxy::OnDecodedFrame(absl::optional<uint8_t> qp,
         interframe_delay_ms);
     content_specific_stats->flow_duration_ms += interframe_delay_ms;
   }
-  if (stats_.frames_decoded == 1)
+  if (stats_.frames_decoded == 1) {
     first_decoded_frame_time_ms_.emplace(now);
+    stats_.first_frame_decoded_ms = now - start_ms_;
+    RTC_LOG(LS_INFO) << "Video start: first frame decoded after "
+                     << stats_.first_frame_decoded_ms << " ms.";
+  }
   last_decoded_frame_time_ms_.emplace(now);
 }
 
@@ -758,15 +797,20 @@ void ReceiveStatisticsProxy::OnRenderedFrame(const VideoFrame& frame) {
   RTC_DCHECK_GT(width, 0);
   RTC_DCHECK_GT(height, 0);
   int64_t now_ms = clock_->TimeInMilliseconds();
-  rtc::CritScope lock(&crit_);
+  rtc::CritScope lock(&render_crit_);
   ContentSpecificStats* content_specific_stats =
-      &content_specific_stats_[last_content_type_];
+      &render_content_specific_stats_[render_content_type_];
   renders_fps_estimator_.Update(1, now_ms);
-  ++stats_.frames_rendered;
-  stats_.width = width;
-  stats_.height = height;
+  ++frames_rendered_;
+  render_width_ = width;
+  render_height_ = height;
   render_fps_tracker_.AddSamples(1);
   render_pixel_tracker_.AddSamples(sqrt(width * height));
+  if (first_frame_rendered_ms_ == -1) {
+    first_frame_rendered_ms_ = now_ms - start_ms_;
+    RTC_LOG(LS_INFO) << "Video start: first frame rendered after "
+                     << first_frame_rendered_ms_ << " ms.";
+  }
   content_specific_stats->received_width.Add(width);
   content_specific_stats->received_height.Add(height);
 
@@ -807,8 +851,14 @@ void ReceiveStatisticsProxy::OnCompleteFrame(bool is_keyframe,
                                              size_t size_bytes,
                                              VideoContentType content_type) {
   rtc::CritScope lock(&crit_);
+  int64_t now_ms = clock_->TimeInMilliseconds();
   if (is_keyframe) {
     ++stats_.frame_counts.key_frames;
+    if (stats_.first_keyframe_complete_ms == -1) {
+      stats_.first_keyframe_complete_ms = now_ms - start_ms_;
+      RTC_LOG(LS_INFO) << "Video start: first keyframe complete after "
+                       << stats_.first_keyframe_complete_ms << " ms.";
+    }
   } else {
     ++stats_.frame_counts.delta_frames;
   }
@@ -823,7 +873,6 @@ void ReceiveStatisticsProxy::OnCompleteFrame(bool is_keyframe,
     ++content_specific_stats->frame_counts.delta_frames;
   }
 
-  int64_t now_ms = clock_->TimeInMilliseconds();
   frame_window_.insert(std::make_pair(now_ms, size_bytes));
   UpdateFramerate(now_ms);
 }
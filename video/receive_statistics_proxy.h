@@ -158,9 +158,6 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   int num_certain_states_ RTC_GUARDED_BY(crit_);
   mutable VideoReceiveStream::Stats stats_ RTC_GUARDED_BY(crit_);
   RateStatistics decode_fps_estimator_ RTC_GUARDED_BY(crit_);
-  RateStatistics renders_fps_estimator_ RTC_GUARDED_BY(crit_);
-  rtc::RateTracker render_fps_tracker_ RTC_GUARDED_BY(crit_);
-  rtc::RateTracker render_pixel_tracker_ RTC_GUARDED_BY(crit_);
   rtc::RateTracker total_byte_tracker_ RTC_GUARDED_BY(crit_);
   rtc::SampleCounter sync_offset_counter_ RTC_GUARDED_BY(crit_);
   rtc::SampleCounter decode_time_counter_ RTC_GUARDED_BY(crit_);
@@ -185,13 +182,30 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   VideoCodecType last_codec_type_ RTC_GUARDED_BY(&crit_);
   absl::optional<int64_t> first_decoded_frame_time_ms_ RTC_GUARDED_BY(&crit_);
   absl::optional<int64_t> last_decoded_frame_time_ms_ RTC_GUARDED_BY(&crit_);
-  size_t num_delayed_frames_rendered_ RTC_GUARDED_BY(&crit_);
-  int64_t sum_missed_render_deadline_ms_ RTC_GUARDED_BY(&crit_);
   // Mutable because calling Max() on MovingMaxCounter is not const. Yet it is
   // called from const GetStats().
   mutable rtc::MovingMaxCounter<TimingFrameInfo> timing_frame_info_counter_
       RTC_GUARDED_BY(&crit_);
   absl::optional<int> num_unique_frames_ RTC_GUARDED_BY(crit_);
+
+  // Stats of rendered frames, which are added on the render thread. They're
+  // kept under a lock of their own, so that rendering doesn't contend with
+  // decoding and the network callbacks.
+  rtc::CriticalSection render_crit_ RTC_ACQUIRED_AFTER(crit_);
+  RateStatistics renders_fps_estimator_ RTC_GUARDED_BY(render_crit_);
+  rtc::RateTracker render_fps_tracker_ RTC_GUARDED_BY(render_crit_);
+  rtc::RateTracker render_pixel_tracker_ RTC_GUARDED_BY(render_crit_);
+  uint32_t frames_rendered_ RTC_GUARDED_BY(render_crit_);
+  int render_width_ RTC_GUARDED_BY(render_crit_);
+  int render_height_ RTC_GUARDED_BY(render_crit_);
+  int64_t first_frame_rendered_ms_ RTC_GUARDED_BY(render_crit_);
+  size_t num_delayed_frames_rendered_ RTC_GUARDED_BY(render_crit_);
+  int64_t sum_missed_render_deadline_ms_ RTC_GUARDED_BY(render_crit_);
+  // |last_content_type_|, updated when it changes.
+  VideoContentType render_content_type_ RTC_GUARDED_BY(render_crit_);
+  // Merged into |content_specific_stats_| by UpdateHistograms().
+  std::map<VideoContentType, ContentSpecificStats>
+      render_content_specific_stats_ RTC_GUARDED_BY(render_crit_);
   rtc::ThreadChecker decode_thread_;
   rtc::ThreadChecker network_thread_;
   rtc::ThreadChecker main_thread_;
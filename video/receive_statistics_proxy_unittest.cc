@@ -256,6 +256,17 @@ TEST_F(ReceiveStatisticsProxyTest, OnRenderedFrameIncreasesFramesRendered) {
   }
 }
 
+TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsRenderedResolution) {
+  EXPECT_EQ(0, statistics_proxy_->GetStats().width);
+  EXPECT_EQ(0, statistics_proxy_->GetStats().height);
+  statistics_proxy_->OnRenderedFrame(CreateFrame(kWidth, kHeight));
+  EXPECT_EQ(kWidth, statistics_proxy_->GetStats().width);
+  EXPECT_EQ(kHeight, statistics_proxy_->GetStats().height);
+  statistics_proxy_->OnRenderedFrame(CreateFrame(kWidth / 2, kHeight / 2));
+  EXPECT_EQ(kWidth / 2, statistics_proxy_->GetStats().width);
+  EXPECT_EQ(kHeight / 2, statistics_proxy_->GetStats().height);
+}
+
 TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsSsrc) {
   EXPECT_EQ(kRemoteSsrc, statistics_proxy_->GetStats().ssrc);
 }
@@ -266,6 +277,48 @@ TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsIncomingPayloadType) {
   EXPECT_EQ(kPayloadType, statistics_proxy_->GetStats().current_payload_type);
 }
 
+TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsStartLatencyStages) {
+  VideoReceiveStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(-1, stats.decoder_ready_ms);
+  EXPECT_EQ(-1, stats.first_packet_received_ms);
+  EXPECT_EQ(-1, stats.first_keyframe_complete_ms);
+  EXPECT_EQ(-1, stats.first_frame_decoded_ms);
+  EXPECT_EQ(-1, stats.first_frame_rendered_ms);
+
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  statistics_proxy_->OnIncomingPayloadType(111);
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  InsertFirstRtpPacket(kRemoteSsrc);
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  // Only a keyframe completes its stage.
+  statistics_proxy_->OnCompleteFrame(false, 1000,
+                                     VideoContentType::UNSPECIFIED);
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  statistics_proxy_->OnCompleteFrame(true, 1000,
+                                     VideoContentType::UNSPECIFIED);
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  statistics_proxy_->OnDecodedFrame(absl::nullopt, kWidth, kHeight,
+                                    VideoContentType::UNSPECIFIED);
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  statistics_proxy_->OnRenderedFrame(CreateFrame(kWidth, kHeight));
+
+  // Later events don't move the stages.
+  fake_clock_.AdvanceTimeMilliseconds(10);
+  statistics_proxy_->OnIncomingPayloadType(112);
+  statistics_proxy_->OnCompleteFrame(true, 1000,
+                                     VideoContentType::UNSPECIFIED);
+  statistics_proxy_->OnDecodedFrame(absl::nullopt, kWidth, kHeight,
+                                    VideoContentType::UNSPECIFIED);
+  statistics_proxy_->OnRenderedFrame(CreateFrame(kWidth, kHeight));
+
+  stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(10, stats.decoder_ready_ms);
+  EXPECT_EQ(20, stats.first_packet_received_ms);
+  EXPECT_EQ(40, stats.first_keyframe_complete_ms);
+  EXPECT_EQ(50, stats.first_frame_decoded_ms);
+  EXPECT_EQ(60, stats.first_frame_rendered_ms);
+}
+
 TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsDecoderImplementationName) {
   const char* kName = "decoderName";
   statistics_proxy_->OnDecoderImplementationName(kName);
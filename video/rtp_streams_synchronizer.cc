@@ -103,6 +103,8 @@ void RtpStreamsSynchronizer::Process() {
   TRACE_COUNTER1("webrtc", "SyncCurrentAudioDelay",
                  audio_info->current_delay_ms);
   TRACE_COUNTER1("webrtc", "SyncRelativeDelay", relative_delay_ms);
+  sync_->SetMaxDelays(audio_info->max_sync_delay_ms,
+                      video_info->max_sync_delay_ms);
   int target_audio_delay_ms = 0;
   int target_video_delay_ms = video_info->current_delay_ms;
   // Calculate the necessary extra audio delay and desired total video
@@ -137,12 +137,15 @@ SendStatisticsProxy::SendStatisticsProxy(
       media_byte_rate_tracker_(kBucketSizeMs, kBucketCount),
       encoded_frame_rate_tracker_(kBucketSizeMs, kBucketCount),
       uma_container_(
-          new UmaSamplesContainer(GetUmaPrefix(content_type_), stats_, clock)) {
-}
+          new UmaSamplesContainer(GetUmaPrefix(content_type_), stats_, clock)),
+      input_stats_(new InputStats(clock)) {}
 
 SendStatisticsProxy::~SendStatisticsProxy() {
   rtc::CritScope lock(&crit_);
-  uma_container_->UpdateHistograms(rtp_config_, stats_);
+  {
+    rtc::CritScope input_lock(&input_crit_);
+    uma_container_->UpdateHistograms(rtp_config_, stats_, input_stats_.get());
+  }
 
   int64_t elapsed_sec = (clock_->TimeInMilliseconds() - start_ms_) / 1000;
   RTC_HISTOGRAM_COUNTS_100000("WebRTC.Video.SendStreamLifetimeInSeconds",
@@ -152,14 +155,15 @@ SendStatisticsProxy::~SendStatisticsProxy() {
     UpdateCodecTypeHistogram(payload_name_);
 }
 
+SendStatisticsProxy::InputStats::InputStats(Clock* clock)
+    : frame_rate_tracker(100, 10u), fps_counter(clock, nullptr, true) {}
+
 SendStatisticsProxy::UmaSamplesContainer::UmaSamplesContainer(
     const char* prefix,
     const VideoSendStream::Stats& stats,
     Clock* const clock)
     : uma_prefix_(prefix),
       clock_(clock),
-      input_frame_rate_tracker_(100, 10u),
-      input_fps_counter_(clock, nullptr, true),
       sent_fps_counter_(clock, nullptr, true),
       total_byte_counter_(clock, nullptr, true),
       media_byte_counter_(clock, nullptr, true),
@@ -263,14 +267,15 @@ bool SendStatisticsProxy::UmaSamplesContainer::InsertEncodedFrame(
 
 void SendStatisticsProxy::UmaSamplesContainer::UpdateHistograms(
     const RtpConfig& rtp_config,
-    const VideoSendStream::Stats& current_stats) {
+    const VideoSendStream::Stats& current_stats,
+    InputStats* input_stats) {
   RTC_DCHECK(uma_prefix_ == kRealtimePrefix || uma_prefix_ == kScreenPrefix);
   const int kIndex = uma_prefix_ == kScreenPrefix ? 1 : 0;
   const int kMinRequiredPeriodicSamples = 6;
   char log_stream_buf[8 * 1024];
   rtc::SimpleStringBuilder log_stream(log_stream_buf);
-  int in_width = input_width_counter_.Avg(kMinRequiredMetricsSamples);
-  int in_height = input_height_counter_.Avg(kMinRequiredMetricsSamples);
+  int in_width = input_stats->width_counter.Avg(kMinRequiredMetricsSamples);
+  int in_height = input_stats->height_counter.Avg(kMinRequiredMetricsSamples);
   if (in_width != -1) {
     RTC_HISTOGRAMS_COUNTS_10000(kIndex, uma_prefix_ + "InputWidthInPixels",
                                 in_width);
@@ -279,7 +284,7 @@ void SendStatisticsProxy::UmaSamplesContainer::UpdateHistograms(
     log_stream << uma_prefix_ << "InputWidthInPixels " << in_width << "\n"
                << uma_prefix_ << "InputHeightInPixels " << in_height << "\n";
   }
-  AggregatedStats in_fps = input_fps_counter_.GetStats();
+  AggregatedStats in_fps = input_stats->fps_counter.GetStats();
   if (in_fps.num_samples >= kMinRequiredPeriodicSamples) {
     RTC_HISTOGRAMS_COUNTS_100(kIndex, uma_prefix_ + "InputFramesPerSecond",
                               in_fps.average);
@@ -354,8 +359,8 @@ void SendStatisticsProxy::UmaSamplesContainer::UpdateHistograms(
         kIndex, uma_prefix_ + "QualityLimitedResolutionDownscales", downscales,
         20);
   }
-  int cpu_limited =
-      cpu_limited_frame_counter_.Percent(kMinRequiredMetricsSamples);
+  int cpu_limited = input_stats->cpu_limited_frame_counter.Percent(
+      kMinRequiredMetricsSamples);
   if (cpu_limited != -1) {
     RTC_HISTOGRAMS_PERCENTAGE(
         kIndex, uma_prefix_ + "CpuLimitedResolutionInPercent", cpu_limited);
@@ -642,9 +647,11 @@ void SendStatisticsProxy::OnEncoderReconfigured(
   rtc::CritScope lock(&crit_);
 
   if (content_type_ != config.content_type) {
-    uma_container_->UpdateHistograms(rtp_config_, stats_);
+    rtc::CritScope input_lock(&input_crit_);
+    uma_container_->UpdateHistograms(rtp_config_, stats_, input_stats_.get());
     uma_container_.reset(new UmaSamplesContainer(
         GetUmaPrefix(config.content_type), stats_, clock_));
+    input_stats_.reset(new InputStats(clock_));
     content_type_ = config.content_type;
   }
   uma_container_->encoded_frames_.clear();
@@ -670,7 +677,10 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
     // Pause framerate (add min pause time since there may be frames/packets
     // that are not yet sent).
     const int64_t kMinMs = 500;
-    uma_container_->input_fps_counter_.ProcessAndPauseForDuration(kMinMs);
+    {
+      rtc::CritScope input_lock(&input_crit_);
+      input_stats_->fps_counter.ProcessAndPauseForDuration(kMinMs);
+    }
     uma_container_->sent_fps_counter_.ProcessAndPauseForDuration(kMinMs);
     // Pause bitrate stats.
     uma_container_->total_byte_counter_.ProcessAndPauseForDuration(kMinMs);
@@ -700,8 +710,11 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
 VideoSendStream::Stats SendStatisticsProxy::GetStats() {
   rtc::CritScope lock(&crit_);
   PurgeOldStats();
-  stats_.input_frame_rate =
-      round(uma_container_->input_frame_rate_tracker_.ComputeRate());
+  {
+    rtc::CritScope input_lock(&input_crit_);
+    stats_.input_frame_rate =
+        round(input_stats_->frame_rate_tracker.ComputeRate());
+  }
   stats_.content_type =
       content_type_ == VideoEncoderConfig::ContentType::kRealtimeVideo
           ? VideoContentType::UNSPECIFIED
@@ -960,8 +973,8 @@ void SendStatisticsProxy::OnSendEncodedImage(
 }
 
 int SendStatisticsProxy::GetInputFrameRate() const {
-  rtc::CritScope lock(&crit_);
-  return round(uma_container_->input_frame_rate_tracker_.ComputeRate());
+  rtc::CritScope lock(&input_crit_);
+  return round(input_stats_->frame_rate_tracker.ComputeRate());
 }
 
 int SendStatisticsProxy::GetSendFrameRate() const {
@@ -970,15 +983,22 @@ int SendStatisticsProxy::GetSendFrameRate() const {
 }
 
 void SendStatisticsProxy::OnIncomingFrame(int width, int height) {
-  rtc::CritScope lock(&crit_);
-  uma_container_->input_frame_rate_tracker_.AddSamples(1);
-  uma_container_->input_fps_counter_.Add(1);
-  uma_container_->input_width_counter_.Add(width);
-  uma_container_->input_height_counter_.Add(height);
-  if (cpu_downscales_ >= 0) {
-    uma_container_->cpu_limited_frame_counter_.Add(
-        stats_.cpu_limited_resolution);
+  {
+    rtc::CritScope lock(&input_crit_);
+    input_stats_->frame_rate_tracker.AddSamples(1);
+    input_stats_->fps_counter.Add(1);
+    input_stats_->width_counter.Add(width);
+    input_stats_->height_counter.Add(height);
+    if (input_cpu_limited_resolution_) {
+      input_stats_->cpu_limited_frame_counter.Add(
+          *input_cpu_limited_resolution_);
+    }
+    if (!first_input_frame_)
+      return;
+    first_input_frame_ = false;
   }
+
+  rtc::CritScope lock(&crit_);
   if (encoded_frame_rate_tracker_.TotalSampleCount() == 0) {
     // Set start time now instead of when first key frame is encoded to avoid a
     // too high initial estimate.
@@ -1035,6 +1055,12 @@ void SendStatisticsProxy::UpdateAdaptationStats(
   stats_.cpu_limited_framerate = cpu_counts.num_framerate_reductions > 0;
   stats_.bw_limited_resolution = quality_counts.num_resolution_reductions > 0;
   stats_.bw_limited_framerate = quality_counts.num_framerate_reductions > 0;
+
+  rtc::CritScope input_lock(&input_crit_);
+  input_cpu_limited_resolution_ =
+      cpu_downscales_ >= 0
+          ? absl::optional<bool>(stats_.cpu_limited_resolution)
+          : absl::nullopt;
 }
 
 // TODO(asapersson): Include fps changes.
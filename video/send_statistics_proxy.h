@@ -242,6 +242,20 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
 
   absl::optional<int64_t> last_outlier_timestamp_ RTC_GUARDED_BY(crit_);
 
+  // Stats of the frames input to the encoder, which are added on the capture
+  // thread. They're kept apart from the other UMA samples, under a lock of
+  // their own, so that captured frames don't contend with the encoder and
+  // network callbacks. Reset along with |uma_container_|.
+  struct InputStats {
+    explicit InputStats(Clock* clock);
+
+    rtc::RateTracker frame_rate_tracker;
+    RateCounter fps_counter;
+    SampleCounter width_counter;
+    SampleCounter height_counter;
+    BoolSampleCounter cpu_limited_frame_counter;
+  };
+
   // Contains stats used for UMA histograms. These stats will be reset if
   // content type changes between real-time video and screenshare, since these
   // will be reported separately.
@@ -252,7 +266,8 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
     ~UmaSamplesContainer();
 
     void UpdateHistograms(const RtpConfig& rtp_config,
-                          const VideoSendStream::Stats& current_stats);
+                          const VideoSendStream::Stats& current_stats,
+                          InputStats* input_stats);
 
     void InitializeBitrateCounters(const VideoSendStream::Stats& stats);
 
@@ -263,21 +278,16 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
 
     const std::string uma_prefix_;
     Clock* const clock_;
-    SampleCounter input_width_counter_;
-    SampleCounter input_height_counter_;
     SampleCounter sent_width_counter_;
     SampleCounter sent_height_counter_;
     SampleCounter encode_time_counter_;
     BoolSampleCounter key_frame_counter_;
     BoolSampleCounter quality_limited_frame_counter_;
     SampleCounter quality_downscales_counter_;
-    BoolSampleCounter cpu_limited_frame_counter_;
     BoolSampleCounter bw_limited_frame_counter_;
     SampleCounter bw_resolutions_disabled_counter_;
     SampleCounter delay_counter_;
     SampleCounter max_delay_counter_;
-    rtc::RateTracker input_frame_rate_tracker_;
-    RateCounter input_fps_counter_;
     RateCounter sent_fps_counter_;
     RateAccCounter total_byte_counter_;
     RateAccCounter media_byte_counter_;
@@ -306,6 +316,14 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   };
 
   std::unique_ptr<UmaSamplesContainer> uma_container_ RTC_GUARDED_BY(crit_);
+
+  rtc::CriticalSection input_crit_ RTC_ACQUIRED_AFTER(crit_);
+  std::unique_ptr<InputStats> input_stats_ RTC_GUARDED_BY(input_crit_);
+  // |stats_.cpu_limited_resolution|, or unset if the resolution isn't adapted
+  // for cpu.
+  absl::optional<bool> input_cpu_limited_resolution_
+      RTC_GUARDED_BY(input_crit_);
+  bool first_input_frame_ RTC_GUARDED_BY(input_crit_) = true;
 };
 
 }  // namespace webrtc
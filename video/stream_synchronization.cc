@@ -127,6 +127,13 @@ bool StreamSynchronization::ComputeDelays(int relative_delay_ms,
   channel_delay_.extra_video_delay_ms =
       std::max(channel_delay_.extra_video_delay_ms, base_target_delay_ms_);
 
+  // Don't build up delay beyond the bounds, it would have to be removed again
+  // before the other stream can be adjusted.
+  channel_delay_.extra_video_delay_ms =
+      std::min(channel_delay_.extra_video_delay_ms, MaxVideoDelayMs());
+  channel_delay_.extra_audio_delay_ms =
+      std::min(channel_delay_.extra_audio_delay_ms, MaxAudioDelayMs());
+
   int new_video_delay_ms;
   if (channel_delay_.extra_video_delay_ms > base_target_delay_ms_) {
     new_video_delay_ms = channel_delay_.extra_video_delay_ms;
@@ -141,8 +148,7 @@ bool StreamSynchronization::ComputeDelays(int relative_delay_ms,
       std::max(new_video_delay_ms, channel_delay_.extra_video_delay_ms);
 
   // Verify we don't go above the maximum allowed video delay.
-  new_video_delay_ms =
-      std::min(new_video_delay_ms, base_target_delay_ms_ + kMaxDeltaDelayMs);
+  new_video_delay_ms = std::min(new_video_delay_ms, MaxVideoDelayMs());
 
   int new_audio_delay_ms;
   if (channel_delay_.extra_audio_delay_ms > base_target_delay_ms_) {
@@ -158,8 +164,7 @@ bool StreamSynchronization::ComputeDelays(int relative_delay_ms,
       std::max(new_audio_delay_ms, channel_delay_.extra_audio_delay_ms);
 
   // Verify we don't go above the maximum allowed audio delay.
-  new_audio_delay_ms =
-      std::min(new_audio_delay_ms, base_target_delay_ms_ + kMaxDeltaDelayMs);
+  new_audio_delay_ms = std::min(new_audio_delay_ms, MaxAudioDelayMs());
 
   // Remember our last audio and video delays.
   channel_delay_.last_video_delay_ms = new_video_delay_ms;
@@ -194,4 +199,29 @@ void StreamSynchronization::SetTargetBufferingDelay(int target_delay_ms) {
   base_target_delay_ms_ = target_delay_ms;
 }
 
+void StreamSynchronization::SetMaxDelays(
+    absl::optional<int> max_audio_delay_ms,
+    absl::optional<int> max_video_delay_ms) {
+  max_audio_delay_ms_ = max_audio_delay_ms;
+  max_video_delay_ms_ = max_video_delay_ms;
+}
+
+int StreamSynchronization::MaxAudioDelayMs() const {
+  int max_delay_ms = base_target_delay_ms_ + kMaxDeltaDelayMs;
+  if (max_audio_delay_ms_) {
+    max_delay_ms = std::min(
+        max_delay_ms, std::max(*max_audio_delay_ms_, base_target_delay_ms_));
+  }
+  return max_delay_ms;
+}
+
+int StreamSynchronization::MaxVideoDelayMs() const {
+  int max_delay_ms = base_target_delay_ms_ + kMaxDeltaDelayMs;
+  if (max_video_delay_ms_) {
+    max_delay_ms = std::min(
+        max_delay_ms, std::max(*max_video_delay_ms_, base_target_delay_ms_));
+  }
+  return max_delay_ms;
+}
+
 }  // namespace webrtc
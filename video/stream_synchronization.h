@@ -13,6 +13,7 @@
 
 #include <list>
 
+#include "absl/types/optional.h"
 #include "system_wrappers/include/rtp_to_ntp_estimator.h"
 
 namespace webrtc {
@@ -43,6 +44,13 @@ class StreamSynchronization {
   // least target_delay_ms.
   void SetTargetBufferingDelay(int target_delay_ms);
 
+  // Bounds the delays returned by ComputeDelays(). When the stream that
+  // would have to be delayed has reached its bound, the delay of the other
+  // stream is still lowered as far as possible, but the remaining offset is
+  // accepted rather than adding more latency. Unset for no bound.
+  void SetMaxDelays(absl::optional<int> max_audio_delay_ms,
+                    absl::optional<int> max_video_delay_ms);
+
  private:
   struct SynchronizationDelays {
     int extra_video_delay_ms = 0;
@@ -51,11 +59,16 @@ class StreamSynchronization {
     int last_audio_delay_ms = 0;
   };
 
+  int MaxAudioDelayMs() const;
+  int MaxVideoDelayMs() const;
+
   SynchronizationDelays channel_delay_;
   const int video_stream_id_;
   const int audio_stream_id_;
   int base_target_delay_ms_;
   int avg_diff_ms_;
+  absl::optional<int> max_audio_delay_ms_;
+  absl::optional<int> max_video_delay_ms_;
 };
 }  // namespace webrtc
 
@@ -373,6 +373,43 @@ TEST_F(StreamSynchronizationTest, VideoDelay) {
   EXPECT_EQ(3 * delay_ms / kSmoothingFilter, total_video_delay_ms);
 }
 
+TEST_F(StreamSynchronizationTest, VideoDelayIsBounded) {
+  const int kMaxVideoDelayMs = 40;
+  sync_->SetMaxDelays(absl::nullopt, kMaxVideoDelayMs);
+  int extra_audio_delay_ms = 0;
+  int total_video_delay_ms = 0;
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(DelayedStreams(200, 0, 0, &extra_audio_delay_ms,
+                               &total_video_delay_ms));
+    EXPECT_EQ(0, extra_audio_delay_ms);
+    EXPECT_LE(total_video_delay_ms, kMaxVideoDelayMs);
+    send_time_->IncreaseTimeMs(1000);
+    receive_time_->IncreaseTimeMs(800);
+    total_video_delay_ms = 0;
+  }
+  EXPECT_TRUE(DelayedStreams(200, 0, 0, &extra_audio_delay_ms,
+                             &total_video_delay_ms));
+  EXPECT_EQ(kMaxVideoDelayMs, total_video_delay_ms);
+}
+
+TEST_F(StreamSynchronizationTest, AudioDelayIsBounded) {
+  const int kMaxAudioDelayMs = 30;
+  sync_->SetMaxDelays(kMaxAudioDelayMs, absl::nullopt);
+  int current_audio_delay_ms = 0;
+  int extra_audio_delay_ms = 0;
+  int total_video_delay_ms = 0;
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(DelayedStreams(0, 200, current_audio_delay_ms,
+                               &extra_audio_delay_ms, &total_video_delay_ms));
+    EXPECT_EQ(0, total_video_delay_ms);
+    EXPECT_LE(extra_audio_delay_ms, kMaxAudioDelayMs);
+    current_audio_delay_ms = extra_audio_delay_ms;
+    send_time_->IncreaseTimeMs(1000);
+    receive_time_->IncreaseTimeMs(800);
+  }
+  EXPECT_EQ(kMaxAudioDelayMs, extra_audio_delay_ms);
+}
+
 TEST_F(StreamSynchronizationTest, AudioDelay) {
   int current_audio_delay_ms = 0;
   int delay_ms = 200;
@@ -12,6 +12,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <utility>
@@ -34,15 +35,27 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/timeutils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/field_trial.h"
 #include "video/call_stats.h"
+#include "video/cpu_overuse_coordinator.h"
 #include "video/receive_statistics_proxy.h"
 
 namespace webrtc {
 
 namespace {
+const int kMaxWaitForFrameMs = 3000;
+const int kMaxWaitForKeyFrameMs = 200;
+// The decode usage reported to the CpuOveruseCoordinator.
+const float kDecodeUsageFilterAlpha = 0.95f;
+const int64_t kMaxDecodeUsageFrameIntervalUs = 1000000;
+const int64_t kDecodeUsageReportIntervalUs = 1000000;
+// Encoded frames to record that aren't yet written to the file, above which
+// frames are dropped rather than blocking the decoder.
+const size_t kMaxPendingRecordingBytes = 4 * 1024 * 1024;
+
 VideoCodec CreateDecoderVideoCodec(const VideoReceiveStream::Decoder& decoder) {
   VideoCodec codec;
   memset(&codec, 0, sizeof(codec));
@@ -84,7 +97,9 @@ VideoReceiveStream::VideoReceiveStream(
     PacketRouter* packet_router,
     VideoReceiveStream::Config config,
     ProcessThread* process_thread,
-    CallStats* call_stats)
+    CallStats* call_stats,
+    DecodePool* decode_pool,
+    CpuOveruseCoordinator* cpu_overuse_coordinator)
     : transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
       num_cpu_cores_(num_cpu_cores),
@@ -94,6 +109,10 @@ VideoReceiveStream::VideoReceiveStream(
                      this,
                      "DecodingThread",
                      rtc::kHighestPriority),
+      decode_pool_(decode_pool),
+      cpu_overuse_coordinator_(cpu_overuse_coordinator),
+      decode_time_ms_(kDecodeUsageFilterAlpha),
+      frame_interval_ms_(kDecodeUsageFilterAlpha),
       call_stats_(call_stats),
       rtp_receive_statistics_(ReceiveStatistics::Create(clock_)),
       timing_(new VCMTiming(clock_)),
@@ -129,8 +148,10 @@ VideoReceiveStream::VideoReceiveStream(
   }
 
   video_receiver_.SetRenderDelay(config_.render_delay_ms);
+  timing_->set_low_latency_mode(config_.low_latency_playout);
 
   jitter_estimator_.reset(new VCMJitterEstimator(clock_));
+  jitter_estimator_->SetLowLatencyMode(config_.low_latency_playout);
   frame_buffer_.reset(new video_coding::FrameBuffer(
       clock_, jitter_estimator_.get(), timing_.get(), &stats_proxy_));
 
@@ -172,7 +193,7 @@ void VideoReceiveStream::SetSync(Syncable* audio_syncable) {
 
 void VideoReceiveStream::Start() {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_sequence_checker_);
-  if (decode_thread_.IsRunning())
+  if (decode_thread_.IsRunning() || added_to_decode_pool_)
     return;
 
   bool protected_by_fec = config_.rtp.protected_by_flexfec ||
@@ -193,6 +214,10 @@ void VideoReceiveStream::Start() {
     } else {
       incoming_video_stream_.reset(
           new IncomingVideoStream(config_.render_delay_ms, this));
+      if (refresh_interval_ms_ > 0) {
+        incoming_video_stream_->OnVsync(vsync_time_ms_,
+                                        refresh_interval_ms_);
+      }
       renderer = incoming_video_stream_.get();
     }
   }
@@ -219,10 +244,22 @@ void VideoReceiveStream::Start() {
 
   process_thread_->RegisterModule(&video_receiver_, RTC_FROM_HERE);
 
+  // The decoder is initialized on the decode thread, like it would be for the
+  // first frame, so that it doesn't hold up the worker thread and the
+  // decoders of several streams are initialized in parallel.
+  prewarm_decoder_pending_ =
+      config_.prewarm_decoder && !config_.decoders.empty();
+
   // Start the decode thread
   video_receiver_.DecoderThreadStarting();
   stats_proxy_.DecoderThreadStarting();
-  decode_thread_.Start();
+  if (decode_pool_) {
+    decode_deadline_ms_ = clock_->TimeInMilliseconds() + MaxWaitForFrameMs();
+    decode_pool_->AddStream(this);
+    added_to_decode_pool_ = true;
+  } else {
+    decode_thread_.Start();
+  }
   rtp_video_stream_receiver_.StartReceive();
 }
 
@@ -237,15 +274,24 @@ void VideoReceiveStream::Stop() {
   call_stats_->DeregisterStatsObserver(this);
   process_thread_->DeRegisterModule(&video_receiver_);
 
-  if (decode_thread_.IsRunning()) {
+  if (decode_thread_.IsRunning() || added_to_decode_pool_) {
     // TriggerDecoderShutdown will release any waiting decoder thread and make
     // it stop immediately, instead of waiting for a timeout. Needs to be called
     // before joining the decoder thread.
     video_receiver_.TriggerDecoderShutdown();
 
-    decode_thread_.Stop();
+    if (added_to_decode_pool_) {
+      decode_pool_->RemoveStream(this);
+      added_to_decode_pool_ = false;
+    } else {
+      decode_thread_.Stop();
+    }
     video_receiver_.DecoderThreadStopped();
     stats_proxy_.DecoderThreadStopped();
+    if (cpu_overuse_coordinator_)
+      cpu_overuse_coordinator_->UpdateLoad(this, absl::nullopt);
+    last_decode_start_us_ = -1;
+    last_usage_report_us_ = -1;
     // Deregister external decoders so they are no longer running during
     // destruction. This effectively stops the VCM since the decoder thread is
     // stopped, the VCM is deregistered and no asynchronous decoder threads are
@@ -270,7 +316,8 @@ void VideoReceiveStream::EnableEncodedFrameRecording(rtc::PlatformFile file,
     if (file == rtc::kInvalidPlatformFileValue) {
       ivf_writer_.reset();
     } else {
-      ivf_writer_ = IvfFileWriter::Wrap(rtc::File(file), byte_limit);
+      ivf_writer_ = IvfFileWriter::WrapAsync(rtc::File(file), byte_limit,
+                                             kMaxPendingRecordingBytes);
     }
   }
 
@@ -290,6 +337,15 @@ void VideoReceiveStream::RemoveSecondarySink(
   rtp_video_stream_receiver_.RemoveSecondarySink(sink);
 }
 
+void VideoReceiveStream::OnVsync(int64_t vsync_time_ms,
+                                 int64_t refresh_interval_ms) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_sequence_checker_);
+  vsync_time_ms_ = vsync_time_ms;
+  refresh_interval_ms_ = refresh_interval_ms;
+  if (incoming_video_stream_)
+    incoming_video_stream_->OnVsync(vsync_time_ms, refresh_interval_ms);
+}
+
 // TODO(tommi): This method grabs a lock 6 times.
 void VideoReceiveStream::OnFrame(const VideoFrame& video_frame) {
   int64_t sync_offset_ms;
@@ -351,8 +407,12 @@ void VideoReceiveStream::OnCompleteFrame(
   frame->id.spatial_layer = 0;
 
   int64_t last_continuous_pid = frame_buffer_->InsertFrame(std::move(frame));
-  if (last_continuous_pid != -1)
+  if (last_continuous_pid != -1) {
     rtp_video_stream_receiver_.FrameContinuous(last_continuous_pid);
+    // The dedicated decode thread is woken up by the frame buffer itself.
+    if (decode_pool_)
+      decode_pool_->WakeUp(this);
+  }
 }
 
 void VideoReceiveStream::OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) {
@@ -376,6 +436,7 @@ absl::optional<Syncable::Info> VideoReceiveStream::GetInfo() const {
     return absl::nullopt;
 
   info->current_delay_ms = video_receiver_.Delay();
+  info->max_sync_delay_ms = config_.max_sync_delay_ms;
   return info;
 }
 
@@ -396,10 +457,9 @@ void VideoReceiveStream::DecodeThreadFunction(void* ptr) {
 
 bool VideoReceiveStream::Decode() {
   TRACE_EVENT0("webrtc", "VideoReceiveStream::Decode");
-  static const int kMaxWaitForFrameMs = 3000;
-  static const int kMaxWaitForKeyFrameMs = 200;
-
-  int wait_ms = keyframe_required_ ? kMaxWaitForKeyFrameMs : kMaxWaitForFrameMs;
+  if (prewarm_decoder_pending_)
+    PrewarmDecoder();
+  int wait_ms = MaxWaitForFrameMs();
   std::unique_ptr<video_coding::EncodedFrame> frame;
   // TODO(philipel): Call NextFrame with |keyframe_required| argument when
   //                 downstream project has been fixed.
@@ -411,52 +471,143 @@ bool VideoReceiveStream::Decode() {
   }
 
   if (frame) {
-    int64_t now_ms = clock_->TimeInMilliseconds();
     RTC_DCHECK_EQ(res, video_coding::FrameBuffer::ReturnReason::kFrameFound);
-    int decode_result = video_receiver_.Decode(frame.get());
-    if (decode_result == WEBRTC_VIDEO_CODEC_OK ||
-        decode_result == WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME) {
-      keyframe_required_ = false;
-      frame_decoded_ = true;
-      rtp_video_stream_receiver_.FrameDecoded(frame->id.picture_id);
-
-      if (decode_result == WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME)
-        RequestKeyFrame();
-    } else if (!frame_decoded_ || !keyframe_required_ ||
-               (last_keyframe_request_ms_ + kMaxWaitForKeyFrameMs < now_ms)) {
-      keyframe_required_ = true;
-      // TODO(philipel): Remove this keyframe request when downstream project
-      //                 has been fixed.
-      RequestKeyFrame();
-      last_keyframe_request_ms_ = now_ms;
-    }
+    HandleEncodedFrame(std::move(frame));
   } else {
     RTC_DCHECK_EQ(res, video_coding::FrameBuffer::ReturnReason::kTimeout);
-    int64_t now_ms = clock_->TimeInMilliseconds();
-    absl::optional<int64_t> last_packet_ms =
-        rtp_video_stream_receiver_.LastReceivedPacketMs();
-    absl::optional<int64_t> last_keyframe_packet_ms =
-        rtp_video_stream_receiver_.LastReceivedKeyframePacketMs();
-
-    // To avoid spamming keyframe requests for a stream that is not active we
-    // check if we have received a packet within the last 5 seconds.
-    bool stream_is_active = last_packet_ms && now_ms - *last_packet_ms < 5000;
-    if (!stream_is_active)
-      stats_proxy_.OnStreamInactive();
-
-    // If we recently have been receiving packets belonging to a keyframe then
-    // we assume a keyframe is currently being received.
-    bool receiving_keyframe =
-        last_keyframe_packet_ms &&
-        now_ms - *last_keyframe_packet_ms < kMaxWaitForKeyFrameMs;
-
-    if (stream_is_active && !receiving_keyframe) {
-      RTC_LOG(LS_WARNING) << "No decodable frame in " << wait_ms
-                          << " ms, requesting keyframe.";
+    HandleFrameBufferTimeout(wait_ms);
+  }
+  return true;
+}
+
+int64_t VideoReceiveStream::DecodeNextFrame() {
+  TRACE_EVENT0("webrtc", "VideoReceiveStream::DecodeNextFrame");
+  if (prewarm_decoder_pending_)
+    PrewarmDecoder();
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  std::unique_ptr<video_coding::EncodedFrame> frame;
+  int64_t wait_ms = 0;
+  video_coding::FrameBuffer::ReturnReason res = frame_buffer_->NextFrameIfDue(
+      std::max<int64_t>(decode_deadline_ms_ - now_ms, 0), &frame, &wait_ms);
+
+  // Stop() removes the stream from the pool right after stopping the frame
+  // buffer.
+  if (res == video_coding::FrameBuffer::ReturnReason::kStopped)
+    return kMaxWaitForFrameMs;
+
+  if (frame) {
+    RTC_DCHECK_EQ(res, video_coding::FrameBuffer::ReturnReason::kFrameFound);
+    HandleEncodedFrame(std::move(frame));
+    decode_deadline_ms_ = clock_->TimeInMilliseconds() + MaxWaitForFrameMs();
+    // Check for the next frame right away, like Decode() does.
+    return 0;
+  }
+
+  RTC_DCHECK_EQ(res, video_coding::FrameBuffer::ReturnReason::kTimeout);
+  if (now_ms < decode_deadline_ms_)
+    return wait_ms;
+  int max_wait_ms = MaxWaitForFrameMs();
+  HandleFrameBufferTimeout(max_wait_ms);
+  decode_deadline_ms_ = now_ms + max_wait_ms;
+  return max_wait_ms;
+}
+
+int VideoReceiveStream::MaxWaitForFrameMs() const {
+  return keyframe_required_ ? kMaxWaitForKeyFrameMs : kMaxWaitForFrameMs;
+}
+
+void VideoReceiveStream::PrewarmDecoder() {
+  prewarm_decoder_pending_ = false;
+  const int payload_type = config_.decoders[0].payload_type;
+  if (video_receiver_.PrewarmDecoder(payload_type) != VCM_OK) {
+    RTC_LOG(LS_WARNING) << "Failed to prewarm the decoder of payload type "
+                        << payload_type << ".";
+  }
+}
+
+void VideoReceiveStream::HandleEncodedFrame(
+    std::unique_ptr<video_coding::EncodedFrame> frame) {
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  // None of the decoders take the bitstream in fragments.
+  frame->MakeBitstreamContiguous();
+  const int64_t decode_start_us = clock_->TimeInMicroseconds();
+  int decode_result = video_receiver_.Decode(frame.get());
+  UpdateDecodeUsage(decode_start_us, clock_->TimeInMicroseconds());
+  if (decode_result == WEBRTC_VIDEO_CODEC_OK ||
+      decode_result == WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME) {
+    keyframe_required_ = false;
+    frame_decoded_ = true;
+    rtp_video_stream_receiver_.FrameDecoded(frame->id.picture_id);
+
+    if (decode_result == WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME)
       RequestKeyFrame();
+  } else if (!frame_decoded_ || !keyframe_required_ ||
+             (last_keyframe_request_ms_ + kMaxWaitForKeyFrameMs < now_ms)) {
+    keyframe_required_ = true;
+    // TODO(philipel): Remove this keyframe request when downstream project
+    //                 has been fixed.
+    RequestKeyFrame();
+    last_keyframe_request_ms_ = now_ms;
+  }
+}
+
+void VideoReceiveStream::UpdateDecodeUsage(int64_t decode_start_us,
+                                           int64_t decode_end_us) {
+  if (!cpu_overuse_coordinator_)
+    return;
+  if (last_decode_start_us_ >= 0) {
+    const int64_t frame_interval_us = decode_start_us - last_decode_start_us_;
+    // Pauses of the stream are not part of its frame rate.
+    if (frame_interval_us < kMaxDecodeUsageFrameIntervalUs) {
+      frame_interval_ms_.Apply(
+          1.0f, static_cast<float>(frame_interval_us) /
+                    rtc::kNumMicrosecsPerMillisec);
     }
   }
-  return true;
+  last_decode_start_us_ = decode_start_us;
+  decode_time_ms_.Apply(1.0f, static_cast<float>(decode_end_us -
+                                                 decode_start_us) /
+                                  rtc::kNumMicrosecsPerMillisec);
+
+  if (frame_interval_ms_.filtered() == rtc::ExpFilter::kValueUndefined ||
+      (last_usage_report_us_ >= 0 &&
+       decode_end_us - last_usage_report_us_ < kDecodeUsageReportIntervalUs)) {
+    return;
+  }
+  last_usage_report_us_ = decode_end_us;
+  // Like the encode usage of OveruseFrameDetector, the share of the frame
+  // interval spent decoding.
+  const int usage_percent = static_cast<int>(
+      100.0f * decode_time_ms_.filtered() /
+          std::max(frame_interval_ms_.filtered(), 1.0f) +
+      0.5f);
+  cpu_overuse_coordinator_->UpdateLoad(this, usage_percent);
+}
+
+void VideoReceiveStream::HandleFrameBufferTimeout(int wait_ms) {
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  absl::optional<int64_t> last_packet_ms =
+      rtp_video_stream_receiver_.LastReceivedPacketMs();
+  absl::optional<int64_t> last_keyframe_packet_ms =
+      rtp_video_stream_receiver_.LastReceivedKeyframePacketMs();
+
+  // To avoid spamming keyframe requests for a stream that is not active we
+  // check if we have received a packet within the last 5 seconds.
+  bool stream_is_active = last_packet_ms && now_ms - *last_packet_ms < 5000;
+  if (!stream_is_active)
+    stats_proxy_.OnStreamInactive();
+
+  // If we recently have been receiving packets belonging to a keyframe then
+  // we assume a keyframe is currently being received.
+  bool receiving_keyframe =
+      last_keyframe_packet_ms &&
+      now_ms - *last_keyframe_packet_ms < kMaxWaitForKeyFrameMs;
+
+  if (stream_is_active && !receiving_keyframe) {
+    RTC_LOG(LS_WARNING) << "No decodable frame in " << wait_ms
+                        << " ms, requesting keyframe.";
+    RequestKeyFrame();
+  }
 }
 }  // namespace internal
 }  // namespace webrtc
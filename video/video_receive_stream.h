@@ -17,12 +17,15 @@
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
 #include "call/video_receive_stream.h"
+#include "common_video/include/incoming_video_stream.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/rtp_rtcp/include/flexfec_receiver.h"
 #include "modules/video_coding/frame_buffer2.h"
 #include "modules/video_coding/video_coding_impl.h"
+#include "rtc_base/numerics/exp_filter.h"
 #include "rtc_base/sequenced_task_checker.h"
 #include "system_wrappers/include/clock.h"
+#include "video/decode_pool.h"
 #include "video/receive_statistics_proxy.h"
 #include "video/rtp_streams_synchronizer.h"
 #include "video/rtp_video_stream_receiver.h"
@@ -32,6 +35,7 @@
 namespace webrtc {
 
 class CallStats;
+class CpuOveruseCoordinator;
 class IvfFileWriter;
 class ProcessThread;
 class RTPFragmentationHeader;
@@ -50,14 +54,17 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                            public KeyFrameRequestSender,
                            public video_coding::OnCompleteFrameCallback,
                            public Syncable,
-                           public CallStatsObserver {
+                           public CallStatsObserver,
+                           public DecodePool::Stream {
  public:
   VideoReceiveStream(RtpStreamReceiverControllerInterface* receiver_controller,
                      int num_cpu_cores,
                      PacketRouter* packet_router,
                      VideoReceiveStream::Config config,
                      ProcessThread* process_thread,
-                     CallStats* call_stats);
+                     CallStats* call_stats,
+                     DecodePool* decode_pool,
+                     CpuOveruseCoordinator* cpu_overuse_coordinator);
   ~VideoReceiveStream() override;
 
   const Config& config() const { return config_; }
@@ -84,6 +91,8 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   void AddSecondarySink(RtpPacketSinkInterface* sink) override;
   void RemoveSecondarySink(const RtpPacketSinkInterface* sink) override;
 
+  void OnVsync(int64_t vsync_time_ms, int64_t refresh_interval_ms) override;
+
   // Implements rtc::VideoSinkInterface<VideoFrame>.
   void OnFrame(const VideoFrame& video_frame) override;
 
@@ -112,9 +121,17 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   uint32_t GetPlayoutTimestamp() const override;
   void SetMinimumPlayoutDelay(int delay_ms) override;
 
+  // Implements DecodePool::Stream.
+  int64_t DecodeNextFrame() override;
+
  private:
   static void DecodeThreadFunction(void* ptr);
   bool Decode();
+  int MaxWaitForFrameMs() const;
+  void PrewarmDecoder();
+  void HandleEncodedFrame(std::unique_ptr<video_coding::EncodedFrame> frame);
+  void HandleFrameBufferTimeout(int wait_ms);
+  void UpdateDecodeUsage(int64_t decode_start_us, int64_t decode_end_us);
 
   rtc::SequencedTaskChecker worker_sequence_checker_;
   rtc::SequencedTaskChecker module_process_sequence_checker_;
@@ -126,6 +143,20 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   Clock* const clock_;
 
   rtc::PlatformThread decode_thread_;
+  // If set, frames are decoded on this pool instead of |decode_thread_|.
+  DecodePool* const decode_pool_;
+  bool added_to_decode_pool_ = false;
+  // When to give up waiting for a frame when decoding on |decode_pool_|. Only
+  // used on the pool thread once the stream is added.
+  int64_t decode_deadline_ms_ = 0;
+
+  // If set, the decode usage of the stream is reported to it as a load. The
+  // measurement is only used on the decode thread.
+  CpuOveruseCoordinator* const cpu_overuse_coordinator_;
+  rtc::ExpFilter decode_time_ms_;
+  rtc::ExpFilter frame_interval_ms_;
+  int64_t last_decode_start_us_ = -1;
+  int64_t last_usage_report_us_ = -1;
 
   CallStats* const call_stats_;
 
@@ -135,7 +166,10 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
 
   std::unique_ptr<VCMTiming> timing_;  // Jitter buffer experiment.
   vcm::VideoReceiver video_receiver_;
-  std::unique_ptr<rtc::VideoSinkInterface<VideoFrame>> incoming_video_stream_;
+  std::unique_ptr<IncomingVideoStream> incoming_video_stream_;
+  // Latest display refresh reported through OnVsync().
+  int64_t vsync_time_ms_ = 0;
+  int64_t refresh_interval_ms_ = 0;
   ReceiveStatisticsProxy stats_proxy_;
   RtpVideoStreamReceiver rtp_video_stream_receiver_;
   std::unique_ptr<VideoStreamDecoder> video_stream_decoder_;
@@ -159,6 +193,10 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   // If we have successfully decoded any frame.
   bool frame_decoded_ = false;
 
+  // Set by Start() when |config_.prewarm_decoder| is set, and cleared on the
+  // decode thread once the decoder has been initialized.
+  bool prewarm_decoder_pending_ = false;
+
   int64_t last_keyframe_request_ms_ = 0;
 };
 }  // namespace internal
@@ -22,8 +22,11 @@
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/event.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/sleep.h"
 #include "test/field_trial.h"
 #include "video/call_stats.h"
+#include "video/cpu_overuse_coordinator.h"
+#include "video/decode_pool.h"
 #include "video/video_receive_stream.h"
 
 namespace webrtc {
@@ -91,7 +94,8 @@ class VideoReceiveStreamTest : public testing::Test {
 
     video_receive_stream_.reset(new webrtc::internal::VideoReceiveStream(
         &rtp_stream_receiver_controller_, kDefaultNumCpuCores, &packet_router_,
-        config_.Copy(), process_thread_.get(), &call_stats_));
+        config_.Copy(), process_thread_.get(), &call_stats_, nullptr,
+        nullptr));
   }
 
  protected:
@@ -136,4 +140,92 @@ TEST_F(VideoReceiveStreamTest, CreateFrameFromH264FmtpSpropAndIdr) {
   init_decode_event_.Wait(kDefaultTimeOutMs);
 }
 
+TEST_F(VideoReceiveStreamTest, DecodesOnDecodePool) {
+  constexpr uint8_t idr_nalu[] = {0x05, 0xFF, 0xFF, 0xFF};
+  DecodePool decode_pool(1);
+  video_receive_stream_.reset();
+  video_receive_stream_.reset(new webrtc::internal::VideoReceiveStream(
+      &rtp_stream_receiver_controller_, 2, &packet_router_, config_.Copy(),
+      process_thread_.get(), &call_stats_, &decode_pool, nullptr));
+
+  RtpPacketToSend rtppacket(nullptr);
+  uint8_t* payload = rtppacket.AllocatePayload(sizeof(idr_nalu));
+  memcpy(payload, idr_nalu, sizeof(idr_nalu));
+  rtppacket.SetMarker(true);
+  rtppacket.SetSsrc(1111);
+  rtppacket.SetPayloadType(99);
+  rtppacket.SetSequenceNumber(1);
+  rtppacket.SetTimestamp(0);
+  rtc::Event decode_event(false, false);
+  EXPECT_CALL(mock_h264_video_decoder_, InitDecode(_, _));
+  EXPECT_CALL(mock_h264_video_decoder_, RegisterDecodeCompleteCallback(_));
+  video_receive_stream_->Start();
+  EXPECT_EQ(1u, decode_pool.NumStreamsForTesting());
+  EXPECT_CALL(mock_h264_video_decoder_, Decode(_, false, _, _))
+      .WillOnce(Invoke([&decode_event](const EncodedImage& input,
+                                       bool missing_frames,
+                                       const CodecSpecificInfo* info,
+                                       int64_t render_time_ms) {
+        decode_event.Set();
+        return 0;
+      }));
+  RtpPacketReceived parsed_packet;
+  ASSERT_TRUE(parsed_packet.Parse(rtppacket.data(), rtppacket.size()));
+  rtp_stream_receiver_controller_.OnRtpPacket(parsed_packet);
+  EXPECT_TRUE(decode_event.Wait(1000));
+
+  EXPECT_CALL(mock_h264_video_decoder_, Release());
+  video_receive_stream_->Stop();
+  EXPECT_EQ(0u, decode_pool.NumStreamsForTesting());
+  video_receive_stream_.reset();
+}
+
+TEST_F(VideoReceiveStreamTest, ReportsDecodeUsageToCpuOveruseCoordinator) {
+  constexpr uint8_t idr_nalu[] = {0x05, 0xFF, 0xFF, 0xFF};
+  CpuOveruseCoordinator coordinator(1);
+  video_receive_stream_.reset();
+  video_receive_stream_.reset(new webrtc::internal::VideoReceiveStream(
+      &rtp_stream_receiver_controller_, 2, &packet_router_,
+      config_.Copy(), process_thread_.get(), &call_stats_, nullptr,
+      &coordinator));
+
+  EXPECT_CALL(mock_h264_video_decoder_, InitDecode(_, _));
+  EXPECT_CALL(mock_h264_video_decoder_, RegisterDecodeCompleteCallback(_));
+  video_receive_stream_->Start();
+  rtc::Event decode_event(false, false);
+  EXPECT_CALL(mock_h264_video_decoder_, Decode(_, false, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&decode_event](const EncodedImage& input,
+                                             bool missing_frames,
+                                             const CodecSpecificInfo* info,
+                                             int64_t render_time_ms) {
+        decode_event.Set();
+        return 0;
+      }));
+  // The usage is known from the second frame, which gives a frame interval.
+  for (uint16_t i = 0; i < 2; ++i) {
+    RtpPacketToSend rtppacket(nullptr);
+    uint8_t* payload = rtppacket.AllocatePayload(sizeof(idr_nalu));
+    memcpy(payload, idr_nalu, sizeof(idr_nalu));
+    rtppacket.SetMarker(true);
+    rtppacket.SetSsrc(1111);
+    rtppacket.SetPayloadType(99);
+    rtppacket.SetSequenceNumber(1 + i);
+    rtppacket.SetTimestamp(3000 * i);
+    RtpPacketReceived parsed_packet;
+    ASSERT_TRUE(parsed_packet.Parse(rtppacket.data(), rtppacket.size()));
+    rtp_stream_receiver_controller_.OnRtpPacket(parsed_packet);
+    EXPECT_TRUE(decode_event.Wait(1000));
+  }
+  // Reported right after the decoder returns.
+  for (int i = 0; i < 100 && !coordinator.TotalUsagePercent(); ++i)
+    SleepMs(10);
+  EXPECT_TRUE(coordinator.TotalUsagePercent());
+
+  EXPECT_CALL(mock_h264_video_decoder_, Release());
+  video_receive_stream_->Stop();
+  EXPECT_FALSE(coordinator.TotalUsagePercent());
+  video_receive_stream_.reset();
+}
+
 }  // namespace webrtc
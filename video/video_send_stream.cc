@@ -11,10 +11,12 @@
 
 #include <utility>
 
-#include "api/video/video_stream_encoder_create.h"
+#include "absl/memory/memory.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "rtc_base/logging.h"
+#include "video/overuse_frame_detector.h"
 #include "video/video_send_stream_impl.h"
+#include "video/video_stream_encoder.h"
 
 namespace webrtc {
 
@@ -68,7 +70,8 @@ VideoSendStream::VideoSendStream(
     VideoEncoderConfig encoder_config,
     const std::map<uint32_t, RtpState>& suspended_ssrcs,
     const std::map<uint32_t, RtpPayloadState>& suspended_payload_states,
-    std::unique_ptr<FecController> fec_controller)
+    std::unique_ptr<FecController> fec_controller,
+    CpuOveruseCoordinator* cpu_overuse_coordinator)
     : worker_queue_(worker_queue),
       thread_sync_event_(false /* manual_reset */, false),
       stats_proxy_(Clock::GetRealTimeClock(),
@@ -78,9 +81,14 @@ VideoSendStream::VideoSendStream(
       content_type_(encoder_config.content_type) {
   RTC_DCHECK(config_.encoder_settings.encoder_factory);
 
-  video_stream_encoder_ = CreateVideoStreamEncoder(num_cpu_cores, &stats_proxy_,
-                                                   config_.encoder_settings,
-                                                   config_.pre_encode_callback);
+  // The overuse detector takes part in the CPU adaptation of all send streams
+  // of the call if |cpu_overuse_coordinator| is set.
+  video_stream_encoder_ = absl::make_unique<VideoStreamEncoder>(
+      num_cpu_cores, &stats_proxy_, config_.encoder_settings,
+      config_.pre_encode_callback,
+      absl::make_unique<OveruseFrameDetector>(&stats_proxy_,
+                                              cpu_overuse_coordinator,
+                                              encoder_config.bitrate_priority));
   // TODO(srte): Initialization should not be done posted on a task queue.
   // Note that the posted task must not outlive this scope since the closure
   // references local variables.
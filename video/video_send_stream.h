@@ -33,6 +33,7 @@ class VideoSendStreamPeer;
 }  // namespace test
 
 class CallStats;
+class CpuOveruseCoordinator;
 class SendSideCongestionController;
 class IvfFileWriter;
 class ProcessThread;
@@ -67,7 +68,8 @@ class VideoSendStream : public webrtc::VideoSendStream {
       VideoEncoderConfig encoder_config,
       const std::map<uint32_t, RtpState>& suspended_ssrcs,
       const std::map<uint32_t, RtpPayloadState>& suspended_payload_states,
-      std::unique_ptr<FecController> fec_controller);
+      std::unique_ptr<FecController> fec_controller,
+      CpuOveruseCoordinator* cpu_overuse_coordinator);
 
   ~VideoSendStream() override;
 
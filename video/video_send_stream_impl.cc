@@ -36,6 +36,10 @@ static const int kSendSideSeqNumSetMaxSize = 5500;
 // We don't do MTU discovery, so assume that we have the standard ethernet MTU.
 const size_t kPathMTU = 1500;
 
+// Encoded frames to record, per stream, that aren't yet written to the file,
+// above which frames are dropped rather than blocking the encoder.
+const size_t kMaxPendingRecordingBytes = 4 * 1024 * 1024;
+
 bool TransportSeqNumExtensionConfigured(const VideoSendStream::Config& config) {
   const std::vector<RtpExtension>& extensions = config.rtp.extensions;
   return std::find_if(
@@ -537,6 +541,13 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
       check_encoder_activity_task_->UpdateEncoderActivity();
   }
 
+  if (encoded_image._frameType == kVideoFrameKey) {
+    encoder_feedback_.OnKeyFrameEncoded(
+        codec_specific_info->codecType == kVideoCodecH264
+            ? codec_specific_info->codecSpecific.H264.simulcast_idx
+            : simulcast_idx);
+  }
+
   fec_controller_->UpdateWithEncodedData(encoded_image._length,
                                          encoded_image._frameType);
   EncodedImageCallback::Result result = rtp_video_sender_->OnEncodedImage(
@@ -627,7 +638,8 @@ void VideoSendStreamImpl::EnableEncodedFrameRecording(
     rtc::CritScope lock(&ivf_writers_crit_);
     for (unsigned int i = 0; i < kMaxSimulcastStreams; ++i) {
       if (i < files.size()) {
-        file_writers_[i] = IvfFileWriter::Wrap(rtc::File(files[i]), byte_limit);
+        file_writers_[i] = IvfFileWriter::WrapAsync(
+            rtc::File(files[i]), byte_limit, kMaxPendingRecordingBytes);
       } else {
         file_writers_[i].reset();
       }
@@ -203,6 +203,7 @@ VideoStreamDecoderImpl::DecodeResult VideoStreamDecoderImpl::DecodeNextFrame(
               Add<kFrameTimestampsMemory>(next_frame_timestamps_index_, 1);
         });
 
+    frame->MakeBitstreamContiguous();
     int32_t decode_result = decoder->Decode(frame->EncodedImage(),
                                             false,    // missing_frame
                                             nullptr,  // codec specific info
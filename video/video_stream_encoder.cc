@@ -661,6 +661,13 @@ void VideoStreamEncoder::OnFrame(const VideoFrame& video_frame) {
                         << incoming_frame.ntp_time_ms()
                         << " <= " << last_captured_timestamp_
                         << ") for incoming frame. Dropping.";
+    // The next frame that is encoded must still include its changes.
+    const absl::optional<VideoFrame::UpdateRect> update_rect =
+        incoming_frame.update_rect();
+    encoder_queue_.PostTask([this, update_rect] {
+      RTC_DCHECK_RUN_ON(&encoder_queue_);
+      AccumulateUpdateRect(update_rect);
+    });
     return;
   }
 
@@ -681,6 +688,7 @@ void VideoStreamEncoder::OnFrame(const VideoFrame& video_frame) {
         encoder_stats_observer_->OnIncomingFrame(incoming_frame.width(),
                                                  incoming_frame.height());
         ++captured_frame_count_;
+        AccumulateUpdateRect(incoming_frame.update_rect());
         const int posted_frames_waiting_for_encode =
             posted_frames_waiting_for_encode_.fetch_sub(1);
         RTC_DCHECK_GT(posted_frames_waiting_for_encode, 0);
@@ -751,6 +759,8 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
     pending_encoder_reconfiguration_ = true;
     last_frame_info_ = VideoFrameInfo(video_frame.width(), video_frame.height(),
                                       video_frame.is_texture());
+    // Changes relative to a frame of another size are meaningless.
+    accumulated_update_rect_.reset();
     RTC_LOG(LS_INFO) << "Video frame parameters changed: dimensions="
                      << last_frame_info_->width << "x"
                      << last_frame_info_->height
@@ -826,23 +836,42 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   if (crop_width_ > 0 || crop_height_ > 0) {
     int cropped_width = video_frame.width() - crop_width_;
     int cropped_height = video_frame.height() - crop_height_;
-    rtc::scoped_refptr<I420Buffer> cropped_buffer =
-        I420Buffer::Create(cropped_width, cropped_height);
     // TODO(ilnik): Remove scaling if cropping is too big, as it should never
     // happen after SinkWants signaled correctly from ReconfigureEncoder.
+    int offset_x = 0;
+    int offset_y = 0;
+    int crop_width = video_frame.width();
+    int crop_height = video_frame.height();
     if (crop_width_ < 4 && crop_height_ < 4) {
-      cropped_buffer->CropAndScaleFrom(
-          *video_frame.video_frame_buffer()->ToI420(), crop_width_ / 2,
-          crop_height_ / 2, cropped_width, cropped_height);
-    } else {
-      cropped_buffer->ScaleFrom(
-          *video_frame.video_frame_buffer()->ToI420().get());
+      offset_x = crop_width_ / 2;
+      offset_y = crop_height_ / 2;
+      crop_width = cropped_width;
+      crop_height = cropped_height;
+    }
+    // Native buffers stay native if they can be cropped as they are, so that
+    // encoders consuming them directly get them without a conversion.
+    rtc::scoped_refptr<VideoFrameBuffer> cropped_buffer =
+        video_frame.video_frame_buffer()->CropAndScale(
+            offset_x, offset_y, crop_width, crop_height, cropped_width,
+            cropped_height);
+    if (!cropped_buffer) {
+      rtc::scoped_refptr<I420Buffer> i420_buffer =
+          cropped_buffer_pool_.CreateBuffer(cropped_width, cropped_height);
+      i420_buffer->CropAndScaleFrom(*video_frame.video_frame_buffer()->ToI420(),
+                                    offset_x, offset_y, crop_width,
+                                    crop_height);
+      cropped_buffer = i420_buffer;
     }
     out_frame =
         VideoFrame(cropped_buffer, video_frame.timestamp(),
                    video_frame.render_time_ms(), video_frame.rotation());
     out_frame.set_ntp_time_ms(video_frame.ntp_time_ms());
+    // Scaling moves the changed pixels, so leave the update rect unset.
+    accumulated_update_rect_.reset();
   }
+  // Pass on the changes of all frames dropped since the last encoded one.
+  out_frame.set_update_rect(accumulated_update_rect_);
+  accumulated_update_rect_ = VideoFrame::UpdateRect{0, 0, 0, 0};
 
   TRACE_EVENT_ASYNC_STEP0("webrtc", "Video", video_frame.render_time_ms(),
                           "Encode");
@@ -852,6 +881,15 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   video_sender_.AddVideoFrame(out_frame, nullptr);
 }
 
+void VideoStreamEncoder::AccumulateUpdateRect(
+    const absl::optional<VideoFrame::UpdateRect>& update_rect) {
+  if (accumulated_update_rect_ && update_rect) {
+    accumulated_update_rect_->Union(*update_rect);
+  } else {
+    accumulated_update_rect_.reset();
+  }
+}
+
 void VideoStreamEncoder::SendKeyFrame() {
   if (!encoder_queue_.IsCurrent()) {
     encoder_queue_.PostTask([this] { SendKeyFrame(); });
@@ -24,6 +24,7 @@
 #include "api/video/video_stream_encoder_observer.h"
 #include "api/video/video_stream_encoder_settings.h"
 #include "api/video_codecs/video_encoder.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "modules/video_coding/utility/quality_scaler.h"
 #include "modules/video_coding/video_coding_impl.h"
 #include "rtc_base/criticalsection.h"
@@ -116,6 +117,11 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
 
   void EncodeVideoFrame(const VideoFrame& frame,
                         int64_t time_when_posted_in_ms);
+  // Adds the update rect of a frame to the changes the encoder hasn't been
+  // given yet.
+  void AccumulateUpdateRect(
+      const absl::optional<VideoFrame::UpdateRect>& update_rect)
+      RTC_RUN_ON(&encoder_queue_);
   // Indicates wether frame should be dropped because the pixel count is too
   // large for the current bitrate configuration.
   bool DropDueToSize(uint32_t pixel_count) const RTC_RUN_ON(&encoder_queue_);
@@ -218,6 +224,12 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
       RTC_GUARDED_BY(&encoder_queue_);
   int crop_width_ RTC_GUARDED_BY(&encoder_queue_);
   int crop_height_ RTC_GUARDED_BY(&encoder_queue_);
+  // Buffers of frames cropped in software.
+  I420BufferPool cropped_buffer_pool_ RTC_GUARDED_BY(&encoder_queue_);
+  // The region that changed since the last frame given to the encoder, over
+  // all the frames dropped since. Unset if unknown.
+  absl::optional<VideoFrame::UpdateRect> accumulated_update_rect_
+      RTC_GUARDED_BY(&encoder_queue_);
   uint32_t encoder_start_bitrate_bps_ RTC_GUARDED_BY(&encoder_queue_);
   size_t max_data_payload_length_ RTC_GUARDED_BY(&encoder_queue_);
   uint32_t last_observed_bitrate_bps_ RTC_GUARDED_BY(&encoder_queue_);